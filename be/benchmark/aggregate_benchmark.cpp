@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+
+#include "benchmark_util.h"
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/arena.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+static constexpr size_t BATCH_SIZE = 4096;
+
+static const char* const AGGREGATE_FUNCTIONS[] = {"sum", "min", "max", "avg", "count"};
+
+// Args: the index of the function in AGGREGATE_FUNCTIONS, the number of groups of the rows where
+// 0 adds the batch into a single place
+static void BM_AggregateAddBatch(benchmark::State& state) {
+    const char* name = AGGREGATE_FUNCTIONS[state.range(0)];
+    DataTypes argument_types {std::make_shared<DataTypeInt64>()};
+    auto function = AggregateFunctionSimpleFactory::instance().get(name, argument_types, {});
+    if (function == nullptr) {
+        state.SkipWithError("unknown aggregate function");
+        return;
+    }
+    state.SetLabel(name);
+
+    auto column = ColumnInt64::create();
+    for (auto value : benchmark_util::random_ints<int64_t>(BATCH_SIZE, 0, 1 << 20)) {
+        column->insert_value(value);
+    }
+    const IColumn* columns[] = {column.get()};
+
+    Arena arena;
+    size_t num_groups = state.range(1) == 0 ? 1 : state.range(1);
+    std::vector<AggregateDataPtr> group_places(num_groups);
+    for (auto& place : group_places) {
+        place = arena.aligned_alloc(function->size_of_data(), function->align_of_data());
+        function->create(place);
+    }
+    auto group_ids = benchmark_util::random_ints<size_t>(BATCH_SIZE, 0, num_groups - 1);
+    std::vector<AggregateDataPtr> places(BATCH_SIZE);
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        places[i] = group_places[group_ids[i]];
+    }
+
+    for (auto _ : state) {
+        if (state.range(1) == 0) {
+            function->add_batch_single_place(BATCH_SIZE, group_places[0], columns, &arena);
+        } else {
+            function->add_batch(BATCH_SIZE, places.data(), 0, columns, &arena);
+        }
+        benchmark::ClobberMemory();
+    }
+    for (auto place : group_places) {
+        function->destroy(place);
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+static void aggregate_function_args(benchmark::internal::Benchmark* benchmark) {
+    for (size_t function = 0; function < std::size(AGGREGATE_FUNCTIONS); ++function) {
+        for (int64_t num_groups : {0, 16, 4096}) {
+            benchmark->Args({static_cast<int64_t>(function), num_groups});
+        }
+    }
+}
+BENCHMARK(BM_AggregateAddBatch)->Apply(aggregate_function_args);
+
+} // namespace doris::vectorized
@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace doris::benchmark_util {
+
+// The data of the benchmarks is generated from a fixed seed, so that the runs of different builds
+// measure the same work and can be compared with the stored baselines.
+constexpr uint32_t RANDOM_SEED = 20221014;
+
+template <typename T>
+std::vector<T> random_ints(size_t num, T min, T max) {
+    std::mt19937_64 rng(RANDOM_SEED);
+    std::uniform_int_distribution<T> dist(min, max);
+    std::vector<T> values(num);
+    for (auto& value : values) {
+        value = dist(rng);
+    }
+    return values;
+}
+
+// num strings of [min_length, max_length] letters drawn from ndv distinct ones
+inline std::vector<std::string> random_strings(size_t num, size_t min_length, size_t max_length,
+                                               size_t ndv) {
+    std::mt19937_64 rng(RANDOM_SEED);
+    std::uniform_int_distribution<size_t> length_dist(min_length, max_length);
+    std::uniform_int_distribution<int> char_dist('a', 'z');
+    std::vector<std::string> distinct_values(ndv);
+    for (auto& value : distinct_values) {
+        value.resize(length_dist(rng));
+        for (auto& c : value) {
+            c = static_cast<char>(char_dist(rng));
+        }
+    }
+    std::uniform_int_distribution<size_t> index_dist(0, ndv - 1);
+    std::vector<std::string> values(num);
+    for (auto& value : values) {
+        value = distinct_values[index_dist(rng)];
+    }
+    return values;
+}
+
+} // namespace doris::benchmark_util
@@ -0,0 +1,142 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "gen_cpp/data.pb.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+static constexpr size_t NUM_ROWS = 4096;
+
+static ColumnString::MutablePtr create_string_column(size_t num, size_t max_length, size_t ndv) {
+    auto column = ColumnString::create();
+    for (auto& value : benchmark_util::random_strings(num, 1, max_length, ndv)) {
+        column->insert_data(value.data(), value.size());
+    }
+    return column;
+}
+
+// Args: the max length of the strings, the percentage of the rows kept
+static void BM_ColumnStringFilter(benchmark::State& state) {
+    auto column = create_string_column(NUM_ROWS, state.range(0), NUM_ROWS);
+    auto random_values = benchmark_util::random_ints<int32_t>(NUM_ROWS, 0, 99);
+    IColumn::Filter filter(NUM_ROWS);
+    for (size_t i = 0; i < NUM_ROWS; ++i) {
+        filter[i] = random_values[i] < state.range(1);
+    }
+    for (auto _ : state) {
+        auto result = column->filter(filter, -1);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ROWS);
+}
+BENCHMARK(BM_ColumnStringFilter)
+        ->Args({16, 10})
+        ->Args({16, 50})
+        ->Args({16, 90})
+        ->Args({128, 50});
+
+// Args: the max length of the strings, the max number of times a row is replicated
+static void BM_ColumnStringReplicate(benchmark::State& state) {
+    auto column = create_string_column(NUM_ROWS, state.range(0), NUM_ROWS);
+    auto counts = benchmark_util::random_ints<int32_t>(NUM_ROWS, 0, state.range(1));
+    IColumn::Offsets offsets(NUM_ROWS);
+    IColumn::Offset offset = 0;
+    for (size_t i = 0; i < NUM_ROWS; ++i) {
+        offset += counts[i];
+        offsets[i] = offset;
+    }
+    for (auto _ : state) {
+        auto result = column->replicate(offsets);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * offset);
+}
+BENCHMARK(BM_ColumnStringReplicate)->Args({16, 1})->Args({16, 8})->Args({128, 8});
+
+// an int column, a bigint column and a string column of strings up to 32 bytes
+static Block create_block(size_t num_rows) {
+    auto int_column = ColumnInt32::create();
+    for (auto value : benchmark_util::random_ints<int32_t>(num_rows, 0, 1 << 20)) {
+        int_column->insert_value(value);
+    }
+    auto bigint_column = ColumnInt64::create();
+    for (auto value : benchmark_util::random_ints<int64_t>(num_rows, 0, 1000)) {
+        bigint_column->insert_value(value);
+    }
+    Block block;
+    block.insert({std::move(int_column), std::make_shared<DataTypeInt32>(), "k1"});
+    block.insert({std::move(bigint_column), std::make_shared<DataTypeInt64>(), "k2"});
+    block.insert({create_string_column(num_rows, 32, num_rows / 4),
+                  std::make_shared<DataTypeString>(), "v1"});
+    return block;
+}
+
+// Args: the CompressionTypePB of the column values
+static void BM_BlockSerialize(benchmark::State& state) {
+    Block block = create_block(NUM_ROWS);
+    auto compression_type = static_cast<segment_v2::CompressionTypePB>(state.range(0));
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    for (auto _ : state) {
+        PBlock pblock;
+        auto st = block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes, false,
+                                  compression_type);
+        if (!st.ok()) {
+            state.SkipWithError(st.to_string().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(pblock);
+    }
+    state.SetBytesProcessed(state.iterations() * uncompressed_bytes);
+    state.counters["compressed_bytes"] = compressed_bytes;
+}
+BENCHMARK(BM_BlockSerialize)
+        ->Arg(segment_v2::CompressionTypePB::NO_COMPRESSION)
+        ->Arg(segment_v2::CompressionTypePB::SNAPPY)
+        ->Arg(segment_v2::CompressionTypePB::LZ4)
+        ->Arg(segment_v2::CompressionTypePB::ZSTD);
+
+// Args: the column to sort by, the limit of the sort where 0 is no limit
+static void BM_SortBlock(benchmark::State& state) {
+    const Block block = create_block(NUM_ROWS * 16);
+    SortDescription description {SortColumnDescription(state.range(0), 1, 1)};
+    for (auto _ : state) {
+        // sort_block replaces the columns of the copy with the sorted ones
+        Block sorted_block = block;
+        sort_block(sorted_block, description, state.range(1));
+        benchmark::DoNotOptimize(sorted_block);
+    }
+    state.SetItemsProcessed(state.iterations() * block.rows());
+}
+BENCHMARK(BM_SortBlock)
+        ->Args({0, 0})
+        ->Args({0, 100})
+        ->Args({1, 0})
+        ->Args({2, 0})
+        ->Args({2, 100});
+
+} // namespace doris::vectorized
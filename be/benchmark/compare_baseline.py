@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""
+Compares the JSON results of two runs of doris_be_benchmark and reports the
+benchmarks that are slower than the baseline by more than the threshold.
+
+Usage: compare_baseline.py BASELINE CONTENDER [--threshold=PERCENT]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    # the aggregates of the repetitions are reported besides the runs, keep the runs
+    return {b["name"]: b for b in benchmarks if b.get("run_type", "iteration") == "iteration"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare doris_be_benchmark results")
+    parser.add_argument("baseline", help="the JSON result of the baseline")
+    parser.add_argument("contender", help="the JSON result to compare with the baseline")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="the percentage of slowdown reported as regression")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+    regressions = []
+    print("%-70s %14s %14s %9s" % ("Benchmark", "Baseline", "Contender", "Change"))
+    for name, result in contender.items():
+        if name not in baseline or "error_occurred" in result:
+            continue
+        # both results are in the time unit of the benchmark
+        old_time = baseline[name]["cpu_time"]
+        new_time = result["cpu_time"]
+        change = (new_time - old_time) * 100.0 / old_time if old_time > 0 else 0.0
+        print("%-70s %14.1f %14.1f %8.1f%%" % (name, old_time, new_time, change))
+        if change > args.threshold:
+            regressions.append((name, change))
+
+    for name in sorted(set(baseline) - set(contender)):
+        print("%-70s missing in the contender" % name)
+
+    if regressions:
+        print("\n%d benchmarks are slower than the baseline by more than %.1f%%:"
+              % (len(regressions), args.threshold))
+        for name, change in regressions:
+            print("    %s: %+.1f%%" % (name, change))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
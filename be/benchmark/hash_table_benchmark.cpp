@@ -0,0 +1,114 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "vec/columns/column_string.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/hash_table/hash_map.h"
+#include "vec/common/hash_table/string_hash_map.h"
+
+namespace doris::vectorized {
+
+using Int64HashMap = HashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+
+// Args: the number of keys, the number of distinct keys
+static void BM_HashMapInsert(benchmark::State& state) {
+    auto keys = benchmark_util::random_ints<UInt64>(state.range(0), 0, state.range(1) - 1);
+    for (auto _ : state) {
+        Int64HashMap map;
+        for (auto key : keys) {
+            ++map[key];
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_HashMapInsert)->Args({1 << 20, 1 << 10})->Args({1 << 20, 1 << 20});
+
+static void BM_HashMapProbe(benchmark::State& state) {
+    auto keys = benchmark_util::random_ints<UInt64>(state.range(0), 0, state.range(1) - 1);
+    Int64HashMap map;
+    for (UInt64 key = 0; key < static_cast<UInt64>(state.range(1)); key += 2) {
+        map[key] = key;
+    }
+    for (auto _ : state) {
+        size_t found = 0;
+        for (auto key : keys) {
+            found += map.find(key) != nullptr;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_HashMapProbe)->Args({1 << 20, 1 << 10})->Args({1 << 20, 1 << 20});
+
+// The keys are in a ColumnString, as StringHashMap reads a key 8 bytes at a time and needs the
+// padding of the column.
+static ColumnString::MutablePtr string_keys(size_t num, size_t max_length, size_t ndv) {
+    auto column = ColumnString::create();
+    for (auto& value : benchmark_util::random_strings(num, 1, max_length, ndv)) {
+        column->insert_data(value.data(), value.size());
+    }
+    return column;
+}
+
+// Args: the number of keys, the max length of the keys, the number of distinct keys
+static void BM_StringHashMapInsert(benchmark::State& state) {
+    auto keys = string_keys(state.range(0), state.range(1), state.range(2));
+    for (auto _ : state) {
+        StringHashMap<UInt64> map;
+        for (size_t i = 0; i < keys->size(); ++i) {
+            StringHashMap<UInt64>::LookupResult it;
+            bool inserted;
+            map.emplace(keys->get_data_at(i), it, inserted);
+            ++*lookup_result_get_mapped(it);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys->size());
+}
+BENCHMARK(BM_StringHashMapInsert)
+        ->Args({1 << 20, 8, 1 << 10})
+        ->Args({1 << 20, 24, 1 << 10})
+        ->Args({1 << 20, 64, 1 << 18});
+
+static void BM_StringHashMapProbe(benchmark::State& state) {
+    auto keys = string_keys(state.range(0), state.range(1), state.range(2));
+    StringHashMap<UInt64> map;
+    // only the first half of the keys are inserted, so that some probes miss
+    for (size_t i = 0; i < keys->size() / 2; ++i) {
+        StringHashMap<UInt64>::LookupResult it;
+        bool inserted;
+        map.emplace(keys->get_data_at(i), it, inserted);
+    }
+    for (auto _ : state) {
+        size_t found = 0;
+        for (size_t i = 0; i < keys->size(); ++i) {
+            found += map.find(keys->get_data_at(i)) != nullptr;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * keys->size());
+}
+BENCHMARK(BM_StringHashMapProbe)
+        ->Args({1 << 20, 8, 1 << 16})
+        ->Args({1 << 20, 24, 1 << 16})
+        ->Args({1 << 20, 64, 1 << 18});
+
+} // namespace doris::vectorized
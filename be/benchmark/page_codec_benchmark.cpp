@@ -0,0 +1,176 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "benchmark_util.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "olap/rowset/segment_v2/binary_dict_page.h"
+#include "olap/rowset/segment_v2/binary_plain_page.h"
+#include "olap/rowset/segment_v2/bitshuffle_page.h"
+#include "olap/rowset/segment_v2/bitshuffle_page_pre_decoder.h"
+#include "olap/rowset/segment_v2/options.h"
+#include "util/block_compression.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+
+namespace doris::segment_v2 {
+
+static constexpr size_t PAGE_ROWS = 64 * 1024;
+
+static PageBuilderOptions page_builder_options() {
+    PageBuilderOptions options;
+    options.data_page_size = 1024 * 1024;
+    options.dict_page_size = 1024 * 1024;
+    return options;
+}
+
+// Args: the max value of the ints, which decides how well they compress
+static void BM_BitShufflePageDecode(benchmark::State& state) {
+    auto values = benchmark_util::random_ints<int32_t>(PAGE_ROWS, 0, state.range(0));
+    BitshufflePageBuilder<OLAP_FIELD_TYPE_INT> page_builder(page_builder_options());
+    size_t count = values.size();
+    page_builder.add(reinterpret_cast<const uint8_t*>(values.data()), &count);
+    OwnedSlice page = page_builder.finish();
+
+    PageDecoderOptions decoder_options;
+    BitShufflePagePreDecoder<false> pre_decoder;
+    for (auto _ : state) {
+        Slice page_slice = page.slice();
+        std::unique_ptr<char[]> decoded_page;
+        pre_decoder.decode(&decoded_page, &page_slice, 0);
+        BitShufflePageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(page_slice, decoder_options);
+        page_decoder.init();
+        vectorized::MutableColumnPtr column = vectorized::ColumnInt32::create();
+        size_t num_rows = count;
+        page_decoder.next_batch(&num_rows, column);
+        benchmark::DoNotOptimize(column);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_BitShufflePageDecode)->Arg(100)->Arg(1 << 30);
+
+// Args: the max length of the strings, the number of distinct strings
+static void BM_BinaryDictPageDecode(benchmark::State& state) {
+    auto values = benchmark_util::random_strings(PAGE_ROWS, 1, state.range(0), state.range(1));
+    std::vector<Slice> slices(values.begin(), values.end());
+    BinaryDictPageBuilder page_builder(page_builder_options());
+    size_t count = slices.size();
+    page_builder.add(reinterpret_cast<const uint8_t*>(slices.data()), &count);
+    OwnedSlice page = page_builder.finish();
+    OwnedSlice dict_page;
+    page_builder.get_dictionary_page(&dict_page);
+
+    PageDecoderOptions decoder_options;
+    BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR> dict_decoder(dict_page.slice(),
+                                                                 decoder_options);
+    dict_decoder.init();
+    std::vector<StringRef> dict_word_info(dict_decoder.count());
+    dict_decoder.get_dict_word_info(dict_word_info.data());
+
+    BitShufflePagePreDecoder<true> pre_decoder;
+    for (auto _ : state) {
+        Slice page_slice = page.slice();
+        std::unique_ptr<char[]> decoded_page;
+        pre_decoder.decode(&decoded_page, &page_slice, 0);
+        BinaryDictPageDecoder page_decoder(page_slice, decoder_options);
+        page_decoder.init();
+        page_decoder.set_dict_decoder(&dict_decoder, dict_word_info.data());
+        vectorized::MutableColumnPtr column = vectorized::ColumnString::create();
+        size_t num_rows = count;
+        page_decoder.next_batch(&num_rows, column);
+        benchmark::DoNotOptimize(column);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_BinaryDictPageDecode)->Args({16, 100})->Args({64, 10000});
+
+// 1MB of text of the ints of a narrow range, like the pages of a column
+static std::string compression_input() {
+    std::string input;
+    for (auto value : benchmark_util::random_ints<int32_t>(1 << 20, 0, 100000)) {
+        input.append(std::to_string(value));
+        input.push_back('|');
+        if (input.size() >= (1 << 20)) {
+            break;
+        }
+    }
+    return input;
+}
+
+// Args: the CompressionTypePB of the codec
+static void BM_BlockCompressionCompress(benchmark::State& state) {
+    std::unique_ptr<BlockCompressionCodec> codec;
+    if (!get_block_compression_codec(static_cast<CompressionTypePB>(state.range(0)), codec).ok() ||
+        codec == nullptr) {
+        state.SkipWithError("unsupported compression type");
+        return;
+    }
+    std::string input = compression_input();
+    std::string output(codec->max_compressed_len(input.size()), '\0');
+    size_t compressed_size = 0;
+    for (auto _ : state) {
+        Slice compressed(output.data(), output.size());
+        auto st = codec->compress(Slice(input), &compressed);
+        if (!st.ok()) {
+            state.SkipWithError(st.to_string().c_str());
+            break;
+        }
+        compressed_size = compressed.size;
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["ratio"] = static_cast<double>(input.size()) / compressed_size;
+}
+
+static void BM_BlockCompressionDecompress(benchmark::State& state) {
+    std::unique_ptr<BlockCompressionCodec> codec;
+    if (!get_block_compression_codec(static_cast<CompressionTypePB>(state.range(0)), codec).ok() ||
+        codec == nullptr) {
+        state.SkipWithError("unsupported compression type");
+        return;
+    }
+    std::string input = compression_input();
+    std::string compressed_buffer(codec->max_compressed_len(input.size()), '\0');
+    Slice compressed(compressed_buffer.data(), compressed_buffer.size());
+    if (!codec->compress(Slice(input), &compressed).ok()) {
+        state.SkipWithError("failed to compress the input");
+        return;
+    }
+    std::string output(input.size(), '\0');
+    for (auto _ : state) {
+        Slice decompressed(output.data(), output.size());
+        auto st = codec->decompress(compressed, &decompressed);
+        if (!st.ok()) {
+            state.SkipWithError(st.to_string().c_str());
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+static void compression_types(benchmark::internal::Benchmark* benchmark) {
+    for (auto type : {CompressionTypePB::SNAPPY, CompressionTypePB::LZ4, CompressionTypePB::LZ4F,
+                      CompressionTypePB::ZLIB, CompressionTypePB::ZSTD}) {
+        benchmark->Arg(type);
+    }
+}
+BENCHMARK(BM_BlockCompressionCompress)->Apply(compression_types);
+BENCHMARK(BM_BlockCompressionDecompress)->Apply(compression_types);
+
+} // namespace doris::segment_v2
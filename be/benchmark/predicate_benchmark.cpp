@@ -0,0 +1,64 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+
+#include "benchmark_util.h"
+#include "olap/comparison_predicate.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/predicate_column.h"
+
+namespace doris {
+
+static constexpr uint16_t BATCH_SIZE = 4096;
+
+// Args: the value compared with the values in [0, 100), whether a tenth of the rows are null
+template <typename Predicate>
+static void BM_ComparisonPredicateEvaluate(benchmark::State& state) {
+    auto values = benchmark_util::random_ints<int32_t>(BATCH_SIZE, 0, 99);
+    auto data_column = vectorized::PredicateColumnType<int32_t>::create();
+    data_column->insert_many_fix_len_data(reinterpret_cast<const char*>(values.data()),
+                                          values.size());
+    vectorized::ColumnPtr column = std::move(data_column);
+    if (state.range(1)) {
+        auto null_map = vectorized::ColumnUInt8::create();
+        for (auto value : benchmark_util::random_ints<int32_t>(BATCH_SIZE, 0, 9)) {
+            null_map->insert_value(value == 0);
+        }
+        column = vectorized::ColumnNullable::create(column, std::move(null_map));
+    }
+    Predicate predicate(0, static_cast<int32_t>(state.range(0)));
+    std::vector<uint16_t> sel(BATCH_SIZE);
+    for (auto _ : state) {
+        std::iota(sel.begin(), sel.end(), 0);
+        uint16_t selected_size = predicate.evaluate(*column, sel.data(), BATCH_SIZE);
+        benchmark::DoNotOptimize(selected_size);
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK_TEMPLATE(BM_ComparisonPredicateEvaluate, LessPredicate<int32_t>)
+        ->Args({10, 0})
+        ->Args({50, 0})
+        ->Args({90, 0})
+        ->Args({50, 1});
+BENCHMARK_TEMPLATE(BM_ComparisonPredicateEvaluate, EqualPredicate<int32_t>)
+        ->Args({50, 0})
+        ->Args({50, 1});
+
+} // namespace doris
@@ -875,6 +875,19 @@ void TaskWorkerPool::_update_tablet_meta_worker_thread_callback() {
                                 tablet_meta_info.storage_policy);
                     }
                     break;
+                case TTabletMetaType::SCHEMA: {
+                    std::vector<TabletColumn> columns(tablet_meta_info.columns_desc.begin(),
+                                                      tablet_meta_info.columns_desc.end());
+                    Status st = tablet->update_tablet_schema(columns,
+                                                             tablet_meta_info.schema_version);
+                    if (!st.ok()) {
+                        LOG(WARNING) << "failed to update schema of tablet "
+                                     << tablet->full_name() << ", error=" << st.to_string();
+                        status_code = TStatusCode::RUNTIME_ERROR;
+                        error_msgs.push_back(st.to_string());
+                    }
+                    break;
+                }
                 }
             }
             tablet->save_meta();
@@ -1215,6 +1228,13 @@ void TaskWorkerPool::_report_tablet_worker_thread_callback() {
     TReportRequest request;
     request.__set_backend(_backend);
     request.__isset.tablets = true;
+    // the last report accepted by the master, which is at the address in the epoch
+    TNetworkAddress reported_master_address;
+    int64_t reported_master_epoch = -1;
+    std::map<TTabletId, TTablet> reported_tablets;
+    int64_t reported_version = -1;
+    int64_t reported_max_compaction_score = -1;
+    int64_t reported_time = 0;
     while (_is_work) {
         _is_doing_work = false;
 
@@ -1264,7 +1284,35 @@ void TaskWorkerPool::_report_tablet_worker_thread_callback() {
                          DorisMetrics::instance()->tablet_base_max_compaction_score->value());
         request.__set_tablet_max_compaction_score(max_compaction_score);
         request.__set_report_version(report_version);
-        _handle_report(request, ReportType::TABLET);
+        // A new master, or the same one after a restart or a failover, has not seen the last
+        // report, so it is forgotten.
+        TNetworkAddress master_address = _master_info.network_address;
+        int64_t master_epoch = _master_info.epoch;
+        if (master_address != reported_master_address || master_epoch != reported_master_epoch) {
+            reported_tablets.clear();
+            reported_version = -1;
+            reported_max_compaction_score = -1;
+            reported_time = 0;
+        }
+        // Skip the report if the master has accepted the same one recently, it saves the master
+        // from checking all the tablets again.
+        if (UnixSeconds() - reported_time < config::report_unchanged_tablets_interval_seconds &&
+            report_version == reported_version &&
+            max_compaction_score == reported_max_compaction_score &&
+            request.tablets == reported_tablets) {
+            LOG(INFO) << "tablets are unchanged since the last report, skip reporting "
+                      << request.tablets.size() << " tablets";
+            DorisMetrics::instance()->report_all_tablets_requests_skip->increment(1);
+            continue;
+        }
+        if (_handle_report(request, ReportType::TABLET)) {
+            reported_master_address = master_address;
+            reported_master_epoch = master_epoch;
+            reported_tablets.swap(request.tablets);
+            reported_version = report_version;
+            reported_max_compaction_score = max_compaction_score;
+            reported_time = UnixSeconds();
+        }
     }
     StorageEngine::instance()->deregister_report_listener(this);
 }
@@ -1602,7 +1650,7 @@ Status TaskWorkerPool::_move_dir(const TTabletId tablet_id, const std::string& s
     return Status::OK();
 }
 
-void TaskWorkerPool::_handle_report(TReportRequest& request, ReportType type) {
+bool TaskWorkerPool::_handle_report(TReportRequest& request, ReportType type) {
     TMasterResult result;
     Status status = _master_client->report(request, &result);
     bool is_report_success = false;
@@ -1649,6 +1697,7 @@ void TaskWorkerPool::_handle_report(TReportRequest& request, ReportType type) {
     default:
         break;
     }
+    return is_report_success;
 }
 
 void TaskWorkerPool::_random_sleep(int second) {
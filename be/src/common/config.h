@@ -151,12 +151,19 @@ CONF_mBool(rowbatch_align_tuple_offset, "false");
 CONF_mInt32(status_report_interval, "5");
 // if true, each disk will have a separate thread pool for scanner
 CONF_Bool(doris_enable_scanner_thread_pool_per_disk, "true");
+// if true, the scanner threads are shared between the queries by the CPU time they used, weighted
+// by the session variable scan_thread_shares, instead of by the priority of the scanners only.
+CONF_Bool(doris_enable_scanner_thread_pool_fair_scheduling, "true");
 // the timeout of a work thread to wait the blocking priority queue to get a task
 CONF_mInt64(doris_blocking_priority_queue_wait_timeout_ms, "5");
 // number of olap scanner thread pool size
 CONF_Int32(doris_scanner_thread_pool_thread_num, "48");
 // number of olap scanner thread pool queue size
 CONF_Int32(doris_scanner_thread_pool_queue_size, "102400");
+// the file ranges of a file scan node larger than this are cut into splits of about this size,
+// which its scanners take from a shared queue, if the format can be read by byte ranges.
+// 0 disables the splitting.
+CONF_mInt64(file_scan_split_size_bytes, "134217728");
 // number of etl thread pool size
 CONF_Int32(etl_thread_pool_size, "8");
 // number of etl thread pool size
@@ -193,6 +200,15 @@ CONF_mInt64(column_dictionary_key_ratio_threshold, "0");
 CONF_mInt64(column_dictionary_key_size_threshold, "0");
 // memory_limitation_per_thread_for_schema_change_bytes unit bytes
 CONF_mInt64(memory_limitation_per_thread_for_schema_change_bytes, "2147483648");
+// the max number of rowsets of a tablet converted in parallel by a schema change, each of them
+// bounded by memory_limitation_per_thread_for_schema_change_bytes
+CONF_mInt32(schema_change_max_parallel_rowsets, "4");
+// the number of threads converting the rowsets of schema changes
+CONF_Int32(schema_change_thread_num, "8");
+// whether a schema change only adding or dropping bloom filter or bitmap indexes links the
+// segments instead of rewriting them, the indexes added are built into an index file beside each
+// linked segment by the index build tasks afterwards
+CONF_mBool(schema_change_link_index_changes, "true");
 CONF_mInt64(memory_limitation_per_thread_for_storage_migration_bytes, "100000000");
 
 // the clean interval of file descriptor cache and segment cache
@@ -239,17 +255,44 @@ CONF_Int32(storage_page_cache_shard_size, "16");
 CONF_Int32(index_page_cache_percentage, "10");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "false");
+// Percentage of the storage page cache for the compressed data pages, the rest is divided into
+// data_page_cache and index_page_cache. A data page missing in data_page_cache is decompressed
+// from this cache instead of being read again. 0 means the compressed pages are not cached.
+CONF_Int32(compressed_page_cache_percentage, "0");
+// The queries scanning a tablet larger than this insert the data pages they read into the page
+// cache at probation priority, so a bulk scan doesn't evict the working set of the cache.
+// -1 means all the pages are inserted at normal priority.
+CONF_mInt64(storage_page_cache_bulk_scan_tablet_bytes, "10737418240");
 
 CONF_Bool(enable_storage_vectorization, "true");
 
 CONF_Bool(enable_low_cardinality_optimize, "true");
 
+// the min number of non-predicate columns a scan reads from the row store column of a segment,
+// if it has one, instead of from their own pages
+CONF_mInt32(row_store_min_read_columns, "32");
+
 // be policy
 // whether disable automatic compaction task
 CONF_mBool(disable_auto_compaction, "false");
 // whether enable vectorized compaction
 CONF_Bool(enable_vectorized_compaction, "true");
-// whether enable vectorized schema change, material-view or rollup task will fail if this config open.
+// whether enable vertical compaction, which merges the key columns first and then the value
+// columns group by group in the order of the merged keys, to bound the memory of wide tables
+CONF_mBool(enable_vertical_compaction, "false");
+// the number of value columns merged at a time by vertical compaction
+CONF_mInt32(vertical_compaction_num_columns_per_group, "5");
+// the max number of value column groups of a vertical compaction merged in parallel
+CONF_mInt32(vertical_compaction_max_parallel_groups, "4");
+// the number of threads merging the value column groups of vertical compactions
+CONF_Int32(vertical_compaction_thread_num, "8");
+// the max memory of the row sources of a vertical compaction, spilled to disk beyond it
+CONF_mInt64(vertical_compaction_max_row_source_memory_mb, "200");
+// whether link the segments of the input rowsets into the output rowset of a compaction when
+// their keys are already in order and there are no rows to merge or delete
+CONF_mBool(enable_ordered_data_compaction, "true");
+// whether enable vectorized schema change. The columns of materialized views are computed by
+// evaluating their define expressions, so any scalar function of the base columns can be used.
 CONF_Bool(enable_vectorized_alter_table, "false");
 
 // check the configuration of auto compaction in seconds when auto compaction disabled
@@ -260,14 +303,29 @@ CONF_mDouble(base_cumulative_delta_ratio, "0.3");
 CONF_mInt64(base_compaction_interval_seconds_since_last_operation, "86400");
 CONF_mInt32(base_compaction_write_mbytes_per_sec, "5");
 
+// whether meter the bytes read and written by compactions on each disk, the rate of a disk
+// adapts to the I/O latency of the queries on it
+CONF_mBool(enable_compaction_io_scheduler, "false");
+// the max and the min bytes per second of compaction I/O on a disk
+CONF_mInt32(compaction_io_max_mbytes_per_sec_per_disk, "200");
+CONF_mInt32(compaction_io_min_mbytes_per_sec_per_disk, "10");
+// the target latency of reading a page from a disk by queries, compactions slow down on the
+// disk while it is exceeded
+CONF_mInt32(compaction_io_query_latency_target_us, "10000");
+// the compactions of a tablet whose version count reaches this ratio of max_tablet_version_num
+// are paced at the max rate regardless of queries
+CONF_mDouble(compaction_io_boost_version_ratio, "0.8");
+
 // config the cumulative compaction policy
-// Valid configs: num_based, size_based
+// Valid configs: num_based, size_based, time_series
 // num_based policy, the original version of cumulative compaction, cumulative version compaction once.
 // size_based policy, a optimization version of cumulative compaction, targeting the use cases requiring
 // lower write amplification, trading off read amplification and space amplification.
+// time_series policy, merging the time-ordered loads of append-mostly tables once by goal size or by time
+// window, targeting the lowest write amplification.
 CONF_mString(cumulative_compaction_policy, "size_based");
 CONF_Validator(cumulative_compaction_policy, [](const std::string config) -> bool {
-    return config == "size_based" || config == "num_based";
+    return config == "size_based" || config == "num_based" || config == "time_series";
 });
 
 // In size_based policy, output rowset of cumulative compaction total disk size exceed this config size,
@@ -363,6 +421,15 @@ CONF_Int64(load_data_reserve_hours, "4");
 // log error log will be removed after this time
 CONF_mInt64(load_error_log_reserve_hours, "48");
 CONF_Int32(number_tablet_writer_threads, "16");
+// send the rows of a load only to one replica of every tablet, the other replicas pull the segment
+// files of the rowset committed by it instead of building their own rowsets from the same rows
+CONF_mBool(enable_single_replica_load, "false");
+// number of threads for the slave replicas to download the rowsets in single replica load
+CONF_Int32(number_slave_replica_download_threads, "64");
+// number of threads serving the point queries of tablet_fetch_data
+CONF_Int32(number_tablet_fetch_data_threads, "48");
+// timeout of the rpc to make a slave replica pull a rowset in single replica load
+CONF_mInt32(slave_replica_pull_rowset_rpc_timeout_sec, "600");
 
 // The maximum amount of data that can be processed by a stream load
 CONF_mInt64(streaming_load_max_mb, "10240");
@@ -370,6 +437,19 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_json_max_mb, "100");
+// the stream loads which set the header 'group_commit: true' and have at most these bytes are
+// committed with the concurrent loads of the same table every group_commit_interval_ms in one
+// txn, the others are committed on their own
+CONF_mInt64(group_commit_max_load_bytes, "1048576");
+CONF_mInt32(group_commit_interval_ms, "1000");
+// a group of stream loads is committed before the interval passes once it has this many bytes
+CONF_mInt64(group_commit_data_bytes, "67108864");
+// the labels of the loads committed in a group are rejected by the BE for this many seconds,
+// see GroupCommitMgr
+CONF_mInt32(group_commit_label_keep_max_second, "3600");
+// read the json data of loads with the on-demand parser of simdjson instead of building a DOM
+// with rapidjson, for the jsonpaths and json roots that are made of object keys only
+CONF_mBool(enable_simdjson_reader, "false");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -399,6 +479,18 @@ CONF_Int32(fragment_pool_thread_num_min, "64");
 CONF_Int32(fragment_pool_thread_num_max, "512");
 CONF_Int32(fragment_pool_queue_size, "2048");
 
+// Whether vectorized fragments run as tasks of a fixed pool of pipeline workers instead of
+// taking a thread of the fragment pool each. A task gives its worker back whenever its
+// exchanges or scans have no data ready or its sink is still sending the previous block.
+CONF_Bool(enable_pipeline_exec_engine, "false");
+// The number of pipeline workers, 0 means one per core.
+CONF_Int32(pipeline_executor_size, "0");
+// The max number of threads opening the pipeline tasks, each open waits until the blocking
+// nodes, such as aggregations, sorts and hash join builds, have consumed their input.
+CONF_Int32(pipeline_open_thread_num_max, "512");
+// The time a pipeline task runs before it yields its worker to the other runnable tasks.
+CONF_mInt64(pipeline_task_time_slice_ms, "100");
+
 // Control the number of disks on the machine.  If 0, this comes from the system settings.
 CONF_Int32(num_disks, "0");
 // The maximum number of the threads per disk is also the max queue depth per disk.
@@ -482,6 +574,10 @@ CONF_mInt64(write_buffer_size, "209715200");
 // max buffer size used in memtable for the aggregated table
 CONF_mInt64(memtable_max_buffer_size, "419430400");
 
+// Whether the vectorized memtable only appends the loaded rows and sorts them once when it is
+// flushed or shrunk, instead of inserting each row into a skiplist.
+CONF_mBool(enable_memtable_sort_on_flush, "true");
+
 // following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
 // NOTICE(cmy): set these default values very large because we don't want to
@@ -489,6 +585,10 @@ CONF_mInt64(memtable_max_buffer_size, "419430400");
 // user should set these configs properly if necessary.
 CONF_Int64(load_process_max_memory_limit_bytes, "107374182400"); // 100GB
 CONF_Int32(load_process_max_memory_limit_percent, "50");         // 50%
+// when the mem consumption of all the loads exceeds this percent of the load mem limit, the
+// largest memtables of all the load channels are submitted to flush without waiting for them,
+// so that the loads are not blocked by a forced flush when the limit is reached
+CONF_mInt32(load_process_soft_mem_limit_percent, "80");
 
 // result buffer cancelled time (unit: second)
 CONF_mInt32(result_buffer_cancelled_interval_time, "300");
@@ -510,6 +610,9 @@ CONF_Bool(enable_metric_calculator, "true");
 
 // max consumer num in one data consumer group, for routine load
 CONF_mInt32(max_consumer_num_per_group, "3");
+// max number of kafka messages a routine load consumer takes from the messages fetched, and hands
+// to its group at once
+CONF_mInt32(routine_load_consumer_batch_messages, "1024");
 
 // the size of thread pool for routine load task.
 // this should be larger than FE config 'max_routine_load_task_num_per_be' (default 5)
@@ -554,6 +657,13 @@ CONF_mInt64(storage_flood_stage_left_capacity_bytes, "1073741824"); // 1GB
 CONF_Int32(flush_thread_num_per_store, "2");
 // number of thread for flushing memtable per store, for high priority load task
 CONF_Int32(high_priority_flush_thread_num_per_store, "1");
+// number of thread per store for writing the segments of a memtable flush concurrently
+CONF_Int32(segment_flush_thread_num_per_store, "2");
+// max number of key ranges the rows of one memtable flush are split into, each range is
+// encoded into its own segment concurrently. 1 means a flush writes a single segment.
+CONF_mInt32(memtable_flush_max_parallel_segments, "1");
+// a memtable flush is only split when each key range has at least these rows
+CONF_mInt64(memtable_flush_min_rows_per_parallel_segment, "200000");
 
 // config for tablet meta checkpoint
 CONF_mInt32(tablet_meta_checkpoint_min_new_rowsets_num, "10");
@@ -574,6 +684,22 @@ CONF_Int64(brpc_socket_max_unwritten_bytes, "1073741824");
 // is greater than 1.8G. This is to avoid the error of Request length overflow (2G).
 CONF_mBool(transfer_large_data_by_brpc, "false");
 
+// Whether the data stream senders hand the blocks for a receiver on the same BE over in memory,
+// instead of serializing them and sending them through brpc.
+CONF_mBool(enable_local_exchange, "true");
+
+// The data stream senders send the column values of the blocks of at least this size as brpc
+// attachment, which brpc sends without copying them. A negative value disables it.
+CONF_mInt64(brpc_block_attachment_min_bytes, "65536");
+
+// The max number of serialized blocks a data stream sender queues for a channel while the rpc
+// of the previous block of the channel is in flight.
+CONF_mInt32(data_stream_sender_channel_queue_size, "8");
+
+// The max bytes of serialized blocks a data stream sender queues for all its channels, the
+// sender waits for the rpcs in flight once it queued more.
+CONF_mInt64(data_stream_sender_max_queued_bytes, "104857600");
+
 // max number of txns for every txn_partition_map in txn manager
 // this is a self protection to avoid too many txns saving in manager
 CONF_mInt64(max_runnings_transactions_per_txn_map, "100");
@@ -667,6 +793,10 @@ CONF_mDouble(tablet_version_graph_orphan_vertex_ratio, "0.1");
 // else we will call sync method
 CONF_mBool(runtime_filter_use_async_rpc, "true");
 
+// if set true, bloom runtime filters also carry the min and max of their values, which are
+// pushed down as range predicates so the scan can skip pages by zone maps
+CONF_mBool(enable_runtime_filter_bloom_range, "true");
+
 // max send batch parallelism for OlapTableSink
 // The value set by the user for send_batch_parallelism is not allowed to exceed max_send_batch_parallelism_per_job,
 // if exceed, the value of send_batch_parallelism would be max_send_batch_parallelism_per_job
@@ -678,6 +808,15 @@ CONF_Validator(max_send_batch_parallelism_per_job,
 CONF_Int32(send_batch_thread_pool_thread_num, "64");
 // number of send batch thread pool queue size
 CONF_Int32(send_batch_thread_pool_queue_size, "102400");
+// the rows of all the tablets on a backend are accumulated by the olap table sink into one
+// block, which is sent once it has this many rows or bytes
+CONF_mInt32(tablet_sink_max_block_rows, "65536");
+CONF_mInt64(tablet_sink_max_block_bytes, "33554432");
+// number of threads writing the rows of a received block to the tablet writers
+CONF_Int32(tablet_writer_write_thread_num, "32");
+// max number of tablet writers of one received block written concurrently,
+// 1 means the tablets are written one by one in the rpc thread
+CONF_mInt32(tablet_writer_max_parallel_writes, "8");
 
 // Limit the number of segment of a newly created rowset.
 // The newly created rowset may to be compacted after loading,
@@ -693,6 +832,10 @@ CONF_mInt32(external_table_connect_timeout_sec, "30");
 // Althought it is called "segment cache", but it caches segments in rowset granularity.
 // So the value of this config should corresponding to the number of rowsets on this BE.
 CONF_mInt32(segment_cache_capacity, "1000000");
+// The capacity in bytes of the cache of the parsed segment footers, ordinal indexes and zone
+// maps, which are kept after their segments are evicted from the segment cache. The metadata
+// of in memory tables is pinned in it. 0 disables the cache.
+CONF_Int64(segment_meta_cache_capacity, "536870912");
 
 // Global bitmap cache capacity for aggregation cache, size in bytes
 CONF_Int64(delete_bitmap_agg_cache_capacity, "104857600");
@@ -759,6 +902,12 @@ CONF_Int32(object_pool_buffer_size, "100");
 // ParquetReaderWrap prefetch buffer size
 CONF_Int32(parquet_reader_max_buffer_size, "50");
 CONF_Bool(parquet_predicate_push_down, "true");
+// whether the vectorized broker load decodes parquet files with the column readers of parquet-cpp
+// instead of arrow record batches, it falls back to the arrow reader for the unsupported columns
+CONF_mBool(enable_native_parquet_reader, "false");
+// whether the vectorized broker load decodes orc files with the RowReader of the orc library
+// instead of arrow record batches, it falls back to the arrow reader for the unsupported columns
+CONF_mBool(enable_native_orc_reader, "false");
 
 // When the rows number reached this limit, will check the filter rate the of bloomfilter
 // if it is lower than a specific threshold, the predicate will be disabled.
@@ -785,8 +934,376 @@ CONF_mInt64(cooldown_lag_time_sec, "10800"); // 3h
 
 CONF_Int32(s3_transfer_executor_pool_size, "2");
 
+// The local directories caching the blocks of the remote files read by cooled down rowsets,
+// separated by ';'. The remote files are not cached if it is empty. The blocks cached in a
+// directory are kept across restarts, up to file_cache_capacity_per_path bytes per directory.
+CONF_String(file_cache_path, "");
+CONF_Int64(file_cache_capacity_per_path, "107374182400");
+CONF_Int64(file_cache_block_size, "1048576");
+
+// Whether the scans of the segments on remote storage read the data pages of each column ahead
+// of the decoder, up to remote_prefetch_window_bytes. The pages less than
+// remote_prefetch_max_gap_bytes apart are read by one request of at most
+// remote_prefetch_max_range_bytes.
+CONF_mBool(enable_remote_prefetch, "true");
+CONF_mInt64(remote_prefetch_window_bytes, "8388608");
+CONF_mInt64(remote_prefetch_max_range_bytes, "2097152");
+CONF_mInt64(remote_prefetch_max_gap_bytes, "65536");
+CONF_Int32(remote_prefetch_thread_num, "64");
+
+// Whether the local files are read through an io_uring of each thread instead of pread, so that
+// the ranges read together by FileReader::read_at_batch are all in flight at once. It's
+// ignored if the kernel doesn't support io_uring.
+CONF_mBool(enable_io_uring, "false");
+CONF_Int32(io_uring_queue_depth, "64");
+
 CONF_Bool(enable_time_lut, "true");
 
+// Whether the vectorized hash aggregation spills its hash table to the scratch directories
+// when its memory usage exceeds agg_spill_mem_threshold_bytes.
+CONF_mBool(enable_agg_spill, "false");
+CONF_mInt64(agg_spill_mem_threshold_bytes, "2147483648");
+// The number of hash partitions the spilled aggregation data is split into. Each partition
+// is merged back into memory separately, so more partitions need less memory to merge.
+CONF_mInt32(agg_spill_partition_count, "16");
+
+// A hash table of a vectorized AggregationNode is converted to a two level table, made of 256
+// sub-tables selected by the high bits of the hash, once it holds this many groups. Each
+// sub-table then stays small enough to be resized cheaply and to stay in the cache longer.
+CONF_mInt64(agg_two_level_hash_table_min_rows, "100000");
+// The number of threads materializing the result of a vectorized AggregationNode whose hash
+// table has been converted to a two level table. Each thread finalizes its own sub-tables, and
+// a value less than 2 finalizes the result on the thread of the node.
+CONF_mInt32(agg_finalize_thread_num, "1");
+// A streaming preaggregation passing its input through because its hash table doesn't reduce
+// the input enough still aggregates one block out of this many, and resumes aggregating if the
+// reduction of these blocks is good enough again.
+CONF_mInt32(streaming_preagg_probe_interval_blocks, "16");
+// Whether a vectorized AggregationNode grouping by several keys replaces its string keys by
+// codes of a per node dictionary, so that the keys are packed into a fixed size hash key
+// instead of being serialized. The strings are only looked up again when outputting results.
+CONF_mBool(enable_agg_string_key_dictionary, "true");
+
+// Whether a full sort spills its sorted blocks to the scratch directories as sorted runs
+// when their memory usage exceeds sort_spill_mem_threshold_bytes.
+CONF_mBool(enable_sort_spill, "false");
+CONF_mInt64(sort_spill_mem_threshold_bytes, "2147483648");
+// The max number of spilled runs merged at the same time.
+CONF_mInt32(sort_spill_merge_fan_in, "64");
+
+// Whether the vectorized hash join switches to a grace hash join, which partitions both of
+// its inputs to the scratch directories, when the build side exceeds
+// hash_join_spill_mem_threshold_bytes.
+CONF_mBool(enable_hash_join_spill, "false");
+CONF_mInt64(hash_join_spill_mem_threshold_bytes, "2147483648");
+// The number of hash partitions of a grace hash join, hash table of each partition is built
+// and probed separately.
+CONF_mInt32(hash_join_spill_partition_count, "16");
+
+// The number of threads building the hash table of a vectorized hash join whose build side
+// has at least hash_join_parallel_build_min_rows rows. The hash table is split into as many
+// partitions, each filled by one thread. It is rounded down to a power of two, and a value
+// less than 2 builds the hash table on a single thread.
+CONF_mInt32(hash_join_build_thread_num, "1");
+CONF_mInt64(hash_join_parallel_build_min_rows, "1000000");
+
+// Whether the instances of a broadcast hash join on one BE share a single hash table, built by
+// the first instance, instead of each building the same one.
+CONF_mBool(enable_share_hash_table_for_broadcast_join, "true");
+
+// Whether the element-wise numeric subtrees of the vectorized expressions, made of arithmetic,
+// comparisons, compound predicates, numeric casts and case exprs, are evaluated as one fused
+// program over chunks of rows, instead of materializing a temporary column for each node.
+CONF_mBool(enable_vexpr_fusion, "false");
+
+// Whether the identical subtrees of a vectorized expression, or of the output exprs executed on
+// the same block, are computed once and their columns reused.
+CONF_mBool(enable_common_subexpr_elimination, "true");
+
+// Whether an or of LIKE and REGEXP predicates with constant patterns on the same column is
+// evaluated by matching all the patterns in one scan of each string.
+CONF_mBool(enable_multi_pattern_match, "true");
+
+// Whether the constant subtrees of a vectorized expression are evaluated once when it's opened,
+// instead of on each block.
+CONF_mBool(enable_vexpr_constant_folding, "true");
+
+// The number of threads shared by the operators splitting their work into parallel tasks, like
+// the parallel evaluation of the analytic functions. A task is run by the thread of its operator
+// when the pool is busy.
+CONF_Int32(parallel_operator_thread_num, "32");
+
+// The number of tasks evaluating a vectorized AnalyticEvalNode with PARTITION BY. The node then
+// reads all its input, splits it into ranges of whole partitions and every task evaluates its own
+// range on the parallel operator pool. A value less than 2 evaluates the partitions one by one
+// while streaming.
+CONF_mInt32(analytic_eval_thread_num, "1");
+
+// Whether a TopN right above an olap scan lets the scan skip the pages that can't have any row of
+// its result, by the zone maps of its first sort column, as the rows it keeps get better.
+CONF_mBool(enable_topn_scan_filter, "true");
+
+// The number of threads merging the partitions of two big sets of an exact count distinct, like
+// the states of multi_distinct_count received from other instances. A value less than 2 merges
+// them on the thread of the aggregation.
+CONF_mInt32(uniq_exact_merge_thread_num, "4");
+
+// Whether the aggregation by keys with at most 256 groups adds a block to the states of its
+// groups by dense group ids, so that functions like sum and count aggregate it in a small array
+// indexed by the ids before updating the states.
+CONF_mBool(enable_agg_dense_group_add, "true");
+
+// Whether the threads of the scanner thread pool are spread over the NUMA nodes, each one bound to
+// the cores of its node, so that the blocks a scanner reads into stay in the memory of its node.
+CONF_Bool(bind_scanner_threads_to_numa_nodes, "false");
+
+// Whether the mmap'ed allocations of at least 2MB, like the big hash tables, arenas and columns,
+// and the chunks of use_mmap_allocate_chunk, are advised to be backed by transparent huge pages,
+// which take far fewer TLB entries when they are probed randomly.
+CONF_Bool(enable_huge_pages_for_large_allocations, "true");
+
+// The percentage of the process memory limit above which the BE is under memory pressure: the
+// aggregation and sort nodes that can spill spill their data once it is larger than
+// mem_pressure_spill_min_bytes, and the unused entries of the page and segment caches are dropped.
+// 0 disables the memory arbitration.
+CONF_mInt32(process_soft_mem_limit_percent, "80");
+// The percentage of the process memory limit above which the new queries fail at once with
+// TOO_MANY_TASKS, which the FE retries, until the memory pressure goes down.
+CONF_mInt32(process_admission_mem_limit_percent, "90");
+CONF_mInt64(mem_pressure_spill_min_bytes, "67108864");
+
+// The workload groups of the queries, separated by ';', each one like
+// "interactive:cpu_share=2048,mem_limit=30%,max_concurrency=20". cpu_share is the share of the
+// scanner threads relative to 1024, mem_limit the memory limit of all the queries of the group in
+// the format of mem_limit, and max_concurrency the number of its queries running at the same
+// time on a BE, 0 for no limit. The FE assigns a query to a group with the session variable
+// workload_group. A query over the limit fails with TOO_MANY_TASKS, which the FE retries.
+CONF_String(workload_groups, "");
+
+// The bytes of the large mmap'ed regions, like the buffers of the big columns, that are kept after
+// they are freed to be reused by the next allocations of their size. 0 disables the cache.
+CONF_mInt64(mmap_region_cache_capacity_bytes, "1073741824");
+
+// Whether to sample the threads on the CPU and count the samples of each query, shown by
+// /api/cpu_samples. Each sample stands for 1/cpu_sampling_frequency second of CPU time.
+CONF_Bool(enable_cpu_sampling, "true");
+CONF_Int32(cpu_sampling_frequency, "99");
+// The seconds that the samples of a query are kept after its last sample.
+CONF_mInt32(cpu_sampling_retention_s, "600");
+
+// Whether the numeric columns of the new segments use the adaptive encoding, which stores each
+// page as delta, delta-of-delta, xor or dictionary-rle, whichever is the smallest. The segments
+// can not be read by the BEs without the encoding, so enable it after all the BEs are upgraded.
+CONF_mBool(enable_adaptive_numeric_encoding, "false");
+
+// The number of the first data pages of a column on which ZSTD is evaluated against the codec of
+// the table, 0 to always use the codec of the table. The later pages of the column use ZSTD if it
+// makes the sample pages at most adaptive_compression_zstd_max_size_ratio of their size by the
+// codec of the table, or they are stored uncompressed if the codec of the table does not save
+// enough space on the sample pages. The BEs without the feature can not read the pages by ZSTD,
+// so enable it after all the BEs are upgraded.
+CONF_mInt32(adaptive_compression_sample_pages, "0");
+CONF_mDouble(adaptive_compression_zstd_max_size_ratio, "0.7");
+
+// Whether the string pages written after the dictionary of a column is full are encoded by a
+// static symbol table (FSST) instead of plain, so that they are smaller and their equality and
+// prefix predicates are evaluated without decoding. The BE of older versions can't read them.
+CONF_mBool(enable_fsst_string_encoding, "false");
+
+// Whether to store a HyperLogLog of the values of each column of a segment in its zone map index,
+// to estimate the number of distinct values of the column.
+CONF_mBool(enable_zone_map_ndv_sketch, "true");
+
+// The capacity of the partial results of the aggregations over the tablets of a fragment, cached
+// by the digest of the plan and the versions of the tablets, 0 to disable the cache. When new
+// versions of the tablets of a duplicate key table arrive, only their rows are scanned and their
+// partial results are sent with the cached ones.
+CONF_Int64(fragment_result_cache_capacity_mb, "0");
+// The partial results of a fragment bigger than it are not cached.
+CONF_mInt64(fragment_result_cache_max_entry_mb, "16");
+
+// The number of threads loading the tablets and rowsets of each data dir at startup. 1 loads them
+// serially.
+CONF_Int32(tablet_load_threads_per_disk, "4");
+
+// Whether to pick the tablets to compact from the compaction scores kept by each data dir, which
+// are computed again only for the tablets whose rowsets changed, instead of computing the scores
+// of all the tablets at every pick. Not used when compaction_tablet_scan_frequency_factor is set.
+CONF_mBool(enable_compaction_score_index, "true");
+
+// The number of threads adding the rowsets published by a txn to their tablets, which is where the
+// delete bitmaps of the merge-on-write tablets are computed.
+CONF_Int32(tablet_publish_txn_max_thread, "16");
+
+// The number of files of a clone downloaded at the same time. They share max_download_speed_kbps.
+CONF_mInt32(clone_download_file_threads, "4");
+
+// The max total speed in KB/s of the writes to the remote file systems of cooldown, 0 is unlimited.
+CONF_Int64(s3_upload_max_speed_kbps, "0");
+// The cooldown of a tablet is delayed while it is scanned at least this many times per minute.
+// 0 means the scans are not considered.
+CONF_mDouble(cooldown_hot_tablet_scan_frequency, "0");
+
+// The capacity of the block cache shared by the metas of all the data dirs.
+CONF_Int64(meta_block_cache_size_mb, "64");
+
+// A tablet report that is the same as the last one accepted by the current master is skipped,
+// unless the last one is at least this many seconds ago. 0, the default, means the tablets are
+// always reported.
+CONF_mInt32(report_unchanged_tablets_interval_seconds, "0");
+
+// Bind a socket with SO_REUSEPORT for each worker of the http server instead of sharing one, so
+// that the kernel balances the new connections among the workers and they do not contend to
+// accept. A connection then waits for its worker even if the others are idle.
+CONF_Bool(enable_http_server_reuseport, "false");
+
+// the size of the buffered row group at which the vectorized parquet writer of the exported
+// results flushes it to the file
+CONF_mInt64(parquet_writer_max_row_group_bytes, "134217728");
+
+// the rows of a block that a vectorized rpc udf sends in one call, 0 to send the whole block. The
+// batches of a block are sent with at most rpc_udf_max_inflight_batches of them in flight.
+CONF_mInt32(rpc_udf_batch_rows, "1024");
+CONF_mInt32(rpc_udf_max_inflight_batches, "4");
+
+// The max rows and buffer bytes of a batch fetched from the ODBC driver at once by the odbc scan.
+CONF_Int32(odbc_scan_batch_rows, "1024");
+CONF_Int64(odbc_scan_batch_bytes, "16777216");
+
+// Whether the mysql scan streams the rows of the result instead of reading all of them before the
+// first one. The mysql server may close a streaming query that is not read for net_write_timeout.
+CONF_mBool(mysql_scan_use_result, "false");
+
+// The number of sliced scrolls that read each shard of an es table concurrently, each by its own
+// scanner. 1 reads a shard with a single scroll.
+CONF_mInt32(es_scroll_slices_per_shard, "1");
+
+// The number of tasks sorting a full sort in one vectorized SortNode on the parallel operator
+// pool. With 2 or more, the input blocks are sorted by the tasks once the input is read, then
+// every round of tasks merges the rows of the next ranges of keys split by sampled rows while the
+// output is read. Less than 2 sorts every block as it arrives and merges them on the fragment
+// thread.
+CONF_mInt32(sort_thread_num, "1");
+
+// Whether the rows of each key of a vectorized hash join table with many duplicates are copied
+// into one contiguous array once the table is built, so that the probe reads them without
+// chasing the batches of the row list.
+CONF_mBool(join_compact_duplicate_rows, "true");
+
+// When tracing is enabled and this is greater than 0, the spans of a trace are buffered on the BE
+// and only exported if one of its local root spans, like the execution of a fragment instance,
+// takes at least this many milliseconds. The spans of the faster traces are dropped.
+CONF_Int64(trace_tail_sampling_threshold_ms, "0");
+
+// The maximum number of the spans buffered for tail sampling, more spans are dropped.
+CONF_Int32(max_tail_sampling_buffered_spans, "100000");
+
+// The connection type of the channels of the internal service to the other BEs: "single",
+// "pooled" or "short". Empty uses the default of brpc, which is single.
+CONF_String(brpc_connection_type, "");
+
+// The number of the channels of the internal service to each other BE, each one with its own
+// connections, which the callers get in turn. More than 1 keeps one connection from being the
+// bottleneck of the shuffles between two BEs.
+CONF_Int32(brpc_channels_per_peer, "1");
+
+// Whether the channels of the internal service break the connections of a peer with too many
+// errors or latency peaks, so that the calls to it fail fast until it recovers.
+CONF_Bool(enable_brpc_circuit_breaker, "false");
+
+// The short circuit predicates of a segment are reordered by their measured pass rate and cost
+// every this many blocks read, so that the cheap and selective ones filter the rows first.
+// 0 keeps the order of the plan.
+CONF_mInt32(adaptive_predicate_order_interval_blocks, "8");
+
+// Whether the rows of a segment deleted by the delete conditions are computed once, and cached
+// in the segment meta cache for the version of the conditions, instead of evaluating the
+// conditions on every read.
+CONF_mBool(enable_deleted_rows_cache, "true");
+
+// The scratch directories of the spilled blocks separated by ';', on dedicated disks for
+// instance. The spilled blocks are striped over the storage root paths if it is empty.
+CONF_String(spill_storage_root_path, "");
+// The max bytes of the spill files of all the queries on disk, beyond which a spill fails.
+// -1 means no limit.
+CONF_mInt64(spill_storage_limit_bytes, "-1");
+// The number of threads writing and reading ahead the spilled blocks in the background.
+CONF_Int32(spill_io_thread_num, "16");
+
+// The domain socket of the datanodes, through which the HDFS client reads the blocks on the
+// local datanode from its disks (short-circuit reads). Empty disables the short-circuit reads.
+CONF_String(hdfs_domain_socket_path, "");
+// The timeout of a read from a datanode, after which the HDFS client reads the block from the
+// next replica, so that a straggler datanode does not stall the scan. 0 keeps the default of
+// the client, an hour.
+CONF_mInt32(hdfs_read_timeout_ms, "30000");
+// The first read of a remote file after a seek fills this many bytes of the buffer of the
+// BufferedReader, and each sequential read after it doubles the bytes up to the whole buffer.
+// 0 fills the whole buffer every time.
+CONF_mInt32(remote_storage_min_read_ahead_kb, "256");
+
+// In time_series policy, a cumulative compaction merges the rowsets after the cumulative point
+// once their total disk size reaches this goal size, unit is m byte.
+CONF_mInt64(time_series_compaction_goal_size_mbytes, "1024");
+// In time_series policy, the rowsets are merged before reaching the goal size when they have
+// this number of segments.
+CONF_mInt64(time_series_compaction_file_count_threshold, "1000");
+// In time_series policy, the rowsets are merged before reaching the goal size when the oldest of
+// them was created this number of seconds ago.
+CONF_mInt64(time_series_compaction_time_threshold_seconds, "3600");
+
+// The estimated size a segment is cut at when a rowset is written, so that a segment is big enough
+// to compress well and small enough to be scanned in parallel with the other segments. It is at
+// most 230MB.
+CONF_mInt64(segment_max_size_mbytes, "230");
+// The max rows of a segment, -1 means the segments are only cut by segment_max_size_mbytes.
+CONF_mInt64(segment_max_rows, "-1");
+// The ordered compaction links the segments of its input rowsets only when they are this big on
+// average, the smaller segments are merged into segments of segment_max_size_mbytes instead.
+CONF_mInt64(ordered_compaction_min_segment_size_mbytes, "16");
+
+// Whether the right side of a vectorized AND or OR is only evaluated on the rows not decided by
+// its left side, and each branch of a case expr only on the rows not matched by the branches
+// before it.
+CONF_mBool(enable_short_circuit_evaluation, "true");
+
+// The number of tablets of a backup or restore task uploaded or downloaded at the same time.
+CONF_mInt32(snapshot_transfer_threads, "4");
+// The max speed of all the files uploaded and downloaded by the backup and restore tasks of a
+// backend together, 0 means no limit.
+CONF_mInt64(snapshot_transfer_max_speed_kbps, "0");
+
+// The number of threads building the index files of the segments linked by schema changes.
+CONF_Int32(index_build_thread_num, "2");
+// The interval of scanning the tablets for the rowsets with index files to build.
+CONF_mInt64(generate_index_build_task_interval_sec, "60");
+
+// The local() table valued function only reads the files under this path of the backend, and
+// can't read any file when it is empty.
+CONF_String(user_files_secure_path, "${DORIS_HOME}/user_files");
+
+// The max connections in the pool of an S3 client without AWS_MAX_CONN_SIZE. The clients are
+// shared by the readers of the files with the same properties.
+CONF_Int32(s3_client_max_connections, "64");
+// A read of an S3 file larger than this is split into parts of this size fetched in parallel by
+// the remote prefetch threads, 0 to disable.
+CONF_mInt64(s3_parallel_read_part_size_bytes, "4194304");
+
+// Whether the fixed-width states of sum, count, min, max and avg are passed from the
+// pre-aggregation to the merge phase as they are instead of serialized one by one. The merge
+// phase reads both formats, disable it while upgrading from the versions that only read strings.
+CONF_mBool(enable_agg_fixed_length_states, "true");
+
+// Whether the olap scan nodes tune the number of running scanners and the rows of their blocks
+// from the queue occupancy and the bytes per row they observe.
+CONF_mBool(enable_adaptive_scan_tuning, "true");
+// The bytes the adaptive scan tuning sizes the blocks of the olap scan nodes to.
+CONF_mInt64(doris_scanner_block_target_bytes, "2097152");
+
+// The number of plan fragments a BE caches by their digests, so that the FE sends only the digest
+// of a fragment it sent before. 0 disables the cache.
+CONF_Int32(fragment_template_cache_capacity, "1024");
+
 } // namespace config
 
 } // namespace doris
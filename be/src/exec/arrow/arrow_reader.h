@@ -96,6 +96,10 @@ public:
     std::shared_ptr<Statistics>& statistics() { return _statistics; }
     void close();
     virtual Status size(int64_t* size) { return Status::NotSupported("Not Implemented size"); }
+    // Reads the schema in the footer of the file, without init_reader().
+    virtual Status read_schema(std::shared_ptr<arrow::Schema>* schema) {
+        return Status::NotSupported("Not Implemented read_schema");
+    }
 
 protected:
     virtual Status column_indices(const std::vector<SlotDescriptor*>& tuple_slot_descs);
@@ -34,6 +34,22 @@ ORCReaderWrap::ORCReaderWrap(FileReader* file_reader, int64_t batch_size,
     _cur_file_eof = false;
 }
 
+Status ORCReaderWrap::read_schema(std::shared_ptr<arrow::Schema>* schema) {
+    auto maybe_reader =
+            arrow::adapters::orc::ORCFileReader::Open(_arrow_file, arrow::default_memory_pool());
+    if (!maybe_reader.ok()) {
+        LOG(WARNING) << "failed to create orc file reader, errmsg=" << maybe_reader.status();
+        return Status::InternalError("Failed to create orc file reader");
+    }
+    auto maybe_schema = maybe_reader.ValueOrDie()->ReadSchema();
+    if (!maybe_schema.ok()) {
+        LOG(WARNING) << "failed to read schema, errmsg=" << maybe_schema.status();
+        return Status::InternalError("Failed to read orc schema");
+    }
+    *schema = maybe_schema.ValueOrDie();
+    return Status::OK();
+}
+
 Status ORCReaderWrap::init_reader(const TupleDescriptor* tuple_desc,
                                   const std::vector<SlotDescriptor*>& tuple_slot_descs,
                                   const std::vector<ExprContext*>& conjunct_ctxs,
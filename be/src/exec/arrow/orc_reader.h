@@ -40,6 +40,7 @@ public:
                        const std::vector<ExprContext*>& conjunct_ctxs,
                        const std::string& timezone) override;
     Status next_batch(std::shared_ptr<arrow::RecordBatch>* batch, bool* eof) override;
+    Status read_schema(std::shared_ptr<arrow::Schema>* schema) override;
 
 private:
     Status _next_stripe_reader(bool* eof);
@@ -54,6 +54,27 @@ ParquetReaderWrap::~ParquetReaderWrap() {
     }
 }
 
+Status ParquetReaderWrap::read_schema(std::shared_ptr<arrow::Schema>* schema) {
+    try {
+        auto reader_builder = parquet::arrow::FileReaderBuilder();
+        auto st = reader_builder.Open(_arrow_file);
+        if (st.ok()) {
+            st = reader_builder.Build(&_reader);
+        }
+        if (st.ok()) {
+            st = _reader->GetSchema(schema);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to read parquet schema, errmsg=" << st.ToString();
+            return Status::InternalError("Failed to read parquet schema");
+        }
+    } catch (parquet::ParquetException& e) {
+        LOG(WARNING) << "failed to read parquet schema, errmsg=" << e.what();
+        return Status::InternalError("Failed to read parquet schema");
+    }
+    return Status::OK();
+}
+
 Status ParquetReaderWrap::init_reader(const TupleDescriptor* tuple_desc,
                                       const std::vector<SlotDescriptor*>& tuple_slot_descs,
                                       const std::vector<ExprContext*>& conjunct_ctxs,
@@ -107,7 +128,8 @@ Status ParquetReaderWrap::init_reader(const TupleDescriptor* tuple_desc,
             int64_t file_size = 0;
             size(&file_size);
             _row_group_reader.reset(new RowGroupReader(_range_start_offset, _range_size,
-                                                       conjunct_ctxs, _file_metadata, this));
+                                                       conjunct_ctxs, _file_metadata,
+                                                       _statistics.get()));
             _row_group_reader->init_filter_groups(tuple_desc, _map_column, _include_column_ids,
                                                   file_size);
         }
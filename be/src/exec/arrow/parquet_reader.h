@@ -70,6 +70,7 @@ public:
     Status read(Tuple* tuple, const std::vector<SlotDescriptor*>& tuple_slot_descs,
                 MemPool* mem_pool, bool* eof) override;
     Status size(int64_t* size) override;
+    Status read_schema(std::shared_ptr<arrow::Schema>* schema) override;
     Status init_reader(const TupleDescriptor* tuple_desc,
                        const std::vector<SlotDescriptor*>& tuple_slot_descs,
                        const std::vector<ExprContext*>& conjunct_ctxs,
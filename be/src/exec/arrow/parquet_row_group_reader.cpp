@@ -82,12 +82,12 @@ namespace doris {
 RowGroupReader::RowGroupReader(int64_t range_start_offset, int64_t range_size,
                                const std::vector<ExprContext*>& conjunct_ctxs,
                                std::shared_ptr<parquet::FileMetaData>& file_metadata,
-                               ParquetReaderWrap* parent)
+                               Statistics* statistics)
         : _range_start_offset(range_start_offset),
           _range_size(range_size),
           _conjunct_ctxs(conjunct_ctxs),
           _file_metadata(file_metadata),
-          _parent(parent) {}
+          _statistics(statistics) {}
 
 RowGroupReader::~RowGroupReader() {
     _slot_conjuncts.clear();
@@ -194,14 +194,14 @@ Status RowGroupReader::init_filter_groups(const TupleDescriptor* tuple_desc,
             }
         }
     }
-    _parent->statistics()->total_groups = total_groups;
-    _parent->statistics()->total_rows = total_rows;
-    _parent->statistics()->total_bytes = total_bytes;
+    _statistics->total_groups = total_groups;
+    _statistics->total_rows = total_rows;
+    _statistics->total_bytes = total_bytes;
 
     if (update_statistics) {
-        _parent->statistics()->filtered_row_groups = _filtered_num_row_groups;
-        _parent->statistics()->filtered_rows = _filtered_num_rows;
-        _parent->statistics()->filtered_total_bytes = _filtered_total_byte_size;
+        _statistics->filtered_row_groups = _filtered_num_row_groups;
+        _statistics->filtered_rows = _filtered_num_rows;
+        _statistics->filtered_total_bytes = _filtered_total_byte_size;
         VLOG_DEBUG << "Parquet file: " << _file_metadata->schema()->name()
                    << ", Num of read row group: " << total_group
                    << ", and num of skip row group: " << _filtered_num_row_groups;
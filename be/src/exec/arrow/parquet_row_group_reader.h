@@ -40,7 +40,7 @@ public:
     RowGroupReader(int64_t range_start_offset, int64_t range_size,
                    const std::vector<ExprContext*>& conjunct_ctxs,
                    std::shared_ptr<parquet::FileMetaData>& file_metadata,
-                   ParquetReaderWrap* parent);
+                   Statistics* statistics);
     ~RowGroupReader();
 
     Status init_filter_groups(const TupleDescriptor* tuple_desc,
@@ -91,7 +91,8 @@ private:
 
     std::vector<ExprContext*> _conjunct_ctxs;
     std::shared_ptr<parquet::FileMetaData> _file_metadata;
-    ParquetReaderWrap* _parent;
+    // the statistics of the reader, updated with the row groups filtered
+    Statistics* _statistics;
 
     int32_t _filtered_num_row_groups = 0;
     int64_t _filtered_num_rows = 0;
@@ -31,6 +31,7 @@
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/tuple.h"
+#include "util/simd/field_splitter.h"
 #include "util/string_util.h"
 #include "util/utf8_check.h"
 
@@ -259,6 +260,16 @@ void BrokerScanner::split_line(const Slice& line) {
         }
         delete row;
         delete[] ptr;
+    } else if (_value_separator_length == 1) {
+        const char* value = line.data;
+        bool trim_tailing_spaces = _state->trim_tailing_spaces_for_external_table_query();
+        simd::split_by_char(value, line.size, _value_separator[0], [&](size_t start, size_t end) {
+            // Trim tailing spaces. Be consistent with hive and trino's behavior.
+            while (trim_tailing_spaces && end > start && *(value + end - 1) == ' ') {
+                end--;
+            }
+            _split_values.emplace_back(value + start, end - start);
+        });
     } else {
         const char* value = line.data;
         size_t start = 0;     // point to the start pos of next col value.
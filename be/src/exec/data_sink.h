@@ -65,6 +65,10 @@ public:
     virtual Status send(RuntimeState* state, vectorized::Block* block) {
         return Status::NotSupported("Not support send block");
     };
+
+    // Whether the next send() would not wait for the previous sends to complete, see
+    // ExecNode::can_read().
+    virtual bool can_write() { return true; }
     // Releases all resources that were allocated in prepare()/send().
     // Further send() calls are illegal after calling close().
     // It must be okay to call this multiple times. Subsequent calls should
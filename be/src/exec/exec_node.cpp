@@ -25,6 +25,7 @@
 
 #include <sstream>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/analytic_eval_node.h"
@@ -58,7 +59,9 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "util/debug_util.h"
+#include "util/md5.h"
 #include "util/runtime_profile.h"
+#include "util/thrift_util.h"
 #include "vec/core/block.h"
 #include "vec/exec/file_scan_node.h"
 #include "vec/exec/join/vhash_join_node.h"
@@ -206,6 +209,9 @@ Status ExecNode::prepare(RuntimeState* state) {
             std::bind<int64_t>(&RuntimeProfile::units_per_second, _rows_returned_counter,
                                runtime_profile()->total_time_counter()),
             "");
+    if (state->enable_perf_counters()) {
+        _perf_counters = std::make_unique<ProfilePerfCounters>(_runtime_profile.get());
+    }
     _mem_tracker = std::make_unique<MemTracker>("ExecNode:" + _runtime_profile->name(), nullptr,
                                                 _runtime_profile.get());
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
@@ -347,6 +353,10 @@ Status ExecNode::create_tree_helper(RuntimeState* state, ObjectPool* pool,
 
     RETURN_IF_ERROR(node->init(tnode, state));
 
+    if (config::fragment_result_cache_capacity_mb > 0) {
+        RETURN_IF_ERROR(compute_plan_digest(tnode, descs, node->_children, &node->_plan_digest));
+    }
+
     // build up tree of profiles; add children >0 first, so that when we print
     // the profile, child 0 is printed last (makes the output more readable)
     for (int i = 1; i < node->_children.size(); ++i) {
@@ -360,6 +370,46 @@ Status ExecNode::create_tree_helper(RuntimeState* state, ObjectPool* pool,
     return Status::OK();
 }
 
+Status ExecNode::compute_plan_digest(const TPlanNode& tnode, const DescriptorTbl& descs,
+                                     const std::vector<ExecNode*>& children, std::string* digest) {
+    ThriftSerializer serializer(false, 1024);
+    uint32_t len = 0;
+    uint8_t* buffer = nullptr;
+    RETURN_IF_ERROR(serializer.serialize(const_cast<TPlanNode*>(&tnode), &len, &buffer));
+    Md5Digest md5;
+    md5.update(buffer, len);
+
+    std::vector<TTupleId> tuple_ids = tnode.row_tuples;
+    if (tnode.__isset.agg_node) {
+        tuple_ids.push_back(tnode.agg_node.intermediate_tuple_id);
+        tuple_ids.push_back(tnode.agg_node.output_tuple_id);
+    }
+    if (tnode.__isset.olap_scan_node) {
+        tuple_ids.push_back(tnode.olap_scan_node.tuple_id);
+    }
+    for (auto tuple_id : tuple_ids) {
+        auto* tuple_desc = descs.get_tuple_descriptor(tuple_id);
+        if (tuple_desc == nullptr) {
+            return Status::InternalError("unknown tuple id {} of plan node {}", tuple_id,
+                                         tnode.node_id);
+        }
+        std::string slots = fmt::format("tuple {}:", tuple_id);
+        for (auto* slot : tuple_desc->slots()) {
+            slots += fmt::format("[{},{},{},{},{},{}]", slot->id(), slot->col_unique_id(),
+                                 slot->col_name(), slot->type().debug_string(),
+                                 slot->is_nullable(), slot->is_materialized());
+        }
+        md5.update(slots.data(), slots.size());
+    }
+
+    for (auto* child : children) {
+        md5.update(child->_plan_digest.data(), child->_plan_digest.size());
+    }
+    md5.digest();
+    *digest = md5.hex();
+    return Status::OK();
+}
+
 Status ExecNode::create_node(RuntimeState* state, ObjectPool* pool, const TPlanNode& tnode,
                              const DescriptorTbl& descs, ExecNode** node) {
     std::stringstream error_msg;
@@ -33,6 +33,7 @@
 #include "util/blocking_queue.hpp"
 #include "util/runtime_profile.h"
 #include "util/telemetry/telemetry.h"
+#include "util/thread_perf_counters.h"
 #include "vec/exprs/vexpr_context.h"
 
 namespace doris {
@@ -105,6 +106,18 @@ public:
     virtual Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos);
     virtual Status get_next(RuntimeState* state, vectorized::Block* block, bool* eos);
 
+    // Whether the next get_next() would find its input ready instead of waiting for it. Used by
+    // the pipeline execution mode to give the thread back while a fragment is blocked. Nodes
+    // waiting on something else than their children, such as exchanges and scans, override it.
+    virtual bool can_read() {
+        for (auto child : _children) {
+            if (!child->can_read()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     // Resets the stream of row batches to be retrieved by subsequent GetNext() calls.
     // Clears all internal state, returning this node to the state it was in after calling
     // Prepare() and before calling Open(). This function must not clear memory
@@ -192,6 +205,10 @@ public:
 
     OpentelemetrySpan get_next_span() { return _get_next_span; }
 
+    // The digest of the thrift and the tuple descriptors of the node and its children, which
+    // identifies the plan of the subtree. It is only computed when the fragment result cache is enabled, empty otherwise.
+    const std::string& plan_digest() const { return _plan_digest; }
+
     // Extract node id from p->name().
     static int get_node_id_from_profile(RuntimeProfile* p);
 
@@ -295,6 +312,10 @@ protected:
     RuntimeProfile::Counter* _rows_returned_rate;
     // Account for peak memory used by this node
     RuntimeProfile::Counter* _memory_used_counter;
+    // The perf counters of the threads running this node, only when the query enables them.
+    // Counted by SCOPED_PERF_COUNTERS in get_next and in the open of the nodes building their
+    // state there.
+    std::unique_ptr<ProfilePerfCounters> _perf_counters;
 
     /// Since get_next is a frequent operation, it is not necessary to generate a span for each call
     /// to the get_next method. Therefore, the call of the get_next method in the ExecNode is
@@ -310,6 +331,8 @@ protected:
     std::mutex _exec_options_lock;
     std::string _runtime_exec_options;
 
+    std::string _plan_digest;
+
     /// Buffer pool client for this node. Initialized with the node's minimum reservation
     /// in ClaimBufferReservation(). After initialization, the client must hold onto at
     /// least the minimum reservation so that it can be returned to the initial
@@ -338,6 +361,12 @@ protected:
                                      const DescriptorTbl& descs, ExecNode* parent, int* node_idx,
                                      ExecNode** root);
 
+    // Computes the plan digest of `tnode` from its thrift, the descriptors of the tuples it uses
+    // and the digests of `children`. The slots in the thrift are only ids, so the column, type
+    // and nullability of each slot come from the descriptor table.
+    static Status compute_plan_digest(const TPlanNode& tnode, const DescriptorTbl& descs,
+                                      const std::vector<ExecNode*>& children, std::string* digest);
+
     virtual bool is_scan_node() const { return false; }
 
     void init_runtime_profile(const std::string& name);
@@ -101,8 +101,10 @@ Status MysqlScanner::query(const std::string& query) {
         mysql_free_result(_my_result);
     }
 
-    // use store result because mysql table is small, can load in memory avoid of many RPC
-    _my_result = mysql_store_result(_my_conn);
+    // use store result because mysql table is small, can load in memory avoid of many RPC, or
+    // stream the rows to convert them while the rest are still read when the table is large
+    _my_result = config::mysql_scan_use_result ? mysql_use_result(_my_conn)
+                                               : mysql_store_result(_my_conn);
 
     if (nullptr == _my_result) {
         return _error_status("mysql store result failed.");
@@ -166,6 +168,10 @@ Status MysqlScanner::get_next_row(char*** buf, unsigned long** lengths, bool* eo
     *buf = mysql_fetch_row(_my_result);
 
     if (nullptr == *buf) {
+        // a streamed result reads the rows from the connection while fetching them
+        if (0 != mysql_errno(_my_conn)) {
+            return _error_status("mysql fetch row failed.");
+        }
         *eos = true;
         return Status::OK();
     }
@@ -19,6 +19,7 @@
 
 #include <sqlext.h>
 
+#include <algorithm>
 #include <codecvt>
 
 #include "common/config.h"
@@ -48,6 +49,13 @@ static constexpr uint32_t BIG_COLUMN_SIZE_BUFFER = 65535;
 // Default max buffer size use in insert to: 50MB, normally a batch is smaller than the size
 static constexpr uint32_t INSERT_BUFFER_SIZE = 1024l * 1024 * 50;
 
+static uint32_t column_buffer_length(doris::PrimitiveType type) {
+    return (type == doris::TYPE_HLL || type == doris::TYPE_CHAR || type == doris::TYPE_VARCHAR ||
+            type == doris::TYPE_STRING)
+                   ? BIG_COLUMN_SIZE_BUFFER
+                   : SMALL_COLUMN_SIZE_BUFFER;
+}
+
 static std::u16string utf8_to_wstring(const std::string& str) {
     std::wstring_convert<std::codecvt_utf8<char16_t>, char16_t> utf8_ucs2_cvt;
     return utf8_ucs2_cvt.from_bytes(str);
@@ -148,16 +156,36 @@ Status ODBCConnector::query() {
         return Status::InternalError("input and output not equal.");
     }
 
+    // the columns are fetched in batches of rows into arrays bound by column, and the rows of a
+    // batch are bounded by the bytes of their buffers since a text column takes 64KB for each row
+    size_t row_bytes = 0;
+    for (int i = 0; i < _field_num; i++) {
+        row_bytes += column_buffer_length(_tuple_desc->slots()[i]->type().type) + sizeof(SQLLEN);
+    }
+    SQLULEN batch_rows = std::max<int64_t>(
+            1, std::min<int64_t>(config::odbc_scan_batch_rows,
+                                 config::odbc_scan_batch_bytes / std::max<size_t>(row_bytes, 1)));
+    SQLSetStmtAttr(_stmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)SQL_BIND_BY_COLUMN, 0);
+    auto rc = SQLSetStmtAttr(_stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)batch_rows, 0);
+    if (rc == SQL_SUCCESS_WITH_INFO) {
+        // the driver may change the size to the nearest one it supports
+        SQLGetStmtAttr(_stmt, SQL_ATTR_ROW_ARRAY_SIZE, &batch_rows, 0, nullptr);
+    } else if (rc != SQL_SUCCESS) {
+        batch_rows = 1;
+    }
+    batch_rows = std::max<SQLULEN>(batch_rows, 1);
+    ODBC_DISPOSE(_stmt, SQL_HANDLE_STMT,
+                 SQLSetStmtAttr(_stmt, SQL_ATTR_ROWS_FETCHED_PTR, &_fetched_rows, 0),
+                 "set rows fetched ptr");
+
     // allocate memory for the binding
     for (int i = 0; i < _field_num; i++) {
         DataBinding* column_data = new DataBinding;
         column_data->target_type = SQL_C_CHAR;
-        auto type = _tuple_desc->slots()[i]->type().type;
-        column_data->buffer_length = (type == TYPE_HLL || type == TYPE_CHAR ||
-                                      type == TYPE_VARCHAR || type == TYPE_STRING)
-                                             ? BIG_COLUMN_SIZE_BUFFER
-                                             : SMALL_COLUMN_SIZE_BUFFER;
-        column_data->target_value_ptr = malloc(sizeof(char) * column_data->buffer_length);
+        column_data->buffer_length = column_buffer_length(_tuple_desc->slots()[i]->type().type);
+        column_data->strlen_or_ind.resize(batch_rows);
+        column_data->target_value_ptr =
+                malloc(sizeof(char) * column_data->buffer_length * batch_rows);
         _columns_data.emplace_back(column_data);
     }
 
@@ -166,26 +194,46 @@ Status ODBCConnector::query() {
         ODBC_DISPOSE(_stmt, SQL_HANDLE_STMT,
                      SQLBindCol(_stmt, (SQLUSMALLINT)i + 1, _columns_data[i]->target_type,
                                 _columns_data[i]->target_value_ptr, _columns_data[i]->buffer_length,
-                                &(_columns_data[i]->strlen_or_ind)),
+                                _columns_data[i]->strlen_or_ind.data()),
                      "bind col");
     }
 
+    LOG(INFO) << "fetch " << batch_rows << " rows in a batch:" << _sql_str;
     return Status::OK();
 }
 
 Status ODBCConnector::get_next_row(bool* eos) {
+    size_t first_row = 0;
+    size_t num_rows = 0;
+    return get_next_rows(1, &first_row, &num_rows, eos);
+}
+
+Status ODBCConnector::get_next_rows(size_t max_rows, size_t* first_row, size_t* num_rows,
+                                    bool* eos) {
     if (!_is_open) {
         return Status::InternalError("GetNextRow before open.");
     }
 
-    auto ret = SQLFetch(_stmt);
-    if (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO) {
-        return Status::OK();
-    } else if (ret != SQL_NO_DATA_FOUND) {
-        return error_status("result fetch", handle_diagnostic_record(_stmt, SQL_HANDLE_STMT, ret));
+    if (_next_row >= _fetched_rows) {
+        _next_row = 0;
+        _fetched_rows = 0;
+        auto ret = SQLFetch(_stmt);
+        if (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO) {
+            // a successful fetch has at least one row, even for a driver not setting the count
+            _fetched_rows = std::max<SQLULEN>(_fetched_rows, 1);
+        } else if (ret != SQL_NO_DATA_FOUND) {
+            return error_status("result fetch",
+                                handle_diagnostic_record(_stmt, SQL_HANDLE_STMT, ret));
+        } else {
+            *num_rows = 0;
+            *eos = true;
+            return Status::OK();
+        }
     }
 
-    *eos = true;
+    *first_row = _next_row;
+    *num_rows = std::min<size_t>(max_rows, _fetched_rows - _next_row);
+    _next_row += *num_rows;
     return Status::OK();
 }
 
@@ -49,14 +49,20 @@ struct ODBCConnectorParam {
 
 // Because the DataBinding have the mem alloc, so
 // this class should not be copyable
+// The column is bound by column-wise binding: target_value_ptr holds a buffer of buffer_length
+// for each row of a fetched batch, and strlen_or_ind the length or SQL_NULL_DATA of each row.
 struct DataBinding {
     SQLSMALLINT target_type;
     SQLINTEGER buffer_length;
-    SQLLEN strlen_or_ind;
+    std::vector<SQLLEN> strlen_or_ind;
     SQLPOINTER target_value_ptr;
 
     DataBinding() = default;
 
+    char* value(size_t row) const {
+        return static_cast<char*>(target_value_ptr) + row * buffer_length;
+    }
+
     ~DataBinding() { free(target_value_ptr); }
     DataBinding(const DataBinding&) = delete;
     DataBinding& operator=(const DataBinding&) = delete;
@@ -72,6 +78,10 @@ public:
     // query for ODBC table
     Status query();
     Status get_next_row(bool* eos);
+    // Returns the next at most max_rows rows of the fetched batch in [*first_row, *first_row +
+    // *num_rows) of the column data, fetching the next batch from the driver when the rows of the
+    // last one are all returned.
+    Status get_next_rows(size_t max_rows, size_t* first_row, size_t* num_rows, bool* eos);
 
     // write for ODBC table
     Status init_to_write(RuntimeProfile* profile);
@@ -88,6 +98,8 @@ public:
     Status finish_trans(); // should be call after transaction commit
 
     const DataBinding& get_column_data(int i) const { return *_columns_data.at(i).get(); }
+    // the row of the column data returned by the last get_next_row
+    size_t current_row() const { return _next_row - 1; }
 
 private:
     void _init_profile(RuntimeProfile*);
@@ -124,6 +136,10 @@ private:
     SQLHSTMT _stmt;
 
     std::vector<std::unique_ptr<DataBinding>> _columns_data;
+    // the number of rows of the last batch fetched into _columns_data, set by the driver
+    SQLULEN _fetched_rows = 0;
+    // the first row of the last batch not returned yet
+    size_t _next_row = 0;
 };
 
 } // namespace doris
@@ -192,7 +192,8 @@ Status OdbcScanNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eo
             }
 
             const auto& column_data = _odbc_scanner->get_column_data(j);
-            if (column_data.strlen_or_ind == SQL_NULL_DATA) {
+            auto row = _odbc_scanner->current_row();
+            if (column_data.strlen_or_ind[row] == SQL_NULL_DATA) {
                 if (slot_desc->is_nullable()) {
                     _tuple->set_null(slot_desc->null_indicator_offset());
                 } else {
@@ -200,12 +201,12 @@ Status OdbcScanNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eo
                             "nonnull column contains nullptr. table={}, column={}", _table_name,
                             slot_desc->col_name());
                 }
-            } else if (column_data.strlen_or_ind > column_data.buffer_length) {
+            } else if (column_data.strlen_or_ind[row] > column_data.buffer_length) {
                 return Status::InternalError("nonnull column contains nullptr. table={}, column={}",
                                              _table_name, slot_desc->col_name());
             } else {
-                RETURN_IF_ERROR(write_text_slot(static_cast<char*>(column_data.target_value_ptr),
-                                                column_data.strlen_or_ind, slot_desc, state));
+                RETURN_IF_ERROR(write_text_slot(column_data.value(row),
+                                                column_data.strlen_or_ind[row], slot_desc, state));
             }
             j++;
         }
@@ -150,10 +150,15 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
 
     _total_pages_num_counter = ADD_COUNTER(_segment_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_segment_profile, "CachedPagesNum", TUnit::UNIT);
+    _cached_compressed_pages_num_counter =
+            ADD_COUNTER(_segment_profile, "CachedCompressedPagesNum", TUnit::UNIT);
 
     _bitmap_index_filter_counter =
             ADD_COUNTER(_segment_profile, "RowsBitmapIndexFiltered", TUnit::UNIT);
     _bitmap_index_filter_timer = ADD_TIMER(_segment_profile, "BitmapIndexFilterTimer");
+    _inverted_index_filter_counter =
+            ADD_COUNTER(_segment_profile, "RowsInvertedIndexFiltered", TUnit::UNIT);
+    _inverted_index_filter_timer = ADD_TIMER(_segment_profile, "InvertedIndexFilterTimer");
 
     _num_scanners = ADD_COUNTER(_runtime_profile, "NumScanners", TUnit::UNIT);
 
@@ -1579,6 +1584,8 @@ void OlapScanNode::transfer_thread(RuntimeState* state) {
                 task.work_function = std::bind(&OlapScanNode::scanner_thread, this, *iter);
                 task.priority = _nice;
                 task.queue_id = state->exec_env()->store_path_to_index((*iter)->scan_disk());
+                task.group_id = state->scan_task_group_id();
+                task.shares = state->scan_thread_shares();
                 (*iter)->start_wait_worker_timer();
                 COUNTER_UPDATE(_scanner_sched_counter, 1);
                 if (thread_pool->offer(task)) {
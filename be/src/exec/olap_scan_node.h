@@ -328,11 +328,15 @@ protected:
     // page read from cache
     // used by segment v2
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _cached_compressed_pages_num_counter = nullptr;
 
     // row count filtered by bitmap inverted index
     RuntimeProfile::Counter* _bitmap_index_filter_counter = nullptr;
     // time fro bitmap inverted index read and filter
     RuntimeProfile::Counter* _bitmap_index_filter_timer = nullptr;
+    // row count filtered by the inverted index of the string columns
+    RuntimeProfile::Counter* _inverted_index_filter_counter = nullptr;
+    RuntimeProfile::Counter* _inverted_index_filter_timer = nullptr;
     // number of created olap scanners
     RuntimeProfile::Counter* _num_scanners = nullptr;
 
@@ -244,6 +244,10 @@ Status OlapScanner::_init_tablet_reader_params(
 
     if (!config::disable_storage_page_cache) {
         _tablet_reader_params.use_page_cache = true;
+        _tablet_reader_params.bulk_scan =
+                config::storage_page_cache_bulk_scan_tablet_bytes >= 0 &&
+                (int64_t)_tablet->tablet_footprint() >
+                        config::storage_page_cache_bulk_scan_tablet_bytes;
     }
 
     return Status::OK();
@@ -583,9 +587,13 @@ void OlapScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_total_pages_num_counter, stats.total_pages_num);
     COUNTER_UPDATE(_parent->_cached_pages_num_counter, stats.cached_pages_num);
+    COUNTER_UPDATE(_parent->_cached_compressed_pages_num_counter,
+                   stats.cached_compressed_pages_num);
 
     COUNTER_UPDATE(_parent->_bitmap_index_filter_counter, stats.rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bitmap_index_filter_timer, stats.bitmap_index_filter_timer);
+    COUNTER_UPDATE(_parent->_inverted_index_filter_counter, stats.rows_inverted_index_filtered);
+    COUNTER_UPDATE(_parent->_inverted_index_filter_timer, stats.inverted_index_filter_timer);
     COUNTER_UPDATE(_parent->_block_seek_counter, stats.block_seek_num);
 
     COUNTER_UPDATE(_parent->_filtered_segment_counter, stats.filtered_segment_number);
@@ -20,9 +20,78 @@
 #include <orc/OrcFile.hh>
 
 #include "exec/base_scanner.h"
+#include "io/file_reader.h"
 
 namespace doris {
 
+// orc::InputStream on a FileReader, which it closes and deletes
+class ORCFileStream : public orc::InputStream {
+public:
+    ORCFileStream(FileReader* file, std::string filename)
+            : _file(file), _filename(std::move(filename)) {}
+
+    ~ORCFileStream() override {
+        if (_file != nullptr) {
+            _file->close();
+            delete _file;
+            _file = nullptr;
+        }
+    }
+
+    /**
+     * Get the total length of the file in bytes.
+     */
+    uint64_t getLength() const override { return _file->size(); }
+
+    /**
+     * Get the natural size for reads.
+     * @return the number of bytes that should be read at once
+     */
+    uint64_t getNaturalReadSize() const override { return 128 * 1024; }
+
+    /**
+     * Read length bytes from the file starting at offset into
+     * the buffer starting at buf.
+     * @param buf the starting position of a buffer.
+     * @param length the number of bytes to read.
+     * @param offset the position in the stream to read from.
+     */
+    void read(void* buf, uint64_t length, uint64_t offset) override {
+        if (buf == nullptr) {
+            throw orc::ParseError("Buffer is null");
+        }
+
+        int64_t bytes_read = 0;
+        int64_t reads = 0;
+        while (bytes_read < length) {
+            Status result = _file->readat(offset, length - bytes_read, &reads, buf);
+            if (!result.ok()) {
+                throw orc::ParseError("Bad read of " + _filename);
+            }
+            if (reads == 0) {
+                break;
+            }
+            bytes_read += reads; // total read bytes
+            offset += reads;
+            buf = (char*)buf + reads;
+        }
+        if (length != bytes_read) {
+            throw orc::ParseError("Short read of " + _filename +
+                                  ". expected :" + std::to_string(length) +
+                                  ", actual : " + std::to_string(bytes_read));
+        }
+    }
+
+    /**
+     * Get the name of the stream for error messages.
+     */
+    const std::string& getName() const override { return _filename; }
+
+private:
+    FileReader* _file;
+    std::string _filename;
+};
+
 // Broker scanner convert the data read from broker to doris's tuple.
 class ORCScanner : public BaseScanner {
 public:
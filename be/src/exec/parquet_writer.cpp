@@ -98,6 +98,11 @@ ParquetWriterWrapper::ParquetWriterWrapper(FileWriter* file_writer,
 
 void ParquetWriterWrapper::parse_properties(
         const std::map<std::string, std::string>& propertie_map) {
+    _properties = build_properties(propertie_map);
+}
+
+std::shared_ptr<parquet::WriterProperties> ParquetWriterWrapper::build_properties(
+        const std::map<std::string, std::string>& propertie_map) {
     parquet::WriterProperties::Builder builder;
     for (auto it = propertie_map.begin(); it != propertie_map.end(); it++) {
         std::string property_name = it->first;
@@ -135,10 +140,16 @@ void ParquetWriterWrapper::parse_properties(
             }
         }
     }
-    _properties = builder.build();
+    return builder.build();
 }
 
 Status ParquetWriterWrapper::parse_schema(const std::vector<std::vector<std::string>>& schema) {
+    _schema = build_schema(schema);
+    return Status::OK();
+}
+
+std::shared_ptr<parquet::schema::GroupNode> ParquetWriterWrapper::build_schema(
+        const std::vector<std::vector<std::string>>& schema) {
     parquet::schema::NodeVector fields;
     for (auto column = schema.begin(); column != schema.end(); column++) {
         std::string repetition_type = (*column)[0];
@@ -179,10 +190,9 @@ Status ParquetWriterWrapper::parse_schema(const std::vector<std::vector<std::str
         fields.push_back(parquet::schema::PrimitiveNode::Make(column_name, parquet_repetition_type,
                                                               parquet::LogicalType::None(),
                                                               parquet_data_type));
-        _schema = std::static_pointer_cast<parquet::schema::GroupNode>(
-                parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
     }
-    return Status::OK();
+    return std::static_pointer_cast<parquet::schema::GroupNode>(
+            parquet::schema::GroupNode::Make("schema", parquet::Repetition::REQUIRED, fields));
 }
 
 Status ParquetWriterWrapper::write(const RowBatch& row_batch) {
@@ -84,6 +84,12 @@ public:
 
     Status parse_schema(const std::vector<std::vector<std::string>>& schema);
 
+    // the writer properties and the schema of the output file, shared with the vectorized writer
+    static std::shared_ptr<parquet::WriterProperties> build_properties(
+            const std::map<std::string, std::string>& propertie_map);
+    static std::shared_ptr<parquet::schema::GroupNode> build_schema(
+            const std::vector<std::vector<std::string>>& schema);
+
     parquet::RowGroupWriter* get_rg_writer();
 
     int64_t written_len();
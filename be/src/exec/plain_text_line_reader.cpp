@@ -20,6 +20,7 @@
 #include "common/status.h"
 #include "exec/decompressor.h"
 #include "io/file_reader.h"
+#include "runtime/stream_load/stream_load_pipe.h"
 
 // INPUT_CHUNK must
 //  larger than 15B for correct lz4 file decompressing
@@ -64,6 +65,10 @@ PlainTextLineReader::PlainTextLineReader(RuntimeProfile* profile, FileReader* fi
     _read_timer = ADD_TIMER(_profile, "FileReadTime");
     _bytes_decompress_counter = ADD_COUNTER(_profile, "BytesDecompressed", TUnit::BYTES);
     _decompress_timer = ADD_TIMER(_profile, "DecompressTime");
+    // the lines of a multi bytes delimiter may be split inside the delimiter between two chunks
+    if (_decompressor == nullptr && _line_delimiter_length == 1) {
+        _pipe = dynamic_cast<StreamLoadPipe*>(_file_reader);
+    }
 }
 
 PlainTextLineReader::~PlainTextLineReader() {
@@ -94,6 +99,10 @@ inline bool PlainTextLineReader::update_eof() {
 uint8_t* PlainTextLineReader::update_field_pos_and_find_line_delimiter(const uint8_t* start,
                                                                        size_t len) {
     // TODO: meanwhile find and save field pos
+    if (_line_delimiter_length == 1) {
+        // memchr compares a vector of bytes at a time, which memmem does not do for a single byte
+        return (uint8_t*)memchr(start, _line_delimiter[0], len);
+    }
     return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
 }
 
@@ -187,6 +196,9 @@ Status PlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool* e
         *eof = true;
         return Status::OK();
     }
+    if (_pipe != nullptr) {
+        return read_line_from_chunks(ptr, size, eof);
+    }
     int found_line_delimiter = 0;
     size_t offset = 0;
     while (!done()) {
@@ -344,4 +356,77 @@ Status PlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool* e
     return Status::OK();
 }
 
+void PlainTextLineReader::append_to_output_buf(const uint8_t* data, size_t size) {
+    if (_output_buf_size - _output_buf_limit < size) {
+        size_t remaining = output_buf_read_remaining();
+        if (_output_buf_size - remaining >= size) {
+            memmove(_output_buf, _output_buf + _output_buf_pos, remaining);
+        } else {
+            while (_output_buf_size - remaining < size) {
+                _output_buf_size = _output_buf_size * 2;
+            }
+            uint8_t* new_output_buf = new uint8_t[_output_buf_size];
+            memmove(new_output_buf, _output_buf + _output_buf_pos, remaining);
+            delete[] _output_buf;
+            _output_buf = new_output_buf;
+        }
+        _output_buf_pos = 0;
+        _output_buf_limit = remaining;
+    }
+    memcpy(_output_buf + _output_buf_limit, data, size);
+    _output_buf_limit += size;
+}
+
+Status PlainTextLineReader::read_line_from_chunks(const uint8_t** ptr, size_t* size, bool* eof) {
+    // the line returned last time is consumed
+    _output_buf_pos = 0;
+    _output_buf_limit = 0;
+    while (true) {
+        if (_chunk != nullptr && _chunk->has_remaining()) {
+            const uint8_t* start = reinterpret_cast<const uint8_t*>(_chunk->ptr) + _chunk->pos;
+            size_t len = _chunk->remaining();
+            const uint8_t* pos = update_field_pos_and_find_line_delimiter(start, len);
+            if (pos != nullptr) {
+                size_t line_len = pos - start;
+                _chunk->pos += line_len + 1;
+                if (_output_buf_limit == 0) {
+                    // the line is returned in place, the chunk is kept until the next read
+                    *ptr = start;
+                    *size = line_len;
+                } else {
+                    append_to_output_buf(start, line_len);
+                    *ptr = _output_buf;
+                    *size = _output_buf_limit;
+                }
+                *eof = false;
+                _total_read_bytes += *size + 1;
+                return Status::OK();
+            }
+            // the rest of the line is in the next chunk
+            append_to_output_buf(start, len);
+            _chunk->pos = _chunk->limit;
+        }
+
+        bool chunk_eof = false;
+        {
+            SCOPED_TIMER(_read_timer);
+            RETURN_IF_ERROR(_pipe->read_chunk(&_chunk, &chunk_eof));
+        }
+        if (chunk_eof) {
+            _chunk.reset();
+            _file_eof = true;
+            // the last line without a delimiter
+            *ptr = _output_buf;
+            *size = _output_buf_limit;
+            *eof = _output_buf_limit == 0;
+            _total_read_bytes += *size;
+            if (*eof) {
+                _eof = true;
+            }
+            return Status::OK();
+        }
+        COUNTER_UPDATE(_bytes_read_counter, _chunk->remaining());
+    }
+}
+
 } // namespace doris
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "exec/line_reader.h"
+#include "util/byte_buffer.h"
 #include "util/runtime_profile.h"
 
 namespace doris {
@@ -25,6 +26,7 @@ namespace doris {
 class FileReader;
 class Decompressor;
 class Status;
+class StreamLoadPipe;
 
 class PlainTextLineReader : public LineReader {
 public:
@@ -56,6 +58,11 @@ private:
     void extend_input_buf();
     void extend_output_buf();
 
+    // read a line from the chunks of a stream load pipe, which are parsed in place: only a line
+    // split between two chunks is copied, into the output buf
+    Status read_line_from_chunks(const uint8_t** ptr, size_t* size, bool* eof);
+    void append_to_output_buf(const uint8_t* data, size_t size);
+
 private:
     RuntimeProfile* _profile;
     FileReader* _file_reader;
@@ -77,6 +84,10 @@ private:
     size_t _output_buf_pos;
     size_t _output_buf_limit;
 
+    // set when the lines are read from the chunks of an uncompressed stream load
+    StreamLoadPipe* _pipe = nullptr;
+    ByteBufferPtr _chunk;
+
     bool _file_eof;
     bool _eof;
     bool _stream_end;
@@ -40,6 +40,9 @@ Status OlapTableSchemaParam::init(const POlapTableSchemaParam& pschema) {
     _db_id = pschema.db_id();
     _table_id = pschema.table_id();
     _version = pschema.version();
+    _is_partial_update = pschema.partial_update();
+    _partial_update_input_columns.insert(pschema.partial_update_input_columns().begin(),
+                                         pschema.partial_update_input_columns().end());
     std::map<std::string, SlotDescriptor*> slots_map;
     _tuple_desc = _obj_pool.add(new TupleDescriptor(pschema.tuple_desc()));
 
@@ -79,6 +82,11 @@ Status OlapTableSchemaParam::init(const TOlapTableSchemaParam& tschema) {
     _db_id = tschema.db_id;
     _table_id = tschema.table_id;
     _version = tschema.version;
+    _is_partial_update = tschema.__isset.is_partial_update && tschema.is_partial_update;
+    if (tschema.__isset.partial_update_input_columns) {
+        _partial_update_input_columns.insert(tschema.partial_update_input_columns.begin(),
+                                             tschema.partial_update_input_columns.end());
+    }
     std::map<std::string, SlotDescriptor*> slots_map;
     _tuple_desc = _obj_pool.add(new TupleDescriptor(tschema.tuple_desc));
     for (auto& t_slot_desc : tschema.slot_descs) {
@@ -117,6 +125,10 @@ void OlapTableSchemaParam::to_protobuf(POlapTableSchemaParam* pschema) const {
     pschema->set_db_id(_db_id);
     pschema->set_table_id(_table_id);
     pschema->set_version(_version);
+    pschema->set_partial_update(_is_partial_update);
+    for (const auto& column : _partial_update_input_columns) {
+        pschema->add_partial_update_input_columns(column);
+    }
     _tuple_desc->to_protobuf(pschema->mutable_tuple_desc());
     for (auto slot : _tuple_desc->slots()) {
         slot->to_protobuf(pschema->add_slot_descs());
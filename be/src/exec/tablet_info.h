@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -62,6 +63,11 @@ public:
     TupleDescriptor* tuple_desc() const { return _tuple_desc; }
     const std::vector<OlapTableIndexSchema*>& indexes() const { return _indexes; }
 
+    bool is_partial_update() const { return _is_partial_update; }
+    const std::set<std::string>& partial_update_input_columns() const {
+        return _partial_update_input_columns;
+    }
+
     void to_protobuf(POlapTableSchemaParam* pschema) const;
 
     // NOTE: this function is not thread-safe.
@@ -83,6 +89,8 @@ private:
     TupleDescriptor* _tuple_desc = nullptr;
     mutable POlapTableSchemaParam* _proto_schema = nullptr;
     std::vector<OlapTableIndexSchema*> _indexes;
+    bool _is_partial_update = false;
+    std::set<std::string> _partial_update_input_columns;
     mutable ObjectPool _obj_pool;
 };
 
@@ -123,10 +123,18 @@ void NodeChannel::open() {
     request.set_index_id(_index_channel->_index_id);
     request.set_txn_id(_parent->_txn_id);
     request.set_allocated_schema(_parent->_schema->to_protobuf());
+    std::set<int64_t> slave_node_ids;
     for (auto& tablet : _all_tablets) {
         auto ptablet = request.add_tablets();
         ptablet->set_partition_id(tablet.partition_id);
         ptablet->set_tablet_id(tablet.tablet_id);
+        auto it = _slave_tablet_nodes.find(tablet.tablet_id);
+        if (it != _slave_tablet_nodes.end()) {
+            for (auto node_id : it->second) {
+                ptablet->add_slave_node_ids(node_id);
+                slave_node_ids.insert(node_id);
+            }
+        }
     }
     request.set_num_senders(_parent->_num_senders);
     request.set_need_gen_rollup(false); // Useless but it is a required field in pb
@@ -135,6 +143,22 @@ void NodeChannel::open() {
     request.set_is_high_priority(_parent->_is_high_priority);
     request.set_sender_ip(BackendOptions::get_localhost());
     request.set_is_vectorized(_is_vectorized);
+    if (_parent->_is_single_replica_load) {
+        request.set_is_single_replica_load(true);
+        for (auto node_id : slave_node_ids) {
+            const NodeInfo* node = _parent->_nodes_info->find_node(node_id);
+            if (node == nullptr) {
+                // the replica just does not pull the rowset, and FE judges the quorum
+                LOG(WARNING) << "unknown slave replica node, node_id=" << node_id << ", "
+                             << channel_info();
+                continue;
+            }
+            auto pnode = request.add_slave_nodes();
+            pnode->set_id(node->id);
+            pnode->set_host(node->host);
+            pnode->set_async_internal_port(node->brpc_port);
+        }
+    }
 
     _open_closure = new RefCountClosure<PTabletWriterOpenResult>();
     _open_closure->ref();
@@ -237,7 +261,8 @@ Status NodeChannel::open_wait() {
                     for (auto& tablet : result.tablet_vec()) {
                         TTabletCommitInfo commit_info;
                         commit_info.tabletId = tablet.tablet_id();
-                        commit_info.backendId = _node_id;
+                        // set for the slave replicas in single replica load
+                        commit_info.backendId = tablet.has_node_id() ? tablet.node_id() : _node_id;
                         _tablet_commit_infos.emplace_back(std::move(commit_info));
                     }
                     _add_batches_finished = true;
@@ -589,6 +614,13 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
             channel->add_tablet(tablet);
             channels.push_back(channel);
             _tablets_by_channel[node_id].insert(tablet.tablet_id);
+            if (_parent->_is_single_replica_load) {
+                // the other replicas pull the rowset written by the first one
+                channel->add_slave_tablet_nodes(
+                        tablet.tablet_id, std::vector<int64_t>(location->node_ids.begin() + 1,
+                                                               location->node_ids.end()));
+                break;
+            }
         }
         _channels_by_tablet.emplace(tablet.tablet_id, std::move(channels));
     }
@@ -606,13 +638,16 @@ void IndexChannel::mark_as_failed(int64_t node_id, const std::string& host, cons
         return;
     }
 
+    // in single replica load, none of the replicas gets the rows if the only channel fails
+    size_t max_failed_replicas =
+            _parent->_is_single_replica_load ? 1 : (_parent->_num_replicas + 1) / 2;
     {
         std::lock_guard<SpinLock> l(_fail_lock);
         if (tablet_id == -1) {
             for (const auto the_tablet_id : it->second) {
                 _failed_channels[the_tablet_id].insert(node_id);
                 _failed_channels_msgs.emplace(the_tablet_id, err + ", host: " + host);
-                if (_failed_channels[the_tablet_id].size() >= ((_parent->_num_replicas + 1) / 2)) {
+                if (_failed_channels[the_tablet_id].size() >= max_failed_replicas) {
                     _intolerable_failure_status =
                             Status::InternalError(_failed_channels_msgs[the_tablet_id]);
                 }
@@ -620,7 +655,7 @@ void IndexChannel::mark_as_failed(int64_t node_id, const std::string& host, cons
         } else {
             _failed_channels[tablet_id].insert(node_id);
             _failed_channels_msgs.emplace(tablet_id, err + ", host: " + host);
-            if (_failed_channels[tablet_id].size() >= ((_parent->_num_replicas + 1) / 2)) {
+            if (_failed_channels[tablet_id].size() >= max_failed_replicas) {
                 _intolerable_failure_status =
                         Status::InternalError(_failed_channels_msgs[tablet_id]);
             }
@@ -679,6 +714,7 @@ Status OlapTableSink::init(const TDataSink& t_sink) {
     _load_id.set_lo(table_sink.load_id.lo);
     _txn_id = table_sink.txn_id;
     _num_replicas = table_sink.num_replicas;
+    _is_single_replica_load = config::enable_single_replica_load && _num_replicas > 1;
     _tuple_desc_id = table_sink.tuple_id;
     _schema.reset(new OlapTableSchemaParam());
     RETURN_IF_ERROR(_schema->init(table_sink.schema));
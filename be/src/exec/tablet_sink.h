@@ -172,6 +172,12 @@ public:
     // called before open, used to add tablet located in this backend
     void add_tablet(const TTabletWithPartition& tablet) { _all_tablets.emplace_back(tablet); }
 
+    // called before open, used to add the backends of the other replicas of a tablet, which
+    // pull the rowset written by this backend in single replica load
+    void add_slave_tablet_nodes(int64_t tablet_id, const std::vector<int64_t>& slave_nodes) {
+        _slave_tablet_nodes[tablet_id] = slave_nodes;
+    }
+
     virtual Status init(RuntimeState* state);
 
     // we use open/open_wait to parallel
@@ -287,6 +293,8 @@ protected:
     RefCountClosure<PTabletWriterOpenResult>* _open_closure = nullptr;
 
     std::vector<TTabletWithPartition> _all_tablets;
+    // tablet_id -> backends of the slave replicas
+    std::unordered_map<int64_t, std::vector<int64_t>> _slave_tablet_nodes;
     std::vector<TTabletCommitInfo> _tablet_commit_infos;
 
     AddBatchCounter _add_batch_counter;
@@ -473,6 +481,8 @@ protected:
     int _sender_id = -1;
     int _num_senders = -1;
     bool _is_high_priority = false;
+    // the rows are only sent to the first replica of every tablet, see enable_single_replica_load
+    bool _is_single_replica_load = false;
 
     // TODO(zc): think about cache this data
     std::shared_ptr<OlapTableSchemaParam> _schema;
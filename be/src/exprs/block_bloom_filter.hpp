@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "common/status.h"
 #include "gutil/macros.h"
 #include "util/hash_util.hpp"
@@ -73,6 +75,33 @@ public:
         }
     }
 
+    // Finds the 'num' keys of 'KeySize' bytes laid out one after another from 'keys', and writes
+    // whether each one is found to 'results'. The keys whose 'null_map' entry is set are not
+    // found, 'null_map' may be null. Hashing the keys of a fixed size is inlined, and the
+    // buckets are probed by find_hashes().
+    template <size_t KeySize>
+    void find_batch(const char* keys, const uint8_t* null_map, size_t num,
+                    uint8_t* results) const noexcept {
+        uint32_t hashes[kFindBatchSize];
+        for (size_t offset = 0; offset < num; offset += kFindBatchSize) {
+            const size_t batch_size = std::min(kFindBatchSize, num - offset);
+            const char* batch_keys = keys + offset * KeySize;
+            for (size_t i = 0; i < batch_size; ++i) {
+                hashes[i] = HashUtil::murmur_hash3_32(batch_keys + i * KeySize, KeySize,
+                                                      _hash_seed);
+            }
+            find_hashes(hashes, batch_size, results + offset);
+        }
+        if (null_map != nullptr) {
+            for (size_t i = 0; i < num; ++i) {
+                results[i] &= !null_map[i];
+            }
+        }
+    }
+
+    // Same as find() for each of the 'num' hashes, the results are written to 'results'.
+    void find_hashes(const uint32_t* hashes, size_t num, uint8_t* results) const noexcept;
+
     // Computes the logical OR of this filter with 'other' and stores the result in this
     // filter.
     // Notes:
@@ -124,6 +153,12 @@ private:
 
     typedef BucketWord Bucket[kBucketWords];
 
+    // The number of keys hashed at a time by find_batch().
+    static constexpr size_t kFindBatchSize = 256;
+    // How many keys ahead find_hashes() prefetches the bucket of, so that the cache misses on
+    // a large directory overlap.
+    static constexpr size_t kFindPrefetchDistance = 16;
+
     // log_num_buckets_ is the log (base 2) of the number of buckets in the directory.
     int _log_num_buckets;
 
@@ -148,6 +183,10 @@ private:
 
     bool bucket_find(uint32_t bucket_idx, uint32_t hash) const noexcept;
 
+    void prefetch_bucket(uint32_t hash) const noexcept {
+        __builtin_prefetch(&_directory[rehash32to32(hash) & _directory_mask]);
+    }
+
     // Computes out[i] |= in[i] for the arrays 'in' and 'out' of length 'n' without using AVX2
     // operations.
     static void or_equal_array_no_avx2(size_t n, const uint8_t* __restrict__ in,
@@ -169,6 +208,10 @@ private:
     bool bucket_find_avx2(uint32_t bucket_idx, uint32_t hash) const noexcept
             __attribute__((__target__("avx2")));
 
+    // Same as find_hashes(), but assumes that AVX2 is available.
+    void find_hashes_avx2(const uint32_t* hashes, size_t num, uint8_t* results) const noexcept
+            __attribute__((__target__("avx2")));
+
     // Computes out[i] |= in[i] for the arrays 'in' and 'out' of length 'n' using AVX2
     // instructions. 'n' must be a multiple of 32.
     static void or_equal_array_avx2(size_t n, const uint8_t* __restrict__ in,
@@ -61,6 +61,20 @@ bool BlockBloomFilter::bucket_find_avx2(const uint32_t bucket_idx,
     return result;
 }
 
+void BlockBloomFilter::find_hashes_avx2(const uint32_t* hashes, size_t num,
+                                        uint8_t* results) const noexcept {
+    const __m256i* const directory = reinterpret_cast<const __m256i*>(_directory);
+    for (size_t i = 0; i < num; ++i) {
+        if (i + kFindPrefetchDistance < num) {
+            prefetch_bucket(hashes[i + kFindPrefetchDistance]);
+        }
+        const uint32_t bucket_idx = rehash32to32(hashes[i]) & _directory_mask;
+        results[i] = _mm256_testc_si256(directory[bucket_idx], make_mark(hashes[i]));
+    }
+    // Unset the high bits once for the whole batch rather than after each key.
+    _mm256_zeroupper();
+}
+
 void BlockBloomFilter::insert_avx2(const uint32_t hash) noexcept {
     _always_false = false;
     const uint32_t bucket_idx = rehash32to32(hash) & _directory_mask;
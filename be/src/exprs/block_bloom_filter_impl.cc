@@ -171,6 +171,25 @@ bool BlockBloomFilter::find(const uint32_t hash) const noexcept {
 #endif
 }
 
+void BlockBloomFilter::find_hashes(const uint32_t* hashes, size_t num,
+                                   uint8_t* results) const noexcept {
+    if (_always_false) {
+        memset(results, 0, num);
+        return;
+    }
+#ifdef __AVX2__
+    find_hashes_avx2(hashes, num, results);
+#else
+    for (size_t i = 0; i < num; ++i) {
+        if (i + kFindPrefetchDistance < num) {
+            prefetch_bucket(hashes[i + kFindPrefetchDistance]);
+        }
+        const uint32_t bucket_idx = rehash32to32(hashes[i]) & _directory_mask;
+        results[i] = bucket_find(bucket_idx, hashes[i]);
+    }
+#endif
+}
+
 void BlockBloomFilter::or_equal_array_internal(size_t n, const uint8_t* __restrict__ in,
                                                uint8_t* __restrict__ out) {
 #ifdef __AVX2__
@@ -63,6 +63,12 @@ public:
         return _bloom_filter->find(data);
     }
 
+    template <size_t KeySize>
+    void test_batch(const char* data, const uint8_t* null_map, size_t num,
+                    uint8_t* results) const {
+        _bloom_filter->find_batch<KeySize>(data, null_map, num, results);
+    }
+
     void add_bytes(const char* data, size_t len) { _bloom_filter->insert(Slice(data, len)); }
 
 private:
@@ -82,6 +88,11 @@ public:
     virtual bool find(const void* data) const = 0;
     virtual bool find_olap_engine(const void* data) const = 0;
     virtual bool find_uint32_t(uint32_t data) const = 0;
+    // Find the 'num' values stored one after another from 'data' at once, as laid out in a
+    // vectorized column of the type. A value is not found if its 'null_map' entry is set,
+    // 'null_map' may be null.
+    virtual void find_fixed_len(const char* data, const uint8_t* null_map, size_t num,
+                                uint8_t* results) const = 0;
 
     virtual Status merge(IBloomFilterFuncBase* bloomfilter_func) = 0;
     virtual Status assign(const char* data, int len) = 0;
@@ -169,6 +180,10 @@ struct CommonFindOp {
     ALWAYS_INLINE bool find(const BloomFilterAdaptor& bloom_filter, uint32_t data) const {
         return bloom_filter.test(data);
     }
+    void find_fixed_len(const BloomFilterAdaptor& bloom_filter, const char* data,
+                        const uint8_t* null_map, size_t num, uint8_t* results) const {
+        bloom_filter.template test_batch<sizeof(T)>(data, null_map, num, results);
+    }
 };
 
 template <class BloomFilterAdaptor>
@@ -193,6 +208,15 @@ struct StringFindOp {
     ALWAYS_INLINE bool find(const BloomFilterAdaptor& bloom_filter, uint32_t data) const {
         return bloom_filter.test(data);
     }
+    // 'data' points to an array of StringValue
+    void find_fixed_len(const BloomFilterAdaptor& bloom_filter, const char* data,
+                        const uint8_t* null_map, size_t num, uint8_t* results) const {
+        const auto* values = reinterpret_cast<const StringValue*>(data);
+        for (size_t i = 0; i < num; ++i) {
+            results[i] = (null_map == nullptr || !null_map[i]) &&
+                         StringFindOp::find(bloom_filter, &values[i]);
+        }
+    }
 };
 
 // We do not need to judge whether data is empty, because null will not appear
@@ -328,6 +352,12 @@ public:
         return dummy.find(*this->_bloom_filter, data);
     }
 
+    void find_fixed_len(const char* data, const uint8_t* null_map, size_t num,
+                        uint8_t* results) const override {
+        DCHECK(this->_bloom_filter != nullptr);
+        dummy.find_fixed_len(*this->_bloom_filter, data, null_map, num, results);
+    }
+
 private:
     typename BloomFilterTypeTraits<type, BloomFilterAdaptor>::FindOp dummy;
 };
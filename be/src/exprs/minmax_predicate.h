@@ -78,23 +78,24 @@ public:
     }
 
     Status merge(MinMaxFuncBase* minmax_func, ObjectPool* pool) override {
+        MinMaxNumFunc<T>* other_minmax = static_cast<MinMaxNumFunc<T>*>(minmax_func);
+        if (other_minmax->_empty) {
+            return Status::OK();
+        }
         if constexpr (std::is_same_v<T, StringValue>) {
-            MinMaxNumFunc<T>* other_minmax = static_cast<MinMaxNumFunc<T>*>(minmax_func);
-
-            if (other_minmax->_min < _min) {
+            if (_empty || other_minmax->_min < _min) {
                 auto& other_min = other_minmax->_min;
                 auto str = pool->add(new std::string(other_min.ptr, other_min.len));
                 _min.ptr = str->data();
                 _min.len = str->length();
             }
-            if (other_minmax->_max > _max) {
+            if (_empty || other_minmax->_max > _max) {
                 auto& other_max = other_minmax->_max;
                 auto str = pool->add(new std::string(other_max.ptr, other_max.len));
                 _max.ptr = str->data();
                 _max.len = str->length();
             }
         } else {
-            MinMaxNumFunc<T>* other_minmax = static_cast<MinMaxNumFunc<T>*>(minmax_func);
             if (other_minmax->_min < _min) {
                 _min = other_minmax->_min;
             }
@@ -102,6 +103,8 @@ public:
                 _max = other_minmax->_max;
             }
         }
+        // Later inserts compare with the merged range instead of overwriting it.
+        _empty = false;
 
         return Status::OK();
     }
@@ -115,6 +118,8 @@ public:
     Status assign(void* min_data, void* max_data) override {
         _min = *(T*)min_data;
         _max = *(T*)max_data;
+        // The range of a filter without any value is assigned as [type max, type min].
+        _empty = _max < _min;
         return Status::OK();
     }
 
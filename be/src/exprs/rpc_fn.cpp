@@ -19,6 +19,7 @@
 
 #include <fmt/format.h>
 
+#include "common/config.h"
 #include "exprs/rpc_fn_comm.h"
 #include "runtime/fragment_mgr.h"
 #include "util/brpc_client_cache.h"
@@ -33,10 +34,11 @@ namespace doris {
 
 RPCFn::RPCFn(RuntimeState* state, const TFunction& fn, int fn_ctx_id, bool is_agg)
         : _state(state), _fn(fn), _fn_ctx_id(fn_ctx_id), _is_agg(is_agg) {
+    _server_addr = _fn.hdfs_location;
+    // the stubs of a server share the channel that the cache keeps for its address
     _client = ExecEnv::GetInstance()->brpc_function_client_cache()->get_client(_server_addr);
     if (!_is_agg) {
         _function_name = _fn.scalar_fn.symbol;
-        _server_addr = _fn.hdfs_location;
         _signature = fmt::format("{}: [{}/{}]", _fn.name.function_name, _fn.hdfs_location,
                                  _fn.scalar_fn.symbol);
     }
@@ -253,6 +255,10 @@ void RPCFn::cancel(const std::string& msg) {
 Status RPCFn::vec_call(FunctionContext* context, vectorized::Block& block,
                        const vectorized::ColumnNumbers& arguments, size_t result,
                        size_t input_rows_count) {
+    const size_t batch_rows = config::rpc_udf_batch_rows;
+    if (batch_rows > 0 && input_rows_count > batch_rows) {
+        return _vec_call_in_batches(block, arguments, result, input_rows_count, batch_rows);
+    }
     PFunctionCallRequest request;
     PFunctionCallResponse response;
     request.set_function_name(_function_name);
@@ -274,4 +280,64 @@ Status RPCFn::vec_call(FunctionContext* context, vectorized::Block& block,
     convert_to_block(block, response.result(0), result);
     return Status::OK();
 }
+
+Status RPCFn::_check_response(const brpc::Controller& cntl,
+                              const PFunctionCallResponse& response) {
+    if (cntl.Failed()) {
+        return Status::InternalError("call to rpc function {} failed: {}", _signature,
+                                     cntl.ErrorText());
+    }
+    if (!response.has_status() || response.result_size() == 0) {
+        return Status::InternalError("call rpc function {} failed: status or result is not set.",
+                                     _signature);
+    }
+    if (response.status().status_code() != 0) {
+        return Status::InternalError("call to rpc function {} failed: {}", _signature,
+                                     response.status().DebugString());
+    }
+    return Status::OK();
+}
+
+Status RPCFn::_vec_call_in_batches(vectorized::Block& block,
+                                   const vectorized::ColumnNumbers& arguments, size_t result,
+                                   size_t input_rows_count, size_t batch_rows) {
+    struct BatchCall {
+        PFunctionCallRequest request;
+        PFunctionCallResponse response;
+        brpc::Controller cntl;
+    };
+    const size_t num_batches = (input_rows_count + batch_rows - 1) / batch_rows;
+    const size_t max_inflight = std::max(config::rpc_udf_max_inflight_batches, 1);
+    std::vector<std::unique_ptr<BatchCall>> calls(num_batches);
+    // the calls are sent asynchronously, with at most max_inflight of them at once
+    for (size_t i = 0; i < num_batches; ++i) {
+        if (i >= max_inflight) {
+            brpc::Join(calls[i - max_inflight]->cntl.call_id());
+        }
+        calls[i] = std::make_unique<BatchCall>();
+        calls[i]->request.set_function_name(_function_name);
+        convert_block_to_proto(block, arguments, i * batch_rows,
+                               std::min((i + 1) * batch_rows, input_rows_count),
+                               &calls[i]->request);
+        _client->fn_call(&calls[i]->cntl, &calls[i]->request, &calls[i]->response,
+                         brpc::DoNothing());
+    }
+    for (const auto& call : calls) {
+        // returns at once for the calls that are already joined
+        brpc::Join(call->cntl.call_id());
+    }
+
+    const auto& result_type = block.get_data_type(result);
+    auto result_column = result_type->create_column();
+    result_column->reserve(input_rows_count);
+    for (const auto& call : calls) {
+        RETURN_IF_ERROR(_check_response(call->cntl, call->response));
+        vectorized::Block batch_block({{result_type->create_column(), result_type, ""}});
+        convert_to_block(batch_block, call->response.result(0), 0);
+        const auto& batch_column = batch_block.get_by_position(0).column;
+        result_column->insert_range_from(*batch_column, 0, batch_column->size());
+    }
+    block.replace_by_position(result, std::move(result_column));
+    return Status::OK();
+}
 } // namespace doris
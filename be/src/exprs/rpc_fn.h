@@ -60,6 +60,11 @@ private:
     Status call_internal(ExprContext* context, TupleRow* row, PFunctionCallResponse* response,
                          const std::vector<Expr*>& exprs);
     void cancel(const std::string& msg);
+    Status _check_response(const brpc::Controller& cntl, const PFunctionCallResponse& response);
+    // sends the rows in batches of batch_rows, with several of them in flight at once, so that a
+    // server that handles the calls concurrently is not waited on one batch at a time
+    Status _vec_call_in_batches(vectorized::Block& block, const std::vector<size_t>& arguments,
+                                size_t result, size_t input_rows_count, size_t batch_rows);
 
     std::shared_ptr<PFunctionService_Stub> _client;
     RuntimeState* _state;
@@ -22,11 +22,10 @@ void convert_nullable_col_to_pvalue(const vectorized::ColumnPtr& column,
                                     const vectorized::ColumnUInt8& null_col, PValues* arg,
                                     int start, int end) {
     int row_count = end - start;
-    if (column->has_null(row_count)) {
+    const auto& data = null_col.get_data();
+    if (std::find(data.begin() + start, data.begin() + end, 1) != data.begin() + end) {
         auto* null_map = arg->mutable_null_map();
         null_map->Reserve(row_count);
-        const auto* col = vectorized::check_and_get_column<vectorized::ColumnUInt8>(null_col);
-        auto& data = col->get_data();
         null_map->Add(data.begin() + start, data.begin() + end);
         convert_col_to_pvalue<true>(column, data_type, arg, start, end);
     } else {
@@ -37,22 +36,30 @@ void convert_nullable_col_to_pvalue(const vectorized::ColumnPtr& column,
 void convert_block_to_proto(vectorized::Block& block, const vectorized::ColumnNumbers& arguments,
                             size_t input_rows_count, PFunctionCallRequest* request) {
     size_t row_count = std::min(block.rows(), input_rows_count);
+    convert_block_to_proto(block, arguments, 0, row_count, request);
+}
+
+void convert_block_to_proto(vectorized::Block& block, const vectorized::ColumnNumbers& arguments,
+                            size_t start, size_t end, PFunctionCallRequest* request) {
     for (size_t col_idx : arguments) {
         PValues* arg = request->add_args();
         vectorized::ColumnWithTypeAndName& column = block.get_by_position(col_idx);
-        arg->set_has_null(column.column->has_null(row_count));
         auto col = column.column->convert_to_full_column_if_const();
         if (auto* nullable =
                     vectorized::check_and_get_column<const vectorized::ColumnNullable>(*col)) {
             auto data_col = nullable->get_nested_column_ptr();
             auto& null_col = nullable->get_null_map_column();
+            const auto& null_map = null_col.get_data();
+            arg->set_has_null(std::find(null_map.begin() + start, null_map.begin() + end, 1) !=
+                              null_map.begin() + end);
             auto data_type =
                     std::reinterpret_pointer_cast<const vectorized::DataTypeNullable>(column.type);
             convert_nullable_col_to_pvalue(data_col->convert_to_full_column_if_const(),
-                                           data_type->get_nested_type(), null_col, arg, 0,
-                                           row_count);
+                                           data_type->get_nested_type(), null_col, arg, start,
+                                           end);
         } else {
-            convert_col_to_pvalue<false>(col, column.type, arg, 0, row_count);
+            arg->set_has_null(false);
+            convert_col_to_pvalue<false>(col, column.type, arg, start, end);
         }
     }
 }
@@ -453,6 +453,10 @@ void convert_nullable_col_to_pvalue(const vectorized::ColumnPtr& column,
 void convert_block_to_proto(vectorized::Block& block, const vectorized::ColumnNumbers& arguments,
                             size_t input_rows_count, PFunctionCallRequest* request);
 
+// converts the rows [start, end) of the arguments
+void convert_block_to_proto(vectorized::Block& block, const vectorized::ColumnNumbers& arguments,
+                            size_t start, size_t end, PFunctionCallRequest* request);
+
 void convert_to_block(vectorized::Block& block, const PValues& result, size_t pos);
 
 } // namespace doris::vectorized
@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exprs/binary_predicate.h"
@@ -421,11 +422,13 @@ public:
         }
         case RuntimeFilterType::BLOOM_FILTER: {
             _is_bloomfilter = true;
+            _init_bloom_filter_range();
             _bloomfilter_func.reset(create_bloom_filter(_column_return_type));
             return _bloomfilter_func->init_with_fixed_length(params->bloom_filter_size);
         }
         case RuntimeFilterType::IN_OR_BLOOM_FILTER: {
             _hybrid_set.reset(create_set(_column_return_type));
+            _init_bloom_filter_range();
             _bloomfilter_func.reset(create_bloom_filter(_column_return_type));
             return _bloomfilter_func->init_with_fixed_length(params->bloom_filter_size);
         }
@@ -443,7 +446,7 @@ public:
         if (_hybrid_set->size() > 0) {
             auto it = _hybrid_set->begin();
             while (it->has_next()) {
-                _bloomfilter_func->insert(it->get_value());
+                _insert_bloom_filter(it->get_value());
                 it->next();
             }
             // release in filter
@@ -465,12 +468,12 @@ public:
             break;
         }
         case RuntimeFilterType::BLOOM_FILTER: {
-            _bloomfilter_func->insert(data);
+            _insert_bloom_filter(data);
             break;
         }
         case RuntimeFilterType::IN_OR_BLOOM_FILTER: {
             if (_is_bloomfilter) {
-                _bloomfilter_func->insert(data);
+                _insert_bloom_filter(data);
             } else {
                 _hybrid_set->insert(data);
             }
@@ -582,7 +585,7 @@ public:
             break;
         }
         case RuntimeFilterType::BLOOM_FILTER: {
-            _bloomfilter_func->merge(wrapper->_bloomfilter_func.get());
+            _merge_bloom_filter(wrapper);
             break;
         }
         case RuntimeFilterType::IN_OR_BLOOM_FILTER: {
@@ -609,7 +612,7 @@ public:
                                << " change runtime filter to bloom filter(id=" << _filter_id
                                << ") because: already exist a bloom filter";
                     change_to_bloom_filter();
-                    _bloomfilter_func->merge(wrapper->_bloomfilter_func.get());
+                    _merge_bloom_filter(wrapper);
                 }
             } else {
                 if (wrapper->_filter_type ==
@@ -622,12 +625,12 @@ public:
                     auto it = wrapper->_hybrid_set->begin();
                     while (it->has_next()) {
                         auto value = it->get_value();
-                        _bloomfilter_func->insert(value);
+                        _insert_bloom_filter(value);
                         it->next();
                     }
                     // bloom filter merge bloom filter
                 } else {
-                    _bloomfilter_func->merge(wrapper->_bloomfilter_func.get());
+                    _merge_bloom_filter(wrapper);
                 }
             }
             break;
@@ -963,6 +966,9 @@ public:
 
     std::string* get_ignored_in_filter_msg() const { return _ignored_in_filter_msg; }
 
+    // Whether a bloom filter also knows the range of its values.
+    bool has_bloom_filter_range() const { return _is_bloomfilter && _minmax_func != nullptr; }
+
     void batch_assign(const PInFilter* filter,
                       void (*assign_func)(std::unique_ptr<HybridSetBase>& _hybrid_set,
                                           PColumnValue&, ObjectPool*)) {
@@ -973,6 +979,42 @@ public:
     }
 
 private:
+    template <class T>
+    Status _get_push_minmax_context(T* container, ExprContext* prob_expr);
+
+    Status _get_push_minmax_vexprs(std::vector<doris::vectorized::VExpr*>* container,
+                                   doris::vectorized::VExprContext* vprob_expr);
+
+    // A bloom filter keeps the min and max of its values as well, so that the scan can prune
+    // pages by zone maps, which a bloom filter alone can not do. Strings are left out, their
+    // min and max would point to the memory of the build side.
+    void _init_bloom_filter_range() {
+        if (config::enable_runtime_filter_bloom_range && !is_string_type(_column_return_type) &&
+            _column_return_type != TYPE_HLL && _column_return_type != TYPE_OBJECT) {
+            _minmax_func.reset(create_minmax_filter(_column_return_type));
+        }
+    }
+
+    void _insert_bloom_filter(const void* data) {
+        _bloomfilter_func->insert(data);
+        if (_minmax_func != nullptr) {
+            _minmax_func->insert(data);
+        }
+    }
+
+    void _merge_bloom_filter(const RuntimePredicateWrapper* wrapper) {
+        _bloomfilter_func->merge(wrapper->_bloomfilter_func.get());
+        if (_minmax_func == nullptr) {
+            return;
+        }
+        if (wrapper->_minmax_func == nullptr) {
+            // the other filter comes from a BE not sending the range, so the range is unknown
+            _minmax_func.reset();
+            return;
+        }
+        _minmax_func->merge(wrapper->_minmax_func.get(), _pool);
+    }
+
     ObjectPool* _pool;
     PrimitiveType _column_return_type; // column type
     RuntimeFilterType _filter_type;
@@ -1021,9 +1063,17 @@ Status IRuntimeFilter::publish() {
         consumer_filter->signal();
         return Status::OK();
     } else {
+        int merged_producer_num = 1;
+        bool is_last = true;
+        RETURN_IF_ERROR(
+                _state->runtime_filter_mgr()->local_merge(this, &merged_producer_num, &is_last));
+        if (!is_last) {
+            // the last producer on this BE sends the merged filter
+            return Status::OK();
+        }
         TNetworkAddress addr;
         RETURN_IF_ERROR(_state->runtime_filter_mgr()->get_merge_addr(&addr));
-        return push_to_remote(_state, &addr);
+        return push_to_remote(_state, &addr, merged_producer_num);
     }
 }
 
@@ -1199,7 +1249,12 @@ Status IRuntimeFilter::_create_wrapper(const T* param, ObjectPool* pool,
     }
     case PFilterType::BLOOM_FILTER: {
         DCHECK(param->request->has_bloom_filter());
-        return (*wrapper)->assign(&param->request->bloom_filter(), param->data);
+        RETURN_IF_ERROR((*wrapper)->assign(&param->request->bloom_filter(), param->data));
+        // the range of the bloom filter, missing if the sender does not know it
+        if (param->request->has_minmax_filter()) {
+            return (*wrapper)->assign(&param->request->minmax_filter());
+        }
+        return Status::OK();
     }
     case PFilterType::MINMAX_FILTER: {
         DCHECK(param->request->has_minmax_filter());
@@ -1290,6 +1345,9 @@ Status IRuntimeFilter::serialize_impl(T* request, void** data, int* len) {
         DCHECK(data != nullptr);
         request->mutable_bloom_filter()->set_filter_length(*len);
         request->mutable_bloom_filter()->set_always_true(false);
+        if (_wrapper->has_bloom_filter_range()) {
+            to_protobuf(request->mutable_minmax_filter());
+        }
     } else if (real_runtime_filter_type == RuntimeFilterType::MINMAX_FILTER) {
         auto minmax_filter = request->mutable_minmax_filter();
         to_protobuf(minmax_filter);
@@ -1552,6 +1610,27 @@ Status IRuntimeFilter::consumer_close() {
     return Status::OK();
 }
 
+template <class T>
+Status RuntimePredicateWrapper::_get_push_minmax_context(T* container, ExprContext* prob_expr) {
+    // create max filter
+    Expr* max_literal = nullptr;
+    auto max_pred = create_bin_predicate(_pool, _column_return_type, TExprOpcode::LE);
+    RETURN_IF_ERROR(create_literal<false>(_pool, prob_expr->root()->type(),
+                                          _minmax_func->get_max(), (void**)&max_literal));
+    max_pred->add_child(Expr::copy(_pool, prob_expr->root()));
+    max_pred->add_child(max_literal);
+    container->push_back(_pool->add(new ExprContext(max_pred)));
+    // create min filter
+    Expr* min_literal = nullptr;
+    auto min_pred = create_bin_predicate(_pool, _column_return_type, TExprOpcode::GE);
+    RETURN_IF_ERROR(create_literal<false>(_pool, prob_expr->root()->type(),
+                                          _minmax_func->get_min(), (void**)&min_literal));
+    min_pred->add_child(Expr::copy(_pool, prob_expr->root()));
+    min_pred->add_child(min_literal);
+    container->push_back(_pool->add(new ExprContext(min_pred)));
+    return Status::OK();
+}
+
 template <class T>
 Status RuntimePredicateWrapper::get_push_context(T* container, RuntimeState* state,
                                                  ExprContext* prob_expr) {
@@ -1582,22 +1661,7 @@ Status RuntimePredicateWrapper::get_push_context(T* container, RuntimeState* sta
         break;
     }
     case RuntimeFilterType::MINMAX_FILTER: {
-        // create max filter
-        Expr* max_literal = nullptr;
-        auto max_pred = create_bin_predicate(_pool, _column_return_type, TExprOpcode::LE);
-        RETURN_IF_ERROR(create_literal<false>(_pool, prob_expr->root()->type(),
-                                              _minmax_func->get_max(), (void**)&max_literal));
-        max_pred->add_child(Expr::copy(_pool, prob_expr->root()));
-        max_pred->add_child(max_literal);
-        container->push_back(_pool->add(new ExprContext(max_pred)));
-        // create min filter
-        Expr* min_literal = nullptr;
-        auto min_pred = create_bin_predicate(_pool, _column_return_type, TExprOpcode::GE);
-        RETURN_IF_ERROR(create_literal<false>(_pool, prob_expr->root()->type(),
-                                              _minmax_func->get_min(), (void**)&min_literal));
-        min_pred->add_child(Expr::copy(_pool, prob_expr->root()));
-        min_pred->add_child(min_literal);
-        container->push_back(_pool->add(new ExprContext(min_pred)));
+        RETURN_IF_ERROR(_get_push_minmax_context(container, prob_expr));
         break;
     }
     case RuntimeFilterType::BLOOM_FILTER: {
@@ -1614,6 +1678,10 @@ Status RuntimePredicateWrapper::get_push_context(T* container, RuntimeState* sta
         bloom_pred->add_child(Expr::copy(_pool, prob_expr->root()));
         ExprContext* ctx = _pool->add(new ExprContext(bloom_pred));
         container->push_back(ctx);
+        // the range predicates are pushed down to the storage, the bloom filter is not
+        if (_minmax_func != nullptr) {
+            RETURN_IF_ERROR(_get_push_minmax_context(container, prob_expr));
+        }
         break;
     }
     default:
@@ -1623,6 +1691,39 @@ Status RuntimePredicateWrapper::get_push_context(T* container, RuntimeState* sta
     return Status::OK();
 }
 
+Status RuntimePredicateWrapper::_get_push_minmax_vexprs(
+        std::vector<doris::vectorized::VExpr*>* container,
+        doris::vectorized::VExprContext* vprob_expr) {
+    doris::vectorized::VExpr* max_pred = nullptr;
+    // create max filter
+    TExprNode max_pred_node;
+    RETURN_IF_ERROR(create_vbin_predicate(_pool, vprob_expr->root()->type(), TExprOpcode::LE,
+                                          &max_pred, &max_pred_node));
+    doris::vectorized::VExpr* max_literal = nullptr;
+    RETURN_IF_ERROR(create_literal<true>(_pool, vprob_expr->root()->type(),
+                                         _minmax_func->get_max(), (void**)&max_literal));
+    auto cloned_vexpr = vprob_expr->root()->clone(_pool);
+    max_pred->add_child(cloned_vexpr);
+    max_pred->add_child(max_literal);
+    container->push_back(
+            _pool->add(new doris::vectorized::VRuntimeFilterWrapper(max_pred_node, max_pred)));
+
+    // create min filter
+    doris::vectorized::VExpr* min_pred = nullptr;
+    TExprNode min_pred_node;
+    RETURN_IF_ERROR(create_vbin_predicate(_pool, vprob_expr->root()->type(), TExprOpcode::GE,
+                                          &min_pred, &min_pred_node));
+    doris::vectorized::VExpr* min_literal = nullptr;
+    RETURN_IF_ERROR(create_literal<true>(_pool, vprob_expr->root()->type(),
+                                         _minmax_func->get_min(), (void**)&min_literal));
+    cloned_vexpr = vprob_expr->root()->clone(_pool);
+    min_pred->add_child(cloned_vexpr);
+    min_pred->add_child(min_literal);
+    container->push_back(
+            _pool->add(new doris::vectorized::VRuntimeFilterWrapper(min_pred_node, min_pred)));
+    return Status::OK();
+}
+
 Status RuntimePredicateWrapper::get_push_vexprs(std::vector<doris::vectorized::VExpr*>* container,
                                                 RuntimeState* state,
                                                 doris::vectorized::VExprContext* vprob_expr) {
@@ -1661,33 +1762,7 @@ Status RuntimePredicateWrapper::get_push_vexprs(std::vector<doris::vectorized::V
         break;
     }
     case RuntimeFilterType::MINMAX_FILTER: {
-        doris::vectorized::VExpr* max_pred = nullptr;
-        // create max filter
-        TExprNode max_pred_node;
-        RETURN_IF_ERROR(create_vbin_predicate(_pool, vprob_expr->root()->type(), TExprOpcode::LE,
-                                              &max_pred, &max_pred_node));
-        doris::vectorized::VExpr* max_literal = nullptr;
-        RETURN_IF_ERROR(create_literal<true>(_pool, vprob_expr->root()->type(),
-                                             _minmax_func->get_max(), (void**)&max_literal));
-        auto cloned_vexpr = vprob_expr->root()->clone(_pool);
-        max_pred->add_child(cloned_vexpr);
-        max_pred->add_child(max_literal);
-        container->push_back(
-                _pool->add(new doris::vectorized::VRuntimeFilterWrapper(max_pred_node, max_pred)));
-
-        // create min filter
-        doris::vectorized::VExpr* min_pred = nullptr;
-        TExprNode min_pred_node;
-        RETURN_IF_ERROR(create_vbin_predicate(_pool, vprob_expr->root()->type(), TExprOpcode::GE,
-                                              &min_pred, &min_pred_node));
-        doris::vectorized::VExpr* min_literal = nullptr;
-        RETURN_IF_ERROR(create_literal<true>(_pool, vprob_expr->root()->type(),
-                                             _minmax_func->get_min(), (void**)&min_literal));
-        cloned_vexpr = vprob_expr->root()->clone(_pool);
-        min_pred->add_child(cloned_vexpr);
-        min_pred->add_child(min_literal);
-        container->push_back(
-                _pool->add(new doris::vectorized::VRuntimeFilterWrapper(min_pred_node, min_pred)));
+        RETURN_IF_ERROR(_get_push_minmax_vexprs(container, vprob_expr));
         break;
     }
     case RuntimeFilterType::BLOOM_FILTER: {
@@ -1705,6 +1780,9 @@ Status RuntimePredicateWrapper::get_push_vexprs(std::vector<doris::vectorized::V
         bloom_pred->add_child(cloned_vexpr);
         auto wrapper = _pool->add(new doris::vectorized::VRuntimeFilterWrapper(node, bloom_pred));
         container->push_back(wrapper);
+        if (_minmax_func != nullptr) {
+            RETURN_IF_ERROR(_get_push_minmax_vexprs(container, vprob_expr));
+        }
         break;
     }
     default:
@@ -148,6 +148,8 @@ public:
 
     RuntimeFilterType type() const { return _runtime_filter_type; }
 
+    int filter_id() const { return _filter_id; }
+
     // get push down expr context
     // This function can only be called once
     // _wrapper's function will be clear
@@ -218,7 +220,9 @@ public:
     Status consumer_close();
 
     // async push runtimefilter to remote node
-    Status push_to_remote(RuntimeState* state, const TNetworkAddress* addr);
+    // 'merged_producer_num' is the number of producers merged into this filter on this BE.
+    Status push_to_remote(RuntimeState* state, const TNetworkAddress* addr,
+                          int merged_producer_num = 1);
     Status join_rpc();
 
     void init_profile(RuntimeProfile* parent_profile);
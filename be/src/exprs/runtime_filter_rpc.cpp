@@ -34,7 +34,8 @@ struct IRuntimeFilter::rpc_context {
     brpc::CallId cid;
 };
 
-Status IRuntimeFilter::push_to_remote(RuntimeState* state, const TNetworkAddress* addr) {
+Status IRuntimeFilter::push_to_remote(RuntimeState* state, const TNetworkAddress* addr,
+                                      int merged_producer_num) {
     DCHECK(is_producer());
     DCHECK(_rpc_context == nullptr);
     std::shared_ptr<PBackendService_Stub> stub(
@@ -58,6 +59,9 @@ Status IRuntimeFilter::push_to_remote(RuntimeState* state, const TNetworkAddress
     pfragment_instance_id->set_lo(state->fragment_instance_id().lo);
 
     _rpc_context->request.set_filter_id(_filter_id);
+    if (merged_producer_num > 1) {
+        _rpc_context->request.set_merged_producer_num(merged_producer_num);
+    }
     _rpc_context->cntl.set_timeout_ms(1000);
     _rpc_context->cid = _rpc_context->cntl.call_id();
 
@@ -20,6 +20,7 @@
 #include "exprs/runtime_filter.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/runtime_state.h"
+#include "vec/runtime/shared_hash_table_controller.h"
 
 namespace doris {
 // this class used in a hash join node
@@ -224,6 +225,46 @@ public:
         }
     }
 
+    // Save the filters built from a shared hash table, for the instances probing the same table.
+    Status copy_to_shared_context(vectorized::SharedHashTableContext* context) {
+        for (auto& pair : _runtime_filters) {
+            for (auto filter : pair.second) {
+                auto& shared_filter = context->runtime_filters[filter->filter_id()];
+                void* data = nullptr;
+                int len = 0;
+                RETURN_IF_ERROR(filter->serialize(&shared_filter.request, &data, &len));
+                shared_filter.request.set_filter_id(filter->filter_id());
+                // the bloom filter data belongs to the filter, copy it
+                if (data != nullptr) {
+                    shared_filter.data.assign(static_cast<const char*>(data), len);
+                }
+            }
+        }
+        return Status::OK();
+    }
+
+    // Fill the filters with the ones the builder of the shared hash table saved, since the
+    // build side of this instance was never evaluated.
+    Status copy_from_shared_context(const vectorized::SharedHashTableContext& context,
+                                    ObjectPool* pool) {
+        for (auto& pair : _runtime_filters) {
+            for (auto filter : pair.second) {
+                auto it = context.runtime_filters.find(filter->filter_id());
+                if (it == context.runtime_filters.end()) {
+                    return Status::InternalError("runtime filter {} is not in the shared context",
+                                                 filter->filter_id());
+                }
+                MergeRuntimeFilterParams params;
+                params.request = &it->second.request;
+                params.data = it->second.data.data();
+                std::unique_ptr<RuntimePredicateWrapper> wrapper;
+                RETURN_IF_ERROR(IRuntimeFilter::create_wrapper(&params, pool, &wrapper));
+                RETURN_IF_ERROR(filter->merge_from(wrapper.get()));
+            }
+        }
+        return Status::OK();
+    }
+
     bool empty() { return !_runtime_filters.size(); }
 
 private:
@@ -71,6 +71,28 @@ public:
         return Status::OK();
     }
 
+    // only used for vectorized. Inserts the values of the current row from the current offset on
+    // into column, at most max_step of them, and moves forward past them like forward(). *step is
+    // set to the number of the values inserted.
+    virtual Status get_many_values(vectorized::IColumn* column, int max_step, int* step) {
+        *step = 0;
+        bool eos = false;
+        while (!eos && *step < max_step) {
+            void* value = nullptr;
+            int64_t length = -1;
+            RETURN_IF_ERROR(get_value(&value));
+            RETURN_IF_ERROR(get_value_length(&length));
+            if (value == nullptr) {
+                column->insert_default();
+            } else {
+                column->insert_data(reinterpret_cast<char*>(value), length);
+            }
+            ++*step;
+            RETURN_IF_ERROR(forward(&eos));
+        }
+        return Status::OK();
+    }
+
     virtual Status close() { return Status::OK(); }
 
     virtual Status forward(bool* eos) {
@@ -19,10 +19,13 @@
 
 #include <s2/s2cap.h>
 #include <s2/s2cell.h>
+#include <s2/s2cell_id.h>
+#include <s2/s2cell_union.h>
 #include <s2/s2earth.h>
 #include <s2/s2latlng.h>
 #include <s2/s2polygon.h>
 #include <s2/s2polyline.h>
+#include <s2/s2region_coverer.h>
 #include <s2/util/coding/coder.h>
 #include <s2/util/units/length-units.h>
 #include <stdio.h>
@@ -240,7 +243,7 @@ bool GeoPoint::decode(const void* data, size_t size) {
     if (size < sizeof(*_point)) {
         return false;
     }
-    memcpy(_point.get(), data, size);
+    memcpy(_point.get(), data, sizeof(*_point));
     return true;
 }
 
@@ -347,6 +350,16 @@ bool GeoPolygon::contains(const GeoShape* rhs) const {
     switch (rhs->type()) {
     case GEO_SHAPE_POINT: {
         const GeoPoint* point = (const GeoPoint*)rhs;
+        if (_exterior_covering != nullptr) {
+            // no edge of the polygon crosses the interior cells
+            S2CellId cell_id(*point->point());
+            if (!_exterior_covering->Contains(cell_id)) {
+                return false;
+            }
+            if (_interior_covering->Contains(cell_id)) {
+                return true;
+            }
+        }
         return _polygon->Contains(*point->point());
     }
     case GEO_SHAPE_LINE_STRING: {
@@ -362,6 +375,17 @@ bool GeoPolygon::contains(const GeoShape* rhs) const {
     }
 }
 
+void GeoPolygon::prepare_contains() {
+    if (_exterior_covering != nullptr) {
+        return;
+    }
+    S2RegionCoverer::Options options;
+    options.set_max_cells(128);
+    S2RegionCoverer coverer(options);
+    _interior_covering.reset(new S2CellUnion(coverer.GetInteriorCovering(*_polygon)));
+    _exterior_covering.reset(new S2CellUnion(coverer.GetCovering(*_polygon)));
+}
+
 GeoParseStatus GeoCircle::init(double lng, double lat, double radius_meter) {
     S2Point center;
     auto status = to_s2point(lng, lat, &center);
@@ -27,6 +27,7 @@
 class S2Polyline;
 class S2Polygon;
 class S2Cap;
+class S2CellUnion;
 
 template <typename T>
 class Vector3;
@@ -54,6 +55,9 @@ public:
     virtual std::string as_wkt() const = 0;
 
     virtual bool contains(const GeoShape* rhs) const { return false; }
+    // Prepares the shape to be tested by contains() against many other shapes, like a constant
+    // shape of a query against the shapes of every row.
+    virtual void prepare_contains() {}
     virtual std::string to_string() const { return ""; };
 
 protected:
@@ -121,6 +125,9 @@ public:
     const S2Polygon* polygon() const { return _polygon.get(); }
 
     bool contains(const GeoShape* rhs) const override;
+    // Computes S2 cell coverings of the polygon, so that contains() decides most of the points by
+    // their cells without looking for the edges around them.
+    void prepare_contains() override;
     std::string as_wkt() const override;
 
 protected:
@@ -129,6 +136,9 @@ protected:
 
 private:
     std::unique_ptr<S2Polygon> _polygon;
+    // the cells inside the polygon and the cells covering it, null until prepare_contains()
+    std::unique_ptr<S2CellUnion> _interior_covering;
+    std::unique_ptr<S2CellUnion> _exterior_covering;
 };
 
 class GeoCircle : public GeoShape {
@@ -0,0 +1,114 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/cpu_samples_action.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "common/status.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "service/backend_options.h"
+#include "util/cpu_sampler.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+const static std::string HEADER_JSON = "application/json";
+
+// the names of the task types of ThreadContext
+static std::string task_type_name(int task_type) {
+    static const char* names[] = {"UNKNOWN", "QUERY", "LOAD", "COMPACTION", "STORAGE", "BRPC"};
+    if (task_type < 0 || task_type >= sizeof(names) / sizeof(names[0])) {
+        return "UNKNOWN";
+    }
+    return names[task_type];
+}
+
+CpuSamplesAction::CpuSamplesAction() {
+    _host = BackendOptions::get_localhost();
+}
+
+void CpuSamplesAction::handle(HttpRequest* req) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+
+    std::string group_by = req->param("group_by");
+    if (group_by != "" && group_by != "query" && group_by != "instance") {
+        LOG(WARNING) << "invalid argument. group_by:" << group_by;
+        Status status = Status::InvalidArgument("invalid argument: group_by");
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, status.to_json());
+        return;
+    }
+    HttpChannel::send_reply(req, HttpStatus::OK,
+                            get_cpu_samples(group_by == "instance").ToString());
+}
+
+EasyJson CpuSamplesAction::get_cpu_samples(bool group_by_instance) {
+    CpuSampler* sampler = CpuSampler::instance();
+    std::vector<CpuSampler::Entry> entries = sampler->entries();
+    if (!group_by_instance) {
+        std::map<std::tuple<int, int64_t, int64_t>, CpuSampler::Entry> queries;
+        for (auto& entry : entries) {
+            auto& query = queries[{entry.task_type, entry.query_id.hi, entry.query_id.lo}];
+            query.task_type = entry.task_type;
+            query.query_id = entry.query_id;
+            query.samples += entry.samples;
+            query.last_sample_time_s =
+                    std::max(query.last_sample_time_s, entry.last_sample_time_s);
+        }
+        entries.clear();
+        for (auto& [key, query] : queries) {
+            entries.push_back(query);
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const CpuSampler::Entry& lhs, const CpuSampler::Entry& rhs) {
+                      return lhs.samples > rhs.samples;
+                  });
+    }
+
+    EasyJson cpu_samples_ej;
+    cpu_samples_ej["msg"] = "OK";
+    cpu_samples_ej["code"] = 0;
+    EasyJson data = cpu_samples_ej.Set("data", EasyJson::kObject);
+    data["host"] = _host;
+    data["frequency"] = sampler->frequency();
+    data["dropped_samples"] = sampler->dropped_samples();
+    EasyJson samples = data.Set("cpu_samples", EasyJson::kArray);
+    for (auto& entry : entries) {
+        EasyJson sample = samples.PushBack(EasyJson::kObject);
+        sample["task_type"] = task_type_name(entry.task_type);
+        sample["query_id"] = print_id(entry.query_id);
+        if (group_by_instance) {
+            sample["fragment_instance_id"] = print_id(entry.fragment_instance_id);
+        }
+        sample["samples"] = entry.samples;
+        // each sample stands for 1/frequency second of CPU time
+        if (sampler->frequency() > 0) {
+            sample["cpu_time_ms"] = entry.samples * 1000 / sampler->frequency();
+        }
+        sample["last_sample_time"] = entry.last_sample_time_s;
+    }
+    cpu_samples_ej["count"] = entries.size();
+    return cpu_samples_ej;
+}
+
+} // namespace doris
@@ -0,0 +1,40 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "http/http_handler.h"
+#include "util/easy_json.h"
+
+namespace doris {
+
+// Get the CPU samples of the queries and fragment instances from http API, like:
+//   /api/cpu_samples?group_by=query
+//   /api/cpu_samples?group_by=instance
+class CpuSamplesAction : public HttpHandler {
+public:
+    CpuSamplesAction();
+    void handle(HttpRequest* req) override;
+    EasyJson get_cpu_samples(bool group_by_instance);
+
+private:
+    std::string _host;
+};
+
+} // namespace doris
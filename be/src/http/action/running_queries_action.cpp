@@ -0,0 +1,125 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/running_queries_action.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "runtime/exec_env.h"
+#include "runtime/fragment_mgr.h"
+#include "service/backend_options.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+const static std::string HEADER_JSON = "application/json";
+
+// Adds the exec nodes of the profile tree, whose names are like "VOLAP_SCAN_NODE (id=0)".
+static void add_operators(const TRuntimeProfileTree& profile, EasyJson* operators) {
+    for (auto& node : profile.nodes) {
+        if (node.name.find("(id=") == std::string::npos) {
+            continue;
+        }
+        EasyJson op = operators->PushBack(EasyJson::kObject);
+        op["name"] = node.name;
+        EasyJson counters = op.Set("counters", EasyJson::kObject);
+        for (auto& counter : node.counters) {
+            counters[counter.name] = counter.value;
+        }
+    }
+}
+
+RunningQueriesAction::RunningQueriesAction(ExecEnv* exec_env) : _exec_env(exec_env) {
+    _host = BackendOptions::get_localhost();
+}
+
+void RunningQueriesAction::handle(HttpRequest* req) {
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+
+    std::string detail = req->param("detail");
+    if (detail != "" && detail != "true" && detail != "false") {
+        LOG(WARNING) << "invalid argument. detail:" << detail;
+        Status status = Status::InvalidArgument("invalid argument: detail");
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST, status.to_json());
+        return;
+    }
+    HttpChannel::send_reply(req, HttpStatus::OK,
+                            get_running_queries(detail == "true").ToString());
+}
+
+EasyJson RunningQueriesAction::get_running_queries(bool detail) {
+    std::vector<RunningFragmentInfo> fragments;
+    _exec_env->fragment_mgr()->get_running_fragments(detail, &fragments);
+
+    // the instances of each query, the instances of a query share its mem tracker
+    std::unordered_map<TUniqueId, std::vector<const RunningFragmentInfo*>> queries;
+    for (auto& fragment : fragments) {
+        queries[fragment.query_id].push_back(&fragment);
+    }
+    std::vector<const std::vector<const RunningFragmentInfo*>*> sorted_queries;
+    sorted_queries.reserve(queries.size());
+    for (auto& [query_id, instances] : queries) {
+        sorted_queries.push_back(&instances);
+    }
+    std::sort(sorted_queries.begin(), sorted_queries.end(),
+              [](const std::vector<const RunningFragmentInfo*>* lhs,
+                 const std::vector<const RunningFragmentInfo*>* rhs) {
+                  return lhs->front()->query_mem_consumption >
+                         rhs->front()->query_mem_consumption;
+              });
+
+    EasyJson queries_ej;
+    queries_ej["msg"] = "OK";
+    queries_ej["code"] = 0;
+    EasyJson data = queries_ej.Set("data", EasyJson::kObject);
+    data["host"] = _host;
+    EasyJson running_queries = data.Set("running_queries", EasyJson::kArray);
+    for (auto* instances : sorted_queries) {
+        const RunningFragmentInfo* first = instances->front();
+        EasyJson query = running_queries.PushBack(EasyJson::kObject);
+        query["query_id"] = print_id(first->query_id);
+        query["mem_consumption"] = first->query_mem_consumption;
+        query["peak_mem_consumption"] = first->query_peak_mem_consumption;
+        query["mem_limit"] = first->query_mem_limit;
+        int64_t elapsed_seconds = 0;
+        EasyJson instances_ej = query.Set("instances", EasyJson::kArray);
+        for (auto* fragment : *instances) {
+            elapsed_seconds = std::max(elapsed_seconds, fragment->elapsed_seconds);
+            EasyJson instance = instances_ej.PushBack(EasyJson::kObject);
+            instance["fragment_instance_id"] = print_id(fragment->fragment_instance_id);
+            instance["start_time"] = fragment->start_time;
+            instance["elapsed_seconds"] = fragment->elapsed_seconds;
+            if (detail) {
+                EasyJson operators = instance.Set("operators", EasyJson::kArray);
+                add_operators(fragment->profile, &operators);
+            }
+        }
+        query["elapsed_seconds"] = elapsed_seconds;
+    }
+    queries_ej["count"] = sorted_queries.size();
+    return queries_ej;
+}
+
+} // namespace doris
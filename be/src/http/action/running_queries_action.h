@@ -0,0 +1,47 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "http/http_handler.h"
+#include "util/easy_json.h"
+
+namespace doris {
+
+class ExecEnv;
+
+// Get the queries running on this BE now, with the memory of each query and the elapsed time of
+// its fragment instances, from http API like:
+//   /api/running_queries
+//   /api/running_queries?detail=true
+// With detail=true, each instance also lists its operators with their counters so far, like the
+// rows returned, the peak memory, the spilled bytes and the scan IO time.
+// The queries are sorted by their memory consumption, the largest first.
+class RunningQueriesAction : public HttpHandler {
+public:
+    RunningQueriesAction(ExecEnv* exec_env);
+    void handle(HttpRequest* req) override;
+    EasyJson get_running_queries(bool detail);
+
+private:
+    ExecEnv* _exec_env;
+    std::string _host;
+};
+
+} // namespace doris
@@ -46,6 +46,7 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/load_path_mgr.h"
 #include "runtime/plan_fragment_executor.h"
+#include "runtime/stream_load/group_commit_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
@@ -144,7 +145,7 @@ void StreamLoadAction::handle(HttpRequest* req) {
 
     // status already set to fail
     if (ctx->status.ok()) {
-        ctx->status = _handle(ctx);
+        ctx->status = _handle(req, ctx);
         if (!ctx->status.ok() && ctx->status.code() != TStatusCode::PUBLISH_TIMEOUT) {
             LOG(WARNING) << "handle streaming load failed, id=" << ctx->id
                          << ", errmsg=" << ctx->status.get_error_msg();
@@ -179,12 +180,15 @@ void StreamLoadAction::handle(HttpRequest* req) {
     streaming_load_current_processing->increment(-1);
 }
 
-Status StreamLoadAction::_handle(StreamLoadContext* ctx) {
+Status StreamLoadAction::_handle(HttpRequest* http_req, StreamLoadContext* ctx) {
     if (ctx->body_bytes > 0 && ctx->receive_bytes != ctx->body_bytes) {
         LOG(WARNING) << "recevie body don't equal with body bytes, body_bytes=" << ctx->body_bytes
                      << ", receive_bytes=" << ctx->receive_bytes << ", id=" << ctx->id;
         return Status::InternalError("receive body don't equal with body bytes");
     }
+    if (ctx->group_commit) {
+        return _group_commit(http_req, ctx);
+    }
     if (!ctx->use_streaming) {
         // if we use non-streaming, we need to close file first,
         // then execute_plan_fragment here
@@ -329,6 +333,13 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, StreamLoadContext* ct
         }
     }
 
+    if (_can_group_commit(http_req, ctx)) {
+        // the body is buffered, and sent to the load of its group when it is all received
+        ctx->group_commit = true;
+        ctx->group_commit_data = ByteBuffer::allocate(ctx->body_bytes + 1);
+        return Status::OK();
+    }
+
     // begin transaction
     int64_t begin_txn_start_time = MonotonicNanos();
     RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(ctx));
@@ -338,6 +349,62 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, StreamLoadContext* ct
     return _process_put(http_req, ctx);
 }
 
+bool StreamLoadAction::_can_group_commit(HttpRequest* http_req, StreamLoadContext* ctx) {
+    // the bodies of the loads in a group are concatenated, so only the csv rows delimited by
+    // the default line delimiter can be merged
+    return iequal(http_req->header(HTTP_GROUP_COMMIT), "true") &&
+           ctx->format == TFileFormatType::FORMAT_CSV_PLAIN && ctx->header_type.empty() &&
+           http_req->header(HTTP_LINE_DELIMITER).empty() && !ctx->two_phase_commit &&
+           ctx->body_bytes > 0 && ctx->body_bytes <= config::group_commit_max_load_bytes;
+}
+
+Status StreamLoadAction::_group_commit(HttpRequest* http_req, StreamLoadContext* ctx) {
+    auto& data = ctx->group_commit_data;
+    // the last row of a load must not be joined with the first row of the next one
+    if (data->pos > 0 && data->ptr[data->pos - 1] != '\n') {
+        data->put_bytes("\n", 1);
+    }
+    data->flip();
+    auto plan_func = [this, http_req](StreamLoadContext* group_ctx) {
+        int64_t begin_txn_start_time = MonotonicNanos();
+        RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(group_ctx));
+        group_ctx->begin_txn_cost_nanos = MonotonicNanos() - begin_txn_start_time;
+        return _process_put(http_req, group_ctx);
+    };
+    return _exec_env->group_commit_mgr()->group_commit(ctx, _group_commit_key(http_req, ctx), data,
+                                                       plan_func);
+}
+
+std::string StreamLoadAction::_group_commit_key(HttpRequest* http_req, StreamLoadContext* ctx) {
+    // the load of a group is planned with the request of its first load, so the loads in a group
+    // must have the same user and parameters
+    std::stringstream ss;
+    ss << ctx->auth.cluster << '\0' << ctx->auth.user << '\0' << ctx->auth.passwd << '\0'
+       << ctx->auth.auth_code << '\0' << ctx->auth.auth_code_uuid << '\0' << ctx->db << '\0'
+       << ctx->table;
+    std::initializer_list<std::string> headers = {HTTP_COLUMNS,
+                                                  HTTP_WHERE,
+                                                  HTTP_COLUMN_SEPARATOR,
+                                                  HTTP_PARTITIONS,
+                                                  HTTP_TEMP_PARTITIONS,
+                                                  HTTP_NEGATIVE,
+                                                  HTTP_STRICT_MODE,
+                                                  HTTP_TIMEZONE,
+                                                  HTTP_EXEC_MEM_LIMIT,
+                                                  HTTP_FUNCTION_COLUMN + "." + HTTP_SEQUENCE_COL,
+                                                  HTTP_SEND_BATCH_PARALLELISM,
+                                                  HTTP_LOAD_TO_SINGLE_TABLET,
+                                                  HTTP_PARTIAL_COLUMNS,
+                                                  HTTP_MERGE_TYPE,
+                                                  HTTP_DELETE_CONDITION,
+                                                  HTTP_MAX_FILTER_RATIO,
+                                                  HTTP_TIMEOUT};
+    for (auto& header : headers) {
+        ss << '\0' << http_req->header(header);
+    }
+    return ss.str();
+}
+
 void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     StreamLoadContext* ctx = (StreamLoadContext*)req->handler_ctx();
     if (ctx == nullptr || !ctx->status.ok()) {
@@ -348,6 +415,19 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     auto evbuf = evhttp_request_get_input_buffer(ev_req);
 
     int64_t start_read_data_time = MonotonicNanos();
+    if (ctx->group_commit) {
+        auto& data = ctx->group_commit_data;
+        size_t len = evbuffer_get_length(evbuf);
+        if (ctx->receive_bytes + len > ctx->body_bytes) {
+            ctx->status = Status::InternalError("receive body exceeds body bytes");
+            return;
+        }
+        evbuffer_remove(evbuf, data->ptr + data->pos, len);
+        data->pos += len;
+        ctx->receive_bytes += len;
+        ctx->read_data_cost_nanos += (MonotonicNanos() - start_read_data_time);
+        return;
+    }
     while (evbuffer_get_length(evbuf) > 0) {
         auto bb = ByteBuffer::allocate(128 * 1024);
         auto remove_bytes = evbuffer_remove(evbuf, bb->ptr, bb->capacity);
@@ -525,6 +605,10 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
         }
     }
 
+    if (!http_req->header(HTTP_PARTIAL_COLUMNS).empty()) {
+        request.__set_partial_update(iequal(http_req->header(HTTP_PARTIAL_COLUMNS), "true"));
+    }
+
     if (ctx->timeout_second != -1) {
         request.__set_timeout(ctx->timeout_second);
     }
@@ -46,7 +46,11 @@ public:
 
 private:
     Status _on_header(HttpRequest* http_req, StreamLoadContext* ctx);
-    Status _handle(StreamLoadContext* ctx);
+    Status _handle(HttpRequest* http_req, StreamLoadContext* ctx);
+    // whether the load is small enough and has the parameters to be group committed
+    bool _can_group_commit(HttpRequest* http_req, StreamLoadContext* ctx);
+    Status _group_commit(HttpRequest* http_req, StreamLoadContext* ctx);
+    std::string _group_commit_key(HttpRequest* http_req, StreamLoadContext* ctx);
     Status _data_saved_path(HttpRequest* req, std::string* file_path);
     Status _execute_plan_fragment(StreamLoadContext* ctx);
     Status _process_put(HttpRequest* http_req, StreamLoadContext* ctx);
@@ -25,9 +25,13 @@
 #include <event2/keyvalq_struct.h>
 #include <event2/thread.h>
 
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include <memory>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "http/http_channel.h"
 #include "http/http_handler.h"
@@ -63,6 +67,30 @@ static int on_header(struct evhttp_request* ev_req, void* param) {
     return server->on_header(ev_req);
 }
 
+// Like butil::tcp_listen(), but the socket is bound with SO_REUSEPORT, so that the kernel balances
+// the new connections among the sockets bound to the same port.
+static int tcp_listen_reuse_port(const butil::EndPoint& point) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr = point.ip;
+    addr.sin_port = htons(point.port);
+    int on = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0 ||
+        bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        int saved_errno = errno;
+        close(fd);
+        errno = saved_errno;
+        return -1;
+    }
+    return fd;
+}
+
 // param is pointer of EvHttpServer
 static int on_connection(struct evhttp_request* req, void* param) {
     evhttp_request_set_header_cb(req, on_header);
@@ -112,7 +140,8 @@ void EvHttpServer::start() {
                                                        [](evhttp* http) { evhttp_free(http); });
                           CHECK(http != nullptr) << "Couldn't create an evhttp.";
 
-                          auto res = evhttp_accept_socket(http.get(), _server_fd);
+                          auto res = evhttp_accept_socket(
+                                  http.get(), _server_fds[i % _server_fds.size()]);
                           CHECK(res >= 0) << "evhttp accept socket failed, res=" << res;
 
                           evhttp_set_newreqcb(http.get(), on_connection, this);
@@ -134,39 +163,58 @@ void EvHttpServer::stop() {
         _event_bases.clear();
     }
     _workers->shutdown();
-    close(_server_fd);
+    for (int fd : _server_fds) {
+        close(fd);
+    }
+    _server_fds.clear();
 }
 
 void EvHttpServer::join() {}
 
 Status EvHttpServer::_bind() {
+    bool reuse_port = config::enable_http_server_reuseport && _num_workers > 1;
+    int num_sockets = reuse_port ? _num_workers : 1;
+    for (int i = 0; i < num_sockets; ++i) {
+        int fd = -1;
+        // the other sockets are bound to the port chosen for the first one
+        RETURN_IF_ERROR(_listen(i == 0 ? _port : _real_port, reuse_port, &fd));
+        _server_fds.push_back(fd);
+        if (i == 0) {
+            _real_port = _port;
+            if (_port == 0) {
+                struct sockaddr_in addr;
+                socklen_t socklen = sizeof(addr);
+                const int rc = getsockname(fd, (struct sockaddr*)&addr, &socklen);
+                if (rc == 0) {
+                    _real_port = ntohs(addr.sin_port);
+                }
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status EvHttpServer::_listen(int port, bool reuse_port, int* fd) {
     butil::EndPoint point;
-    auto res = butil::hostname2endpoint(_host.c_str(), _port, &point);
+    auto res = butil::hostname2endpoint(_host.c_str(), port, &point);
     if (res < 0) {
-        return Status::InternalError("convert address failed, host={}, port={}", _host, _port);
+        return Status::InternalError("convert address failed, host={}, port={}", _host, port);
     }
-    _server_fd = butil::tcp_listen(point);
-    if (_server_fd < 0) {
+    *fd = reuse_port ? tcp_listen_reuse_port(point) : butil::tcp_listen(point);
+    if (*fd < 0) {
         char buf[64];
         std::stringstream ss;
         ss << "tcp listen failed, errno=" << errno
            << ", errmsg=" << strerror_r(errno, buf, sizeof(buf));
         return Status::InternalError(ss.str());
     }
-    if (_port == 0) {
-        struct sockaddr_in addr;
-        socklen_t socklen = sizeof(addr);
-        const int rc = getsockname(_server_fd, (struct sockaddr*)&addr, &socklen);
-        if (rc == 0) {
-            _real_port = ntohs(addr.sin_port);
-        }
-    }
-    res = butil::make_non_blocking(_server_fd);
+    res = butil::make_non_blocking(*fd);
     if (res < 0) {
         char buf[64];
         std::stringstream ss;
         ss << "make socket to non_blocking failed, errno=" << errno
            << ", errmsg=" << strerror_r(errno, buf, sizeof(buf));
+        close(*fd);
         return Status::InternalError(ss.str());
     }
     return Status::OK();
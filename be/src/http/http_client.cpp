@@ -17,6 +17,8 @@
 
 #include "http/http_client.h"
 
+#include <filesystem>
+
 #include "common/config.h"
 
 namespace doris {
@@ -168,18 +170,34 @@ Status HttpClient::execute(const std::function<bool(const void* data, size_t len
     return Status::OK();
 }
 
-Status HttpClient::download(const std::string& local_path) {
+Status HttpClient::download(const std::string& local_path, bool resume, int64_t max_speed_kbps) {
     // set method to GET
     set_method(GET);
 
     // TODO(zc) Move this download speed limit outside to limit download speed
     // at system level
+    if (max_speed_kbps <= 0) {
+        max_speed_kbps = config::max_download_speed_kbps;
+    }
     curl_easy_setopt(_curl, CURLOPT_LOW_SPEED_LIMIT, config::download_low_speed_limit_kbps * 1024);
     curl_easy_setopt(_curl, CURLOPT_LOW_SPEED_TIME, config::download_low_speed_time);
-    curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE, config::max_download_speed_kbps * 1024);
+    curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE,
+                     static_cast<curl_off_t>(max_speed_kbps * 1024));
+
+    const char* mode = "w";
+    if (resume) {
+        std::error_code ec;
+        auto downloaded_size = std::filesystem::file_size(local_path, ec);
+        if (!ec && downloaded_size > 0) {
+            // the server replies with the bytes after the downloaded ones
+            curl_easy_setopt(_curl, CURLOPT_RESUME_FROM_LARGE,
+                             static_cast<curl_off_t>(downloaded_size));
+            mode = "a";
+        }
+    }
 
     auto fp_closer = [](FILE* fp) { fclose(fp); };
-    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), "w"), fp_closer);
+    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), mode), fp_closer);
     if (fp == nullptr) {
         LOG(WARNING) << "open file failed, file=" << local_path;
         return Status::InternalError("open file failed");
@@ -122,8 +122,11 @@ public:
     }
 
     // helper function to download a file, you can call this function to download
-    // a file to local_path
-    Status download(const std::string& local_path);
+    // a file to local_path.
+    // If resume is true, the download continues after the bytes already in local_path by a range
+    // request. max_speed_kbps overrides config::max_download_speed_kbps when it is positive.
+    Status download(const std::string& local_path, bool resume = false,
+                    int64_t max_speed_kbps = 0);
 
     Status execute_post_request(const std::string& payload, std::string* response);
 
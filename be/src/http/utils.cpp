@@ -18,8 +18,11 @@
 #include "http/utils.h"
 
 #include <fcntl.h>
+#include <fmt/format.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+
 #include "common/logging.h"
 #include "common/status.h"
 #include "common/utils.h"
@@ -134,13 +137,26 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
     int64_t file_size = st.st_size;
 
     // TODO(lingbin): process "IF_MODIFIED_SINCE" header
-    // TODO(lingbin): process "RANGE" header
+    // A single range of bytes like "bytes=100-" or "bytes=100-199" is served, which resumes the
+    // interrupted downloads of clones. The other ranges get the whole file.
+    int64_t range_start = 0;
+    int64_t range_end = file_size - 1;
+    bool is_range = false;
     const std::string& range_header = req->header(HttpHeaders::RANGE);
-    if (!range_header.empty()) {
-        // analyse range header
+    if (!range_header.empty() && parse_range_header(range_header, &range_start, &range_end)) {
+        if (range_start >= file_size || range_start > range_end) {
+            close(fd);
+            req->add_output_header(HttpHeaders::CONTENT_RANGE,
+                                   ("bytes */" + std::to_string(file_size)).c_str());
+            HttpChannel::send_error(req, HttpStatus::REQUESTED_RANGE_NOT_SATISFIED);
+            return;
+        }
+        range_end = std::min(range_end, file_size - 1);
+        is_range = true;
     }
 
     req->add_output_header(HttpHeaders::CONTENT_TYPE, get_content_type(file_path).c_str());
+    req->add_output_header(HttpHeaders::ACCEPT_RANGES, "bytes");
 
     if (req->method() == HttpMethod::HEAD) {
         close(fd);
@@ -149,9 +165,46 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
         return;
     }
 
+    if (is_range) {
+        std::string content_range =
+                fmt::format("bytes {}-{}/{}", range_start, range_end, file_size);
+        req->add_output_header(HttpHeaders::CONTENT_RANGE, content_range.c_str());
+        HttpChannel::send_file(req, fd, range_start, range_end - range_start + 1,
+                               HttpStatus::PARTIAL_CONTENT);
+        return;
+    }
     HttpChannel::send_file(req, fd, 0, file_size);
 }
 
+bool parse_range_header(const std::string& range_header, int64_t* start, int64_t* end) {
+    static const std::string BYTES_PREFIX = "bytes=";
+    if (range_header.compare(0, BYTES_PREFIX.size(), BYTES_PREFIX) != 0) {
+        return false;
+    }
+    std::string range = range_header.substr(BYTES_PREFIX.size());
+    size_t dash = range.find('-');
+    // suffix ranges like "bytes=-100" and multiple ranges are not supported
+    if (dash == std::string::npos || dash == 0 || range.find(',') != std::string::npos) {
+        return false;
+    }
+    char* parse_end = nullptr;
+    std::string start_str = range.substr(0, dash);
+    int64_t range_start = strtoll(start_str.c_str(), &parse_end, 10);
+    if (*parse_end != '\0' || range_start < 0) {
+        return false;
+    }
+    std::string end_str = range.substr(dash + 1);
+    if (!end_str.empty()) {
+        int64_t range_end = strtoll(end_str.c_str(), &parse_end, 10);
+        if (*parse_end != '\0') {
+            return false;
+        }
+        *end = range_end;
+    }
+    *start = range_start;
+    return true;
+}
+
 void do_dir_response(const std::string& dir_path, HttpRequest* req) {
     std::vector<std::string> files;
     Status status = FileUtils::list_files(Env::Default(), dir_path, &files);
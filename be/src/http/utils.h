@@ -37,6 +37,11 @@ bool parse_basic_auth(const HttpRequest& req, AuthInfo* auth);
 
 void do_file_response(const std::string& dir_path, HttpRequest* req);
 
+// parse a Range header of a single range of bytes, like "bytes=100-" or "bytes=100-199".
+// end is only set if the range has an end.
+// return false if the header is not such a range.
+bool parse_range_header(const std::string& range_header, int64_t* start, int64_t* end);
+
 void do_dir_response(const std::string& dir_path, HttpRequest* req);
 
 std::string get_content_type(const std::string& file_name);
@@ -124,6 +124,16 @@ Status BufferedReader::_read_once(int64_t position, int64_t nbytes, int64_t* byt
             }
             return st;
         }
+        // a sequential read doubles the bytes read ahead, and a seek starts them again
+        int64_t min_read_ahead = config::remote_storage_min_read_ahead_kb * 1024L;
+        if (min_read_ahead <= 0) {
+            _read_ahead_bytes = _buffer_size;
+        } else if (position == _buffer_limit && _buffer_limit > _buffer_offset) {
+            _read_ahead_bytes = std::min(_read_ahead_bytes * 2, _buffer_size);
+        } else {
+            _read_ahead_bytes = std::min(min_read_ahead, _buffer_size);
+        }
+        _read_ahead_bytes = std::max(_read_ahead_bytes, nbytes);
         _buffer_offset = position;
         RETURN_IF_ERROR(_fill());
         if (position >= _buffer_limit) {
@@ -143,7 +153,7 @@ Status BufferedReader::_fill() {
     if (_buffer_offset >= 0) {
         int64_t bytes_read = 0;
         SCOPED_TIMER(_remote_read_timer);
-        RETURN_IF_ERROR(_reader->readat(_buffer_offset, _buffer_size, &bytes_read, _buffer));
+        RETURN_IF_ERROR(_reader->readat(_buffer_offset, _read_ahead_bytes, &bytes_read, _buffer));
         _buffer_limit = _buffer_offset + bytes_read;
         ++_remote_read_count;
         _remote_bytes += bytes_read;
@@ -65,6 +65,8 @@ private:
     int64_t _buffer_offset;
     int64_t _buffer_limit;
     int64_t _cur_offset;
+    // the bytes of the buffer filled by the next read of '_reader'
+    int64_t _read_ahead_bytes = 0;
 
     int64_t _read_count = 0;
     int64_t _remote_read_count = 0;
@@ -17,6 +17,7 @@
 
 #include "io/file_factory.h"
 
+#include "common/config.h"
 #include "io/broker_reader.h"
 #include "io/broker_writer.h"
 #include "io/buffered_reader.h"
@@ -27,6 +28,7 @@
 #include "io/s3_writer.h"
 #include "runtime/exec_env.h"
 #include "runtime/stream_load/load_stream_mgr.h"
+#include "util/file_utils.h"
 
 doris::Status doris::FileFactory::create_file_writer(
         TFileType::type type, doris::ExecEnv* env,
@@ -131,6 +133,25 @@ doris::Status doris::FileFactory::create_file_reader(
     return Status::OK();
 }
 
+doris::Status doris::FileFactory::check_user_file_path(const std::string& path,
+                                                       std::string* real_path) {
+    if (config::user_files_secure_path.empty()) {
+        return Status::NotSupported("Reading the local files is disabled by an empty "
+                                    "user_files_secure_path");
+    }
+    // the links and the '..' are resolved, so the file itself must be under the secure path
+    RETURN_IF_ERROR(FileUtils::canonicalize(path, real_path));
+    std::string secure_path;
+    RETURN_IF_ERROR(FileUtils::canonicalize(config::user_files_secure_path, &secure_path));
+    if (real_path->compare(0, secure_path.size(), secure_path) != 0 ||
+        (real_path->size() > secure_path.size() && secure_path.back() != '/' &&
+         (*real_path)[secure_path.size()] != '/')) {
+        return Status::InternalError("File {} is not under user_files_secure_path {}", path,
+                                     config::user_files_secure_path);
+    }
+    return Status::OK();
+}
+
 doris::Status doris::FileFactory::_new_file_reader(doris::ExecEnv* env, RuntimeProfile* profile,
                                                    const TFileScanRangeParams& params,
                                                    const doris::TFileRangeDesc& range,
@@ -142,6 +163,12 @@ doris::Status doris::FileFactory::_new_file_reader(doris::ExecEnv* env, RuntimeP
     }
 
     switch (type) {
+    case TFileType::FILE_LOCAL: {
+        std::string real_path;
+        RETURN_IF_ERROR(check_user_file_path(range.path, &real_path));
+        file_reader_ptr = new LocalFileReader(real_path, range.start_offset);
+        break;
+    }
     case TFileType::FILE_S3: {
         file_reader_ptr = new BufferedReader(
                 profile, new S3Reader(params.properties, range.path, range.start_offset));
@@ -58,6 +58,10 @@ public:
                                      const TFileRangeDesc& range,
                                      std::shared_ptr<FileReader>& file_reader);
 
+    // The files of the local() table valued function must be under user_files_secure_path.
+    // Sets the real path of a file there, or returns an error.
+    static Status check_user_file_path(const std::string& path, std::string* real_path);
+
     static TFileType::type convert_storage_type(TStorageBackendType::type type) {
         switch (type) {
         case TStorageBackendType::LOCAL:
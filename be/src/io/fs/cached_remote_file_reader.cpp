@@ -0,0 +1,43 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/cached_remote_file_reader.h"
+
+#include "common/logging.h"
+#include "io/fs/file_block_cache.h"
+
+namespace doris {
+namespace io {
+
+CachedRemoteFileReader::CachedRemoteFileReader(FileReaderSPtr remote_reader)
+        : _remote_reader(std::move(remote_reader)) {}
+
+Status CachedRemoteFileReader::read_at(size_t offset, Slice result, size_t* bytes_read) {
+    auto cache = FileBlockCache::instance();
+    if (cache != nullptr) {
+        auto st = cache->read_at(_remote_reader.get(), offset, result, bytes_read);
+        if (st.ok()) {
+            return st;
+        }
+        LOG(WARNING) << "failed to read " << path().native()
+                     << " through file cache: " << st.to_string();
+    }
+    return _remote_reader->read_at(offset, result, bytes_read);
+}
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,48 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "io/fs/file_reader.h"
+
+namespace doris {
+namespace io {
+
+// Reads a remote file through the FileBlockCache, falling back to the remote reader if the
+// local disks fail.
+class CachedRemoteFileReader final : public FileReader {
+public:
+    explicit CachedRemoteFileReader(FileReaderSPtr remote_reader);
+
+    ~CachedRemoteFileReader() override = default;
+
+    Status close() override { return _remote_reader->close(); }
+
+    Status read_at(size_t offset, Slice result, size_t* bytes_read) override;
+
+    const Path& path() const override { return _remote_reader->path(); }
+
+    size_t size() const override { return _remote_reader->size(); }
+
+    bool closed() const override { return _remote_reader->closed(); }
+
+private:
+    FileReaderSPtr _remote_reader;
+};
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,260 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/file_block_cache.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <tuple>
+
+#include "common/logging.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "util/murmur_hash3.h"
+#include "util/scoped_cleanup.h"
+
+namespace doris {
+namespace io {
+
+FileBlockCache* FileBlockCache::_s_instance = nullptr;
+
+namespace {
+
+static const char* TMP_FILE_SUFFIX = ".tmp";
+
+// A block file is named "<key>_<generation>", the key being "<32 hex digits of the hash of the
+// remote path>_<block offset>". Each download of a block gets a new generation, so that removing
+// the file of an evicted block never removes the file of a later download of the same block.
+// Return false if 'name' is not the name of a block file.
+bool parse_block_file_name(const std::string& name, std::string* key, uint64_t* generation) {
+    size_t sep = name.rfind('_');
+    if (name.size() < 36 || name[32] != '_' || sep == 32 || sep == name.size() - 1) {
+        return false;
+    }
+    auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    auto is_hex = [&](char c) { return is_digit(c) || (c >= 'a' && c <= 'f'); };
+    if (!std::all_of(name.begin(), name.begin() + 32, is_hex) ||
+        !std::all_of(name.begin() + 33, name.begin() + sep, is_digit) ||
+        !std::all_of(name.begin() + sep + 1, name.end(), is_digit) || name.size() - sep - 1 > 19) {
+        return false;
+    }
+    *key = name.substr(0, sep);
+    *generation = std::stoull(name.substr(sep + 1));
+    return true;
+}
+
+} // namespace
+
+FileBlockCache::~FileBlockCache() {
+    for (auto& dir : _dirs) {
+        dir->closing = true;
+    }
+}
+
+void FileBlockCache::_delete_block(const CacheKey& key, void* value) {
+    auto block = reinterpret_cast<CachedBlock*>(value);
+    if (!block->dir->closing) {
+        std::error_code ec;
+        std::filesystem::remove(block->path, ec);
+        if (ec) {
+            LOG(WARNING) << "failed to remove cached block " << block->path << ": "
+                         << ec.message();
+        }
+    }
+    delete block;
+}
+
+Status FileBlockCache::create_global_instance(const std::vector<std::string>& paths,
+                                              size_t capacity_per_path, size_t block_size) {
+    DCHECK(_s_instance == nullptr);
+    if (block_size == 0) {
+        return Status::InvalidArgument("file cache block size must be positive");
+    }
+    if (paths.empty()) {
+        return Status::OK();
+    }
+    auto cache = new FileBlockCache(block_size);
+    for (auto& path : paths) {
+        auto st = cache->add_path(path, capacity_per_path);
+        if (!st.ok()) {
+            delete cache;
+            return st;
+        }
+    }
+    _s_instance = cache;
+    return Status::OK();
+}
+
+Status FileBlockCache::add_path(const std::string& path, size_t capacity) {
+    std::error_code ec;
+    std::filesystem::create_directories(path, ec);
+    if (ec) {
+        return Status::IOError("failed to create file cache path {}: {}", path, ec.message());
+    }
+
+    auto dir = std::make_unique<CacheDir>();
+    dir->path = path;
+    // Counts the blocks, the disk space used by the cache is not memory.
+    size_t num_blocks = std::max<size_t>(capacity / _block_size, 1);
+    // A small cache is not sharded, each shard would hold too few blocks to keep the LRU order.
+    uint32_t num_shards = num_blocks < 1024 ? 1 : 16;
+    dir->cache.reset(new_lru_cache("FileBlockCache:" + path, num_blocks, LRUCacheType::NUMBER,
+                                   num_shards));
+
+    // Load the blocks cached before the restart, the least recently written first so that they
+    // are the first evicted. The files left by unfinished downloads are removed.
+    std::vector<std::tuple<std::filesystem::file_time_type, std::string, std::string>> blocks;
+    for (auto it = std::filesystem::directory_iterator(path, ec);
+         !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        std::string name = it->path().filename().native();
+        if (!it->is_regular_file(ec)) {
+            continue;
+        }
+        std::string key;
+        uint64_t generation = 0;
+        if (!parse_block_file_name(name, &key, &generation)) {
+            if (name.size() > strlen(TMP_FILE_SUFFIX) &&
+                name.compare(name.size() - strlen(TMP_FILE_SUFFIX), std::string::npos,
+                             TMP_FILE_SUFFIX) == 0) {
+                std::error_code remove_ec;
+                std::filesystem::remove(it->path(), remove_ec);
+            }
+            continue;
+        }
+        auto mtime = it->last_write_time(ec);
+        if (!ec) {
+            blocks.emplace_back(mtime, std::move(key), std::move(name));
+            _next_generation = std::max(_next_generation.load(), generation + 1);
+        }
+    }
+    if (ec) {
+        return Status::IOError("failed to list file cache path {}: {}", path, ec.message());
+    }
+    std::sort(blocks.begin(), blocks.end());
+    // A crash may leave the files of two downloads of a block, the file of the earlier one is
+    // removed when the later one replaces it in the cache.
+    for (auto& [mtime, key, name] : blocks) {
+        auto block = new CachedBlock {dir.get(), (std::filesystem::path(path) / name).native()};
+        dir->cache->release(dir->cache->insert(CacheKey(key), block, 1, _delete_block));
+    }
+    LOG(INFO) << "init file cache path " << path << ", capacity: " << capacity
+              << ", loaded blocks: " << blocks.size();
+    _dirs.push_back(std::move(dir));
+    return Status::OK();
+}
+
+Status FileBlockCache::read_at(FileReader* remote_reader, size_t offset, Slice result,
+                               size_t* bytes_read) {
+    size_t file_size = remote_reader->size();
+    if (offset > file_size) {
+        return Status::IOError("offset exceeds file size(offset: {}, file size: {}, path: {})",
+                               offset, file_size, remote_reader->path().native());
+    }
+    size_t bytes_req = std::min(result.size, file_size - offset);
+
+    uint64_t hash[2];
+    const std::string& remote_path = remote_reader->path().native();
+    murmur_hash3_x64_128(remote_path.data(), remote_path.size(), 0, hash);
+    std::string file_id = fmt::format("{:016x}{:016x}", hash[0], hash[1]);
+
+    size_t read = 0;
+    while (read < bytes_req) {
+        size_t pos = offset + read;
+        size_t block_offset = pos / _block_size * _block_size;
+        size_t n = std::min(bytes_req - read, block_offset + _block_size - pos);
+        RETURN_IF_ERROR(_read_block(remote_reader, file_id, hash[0], block_offset,
+                                    pos - block_offset, Slice(result.data + read, n)));
+        read += n;
+    }
+    *bytes_read = bytes_req;
+    return Status::OK();
+}
+
+Status FileBlockCache::_read_block(FileReader* remote_reader, const std::string& file_id,
+                                   uint64_t file_hash, size_t block_offset,
+                                   size_t offset_in_block, Slice result) {
+    // Spread the blocks of a file over all cache paths.
+    CacheDir* dir = _dirs[(file_hash + block_offset / _block_size) % _dirs.size()].get();
+    std::string name = fmt::format("{}_{}", file_id, block_offset);
+    Cache::Handle* handle = dir->cache->lookup(CacheKey(name));
+    if (handle == nullptr) {
+        RETURN_IF_ERROR(_fetch_block(remote_reader, dir, name, block_offset, &handle));
+    }
+    // The block file is not removed while the handle is held.
+    SCOPED_CLEANUP({ dir->cache->release(handle); });
+    auto block = reinterpret_cast<CachedBlock*>(dir->cache->value(handle));
+
+    FileReaderSPtr reader;
+    RETURN_IF_ERROR(global_local_filesystem()->open_file(block->path, &reader));
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(reader->read_at(offset_in_block, result, &bytes_read));
+    RETURN_IF_ERROR(reader->close());
+    if (bytes_read != result.size) {
+        return Status::IOError("cached block {} is truncated, read {} bytes, expect {}",
+                               block->path, bytes_read, result.size);
+    }
+    return Status::OK();
+}
+
+Status FileBlockCache::_fetch_block(FileReader* remote_reader, CacheDir* dir,
+                                    const std::string& name, size_t block_offset,
+                                    Cache::Handle** handle) {
+    size_t size = std::min(_block_size, remote_reader->size() - block_offset);
+    std::unique_ptr<char[]> buf(new char[size]);
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(remote_reader->read_at(block_offset, Slice(buf.get(), size), &bytes_read));
+    if (bytes_read != size) {
+        return Status::IOError("failed to read block of {} at {}, read {} bytes, expect {}",
+                               remote_reader->path().native(), block_offset, bytes_read, size);
+    }
+
+    // Written to a temporary file first, so that a crash never leaves a partial block.
+    std::string path = fmt::format("{}_{}", (std::filesystem::path(dir->path) / name).native(),
+                                   _next_generation++);
+    std::string tmp_path = path + TMP_FILE_SUFFIX;
+    {
+        // The file is removed by the writer if it is not closed.
+        FileWriterPtr writer;
+        RETURN_IF_ERROR(global_local_filesystem()->create_file(tmp_path, &writer));
+        RETURN_IF_ERROR(writer->append(Slice(buf.get(), size)));
+        RETURN_IF_ERROR(writer->close());
+    }
+
+    std::error_code ec;
+
+    std::lock_guard<std::mutex> l(dir->insert_lock);
+    // Another reader may have cached the block meanwhile.
+    *handle = dir->cache->lookup(CacheKey(name));
+    if (*handle != nullptr) {
+        std::filesystem::remove(tmp_path, ec);
+        return Status::OK();
+    }
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::error_code ignored;
+        std::filesystem::remove(tmp_path, ignored);
+        return Status::IOError("failed to rename {} to {}: {}", tmp_path, path, ec.message());
+    }
+    *handle = dir->cache->insert(CacheKey(name), new CachedBlock {dir, path}, 1, _delete_block);
+    return Status::OK();
+}
+
+} // namespace io
+} // namespace doris
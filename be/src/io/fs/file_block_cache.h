@@ -0,0 +1,94 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "io/fs/file_reader.h"
+#include "olap/lru_cache.h"
+
+namespace doris {
+namespace io {
+
+// A cache on the local disks of the blocks of remote files, such as the segments of the rowsets
+// moved to S3 by cooldown. Each block is a local file named after the hash of the remote path,
+// the offset of the block and the generation of its download, so the cached blocks are loaded again after a restart. Once a
+// cache path holds its capacity, its least recently used blocks are removed.
+class FileBlockCache {
+public:
+    // Create the global instance, caching up to 'capacity_per_path' bytes in each of 'paths'.
+    static Status create_global_instance(const std::vector<std::string>& paths,
+                                         size_t capacity_per_path, size_t block_size);
+
+    // Return nullptr if the remote files are not cached.
+    static FileBlockCache* instance() { return _s_instance; }
+
+    FileBlockCache(size_t block_size) : _block_size(block_size) {}
+
+    // The cached blocks are kept on the disks.
+    ~FileBlockCache();
+
+    // Add a directory holding up to 'capacity' bytes of blocks, the blocks already in it are
+    // loaded into the cache.
+    Status add_path(const std::string& path, size_t capacity);
+
+    // Read [offset, offset + result.size) of the file of 'remote_reader'. The blocks missing in
+    // the cache are read from 'remote_reader' and cached.
+    Status read_at(FileReader* remote_reader, size_t offset, Slice result, size_t* bytes_read);
+
+    size_t block_size() const { return _block_size; }
+
+private:
+    struct CacheDir {
+        std::string path;
+        // Set when the cache is destroyed, the evicted blocks are removed from the disk only
+        // if it is not set.
+        std::atomic<bool> closing {false};
+        std::unique_ptr<Cache> cache;
+        // Serializes the insertion of the blocks downloaded concurrently.
+        std::mutex insert_lock;
+    };
+
+    struct CachedBlock {
+        const CacheDir* dir;
+        std::string path;
+    };
+
+    static void _delete_block(const CacheKey& key, void* value);
+
+    Status _read_block(FileReader* remote_reader, const std::string& file_id, uint64_t file_hash,
+                       size_t block_offset, size_t offset_in_block, Slice result);
+
+    Status _fetch_block(FileReader* remote_reader, CacheDir* dir, const std::string& name,
+                        size_t block_offset, Cache::Handle** handle);
+
+    static FileBlockCache* _s_instance;
+
+    const size_t _block_size;
+    std::vector<std::unique_ptr<CacheDir>> _dirs;
+    // Above the generations of the blocks loaded by add_path().
+    std::atomic<uint64_t> _next_generation {0};
+};
+
+} // namespace io
+} // namespace doris
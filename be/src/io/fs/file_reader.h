@@ -26,6 +26,13 @@
 namespace doris {
 namespace io {
 
+// A range read by FileReader::read_at_batch.
+struct ReadRange {
+    size_t offset = 0;
+    Slice result;
+    size_t bytes_read = 0;
+};
+
 class FileReader {
 public:
     FileReader() = default;
@@ -37,6 +44,14 @@ public:
 
     virtual Status read_at(size_t offset, Slice result, size_t* bytes_read) = 0;
 
+    // Read several ranges, which the readers may read concurrently.
+    virtual Status read_at_batch(ReadRange* ranges, size_t num_ranges) {
+        for (size_t i = 0; i < num_ranges; ++i) {
+            RETURN_IF_ERROR(read_at(ranges[i].offset, ranges[i].result, &ranges[i].bytes_read));
+        }
+        return Status::OK();
+    }
+
     virtual const Path& path() const = 0;
 
     virtual size_t size() const = 0;
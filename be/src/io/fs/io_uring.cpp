@@ -0,0 +1,233 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/io_uring.h"
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#define DORIS_HAVE_IO_URING 1
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/config.h"
+#include "common/logging.h"
+
+namespace doris {
+namespace io {
+
+IoUring* IoUring::thread_local_ring() {
+#ifdef DORIS_HAVE_IO_URING
+    thread_local std::unique_ptr<IoUring> ring;
+    thread_local bool initialized = false;
+    if (!initialized) {
+        initialized = true;
+        std::unique_ptr<IoUring> new_ring(new IoUring());
+        auto st = new_ring->_init(config::io_uring_queue_depth);
+        if (st.ok()) {
+            ring = std::move(new_ring);
+        } else {
+            LOG(WARNING) << "io_uring is not available: " << st.to_string();
+        }
+    }
+    return ring.get();
+#else
+    return nullptr;
+#endif
+}
+
+#ifdef DORIS_HAVE_IO_URING
+
+namespace {
+
+int io_uring_setup(uint32_t entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+    return static_cast<int>(
+            syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+unsigned* ring_field(void* ring, uint32_t offset) {
+    return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+}
+
+// How long a read waits for the completions in flight before checking again, once the ring
+// can't be entered.
+constexpr auto COMPLETION_POLL_INTERVAL = std::chrono::microseconds(100);
+
+} // namespace
+
+IoUring::~IoUring() {
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ring != nullptr && _cq_ring != _sq_ring) {
+        munmap(_cq_ring, _cq_ring_size);
+    }
+    if (_sq_ring != nullptr) {
+        munmap(_sq_ring, _sq_ring_size);
+    }
+    if (_ring_fd >= 0) {
+        close(_ring_fd);
+    }
+}
+
+Status IoUring::_init(uint32_t entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    _ring_fd = io_uring_setup(std::max<uint32_t>(entries, 1), &params);
+    if (_ring_fd < 0) {
+        return Status::IOError("failed to set up io_uring: {}", std::strerror(errno));
+    }
+    _entries = params.sq_entries;
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    void* ptr = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     _ring_fd, IORING_OFF_SQ_RING);
+    if (ptr == MAP_FAILED) {
+        return Status::IOError("failed to map io_uring: {}", std::strerror(errno));
+    }
+    _sq_ring = ptr;
+    if (single_mmap) {
+        _cq_ring = _sq_ring;
+    } else {
+        ptr = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   _ring_fd, IORING_OFF_CQ_RING);
+        if (ptr == MAP_FAILED) {
+            return Status::IOError("failed to map io_uring: {}", std::strerror(errno));
+        }
+        _cq_ring = ptr;
+    }
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    ptr = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+               IORING_OFF_SQES);
+    if (ptr == MAP_FAILED) {
+        return Status::IOError("failed to map io_uring: {}", std::strerror(errno));
+    }
+    _sqes = static_cast<io_uring_sqe*>(ptr);
+
+    _sq_tail = ring_field(_sq_ring, params.sq_off.tail);
+    _sq_mask = ring_field(_sq_ring, params.sq_off.ring_mask);
+    _sq_array = ring_field(_sq_ring, params.sq_off.array);
+    _cq_head = ring_field(_cq_ring, params.cq_off.head);
+    _cq_tail = ring_field(_cq_ring, params.cq_off.tail);
+    _cq_mask = ring_field(_cq_ring, params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe*>(static_cast<char*>(_cq_ring) + params.cq_off.cqes);
+    return Status::OK();
+}
+
+Status IoUring::read(int fd, ReadRange* ranges, size_t num_ranges) {
+    std::vector<iovec> iovecs(num_ranges);
+    size_t num_submitted = 0;
+    size_t num_completed = 0;
+    // queued in the submission ring but not consumed by the kernel yet
+    uint32_t num_queued = 0;
+    Status status;
+    while (num_completed < num_submitted || (num_submitted < num_ranges && status.ok())) {
+        // only this thread produces submissions, so the tail is read without synchronization
+        unsigned tail = *_sq_tail;
+        while (status.ok() && num_submitted < num_ranges &&
+               num_submitted - num_completed < _entries) {
+            ReadRange& range = ranges[num_submitted];
+            iovecs[num_submitted] = {range.result.data, range.result.size};
+            unsigned index = tail & *_sq_mask;
+            io_uring_sqe* sqe = &_sqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = fd;
+            sqe->addr = reinterpret_cast<uint64_t>(&iovecs[num_submitted]);
+            sqe->len = 1;
+            sqe->off = range.offset;
+            sqe->user_data = num_submitted;
+            _sq_array[index] = index;
+            ++tail;
+            ++num_submitted;
+            ++num_queued;
+        }
+        __atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+
+        int ret = io_uring_enter(_ring_fd, num_queued, 1, IORING_ENTER_GETEVENTS);
+        if (ret >= 0) {
+            num_queued -= ret;
+        } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            if (status.ok()) {
+                status = Status::IOError("failed to enter io_uring: {}", std::strerror(errno));
+            }
+            // A failed enter submits nothing, so the reads queued are taken back. The buffers
+            // of the reads in flight may still be written, their completions are waited for
+            // without entering the ring, the kernel posts them anyway.
+            tail -= num_queued;
+            __atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+            num_submitted -= num_queued;
+            num_queued = 0;
+            if (__atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE) == *_cq_head) {
+                std::this_thread::sleep_for(COMPLETION_POLL_INTERVAL);
+            }
+        }
+
+        unsigned head = *_cq_head;
+        while (head != __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE)) {
+            io_uring_cqe* cqe = &_cqes[head & *_cq_mask];
+            ReadRange& range = ranges[cqe->user_data];
+            if (cqe->res < 0) {
+                status = Status::IOError("failed to read at {}: {}", range.offset,
+                                         std::strerror(-cqe->res));
+            } else {
+                range.bytes_read = cqe->res;
+            }
+            ++head;
+            ++num_completed;
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+    }
+    return status;
+}
+
+#else
+
+IoUring::~IoUring() = default;
+
+Status IoUring::_init(uint32_t entries) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+Status IoUring::read(int fd, ReadRange* ranges, size_t num_ranges) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+#endif
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/status.h"
+#include "io/fs/file_reader.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace doris {
+namespace io {
+
+// A minimal io_uring instance to read local files, without liburing. A ring is owned by a
+// thread, reads submit all their ranges before waiting for them, so that the disk sees them
+// at once instead of one pread after another.
+class IoUring {
+public:
+    // Return the ring of the calling thread, or nullptr if io_uring is not supported.
+    static IoUring* thread_local_ring();
+
+    ~IoUring();
+
+    // Read the ranges from 'fd' concurrently. The bytes read by a range may be less than its
+    // size at the end of the file.
+    Status read(int fd, ReadRange* ranges, size_t num_ranges);
+
+private:
+    IoUring() = default;
+
+    Status _init(uint32_t entries);
+
+    int _ring_fd = -1;
+    uint32_t _entries = 0;
+
+    void* _sq_ring = nullptr;
+    size_t _sq_ring_size = 0;
+    void* _cq_ring = nullptr;
+    size_t _cq_ring_size = 0;
+    io_uring_sqe* _sqes = nullptr;
+    size_t _sqes_size = 0;
+
+    unsigned* _sq_tail = nullptr;
+    unsigned* _sq_mask = nullptr;
+    unsigned* _sq_array = nullptr;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned* _cq_mask = nullptr;
+    io_uring_cqe* _cqes = nullptr;
+};
+
+} // namespace io
+} // namespace doris
@@ -17,8 +17,12 @@
 
 #include "io/fs/local_file_reader.h"
 
+#include <algorithm>
 #include <atomic>
+#include <vector>
 
+#include "common/config.h"
+#include "io/fs/io_uring.h"
 #include "util/doris_metrics.h"
 #include "util/errno.h"
 
@@ -49,6 +53,62 @@ Status LocalFileReader::close() {
 
 Status LocalFileReader::read_at(size_t offset, Slice result, size_t* bytes_read) {
     DCHECK(!closed());
+    IoUring* ring = config::enable_io_uring ? IoUring::thread_local_ring() : nullptr;
+    if (ring != nullptr) {
+        ReadRange range;
+        range.offset = offset;
+        range.result = result;
+        RETURN_IF_ERROR(_read_with_ring(ring, &range, 1));
+        *bytes_read = range.bytes_read;
+        return Status::OK();
+    }
+    return _pread_at(offset, result, bytes_read);
+}
+
+Status LocalFileReader::read_at_batch(ReadRange* ranges, size_t num_ranges) {
+    DCHECK(!closed());
+    IoUring* ring = config::enable_io_uring ? IoUring::thread_local_ring() : nullptr;
+    if (ring != nullptr) {
+        return _read_with_ring(ring, ranges, num_ranges);
+    }
+    for (size_t i = 0; i < num_ranges; ++i) {
+        RETURN_IF_ERROR(_pread_at(ranges[i].offset, ranges[i].result, &ranges[i].bytes_read));
+    }
+    return Status::OK();
+}
+
+Status LocalFileReader::_read_with_ring(IoUring* ring, ReadRange* ranges, size_t num_ranges) {
+    // the ranges clamped to the end of the file
+    std::vector<ReadRange> reads(ranges, ranges + num_ranges);
+    for (auto& read : reads) {
+        if (read.offset > _file_size) {
+            return Status::IOError("offset exceeds file size(offset: {}, file size: {}, path: {})",
+                                   read.offset, _file_size, _path.native());
+        }
+        read.result.size = std::min(read.result.size, _file_size - read.offset);
+        read.bytes_read = 0;
+    }
+    RETURN_IF_ERROR(ring->read(_fd, reads.data(), num_ranges));
+    size_t total_bytes_read = 0;
+    for (size_t i = 0; i < num_ranges; ++i) {
+        // finish the short reads synchronously
+        size_t bytes_read = reads[i].bytes_read;
+        if (bytes_read < reads[i].result.size) {
+            size_t rest = 0;
+            RETURN_IF_ERROR(_pread_at(reads[i].offset + bytes_read,
+                                      Slice(reads[i].result.data + bytes_read,
+                                            reads[i].result.size - bytes_read),
+                                      &rest));
+            bytes_read += rest;
+        }
+        ranges[i].bytes_read = bytes_read;
+        total_bytes_read += bytes_read;
+    }
+    DorisMetrics::instance()->local_bytes_read_total->increment(total_bytes_read);
+    return Status::OK();
+}
+
+Status LocalFileReader::_pread_at(size_t offset, Slice result, size_t* bytes_read) {
     if (offset > _file_size) {
         return Status::IOError(
                 fmt::format("offset exceeds file size(offset: {), file size: {}, path: {})", offset,
@@ -25,6 +25,8 @@
 namespace doris {
 namespace io {
 
+class IoUring;
+
 class LocalFileReader final : public FileReader {
 public:
     LocalFileReader(Path path, size_t file_size, int fd);
@@ -35,6 +37,9 @@ public:
 
     Status read_at(size_t offset, Slice result, size_t* bytes_read) override;
 
+    // Read the ranges through the io_uring of the thread if enable_io_uring is set.
+    Status read_at_batch(ReadRange* ranges, size_t num_ranges) override;
+
     const Path& path() const override { return _path; }
 
     size_t size() const override { return _file_size; }
@@ -42,6 +47,10 @@ public:
     bool closed() const override { return _closed.load(std::memory_order_acquire); }
 
 private:
+    Status _pread_at(size_t offset, Slice result, size_t* bytes_read);
+
+    Status _read_with_ring(IoUring* ring, ReadRange* ranges, size_t num_ranges);
+
     int _fd = -1; // owned
     Path _path;
     size_t _file_size;
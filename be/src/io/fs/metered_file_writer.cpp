@@ -0,0 +1,48 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/metered_file_writer.h"
+
+#include "util/slice.h"
+
+namespace doris {
+namespace io {
+
+MeteredFileWriter::MeteredFileWriter(FileWriterPtr writer, std::function<void(size_t)> meter)
+        : FileWriter(Path(writer->path())), _writer(std::move(writer)), _meter(std::move(meter)) {}
+
+Status MeteredFileWriter::append(const Slice& data) {
+    _meter(data.size);
+    return _writer->append(data);
+}
+
+Status MeteredFileWriter::appendv(const Slice* data, size_t data_cnt) {
+    size_t bytes = 0;
+    for (size_t i = 0; i < data_cnt; ++i) {
+        bytes += data[i].size;
+    }
+    _meter(bytes);
+    return _writer->appendv(data, data_cnt);
+}
+
+Status MeteredFileWriter::write_at(size_t offset, const Slice& data) {
+    _meter(data.size);
+    return _writer->write_at(offset, data);
+}
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+
+#include "io/fs/file_writer.h"
+
+namespace doris {
+namespace io {
+
+// Wraps a file writer to report the size of every write before it is done, the report may
+// block to pace the writes.
+class MeteredFileWriter final : public FileWriter {
+public:
+    MeteredFileWriter(FileWriterPtr writer, std::function<void(size_t)> meter);
+    ~MeteredFileWriter() override = default;
+
+    Status close() override { return _writer->close(); }
+
+    Status abort() override { return _writer->abort(); }
+
+    Status append(const Slice& data) override;
+
+    Status appendv(const Slice* data, size_t data_cnt) override;
+
+    Status write_at(size_t offset, const Slice& data) override;
+
+    Status finalize() override { return _writer->finalize(); }
+
+    size_t bytes_appended() const override { return _writer->bytes_appended(); }
+
+private:
+    FileWriterPtr _writer;
+    std::function<void(size_t)> _meter;
+};
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/prefetch_file_reader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/logging.h"
+#include "util/threadpool.h"
+
+namespace doris {
+namespace io {
+
+PrefetchFileReader::PrefetchFileReader(FileReader* reader, ThreadPool* pool)
+        : _reader(reader), _pool(pool) {}
+
+PrefetchFileReader::~PrefetchFileReader() {
+    std::unique_lock<std::mutex> l(_lock);
+    _cond.wait(l, [this] { return _num_pending == 0; });
+}
+
+void PrefetchFileReader::prefetch(size_t offset, size_t size) {
+    auto range = std::make_shared<Range>();
+    range->offset = offset;
+    range->size = size;
+    range->data.reset(new char[size]);
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        ++_num_pending;
+    }
+    auto st = _pool->submit_func([this, range] {
+        size_t bytes_read = 0;
+        auto st = _reader->read_at(range->offset, Slice(range->data.get(), range->size),
+                                   &bytes_read);
+        if (st.ok() && bytes_read != range->size) {
+            st = Status::IOError("failed to prefetch {}(bytes read: {}, bytes req: {})",
+                                 _reader->path().native(), bytes_read, range->size);
+        }
+        std::lock_guard<std::mutex> l(_lock);
+        range->status = std::move(st);
+        range->done = true;
+        --_num_pending;
+        _cond.notify_all();
+    });
+    std::lock_guard<std::mutex> l(_lock);
+    if (!st.ok()) {
+        --_num_pending;
+        return;
+    }
+    _ranges.push_back(std::move(range));
+}
+
+void PrefetchFileReader::reset() {
+    std::lock_guard<std::mutex> l(_lock);
+    _ranges.clear();
+}
+
+Status PrefetchFileReader::read_at(size_t offset, Slice result, size_t* bytes_read) {
+    std::unique_lock<std::mutex> l(_lock);
+    auto it = std::find_if(_ranges.begin(), _ranges.end(), [&](const auto& range) {
+        return range->offset <= offset && offset + result.size <= range->offset + range->size;
+    });
+    if (it != _ranges.end()) {
+        _ranges.erase(_ranges.begin(), it);
+        auto range = _ranges.front();
+        _cond.wait(l, [&] { return range->done; });
+        if (range->status.ok()) {
+            memcpy(result.data, range->data.get() + (offset - range->offset), result.size);
+            if (offset + result.size == range->offset + range->size) {
+                _ranges.pop_front();
+            }
+            *bytes_read = result.size;
+            return Status::OK();
+        }
+        LOG(WARNING) << "read " << path().native() << " again after prefetch failed: "
+                     << range->status.to_string();
+        _ranges.pop_front();
+    }
+    l.unlock();
+    return _reader->read_at(offset, result, bytes_read);
+}
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "io/fs/file_reader.h"
+
+namespace doris {
+
+class ThreadPool;
+
+namespace io {
+
+// Wraps the reader of a remote file to read the ranges that will be needed soon asynchronously.
+// The file is read in order: a read served from a prefetched range discards the ranges before
+// it. The reads not covered by a prefetched range go to the wrapped reader directly.
+class PrefetchFileReader final : public FileReader {
+public:
+    // 'reader' must outlive this reader, the ranges are read by the threads of 'pool'.
+    PrefetchFileReader(FileReader* reader, ThreadPool* pool);
+
+    // Wait for the ranges being read.
+    ~PrefetchFileReader() override;
+
+    // The wrapped reader is not owned, so it is not closed.
+    Status close() override { return Status::OK(); }
+
+    Status read_at(size_t offset, Slice result, size_t* bytes_read) override;
+
+    const Path& path() const override { return _reader->path(); }
+
+    size_t size() const override { return _reader->size(); }
+
+    bool closed() const override { return _reader->closed(); }
+
+    // Read [offset, offset + size) asynchronously. The range is dropped if it can't be submitted.
+    void prefetch(size_t offset, size_t size);
+
+    // Discard the prefetched ranges, such as after a seek.
+    void reset();
+
+private:
+    struct Range {
+        size_t offset;
+        size_t size;
+        std::unique_ptr<char[]> data;
+        bool done = false;
+        Status status;
+    };
+
+    FileReader* _reader;
+    ThreadPool* _pool;
+
+    std::mutex _lock;
+    std::condition_variable _cond;
+    // The prefetched ranges in the order of their offsets.
+    std::deque<std::shared_ptr<Range>> _ranges;
+    int _num_pending = 0;
+};
+
+} // namespace io
+} // namespace doris
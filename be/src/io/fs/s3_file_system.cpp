@@ -17,6 +17,7 @@
 
 #include "io/fs/s3_file_system.h"
 
+#include <aws/core/utils/ratelimiter/DefaultRateLimiter.h>
 #include <aws/core/utils/threading/Executor.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
@@ -31,12 +32,24 @@
 #include "common/config.h"
 #include "common/status.h"
 #include "gutil/strings/stringpiece.h"
+#include "io/fs/cached_remote_file_reader.h"
+#include "io/fs/file_block_cache.h"
 #include "io/fs/remote_file_system.h"
 #include "io/fs/s3_file_reader.h"
 
 namespace doris {
 namespace io {
 
+// The uploads of all the file systems share the limit of config::s3_upload_max_speed_kbps.
+static std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> upload_rate_limiter() {
+    static std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> limiter =
+            config::s3_upload_max_speed_kbps > 0
+                    ? std::make_shared<Aws::Utils::RateLimits::DefaultRateLimiter<>>(
+                              config::s3_upload_max_speed_kbps * 1024)
+                    : nullptr;
+    return limiter;
+}
+
 S3FileSystem::S3FileSystem(const std::map<std::string, std::string>& properties, std::string bucket,
                            std::string prefix, ResourceId resource_id)
         : RemoteFileSystem(Path(properties.at(S3_ENDPOINT)) / bucket / prefix,
@@ -53,7 +66,7 @@ S3FileSystem::~S3FileSystem() = default;
 
 Status S3FileSystem::connect() {
     std::lock_guard lock(_client_mu);
-    _client = ClientFactory::instance().create(_properties);
+    _client = ClientFactory::instance().create(_properties, upload_rate_limiter());
     return Status::OK();
 }
 
@@ -132,6 +145,9 @@ Status S3FileSystem::open_file(const Path& path, FileReaderSPtr* reader) {
     auto fs_path = Path(_endpoint) / _bucket / key;
     *reader = std::make_unique<S3FileReader>(std::move(fs_path), fsize, std::move(key), _bucket,
                                              this);
+    if (FileBlockCache::instance() != nullptr) {
+        *reader = std::make_shared<CachedRemoteFileReader>(std::move(*reader));
+    }
     return Status::OK();
 }
 
@@ -22,6 +22,7 @@
 #include <fstream>
 
 #include "agent/utils.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "util/string_util.h"
 #include "util/uid_util.h"
@@ -93,6 +94,17 @@ HDFSCommonBuilder createHDFSBuilder(const THdfsParams& hdfsParams) {
         builder.need_kinit = true;
         builder.hdfs_kerberos_keytab = hdfsParams.hdfs_kerberos_keytab;
     }
+    // the defaults of the backend, overridden by the conf of the table
+    if (!config::hdfs_domain_socket_path.empty()) {
+        hdfsBuilderConfSetStr(builder.get(), "dfs.client.read.shortcircuit", "true");
+        hdfsBuilderConfSetStr(builder.get(), "dfs.domain.socket.path",
+                              config::hdfs_domain_socket_path.c_str());
+    }
+    if (config::hdfs_read_timeout_ms > 0) {
+        // the client reads the block from another replica when a datanode times out
+        std::string read_timeout = std::to_string(config::hdfs_read_timeout_ms);
+        hdfsBuilderConfSetStr(builder.get(), "input.read.timeout", read_timeout.c_str());
+    }
     // set other conf
     if (hdfsParams.__isset.hdfs_conf) {
         for (const THdfsConf& conf : hdfsParams.hdfs_conf) {
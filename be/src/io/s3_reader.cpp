@@ -21,10 +21,15 @@
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/strcat.h"
+#include "io/fs/s3_common.h"
+#include "runtime/exec_env.h"
 #include "service/backend_options.h"
+#include "util/countdown_latch.h"
 #include "util/s3_util.h"
+#include "util/threadpool.h"
 
 namespace doris {
 
@@ -87,26 +92,63 @@ Status S3Reader::readat(int64_t position, int64_t nbytes, int64_t* bytes_read, v
         VLOG_FILE << "Read end of file: " + _path;
         return Status::OK();
     }
+    *bytes_read = 0;
+    nbytes = std::min(nbytes, _file_size - position);
+    // a large read, like filling the buffer of a BufferedReader, is fetched as parts in parallel
+    // since a single GetObject stream is far slower than the bandwidth of the backend
+    int64_t part_size = config::s3_parallel_read_part_size_bytes;
+    ThreadPool* pool = ExecEnv::GetInstance()->remote_prefetch_thread_pool();
+    int64_t num_parts = 1;
+    if (part_size > 0 && pool != nullptr && nbytes > part_size) {
+        num_parts = (nbytes + part_size - 1) / part_size;
+    }
+    if (num_parts == 1) {
+        RETURN_IF_ERROR(_read_range(position, nbytes, out));
+    } else {
+        std::vector<Status> statuses(num_parts);
+        CountDownLatch latch(num_parts - 1);
+        for (int64_t i = 1; i < num_parts; ++i) {
+            int64_t offset = i * part_size;
+            int64_t len = std::min(part_size, nbytes - offset);
+            char* part_out = reinterpret_cast<char*>(out) + offset;
+            auto fetch = [this, &statuses, &latch, i, position, offset, len, part_out]() {
+                statuses[i] = _read_range(position + offset, len, part_out);
+                latch.count_down();
+            };
+            if (!pool->submit_func(fetch).ok()) {
+                fetch();
+            }
+        }
+        statuses[0] = _read_range(position, part_size, out);
+        latch.wait();
+        for (auto& st : statuses) {
+            RETURN_IF_ERROR(st);
+        }
+    }
+    *bytes_read = nbytes;
+    _cur_offset = position + nbytes;
+    return Status::OK();
+}
+
+Status S3Reader::_read_range(int64_t position, int64_t nbytes, void* out) {
     Aws::S3::Model::GetObjectRequest request;
     request.WithBucket(_uri.get_bucket()).WithKey(_uri.get_key());
-    string bytes = StrCat("bytes=", position, "-");
-    if (position + nbytes < _file_size) {
-        bytes = StrCat(bytes.c_str(), position + nbytes - 1);
-    }
-    request.SetRange(bytes.c_str());
+    request.SetRange(StrCat("bytes=", position, "-", position + nbytes - 1).c_str());
+    // the body is written into out directly instead of a buffer of the response
+    request.SetResponseStreamFactory(AwsWriteableStreamFactory(out, nbytes));
     auto response = _client->GetObject(request);
     if (!response.IsSuccess()) {
-        *bytes_read = 0;
-        std::stringstream out;
-        out << "Error: [" << response.GetError().GetExceptionName() << ":"
+        std::stringstream err;
+        err << "Error: [" << response.GetError().GetExceptionName() << ":"
             << response.GetError().GetMessage() << "] at " << BackendOptions::get_localhost();
-        LOG(INFO) << out.str();
-        return Status::InternalError(out.str());
+        LOG(INFO) << err.str();
+        return Status::InternalError(err.str());
+    }
+    if (response.GetResult().GetContentLength() != nbytes) {
+        return Status::InternalError("Read {} bytes at {} of {}, but {} bytes are expected",
+                                     response.GetResult().GetContentLength(), position, _path,
+                                     nbytes);
     }
-    *bytes_read = response.GetResult().GetContentLength();
-    *bytes_read = nbytes < *bytes_read ? nbytes : *bytes_read;
-    _cur_offset = position + *bytes_read;
-    response.GetResult().GetBody().read((char*)out, *bytes_read);
     return Status::OK();
 }
 
@@ -58,6 +58,9 @@ public:
     virtual bool closed() override;
 
 private:
+    // Reads exactly [position, position + nbytes) of the file into out.
+    Status _read_range(int64_t position, int64_t nbytes, void* out);
+
     const std::map<std::string, std::string>& _properties;
     std::string _path;
     S3URI _uri;
@@ -18,10 +18,12 @@
 #include "io/s3_writer.h"
 
 #include <aws/core/utils/FileSystemUtils.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/HeadObjectRequest.h>
-#include <aws/s3/model/PutObjectRequest.h>
+#include <aws/transfer/TransferManager.h>
 
+#include "common/config.h"
 #include "runtime/exec_env.h"
 #include "runtime/tmp_file_mgr.h"
 #include "service/backend_options.h"
@@ -37,6 +39,13 @@ namespace doris {
     }
 #endif
 
+// The writers of all the exports upload the parts of their files on the threads of one executor.
+static Aws::Utils::Threading::Executor* upload_executor() {
+    static auto executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(
+            "S3Writer", config::s3_transfer_executor_pool_size);
+    return executor.get();
+}
+
 S3Writer::S3Writer(const std::map<std::string, std::string>& properties, const std::string& path,
                    int64_t start_offset)
         : _properties(properties),
@@ -118,20 +127,23 @@ Status S3Writer::_sync() {
                 "write temp file error");
     }
     CHECK_S3_CLIENT(_client);
-    Aws::S3::Model::PutObjectRequest request;
-    request.WithBucket(_uri.get_bucket()).WithKey(_uri.get_key());
+    // the transfer manager uploads a large file by a multipart upload of concurrent parts
+    Aws::Transfer::TransferManagerConfiguration transfer_config(upload_executor());
+    transfer_config.s3Client = _client;
+    auto transfer_manager = Aws::Transfer::TransferManager::Create(transfer_config);
     long offset = _temp_file->tellp();
     _temp_file->seekg(0);
-    request.SetBody(_temp_file);
-    request.SetContentLength(offset);
-    auto response = _client->PutObject(request);
+    auto handle = transfer_manager->UploadFile(_temp_file, _uri.get_bucket(), _uri.get_key(),
+                                               "text/plain", Aws::Map<Aws::String, Aws::String>());
+    handle->WaitUntilFinished();
     _temp_file->clear();
     _temp_file->seekp(offset);
-    if (response.IsSuccess()) {
+    if (handle->GetStatus() == Aws::Transfer::TransferStatus::COMPLETED) {
         return Status::OK();
     } else {
-        return Status::InternalError("Error: [{}:{}] at {}", response.GetError().GetExceptionName(),
-                                     response.GetError().GetMessage(),
+        return Status::InternalError("Error: [{}:{}] at {}",
+                                     handle->GetLastError().GetExceptionName(),
+                                     handle->GetLastError().GetMessage(),
                                      BackendOptions::get_localhost());
     }
 }
@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace doris {
+
+// Orders the predicates of a conjunction evaluated one after another on the rows left by the
+// previous ones, by their pass rate and cost measured on the blocks read. Every `interval` blocks
+// they are sorted by their cost per input row divided by the fraction of the rows they remove,
+// so a cheap and selective `status = 3` comes before an expensive LIKE whatever the order of the
+// plan. The measures decay at each reordering, so the order follows the data as it changes.
+template <typename Predicate>
+class AdaptivePredicateOrder {
+public:
+    explicit AdaptivePredicateOrder(int64_t interval) : _interval(std::max<int64_t>(1, interval)) {}
+
+    // Records an evaluation of the index-th predicate of the current order.
+    void update(size_t index, size_t input_rows, size_t output_rows, int64_t cost_ns) {
+        if (index >= _stats.size()) {
+            _stats.resize(index + 1);
+        }
+        _stats[index].input_rows += input_rows;
+        _stats[index].output_rows += output_rows;
+        _stats[index].cost_ns += cost_ns;
+    }
+
+    // Called after each block, reorders `predicates` when it's time to. Returns whether their
+    // order changed.
+    bool reorder(std::vector<Predicate>* predicates) {
+        if (++_blocks < _interval || predicates->size() < 2) {
+            return false;
+        }
+        _blocks = 0;
+        _stats.resize(predicates->size());
+        std::vector<double> ranks(predicates->size());
+        for (size_t i = 0; i < ranks.size(); ++i) {
+            ranks[i] = _stats[i].rank();
+        }
+        std::vector<size_t> order(predicates->size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t lhs, size_t rhs) { return ranks[lhs] < ranks[rhs]; });
+        bool changed = false;
+        std::vector<Predicate> ordered;
+        std::vector<Stats> ordered_stats;
+        ordered.reserve(order.size());
+        ordered_stats.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            changed |= order[i] != i;
+            ordered.push_back((*predicates)[order[i]]);
+            ordered_stats.push_back(_stats[order[i]].decay());
+        }
+        predicates->swap(ordered);
+        _stats.swap(ordered_stats);
+        return changed;
+    }
+
+private:
+    struct Stats {
+        int64_t input_rows = 0;
+        int64_t output_rows = 0;
+        int64_t cost_ns = 0;
+
+        // A predicate removing no row, or not reached because the ones before it removed all
+        // the rows, goes after the others.
+        double rank() const {
+            double removed =
+                    input_rows == 0 ? 0 : 1 - static_cast<double>(output_rows) / input_rows;
+            if (removed <= 0) {
+                return std::numeric_limits<double>::max();
+            }
+            return static_cast<double>(cost_ns) / input_rows / removed;
+        }
+
+        Stats decay() const { return {input_rows / 2, output_rows / 2, cost_ns / 2}; }
+    };
+
+    const int64_t _interval;
+    int64_t _blocks = 0;
+    std::vector<Stats> _stats;
+};
+
+} // namespace doris
@@ -59,9 +59,16 @@ Status BaseTablet::set_tablet_state(TabletState state) {
     }
     _tablet_meta->set_tablet_state(state);
     _state = state;
+    _mark_compaction_score_dirty();
     return Status::OK();
 }
 
+void BaseTablet::_mark_compaction_score_dirty() {
+    if (_data_dir != nullptr && _tablet_meta != nullptr) {
+        _data_dir->mark_compaction_score_dirty(tablet_id());
+    }
+}
+
 void BaseTablet::_gen_tablet_path() {
     if (_data_dir != nullptr && _tablet_meta != nullptr) {
         _tablet_path = fmt::format("{}/{}/{}/{}/{}", _data_dir->path(), DATA_PREFIX, shard_id(),
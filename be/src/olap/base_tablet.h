@@ -71,6 +71,9 @@ public:
 
 protected:
     void _gen_tablet_path();
+    // Called when the rowsets, the cumulative point or the state of the tablet change, which
+    // change its compaction scores.
+    void _mark_compaction_score_dirty();
 
 protected:
     TabletState _state;
@@ -20,7 +20,10 @@
 #include <roaring/roaring.hh>
 
 #include "olap/column_block.h"
+#include "olap/rowset/segment_v2/bit_sliced_index_reader.h"
 #include "olap/rowset/segment_v2/bitmap_index_reader.h"
+#include "olap/rowset/segment_v2/bloom_filter.h"
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
 #include "olap/selection_vector.h"
 #include "vec/columns/column.h"
 
@@ -75,6 +78,39 @@ public:
                             const std::vector<BitmapIndexIterator*>& iterators, uint32_t num_rows,
                             roaring::Roaring* roaring) const = 0;
 
+    // evaluate predicate on the inverted index of its column. The index only tells the rows that
+    // may match, so the rows that can't are removed from `bitmap` and the predicate still has to
+    // be evaluated on the others.
+    virtual Status evaluate_inverted_index(const Schema& schema, InvertedIndexIterator* iterator,
+                                           uint32_t num_rows, roaring::Roaring* bitmap) const {
+        return Status::OK();
+    }
+
+    // evaluate predicate on the bit-sliced bitmap index of its column. *evaluated is set if the
+    // rows that don't match have been removed from `bitmap`, the index being exact the predicate
+    // needn't be evaluated on the others then.
+    virtual Status evaluate_bit_sliced_index(BitSlicedIndexIterator* iterator, uint32_t num_rows,
+                                             roaring::Roaring* bitmap, bool* evaluated) const {
+        *evaluated = false;
+        return Status::OK();
+    }
+
+    // whether evaluate_ngram_bloom_filter() can tell the pages without any matching row
+    virtual bool can_do_ngram_bloom_filter(uint32_t gram_size) const { return false; }
+
+    // evaluate predicate on the ngram bloom filter of a page, whose substrings have gram_size
+    // bytes. Returns false if no row of the page can match.
+    virtual bool evaluate_ngram_bloom_filter(const BloomFilter* bf, uint32_t gram_size) const {
+        return true;
+    }
+
+    // whether the predicate is true just for the strings equal to a value, which is set to value
+    virtual bool is_string_equal(std::string* value) const { return false; }
+
+    // whether the predicate is true just for the strings starting with a prefix, which is set to
+    // prefix
+    virtual bool is_string_prefix(std::string* prefix) const { return false; }
+
     // evaluate predicate on IColumn
     // a short circuit eval way
     virtual uint16_t evaluate(const vectorized::IColumn& column, uint16_t* sel,
@@ -19,6 +19,7 @@
 
 #include "common/status.h"
 #include "gutil/strings/substitute.h"
+#include "olap/compaction_io_scheduler.h"
 #include "olap/rowset/rowset_meta.h"
 #include "olap/tablet.h"
 #include "util/time.h"
@@ -147,6 +148,8 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     const TabletSchema cur_tablet_schema = _tablet->tablet_schema();
 
     RETURN_NOT_OK(construct_output_rowset_writer(&cur_tablet_schema));
+    _io_meter = std::make_unique<CompactionIOMeter>(_tablet, compaction_type());
+    _output_rs_writer->set_io_meter(_io_meter.get());
     RETURN_NOT_OK(construct_input_rowset_readers());
     TRACE("prepare finished");
 
@@ -155,7 +158,16 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     Merger::Statistics stats;
     Status res;
 
-    if (use_vectorized_compaction) {
+    if (can_link_input_rowsets(cur_tablet_schema)) {
+        merge_type = "ordered ";
+        res = link_input_rowsets(&stats);
+    } else if (use_vectorized_compaction &&
+               Merger::can_vertical_merge(_tablet, compaction_type(), cur_tablet_schema,
+                                   _input_rowsets)) {
+        merge_type = "vertical ";
+        res = Merger::vertical_merge_rowsets(_tablet, compaction_type(), &cur_tablet_schema,
+                                             _input_rowsets, _output_rs_writer.get(), &stats);
+    } else if (use_vectorized_compaction) {
         res = Merger::vmerge_rowsets(_tablet, compaction_type(), &cur_tablet_schema,
                                      _input_rs_readers, _output_rs_writer.get(), &stats);
     } else {
@@ -229,6 +241,83 @@ Status Compaction::construct_output_rowset_writer(const TabletSchema* schema) {
                                          &_output_rs_writer);
 }
 
+bool Compaction::can_link_input_rowsets(const TabletSchema& schema) {
+    if (!config::enable_ordered_data_compaction ||
+        _tablet->enable_unique_key_merge_on_write()) {
+        return false;
+    }
+    // the segments are sorted by the z-order of the keys, which the key bounds don't follow
+    if (schema.sort_type() == SortType::ZORDER) {
+        return false;
+    }
+    // The encoded keys of a variable length column are not terminated, the bounds are only
+    // compared as the keys when it is the last key column.
+    for (size_t cid = 0; cid + 1 < schema.num_key_columns(); ++cid) {
+        auto type = schema.column(cid).type();
+        if (type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR ||
+            type == OLAP_FIELD_TYPE_STRING) {
+            return false;
+        }
+    }
+    // the rows with the same key are merged in UNIQUE_KEYS and AGG_KEYS
+    bool allow_equal_keys = schema.keys_type() == KeysType::DUP_KEYS;
+    const std::string* last_max_key = nullptr;
+    std::vector<KeyBoundsPB> segments_key_bounds;
+    for (auto& rowset : _input_rowsets) {
+        if (rowset->rowset_meta()->rowset_type() != BETA_ROWSET || !rowset->is_local() ||
+            rowset->rowset_meta()->has_delete_predicate() ||
+            rowset->tablet_schema()->schema_version() != schema.schema_version()) {
+            return false;
+        }
+        if (rowset->num_segments() == 0) {
+            continue;
+        }
+        std::vector<KeyBoundsPB> key_bounds;
+        if (!rowset->get_segments_key_bounds(&key_bounds).ok() ||
+            key_bounds.size() != rowset->num_segments()) {
+            return false;
+        }
+        segments_key_bounds.insert(segments_key_bounds.end(), key_bounds.begin(),
+                                   key_bounds.end());
+    }
+    // linking keeps the segments as they are, so the small ones are merged into bigger ones
+    int64_t input_size = 0;
+    for (auto& rowset : _input_rowsets) {
+        input_size += rowset->data_disk_size();
+    }
+    if (segments_key_bounds.size() > 1 &&
+        input_size / static_cast<int64_t>(segments_key_bounds.size()) <
+                config::ordered_compaction_min_segment_size_mbytes << 20) {
+        return false;
+    }
+    for (auto& key_bounds : segments_key_bounds) {
+        if (last_max_key != nullptr) {
+            int cmp = key_bounds.min_key().compare(*last_max_key);
+            if (cmp < 0 || (cmp == 0 && !allow_equal_keys)) {
+                return false;
+            }
+        }
+        last_max_key = &key_bounds.max_key();
+    }
+    return true;
+}
+
+Status Compaction::link_input_rowsets(Merger::Statistics* stats) {
+    for (auto& rowset : _input_rowsets) {
+        if (rowset->num_segments() == 0) {
+            continue;
+        }
+        RETURN_NOT_OK_LOG(_output_rs_writer->add_rowset(rowset),
+                          "failed to link rowset " + rowset->rowset_id().to_string() +
+                                  " to the output rowset of tablet " + _tablet->full_name());
+    }
+    RETURN_NOT_OK(_output_rs_writer->flush());
+    stats->output_rows = _input_row_num;
+    stats->merged_rows = 0;
+    stats->filtered_rows = 0;
+    return Status::OK();
+}
+
 Status Compaction::construct_input_rowset_readers() {
     for (auto& rowset : _input_rowsets) {
         RowsetReaderSharedPtr rs_reader;
@@ -31,6 +31,7 @@
 
 namespace doris {
 
+class CompactionIOMeter;
 class DataDir;
 class Merger;
 
@@ -68,6 +69,11 @@ protected:
     Status construct_output_rowset_writer(const TabletSchema* schema);
     Status construct_input_rowset_readers();
 
+    // Whether the segments of the input rowsets are already in key order, with no rows to merge
+    // or delete, so that they can be linked into the output rowset without being rewritten.
+    bool can_link_input_rowsets(const TabletSchema& schema);
+    Status link_input_rowsets(Merger::Statistics* stats);
+
     Status check_version_continuity(const std::vector<RowsetSharedPtr>& rowsets);
     Status check_correctness(const Merger::Statistics& stats);
     Status find_longest_consecutive_version(std::vector<RowsetSharedPtr>* rowsets,
@@ -86,6 +92,8 @@ protected:
     int64_t _input_row_num;
 
     RowsetSharedPtr _output_rowset;
+    // meters the writes of _output_rs_writer
+    std::unique_ptr<CompactionIOMeter> _io_meter;
     std::unique_ptr<RowsetWriter> _output_rs_writer;
 
     enum CompactionState { INITED = 0, SUCCESS = 1 };
@@ -0,0 +1,164 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_io_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "common/config.h"
+#include "olap/storage_engine.h"
+#include "util/time.h"
+
+namespace doris {
+
+// the interval to adapt the rate of a disk to the query I/O latency
+static constexpr int64_t ADJUST_INTERVAL_NS = 1000L * 1000 * 1000;
+// the least number of pages read by queries to measure their latency
+static constexpr int64_t MIN_QUERY_PAGES = 16;
+// the longest wait of a compaction at a time, the rest of the debt is paid by later I/O
+static constexpr int64_t MAX_WAIT_NS = 1000L * 1000 * 1000;
+
+static double max_rate() {
+    return std::max(1, config::compaction_io_max_mbytes_per_sec_per_disk) * 1024.0 * 1024.0;
+}
+
+static double min_rate() {
+    return std::clamp(config::compaction_io_min_mbytes_per_sec_per_disk, 1,
+                      std::max(1, config::compaction_io_max_mbytes_per_sec_per_disk)) *
+           1024.0 * 1024.0;
+}
+
+CompactionIOScheduler::DiskState* CompactionIOScheduler::_get_state(DataDir* data_dir) {
+    {
+        std::shared_lock rdlock(_states_lock);
+        auto it = _states.find(data_dir);
+        if (it != _states.end()) {
+            return it->second.get();
+        }
+    }
+    std::lock_guard wrlock(_states_lock);
+    auto& state = _states[data_dir];
+    if (state == nullptr) {
+        state = std::make_unique<DiskState>();
+        state->rate = max_rate();
+        state->tokens = state->rate;
+        state->last_refill_ns = MonotonicNanos();
+        state->window_start_ns = state->last_refill_ns;
+    }
+    return state.get();
+}
+
+void CompactionIOScheduler::_refill(DiskState* state, int64_t now_ns) {
+    if (now_ns - state->window_start_ns >= ADJUST_INTERVAL_NS) {
+        double rate = state->rate;
+        state->pressure = 0;
+        if (state->query_pages >= MIN_QUERY_PAGES) {
+            double latency_us = state->query_io_ns / 1000.0 / state->query_pages;
+            double target_us = std::max(1, config::compaction_io_query_latency_target_us);
+            state->pressure = std::clamp(latency_us / target_us - 1, 0.0, 1.0);
+            if (latency_us > target_us) {
+                rate /= 2;
+            } else {
+                rate += max_rate() / 10;
+            }
+        } else {
+            rate += max_rate() / 10;
+        }
+        state->rate = std::clamp(rate, min_rate(), max_rate());
+        state->window_start_ns = now_ns;
+        state->query_io_ns = 0;
+        state->query_pages = 0;
+    }
+    // at most one second of I/O is saved up
+    double elapsed_sec = (now_ns - state->last_refill_ns) / 1e9;
+    state->tokens = std::min(state->rate, state->tokens + state->rate * elapsed_sec);
+    state->last_refill_ns = now_ns;
+}
+
+void CompactionIOScheduler::acquire(DataDir* data_dir, int64_t bytes, bool boost) {
+    if (!config::enable_compaction_io_scheduler || data_dir == nullptr || bytes <= 0) {
+        return;
+    }
+    DiskState* state = _get_state(data_dir);
+    int64_t wait_ns = 0;
+    {
+        std::lock_guard l(state->lock);
+        _refill(state, MonotonicNanos());
+        state->tokens -= bytes;
+        if (state->tokens >= 0) {
+            return;
+        }
+        double rate = boost ? max_rate() : state->rate;
+        wait_ns = std::min<int64_t>(MAX_WAIT_NS, -state->tokens / rate * 1e9);
+    }
+    std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns));
+}
+
+void CompactionIOScheduler::report_query_io(DataDir* data_dir, int64_t io_ns, int64_t num_pages) {
+    if (!config::enable_compaction_io_scheduler || data_dir == nullptr || num_pages <= 0) {
+        return;
+    }
+    DiskState* state = _get_state(data_dir);
+    std::lock_guard l(state->lock);
+    state->query_io_ns += io_ns;
+    state->query_pages += num_pages;
+}
+
+double CompactionIOScheduler::query_io_pressure(DataDir* data_dir) {
+    if (!config::enable_compaction_io_scheduler) {
+        return 0;
+    }
+    DiskState* state = _get_state(data_dir);
+    std::lock_guard l(state->lock);
+    _refill(state, MonotonicNanos());
+    return state->pressure;
+}
+
+int64_t CompactionIOScheduler::rate(DataDir* data_dir) {
+    DiskState* state = _get_state(data_dir);
+    std::lock_guard l(state->lock);
+    _refill(state, MonotonicNanos());
+    return state->rate;
+}
+
+CompactionIOMeter::CompactionIOMeter(TabletSharedPtr tablet, ReaderType reader_type)
+        : _scheduler(nullptr),
+          _data_dir(tablet->data_dir()),
+          _boost(tablet->version_count() >=
+                 config::compaction_io_boost_version_ratio * config::max_tablet_version_num) {
+    if ((reader_type == READER_BASE_COMPACTION || reader_type == READER_CUMULATIVE_COMPACTION) &&
+        StorageEngine::instance() != nullptr) {
+        _scheduler = StorageEngine::instance()->compaction_io_scheduler();
+    }
+}
+
+void CompactionIOMeter::on_read(int64_t total_bytes_read) {
+    if (_scheduler != nullptr && total_bytes_read > _bytes_read) {
+        _scheduler->acquire(_data_dir, total_bytes_read - _bytes_read, _boost);
+        _bytes_read = total_bytes_read;
+    }
+}
+
+void CompactionIOMeter::on_write(int64_t bytes) {
+    if (_scheduler != nullptr) {
+        _scheduler->acquire(_data_dir, bytes, _boost);
+    }
+}
+
+} // namespace doris
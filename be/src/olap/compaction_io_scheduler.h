@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "olap/tablet.h"
+
+namespace doris {
+
+class DataDir;
+
+// Meters the bytes read and written by compactions on each disk with a token bucket, so that
+// compactions give way to queries. The rate of a disk adapts to the I/O latency of the queries
+// on it: it is halved while the latency of a page read is above
+// compaction_io_query_latency_target_us, and grows back step by step otherwise.
+class CompactionIOScheduler {
+public:
+    CompactionIOScheduler() = default;
+
+    // Charges 'bytes' of compaction I/O on 'data_dir', and waits while the disk is over its
+    // budget. A boosted compaction is paced at the max rate of the disk regardless of queries.
+    void acquire(DataDir* data_dir, int64_t bytes, bool boost);
+
+    // Reports the time and the number of pages read from 'data_dir' by a query.
+    void report_query_io(DataDir* data_dir, int64_t io_ns, int64_t num_pages);
+
+    // How much the query I/O latency of 'data_dir' exceeds the target, in [0, 1].
+    double query_io_pressure(DataDir* data_dir);
+
+    // The bytes per second allowed to compactions on 'data_dir'.
+    int64_t rate(DataDir* data_dir);
+
+private:
+    struct DiskState {
+        std::mutex lock;
+        double rate = 0;
+        // may be negative, the debt is paid by waiting
+        double tokens = 0;
+        int64_t last_refill_ns = 0;
+        // the query I/O since the last adjustment
+        int64_t window_start_ns = 0;
+        int64_t query_io_ns = 0;
+        int64_t query_pages = 0;
+        double pressure = 0;
+    };
+
+    DiskState* _get_state(DataDir* data_dir);
+    // refill the tokens of 'state', and adapt its rate once per second, 'state->lock' is held
+    void _refill(DiskState* state, int64_t now_ns);
+
+    std::shared_mutex _states_lock;
+    std::map<DataDir*, std::unique_ptr<DiskState>> _states;
+};
+
+// Meters the I/O of one compaction of a tablet, the compaction is boosted when the versions of
+// the tablet are close to max_tablet_version_num. Nothing is metered for other reader types,
+// such as schema change.
+class CompactionIOMeter {
+public:
+    CompactionIOMeter(TabletSharedPtr tablet, ReaderType reader_type);
+
+    // 'total_bytes_read' is the bytes read by the compaction so far
+    void on_read(int64_t total_bytes_read);
+
+    void on_write(int64_t bytes);
+
+private:
+    CompactionIOScheduler* _scheduler;
+    DataDir* _data_dir;
+    bool _boost;
+    int64_t _bytes_read = 0;
+};
+
+} // namespace doris
@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_score_index.h"
+
+namespace doris {
+
+void CompactionScoreIndex::mark_dirty(TTabletId tablet_id) {
+    std::lock_guard<std::mutex> l(_lock);
+    _dirty_tablets.insert(tablet_id);
+}
+
+std::vector<TTabletId> CompactionScoreIndex::take_dirty() {
+    std::lock_guard<std::mutex> l(_lock);
+    std::vector<TTabletId> tablet_ids(_dirty_tablets.begin(), _dirty_tablets.end());
+    _dirty_tablets.clear();
+    return tablet_ids;
+}
+
+void CompactionScoreIndex::update(TTabletId tablet_id, uint32_t score) {
+    std::lock_guard<std::mutex> l(_lock);
+    _remove_unlocked(tablet_id);
+    if (score > 0) {
+        _scores.emplace(tablet_id, score);
+        _tablets_by_score.emplace(score, tablet_id);
+    }
+}
+
+void CompactionScoreIndex::remove(TTabletId tablet_id) {
+    std::lock_guard<std::mutex> l(_lock);
+    _remove_unlocked(tablet_id);
+}
+
+void CompactionScoreIndex::_remove_unlocked(TTabletId tablet_id) {
+    auto it = _scores.find(tablet_id);
+    if (it != _scores.end()) {
+        _tablets_by_score.erase({it->second, tablet_id});
+        _scores.erase(it);
+    }
+}
+
+bool CompactionScoreIndex::next_by_score(Entry* entry) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _tablets_by_score.upper_bound(*entry);
+    if (it == _tablets_by_score.end()) {
+        return false;
+    }
+    *entry = *it;
+    return true;
+}
+
+size_t CompactionScoreIndex::size() {
+    std::lock_guard<std::mutex> l(_lock);
+    return _scores.size();
+}
+
+} // namespace doris
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gen_cpp/Types_types.h"
+
+namespace doris {
+
+// The compaction scores of the tablets of a data dir for one type of compaction, ordered so that
+// the tablet of the highest score is found without computing the scores of all the tablets. A
+// tablet is marked dirty when its rowsets, its cumulative point or its state change, and its score
+// is computed again by the next pick.
+class CompactionScoreIndex {
+public:
+    // Marks the score of the tablet to be computed again.
+    void mark_dirty(TTabletId tablet_id);
+
+    // Takes the tablets marked dirty since the last call.
+    std::vector<TTabletId> take_dirty();
+
+    // Sets the score of the tablet. The tablets of score 0 are not kept, since they are never
+    // compacted.
+    void update(TTabletId tablet_id, uint32_t score);
+
+    void remove(TTabletId tablet_id);
+
+    // A score and its tablet, ordered by decreasing score.
+    using Entry = std::pair<uint32_t, TTabletId>;
+    // The entry to pass to next_by_score() to get the tablet of the highest score.
+    static constexpr Entry BEGIN = {UINT32_MAX, INT64_MAX};
+
+    // Gets the entry after *entry in decreasing order of score into *entry, and returns false if
+    // there is none. The index is only locked during the call, so the caller may look at the
+    // tablets, which takes the tablet locks of the rowset changes marking the tablets dirty.
+    bool next_by_score(Entry* entry);
+
+    size_t size();
+
+private:
+    void _remove_unlocked(TTabletId tablet_id);
+
+    std::mutex _lock;
+    std::unordered_set<TTabletId> _dirty_tablets;
+    std::unordered_map<TTabletId, uint32_t> _scores;
+    std::set<Entry, std::greater<Entry>> _tablets_by_score;
+};
+
+} // namespace doris
@@ -134,6 +134,65 @@ public:
                                bitmap);
     }
 
+    Status evaluate_inverted_index(const Schema& schema, InvertedIndexIterator* iterator,
+                                   uint32_t num_rows, roaring::Roaring* bitmap) const override {
+        // the values equal to a string have all its terms
+        if constexpr (PT == PredicateType::EQ && std::is_same_v<T, StringValue>) {
+            if (_opposite) {
+                return Status::OK();
+            }
+            roaring::Roaring candidates;
+            bool pruned = false;
+            RETURN_IF_ERROR(iterator->equal_candidates(Slice(_value.ptr, _value.len), num_rows,
+                                                       &candidates, &pruned));
+            if (pruned) {
+                *bitmap &= candidates;
+            }
+        }
+        return Status::OK();
+    }
+
+    Status evaluate_bit_sliced_index(BitSlicedIndexIterator* iterator, uint32_t num_rows,
+                                     roaring::Roaring* bitmap, bool* evaluated) const override {
+        *evaluated = false;
+        if constexpr (sizeof(T) <= 8 && (std::is_integral_v<T> || std::is_same_v<T, uint24_t>)) {
+            if (_opposite) {
+                return Status::OK();
+            }
+            roaring::Roaring less;
+            roaring::Roaring equal;
+            roaring::Roaring not_null;
+            RETURN_IF_ERROR(iterator->compare(&_value, &less, &equal, &not_null));
+            if constexpr (PT == PredicateType::EQ) {
+                *bitmap &= equal;
+            } else if constexpr (PT == PredicateType::NE) {
+                *bitmap &= not_null - equal;
+            } else if constexpr (PT == PredicateType::LT) {
+                *bitmap &= less;
+            } else if constexpr (PT == PredicateType::LE) {
+                *bitmap &= less | equal;
+            } else if constexpr (PT == PredicateType::GT) {
+                *bitmap &= not_null - (less | equal);
+            } else if constexpr (PT == PredicateType::GE) {
+                *bitmap &= not_null - less;
+            } else {
+                return Status::OK();
+            }
+            *evaluated = true;
+        }
+        return Status::OK();
+    }
+
+    bool is_string_equal(std::string* value) const override {
+        if constexpr (PT == PredicateType::EQ && std::is_same_v<T, StringValue>) {
+            if (!_opposite) {
+                value->assign(_value.ptr, _value.len);
+                return true;
+            }
+        }
+        return false;
+    }
+
     uint16_t evaluate(const vectorized::IColumn& column, uint16_t* sel,
                       uint16_t size) const override {
         if (column.is_nullable()) {
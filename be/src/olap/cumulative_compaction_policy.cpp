@@ -17,6 +17,7 @@
 
 #include "olap/cumulative_compaction_policy.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <string>
 
@@ -460,6 +461,180 @@ void NumBasedCumulativeCompactionPolicy::calculate_cumulative_point(
     }
 }
 
+TimeSeriesCumulativeCompactionPolicy::TimeSeriesCumulativeCompactionPolicy(
+        int64_t goal_size, int64_t file_count_threshold, int64_t time_threshold_seconds)
+        : CumulativeCompactionPolicy(),
+          _goal_size(goal_size),
+          _file_count_threshold(file_count_threshold),
+          _time_threshold_seconds(time_threshold_seconds) {}
+
+bool TimeSeriesCumulativeCompactionPolicy::_reach_compaction_threshold(
+        int64_t total_size, int64_t score, int64_t oldest_creation_time) const {
+    return total_size >= _goal_size || score >= _file_count_threshold ||
+           UnixSeconds() - oldest_creation_time >= _time_threshold_seconds;
+}
+
+void TimeSeriesCumulativeCompactionPolicy::calculate_cumulative_point(
+        Tablet* tablet, const std::vector<RowsetMetaSharedPtr>& all_metas,
+        int64_t current_cumulative_point, int64_t* ret_cumulative_point) {
+    *ret_cumulative_point = Tablet::K_INVALID_CUMULATIVE_POINT;
+    if (current_cumulative_point != Tablet::K_INVALID_CUMULATIVE_POINT) {
+        // only calculate the point once.
+        // after that, cumulative point will be updated along with compaction process.
+        return;
+    }
+
+    std::vector<RowsetMetaSharedPtr> existing_rss(all_metas.begin(), all_metas.end());
+    // sort the existing rowsets by version in ascending order
+    std::sort(existing_rss.begin(), existing_rss.end(),
+              [](const RowsetMetaSharedPtr& a, const RowsetMetaSharedPtr& b) {
+                  return a->version().first < b->version().first;
+              });
+
+    if (tablet->tablet_state() == TABLET_RUNNING) {
+        int64_t prev_version = -1;
+        for (const RowsetMetaSharedPtr& rs : existing_rss) {
+            if (rs->version().first > prev_version + 1) {
+                // There is a hole, do not continue
+                break;
+            }
+            // the outputs of cumulative compaction and the big loads are already promoted
+            if (rs->is_segments_overlapping() ||
+                (rs->is_singleton_delta() && rs->total_disk_size() < _goal_size)) {
+                *ret_cumulative_point = rs->version().first;
+                break;
+            }
+            prev_version = rs->version().second;
+            *ret_cumulative_point = prev_version + 1;
+        }
+    } else if (tablet->tablet_state() == TABLET_NOTREADY) {
+        // tablet under alter process
+        // we choose version next to the base version as cumulative point
+        for (const RowsetMetaSharedPtr& rs : existing_rss) {
+            if (rs->version().first > 0) {
+                *ret_cumulative_point = rs->version().first;
+                break;
+            }
+        }
+    }
+}
+
+int TimeSeriesCumulativeCompactionPolicy::pick_input_rowsets(
+        Tablet* tablet, const std::vector<RowsetSharedPtr>& candidate_rowsets,
+        const int64_t max_compaction_score, const int64_t min_compaction_score,
+        std::vector<RowsetSharedPtr>* input_rowsets, Version* last_delete_version,
+        size_t* compaction_score) {
+    *compaction_score = 0;
+    int transient_size = 0;
+    int64_t total_size = 0;
+    for (size_t i = 0; i < candidate_rowsets.size(); ++i) {
+        RowsetSharedPtr rowset = candidate_rowsets[i];
+        // check whether this rowset is delete version
+        if (tablet->version_for_delete_predicate(rowset->version())) {
+            *last_delete_version = rowset->version();
+            if (!input_rowsets->empty()) {
+                // we meet a delete version, and there were other versions before.
+                // we should compact those version before handling them over to base compaction
+                break;
+            } else {
+                // we meet a delete version, and no other versions before, skip it and continue
+                input_rowsets->clear();
+                *compaction_score = 0;
+                transient_size = 0;
+                total_size = 0;
+                continue;
+            }
+        }
+        auto rs_meta = rowset->rowset_meta();
+        if (input_rowsets->empty() && tablet->cumulative_layer_point() == rowset->start_version() &&
+            !rs_meta->is_segments_overlapping() && rs_meta->total_disk_size() >= _goal_size) {
+            // a big load is promoted as it is, there is nothing to merge it with
+            tablet->set_cumulative_layer_point(rowset->end_version() + 1);
+            continue;
+        }
+        if (*compaction_score >= max_compaction_score) {
+            // got enough segments
+            break;
+        }
+        *compaction_score += rs_meta->get_compaction_score();
+        total_size += rs_meta->total_disk_size();
+        transient_size += 1;
+        input_rowsets->push_back(rowset);
+        if (total_size >= _goal_size) {
+            break;
+        }
+    }
+
+    if (input_rowsets->empty()) {
+        return transient_size;
+    }
+    if (input_rowsets->size() == 1 &&
+        !input_rowsets->front()->rowset_meta()->is_segments_overlapping()) {
+        // if there is only one rowset and not overlapping,
+        // we do not need to do cumulative compaction
+        input_rowsets->clear();
+        *compaction_score = 0;
+        return transient_size;
+    }
+    // if there is delete version, or we have a sufficient number of segments, do compaction
+    // directly, otherwise wait until the rowsets reach the goal size or the time threshold.
+    if (last_delete_version->first == -1 && *compaction_score < max_compaction_score &&
+        !_reach_compaction_threshold(total_size, *compaction_score,
+                                     input_rowsets->front()->creation_time())) {
+        input_rowsets->clear();
+        *compaction_score = 0;
+    }
+    VLOG_CRITICAL << "cumulative compaction time_series policy, compaction_score = "
+                  << *compaction_score << ", total_size = " << total_size
+                  << ", tablet = " << tablet->full_name() << ", input_rowset size "
+                  << input_rowsets->size();
+    return transient_size;
+}
+
+void TimeSeriesCumulativeCompactionPolicy::update_cumulative_point(
+        Tablet* tablet, const std::vector<RowsetSharedPtr>& input_rowsets,
+        RowsetSharedPtr output_rowset, Version& last_delete_version) {
+    if (tablet->tablet_state() != TABLET_RUNNING) {
+        // if tablet under alter process, do not update cumulative point
+        return;
+    }
+    // every output rowset is promoted, so the rows are merged once by cumulative compaction
+    tablet->set_cumulative_layer_point(output_rowset->end_version() + 1);
+}
+
+void TimeSeriesCumulativeCompactionPolicy::calc_cumulative_compaction_score(
+        TabletState state, const std::vector<RowsetMetaSharedPtr>& all_metas,
+        int64_t current_cumulative_point, uint32_t* score) {
+    bool base_rowset_exist = false;
+    int64_t total_size = 0;
+    int64_t oldest_creation_time = INT64_MAX;
+    uint32_t cumulative_score = 0;
+    for (auto& rs_meta : all_metas) {
+        // check base rowset
+        if (rs_meta->start_version() == 0) {
+            base_rowset_exist = true;
+        }
+        if (rs_meta->start_version() < current_cumulative_point) {
+            // all_rs_metas() is not sorted, so we use _continue_ other than _break_ here.
+            continue;
+        }
+        total_size += rs_meta->total_disk_size();
+        cumulative_score += rs_meta->get_compaction_score();
+        oldest_creation_time = std::min(oldest_creation_time, rs_meta->creation_time());
+    }
+    // If base version does not exist, but its state is RUNNING.
+    // It is abnormal, do not select it and set *score = 0
+    if (!base_rowset_exist && state == TABLET_RUNNING) {
+        LOG(WARNING) << "tablet state is running but have no base version";
+        *score = 0;
+        return;
+    }
+    if (cumulative_score > 0 &&
+        _reach_compaction_threshold(total_size, cumulative_score, oldest_creation_time)) {
+        *score += cumulative_score;
+    }
+}
+
 void CumulativeCompactionPolicy::pick_candidate_rowsets(
         const std::unordered_map<Version, RowsetSharedPtr, HashOfVersion>& rs_version_map,
         int64_t cumulative_point, std::vector<RowsetSharedPtr>* candidate_rowsets) {
@@ -483,6 +658,9 @@ CumulativeCompactionPolicyFactory::create_cumulative_compaction_policy(std::stri
     } else if (policy_type == SIZE_BASED_POLICY) {
         return std::unique_ptr<CumulativeCompactionPolicy>(
                 new SizeBasedCumulativeCompactionPolicy());
+    } else if (policy_type == TIME_SERIES_POLICY) {
+        return std::unique_ptr<CumulativeCompactionPolicy>(
+                new TimeSeriesCumulativeCompactionPolicy());
     }
 
     return std::shared_ptr<CumulativeCompactionPolicy>(new NumBasedCumulativeCompactionPolicy());
@@ -494,6 +672,8 @@ void CumulativeCompactionPolicyFactory::_parse_cumulative_compaction_policy(
         *policy_type = NUM_BASED_POLICY;
     } else if (type == CUMULATIVE_SIZE_BASED_POLICY) {
         *policy_type = SIZE_BASED_POLICY;
+    } else if (type == CUMULATIVE_TIME_SERIES_POLICY) {
+        *policy_type = TIME_SERIES_POLICY;
     } else {
         LOG(WARNING) << "parse cumulative compaction policy error " << type << ", default use "
                      << CUMULATIVE_NUM_BASED_POLICY;
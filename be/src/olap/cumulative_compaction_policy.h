@@ -30,16 +30,19 @@ namespace doris {
 class Tablet;
 
 /// This CompactionPolicy enum is used to represent the type of compaction policy.
-/// Now it has two values, NUM_BASED_POLICY and SIZE_BASED_POLICY.
+/// Now it has three values, NUM_BASED_POLICY, SIZE_BASED_POLICY and TIME_SERIES_POLICY.
 /// NUM_BASED_POLICY means current compaction policy implemented by num based policy.
 /// SIZE_BASED_POLICY means current compaction policy implemented by size_based policy.
+/// TIME_SERIES_POLICY means current compaction policy implemented by time_series policy.
 enum CompactionPolicy {
     NUM_BASED_POLICY = 0,
     SIZE_BASED_POLICY = 1,
+    TIME_SERIES_POLICY = 2,
 };
 
 const static std::string CUMULATIVE_NUM_BASED_POLICY = "NUM_BASED";
 const static std::string CUMULATIVE_SIZE_BASED_POLICY = "SIZE_BASED";
+const static std::string CUMULATIVE_TIME_SERIES_POLICY = "TIME_SERIES";
 /// This class CumulativeCompactionPolicy is the base class of cumulative compaction policy.
 /// It defines the policy to do cumulative compaction. It has different derived classes, which implements
 /// concrete cumulative compaction algorithm. The policy is configured by conf::cumulative_compaction_policy.
@@ -243,11 +246,74 @@ private:
     std::vector<int64_t> _levels;
 };
 
+/// Time series cumulative compaction policy implemention. It targets the append-mostly tables whose loads are
+/// time-ordered and seldom overlap, like metrics and logs. The rowsets after the cumulative point are merged once
+/// their total disk size reaches the goal size, their segments reach the file count threshold, or the oldest of
+/// them has waited for the time threshold, and every output rowset is promoted right away, so a row is written
+/// once by cumulative compaction. The inputs of such tables usually take the ordered compaction path, which links
+/// the segments instead of merging the rows. Base compaction is then only needed to apply delete predicates.
+class TimeSeriesCumulativeCompactionPolicy final : public CumulativeCompactionPolicy {
+public:
+    TimeSeriesCumulativeCompactionPolicy(
+            int64_t goal_size = config::time_series_compaction_goal_size_mbytes * 1024 * 1024,
+            int64_t file_count_threshold = config::time_series_compaction_file_count_threshold,
+            int64_t time_threshold_seconds =
+                    config::time_series_compaction_time_threshold_seconds);
+
+    ~TimeSeriesCumulativeCompactionPolicy() {}
+
+    /// Time series cumulative compaction policy implements calculate cumulative point function.
+    /// When the first time the tablet does compact, this calculation is executed. Its main policy is to find first
+    /// rowset which is overlapping, or a singleton smaller than the goal size, and use its version as cumulative point.
+    void calculate_cumulative_point(Tablet* tablet,
+                                    const std::vector<RowsetMetaSharedPtr>& all_rowsets,
+                                    int64_t current_cumulative_point,
+                                    int64_t* cumulative_point) override;
+
+    /// Time series cumulative compaction policy implements pick input rowsets function.
+    /// Its main policy is picking the rowsets in version order until their total size reaches the goal size, and
+    /// keeping them only when that size, the file count threshold or the time threshold is reached. A leading
+    /// non-overlapping rowset reaching the goal size by itself is promoted without compaction.
+    int pick_input_rowsets(Tablet* tablet, const std::vector<RowsetSharedPtr>& candidate_rowsets,
+                           const int64_t max_compaction_score, const int64_t min_compaction_score,
+                           std::vector<RowsetSharedPtr>* input_rowsets,
+                           Version* last_delete_version, size_t* compaction_score) override;
+
+    /// Time series cumulative compaction policy implements update cumulative point function.
+    /// Its main policy is moving the cumulative point after every output rowset.
+    void update_cumulative_point(Tablet* tablet, const std::vector<RowsetSharedPtr>& input_rowsets,
+                                 RowsetSharedPtr _output_rowset,
+                                 Version& last_delete_version) override;
+
+    /// Time series cumulative compaction policy implements calc cumulative compaction score function.
+    /// Its main policy is calculating the accumulative compaction score after current cumulative_point in tablet,
+    /// which is zero until a condition to compact them is reached.
+    void calc_cumulative_compaction_score(TabletState state,
+                                          const std::vector<RowsetMetaSharedPtr>& all_rowsets,
+                                          int64_t current_cumulative_point,
+                                          uint32_t* score) override;
+
+    std::string name() override { return CUMULATIVE_TIME_SERIES_POLICY; }
+
+private:
+    /// whether the rowsets of the total size and score which the oldest of them was created at
+    /// can be compacted
+    bool _reach_compaction_threshold(int64_t total_size, int64_t score,
+                                     int64_t oldest_creation_time) const;
+
+    /// the total disk size of the rowsets to merge in one compaction, unit is byte.
+    int64_t _goal_size;
+    /// the number of segments which are merged before reaching the goal size.
+    int64_t _file_count_threshold;
+    /// the seconds the oldest rowset waits before being merged without reaching the goal size.
+    int64_t _time_threshold_seconds;
+};
+
 /// The factory of CumulativeCompactionPolicy, it can product different policy according to the `policy` parameter.
 class CumulativeCompactionPolicyFactory {
 public:
     /// Static factory function. It can product different policy according to the `policy` parameter and use tablet ptr
-    /// to construct the policy. Now it can product size based and num based policies.
+    /// to construct the policy. Now it can product size based, num based and time series policies.
     static std::shared_ptr<CumulativeCompactionPolicy> create_cumulative_compaction_policy(
             std::string policy);
 
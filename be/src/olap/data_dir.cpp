@@ -30,9 +30,11 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "env/env_util.h"
 #include "gutil/strings/substitute.h"
@@ -48,6 +50,7 @@
 #include "util/errno.h"
 #include "util/file_utils.h"
 #include "util/string_util.h"
+#include "util/threadpool.h"
 
 using strings::Substitute;
 
@@ -262,15 +265,22 @@ Status DataDir::get_shard(uint64_t* shard) {
 void DataDir::register_tablet(Tablet* tablet) {
     TabletInfo tablet_info(tablet->tablet_id(), tablet->schema_hash(), tablet->tablet_uid());
 
-    std::lock_guard<std::mutex> l(_mutex);
-    _tablet_set.emplace(std::move(tablet_info));
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _tablet_set.emplace(std::move(tablet_info));
+    }
+    mark_compaction_score_dirty(tablet->tablet_id());
 }
 
 void DataDir::deregister_tablet(Tablet* tablet) {
     TabletInfo tablet_info(tablet->tablet_id(), tablet->schema_hash(), tablet->tablet_uid());
 
-    std::lock_guard<std::mutex> l(_mutex);
-    _tablet_set.erase(tablet_info);
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _tablet_set.erase(tablet_info);
+    }
+    // the next pick finds the tablet gone and removes its score
+    mark_compaction_score_dirty(tablet->tablet_id());
 }
 
 void DataDir::clear_tablets(std::vector<TabletInfo>* tablet_infos) {
@@ -386,16 +396,32 @@ Status DataDir::load() {
         LOG(INFO) << "load rowset from meta finished, data dir: " << _path;
     }
 
+    // The tablets and their rowsets are loaded by several threads, since parsing their metas and
+    // initializing them takes most of the time of a disk of many tablets.
+    int num_threads = std::max(1, config::tablet_load_threads_per_disk);
+    std::unique_ptr<ThreadPool> load_pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder("TabletLoadThreadPool")
+                            .set_min_threads(num_threads)
+                            .set_max_threads(num_threads)
+                            .build(&load_pool));
+    // runs the function on the pool, or in place if it can't be submitted
+    auto run = [&load_pool](const std::function<void()>& func) {
+        if (!load_pool->submit_func(func).ok()) {
+            func();
+        }
+    };
+
     // load tablet
     // create tablet from tablet meta and add it to tablet mgr
     LOG(INFO) << "begin loading tablet from meta";
+    std::mutex tablet_ids_lock;
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](
-                                    int64_t tablet_id, int32_t schema_hash,
-                                    const std::string& value) -> bool {
+    auto load_tablet = [this, &tablet_ids_lock, &tablet_ids, &failed_tablet_ids](
+                               int64_t tablet_id, int32_t schema_hash, const std::string& value) {
         Status status = _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value,
                                                                false, false, false, false);
+        std::lock_guard<std::mutex> l(tablet_ids_lock);
         if (!status.ok() && status.precise_code() != OLAP_ERR_TABLE_ALREADY_DELETED_ERROR &&
             status.precise_code() != OLAP_ERR_ENGINE_INSERT_OLD_TABLET) {
             // load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR)
@@ -418,9 +444,34 @@ Status DataDir::load() {
         } else {
             tablet_ids.insert(tablet_id);
         }
+    };
+    // The metas read from the meta env are loaded in batches, which bounds the memory of the
+    // metas read ahead of the threads.
+    struct TabletMetaValue {
+        int64_t tablet_id;
+        int32_t schema_hash;
+        std::string value;
+    };
+    std::vector<TabletMetaValue> tablet_metas;
+    auto load_tablet_metas = [&]() {
+        for (auto& meta : tablet_metas) {
+            run([&load_tablet, &meta] {
+                load_tablet(meta.tablet_id, meta.schema_hash, meta.value);
+            });
+        }
+        load_pool->wait();
+        tablet_metas.clear();
+    };
+    auto load_tablet_func = [&](int64_t tablet_id, int32_t schema_hash,
+                                const std::string& value) -> bool {
+        tablet_metas.push_back({tablet_id, schema_hash, value});
+        if (tablet_metas.size() >= static_cast<size_t>(num_threads) * 64) {
+            load_tablet_metas();
+        }
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    load_tablet_metas();
     if (failed_tablet_ids.size() != 0) {
         LOG(WARNING) << "load tablets from header failed"
                      << ", loaded tablet: " << tablet_ids.size()
@@ -440,98 +491,116 @@ Status DataDir::load() {
     }
 
     for (int64_t tablet_id : tablet_ids) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
-        if (tablet && tablet->set_tablet_schema_into_rowset_meta()) {
-            TabletMetaManager::save(this, tablet->tablet_id(), tablet->schema_hash(),
-                                    tablet->tablet_meta());
-        }
+        run([this, tablet_id] {
+            TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
+            if (tablet && tablet->set_tablet_schema_into_rowset_meta()) {
+                TabletMetaManager::save(this, tablet->tablet_id(), tablet->schema_hash(),
+                                        tablet->tablet_meta());
+            }
+        });
     }
+    load_pool->wait();
 
     // traverse rowset
     // 1. add committed rowset to txn map
     // 2. add visible rowset to tablet
     // ignore any errors when load tablet or rowset, because fe will repair them after report
-    int64_t invalid_rowset_counter = 0;
-    for (auto rowset_meta : dir_rowset_metas) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id());
-        // tablet maybe dropped, but not drop related rowset meta
-        if (tablet == nullptr) {
-            VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
-                        << ", schema hash: " << rowset_meta->tablet_schema_hash()
-                        << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
-            ++invalid_rowset_counter;
-            continue;
-        }
-
-        RowsetSharedPtr rowset;
-        Status create_status = tablet->create_rowset(rowset_meta, &rowset);
-        if (!create_status) {
-            LOG(WARNING) << "could not create rowset from rowsetmeta: "
-                         << " rowset_id: " << rowset_meta->rowset_id()
-                         << " rowset_type: " << rowset_meta->rowset_type()
-                         << " rowset_state: " << rowset_meta->rowset_state();
-            continue;
-        }
-        if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
-            rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            if (!rowset_meta->get_rowset_pb().has_tablet_schema()) {
-                rowset_meta->set_tablet_schema(&tablet->tablet_schema());
-                RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
-                                        rowset_meta->get_rowset_pb());
-            }
-            Status commit_txn_status = _txn_manager->commit_txn(
-                    _meta, rowset_meta->partition_id(), rowset_meta->txn_id(),
-                    rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash(),
-                    rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
-            if (!commit_txn_status &&
-                commit_txn_status !=
-                        Status::OLAPInternalError(OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST)) {
-                LOG(WARNING) << "failed to add committed rowset: " << rowset_meta->rowset_id()
-                             << " to tablet: " << rowset_meta->tablet_id()
-                             << " for txn: " << rowset_meta->txn_id();
-            } else {
-                LOG(INFO) << "successfully to add committed rowset: " << rowset_meta->rowset_id()
-                          << " to tablet: " << rowset_meta->tablet_id()
-                          << " schema hash: " << rowset_meta->tablet_schema_hash()
-                          << " for txn: " << rowset_meta->txn_id();
+    // The rowsets of a tablet are loaded in order by one thread.
+    std::unordered_map<int64_t, std::vector<RowsetMetaSharedPtr>> tablet_rowset_metas;
+    for (auto& rowset_meta : dir_rowset_metas) {
+        tablet_rowset_metas[rowset_meta->tablet_id()].push_back(rowset_meta);
+    }
+    std::atomic<int64_t> invalid_rowset_counter {0};
+    for (auto& [tablet_id, rowset_metas] : tablet_rowset_metas) {
+        run([this, tablet_id = tablet_id, &rowset_metas = rowset_metas, &invalid_rowset_counter] {
+            TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
+            for (auto& rowset_meta : rowset_metas) {
+                _load_rowset(tablet, rowset_meta, &invalid_rowset_counter);
             }
-        } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
-                   rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            if (!rowset_meta->get_rowset_pb().has_tablet_schema()) {
-                rowset_meta->set_tablet_schema(&tablet->tablet_schema());
-                RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
-                                        rowset_meta->get_rowset_pb());
-            }
-            Status publish_status = tablet->add_rowset(rowset);
-            if (!publish_status &&
-                publish_status.precise_code() != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-                LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
-                             << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
-                             << " txn id:" << rowset_meta->txn_id()
-                             << " start_version: " << rowset_meta->version().first
-                             << " end_version: " << rowset_meta->version().second;
-            }
-        } else {
-            LOG(WARNING) << "find invalid rowset: " << rowset_meta->rowset_id()
-                         << " with tablet id: " << rowset_meta->tablet_id()
-                         << " tablet uid: " << rowset_meta->tablet_uid()
-                         << " schema hash: " << rowset_meta->tablet_schema_hash()
-                         << " txn: " << rowset_meta->txn_id()
-                         << " current valid tablet uid: " << tablet->tablet_uid();
-            ++invalid_rowset_counter;
-        }
+        });
     }
+    load_pool->wait();
 
     // At startup, we only count these invalid rowset, but do not actually delete it.
     // The actual delete operation is in StorageEngine::_clean_unused_rowset_metas,
     // which is cleaned up uniformly by the background cleanup thread.
     LOG(INFO) << "finish to load tablets from " << _path
               << ", total rowset meta: " << dir_rowset_metas.size()
-              << ", invalid rowset num: " << invalid_rowset_counter;
+              << ", invalid rowset num: " << invalid_rowset_counter.load();
 
     return Status::OK();
 }
 
+void DataDir::_load_rowset(const TabletSharedPtr& tablet, const RowsetMetaSharedPtr& rowset_meta,
+                           std::atomic<int64_t>* invalid_rowset_counter) {
+    // tablet maybe dropped, but not drop related rowset meta
+    if (tablet == nullptr) {
+        VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
+                    << ", schema hash: " << rowset_meta->tablet_schema_hash()
+                    << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
+        ++*invalid_rowset_counter;
+        return;
+    }
+
+    RowsetSharedPtr rowset;
+    Status create_status = tablet->create_rowset(rowset_meta, &rowset);
+    if (!create_status) {
+        LOG(WARNING) << "could not create rowset from rowsetmeta: "
+                     << " rowset_id: " << rowset_meta->rowset_id()
+                     << " rowset_type: " << rowset_meta->rowset_type()
+                     << " rowset_state: " << rowset_meta->rowset_state();
+        return;
+    }
+    if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
+        rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        if (!rowset_meta->get_rowset_pb().has_tablet_schema()) {
+            rowset_meta->set_tablet_schema(&tablet->tablet_schema());
+            RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
+                                    rowset_meta->get_rowset_pb());
+        }
+        Status commit_txn_status = _txn_manager->commit_txn(
+                _meta, rowset_meta->partition_id(), rowset_meta->txn_id(),
+                rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash(),
+                rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
+        if (!commit_txn_status &&
+            commit_txn_status !=
+                    Status::OLAPInternalError(OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST)) {
+            LOG(WARNING) << "failed to add committed rowset: " << rowset_meta->rowset_id()
+                         << " to tablet: " << rowset_meta->tablet_id()
+                         << " for txn: " << rowset_meta->txn_id();
+        } else {
+            LOG(INFO) << "successfully to add committed rowset: " << rowset_meta->rowset_id()
+                      << " to tablet: " << rowset_meta->tablet_id()
+                      << " schema hash: " << rowset_meta->tablet_schema_hash()
+                      << " for txn: " << rowset_meta->txn_id();
+        }
+    } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
+               rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        if (!rowset_meta->get_rowset_pb().has_tablet_schema()) {
+            rowset_meta->set_tablet_schema(&tablet->tablet_schema());
+            RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
+                                    rowset_meta->get_rowset_pb());
+        }
+        Status publish_status = tablet->add_rowset(rowset);
+        if (!publish_status &&
+            publish_status.precise_code() != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+            LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
+                         << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
+                         << " txn id:" << rowset_meta->txn_id()
+                         << " start_version: " << rowset_meta->version().first
+                         << " end_version: " << rowset_meta->version().second;
+        }
+    } else {
+        LOG(WARNING) << "find invalid rowset: " << rowset_meta->rowset_id()
+                     << " with tablet id: " << rowset_meta->tablet_id()
+                     << " tablet uid: " << rowset_meta->tablet_uid()
+                     << " schema hash: " << rowset_meta->tablet_schema_hash()
+                     << " txn: " << rowset_meta->txn_id()
+                     << " current valid tablet uid: " << tablet->tablet_uid();
+        ++*invalid_rowset_counter;
+    }
+}
+
 void DataDir::add_pending_ids(const std::string& id) {
     std::lock_guard<std::shared_mutex> wr_lock(_pending_path_mutex);
     _pending_path_ids.insert(id);
@@ -17,8 +17,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -29,12 +31,14 @@
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "io/fs/file_system.h"
+#include "olap/compaction_score_index.h"
 #include "olap/olap_common.h"
 #include "olap/rowset/rowset_id_generator.h"
 #include "util/metrics.h"
 
 namespace doris {
 
+class RowsetMeta;
 class Tablet;
 class TabletManager;
 class TabletMeta;
@@ -93,6 +97,16 @@ public:
     void deregister_tablet(Tablet* tablet);
     void clear_tablets(std::vector<TabletInfo>* tablet_infos);
 
+    // The compaction scores of the tablets of the dir, see CompactionScoreIndex.
+    CompactionScoreIndex* compaction_score_index(CompactionType compaction_type) {
+        return compaction_type == CompactionType::BASE_COMPACTION ? &_base_compaction_score_index
+                                                                  : &_cumu_compaction_score_index;
+    }
+    void mark_compaction_score_dirty(TTabletId tablet_id) {
+        _base_compaction_score_index.mark_dirty(tablet_id);
+        _cumu_compaction_score_index.mark_dirty(tablet_id);
+    }
+
     std::string get_absolute_shard_path(int64_t shard_id);
     std::string get_absolute_tablet_path(int64_t shard_id, int64_t tablet_id, int32_t schema_hash);
 
@@ -153,6 +167,12 @@ private:
     // process will log fatal.
     Status _check_incompatible_old_format_tablet();
 
+    // Adds the rowset to the txn map if it is committed or to the tablet if it is visible, and
+    // counts it as invalid otherwise. Called by the threads loading the tablets of the dir.
+    void _load_rowset(const std::shared_ptr<Tablet>& tablet,
+                      const std::shared_ptr<RowsetMeta>& rowset_meta,
+                      std::atomic<int64_t>* invalid_rowset_counter);
+
     void _process_garbage_path(const std::string& path);
 
     void _remove_check_paths(const std::set<std::string>& paths);
@@ -189,6 +209,9 @@ private:
     uint64_t _current_shard;
     std::set<TabletInfo> _tablet_set;
 
+    CompactionScoreIndex _base_compaction_score_index;
+    CompactionScoreIndex _cumu_compaction_score_index;
+
     static const uint32_t MAX_SHARD_NUM = 1024;
 
     OlapMeta* _meta = nullptr;
@@ -121,9 +121,14 @@ Status DeltaWriter::init() {
     }
     // build tablet schema in request level
     _build_current_tablet_schema(_req.index_id, _req.ptable_schema_param, _tablet->tablet_schema());
+    std::vector<uint32_t> partial_update_missing_cids;
+    if (_req.ptable_schema_param.partial_update()) {
+        RETURN_NOT_OK(_init_partial_update(&partial_update_missing_cids));
+    }
 
     RETURN_NOT_OK(_tablet->create_rowset_writer(_req.txn_id, _req.load_id, PREPARED, OVERLAPPING,
-                                                _tablet_schema.get(), &_rowset_writer));
+                                                _tablet_schema.get(), &_rowset_writer,
+                                                partial_update_missing_cids));
     _schema.reset(new Schema(*_tablet_schema));
     _reset_mem_table();
 
@@ -358,10 +363,42 @@ int64_t DeltaWriter::mem_consumption() const {
     return _flushed_mem_tracker->consumption() + _mem_table->memory_usage();
 }
 
+int64_t DeltaWriter::memtable_consumption() const {
+    if (_mem_table == nullptr) {
+        return 0;
+    }
+    return _mem_table->memory_usage();
+}
+
 int64_t DeltaWriter::partition_id() const {
     return _req.partition_id;
 }
 
+Status DeltaWriter::_init_partial_update(std::vector<uint32_t>* missing_cids) {
+    if (_tablet->keys_type() != UNIQUE_KEYS || !_tablet->enable_unique_key_merge_on_write()) {
+        return Status::InvalidArgument(
+                "partial update is only supported by unique key tables with merge-on-write, "
+                "tablet={}",
+                _tablet->full_name());
+    }
+    const auto& input_columns = _req.ptable_schema_param.partial_update_input_columns();
+    std::set<std::string> input_names(input_columns.begin(), input_columns.end());
+    for (int32_t cid = 0; cid < _tablet_schema->num_columns(); ++cid) {
+        const auto& column = _tablet_schema->column(cid);
+        bool is_input = input_names.count(column.name()) > 0;
+        if (column.is_key()) {
+            if (!is_input) {
+                return Status::InvalidArgument("partial update misses key column {}, tablet={}",
+                                               column.name(), _tablet->full_name());
+            }
+        } else if (!is_input && cid != _tablet_schema->row_store_col_idx()) {
+            // the row store is encoded from the other columns when the rows are written
+            missing_cids->push_back(cid);
+        }
+    }
+    return Status::OK();
+}
+
 void DeltaWriter::_build_current_tablet_schema(int64_t index_id,
                                                const POlapTableSchemaParam& ptable_schema_param,
                                                const TabletSchema& ori_tablet_schema) {
@@ -49,6 +49,8 @@ struct WriteRequest {
     bool is_high_priority = false;
     POlapTableSchemaParam ptable_schema_param;
     int64_t index_id;
+    // the backends of the other replicas, which pull the committed rowset in single replica load
+    std::vector<PNodeInfo> slave_nodes;
 };
 
 // Writer for a particular (load, index, tablet).
@@ -93,12 +95,18 @@ public:
 
     int32_t schema_hash() { return _tablet->schema_hash(); }
 
+    // mem consumption of the memtable being written, not the ones in flush queue
     int64_t memtable_consumption() const;
 
     int64_t save_mem_consumption_snapshot();
 
     int64_t get_mem_consumption_snapshot() const;
 
+    const std::vector<PNodeInfo>& slave_nodes() const { return _req.slave_nodes; }
+
+    // the rowset committed to the txn by close_wait()
+    RowsetSharedPtr committed_rowset() const { return _cur_rowset; }
+
 private:
     DeltaWriter(WriteRequest* req, StorageEngine* storage_engine, bool is_vec);
 
@@ -109,6 +117,9 @@ private:
 
     void _reset_mem_table();
 
+    // checks a partial update of the tablet and collects the columns it doesn't carry
+    Status _init_partial_update(std::vector<uint32_t>* missing_cids);
+
     void _build_current_tablet_schema(int64_t index_id,
                                       const POlapTableSchemaParam& table_schema_param,
                                       const TabletSchema& ori_tablet_schema);
@@ -117,8 +117,6 @@ public:
 
     virtual size_t get_variable_len() const { return 0; }
 
-    virtual void modify_zone_map_index(char*) const {};
-
     virtual Field* clone() const {
         auto* local = new Field();
         this->clone(local);
@@ -526,17 +524,6 @@ public:
         return type_value;
     }
 
-    // only varchar filed need modify zone map index when zone map max_value
-    // index longer than `MAX_ZONE_MAP_INDEX_SIZE`. so here we add one
-    // for the last byte
-    // In UTF8 encoding, here do not appear 0xff in last byte
-    void modify_zone_map_index(char* src) const override {
-        auto slice = reinterpret_cast<Slice*>(src);
-        if (slice->size == MAX_ZONE_MAP_INDEX_SIZE) {
-            slice->mutable_data()[slice->size - 1] += 1;
-        }
-    }
-
     void set_to_zone_map_max(char* ch) const override {
         auto slice = reinterpret_cast<Slice*>(ch);
         int length = _length < MAX_ZONE_MAP_INDEX_SIZE ? _length : MAX_ZONE_MAP_INDEX_SIZE;
@@ -582,17 +569,6 @@ public:
         return type_value;
     }
 
-    // only varchar/string filed need modify zone map index when zone map max_value
-    // index longer than `MAX_ZONE_MAP_INDEX_SIZE`. so here we add one
-    // for the last byte
-    // In UTF8 encoding, here do not appear 0xff in last byte
-    void modify_zone_map_index(char* src) const override {
-        auto slice = reinterpret_cast<Slice*>(src);
-        if (slice->size == MAX_ZONE_MAP_INDEX_SIZE) {
-            slice->mutable_data()[slice->size - 1] += 1;
-        }
-    }
-
     void set_to_max(char* ch) const override {
         auto slice = reinterpret_cast<Slice*>(ch);
         slice->size = _length - OLAP_VARCHAR_MAX_BYTES;
@@ -637,17 +613,6 @@ public:
         auto slice = reinterpret_cast<Slice*>(ch);
         memset(slice->data, 0xFF, slice->size);
     }
-    // only varchar/string filed need modify zone map index when zone map max_value
-    // index longer than `MAX_ZONE_MAP_INDEX_SIZE`. so here we add one
-    // for the last byte
-    // In UTF8 encoding, here do not appear 0xff in last byte
-    void modify_zone_map_index(char* src) const override {
-        auto slice = reinterpret_cast<Slice*>(src);
-        if (slice->size == MAX_ZONE_MAP_INDEX_SIZE) {
-            slice->mutable_data()[slice->size - 1] += 1;
-        }
-    }
-
     void set_to_zone_map_max(char* ch) const override {
         auto slice = reinterpret_cast<Slice*>(ch);
         memset(slice->data, 0xFF, slice->size);
@@ -38,22 +38,64 @@ HyperLogLog::HyperLogLog(const Slice& src) {
     }
 }
 
-// Convert explicit values to register format, and clear explicit values.
-// NOTE: this function won't modify _type.
-void HyperLogLog::_convert_explicit_to_register() {
+void HyperLogLog::_convert_explicit_to_sparse() {
     DCHECK(_type == HLL_DATA_EXPLICIT)
             << "_type(" << _type << ") should be explicit(" << HLL_DATA_EXPLICIT << ")";
-    _registers = new uint8_t[HLL_REGISTERS_COUNT];
-    memset(_registers, 0, HLL_REGISTERS_COUNT);
+    _sparse_registers.reserve(_hash_set.size());
     for (auto value : _hash_set) {
-        _update_registers(value);
+        _sparse_registers.push_back(_register_of(value));
     }
+    _sort_sparse_registers();
     // clear _hash_set
     phmap::flat_hash_set<uint64_t>().swap(_hash_set);
+    _type = HLL_DATA_SPARSE;
+}
+
+void HyperLogLog::_sort_sparse_registers() {
+    std::sort(_sparse_registers.begin(), _sparse_registers.end());
+    // keep the greatest value of each index, which is the last one
+    auto last = _sparse_registers.begin();
+    for (auto it = _sparse_registers.begin(); it != _sparse_registers.end(); ++it) {
+        if (last != _sparse_registers.begin() && (*(last - 1) >> 8) == (*it >> 8)) {
+            *(last - 1) = *it;
+        } else {
+            *last++ = *it;
+        }
+    }
+    _sparse_registers.erase(last, _sparse_registers.end());
+}
+
+void HyperLogLog::_convert_sparse_to_full() {
+    DCHECK(_type == HLL_DATA_SPARSE)
+            << "_type(" << _type << ") should be sparse(" << HLL_DATA_SPARSE << ")";
+    _registers = new uint8_t[HLL_REGISTERS_COUNT];
+    memset(_registers, 0, HLL_REGISTERS_COUNT);
+    for (auto reg : _sparse_registers) {
+        _registers[reg >> 8] = reg & 0xff;
+    }
+    std::vector<uint32_t>().swap(_sparse_registers);
+    _type = HLL_DATA_FULL;
+}
+
+void HyperLogLog::_merge_sparse_registers(const std::vector<uint32_t>& other_sparse_registers) {
+    std::vector<uint32_t> merged;
+    merged.reserve(_sparse_registers.size() + other_sparse_registers.size());
+    auto it = _sparse_registers.begin();
+    auto other_it = other_sparse_registers.begin();
+    while (it != _sparse_registers.end() && other_it != other_sparse_registers.end()) {
+        if ((*it >> 8) == (*other_it >> 8)) {
+            merged.push_back(std::max(*it++, *other_it++));
+        } else if (*it < *other_it) {
+            merged.push_back(*it++);
+        } else {
+            merged.push_back(*other_it++);
+        }
+    }
+    merged.insert(merged.end(), it, _sparse_registers.end());
+    merged.insert(merged.end(), other_it, other_sparse_registers.end());
+    _sparse_registers.swap(merged);
 }
 
-// Change HLL_DATA_EXPLICIT to HLL_DATA_FULL directly, because HLL_DATA_SPARSE
-// is implemented in the same way in memory with HLL_DATA_FULL.
 void HyperLogLog::update(uint64_t hash_value) {
     switch (_type) {
     case HLL_DATA_EMPTY:
@@ -65,10 +107,14 @@ void HyperLogLog::update(uint64_t hash_value) {
             _hash_set.insert(hash_value);
             break;
         }
-        _convert_explicit_to_register();
-        _type = HLL_DATA_FULL;
+        _convert_explicit_to_sparse();
         // fall through
     case HLL_DATA_SPARSE:
+        _update_sparse_registers(hash_value);
+        if (_sparse_registers.size() > HLL_SPARSE_MEMORY_THRESHOLD) {
+            _convert_sparse_to_full();
+        }
+        break;
     case HLL_DATA_FULL:
         _update_registers(hash_value);
         break;
@@ -89,6 +135,8 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             _hash_set = other._hash_set;
             break;
         case HLL_DATA_SPARSE:
+            _sparse_registers = other._sparse_registers;
+            break;
         case HLL_DATA_FULL:
             _registers = new uint8_t[HLL_REGISTERS_COUNT];
             memcpy(_registers, other._registers, HLL_REGISTERS_COUNT);
@@ -105,22 +153,48 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             // HLL_EXPLICIT_INT64_NUM. This is OK because the max value is 2 * 160.
             _hash_set.insert(other._hash_set.begin(), other._hash_set.end());
             if (_hash_set.size() > HLL_EXPLICIT_INT64_NUM) {
-                _convert_explicit_to_register();
-                _type = HLL_DATA_FULL;
+                _convert_explicit_to_sparse();
             }
         } break;
         case HLL_DATA_SPARSE:
+            _convert_explicit_to_sparse();
+            _merge_sparse_registers(other._sparse_registers);
+            if (_sparse_registers.size() > HLL_SPARSE_MEMORY_THRESHOLD) {
+                _convert_sparse_to_full();
+            }
+            break;
         case HLL_DATA_FULL:
-            _convert_explicit_to_register();
+            _convert_explicit_to_sparse();
+            _convert_sparse_to_full();
             _merge_registers(other._registers);
-            _type = HLL_DATA_FULL;
             break;
         default:
             break;
         }
         break;
     }
-    case HLL_DATA_SPARSE:
+    case HLL_DATA_SPARSE: {
+        switch (other._type) {
+        case HLL_DATA_EXPLICIT:
+            for (auto hash_value : other._hash_set) {
+                _update_sparse_registers(hash_value);
+            }
+            break;
+        case HLL_DATA_SPARSE:
+            _merge_sparse_registers(other._sparse_registers);
+            break;
+        case HLL_DATA_FULL:
+            _convert_sparse_to_full();
+            _merge_registers(other._registers);
+            break;
+        default:
+            break;
+        }
+        if (_type == HLL_DATA_SPARSE && _sparse_registers.size() > HLL_SPARSE_MEMORY_THRESHOLD) {
+            _convert_sparse_to_full();
+        }
+        break;
+    }
     case HLL_DATA_FULL: {
         switch (other._type) {
         case HLL_DATA_EXPLICIT:
@@ -129,6 +203,11 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             }
             break;
         case HLL_DATA_SPARSE:
+            for (auto reg : other._sparse_registers) {
+                uint8_t& value = _registers[reg >> 8];
+                value = std::max(value, static_cast<uint8_t>(reg & 0xff));
+            }
+            break;
         case HLL_DATA_FULL:
             _merge_registers(other._registers);
             break;
@@ -148,6 +227,7 @@ size_t HyperLogLog::max_serialized_size() const {
     case HLL_DATA_EXPLICIT:
         return 2 + _hash_set.size() * 8;
     case HLL_DATA_SPARSE:
+        return 1 + 4 + 3 * _sparse_registers.size();
     case HLL_DATA_FULL:
         return 1 + HLL_REGISTERS_COUNT;
     }
@@ -175,7 +255,17 @@ size_t HyperLogLog::serialize(uint8_t* dst) const {
         }
         break;
     }
-    case HLL_DATA_SPARSE:
+    case HLL_DATA_SPARSE: {
+        *ptr++ = HLL_DATA_SPARSE;
+        encode_fixed32_le(ptr, _sparse_registers.size());
+        ptr += 4;
+        for (auto reg : _sparse_registers) {
+            encode_fixed16_le(ptr, reg >> 8);
+            ptr += 2;
+            *ptr++ = reg & 0xff;
+        }
+        break;
+    }
     case HLL_DATA_FULL: {
         uint32_t num_non_zero_registers = 0;
         for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
@@ -285,17 +375,33 @@ bool HyperLogLog::deserialize(const Slice& slice) {
         break;
     }
     case HLL_DATA_SPARSE: {
-        _registers = new uint8_t[HLL_REGISTERS_COUNT];
-        memset(_registers, 0, HLL_REGISTERS_COUNT);
         // 2-5(4 byte): number of registers
         uint32_t num_registers = decode_fixed32_le(ptr);
         ptr += 4;
+        if (num_registers > HLL_SPARSE_MEMORY_THRESHOLD) {
+            _type = HLL_DATA_FULL;
+            _registers = new uint8_t[HLL_REGISTERS_COUNT];
+            memset(_registers, 0, HLL_REGISTERS_COUNT);
+        } else {
+            _sparse_registers.reserve(num_registers);
+        }
         for (uint32_t i = 0; i < num_registers; ++i) {
             // 2 bytes: register index
             // 1 byte: register value
             uint16_t register_idx = decode_fixed16_le(ptr);
             ptr += 2;
-            _registers[register_idx] = *ptr++;
+            uint8_t register_value = *ptr++;
+            if (_type == HLL_DATA_FULL) {
+                _registers[register_idx] = register_value;
+            } else if (register_value != 0) {
+                _sparse_registers.push_back((uint32_t)register_idx << 8 | register_value);
+            }
+        }
+        // the registers are written in the order of their indexes, but the other writers of
+        // the format are not required to
+        if (_type == HLL_DATA_SPARSE &&
+            !std::is_sorted(_sparse_registers.begin(), _sparse_registers.end())) {
+            _sort_sparse_registers();
         }
         break;
     }
@@ -338,10 +444,19 @@ int64_t HyperLogLog::estimate_cardinality() const {
     float harmonic_mean = 0;
     int num_zero_registers = 0;
 
+    // the sparse registers are summed in the same order as the full ones, so that both give
+    // the same estimate
+    auto sparse_it = _sparse_registers.begin();
     for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
-        harmonic_mean += powf(2.0f, -_registers[i]);
+        uint8_t value = 0;
+        if (_type == HLL_DATA_FULL) {
+            value = _registers[i];
+        } else if (sparse_it != _sparse_registers.end() && (int)(*sparse_it >> 8) == i) {
+            value = *sparse_it++ & 0xff;
+        }
+        harmonic_mean += powf(2.0f, -value);
 
-        if (_registers[i] == 0) {
+        if (value == 0) {
             ++num_zero_registers;
         }
     }
@@ -21,9 +21,11 @@
 #include <parallel_hashmap/phmap.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #ifdef __x86_64__
 #include <immintrin.h>
@@ -40,6 +42,9 @@ inline const int HLL_ZERO_COUNT_BITS = (64 - HLL_COLUMN_PRECISION);
 inline const int HLL_EXPLICIT_INT64_NUM = 160;
 inline const int HLL_SPARSE_THRESHOLD = 4096;
 inline const int HLL_REGISTERS_COUNT = 16 * 1024;
+// The most non-zero registers kept sorted in memory by a HLL_DATA_SPARSE value, 4 bytes each,
+// before it allocates all the registers and becomes HLL_DATA_FULL.
+inline const int HLL_SPARSE_MEMORY_THRESHOLD = 1024;
 // maximum size in byte of serialized HLL: type(1) + registers (2^14)
 inline const int HLL_COLUMN_DEFAULT_LEN = HLL_REGISTERS_COUNT + 1;
 
@@ -73,6 +78,11 @@ inline const int HLL_EMPTY_SIZE = 1;
 // A HLL value will change in the sequence empty -> explicit -> sparse -> full, and not
 // allow reverse.
 //
+// In memory, a sparse value keeps its non-zero registers in a sorted array until there are
+// more than HLL_SPARSE_MEMORY_THRESHOLD of them, so the many small HLLs of a GROUP BY don't
+// take HLL_REGISTERS_COUNT bytes each. The serialized format is chosen separately, a full value
+// with few non-zero registers is still serialized as sparse.
+//
 // NOTE: This values are persisted in storage devices, so don't change exist
 // enum values.
 enum HllDataType {
@@ -99,7 +109,10 @@ public:
             this->_hash_set = other._hash_set;
             break;
         }
-        case HLL_DATA_SPARSE:
+        case HLL_DATA_SPARSE: {
+            this->_sparse_registers = other._sparse_registers;
+            break;
+        }
         case HLL_DATA_FULL: {
             _registers = new uint8_t[HLL_REGISTERS_COUNT];
             memcpy(_registers, other._registers, HLL_REGISTERS_COUNT);
@@ -120,7 +133,11 @@ public:
             other._type = HLL_DATA_EMPTY;
             break;
         }
-        case HLL_DATA_SPARSE:
+        case HLL_DATA_SPARSE: {
+            this->_sparse_registers = std::move(other._sparse_registers);
+            other._type = HLL_DATA_EMPTY;
+            break;
+        }
         case HLL_DATA_FULL: {
             this->_registers = other._registers;
             other._registers = nullptr;
@@ -148,7 +165,11 @@ public:
                 other._type = HLL_DATA_EMPTY;
                 break;
             }
-            case HLL_DATA_SPARSE:
+            case HLL_DATA_SPARSE: {
+                this->_sparse_registers = std::move(other._sparse_registers);
+                other._type = HLL_DATA_EMPTY;
+                break;
+            }
             case HLL_DATA_FULL: {
                 this->_registers = other._registers;
                 other._registers = nullptr;
@@ -177,7 +198,10 @@ public:
                 this->_hash_set = other._hash_set;
                 break;
             }
-            case HLL_DATA_SPARSE:
+            case HLL_DATA_SPARSE: {
+                this->_sparse_registers = other._sparse_registers;
+                break;
+            }
             case HLL_DATA_FULL: {
                 _registers = new uint8_t[HLL_REGISTERS_COUNT];
                 memcpy(_registers, other._registers, HLL_REGISTERS_COUNT);
@@ -194,6 +218,7 @@ public:
     void clear() {
         _type = HLL_DATA_EMPTY;
         _hash_set.clear();
+        std::vector<uint32_t>().swap(_sparse_registers);
         delete[] _registers;
         _registers = nullptr;
     }
@@ -216,7 +241,9 @@ public:
         size_t size = sizeof(*this);
         if (_type == HLL_DATA_EXPLICIT)
             size += _hash_set.size() * sizeof(uint64_t);
-        else if (_type == HLL_DATA_SPARSE || _type == HLL_DATA_FULL)
+        else if (_type == HLL_DATA_SPARSE)
+            size += _sparse_registers.capacity() * sizeof(uint32_t);
+        else if (_type == HLL_DATA_FULL)
             size += HLL_REGISTERS_COUNT;
         return size;
     }
@@ -270,25 +297,56 @@ private:
     HllDataType _type = HLL_DATA_EMPTY;
     phmap::flat_hash_set<uint64_t> _hash_set;
 
+    // The non-zero registers of HLL_DATA_SPARSE, as (index << 8 | value) sorted by index.
+    std::vector<uint32_t> _sparse_registers;
+
     // This field is much space consuming(HLL_REGISTERS_COUNT), we create
     // it only when it is really needed.
     uint8_t* _registers = nullptr;
 
 private:
-    void _convert_explicit_to_register();
-
-    // update one hash value into this registers
-    void _update_registers(uint64_t hash_value) {
+    // Convert explicit values to the sparse registers, and clear explicit values.
+    void _convert_explicit_to_sparse();
+    // Sort the sparse registers by index, keeping the greatest value of each index.
+    void _sort_sparse_registers();
+    // Allocate the registers from the sparse registers, and clear the sparse registers.
+    void _convert_sparse_to_full();
+    // Merge the sorted sparse registers into the sparse registers of this value.
+    void _merge_sparse_registers(const std::vector<uint32_t>& other_sparse_registers);
+
+    static uint32_t _register_of(uint64_t hash_value) {
         // Use the lower bits to index into the number of streams and then
         // find the first 1 bit after the index bits.
-        int idx = hash_value % HLL_REGISTERS_COUNT;
+        uint32_t idx = hash_value % HLL_REGISTERS_COUNT;
         hash_value >>= HLL_COLUMN_PRECISION;
         // make sure max first_one_bit is HLL_ZERO_COUNT_BITS + 1
         hash_value |= ((uint64_t)1 << HLL_ZERO_COUNT_BITS);
         uint8_t first_one_bit = __builtin_ctzl(hash_value) + 1;
+        return idx << 8 | first_one_bit;
+    }
+
+    // update one hash value into this registers
+    void _update_registers(uint64_t hash_value) {
+        uint32_t reg = _register_of(hash_value);
+        uint32_t idx = reg >> 8;
+        uint8_t first_one_bit = reg & 0xff;
         _registers[idx] = (_registers[idx] < first_one_bit ? first_one_bit : _registers[idx]);
     }
 
+    // update one hash value into the sparse registers, which may become more than
+    // HLL_SPARSE_MEMORY_THRESHOLD
+    void _update_sparse_registers(uint64_t hash_value) {
+        uint32_t reg = _register_of(hash_value);
+        // the first register with the same index or a greater one
+        auto it = std::lower_bound(_sparse_registers.begin(), _sparse_registers.end(),
+                                   reg & ~0xffU);
+        if (it != _sparse_registers.end() && (*it >> 8) == (reg >> 8)) {
+            *it = std::max(*it, reg);
+        } else {
+            _sparse_registers.insert(it, reg);
+        }
+    }
+
     // absorb other registers into this registers
     void _merge_registers(const uint8_t* other_registers) {
 #ifdef __AVX2__
@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/index_builder.h"
+
+#include <mutex>
+
+#include "olap/compaction_io_scheduler.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/rowset/segment_v2/segment_index_file.h"
+#include "olap/segment_loader.h"
+#include "olap/storage_engine.h"
+
+namespace doris {
+
+Status IndexBuilder::prepare(int64_t* permits) {
+    _rowsets = _tablet->pick_rowsets_to_build_indexes();
+    *permits = 0;
+    for (const auto& rowset : _rowsets) {
+        *permits += rowset->num_segments();
+    }
+    return Status::OK();
+}
+
+Status IndexBuilder::build() {
+    for (const auto& rowset : _rowsets) {
+        RETURN_IF_ERROR(_build_rowset(rowset));
+    }
+    return Status::OK();
+}
+
+Status IndexBuilder::_build_rowset(const RowsetSharedPtr& rowset) {
+    auto beta_rowset = std::static_pointer_cast<BetaRowset>(rowset);
+    auto fs = rowset->rowset_meta()->fs();
+    if (!fs || rowset->tablet_schema() == nullptr) {
+        return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
+    }
+    auto* scheduler = StorageEngine::instance()->compaction_io_scheduler();
+    DataDir* data_dir = _tablet->data_dir();
+    auto before_read = [&](size_t bytes) { scheduler->acquire(data_dir, bytes, false); };
+    for (int seg_id = 0; seg_id < rowset->num_segments(); ++seg_id) {
+        auto index_path = beta_rowset->segment_index_file_path(seg_id);
+        bool exists = false;
+        RETURN_IF_ERROR(fs->exists(index_path, &exists));
+        if (exists) {
+            continue;
+        }
+        std::shared_ptr<segment_v2::Segment> segment;
+        RETURN_IF_ERROR(segment_v2::Segment::open(fs, beta_rowset->segment_file_path(seg_id),
+                                                  seg_id, rowset->tablet_schema(), &segment));
+        bool built = false;
+        RETURN_IF_ERROR(segment_v2::SegmentIndexFile::build(segment.get(), index_path,
+                                                            before_read, &built));
+        if (built) {
+            // the segments are opened again with the index file by the next queries
+            SegmentLoader::instance()->erase(rowset->rowset_id());
+        }
+    }
+
+    std::lock_guard<std::shared_mutex> wrlock(_tablet->get_header_lock());
+    rowset->rowset_meta()->set_index_files_built(true);
+    _tablet->save_meta();
+    LOG(INFO) << "succeed to build the index files of rowset " << rowset->rowset_id()
+              << ", tablet: " << _tablet->tablet_id()
+              << ", segments: " << rowset->num_segments();
+    return Status::OK();
+}
+
+} // namespace doris
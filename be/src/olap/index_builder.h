@@ -0,0 +1,48 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "common/status.h"
+#include "olap/rowset/rowset.h"
+#include "olap/tablet.h"
+
+namespace doris {
+
+// Builds the index files of the segments linked by a schema change adding some indexes, see
+// SegmentIndexFile. Only the indexed columns of each segment are read, and the reads are paced
+// by the CompactionIOScheduler like those of compactions. Each index file is used by the queries
+// once it's written, and the rowset is marked built once all its segments have one.
+class IndexBuilder {
+public:
+    explicit IndexBuilder(TabletSharedPtr tablet) : _tablet(std::move(tablet)) {}
+
+    // Picks the rowsets to build, the permits are the number of their segments.
+    Status prepare(int64_t* permits);
+
+    Status build();
+
+private:
+    Status _build_rowset(const RowsetSharedPtr& rowset);
+
+    TabletSharedPtr _tablet;
+    std::vector<RowsetSharedPtr> _rowsets;
+};
+
+} // namespace doris
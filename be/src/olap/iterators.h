@@ -17,9 +17,11 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 
 #include "common/status.h"
+#include "gen_cpp/PlanNodes_types.h"
 #include "olap/block_column_predicate.h"
 #include "olap/column_predicate.h"
 #include "olap/olap_common.h"
@@ -33,6 +35,10 @@ class RowBlockV2;
 class Schema;
 class Conditions;
 class ColumnPredicate;
+class TopNBoundary;
+
+// The rows [first, second) to read of some segments of a rowset, keyed by segment id.
+using SegmentRowRanges = std::map<uint32_t, std::pair<uint32_t, uint32_t>>;
 
 class StorageReadOptions {
 public:
@@ -74,6 +80,9 @@ public:
 
     std::shared_ptr<AndBlockColumnPredicate> delete_condition_predicates =
             std::make_shared<AndBlockColumnPredicate>();
+    // The latest version of the delete conditions, which keys the cached deleted rows of the
+    // segments, or -1 if the conditions are evaluated on the rows read.
+    int64_t delete_condition_version = -1;
     // reader's column predicate, nullptr if not existed
     // used to fiter rows in row block
     // TODO(hkp): refactor the column predicate framework
@@ -83,9 +92,26 @@ public:
     // REQUIRED (null is not allowed)
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
+    // whether the pages read are cached at probation priority
+    bool bulk_scan = false;
     int block_row_max = 4096;
 
     const TabletSchema* tablet_schema = nullptr;
+
+    // If set, only the segments in it are read, and only the rows in their ranges. The end of a
+    // range is capped by the number of rows of the segment.
+    const SegmentRowRanges* segment_row_ranges = nullptr;
+
+    // If set, the rows that can't be in the result of the TopN above the scan are skipped by the
+    // zone maps of its column, as its boundary tightens.
+    const TopNBoundary* topn_boundary = nullptr;
+
+    // The aggregate above the scan that a segment answers from its metadata when it reads all its
+    // rows, see TPushAggOp.
+    TPushAggOp::type push_down_agg_type_opt = TPushAggOp::NONE;
+    // The number of rows a segment returns at most, -1 if not limited. Only set when the rows
+    // are neither filtered nor merged after the segment.
+    int64_t read_limit = -1;
 };
 
 // Used to read data in RowBlockV2 one by one
@@ -29,6 +29,75 @@ LikeColumnPredicate::LikeColumnPredicate(bool opposite, uint32_t column_id,
         : ColumnPredicate(column_id, opposite), _fn_ctx(fn_ctx), pattern(val) {
     _state = reinterpret_cast<LikePredicateState*>(
             _fn_ctx->get_function_state(doris_udf::FunctionContext::THREAD_LOCAL));
+    std::string literal;
+    // whether a '%' was seen, after which only '%' can follow in a prefix pattern
+    bool after_percent = false;
+    _is_prefix_pattern = true;
+    for (int i = 0; i < pattern.len; ++i) {
+        char c = pattern.ptr[i];
+        if (c == '\\' && i + 1 < pattern.len) {
+            literal.push_back(pattern.ptr[++i]);
+            _is_prefix_pattern &= !after_percent;
+        } else if (c == '%' || c == '_') {
+            if (!literal.empty()) {
+                _literals.push_back(std::move(literal));
+                literal.clear();
+            }
+            after_percent |= c == '%';
+            _is_prefix_pattern &= c == '%';
+        } else {
+            literal.push_back(c);
+            _is_prefix_pattern &= !after_percent;
+        }
+    }
+    if (!literal.empty()) {
+        _literals.push_back(std::move(literal));
+    }
+    _is_prefix_pattern &= after_percent;
+}
+
+bool LikeColumnPredicate::can_do_ngram_bloom_filter(uint32_t gram_size) const {
+    if (_opposite) {
+        return false;
+    }
+    for (auto& literal : _literals) {
+        if (literal.size() >= gram_size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LikeColumnPredicate::evaluate_ngram_bloom_filter(const BloomFilter* bf,
+                                                      uint32_t gram_size) const {
+    // the matching values have all the substrings of the literals
+    for (auto& literal : _literals) {
+        for (size_t pos = 0; pos + gram_size <= literal.size(); ++pos) {
+            if (!bf->test_bytes(const_cast<char*>(literal.data()) + pos, gram_size)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Status LikeColumnPredicate::evaluate_inverted_index(const Schema& schema,
+                                                    InvertedIndexIterator* iterator,
+                                                    uint32_t num_rows,
+                                                    roaring::Roaring* bitmap) const {
+    // NOT LIKE can't be pruned by the terms of the pattern
+    if (_opposite) {
+        return Status::OK();
+    }
+    roaring::Roaring candidates;
+    bool pruned = false;
+    RETURN_IF_ERROR(iterator->like_candidates(
+            Slice(reinterpret_cast<const char*>(pattern.ptr), pattern.len), num_rows, &candidates,
+            &pruned));
+    if (pruned) {
+        *bitmap &= candidates;
+    }
+    return Status::OK();
 }
 
 void LikeColumnPredicate::evaluate(ColumnBlock* block, uint16_t* sel, uint16_t* size) const {
@@ -39,6 +108,23 @@ void LikeColumnPredicate::evaluate(ColumnBlock* block, uint16_t* sel, uint16_t*
     }
 }
 
+bool LikeColumnPredicate::is_string_prefix(std::string* prefix) const {
+    if (_opposite || !_is_prefix_pattern) {
+        return false;
+    }
+    *prefix = _literals.empty() ? "" : _literals[0];
+    return true;
+}
+
+void LikeColumnPredicate::evaluate_and_vec(const vectorized::IColumn& column, uint16_t size,
+                                           bool* flags) const {
+    bool matches[size];
+    evaluate_vec(column, size, matches);
+    for (uint16_t i = 0; i < size; i++) {
+        flags[i] &= matches[i];
+    }
+}
+
 void LikeColumnPredicate::evaluate_vec(const vectorized::IColumn& column, uint16_t size,
                                        bool* flags) const {
     if (column.is_nullable()) {
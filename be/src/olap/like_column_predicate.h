@@ -33,6 +33,8 @@ public:
 
     PredicateType type() const override { return PredicateType::EQ; }
     void evaluate_vec(const vectorized::IColumn& column, uint16_t size, bool* flags) const override;
+    void evaluate_and_vec(const vectorized::IColumn& column, uint16_t size,
+                          bool* flags) const override;
 
     void evaluate(ColumnBlock* block, uint16_t* sel, uint16_t* size) const override;
 
@@ -44,6 +46,13 @@ public:
                     uint32_t num_rows, roaring::Roaring* roaring) const override {
         return Status::OK();
     }
+    Status evaluate_inverted_index(const Schema& schema, InvertedIndexIterator* iterator,
+                                   uint32_t num_rows, roaring::Roaring* bitmap) const override;
+
+    bool can_do_ngram_bloom_filter(uint32_t gram_size) const override;
+    bool evaluate_ngram_bloom_filter(const BloomFilter* bf, uint32_t gram_size) const override;
+
+    bool is_string_prefix(std::string* prefix) const override;
 
 private:
     template <bool is_nullable>
@@ -70,6 +79,10 @@ private:
     // life time controlled by scan node
     doris_udf::FunctionContext* _fn_ctx;
     doris_udf::StringVal pattern;
+    // the runs of literal characters of the pattern, between its wildcards
+    std::vector<std::string> _literals;
+    // whether the pattern is a literal followed by '%' only, the literal being _literals[0] if any
+    bool _is_prefix_pattern = false;
 
     LikePredicateState* _state;
 };
@@ -170,6 +170,8 @@ LRUCache::LRUCache(LRUCacheType type) : _type(type) {
     _lru_normal.prev = &_lru_normal;
     _lru_durable.next = &_lru_durable;
     _lru_durable.prev = &_lru_durable;
+    _lru_probation.next = &_lru_probation;
+    _lru_probation.prev = &_lru_probation;
 }
 
 LRUCache::~LRUCache() {
@@ -178,17 +180,33 @@ LRUCache::~LRUCache() {
 
 bool LRUCache::_unref(LRUHandle* e) {
     DCHECK(e->refs > 0);
-    e->refs--;
-    return e->refs == 0;
+    return e->refs.fetch_sub(1) == 1;
+}
+
+LRUHandle* LRUCache::_lru_list(CachePriority priority) {
+    switch (priority) {
+    case CachePriority::DURABLE:
+        return &_lru_durable;
+    case CachePriority::PROBATION:
+        return &_lru_probation;
+    default:
+        return &_lru_normal;
+    }
 }
 
 void LRUCache::_lru_remove(LRUHandle* e) {
+    if (e->priority == CachePriority::PROBATION) {
+        _probation_usage -= e->total_size;
+    }
     e->next->prev = e->prev;
     e->prev->next = e->next;
     e->prev = e->next = nullptr;
 }
 
 void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
+    if (e->priority == CachePriority::PROBATION) {
+        _probation_usage += e->total_size;
+    }
     // Make "e" newest entry by inserting just before *list
     e->next = list;
     e->prev = list->prev;
@@ -197,18 +215,19 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
 }
 
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
-    std::lock_guard<std::mutex> l(_mutex);
-    ++_lookup_count;
+    std::shared_lock<std::shared_mutex> l(_mutex);
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
     LRUHandle* e = _table.lookup(key, hash);
     if (e != nullptr) {
         // we get it from _table, so in_cache must be true
         DCHECK(e->in_cache);
-        if (e->refs == 1) {
-            // only in LRU free list, remove it from list
-            _lru_remove(e);
+        e->refs.fetch_add(1);
+        // the entry stays where it is on the LRU list, the eviction gives it another chance
+        uint8_t visits = e->visits.load(std::memory_order_relaxed);
+        if (visits < kMaxVisits) {
+            e->visits.store(visits + 1, std::memory_order_relaxed);
         }
-        e->refs++;
-        ++_hit_count;
+        _hit_count.fetch_add(1, std::memory_order_relaxed);
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -219,54 +238,87 @@ void LRUCache::release(Cache::Handle* handle) {
     }
     LRUHandle* e = reinterpret_cast<LRUHandle*>(handle);
     bool last_ref = false;
-    {
-        std::lock_guard<std::mutex> l(_mutex);
+    if (_usage <= _capacity) {
+        // The entry remains on the LRU list while it is used, so releasing it needs no lock.
+        // When the cache holds the last reference, it may be evicted as soon as it is unref'ed.
         last_ref = _unref(e);
-        if (last_ref) {
-            _usage -= e->total_size;
-        } else if (e->in_cache && e->refs == 1) {
-            // only exists in cache
-            if (_usage > _capacity) {
-                // take this opportunity and remove the item
-                bool removed = _table.remove(e);
-                DCHECK(removed);
-                e->in_cache = false;
-                _unref(e);
-                _usage -= e->total_size;
-                last_ref = true;
-            } else {
-                // put it to LRU free list
-                if (e->priority == CachePriority::NORMAL) {
-                    _lru_append(&_lru_normal, e);
-                } else if (e->priority == CachePriority::DURABLE) {
-                    _lru_append(&_lru_durable, e);
-                }
-            }
+    } else {
+        std::lock_guard<std::shared_mutex> l(_mutex);
+        last_ref = _unref(e);
+        if (!last_ref && e->in_cache && e->refs == 1) {
+            // only exists in cache, take this opportunity and remove the item
+            _lru_remove(e);
+            bool removed = _table.remove(e);
+            DCHECK(removed);
+            e->in_cache = false;
+            _unref(e);
+            last_ref = true;
         }
     }
 
     // free handle out of mutex
     if (last_ref) {
+        _usage -= e->total_size;
         e->free();
     }
 }
 
 void LRUCache::_evict_from_lru(size_t total_size, LRUHandle** to_remove_head) {
-    // 1. evict normal cache entries
-    while (_usage + total_size > _capacity && _lru_normal.next != &_lru_normal) {
-        LRUHandle* old = _lru_normal.next;
-        DCHECK(old->priority == CachePriority::NORMAL);
-        _evict_one_entry(old);
-        old->next = *to_remove_head;
-        *to_remove_head = old;
+    // 1. evict probation cache entries beyond their share of the capacity
+    _evict_from_probation(_capacity * kProbationPercentage / 100, total_size, to_remove_head);
+    // 2. evict normal cache entries
+    _evict_from_list(&_lru_normal, total_size, to_remove_head);
+    // 3. evict the rest probation cache entries if need
+    _evict_from_probation(0, total_size, to_remove_head);
+    // 4. evict durable cache entries if need
+    _evict_from_list(&_lru_durable, total_size, to_remove_head);
+}
+
+void LRUCache::_evict_from_probation(size_t probation_capacity, size_t total_size,
+                                     LRUHandle** to_remove_head) {
+    // The visited entries are promoted to normal ones instead of being evicted.
+    LRUHandle* e = _lru_probation.next;
+    while (_usage + total_size > _capacity && _probation_usage > probation_capacity &&
+           e != &_lru_probation) {
+        LRUHandle* next = e->next;
+        if (e->refs > 1) {
+            // in use
+        } else if (e->visits > 0) {
+            _lru_remove(e);
+            e->priority = CachePriority::NORMAL;
+            e->visits = 0;
+            _lru_append(&_lru_normal, e);
+        } else {
+            _evict_one_entry(e);
+            e->next = *to_remove_head;
+            *to_remove_head = e;
+        }
+        e = next;
     }
-    // 2. evict durable cache entries if need
-    while (_usage + total_size > _capacity && _lru_durable.next != &_lru_durable) {
-        LRUHandle* old = _lru_durable.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        old->next = *to_remove_head;
-        *to_remove_head = old;
+}
+
+void LRUCache::_evict_from_list(LRUHandle* list, size_t total_size, LRUHandle** to_remove_head) {
+    // The entries in use are skipped and the visited ones move to the end of the list, so
+    // the visited entries are passed at most kMaxVisits times before they are evicted.
+    LRUHandle* e = list->next;
+    while (_usage + total_size > _capacity && e != list) {
+        LRUHandle* next = e->next;
+        uint8_t visits = e->visits.load(std::memory_order_relaxed);
+        if (e->refs > 1) {
+            // in use
+        } else if (visits > 0) {
+            e->visits.store(visits - 1, std::memory_order_relaxed);
+            _lru_remove(e);
+            _lru_append(list, e);
+            if (next == list) {
+                next = e;
+            }
+        } else {
+            _evict_one_entry(e);
+            e->next = *to_remove_head;
+            *to_remove_head = e;
+        }
+        e = next;
     }
 }
 
@@ -293,6 +345,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->total_size = (_type == LRUCacheType::SIZE ? handle_size + charge : 1);
     e->hash = hash;
     e->refs = 2; // one for the returned handle, one for LRUCache.
+    e->visits = 0;
     e->next = e->prev = nullptr;
     e->in_cache = true;
     e->priority = priority;
@@ -303,7 +356,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     THREAD_MEM_TRACKER_TRANSFER_TO(e->total_size, tracker);
     LRUHandle* to_remove_head = nullptr;
     {
-        std::lock_guard<std::mutex> l(_mutex);
+        std::lock_guard<std::shared_mutex> l(_mutex);
 
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
@@ -314,13 +367,13 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         // space was freed
         auto old = _table.insert(e);
         _usage += e->total_size;
+        _lru_append(_lru_list(e->priority), e);
         if (old != nullptr) {
+            // old is on LRU because it's in cache
+            _lru_remove(old);
             old->in_cache = false;
             if (_unref(old)) {
                 _usage -= old->total_size;
-                // old is on LRU because it's in cache and its reference count
-                // was just 1 (Unref returned 0)
-                _lru_remove(old);
                 old->next = to_remove_head;
                 to_remove_head = old;
             }
@@ -342,18 +395,16 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
     LRUHandle* e = nullptr;
     bool last_ref = false;
     {
-        std::lock_guard<std::mutex> l(_mutex);
+        std::lock_guard<std::shared_mutex> l(_mutex);
         e = _table.remove(key, hash);
         if (e != nullptr) {
+            // the entry in cache is on LRU list
+            _lru_remove(e);
+            e->in_cache = false;
             last_ref = _unref(e);
             if (last_ref) {
                 _usage -= e->total_size;
-                if (e->in_cache) {
-                    // locate in free list
-                    _lru_remove(e);
-                }
             }
-            e->in_cache = false;
         }
     }
     // free handle out of mutex, when last_ref is true, e must not be nullptr
@@ -363,56 +414,25 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
 }
 
 int64_t LRUCache::prune() {
-    LRUHandle* to_remove_head = nullptr;
-    {
-        std::lock_guard<std::mutex> l(_mutex);
-        while (_lru_normal.next != &_lru_normal) {
-            LRUHandle* old = _lru_normal.next;
-            _evict_one_entry(old);
-            old->next = to_remove_head;
-            to_remove_head = old;
-        }
-        while (_lru_durable.next != &_lru_durable) {
-            LRUHandle* old = _lru_durable.next;
-            _evict_one_entry(old);
-            old->next = to_remove_head;
-            to_remove_head = old;
-        }
-    }
-    int64_t pruned_count = 0;
-    while (to_remove_head != nullptr) {
-        ++pruned_count;
-        LRUHandle* next = to_remove_head->next;
-        to_remove_head->free();
-        to_remove_head = next;
-    }
-    return pruned_count;
+    return prune_if([](const void*) { return true; });
 }
 
 int64_t LRUCache::prune_if(CacheValuePredicate pred) {
     LRUHandle* to_remove_head = nullptr;
     {
-        std::lock_guard<std::mutex> l(_mutex);
-        LRUHandle* p = _lru_normal.next;
-        while (p != &_lru_normal) {
-            LRUHandle* next = p->next;
-            if (pred(p->value)) {
-                _evict_one_entry(p);
-                p->next = to_remove_head;
-                to_remove_head = p;
-            }
-            p = next;
-        }
-
-        p = _lru_durable.next;
-        while (p != &_lru_durable) {
-            LRUHandle* next = p->next;
-            if (pred(p->value)) {
-                _evict_one_entry(p);
-                p->next = to_remove_head;
-                to_remove_head = p;
+        std::lock_guard<std::shared_mutex> l(_mutex);
+        // the entries in use are on the LRU lists too, but can not be pruned
+        for (LRUHandle* list : {&_lru_normal, &_lru_probation, &_lru_durable}) {
+            LRUHandle* p = list->next;
+            while (p != list) {
+                LRUHandle* next = p->next;
+                if (p->refs == 1 && pred(p->value)) {
+                    _evict_one_entry(p);
+                    p->next = to_remove_head;
+                    to_remove_head = p;
+                }
+                p = next;
             }
-            p = next;
         }
     }
     int64_t pruned_count = 0;
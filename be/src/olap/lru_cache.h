@@ -9,7 +9,9 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <atomic>
 #include <functional>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -143,7 +145,11 @@ private:
 };
 
 // The entry with smaller CachePriority will evict firstly
-enum class CachePriority { NORMAL = 0, DURABLE = 1 };
+// The PROBATION entries are kept apart from the NORMAL ones and are evicted first once they use
+// more than a quarter of the cache, unless they are looked up again before, in which case they
+// become NORMAL entries. They are used for the data read only once, such as bulk scans, so
+// such reads don't evict the working set of the cache.
+enum class CachePriority { NORMAL = 0, DURABLE = 1, PROBATION = 2 };
 
 using CacheValuePredicate = std::function<bool(const void*)>;
 
@@ -222,7 +228,9 @@ private:
 };
 
 // An entry is a variable length heap-allocated structure.  Entries
-// are kept in a circular doubly linked list ordered by access time.
+// are kept in a circular doubly linked list ordered by insertion time,
+// the entries looked up since they are put at the end of the list are
+// given another chance when they reach the front.
 typedef struct LRUHandle {
     void* value;
     void (*deleter)(const CacheKey&, void* value);
@@ -233,7 +241,10 @@ typedef struct LRUHandle {
     size_t key_length;
     size_t total_size; // including key length
     bool in_cache;     // Whether entry is in the cache.
-    uint32_t refs;
+    // The times the entry is looked up since it is put at the end of the LRU list, at most
+    // LRUCache::kMaxVisits. It is updated by the lookups holding the shared lock.
+    std::atomic<uint8_t> visits;
+    std::atomic<uint32_t> refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
     MemTrackerLimiter* mem_tracker;
@@ -299,6 +310,11 @@ private:
 };
 
 // A single shard of sharded cache.
+//
+// Lookups only take the shared lock: they never move the entries on the
+// LRU lists, but count the visits of an entry and the eviction moves the
+// visited entries back to the end of the list instead of evicting them.
+// The entries in use stay on the lists and are skipped by the eviction.
 class LRUCache {
 public:
     LRUCache(LRUCacheType type);
@@ -323,11 +339,22 @@ public:
     size_t get_usage() const { return _usage; }
     size_t get_capacity() const { return _capacity; }
 
+    // The visits an entry counts at most, the eviction decreases them by one each time it
+    // gives the entry another chance.
+    static constexpr uint8_t kMaxVisits = 3;
+    // The percentage of the capacity the PROBATION entries may use before they are evicted
+    // ahead of the NORMAL ones.
+    static constexpr size_t kProbationPercentage = 25;
+
 private:
     void _lru_remove(LRUHandle* e);
     void _lru_append(LRUHandle* list, LRUHandle* e);
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t total_size, LRUHandle** to_remove_head);
+    void _evict_from_list(LRUHandle* list, size_t total_size, LRUHandle** to_remove_head);
+    void _evict_from_probation(size_t probation_capacity, size_t total_size,
+                               LRUHandle** to_remove_head);
+    LRUHandle* _lru_list(CachePriority priority);
     void _evict_one_entry(LRUHandle* e);
 
 private:
@@ -336,21 +363,25 @@ private:
     // Initialized before use.
     size_t _capacity = 0;
 
-    // _mutex protects the following state.
-    std::mutex _mutex;
-    size_t _usage = 0;
+    // _mutex protects the following state, lookups only hold it shared.
+    std::shared_mutex _mutex;
+    std::atomic<size_t> _usage = 0;
 
     // Dummy head of LRU list.
-    // Entries have refs==1 and in_cache==true.
+    // Entries have in_cache==true, the ones with refs==1 may be evicted.
     // _lru_normal.prev is newest entry, _lru_normal.next is oldest entry.
     LRUHandle _lru_normal;
     // _lru_durable.prev is newest entry, _lru_durable.next is oldest entry.
     LRUHandle _lru_durable;
+    // _lru_probation.prev is newest entry, _lru_probation.next is oldest entry.
+    LRUHandle _lru_probation;
+    // the total size of the entries on _lru_probation
+    size_t _probation_usage = 0;
 
     HandleTable _table;
 
-    uint64_t _lookup_count = 0; // cache查找总次数
-    uint64_t _hit_count = 0;    // 命中cache的总次数
+    std::atomic<uint64_t> _lookup_count = 0; // cache查找总次数
+    std::atomic<uint64_t> _hit_count = 0;    // 命中cache的总次数
 };
 
 class ShardedLRUCache : public Cache {
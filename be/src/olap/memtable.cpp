@@ -17,12 +17,17 @@
 
 #include "olap/memtable.h"
 
+#include <pdqsort.h>
+
+#include <numeric>
+
 #include "common/logging.h"
 #include "olap/row.h"
 #include "olap/rowset/rowset_writer.h"
 #include "olap/schema.h"
 #include "runtime/tuple.h"
 #include "util/doris_metrics.h"
+#include "vec/common/arena.h"
 #include "vec/aggregate_functions/aggregate_function_reader.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/core/field.h"
@@ -52,10 +57,20 @@ MemTable::MemTable(int64_t tablet_id, Schema* schema, const TabletSchema* tablet
           _mem_usage(0) {
     if (support_vec) {
         _skip_list = nullptr;
-        _vec_row_comparator = std::make_shared<RowInBlockComparator>(_schema);
-        // TODO: Support ZOrderComparator in the future
-        _vec_skip_list = std::make_unique<VecTable>(
-                _vec_row_comparator.get(), _table_mem_pool.get(), _keys_type == KeysType::DUP_KEYS);
+        _sort_on_flush = config::enable_memtable_sort_on_flush;
+        // the rows with equal keys are not adjacent in z-order, so only the duplicate keys
+        // tables may be sorted by it
+        if (tablet_schema->sort_type() == SortType::ZORDER && _keys_type == KeysType::DUP_KEYS) {
+            _zorder_comparator = std::make_unique<vectorized::ZOrderComparator>(
+                    *tablet_schema, tablet_schema->sort_col_num());
+        }
+        if (!_sort_on_flush) {
+            _vec_row_comparator =
+                    std::make_shared<RowInBlockComparator>(_schema, _zorder_comparator.get());
+            _vec_skip_list = std::make_unique<VecTable>(_vec_row_comparator.get(),
+                                                        _table_mem_pool.get(),
+                                                        _keys_type == KeysType::DUP_KEYS);
+        }
         _init_columns_offset_by_slot_descs(slot_descs, tuple_desc);
     } else {
         _vec_skip_list = nullptr;
@@ -151,6 +166,9 @@ int MemTable::RowCursorComparator::operator()(const char* left, const char* righ
 
 int MemTable::RowInBlockComparator::operator()(const RowInBlock* left,
                                                const RowInBlock* right) const {
+    if (_zorder_comparator != nullptr) {
+        return _zorder_comparator->compare_at(left->_row_pos, right->_row_pos, *_pblock, *_pblock);
+    }
     return _pblock->compare_at(left->_row_pos, right->_row_pos, _schema->num_key_columns(),
                                *_pblock, -1);
 }
@@ -161,7 +179,9 @@ void MemTable::insert(const vectorized::Block* input_block, const std::vector<in
         _is_first_insertion = false;
         auto cloneBlock = target_block.clone_without_columns();
         _input_mutable_block = vectorized::MutableBlock::build_mutable_block(&cloneBlock);
-        _vec_row_comparator->set_block(&_input_mutable_block);
+        if (_vec_row_comparator != nullptr) {
+            _vec_row_comparator->set_block(&_input_mutable_block);
+        }
         _output_mutable_block = vectorized::MutableBlock::build_mutable_block(&cloneBlock);
         if (_keys_type != KeysType::DUP_KEYS) {
             _init_agg_functions(&target_block);
@@ -174,6 +194,11 @@ void MemTable::insert(const vectorized::Block* input_block, const std::vector<in
     _mem_usage += input_size;
     _mem_tracker->consume(input_size);
 
+    if (_sort_on_flush) {
+        // the rows are sorted and aggregated only when the memtable is shrunk or flushed
+        _rows += num_rows;
+        return;
+    }
     for (int i = 0; i < num_rows; i++) {
         _row_in_blocks.emplace_back(new RowInBlock {cursor_in_mutableblock + i});
         _insert_one_row_from_block(_row_in_blocks.back());
@@ -344,10 +369,130 @@ void MemTable::_collect_vskiplist_results() {
     }
 }
 
+template <bool is_final>
+void MemTable::_sort_and_aggregate_rows() {
+    vectorized::Block in_block = _input_mutable_block.to_block();
+    size_t num_rows = in_block.rows();
+    if (num_rows == 0) {
+        return;
+    }
+    size_t num_key_columns = _schema->num_key_columns();
+
+    vectorized::IColumn::Permutation perm(num_rows);
+    std::iota(perm.begin(), perm.end(), 0);
+    // The rows with equal keys keep the order they were inserted in, as the later rows must
+    // replace the earlier ones for the unique and replace columns.
+    pdqsort(perm.begin(), perm.end(), [&](size_t lhs, size_t rhs) {
+        int res = _zorder_comparator != nullptr
+                          ? _zorder_comparator->compare_at(lhs, rhs, in_block, in_block)
+                          : in_block.compare_at(lhs, rhs, num_key_columns, in_block, -1);
+        return res != 0 ? res < 0 : lhs < rhs;
+    });
+
+    if (_keys_type == KeysType::DUP_KEYS) {
+        for (size_t i = 0; i < in_block.columns(); ++i) {
+            auto& column = in_block.get_by_position(i).column;
+            column = column->permute(perm, 0);
+        }
+        _output_mutable_block = vectorized::MutableBlock::build_mutable_block(&in_block);
+        return;
+    }
+
+    // the first row of each group of rows with equal keys, in the sorted order
+    std::vector<int> group_rows;
+    std::vector<size_t> group_ends;
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (i == 0 || in_block.compare_at(perm[i - 1], perm[i], num_key_columns, in_block, -1)) {
+            if (i != 0) {
+                group_ends.push_back(i);
+            }
+            group_rows.push_back(perm[i]);
+        }
+    }
+    group_ends.push_back(num_rows);
+    size_t num_groups = group_rows.size();
+
+    vectorized::Arena agg_arena;
+    std::vector<vectorized::AggregateDataPtr> places(num_groups);
+    for (size_t g = 0; g < num_groups; ++g) {
+        places[g] = agg_arena.aligned_alloc(_total_size_of_aggregate_states, 16);
+        for (auto cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+            _agg_functions[cid]->create(places[g] + _offsets_of_aggregate_states[cid]);
+        }
+    }
+
+    auto& block_data = in_block.get_columns_with_type_and_name();
+    if (_tablet_schema->has_sequence_col()) {
+        // a row is only aggregated when its sequence is not smaller than the last aggregated one
+        auto sequence_idx = _tablet_schema->sequence_col_idx();
+        size_t begin = 0;
+        for (size_t g = 0; g < num_groups; ++g) {
+            size_t last_row = perm[begin];
+            for (size_t i = begin; i < group_ends[g]; ++i) {
+                size_t row = perm[i];
+                if (i != begin &&
+                    in_block.compare_column_at(last_row, row, sequence_idx, in_block, -1) > 0) {
+                    continue;
+                }
+                for (auto cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+                    const vectorized::IColumn* column = block_data[cid].column.get();
+                    _agg_functions[cid]->add(places[g] + _offsets_of_aggregate_states[cid],
+                                             &column, row, nullptr);
+                }
+                last_row = row;
+            }
+            begin = group_ends[g];
+        }
+    } else {
+        std::vector<vectorized::AggregateDataPtr> row_places(num_rows);
+        size_t begin = 0;
+        for (size_t g = 0; g < num_groups; ++g) {
+            for (size_t i = begin; i < group_ends[g]; ++i) {
+                row_places[perm[i]] = places[g];
+            }
+            begin = group_ends[g];
+        }
+        for (auto cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+            const vectorized::IColumn* column = block_data[cid].column.get();
+            _agg_functions[cid]->add_batch(num_rows, row_places.data(),
+                                           _offsets_of_aggregate_states[cid], &column, &agg_arena);
+        }
+    }
+
+    for (size_t i = 0; i < num_key_columns; ++i) {
+        _output_mutable_block.get_column_by_position(i)->insert_indices_from(
+                *block_data[i].column, group_rows.data(), group_rows.data() + num_groups);
+    }
+    for (auto cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+        auto& dst = *_output_mutable_block.get_column_by_position(cid);
+        for (size_t g = 0; g < num_groups; ++g) {
+            auto agg_place = places[g] + _offsets_of_aggregate_states[cid];
+            _agg_functions[cid]->insert_result_into(agg_place, dst);
+            _agg_functions[cid]->destroy(agg_place);
+        }
+    }
+
+    if constexpr (!is_final) {
+        // collect the agg results to input_block and then continue to append
+        size_t shrunked_after_agg = _output_mutable_block.allocated_bytes();
+        _mem_tracker->consume(shrunked_after_agg - _mem_usage);
+        _mem_usage = shrunked_after_agg;
+        _input_mutable_block.swap(_output_mutable_block);
+        std::unique_ptr<vectorized::Block> empty_input_block = in_block.create_same_struct_block(0);
+        _output_mutable_block =
+                vectorized::MutableBlock::build_mutable_block(empty_input_block.get());
+        _output_mutable_block.clear_column_data();
+    }
+}
+
 void MemTable::shrink_memtable_by_agg() {
     if (_keys_type == KeysType::DUP_KEYS) {
         return;
     }
+    if (_sort_on_flush) {
+        _sort_and_aggregate_rows<false>();
+        return;
+    }
     _collect_vskiplist_results<false>();
 }
 
@@ -367,6 +512,7 @@ Status MemTable::flush() {
     RETURN_NOT_OK(_do_flush(duration_ns));
     DorisMetrics::instance()->memtable_flush_total->increment(1);
     DorisMetrics::instance()->memtable_flush_duration_us->increment(duration_ns / 1000);
+    DorisMetrics::instance()->memtable_flush_latency_us->add(duration_ns / 1000);
     VLOG_CRITICAL << "after flush memtable for tablet: " << _tablet_id
                   << ", flushsize: " << _flush_size;
     return Status::OK();
@@ -391,7 +537,11 @@ Status MemTable::_do_flush(int64_t& duration_ns) {
             RETURN_NOT_OK(st);
         }
     } else {
-        _collect_vskiplist_results<true>();
+        if (_sort_on_flush) {
+            _sort_and_aggregate_rows<true>();
+        } else {
+            _collect_vskiplist_results<true>();
+        }
         vectorized::Block block = _output_mutable_block.to_block();
         RETURN_NOT_OK(_rowset_writer->flush_single_memtable(&block));
         _flush_size = block.allocated_bytes();
@@ -27,6 +27,7 @@
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/common/string_ref.h"
 #include "vec/core/block.h"
+#include "vec/olap/zorder_comparator.h"
 
 namespace doris {
 
@@ -95,7 +96,9 @@ private:
 
     class RowInBlockComparator {
     public:
-        RowInBlockComparator(const Schema* schema) : _schema(schema) {};
+        RowInBlockComparator(const Schema* schema,
+                             const vectorized::ZOrderComparator* zorder_comparator = nullptr)
+                : _schema(schema), _zorder_comparator(zorder_comparator) {};
         // call set_block before operator().
         // only first time insert block to create _input_mutable_block,
         // so can not Comparator of construct to set pblock
@@ -104,6 +107,8 @@ private:
 
     private:
         const Schema* _schema;
+        // compares the rows by z-order instead of by the keys when not null
+        const vectorized::ZOrderComparator* _zorder_comparator;
         vectorized::MutableBlock* _pblock; // 对应Memtable::_input_mutable_block
     };
 
@@ -151,6 +156,8 @@ private:
     std::shared_ptr<RowComparator> _row_comparator;
 
     std::shared_ptr<RowInBlockComparator> _vec_row_comparator;
+    // the order of the rows of the vectorized memtable when the table is sorted by z-order
+    std::unique_ptr<vectorized::ZOrderComparator> _zorder_comparator;
 
     std::unique_ptr<MemTracker> _mem_tracker;
     MemTracker* _writer_mem_tracker;
@@ -195,6 +202,11 @@ private:
 
     template <bool is_final>
     void _collect_vskiplist_results();
+    // Sort the appended rows by the key columns and aggregate the rows with equal keys, used
+    // instead of _collect_vskiplist_results() when the rows are not kept in a skiplist.
+    template <bool is_final>
+    void _sort_and_aggregate_rows();
+    bool _sort_on_flush = false;
     bool _is_first_insertion;
 
     void _init_agg_functions(const vectorized::Block* block);
@@ -95,6 +95,7 @@ public:
     ~MemTableFlushExecutor() {
         _flush_pool->shutdown();
         _high_prio_flush_pool->shutdown();
+        _segment_flush_pool->shutdown();
     }
 
     // init should be called after storage engine is opened,
@@ -104,9 +105,14 @@ public:
     Status create_flush_token(std::unique_ptr<FlushToken>* flush_token, RowsetTypePB rowset_type,
                               bool is_high_priority);
 
+    // The pool writing the segments of one memtable flush concurrently. It is separated from
+    // the flush pools because a flush task waits for the segment tasks it submits.
+    ThreadPool* segment_flush_pool() { return _segment_flush_pool.get(); }
+
 private:
     std::unique_ptr<ThreadPool> _flush_pool;
     std::unique_ptr<ThreadPool> _high_prio_flush_pool;
+    std::unique_ptr<ThreadPool> _segment_flush_pool;
 };
 
 } // namespace doris
@@ -20,12 +20,16 @@
 #include <memory>
 #include <vector>
 
+#include "olap/compaction_io_scheduler.h"
 #include "olap/olap_define.h"
 #include "olap/row_cursor.h"
 #include "olap/tablet.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/storage_engine.h"
 #include "olap/tuple_reader.h"
 #include "util/trace.h"
 #include "vec/olap/block_reader.h"
+#include "vec/olap/vertical_merge_iterator.h"
 
 namespace doris {
 
@@ -52,6 +56,7 @@ Status Merger::merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     row_cursor.allocate_memory_for_string_type(*cur_tablet_schema);
 
     std::unique_ptr<MemPool> mem_pool(new MemPool());
+    CompactionIOMeter io_meter(tablet, reader_type);
 
     // The following procedure would last for long time, half of one day, etc.
     int64_t output_rows = 0;
@@ -69,6 +74,7 @@ Status Merger::merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                 dst_rowset_writer->add_row(row_cursor),
                 "failed to write row when merging rowsets of tablet " + tablet->full_name());
         output_rows++;
+        io_meter.on_read(reader.stats().compressed_bytes_read);
         LOG_IF(INFO, config::row_step_for_compaction_merge_log != 0 &&
                              output_rows % config::row_step_for_compaction_merge_log == 0)
                 << "Merge rowsets stay alive. "
@@ -111,6 +117,7 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     RETURN_NOT_OK(reader.init(reader_params));
 
     vectorized::Block block = schema.create_block(reader_params.return_columns);
+    CompactionIOMeter io_meter(tablet, reader_type);
     size_t output_rows = 0;
     bool eof = false;
     while (!eof) {
@@ -123,6 +130,7 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                 "failed to write block when merging rowsets of tablet " + tablet->full_name());
         output_rows += block.rows();
         block.clear_column_data();
+        io_meter.on_read(reader.stats().compressed_bytes_read);
     }
 
     if (stats_output != nullptr) {
@@ -138,4 +146,195 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     return Status::OK();
 }
 
+void Merger::vertical_split_columns(const TabletSchema& tablet_schema,
+                                    std::vector<std::vector<uint32_t>>* column_groups) {
+    column_groups->clear();
+    std::vector<uint32_t> key_columns(tablet_schema.num_key_columns());
+    std::iota(key_columns.begin(), key_columns.end(), 0);
+    int32_t sequence_col_idx = -1;
+    if (tablet_schema.keys_type() == KeysType::UNIQUE_KEYS &&
+        tablet_schema.has_sequence_col()) {
+        sequence_col_idx = tablet_schema.sequence_col_idx();
+        key_columns.push_back(sequence_col_idx);
+    }
+    column_groups->push_back(std::move(key_columns));
+
+    size_t num_columns_per_group =
+            std::max<int32_t>(1, config::vertical_compaction_num_columns_per_group);
+    std::vector<uint32_t> value_columns;
+    for (uint32_t cid = tablet_schema.num_key_columns(); cid < tablet_schema.num_columns(); ++cid) {
+        if (cid == sequence_col_idx) {
+            continue;
+        }
+        value_columns.push_back(cid);
+        if (value_columns.size() == num_columns_per_group) {
+            column_groups->push_back(std::move(value_columns));
+            value_columns.clear();
+        }
+    }
+    if (!value_columns.empty()) {
+        column_groups->push_back(std::move(value_columns));
+    }
+}
+
+bool Merger::can_vertical_merge(TabletSharedPtr tablet, ReaderType reader_type,
+                                const TabletSchema& tablet_schema,
+                                const std::vector<RowsetSharedPtr>& src_rowsets) {
+    if (!config::enable_vertical_compaction) {
+        return false;
+    }
+    // the row store column is encoded from all the columns of a row at once
+    if (tablet_schema.has_row_store_column()) {
+        return false;
+    }
+    // the key group is merged by the order of the keys, not by z-order
+    if (tablet_schema.sort_type() == SortType::ZORDER) {
+        return false;
+    }
+    // there is nothing to gain with only the key group
+    std::vector<std::vector<uint32_t>> column_groups;
+    vertical_split_columns(tablet_schema, &column_groups);
+    if (column_groups.size() < 2) {
+        return false;
+    }
+    if (vectorized::vertical_merge_sources(src_rowsets).size() >
+        vectorized::RowSource::MAX_SOURCE) {
+        return false;
+    }
+    // the delete predicates on value columns are applied by the row-wise merge
+    if (reader_type == READER_BASE_COMPACTION) {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        if (!tablet->delete_predicates().empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                      const TabletSchema* cur_tablet_schema,
+                                      const std::vector<RowsetSharedPtr>& src_rowsets,
+                                      RowsetWriter* dst_rowset_writer, Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
+
+    const auto& schema = *cur_tablet_schema;
+    std::vector<std::vector<uint32_t>> column_groups;
+    vertical_split_columns(schema, &column_groups);
+
+    // the segments are cut by rows since the size of a segment is not known before all of its
+    // groups are written
+    int64_t input_rows = 0;
+    int64_t input_size = 0;
+    for (auto& rowset : src_rowsets) {
+        input_rows += rowset->num_rows();
+        input_size += rowset->data_disk_size();
+    }
+    uint32_t max_rows_per_segment = UINT32_MAX;
+    if (input_rows > 0 && input_size > 0) {
+        int64_t row_size = std::max<int64_t>(1, input_size / input_rows);
+        max_rows_per_segment = std::clamp<int64_t>(segment_v2::target_segment_size() / row_size,
+                                                   1, UINT32_MAX);
+    }
+    RETURN_NOT_OK_LOG(dst_rowset_writer->init_column_groups(column_groups, max_rows_per_segment),
+                      "failed to init column groups of rowset writer of tablet " +
+                              tablet->full_name());
+
+    auto sources = vectorized::vertical_merge_sources(src_rowsets);
+    vectorized::RowSourcesBuffer row_sources(
+            fmt::format("{}/compaction_{}.row_sources.tmp", tablet->tablet_path(),
+                        dst_rowset_writer->rowset_id().to_string()),
+            config::vertical_compaction_max_row_source_memory_mb * 1024 * 1024);
+    // the default batch size of the tablet reader used by the row-wise merge
+    int batch_size = 1024;
+
+    // 1. merge the key group
+    int64_t output_rows = 0;
+    int64_t merged_rows = 0;
+    {
+        int sequence_loc = -1;
+        if (column_groups[0].size() > schema.num_key_columns()) {
+            sequence_loc = schema.num_key_columns();
+        }
+        vectorized::VerticalKeyMerger merger(cur_tablet_schema, column_groups[0], reader_type,
+                                             batch_size, sequence_loc);
+        RETURN_NOT_OK_LOG(merger.init(sources), "failed to init key merger of tablet " +
+                                                        tablet->full_name());
+        vectorized::Block block = schema.create_block(column_groups[0]);
+        CompactionIOMeter io_meter(tablet, reader_type);
+        while (true) {
+            auto res = merger.next_block(&block, &row_sources);
+            if (res.precise_code() == OLAP_ERR_DATA_EOF) {
+                break;
+            }
+            RETURN_NOT_OK_LOG(res, "failed to merge key columns of tablet " + tablet->full_name());
+            RETURN_NOT_OK_LOG(dst_rowset_writer->add_columns(0, &block),
+                              "failed to write key columns of tablet " + tablet->full_name());
+            output_rows += block.rows();
+            block.clear_column_data();
+            io_meter.on_read(merger.stats().compressed_bytes_read);
+        }
+        merged_rows = merger.merged_rows();
+        RETURN_IF_ERROR(row_sources.flush());
+        RETURN_IF_ERROR(dst_rowset_writer->flush_columns(0));
+    }
+    TRACE("merge key columns finished");
+
+    // 2. merge the value groups in the order of the row sources
+    auto merge_value_group = [&](size_t group) -> Status {
+        vectorized::VerticalValueMerger merger(cur_tablet_schema, column_groups[group],
+                                               reader_type, batch_size);
+        RETURN_IF_ERROR(merger.init(sources, row_sources));
+        vectorized::Block block = schema.create_block(column_groups[group]);
+        CompactionIOMeter io_meter(tablet, reader_type);
+        while (true) {
+            auto res = merger.next_block(&block);
+            if (res.precise_code() == OLAP_ERR_DATA_EOF) {
+                break;
+            }
+            RETURN_IF_ERROR(res);
+            RETURN_IF_ERROR(dst_rowset_writer->add_columns(group, &block));
+            block.clear_column_data();
+            io_meter.on_read(merger.stats().compressed_bytes_read);
+        }
+        return dst_rowset_writer->flush_columns(group);
+    };
+
+    std::vector<Status> group_status(column_groups.size());
+    std::unique_ptr<ThreadPoolToken> token;
+    ThreadPool* pool = StorageEngine::instance()->vertical_compaction_thread_pool();
+    if (pool != nullptr && config::vertical_compaction_max_parallel_groups > 1) {
+        token = pool->new_token(ThreadPool::ExecutionMode::CONCURRENT,
+                                config::vertical_compaction_max_parallel_groups);
+    }
+    for (size_t group = 1; group < column_groups.size(); ++group) {
+        if (token != nullptr &&
+            token->submit_func([&, group]() { group_status[group] = merge_value_group(group); })
+                    .ok()) {
+            continue;
+        }
+        group_status[group] = merge_value_group(group);
+    }
+    if (token != nullptr) {
+        token->wait();
+    }
+    for (size_t group = 1; group < column_groups.size(); ++group) {
+        RETURN_NOT_OK_LOG(group_status[group], fmt::format("failed to merge column group {} of "
+                                                           "tablet {}",
+                                                           group, tablet->full_name()));
+    }
+    TRACE("merge value columns finished");
+
+    if (stats_output != nullptr) {
+        stats_output->output_rows = output_rows;
+        stats_output->merged_rows = merged_rows;
+        stats_output->filtered_rows = 0;
+    }
+
+    RETURN_NOT_OK_LOG(
+            dst_rowset_writer->flush(),
+            "failed to flush rowset when merging rowsets of tablet " + tablet->full_name());
+
+    return Status::OK();
+}
+
 } // namespace doris
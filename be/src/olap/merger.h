@@ -44,6 +44,25 @@ public:
                                  const TabletSchema* cur_tablet_schema,
                                  const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                  RowsetWriter* dst_rowset_writer, Statistics* stats_output);
+
+    // Splits the columns of 'tablet_schema' into the groups of vertical compaction. The first
+    // group has the key columns, and the sequence column if any.
+    static void vertical_split_columns(const TabletSchema& tablet_schema,
+                                       std::vector<std::vector<uint32_t>>* column_groups);
+
+    // whether 'src_rowsets' of 'tablet' can be merged by vertical_merge_rowsets
+    static bool can_vertical_merge(TabletSharedPtr tablet, ReaderType reader_type,
+                                   const TabletSchema& tablet_schema,
+                                   const std::vector<RowsetSharedPtr>& src_rowsets);
+
+    // Merges 'src_rowsets' column group by column group: the key group is merged first, which
+    // records the source of every row, then the value groups are read in that order in
+    // parallel. Only one key group and one value group of blocks is in memory at a time.
+    static Status vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                         const TabletSchema* cur_tablet_schema,
+                                         const std::vector<RowsetSharedPtr>& src_rowsets,
+                                         RowsetWriter* dst_rowset_writer,
+                                         Statistics* stats_output);
 };
 
 } // namespace doris
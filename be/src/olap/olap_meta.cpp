@@ -22,10 +22,14 @@
 
 #include "common/logging.h"
 #include "olap/olap_define.h"
+#include "rocksdb/cache.h"
 #include "rocksdb/db.h"
+#include "rocksdb/filter_policy.h"
 #include "rocksdb/options.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/slice_transform.h"
+#include "rocksdb/table.h"
+#include "rocksdb/write_batch.h"
 #include "util/doris_metrics.h"
 #include "util/runtime_profile.h"
 
@@ -45,6 +49,13 @@ namespace doris {
 const std::string META_POSTFIX = "/meta";
 const size_t PREFIX_LENGTH = 4;
 
+// The block cache shared by the metas of all the data dirs.
+static std::shared_ptr<rocksdb::Cache> meta_block_cache() {
+    static std::shared_ptr<rocksdb::Cache> cache =
+            rocksdb::NewLRUCache(config::meta_block_cache_size_mb * 1024 * 1024);
+    return cache;
+}
+
 OlapMeta::OlapMeta(const std::string& root_path) : _root_path(root_path), _db(nullptr) {}
 
 OlapMeta::~OlapMeta() {
@@ -65,13 +76,19 @@ Status OlapMeta::init() {
     options.create_if_missing = true;
     options.create_missing_column_families = true;
     std::string db_path = _root_path + META_POSTFIX;
+    // the point lookups of the keys are served by the shared block cache and the bloom filters
+    rocksdb::BlockBasedTableOptions table_options;
+    table_options.block_cache = meta_block_cache();
+    table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+    ColumnFamilyOptions column_family;
+    column_family.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
     std::vector<ColumnFamilyDescriptor> column_families;
     // default column family is required
-    column_families.emplace_back(DEFAULT_COLUMN_FAMILY, ColumnFamilyOptions());
-    column_families.emplace_back(DORIS_COLUMN_FAMILY, ColumnFamilyOptions());
+    column_families.emplace_back(DEFAULT_COLUMN_FAMILY, column_family);
+    column_families.emplace_back(DORIS_COLUMN_FAMILY, column_family);
 
     // meta column family add prefix extractor to improve performance and ensure correctness
-    ColumnFamilyOptions meta_column_family;
+    ColumnFamilyOptions meta_column_family = column_family;
     meta_column_family.prefix_extractor.reset(NewFixedPrefixTransform(PREFIX_LENGTH));
     column_families.emplace_back(META_COLUMN_FAMILY, meta_column_family);
     rocksdb::Status s = DB::Open(options, db_path, column_families, &_handles, &_db);
@@ -101,6 +118,36 @@ Status OlapMeta::get(const int column_family_index, const std::string& key, std:
     return Status::OK();
 }
 
+void OlapMeta::multi_get(const int column_family_index, const std::vector<std::string>& keys,
+                         std::vector<std::string>* values, std::vector<Status>* statuses) {
+    values->clear();
+    statuses->clear();
+    if (keys.empty()) {
+        return;
+    }
+    DorisMetrics::instance()->meta_read_request_total->increment(1);
+    std::vector<rocksdb::ColumnFamilyHandle*> handles(keys.size(), _handles[column_family_index]);
+    std::vector<rocksdb::Slice> slices(keys.begin(), keys.end());
+    int64_t duration_ns = 0;
+    std::vector<rocksdb::Status> s;
+    {
+        SCOPED_RAW_TIMER(&duration_ns);
+        s = _db->MultiGet(ReadOptions(), handles, slices, values);
+    }
+    DorisMetrics::instance()->meta_read_request_duration_us->increment(duration_ns / 1000);
+    statuses->reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (s[i].IsNotFound()) {
+            statuses->push_back(Status::OLAPInternalError(OLAP_ERR_META_KEY_NOT_FOUND));
+        } else if (!s[i].ok()) {
+            LOG(WARNING) << "rocks db get key:" << keys[i] << " failed, reason:" << s[i].ToString();
+            statuses->push_back(Status::OLAPInternalError(OLAP_ERR_META_GET));
+        } else {
+            statuses->push_back(Status::OK());
+        }
+    }
+}
+
 bool OlapMeta::key_may_exist(const int column_family_index, const std::string& key,
                              std::string* value) {
     DorisMetrics::instance()->meta_read_request_total->increment(1);
@@ -136,6 +183,39 @@ Status OlapMeta::put(const int column_family_index, const std::string& key,
     return Status::OK();
 }
 
+Status OlapMeta::put(const int column_family_index,
+                     const std::vector<std::pair<std::string, std::string>>& entries) {
+    if (entries.empty()) {
+        return Status::OK();
+    }
+    DorisMetrics::instance()->meta_write_request_total->increment(1);
+    rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
+    int64_t duration_ns = 0;
+    rocksdb::Status s;
+    {
+        SCOPED_RAW_TIMER(&duration_ns);
+        rocksdb::WriteBatch batch;
+        for (const auto& [key, value] : entries) {
+            s = batch.Put(handle, rocksdb::Slice(key), rocksdb::Slice(value));
+            if (!s.ok()) {
+                break;
+            }
+        }
+        if (s.ok()) {
+            WriteOptions write_options;
+            write_options.sync = config::sync_tablet_meta;
+            s = _db->Write(write_options, &batch);
+        }
+    }
+    DorisMetrics::instance()->meta_write_request_duration_us->increment(duration_ns / 1000);
+    if (!s.ok()) {
+        LOG(WARNING) << "rocks db put " << entries.size() << " keys failed, first key:"
+                     << entries[0].first << ", reason:" << s.ToString();
+        return Status::OLAPInternalError(OLAP_ERR_META_PUT);
+    }
+    return Status::OK();
+}
+
 Status OlapMeta::remove(const int column_family_index, const std::string& key) {
     DorisMetrics::instance()->meta_write_request_total->increment(1);
     rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
@@ -155,6 +235,38 @@ Status OlapMeta::remove(const int column_family_index, const std::string& key) {
     return Status::OK();
 }
 
+Status OlapMeta::remove(const int column_family_index, const std::vector<std::string>& keys) {
+    if (keys.empty()) {
+        return Status::OK();
+    }
+    DorisMetrics::instance()->meta_write_request_total->increment(1);
+    rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
+    rocksdb::Status s;
+    int64_t duration_ns = 0;
+    {
+        SCOPED_RAW_TIMER(&duration_ns);
+        rocksdb::WriteBatch batch;
+        for (const auto& key : keys) {
+            s = batch.Delete(handle, rocksdb::Slice(key));
+            if (!s.ok()) {
+                break;
+            }
+        }
+        if (s.ok()) {
+            WriteOptions write_options;
+            write_options.sync = config::sync_tablet_meta;
+            s = _db->Write(write_options, &batch);
+        }
+    }
+    DorisMetrics::instance()->meta_write_request_duration_us->increment(duration_ns / 1000);
+    if (!s.ok()) {
+        LOG(WARNING) << "rocks db delete " << keys.size() << " keys failed, first key:" << keys[0]
+                     << ", reason:" << s.ToString();
+        return Status::OLAPInternalError(OLAP_ERR_META_DELETE);
+    }
+    return Status::OK();
+}
+
 Status OlapMeta::iterate(const int column_family_index, const std::string& prefix,
                          std::function<bool(const std::string&, const std::string&)> const& func) {
     rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
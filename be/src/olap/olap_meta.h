@@ -20,6 +20,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "olap/olap_define.h"
 #include "rocksdb/db.h"
@@ -36,12 +37,24 @@ public:
 
     Status get(const int column_family_index, const std::string& key, std::string* value);
 
+    // Gets the values of the keys in one batch. The status of each key is
+    // OLAP_ERR_META_KEY_NOT_FOUND if the key does not exist.
+    void multi_get(const int column_family_index, const std::vector<std::string>& keys,
+                   std::vector<std::string>* values, std::vector<Status>* statuses);
+
     bool key_may_exist(const int column_family_index, const std::string& key, std::string* value);
 
     Status put(const int column_family_index, const std::string& key, const std::string& value);
 
+    // Puts the key-value pairs in one write batch, so that they are written and synced at once.
+    Status put(const int column_family_index,
+               const std::vector<std::pair<std::string, std::string>>& entries);
+
     Status remove(const int column_family_index, const std::string& key);
 
+    // Removes the keys in one write batch.
+    Status remove(const int column_family_index, const std::vector<std::string>& keys);
+
     Status iterate(const int column_family_index, const std::string& prefix,
                    std::function<bool(const std::string&, const std::string&)> const& func);
 
@@ -29,6 +29,7 @@
 #include "common/status.h"
 #include "gutil/strings/substitute.h"
 #include "olap/cumulative_compaction.h"
+#include "olap/index_builder.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/storage_engine.h"
@@ -125,18 +126,48 @@ Status StorageEngine::start_bg_threads() {
         LOG(INFO) << "path scan/gc threads started. number:" << get_stores().size();
     }
 
+    ThreadPoolBuilder("VerticalCompactionTaskThreadPool")
+            .set_min_threads(config::vertical_compaction_thread_num)
+            .set_max_threads(config::vertical_compaction_thread_num)
+            .build(&_vertical_compaction_thread_pool);
+    LOG(INFO) << "vertical compaction thread pool started";
+
+    ThreadPoolBuilder("SchemaChangeTaskThreadPool")
+            .set_min_threads(config::schema_change_thread_num)
+            .set_max_threads(config::schema_change_thread_num)
+            .build(&_schema_change_thread_pool);
+    LOG(INFO) << "schema change thread pool started";
+
     ThreadPoolBuilder("CooldownTaskThreadPool")
             .set_min_threads(config::cooldown_thread_num)
             .set_max_threads(config::cooldown_thread_num)
             .build(&_cooldown_thread_pool);
     LOG(INFO) << "cooldown thread pool started";
 
+    ThreadPoolBuilder("TabletPublishTxnThreadPool")
+            .set_min_threads(config::tablet_publish_txn_max_thread)
+            .set_max_threads(config::tablet_publish_txn_max_thread)
+            .build(&_tablet_publish_txn_thread_pool);
+    LOG(INFO) << "tablet publish txn thread pool started";
+
     RETURN_IF_ERROR(Thread::create(
             "StorageEngine", "cooldown_tasks_producer_thread",
             [this]() { this->_cooldown_tasks_producer_callback(); },
             &_cooldown_tasks_producer_thread));
     LOG(INFO) << "cooldown tasks producer thread started";
 
+    ThreadPoolBuilder("IndexBuildTaskThreadPool")
+            .set_min_threads(config::index_build_thread_num)
+            .set_max_threads(config::index_build_thread_num)
+            .build(&_index_build_thread_pool);
+    LOG(INFO) << "index build thread pool started";
+
+    RETURN_IF_ERROR(Thread::create(
+            "StorageEngine", "index_build_tasks_producer_thread",
+            [this]() { this->_index_build_tasks_producer_callback(); },
+            &_index_build_tasks_producer_thread));
+    LOG(INFO) << "index build tasks producer thread started";
+
     LOG(INFO) << "all storage engine's background threads are started.";
     return Status::OK();
 }
@@ -725,4 +756,47 @@ void StorageEngine::_cooldown_tasks_producer_callback() {
     } while (!_stop_background_threads_latch.wait_for(std::chrono::seconds(interval)));
 }
 
+void StorageEngine::_index_build_tasks_producer_callback() {
+    do {
+        if (_index_build_thread_pool->get_queue_size() > 0) {
+            continue;
+        }
+        std::vector<TabletSharedPtr> tablets;
+        _tablet_manager->get_tablets_to_build_indexes(&tablets);
+        if (!tablets.empty()) {
+            LOG(INFO) << "index build producer get tablet num: " << tablets.size();
+        }
+        for (const auto& tablet : tablets) {
+            Status st = _index_build_thread_pool->submit_func([=]() {
+                {
+                    std::lock_guard<std::mutex> lock(_running_index_build_mutex);
+                    if (!_running_index_build_tablets.insert(tablet->tablet_id()).second) {
+                        return;
+                    }
+                }
+                // the index builds share the permits of compactions, as both read a lot
+                IndexBuilder builder(tablet);
+                int64_t permits = 0;
+                Status st = builder.prepare(&permits);
+                if (st.ok() && permits > 0 && _permit_limiter.request(permits)) {
+                    st = builder.build();
+                    _permit_limiter.release(permits);
+                }
+                if (!st.ok()) {
+                    LOG(WARNING) << "failed to build index files, tablet: " << tablet->tablet_id()
+                                 << " err: " << st.to_string();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(_running_index_build_mutex);
+                    _running_index_build_tablets.erase(tablet->tablet_id());
+                }
+            });
+            if (!st.ok()) {
+                LOG(INFO) << "failed to submit index build task, err msg: " << st.get_error_msg();
+            }
+        }
+    } while (!_stop_background_threads_latch.wait_for(
+            std::chrono::seconds(config::generate_index_build_task_interval_sec)));
+}
+
 } // namespace doris
@@ -18,21 +18,33 @@
 #include "olap/page_cache.h"
 
 #include "runtime/thread_context.h"
+#include "util/doris_metrics.h"
+#include "util/time.h"
 
 namespace doris {
 
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
 void StoragePageCache::create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                           uint32_t num_shards) {
+                                           uint32_t num_shards,
+                                           int32_t compressed_cache_percentage) {
     DCHECK(_s_instance == nullptr);
-    static StoragePageCache instance(capacity, index_cache_percentage, num_shards);
+    static StoragePageCache instance(capacity, index_cache_percentage, num_shards,
+                                     compressed_cache_percentage);
     _s_instance = &instance;
 }
 
 StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percentage,
-                                   uint32_t num_shards)
+                                   uint32_t num_shards, int32_t compressed_cache_percentage)
         : _index_cache_percentage(index_cache_percentage) {
+    if (compressed_cache_percentage > 0 && compressed_cache_percentage < 100) {
+        size_t compressed_capacity = capacity * compressed_cache_percentage / 100;
+        _compressed_page_cache = std::unique_ptr<Cache>(new_lru_cache(
+                "CompressedPageCache", compressed_capacity, LRUCacheType::SIZE, num_shards));
+        capacity -= compressed_capacity;
+    } else if (compressed_cache_percentage != 0) {
+        CHECK(false) << "invalid compressed page cache percentage";
+    }
     if (index_cache_percentage == 0) {
         _data_page_cache = std::unique_ptr<Cache>(
                 new_lru_cache("DataPageCache", capacity, LRUCacheType::SIZE, num_shards));
@@ -53,8 +65,10 @@ StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percenta
 
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle,
                               segment_v2::PageTypePB page_type) {
+    int64_t start_ns = MonotonicNanos();
     auto cache = _get_page_cache(page_type);
     auto lru_handle = cache->lookup(key.encode());
+    DorisMetrics::instance()->page_cache_lookup_latency_ns->add(MonotonicNanos() - start_ns);
     if (lru_handle == nullptr) {
         return false;
     }
@@ -63,17 +77,49 @@ bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle,
 }
 
 void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle,
-                              segment_v2::PageTypePB page_type, bool in_memory) {
+                              segment_v2::PageTypePB page_type, bool in_memory, bool bulk_scan) {
+    _insert(_get_page_cache(page_type), key, data, handle, in_memory, bulk_scan);
+}
+
+bool StoragePageCache::lookup_compressed(const CacheKey& key, PageCacheHandle* handle) {
+    auto lru_handle = _compressed_page_cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = PageCacheHandle(_compressed_page_cache.get(), lru_handle);
+    return true;
+}
+
+void StoragePageCache::insert_compressed(const CacheKey& key, const Slice& data,
+                                         PageCacheHandle* handle, bool in_memory,
+                                         bool bulk_scan) {
+    _insert(_compressed_page_cache.get(), key, data, handle, in_memory, bulk_scan);
+}
+
+void StoragePageCache::_insert(Cache* cache, const CacheKey& key, const Slice& data,
+                               PageCacheHandle* handle, bool in_memory, bool bulk_scan) {
     auto deleter = [](const doris::CacheKey& key, void* value) { delete[](uint8_t*) value; };
 
     CachePriority priority = CachePriority::NORMAL;
     if (in_memory) {
         priority = CachePriority::DURABLE;
+    } else if (bulk_scan) {
+        priority = CachePriority::PROBATION;
     }
 
-    auto cache = _get_page_cache(page_type);
     auto lru_handle = cache->insert(key.encode(), data.data, data.size, deleter, priority);
     *handle = PageCacheHandle(cache, lru_handle);
 }
 
+int64_t StoragePageCache::prune() {
+    int64_t prune_num = 0;
+    for (auto* cache : {_data_page_cache.get(), _index_page_cache.get(),
+                        _compressed_page_cache.get()}) {
+        if (cache != nullptr) {
+            prune_num += cache->prune();
+        }
+    }
+    return prune_num;
+}
+
 } // namespace doris
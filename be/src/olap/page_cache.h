@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -25,6 +26,7 @@
 #include "gutil/macros.h"          // for DISALLOW_COPY_AND_ASSIGN
 #include "olap/lru_cache.h"
 #include "runtime/memory/mem_tracker.h"
+#include "util/murmur_hash3.h"
 
 namespace doris {
 
@@ -39,32 +41,35 @@ public:
     // Each cached page corresponds to a specific offset within
     // a file.
     //
-    // TODO(zc): Now we use file name(std::string) as a part of
-    // key, which is not efficient. We should make it better later
+    // The file is identified by the 128 bits hash of its name, so the key is a fixed 24 bytes
+    // binary built without any allocation.
     struct CacheKey {
-        CacheKey(std::string fname_, int64_t offset_) : fname(std::move(fname_)), offset(offset_) {}
-        std::string fname;
-        int64_t offset;
-
-        // Encode to a flat binary which can be used as LRUCache's key
-        std::string encode() const {
-            std::string key_buf(fname);
-            key_buf.append((char*)&offset, sizeof(offset));
-            return key_buf;
+        CacheKey(const std::string& fname, int64_t offset) {
+            murmur_hash3_x64_128(fname.data(), fname.size(), 0, _buf);
+            memcpy(_buf + FILE_ID_SIZE, &offset, sizeof(offset));
         }
+
+        // Return a flat binary which can be used as LRUCache's key, it refers to this key.
+        doris::CacheKey encode() const { return doris::CacheKey(_buf, sizeof(_buf)); }
+
+    private:
+        static constexpr size_t FILE_ID_SIZE = 16;
+        char _buf[FILE_ID_SIZE + sizeof(int64_t)];
     };
 
     static constexpr uint32_t kDefaultNumShards = 16;
 
     // Create global instance of this class
     static void create_global_cache(size_t capacity, int32_t index_cache_percentage,
-                                    uint32_t num_shards = kDefaultNumShards);
+                                    uint32_t num_shards = kDefaultNumShards,
+                                    int32_t compressed_cache_percentage = 0);
 
     // Return global instance.
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards);
+    StoragePageCache(size_t capacity, int32_t index_cache_percentage, uint32_t num_shards,
+                     int32_t compressed_cache_percentage = 0);
 
     // Lookup the given page in the cache.
     //
@@ -81,9 +86,9 @@ public:
     // Given handle will be set to valid reference.
     // This function is thread-safe, and when two clients insert two same key
     // concurrently, this function can assure that only one page is cached.
-    // The in_memory page will have higher priority.
+    // The in_memory page will have higher priority, and the pages of bulk scans lower priority.
     void insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle,
-                segment_v2::PageTypePB page_type, bool in_memory = false);
+                segment_v2::PageTypePB page_type, bool in_memory = false, bool bulk_scan = false);
 
     // Page cache available check.
     // When percentage is set to 0 or 100, the index or data cache will not be allocated.
@@ -91,6 +96,18 @@ public:
         return _get_page_cache(page_type) != nullptr;
     }
 
+    // Like lookup() and insert(), but for the compressed data pages, which are cached as they
+    // are stored in the file, checksum included.
+    bool lookup_compressed(const CacheKey& key, PageCacheHandle* handle);
+    void insert_compressed(const CacheKey& key, const Slice& data, PageCacheHandle* handle,
+                           bool in_memory = false, bool bulk_scan = false);
+
+    // Whether the compressed data pages are cached, compressed_cache_percentage is not 0.
+    bool is_compressed_cache_available() { return _compressed_page_cache != nullptr; }
+
+    // Drop all the pages that are not in use, returns the number of dropped pages.
+    int64_t prune();
+
 private:
     StoragePageCache();
     static StoragePageCache* _s_instance;
@@ -98,6 +115,10 @@ private:
     int32_t _index_cache_percentage = 0;
     std::unique_ptr<Cache> _data_page_cache = nullptr;
     std::unique_ptr<Cache> _index_page_cache = nullptr;
+    std::unique_ptr<Cache> _compressed_page_cache = nullptr;
+
+    void _insert(Cache* cache, const CacheKey& key, const Slice& data, PageCacheHandle* handle,
+                 bool in_memory, bool bulk_scan);
 
     Cache* _get_page_cache(segment_v2::PageTypePB page_type) {
         switch (page_type) {
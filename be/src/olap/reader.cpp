@@ -221,6 +221,10 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params,
     _reader_context.stats = &_stats;
     _reader_context.runtime_state = read_params.runtime_state;
     _reader_context.use_page_cache = read_params.use_page_cache;
+    _reader_context.bulk_scan = read_params.bulk_scan;
+    _reader_context.topn_boundary = read_params.topn_boundary;
+    _reader_context.push_down_agg_type_opt = read_params.push_down_agg_type_opt;
+    _reader_context.read_limit = read_params.read_limit;
     _reader_context.sequence_id_idx = _sequence_col_idx;
     _reader_context.batch_size = _batch_size;
     _reader_context.is_unique = tablet()->keys_type() == UNIQUE_KEYS;
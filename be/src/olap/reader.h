@@ -38,6 +38,7 @@ class RowCursor;
 class RowBlock;
 class CollectIterator;
 class RuntimeState;
+class TopNBoundary;
 
 namespace vectorized {
 class VCollectIterator;
@@ -70,6 +71,14 @@ public:
         // 2. when read column index page
         //     if config::disable_storage_page_cache is false, we use page cache
         bool use_page_cache = false;
+        // whether the read is a bulk scan, whose pages are cached at probation priority
+        bool bulk_scan = false;
+        // the boundary of the TopN above the scan, whose column the scan can skip pages by
+        const TopNBoundary* topn_boundary = nullptr;
+        // the aggregate the segments answer from their metadata, see StorageReadOptions
+        TPushAggOp::type push_down_agg_type_opt = TPushAggOp::NONE;
+        // the number of rows each segment returns at most, -1 if not limited
+        int64_t read_limit = -1;
         Version version = Version(-1, 0);
 
         std::vector<OlapTuple> start_key;
@@ -53,6 +53,17 @@ std::string BetaRowset::remote_segment_path(int64_t tablet_id, const RowsetId& r
                        segment_id);
 }
 
+std::string BetaRowset::segment_index_file_path(int segment_id) {
+    DCHECK(is_local());
+    return local_segment_index_path(_tablet_path, rowset_id(), segment_id);
+}
+
+std::string BetaRowset::local_segment_index_path(const std::string& tablet_path,
+                                                 const RowsetId& rowset_id, int segment_id) {
+    // {root_path}/data/{shard_id}/{tablet_id}/{schema_hash}/{rowset_id}_{seg_num}.idx
+    return fmt::format("{}/{}_{}.idx", tablet_path, rowset_id.to_string(), segment_id);
+}
+
 BetaRowset::BetaRowset(const TabletSchema* schema, const std::string& tablet_path,
                        RowsetMetaSharedPtr rowset_meta)
         : Rowset(schema, tablet_path, std::move(rowset_meta)) {}
@@ -74,10 +85,13 @@ Status BetaRowset::load_segments(std::vector<segment_v2::SegmentSharedPtr>* segm
     if (!fs || _schema == nullptr) {
         return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
     }
+    bool has_index_files = is_local() && _rowset_meta->has_index_files();
     for (int seg_id = 0; seg_id < num_segments(); ++seg_id) {
         auto seg_path = segment_file_path(seg_id);
         std::shared_ptr<segment_v2::Segment> segment;
-        auto s = segment_v2::Segment::open(fs, seg_path, seg_id, _schema, &segment);
+        auto s = segment_v2::Segment::open(
+                fs, seg_path, seg_id, _schema, &segment,
+                has_index_files ? segment_index_file_path(seg_id) : std::string());
         if (!s.ok()) {
             LOG(WARNING) << "failed to open segment. " << seg_path << " under rowset "
                          << unique_id() << " : " << s.to_string();
@@ -121,6 +135,19 @@ Status BetaRowset::remove() {
             LOG(WARNING) << st.to_string();
             success = false;
         }
+        if (is_local() && _rowset_meta->has_index_files()) {
+            auto index_path = segment_index_file_path(i);
+            bool exists = false;
+            st = fs->exists(index_path, &exists);
+            if (st.ok() && exists) {
+                LOG(INFO) << "deleting " << index_path;
+                st = fs->delete_file(index_path);
+            }
+            if (!st.ok()) {
+                LOG(WARNING) << st.to_string();
+                success = false;
+            }
+        }
     }
     if (!success) {
         LOG(WARNING) << "failed to remove files in rowset " << unique_id();
@@ -133,14 +160,15 @@ void BetaRowset::do_close() {
     // do nothing.
 }
 
-Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id) {
+Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id,
+                                 size_t new_segment_start_id) {
     DCHECK(is_local());
     auto fs = _rowset_meta->fs();
     if (!fs) {
         return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
     }
     for (int i = 0; i < num_segments(); ++i) {
-        auto dst_path = local_segment_path(dir, new_rowset_id, i);
+        auto dst_path = local_segment_path(dir, new_rowset_id, i + new_segment_start_id);
         // TODO(lingbin): use Env API? or EnvUtil?
         if (FileUtils::check_exist(dst_path)) {
             LOG(WARNING) << "failed to create hard link, file already exist: " << dst_path;
@@ -154,6 +182,17 @@ Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id)
                          << "to=" << dst_path << ", errno=" << Errno::no();
             return Status::OLAPInternalError(OLAP_ERR_OS_ERROR);
         }
+        if (_rowset_meta->has_index_files()) {
+            auto src_index_path = segment_index_file_path(i);
+            auto dst_index_path =
+                    local_segment_index_path(dir, new_rowset_id, i + new_segment_start_id);
+            if (FileUtils::check_exist(src_index_path) &&
+                !fs->link_file(src_index_path, dst_index_path).ok()) {
+                LOG(WARNING) << "fail to create hard link. from=" << src_index_path << ", "
+                             << "to=" << dst_index_path << ", errno=" << Errno::no();
+                return Status::OLAPInternalError(OLAP_ERR_OS_ERROR);
+            }
+        }
     }
     return Status::OK();
 }
@@ -177,6 +216,16 @@ Status BetaRowset::copy_files_to(const std::string& dir, const RowsetId& new_row
                          << ", errno=" << Errno::no();
             return Status::OLAPInternalError(OLAP_ERR_OS_ERROR);
         }
+        if (_rowset_meta->has_index_files()) {
+            auto src_index_path = segment_index_file_path(i);
+            auto dst_index_path = local_segment_index_path(dir, new_rowset_id, i);
+            if (Env::Default()->path_exists(src_index_path).ok() &&
+                !Env::Default()->copy_path(src_index_path, dst_index_path).ok()) {
+                LOG(WARNING) << "fail to copy file. from=" << src_index_path
+                             << ", to=" << dst_index_path << ", errno=" << Errno::no();
+                return Status::OLAPInternalError(OLAP_ERR_OS_ERROR);
+            }
+        }
     }
     return Status::OK();
 }
@@ -211,6 +260,9 @@ bool BetaRowset::check_path(const std::string& path) {
         if (seg_path == path) {
             return true;
         }
+        if (is_local() && _rowset_meta->has_index_files() && segment_index_file_path(i) == path) {
+            return true;
+        }
     }
     return false;
 }
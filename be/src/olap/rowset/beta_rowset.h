@@ -49,13 +49,21 @@ public:
     static std::string remote_segment_path(int64_t tablet_id, const RowsetId& rowset_id,
                                            int segment_id);
 
+    // the index file of a segment of a local rowset, holding the indexes built after the segment
+    // was written, see SegmentIndexFile
+    std::string segment_index_file_path(int segment_id);
+
+    static std::string local_segment_index_path(const std::string& tablet_path,
+                                                const RowsetId& rowset_id, int segment_id);
+
     Status split_range(const RowCursor& start_key, const RowCursor& end_key,
                        uint64_t request_block_row_count, size_t key_num,
                        std::vector<OlapTuple>* ranges) override;
 
     Status remove() override;
 
-    Status link_files_to(const std::string& dir, RowsetId new_rowset_id) override;
+    Status link_files_to(const std::string& dir, RowsetId new_rowset_id,
+                         size_t new_segment_start_id = 0) override;
 
     Status copy_files_to(const std::string& dir, const RowsetId& new_rowset_id) override;
 
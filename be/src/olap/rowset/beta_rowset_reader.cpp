@@ -17,6 +17,7 @@
 
 #include "beta_rowset_reader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "olap/delete_handler.h"
@@ -65,6 +66,14 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
         read_context->delete_handler->get_delete_conditions_after_version(
                 _rowset->end_version(), &read_options.delete_conditions,
                 read_options.delete_condition_predicates.get());
+        if (read_context->reader_type == ReaderType::READER_QUERY) {
+            for (const auto& del_cond : read_context->delete_handler->get_delete_conditions()) {
+                if (del_cond.filter_version > _rowset->end_version()) {
+                    read_options.delete_condition_version = std::max(
+                            read_options.delete_condition_version, del_cond.filter_version);
+                }
+            }
+        }
     }
     if (read_context->predicates != nullptr) {
         read_options.column_predicates.insert(read_options.column_predicates.end(),
@@ -83,7 +92,12 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
         }
     }
     read_options.use_page_cache = read_context->use_page_cache;
+    read_options.bulk_scan = read_context->bulk_scan;
     read_options.tablet_schema = read_context->tablet_schema;
+    read_options.segment_row_ranges = _segment_row_ranges.get();
+    read_options.topn_boundary = read_context->topn_boundary;
+    read_options.push_down_agg_type_opt = read_context->push_down_agg_type_opt;
+    read_options.read_limit = read_context->read_limit;
 
     // load segments
     RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
@@ -93,6 +107,9 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
     // create iterator for each segment
     std::vector<std::unique_ptr<RowwiseIterator>> seg_iterators;
     for (auto& seg_ptr : _segment_cache_handle.get_segments()) {
+        if (_segment_row_ranges != nullptr && _segment_row_ranges->count(seg_ptr->id()) == 0) {
+            continue;
+        }
         std::unique_ptr<RowwiseIterator> iter;
         auto s = seg_ptr->new_iterator(*_schema, read_options, &iter);
         if (!s.ok()) {
@@ -115,7 +132,7 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
             _rowset->rowset_meta()->is_segments_overlapping()) {
             final_iterator = vectorized::new_merge_iterator(
                     iterators, read_context->sequence_id_idx, read_context->is_unique,
-                    read_context->merged_rows);
+                    read_context->merged_rows, read_context->tablet_schema);
         } else {
             final_iterator = vectorized::new_union_iterator(iterators);
         }
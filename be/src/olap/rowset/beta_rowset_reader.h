@@ -35,6 +35,10 @@ public:
 
     Status init(RowsetReaderContext* read_context) override;
 
+    void set_segment_row_ranges(SegmentRowRanges ranges) override {
+        _segment_row_ranges = std::make_unique<SegmentRowRanges>(std::move(ranges));
+    }
+
     // It's ok, because we only get ref here, the block's owner is this reader.
     Status next_block(RowBlock** block) override;
     Status next_block(vectorized::Block* block) override;
@@ -75,6 +79,9 @@ private:
     // make sure this handle is initialized and valid before
     // reading data.
     SegmentCacheHandle _segment_cache_handle;
+
+    // the rows to read, all rows of all segments are read if not set
+    std::unique_ptr<SegmentRowRanges> _segment_row_ranges;
 };
 
 } // namespace doris
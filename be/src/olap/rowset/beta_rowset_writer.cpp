@@ -24,15 +24,20 @@
 #include "env/env.h"
 #include "gutil/strings/substitute.h"
 #include "io/fs/file_writer.h"
+#include "io/fs/metered_file_writer.h"
+#include "olap/compaction_io_scheduler.h"
 #include "olap/memtable.h"
 #include "olap/olap_define.h"
 #include "olap/row.h"        // ContiguousRow
 #include "olap/row_cursor.h" // RowCursor
 #include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/segment_v2/segment_index_file.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/memtable_flush_executor.h"
 #include "olap/storage_engine.h"
 #include "runtime/exec_env.h"
+#include "util/file_utils.h"
 
 namespace doris {
 
@@ -48,6 +53,8 @@ BetaRowsetWriter::~BetaRowsetWriter() {
     // TODO(lingbin): Should wrapper exception logic, no need to know file ops directly.
     if (!_already_built) {       // abnormal exit, remove all files generated
         _segment_writer.reset(); // ensure all files are closed
+        _column_groups.clear();
+        _vertical_segment_writers.clear();
         auto fs = _rowset_meta->fs();
         if (!fs) {
             return;
@@ -66,6 +73,11 @@ BetaRowsetWriter::~BetaRowsetWriter() {
 
 Status BetaRowsetWriter::init(const RowsetWriterContext& rowset_writer_context) {
     _context = rowset_writer_context;
+    _max_segment_size = segment_v2::target_segment_size();
+    if (config::segment_max_rows > 0) {
+        _context.max_rows_per_segment =
+                std::min<int64_t>(_context.max_rows_per_segment, config::segment_max_rows);
+    }
     _rowset_meta.reset(new RowsetMeta);
     if (_context.data_dir) {
         _rowset_meta->set_fs(_context.data_dir->fs());
@@ -104,10 +116,16 @@ Status BetaRowsetWriter::add_block(const vectorized::Block* block) {
 
 Status BetaRowsetWriter::_add_block(const vectorized::Block* block,
                                     std::unique_ptr<segment_v2::SegmentWriter>* segment_writer) {
+    return _add_block(block, segment_writer, 0, block->rows());
+}
+
+Status BetaRowsetWriter::_add_block(const vectorized::Block* block,
+                                    std::unique_ptr<segment_v2::SegmentWriter>* segment_writer,
+                                    size_t row_begin, size_t num_rows) {
     size_t block_size_in_bytes = block->bytes();
-    size_t block_row_num = block->rows();
-    size_t row_avg_size_in_bytes = std::max((size_t)1, block_size_in_bytes / block_row_num);
-    size_t row_offset = 0;
+    size_t row_avg_size_in_bytes = std::max((size_t)1, block_size_in_bytes / block->rows());
+    size_t block_row_num = row_begin + num_rows;
+    size_t row_offset = row_begin;
 
     do {
         auto max_row_add = (*segment_writer)->max_row_to_add(row_avg_size_in_bytes);
@@ -128,7 +146,7 @@ Status BetaRowsetWriter::_add_block(const vectorized::Block* block,
         row_offset += input_row_num;
     } while (row_offset < block_row_num);
 
-    _num_rows_written += block_row_num;
+    _num_rows_written += num_rows;
     return Status::OK();
 }
 
@@ -143,7 +161,7 @@ Status BetaRowsetWriter::_add_row(const RowType& row) {
         LOG(WARNING) << "failed to append row: " << s.to_string();
         return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
     }
-    if (PREDICT_FALSE(_segment_writer->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
+    if (PREDICT_FALSE(_segment_writer->estimate_segment_size() >= _max_segment_size ||
                       _segment_writer->num_rows_written() >= _context.max_rows_per_segment)) {
         RETURN_NOT_OK(_flush_segment_writer(&_segment_writer));
     }
@@ -156,7 +174,16 @@ template Status BetaRowsetWriter::_add_row(const ContiguousRow& row);
 
 Status BetaRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
     assert(rowset->rowset_meta()->rowset_type() == BETA_ROWSET);
-    RETURN_NOT_OK(rowset->link_files_to(_context.tablet_path, _context.rowset_id));
+    RETURN_NOT_OK(
+            rowset->link_files_to(_context.tablet_path, _context.rowset_id, _num_segment));
+    std::vector<KeyBoundsPB> segments_key_bounds;
+    RETURN_NOT_OK(rowset->get_segments_key_bounds(&segments_key_bounds));
+    if (segments_key_bounds.size() == rowset->num_segments()) {
+        std::lock_guard<SpinLock> l(_lock);
+        for (size_t i = 0; i < segments_key_bounds.size(); ++i) {
+            _segments_key_bounds[_num_segment + i] = segments_key_bounds[i];
+        }
+    }
     _num_rows_written += rowset->num_rows();
     _total_data_size += rowset->rowset_meta()->data_disk_size();
     _total_index_size += rowset->rowset_meta()->index_disk_size();
@@ -171,13 +198,123 @@ Status BetaRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
 Status BetaRowsetWriter::add_rowset_for_linked_schema_change(RowsetSharedPtr rowset,
                                                              const SchemaMapping& schema_mapping) {
     // TODO use schema_mapping to transfer zonemap
-    return add_rowset(rowset);
+    size_t segment_start_id = _num_segment;
+    RETURN_NOT_OK(add_rowset(rowset));
+    bool lacks_indexes = segment_v2::SegmentIndexFile::lacks_indexes(*rowset->tablet_schema(),
+                                                                     *_context.tablet_schema);
+    if (!lacks_indexes && !rowset->rowset_meta()->has_index_files()) {
+        return Status::OK();
+    }
+    // the indexes the segments lack are built into index files by IndexBuilder
+    _rowset_meta->set_has_index_files(true);
+    _rowset_meta->set_index_files_built(!lacks_indexes &&
+                                        rowset->rowset_meta()->index_files_built());
+    if (lacks_indexes) {
+        // the linked index files lack the new indexes, they are built again with them
+        for (int i = 0; i < rowset->num_segments(); ++i) {
+            auto index_path = BetaRowset::local_segment_index_path(
+                    _context.tablet_path, _context.rowset_id, segment_start_id + i);
+            if (FileUtils::check_exist(index_path)) {
+                RETURN_NOT_OK(FileUtils::remove(index_path));
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status BetaRowsetWriter::init_column_groups(
+        const std::vector<std::vector<uint32_t>>& column_groups, uint32_t max_rows_per_segment) {
+    DCHECK(!column_groups.empty());
+    _column_groups.clear();
+    _column_groups.resize(column_groups.size());
+    for (size_t i = 0; i < column_groups.size(); ++i) {
+        _column_groups[i].column_ids = column_groups[i];
+    }
+    _vertical_max_rows_per_segment =
+            std::max<uint32_t>(1, std::min(max_rows_per_segment, _context.max_rows_per_segment));
+    return Status::OK();
+}
+
+Status BetaRowsetWriter::add_columns(size_t group, const vectorized::Block* block) {
+    DCHECK_LT(group, _column_groups.size());
+    auto& state = _column_groups[group];
+    bool is_key = group == 0;
+    size_t num_rows = block->rows();
+    size_t row_offset = 0;
+    while (row_offset < num_rows) {
+        if (state.writer == nullptr) {
+            if (is_key) {
+                std::unique_ptr<segment_v2::SegmentWriter> segment_writer;
+                RETURN_NOT_OK(_create_segment_writer(&segment_writer, true));
+                _vertical_segment_writers.push_back(std::move(segment_writer));
+                state.segment = _vertical_segment_writers.size() - 1;
+            } else if (state.segment >= _vertical_segment_writers.size()) {
+                LOG(WARNING) << "column group " << group << " has more rows than the key group";
+                return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+            }
+            state.writer = std::make_unique<segment_v2::ColumnGroupWriter>();
+            RETURN_NOT_OK(_vertical_segment_writers[state.segment]->init_column_group(
+                    state.column_ids, is_key, state.writer.get()));
+        }
+        auto& segment_writer = _vertical_segment_writers[state.segment];
+        size_t segment_rows =
+                is_key ? _vertical_max_rows_per_segment : segment_writer->num_rows_written();
+        if (state.writer->num_rows >= segment_rows) {
+            RETURN_NOT_OK(segment_writer->finalize_column_group(state.writer.get()));
+            state.writer.reset();
+            ++state.segment;
+            continue;
+        }
+        size_t input_rows = std::min<size_t>(num_rows - row_offset,
+                                             segment_rows - state.writer->num_rows);
+        auto s = segment_writer->append_column_group(state.writer.get(), block, row_offset,
+                                                     input_rows);
+        if (UNLIKELY(!s.ok())) {
+            LOG(WARNING) << "failed to append column group: " << s.to_string();
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        row_offset += input_rows;
+    }
+    if (is_key) {
+        _num_rows_written += num_rows;
+    }
+    return Status::OK();
+}
+
+Status BetaRowsetWriter::flush_columns(size_t group) {
+    DCHECK_LT(group, _column_groups.size());
+    auto& state = _column_groups[group];
+    if (state.writer != nullptr) {
+        RETURN_NOT_OK(_vertical_segment_writers[state.segment]->finalize_column_group(
+                state.writer.get()));
+        state.writer.reset();
+        ++state.segment;
+    }
+    if (state.segment != _vertical_segment_writers.size()) {
+        LOG(WARNING) << "column group " << group << " has less rows than the key group";
+        return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+    }
+    return Status::OK();
 }
 
 Status BetaRowsetWriter::flush() {
     if (_segment_writer != nullptr) {
         RETURN_NOT_OK(_flush_segment_writer(&_segment_writer));
     }
+    for (auto& segment_writer : _vertical_segment_writers) {
+        uint64_t segment_size;
+        uint64_t index_size;
+        Status s = segment_writer->finalize_vertical(&segment_size, &index_size);
+        if (!s.ok()) {
+            LOG(WARNING) << "failed to finalize segment: " << s.to_string();
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        _total_data_size += segment_size;
+        _total_index_size += index_size;
+        _add_segment_key_bounds(*segment_writer);
+    }
+    _vertical_segment_writers.clear();
+    _column_groups.clear();
     return Status::OK();
 }
 
@@ -199,7 +336,7 @@ Status BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int64_t* flus
             return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
         }
 
-        if (PREDICT_FALSE(writer->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
+        if (PREDICT_FALSE(writer->estimate_segment_size() >= _max_segment_size ||
                           writer->num_rows_written() >= _context.max_rows_per_segment)) {
             RETURN_NOT_OK(_flush_segment_writer(&writer));
         }
@@ -215,12 +352,51 @@ Status BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int64_t* flus
 }
 
 Status BetaRowsetWriter::flush_single_memtable(const vectorized::Block* block) {
-    if (block->rows() == 0) {
+    size_t num_rows = block->rows();
+    if (num_rows == 0) {
         return Status::OK();
     }
+    ThreadPool* pool = nullptr;
+    if (StorageEngine::instance() != nullptr &&
+        StorageEngine::instance()->memtable_flush_executor() != nullptr) {
+        pool = StorageEngine::instance()->memtable_flush_executor()->segment_flush_pool();
+    }
+    size_t min_rows = std::max<int64_t>(1, config::memtable_flush_min_rows_per_parallel_segment);
+    size_t num_ranges = std::min<size_t>(std::max(1, config::memtable_flush_max_parallel_segments),
+                                         num_rows / min_rows);
+    if (pool == nullptr || num_ranges <= 1) {
+        return _flush_block_rows(block, 0, num_rows);
+    }
+
+    // The rows of a memtable are sorted, so each range of rows is a key range and is encoded
+    // into its own segment. The current thread writes the last range.
+    size_t rows_per_range = (num_rows + num_ranges - 1) / num_ranges;
+    num_ranges = (num_rows + rows_per_range - 1) / rows_per_range;
+    std::vector<Status> statuses(num_ranges);
+    auto token = pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    for (size_t i = 0; i + 1 < num_ranges; ++i) {
+        size_t row_begin = i * rows_per_range;
+        auto st = token->submit_func([this, block, row_begin, rows_per_range, &statuses, i]() {
+            statuses[i] = _flush_block_rows(block, row_begin, rows_per_range);
+        });
+        if (!st.ok()) {
+            statuses[i] = _flush_block_rows(block, row_begin, rows_per_range);
+        }
+    }
+    size_t last_begin = (num_ranges - 1) * rows_per_range;
+    statuses.back() = _flush_block_rows(block, last_begin, num_rows - last_begin);
+    token->wait();
+    for (auto& st : statuses) {
+        RETURN_NOT_OK(st);
+    }
+    return Status::OK();
+}
+
+Status BetaRowsetWriter::_flush_block_rows(const vectorized::Block* block, size_t row_begin,
+                                           size_t num_rows) {
     std::unique_ptr<segment_v2::SegmentWriter> writer;
     RETURN_NOT_OK(_create_segment_writer(&writer));
-    RETURN_NOT_OK(_add_block(block, &writer));
+    RETURN_NOT_OK(_add_block(block, &writer, row_begin, num_rows));
     RETURN_NOT_OK(_flush_segment_writer(&writer));
     return Status::OK();
 }
@@ -241,6 +417,13 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     _rowset_meta->set_empty(_num_rows_written == 0);
     _rowset_meta->set_creation_time(time(nullptr));
     _rowset_meta->set_num_segments(_num_segment);
+    if (_num_segment > 0 && _segments_key_bounds.size() == _num_segment) {
+        std::vector<KeyBoundsPB> segments_key_bounds;
+        for (auto& [segment_id, key_bounds] : _segments_key_bounds) {
+            segments_key_bounds.push_back(key_bounds);
+        }
+        _rowset_meta->set_segments_key_bounds(segments_key_bounds);
+    }
     if (_num_segment <= 1) {
         _rowset_meta->set_segments_overlap(NONOVERLAPPING);
     }
@@ -270,9 +453,10 @@ RowsetSharedPtr BetaRowsetWriter::build() {
 }
 
 Status BetaRowsetWriter::_create_segment_writer(
-        std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+        std::unique_ptr<segment_v2::SegmentWriter>* writer, bool is_vertical) {
+    uint32_t segment_id = _num_segment++;
     auto path = BetaRowset::local_segment_path(_context.tablet_path, _context.rowset_id,
-                                               _num_segment++);
+                                               segment_id);
     auto fs = _rowset_meta->fs();
     if (!fs) {
         return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
@@ -284,10 +468,19 @@ Status BetaRowsetWriter::_create_segment_writer(
                      << ", err: " << st.get_error_msg();
         return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
     }
+    if (_io_meter != nullptr) {
+        auto meter = _io_meter;
+        file_writer = std::make_unique<io::MeteredFileWriter>(
+                std::move(file_writer), [meter](size_t bytes) { meter->on_write(bytes); });
+    }
 
     DCHECK(file_writer != nullptr);
     segment_v2::SegmentWriterOptions writer_options;
-    writer->reset(new segment_v2::SegmentWriter(file_writer.get(), _num_segment,
+    writer_options.max_segment_size = _max_segment_size;
+    writer_options.enable_unique_key_merge_on_write = _context.enable_unique_key_merge_on_write;
+    writer_options.partial_update_missing_cids = _context.partial_update_missing_cids;
+    writer_options.tablet = _context.tablet;
+    writer->reset(new segment_v2::SegmentWriter(file_writer.get(), segment_id,
                                                 _context.tablet_schema, _context.data_dir,
                                                 _context.max_rows_per_segment, writer_options));
     {
@@ -295,7 +488,8 @@ Status BetaRowsetWriter::_create_segment_writer(
         _file_writers.push_back(std::move(file_writer));
     }
 
-    auto s = (*writer)->init(config::push_write_mbytes_per_sec);
+    auto s = is_vertical ? (*writer)->init_vertical()
+                         : (*writer)->init(config::push_write_mbytes_per_sec);
     if (!s.ok()) {
         LOG(WARNING) << "failed to init segment writer: " << s.to_string();
         writer->reset(nullptr);
@@ -317,8 +511,20 @@ Status BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::Segme
     }
     _total_data_size += segment_size;
     _total_index_size += index_size;
+    _add_segment_key_bounds(**writer);
     writer->reset();
     return Status::OK();
 }
 
+void BetaRowsetWriter::_add_segment_key_bounds(const segment_v2::SegmentWriter& writer) {
+    if (writer.num_rows_written() == 0 || writer.max_encoded_key().empty()) {
+        return;
+    }
+    KeyBoundsPB key_bounds;
+    key_bounds.set_min_key(writer.min_encoded_key());
+    key_bounds.set_max_key(writer.max_encoded_key());
+    std::lock_guard<SpinLock> l(_lock);
+    _segments_key_bounds[writer.segment_id()] = std::move(key_bounds);
+}
+
 } // namespace doris
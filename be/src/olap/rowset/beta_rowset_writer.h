@@ -22,6 +22,7 @@
 namespace doris {
 namespace segment_v2 {
 class SegmentWriter;
+struct ColumnGroupWriter;
 } // namespace segment_v2
 
 namespace io {
@@ -42,12 +43,21 @@ public:
 
     Status add_block(const vectorized::Block* block) override;
 
+    Status init_column_groups(const std::vector<std::vector<uint32_t>>& column_groups,
+                              uint32_t max_rows_per_segment) override;
+
+    Status add_columns(size_t group, const vectorized::Block* block) override;
+
+    Status flush_columns(size_t group) override;
+
     // add rowset by create hard link
     Status add_rowset(RowsetSharedPtr rowset) override;
 
     Status add_rowset_for_linked_schema_change(RowsetSharedPtr rowset,
                                                const SchemaMapping& schema_mapping) override;
 
+    void set_io_meter(CompactionIOMeter* meter) override { _io_meter = meter; }
+
     Status flush() override;
 
     // Return the file size flushed to disk in "flush_size"
@@ -70,11 +80,21 @@ private:
     Status _add_row(const RowType& row);
     Status _add_block(const vectorized::Block* block,
                       std::unique_ptr<segment_v2::SegmentWriter>* writer);
+    // add the rows [row_begin, row_begin + num_rows) of the block
+    Status _add_block(const vectorized::Block* block,
+                      std::unique_ptr<segment_v2::SegmentWriter>* writer, size_t row_begin,
+                      size_t num_rows);
+    // write the rows [row_begin, row_begin + num_rows) of the block into new segments
+    Status _flush_block_rows(const vectorized::Block* block, size_t row_begin, size_t num_rows);
 
-    Status _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
+    Status _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer,
+                                  bool is_vertical = false);
 
     Status _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
 
+    // record the key bounds of a finalized segment if it knows them
+    void _add_segment_key_bounds(const segment_v2::SegmentWriter& writer);
+
 private:
     RowsetWriterContext _context;
     std::shared_ptr<RowsetMeta> _rowset_meta;
@@ -92,6 +112,25 @@ private:
     std::atomic<int64_t> _total_data_size;
     std::atomic<int64_t> _total_index_size;
     // TODO rowset Zonemap
+    // segment id -> the encoded key bounds of the segment, protected by _lock. The bounds are
+    // saved to the rowset meta only if all segments have them.
+    std::map<uint32_t, KeyBoundsPB> _segments_key_bounds;
+
+    // used by vertical writing
+    struct ColumnGroupState {
+        std::vector<uint32_t> column_ids;
+        // the segment the group is being written to
+        size_t segment = 0;
+        std::unique_ptr<segment_v2::ColumnGroupWriter> writer;
+    };
+    std::vector<ColumnGroupState> _column_groups;
+    // written by the key group, which is done before the other groups start
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _vertical_segment_writers;
+    uint32_t _vertical_max_rows_per_segment = 0;
+    // the estimated size a segment is cut at
+    uint32_t _max_segment_size = 0;
+
+    CompactionIOMeter* _io_meter = nullptr;
 
     bool _is_pending = false;
     bool _already_built = false;
@@ -197,8 +197,10 @@ public:
                     << "-" << end_version() << ", tabletid:" << _rowset_meta->tablet_id();
     }
 
-    // hard link all files in this rowset to `dir` to form a new rowset with id `new_rowset_id`.
-    virtual Status link_files_to(const std::string& dir, RowsetId new_rowset_id) = 0;
+    // hard link all files in this rowset to `dir` to form a new rowset with id `new_rowset_id`,
+    // the segments of the new rowset are numbered from `new_segment_start_id`.
+    virtual Status link_files_to(const std::string& dir, RowsetId new_rowset_id,
+                                 size_t new_segment_start_id = 0) = 0;
 
     // copy all files to `dir`
     virtual Status copy_files_to(const std::string& dir, const RowsetId& new_rowset_id) = 0;
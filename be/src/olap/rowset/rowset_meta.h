@@ -213,6 +213,18 @@ public:
         *new_delete_condition = delete_predicate;
     }
 
+    bool has_index_files() const { return _rowset_meta_pb.has_index_files(); }
+
+    void set_has_index_files(bool has_index_files) {
+        _rowset_meta_pb.set_has_index_files(has_index_files);
+    }
+
+    bool index_files_built() const { return _rowset_meta_pb.index_files_built(); }
+
+    void set_index_files_built(bool index_files_built) {
+        _rowset_meta_pb.set_index_files_built(index_files_built);
+    }
+
     bool empty() const { return _rowset_meta_pb.empty(); }
 
     void set_empty(bool empty) { _rowset_meta_pb.set_empty(empty); }
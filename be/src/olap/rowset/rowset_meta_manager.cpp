@@ -94,6 +94,23 @@ Status RowsetMetaManager::save(OlapMeta* meta, TabletUid tablet_uid, const Rowse
     return status;
 }
 
+Status RowsetMetaManager::save(OlapMeta* meta,
+                               const std::vector<RowsetMetaSharedPtr>& rowset_metas) {
+    std::vector<std::pair<std::string, std::string>> entries;
+    entries.reserve(rowset_metas.size());
+    for (const auto& rowset_meta : rowset_metas) {
+        std::string key = ROWSET_PREFIX + rowset_meta->tablet_uid().to_string() + "_" +
+                          rowset_meta->rowset_id().to_string();
+        std::string value;
+        if (!rowset_meta->get_rowset_pb().SerializeToString(&value)) {
+            LOG(WARNING) << "serialize rowset pb failed. rowset id:" << key;
+            return Status::OLAPInternalError(OLAP_ERR_SERIALIZE_PROTOBUF_ERROR);
+        }
+        entries.emplace_back(std::move(key), std::move(value));
+    }
+    return meta->put(META_COLUMN_FAMILY_INDEX, entries);
+}
+
 Status RowsetMetaManager::remove(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id) {
     std::string key = ROWSET_PREFIX + tablet_uid.to_string() + "_" + rowset_id.to_string();
     VLOG_NOTICE << "start to remove rowset, key:" << key;
@@ -102,6 +119,18 @@ Status RowsetMetaManager::remove(OlapMeta* meta, TabletUid tablet_uid, const Row
     return status;
 }
 
+Status RowsetMetaManager::remove(OlapMeta* meta,
+                                 const std::vector<RowsetMetaSharedPtr>& rowset_metas) {
+    std::vector<std::string> keys;
+    keys.reserve(rowset_metas.size());
+    for (const auto& rowset_meta : rowset_metas) {
+        keys.push_back(ROWSET_PREFIX + rowset_meta->tablet_uid().to_string() + "_" +
+                       rowset_meta->rowset_id().to_string());
+    }
+    VLOG_NOTICE << "start to remove " << keys.size() << " rowsets";
+    return meta->remove(META_COLUMN_FAMILY_INDEX, keys);
+}
+
 Status RowsetMetaManager::traverse_rowset_metas(
         OlapMeta* meta,
         std::function<bool(const TabletUid&, const RowsetId&, const std::string&)> const& func) {
@@ -41,8 +41,14 @@ public:
     static Status save(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id,
                        const RowsetMetaPB& rowset_meta_pb);
 
+    // Saves the metas of the rowsets in one write to the meta.
+    static Status save(OlapMeta* meta, const std::vector<RowsetMetaSharedPtr>& rowset_metas);
+
     static Status remove(OlapMeta* meta, TabletUid tablet_uid, const RowsetId& rowset_id);
 
+    // Removes the metas of the rowsets in one write batch.
+    static Status remove(OlapMeta* meta, const std::vector<RowsetMetaSharedPtr>& rowset_metas);
+
     static Status traverse_rowset_metas(
             OlapMeta* meta,
             std::function<bool(const TabletUid&, const RowsetId&, const std::string&)> const& func);
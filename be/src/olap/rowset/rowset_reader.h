@@ -22,6 +22,7 @@
 #include <unordered_map>
 
 #include "gen_cpp/olap_file.pb.h"
+#include "olap/iterators.h"
 #include "olap/rowset/rowset.h"
 #include "olap/rowset/rowset_reader_context.h"
 #include "vec/core/block.h"
@@ -43,6 +44,10 @@ public:
     // reader init
     virtual Status init(RowsetReaderContext* read_context) = 0;
 
+    // Only read the rows of the segments in 'ranges', so that several readers may share the
+    // rowset. Must be called before init().
+    virtual void set_segment_row_ranges(SegmentRowRanges ranges) = 0;
+
     // read next block data into *block.
     // Returns
     //      OLAP_SUCCESS when read successfully.
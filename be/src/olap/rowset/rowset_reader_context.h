@@ -18,6 +18,7 @@
 #ifndef DORIS_BE_SRC_OLAP_ROWSET_ROWSET_READER_CONTEXT_H
 #define DORIS_BE_SRC_OLAP_ROWSET_ROWSET_READER_CONTEXT_H
 
+#include "gen_cpp/PlanNodes_types.h"
 #include "olap/column_predicate.h"
 #include "olap/olap_common.h"
 #include "runtime/runtime_state.h"
@@ -28,6 +29,7 @@ class RowCursor;
 class Conditions;
 class DeleteHandler;
 class TabletSchema;
+class TopNBoundary;
 
 struct RowsetReaderContext {
     ReaderType reader_type = READER_QUERY;
@@ -60,6 +62,12 @@ struct RowsetReaderContext {
     OlapReaderStatistics* stats = nullptr;
     RuntimeState* runtime_state = nullptr;
     bool use_page_cache = false;
+    bool bulk_scan = false;
+    // the boundary of the TopN above the scan, see StorageReadOptions
+    const TopNBoundary* topn_boundary = nullptr;
+    // see StorageReadOptions
+    TPushAggOp::type push_down_agg_type_opt = TPushAggOp::NONE;
+    int64_t read_limit = -1;
     int sequence_id_idx = -1;
     int batch_size = 1024;
     bool is_vec = false;
@@ -212,7 +212,7 @@ void RowsetTree::FindRowsetsWithKeyInRange(
 
 void RowsetTree::ForEachRowsetContainingKeys(
         const std::vector<Slice>& encoded_keys,
-        const std::function<void(RowsetSharedPtr, int)>& cb) const {
+        const std::function<void(RowsetSharedPtr, int32_t, int)>& cb) const {
     DCHECK(std::is_sorted(encoded_keys.cbegin(), encoded_keys.cend(), Slice::Comparator()));
     // The interval tree batch query callback would naturally just give us back
     // the matching Slices, but that won't allow us to easily tell the caller
@@ -225,7 +225,9 @@ void RowsetTree::ForEachRowsetContainingKeys(
     }
 
     tree_->ForEachIntervalContainingPoints(
-            queries, [&](const QueryStruct& qs, RowsetWithBounds* rs) { cb(rs->rowset, qs.idx); });
+            queries, [&](const QueryStruct& qs, RowsetWithBounds* rs) {
+                cb(rs->rowset, rs->segment_id, qs.idx);
+            });
 }
 
 RowsetTree::~RowsetTree() {
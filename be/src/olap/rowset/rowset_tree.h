@@ -79,15 +79,16 @@ public:
     void FindRowsetsWithKeyInRange(const Slice& encoded_key,
                                    vector<std::pair<RowsetSharedPtr, int32_t>>* rowsets) const;
 
-    // Call 'cb(rowset, index)' for each (rowset, index) pair such that
-    // 'encoded_keys[index]' may be within the bounds of 'rowset'.
+    // Call 'cb(rowset, segment_id, index)' for each (rowset, segment_id, index) tuple such
+    // that 'encoded_keys[index]' may be within the bounds of the segment of 'rowset'.
     //
     // See IntervalTree::ForEachIntervalContainingPoints for additional
     // information on the particular order in which the callback will be called.
     //
     // REQUIRES: 'encoded_keys' must be in sorted order.
     void ForEachRowsetContainingKeys(const std::vector<Slice>& encoded_keys,
-                                     const std::function<void(RowsetSharedPtr, int)>& cb) const;
+                                     const std::function<void(RowsetSharedPtr, int32_t, int)>& cb)
+            const;
 
     // When 'lower_bound' is boost::none, it means negative infinity.
     // When 'upper_bound' is boost::none, it means positive infinity.
@@ -28,6 +28,7 @@
 namespace doris {
 
 struct ContiguousRow;
+class CompactionIOMeter;
 class MemTable;
 
 class RowsetWriter {
@@ -46,6 +47,27 @@ public:
         return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
     }
 
+    // Vertical writing: the columns are added group by group instead of row by row.
+    // 'column_groups[0]' is the key group, it starts with the key columns and is added first:
+    // its rows are cut into segments of at most 'max_rows_per_segment' rows. Each other group
+    // is added with the same rows in the same order afterwards, and different groups may be
+    // added by different threads. A block added to a group has the columns of the group.
+    virtual Status init_column_groups(const std::vector<std::vector<uint32_t>>& column_groups,
+                                      uint32_t max_rows_per_segment) {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+    virtual Status add_columns(size_t group, const vectorized::Block* block) {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+    // called after all the rows of a group are added
+    virtual Status flush_columns(size_t group) {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+
+    // Meter the bytes written to the files of the rowset from now on, `meter` must outlive the
+    // writes.
+    virtual void set_io_meter(CompactionIOMeter* meter) {}
+
     // Precondition: the input `rowset` should have the same type of the rowset we're building
     virtual Status add_rowset(RowsetSharedPtr rowset) = 0;
 
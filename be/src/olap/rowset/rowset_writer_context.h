@@ -96,6 +96,13 @@ struct RowsetWriterContext {
 
     int64_t oldest_write_timestamp;
     int64_t newest_write_timestamp;
+    // whether the segments need a primary key index
+    bool enable_unique_key_merge_on_write = false;
+    // the columns of tablet_schema that a partial update doesn't carry, which are filled from
+    // the existing rows of the same keys in tablet, empty for a load of all the columns
+    std::vector<uint32_t> partial_update_missing_cids;
+    // not owned, the tablet written by a partial update
+    Tablet* tablet = nullptr;
 };
 
 } // namespace doris
@@ -0,0 +1,572 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "olap/rowset/segment_v2/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "olap/rowset/segment_v2/page_builder.h" // for PageBuilder
+#include "olap/rowset/segment_v2/page_decoder.h" // for PageDecoder
+#include "olap/types.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/rle_encoding.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// The adaptive page stores the numbers of a page in the smallest one of these forms, which is
+// chosen by the page builder when the page is finished:
+//  - FOR: the values themselves.
+//  - DELTA: the differences between the adjacent values, for the monotonic counters.
+//  - DELTA_OF_DELTA: the differences between the adjacent deltas, for the periodic timestamps.
+//  - XOR: the xor of the adjacent values, for the slowly changing floating numbers.
+//  - DICT_RLE: the run length encoded codes of a dictionary, for the low cardinality values.
+// The residuals of the first four forms are bit packed in blocks of 128. A block stores the
+// minimum residual, the number of trailing zero bits common to all the residuals minus the
+// minimum, and the bit width of the packed values.
+//
+// The layout of a page is:
+//   num_elements(4) | mode(1) | first value | first delta | blocks or dictionary | padding
+// The first value and the first delta both have the size of the type. The padding lets the
+// unpacking load 8 bytes from any packed position.
+enum AdaptivePageMode : uint8_t {
+    ADAPTIVE_FOR = 0,
+    ADAPTIVE_DELTA = 1,
+    ADAPTIVE_DELTA_OF_DELTA = 2,
+    ADAPTIVE_XOR = 3,
+    ADAPTIVE_DICT_RLE = 4,
+};
+
+static const size_t ADAPTIVE_PAGE_BLOCK_SIZE = 128;
+static const size_t ADAPTIVE_PAGE_PADDING = 16;
+// the dictionary is only tried for the pages with at most this number of distinct values
+static const size_t ADAPTIVE_PAGE_MAX_DICT_SIZE = 4096;
+
+template <size_t size>
+struct AdaptiveUnsigned {};
+template <>
+struct AdaptiveUnsigned<1> {
+    using type = uint8_t;
+};
+template <>
+struct AdaptiveUnsigned<2> {
+    using type = uint16_t;
+};
+template <>
+struct AdaptiveUnsigned<4> {
+    using type = uint32_t;
+};
+template <>
+struct AdaptiveUnsigned<8> {
+    using type = uint64_t;
+};
+
+// Bit packing of the residuals of the adaptive page, U is the unsigned type of the values.
+template <typename U>
+struct AdaptivePacking {
+    using S = std::make_signed_t<U>;
+    static const size_t BLOCK_HEADER_SIZE = sizeof(U) + 2;
+
+    static int bit_width(uint64_t v) { return v == 0 ? 0 : 64 - __builtin_clzll(v); }
+
+    // Returns the bytes of the blocks of the residuals, and appends them to `buf` if it is not
+    // null. The minimum of a block is taken as signed if `signed_base` is true, so that the small
+    // negative residuals are packed into a few bits.
+    static size_t pack(const U* residuals, size_t n, bool signed_base, faststring* buf) {
+        size_t bytes = 0;
+        for (size_t start = 0; start < n; start += ADAPTIVE_PAGE_BLOCK_SIZE) {
+            bytes += _pack_block(residuals + start, std::min(ADAPTIVE_PAGE_BLOCK_SIZE, n - start),
+                                 signed_base, buf);
+        }
+        return bytes;
+    }
+
+    // Unpacks `n` residuals from the blocks at `*data` into `out` and moves `*data` after them.
+    // Returns false if the blocks overrun `end`. The 8 bytes after `end` must be readable.
+    static bool unpack(const uint8_t** data, const uint8_t* end, size_t n, U* out) {
+        for (size_t start = 0; start < n; start += ADAPTIVE_PAGE_BLOCK_SIZE) {
+            if (!_unpack_block(data, end, std::min(ADAPTIVE_PAGE_BLOCK_SIZE, n - start),
+                               out + start)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static size_t _pack_block(const U* r, size_t n, bool signed_base, faststring* buf) {
+        U base = r[0];
+        for (size_t i = 1; i < n; ++i) {
+            if (signed_base ? static_cast<S>(r[i]) < static_cast<S>(base) : r[i] < base) {
+                base = r[i];
+            }
+        }
+        U bits = 0;
+        for (size_t i = 0; i < n; ++i) {
+            bits |= static_cast<U>(r[i] - base);
+        }
+        int shift = bits == 0 ? 0 : __builtin_ctzll(bits);
+        int width = bit_width(static_cast<U>(bits >> shift));
+        size_t bytes = BLOCK_HEADER_SIZE + (n * width + 7) / 8;
+        if (buf == nullptr) {
+            return bytes;
+        }
+        buf->append(&base, sizeof(U));
+        buf->push_back(static_cast<char>(shift));
+        buf->push_back(static_cast<char>(width));
+        if (width == 0) {
+            return bytes;
+        }
+        unsigned __int128 acc = 0;
+        int num_bits = 0;
+        for (size_t i = 0; i < n; ++i) {
+            acc |= static_cast<unsigned __int128>(static_cast<U>(r[i] - base) >> shift)
+                   << num_bits;
+            num_bits += width;
+            while (num_bits >= 8) {
+                buf->push_back(static_cast<char>(acc));
+                acc >>= 8;
+                num_bits -= 8;
+            }
+        }
+        if (num_bits > 0) {
+            buf->push_back(static_cast<char>(acc));
+        }
+        return bytes;
+    }
+
+    static bool _unpack_block(const uint8_t** data, const uint8_t* end, size_t n, U* out) {
+        const uint8_t* p = *data;
+        if (end - p < static_cast<ptrdiff_t>(BLOCK_HEADER_SIZE)) {
+            return false;
+        }
+        U base;
+        memcpy(&base, p, sizeof(U));
+        int shift = p[sizeof(U)];
+        int width = p[sizeof(U) + 1];
+        p += BLOCK_HEADER_SIZE;
+        size_t bytes = (n * width + 7) / 8;
+        if (static_cast<size_t>(shift + width) > sizeof(U) * 8 ||
+            end - p < static_cast<ptrdiff_t>(bytes)) {
+            return false;
+        }
+        *data = p + bytes;
+        // The loops have no branch on the positions, so that the compiler vectorizes them.
+        if (width == 0) {
+            std::fill(out, out + n, base);
+        } else if (width <= 56) {
+            // the bits of a value are in the 8 bytes from its first byte
+            uint64_t mask = (uint64_t(1) << width) - 1;
+            for (size_t i = 0; i < n; ++i) {
+                size_t bit = i * width;
+                uint64_t word;
+                memcpy(&word, p + (bit >> 3), sizeof(word));
+                out[i] = base + static_cast<U>(static_cast<U>((word >> (bit & 7)) & mask) << shift);
+            }
+        } else {
+            uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+            for (size_t i = 0; i < n; ++i) {
+                size_t bit = i * width;
+                uint64_t word;
+                memcpy(&word, p + (bit >> 3), sizeof(word));
+                uint64_t next = p[(bit >> 3) + 8];
+                uint64_t v = (word >> (bit & 7)) | ((next << 1) << (63 - (bit & 7)));
+                out[i] = base + static_cast<U>(static_cast<U>(v & mask) << shift);
+            }
+        }
+        return true;
+    }
+};
+
+template <FieldType Type>
+class AdaptivePageBuilder : public PageBuilder {
+public:
+    explicit AdaptivePageBuilder(const PageBuilderOptions& options) : _options(options) {
+        reset();
+    }
+
+    bool is_page_full() override {
+        return _values.size() * SIZE_OF_TYPE >= _options.data_page_size;
+    }
+
+    Status add(const uint8_t* vals, size_t* count) override {
+        DCHECK(!_finished);
+        if (is_page_full()) {
+            *count = 0;
+            return Status::OK();
+        }
+        if (*count == 0) {
+            return Status::OK();
+        }
+        size_t old_size = _values.size();
+        _values.resize(old_size + *count);
+        memcpy(&_values[old_size], vals, *count * SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    OwnedSlice finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        size_t n = _values.size();
+        U first = n > 0 ? _values[0] : 0;
+        U first_delta = n > 1 ? static_cast<U>(_values[1] - _values[0]) : 0;
+
+        // the size of the packed residuals of each mode, except the dictionary
+        AdaptivePageMode mode = ADAPTIVE_FOR;
+        size_t best_size = Packing::pack(_values.data(), n, IS_INTEGER, nullptr);
+        for (auto candidate : {ADAPTIVE_DELTA, ADAPTIVE_DELTA_OF_DELTA, ADAPTIVE_XOR}) {
+            _compute_residuals(candidate);
+            size_t size = Packing::pack(_residuals.data(), _residuals.size(),
+                                        IS_INTEGER && candidate != ADAPTIVE_XOR, nullptr);
+            if (size < best_size) {
+                mode = candidate;
+                best_size = size;
+            }
+        }
+        bool use_dict = _encode_dict(best_size);
+
+        _buf.clear();
+        _buf.reserve(HEADER_SIZE + best_size + ADAPTIVE_PAGE_PADDING);
+        put_fixed32_le(&_buf, n);
+        _buf.push_back(static_cast<char>(use_dict ? ADAPTIVE_DICT_RLE : mode));
+        _buf.append(&first, sizeof(U));
+        _buf.append(&first_delta, sizeof(U));
+        if (use_dict) {
+            put_fixed32_le(&_buf, _dict.size());
+            _buf.append(_dict.data(), _dict.size() * sizeof(U));
+            _buf.append(_dict_codes.data(), _dict_codes.size());
+        } else if (mode == ADAPTIVE_FOR) {
+            Packing::pack(_values.data(), n, IS_INTEGER, &_buf);
+        } else {
+            _compute_residuals(mode);
+            Packing::pack(_residuals.data(), _residuals.size(),
+                          IS_INTEGER && mode != ADAPTIVE_XOR, &_buf);
+        }
+        uint8_t padding[ADAPTIVE_PAGE_PADDING] = {0};
+        _buf.append(padding, ADAPTIVE_PAGE_PADDING);
+        return _buf.build();
+    }
+
+    void reset() override {
+        _finished = false;
+        _values.clear();
+        _values.reserve(_options.data_page_size / SIZE_OF_TYPE + 1);
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _values.size() * SIZE_OF_TYPE; }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), SIZE_OF_TYPE);
+        return Status::OK();
+    }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using U = typename AdaptiveUnsigned<sizeof(CppType)>::type;
+    using Packing = AdaptivePacking<U>;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+    static const bool IS_INTEGER = std::is_integral<CppType>::value;
+    static const size_t HEADER_SIZE = 5 + 2 * sizeof(U);
+
+    void _compute_residuals(AdaptivePageMode mode) {
+        size_t n = _values.size();
+        _residuals.clear();
+        switch (mode) {
+        case ADAPTIVE_DELTA:
+            for (size_t i = 1; i < n; ++i) {
+                _residuals.push_back(static_cast<U>(_values[i] - _values[i - 1]));
+            }
+            break;
+        case ADAPTIVE_DELTA_OF_DELTA:
+            for (size_t i = 2; i < n; ++i) {
+                _residuals.push_back(static_cast<U>((_values[i] - _values[i - 1]) -
+                                                    (_values[i - 1] - _values[i - 2])));
+            }
+            break;
+        case ADAPTIVE_XOR:
+            for (size_t i = 1; i < n; ++i) {
+                _residuals.push_back(static_cast<U>(_values[i] ^ _values[i - 1]));
+            }
+            break;
+        default:
+            DCHECK(false) << "no residuals for mode " << static_cast<int>(mode);
+        }
+    }
+
+    // Encodes the values by a dictionary into `_dict` and `_dict_codes`, returns false if the
+    // values have too many distinct ones or the dictionary is not smaller than `best_size`.
+    bool _encode_dict(size_t best_size) {
+        _dict.clear();
+        _dict_codes.clear();
+        std::unordered_map<U, uint32_t> codes;
+        for (U value : _values) {
+            if (codes.emplace(value, _dict.size()).second) {
+                _dict.push_back(value);
+                if (_dict.size() > ADAPTIVE_PAGE_MAX_DICT_SIZE ||
+                    _dict.size() * sizeof(U) >= best_size) {
+                    return false;
+                }
+            }
+        }
+        if (_dict.empty()) {
+            return false;
+        }
+        int bit_width = std::max(1, Packing::bit_width(_dict.size() - 1));
+        RleEncoder<uint32_t> encoder(&_dict_codes, bit_width);
+        for (U value : _values) {
+            encoder.Put(codes[value]);
+        }
+        encoder.Flush();
+        return 4 + _dict.size() * sizeof(U) + _dict_codes.size() < best_size;
+    }
+
+    PageBuilderOptions _options;
+    bool _finished;
+    std::vector<U> _values;
+    std::vector<U> _residuals;
+    std::vector<U> _dict;
+    faststring _dict_codes;
+    faststring _buf;
+};
+
+template <FieldType Type>
+class AdaptivePageDecoder : public PageDecoder {
+public:
+    AdaptivePageDecoder(Slice data, const PageDecoderOptions& options)
+            : _data(data), _options(options), _parsed(false), _cur_index(0) {}
+
+    Status init() override {
+        CHECK(!_parsed);
+        RETURN_IF_ERROR(_decode());
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _values.size());
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        size_t left = 0;
+        size_t right = _values.size();
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (TypeTraits<Type>::cmp(&_values[mid], value) < 0) {
+                left = mid + 1;
+            } else {
+                right = mid;
+            }
+        }
+        if (left >= _values.size()) {
+            return Status::NotFound("all value small than the value");
+        }
+        *exact_match = TypeTraits<Type>::cmp(&_values[left], value) == 0;
+        _cur_index = left;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override { return next_batch<true>(n, dst); }
+
+    template <bool forward_index>
+    Status next_batch(size_t* n, ColumnBlockView* dst) {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _values.size())) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t to_fetch = std::min(*n, _values.size() - _cur_index);
+        memcpy(dst->data(), &_values[_cur_index], to_fetch * SIZE_OF_TYPE);
+        if (forward_index) {
+            _cur_index += to_fetch;
+        }
+        *n = to_fetch;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _values.size())) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t to_fetch = std::min(*n, _values.size() - _cur_index);
+        dst->insert_many_fix_len_data(reinterpret_cast<const char*>(&_values[_cur_index]),
+                                      to_fetch);
+        _cur_index += to_fetch;
+        *n = to_fetch;
+        return Status::OK();
+    }
+
+    Status read_by_rowids(const rowid_t* rowids, ordinal_t page_first_ordinal, size_t* n,
+                          vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        _selected.clear();
+        for (size_t i = 0; i < *n; ++i) {
+            ordinal_t ord = rowids[i] - page_first_ordinal;
+            if (UNLIKELY(ord >= _values.size())) {
+                break;
+            }
+            _selected.push_back(_values[ord]);
+        }
+        if (LIKELY(!_selected.empty())) {
+            dst->insert_many_fix_len_data(reinterpret_cast<const char*>(_selected.data()),
+                                          _selected.size());
+        }
+        *n = _selected.size();
+        return Status::OK();
+    }
+
+    Status peek_next_batch(size_t* n, ColumnBlockView* dst) override {
+        return next_batch<false>(n, dst);
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    size_t current_index() const override { return _cur_index; }
+
+private:
+    using CppType = typename TypeTraits<Type>::CppType;
+    using U = typename AdaptiveUnsigned<sizeof(CppType)>::type;
+    using Packing = AdaptivePacking<U>;
+    enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+    static const size_t HEADER_SIZE = 5 + 2 * sizeof(U);
+
+    // Decodes all the values of the page, so that the reads and seeks are plain copies.
+    Status _decode() {
+        if (_data.size < HEADER_SIZE + ADAPTIVE_PAGE_PADDING) {
+            return Status::Corruption("adaptive page is too small, size:{}", _data.size);
+        }
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(_data.data);
+        const uint8_t* end = p + _data.size - ADAPTIVE_PAGE_PADDING;
+        uint32_t n = decode_fixed32_le(p);
+        uint8_t mode = p[4];
+        U first;
+        U first_delta;
+        memcpy(&first, p + 5, sizeof(U));
+        memcpy(&first_delta, p + 5 + sizeof(U), sizeof(U));
+        p += HEADER_SIZE;
+
+        _values.resize(n);
+        U* values = _values.data();
+        bool ok = true;
+        switch (mode) {
+        case ADAPTIVE_FOR:
+            ok = Packing::unpack(&p, end, n, values);
+            break;
+        case ADAPTIVE_DELTA:
+            if (n > 0) {
+                values[0] = first;
+                ok = Packing::unpack(&p, end, n - 1, values + 1);
+                for (size_t i = 1; i < n; ++i) {
+                    values[i] += values[i - 1];
+                }
+            }
+            break;
+        case ADAPTIVE_DELTA_OF_DELTA:
+            if (n > 0) {
+                values[0] = first;
+            }
+            if (n > 1) {
+                values[1] = first + first_delta;
+                ok = Packing::unpack(&p, end, n - 2, values + 2);
+                U delta = first_delta;
+                for (size_t i = 2; i < n; ++i) {
+                    delta += values[i];
+                    values[i] = values[i - 1] + delta;
+                }
+            }
+            break;
+        case ADAPTIVE_XOR:
+            if (n > 0) {
+                values[0] = first;
+                ok = Packing::unpack(&p, end, n - 1, values + 1);
+                for (size_t i = 1; i < n; ++i) {
+                    values[i] ^= values[i - 1];
+                }
+            }
+            break;
+        case ADAPTIVE_DICT_RLE:
+            ok = _decode_dict(p, end, n);
+            break;
+        default:
+            return Status::Corruption("unknown adaptive page mode:{}", mode);
+        }
+        if (!ok) {
+            return Status::Corruption("adaptive page of mode {} is broken", mode);
+        }
+        return Status::OK();
+    }
+
+    bool _decode_dict(const uint8_t* p, const uint8_t* end, uint32_t n) {
+        if (end - p < 4) {
+            return false;
+        }
+        uint32_t dict_size = decode_fixed32_le(p);
+        p += 4;
+        if (dict_size == 0 || static_cast<size_t>(end - p) < dict_size * sizeof(U)) {
+            return false;
+        }
+        std::vector<U> dict(dict_size);
+        memcpy(dict.data(), p, dict_size * sizeof(U));
+        p += dict_size * sizeof(U);
+        int bit_width = std::max(1, Packing::bit_width(dict_size - 1));
+        RleDecoder<uint32_t> decoder(p, end - p, bit_width);
+        for (size_t i = 0; i < n;) {
+            uint32_t code = 0;
+            size_t run = decoder.GetNextRun(&code, n - i);
+            if (run == 0 || code >= dict_size) {
+                return false;
+            }
+            std::fill(_values.begin() + i, _values.begin() + i + run, dict[code]);
+            i += run;
+        }
+        return true;
+    }
+
+    Slice _data;
+    PageDecoderOptions _options;
+    bool _parsed;
+    size_t _cur_index;
+    std::vector<U> _values;
+    std::vector<U> _selected;
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -17,6 +17,7 @@
 
 #include "olap/rowset/segment_v2/binary_dict_page.h"
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/substitute.h" // for Substitute
 #include "runtime/mem_pool.h"
@@ -113,7 +114,7 @@ Status BinaryDictPageBuilder::add(const uint8_t* vals, size_t* count) {
         *count = num_added;
         return Status::OK();
     } else {
-        DCHECK_EQ(_encoding_type, PLAIN_ENCODING);
+        DCHECK_NE(_encoding_type, DICT_ENCODING);
         return _data_page_builder->add(vals, count);
     }
 }
@@ -135,8 +136,14 @@ void BinaryDictPageBuilder::reset() {
     _buffer.resize(BINARY_DICT_PAGE_HEADER_SIZE);
 
     if (_encoding_type == DICT_ENCODING && _dict_builder->is_page_full()) {
-        _data_page_builder.reset(new BinaryPlainPageBuilder<OLAP_FIELD_TYPE_VARCHAR>(_options));
-        _encoding_type = PLAIN_ENCODING;
+        if (config::enable_fsst_string_encoding) {
+            _data_page_builder.reset(new BinaryFsstPageBuilder<OLAP_FIELD_TYPE_VARCHAR>(_options));
+            _encoding_type = FSST_ENCODING;
+        } else {
+            _data_page_builder.reset(
+                    new BinaryPlainPageBuilder<OLAP_FIELD_TYPE_VARCHAR>(_options));
+            _encoding_type = PLAIN_ENCODING;
+        }
     } else {
         _data_page_builder->reset();
     }
@@ -207,6 +214,9 @@ Status BinaryDictPageDecoder::init() {
     } else if (_encoding_type == PLAIN_ENCODING) {
         DCHECK_EQ(_encoding_type, PLAIN_ENCODING);
         _data_page_decoder.reset(new BinaryPlainPageDecoder<OLAP_FIELD_TYPE_INT>(_data, _options));
+    } else if (_encoding_type == FSST_ENCODING) {
+        _data_page_decoder.reset(
+                new BinaryFsstPageDecoder<OLAP_FIELD_TYPE_VARCHAR>(_data, _options));
     } else {
         LOG(WARNING) << "invalid encoding type:" << _encoding_type;
         return Status::Corruption("invalid encoding type:{}", _encoding_type);
@@ -233,7 +243,7 @@ void BinaryDictPageDecoder::set_dict_decoder(PageDecoder* dict_decoder, StringRe
 };
 
 Status BinaryDictPageDecoder::next_batch(size_t* n, vectorized::MutableColumnPtr& dst) {
-    if (_encoding_type == PLAIN_ENCODING) {
+    if (_encoding_type != DICT_ENCODING) {
         dst = dst->convert_to_predicate_column_if_dictionary();
         return _data_page_decoder->next_batch(n, dst);
     }
@@ -263,7 +273,8 @@ Status BinaryDictPageDecoder::next_batch(size_t* n, vectorized::MutableColumnPtr
 
 Status BinaryDictPageDecoder::read_by_rowids(const rowid_t* rowids, ordinal_t page_first_ordinal,
                                              size_t* n, vectorized::MutableColumnPtr& dst) {
-    if (_encoding_type == PLAIN_ENCODING) {
+    if (_encoding_type != DICT_ENCODING) {
+        dst = dst->convert_to_predicate_column_if_dictionary();
         return _data_page_decoder->read_by_rowids(rowids, page_first_ordinal, n, dst);
     }
     DCHECK(_parsed);
@@ -293,8 +304,17 @@ Status BinaryDictPageDecoder::read_by_rowids(const rowid_t* rowids, ordinal_t pa
     return Status::OK();
 }
 
+Status BinaryDictPageDecoder::evaluate_predicates(const std::vector<ColumnPredicate*>& predicates,
+                                                  size_t* n, vectorized::MutableColumnPtr& scratch,
+                                                  bool* flags) {
+    if (_encoding_type == FSST_ENCODING) {
+        return _data_page_decoder->evaluate_predicates(predicates, n, scratch, flags);
+    }
+    return Status::NotSupported("evaluate_predicates not implement");
+}
+
 Status BinaryDictPageDecoder::next_batch(size_t* n, ColumnBlockView* dst) {
-    if (_encoding_type == PLAIN_ENCODING) {
+    if (_encoding_type != DICT_ENCODING) {
         return _data_page_decoder->next_batch(n, dst);
     }
     // dictionary encoding
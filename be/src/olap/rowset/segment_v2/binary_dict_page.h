@@ -28,6 +28,7 @@
 #include "olap/column_block.h"
 #include "olap/column_vector.h"
 #include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/binary_fsst_page.h"
 #include "olap/rowset/segment_v2/binary_plain_page.h"
 #include "olap/rowset/segment_v2/bitshuffle_page.h"
 #include "olap/rowset/segment_v2/common.h"
@@ -47,9 +48,10 @@ enum { BINARY_DICT_PAGE_HEADER_SIZE = 4 };
 // Either header + embedded codeword page, which can be encoded with any
 //        int PageBuilder, when mode_ = DICT_ENCODING.
 // Or     header + embedded BinaryPlainPage, when mode_ = PLAIN_ENCODING.
+// Or     header + embedded BinaryFsstPage, when mode_ = FSST_ENCODING.
 // Data pages start with mode_ = DICT_ENCODING, when the size of dictionary
 // page go beyond the option_->dict_page_size, the subsequent data pages will switch
-// to string plain page automatically.
+// to string plain page automatically, or to fsst page if enable_fsst_string_encoding is set.
 class BinaryDictPageBuilder : public PageBuilder {
 public:
     BinaryDictPageBuilder(const PageBuilderOptions& options);
@@ -111,6 +113,9 @@ public:
     Status read_by_rowids(const rowid_t* rowids, ordinal_t page_first_ordinal, size_t* n,
                           vectorized::MutableColumnPtr& dst) override;
 
+    Status evaluate_predicates(const std::vector<ColumnPredicate*>& predicates, size_t* n,
+                               vectorized::MutableColumnPtr& scratch, bool* flags) override;
+
     size_t count() const override { return _data_page_decoder->count(); }
 
     size_t current_index() const override { return _data_page_decoder->current_index(); }
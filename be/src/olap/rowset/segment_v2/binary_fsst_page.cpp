@@ -0,0 +1,179 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/binary_fsst_page.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace doris {
+namespace segment_v2 {
+
+// the rounds of counting the symbols in the samples and merging the frequent pairs of them, which
+// doubles the longest symbols in each round
+static constexpr int FSST_BUILD_ROUNDS = 5;
+
+void FsstSymbolTable::_clear() {
+    _num_symbols = 0;
+    memset(_symbols, 0, sizeof(_symbols));
+    memset(_lengths, 0, sizeof(_lengths));
+    for (auto& candidates : _candidates) {
+        candidates.clear();
+    }
+}
+
+void FsstSymbolTable::_set_symbols(const std::vector<std::string>& symbols) {
+    _clear();
+    DCHECK_LE(symbols.size(), FSST_MAX_SYMBOLS);
+    for (const auto& symbol : symbols) {
+        DCHECK(!symbol.empty() && symbol.size() <= FSST_MAX_SYMBOL_LENGTH);
+        memcpy(_symbols[_num_symbols], symbol.data(), symbol.size());
+        _lengths[_num_symbols] = symbol.size();
+        _candidates[static_cast<uint8_t>(symbol[0])].push_back(_num_symbols);
+        _num_symbols++;
+    }
+    for (auto& candidates : _candidates) {
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [this](uint8_t a, uint8_t b) { return _lengths[a] > _lengths[b]; });
+    }
+}
+
+void FsstSymbolTable::build(const std::vector<Slice>& samples) {
+    _clear();
+    // the codes of the symbols are below 256, and an escaped byte b is counted as 256 + b
+    auto symbol_of = [this](uint32_t code) {
+        if (code >= 256) {
+            return std::string(1, static_cast<char>(code - 256));
+        }
+        return std::string(_symbols[code], _lengths[code]);
+    };
+    for (int round = 0; round < FSST_BUILD_ROUNDS; ++round) {
+        std::vector<uint32_t> counts(512, 0);
+        std::unordered_map<uint32_t, uint32_t> pair_counts;
+        for (const Slice& sample : samples) {
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(sample.data);
+            size_t remaining = sample.size;
+            int64_t prev = -1;
+            while (remaining > 0) {
+                size_t length = 0;
+                int code = _find(p, remaining, &length);
+                uint32_t counted = code < 0 ? 256 + *p : code;
+                counts[counted]++;
+                if (prev >= 0) {
+                    pair_counts[(prev << 9) | counted]++;
+                }
+                prev = counted;
+                p += length;
+                remaining -= length;
+            }
+        }
+
+        // the gain of a symbol is the bytes of the samples it covers
+        std::unordered_map<std::string, uint64_t> gains;
+        for (uint32_t code = 0; code < counts.size(); ++code) {
+            if (counts[code] > 0) {
+                std::string symbol = symbol_of(code);
+                gains[symbol] += static_cast<uint64_t>(counts[code]) * symbol.size();
+            }
+        }
+        for (const auto& [pair, count] : pair_counts) {
+            // a pair seen once saves at most a byte
+            if (count < 2) {
+                continue;
+            }
+            std::string symbol = symbol_of(pair >> 9) + symbol_of(pair & 511);
+            if (symbol.size() > FSST_MAX_SYMBOL_LENGTH) {
+                symbol.resize(FSST_MAX_SYMBOL_LENGTH);
+            }
+            gains[symbol] += static_cast<uint64_t>(count) * symbol.size();
+        }
+
+        std::vector<std::pair<uint64_t, std::string>> ranked;
+        ranked.reserve(gains.size());
+        for (auto& [symbol, gain] : gains) {
+            ranked.emplace_back(gain, symbol);
+        }
+        size_t num_symbols = std::min(ranked.size(), FSST_MAX_SYMBOLS);
+        // the same samples always give the same table
+        std::partial_sort(ranked.begin(), ranked.begin() + num_symbols, ranked.end(),
+                          [](const auto& a, const auto& b) {
+                              return a.first != b.first ? a.first > b.first : a.second < b.second;
+                          });
+        std::vector<std::string> symbols;
+        symbols.reserve(num_symbols);
+        for (size_t i = 0; i < num_symbols; ++i) {
+            symbols.push_back(std::move(ranked[i].second));
+        }
+        _set_symbols(symbols);
+    }
+}
+
+void FsstSymbolTable::encode(const Slice& value, faststring* codes) const {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(value.data);
+    size_t remaining = value.size;
+    while (remaining > 0) {
+        size_t length = 0;
+        int code = _find(p, remaining, &length);
+        if (code < 0) {
+            codes->push_back(FSST_ESCAPE);
+            codes->push_back(*p);
+        } else {
+            codes->push_back(code);
+        }
+        p += length;
+        remaining -= length;
+    }
+}
+
+void FsstSymbolTable::serialize(faststring* buf) const {
+    buf->push_back(_num_symbols);
+    for (size_t code = 0; code < _num_symbols; ++code) {
+        buf->push_back(_lengths[code]);
+    }
+    for (size_t code = 0; code < _num_symbols; ++code) {
+        buf->append(_symbols[code], _lengths[code]);
+    }
+}
+
+Status FsstSymbolTable::parse(const Slice& data, size_t* consumed) {
+    if (data.size < 1) {
+        return Status::Corruption("invalid fsst symbol table size:{}", data.size);
+    }
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data.data);
+    size_t num_symbols = p[0];
+    if (num_symbols > FSST_MAX_SYMBOLS || 1 + num_symbols > data.size) {
+        return Status::Corruption("invalid fsst symbol table of {} symbols, size:{}", num_symbols,
+                                  data.size);
+    }
+    size_t pos = 1 + num_symbols;
+    std::vector<std::string> symbols;
+    symbols.reserve(num_symbols);
+    for (size_t code = 0; code < num_symbols; ++code) {
+        size_t length = p[1 + code];
+        if (length == 0 || length > FSST_MAX_SYMBOL_LENGTH || pos + length > data.size) {
+            return Status::Corruption("invalid fsst symbol {} of length {}", code, length);
+        }
+        symbols.emplace_back(data.data + pos, length);
+        pos += length;
+    }
+    _set_symbols(symbols);
+    *consumed = pos;
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
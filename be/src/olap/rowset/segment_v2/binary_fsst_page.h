@@ -0,0 +1,487 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Page encoding for strings with a static symbol table (FSST).
+//
+// The symbol table of a page maps up to 255 one-byte codes to the symbols of 1 to 8 bytes that
+// are the most frequent in the strings of the page. Each string is encoded alone as codes of
+// its symbols, and the bytes that are not in any symbol are escaped, so any string can be
+// decoded without the others and the equal strings have equal codes.
+//
+// The page consists of:
+//   num_elems (32-bit fixed)
+//   symbol table
+//   offsets of the codes of each string, and the size of the codes ((num_elems + 1) x 32-bit)
+//   codes
+//
+// The equality and prefix predicates are evaluated on the codes: the literal of an equality is
+// encoded by the table of the page and compared with the codes, and only the first bytes of the
+// strings are decoded for a prefix.
+
+#pragma once
+
+#include "common/logging.h"
+#include "olap/column_predicate.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/options.h"
+#include "olap/rowset/segment_v2/page_builder.h"
+#include "olap/rowset/segment_v2/page_decoder.h"
+#include "olap/types.h"
+#include "runtime/mem_pool.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "vec/columns/column.h"
+
+namespace doris {
+namespace segment_v2 {
+
+static constexpr size_t FSST_MAX_SYMBOLS = 255;
+static constexpr size_t FSST_MAX_SYMBOL_LENGTH = 8;
+static constexpr uint8_t FSST_ESCAPE = 255;
+// the bytes of the strings of a page the symbol table is built from
+static constexpr size_t FSST_SAMPLE_SIZE = 16 * 1024;
+
+class FsstSymbolTable {
+public:
+    FsstSymbolTable() { _clear(); }
+
+    // Builds the table of the symbols saving the most bytes in the samples.
+    void build(const std::vector<Slice>& samples);
+
+    // Appends the codes of value to codes.
+    void encode(const Slice& value, faststring* codes) const;
+
+    // Decodes len codes into dst, and returns the number of decoded bytes. dst must have
+    // FSST_MAX_SYMBOL_LENGTH bytes for each code.
+    size_t decode(const uint8_t* codes, size_t len, char* dst) const {
+        char* out = dst;
+        const uint8_t* end = codes + len;
+        while (codes < end) {
+            uint8_t code = *codes++;
+            if (PREDICT_FALSE(code == FSST_ESCAPE)) {
+                if (codes < end) {
+                    *out++ = *codes++;
+                }
+            } else {
+                memcpy(out, _symbols[code], FSST_MAX_SYMBOL_LENGTH);
+                out += _lengths[code];
+            }
+        }
+        return out - dst;
+    }
+
+    // Same as decode(), but stops once `limit` bytes are decoded. dst must have
+    // limit + FSST_MAX_SYMBOL_LENGTH bytes.
+    size_t decode_prefix(const uint8_t* codes, size_t len, size_t limit, char* dst) const {
+        char* out = dst;
+        const uint8_t* end = codes + len;
+        while (codes < end && static_cast<size_t>(out - dst) < limit) {
+            uint8_t code = *codes++;
+            if (PREDICT_FALSE(code == FSST_ESCAPE)) {
+                if (codes < end) {
+                    *out++ = *codes++;
+                }
+            } else {
+                memcpy(out, _symbols[code], FSST_MAX_SYMBOL_LENGTH);
+                out += _lengths[code];
+            }
+        }
+        return out - dst;
+    }
+
+    // the table is the number of symbols (8-bit), the length of each symbol (8-bit each) and
+    // the bytes of the symbols
+    void serialize(faststring* buf) const;
+    // parses a table serialized at the beginning of data, whose size is set to consumed
+    Status parse(const Slice& data, size_t* consumed);
+
+    size_t num_symbols() const { return _num_symbols; }
+
+private:
+    void _clear();
+    // sets the symbols of the codes from 0
+    void _set_symbols(const std::vector<std::string>& symbols);
+    // the code of the longest symbol at the beginning of the len bytes at p, or -1 if there is
+    // none, in which case the first byte is escaped
+    int _find(const uint8_t* p, size_t len, size_t* length) const {
+        for (uint8_t code : _candidates[*p]) {
+            size_t symbol_length = _lengths[code];
+            if (symbol_length <= len && memcmp(_symbols[code], p, symbol_length) == 0) {
+                *length = symbol_length;
+                return code;
+            }
+        }
+        *length = 1;
+        return -1;
+    }
+
+    size_t _num_symbols;
+    // the unused codes have no byte, so the corrupted codes are decoded as nothing
+    char _symbols[FSST_MAX_SYMBOLS + 1][FSST_MAX_SYMBOL_LENGTH];
+    uint8_t _lengths[FSST_MAX_SYMBOLS + 1];
+    // the codes of the symbols starting with each byte, the longest first
+    std::vector<uint8_t> _candidates[256];
+};
+
+template <FieldType Type>
+class BinaryFsstPageBuilder : public PageBuilder {
+public:
+    BinaryFsstPageBuilder(const PageBuilderOptions& options) : _options(options) { reset(); }
+
+    bool is_page_full() override {
+        // data_page_size is 0, do not limit the page size
+        return _options.data_page_size != 0 && _size_estimate > _options.data_page_size;
+    }
+
+    Status add(const uint8_t* vals, size_t* count) override {
+        DCHECK(!_finished);
+        const Slice* src = reinterpret_cast<const Slice*>(vals);
+        size_t i = 0;
+        while (!is_page_full() && i < *count) {
+            _offsets.push_back(_buffer.size());
+            _buffer.append(src[i].data, src[i].size);
+            // the codes are not longer than the raw strings in most cases
+            _size_estimate += src[i].size + sizeof(uint32_t);
+            i++;
+        }
+        *count = i;
+        return Status::OK();
+    }
+
+    OwnedSlice finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        size_t num_elems = _offsets.size();
+
+        // sample the strings evenly over the page
+        std::vector<Slice> samples;
+        size_t stride = std::max<size_t>(1, _buffer.size() / FSST_SAMPLE_SIZE);
+        for (size_t i = 0; i < num_elems; i += stride) {
+            samples.emplace_back(value_at(i));
+        }
+        FsstSymbolTable table;
+        table.build(samples);
+
+        faststring codes;
+        std::vector<uint32_t> code_offsets;
+        code_offsets.reserve(num_elems + 1);
+        for (size_t i = 0; i < num_elems; ++i) {
+            code_offsets.push_back(codes.size());
+            table.encode(value_at(i), &codes);
+        }
+        code_offsets.push_back(codes.size());
+
+        faststring page;
+        page.reserve(codes.size() + code_offsets.size() * sizeof(uint32_t) + 1024);
+        put_fixed32_le(&page, num_elems);
+        table.serialize(&page);
+        for (uint32_t offset : code_offsets) {
+            put_fixed32_le(&page, offset);
+        }
+        page.append(codes.data(), codes.size());
+
+        if (num_elems > 0) {
+            Slice first = value_at(0);
+            Slice last = value_at(num_elems - 1);
+            _first_value.assign_copy(reinterpret_cast<const uint8_t*>(first.data), first.size);
+            _last_value.assign_copy(reinterpret_cast<const uint8_t*>(last.data), last.size);
+        }
+        return page.build();
+    }
+
+    void reset() override {
+        _offsets.clear();
+        _buffer.clear();
+        _buffer.reserve(_options.data_page_size == 0 ? 1024 : _options.data_page_size);
+        _size_estimate = sizeof(uint32_t);
+        _finished = false;
+    }
+
+    size_t count() const override { return _offsets.size(); }
+
+    uint64_t size() const override { return _size_estimate; }
+
+    Status get_first_value(void* value) const override {
+        DCHECK(_finished);
+        if (count() == 0) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = Slice(_first_value);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        DCHECK(_finished);
+        if (count() == 0) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = Slice(_last_value);
+        return Status::OK();
+    }
+
+private:
+    Slice value_at(size_t idx) const {
+        size_t end = idx + 1 < _offsets.size() ? _offsets[idx + 1] : _buffer.size();
+        return Slice(&_buffer[_offsets[idx]], end - _offsets[idx]);
+    }
+
+    PageBuilderOptions _options;
+    // the raw strings, encoded when the page is finished
+    faststring _buffer;
+    std::vector<uint32_t> _offsets;
+    size_t _size_estimate;
+    bool _finished;
+    faststring _first_value;
+    faststring _last_value;
+};
+
+template <FieldType Type>
+class BinaryFsstPageDecoder : public PageDecoder {
+public:
+    BinaryFsstPageDecoder(Slice data) : BinaryFsstPageDecoder(data, PageDecoderOptions()) {}
+
+    BinaryFsstPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _data(data), _options(options) {}
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < sizeof(uint32_t)) {
+            return Status::Corruption("invalid data size:{} of fsst page", _data.size);
+        }
+        _num_elems = decode_fixed32_le(reinterpret_cast<const uint8_t*>(_data.data));
+        size_t table_size = 0;
+        RETURN_IF_ERROR(_table.parse(Slice(_data.data + sizeof(uint32_t),
+                                           _data.size - sizeof(uint32_t)),
+                                     &table_size));
+        _offsets = reinterpret_cast<const uint8_t*>(_data.data) + sizeof(uint32_t) + table_size;
+        size_t codes_pos = sizeof(uint32_t) + table_size + (_num_elems + 1) * sizeof(uint32_t);
+        if (codes_pos > _data.size) {
+            return Status::Corruption("invalid data size:{} of fsst page, {} values", _data.size,
+                                      _num_elems);
+        }
+        _codes = reinterpret_cast<const uint8_t*>(_data.data) + codes_pos;
+        for (size_t i = 0; i < _num_elems; ++i) {
+            if (_offset(i) > _offset(i + 1)) {
+                return Status::Corruption("invalid offset of value {} of fsst page", i);
+            }
+        }
+        if (_offset(0) != 0 || _offset(_num_elems) != _data.size - codes_pos) {
+            return Status::Corruption("invalid codes size:{} of fsst page", _offset(_num_elems));
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK_LE(pos, _num_elems);
+        _cur_idx = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_idx >= _num_elems)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elems - _cur_idx));
+        _decode_range(_cur_idx, max_fetch);
+
+        char* destination = (char*)dst->column_block()->pool()->allocate(_decoded.size());
+        if (destination == nullptr) {
+            return Status::MemoryAllocFailed("memory allocate failed, size:{}", _decoded.size());
+        }
+        memcpy(destination, _decoded.data(), _decoded.size());
+        Slice* out = reinterpret_cast<Slice*>(dst->data());
+        for (size_t i = 0; i < max_fetch; ++i) {
+            out[i] = Slice(destination + _starts[i], _lens[i]);
+        }
+
+        _cur_idx += max_fetch;
+        *n = max_fetch;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0 || _cur_idx >= _num_elems)) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elems - _cur_idx));
+        _decode_range(_cur_idx, max_fetch);
+        dst->insert_many_binary_data(reinterpret_cast<char*>(_decoded.data()), _lens.data(),
+                                     _starts.data(), max_fetch);
+
+        _cur_idx += max_fetch;
+        *n = max_fetch;
+        return Status::OK();
+    }
+
+    Status read_by_rowids(const rowid_t* rowids, ordinal_t page_first_ordinal, size_t* n,
+                          vectorized::MutableColumnPtr& dst) override {
+        DCHECK(_parsed);
+        if (PREDICT_FALSE(*n == 0)) {
+            *n = 0;
+            return Status::OK();
+        }
+
+        size_t read_count = 0;
+        size_t codes_size = 0;
+        for (; read_count < *n; ++read_count) {
+            ordinal_t ord = rowids[read_count] - page_first_ordinal;
+            if (UNLIKELY(ord >= _num_elems)) {
+                break;
+            }
+            codes_size += _offset(ord + 1) - _offset(ord);
+        }
+        _prepare_decode(read_count, codes_size);
+        size_t decoded_size = 0;
+        for (size_t i = 0; i < read_count; ++i) {
+            decoded_size += _decode_value(rowids[i] - page_first_ordinal, i, decoded_size);
+        }
+        _decoded.resize(decoded_size);
+
+        if (LIKELY(read_count > 0)) {
+            dst->insert_many_binary_data(reinterpret_cast<char*>(_decoded.data()), _lens.data(),
+                                         _starts.data(), read_count);
+        }
+        *n = read_count;
+        return Status::OK();
+    }
+
+    Status evaluate_predicates(const std::vector<ColumnPredicate*>& predicates, size_t* n,
+                               vectorized::MutableColumnPtr& scratch, bool* flags) override {
+        DCHECK(_parsed);
+        DCHECK(!predicates.empty());
+        // the other predicates are evaluated on the decoded strings by the caller
+        std::vector<std::string> literals(predicates.size());
+        std::vector<bool> is_prefix(predicates.size());
+        for (size_t i = 0; i < predicates.size(); ++i) {
+            if (predicates[i]->is_string_prefix(&literals[i])) {
+                is_prefix[i] = true;
+            } else if (!predicates[i]->is_string_equal(&literals[i])) {
+                return Status::NotSupported("predicate can't be evaluated on fsst codes");
+            }
+        }
+        if (PREDICT_FALSE(*n == 0 || _cur_idx >= _num_elems)) {
+            *n = 0;
+            return Status::OK();
+        }
+
+        size_t to_fetch = std::min(*n, static_cast<size_t>(_num_elems - _cur_idx));
+        memset(flags, 1, to_fetch);
+        for (size_t i = 0; i < predicates.size(); ++i) {
+            if (is_prefix[i]) {
+                _evaluate_prefix(literals[i], to_fetch, flags);
+            } else {
+                _evaluate_equal(literals[i], to_fetch, flags);
+            }
+        }
+
+        _cur_idx += to_fetch;
+        *n = to_fetch;
+        return Status::OK();
+    }
+
+    size_t count() const override {
+        DCHECK(_parsed);
+        return _num_elems;
+    }
+
+    size_t current_index() const override {
+        DCHECK(_parsed);
+        return _cur_idx;
+    }
+
+private:
+    uint32_t _offset(size_t idx) const {
+        return decode_fixed32_le(_offsets + idx * sizeof(uint32_t));
+    }
+
+    // makes room in _decoded for the values having codes_size codes in total
+    void _prepare_decode(size_t num_values, size_t codes_size) {
+        _starts.resize(num_values);
+        _lens.resize(num_values);
+        _decoded.resize((codes_size + 1) * FSST_MAX_SYMBOL_LENGTH);
+    }
+
+    // decodes the value at idx into _decoded at pos, as the i-th decoded value
+    size_t _decode_value(size_t idx, size_t i, size_t pos) {
+        uint32_t start = _offset(idx);
+        size_t size = _table.decode(_codes + start, _offset(idx + 1) - start,
+                                    reinterpret_cast<char*>(_decoded.data()) + pos);
+        _starts[i] = pos;
+        _lens[i] = size;
+        return size;
+    }
+
+    void _decode_range(size_t start, size_t num_values) {
+        _prepare_decode(num_values, _offset(start + num_values) - _offset(start));
+        size_t decoded_size = 0;
+        for (size_t i = 0; i < num_values; ++i) {
+            decoded_size += _decode_value(start + i, i, decoded_size);
+        }
+        _decoded.resize(decoded_size);
+    }
+
+    void _evaluate_equal(const std::string& literal, size_t num_values, bool* flags) {
+        _literal_codes.clear();
+        _table.encode(Slice(literal), &_literal_codes);
+        for (size_t i = 0; i < num_values; ++i) {
+            if (flags[i]) {
+                uint32_t start = _offset(_cur_idx + i);
+                uint32_t size = _offset(_cur_idx + i + 1) - start;
+                flags[i] = size == _literal_codes.size() &&
+                           memcmp(_codes + start, _literal_codes.data(), size) == 0;
+            }
+        }
+    }
+
+    void _evaluate_prefix(const std::string& prefix, size_t num_values, bool* flags) {
+        _decoded.resize(prefix.size() + FSST_MAX_SYMBOL_LENGTH);
+        char* buf = reinterpret_cast<char*>(_decoded.data());
+        for (size_t i = 0; i < num_values; ++i) {
+            if (flags[i]) {
+                uint32_t start = _offset(_cur_idx + i);
+                size_t size = _table.decode_prefix(_codes + start,
+                                                   _offset(_cur_idx + i + 1) - start,
+                                                   prefix.size(), buf);
+                flags[i] = size >= prefix.size() && memcmp(buf, prefix.data(), prefix.size()) == 0;
+            }
+        }
+    }
+
+    Slice _data;
+    PageDecoderOptions _options;
+    bool _parsed = false;
+    uint32_t _num_elems = 0;
+    FsstSymbolTable _table;
+    const uint8_t* _offsets = nullptr;
+    const uint8_t* _codes = nullptr;
+    // Index of the currently seeked element in the page.
+    uint32_t _cur_idx = 0;
+
+    // the strings decoded by the last batch and their positions in _decoded
+    faststring _decoded;
+    std::vector<uint32_t> _starts;
+    std::vector<uint32_t> _lens;
+    faststring _literal_codes;
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -249,21 +249,21 @@ public:
         }
         const size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elems - _cur_idx));
 
-        uint32_t len_array[max_fetch];
-        uint32_t start_offset_array[max_fetch];
-        for (int i = 0; i < max_fetch; i++, _cur_idx++) {
-            const uint32_t start_offset = offset(_cur_idx);
-            uint32_t len = offset(_cur_idx + 1) - start_offset;
-            len_array[i] = len;
-            start_offset_array[i] = start_offset;
-            if constexpr (Type == OLAP_FIELD_TYPE_OBJECT) {
-                if (_options.need_check_bitmap) {
-                    RETURN_IF_ERROR(BitmapTypeCode::validate(*(_data.data + start_offset)));
+        // the values of the batch are contiguous in the page, the column copies them from their
+        // offsets
+        uint32_t offset_array[max_fetch + 1];
+        for (size_t i = 0; i <= max_fetch; i++) {
+            offset_array[i] = offset(_cur_idx + i);
+        }
+        if constexpr (Type == OLAP_FIELD_TYPE_OBJECT) {
+            if (_options.need_check_bitmap) {
+                for (size_t i = 0; i < max_fetch; i++) {
+                    RETURN_IF_ERROR(BitmapTypeCode::validate(*(_data.data + offset_array[i])));
                 }
             }
         }
-        dst->insert_many_binary_data(_data.mutable_data(), len_array, start_offset_array,
-                                     max_fetch);
+        dst->insert_many_continuous_binary_data(_data.data, offset_array, max_fetch);
+        _cur_idx += max_fetch;
 
         *n = max_fetch;
         return Status::OK();
@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/bit_sliced_index_reader.h"
+
+#include "olap/rowset/segment_v2/bit_sliced_index_writer.h"
+#include "olap/types.h"
+
+namespace doris {
+namespace segment_v2 {
+
+Status BitSlicedIndexReader::load(bool use_page_cache, bool kept_in_memory) {
+    const IndexedColumnMetaPB& bitmap_meta = _bit_sliced_index_meta->bitmap_column();
+    _bitmap_column_reader.reset(new IndexedColumnReader(_file_reader, bitmap_meta));
+    return _bitmap_column_reader->load(use_page_cache, kept_in_memory);
+}
+
+Status BitSlicedIndexReader::new_iterator(BitSlicedIndexIterator** iterator) {
+    *iterator = new BitSlicedIndexIterator(this);
+    return Status::OK();
+}
+
+Status BitSlicedIndexIterator::compare(const void* value, roaring::Roaring* less,
+                                       roaring::Roaring* equal, roaring::Roaring* not_null) {
+    const BitSlicedIndexPB* meta = _reader->_bit_sliced_index_meta;
+    uint64_t key = BitSlicedIndexWriter::key(_reader->_field_type, value);
+    uint32_t bit_width = meta->bit_width();
+
+    *less = roaring::Roaring();
+    *equal = roaring::Roaring();
+    RETURN_IF_ERROR(_read_bitmap(0, not_null));
+    if (key < meta->min_key()) {
+        return Status::OK();
+    }
+    uint64_t offset = key - meta->min_key();
+    if (bit_width < 64 && (offset >> bit_width) != 0) {
+        // greater than all the values
+        *less = *not_null;
+        return Status::OK();
+    }
+
+    // from the highest bit down, the rows whose bits so far are equal to the ones of the offset
+    // are less if the bit of the offset is set and theirs is not
+    *equal = *not_null;
+    for (int bit = static_cast<int>(bit_width) - 1; bit >= 0 && !equal->isEmpty(); --bit) {
+        roaring::Roaring slice;
+        RETURN_IF_ERROR(_read_bitmap(bit + 1, &slice));
+        if ((offset >> bit) & 1) {
+            *less |= *equal - slice;
+            *equal &= slice;
+        } else {
+            *equal -= slice;
+        }
+    }
+    return Status::OK();
+}
+
+Status BitSlicedIndexIterator::_read_bitmap(rowid_t ordinal, roaring::Roaring* result) {
+    DCHECK(ordinal < _reader->_bitmap_column_reader->num_values());
+
+    size_t num_to_read = 1;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(
+            ColumnVectorBatch::create(num_to_read, false, _reader->type_info(), nullptr, &cvb));
+    ColumnBlock block(cvb.get(), _pool.get());
+    ColumnBlockView column_block_view(&block);
+
+    RETURN_IF_ERROR(_bitmap_column_iter.seek_to_ordinal(ordinal));
+    size_t num_read = num_to_read;
+    RETURN_IF_ERROR(_bitmap_column_iter.next_batch(&num_read, &column_block_view));
+    DCHECK(num_to_read == num_read);
+
+    *result = roaring::Roaring::read(reinterpret_cast<const Slice*>(block.data())->data, false);
+    _pool->clear();
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
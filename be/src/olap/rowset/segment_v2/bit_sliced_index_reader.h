@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <roaring/roaring.hh>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "io/fs/file_reader.h"
+#include "olap/column_block.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
+#include "runtime/mem_pool.h"
+
+namespace doris {
+
+class TypeInfo;
+
+namespace segment_v2 {
+
+class BitSlicedIndexIterator;
+
+// Reader of the bit-sliced bitmap index written by BitSlicedIndexWriter.
+class BitSlicedIndexReader {
+public:
+    explicit BitSlicedIndexReader(io::FileReaderSPtr file_reader,
+                                  const BitSlicedIndexPB* bit_sliced_index_meta,
+                                  FieldType field_type)
+            : _file_reader(std::move(file_reader)),
+              _type_info(get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>()),
+              _bit_sliced_index_meta(bit_sliced_index_meta),
+              _field_type(field_type) {}
+
+    Status load(bool use_page_cache, bool kept_in_memory);
+
+    // create a new index iterator. Client should delete returned iterator
+    Status new_iterator(BitSlicedIndexIterator** iterator);
+
+    const TypeInfo* type_info() { return _type_info; }
+
+private:
+    friend class BitSlicedIndexIterator;
+
+    io::FileReaderSPtr _file_reader;
+    const TypeInfo* _type_info;
+    const BitSlicedIndexPB* _bit_sliced_index_meta;
+    FieldType _field_type;
+    std::unique_ptr<IndexedColumnReader> _bitmap_column_reader;
+};
+
+class BitSlicedIndexIterator {
+public:
+    explicit BitSlicedIndexIterator(BitSlicedIndexReader* reader)
+            : _reader(reader),
+              _bitmap_column_iter(reader->_bitmap_column_reader.get()),
+              _pool(new MemPool()) {}
+
+    // Compares the rows of the segment to *value, of the CppType of the column: sets *less to
+    // the rows whose value is less than *value, *equal to the rows whose value is equal to it,
+    // and *not_null to the rows with a value. The rows that are greater are *not_null minus
+    // *less and *equal. The bitmaps of at most all the bits of the keys are read.
+    Status compare(const void* value, roaring::Roaring* less, roaring::Roaring* equal,
+                   roaring::Roaring* not_null);
+
+private:
+    Status _read_bitmap(rowid_t ordinal, roaring::Roaring* result);
+
+    BitSlicedIndexReader* _reader;
+    IndexedColumnIterator _bitmap_column_iter;
+    std::unique_ptr<MemPool> _pool;
+};
+
+} // namespace segment_v2
+} // namespace doris
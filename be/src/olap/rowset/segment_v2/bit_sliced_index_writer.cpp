@@ -0,0 +1,181 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/bit_sliced_index_writer.h"
+
+#include <algorithm>
+#include <roaring/roaring.hh>
+#include <vector>
+
+#include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/indexed_column_writer.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+namespace {
+
+template <FieldType field_type>
+class BitSlicedIndexWriterImpl : public BitmapIndexWriter {
+public:
+    using CppType = typename CppTypeTraits<field_type>::CppType;
+
+    ~BitSlicedIndexWriterImpl() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        auto p = reinterpret_cast<const CppType*>(values);
+        for (size_t i = 0; i < count; ++i) {
+            _keys.push_back(BitSlicedIndexWriter::key<field_type>(p + i));
+        }
+        _not_null_bitmap.addRange(_rid, _rid + count);
+        _rid += count;
+    }
+
+    void add_nulls(uint32_t count) override {
+        _keys.resize(_keys.size() + count, 0);
+        _rid += count;
+    }
+
+    Status finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta) override {
+        index_meta->set_type(BIT_SLICED_INDEX);
+        BitSlicedIndexPB* meta = index_meta->mutable_bit_sliced_index();
+
+        uint64_t min_key = UINT64_MAX;
+        uint64_t max_key = 0;
+        for (rowid_t rid : _not_null_bitmap) {
+            min_key = std::min(min_key, _keys[rid]);
+            max_key = std::max(max_key, _keys[rid]);
+        }
+        uint32_t bit_width = 0;
+        if (min_key < max_key) {
+            bit_width = 64 - __builtin_clzll(max_key - min_key);
+        } else {
+            min_key = std::min(min_key, max_key);
+        }
+        meta->set_min_key(min_key);
+        meta->set_bit_width(bit_width);
+
+        std::vector<roaring::Roaring> bitmaps(bit_width + 1);
+        bitmaps[0] = std::move(_not_null_bitmap);
+        // the rows of the bits are added in order, which roaring appends cheaply
+        for (rowid_t rid : bitmaps[0]) {
+            uint64_t bits = _keys[rid] - min_key;
+            while (bits != 0) {
+                bitmaps[__builtin_ctzll(bits) + 1].add(rid);
+                bits &= bits - 1;
+            }
+        }
+
+        const auto* bitmap_type_info = get_scalar_type_info<OLAP_FIELD_TYPE_OBJECT>();
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = EncodingInfo::get_default_encoding(bitmap_type_info, false);
+        // we already store compressed bitmap, use NO_COMPRESSION to save some cpu
+        options.compression = NO_COMPRESSION;
+
+        IndexedColumnWriter bitmap_column_writer(options, bitmap_type_info, file_writer);
+        RETURN_IF_ERROR(bitmap_column_writer.init());
+        faststring buf;
+        for (auto& bitmap : bitmaps) {
+            bitmap.runOptimize();
+            buf.resize(bitmap.getSizeInBytes(false));
+            bitmap.write(reinterpret_cast<char*>(buf.data()), false);
+            Slice buf_slice(buf);
+            RETURN_IF_ERROR(bitmap_column_writer.add(&buf_slice));
+        }
+        return bitmap_column_writer.finish(meta->mutable_bitmap_column());
+    }
+
+    uint64_t size() const override {
+        return _keys.capacity() * sizeof(uint64_t) + _not_null_bitmap.getSizeInBytes(false);
+    }
+
+private:
+    rowid_t _rid = 0;
+    // the key of each row, 0 for the null rows
+    std::vector<uint64_t> _keys;
+    roaring::Roaring _not_null_bitmap;
+};
+
+} // namespace
+
+bool BitSlicedIndexWriter::is_supported(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATEV2:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_DATETIMEV2:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+#define APPLY_FOR_BIT_SLICED_INDEX_TYPES(M) \
+    M(OLAP_FIELD_TYPE_TINYINT)              \
+    M(OLAP_FIELD_TYPE_SMALLINT)             \
+    M(OLAP_FIELD_TYPE_INT)                  \
+    M(OLAP_FIELD_TYPE_BIGINT)               \
+    M(OLAP_FIELD_TYPE_DATE)                 \
+    M(OLAP_FIELD_TYPE_DATEV2)               \
+    M(OLAP_FIELD_TYPE_DATETIME)             \
+    M(OLAP_FIELD_TYPE_DATETIMEV2)           \
+    M(OLAP_FIELD_TYPE_DECIMAL32)            \
+    M(OLAP_FIELD_TYPE_DECIMAL64)
+
+Status BitSlicedIndexWriter::create(const TypeInfo* type_info,
+                                    std::unique_ptr<BitmapIndexWriter>* res) {
+    FieldType type = type_info->type();
+    switch (type) {
+#define M(TYPE)                                           \
+    case TYPE:                                            \
+        res->reset(new BitSlicedIndexWriterImpl<TYPE>()); \
+        break;
+        APPLY_FOR_BIT_SLICED_INDEX_TYPES(M)
+#undef M
+    default:
+        return Status::NotSupported("unsupported type for bit-sliced bitmap index: {}",
+                                    std::to_string(type));
+    }
+    return Status::OK();
+}
+
+uint64_t BitSlicedIndexWriter::key(FieldType type, const void* value) {
+    switch (type) {
+#define M(TYPE) \
+    case TYPE:  \
+        return key<TYPE>(value);
+        APPLY_FOR_BIT_SLICED_INDEX_TYPES(M)
+#undef M
+    default:
+        DCHECK(false) << "unsupported type for bit-sliced bitmap index: " << type;
+        return 0;
+    }
+}
+
+} // namespace segment_v2
+} // namespace doris
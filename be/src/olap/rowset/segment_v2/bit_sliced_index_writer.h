@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "common/status.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/bitmap_index_writer.h"
+#include "olap/types.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// Builder for the bit-sliced form of the bitmap index of an integer, decimal or date column,
+// which answers range predicates with a number of bitmap operations that depends on the number
+// of bits of the values instead of the number of distinct values.
+//
+// Each value is mapped to an unsigned key in the same order, and the index stores the rows with
+// a value, followed by one bitmap per bit of key - min_key, the rows having that bit set.
+//
+// E.g, if the column contains 4 rows [5, 7, null, 4], the keys minus min key 4 are [1, 3, -, 0],
+// and the bitmaps are
+//   rows with a value : [1 1 0 1]
+//   bit 0             : [1 1 0 0]
+//   bit 1             : [0 1 0 0]
+class BitSlicedIndexWriter {
+public:
+    static bool is_supported(FieldType type);
+
+    static Status create(const TypeInfo* type_info, std::unique_ptr<BitmapIndexWriter>* res);
+
+    // The key of *value, of the CppType of the column of type field_type. The signed values are
+    // offset by 2^63, so the keys compare as the values.
+    template <FieldType field_type>
+    static uint64_t key(const void* value) {
+        using CppType = typename CppTypeTraits<field_type>::CppType;
+        const auto& v = *reinterpret_cast<const CppType*>(value);
+        if constexpr (std::is_same_v<CppType, uint24_t>) {
+            return static_cast<uint32_t>(v);
+        } else if constexpr (std::is_signed_v<CppType>) {
+            return static_cast<uint64_t>(static_cast<int64_t>(v)) ^ (1ULL << 63);
+        } else {
+            return static_cast<uint64_t>(v);
+        }
+    }
+
+    // The key of *value of a column of type, which has to be supported.
+    static uint64_t key(FieldType type, const void* value);
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -19,6 +19,7 @@
 
 #include <map>
 #include <roaring/roaring.hh>
+#include <unordered_set>
 
 #include "olap/rowset/segment_v2/bloom_filter.h" // for BloomFilterOptions, BloomFilter
 #include "olap/rowset/segment_v2/common.h"
@@ -168,8 +169,97 @@ private:
     std::vector<std::unique_ptr<BloomFilter>> _bfs;
 };
 
+// Builder for ngram bloom filter. It has the same layout as the bloom filter index, a filter
+// by data page, but the filter of a page has the hashes of the substrings of gram_size bytes of
+// its values instead of the values.
+class NgramBloomFilterIndexWriterImpl : public BloomFilterIndexWriter {
+public:
+    NgramBloomFilterIndexWriterImpl(const BloomFilterOptions& bf_options, uint32_t gram_size)
+            : _bf_options(bf_options), _gram_size(gram_size) {}
+
+    ~NgramBloomFilterIndexWriterImpl() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        const Slice* v = (const Slice*)values;
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t pos = 0; pos + _gram_size <= v[i].size; ++pos) {
+                uint64_t hash_code;
+                murmur_hash3_x64_64(v[i].data + pos, _gram_size, BloomFilter::DEFAULT_SEED,
+                                    &hash_code);
+                _hashes.insert(hash_code);
+            }
+        }
+    }
+
+    void add_nulls(uint32_t count) override {}
+
+    Status flush() override {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(_hashes.size(), _bf_options.fpp, _bf_options.strategy));
+        for (auto hash_code : _hashes) {
+            bf->add_hash(hash_code);
+        }
+        _bf_buffer_size += bf->size();
+        _bfs.push_back(std::move(bf));
+        _hashes.clear();
+        return Status::OK();
+    }
+
+    Status finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta) override {
+        if (_hashes.size() > 0) {
+            RETURN_IF_ERROR(flush());
+        }
+        index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+        BloomFilterIndexPB* meta = index_meta->mutable_ngram_bloom_filter_index();
+        meta->set_hash_strategy(_bf_options.strategy);
+        meta->set_algorithm(BLOCK_BLOOM_FILTER);
+        meta->set_gram_size(_gram_size);
+
+        const auto* bf_type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = PLAIN_ENCODING;
+        IndexedColumnWriter bf_writer(options, bf_type_info, file_writer);
+        RETURN_IF_ERROR(bf_writer.init());
+        for (auto& bf : _bfs) {
+            Slice data(bf->data(), bf->size());
+            RETURN_IF_ERROR(bf_writer.add(&data));
+        }
+        RETURN_IF_ERROR(bf_writer.finish(meta->mutable_bloom_filter()));
+        return Status::OK();
+    }
+
+    uint64_t size() override { return _bf_buffer_size + _hashes.size() * sizeof(uint64_t); }
+
+private:
+    BloomFilterOptions _bf_options;
+    const uint32_t _gram_size;
+    uint64_t _bf_buffer_size = 0;
+    // the distinct ngrams of the current page
+    std::unordered_set<uint64_t> _hashes;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
 } // namespace
 
+Status BloomFilterIndexWriter::create_ngram(const BloomFilterOptions& bf_options,
+                                            const TypeInfo* type_info, uint32_t gram_size,
+                                            std::unique_ptr<BloomFilterIndexWriter>* res) {
+    FieldType type = type_info->type();
+    if (type != OLAP_FIELD_TYPE_CHAR && type != OLAP_FIELD_TYPE_VARCHAR &&
+        type != OLAP_FIELD_TYPE_STRING) {
+        return Status::NotSupported("unsupported type for ngram bloom filter index: {}",
+                                    std::to_string(type));
+    }
+    if (gram_size == 0) {
+        return Status::InvalidArgument("invalid gram size of ngram bloom filter index: 0");
+    }
+    res->reset(new NgramBloomFilterIndexWriterImpl(bf_options, gram_size));
+    return Status::OK();
+}
+
 // TODO currently we don't support bloom filter index for tinyint/hll/float/double
 Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options,
                                       const TypeInfo* type_info,
@@ -41,6 +41,12 @@ public:
     static Status create(const BloomFilterOptions& bf_options, const TypeInfo* type_info,
                          std::unique_ptr<BloomFilterIndexWriter>* res);
 
+    // Creates the writer of an ngram bloom filter index, whose filter of a page has all the
+    // substrings of gram_size bytes of its values, so that it can tell the pages which can't
+    // match a LIKE pattern.
+    static Status create_ngram(const BloomFilterOptions& bf_options, const TypeInfo* type_info,
+                               uint32_t gram_size, std::unique_ptr<BloomFilterIndexWriter>* res);
+
     BloomFilterIndexWriter() = default;
     virtual ~BloomFilterIndexWriter() = default;
 
@@ -19,13 +19,17 @@
 
 #include "io/fs/file_reader.h"
 #include "olap/column_block.h"                       // for ColumnBlockView
+#include "olap/column_predicate.h"
+#include "olap/page_cache.h"
 #include "olap/rowset/segment_v2/binary_dict_page.h" // for BinaryDictPageDecoder
 #include "olap/rowset/segment_v2/bloom_filter_index_reader.h"
 #include "olap/rowset/segment_v2/encoding_info.h" // for EncodingInfo
 #include "olap/rowset/segment_v2/page_handle.h"   // for PageHandle
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/page_pointer.h" // for PagePointer
-#include "olap/types.h"                          // for TypeInfo
+#include "olap/segment_meta_cache.h"
+#include "olap/types.h" // for TypeInfo
+#include "runtime/exec_env.h"
 #include "util/block_compression.h"
 #include "util/rle_encoding.h" // for RleDecoder
 #include "vec/columns/column.h"
@@ -121,6 +125,15 @@ Status ColumnReader::init() {
         case BLOOM_FILTER_INDEX:
             _bf_index_meta = &index_meta.bloom_filter_index();
             break;
+        case INVERTED_INDEX:
+            _inverted_index_meta = &index_meta.inverted_index();
+            break;
+        case NGRAM_BLOOM_FILTER_INDEX:
+            _ngram_bf_index_meta = &index_meta.ngram_bloom_filter_index();
+            break;
+        case BIT_SLICED_INDEX:
+            _bit_sliced_index_meta = &index_meta.bit_sliced_index();
+            break;
         default:
             return Status::Corruption("Bad file {}: invalid column index type {}",
                                       _file_reader->path().native(), index_meta.type());
@@ -135,12 +148,66 @@ Status ColumnReader::init() {
     return Status::OK();
 }
 
+void ColumnReader::add_index_file(io::FileReaderSPtr file_reader, const ColumnIndexesPB& indexes) {
+    _index_file_reader = std::move(file_reader);
+    _index_file_indexes = indexes;
+    for (auto& index_meta : _index_file_indexes.indexes()) {
+        switch (index_meta.type()) {
+        case BITMAP_INDEX:
+            if (_bitmap_index_meta != nullptr || _bit_sliced_index_meta != nullptr) {
+                continue;
+            }
+            _bitmap_index_meta = &index_meta.bitmap_index();
+            break;
+        case BIT_SLICED_INDEX:
+            if (_bitmap_index_meta != nullptr || _bit_sliced_index_meta != nullptr) {
+                continue;
+            }
+            _bit_sliced_index_meta = &index_meta.bit_sliced_index();
+            break;
+        case BLOOM_FILTER_INDEX:
+            if (_bf_index_meta != nullptr) {
+                continue;
+            }
+            _bf_index_meta = &index_meta.bloom_filter_index();
+            break;
+        case INVERTED_INDEX:
+            if (_inverted_index_meta != nullptr) {
+                continue;
+            }
+            _inverted_index_meta = &index_meta.inverted_index();
+            break;
+        case NGRAM_BLOOM_FILTER_INDEX:
+            if (_ngram_bf_index_meta != nullptr) {
+                continue;
+            }
+            _ngram_bf_index_meta = &index_meta.ngram_bloom_filter_index();
+            break;
+        default:
+            continue;
+        }
+        _index_file_types |= 1U << index_meta.type();
+    }
+}
+
 Status ColumnReader::new_bitmap_index_iterator(BitmapIndexIterator** iterator) {
     RETURN_IF_ERROR(_ensure_index_loaded());
     RETURN_IF_ERROR(_bitmap_index->new_iterator(iterator));
     return Status::OK();
 }
 
+Status ColumnReader::new_inverted_index_iterator(InvertedIndexIterator** iterator) {
+    RETURN_IF_ERROR(_ensure_index_loaded());
+    RETURN_IF_ERROR(_inverted_index->new_iterator(iterator));
+    return Status::OK();
+}
+
+Status ColumnReader::new_bit_sliced_index_iterator(BitSlicedIndexIterator** iterator) {
+    RETURN_IF_ERROR(_ensure_index_loaded());
+    RETURN_IF_ERROR(_bit_sliced_index->new_iterator(iterator));
+    return Status::OK();
+}
+
 Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
                                PageHandle* handle, Slice* page_body, PageFooterPB* footer,
                                BlockCompressionCodec* codec) const {
@@ -152,6 +219,7 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     opts.stats = iter_opts.stats;
     opts.verify_checksum = _opts.verify_checksum;
     opts.use_page_cache = iter_opts.use_page_cache;
+    opts.bulk_scan = iter_opts.bulk_scan;
     opts.kept_in_memory = _opts.kept_in_memory;
     opts.type = iter_opts.type;
     opts.encoding_info = _encoding_info;
@@ -267,24 +335,37 @@ Status ColumnReader::get_row_ranges_by_bloom_filter(CondColumn* cond_column,
     RowRanges bf_row_ranges;
     std::unique_ptr<BloomFilterIndexIterator> bf_iter;
     RETURN_IF_ERROR(_bloom_filter_index->new_iterator(&bf_iter));
-    size_t range_size = row_ranges->range_size();
     // get covered page ids
     std::set<uint32_t> page_ids;
-    for (int i = 0; i < range_size; ++i) {
-        int64_t from = row_ranges->get_range_from(i);
-        int64_t idx = from;
-        int64_t to = row_ranges->get_range_to(i);
-        auto iter = _ordinal_index->seek_at_or_before(from);
-        while (idx < to && iter.valid()) {
-            page_ids.insert(iter.page_index());
-            idx = iter.last_ordinal() + 1;
-            iter.next();
+    _get_page_ids(*row_ranges, &page_ids);
+    for (auto& pid : page_ids) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+        if (cond_column->eval(bf.get())) {
+            bf_row_ranges.add(RowRange(_ordinal_index->get_first_ordinal(pid),
+                                       _ordinal_index->get_last_ordinal(pid) + 1));
         }
     }
+    RowRanges::ranges_intersection(*row_ranges, bf_row_ranges, row_ranges);
+    return Status::OK();
+}
+
+Status ColumnReader::get_row_ranges_by_ngram_bloom_filter(const ColumnPredicate* predicate,
+                                                          RowRanges* row_ranges) {
+    uint32_t gram_size = _ngram_bf_index_meta->gram_size();
+    if (!predicate->can_do_ngram_bloom_filter(gram_size)) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_ensure_index_loaded());
+    RowRanges bf_row_ranges;
+    std::unique_ptr<BloomFilterIndexIterator> bf_iter;
+    RETURN_IF_ERROR(_ngram_bloom_filter_index->new_iterator(&bf_iter));
+    std::set<uint32_t> page_ids;
+    _get_page_ids(*row_ranges, &page_ids);
     for (auto& pid : page_ids) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
-        if (cond_column->eval(bf.get())) {
+        if (predicate->evaluate_ngram_bloom_filter(bf.get(), gram_size)) {
             bf_row_ranges.add(RowRange(_ordinal_index->get_first_ordinal(pid),
                                        _ordinal_index->get_last_ordinal(pid) + 1));
         }
@@ -293,31 +374,151 @@ Status ColumnReader::get_row_ranges_by_bloom_filter(CondColumn* cond_column,
     return Status::OK();
 }
 
+void ColumnReader::_get_page_ids(const RowRanges& row_ranges, std::set<uint32_t>* page_ids) {
+    size_t range_size = row_ranges.range_size();
+    for (int i = 0; i < range_size; ++i) {
+        int64_t from = row_ranges.get_range_from(i);
+        int64_t idx = from;
+        int64_t to = row_ranges.get_range_to(i);
+        auto iter = _ordinal_index->seek_at_or_before(from);
+        while (idx < to && iter.valid()) {
+            page_ids->insert(iter.page_index());
+            idx = iter.last_ordinal() + 1;
+            iter.next();
+        }
+    }
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     DCHECK(_ordinal_index_meta != nullptr);
-    _ordinal_index.reset(new OrdinalIndexReader(_file_reader, _ordinal_index_meta, _num_rows));
-    return _ordinal_index->load(use_page_cache, kept_in_memory);
+    auto meta_cache = SegmentMetaCache::instance();
+    std::string cache_key;
+    if (meta_cache != nullptr) {
+        cache_key = SegmentMetaCache::key(_file_reader->path().native(),
+                                          SegmentMetaCache::ORDINAL_INDEX,
+                                          _ordinal_index_meta->root_page().root_page().offset());
+        _ordinal_index = meta_cache->lookup<OrdinalIndexReader>(cache_key);
+        if (_ordinal_index != nullptr) {
+            return Status::OK();
+        }
+    }
+    auto ordinal_index =
+            std::make_shared<OrdinalIndexReader>(_file_reader, _ordinal_index_meta, _num_rows);
+    RETURN_IF_ERROR(ordinal_index->load(use_page_cache, kept_in_memory));
+    if (meta_cache != nullptr) {
+        meta_cache->insert(cache_key, ordinal_index, ordinal_index->mem_usage(), kept_in_memory);
+    }
+    _ordinal_index = std::move(ordinal_index);
+    return Status::OK();
+}
+
+int64_t ColumnReader::null_count() const {
+    if (_zone_map_index_meta == nullptr) {
+        return -1;
+    }
+    const auto& zone_map = _zone_map_index_meta->segment_zone_map();
+    if (!zone_map.has_null()) {
+        return 0;
+    }
+    return zone_map.has_null_count() ? zone_map.null_count() : -1;
+}
+
+bool ColumnReader::get_segment_min_max(WrapperField* min_value, WrapperField* max_value) const {
+    if (_zone_map_index_meta == nullptr) {
+        return false;
+    }
+    const auto& zone_map = _zone_map_index_meta->segment_zone_map();
+    if (!zone_map.has_not_null() || zone_map.pass_all()) {
+        return false;
+    }
+    return min_value->from_string(zone_map.min()).ok() &&
+           max_value->from_string(zone_map.max()).ok();
+}
+
+Status ColumnReader::estimate_ndv(int64_t* ndv) const {
+    *ndv = -1;
+    if (_zone_map_index_meta == nullptr) {
+        return Status::OK();
+    }
+    HyperLogLog sketch;
+    bool has_sketch = false;
+    RETURN_IF_ERROR(ZoneMapIndexReader::load_ndv_sketch(_file_reader, *_zone_map_index_meta,
+                                                        &sketch, &has_sketch));
+    if (has_sketch) {
+        *ndv = sketch.estimate_cardinality();
+    }
+    return Status::OK();
 }
 
 Status ColumnReader::_load_zone_map_index(bool use_page_cache, bool kept_in_memory) {
-    if (_zone_map_index_meta != nullptr) {
-        _zone_map_index.reset(new ZoneMapIndexReader(_file_reader, _zone_map_index_meta));
-        return _zone_map_index->load(use_page_cache, kept_in_memory);
+    if (_zone_map_index_meta == nullptr) {
+        return Status::OK();
+    }
+    auto meta_cache = SegmentMetaCache::instance();
+    std::string cache_key;
+    if (meta_cache != nullptr) {
+        const auto& root_page =
+                _zone_map_index_meta->page_zone_maps().ordinal_index_meta().root_page();
+        cache_key = SegmentMetaCache::key(_file_reader->path().native(),
+                                          SegmentMetaCache::ZONE_MAP_INDEX,
+                                          root_page.root_page().offset());
+        _zone_map_index = meta_cache->lookup<ZoneMapIndexReader>(cache_key);
+        if (_zone_map_index != nullptr) {
+            return Status::OK();
+        }
+    }
+    auto zone_map_index = std::make_shared<ZoneMapIndexReader>(_file_reader, _zone_map_index_meta);
+    RETURN_IF_ERROR(zone_map_index->load(use_page_cache, kept_in_memory));
+    if (meta_cache != nullptr) {
+        meta_cache->insert(cache_key, zone_map_index, zone_map_index->mem_usage(),
+                           kept_in_memory);
     }
+    _zone_map_index = std::move(zone_map_index);
     return Status::OK();
 }
 
 Status ColumnReader::_load_bitmap_index(bool use_page_cache, bool kept_in_memory) {
     if (_bitmap_index_meta != nullptr) {
-        _bitmap_index.reset(new BitmapIndexReader(_file_reader, _bitmap_index_meta));
+        _bitmap_index.reset(
+                new BitmapIndexReader(_index_file_reader_of(BITMAP_INDEX), _bitmap_index_meta));
         return _bitmap_index->load(use_page_cache, kept_in_memory);
     }
     return Status::OK();
 }
 
+Status ColumnReader::_load_inverted_index(bool use_page_cache, bool kept_in_memory) {
+    if (_inverted_index_meta != nullptr) {
+        _inverted_index.reset(new InvertedIndexReader(_index_file_reader_of(INVERTED_INDEX),
+                                                      _inverted_index_meta));
+        return _inverted_index->load(use_page_cache, kept_in_memory);
+    }
+    return Status::OK();
+}
+
+Status ColumnReader::_load_bit_sliced_index(bool use_page_cache, bool kept_in_memory) {
+    if (_bit_sliced_index_meta != nullptr) {
+        _bit_sliced_index.reset(new BitSlicedIndexReader(_index_file_reader_of(BIT_SLICED_INDEX),
+                                                         _bit_sliced_index_meta,
+                                                         (FieldType)_meta.type()));
+        return _bit_sliced_index->load(use_page_cache, kept_in_memory);
+    }
+    return Status::OK();
+}
+
+Status ColumnReader::_load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
+    if (_ngram_bf_index_meta != nullptr) {
+        _ngram_bloom_filter_index.reset(
+                new BloomFilterIndexReader(_index_file_reader_of(NGRAM_BLOOM_FILTER_INDEX),
+                                           _ngram_bf_index_meta));
+        return _ngram_bloom_filter_index->load(use_page_cache, kept_in_memory);
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
     if (_bf_index_meta != nullptr) {
-        _bloom_filter_index.reset(new BloomFilterIndexReader(_file_reader, _bf_index_meta));
+        _bloom_filter_index.reset(new BloomFilterIndexReader(
+                _index_file_reader_of(BLOOM_FILTER_INDEX), _bf_index_meta));
         return _bloom_filter_index->load(use_page_cache, kept_in_memory);
     }
     return Status::OK();
@@ -521,6 +722,13 @@ FileColumnIterator::FileColumnIterator(ColumnReader* reader) : _reader(reader) {
 Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
     RETURN_IF_ERROR(get_block_compression_codec(_reader->get_compression(), _compress_codec));
+    if (_opts.prefetch && config::enable_remote_prefetch) {
+        auto pool = ExecEnv::GetInstance()->remote_prefetch_thread_pool();
+        if (pool != nullptr) {
+            _prefetch_reader = std::make_unique<io::PrefetchFileReader>(_opts.file_reader, pool);
+            _opts.file_reader = _prefetch_reader.get();
+        }
+    }
     if (config::enable_low_cardinality_optimize &&
         _reader->encoding_info()->encoding() == DICT_ENCODING) {
         auto dict_encoding_type = _reader->get_dict_encoding_type();
@@ -542,6 +750,7 @@ FileColumnIterator::~FileColumnIterator() = default;
 Status FileColumnIterator::seek_to_first() {
     RETURN_IF_ERROR(_reader->seek_to_first(&_page_iter));
     RETURN_IF_ERROR(_read_data_page(_page_iter));
+    _prefetch_pages();
 
     _seek_to_pos_in_page(&_page, 0);
     _current_ordinal = 0;
@@ -553,6 +762,7 @@ Status FileColumnIterator::seek_to_ordinal(ordinal_t ord) {
     if (!_page || !_page.contains(ord) || !_page_iter.valid()) {
         RETURN_IF_ERROR(_reader->seek_at_or_before(ord, &_page_iter));
         RETURN_IF_ERROR(_read_data_page(_page_iter));
+        _prefetch_pages();
     }
     _seek_to_pos_in_page(&_page, ord - _page.first_ordinal);
     _current_ordinal = ord;
@@ -787,6 +997,61 @@ Status FileColumnIterator::read_by_rowids(const rowid_t* rowids, const size_t co
     return Status::OK();
 }
 
+Status FileColumnIterator::evaluate_predicates(const std::vector<ColumnPredicate*>& predicates,
+                                               size_t* n, vectorized::MutableColumnPtr& scratch,
+                                               bool* flags) {
+    DCHECK(!predicates.empty());
+    size_t remaining = *n;
+    while (remaining > 0) {
+        if (!_page.has_remaining()) {
+            bool eos = false;
+            RETURN_IF_ERROR(_load_next_page(&eos));
+            if (eos) {
+                break;
+            }
+        }
+
+        // number of rows to be evaluated in this page
+        size_t nrows_in_page = std::min(remaining, _page.remaining());
+        size_t nrows_to_read = nrows_in_page;
+        scratch->clear();
+        Status st = Status::NotSupported("evaluate_predicates not implement");
+        if (!_page.has_null) {
+            st = _page.data_decoder->evaluate_predicates(predicates, &nrows_to_read, scratch,
+                                                         flags);
+        }
+        if (st.ok()) {
+            DCHECK_EQ(nrows_to_read, nrows_in_page);
+            _page.offset_in_page += nrows_to_read;
+            _current_ordinal += nrows_to_read;
+        } else if (st.code() == TStatusCode::NOT_IMPLEMENTED_ERROR) {
+            // decode the rows of this page, the nulls included, and evaluate them
+            scratch->clear();
+            bool has_null = false;
+            RETURN_IF_ERROR(next_batch(&nrows_to_read, scratch, &has_null));
+            DCHECK_EQ(nrows_to_read, nrows_in_page);
+            predicates[0]->evaluate_vec(*scratch, nrows_to_read, flags);
+            for (size_t i = 1; i < predicates.size(); ++i) {
+                predicates[i]->evaluate_and_vec(*scratch, nrows_to_read, flags);
+            }
+        } else {
+            return st;
+        }
+        flags += nrows_in_page;
+        remaining -= nrows_in_page;
+    }
+    *n -= remaining;
+    return Status::OK();
+}
+
+bool FileColumnIterator::can_evaluate_predicates_on_pages() const {
+    // the dictionary pages fall back to fsst pages when the dictionary is full
+    auto encoding = _reader->encoding_info()->encoding();
+    return encoding == RLE || encoding == FSST_ENCODING ||
+           (encoding == DICT_ENCODING && config::enable_fsst_string_encoding &&
+            !_is_all_dict_encoding);
+}
+
 Status FileColumnIterator::_load_next_page(bool* eos) {
     _page_iter.next();
     if (!_page_iter.valid()) {
@@ -795,11 +1060,64 @@ Status FileColumnIterator::_load_next_page(bool* eos) {
     }
 
     RETURN_IF_ERROR(_read_data_page(_page_iter));
+    _prefetch_pages();
     _seek_to_pos_in_page(&_page, 0);
     *eos = false;
     return Status::OK();
 }
 
+void FileColumnIterator::_prefetch_pages() {
+    if (_prefetch_reader == nullptr) {
+        return;
+    }
+    int32_t cur = _page_iter.page_index();
+    uint64_t cur_end = _page_iter.page().offset + _page_iter.page().size;
+    if (_prefetch_begin < 0 || cur + 1 < _prefetch_begin || cur >= _prefetch_iter.page_index()) {
+        // seek out of the prefetched pages
+        _prefetch_reader->reset();
+        _prefetch_begin = cur + 1;
+        _prefetch_iter = _page_iter;
+        _prefetch_iter.next();
+        _prefetch_end_offset = cur_end;
+    }
+
+    // the pages in the page cache are not read from the file
+    std::string file_name = _opts.file_reader->path().native();
+    auto is_cached = [&](const PagePointer& pp) {
+        if (!_opts.use_page_cache || config::disable_storage_page_cache) {
+            return false;
+        }
+        PageCacheHandle handle;
+        return StoragePageCache::instance()->lookup(
+                StoragePageCache::CacheKey(file_name, pp.offset), &handle, DATA_PAGE);
+    };
+    uint64_t max_range_bytes = config::remote_prefetch_max_range_bytes;
+    uint64_t max_gap_bytes = config::remote_prefetch_max_gap_bytes;
+    while (_prefetch_iter.valid() &&
+           _prefetch_end_offset < cur_end + config::remote_prefetch_window_bytes) {
+        const PagePointer& first = _prefetch_iter.page();
+        _prefetch_iter.next();
+        if (is_cached(first)) {
+            _prefetch_end_offset = first.offset + first.size;
+            continue;
+        }
+        // coalesce the following pages close enough into one read
+        uint64_t begin = first.offset;
+        uint64_t end = first.offset + first.size;
+        while (_prefetch_iter.valid()) {
+            const PagePointer& pp = _prefetch_iter.page();
+            if (pp.offset < end || pp.offset > end + max_gap_bytes ||
+                pp.offset + pp.size - begin > max_range_bytes || is_cached(pp)) {
+                break;
+            }
+            end = pp.offset + pp.size;
+            _prefetch_iter.next();
+        }
+        _prefetch_reader->prefetch(begin, end - begin);
+        _prefetch_end_offset = end;
+    }
+}
+
 Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter) {
     PageHandle handle;
     Slice page_body;
@@ -865,6 +1183,14 @@ Status FileColumnIterator::get_row_ranges_by_bloom_filter(CondColumn* cond_colum
     return Status::OK();
 }
 
+Status FileColumnIterator::get_row_ranges_by_ngram_bloom_filter(const ColumnPredicate* predicate,
+                                                                RowRanges* row_ranges) {
+    if (_reader->has_ngram_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->get_row_ranges_by_ngram_bloom_filter(predicate, row_ranges));
+    }
+    return Status::OK();
+}
+
 Status DefaultValueColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
     // be consistent with segment v1
@@ -25,8 +25,11 @@
 #include "common/status.h"         // for Status
 #include "gen_cpp/segment_v2.pb.h" // for ColumnMetaPB
 #include "io/fs/file_reader.h"
+#include "io/fs/prefetch_file_reader.h"
 #include "olap/olap_cond.h"                             // for CondColumn
+#include "olap/rowset/segment_v2/bit_sliced_index_reader.h" // for BitSlicedIndexReader
 #include "olap/rowset/segment_v2/bitmap_index_reader.h" // for BitmapIndexReader
+#include "olap/rowset/segment_v2/inverted_index_reader.h" // for InvertedIndexReader
 #include "olap/rowset/segment_v2/common.h"
 #include "olap/rowset/segment_v2/ordinal_page_index.h" // for OrdinalPageIndexIterator
 #include "olap/rowset/segment_v2/page_handle.h"        // for PageHandle
@@ -40,6 +43,7 @@
 namespace doris {
 
 class ColumnBlock;
+class ColumnPredicate;
 class TypeInfo;
 class BlockCompressionCodec;
 class WrapperField;
@@ -68,6 +72,10 @@ struct ColumnIteratorOptions {
     // reader statistics
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
+    // whether the pages read are cached at probation priority
+    bool bulk_scan = false;
+    // whether the data pages are read ahead asynchronously, for the files on remote storage
+    bool prefetch = false;
     // for page cache allocation
     // page types are divided into DATA_PAGE & INDEX_PAGE
     // INDEX_PAGE including index_page, dict_page and short_key_page
@@ -99,6 +107,10 @@ public:
     Status new_iterator(ColumnIterator** iterator);
     // Client should delete returned iterator
     Status new_bitmap_index_iterator(BitmapIndexIterator** iterator);
+    // Client should delete returned iterator
+    Status new_inverted_index_iterator(InvertedIndexIterator** iterator);
+    // Client should delete returned iterator
+    Status new_bit_sliced_index_iterator(BitSlicedIndexIterator** iterator);
 
     // Seek to the first entry in the column.
     Status seek_to_first(OrdinalPageIndexIterator* iter);
@@ -116,12 +128,32 @@ public:
     bool has_zone_map() const { return _zone_map_index_meta != nullptr; }
     bool has_bitmap_index() const { return _bitmap_index_meta != nullptr; }
     bool has_bloom_filter_index() const { return _bf_index_meta != nullptr; }
+    bool has_inverted_index() const { return _inverted_index_meta != nullptr; }
+    bool has_ngram_bloom_filter_index() const { return _ngram_bf_index_meta != nullptr; }
+    bool has_bit_sliced_index() const { return _bit_sliced_index_meta != nullptr; }
+
+    // Adds the indexes of the column built into the index file of its segment after the segment
+    // was written, see SegmentIndexFile. It's called before the indexes are loaded, and the
+    // indexes the segment file has already are kept.
+    void add_index_file(io::FileReaderSPtr file_reader, const ColumnIndexesPB& indexes);
 
     // Check if this column could match `cond' using segment zone map.
     // Since segment zone map is stored in metadata, this function is fast without I/O.
     // Return true if segment zone map is absent or `cond' could be satisfied, false otherwise.
     bool match_condition(CondColumn* cond) const;
 
+    // The number of nulls of the column in the segment from its zone map, or -1 when the zone
+    // map is absent or written without the null count.
+    int64_t null_count() const;
+
+    // Sets `min_value` and `max_value` to the not-null min and max of the column in the segment
+    // from its zone map. Returns false when the zone map is absent or has no not-null value.
+    bool get_segment_min_max(WrapperField* min_value, WrapperField* max_value) const;
+
+    // Estimates the number of distinct not-null values of the column in the segment from the
+    // sketch of its zone map index. *ndv is -1 when the segment is written without a sketch.
+    Status estimate_ndv(int64_t* ndv) const;
+
     // get row ranges with zone map
     // - cond_column is user's query predicate
     // - delete_condition is a delete predicate of one version
@@ -131,6 +163,11 @@ public:
     // get row ranges with bloom filter index
     Status get_row_ranges_by_bloom_filter(CondColumn* cond_column, RowRanges* row_ranges);
 
+    // Removes from `row_ranges` the pages whose ngram bloom filter tells they can't match
+    // `predicate`.
+    Status get_row_ranges_by_ngram_bloom_filter(const ColumnPredicate* predicate,
+                                                RowRanges* row_ranges);
+
     PagePointer get_dict_page_pointer() const { return _meta.dict_page(); }
 
     bool is_empty() const { return _num_rows == 0; }
@@ -159,6 +196,10 @@ private:
             RETURN_IF_ERROR(_load_ordinal_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bitmap_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(_load_inverted_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(
+                    _load_ngram_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(_load_bit_sliced_index(use_page_cache, _opts.kept_in_memory));
             return Status::OK();
         });
     }
@@ -167,6 +208,17 @@ private:
     Status _load_ordinal_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bitmap_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_inverted_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_bit_sliced_index(bool use_page_cache, bool kept_in_memory);
+
+    // the reader of the file holding the index of type
+    const io::FileReaderSPtr& _index_file_reader_of(ColumnIndexTypePB type) const {
+        return (_index_file_types & (1U << type)) != 0 ? _index_file_reader : _file_reader;
+    }
+
+    // the ids of the pages having rows of `row_ranges`
+    void _get_page_ids(const RowRanges& row_ranges, std::set<uint32_t>* page_ids);
 
     bool _zone_map_match_condition(const ZoneMapPB& zone_map, WrapperField* min_value_container,
                                    WrapperField* max_value_container, CondColumn* cond) const;
@@ -185,6 +237,10 @@ private:
     uint64_t _num_rows;
 
     io::FileReaderSPtr _file_reader;
+    // the index file of the segment, and the indexes and their types read from it
+    io::FileReaderSPtr _index_file_reader;
+    ColumnIndexesPB _index_file_indexes;
+    uint32_t _index_file_types = 0;
 
     DictEncodingType _dict_encoding_type;
 
@@ -198,12 +254,19 @@ private:
     const OrdinalIndexPB* _ordinal_index_meta = nullptr;
     const BitmapIndexPB* _bitmap_index_meta = nullptr;
     const BloomFilterIndexPB* _bf_index_meta = nullptr;
+    const InvertedIndexPB* _inverted_index_meta = nullptr;
+    const BloomFilterIndexPB* _ngram_bf_index_meta = nullptr;
+    const BitSlicedIndexPB* _bit_sliced_index_meta = nullptr;
 
     DorisCallOnce<Status> _load_index_once;
-    std::unique_ptr<ZoneMapIndexReader> _zone_map_index;
-    std::unique_ptr<OrdinalIndexReader> _ordinal_index;
+    // shared with the SegmentMetaCache
+    std::shared_ptr<ZoneMapIndexReader> _zone_map_index;
+    std::shared_ptr<OrdinalIndexReader> _ordinal_index;
     std::unique_ptr<BitmapIndexReader> _bitmap_index;
     std::unique_ptr<BloomFilterIndexReader> _bloom_filter_index;
+    std::unique_ptr<InvertedIndexReader> _inverted_index;
+    std::unique_ptr<BloomFilterIndexReader> _ngram_bloom_filter_index;
+    std::unique_ptr<BitSlicedIndexReader> _bit_sliced_index;
 
     std::vector<std::unique_ptr<ColumnReader>> _sub_readers;
 
@@ -254,6 +317,17 @@ public:
         return Status::NotSupported("read_by_rowids not implement");
     }
 
+    // Evaluate the AND of `predicates` on the next `*n` rows, and move forward like `next_batch`.
+    // `flags` receives the result of every row, `scratch` is a predicate column of the column
+    // type used to hold the values to evaluate.
+    virtual Status evaluate_predicates(const std::vector<ColumnPredicate*>& predicates, size_t* n,
+                                       vectorized::MutableColumnPtr& scratch, bool* flags) {
+        return Status::NotSupported("evaluate_predicates not implement");
+    }
+
+    // Whether `evaluate_predicates` works on the encoded pages without decoding every value.
+    virtual bool can_evaluate_predicates_on_pages() const { return false; }
+
     virtual ordinal_t get_current_ordinal() const = 0;
 
     virtual Status get_row_ranges_by_zone_map(CondColumn* cond_column, CondColumn* delete_condition,
@@ -261,6 +335,11 @@ public:
         return Status::OK();
     }
 
+    virtual Status get_row_ranges_by_ngram_bloom_filter(const ColumnPredicate* predicate,
+                                                        RowRanges* row_ranges) {
+        return Status::OK();
+    }
+
     virtual Status get_row_ranges_by_bloom_filter(CondColumn* cond_column, RowRanges* row_ranges) {
         return Status::OK();
     }
@@ -293,6 +372,11 @@ public:
     Status read_by_rowids(const rowid_t* rowids, const size_t count,
                           vectorized::MutableColumnPtr& dst) override;
 
+    Status evaluate_predicates(const std::vector<ColumnPredicate*>& predicates, size_t* n,
+                               vectorized::MutableColumnPtr& scratch, bool* flags) override;
+
+    bool can_evaluate_predicates_on_pages() const override;
+
     ordinal_t get_current_ordinal() const override { return _current_ordinal; }
 
     // get row ranges by zone map
@@ -303,6 +387,9 @@ public:
 
     Status get_row_ranges_by_bloom_filter(CondColumn* cond_column, RowRanges* row_ranges) override;
 
+    Status get_row_ranges_by_ngram_bloom_filter(const ColumnPredicate* predicate,
+                                                RowRanges* row_ranges) override;
+
     ParsedPage* get_current_page() { return &_page; }
 
     bool is_nullable() { return _reader->is_nullable(); }
@@ -313,6 +400,8 @@ private:
     void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page) const;
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
+    // Prefetch the data pages after the current one, up to remote_prefetch_window_bytes.
+    void _prefetch_pages();
 
 private:
     ColumnReader* _reader;
@@ -335,6 +424,13 @@ private:
     // This value will be reset when a new seek is issued
     OrdinalPageIndexIterator _page_iter;
 
+    // reads the data pages ahead of the decoder if _opts.prefetch is set
+    std::unique_ptr<io::PrefetchFileReader> _prefetch_reader;
+    // the prefetched pages are [_prefetch_begin, _prefetch_iter), ending at _prefetch_end_offset
+    int32_t _prefetch_begin = -1;
+    OrdinalPageIndexIterator _prefetch_iter;
+    uint64_t _prefetch_end_offset = 0;
+
     // current value ordinal
     ordinal_t _current_ordinal = 0;
 
@@ -22,10 +22,12 @@
 #include "common/logging.h"
 #include "env/env.h"
 #include "gutil/strings/substitute.h"
+#include "olap/rowset/segment_v2/bit_sliced_index_writer.h"
 #include "olap/rowset/segment_v2/bitmap_index_writer.h"
 #include "olap/rowset/segment_v2/bloom_filter.h"
 #include "olap/rowset/segment_v2/bloom_filter_index_writer.h"
 #include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/inverted_index_writer.h"
 #include "olap/rowset/segment_v2/options.h"
 #include "olap/rowset/segment_v2/ordinal_page_index.h"
 #include "olap/rowset/segment_v2/page_builder.h"
@@ -265,6 +267,12 @@ ScalarColumnWriter::~ScalarColumnWriter() {
 
 Status ScalarColumnWriter::init() {
     RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), _compress_codec));
+    _page_codec = _compress_codec.get();
+    _page_codec_type = _opts.meta->compression();
+    if (_opts.compression_sample_pages > 0 && _compress_codec != nullptr &&
+        _opts.meta->compression() != ZSTD) {
+        RETURN_IF_ERROR(get_block_compression_codec(ZSTD, _candidate_codec));
+    }
 
     PageBuilder* page_builder = nullptr;
 
@@ -292,7 +300,10 @@ Status ScalarColumnWriter::init() {
     if (_opts.need_zone_map) {
         _zone_map_index_builder.reset(new ZoneMapIndexWriter(get_field()));
     }
-    if (_opts.need_bitmap_index) {
+    if (_opts.need_bitmap_index && _opts.bit_sliced_bitmap_index) {
+        RETURN_IF_ERROR(
+                BitSlicedIndexWriter::create(get_field()->type_info(), &_bitmap_index_builder));
+    } else if (_opts.need_bitmap_index) {
         RETURN_IF_ERROR(
                 BitmapIndexWriter::create(get_field()->type_info(), &_bitmap_index_builder));
     }
@@ -300,6 +311,16 @@ Status ScalarColumnWriter::init() {
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(
                 BloomFilterOptions(), get_field()->type_info(), &_bloom_filter_index_builder));
     }
+    if (_opts.need_inverted_index) {
+        RETURN_IF_ERROR(InvertedIndexWriter::create(
+                get_field()->type_info(), _opts.inverted_index_parser,
+                _opts.inverted_index_gram_size, &_inverted_index_builder));
+    }
+    if (_opts.ngram_bf_gram_size > 0) {
+        RETURN_IF_ERROR(BloomFilterIndexWriter::create_ngram(
+                BloomFilterOptions(), get_field()->type_info(), _opts.ngram_bf_gram_size,
+                &_ngram_bloom_filter_index_builder));
+    }
     return Status::OK();
 }
 
@@ -315,6 +336,9 @@ Status ScalarColumnWriter::append_nulls(size_t num_rows) {
     if (_opts.need_bloom_filter) {
         _bloom_filter_index_builder->add_nulls(num_rows);
     }
+    if (_opts.need_inverted_index) {
+        _inverted_index_builder->add_nulls(num_rows);
+    }
     return Status::OK();
 }
 
@@ -347,6 +371,12 @@ Status ScalarColumnWriter::append_data_in_current_page(const uint8_t** ptr, size
     if (_opts.need_bloom_filter) {
         _bloom_filter_index_builder->add_values(*ptr, *num_written);
     }
+    if (_opts.need_inverted_index) {
+        _inverted_index_builder->add_values(*ptr, *num_written);
+    }
+    if (_opts.ngram_bf_gram_size > 0) {
+        _ngram_bloom_filter_index_builder->add_values(*ptr, *num_written);
+    }
 
     _next_rowid += *num_written;
     *ptr += get_field()->size() * (*num_written);
@@ -369,6 +399,12 @@ Status ScalarColumnWriter::append_data_in_current_page(const uint8_t* ptr, size_
     if (_opts.need_bloom_filter) {
         _bloom_filter_index_builder->add_values(ptr, *num_written);
     }
+    if (_opts.need_inverted_index) {
+        _inverted_index_builder->add_values(ptr, *num_written);
+    }
+    if (_opts.ngram_bf_gram_size > 0) {
+        _ngram_bloom_filter_index_builder->add_values(ptr, *num_written);
+    }
 
     _next_rowid += *num_written;
     if (is_nullable()) {
@@ -393,6 +429,12 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_opts.need_bloom_filter) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_opts.need_inverted_index) {
+        size += _inverted_index_builder->size();
+    }
+    if (_opts.ngram_bf_gram_size > 0) {
+        size += _ngram_bloom_filter_index_builder->size();
+    }
     return size;
 }
 
@@ -452,6 +494,21 @@ Status ScalarColumnWriter::write_bloom_filter_index() {
     return Status::OK();
 }
 
+Status ScalarColumnWriter::write_inverted_index() {
+    if (_opts.need_inverted_index) {
+        return _inverted_index_builder->finish(_file_writer, _opts.meta->add_indexes());
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::write_ngram_bloom_filter_index() {
+    if (_opts.ngram_bf_gram_size > 0) {
+        return _ngram_bloom_filter_index_builder->finish(_file_writer,
+                                                         _opts.meta->add_indexes());
+    }
+    return Status::OK();
+}
+
 // write a data page into file and update ordinal index
 Status ScalarColumnWriter::_write_data_page(Page* page) {
     PagePointer pp;
@@ -479,6 +536,10 @@ Status ScalarColumnWriter::finish_current_page() {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
     }
 
+    if (_opts.ngram_bf_gram_size > 0) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->flush());
+    }
+
     // build data page body : encoded values + [nullmap]
     std::vector<Slice> body;
     OwnedSlice encoded_values = _page_builder->finish();
@@ -507,8 +568,7 @@ Status ScalarColumnWriter::finish_current_page() {
     }
     // trying to compress page body
     OwnedSlice compressed_body;
-    RETURN_IF_ERROR(PageIO::compress_page_body(
-            _compress_codec.get(), _opts.compression_min_space_saving, body, &compressed_body));
+    RETURN_IF_ERROR(_compress_page_body(body, &page->footer, &compressed_body));
     if (compressed_body.slice().empty()) {
         // page body is uncompressed
         page->data.emplace_back(std::move(encoded_values));
@@ -523,6 +583,59 @@ Status ScalarColumnWriter::finish_current_page() {
     return Status::OK();
 }
 
+Status ScalarColumnWriter::_compress_page_body(const std::vector<Slice>& body,
+                                               PageFooterPB* footer, OwnedSlice* compressed_body) {
+    RETURN_IF_ERROR(PageIO::compress_page_body(_page_codec, _opts.compression_min_space_saving,
+                                               body, compressed_body));
+    if (_page_codec != _compress_codec.get() && !compressed_body->slice().empty()) {
+        footer->set_compression(_page_codec_type);
+    }
+    if (_num_sampled_pages < _opts.compression_sample_pages && _compress_codec != nullptr) {
+        RETURN_IF_ERROR(_sample_page_body(body, compressed_body->slice().get_size()));
+    }
+    return Status::OK();
+}
+
+// `compressed_size` is the size of the page body compressed by the codec of the column, 0 if it
+// is not compressed.
+Status ScalarColumnWriter::_sample_page_body(const std::vector<Slice>& body,
+                                             size_t compressed_size) {
+    size_t raw_size = Slice::compute_total_size(body);
+    _sampled_raw_bytes += raw_size;
+    _sampled_bytes += compressed_size == 0 ? raw_size : compressed_size;
+    if (_candidate_codec != nullptr) {
+        OwnedSlice candidate_body;
+        RETURN_IF_ERROR(
+                PageIO::compress_page_body(_candidate_codec.get(), 0, body, &candidate_body));
+        size_t candidate_size = candidate_body.slice().get_size();
+        _sampled_candidate_bytes += candidate_size == 0 ? raw_size : candidate_size;
+    }
+    if (++_num_sampled_pages == _opts.compression_sample_pages) {
+        _choose_page_codec();
+    }
+    return Status::OK();
+}
+
+void ScalarColumnWriter::_choose_page_codec() {
+    if (_sampled_raw_bytes == 0) {
+        return;
+    }
+    if (_candidate_codec != nullptr &&
+        _sampled_candidate_bytes <= _sampled_bytes * _opts.zstd_max_size_ratio) {
+        _page_codec = _candidate_codec.get();
+        _page_codec_type = ZSTD;
+    } else if (1.0 - static_cast<double>(_sampled_bytes) / _sampled_raw_bytes <
+               _opts.compression_min_space_saving) {
+        _page_codec = nullptr;
+    }
+    VLOG_DEBUG << "column " << _opts.meta->column_id() << " samples " << _num_sampled_pages
+               << " pages of " << _sampled_raw_bytes << " bytes, compressed to " << _sampled_bytes
+               << " bytes by its codec and " << _sampled_candidate_bytes
+               << " bytes by zstd, the later pages are "
+               << (_page_codec == nullptr ? "uncompressed" : "compressed by ")
+               << (_page_codec == nullptr ? "" : CompressionTypePB_Name(_page_codec_type));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ArrayColumnWriter::ArrayColumnWriter(const ColumnWriterOptions& opts, std::unique_ptr<Field> field,
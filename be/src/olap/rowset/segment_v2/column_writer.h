@@ -47,22 +47,40 @@ struct ColumnWriterOptions {
     // store compressed page only when space saving is above the threshold.
     // space saving = 1 - compressed_size / uncompressed_size
     double compression_min_space_saving = 0.1;
+    // the number of the first data pages on which the codecs are evaluated, 0 to always use the
+    // codec of the column. The later pages use ZSTD if it makes the samples at most
+    // `zstd_max_size_ratio` of their size by the codec of the column, or they are stored
+    // uncompressed if neither codec saves `compression_min_space_saving` on them.
+    uint32_t compression_sample_pages = 0;
+    double zstd_max_size_ratio = 0.7;
     bool need_zone_map = false;
     bool need_bitmap_index = false;
+    // whether the bitmap index is bit-sliced, see BitSlicedIndexWriter
+    bool bit_sliced_bitmap_index = false;
     bool need_bloom_filter = false;
+    bool need_inverted_index = false;
+    // the length of the substrings of the ngram bloom filter index, 0 for no index
+    uint32_t ngram_bf_gram_size = 0;
+    InvertedIndexParserPB inverted_index_parser = UNICODE_PARSER;
+    uint32_t inverted_index_gram_size = 0;
     std::string to_string() const {
         std::stringstream ss;
         ss << std::boolalpha << "meta=" << meta->DebugString()
            << ", data_page_size=" << data_page_size
            << ", compression_min_space_saving = " << compression_min_space_saving
+           << ", compression_sample_pages=" << compression_sample_pages
            << ", need_zone_map=" << need_zone_map << ", need_bitmap_index=" << need_bitmap_index
-           << ", need_bloom_filter" << need_bloom_filter;
+           << ", bit_sliced_bitmap_index=" << bit_sliced_bitmap_index
+           << ", need_bloom_filter" << need_bloom_filter
+           << ", need_inverted_index=" << need_inverted_index
+           << ", ngram_bf_gram_size=" << ngram_bf_gram_size;
         return ss.str();
     }
 };
 
 class BitmapIndexWriter;
 class EncodingInfo;
+class InvertedIndexWriter;
 class NullBitmapBuilder;
 class OrdinalIndexWriter;
 class PageBuilder;
@@ -128,6 +146,10 @@ public:
 
     virtual Status write_bloom_filter_index() = 0;
 
+    virtual Status write_inverted_index() = 0;
+
+    virtual Status write_ngram_bloom_filter_index() = 0;
+
     virtual ordinal_t get_next_rowid() const = 0;
 
     // used for append not null data.
@@ -181,6 +203,8 @@ public:
     Status write_zone_map() override;
     Status write_bitmap_index() override;
     Status write_bloom_filter_index() override;
+    Status write_inverted_index() override;
+    Status write_ngram_bloom_filter_index() override;
     ordinal_t get_next_rowid() const override { return _next_rowid; }
 
     void register_flush_page_callback(FlushPageCallback* flush_page_callback) {
@@ -236,6 +260,10 @@ private:
     }
 
     Status _write_data_page(Page* page);
+    Status _compress_page_body(const std::vector<Slice>& body, PageFooterPB* footer,
+                               OwnedSlice* compressed_body);
+    Status _sample_page_body(const std::vector<Slice>& body, size_t compressed_size);
+    void _choose_page_codec();
 
 private:
     io::FileWriter* _file_writer = nullptr;
@@ -247,11 +275,22 @@ private:
     ordinal_t _first_rowid = 0;
 
     std::unique_ptr<BlockCompressionCodec> _compress_codec;
+    // the codec of the data pages after the sample pages, null to store them uncompressed
+    const BlockCompressionCodec* _page_codec = nullptr;
+    CompressionTypePB _page_codec_type;
+    // the codec evaluated against the one of the column on the sample pages
+    std::unique_ptr<BlockCompressionCodec> _candidate_codec;
+    uint32_t _num_sampled_pages = 0;
+    uint64_t _sampled_raw_bytes = 0;
+    uint64_t _sampled_bytes = 0;
+    uint64_t _sampled_candidate_bytes = 0;
 
     std::unique_ptr<OrdinalIndexWriter> _ordinal_index_builder;
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
+    std::unique_ptr<InvertedIndexWriter> _inverted_index_builder;
+    std::unique_ptr<BloomFilterIndexWriter> _ngram_bloom_filter_index_builder;
 
     // call before flush data page.
     FlushPageCallback* _new_page_callback = nullptr;
@@ -304,6 +343,18 @@ public:
         }
         return Status::OK();
     }
+    Status write_inverted_index() override {
+        if (_opts.need_inverted_index) {
+            return Status::NotSupported("array not support inverted index");
+        }
+        return Status::OK();
+    }
+    Status write_ngram_bloom_filter_index() override {
+        if (_opts.ngram_bf_gram_size > 0) {
+            return Status::NotSupported("array not support ngram bloom filter index");
+        }
+        return Status::OK();
+    }
     ordinal_t get_next_rowid() const override { return _length_writer->get_next_rowid(); }
 
 private:
@@ -21,7 +21,9 @@
 
 #include "gutil/strings/substitute.h"
 #include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/adaptive_page.h"
 #include "olap/rowset/segment_v2/binary_dict_page.h"
+#include "olap/rowset/segment_v2/binary_fsst_page.h"
 #include "olap/rowset/segment_v2/binary_plain_page.h"
 #include "olap/rowset/segment_v2/binary_prefix_page.h"
 #include "olap/rowset/segment_v2/bitshuffle_page.h"
@@ -163,6 +165,20 @@ struct TypeEncodingTraits<type, FOR_ENCODING, CppType,
     }
 };
 
+template <FieldType type, typename CppType>
+struct TypeEncodingTraits<type, ADAPTIVE_ENCODING, CppType,
+                          typename std::enable_if<std::is_arithmetic<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new AdaptivePageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts,
+                                      PageDecoder** decoder) {
+        *decoder = new AdaptivePageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
 template <FieldType type>
 struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
@@ -176,6 +192,19 @@ struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     }
 };
 
+template <FieldType type>
+struct TypeEncodingTraits<type, FSST_ENCODING, Slice> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new BinaryFsstPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts,
+                                      PageDecoder** decoder) {
+        *decoder = new BinaryFsstPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
 template <FieldType field_type, EncodingTypePB encoding_type>
 struct EncodingTraits : TypeEncodingTraits<field_type, encoding_type,
                                            typename CppTypeTraits<field_type>::CppType> {
@@ -234,18 +263,22 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<OLAP_FIELD_TYPE_TINYINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_TINYINT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_TINYINT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_TINYINT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_SMALLINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_SMALLINT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_SMALLINT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_SMALLINT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_INT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_INT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_INT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_INT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_BIGINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_BIGINT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_BIGINT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_UNSIGNED_BIGINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_UNSIGNED_INT, BIT_SHUFFLE>();
@@ -257,9 +290,11 @@ EncodingInfoResolver::EncodingInfoResolver() {
 
     _add_map<OLAP_FIELD_TYPE_FLOAT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_FLOAT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_FLOAT, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_DOUBLE, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DOUBLE, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DOUBLE, ADAPTIVE_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_CHAR, DICT_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_CHAR, PLAIN_ENCODING>();
@@ -268,10 +303,12 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<OLAP_FIELD_TYPE_VARCHAR, DICT_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_VARCHAR, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_VARCHAR, PREFIX_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_VARCHAR, FSST_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_STRING, DICT_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_STRING, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_STRING, PREFIX_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_STRING, FSST_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_BOOL, RLE>();
     _add_map<OLAP_FIELD_TYPE_BOOL, BIT_SHUFFLE>();
@@ -284,10 +321,12 @@ EncodingInfoResolver::EncodingInfoResolver() {
 
     _add_map<OLAP_FIELD_TYPE_DATEV2, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DATEV2, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DATEV2, ADAPTIVE_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_DATEV2, FOR_ENCODING, true>();
 
     _add_map<OLAP_FIELD_TYPE_DATETIME, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DATETIME, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DATETIME, ADAPTIVE_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_DATETIME, FOR_ENCODING, true>();
 
     _add_map<OLAP_FIELD_TYPE_DECIMAL, BIT_SHUFFLE>();
@@ -296,10 +335,12 @@ EncodingInfoResolver::EncodingInfoResolver() {
 
     _add_map<OLAP_FIELD_TYPE_DECIMAL32, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DECIMAL32, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DECIMAL32, ADAPTIVE_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_DECIMAL32, BIT_SHUFFLE, true>();
 
     _add_map<OLAP_FIELD_TYPE_DECIMAL64, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DECIMAL64, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_DECIMAL64, ADAPTIVE_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_DECIMAL64, BIT_SHUFFLE, true>();
 
     _add_map<OLAP_FIELD_TYPE_DECIMAL128, BIT_SHUFFLE>();
@@ -40,14 +40,18 @@ Status IndexedColumnReader::load(bool use_page_cache, bool kept_in_memory) {
     RETURN_IF_ERROR(EncodingInfo::get(_type_info, _meta.encoding(), &_encoding_info));
     _value_key_coder = get_key_coder(_type_info->type());
 
+    // the root pages of the ordinal index and the value index are read together
+    std::vector<PagePointer> index_pages;
+    std::vector<PageHandle*> index_page_handles;
+    std::vector<IndexPageReader*> index_page_readers;
     // read and parse ordinal index page when exists
     if (_meta.has_ordinal_index_meta()) {
         if (_meta.ordinal_index_meta().is_root_data_page()) {
             _sole_data_page = PagePointer(_meta.ordinal_index_meta().root_page());
         } else {
-            RETURN_IF_ERROR(load_index_page(_meta.ordinal_index_meta().root_page(),
-                                            &_ordinal_index_page_handle, &_ordinal_index_reader));
-            _has_index_page = true;
+            index_pages.emplace_back(_meta.ordinal_index_meta().root_page());
+            index_page_handles.push_back(&_ordinal_index_page_handle);
+            index_page_readers.push_back(&_ordinal_index_reader);
         }
     }
 
@@ -56,24 +60,46 @@ Status IndexedColumnReader::load(bool use_page_cache, bool kept_in_memory) {
         if (_meta.value_index_meta().is_root_data_page()) {
             _sole_data_page = PagePointer(_meta.value_index_meta().root_page());
         } else {
-            RETURN_IF_ERROR(load_index_page(_meta.value_index_meta().root_page(),
-                                            &_value_index_page_handle, &_value_index_reader));
-            _has_index_page = true;
+            index_pages.emplace_back(_meta.value_index_meta().root_page());
+            index_page_handles.push_back(&_value_index_page_handle);
+            index_page_readers.push_back(&_value_index_reader);
         }
     }
+    if (!index_pages.empty()) {
+        RETURN_IF_ERROR(load_index_pages(index_pages, index_page_handles, index_page_readers));
+        _has_index_page = true;
+    }
     _num_values = _meta.num_values();
     return Status::OK();
 }
 
-Status IndexedColumnReader::load_index_page(const PagePointerPB& pp, PageHandle* handle,
-                                            IndexPageReader* reader) {
-    Slice body;
-    PageFooterPB footer;
+Status IndexedColumnReader::load_index_pages(const std::vector<PagePointer>& pps,
+                                             const std::vector<PageHandle*>& handles,
+                                             const std::vector<IndexPageReader*>& readers) {
     std::unique_ptr<BlockCompressionCodec> local_compress_codec;
     RETURN_IF_ERROR(get_block_compression_codec(_meta.compression(), local_compress_codec));
-    RETURN_IF_ERROR(read_page(PagePointer(pp), handle, &body, &footer, INDEX_PAGE,
-                              local_compress_codec.get()));
-    RETURN_IF_ERROR(reader->parse(body, footer.index_page_footer()));
+    OlapReaderStatistics tmp_stats;
+    std::vector<PageReadOptions> opts(pps.size());
+    for (size_t i = 0; i < pps.size(); ++i) {
+        opts[i].file_reader = _file_reader.get();
+        opts[i].page_pointer = pps[i];
+        opts[i].codec = local_compress_codec.get();
+        opts[i].stats = &tmp_stats;
+        opts[i].use_page_cache = _use_page_cache;
+        opts[i].kept_in_memory = _kept_in_memory;
+        opts[i].type = INDEX_PAGE;
+        opts[i].encoding_info = _encoding_info;
+    }
+
+    std::vector<PageHandle> page_handles(pps.size());
+    std::vector<Slice> bodies(pps.size());
+    std::vector<PageFooterPB> footers(pps.size());
+    RETURN_IF_ERROR(PageIO::read_and_decompress_pages(opts, page_handles.data(), bodies.data(),
+                                                      footers.data()));
+    for (size_t i = 0; i < pps.size(); ++i) {
+        *handles[i] = std::move(page_handles[i]);
+        RETURN_IF_ERROR(readers[i]->parse(bodies[i], footers[i].index_page_footer()));
+    }
     return Status::OK();
 }
 
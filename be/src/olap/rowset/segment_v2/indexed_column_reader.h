@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "common/status.h"
 #include "env/env.h"
@@ -65,7 +66,10 @@ public:
     CompressionTypePB get_compression() const { return _meta.compression(); }
 
 private:
-    Status load_index_page(const PagePointerPB& pp, PageHandle* handle, IndexPageReader* reader);
+    // read the index pages `pps' together, and parse them into `readers'
+    Status load_index_pages(const std::vector<PagePointer>& pps,
+                            const std::vector<PageHandle*>& handles,
+                            const std::vector<IndexPageReader*>& readers);
 
     friend class IndexedColumnIterator;
 
@@ -0,0 +1,227 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/inverted_index_parser.h"
+
+#include <algorithm>
+
+namespace doris {
+namespace segment_v2 {
+
+namespace {
+
+// the terms are the runs of characters between the whitespaces, or the NUL padding of CHAR
+class WhitespaceParser : public InvertedIndexParser {
+protected:
+    void _parse(const Slice& text, std::vector<InvertedIndexTerm>* terms) const override {
+        size_t begin = 0;
+        for (size_t i = 0; i <= text.size; ++i) {
+            if (i == text.size || _is_separator(text.data[i])) {
+                if (i > begin) {
+                    terms->push_back({begin, i, false});
+                }
+                begin = i + 1;
+            }
+        }
+    }
+
+private:
+    static bool _is_separator(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f' ||
+               c == '\0';
+    }
+};
+
+// the terms are the runs of letters and digits, and each CJK character is a term of its own since
+// these languages don't separate their words
+class UnicodeParser : public InvertedIndexParser {
+protected:
+    void _parse(const Slice& text, std::vector<InvertedIndexTerm>* terms) const override {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data);
+        size_t word_begin = 0;
+        size_t i = 0;
+        while (i < text.size) {
+            size_t length = 0;
+            uint32_t code_point = _decode(data + i, text.size - i, &length);
+            CharClass char_class = _classify(code_point);
+            if (char_class != WORD) {
+                if (i > word_begin) {
+                    terms->push_back({word_begin, i, false});
+                }
+                if (char_class == SINGLE) {
+                    terms->push_back({i, i + length, true});
+                }
+                word_begin = i + length;
+            }
+            i += length;
+        }
+        if (text.size > word_begin) {
+            terms->push_back({word_begin, text.size, false});
+        }
+    }
+
+private:
+    enum CharClass { WORD, SEPARATOR, SINGLE };
+
+    // the code point of the character at 'data', or the byte itself if it isn't valid UTF-8
+    static uint32_t _decode(const uint8_t* data, size_t size, size_t* length) {
+        size_t n = utf8_char_length(data[0]);
+        if (n == 1 || n > size) {
+            *length = 1;
+            return data[0];
+        }
+        uint32_t code_point = data[0] & (0x7F >> n);
+        for (size_t i = 1; i < n; ++i) {
+            if ((data[i] & 0xC0) != 0x80) {
+                *length = 1;
+                return data[0];
+            }
+            code_point = (code_point << 6) | (data[i] & 0x3F);
+        }
+        *length = n;
+        return code_point;
+    }
+
+    static CharClass _classify(uint32_t c) {
+        if (c < 0x80) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+                           ? WORD
+                           : SEPARATOR;
+        }
+        if ((c >= 0x2000 && c <= 0x206F) || (c >= 0x3000 && c <= 0x303F) ||
+            (c >= 0xFF00 && c <= 0xFF0F) || (c >= 0xFF1A && c <= 0xFF20) ||
+            (c >= 0xFF3B && c <= 0xFF40) || (c >= 0xFF5B && c <= 0xFF65)) {
+            // general, CJK and full width punctuations
+            return SEPARATOR;
+        }
+        if ((c >= 0x3040 && c <= 0x30FF) || (c >= 0x3400 && c <= 0x4DBF) ||
+            (c >= 0x4E00 && c <= 0x9FFF) || (c >= 0xAC00 && c <= 0xD7AF) ||
+            (c >= 0xF900 && c <= 0xFAFF) || (c >= 0x20000 && c <= 0x2FFFF)) {
+            // kana, CJK ideographs and hangul
+            return SINGLE;
+        }
+        return WORD;
+    }
+};
+
+// the terms are all the substrings of gram_size characters
+class NgramParser : public InvertedIndexParser {
+public:
+    explicit NgramParser(uint32_t gram_size) : _gram_size(gram_size) {}
+
+protected:
+    void _parse(const Slice& text, std::vector<InvertedIndexTerm>* terms) const override {
+        std::vector<size_t> char_begins;
+        for (size_t i = 0; i < text.size;) {
+            char_begins.push_back(i);
+            i += std::min(utf8_char_length(text.data[i]), text.size - i);
+        }
+        char_begins.push_back(text.size);
+        for (size_t i = 0; i + _gram_size < char_begins.size(); ++i) {
+            terms->push_back({char_begins[i], char_begins[i + _gram_size], true});
+        }
+    }
+
+private:
+    const uint32_t _gram_size;
+};
+
+} // namespace
+
+Status InvertedIndexParser::parse_type(const std::string& name, InvertedIndexParserPB* type) {
+    if (name == "whitespace") {
+        *type = WHITESPACE_PARSER;
+    } else if (name == "unicode") {
+        *type = UNICODE_PARSER;
+    } else if (name == "ngram") {
+        *type = NGRAM_PARSER;
+    } else {
+        return Status::NotSupported("unsupported inverted index parser: {}", name);
+    }
+    return Status::OK();
+}
+
+Status InvertedIndexParser::create(InvertedIndexParserPB type, uint32_t gram_size,
+                                   std::unique_ptr<InvertedIndexParser>* parser) {
+    switch (type) {
+    case WHITESPACE_PARSER:
+        parser->reset(new WhitespaceParser());
+        break;
+    case UNICODE_PARSER:
+        parser->reset(new UnicodeParser());
+        break;
+    case NGRAM_PARSER:
+        if (gram_size == 0 || gram_size > MAX_TERM_LENGTH / 4) {
+            return Status::InvalidArgument("invalid gram size of inverted index: {}", gram_size);
+        }
+        parser->reset(new NgramParser(gram_size));
+        break;
+    default:
+        return Status::NotSupported("unsupported inverted index parser: {}", type);
+    }
+    return Status::OK();
+}
+
+void InvertedIndexParser::parse(const Slice& text, std::vector<InvertedIndexTerm>* terms) const {
+    size_t first = terms->size();
+    _parse(text, terms);
+    terms->erase(std::remove_if(terms->begin() + first, terms->end(),
+                                [](const InvertedIndexTerm& term) {
+                                    return term.end - term.begin > MAX_TERM_LENGTH;
+                                }),
+                 terms->end());
+}
+
+void InvertedIndexParser::required_terms_of_like(const Slice& pattern,
+                                                 std::vector<std::string>* terms) const {
+    std::string text;
+    bool open_begin = false;
+    for (size_t i = 0; i < pattern.size; ++i) {
+        char c = pattern.data[i];
+        if (c == '\\' && i + 1 < pattern.size) {
+            text.push_back(pattern.data[++i]);
+        } else if (c == '%' || c == '_') {
+            _required_terms(text, open_begin, true, terms);
+            text.clear();
+            open_begin = true;
+        } else {
+            text.push_back(c);
+        }
+    }
+    _required_terms(text, open_begin, false, terms);
+}
+
+void InvertedIndexParser::required_terms_of_value(const Slice& value,
+                                                  std::vector<std::string>* terms) const {
+    _required_terms(value, false, false, terms);
+}
+
+void InvertedIndexParser::_required_terms(const Slice& text, bool open_begin, bool open_end,
+                                          std::vector<std::string>* terms) const {
+    std::vector<InvertedIndexTerm> text_terms;
+    parse(text, &text_terms);
+    for (auto& term : text_terms) {
+        // a word at an open end of the text may be a part of a longer word of the value
+        if (term.standalone || ((term.begin > 0 || !open_begin) &&
+                                (term.end < text.size || !open_end))) {
+            terms->emplace_back(text.data + term.begin, term.end - term.begin);
+        }
+    }
+}
+
+} // namespace segment_v2
+} // namespace doris
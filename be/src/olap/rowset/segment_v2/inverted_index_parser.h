@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+struct InvertedIndexTerm {
+    // the bytes [begin, end) of the parsed text
+    size_t begin;
+    size_t end;
+    // whether the term is a term of any text containing it, whatever the characters around it,
+    // like the ngrams or a CJK character, but not a word that may be a part of a longer word
+    bool standalone;
+};
+
+// Splits the values of a column into the terms of its inverted index. The terms are case
+// sensitive, so that they keep the semantics of LIKE and equality.
+class InvertedIndexParser {
+public:
+    // the terms longer than it are not indexed
+    static constexpr size_t MAX_TERM_LENGTH = 256;
+
+    // the parser named 'name': whitespace, unicode or ngram
+    static Status parse_type(const std::string& name, InvertedIndexParserPB* type);
+
+    static Status create(InvertedIndexParserPB type, uint32_t gram_size,
+                         std::unique_ptr<InvertedIndexParser>* parser);
+
+    virtual ~InvertedIndexParser() = default;
+
+    // Appends the terms of 'text' to 'terms'.
+    void parse(const Slice& text, std::vector<InvertedIndexTerm>* terms) const;
+
+    // Appends to 'terms' the terms that every value matching the LIKE 'pattern' has. The values
+    // having all of them are a superset of the values matching the pattern.
+    void required_terms_of_like(const Slice& pattern, std::vector<std::string>* terms) const;
+
+    // Appends to 'terms' the terms of the values equal to 'value'.
+    void required_terms_of_value(const Slice& value, std::vector<std::string>* terms) const;
+
+protected:
+    virtual void _parse(const Slice& text, std::vector<InvertedIndexTerm>* terms) const = 0;
+
+private:
+    // Appends the terms of 'text', a part of a value, to 'terms'. 'open_begin' and 'open_end'
+    // tell whether the value may have other characters before and after the text.
+    void _required_terms(const Slice& text, bool open_begin, bool open_end,
+                         std::vector<std::string>* terms) const;
+};
+
+// Returns the byte length of the UTF-8 character starting with byte 'c', or 1 if 'c' can't
+// start one.
+inline size_t utf8_char_length(uint8_t c) {
+    if (c < 0x80) {
+        return 1;
+    } else if ((c & 0xE0) == 0xC0) {
+        return 2;
+    } else if ((c & 0xF0) == 0xE0) {
+        return 3;
+    } else if ((c & 0xF8) == 0xF0) {
+        return 4;
+    }
+    return 1;
+}
+
+} // namespace segment_v2
+} // namespace doris
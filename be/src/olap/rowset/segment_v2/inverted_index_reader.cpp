@@ -0,0 +1,132 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
+
+#include "olap/types.h"
+
+namespace doris {
+namespace segment_v2 {
+
+Status InvertedIndexReader::load(bool use_page_cache, bool kept_in_memory) {
+    const IndexedColumnMetaPB& term_meta = _inverted_index_meta->term_column();
+    const IndexedColumnMetaPB& posting_meta = _inverted_index_meta->posting_column();
+    RETURN_IF_ERROR(InvertedIndexParser::create(_inverted_index_meta->parser(),
+                                                _inverted_index_meta->gram_size(), &_parser));
+
+    _term_column_reader.reset(new IndexedColumnReader(_file_reader, term_meta));
+    _posting_column_reader.reset(new IndexedColumnReader(_file_reader, posting_meta));
+    RETURN_IF_ERROR(_term_column_reader->load(use_page_cache, kept_in_memory));
+    RETURN_IF_ERROR(_posting_column_reader->load(use_page_cache, kept_in_memory));
+    return Status::OK();
+}
+
+Status InvertedIndexReader::new_iterator(InvertedIndexIterator** iterator) {
+    *iterator = new InvertedIndexIterator(this);
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::read_term(const Slice& term, roaring::Roaring* result) {
+    *result = roaring::Roaring();
+    if (_reader->term_nums() == 0) {
+        return Status::OK();
+    }
+    bool exact_match = false;
+    Status st = _term_column_iter.seek_at_or_after(&term, &exact_match);
+    if (st.is_not_found() || (st.ok() && !exact_match)) {
+        // all the terms are < term, or term is not in the dictionary
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(st);
+    return _read_posting(_term_column_iter.get_current_ordinal(), result);
+}
+
+Status InvertedIndexIterator::query(const std::vector<std::string>& terms, QueryType type,
+                                    uint32_t num_rows, roaring::Roaring* result) {
+    *result = roaring::Roaring();
+    if (terms.empty()) {
+        if (type == MATCH_ALL) {
+            result->addRange(0, num_rows);
+        }
+        return Status::OK();
+    }
+    for (size_t i = 0; i < terms.size(); ++i) {
+        roaring::Roaring bitmap;
+        RETURN_IF_ERROR(read_term(terms[i], &bitmap));
+        if (i == 0) {
+            *result = std::move(bitmap);
+        } else if (type == MATCH_ALL) {
+            *result &= bitmap;
+        } else {
+            *result |= bitmap;
+        }
+        if (type == MATCH_ALL && result->isEmpty()) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+Status InvertedIndexIterator::match_phrase(const Slice& phrase, uint32_t num_rows,
+                                           roaring::Roaring* result) {
+    std::vector<InvertedIndexTerm> parsed;
+    _reader->parser()->parse(phrase, &parsed);
+    std::vector<std::string> terms;
+    for (auto& term : parsed) {
+        terms.emplace_back(phrase.data + term.begin, term.end - term.begin);
+    }
+    return query(terms, MATCH_ALL, num_rows, result);
+}
+
+Status InvertedIndexIterator::like_candidates(const Slice& pattern, uint32_t num_rows,
+                                              roaring::Roaring* result, bool* pruned) {
+    std::vector<std::string> terms;
+    _reader->parser()->required_terms_of_like(pattern, &terms);
+    *pruned = !terms.empty();
+    return query(terms, MATCH_ALL, num_rows, result);
+}
+
+Status InvertedIndexIterator::equal_candidates(const Slice& value, uint32_t num_rows,
+                                               roaring::Roaring* result, bool* pruned) {
+    std::vector<std::string> terms;
+    _reader->parser()->required_terms_of_value(value, &terms);
+    *pruned = !terms.empty();
+    return query(terms, MATCH_ALL, num_rows, result);
+}
+
+Status InvertedIndexIterator::_read_posting(rowid_t ordinal, roaring::Roaring* result) {
+    DCHECK(0 <= ordinal && ordinal < _reader->term_nums());
+
+    size_t num_to_read = 1;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(
+            ColumnVectorBatch::create(num_to_read, false, _reader->type_info(), nullptr, &cvb));
+    ColumnBlock block(cvb.get(), _pool.get());
+    ColumnBlockView column_block_view(&block);
+
+    RETURN_IF_ERROR(_posting_column_iter.seek_to_ordinal(ordinal));
+    size_t num_read = num_to_read;
+    RETURN_IF_ERROR(_posting_column_iter.next_batch(&num_read, &column_block_view));
+    DCHECK(num_to_read == num_read);
+
+    *result = roaring::Roaring::read(reinterpret_cast<const Slice*>(block.data())->data, false);
+    _pool->clear();
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
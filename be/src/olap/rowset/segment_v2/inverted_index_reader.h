@@ -0,0 +1,112 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <roaring/roaring.hh>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "io/fs/file_reader.h"
+#include "olap/column_block.h"
+#include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
+#include "olap/rowset/segment_v2/inverted_index_parser.h"
+#include "runtime/mem_pool.h"
+
+namespace doris {
+
+class TypeInfo;
+
+namespace segment_v2 {
+
+class InvertedIndexIterator;
+
+class InvertedIndexReader {
+public:
+    explicit InvertedIndexReader(io::FileReaderSPtr file_reader,
+                                 const InvertedIndexPB* inverted_index_meta)
+            : _file_reader(std::move(file_reader)),
+              _type_info(get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>()),
+              _inverted_index_meta(inverted_index_meta) {}
+
+    Status load(bool use_page_cache, bool kept_in_memory);
+
+    // create a new column iterator. Client should delete returned iterator
+    Status new_iterator(InvertedIndexIterator** iterator);
+
+    int64_t term_nums() { return _posting_column_reader->num_values(); }
+
+    const TypeInfo* type_info() { return _type_info; }
+
+    const InvertedIndexParser* parser() const { return _parser.get(); }
+
+private:
+    friend class InvertedIndexIterator;
+
+    io::FileReaderSPtr _file_reader;
+    const TypeInfo* _type_info;
+    const InvertedIndexPB* _inverted_index_meta;
+    std::unique_ptr<InvertedIndexParser> _parser;
+    std::unique_ptr<IndexedColumnReader> _term_column_reader;
+    std::unique_ptr<IndexedColumnReader> _posting_column_reader;
+};
+
+class InvertedIndexIterator {
+public:
+    enum QueryType { MATCH_ALL, MATCH_ANY };
+
+    explicit InvertedIndexIterator(InvertedIndexReader* reader)
+            : _reader(reader),
+              _term_column_iter(reader->_term_column_reader.get()),
+              _posting_column_iter(reader->_posting_column_reader.get()),
+              _pool(new MemPool()) {}
+
+    // Read the rows containing 'term' into 'result', which is empty when no row has it.
+    Status read_term(const Slice& term, roaring::Roaring* result);
+
+    // Read the rows containing all (MATCH_ALL) or any (MATCH_ANY) of 'terms' into 'result'.
+    // No row matches an empty MATCH_ANY query, and all the rows [0, num_rows) match an empty
+    // MATCH_ALL one.
+    Status query(const std::vector<std::string>& terms, QueryType type, uint32_t num_rows,
+                 roaring::Roaring* result);
+
+    // Read into 'result' the rows that may contain the terms of 'phrase' in order. The positions
+    // of the terms are not indexed, so it is the rows containing all of them.
+    Status match_phrase(const Slice& phrase, uint32_t num_rows, roaring::Roaring* result);
+
+    // Read into 'result' the rows that may match the LIKE 'pattern', the ones having all the
+    // terms that the matching values must have. *pruned is false when the pattern has no such
+    // term, and then 'result' is all the rows [0, num_rows).
+    Status like_candidates(const Slice& pattern, uint32_t num_rows, roaring::Roaring* result,
+                           bool* pruned);
+
+    // Read into 'result' the rows that may be equal to 'value', as like_candidates().
+    Status equal_candidates(const Slice& value, uint32_t num_rows, roaring::Roaring* result,
+                            bool* pruned);
+
+private:
+    Status _read_posting(rowid_t ordinal, roaring::Roaring* result);
+
+    InvertedIndexReader* _reader;
+    IndexedColumnIterator _term_column_iter;
+    IndexedColumnIterator _posting_column_iter;
+    std::unique_ptr<MemPool> _pool;
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,126 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/inverted_index_writer.h"
+
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/indexed_column_writer.h"
+#include "olap/types.h"
+#include "util/faststring.h"
+
+namespace doris {
+namespace segment_v2 {
+
+Status InvertedIndexWriter::create(const TypeInfo* type_info, InvertedIndexParserPB parser_type,
+                                   uint32_t gram_size, std::unique_ptr<InvertedIndexWriter>* res) {
+    FieldType type = type_info->type();
+    if (type != OLAP_FIELD_TYPE_CHAR && type != OLAP_FIELD_TYPE_VARCHAR &&
+        type != OLAP_FIELD_TYPE_STRING) {
+        return Status::NotSupported("unsupported type for inverted index: {}",
+                                    std::to_string(type));
+    }
+    std::unique_ptr<InvertedIndexParser> parser;
+    RETURN_IF_ERROR(InvertedIndexParser::create(parser_type, gram_size, &parser));
+    res->reset(new InvertedIndexWriter(parser_type, gram_size, std::move(parser)));
+    return Status::OK();
+}
+
+void InvertedIndexWriter::add_values(const void* values, size_t count) {
+    auto p = reinterpret_cast<const Slice*>(values);
+    for (size_t i = 0; i < count; ++i) {
+        _add_value(p[i]);
+        _rid++;
+    }
+}
+
+void InvertedIndexWriter::_add_value(const Slice& value) {
+    _terms.clear();
+    _parser->parse(value, &_terms);
+    for (auto& term : _terms) {
+        Slice term_slice(value.data + term.begin, term.end - term.begin);
+        auto it = _mem_index.find(term_slice);
+        if (it != _mem_index.end()) {
+            uint64_t old_size = it->second.getSizeInBytes(false);
+            it->second.add(_rid);
+            _posting_size += it->second.getSizeInBytes(false) - old_size;
+        } else {
+            // new term, copy it and insert new term->bitmap pair
+            char* data = reinterpret_cast<char*>(_pool.allocate(term_slice.size));
+            memcpy(data, term_slice.data, term_slice.size);
+            auto bitmap = roaring::Roaring::bitmapOf(1, _rid);
+            _posting_size += bitmap.getSizeInBytes(false);
+            _mem_index.insert({Slice(data, term_slice.size), std::move(bitmap)});
+        }
+    }
+}
+
+Status InvertedIndexWriter::finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta) {
+    index_meta->set_type(INVERTED_INDEX);
+    InvertedIndexPB* meta = index_meta->mutable_inverted_index();
+    meta->set_parser(_parser_type);
+    meta->set_gram_size(_gram_size);
+
+    { // write terms
+        const auto* term_type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = false;
+        options.write_value_index = true;
+        options.encoding = EncodingInfo::get_default_encoding(term_type_info, true);
+        options.compression = LZ4F;
+
+        IndexedColumnWriter term_column_writer(options, term_type_info, file_writer);
+        RETURN_IF_ERROR(term_column_writer.init());
+        for (auto const& it : _mem_index) {
+            RETURN_IF_ERROR(term_column_writer.add(&(it.first)));
+        }
+        RETURN_IF_ERROR(term_column_writer.finish(meta->mutable_term_column()));
+    }
+    { // write posting lists
+        const auto* bitmap_type_info = get_scalar_type_info<OLAP_FIELD_TYPE_OBJECT>();
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = true;
+        options.write_value_index = false;
+        options.encoding = EncodingInfo::get_default_encoding(bitmap_type_info, false);
+        // we already store compressed bitmap, use NO_COMPRESSION to save some cpu
+        options.compression = NO_COMPRESSION;
+
+        IndexedColumnWriter posting_column_writer(options, bitmap_type_info, file_writer);
+        RETURN_IF_ERROR(posting_column_writer.init());
+
+        faststring buf;
+        for (auto& it : _mem_index) {
+            it.second.runOptimize();
+            buf.resize(it.second.getSizeInBytes(false));
+            it.second.write(reinterpret_cast<char*>(buf.data()), false);
+            Slice buf_slice(buf);
+            RETURN_IF_ERROR(posting_column_writer.add(&buf_slice));
+        }
+        RETURN_IF_ERROR(posting_column_writer.finish(meta->mutable_posting_column()));
+    }
+    return Status::OK();
+}
+
+uint64_t InvertedIndexWriter::size() const {
+    uint64_t size = 0;
+    size += _posting_size;
+    size += _mem_index.size() * sizeof(Slice);
+    size += _pool.total_allocated_bytes();
+    return size;
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <roaring/roaring.hh>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/macros.h"
+#include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/inverted_index_parser.h"
+#include "runtime/mem_pool.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class TypeInfo;
+
+namespace io {
+class FileWriter;
+}
+
+namespace segment_v2 {
+
+// Builder for the inverted index of a string column. Like the bitmap index, it is comprised of
+// an ordered dictionary and a posting list, but the dictionary has the terms of the values
+// instead of the values, as split by an InvertedIndexParser, and the bitmap of a term has the
+// rows whose value contains the term.
+//
+// E.g, with the whitespace parser, if the column contains 3 rows ['a b', 'b c', 'c'],
+// then the ordered dictionary would be ['a', 'b', 'c'], and the posting list
+//   bitmap for 'a' : [1 0 0]
+//   bitmap for 'b' : [1 1 0]
+//   bitmap for 'c' : [0 1 1]
+class InvertedIndexWriter {
+public:
+    static Status create(const TypeInfo* type_info, InvertedIndexParserPB parser_type,
+                         uint32_t gram_size, std::unique_ptr<InvertedIndexWriter>* res);
+
+    ~InvertedIndexWriter() = default;
+
+    void add_values(const void* values, size_t count);
+
+    void add_nulls(uint32_t count) { _rid += count; }
+
+    Status finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta);
+
+    uint64_t size() const;
+
+private:
+    InvertedIndexWriter(InvertedIndexParserPB parser_type, uint32_t gram_size,
+                        std::unique_ptr<InvertedIndexParser> parser)
+            : _parser_type(parser_type), _gram_size(gram_size), _parser(std::move(parser)) {}
+
+    void _add_value(const Slice& value);
+
+    const InvertedIndexParserPB _parser_type;
+    const uint32_t _gram_size;
+    std::unique_ptr<InvertedIndexParser> _parser;
+    std::vector<InvertedIndexTerm> _terms;
+    rowid_t _rid = 0;
+    uint64_t _posting_size = 0;
+    // term to the ids of the rows containing it
+    std::map<Slice, roaring::Roaring, Slice::Comparator> _mem_index;
+    MemPool _pool;
+
+    DISALLOW_COPY_AND_ASSIGN(InvertedIndexWriter);
+};
+
+} // namespace segment_v2
+} // namespace doris
@@ -25,6 +25,7 @@
 #include "olap/key_coder.h"
 #include "olap/rowset/segment_v2/page_handle.h"
 #include "olap/rowset/segment_v2/page_io.h"
+#include "util/simd/sorted_search.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -62,6 +63,13 @@ Status OrdinalIndexWriter::finish(io::FileWriter* file_writer, ColumnIndexMetaPB
 }
 
 Status OrdinalIndexReader::load(bool use_page_cache, bool kept_in_memory) {
+    RETURN_IF_ERROR(_load(use_page_cache, kept_in_memory));
+    _file_reader.reset();
+    _index_meta = nullptr;
+    return Status::OK();
+}
+
+Status OrdinalIndexReader::_load(bool use_page_cache, bool kept_in_memory) {
     if (_index_meta->root_page().is_root_data_page()) {
         // only one data page, no index page
         _num_pages = 1;
@@ -108,24 +116,12 @@ Status OrdinalIndexReader::load(bool use_page_cache, bool kept_in_memory) {
 }
 
 OrdinalPageIndexIterator OrdinalIndexReader::seek_at_or_before(ordinal_t ordinal) {
-    int32_t left = 0;
-    int32_t right = _num_pages - 1;
-    while (left < right) {
-        int32_t mid = (left + right + 1) / 2;
-
-        if (_ordinals[mid] < ordinal) {
-            left = mid;
-        } else if (_ordinals[mid] > ordinal) {
-            right = mid - 1;
-        } else {
-            left = mid;
-            break;
-        }
-    }
-    if (_ordinals[left] > ordinal) {
+    // the last page whose first ordinal is not greater than ordinal
+    size_t num_pages_before = simd::sorted_upper_bound(_ordinals.data(), _num_pages, ordinal);
+    if (num_pages_before == 0) {
         return OrdinalPageIndexIterator(this, _num_pages);
     }
-    return OrdinalPageIndexIterator(this, left);
+    return OrdinalPageIndexIterator(this, num_pages_before - 1);
 }
 
 } // namespace segment_v2
@@ -69,9 +69,16 @@ public:
               _index_meta(index_meta),
               _num_values(num_values) {}
 
-    // load and parse the index page into memory
+    // load and parse the index page into memory. The file reader and the index meta are
+    // released once loaded, so that the index may outlive its column reader in the
+    // SegmentMetaCache.
     Status load(bool use_page_cache, bool kept_in_memory);
 
+    size_t mem_usage() const {
+        return sizeof(*this) + _ordinals.capacity() * sizeof(ordinal_t) +
+               _pages.capacity() * sizeof(PagePointer);
+    }
+
     // the returned iter points to the largest element which is less than `ordinal`,
     // or points to the first element if all elements are greater than `ordinal`,
     // or points to "end" if all elements are smaller than `ordinal`.
@@ -90,6 +97,8 @@ public:
 private:
     friend OrdinalPageIndexIterator;
 
+    Status _load(bool use_page_cache, bool kept_in_memory);
+
     io::FileReaderSPtr _file_reader;
     const OrdinalIndexPB* _index_meta;
     // total number of values (including NULLs) in the indexed column,
@@ -17,11 +17,16 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/status.h"     // for Status
 #include "olap/column_block.h" // for ColumnBlockView
 #include "vec/columns/column.h"
 
 namespace doris {
+
+class ColumnPredicate;
+
 namespace segment_v2 {
 
 // PageDecoder is used to decode page.
@@ -91,6 +96,16 @@ public:
         return Status::NotSupported("not implement vec op now");
     }
 
+    // Evaluate the AND of `predicates` on the next `*n` values without decoding them one by one,
+    // and move forward the cursor like `next_batch`. `flags` receives the result of every value.
+    // `scratch` is an empty predicate column of the page type, the decoder may put the values it
+    // has to evaluate into it.
+    virtual Status evaluate_predicates(const std::vector<ColumnPredicate*>& predicates,
+                                       size_t* n, vectorized::MutableColumnPtr& scratch,
+                                       bool* flags) {
+        return Status::NotSupported("evaluate_predicates not implement");
+    }
+
     // Same as `next_batch` except for not moving forward the cursor.
     // When read array's ordinals in `ArrayFileColumnIterator`, we want to read one extra ordinal
     // but do not want to move forward the cursor.
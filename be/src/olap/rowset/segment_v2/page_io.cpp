@@ -18,7 +18,9 @@
 #include "olap/rowset/segment_v2/page_io.h"
 
 #include <cstring>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
@@ -27,14 +29,30 @@
 #include "util/block_compression.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/doris_metrics.h"
 #include "util/faststring.h"
 #include "util/runtime_profile.h"
+#include "util/time.h"
 
 namespace doris {
 namespace segment_v2 {
 
 using strings::Substitute;
 
+// Returns the codec of the pages compressed by a codec other than the one of their column. The
+// codecs keep their compression contexts, so every thread has its own ones.
+static Status get_page_codec(CompressionTypePB type, const BlockCompressionCodec** codec) {
+    static thread_local std::unordered_map<int, std::unique_ptr<BlockCompressionCodec>> codecs;
+    auto it = codecs.find(type);
+    if (it == codecs.end()) {
+        std::unique_ptr<BlockCompressionCodec> new_codec;
+        RETURN_IF_ERROR(get_block_compression_codec(type, new_codec));
+        it = codecs.emplace(type, std::move(new_codec)).first;
+    }
+    *codec = it->second.get();
+    return Status::OK();
+}
+
 Status PageIO::compress_page_body(const BlockCompressionCodec* codec, double min_space_saving,
                                   const std::vector<Slice>& body, OwnedSlice* compressed_body) {
     size_t uncompressed_size = Slice::compute_total_size(body);
@@ -108,8 +126,80 @@ Status PageIO::write_page(io::FileWriter* writer, const std::vector<Slice>& body
     return Status::OK();
 }
 
+// Whether the page, or its compressed data, is in the page cache.
+static bool is_page_cached(const PageReadOptions& opts) {
+    if (!opts.use_page_cache) {
+        return false;
+    }
+    auto cache = StoragePageCache::instance();
+    StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
+                                         opts.page_pointer.offset);
+    PageCacheHandle cache_handle;
+    if (cache->is_cache_available(opts.type) &&
+        cache->lookup(cache_key, &cache_handle, opts.type)) {
+        return true;
+    }
+    return opts.codec != nullptr && opts.type == segment_v2::DATA_PAGE &&
+           cache->is_compressed_cache_available() &&
+           cache->lookup_compressed(cache_key, &cache_handle);
+}
+
+// 'read_page' holds the page already read from the file, if any.
+static Status read_and_decompress_page_impl(const PageReadOptions& opts,
+                                            std::unique_ptr<char[]> read_page,
+                                            PageHandle* handle, Slice* body,
+                                            PageFooterPB* footer);
+
 Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
                                         Slice* body, PageFooterPB* footer) {
+    return read_and_decompress_page_impl(opts, nullptr, handle, body, footer);
+}
+
+Status PageIO::read_and_decompress_pages(const std::vector<PageReadOptions>& opts,
+                                         PageHandle* handles, Slice* bodies,
+                                         PageFooterPB* footers) {
+    std::vector<std::unique_ptr<char[]>> pages(opts.size());
+    std::vector<io::ReadRange> ranges;
+    for (size_t i = 0; i < opts.size(); ++i) {
+        opts[i].sanity_check();
+        DCHECK_EQ(opts[i].file_reader, opts[0].file_reader);
+        // the pages too small are reported as corrupted below
+        const uint32_t page_size = opts[i].page_pointer.size;
+        if (page_size < 8 || is_page_cached(opts[i])) {
+            continue;
+        }
+        pages[i].reset(new char[page_size]);
+        io::ReadRange range;
+        range.offset = opts[i].page_pointer.offset;
+        range.result = Slice(pages[i].get(), page_size);
+        ranges.push_back(range);
+    }
+
+    if (!ranges.empty()) {
+        SCOPED_RAW_TIMER(&opts[0].stats->io_ns);
+        int64_t start_ns = MonotonicNanos();
+        RETURN_IF_ERROR(opts[0].file_reader->read_at_batch(ranges.data(), ranges.size()));
+        DorisMetrics::instance()->page_io_read_latency_us->add((MonotonicNanos() - start_ns) /
+                                                               1000);
+        for (auto& range : ranges) {
+            if (range.bytes_read != range.result.size) {
+                return Status::Corruption("Bad page: read {} bytes at {} instead of {}",
+                                          range.bytes_read, range.offset, range.result.size);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < opts.size(); ++i) {
+        RETURN_IF_ERROR(read_and_decompress_page_impl(opts[i], std::move(pages[i]), &handles[i],
+                                                      &bodies[i], &footers[i]));
+    }
+    return Status::OK();
+}
+
+static Status read_and_decompress_page_impl(const PageReadOptions& opts,
+                                            std::unique_ptr<char[]> read_page,
+                                            PageHandle* handle, Slice* body,
+                                            PageFooterPB* footer) {
     opts.sanity_check();
     opts.stats->total_pages_num++;
 
@@ -139,19 +229,42 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         return Status::Corruption("Bad page: too small size ({})", page_size);
     }
 
+    // The compressed data pages are cached as they are read from the file, so a data page
+    // evicted from the page cache may be decompressed again without reading the file.
+    bool use_compressed_cache = opts.use_page_cache && opts.codec != nullptr &&
+                                opts.type == segment_v2::DATA_PAGE &&
+                                cache->is_compressed_cache_available();
+    PageCacheHandle compressed_handle;
+    bool compressed_cached =
+            use_compressed_cache && cache->lookup_compressed(cache_key, &compressed_handle);
+
     // hold compressed page at first, reset to decompressed page later
-    std::unique_ptr<char[]> page(new char[page_size]);
-    Slice page_slice(page.get(), page_size);
-    {
+    std::unique_ptr<char[]> page;
+    Slice page_slice;
+    if (compressed_cached) {
+        page_slice = compressed_handle.data();
+        DCHECK_EQ(page_slice.size, page_size);
+        opts.stats->cached_compressed_pages_num++;
+    } else if (read_page != nullptr) {
+        page = std::move(read_page);
+        page_slice = Slice(page.get(), page_size);
+        opts.stats->compressed_bytes_read += page_size;
+    } else {
+        page.reset(new char[page_size]);
+        page_slice = Slice(page.get(), page_size);
         SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        int64_t start_ns = MonotonicNanos();
         size_t bytes_read = 0;
         RETURN_IF_ERROR(
                 opts.file_reader->read_at(opts.page_pointer.offset, page_slice, &bytes_read));
+        DorisMetrics::instance()->page_io_read_latency_us->add((MonotonicNanos() - start_ns) /
+                                                               1000);
         DCHECK_EQ(bytes_read, page_size);
         opts.stats->compressed_bytes_read += page_size;
     }
 
-    if (opts.verify_checksum) {
+    // the checksum of a cached compressed page is verified when it is read from the file
+    if (opts.verify_checksum && !compressed_cached) {
         uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
         uint32_t actual = crc32c::Value(page_slice.data, page_slice.size - 4);
         if (expect != actual) {
@@ -170,9 +283,18 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
 
     uint32_t body_size = page_slice.size - 4 - footer_size;
     if (body_size != footer->uncompressed_size()) { // need decompress body
-        if (opts.codec == nullptr) {
+        const BlockCompressionCodec* codec = opts.codec;
+        if (footer->has_compression()) {
+            RETURN_IF_ERROR(get_page_codec(footer->compression(), &codec));
+        }
+        if (codec == nullptr) {
             return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
         }
+        if (use_compressed_cache && !compressed_cached) {
+            // the cache owns the compressed page from now on
+            cache->insert_compressed(cache_key, Slice(page.release(), page_size),
+                                     &compressed_handle, opts.kept_in_memory, opts.bulk_scan);
+        }
         SCOPED_RAW_TIMER(&opts.stats->decompress_ns);
         std::unique_ptr<char[]> decompressed_page(
                 new char[footer->uncompressed_size() + footer_size + 4]);
@@ -180,7 +302,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         // decompress page body
         Slice compressed_body(page_slice.data, body_size);
         Slice decompressed_body(decompressed_page.get(), footer->uncompressed_size());
-        RETURN_IF_ERROR(opts.codec->decompress(compressed_body, &decompressed_body));
+        RETURN_IF_ERROR(codec->decompress(compressed_body, &decompressed_body));
         if (decompressed_body.size != footer->uncompressed_size()) {
             return Status::Corruption(
                     "Bad page: record uncompressed size={} vs real decompressed size={}",
@@ -194,6 +316,9 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         page_slice = Slice(page.get(), footer->uncompressed_size() + footer_size + 4);
         opts.stats->uncompressed_bytes_read += page_slice.size;
     } else {
+        if (compressed_cached) {
+            return Status::Corruption("Bad page: cached compressed page is not compressed");
+        }
         opts.stats->uncompressed_bytes_read += body_size;
     }
 
@@ -209,7 +334,8 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
     if (opts.use_page_cache && cache->is_cache_available(opts.type)) {
         // insert this page into cache and return the cache handle
-        cache->insert(cache_key, page_slice, &cache_handle, opts.type, opts.kept_in_memory);
+        cache->insert(cache_key, page_slice, &cache_handle, opts.type, opts.kept_in_memory,
+                      opts.bulk_scan);
         *handle = PageHandle(std::move(cache_handle));
     } else {
         *handle = PageHandle(page_slice);
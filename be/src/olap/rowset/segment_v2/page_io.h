@@ -60,6 +60,9 @@ struct PageReadOptions {
     // if true, use DURABLE CachePriority in page cache
     // currently used for in memory olap table
     bool kept_in_memory = false;
+    // if true and kept_in_memory is false, use PROBATION CachePriority in page cache,
+    // used for the pages read by bulk scans
+    bool bulk_scan = false;
     // for page cache allocation
     // page types are divided into DATA_PAGE & INDEX_PAGE
     // INDEX_PAGE including index_page, dict_page and short_key_page
@@ -116,6 +119,13 @@ public:
     //     `footer' stores the page footer.
     static Status read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
                                            Slice* body, PageFooterPB* footer);
+
+    // Read and parse the pages of the same file according to `opts', as many pages as there
+    // are options. The pages missing from the page cache are read from the file together, see
+    // io::FileReader::read_at_batch.
+    static Status read_and_decompress_pages(const std::vector<PageReadOptions>& opts,
+                                            PageHandle* handles, Slice* bodies,
+                                            PageFooterPB* footers);
 };
 
 } // namespace segment_v2
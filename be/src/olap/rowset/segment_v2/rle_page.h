@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "olap/column_predicate.h"               // for ColumnPredicate
 #include "olap/rowset/segment_v2/options.h"      // for PageBuilderOptions/PageDecoderOptions
 #include "olap/rowset/segment_v2/page_builder.h" // for PageBuilder
 #include "olap/rowset/segment_v2/page_decoder.h" // for PageDecoder
@@ -286,6 +287,45 @@ public:
         return Status::OK();
     }
 
+    // Every run of the same value is evaluated once, so a page of long runs is filtered at the
+    // cost of a few comparisons.
+    Status evaluate_predicates(const std::vector<ColumnPredicate*>& predicates, size_t* n,
+                               vectorized::MutableColumnPtr& scratch, bool* flags) override {
+        DCHECK(_parsed);
+        DCHECK(!predicates.empty());
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+
+        size_t to_fetch = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
+        size_t run_lengths[to_fetch];
+        size_t num_runs = 0;
+        size_t fetched = 0;
+        CppType value;
+        while (fetched < to_fetch) {
+            size_t run_length = _rle_decoder.GetNextRun(&value, to_fetch - fetched);
+            DCHECK_GT(run_length, 0);
+            scratch->insert_data((char*)(&value), SIZE_OF_TYPE);
+            run_lengths[num_runs++] = run_length;
+            fetched += run_length;
+        }
+
+        bool run_flags[num_runs];
+        predicates[0]->evaluate_vec(*scratch, num_runs, run_flags);
+        for (size_t i = 1; i < predicates.size(); ++i) {
+            predicates[i]->evaluate_and_vec(*scratch, num_runs, run_flags);
+        }
+        for (size_t i = 0; i < num_runs; ++i) {
+            memset(flags, run_flags[i], run_lengths[i]);
+            flags += run_lengths[i];
+        }
+
+        _cur_index += to_fetch;
+        *n = to_fetch;
+        return Status::OK();
+    }
+
     size_t count() const override { return _num_elements; }
 
     size_t current_index() const override { return _cur_index; }
@@ -24,24 +24,44 @@
 #include "olap/rowset/segment_v2/column_reader.h" // ColumnReader
 #include "olap/rowset/segment_v2/empty_segment_iterator.h"
 #include "olap/rowset/segment_v2/page_io.h"
+#include "olap/rowset/segment_v2/segment_index_file.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h" // k_segment_magic_length
+#include "olap/segment_meta_cache.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet_schema.h"
 #include "util/crc32c.h"
+#include "util/doris_metrics.h"
 #include "util/slice.h" // Slice
+#include "util/stopwatch.hpp"
+#include "vec/olap/row_store.h"
 
 namespace doris {
 namespace segment_v2 {
 
 Status Segment::open(io::FileSystem* fs, const std::string& path, uint32_t segment_id,
-                     const TabletSchema* tablet_schema, std::shared_ptr<Segment>* output) {
+                     const TabletSchema* tablet_schema, std::shared_ptr<Segment>* output,
+                     const std::string& index_file_path) {
+    MonotonicStopWatch watch;
+    watch.start();
     std::shared_ptr<Segment> segment(new Segment(segment_id, tablet_schema));
     io::FileReaderSPtr file_reader;
     RETURN_IF_ERROR(fs->open_file(path, &file_reader));
     segment->_file_reader = std::move(file_reader);
+    segment->_is_remote = fs->type() != io::FileSystemType::LOCAL;
+    bool has_index_file = false;
+    if (!index_file_path.empty()) {
+        RETURN_IF_ERROR(fs->exists(index_file_path, &has_index_file));
+    }
+    if (has_index_file) {
+        RETURN_IF_ERROR(fs->open_file(index_file_path, &segment->_index_file_reader));
+        segment->_index_file_footer.reset(new SegmentIndexFooterPB());
+        RETURN_IF_ERROR(SegmentIndexFile::read_footer(segment->_index_file_reader.get(),
+                                                      segment->_index_file_footer.get()));
+    }
     RETURN_IF_ERROR(segment->_open());
     *output = std::move(segment);
+    DorisMetrics::instance()->segment_open_latency_us->add(watch.elapsed_time() / 1000);
     return Status::OK();
 }
 
@@ -85,6 +105,16 @@ Status Segment::new_iterator(const Schema& schema, const StorageReadOptions& rea
 }
 
 Status Segment::_parse_footer() {
+    auto meta_cache = SegmentMetaCache::instance();
+    std::string cache_key;
+    if (meta_cache != nullptr) {
+        cache_key = SegmentMetaCache::key(_file_reader->path().native(), SegmentMetaCache::FOOTER);
+        _footer = meta_cache->lookup<const SegmentFooterPB>(cache_key);
+        if (_footer != nullptr) {
+            return Status::OK();
+        }
+    }
+
     // Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
     auto file_size = _file_reader->size();
     if (file_size < 12) {
@@ -127,10 +157,16 @@ Status Segment::_parse_footer() {
     }
 
     // deserialize footer PB
-    if (!_footer.ParseFromString(footer_buf)) {
+    auto footer = std::make_shared<SegmentFooterPB>();
+    if (!footer->ParseFromString(footer_buf)) {
         return Status::Corruption("Bad segment file {}: failed to parse SegmentFooterPB",
                                   _file_reader->path().native());
     }
+    if (meta_cache != nullptr) {
+        meta_cache->insert(cache_key, footer, footer->SpaceUsedLong(),
+                           _tablet_schema.is_in_memory());
+    }
+    _footer = std::move(footer);
     return Status::OK();
 }
 
@@ -139,34 +175,35 @@ Status Segment::_load_index() {
         // read and parse short key index page
         PageReadOptions opts;
         opts.file_reader = _file_reader.get();
-        opts.page_pointer = PagePointer(_footer.short_key_index_page());
+        opts.page_pointer = PagePointer(_footer->short_key_index_page());
         opts.codec = nullptr; // short key index page uses NO_COMPRESSION for now
         OlapReaderStatistics tmp_stats;
         opts.stats = &tmp_stats;
         opts.type = INDEX_PAGE;
 
-        if (_tablet_schema.keys_type() == UNIQUE_KEYS && _footer.has_primary_key_index_meta()) {
+        if (_tablet_schema.keys_type() == UNIQUE_KEYS && _footer->has_primary_key_index_meta()) {
             _pk_index_reader.reset(new PrimaryKeyIndexReader());
-            return _pk_index_reader->parse(_file_reader, _footer.primary_key_index_meta());
-        } else {
-            Slice body;
-            PageFooterPB footer;
             RETURN_IF_ERROR(
-                    PageIO::read_and_decompress_page(opts, &_sk_index_handle, &body, &footer));
-            DCHECK_EQ(footer.type(), SHORT_KEY_PAGE);
-            DCHECK(footer.has_short_key_page_footer());
-
-            _meta_mem_usage += body.get_size();
-            StorageEngine::instance()->segment_meta_mem_tracker()->consume(body.get_size());
-            _sk_index_decoder.reset(new ShortKeyIndexDecoder);
-            return _sk_index_decoder->parse(body, footer.short_key_page_footer());
+                    _pk_index_reader->parse(_file_reader, _footer->primary_key_index_meta()));
         }
+        // the short key index is written along with the primary key index, it's used to seek
+        // the key ranges of scans
+        Slice body;
+        PageFooterPB footer;
+        RETURN_IF_ERROR(PageIO::read_and_decompress_page(opts, &_sk_index_handle, &body, &footer));
+        DCHECK_EQ(footer.type(), SHORT_KEY_PAGE);
+        DCHECK(footer.has_short_key_page_footer());
+
+        _meta_mem_usage += body.get_size();
+        StorageEngine::instance()->segment_meta_mem_tracker()->consume(body.get_size());
+        _sk_index_decoder.reset(new ShortKeyIndexDecoder);
+        return _sk_index_decoder->parse(body, footer.short_key_page_footer());
     });
 }
 
 Status Segment::_create_column_readers() {
-    for (uint32_t ordinal = 0; ordinal < _footer.columns().size(); ++ordinal) {
-        auto& column_pb = _footer.columns(ordinal);
+    for (uint32_t ordinal = 0; ordinal < _footer->columns().size(); ++ordinal) {
+        auto& column_pb = _footer->columns(ordinal);
         _column_id_to_footer_ordinal.emplace(column_pb.unique_id(), ordinal);
     }
 
@@ -180,10 +217,20 @@ Status Segment::_create_column_readers() {
         ColumnReaderOptions opts;
         opts.kept_in_memory = _tablet_schema.is_in_memory();
         std::unique_ptr<ColumnReader> reader;
-        RETURN_IF_ERROR(ColumnReader::create(opts, _footer.columns(iter->second),
-                                             _footer.num_rows(), _file_reader, &reader));
+        RETURN_IF_ERROR(ColumnReader::create(opts, _footer->columns(iter->second),
+                                             _footer->num_rows(), _file_reader, &reader));
         _column_readers.emplace(column.unique_id(), std::move(reader));
     }
+
+    if (_index_file_footer != nullptr) {
+        for (auto& column_indexes : _index_file_footer->columns()) {
+            auto iter = _column_readers.find(column_indexes.unique_id());
+            if (iter != _column_readers.end()) {
+                iter->second->add_index_file(_index_file_reader, column_indexes);
+            }
+        }
+        _index_file_footer.reset();
+    }
     return Status::OK();
 }
 
@@ -224,15 +271,106 @@ Status Segment::new_bitmap_index_iterator(const TabletColumn& tablet_column,
     return Status::OK();
 }
 
+Status Segment::new_inverted_index_iterator(const TabletColumn& tablet_column,
+                                            InvertedIndexIterator** iter) {
+    auto col_unique_id = tablet_column.unique_id();
+    if (_column_readers.count(col_unique_id) > 0 &&
+        _column_readers.at(col_unique_id)->has_inverted_index()) {
+        return _column_readers.at(col_unique_id)->new_inverted_index_iterator(iter);
+    }
+    return Status::OK();
+}
+
+Status Segment::new_bit_sliced_index_iterator(const TabletColumn& tablet_column,
+                                              BitSlicedIndexIterator** iter) {
+    auto col_unique_id = tablet_column.unique_id();
+    if (_column_readers.count(col_unique_id) > 0 &&
+        _column_readers.at(col_unique_id)->has_bit_sliced_index()) {
+        return _column_readers.at(col_unique_id)->new_bit_sliced_index_iterator(iter);
+    }
+    return Status::OK();
+}
+
+Status Segment::read_column_by_rowids(const TabletColumn& tablet_column, const rowid_t* rowids,
+                                      size_t count, OlapReaderStatistics* stats,
+                                      vectorized::MutableColumnPtr& dst) {
+    ColumnIterator* raw_iter = nullptr;
+    RETURN_IF_ERROR(new_column_iterator(tablet_column, &raw_iter));
+    std::unique_ptr<ColumnIterator> iter(raw_iter);
+    ColumnIteratorOptions iter_opts;
+    iter_opts.stats = stats;
+    iter_opts.use_page_cache = true;
+    iter_opts.file_reader = _file_reader.get();
+    RETURN_IF_ERROR(iter->init(iter_opts));
+    return iter->read_by_rowids(rowids, count, dst);
+}
+
+Status Segment::read_columns_from_row_store(const std::vector<const TabletColumn*>& columns,
+                                            const rowid_t* rowids, size_t count,
+                                            OlapReaderStatistics* stats,
+                                            const std::vector<vectorized::IColumn*>& dst) {
+    DCHECK_EQ(columns.size(), dst.size());
+    if (!has_row_store()) {
+        return Status::NotSupported("segment {} has no row store", _segment_id);
+    }
+    // the columns encoded in the rows, and the positions of the requested ones among them
+    int32_t row_store_col_idx = _tablet_schema.row_store_col_idx();
+    std::vector<uint32_t> stored_cids;
+    for (int32_t cid = 0; cid < _tablet_schema.num_columns(); ++cid) {
+        if (cid != row_store_col_idx) {
+            stored_cids.push_back(cid);
+        }
+    }
+    vectorized::Block decoded_block = _tablet_schema.create_block(stored_cids);
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        int32_t cid = _tablet_schema.field_index(columns[i]->unique_id());
+        if (cid < 0 || cid == row_store_col_idx ||
+            _tablet_schema.column(cid).type() != columns[i]->type()) {
+            return Status::NotSupported("column {} is not in the row store of segment {}",
+                                        columns[i]->name(), _segment_id);
+        }
+        size_t pos = cid < row_store_col_idx ? cid : cid - 1;
+        if (decoded_block.get_by_position(pos).column->get_name() != dst[i]->get_name()) {
+            return Status::NotSupported("column {} is read as {}, but stored as {}",
+                                        columns[i]->name(), dst[i]->get_name(),
+                                        decoded_block.get_by_position(pos).column->get_name());
+        }
+        positions.push_back(pos);
+    }
+
+    vectorized::MutableColumnPtr rows = vectorized::ColumnString::create();
+    RETURN_IF_ERROR(read_column_by_rowids(_tablet_schema.column(row_store_col_idx), rowids, count,
+                                          stats, rows));
+    auto decoded_columns = decoded_block.mutate_columns();
+    for (size_t i = 0; i < count; ++i) {
+        StringRef row = rows->get_data_at(i);
+        // every encoded row holds at least its version
+        if (row.size == 0) {
+            return Status::NotSupported("row {} is not in the row store of segment {}", rowids[i],
+                                        _segment_id);
+        }
+        RETURN_IF_ERROR(vectorized::RowStore::decode_row(row, decoded_columns));
+    }
+    for (size_t i = 0; i < dst.size(); ++i) {
+        dst[i]->insert_range_from(*decoded_columns[positions[i]], 0, count);
+    }
+    return Status::OK();
+}
+
 Status Segment::lookup_row_key(const Slice& key, RowLocation* row_location) {
-    RETURN_IF_ERROR(_load_index());
+    std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
+    RETURN_IF_ERROR(new_primary_key_index_iterator(&index_iterator));
+    return lookup_row_key(key, index_iterator.get(), row_location);
+}
+
+Status Segment::lookup_row_key(const Slice& key, IndexedColumnIterator* index_iterator,
+                               RowLocation* row_location) {
     DCHECK(_pk_index_reader != nullptr);
     if (!_pk_index_reader->check_present(key)) {
         return Status::NotFound("Can't find key in the segment");
     }
     bool exact_match = false;
-    std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
-    RETURN_IF_ERROR(_pk_index_reader->new_iterator(&index_iterator));
     RETURN_IF_ERROR(index_iterator->seek_at_or_after(&key, &exact_match));
     if (!exact_match) {
         return Status::NotFound("Can't find key in the segment");
@@ -242,5 +380,13 @@ Status Segment::lookup_row_key(const Slice& key, RowLocation* row_location) {
     return Status::OK();
 }
 
+Status Segment::new_primary_key_index_iterator(std::unique_ptr<IndexedColumnIterator>* iter) {
+    RETURN_IF_ERROR(_load_index());
+    if (_pk_index_reader == nullptr) {
+        return Status::NotSupported("segment has no primary key index");
+    }
+    return _pk_index_reader->new_iterator(iter);
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -28,6 +28,7 @@
 #include "io/fs/file_system.h"
 #include "olap/iterators.h"
 #include "olap/primary_key_index.h"
+#include "olap/rowset/segment_v2/common.h"
 #include "olap/rowset/segment_v2/page_handle.h"
 #include "olap/short_key_index.h"
 #include "olap/tablet_schema.h"
@@ -45,6 +46,8 @@ class StorageReadOptions;
 namespace segment_v2 {
 
 class BitmapIndexIterator;
+class InvertedIndexIterator;
+class BitSlicedIndexIterator;
 class ColumnReader;
 class ColumnIterator;
 class Segment;
@@ -61,8 +64,11 @@ using SegmentSharedPtr = std::shared_ptr<Segment>;
 // change finished, client should disable all cached Segment for old TabletSchema.
 class Segment : public std::enable_shared_from_this<Segment> {
 public:
+    // index_file_path is the path of the index file of the segment if it may have one, see
+    // SegmentIndexFile
     static Status open(io::FileSystem* fs, const std::string& path, uint32_t segment_id,
-                       const TabletSchema* tablet_schema, std::shared_ptr<Segment>* output);
+                       const TabletSchema* tablet_schema, std::shared_ptr<Segment>* output,
+                       const std::string& index_file_path = std::string());
 
     ~Segment();
 
@@ -71,12 +77,35 @@ public:
 
     uint64_t id() const { return _segment_id; }
 
-    uint32_t num_rows() const { return _footer.num_rows(); }
+    uint32_t num_rows() const { return _footer->num_rows(); }
 
     Status new_column_iterator(const TabletColumn& tablet_column, ColumnIterator** iter);
 
     Status new_bitmap_index_iterator(const TabletColumn& tablet_column, BitmapIndexIterator** iter);
 
+    Status new_inverted_index_iterator(const TabletColumn& tablet_column,
+                                       InvertedIndexIterator** iter);
+
+    Status new_bit_sliced_index_iterator(const TabletColumn& tablet_column,
+                                         BitSlicedIndexIterator** iter);
+
+    // Read the values at `rowids` of `tablet_column` into `dst`, reading the pages through
+    // the page cache. It's used to fetch a few rows located by their keys.
+    Status read_column_by_rowids(const TabletColumn& tablet_column, const rowid_t* rowids,
+                                 size_t count, OlapReaderStatistics* stats,
+                                 vectorized::MutableColumnPtr& dst);
+
+    bool has_row_store() const { return _tablet_schema.has_row_store_column(); }
+
+    // Read the values at `rowids` of `columns` from the row store column, appending them to
+    // `dst`, which is aligned with `columns`. Nothing is appended and NotSupported is returned
+    // if some of the rows or columns are not in the row store, e.g. the segment was written row
+    // by row or before a column was added, so the caller should read the columns instead.
+    Status read_columns_from_row_store(const std::vector<const TabletColumn*>& columns,
+                                       const rowid_t* rowids, size_t count,
+                                       OlapReaderStatistics* stats,
+                                       const std::vector<vectorized::IColumn*>& dst);
+
     size_t num_short_keys() const { return _tablet_schema.num_short_key_columns(); }
 
     uint32_t num_rows_per_block() const {
@@ -103,8 +132,18 @@ public:
 
     Status lookup_row_key(const Slice& key, RowLocation* row_location);
 
+    // Same as above, but seeks with `index_iterator` created by new_primary_key_index_iterator().
+    // When keys are looked up in ascending order, the iterator reuses the decoded index page
+    // across consecutive keys that fall in the same page.
+    Status lookup_row_key(const Slice& key, IndexedColumnIterator* index_iterator,
+                          RowLocation* row_location);
+
+    // Create an iterator over the primary key index, entries are ordered by key.
+    // Return NotSupported if the segment has no primary key index.
+    Status new_primary_key_index_iterator(std::unique_ptr<IndexedColumnIterator>* iter);
+
     // only used by UT
-    const SegmentFooterPB& footer() const { return _footer; }
+    const SegmentFooterPB& footer() const { return *_footer; }
 
 private:
     DISALLOW_COPY_AND_ASSIGN(Segment);
@@ -119,13 +158,21 @@ private:
 
 private:
     friend class SegmentIterator;
+    friend class SegmentIndexFile;
     io::FileReaderSPtr _file_reader;
+    // the index file of the segment if it has one, and its footer until the column readers
+    // have copied their indexes
+    io::FileReaderSPtr _index_file_reader;
+    std::unique_ptr<SegmentIndexFooterPB> _index_file_footer;
+    // whether the segment file is on remote storage
+    bool _is_remote = false;
 
     uint32_t _segment_id;
     TabletSchema _tablet_schema;
 
     int64_t _meta_mem_usage;
-    SegmentFooterPB _footer;
+    // shared with the SegmentMetaCache
+    std::shared_ptr<const SegmentFooterPB> _footer;
 
     // Map from column unique id to column ordinal in footer's ColumnMetaPB
     // If we can't find unique id from it, it means this segment is created
@@ -0,0 +1,372 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/segment_index_file.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "env/env.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/column_block.h"
+#include "olap/column_vector.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/bit_sliced_index_writer.h"
+#include "olap/rowset/segment_v2/bitmap_index_writer.h"
+#include "olap/rowset/segment_v2/bloom_filter.h"
+#include "olap/rowset/segment_v2/bloom_filter_index_writer.h"
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "olap/rowset/segment_v2/inverted_index_parser.h"
+#include "olap/rowset/segment_v2/inverted_index_writer.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/tablet_schema.h"
+#include "olap/types.h"
+#include "runtime/mem_pool.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/faststring.h"
+
+namespace doris {
+namespace segment_v2 {
+
+namespace {
+
+const char* k_index_file_magic = "D0X1";
+const uint32_t k_index_file_magic_length = 4;
+const size_t k_batch_size = 1024;
+
+bool has_index(const ColumnReader& reader, ColumnIndexTypePB type) {
+    switch (type) {
+    case BITMAP_INDEX:
+    case BIT_SLICED_INDEX:
+        return reader.has_bitmap_index() || reader.has_bit_sliced_index();
+    case BLOOM_FILTER_INDEX:
+        return reader.has_bloom_filter_index();
+    case INVERTED_INDEX:
+        return reader.has_inverted_index();
+    case NGRAM_BLOOM_FILTER_INDEX:
+        return reader.has_ngram_bloom_filter_index();
+    default:
+        return true;
+    }
+}
+
+// The writers of the indexes a column lacks, fed the values of the column page by page.
+class ColumnIndexBuilder {
+public:
+    ColumnIndexBuilder(const TabletColumn& column, ColumnReader* reader)
+            : _column(column), _reader(reader), _type_info(get_type_info(&column)) {}
+
+    Status init(const std::vector<ColumnIndexTypePB>& types) {
+        for (auto type : types) {
+            switch (type) {
+            case BITMAP_INDEX:
+                RETURN_IF_ERROR(BitmapIndexWriter::create(_type_info.get(), &_bitmap_index));
+                break;
+            case BIT_SLICED_INDEX:
+                RETURN_IF_ERROR(BitSlicedIndexWriter::create(_type_info.get(), &_bitmap_index));
+                break;
+            case BLOOM_FILTER_INDEX:
+                RETURN_IF_ERROR(BloomFilterIndexWriter::create(
+                        BloomFilterOptions(), _type_info.get(), &_bloom_filter_index));
+                break;
+            case INVERTED_INDEX: {
+                InvertedIndexParserPB parser;
+                RETURN_IF_ERROR(
+                        InvertedIndexParser::parse_type(_column.inverted_index_parser(), &parser));
+                RETURN_IF_ERROR(InvertedIndexWriter::create(_type_info.get(), parser,
+                                                            _column.inverted_index_gram_size(),
+                                                            &_inverted_index));
+                break;
+            }
+            case NGRAM_BLOOM_FILTER_INDEX:
+                RETURN_IF_ERROR(BloomFilterIndexWriter::create_ngram(
+                        BloomFilterOptions(), _type_info.get(), _column.ngram_bf_gram_size(),
+                        &_ngram_bloom_filter_index));
+                break;
+            default:
+                return Status::NotSupported("can't build index {} of column {}", type,
+                                            _column.name());
+            }
+        }
+        return Status::OK();
+    }
+
+    // reads the values of the column page by page, as the bloom filters are per page
+    Status add_values(io::FileReader* file_reader,
+                      const std::function<void(size_t)>& before_read) {
+        if (_reader->is_empty()) {
+            return Status::OK();
+        }
+        OlapReaderStatistics stats;
+        ColumnIteratorOptions iter_opts;
+        iter_opts.file_reader = file_reader;
+        iter_opts.stats = &stats;
+        iter_opts.use_page_cache = false;
+        ColumnIterator* column_iter = nullptr;
+        RETURN_IF_ERROR(_reader->new_iterator(&column_iter));
+        std::unique_ptr<ColumnIterator> column_iter_holder(column_iter);
+        RETURN_IF_ERROR(column_iter->init(iter_opts));
+
+        std::unique_ptr<ColumnVectorBatch> cvb;
+        RETURN_IF_ERROR(ColumnVectorBatch::create(k_batch_size, _reader->is_nullable(),
+                                                  _type_info.get(), nullptr, &cvb));
+        MemPool pool;
+        ColumnBlock block(cvb.get(), &pool);
+
+        OrdinalPageIndexIterator page_iter;
+        RETURN_IF_ERROR(_reader->seek_to_first(&page_iter));
+        for (; page_iter.valid(); page_iter.next()) {
+            before_read(page_iter.page().size);
+            RETURN_IF_ERROR(column_iter->seek_to_ordinal(page_iter.first_ordinal()));
+            size_t remaining = page_iter.last_ordinal() - page_iter.first_ordinal() + 1;
+            while (remaining > 0) {
+                size_t n = std::min(remaining, k_batch_size);
+                ColumnBlockView view(&block);
+                bool has_null = false;
+                RETURN_IF_ERROR(column_iter->next_batch(&n, &view, &has_null));
+                if (n == 0) {
+                    return Status::Corruption("unexpected end of column {} of segment {}",
+                                              _column.name(), file_reader->path().native());
+                }
+                _add_runs(block, n);
+                pool.clear();
+                remaining -= n;
+            }
+            if (_bloom_filter_index != nullptr) {
+                RETURN_IF_ERROR(_bloom_filter_index->flush());
+            }
+            if (_ngram_bloom_filter_index != nullptr) {
+                RETURN_IF_ERROR(_ngram_bloom_filter_index->flush());
+            }
+        }
+        return Status::OK();
+    }
+
+    Status finish(io::FileWriter* file_writer, ColumnIndexesPB* meta) {
+        meta->set_unique_id(_column.unique_id());
+        if (_bitmap_index != nullptr) {
+            RETURN_IF_ERROR(_bitmap_index->finish(file_writer, meta->add_indexes()));
+        }
+        if (_bloom_filter_index != nullptr) {
+            RETURN_IF_ERROR(_bloom_filter_index->finish(file_writer, meta->add_indexes()));
+        }
+        if (_inverted_index != nullptr) {
+            RETURN_IF_ERROR(_inverted_index->finish(file_writer, meta->add_indexes()));
+        }
+        if (_ngram_bloom_filter_index != nullptr) {
+            RETURN_IF_ERROR(_ngram_bloom_filter_index->finish(file_writer, meta->add_indexes()));
+        }
+        return Status::OK();
+    }
+
+private:
+    // adds the first n rows of block, by runs of values and nulls
+    void _add_runs(const ColumnBlock& block, size_t n) {
+        size_t start = 0;
+        while (start < n) {
+            bool is_null = block.is_null(start);
+            size_t end = start + 1;
+            while (end < n && block.is_null(end) == is_null) {
+                ++end;
+            }
+            if (is_null) {
+                _add_nulls(end - start);
+            } else {
+                _add_values(block.cell_ptr(start), end - start);
+            }
+            start = end;
+        }
+    }
+
+    void _add_values(const void* values, size_t count) {
+        if (_bitmap_index != nullptr) {
+            _bitmap_index->add_values(values, count);
+        }
+        if (_bloom_filter_index != nullptr) {
+            _bloom_filter_index->add_values(values, count);
+        }
+        if (_inverted_index != nullptr) {
+            _inverted_index->add_values(values, count);
+        }
+        if (_ngram_bloom_filter_index != nullptr) {
+            _ngram_bloom_filter_index->add_values(values, count);
+        }
+    }
+
+    void _add_nulls(uint32_t count) {
+        if (_bitmap_index != nullptr) {
+            _bitmap_index->add_nulls(count);
+        }
+        if (_bloom_filter_index != nullptr) {
+            _bloom_filter_index->add_nulls(count);
+        }
+        if (_inverted_index != nullptr) {
+            _inverted_index->add_nulls(count);
+        }
+        if (_ngram_bloom_filter_index != nullptr) {
+            _ngram_bloom_filter_index->add_nulls(count);
+        }
+    }
+
+    const TabletColumn& _column;
+    ColumnReader* _reader;
+    TypeInfoPtr _type_info;
+    std::unique_ptr<BitmapIndexWriter> _bitmap_index;
+    std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index;
+    std::unique_ptr<InvertedIndexWriter> _inverted_index;
+    std::unique_ptr<BloomFilterIndexWriter> _ngram_bloom_filter_index;
+};
+
+} // namespace
+
+std::vector<ColumnIndexTypePB> SegmentIndexFile::index_types(const TabletSchema& schema,
+                                                             const TabletColumn& column) {
+    std::vector<ColumnIndexTypePB> types;
+    // like SegmentWriter, the row store column and the arrays have no index
+    if ((schema.has_row_store_column() &&
+         column.unique_id() == schema.column(schema.row_store_col_idx()).unique_id()) ||
+        column.type() == OLAP_FIELD_TYPE_ARRAY) {
+        return types;
+    }
+    if (column.has_bitmap_index()) {
+        types.push_back(column.bit_sliced_bitmap_index() ? BIT_SLICED_INDEX : BITMAP_INDEX);
+    }
+    if (column.is_bf_column()) {
+        types.push_back(BLOOM_FILTER_INDEX);
+    }
+    if (column.has_inverted_index()) {
+        types.push_back(INVERTED_INDEX);
+    }
+    if (column.ngram_bf_gram_size() > 0) {
+        types.push_back(NGRAM_BLOOM_FILTER_INDEX);
+    }
+    return types;
+}
+
+bool SegmentIndexFile::lacks_indexes(const TabletSchema& old_schema,
+                                     const TabletSchema& new_schema) {
+    for (auto& column : new_schema.columns()) {
+        int32_t old_index = old_schema.field_index(column.unique_id());
+        if (old_index < 0) {
+            // the segments have no values of the column
+            continue;
+        }
+        auto old_types = index_types(old_schema, old_schema.column(old_index));
+        for (auto type : index_types(new_schema, column)) {
+            if (std::find(old_types.begin(), old_types.end(), type) == old_types.end()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+Status SegmentIndexFile::read_footer(io::FileReader* file_reader, SegmentIndexFooterPB* footer) {
+    auto file_size = file_reader->size();
+    if (file_size < 12) {
+        return Status::Corruption("Bad segment index file {}: file size {} < 12",
+                                  file_reader->path().native(), file_size);
+    }
+    uint8_t fixed_buf[12];
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(file_reader->read_at(file_size - 12, Slice(fixed_buf, 12), &bytes_read));
+    DCHECK_EQ(bytes_read, 12);
+    if (memcmp(fixed_buf + 8, k_index_file_magic, k_index_file_magic_length) != 0) {
+        return Status::Corruption("Bad segment index file {}: magic number not match",
+                                  file_reader->path().native());
+    }
+
+    uint32_t footer_length = decode_fixed32_le(fixed_buf);
+    if (file_size < 12 + footer_length) {
+        return Status::Corruption("Bad segment index file {}: file size {} < {}",
+                                  file_reader->path().native(), file_size, 12 + footer_length);
+    }
+    std::string footer_buf;
+    footer_buf.resize(footer_length);
+    RETURN_IF_ERROR(file_reader->read_at(file_size - 12 - footer_length, footer_buf, &bytes_read));
+    DCHECK_EQ(bytes_read, footer_length);
+
+    uint32_t expect_checksum = decode_fixed32_le(fixed_buf + 4);
+    uint32_t actual_checksum = crc32c::Value(footer_buf.data(), footer_buf.size());
+    if (actual_checksum != expect_checksum) {
+        return Status::Corruption(
+                "Bad segment index file {}: footer checksum not match, actual={} vs expect={}",
+                file_reader->path().native(), actual_checksum, expect_checksum);
+    }
+    if (!footer->ParseFromString(footer_buf)) {
+        return Status::Corruption("Bad segment index file {}: failed to parse footer",
+                                  file_reader->path().native());
+    }
+    return Status::OK();
+}
+
+Status SegmentIndexFile::build(Segment* segment, const std::string& path,
+                               const std::function<void(size_t)>& before_read, bool* built) {
+    *built = false;
+    const TabletSchema& schema = segment->_tablet_schema;
+    std::vector<std::unique_ptr<ColumnIndexBuilder>> builders;
+    for (auto& column : schema.columns()) {
+        auto it = segment->_column_readers.find(column.unique_id());
+        if (it == segment->_column_readers.end()) {
+            continue;
+        }
+        std::vector<ColumnIndexTypePB> types;
+        for (auto type : index_types(schema, column)) {
+            if (!has_index(*it->second, type)) {
+                types.push_back(type);
+            }
+        }
+        if (!types.empty()) {
+            builders.emplace_back(new ColumnIndexBuilder(column, it->second.get()));
+            RETURN_IF_ERROR(builders.back()->init(types));
+        }
+    }
+    if (builders.empty()) {
+        return Status::OK();
+    }
+
+    // the file is written aside and renamed once complete, so an index file is never partial
+    std::string tmp_path = path + ".tmp";
+    io::FileWriterPtr file_writer;
+    RETURN_IF_ERROR(io::global_local_filesystem()->create_file(tmp_path, &file_writer));
+    SegmentIndexFooterPB footer;
+    for (auto& builder : builders) {
+        RETURN_IF_ERROR(builder->add_values(segment->_file_reader.get(), before_read));
+        RETURN_IF_ERROR(builder->finish(file_writer.get(), footer.add_columns()));
+    }
+
+    // Footer := SegmentIndexFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
+    std::string footer_buf;
+    if (!footer.SerializeToString(&footer_buf)) {
+        return Status::InternalError("failed to serialize segment index footer");
+    }
+    faststring fixed_buf;
+    put_fixed32_le(&fixed_buf, footer_buf.size());
+    put_fixed32_le(&fixed_buf, crc32c::Value(footer_buf.data(), footer_buf.size()));
+    fixed_buf.append(k_index_file_magic, k_index_file_magic_length);
+    std::vector<Slice> slices {footer_buf, fixed_buf};
+    RETURN_IF_ERROR(file_writer->appendv(&slices[0], slices.size()));
+    RETURN_IF_ERROR(file_writer->close());
+    RETURN_IF_ERROR(Env::Default()->rename_file(tmp_path, path));
+    *built = true;
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "io/fs/file_reader.h"
+
+namespace doris {
+
+class TabletColumn;
+class TabletSchema;
+
+namespace segment_v2 {
+
+class Segment;
+
+// The index file of a segment holds the indexes of the columns of its schema that the segment
+// file lacks, because the schema change adding them linked the segment instead of rewriting it.
+// They are built later from the values of their columns only, and the ColumnReader loads them
+// from the index file.
+//
+// IndexFile := Index..., SegmentIndexFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
+class SegmentIndexFile {
+public:
+    // the types of the indexes the segments of schema have for column
+    static std::vector<ColumnIndexTypePB> index_types(const TabletSchema& schema,
+                                                      const TabletColumn& column);
+
+    // whether the segments written with old_schema lack some indexes of new_schema
+    static bool lacks_indexes(const TabletSchema& old_schema, const TabletSchema& new_schema);
+
+    static Status read_footer(io::FileReader* file_reader, SegmentIndexFooterPB* footer);
+
+    // Writes the index file of segment at path, which is on the local file system, with the
+    // indexes of its schema that the segment file lacks. *built is false if it lacks none, and
+    // the file isn't written then. before_read is called with the size of each data page of the
+    // segment before it's read, to throttle the reads.
+    static Status build(Segment* segment, const std::string& path,
+                        const std::function<void(size_t)>& before_read, bool* built);
+};
+
+} // namespace segment_v2
+} // namespace doris
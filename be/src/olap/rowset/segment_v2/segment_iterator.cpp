@@ -17,6 +17,7 @@
 
 #include "olap/rowset/segment_v2/segment_iterator.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <utility>
@@ -29,9 +30,16 @@
 #include "olap/row_cursor.h"
 #include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/rowset/segment_v2/segment.h"
+#include "olap/segment_meta_cache.h"
 #include "olap/short_key_index.h"
+#include "olap/topn_boundary.h"
+#include "olap/wrapper_field.h"
 #include "util/doris_metrics.h"
 #include "util/simd/bits.h"
+#include "util/time.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_common.h"
+#include "vec/common/assert_cast.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -108,6 +116,8 @@ SegmentIterator::SegmentIterator(std::shared_ptr<Segment> segment, const Schema&
           _schema(schema),
           _column_iterators(_schema.num_columns(), nullptr),
           _bitmap_index_iterators(_schema.num_columns(), nullptr),
+          _inverted_index_iterators(_schema.num_columns(), nullptr),
+          _bit_sliced_index_iterators(_schema.num_columns(), nullptr),
           _cur_rowid(0),
           _lazy_materialization_read(false),
           _inited(false),
@@ -120,6 +130,12 @@ SegmentIterator::~SegmentIterator() {
     for (auto iter : _bitmap_index_iterators) {
         delete iter;
     }
+    for (auto iter : _inverted_index_iterators) {
+        delete iter;
+    }
+    for (auto iter : _bit_sliced_index_iterators) {
+        delete iter;
+    }
 }
 
 Status SegmentIterator::init(const StorageReadOptions& opts) {
@@ -138,17 +154,45 @@ Status SegmentIterator::_init(bool is_vec) {
     // get file handle from file descriptor of segment
     _file_reader = _segment->_file_reader;
 
-    _row_bitmap.addRange(0, _segment->num_rows());
+    if (_opts.segment_row_ranges != nullptr) {
+        auto it = _opts.segment_row_ranges->find(_segment->id());
+        DCHECK(it != _opts.segment_row_ranges->end());
+        uint32_t end = std::min(it->second.second, _segment->num_rows());
+        if (it->second.first < end) {
+            _row_bitmap.addRange(it->second.first, end);
+        }
+    } else {
+        _row_bitmap.addRange(0, _segment->num_rows());
+    }
     RETURN_IF_ERROR(_init_return_column_iterators());
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
+    RETURN_IF_ERROR(_init_inverted_index_iterators());
+    RETURN_IF_ERROR(_init_bit_sliced_index_iterators());
     // z-order can not use prefix index
     if (_segment->_tablet_schema.sort_type() != SortType::ZORDER) {
         RETURN_IF_ERROR(_get_row_ranges_by_keys());
     }
+    if (is_vec) {
+        RETURN_IF_ERROR(_apply_deleted_rows());
+    }
     RETURN_IF_ERROR(_get_row_ranges_by_column_conditions());
     if (is_vec) {
         _vec_init_lazy_materialization();
         _vec_init_char_column_id();
+        _answer_by_metadata = _can_answer_by_metadata();
+        if (int32_t interval = config::adaptive_predicate_order_interval_blocks; interval > 0) {
+            using Order = AdaptivePredicateOrder<ColumnPredicate*>;
+            _short_cir_pred_order = std::make_unique<Order>(interval);
+            _late_short_cir_pred_order = std::make_unique<Order>(interval);
+        }
+        if (_answer_by_metadata) {
+            _opts.stats->metadata_answered_segment_number++;
+        }
+        // a wide projection reads each row from one page of the row store instead of a page
+        // per column
+        _read_from_row_store =
+                _lazy_materialization_read && _segment->has_row_store() &&
+                _non_predicate_columns.size() >= config::row_store_min_read_columns;
     } else {
         _init_lazy_materialization();
     }
@@ -183,15 +227,99 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
         auto row_range = RowRanges::create_single(lower_rowid, upper_rowid);
         RowRanges::ranges_union(result_ranges, row_range, &result_ranges);
     }
-    // pre-condition: _row_ranges == [0, num_rows)
     size_t pre_size = _row_bitmap.cardinality();
-    _row_bitmap = RowRanges::ranges_to_roaring(result_ranges);
+    _row_bitmap &= RowRanges::ranges_to_roaring(result_ranges);
     _opts.stats->rows_key_range_filtered += (pre_size - _row_bitmap.cardinality());
     DorisMetrics::instance()->segment_rows_by_short_key->increment(_row_bitmap.cardinality());
 
     return Status::OK();
 }
 
+Status SegmentIterator::_apply_deleted_rows() {
+    auto meta_cache = SegmentMetaCache::instance();
+    const auto& predicates = _opts.delete_condition_predicates;
+    // the conditions without the column predicates are only evaluated on the pages
+    if (!config::enable_deleted_rows_cache || meta_cache == nullptr ||
+        _opts.delete_condition_version < 0 || _row_bitmap.isEmpty() ||
+        predicates->num_of_column_predicate() == 0 ||
+        predicates->num_of_column_predicate() != _opts.delete_conditions.size()) {
+        return Status::OK();
+    }
+    auto key = SegmentMetaCache::key(_file_reader->path().native(), SegmentMetaCache::DELETED_ROWS,
+                                     _opts.delete_condition_version);
+    auto deleted_rows = meta_cache->lookup<roaring::Roaring>(key);
+    if (deleted_rows == nullptr) {
+        // computing them reads the delete columns of the whole segment, so a read of a small
+        // part of it, e.g. of a short key range, evaluates the conditions on its rows instead
+        if (_row_bitmap.cardinality() * 2 < num_rows()) {
+            return Status::OK();
+        }
+        auto computed = std::make_shared<roaring::Roaring>();
+        RETURN_IF_ERROR(_compute_deleted_rows(computed.get()));
+        computed->runOptimize();
+        meta_cache->insert(key, computed, computed->getSizeInBytes(), false);
+        deleted_rows = std::move(computed);
+    }
+    size_t pre_size = _row_bitmap.cardinality();
+    _row_bitmap -= *deleted_rows;
+    _opts.stats->rows_vec_del_cond_filtered += pre_size - _row_bitmap.cardinality();
+    // the predicates are shared with the iterators of the other segments
+    _opts.delete_conditions.clear();
+    _opts.delete_condition_predicates = std::make_shared<AndBlockColumnPredicate>();
+    return Status::OK();
+}
+
+Status SegmentIterator::_compute_deleted_rows(roaring::Roaring* deleted_rows) {
+    std::set<ColumnId> cid_set;
+    _opts.delete_condition_predicates->get_all_column_ids(cid_set);
+    std::vector<ColumnId> cids(cid_set.begin(), cid_set.end());
+    // not the iterators of the segment, which are positioned at the rows read
+    std::vector<std::unique_ptr<ColumnIterator>> iterators;
+    vectorized::MutableColumns columns(_opts.tablet_schema->num_columns());
+    for (auto cid : cids) {
+        const auto& column = _opts.tablet_schema->column(cid);
+        ColumnIterator* iter = nullptr;
+        RETURN_IF_ERROR(_segment->new_column_iterator(column, &iter));
+        iterators.emplace_back(iter);
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = _opts.stats;
+        iter_opts.use_page_cache = _opts.use_page_cache;
+        iter_opts.prefetch = _segment->_is_remote;
+        iter_opts.file_reader = _file_reader.get();
+        RETURN_IF_ERROR(iter->init(iter_opts));
+        RETURN_IF_ERROR(iter->seek_to_ordinal(0));
+        columns[cid] =
+                Schema::get_predicate_column_nullable_ptr(column.type(), column.is_nullable());
+    }
+
+    std::vector<uint16_t> sel_rowid_idx(_opts.block_row_max);
+    for (rowid_t start = 0; start < num_rows();) {
+        uint16_t rows = std::min<uint32_t>(_opts.block_row_max, num_rows() - start);
+        for (size_t i = 0; i < cids.size(); ++i) {
+            auto& column = columns[cids[i]];
+            column->clear();
+            size_t rows_read = rows;
+            RETURN_IF_ERROR(iterators[i]->next_batch(&rows_read, column));
+            DCHECK_EQ(rows, rows_read);
+        }
+        for (uint16_t i = 0; i < rows; ++i) {
+            sel_rowid_idx[i] = i;
+        }
+        // the rows selected are the rows not deleted
+        uint16_t selected_size = _opts.delete_condition_predicates->evaluate(
+                columns, sel_rowid_idx.data(), rows);
+        for (uint16_t row = 0, i = 0; row < rows; ++row) {
+            if (i < selected_size && sel_rowid_idx[i] == row) {
+                ++i;
+            } else {
+                deleted_rows->add(start + row);
+            }
+        }
+        start += rows;
+    }
+    return Status::OK();
+}
+
 // Set up environment for the following seek.
 Status SegmentIterator::_prepare_seek(const StorageReadOptions::KeyRange& key_range) {
     std::vector<const Field*> key_fields;
@@ -232,6 +360,9 @@ Status SegmentIterator::_get_row_ranges_by_column_conditions() {
     if (_row_bitmap.isEmpty()) {
         return Status::OK();
     }
+    // before the bitmap index, which removes the predicates it evaluates
+    RETURN_IF_ERROR(_apply_ngram_bloom_filter());
+    RETURN_IF_ERROR(_apply_inverted_index());
     RETURN_IF_ERROR(_apply_bitmap_index());
 
     if (!_row_bitmap.isEmpty() &&
@@ -315,6 +446,50 @@ Status SegmentIterator::_get_row_ranges_from_conditions(RowRanges* condition_row
     return Status::OK();
 }
 
+Status SegmentIterator::_apply_topn_boundary() {
+    if (_opts.topn_boundary == nullptr ||
+        _opts.topn_boundary->version() == _topn_boundary_version) {
+        return Status::OK();
+    }
+    TCondition condition;
+    _topn_boundary_version = _opts.topn_boundary->get_condition(&condition);
+    int32_t cid = _opts.tablet_schema->field_index(condition.column_name);
+    if (cid < 0 || _column_iterators[cid] == nullptr) {
+        return Status::OK();
+    }
+    Conditions conditions;
+    conditions.set_tablet_schema(_opts.tablet_schema);
+    // the boundary only skips rows, so a value the column can't parse just skips nothing
+    if (!conditions.append_condition(condition).ok() || conditions.get_column(cid) == nullptr) {
+        return Status::OK();
+    }
+    RowRanges row_ranges = RowRanges::create_single(num_rows());
+    RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(conditions.get_column(cid),
+                                                                       nullptr, &row_ranges));
+    if (_opts.topn_boundary->nulls_first()) {
+        // the null rows come before any value, so the pages having nulls are always read
+        TCondition is_null;
+        is_null.__set_column_name(condition.column_name);
+        is_null.__set_condition_op("is");
+        is_null.__set_condition_values({"null"});
+        Conditions null_conditions;
+        null_conditions.set_tablet_schema(_opts.tablet_schema);
+        RETURN_IF_ERROR(null_conditions.append_condition(is_null));
+        RowRanges null_ranges = RowRanges::create_single(num_rows());
+        RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(
+                null_conditions.get_column(cid), nullptr, &null_ranges));
+        RowRanges::ranges_union(row_ranges, null_ranges, &row_ranges);
+    }
+
+    // `_range_iter` buffers the rows of the bitmap, so it's recreated on the rows not read yet
+    _row_bitmap &= RowRanges::ranges_to_roaring(RowRanges::create_single(_range_end, num_rows()));
+    size_t pre_size = _row_bitmap.cardinality();
+    _row_bitmap &= RowRanges::ranges_to_roaring(row_ranges);
+    _opts.stats->rows_topn_filtered += (pre_size - _row_bitmap.cardinality());
+    _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
+    return Status::OK();
+}
+
 // filter rows by evaluating column predicates using bitmap indexes.
 // upon return, predicates that've been evaluated by bitmap indexes are removed from _col_predicates.
 Status SegmentIterator::_apply_bitmap_index() {
@@ -324,8 +499,18 @@ Status SegmentIterator::_apply_bitmap_index() {
 
     for (auto pred : _col_predicates) {
         if (_bitmap_index_iterators[pred->column_id()] == nullptr) {
-            // no bitmap index for this column
-            remaining_predicates.push_back(pred);
+            auto iterator = _bit_sliced_index_iterators[pred->column_id()];
+            bool evaluated = false;
+            if (iterator != nullptr) {
+                RETURN_IF_ERROR(pred->evaluate_bit_sliced_index(iterator, _segment->num_rows(),
+                                                                &_row_bitmap, &evaluated));
+            }
+            if (!evaluated) {
+                // no bitmap index for this column, or the predicate can't use it
+                remaining_predicates.push_back(pred);
+            } else if (_row_bitmap.isEmpty()) {
+                break;
+            }
         } else {
             RETURN_IF_ERROR(pred->evaluate(_schema, _bitmap_index_iterators, _segment->num_rows(),
                                            &_row_bitmap));
@@ -339,6 +524,40 @@ Status SegmentIterator::_apply_bitmap_index() {
     return Status::OK();
 }
 
+Status SegmentIterator::_apply_ngram_bloom_filter() {
+    size_t input_rows = _row_bitmap.cardinality();
+    for (auto pred : _col_predicates) {
+        if (_row_bitmap.isEmpty()) {
+            break;
+        }
+        RowRanges row_ranges = RowRanges::create_single(num_rows());
+        RETURN_IF_ERROR(_column_iterators[pred->column_id()]->get_row_ranges_by_ngram_bloom_filter(
+                pred, &row_ranges));
+        if (row_ranges.count() < num_rows()) {
+            _row_bitmap &= RowRanges::ranges_to_roaring(row_ranges);
+        }
+    }
+    _opts.stats->rows_bf_filtered += (input_rows - _row_bitmap.cardinality());
+    return Status::OK();
+}
+
+Status SegmentIterator::_apply_inverted_index() {
+    SCOPED_RAW_TIMER(&_opts.stats->inverted_index_filter_timer);
+    size_t input_rows = _row_bitmap.cardinality();
+    for (auto pred : _col_predicates) {
+        if (_row_bitmap.isEmpty()) {
+            break;
+        }
+        auto iterator = _inverted_index_iterators[pred->column_id()];
+        if (iterator != nullptr) {
+            RETURN_IF_ERROR(pred->evaluate_inverted_index(_schema, iterator, _segment->num_rows(),
+                                                          &_row_bitmap));
+        }
+    }
+    _opts.stats->rows_inverted_index_filtered += (input_rows - _row_bitmap.cardinality());
+    return Status::OK();
+}
+
 Status SegmentIterator::_init_return_column_iterators() {
     if (_cur_rowid >= num_rows()) {
         return Status::OK();
@@ -350,6 +569,8 @@ Status SegmentIterator::_init_return_column_iterators() {
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
             iter_opts.use_page_cache = _opts.use_page_cache;
+            iter_opts.bulk_scan = _opts.bulk_scan;
+            iter_opts.prefetch = _segment->_is_remote;
             iter_opts.file_reader = _file_reader.get();
             RETURN_IF_ERROR(_column_iterators[cid]->init(iter_opts));
         }
@@ -370,6 +591,32 @@ Status SegmentIterator::_init_bitmap_index_iterators() {
     return Status::OK();
 }
 
+Status SegmentIterator::_init_bit_sliced_index_iterators() {
+    if (_cur_rowid >= num_rows()) {
+        return Status::OK();
+    }
+    for (auto cid : _schema.column_ids()) {
+        if (_bit_sliced_index_iterators[cid] == nullptr) {
+            RETURN_IF_ERROR(_segment->new_bit_sliced_index_iterator(
+                    _opts.tablet_schema->column(cid), &_bit_sliced_index_iterators[cid]));
+        }
+    }
+    return Status::OK();
+}
+
+Status SegmentIterator::_init_inverted_index_iterators() {
+    if (_cur_rowid >= num_rows()) {
+        return Status::OK();
+    }
+    for (auto cid : _schema.column_ids()) {
+        if (_inverted_index_iterators[cid] == nullptr) {
+            RETURN_IF_ERROR(_segment->new_inverted_index_iterator(
+                    _opts.tablet_schema->column(cid), &_inverted_index_iterators[cid]));
+        }
+    }
+    return Status::OK();
+}
+
 // Schema of lhs and rhs are different.
 // callers should assure that rhs' schema has all columns in lhs schema
 template <typename LhsRowType, typename RhsRowType>
@@ -707,9 +954,64 @@ void SegmentIterator::_vec_init_lazy_materialization() {
 
     // Step 3: fill column ids for read and output
     if (_lazy_materialization_read) {
+        // The vectorized predicates of a column having no other predicate are evaluated on its
+        // pages if their encoding allows it.
+        for (auto cid : _vec_pred_column_ids) {
+            if (std::find(_short_cir_pred_column_ids.begin(), _short_cir_pred_column_ids.end(),
+                          cid) == _short_cir_pred_column_ids.end() &&
+                _column_iterators[cid]->can_evaluate_predicates_on_pages()) {
+                _page_pred_column_ids.push_back(cid);
+            }
+        }
+        if (!_page_pred_column_ids.empty()) {
+            _page_eval_predicates.resize(_page_pred_column_ids.size());
+            std::vector<ColumnPredicate*> pre_eval_block_predicate;
+            for (auto predicate : _pre_eval_block_predicate) {
+                auto it = std::find(_page_pred_column_ids.begin(), _page_pred_column_ids.end(),
+                                    predicate->column_id());
+                if (it != _page_pred_column_ids.end()) {
+                    _page_eval_predicates[it - _page_pred_column_ids.begin()].push_back(predicate);
+                } else {
+                    pre_eval_block_predicate.push_back(predicate);
+                }
+            }
+            _pre_eval_block_predicate.swap(pre_eval_block_predicate);
+        }
+
+        // A column having only short circuit predicates is read after the other predicates
+        // filtered the block, as long as some other predicate is evaluated before.
+        std::set<ColumnId> late_pred_column_ids;
+        for (auto cid : _short_cir_pred_column_ids) {
+            if (std::find(_vec_pred_column_ids.begin(), _vec_pred_column_ids.end(), cid) ==
+                        _vec_pred_column_ids.end() &&
+                del_cond_id_set.find(cid) == del_cond_id_set.end()) {
+                late_pred_column_ids.insert(cid);
+            }
+        }
+        if (late_pred_column_ids.size() < pred_column_ids.size()) {
+            _late_short_cir_pred_column_ids.assign(late_pred_column_ids.begin(),
+                                                   late_pred_column_ids.end());
+            std::vector<ColumnPredicate*> short_cir_eval_predicate;
+            for (auto predicate : _short_cir_eval_predicate) {
+                if (late_pred_column_ids.count(predicate->column_id())) {
+                    _late_short_cir_eval_predicate.push_back(predicate);
+                } else {
+                    short_cir_eval_predicate.push_back(predicate);
+                }
+            }
+            _short_cir_eval_predicate.swap(short_cir_eval_predicate);
+        }
+
+        _late_read_column_ids = _late_short_cir_pred_column_ids;
+        _late_read_column_ids.insert(_late_read_column_ids.end(), _page_pred_column_ids.begin(),
+                                     _page_pred_column_ids.end());
+
         // insert pred cid to first_read_columns
         for (auto cid : pred_column_ids) {
-            _first_read_column_ids.push_back(cid);
+            if (std::find(_late_read_column_ids.begin(), _late_read_column_ids.end(), cid) ==
+                _late_read_column_ids.end()) {
+                _first_read_column_ids.push_back(cid);
+            }
         }
     } else if (!_is_need_vec_eval &&
                !_is_need_short_eval) { // no pred exists, just read and output column
@@ -757,8 +1059,15 @@ bool SegmentIterator::_can_evaluated_by_vectorized(ColumnPredicate* predicate) {
     case PredicateType::GT: {
         if (field_type == OLAP_FIELD_TYPE_VARCHAR || field_type == OLAP_FIELD_TYPE_CHAR ||
             field_type == OLAP_FIELD_TYPE_STRING) {
-            return config::enable_low_cardinality_optimize &&
-                   _column_iterators[cid]->is_all_dict_encoding();
+            if (config::enable_low_cardinality_optimize &&
+                _column_iterators[cid]->is_all_dict_encoding()) {
+                return true;
+            }
+            // the equality and prefix predicates can be evaluated on the fsst pages
+            std::string value;
+            return field_type != OLAP_FIELD_TYPE_CHAR &&
+                   _column_iterators[cid]->can_evaluate_predicates_on_pages() &&
+                   (predicate->is_string_equal(&value) || predicate->is_string_prefix(&value));
         } else if (field_type == OLAP_FIELD_TYPE_DECIMAL) {
             return false;
         }
@@ -836,6 +1145,10 @@ void SegmentIterator::_output_non_pred_columns(vectorized::Block* block) {
 Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32_t& nrows_read,
                                                bool set_block_rowid) {
     SCOPED_RAW_TIMER(&_opts.stats->first_read_ns);
+    // The late reads of the previous block moved the iterators of the page predicate columns
+    // to its last selected row, so they are seeked to the first range even if it follows that
+    // block.
+    bool page_pred_columns_seeked = false;
     do {
         uint32_t range_from;
         uint32_t range_to;
@@ -844,15 +1157,21 @@ Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32
         if (!has_next_range) {
             break;
         }
+        _range_end = range_to;
         if (_cur_rowid == 0 || _cur_rowid != range_from) {
             _cur_rowid = range_from;
             _opts.stats->block_first_read_seek_num += 1;
             SCOPED_RAW_TIMER(&_opts.stats->block_first_read_seek_ns);
             RETURN_IF_ERROR(_seek_columns(_first_read_column_ids, _cur_rowid));
+            RETURN_IF_ERROR(_seek_columns(_page_pred_column_ids, _cur_rowid));
+        } else if (!page_pred_columns_seeked) {
+            RETURN_IF_ERROR(_seek_columns(_page_pred_column_ids, _cur_rowid));
         }
+        page_pred_columns_seeked = true;
         size_t rows_to_read = range_to - range_from;
         RETURN_IF_ERROR(
                 _read_columns(_first_read_column_ids, _current_return_columns, rows_to_read));
+        RETURN_IF_ERROR(_evaluate_page_predicates(rows_to_read, nrows_read));
         _cur_rowid += rows_to_read;
         if (set_block_rowid) {
             // Here use std::iota is better performance than for-loop, maybe for-loop is not vectorized
@@ -867,6 +1186,24 @@ Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32
     return Status::OK();
 }
 
+Status SegmentIterator::_evaluate_page_predicates(size_t nrows, size_t offset) {
+    bool* flags = _page_pred_flags.get() + offset;
+    for (size_t i = 0; i < _page_pred_column_ids.size(); ++i) {
+        bool* column_flags = i == 0 ? flags : _page_pred_column_flags.get();
+        size_t rows_read = nrows;
+        RETURN_IF_ERROR(_column_iterators[_page_pred_column_ids[i]]->evaluate_predicates(
+                _page_eval_predicates[i], &rows_read, _page_pred_scratch_columns[i],
+                column_flags));
+        DCHECK_EQ(nrows, rows_read);
+        if (i > 0) {
+            for (size_t j = 0; j < nrows; ++j) {
+                flags[j] &= column_flags[j];
+            }
+        }
+    }
+    return Status::OK();
+}
+
 uint16_t SegmentIterator::_evaluate_vectorization_predicate(uint16_t* sel_rowid_idx,
                                                             uint16_t selected_size) {
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
@@ -879,46 +1216,29 @@ uint16_t SegmentIterator::_evaluate_vectorization_predicate(uint16_t* sel_rowid_
 
     uint16_t original_size = selected_size;
     bool ret_flags[original_size];
-    DCHECK(_pre_eval_block_predicate.size() > 0);
-    auto column_id = _pre_eval_block_predicate[0]->column_id();
-    auto& column = _current_return_columns[column_id];
-    _pre_eval_block_predicate[0]->evaluate_vec(*column, original_size, ret_flags);
-    for (int i = 1; i < _pre_eval_block_predicate.size(); i++) {
-        auto column_id2 = _pre_eval_block_predicate[i]->column_id();
-        auto& column2 = _current_return_columns[column_id2];
-        _pre_eval_block_predicate[i]->evaluate_and_vec(*column2, original_size, ret_flags);
-    }
-
-    uint16_t new_size = 0;
-
-    uint32_t sel_pos = 0;
-    const uint32_t sel_end = sel_pos + selected_size;
-    static constexpr size_t SIMD_BYTES = 32;
-    const uint32_t sel_end_simd = sel_pos + selected_size / SIMD_BYTES * SIMD_BYTES;
-
-    while (sel_pos < sel_end_simd) {
-        auto mask = simd::bytes32_mask_to_bits32_mask(ret_flags + sel_pos);
-        if (0 == mask) {
-            //pass
-        } else if (0xffffffff == mask) {
-            for (uint32_t i = 0; i < SIMD_BYTES; i++) {
-                sel_rowid_idx[new_size++] = sel_pos + i;
-            }
-        } else {
-            while (mask) {
-                const size_t bit_pos = __builtin_ctzll(mask);
-                sel_rowid_idx[new_size++] = sel_pos + bit_pos;
-                mask = mask & (mask - 1);
+    if (_pre_eval_block_predicate.empty()) {
+        // all the vectorized predicates have been evaluated on the pages
+        DCHECK(!_page_pred_column_ids.empty());
+        memcpy(ret_flags, _page_pred_flags.get(), original_size);
+    } else {
+        auto column_id = _pre_eval_block_predicate[0]->column_id();
+        auto& column = _current_return_columns[column_id];
+        _pre_eval_block_predicate[0]->evaluate_vec(*column, original_size, ret_flags);
+        for (int i = 1; i < _pre_eval_block_predicate.size(); i++) {
+            auto column_id2 = _pre_eval_block_predicate[i]->column_id();
+            auto& column2 = _current_return_columns[column_id2];
+            _pre_eval_block_predicate[i]->evaluate_and_vec(*column2, original_size, ret_flags);
+        }
+        if (!_page_pred_column_ids.empty()) {
+            const bool* page_flags = _page_pred_flags.get();
+            for (uint16_t i = 0; i < original_size; ++i) {
+                ret_flags[i] &= page_flags[i];
             }
         }
-        sel_pos += SIMD_BYTES;
     }
 
-    for (; sel_pos < sel_end; sel_pos++) {
-        if (ret_flags[sel_pos]) {
-            sel_rowid_idx[new_size++] = sel_pos;
-        }
-    }
+    uint16_t new_size = vectorized::filter_to_selection(reinterpret_cast<const uint8_t*>(ret_flags),
+                                                        selected_size, sel_rowid_idx);
 
     _opts.stats->rows_vec_cond_filtered += original_size - new_size;
     return new_size;
@@ -932,11 +1252,8 @@ uint16_t SegmentIterator::_evaluate_short_circuit_predicate(uint16_t* vec_sel_ro
     }
 
     uint16_t original_size = selected_size;
-    for (auto predicate : _short_cir_eval_predicate) {
-        auto column_id = predicate->column_id();
-        auto& short_cir_column = _current_return_columns[column_id];
-        selected_size = predicate->evaluate(*short_cir_column, vec_sel_rowid_idx, selected_size);
-    }
+    selected_size = _evaluate_in_order(&_short_cir_eval_predicate, _short_cir_pred_order.get(),
+                                       vec_sel_rowid_idx, selected_size);
     _opts.stats->rows_vec_cond_filtered += original_size - selected_size;
 
     // evaluate delete condition
@@ -947,11 +1264,59 @@ uint16_t SegmentIterator::_evaluate_short_circuit_predicate(uint16_t* vec_sel_ro
     return selected_size;
 }
 
+uint16_t SegmentIterator::_evaluate_in_order(std::vector<ColumnPredicate*>* predicates,
+                                             AdaptivePredicateOrder<ColumnPredicate*>* order,
+                                             uint16_t* sel_rowid_idx, uint16_t selected_size) {
+    for (size_t i = 0; i < predicates->size() && selected_size > 0; ++i) {
+        auto* predicate = (*predicates)[i];
+        auto& column = _current_return_columns[predicate->column_id()];
+        if (order == nullptr) {
+            selected_size = predicate->evaluate(*column, sel_rowid_idx, selected_size);
+            continue;
+        }
+        uint16_t input_size = selected_size;
+        int64_t start_ns = MonotonicNanos();
+        selected_size = predicate->evaluate(*column, sel_rowid_idx, selected_size);
+        order->update(i, input_size, selected_size, MonotonicNanos() - start_ns);
+    }
+    if (order != nullptr) {
+        order->reorder(predicates);
+    }
+    return selected_size;
+}
+
+Status SegmentIterator::_evaluate_late_short_circuit_predicate(uint16_t* sel_rowid_idx,
+                                                               uint16_t* late_sel_rowid_idx,
+                                                               uint16_t* selected_size) {
+    RETURN_IF_ERROR(_read_columns_by_rowids(_late_read_column_ids, _block_rowids, sel_rowid_idx,
+                                            *selected_size, &_current_return_columns));
+
+    SCOPED_RAW_TIMER(&_opts.stats->short_cond_ns);
+    _convert_dict_code_for_predicate_if_necessary(_late_short_cir_eval_predicate);
+    // The late columns only hold the selected rows, so they are filtered by their own positions,
+    // which are mapped back to the positions in the block afterwards.
+    uint16_t original_size = *selected_size;
+    uint16_t new_size = original_size;
+    std::iota(late_sel_rowid_idx, late_sel_rowid_idx + original_size, 0);
+    new_size = _evaluate_in_order(&_late_short_cir_eval_predicate,
+                                  _late_short_cir_pred_order.get(), late_sel_rowid_idx, new_size);
+    for (uint16_t i = 0; i < new_size; ++i) {
+        sel_rowid_idx[i] = sel_rowid_idx[late_sel_rowid_idx[i]];
+    }
+    _opts.stats->rows_vec_cond_filtered += original_size - new_size;
+    *selected_size = new_size;
+    return Status::OK();
+}
+
 Status SegmentIterator::_read_columns_by_rowids(std::vector<ColumnId>& read_column_ids,
                                                 std::vector<rowid_t>& rowid_vector,
                                                 uint16_t* sel_rowid_idx, size_t select_size,
                                                 vectorized::MutableColumns* mutable_columns) {
     SCOPED_RAW_TIMER(&_opts.stats->lazy_read_ns);
+    if (select_size == 0) {
+        // no row survived, don't seek to any page
+        return Status::OK();
+    }
     std::vector<rowid_t> rowids(select_size);
     for (size_t i = 0; i < select_size; ++i) {
         rowids[i] = rowid_vector[sel_rowid_idx[i]];
@@ -964,6 +1329,33 @@ Status SegmentIterator::_read_columns_by_rowids(std::vector<ColumnId>& read_colu
     return Status::OK();
 }
 
+Status SegmentIterator::_read_non_predicate_columns(uint16_t* sel_rowid_idx, size_t select_size) {
+    if (_read_from_row_store && select_size > 0) {
+        SCOPED_RAW_TIMER(&_opts.stats->lazy_read_ns);
+        std::vector<rowid_t> rowids(select_size);
+        for (size_t i = 0; i < select_size; ++i) {
+            rowids[i] = _block_rowids[sel_rowid_idx[i]];
+        }
+        std::vector<const TabletColumn*> columns;
+        std::vector<vectorized::IColumn*> dst;
+        for (auto cid : _non_predicate_columns) {
+            columns.push_back(&_opts.tablet_schema->column(cid));
+            dst.push_back(_current_return_columns[cid].get());
+        }
+        Status st = _segment->read_columns_from_row_store(columns, rowids.data(), select_size,
+                                                          _opts.stats, dst);
+        if (!st.is_not_supported()) {
+            return st;
+        }
+        // nothing was read, and the row store can't serve the other blocks either
+        VLOG_DEBUG << "read the columns of segment " << _segment->id()
+                   << " instead of its row store: " << st.to_string();
+        _read_from_row_store = false;
+    }
+    return _read_columns_by_rowids(_non_predicate_columns, _block_rowids, sel_rowid_idx,
+                                   select_size, &_current_return_columns);
+}
+
 Status SegmentIterator::next_batch(vectorized::Block* block) {
     bool is_mem_reuse = block->mem_reuse();
     DCHECK(is_mem_reuse);
@@ -975,6 +1367,15 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
         if (_lazy_materialization_read) {
             _block_rowids.resize(_opts.block_row_max);
         }
+        if (!_page_pred_column_ids.empty()) {
+            _page_pred_flags.reset(new bool[_opts.block_row_max]);
+            _page_pred_column_flags.reset(new bool[_opts.block_row_max]);
+            for (auto cid : _page_pred_column_ids) {
+                auto column_desc = _schema.column(cid);
+                _page_pred_scratch_columns.emplace_back(Schema::get_predicate_column_nullable_ptr(
+                        column_desc->type(), column_desc->is_nullable()));
+            }
+        }
         _current_return_columns.resize(_schema.columns().size());
         for (size_t i = 0; i < _schema.num_column_ids(); i++) {
             auto cid = _schema.column_id(i);
@@ -998,7 +1399,12 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
         }
     }
 
+    if (_answer_by_metadata) {
+        return _next_batch_by_metadata(block);
+    }
+
     _init_current_block(block, _current_return_columns);
+    RETURN_IF_ERROR(_apply_topn_boundary());
 
     uint32_t nrows_read = 0;
     uint32_t nrows_read_limit = _opts.block_row_max;
@@ -1006,7 +1412,13 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
         // read 100 rows to estimate average row size
         nrows_read_limit = 100;
     }
-    _read_columns_by_index(nrows_read_limit, nrows_read, _lazy_materialization_read);
+    if (_opts.read_limit >= 0) {
+        int64_t rows_left = std::max<int64_t>(0, _opts.read_limit - _rows_returned);
+        nrows_read_limit = std::min<int64_t>(nrows_read_limit, rows_left);
+    }
+    if (nrows_read_limit > 0) {
+        _read_columns_by_index(nrows_read_limit, nrows_read, _lazy_materialization_read);
+    }
 
     _opts.stats->blocks_load += 1;
     _opts.stats->raw_rows_read += nrows_read;
@@ -1051,20 +1463,33 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
             if (UNLIKELY(_estimate_row_size) && block->rows() > 0) {
                 _update_max_row(block);
             }
+            _rows_returned += block->rows();
             return ret;
         }
 
-        // step3: read non_predicate column
-        RETURN_IF_ERROR(_read_columns_by_rowids(_non_predicate_columns, _block_rowids,
-                                                sel_rowid_idx, selected_size,
-                                                &_current_return_columns));
+        // step 3: read the late read columns for the selected rows, and evaluate the late short
+        // circuit predicates
+        uint16_t late_sel_rowid_idx[_late_read_column_ids.empty() ? 1 : nrows_read];
+        if (!_late_read_column_ids.empty()) {
+            RETURN_IF_ERROR(_evaluate_late_short_circuit_predicate(
+                    sel_rowid_idx, late_sel_rowid_idx, &selected_size));
+        }
+
+        // step4: read non_predicate column
+        RETURN_IF_ERROR(_read_non_predicate_columns(sel_rowid_idx, selected_size));
 
-        // step4: output columns
-        // 4.1 output non-predicate column
+        // step5: output columns
+        // 5.1 output non-predicate column
         _output_non_pred_columns(block);
 
-        // 4.3 output short circuit and predicate column
+        // 5.2 output the late read columns, which only hold the rows selected by the first read
+        // columns
+        RETURN_IF_ERROR(_output_column_by_sel_idx(block, _late_read_column_ids, late_sel_rowid_idx,
+                                                  selected_size));
+
+        // 5.3 output short circuit and predicate column
         // when lazy materialization enables, _first_read_column_ids = distinct(_short_cir_pred_column_ids + _vec_pred_column_ids)
+        // except _late_read_column_ids
         // see _vec_init_lazy_materialization
         // todo(wb) need to tell input columnids from output columnids
         RETURN_IF_ERROR(_output_column_by_sel_idx(block, _first_read_column_ids, sel_rowid_idx,
@@ -1077,6 +1502,7 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
     if (UNLIKELY(_estimate_row_size) && block->rows() > 0) {
         _update_max_row(block);
     }
+    _rows_returned += block->rows();
     return Status::OK();
 }
 
@@ -1088,5 +1514,106 @@ void SegmentIterator::_update_max_row(const vectorized::Block* block) {
     _opts.block_row_max = std::min(block_row_max, _opts.block_row_max);
 }
 
+// The types whose values in a zone map are exact and stored as the columns of the query engine
+// take them. The strings of a zone map may be cut.
+static bool is_min_max_in_zone_map(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_BOOL:
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_FLOAT:
+    case OLAP_FIELD_TYPE_DOUBLE:
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_DATEV2:
+    case OLAP_FIELD_TYPE_DATETIMEV2:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool SegmentIterator::_can_answer_by_metadata() const {
+    if (_opts.push_down_agg_type_opt == TPushAggOp::NONE || !_col_predicates.empty() ||
+        _opts.conditions != nullptr || !_opts.delete_conditions.empty() ||
+        _opts.delete_condition_predicates->num_of_column_predicate() > 0 ||
+        _opts.topn_boundary != nullptr || _row_bitmap.cardinality() != num_rows()) {
+        return false;
+    }
+    for (size_t i = 0; i < _schema.num_column_ids(); ++i) {
+        const auto& column = _opts.tablet_schema->column(_schema.column_id(i));
+        auto it = _segment->_column_readers.find(column.unique_id());
+        if (it == _segment->_column_readers.end()) {
+            // the column is added after the segment is written
+            return false;
+        }
+        if (_opts.push_down_agg_type_opt == TPushAggOp::COUNT) {
+            // the nulls are counted by count(column)
+            if (column.is_nullable() && it->second->null_count() < 0) {
+                return false;
+            }
+        } else if (!it->second->has_zone_map() || !is_min_max_in_zone_map(column.type())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status SegmentIterator::_next_batch_by_metadata(vectorized::Block* block) {
+    // the min and the max of every column, or as many rows as the segment has
+    const bool is_min_max = _opts.push_down_agg_type_opt == TPushAggOp::MINMAX;
+    const size_t total_rows = is_min_max ? 2 : num_rows();
+    block->clear_column_data(_schema.num_column_ids());
+    if (_metadata_rows_returned >= total_rows) {
+        return Status::EndOfFile("no more data in segment");
+    }
+    const size_t rows = is_min_max ? total_rows
+                                   : std::min<size_t>(total_rows - _metadata_rows_returned,
+                                                      _opts.block_row_max);
+
+    for (size_t i = 0; i < block->columns(); ++i) {
+        auto cid = _schema.column_id(i);
+        const auto& column = _opts.tablet_schema->column(cid);
+        const ColumnReader* reader = _segment->_column_readers.at(column.unique_id()).get();
+        auto dst = std::move(*block->get_by_position(i).column).mutate();
+        if (!is_min_max) {
+            // the first rows of the segment are its not-null ones
+            int64_t not_null_rows = num_rows() - std::max<int64_t>(0, reader->null_count());
+            size_t not_null = std::clamp<int64_t>(
+                    not_null_rows - static_cast<int64_t>(_metadata_rows_returned), 0, rows);
+            if (dst->is_nullable()) {
+                auto& nullable = assert_cast<vectorized::ColumnNullable&>(*dst);
+                nullable.get_nested_column().insert_many_defaults(not_null);
+                nullable.get_null_map_column().fill(0, not_null);
+                nullable.insert_null_elements(rows - not_null);
+            } else {
+                dst->insert_many_defaults(rows);
+            }
+        } else {
+            std::unique_ptr<WrapperField> min_value(WrapperField::create(column));
+            std::unique_ptr<WrapperField> max_value(WrapperField::create(column));
+            if (!reader->get_segment_min_max(min_value.get(), max_value.get())) {
+                // all the rows of the segment are null
+                assert_cast<vectorized::ColumnNullable&>(*dst).insert_null_elements(rows);
+            } else {
+                if (column.type() == OLAP_FIELD_TYPE_DATE) {
+                    dst->set_date_type();
+                } else if (column.type() == OLAP_FIELD_TYPE_DATETIME) {
+                    dst->set_datetime_type();
+                }
+                dst->insert_many_fix_len_data(static_cast<const char*>(min_value->cell_ptr()), 1);
+                dst->insert_many_fix_len_data(static_cast<const char*>(max_value->cell_ptr()), 1);
+            }
+        }
+        block->replace_by_position(i, std::move(dst));
+    }
+    _metadata_rows_returned += rows;
+    _opts.stats->blocks_load += 1;
+    return Status::OK();
+}
+
 } // namespace segment_v2
 } // namespace doris
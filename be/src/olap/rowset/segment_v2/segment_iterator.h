@@ -24,6 +24,7 @@
 #include "common/status.h"
 #include "io/fs/file_reader.h"
 #include "io/fs/file_system.h"
+#include "olap/adaptive_predicate_order.h"
 #include "olap/olap_common.h"
 #include "olap/olap_cond.h"
 #include "olap/rowset/segment_v2/common.h"
@@ -45,6 +46,7 @@ class ReadableBlock;
 namespace segment_v2 {
 
 class BitmapIndexIterator;
+class BitSlicedIndexIterator;
 class BitmapIndexReader;
 class ColumnIterator;
 
@@ -66,6 +68,8 @@ private:
 
     Status _init_return_column_iterators();
     Status _init_bitmap_index_iterators();
+    Status _init_inverted_index_iterators();
+    Status _init_bit_sliced_index_iterators();
 
     // calculate row ranges that fall into requested key ranges using short key index
     Status _get_row_ranges_by_keys();
@@ -74,10 +78,25 @@ private:
                            rowid_t* rowid);
     Status _seek_and_peek(rowid_t rowid);
 
+    // Removes the rows deleted by the delete conditions from the row bitmap and drops the
+    // conditions, so they are not evaluated on the rows read. The deleted rows of the segment are
+    // cached for the version of the conditions, and computed on the first read of at least half
+    // of the segment.
+    Status _apply_deleted_rows();
+    Status _compute_deleted_rows(roaring::Roaring* deleted_rows);
+
     // calculate row ranges that satisfy requested column conditions using various column index
     Status _get_row_ranges_by_column_conditions();
     Status _get_row_ranges_from_conditions(RowRanges* condition_row_ranges);
+    // Removes the rows not read yet of the pages that can't have any row of the TopN above the
+    // scan, when its boundary has tightened since the last call.
+    Status _apply_topn_boundary();
     Status _apply_bitmap_index();
+    // Removes the rows that can't match the predicates on the columns with an inverted index,
+    // which still have to be evaluated on the remaining rows.
+    Status _apply_inverted_index();
+    // Removes the pages that the ngram bloom filters tell can't match the LIKE predicates.
+    Status _apply_ngram_bloom_filter();
 
     void _init_lazy_materialization();
     void _vec_init_lazy_materialization();
@@ -101,12 +120,28 @@ private:
                                   bool set_block_rowid);
     void _init_current_block(vectorized::Block* block,
                              std::vector<vectorized::MutableColumnPtr>& non_pred_vector);
+    // Evaluate `_page_eval_predicates` on the next `nrows` rows of their columns, into
+    // `_page_pred_flags` at `offset`.
+    Status _evaluate_page_predicates(size_t nrows, size_t offset);
     uint16_t _evaluate_vectorization_predicate(uint16_t* sel_rowid_idx, uint16_t selected_size);
     uint16_t _evaluate_short_circuit_predicate(uint16_t* sel_rowid_idx, uint16_t selected_size);
+    // Evaluates the predicates one after another on the rows left by the previous ones, and
+    // updates their order when `order` isn't null.
+    uint16_t _evaluate_in_order(std::vector<ColumnPredicate*>* predicates,
+                                AdaptivePredicateOrder<ColumnPredicate*>* order,
+                                uint16_t* sel_rowid_idx, uint16_t selected_size);
+    // Read `_late_read_column_ids` for the selected rows only and filter them by
+    // `_late_short_cir_eval_predicate`. `late_sel_rowid_idx` receives the positions of the
+    // remaining rows in those columns.
+    Status _evaluate_late_short_circuit_predicate(uint16_t* sel_rowid_idx,
+                                                  uint16_t* late_sel_rowid_idx,
+                                                  uint16_t* selected_size);
     void _output_non_pred_columns(vectorized::Block* block);
     Status _read_columns_by_rowids(std::vector<ColumnId>& read_column_ids,
                                    std::vector<rowid_t>& rowid_vector, uint16_t* sel_rowid_idx,
                                    size_t select_size, vectorized::MutableColumns* mutable_columns);
+    // read the non-predicate columns of the selected rows, from the row store if it's worth it
+    Status _read_non_predicate_columns(uint16_t* sel_rowid_idx, size_t select_size);
 
     template <class Container>
     Status _output_column_by_sel_idx(vectorized::Block* block, const Container& column_ids,
@@ -125,17 +160,13 @@ private:
 
     // Dictionary column should do something to initial.
     void _convert_dict_code_for_predicate_if_necessary() {
-        for (auto predicate : _short_cir_eval_predicate) {
-            auto& column = _current_return_columns[predicate->column_id()];
-            auto* col_ptr = column.get();
-            if (PredicateTypeTraits::is_range(predicate->type())) {
-                col_ptr->convert_dict_codes_if_necessary();
-            } else if (PredicateTypeTraits::is_bloom_filter(predicate->type())) {
-                col_ptr->generate_hash_values_for_runtime_filter();
-            }
-        }
+        _convert_dict_code_for_predicate_if_necessary(_short_cir_eval_predicate);
+        _convert_dict_code_for_predicate_if_necessary(_pre_eval_block_predicate);
+    }
 
-        for (auto predicate : _pre_eval_block_predicate) {
+    void _convert_dict_code_for_predicate_if_necessary(
+            const std::vector<ColumnPredicate*>& predicates) {
+        for (auto predicate : predicates) {
             auto& column = _current_return_columns[predicate->column_id()];
             auto* col_ptr = column.get();
             if (PredicateTypeTraits::is_range(predicate->type())) {
@@ -148,6 +179,13 @@ private:
 
     void _update_max_row(const vectorized::Block* block);
 
+    // Whether the aggregate above the scan can be answered from the metadata of the segment, that
+    // is all its rows are read and every column has the metadata needed.
+    bool _can_answer_by_metadata() const;
+    // Outputs the rows answering the aggregate from the metadata instead of the rows of the
+    // segment, see TPushAggOp.
+    Status _next_batch_by_metadata(vectorized::Block* block);
+
 private:
     class BitmapRangeIterator;
 
@@ -158,12 +196,22 @@ private:
     std::vector<ColumnIterator*> _column_iterators;
     // FIXME prefer vector<unique_ptr<BitmapIndexIterator>>
     std::vector<BitmapIndexIterator*> _bitmap_index_iterators;
+    std::vector<InvertedIndexIterator*> _inverted_index_iterators;
+    std::vector<BitSlicedIndexIterator*> _bit_sliced_index_iterators;
     // after init(), `_row_bitmap` contains all rowid to scan
     roaring::Roaring _row_bitmap;
     // an iterator for `_row_bitmap` that can be used to extract row range to scan
     std::unique_ptr<BitmapRangeIterator> _range_iter;
+    // the end of the last range of `_range_iter`, the rows before it have been read
+    rowid_t _range_end = 0;
+    // the version of the TopN boundary `_row_bitmap` was last pruned by
+    int64_t _topn_boundary_version = 0;
     // the next rowid to read
     rowid_t _cur_rowid;
+    // the rows returned so far, counted against `_opts.read_limit`
+    int64_t _rows_returned = 0;
+    bool _answer_by_metadata = false;
+    size_t _metadata_rows_returned = 0;
     // members related to lazy materialization read
     // --------------------------------------------
     // whether lazy materialization read should be used.
@@ -172,6 +220,8 @@ private:
     std::vector<ColumnId> _predicate_columns;
     // columns to read after predicate evaluation
     std::vector<ColumnId> _non_predicate_columns;
+    // whether the non-predicate columns are read from the row store of the segment
+    bool _read_from_row_store = false;
     // remember the rowids we've read for the current row block.
     // could be a local variable of next_batch(), kept here to reuse vector memory
     std::vector<rowid_t> _block_rowids;
@@ -187,6 +237,25 @@ private:
     vectorized::MutableColumns _current_return_columns;
     std::vector<ColumnPredicate*> _pre_eval_block_predicate;
     std::vector<ColumnPredicate*> _short_cir_eval_predicate;
+    // the order of `_short_cir_eval_predicate` and `_late_short_cir_eval_predicate`, null if it's
+    // the order of the plan
+    std::unique_ptr<AdaptivePredicateOrder<ColumnPredicate*>> _short_cir_pred_order;
+    std::unique_ptr<AdaptivePredicateOrder<ColumnPredicate*>> _late_short_cir_pred_order;
+    // With lazy materialization, the columns having only short circuit predicates are read
+    // after the other predicates, and only for the rows the other predicates keep.
+    std::vector<ColumnId> _late_short_cir_pred_column_ids;
+    std::vector<ColumnPredicate*> _late_short_cir_eval_predicate;
+    // With lazy materialization, the vectorized predicates of a column whose pages can evaluate
+    // them are evaluated on the pages while reading the block, and the column is only decoded
+    // for the rows all predicates keep.
+    std::vector<ColumnId> _page_pred_column_ids;
+    std::vector<std::vector<ColumnPredicate*>> _page_eval_predicates;
+    vectorized::MutableColumns _page_pred_scratch_columns;
+    std::unique_ptr<bool[]> _page_pred_flags;
+    std::unique_ptr<bool[]> _page_pred_column_flags;
+    // The columns read for the selected rows only, before the non-predicate columns:
+    // `_late_short_cir_pred_column_ids` and `_page_pred_column_ids`.
+    std::vector<ColumnId> _late_read_column_ids;
     // when lazy materialization is enable, segmentIter need to read data at least twice
     // first, read predicate columns by various index
     // second, read non-predicate columns
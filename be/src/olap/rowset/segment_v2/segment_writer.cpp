@@ -17,19 +17,28 @@
 
 #include "olap/rowset/segment_v2/segment_writer.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "io/fs/file_writer.h"
 #include "olap/data_dir.h"
+#include "olap/primary_key_index.h"
 #include "olap/row.h"                             // ContiguousRow
 #include "olap/row_cursor.h"                      // RowCursor
 #include "olap/rowset/segment_v2/column_writer.h" // ColumnWriter
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/inverted_index_parser.h"
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/schema.h"
 #include "olap/short_key_index.h"
+#include "olap/tablet.h"
 #include "runtime/memory/mem_tracker.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
+#include "vec/olap/row_store.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -37,6 +46,10 @@ namespace segment_v2 {
 const char* k_segment_magic = "D0R1";
 const uint32_t k_segment_magic_length = 4;
 
+ColumnGroupWriter::ColumnGroupWriter() = default;
+
+ColumnGroupWriter::~ColumnGroupWriter() = default;
+
 SegmentWriter::SegmentWriter(io::FileWriter* file_writer, uint32_t segment_id,
                              const TabletSchema* tablet_schema, DataDir* data_dir,
                              uint32_t max_row_per_segment, const SegmentWriterOptions& opts)
@@ -56,6 +69,9 @@ SegmentWriter::SegmentWriter(io::FileWriter* file_writer, uint32_t segment_id,
         _short_key_coders.push_back(get_key_coder(column.type()));
         _short_key_index_size.push_back(column.index_length());
     }
+    for (size_t cid = 0; cid < _tablet_schema->num_key_columns(); ++cid) {
+        _key_coders.push_back(get_key_coder(_tablet_schema->column(cid).type()));
+    }
 }
 
 SegmentWriter::~SegmentWriter() {
@@ -71,6 +87,14 @@ void SegmentWriter::init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
     meta->set_type(column.type());
     meta->set_length(column.length());
     meta->set_encoding(DEFAULT_ENCODING);
+    if (config::enable_adaptive_numeric_encoding && column.get_subtype_count() == 0) {
+        const TypeInfo* type_info = get_scalar_type_info(column.type());
+        const EncodingInfo* encoding_info = nullptr;
+        if (type_info != nullptr &&
+            EncodingInfo::get(type_info, ADAPTIVE_ENCODING, &encoding_info).ok()) {
+            meta->set_encoding(ADAPTIVE_ENCODING);
+        }
+    }
     meta->set_compression(tablet_schema->compression_type());
     meta->set_is_nullable(column.is_nullable());
     for (uint32_t i = 0; i < column.get_subtype_count(); ++i) {
@@ -80,35 +104,75 @@ void SegmentWriter::init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
 }
 
 Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
+    if (_tablet_schema->has_row_store_column()) {
+        RETURN_IF_ERROR(vectorized::RowStore::check_schema(*_tablet_schema));
+    }
     uint32_t column_id = 0;
     _column_writers.reserve(_tablet_schema->columns().size());
     for (auto& column : _tablet_schema->columns()) {
-        ColumnWriterOptions opts;
-        opts.meta = _footer.add_columns();
-
-        init_column_meta(opts.meta, &column_id, column, _tablet_schema);
-
-        // now we create zone map for key columns in AGG_KEYS or all column in UNIQUE_KEYS or DUP_KEYS
-        // and not support zone map for array type.
-        opts.need_zone_map = column.is_key() || _tablet_schema->keys_type() != KeysType::AGG_KEYS;
-        opts.need_bloom_filter = column.is_bf_column();
-        opts.need_bitmap_index = column.has_bitmap_index();
-        if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
-            opts.need_zone_map = false;
-            if (opts.need_bloom_filter) {
-                return Status::NotSupported("Do not support bloom filter for array type");
-            }
-            if (opts.need_bitmap_index) {
-                return Status::NotSupported("Do not support bitmap index for array type");
-            }
-        }
+        ColumnMetaPB* meta = _footer.add_columns();
+        init_column_meta(meta, &column_id, column, _tablet_schema);
 
         std::unique_ptr<ColumnWriter> writer;
-        RETURN_IF_ERROR(ColumnWriter::create(opts, &column, _file_writer, &writer));
-        RETURN_IF_ERROR(writer->init());
+        RETURN_IF_ERROR(_create_column_writer(column, meta, &writer));
         _column_writers.push_back(std::move(writer));
     }
     _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+    if (_opts.enable_unique_key_merge_on_write && _tablet_schema->keys_type() == UNIQUE_KEYS) {
+        _primary_key_index_builder.reset(new PrimaryKeyIndexBuilder(_file_writer));
+        RETURN_IF_ERROR(_primary_key_index_builder->init());
+    }
+    return Status::OK();
+}
+
+Status SegmentWriter::_create_column_writer(const TabletColumn& column, ColumnMetaPB* meta,
+                                            std::unique_ptr<ColumnWriter>* writer) {
+    ColumnWriterOptions opts;
+    opts.meta = meta;
+
+    // now we create zone map for key columns in AGG_KEYS or all column in UNIQUE_KEYS or DUP_KEYS
+    // and not support zone map for array type.
+    opts.need_zone_map = column.is_key() || _tablet_schema->keys_type() != KeysType::AGG_KEYS;
+    opts.need_bloom_filter = column.is_bf_column();
+    opts.need_bitmap_index = column.has_bitmap_index();
+    opts.bit_sliced_bitmap_index = column.bit_sliced_bitmap_index();
+    if (column.has_inverted_index()) {
+        opts.need_inverted_index = true;
+        RETURN_IF_ERROR(InvertedIndexParser::parse_type(column.inverted_index_parser(),
+                                                        &opts.inverted_index_parser));
+        opts.inverted_index_gram_size = column.inverted_index_gram_size();
+    }
+    opts.ngram_bf_gram_size = column.ngram_bf_gram_size();
+    opts.compression_sample_pages = config::adaptive_compression_sample_pages;
+    opts.zstd_max_size_ratio = config::adaptive_compression_zstd_max_size_ratio;
+    // the row store column is only read by row ids
+    if (_tablet_schema->has_row_store_column() &&
+        column.unique_id() ==
+                _tablet_schema->column(_tablet_schema->row_store_col_idx()).unique_id()) {
+        opts.need_zone_map = false;
+        opts.need_bloom_filter = false;
+        opts.need_bitmap_index = false;
+        opts.need_inverted_index = false;
+        opts.ngram_bf_gram_size = 0;
+    }
+    if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
+        opts.need_zone_map = false;
+        if (opts.need_bloom_filter) {
+            return Status::NotSupported("Do not support bloom filter for array type");
+        }
+        if (opts.need_bitmap_index) {
+            return Status::NotSupported("Do not support bitmap index for array type");
+        }
+        if (opts.need_inverted_index) {
+            return Status::NotSupported("Do not support inverted index for array type");
+        }
+        if (opts.ngram_bf_gram_size > 0) {
+            return Status::NotSupported("Do not support ngram bloom filter index for array type");
+        }
+    }
+
+    RETURN_IF_ERROR(ColumnWriter::create(opts, &column, _file_writer, writer));
+    RETURN_IF_ERROR((*writer)->init());
     return Status::OK();
 }
 
@@ -116,60 +180,187 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
                                    size_t num_rows) {
     assert(block && num_rows > 0 && row_pos + num_rows <= block->rows() &&
            block->columns() == _column_writers.size());
-    _olap_data_convertor.set_source_content(block, row_pos, num_rows);
-
-    // find all row pos for short key indexes
-    std::vector<size_t> short_key_pos;
-    // We build a short key index every `_opts.num_rows_per_block` rows. Specifically, we
-    // build a short key index using 1st rows for first block and `_short_key_row_pos - _row_count`
-    // for next blocks.
-    // Ensure we build a short key index using 1st rows only for the first block (ISSUE-9766).
-    if (UNLIKELY(_short_key_row_pos == 0 && _row_count == 0)) {
-        short_key_pos.push_back(0);
+    // the columns a partial update doesn't carry hold the values of the existing rows
+    vectorized::Block filled_block;
+    if (!_opts.partial_update_missing_cids.empty()) {
+        RETURN_IF_ERROR(_fill_missing_columns(block, row_pos, num_rows, &filled_block));
+        block = &filled_block;
     }
-    while (_short_key_row_pos + _opts.num_rows_per_block < _row_count + num_rows) {
-        _short_key_row_pos += _opts.num_rows_per_block;
-        short_key_pos.push_back(_short_key_row_pos - _row_count);
+    // the row store column is not loaded, but encoded from the other columns of the rows
+    vectorized::Block row_store_block;
+    if (_tablet_schema->has_row_store_column()) {
+        auto row_store_column = vectorized::ColumnString::create();
+        row_store_column->insert_many_defaults(row_pos);
+        vectorized::RowStore::encode_rows(*_tablet_schema, *block, row_pos, num_rows,
+                                          row_store_column.get());
+        row_store_column->insert_many_defaults(block->rows() - row_pos - num_rows);
+        row_store_block = vectorized::Block(block->get_columns_with_type_and_name());
+        row_store_block.replace_by_position(_tablet_schema->row_store_col_idx(),
+                                           std::move(row_store_column));
+        block = &row_store_block;
     }
+    _olap_data_convertor.set_source_content(block, row_pos, num_rows);
 
     // convert column data from engine format to storage layer format
-    std::vector<vectorized::IOlapColumnDataAccessor*> short_key_columns;
-    size_t num_key_columns = _tablet_schema->num_short_key_columns();
+    std::vector<vectorized::IOlapColumnDataAccessor*> key_columns;
+    size_t num_key_columns = _tablet_schema->num_key_columns();
     for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
         auto converted_result = _olap_data_convertor.convert_column_data(cid);
         if (converted_result.first != Status::OK()) {
             return converted_result.first;
         }
         if (cid < num_key_columns) {
-            short_key_columns.push_back(converted_result.second);
+            key_columns.push_back(converted_result.second);
         }
         RETURN_IF_ERROR(_column_writers[cid]->append(converted_result.second->get_nullmap(),
                                                      converted_result.second->get_data(),
                                                      num_rows));
     }
+    RETURN_IF_ERROR(_add_short_keys(key_columns, num_rows));
+    RETURN_IF_ERROR(_add_primary_keys(key_columns, num_rows));
+    _update_key_bounds(key_columns, num_rows);
+
+    _row_count += num_rows;
+    _olap_data_convertor.clear_source_content();
+    return Status::OK();
+}
+
+Status SegmentWriter::_fill_missing_columns(const vectorized::Block* block, size_t row_pos,
+                                            size_t num_rows, vectorized::Block* filled_block) {
+    DCHECK(_opts.tablet != nullptr);
+    _olap_data_convertor.set_source_content(block, row_pos, num_rows);
+    std::vector<vectorized::IOlapColumnDataAccessor*> key_columns;
+    for (size_t cid = 0; cid < _tablet_schema->num_key_columns(); ++cid) {
+        auto converted_result = _olap_data_convertor.convert_column_data(cid);
+        if (converted_result.first != Status::OK()) {
+            _olap_data_convertor.clear_source_content();
+            return converted_result.first;
+        }
+        key_columns.push_back(converted_result.second);
+    }
+    std::vector<std::string> encoded_keys(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        encoded_keys[i] = _full_encode_keys(key_columns, i);
+    }
+    _olap_data_convertor.clear_source_content();
+
+    // the keys are looked up in ascending order, rows of a memtable are usually sorted already
+    std::vector<size_t> order(num_rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return encoded_keys[a] < encoded_keys[b]; });
+    std::vector<Slice> sorted_keys;
+    std::vector<size_t> sorted_pos(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        sorted_keys.emplace_back(encoded_keys[order[i]]);
+        sorted_pos[order[i]] = i;
+    }
+    const auto& missing_cids = _opts.partial_update_missing_cids;
+    auto read_columns = _tablet_schema->create_block(missing_cids).mutate_columns();
+    std::vector<bool> found;
+    RETURN_IF_ERROR(_opts.tablet->read_columns_by_keys(sorted_keys, *_tablet_schema, missing_cids,
+                                                       &read_columns, &found));
+
+    *filled_block = vectorized::Block(block->get_columns_with_type_and_name());
+    for (size_t i = 0; i < missing_cids.size(); ++i) {
+        uint32_t cid = missing_cids[i];
+        auto src = block->get_by_position(cid).column->convert_to_full_column_if_const();
+        if (src->get_name() != read_columns[i]->get_name()) {
+            return Status::InternalError("column {} of the partial update is {}, but {} is read",
+                                         _tablet_schema->column(cid).name(), src->get_name(),
+                                         read_columns[i]->get_name());
+        }
+        auto dst = src->clone_empty();
+        dst->reserve(block->rows());
+        dst->insert_range_from(*src, 0, row_pos);
+        for (size_t row = 0; row < num_rows; ++row) {
+            size_t pos = sorted_pos[row];
+            if (found[pos]) {
+                dst->insert_from(*read_columns[i], pos);
+            } else {
+                // a new key keeps the default values the load filled
+                dst->insert_from(*src, row_pos + row);
+            }
+        }
+        dst->insert_range_from(*src, row_pos + num_rows, block->rows() - row_pos - num_rows);
+        filled_block->replace_by_position(cid, std::move(dst));
+    }
+    return Status::OK();
+}
+
+Status SegmentWriter::_add_short_keys(
+        const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns, size_t num_rows) {
+    // find all row pos for short key indexes
+    std::vector<size_t> short_key_pos;
+    // We build a short key index every `_opts.num_rows_per_block` rows. Specifically, we
+    // build a short key index using 1st rows for first block and `_short_key_row_pos - _row_count`
+    // for next blocks.
+    // Ensure we build a short key index using 1st rows only for the first block (ISSUE-9766).
+    if (UNLIKELY(_short_key_row_pos == 0 && _row_count == 0)) {
+        short_key_pos.push_back(0);
+    }
+    while (_short_key_row_pos + _opts.num_rows_per_block < _row_count + num_rows) {
+        _short_key_row_pos += _opts.num_rows_per_block;
+        short_key_pos.push_back(_short_key_row_pos - _row_count);
+    }
 
     // create short key indexes
     std::vector<const void*> key_column_fields;
+    size_t num_short_key_columns = _tablet_schema->num_short_key_columns();
     for (const auto pos : short_key_pos) {
-        for (const auto& column : short_key_columns) {
-            key_column_fields.push_back(column->get_data_at(pos));
+        for (size_t cid = 0; cid < num_short_key_columns; ++cid) {
+            key_column_fields.push_back(key_columns[cid]->get_data_at(pos));
         }
         std::string encoded_key = encode_short_keys(key_column_fields);
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
         key_column_fields.clear();
     }
+    return Status::OK();
+}
 
-    _row_count += num_rows;
-    _olap_data_convertor.clear_source_content();
+Status SegmentWriter::_add_primary_keys(
+        const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns, size_t num_rows) {
+    if (_primary_key_index_builder == nullptr) {
+        return Status::OK();
+    }
+    for (size_t pos = 0; pos < num_rows; ++pos) {
+        RETURN_IF_ERROR(_primary_key_index_builder->add_item(_full_encode_keys(key_columns, pos)));
+    }
     return Status::OK();
 }
 
+void SegmentWriter::_update_key_bounds(
+        const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns, size_t num_rows) {
+    if (_row_count == 0) {
+        _min_encoded_key = _full_encode_keys(key_columns, 0);
+    }
+    _max_encoded_key = _full_encode_keys(key_columns, num_rows - 1);
+}
+
+std::string SegmentWriter::_full_encode_keys(
+        const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns, size_t pos) {
+    assert(key_columns.size() == _key_coders.size());
+    std::string encoded_keys;
+    for (size_t cid = 0; cid < key_columns.size(); ++cid) {
+        auto field = key_columns[cid]->get_data_at(pos);
+        if (UNLIKELY(!field)) {
+            encoded_keys.push_back(KEY_NULL_FIRST_MARKER);
+            continue;
+        }
+        encoded_keys.push_back(KEY_NORMAL_MARKER);
+        _key_coders[cid]->full_encode_ascending(field, &encoded_keys);
+    }
+    return encoded_keys;
+}
+
 int64_t SegmentWriter::max_row_to_add(size_t row_avg_size_in_bytes) {
     auto segment_size = estimate_segment_size();
-    if (PREDICT_FALSE(segment_size >= MAX_SEGMENT_SIZE || _row_count >= _max_row_per_segment)) {
+    if (PREDICT_FALSE(segment_size >= _opts.max_segment_size ||
+                      _row_count >= _max_row_per_segment)) {
         return 0;
     }
-    int64_t size_rows = ((int64_t)MAX_SEGMENT_SIZE - (int64_t)segment_size) / row_avg_size_in_bytes;
+    int64_t size_rows =
+            ((int64_t)_opts.max_segment_size - (int64_t)segment_size) / row_avg_size_in_bytes;
     int64_t count_rows = (int64_t)_max_row_per_segment - _row_count;
 
     return std::min(size_rows, count_rows);
@@ -212,6 +403,19 @@ Status SegmentWriter::append_row(const RowType& row) {
         encode_key(&encoded_key, row, _tablet_schema->num_short_key_columns());
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
     }
+    if (_primary_key_index_builder != nullptr) {
+        std::string encoded_key;
+        for (size_t cid = 0; cid < _key_coders.size(); ++cid) {
+            auto cell = row.cell(cid);
+            if (cell.is_null()) {
+                encoded_key.push_back(KEY_NULL_FIRST_MARKER);
+                continue;
+            }
+            encoded_key.push_back(KEY_NORMAL_MARKER);
+            _key_coders[cid]->full_encode_ascending(cell.cell_ptr(), &encoded_key);
+        }
+        RETURN_IF_ERROR(_primary_key_index_builder->add_item(encoded_key));
+    }
     ++_row_count;
     return Status::OK();
 }
@@ -230,6 +434,9 @@ uint64_t SegmentWriter::estimate_segment_size() {
         size += column_writer->estimate_buffer_size();
     }
     size += _index_builder->size();
+    if (_primary_key_index_builder != nullptr) {
+        size += _primary_key_index_builder->size();
+    }
 
     // update the mem_tracker of segment size
     _mem_tracker->consume(size - _mem_tracker->consumption());
@@ -250,7 +457,10 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
+    RETURN_IF_ERROR(_write_inverted_index());
+    RETURN_IF_ERROR(_write_ngram_bloom_filter_index());
     RETURN_IF_ERROR(_write_short_key_index());
+    RETURN_IF_ERROR(_write_primary_key_index());
     *index_size = _file_writer->bytes_appended() - index_offset;
     RETURN_IF_ERROR(_write_footer());
     RETURN_IF_ERROR(_file_writer->finalize());
@@ -258,6 +468,117 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     return Status::OK();
 }
 
+Status SegmentWriter::init_vertical() {
+    // the row store column is encoded from all the columns of a row at once
+    if (_tablet_schema->has_row_store_column()) {
+        return Status::NotSupported("can't write a row store column by column groups");
+    }
+    uint32_t column_id = 0;
+    for (auto& column : _tablet_schema->columns()) {
+        init_column_meta(_footer.add_columns(), &column_id, column, _tablet_schema);
+    }
+    _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+    if (_opts.enable_unique_key_merge_on_write && _tablet_schema->keys_type() == UNIQUE_KEYS) {
+        _primary_key_index_builder.reset(new PrimaryKeyIndexBuilder(_file_writer));
+        RETURN_IF_ERROR(_primary_key_index_builder->init());
+    }
+    return Status::OK();
+}
+
+Status SegmentWriter::init_column_group(const std::vector<uint32_t>& column_ids, bool is_key,
+                                        ColumnGroupWriter* group) {
+    DCHECK(!is_key || column_ids.size() >= _tablet_schema->num_key_columns());
+    group->column_ids = column_ids;
+    group->is_key = is_key;
+    group->num_rows = 0;
+    group->column_writers.clear();
+    for (auto cid : column_ids) {
+        std::unique_ptr<ColumnWriter> writer;
+        RETURN_IF_ERROR(_create_column_writer(_tablet_schema->column(cid),
+                                              _footer.mutable_columns(cid), &writer));
+        group->column_writers.push_back(std::move(writer));
+    }
+    group->convertor =
+            std::make_unique<vectorized::OlapBlockDataConvertor>(_tablet_schema, column_ids);
+    return Status::OK();
+}
+
+Status SegmentWriter::append_column_group(ColumnGroupWriter* group,
+                                          const vectorized::Block* block, size_t row_pos,
+                                          size_t num_rows) {
+    assert(block && num_rows > 0 && row_pos + num_rows <= block->rows() &&
+           block->columns() == group->column_writers.size());
+    group->convertor->set_source_content(block, row_pos, num_rows);
+
+    std::vector<vectorized::IOlapColumnDataAccessor*> key_columns;
+    size_t num_key_columns = group->is_key ? _tablet_schema->num_key_columns() : 0;
+    for (size_t i = 0; i < group->column_writers.size(); ++i) {
+        auto converted_result = group->convertor->convert_column_data(i);
+        if (converted_result.first != Status::OK()) {
+            return converted_result.first;
+        }
+        if (i < num_key_columns) {
+            key_columns.push_back(converted_result.second);
+        }
+        RETURN_IF_ERROR(group->column_writers[i]->append(converted_result.second->get_nullmap(),
+                                                         converted_result.second->get_data(),
+                                                         num_rows));
+    }
+    if (group->is_key) {
+        RETURN_IF_ERROR(_add_short_keys(key_columns, num_rows));
+        RETURN_IF_ERROR(_add_primary_keys(key_columns, num_rows));
+        _update_key_bounds(key_columns, num_rows);
+        _row_count += num_rows;
+    }
+    group->num_rows += num_rows;
+    group->convertor->clear_source_content();
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_column_group(ColumnGroupWriter* group) {
+    if (!group->is_key && group->num_rows != _row_count) {
+        return Status::InternalError("column group has {} rows, but segment {} has {} rows",
+                                     group->num_rows, _segment_id, _row_count);
+    }
+    uint64_t group_size = 0;
+    for (auto& column_writer : group->column_writers) {
+        RETURN_IF_ERROR(column_writer->finish());
+        group_size += column_writer->estimate_buffer_size();
+    }
+    // check disk capacity
+    if (_data_dir != nullptr && _data_dir->reach_capacity_limit((int64_t)group_size)) {
+        return Status::InternalError("disk {} exceed capacity limit.", _data_dir->path_hash());
+    }
+
+    std::lock_guard<std::mutex> l(_column_group_lock);
+    for (auto& column_writer : group->column_writers) {
+        RETURN_IF_ERROR(column_writer->write_data());
+    }
+    uint64_t index_offset = _file_writer->bytes_appended();
+    for (auto& column_writer : group->column_writers) {
+        RETURN_IF_ERROR(column_writer->write_ordinal_index());
+        RETURN_IF_ERROR(column_writer->write_zone_map());
+        RETURN_IF_ERROR(column_writer->write_bitmap_index());
+        RETURN_IF_ERROR(column_writer->write_bloom_filter_index());
+        RETURN_IF_ERROR(column_writer->write_inverted_index());
+        RETURN_IF_ERROR(column_writer->write_ngram_bloom_filter_index());
+    }
+    _column_group_index_size += _file_writer->bytes_appended() - index_offset;
+    group->column_writers.clear();
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_vertical(uint64_t* segment_file_size, uint64_t* index_size) {
+    uint64_t index_offset = _file_writer->bytes_appended();
+    RETURN_IF_ERROR(_write_short_key_index());
+    RETURN_IF_ERROR(_write_primary_key_index());
+    *index_size = _column_group_index_size + _file_writer->bytes_appended() - index_offset;
+    RETURN_IF_ERROR(_write_footer());
+    RETURN_IF_ERROR(_file_writer->finalize());
+    *segment_file_size = _file_writer->bytes_appended();
+    return Status::OK();
+}
+
 // write column data to file one by one
 Status SegmentWriter::_write_data() {
     for (auto& column_writer : _column_writers) {
@@ -295,6 +616,20 @@ Status SegmentWriter::_write_bloom_filter_index() {
     return Status::OK();
 }
 
+Status SegmentWriter::_write_inverted_index() {
+    for (auto& column_writer : _column_writers) {
+        RETURN_IF_ERROR(column_writer->write_inverted_index());
+    }
+    return Status::OK();
+}
+
+Status SegmentWriter::_write_ngram_bloom_filter_index() {
+    for (auto& column_writer : _column_writers) {
+        RETURN_IF_ERROR(column_writer->write_ngram_bloom_filter_index());
+    }
+    return Status::OK();
+}
+
 Status SegmentWriter::_write_short_key_index() {
     std::vector<Slice> body;
     PageFooterPB footer;
@@ -306,6 +641,14 @@ Status SegmentWriter::_write_short_key_index() {
     return Status::OK();
 }
 
+Status SegmentWriter::_write_primary_key_index() {
+    if (_primary_key_index_builder == nullptr) {
+        return Status::OK();
+    }
+    DCHECK_EQ(_primary_key_index_builder->num_rows(), _row_count);
+    return _primary_key_index_builder->finalize(_footer.mutable_primary_key_index_meta());
+}
+
 Status SegmentWriter::_write_footer() {
     _footer.set_num_rows(_row_count);
 
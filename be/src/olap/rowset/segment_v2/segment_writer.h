@@ -17,11 +17,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <memory> // unique_ptr
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h" // Status
 #include "gen_cpp/segment_v2.pb.h"
 #include "gutil/macros.h"
@@ -33,13 +36,16 @@ namespace doris {
 // TODO(lingbin): Should be a conf that can be dynamically adjusted, or a member in the context
 const uint32_t MAX_SEGMENT_SIZE = static_cast<uint32_t>(OLAP_MAX_COLUMN_SEGMENT_FILE_SIZE *
                                                         OLAP_COLUMN_FILE_SEGMENT_SIZE_SCALE);
+
 class DataDir;
 class MemTracker;
 class RowBlock;
 class RowCursor;
+class Tablet;
 class TabletSchema;
 class TabletColumn;
 class ShortKeyIndexBuilder;
+class PrimaryKeyIndexBuilder;
 class KeyCoder;
 
 namespace io {
@@ -53,8 +59,35 @@ class ColumnWriter;
 extern const char* k_segment_magic;
 extern const uint32_t k_segment_magic_length;
 
+// The size a segment is cut at, which is configured by segment_max_size_mbytes and bounded by
+// MAX_SEGMENT_SIZE.
+inline uint32_t target_segment_size() {
+    int64_t size = config::segment_max_size_mbytes << 20;
+    return size > 0 ? std::min<int64_t>(size, MAX_SEGMENT_SIZE) : MAX_SEGMENT_SIZE;
+}
+
 struct SegmentWriterOptions {
     uint32_t num_rows_per_block = 1024;
+    // the segment is full when its estimated size reaches it
+    uint32_t max_segment_size = MAX_SEGMENT_SIZE;
+    // build the primary key index of the rows, which must be unique and sorted
+    bool enable_unique_key_merge_on_write = false;
+    // the columns missing from the appended blocks of a partial update, which are read from the
+    // existing rows of the same keys in tablet before the rows are written
+    std::vector<uint32_t> partial_update_missing_cids;
+    Tablet* tablet = nullptr;
+};
+
+// The writers of a group of columns of a segment written vertically.
+struct ColumnGroupWriter {
+    ColumnGroupWriter();
+    ~ColumnGroupWriter();
+
+    std::vector<uint32_t> column_ids;
+    bool is_key = false;
+    std::vector<std::unique_ptr<ColumnWriter>> column_writers;
+    std::unique_ptr<vectorized::OlapBlockDataConvertor> convertor;
+    uint32_t num_rows = 0;
 };
 
 class SegmentWriter {
@@ -77,19 +110,58 @@ public:
 
     uint32_t num_rows_written() const { return _row_count; }
 
+    uint32_t segment_id() const { return _segment_id; }
+
+    // The memcomparable encoded keys of the first and the last row appended by blocks, empty if
+    // the rows are appended one by one.
+    const std::string& min_encoded_key() const { return _min_encoded_key; }
+    const std::string& max_encoded_key() const { return _max_encoded_key; }
+
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // Vertical writing: instead of whole rows, the columns of the segment are written group by
+    // group, each group is written to the file once all its rows are appended. The key group
+    // starts with the key columns and is written first, it builds the short key index. The
+    // other groups must have as many rows, and may be written by different threads.
+    Status init_vertical();
+    Status init_column_group(const std::vector<uint32_t>& column_ids, bool is_key,
+                             ColumnGroupWriter* group);
+    Status append_column_group(ColumnGroupWriter* group, const vectorized::Block* block,
+                               size_t row_pos, size_t num_rows);
+    // write the columns of the group to the file and release its writers
+    Status finalize_column_group(ColumnGroupWriter* group);
+    // write the short key index and the footer after all groups are written
+    Status finalize_vertical(uint64_t* segment_file_size, uint64_t* index_size);
+
     static void init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
                                  const TabletColumn& column, const TabletSchema* tablet_schema);
 
 private:
     DISALLOW_COPY_AND_ASSIGN(SegmentWriter);
+    Status _create_column_writer(const TabletColumn& column, ColumnMetaPB* meta,
+                                 std::unique_ptr<ColumnWriter>* writer);
+    Status _add_short_keys(const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns,
+                           size_t num_rows);
+    Status _add_primary_keys(
+            const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns,
+            size_t num_rows);
+    void _update_key_bounds(const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns,
+                            size_t num_rows);
+    std::string _full_encode_keys(
+            const std::vector<vectorized::IOlapColumnDataAccessor*>& key_columns, size_t pos);
+    // Sets `filled_block` to `block` with the missing columns of a partial update replaced by
+    // the values of the existing rows of the same keys in [row_pos, row_pos + num_rows).
+    Status _fill_missing_columns(const vectorized::Block* block, size_t row_pos,
+                                 size_t num_rows, vectorized::Block* filled_block);
     Status _write_data();
     Status _write_ordinal_index();
     Status _write_zone_map();
     Status _write_bitmap_index();
     Status _write_bloom_filter_index();
+    Status _write_inverted_index();
+    Status _write_ngram_bloom_filter_index();
     Status _write_short_key_index();
+    Status _write_primary_key_index();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
 
@@ -108,6 +180,8 @@ private:
 
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
+    // only built for unique key tables with merge-on-write enabled
+    std::unique_ptr<PrimaryKeyIndexBuilder> _primary_key_index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
     std::unique_ptr<MemTracker> _mem_tracker;
     uint32_t _row_count = 0;
@@ -116,6 +190,13 @@ private:
     std::vector<const KeyCoder*> _short_key_coders;
     std::vector<uint16_t> _short_key_index_size;
     size_t _short_key_row_pos = 0;
+    std::vector<const KeyCoder*> _key_coders;
+    std::string _min_encoded_key;
+    std::string _max_encoded_key;
+
+    // used by vertical writing, the groups are written to the file one at a time
+    std::mutex _column_group_lock;
+    uint64_t _column_group_index_size = 0;
 };
 
 } // namespace segment_v2
@@ -17,6 +17,7 @@
 
 #include "olap/rowset/segment_v2/zone_map_index.h"
 
+#include "common/config.h"
 #include "olap/column_block.h"
 #include "olap/olap_define.h"
 #include "olap/rowset/segment_v2/encoding_info.h"
@@ -24,18 +25,25 @@
 #include "olap/rowset/segment_v2/indexed_column_writer.h"
 #include "olap/types.h"
 #include "runtime/mem_pool.h"
+#include "util/hash_util.hpp"
 
 namespace doris {
 
 namespace segment_v2 {
 
 ZoneMapIndexWriter::ZoneMapIndexWriter(Field* field) : _field(field) {
+    _is_string_type = _field->type() == OLAP_FIELD_TYPE_CHAR ||
+                      _field->type() == OLAP_FIELD_TYPE_VARCHAR ||
+                      _field->type() == OLAP_FIELD_TYPE_STRING;
     _page_zone_map.min_value = _field->allocate_zone_map_value(&_pool);
     _page_zone_map.max_value = _field->allocate_zone_map_value(&_pool);
     _reset_zone_map(&_page_zone_map);
     _segment_zone_map.min_value = _field->allocate_zone_map_value(&_pool);
     _segment_zone_map.max_value = _field->allocate_zone_map_value(&_pool);
     _reset_zone_map(&_segment_zone_map);
+    if (config::enable_zone_map_ndv_sketch) {
+        _ndv_sketch.reset(new HyperLogLog());
+    }
 }
 
 void ZoneMapIndexWriter::add_values(const void* values, size_t count) {
@@ -49,13 +57,43 @@ void ZoneMapIndexWriter::add_values(const void* values, size_t count) {
         }
         if (_field->compare(_page_zone_map.max_value, vals) < 0) {
             _field->type_info()->direct_copy_may_cut(_page_zone_map.max_value, vals);
+            if (_is_string_type) {
+                _page_zone_map.max_truncated =
+                        reinterpret_cast<const Slice*>(vals)->size > MAX_ZONE_MAP_INDEX_SIZE;
+            }
+        }
+        if (_ndv_sketch != nullptr) {
+            if (_is_string_type) {
+                auto value = reinterpret_cast<const Slice*>(vals);
+                _ndv_sketch->update(
+                        HashUtil::murmur_hash64A(value->data, value->size, HashUtil::MURMUR_SEED));
+            } else {
+                _ndv_sketch->update(
+                        HashUtil::murmur_hash64A(vals, _field->size(), HashUtil::MURMUR_SEED));
+            }
         }
         vals += _field->size();
     }
 }
 
+// A max cut to its first MAX_ZONE_MAP_INDEX_SIZE bytes is less than the values it is cut from,
+// so it is replaced by the least string greater than all the strings having it as a prefix: the
+// bytes after its last byte that is not 0xFF are dropped and that byte is incremented. The zone
+// passes all when every byte is 0xFF.
 void ZoneMapIndexWriter::moidfy_index_before_flush(struct doris::segment_v2::ZoneMap& zone_map) {
-    _field->modify_zone_map_index(zone_map.max_value);
+    if (!zone_map.max_truncated) {
+        return;
+    }
+    auto max = reinterpret_cast<Slice*>(zone_map.max_value);
+    while (max->size > 0 && static_cast<uint8_t>(max->data[max->size - 1]) == 0xFF) {
+        max->size--;
+    }
+    if (max->size == 0) {
+        zone_map.pass_all = true;
+    } else {
+        max->mutable_data()[max->size - 1]++;
+    }
+    zone_map.max_truncated = false;
 }
 
 void ZoneMapIndexWriter::reset_page_zone_map() {
@@ -71,12 +109,17 @@ Status ZoneMapIndexWriter::flush() {
     if (_field->compare(_segment_zone_map.min_value, _page_zone_map.min_value) > 0) {
         _field->type_info()->direct_copy(_segment_zone_map.min_value, _page_zone_map.min_value);
     }
-    if (_field->compare(_segment_zone_map.max_value, _page_zone_map.max_value) < 0) {
+    int max_cmp = _field->compare(_segment_zone_map.max_value, _page_zone_map.max_value);
+    if (max_cmp < 0) {
         _field->type_info()->direct_copy(_segment_zone_map.max_value, _page_zone_map.max_value);
+        _segment_zone_map.max_truncated = _page_zone_map.max_truncated;
+    } else if (max_cmp == 0) {
+        _segment_zone_map.max_truncated |= _page_zone_map.max_truncated;
     }
     if (_page_zone_map.has_null) {
         _segment_zone_map.has_null = true;
     }
+    _segment_zone_map.null_count += _page_zone_map.null_count;
     if (_page_zone_map.has_not_null) {
         _segment_zone_map.has_not_null = true;
     }
@@ -118,10 +161,68 @@ Status ZoneMapIndexWriter::finish(io::FileWriter* file_writer, ColumnIndexMetaPB
         Slice value_slice(value);
         RETURN_IF_ERROR(writer.add(&value_slice));
     }
-    return writer.finish(meta->mutable_page_zone_maps());
+    RETURN_IF_ERROR(writer.finish(meta->mutable_page_zone_maps()));
+
+    if (_ndv_sketch != nullptr) {
+        std::string serialized_sketch(_ndv_sketch->max_serialized_size(), '\0');
+        serialized_sketch.resize(_ndv_sketch->serialize((uint8_t*)serialized_sketch.data()));
+        IndexedColumnWriter sketch_writer(options, type_info, file_writer);
+        RETURN_IF_ERROR(sketch_writer.init());
+        Slice sketch_slice(serialized_sketch);
+        RETURN_IF_ERROR(sketch_writer.add(&sketch_slice));
+        RETURN_IF_ERROR(sketch_writer.finish(meta->mutable_ndv_sketch()));
+    }
+    return Status::OK();
 }
 
 Status ZoneMapIndexReader::load(bool use_page_cache, bool kept_in_memory) {
+    RETURN_IF_ERROR(_load(use_page_cache, kept_in_memory));
+    _file_reader.reset();
+    _index_meta = nullptr;
+    return Status::OK();
+}
+
+size_t ZoneMapIndexReader::mem_usage() const {
+    size_t usage = sizeof(*this);
+    for (auto& zone_map : _page_zone_maps) {
+        usage += zone_map.SpaceUsedLong();
+    }
+    return usage;
+}
+
+Status ZoneMapIndexReader::load_ndv_sketch(io::FileReaderSPtr file_reader,
+                                           const ZoneMapIndexPB& index_meta, HyperLogLog* sketch,
+                                           bool* has_sketch) {
+    *has_sketch = index_meta.has_ndv_sketch();
+    if (!*has_sketch) {
+        return Status::OK();
+    }
+    IndexedColumnReader reader(std::move(file_reader), index_meta.ndv_sketch());
+    RETURN_IF_ERROR(reader.load(false, false));
+    if (reader.num_values() != 1) {
+        return Status::Corruption("Invalid ndv sketch of zone map, num_values={}",
+                                  reader.num_values());
+    }
+    IndexedColumnIterator iter(&reader);
+
+    MemPool pool;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(ColumnVectorBatch::create(1, false, reader.type_info(), nullptr, &cvb));
+    ColumnBlock block(cvb.get(), &pool);
+    ColumnBlockView column_block_view(&block);
+    RETURN_IF_ERROR(iter.seek_to_ordinal(0));
+    size_t num_read = 1;
+    RETURN_IF_ERROR(iter.next_batch(&num_read, &column_block_view));
+    DCHECK(num_read == 1);
+
+    Slice* value = reinterpret_cast<Slice*>(cvb->data());
+    if (!sketch->deserialize(*value)) {
+        return Status::Corruption("Failed to parse ndv sketch of zone map");
+    }
+    return Status::OK();
+}
+
+Status ZoneMapIndexReader::_load(bool use_page_cache, bool kept_in_memory) {
     IndexedColumnReader reader(_file_reader, _index_meta->page_zone_maps());
     RETURN_IF_ERROR(reader.load(use_page_cache, kept_in_memory));
     IndexedColumnIterator iter(&reader);
@@ -26,6 +26,7 @@
 #include "gen_cpp/segment_v2.pb.h"
 #include "io/fs/file_reader.h"
 #include "olap/field.h"
+#include "olap/hll.h"
 #include "olap/rowset/segment_v2/binary_plain_page.h"
 #include "runtime/mem_pool.h"
 #include "util/slice.h"
@@ -55,6 +56,12 @@ struct ZoneMap {
 
     bool pass_all = false;
 
+    // whether max_value is a prefix of the max value cut to MAX_ZONE_MAP_INDEX_SIZE bytes, and
+    // has to be turned into an upper bound before flushed
+    bool max_truncated = false;
+
+    uint64_t null_count = 0;
+
     void to_proto(ZoneMapPB* dst, Field* field) const {
         if (pass_all) {
             dst->set_min("");
@@ -66,6 +73,7 @@ struct ZoneMap {
         dst->set_has_null(has_null);
         dst->set_has_not_null(has_not_null);
         dst->set_pass_all(pass_all);
+        dst->set_null_count(null_count);
     }
 };
 
@@ -79,7 +87,10 @@ public:
 
     void add_values(const void* values, size_t count);
 
-    void add_nulls(uint32_t count) { _page_zone_map.has_null = true; }
+    void add_nulls(uint32_t count) {
+        _page_zone_map.has_null = true;
+        _page_zone_map.null_count += count;
+    }
 
     // mark the end of one data page so that we can finalize the corresponding zone map
     Status flush();
@@ -101,9 +112,12 @@ private:
         zone_map->has_null = false;
         zone_map->has_not_null = false;
         zone_map->pass_all = false;
+        zone_map->max_truncated = false;
+        zone_map->null_count = 0;
     }
 
     Field* _field;
+    bool _is_string_type = false;
     // memory will be managed by MemPool
     ZoneMap _page_zone_map;
     ZoneMap _segment_zone_map;
@@ -114,6 +128,9 @@ private:
     // serialized ZoneMapPB for each data page
     std::vector<std::string> _values;
     uint64_t _estimated_size = 0;
+
+    // the distinct not-null values of the segment, when config::enable_zone_map_ndv_sketch
+    std::unique_ptr<HyperLogLog> _ndv_sketch;
 };
 
 class ZoneMapIndexReader {
@@ -121,14 +138,24 @@ public:
     explicit ZoneMapIndexReader(io::FileReaderSPtr file_reader, const ZoneMapIndexPB* index_meta)
             : _file_reader(std::move(file_reader)), _index_meta(index_meta) {}
 
-    // load all page zone maps into memory
+    // load all page zone maps into memory. The file reader and the index meta are released
+    // once loaded, so that the index may outlive its column reader in the SegmentMetaCache.
     Status load(bool use_page_cache, bool kept_in_memory);
 
     const std::vector<ZoneMapPB>& page_zone_maps() const { return _page_zone_maps; }
 
     int32_t num_pages() const { return _page_zone_maps.size(); }
 
+    size_t mem_usage() const;
+
+    // reads the NDV sketch of the segment. *has_sketch is false when the segment is written
+    // without one.
+    static Status load_ndv_sketch(io::FileReaderSPtr file_reader, const ZoneMapIndexPB& index_meta,
+                                  HyperLogLog* sketch, bool* has_sketch);
+
 private:
+    Status _load(bool use_page_cache, bool kept_in_memory);
+
     io::FileReaderSPtr _file_reader;
     const ZoneMapIndexPB* _index_meta;
 
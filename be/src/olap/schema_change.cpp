@@ -17,6 +17,7 @@
 
 #include "olap/schema_change.h"
 
+#include <atomic>
 #include <vector>
 
 #include "common/status.h"
@@ -33,6 +34,7 @@
 #include "olap/wrapper_field.h"
 #include "runtime/memory/mem_tracker.h"
 #include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_reader.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
@@ -653,8 +655,10 @@ Status RowBlockChanger::change_row_block(const RowBlock* ref_block, int32_t data
                 } else if (_schema_mapping[i].materialized_function == "count_field") {
                     _do_materialized_transform = count_field;
                 } else {
+                    // the other define expressions are only evaluated on blocks
                     LOG(WARNING) << "error materialized view function : "
-                                 << _schema_mapping[i].materialized_function;
+                                 << _schema_mapping[i].materialized_function
+                                 << ", set enable_vectorized_alter_table to build it";
                     return Status::OLAPInternalError(OLAP_ERR_SCHEMA_CHANGE_INFO_INVALID);
                 }
                 VLOG_NOTICE << "_schema_mapping[" << i << "].materialized_function : "
@@ -849,8 +853,12 @@ Status RowBlockChanger::change_block(vectorized::Block* ref_block,
     for (int idx = 0; idx < column_size; idx++) {
         int ref_idx = _schema_mapping[idx].ref_column;
 
-        if (!_schema_mapping[idx].materialized_function.empty()) {
-            return Status::NotSupported("Materialized function not supported now. ");
+        // the columns of a materialized view are computed by their define expressions, which
+        // may be any function of the base columns, like date_trunc(ts, 'hour')
+        if (!_schema_mapping[idx].materialized_function.empty() &&
+            _schema_mapping[idx].expr == nullptr) {
+            return Status::NotSupported("Materialized function {} has no define expr",
+                                        _schema_mapping[idx].materialized_function);
         }
 
         if (ref_idx < 0) {
@@ -1587,13 +1595,10 @@ Status VSchemaChangeWithSorting::_inner_process(RowsetReaderSharedPtr rowset_rea
     rowset_reader->next_block(ref_block.get());
     while (ref_block->rows()) {
         RETURN_IF_ERROR(_changer.change_block(ref_block.get(), new_block.get()));
-        if (!_mem_tracker->check_limit(config::memory_limitation_per_thread_for_schema_change_bytes,
-                                       new_block->allocated_bytes())) {
+        if (!_mem_tracker->check_limit(_memory_limitation, new_block->allocated_bytes())) {
             RETURN_IF_ERROR(create_rowset());
 
-            if (!_mem_tracker->check_limit(
-                        config::memory_limitation_per_thread_for_schema_change_bytes,
-                        new_block->allocated_bytes())) {
+            if (!_mem_tracker->check_limit(_memory_limitation, new_block->allocated_bytes())) {
                 LOG(WARNING) << "Memory limitation is too small for Schema Change."
                              << "memory_limitation=" << _memory_limitation;
                 return Status::OLAPInternalError(OLAP_ERR_INPUT_PARAMETER_ERROR);
@@ -2205,78 +2210,117 @@ Status SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangeParams
         return process_alter_exit();
     }
 
-    // b. Generate historical data converter
-    auto sc_procedure = get_sc_procedure(rb_changer, sc_sorting, sc_directly);
+    // b. Convert historical data, several rowsets at a time. Each conversion creates its own
+    // procedure, which keeps the state of the rowset being converted.
+    const auto& rs_readers = sc_params.ref_rowset_readers;
+    res = run_rowset_conversions(
+            StorageEngine::instance()->schema_change_thread_pool(),
+            config::schema_change_max_parallel_rowsets, rs_readers.size(), [&](size_t i) {
+                return _convert_rowset(sc_params, rb_changer, sc_sorting, sc_directly,
+                                       rs_readers[i]);
+            });
 
-    // c.Convert historical data
-    for (auto& rs_reader : sc_params.ref_rowset_readers) {
-        VLOG_TRACE << "begin to convert a history rowset. version=" << rs_reader->version().first
-                   << "-" << rs_reader->version().second;
-
-        // set status for monitor
-        // As long as there is a new_table as running, ref table is set as running
-        // NOTE If the first sub_table fails first, it will continue to go as normal here
-        TabletSharedPtr new_tablet = sc_params.new_tablet;
-        // When tablet create new rowset writer, it may change rowset type, in this case
-        // linked schema change will not be used.
-        std::unique_ptr<RowsetWriter> rowset_writer;
-        Status status = new_tablet->create_rowset_writer(
-                rs_reader->version(), VISIBLE,
-                rs_reader->rowset()->rowset_meta()->segments_overlap(),
-                &new_tablet->tablet_schema(), rs_reader->oldest_write_timestamp(),
-                rs_reader->newest_write_timestamp(), &rowset_writer);
-        if (!status.ok()) {
-            res = Status::OLAPInternalError(OLAP_ERR_ROWSET_BUILDER_INIT);
-            return process_alter_exit();
-        }
-
-        if (res = sc_procedure->process(rs_reader, rowset_writer.get(), sc_params.new_tablet,
-                                        sc_params.base_tablet);
-            !res) {
-            LOG(WARNING) << "failed to process the version."
-                         << " version=" << rs_reader->version().first << "-"
-                         << rs_reader->version().second;
-            new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
-                                                       rowset_writer->rowset_id().to_string());
-            return process_alter_exit();
+    // XXX:The SchemaChange state should not be canceled at this time, because the new Delta has to be converted to the old and new Schema version
+    return process_alter_exit();
+}
+
+Status SchemaChangeHandler::run_rowset_conversions(ThreadPool* pool, int max_parallel,
+                                                   size_t num_rowsets,
+                                                   const std::function<Status(size_t)>& convert) {
+    std::atomic<bool> failed(false);
+    std::vector<Status> rowset_status(num_rowsets);
+    std::unique_ptr<ThreadPoolToken> token;
+    if (pool != nullptr && max_parallel > 1 && num_rowsets > 1) {
+        token = pool->new_token(ThreadPool::ExecutionMode::CONCURRENT, max_parallel);
+    }
+    for (size_t i = 0; i < num_rowsets; ++i) {
+        auto run = [&, i]() {
+            if (failed) {
+                rowset_status[i] = Status::Cancelled("the conversion of another rowset failed");
+                return;
+            }
+            rowset_status[i] = convert(i);
+            if (!rowset_status[i].ok()) {
+                failed = true;
+            }
+        };
+        if (token == nullptr || !token->submit_func(run).ok()) {
+            run();
         }
-        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
-                                                   rowset_writer->rowset_id().to_string());
-        // Add the new version of the data to the header
-        // In order to prevent the occurrence of deadlock, we must first lock the old table, and then lock the new table
-        std::lock_guard<std::mutex> lock(sc_params.new_tablet->get_push_lock());
-        RowsetSharedPtr new_rowset = rowset_writer->build();
-        if (new_rowset == nullptr) {
-            LOG(WARNING) << "failed to build rowset, exit alter process";
-            return process_alter_exit();
-        }
-        res = sc_params.new_tablet->add_rowset(new_rowset);
-        if (res.precise_code() == OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-            LOG(WARNING) << "version already exist, version revert occurred. "
-                         << "tablet=" << sc_params.new_tablet->full_name() << ", version='"
-                         << rs_reader->version().first << "-" << rs_reader->version().second;
-            StorageEngine::instance()->add_unused_rowset(new_rowset);
-            res = Status::OK();
-        } else if (!res) {
-            LOG(WARNING) << "failed to register new version. "
-                         << " tablet=" << sc_params.new_tablet->full_name()
-                         << ", version=" << rs_reader->version().first << "-"
-                         << rs_reader->version().second;
-            StorageEngine::instance()->add_unused_rowset(new_rowset);
-            return process_alter_exit();
-        } else {
-            VLOG_NOTICE << "register new version. tablet=" << sc_params.new_tablet->full_name()
-                        << ", version=" << rs_reader->version().first << "-"
-                        << rs_reader->version().second;
+    }
+    if (token != nullptr) {
+        token->wait();
+    }
+    for (auto& status : rowset_status) {
+        // report the failure that cancelled the other conversions
+        if (!status.ok() && !status.is_cancelled()) {
+            return status;
         }
+    }
+    return Status::OK();
+}
 
-        VLOG_TRACE << "succeed to convert a history version."
-                   << " version=" << rs_reader->version().first << "-"
-                   << rs_reader->version().second;
+Status SchemaChangeHandler::_convert_rowset(const SchemaChangeParams& sc_params,
+                                            const RowBlockChanger& rb_changer, bool sc_sorting,
+                                            bool sc_directly,
+                                            const RowsetReaderSharedPtr& rs_reader) {
+    VLOG_TRACE << "begin to convert a history rowset. version=" << rs_reader->version().first
+               << "-" << rs_reader->version().second;
+
+    TabletSharedPtr new_tablet = sc_params.new_tablet;
+    // When tablet create new rowset writer, it may change rowset type, in this case
+    // linked schema change will not be used.
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    Status status = new_tablet->create_rowset_writer(
+            rs_reader->version(), VISIBLE, rs_reader->rowset()->rowset_meta()->segments_overlap(),
+            &new_tablet->tablet_schema(), rs_reader->oldest_write_timestamp(),
+            rs_reader->newest_write_timestamp(), &rowset_writer);
+    if (!status.ok()) {
+        return Status::OLAPInternalError(OLAP_ERR_ROWSET_BUILDER_INIT);
     }
 
-    // XXX:The SchemaChange state should not be canceled at this time, because the new Delta has to be converted to the old and new Schema version
-    return process_alter_exit();
+    auto sc_procedure = get_sc_procedure(rb_changer, sc_sorting, sc_directly);
+    status = sc_procedure->process(rs_reader, rowset_writer.get(), new_tablet,
+                                   sc_params.base_tablet);
+    new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX +
+                                               rowset_writer->rowset_id().to_string());
+    if (!status.ok()) {
+        LOG(WARNING) << "failed to process the version."
+                     << " version=" << rs_reader->version().first << "-"
+                     << rs_reader->version().second;
+        return status;
+    }
+    // Add the new version of the data to the header
+    // In order to prevent the occurrence of deadlock, we must first lock the old table, and then lock the new table
+    std::lock_guard<std::mutex> lock(new_tablet->get_push_lock());
+    RowsetSharedPtr new_rowset = rowset_writer->build();
+    if (new_rowset == nullptr) {
+        LOG(WARNING) << "failed to build rowset, exit alter process";
+        return Status::OLAPInternalError(OLAP_ERR_MALLOC_ERROR);
+    }
+    status = new_tablet->add_rowset(new_rowset);
+    if (status.precise_code() == OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+        LOG(WARNING) << "version already exist, version revert occurred. "
+                     << "tablet=" << new_tablet->full_name() << ", version='"
+                     << rs_reader->version().first << "-" << rs_reader->version().second;
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+    } else if (!status) {
+        LOG(WARNING) << "failed to register new version. "
+                     << " tablet=" << new_tablet->full_name()
+                     << ", version=" << rs_reader->version().first << "-"
+                     << rs_reader->version().second;
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+        return status;
+    } else {
+        VLOG_NOTICE << "register new version. tablet=" << new_tablet->full_name()
+                    << ", version=" << rs_reader->version().first << "-"
+                    << rs_reader->version().second;
+    }
+
+    VLOG_TRACE << "succeed to convert a history version."
+               << " version=" << rs_reader->version().first << "-"
+               << rs_reader->version().second;
+    return Status::OK();
 }
 
 // @static
@@ -2405,9 +2449,28 @@ Status SchemaChangeHandler::_parse_request(
             if (column_new.type() != column_old.type() ||
                 column_new.precision() != column_old.precision() ||
                 column_new.frac() != column_old.frac() ||
-                column_new.length() != column_old.length() ||
-                column_new.is_bf_column() != column_old.is_bf_column() ||
-                column_new.has_bitmap_index() != column_old.has_bitmap_index()) {
+                column_new.length() != column_old.length()) {
+                *sc_directly = true;
+                return Status::OK();
+            }
+            bool index_changed =
+                    column_new.is_bf_column() != column_old.is_bf_column() ||
+                    column_new.has_bitmap_index() != column_old.has_bitmap_index() ||
+                    column_new.bit_sliced_bitmap_index() != column_old.bit_sliced_bitmap_index() ||
+                    column_new.inverted_index_parser() != column_old.inverted_index_parser() ||
+                    column_new.inverted_index_gram_size() !=
+                            column_old.inverted_index_gram_size() ||
+                    column_new.ngram_bf_gram_size() != column_old.ngram_bf_gram_size();
+            // the indexes the linked segments lack are built into their index files by the index
+            // build tasks, but an index kept with other parameters has to be rewritten
+            bool index_rebuilt =
+                    (column_new.has_inverted_index() && column_old.has_inverted_index() &&
+                     (column_new.inverted_index_parser() != column_old.inverted_index_parser() ||
+                      column_new.inverted_index_gram_size() !=
+                              column_old.inverted_index_gram_size())) ||
+                    (column_new.ngram_bf_gram_size() > 0 && column_old.ngram_bf_gram_size() > 0 &&
+                     column_new.ngram_bf_gram_size() != column_old.ngram_bf_gram_size());
+            if (index_changed && (!config::schema_change_link_index_changes || index_rebuilt)) {
                 *sc_directly = true;
                 return Status::OK();
             }
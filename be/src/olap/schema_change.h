@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "common/status.h"
 #include "gen_cpp/AgentService_types.h"
 #include "olap/column_mapping.h"
@@ -29,6 +31,8 @@
 
 namespace doris {
 
+class ThreadPool;
+
 bool to_bitmap(RowCursor* read_helper, RowCursor* write_helper, const TabletColumn& ref_column,
                int field_idx, int ref_field_idx, MemPool* mem_pool);
 bool hll_hash(RowCursor* read_helper, RowCursor* write_helper, const TabletColumn& ref_column,
@@ -282,6 +286,12 @@ public:
 
     static bool tablet_in_converting(int64_t tablet_id);
 
+    // Runs convert(i) for each of the num_rowsets rowsets, up to max_parallel at once on the pool,
+    // or inline without a pool. Once a conversion fails, the ones not started yet are cancelled,
+    // and the first failure is returned.
+    static Status run_rowset_conversions(ThreadPool* pool, int max_parallel, size_t num_rowsets,
+                                         const std::function<Status(size_t)>& convert);
+
 private:
     // Check the status of schema change and clear information between "a pair" of Schema change tables
     // Since A->B's schema_change information for A will be overwritten in subsequent processing (no extra cleanup here)
@@ -321,6 +331,11 @@ private:
 
     static Status _convert_historical_rowsets(const SchemaChangeParams& sc_params);
 
+    // Converts one rowset of the base tablet and adds it to the new tablet.
+    static Status _convert_rowset(const SchemaChangeParams& sc_params,
+                                  const RowBlockChanger& rb_changer, bool sc_sorting,
+                                  bool sc_directly, const RowsetReaderSharedPtr& rs_reader);
+
     static Status _parse_request(TabletSharedPtr base_tablet, TabletSharedPtr new_tablet,
                                  RowBlockChanger* rb_changer, bool* sc_sorting, bool* sc_directly,
                                  const std::unordered_map<std::string, AlterMaterializedViewParam>&
@@ -98,4 +98,12 @@ Status SegmentLoader::prune() {
     return Status::OK();
 }
 
+void SegmentLoader::erase(const RowsetId& rowset_id) {
+    _cache->erase(SegmentLoader::CacheKey(rowset_id).encode());
+}
+
+int64_t SegmentLoader::prune_all() {
+    return _cache->prune();
+}
+
 } // namespace doris
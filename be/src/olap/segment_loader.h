@@ -85,9 +85,16 @@ public:
     Status load_segments(const BetaRowsetSharedPtr& rowset, SegmentCacheHandle* cache_handle,
                          bool use_cache = false);
 
+    // Drop the cached segments of the rowset, so that they are opened again by the next load,
+    // e.g. with the index files built for them since then.
+    void erase(const RowsetId& rowset_id);
+
     // Try to prune the segment cache if expired.
     Status prune();
 
+    // Drop all the segments that are not in use, returns the number of dropped entries.
+    int64_t prune_all();
+
 private:
     SegmentLoader();
 
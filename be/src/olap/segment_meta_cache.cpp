@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/segment_meta_cache.h"
+
+#include <fmt/format.h>
+
+namespace doris {
+
+SegmentMetaCache* SegmentMetaCache::_s_instance = nullptr;
+
+void SegmentMetaCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    if (capacity == 0) {
+        return;
+    }
+    static SegmentMetaCache instance(capacity);
+    _s_instance = &instance;
+}
+
+SegmentMetaCache::SegmentMetaCache(size_t capacity)
+        : _cache(new_lru_cache("SegmentMetaCache", capacity)) {}
+
+std::string SegmentMetaCache::key(const std::string& path, MetaType type, uint64_t offset) {
+    return fmt::format("{}:{}:{}", path, type, offset);
+}
+
+std::shared_ptr<void> SegmentMetaCache::_lookup(const std::string& key) {
+    auto handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    auto meta = *reinterpret_cast<std::shared_ptr<void>*>(_cache->value(handle));
+    _cache->release(handle);
+    return meta;
+}
+
+void SegmentMetaCache::_insert(const std::string& key, std::shared_ptr<void> meta, size_t charge,
+                               bool pinned) {
+    auto deleter = [](const doris::CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<void>*>(value);
+    };
+    auto value = new std::shared_ptr<void>(std::move(meta));
+    auto handle = _cache->insert(CacheKey(key), value, charge, deleter,
+                                 pinned ? CachePriority::DURABLE : CachePriority::NORMAL);
+    _cache->release(handle);
+}
+
+} // namespace doris
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "olap/lru_cache.h"
+
+namespace doris {
+
+// SegmentMetaCache caches the parsed metadata of the segment files: their footers and the
+// ordinal indexes and zone maps of their columns, and the rows of the segments deleted by the
+// delete conditions of a version. A segment evicted from the SegmentLoader is opened again
+// without reading and parsing them. The capacity and the entries are measured in
+// bytes of memory. The metadata of in memory tablets is pinned by inserting it at DURABLE
+// priority. The usage and hit ratio are reported by the metrics of the "SegmentMetaCache" LRU
+// cache.
+class SegmentMetaCache {
+public:
+    enum MetaType { FOOTER, ORDINAL_INDEX, ZONE_MAP_INDEX, DELETED_ROWS };
+
+    // Create the global instance, or none if 'capacity' is 0.
+    static void create_global_instance(size_t capacity);
+
+    // Return nullptr if the metadata is not cached.
+    static SegmentMetaCache* instance() { return _s_instance; }
+
+    SegmentMetaCache(size_t capacity);
+
+    // The key of a metadata of the segment file 'path', stored at 'offset' of the file. The key of
+    // the deleted rows has the version of the delete conditions as its offset.
+    static std::string key(const std::string& path, MetaType type, uint64_t offset = 0);
+
+    template <typename T>
+    std::shared_ptr<T> lookup(const std::string& key) {
+        return std::static_pointer_cast<T>(_lookup(key));
+    }
+
+    // Insert 'meta' of 'charge' bytes, that is only evicted under DURABLE pressure if 'pinned'.
+    template <typename T>
+    void insert(const std::string& key, std::shared_ptr<T> meta, size_t charge, bool pinned) {
+        _insert(key, std::const_pointer_cast<void>(std::static_pointer_cast<const void>(meta)),
+                charge, pinned);
+    }
+
+private:
+    std::shared_ptr<void> _lookup(const std::string& key);
+
+    void _insert(const std::string& key, std::shared_ptr<void> meta, size_t charge, bool pinned);
+
+    static SegmentMetaCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace doris
@@ -83,6 +83,11 @@ Status ShortKeyIndexDecoder::parse(const Slice& body, const segment_v2::ShortKey
         return Status::Corruption("Still has data after parse all key offset");
     }
     _parsed = true;
+
+    _key_prefixes.resize(_footer.num_items());
+    for (uint32_t i = 0; i < _footer.num_items(); ++i) {
+        _key_prefixes[i] = key_prefix(key(i));
+    }
     return Status::OK();
 }
 
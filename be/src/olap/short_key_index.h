@@ -26,6 +26,7 @@
 #include "gen_cpp/segment_v2.pb.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
+#include "util/simd/sorted_search.h"
 #include "util/slice.h"
 
 namespace doris {
@@ -256,13 +257,31 @@ public:
     }
 
 private:
+    // The first 8 bytes of the key as a big endian integer, padded with zeros. The prefixes are in
+    // the order of their keys, but different keys may have the same prefix.
+    static uint64_t key_prefix(const Slice& key) {
+        uint64_t prefix = 0;
+        for (size_t i = 0; i < sizeof(prefix); ++i) {
+            prefix = (prefix << 8) | (i < key.size ? static_cast<uint8_t>(key.data[i]) : 0);
+        }
+        return prefix;
+    }
+
+    // The items are first narrowed to the ones with the prefix of the key, by searching the
+    // prefixes, and only those keys are compared as slices.
     template <bool lower_bound>
     ShortKeyIndexIterator seek(const Slice& key) const {
+        uint64_t prefix = key_prefix(key);
+        size_t first = simd::sorted_lower_bound(_key_prefixes.data(), _key_prefixes.size(), prefix);
+        size_t last = first + simd::sorted_upper_bound(_key_prefixes.data() + first,
+                                                       _key_prefixes.size() - first, prefix);
         auto comparator = [](const Slice& lhs, const Slice& rhs) { return lhs.compare(rhs) < 0; };
         if (lower_bound) {
-            return std::lower_bound(begin(), end(), key, comparator);
+            return std::lower_bound(ShortKeyIndexIterator(this, first),
+                                    ShortKeyIndexIterator(this, last), key, comparator);
         } else {
-            return std::upper_bound(begin(), end(), key, comparator);
+            return std::upper_bound(ShortKeyIndexIterator(this, first),
+                                    ShortKeyIndexIterator(this, last), key, comparator);
         }
     }
 
@@ -273,6 +292,8 @@ private:
     segment_v2::ShortKeyFooterPB _footer;
     std::vector<uint32_t> _offsets;
     Slice _key_data;
+    // the prefixes of the keys of the items
+    std::vector<uint64_t> _key_prefixes;
 };
 
 inline Slice ShortKeyIndexIterator::operator*() const {
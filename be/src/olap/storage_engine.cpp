@@ -158,9 +158,25 @@ StorageEngine::~StorageEngine() {
         _quick_compaction_thread_pool->shutdown();
     }
 
+    if (_vertical_compaction_thread_pool) {
+        _vertical_compaction_thread_pool->shutdown();
+    }
+
+    if (_schema_change_thread_pool) {
+        _schema_change_thread_pool->shutdown();
+    }
+
     if (_tablet_meta_checkpoint_thread_pool) {
         _tablet_meta_checkpoint_thread_pool->shutdown();
     }
+
+    if (_tablet_publish_txn_thread_pool) {
+        _tablet_publish_txn_thread_pool->shutdown();
+    }
+
+    if (_index_build_thread_pool) {
+        _index_build_thread_pool->shutdown();
+    }
 }
 
 void StorageEngine::load_data_dirs(const std::vector<DataDir*>& data_dirs) {
@@ -579,6 +595,7 @@ void StorageEngine::stop() {
     THREAD_JOIN(_disk_stat_monitor_thread);
     THREAD_JOIN(_fd_cache_clean_thread);
     THREAD_JOIN(_tablet_checkpoint_tasks_producer_thread);
+    THREAD_JOIN(_index_build_tasks_producer_thread);
 #undef THREAD_JOIN
 
 #define THREADS_JOIN(threads)            \
@@ -776,10 +793,7 @@ void StorageEngine::_clean_unused_rowset_metas() {
     auto data_dirs = get_stores();
     for (auto data_dir : data_dirs) {
         RowsetMetaManager::traverse_rowset_metas(data_dir->get_meta(), clean_rowset_func);
-        for (auto& rowset_meta : invalid_rowset_metas) {
-            RowsetMetaManager::remove(data_dir->get_meta(), rowset_meta->tablet_uid(),
-                                      rowset_meta->rowset_id());
-        }
+        RowsetMetaManager::remove(data_dir->get_meta(), invalid_rowset_metas);
         LOG(INFO) << "remove " << invalid_rowset_metas.size()
                   << " invalid rowset meta from dir: " << data_dir->path();
         invalid_rowset_metas.clear();
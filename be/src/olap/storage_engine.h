@@ -35,6 +35,7 @@
 #include "gen_cpp/BackendService_types.h"
 #include "gen_cpp/MasterService_types.h"
 #include "gutil/ref_counted.h"
+#include "olap/compaction_io_scheduler.h"
 #include "olap/compaction_permit_limiter.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
@@ -138,6 +139,17 @@ public:
     TxnManager* txn_manager() { return _txn_manager.get(); }
     MemTableFlushExecutor* memtable_flush_executor() { return _memtable_flush_executor.get(); }
 
+    CompactionIOScheduler* compaction_io_scheduler() { return &_compaction_io_scheduler; }
+
+    // runs the value column groups of vertical compactions, nullptr before started
+    ThreadPool* vertical_compaction_thread_pool() { return _vertical_compaction_thread_pool.get(); }
+
+    // runs the rowset conversions of schema changes, nullptr before started
+    ThreadPool* schema_change_thread_pool() { return _schema_change_thread_pool.get(); }
+
+    // adds the published rowsets to their tablets, nullptr before started
+    ThreadPool* tablet_publish_txn_thread_pool() { return _tablet_publish_txn_thread_pool.get(); }
+
     bool check_rowset_id_in_unused_rowsets(const RowsetId& rowset_id);
 
     RowsetId next_rowset_id() { return _rowset_id_generator->next_id(); };
@@ -272,6 +284,8 @@ private:
 
     void _cooldown_tasks_producer_callback();
 
+    void _index_build_tasks_producer_callback();
+
 private:
     struct CompactionCandidate {
         CompactionCandidate(uint32_t nicumulative_compaction_, int64_t tablet_id_, uint32_t index_)
@@ -381,10 +395,13 @@ private:
     std::unique_ptr<ThreadPool> _quick_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _base_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _cumu_compaction_thread_pool;
+    std::unique_ptr<ThreadPool> _vertical_compaction_thread_pool;
+    std::unique_ptr<ThreadPool> _schema_change_thread_pool;
 
     std::unique_ptr<ThreadPool> _tablet_meta_checkpoint_thread_pool;
 
     CompactionPermitLimiter _permit_limiter;
+    CompactionIOScheduler _compaction_io_scheduler;
 
     std::mutex _tablet_submitted_compaction_mutex;
     // a tablet can do base and cumulative compaction at same time
@@ -404,10 +421,17 @@ private:
 
     std::unique_ptr<ThreadPool> _cooldown_thread_pool;
 
+    std::unique_ptr<ThreadPool> _tablet_publish_txn_thread_pool;
+
     std::mutex _running_cooldown_mutex;
     std::unordered_map<DataDir*, int64_t> _running_cooldown_tasks_cnt;
     std::unordered_set<int64_t> _running_cooldown_tablets;
 
+    scoped_refptr<Thread> _index_build_tasks_producer_thread;
+    std::unique_ptr<ThreadPool> _index_build_thread_pool;
+    std::mutex _running_index_build_mutex;
+    std::unordered_set<int64_t> _running_index_build_tablets;
+
     DISALLOW_COPY_AND_ASSIGN(StorageEngine);
 };
 
@@ -39,6 +39,8 @@
 #include "io/fs/path.h"
 #include "io/fs/remote_file_system.h"
 #include "olap/base_compaction.h"
+#include "olap/column_block.h"
+#include "olap/column_vector.h"
 #include "olap/cumulative_compaction.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
@@ -47,17 +49,21 @@
 #include "olap/rowset/rowset.h"
 #include "olap/rowset/rowset_factory.h"
 #include "olap/rowset/rowset_meta_manager.h"
+#include "olap/rowset/segment_v2/segment.h"
 #include "olap/schema_change.h"
 #include "olap/storage_engine.h"
 #include "olap/storage_policy_mgr.h"
+#include "olap/types.h"
 #include "olap/tablet_meta.h"
 #include "olap/tablet_meta_manager.h"
+#include "runtime/mem_pool.h"
 #include "segment_loader.h"
 #include "util/path_util.h"
 #include "util/pretty_printer.h"
 #include "util/scoped_cleanup.h"
 #include "util/time.h"
 #include "util/trace.h"
+#include "vec/data_types/data_type_factory.hpp"
 
 namespace doris {
 
@@ -221,6 +227,7 @@ Status Tablet::revise_tablet_meta(const std::vector<RowsetMetaSharedPtr>& rowset
     }
     _stale_rs_version_map.clear();
     _tablet_meta->clear_stale_rowset();
+    _mark_compaction_score_dirty();
 
     LOG(INFO) << "finish to revise tablet. res=" << res << ", "
               << "table=" << full_name();
@@ -264,6 +271,7 @@ Status Tablet::add_rowset(RowsetSharedPtr rowset) {
     std::vector<RowsetSharedPtr> empty_vec;
     modify_rowsets(empty_vec, rowsets_to_delete);
     ++_newly_created_rowset_num;
+    _mark_compaction_score_dirty();
     return Status::OK();
 }
 
@@ -358,6 +366,7 @@ Status Tablet::modify_rowsets(std::vector<RowsetSharedPtr>& to_add,
             StorageEngine::instance()->add_unused_rowset(rs);
         }
     }
+    _mark_compaction_score_dirty();
     return Status::OK();
 }
 
@@ -445,6 +454,7 @@ Status Tablet::add_inc_rowset(const RowsetSharedPtr& rowset) {
     _timestamped_version_tracker.add_version(rowset->version());
 
     ++_newly_created_rowset_num;
+    _mark_compaction_score_dirty();
     return Status::OK();
 }
 
@@ -566,6 +576,7 @@ void Tablet::delete_expired_stale_rowset() {
     auto old_meta_size = _tablet_meta->all_stale_rs_metas().size();
 
     // do delete operation
+    std::vector<RowsetId> deleted_rowset_ids;
     auto to_delete_iter = stale_version_path_map.begin();
     while (to_delete_iter != stale_version_path_map.end()) {
         std::vector<TimestampedVersionSharedPtr>& to_delete_version =
@@ -575,6 +586,7 @@ void Tablet::delete_expired_stale_rowset() {
             if (it != _stale_rs_version_map.end()) {
                 // delete rowset
                 StorageEngine::instance()->add_unused_rowset(it->second);
+                deleted_rowset_ids.push_back(it->second->rowset_id());
                 _stale_rs_version_map.erase(it);
                 VLOG_NOTICE << "delete stale rowset tablet=" << full_name() << " version["
                             << timestampedVersion->version().first << ","
@@ -594,6 +606,10 @@ void Tablet::delete_expired_stale_rowset() {
 
     bool reconstructed = _reconstruct_version_tracker_if_necessary();
 
+    if (keys_type() == UNIQUE_KEYS && enable_unique_key_merge_on_write()) {
+        _compact_delete_bitmap_unlocked(deleted_rowset_ids);
+    }
+
     VLOG_NOTICE << "delete stale rowset _stale_rs_version_map tablet=" << full_name()
                 << " current_size=" << _stale_rs_version_map.size() << " old_size=" << old_size
                 << " current_meta_size=" << _tablet_meta->all_stale_rs_metas().size()
@@ -605,6 +621,30 @@ void Tablet::delete_expired_stale_rowset() {
 #endif
 }
 
+void Tablet::_compact_delete_bitmap_unlocked(const std::vector<RowsetId>& deleted_rowset_ids) {
+    auto& delete_bitmap = _tablet_meta->delete_bitmap();
+    for (auto& rowset_id : deleted_rowset_ids) {
+        delete_bitmap.remove({rowset_id, 0, 0}, {rowset_id, UINT32_MAX, 0});
+    }
+    // A read at some version goes through a rowset starting at version 0, so no version lower
+    // than the smallest end version of those rowsets can be read any more.
+    int64_t min_readable_version = INT64_MAX;
+    for (auto* rs_map : {&_rs_version_map, &_stale_rs_version_map}) {
+        for (auto& [version, rowset] : *rs_map) {
+            if (version.first == 0) {
+                min_readable_version = std::min(min_readable_version, version.second);
+            }
+        }
+    }
+    if (min_readable_version == INT64_MAX) {
+        return;
+    }
+    size_t num_folded = delete_bitmap.compact(min_readable_version);
+    VLOG_NOTICE << "compact delete bitmap tablet=" << full_name()
+                << " removed_rowsets=" << deleted_rowset_ids.size()
+                << " folded_bitmaps=" << num_folded << " version=" << min_readable_version;
+}
+
 bool Tablet::_reconstruct_version_tracker_if_necessary() {
     double orphan_vertex_ratio = _timestamped_version_tracker.get_orphan_vertex_ratio();
     if (orphan_vertex_ratio >= config::tablet_version_graph_orphan_vertex_ratio) {
@@ -806,6 +846,7 @@ const uint32_t Tablet::_calc_base_compaction_score() const {
     uint32_t score = 0;
     const int64_t point = cumulative_layer_point();
     bool base_rowset_exist = false;
+    bool has_delete_predicate = false;
     for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
         if (rs_meta->start_version() == 0) {
             base_rowset_exist = true;
@@ -816,6 +857,14 @@ const uint32_t Tablet::_calc_base_compaction_score() const {
         }
 
         score += rs_meta->get_compaction_score();
+        has_delete_predicate |= rs_meta->has_delete_predicate();
+    }
+    // The promoted rowsets of the time series policy are already merged, base compaction would
+    // rewrite them only to apply the delete predicates.
+    if (_cumulative_compaction_policy != nullptr &&
+        _cumulative_compaction_policy->name() == CUMULATIVE_TIME_SERIES_POLICY &&
+        !has_delete_predicate) {
+        return 0;
     }
 
     // base不存在可能是tablet正在做alter table，先不选它，设score=0
@@ -1293,6 +1342,7 @@ bool Tablet::do_tablet_meta_checkpoint() {
     save_meta();
     // if save meta successfully, then should remove the rowset meta existing in tablet
     // meta from rowset meta store
+    std::vector<RowsetMetaSharedPtr> persistent_rs_metas;
     for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
         // If we delete it from rowset manager's meta explicitly in previous checkpoint, just skip.
         if (rs_meta->is_remove_from_rowset_meta()) {
@@ -1300,7 +1350,7 @@ bool Tablet::do_tablet_meta_checkpoint() {
         }
         if (RowsetMetaManager::check_rowset_meta(_data_dir->get_meta(), tablet_uid(),
                                                  rs_meta->rowset_id())) {
-            RowsetMetaManager::remove(_data_dir->get_meta(), tablet_uid(), rs_meta->rowset_id());
+            persistent_rs_metas.push_back(rs_meta);
             VLOG_NOTICE << "remove rowset id from meta store because it is already persistent with "
                         << "tablet meta, rowset_id=" << rs_meta->rowset_id();
         }
@@ -1315,12 +1365,13 @@ bool Tablet::do_tablet_meta_checkpoint() {
         }
         if (RowsetMetaManager::check_rowset_meta(_data_dir->get_meta(), tablet_uid(),
                                                  rs_meta->rowset_id())) {
-            RowsetMetaManager::remove(_data_dir->get_meta(), tablet_uid(), rs_meta->rowset_id());
+            persistent_rs_metas.push_back(rs_meta);
             VLOG_NOTICE << "remove rowset id from meta store because it is already persistent with "
                         << "tablet meta, rowset_id=" << rs_meta->rowset_id();
         }
         rs_meta->set_remove_from_rowset_meta();
     }
+    RowsetMetaManager::remove(_data_dir->get_meta(), persistent_rs_metas);
 
     _newly_created_rowset_num = 0;
     _last_checkpoint_time = UnixMillis();
@@ -1462,6 +1513,14 @@ double Tablet::calculate_scan_frequency() {
     return scan_frequency;
 }
 
+double Tablet::scan_frequency() const {
+    double interval = difftime(time(nullptr), _last_record_scan_count_timestamp);
+    if (interval <= 0) {
+        return 0;
+    }
+    return (query_scan_count->value() - _last_record_scan_count) * 60 / interval;
+}
+
 Status Tablet::prepare_compaction_and_calculate_permits(CompactionType compaction_type,
                                                         TabletSharedPtr tablet, int64_t* permits) {
     std::vector<RowsetSharedPtr> compaction_rowsets;
@@ -1649,7 +1708,8 @@ Status Tablet::create_rowset_writer(const int64_t& txn_id, const PUniqueId& load
                                     const RowsetStatePB& rowset_state,
                                     const SegmentsOverlapPB& overlap,
                                     const doris::TabletSchema* tablet_schema,
-                                    std::unique_ptr<RowsetWriter>* rowset_writer) {
+                                    std::unique_ptr<RowsetWriter>* rowset_writer,
+                                    const std::vector<uint32_t>& partial_update_missing_cids) {
     RowsetWriterContext context;
     context.txn_id = txn_id;
     context.load_id = load_id;
@@ -1659,6 +1719,10 @@ Status Tablet::create_rowset_writer(const int64_t& txn_id, const PUniqueId& load
     context.newest_write_timestamp = -1;
     context.tablet_schema = tablet_schema;
     _init_context_common_fields(context);
+    if (!partial_update_missing_cids.empty()) {
+        context.partial_update_missing_cids = partial_update_missing_cids;
+        context.tablet = this;
+    }
     return RowsetFactory::create_rowset_writer(context, rowset_writer);
 }
 
@@ -1677,6 +1741,7 @@ void Tablet::_init_context_common_fields(RowsetWriterContext& context) {
     }
     context.tablet_path = tablet_path();
     context.data_dir = data_dir();
+    context.enable_unique_key_merge_on_write = enable_unique_key_merge_on_write();
 }
 
 Status Tablet::create_rowset(RowsetMetaSharedPtr rowset_meta, RowsetSharedPtr* rowset) {
@@ -1689,17 +1754,6 @@ Status Tablet::cooldown() {
         LOG(WARNING) << "Failed to own schema_change_lock. tablet=" << tablet_id();
         return Status::OLAPInternalError(OLAP_ERR_BE_TRY_BE_LOCK_ERROR);
     }
-    // Check executing serially with compaction task.
-    std::unique_lock base_compaction_lock(_base_compaction_lock, std::try_to_lock);
-    if (!base_compaction_lock.owns_lock()) {
-        LOG(WARNING) << "Failed to own base_compaction_lock. tablet=" << tablet_id();
-        return Status::OLAPInternalError(OLAP_ERR_BE_TRY_BE_LOCK_ERROR);
-    }
-    std::unique_lock cumu_compaction_lock(_cumulative_compaction_lock, std::try_to_lock);
-    if (!cumu_compaction_lock.owns_lock()) {
-        LOG(WARNING) << "Failed to own cumu_compaction_lock. tablet=" << tablet_id();
-        return Status::OLAPInternalError(OLAP_ERR_BE_TRY_BE_LOCK_ERROR);
-    }
     auto dest_fs = io::FileSystemMap::instance()->get(cooldown_resource());
     if (!dest_fs) {
         return Status::OLAPInternalError(OLAP_ERR_NOT_INITED);
@@ -1732,10 +1786,23 @@ Status Tablet::cooldown() {
     RowsetSharedPtr new_rowset;
     RowsetFactory::create_rowset(&_schema, _tablet_path, std::move(new_rowset_meta), &new_rowset);
 
+    // The compactions are not blocked by the upload and the scans keep reading the local rowset
+    // until it is replaced here. The remote copy is dropped if a compaction has replaced the local
+    // rowset meanwhile.
+    std::lock_guard base_compaction_lock(_base_compaction_lock);
+    std::lock_guard cumu_compaction_lock(_cumulative_compaction_lock);
+    std::unique_lock meta_wlock(_meta_lock);
+    auto it = _rs_version_map.find(old_rowset->version());
+    if (it == _rs_version_map.end() || it->second->rowset_id() != old_rowset->rowset_id()) {
+        meta_wlock.unlock();
+        LOG(INFO) << "Rowset " << old_rowset->version() << " of tablet " << tablet_id()
+                  << " is replaced during cooldown, drop the remote rowset "
+                  << new_rowset_id.to_string();
+        WARN_IF_ERROR(new_rowset->remove(), "Failed to remove the remote rowset");
+        return Status::OK();
+    }
     std::vector to_add {std::move(new_rowset)};
     std::vector to_delete {std::move(old_rowset)};
-
-    std::unique_lock meta_wlock(_meta_lock);
     modify_rowsets(to_add, to_delete);
     save_meta();
     return Status::OK();
@@ -1759,6 +1826,19 @@ RowsetSharedPtr Tablet::pick_cooldown_rowset() {
     return rowset;
 }
 
+std::vector<RowsetSharedPtr> Tablet::pick_rowsets_to_build_indexes() {
+    std::vector<RowsetSharedPtr> rowsets;
+    std::shared_lock meta_rlock(_meta_lock);
+    for (const auto& it : _rs_version_map) {
+        auto& rs = it.second;
+        if (rs->is_local() && rs->rowset_meta()->has_index_files() &&
+            !rs->rowset_meta()->index_files_built()) {
+            rowsets.push_back(rs);
+        }
+    }
+    return rowsets;
+}
+
 bool Tablet::need_cooldown(int64_t* cooldown_timestamp, size_t* file_size) {
     // std::shared_lock meta_rlock(_meta_lock);
     if (cooldown_resource().empty()) {
@@ -1777,6 +1857,12 @@ bool Tablet::need_cooldown(int64_t* cooldown_timestamp, size_t* file_size) {
         VLOG_DEBUG << "pick cooldown rowset, get null, tablet id: " << tablet_id();
         return false;
     }
+    // The data of the tablets still scanned frequently is kept local.
+    if (config::cooldown_hot_tablet_scan_frequency > 0 &&
+        scan_frequency() >= config::cooldown_hot_tablet_scan_frequency) {
+        VLOG_DEBUG << "tablet is hot and does not need cooldown, tablet id: " << tablet_id();
+        return false;
+    }
 
     int64_t oldest_cooldown_time = std::numeric_limits<int64_t>::max();
     if (cooldown_ttl_sec >= 0) {
@@ -1841,13 +1927,67 @@ void Tablet::remove_all_remote_rowsets() {
 
 const TabletSchema& Tablet::tablet_schema() const {
     std::shared_lock wrlock(_meta_lock);
+    return _tablet_schema_unlocked();
+}
+
+const TabletSchema& Tablet::_tablet_schema_unlocked() const {
     const RowsetMetaSharedPtr rowset_meta =
             rowset_meta_with_max_schema_version(_tablet_meta->all_rs_metas());
+    // a light schema change updates the schema of the tablet ahead of its rowsets
+    const TabletSchema& meta_schema = _tablet_meta->tablet_schema();
+    if (meta_schema.schema_version() > rowset_meta->tablet_schema()->schema_version()) {
+        return meta_schema;
+    }
     return *rowset_meta->tablet_schema();
 }
 
+Status Tablet::update_tablet_schema(const std::vector<TabletColumn>& columns,
+                                    int32_t schema_version) {
+    const TabletSchema& cur_schema = _tablet_schema_unlocked();
+    if (schema_version <= cur_schema.schema_version()) {
+        LOG(INFO) << "skip schema version " << schema_version << " of tablet " << full_name()
+                  << ", which is at schema version " << cur_schema.schema_version();
+        return Status::OK();
+    }
+    size_t num_key_columns = 0;
+    for (const auto& column : columns) {
+        if (column.unique_id() < 0) {
+            return Status::InvalidArgument("column {} has no unique id", column.name());
+        }
+        int32_t cid = cur_schema.field_index(column.unique_id());
+        if (column.is_key()) {
+            if (cid != static_cast<int32_t>(num_key_columns) || !cur_schema.column(cid).is_key()) {
+                return Status::InvalidArgument(
+                        "can't change key column {} by a light schema change", column.name());
+            }
+            ++num_key_columns;
+        }
+        if (cid < 0) {
+            if (!column.is_nullable() && !column.has_default_value()) {
+                return Status::InvalidArgument(
+                        "added column {} is neither nullable nor has a default value",
+                        column.name());
+            }
+        } else if (column.type() != cur_schema.column(cid).type()) {
+            return Status::InvalidArgument("can't change the type of column {} by a light schema "
+                                           "change",
+                                           column.name());
+        }
+    }
+    if (num_key_columns != cur_schema.num_key_columns()) {
+        return Status::InvalidArgument("can't drop key columns by a light schema change");
+    }
+
+    TabletSchema new_schema = cur_schema;
+    new_schema.update_columns(columns, schema_version);
+    _tablet_meta->update_tablet_schema(new_schema);
+    LOG(INFO) << "update schema of tablet " << full_name() << " to version " << schema_version
+              << ", num_columns=" << new_schema.num_columns();
+    return Status::OK();
+}
+
 Status Tablet::lookup_row_key(const Slice& encoded_key, RowLocation* row_location,
-                              uint32_t version) {
+                              uint32_t version, RowsetSharedPtr* rowset) {
     std::vector<std::pair<RowsetSharedPtr, int32_t>> selected_rs;
     _rowset_tree->FindRowsetsWithKeyInRange(encoded_key, &selected_rs);
     if (selected_rs.empty()) {
@@ -1879,10 +2019,269 @@ Status Tablet::lookup_row_key(const Slice& encoded_key, RowLocation* row_locatio
         loc.rowset_id = rs.first->rowset_id();
         // Check delete bitmap, if the row
         *row_location = loc;
+        if (rowset != nullptr) {
+            *rowset = rs.first;
+        }
         // find it and return
         return s;
     }
     return Status::NotFound("can't find key in all rowsets");
 }
 
+// Holds the segments and the primary key index iterators of the rowsets probed while
+// computing one delete bitmap. Keys are probed in ascending order, so an iterator only
+// moves forward and keeps reusing the index page it decoded for the previous key.
+class PrimaryKeyLookupCache {
+public:
+    Status get(const RowsetSharedPtr& rowset, uint32_t segment_id,
+               segment_v2::SegmentSharedPtr* segment,
+               segment_v2::IndexedColumnIterator** index_iterator) {
+        auto& entry = _entries[rowset->rowset_id()];
+        if (entry.segments.empty()) {
+            SegmentCacheHandle segment_cache_handle;
+            RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+                    std::static_pointer_cast<BetaRowset>(rowset), &segment_cache_handle, true));
+            entry.segments = segment_cache_handle.get_segments();
+            entry.index_iterators.resize(entry.segments.size());
+        }
+        DCHECK_GT(entry.segments.size(), segment_id);
+        auto& iter = entry.index_iterators[segment_id];
+        if (iter == nullptr) {
+            RETURN_NOT_OK(entry.segments[segment_id]->new_primary_key_index_iterator(&iter));
+        }
+        *segment = entry.segments[segment_id];
+        *index_iterator = iter.get();
+        return Status::OK();
+    }
+
+private:
+    struct Entry {
+        std::vector<segment_v2::SegmentSharedPtr> segments;
+        std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>> index_iterators;
+    };
+    std::unordered_map<RowsetId, Entry, HashOfRowsetId> _entries;
+};
+
+Status Tablet::_lookup_row_keys(const std::vector<Slice>& sorted_keys, uint32_t version,
+                                PrimaryKeyLookupCache* lookup_cache,
+                                std::vector<RowLocation>* row_locations, std::vector<bool>* found,
+                                std::vector<RowsetSharedPtr>* rowsets) {
+    row_locations->assign(sorted_keys.size(), RowLocation());
+    found->assign(sorted_keys.size(), false);
+    if (rowsets != nullptr) {
+        rowsets->assign(sorted_keys.size(), nullptr);
+    }
+    // Prune the segments by their key bounds with one batched query of the rowset tree.
+    std::vector<std::vector<std::pair<RowsetSharedPtr, int32_t>>> candidates(sorted_keys.size());
+    _rowset_tree->ForEachRowsetContainingKeys(
+            sorted_keys, [&](RowsetSharedPtr rowset, int32_t segment_id, int idx) {
+                if (rowset->end_version() < version) {
+                    candidates[idx].emplace_back(std::move(rowset), segment_id);
+                }
+            });
+    for (size_t i = 0; i < sorted_keys.size(); ++i) {
+        auto& selected_rs = candidates[i];
+        // The row in the rowset with the largest version is the visible one, rows of the
+        // same key in older rowsets were marked deleted when that rowset was published.
+        std::sort(selected_rs.begin(), selected_rs.end(),
+                  [](const std::pair<RowsetSharedPtr, int32_t>& a,
+                     const std::pair<RowsetSharedPtr, int32_t>& b) {
+                      return a.first->end_version() > b.first->end_version();
+                  });
+        for (auto& rs : selected_rs) {
+            segment_v2::SegmentSharedPtr segment;
+            segment_v2::IndexedColumnIterator* index_iterator = nullptr;
+            RETURN_NOT_OK(lookup_cache->get(rs.first, rs.second, &segment, &index_iterator));
+            RowLocation loc;
+            Status s = segment->lookup_row_key(sorted_keys[i], index_iterator, &loc);
+            if (s.is_not_found()) {
+                continue;
+            }
+            if (!s.ok()) {
+                return s;
+            }
+            loc.rowset_id = rs.first->rowset_id();
+            (*row_locations)[i] = loc;
+            (*found)[i] = true;
+            if (rowsets != nullptr) {
+                (*rowsets)[i] = rs.first;
+            }
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+Status Tablet::calc_delete_bitmap(const RowsetSharedPtr& rowset, DeleteBitmap* delete_bitmap) {
+    DCHECK(keys_type() == UNIQUE_KEYS && enable_unique_key_merge_on_write());
+    SegmentCacheHandle segment_cache_handle;
+    RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+            std::static_pointer_cast<BetaRowset>(rowset), &segment_cache_handle, true));
+    uint32_t version = rowset->end_version();
+    const auto* type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+    constexpr size_t batch_size = 4096;
+
+    std::shared_lock rdlock(_meta_lock);
+    PrimaryKeyLookupCache lookup_cache;
+    std::vector<Slice> keys;
+    std::vector<RowLocation> row_locations;
+    std::vector<bool> found;
+    MemPool pool;
+    for (auto& segment : segment_cache_handle.get_segments()) {
+        std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
+        RETURN_NOT_OK(segment->new_primary_key_index_iterator(&index_iterator));
+        std::unique_ptr<ColumnVectorBatch> cvb;
+        RETURN_NOT_OK(ColumnVectorBatch::create(batch_size + 1, false, type_info, nullptr, &cvb));
+        // The iterator must be seeked before each batch, so every batch but the first one
+        // seeks to the last key of the previous batch and skips it.
+        std::string last_key;
+        size_t skip = 0;
+        size_t remaining = segment->num_rows();
+        while (remaining > 0) {
+            Slice seek_key(last_key);
+            bool exact_match = false;
+            RETURN_NOT_OK(index_iterator->seek_at_or_after(&seek_key, &exact_match));
+            ColumnBlock block(cvb.get(), &pool);
+            ColumnBlockView column_block_view(&block);
+            size_t num_to_read = std::min(remaining, batch_size) + skip;
+            size_t num_read = num_to_read;
+            RETURN_NOT_OK(index_iterator->next_batch(&num_read, &column_block_view));
+            DCHECK_EQ(num_to_read, num_read);
+            const Slice* data = reinterpret_cast<const Slice*>(block.data());
+            keys.assign(data + skip, data + num_read);
+            remaining -= keys.size();
+
+            RETURN_NOT_OK(
+                    _lookup_row_keys(keys, version, &lookup_cache, &row_locations, &found));
+            for (size_t i = 0; i < keys.size(); ++i) {
+                if (found[i]) {
+                    auto& loc = row_locations[i];
+                    delete_bitmap->add({loc.rowset_id, loc.segment_id, version}, loc.row_id);
+                }
+            }
+            last_key = keys.back().to_string();
+            skip = 1;
+            pool.clear();
+        }
+    }
+    return Status::OK();
+}
+
+Status Tablet::read_columns_by_keys(const std::vector<Slice>& sorted_keys,
+                                    const TabletSchema& schema, const std::vector<uint32_t>& cids,
+                                    vectorized::MutableColumns* columns,
+                                    std::vector<bool>* found) {
+    DCHECK(keys_type() == UNIQUE_KEYS && enable_unique_key_merge_on_write());
+    DCHECK_EQ(cids.size(), columns->size());
+    PrimaryKeyLookupCache lookup_cache;
+    std::vector<RowLocation> row_locations;
+    std::vector<RowsetSharedPtr> rowsets;
+    {
+        std::shared_lock rdlock(_meta_lock);
+        uint32_t version = max_version().second + 1;
+        RETURN_NOT_OK(_lookup_row_keys(sorted_keys, version, &lookup_cache, &row_locations, found,
+                                       &rowsets));
+    }
+
+    // Read the rows of a segment in one batch in the order of their row ids, then put the
+    // values back in the order of the keys.
+    std::map<std::pair<RowsetId, uint32_t>, std::vector<std::pair<rowid_t, size_t>>> segment_rows;
+    for (size_t i = 0; i < sorted_keys.size(); ++i) {
+        if ((*found)[i]) {
+            const auto& loc = row_locations[i];
+            segment_rows[{loc.rowset_id, loc.segment_id}].emplace_back(loc.row_id, i);
+        }
+    }
+    std::vector<const TabletColumn*> tablet_columns;
+    for (auto cid : cids) {
+        tablet_columns.push_back(&schema.column(cid));
+    }
+    int32_t delete_sign_idx = schema.delete_sign_idx();
+    // the block of a segment, the position of its row of a key and whether it's deleted
+    std::vector<vectorized::Block> blocks;
+    std::vector<std::pair<size_t, size_t>> key_rows(sorted_keys.size());
+    std::vector<bool> deleted(sorted_keys.size(), false);
+    OlapReaderStatistics stats;
+    for (auto& [segment_key, rows] : segment_rows) {
+        std::sort(rows.begin(), rows.end());
+        std::vector<rowid_t> rowids;
+        for (size_t pos = 0; pos < rows.size(); ++pos) {
+            rowids.push_back(rows[pos].first);
+            key_rows[rows[pos].second] = {blocks.size(), pos};
+        }
+        segment_v2::SegmentSharedPtr segment;
+        segment_v2::IndexedColumnIterator* index_iterator = nullptr;
+        RETURN_NOT_OK(lookup_cache.get(rowsets[rows[0].second], segment_key.second, &segment,
+                                       &index_iterator));
+
+        vectorized::Block block = schema.create_block(cids);
+        auto read_columns = block.mutate_columns();
+        for (size_t i = 0; i < cids.size(); ++i) {
+            auto type = tablet_columns[i]->type();
+            if (type == OLAP_FIELD_TYPE_DATE) {
+                read_columns[i]->set_date_type();
+            } else if (type == OLAP_FIELD_TYPE_DATETIME) {
+                read_columns[i]->set_datetime_type();
+            } else if (type == OLAP_FIELD_TYPE_DATEV2) {
+                read_columns[i]->set_date_v2_type();
+            } else if (type == OLAP_FIELD_TYPE_DECIMAL) {
+                read_columns[i]->set_decimalv2_type();
+            }
+        }
+        Status st = Status::NotSupported("no row store");
+        if (segment->has_row_store()) {
+            std::vector<vectorized::IColumn*> dst;
+            for (auto& column : read_columns) {
+                dst.push_back(column.get());
+            }
+            st = segment->read_columns_from_row_store(tablet_columns, rowids.data(),
+                                                      rowids.size(), &stats, dst);
+        }
+        if (st.is_not_supported()) {
+            for (size_t i = 0; i < cids.size(); ++i) {
+                RETURN_NOT_OK(segment->read_column_by_rowids(
+                        *tablet_columns[i], rowids.data(), rowids.size(), &stats,
+                        read_columns[i]));
+            }
+        } else if (!st.ok()) {
+            return st;
+        }
+        if (delete_sign_idx >= 0) {
+            const TabletColumn& column = schema.column(delete_sign_idx);
+            auto delete_sign = vectorized::DataTypeFactory::instance()
+                                       .create_data_type(column)
+                                       ->create_column();
+            RETURN_NOT_OK(segment->read_column_by_rowids(column, rowids.data(), rowids.size(),
+                                                         &stats, delete_sign));
+            for (size_t pos = 0; pos < rows.size(); ++pos) {
+                deleted[rows[pos].second] = delete_sign->get_int(pos) != 0;
+            }
+        }
+        block.set_columns(std::move(read_columns));
+        blocks.push_back(std::move(block));
+    }
+
+    for (size_t i = 0; i < sorted_keys.size(); ++i) {
+        if ((*found)[i] && deleted[i]) {
+            (*found)[i] = false;
+        }
+        for (size_t j = 0; j < cids.size(); ++j) {
+            if ((*found)[i]) {
+                auto [block_idx, pos] = key_rows[i];
+                (*columns)[j]->insert_from(*blocks[block_idx].get_by_position(j).column, pos);
+            } else {
+                (*columns)[j]->insert_default();
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status Tablet::update_delete_bitmap(const RowsetSharedPtr& rowset) {
+    DeleteBitmap delete_bitmap(tablet_id());
+    RETURN_NOT_OK(calc_delete_bitmap(rowset, &delete_bitmap));
+    _tablet_meta->delete_bitmap().merge(delete_bitmap);
+    return Status::OK();
+}
+
 } // namespace doris
@@ -50,6 +50,8 @@ class CumulativeCompaction;
 class BaseCompaction;
 class RowsetWriter;
 struct RowsetWriterContext;
+class DeleteBitmap;
+class PrimaryKeyLookupCache;
 
 using TabletSharedPtr = std::shared_ptr<Tablet>;
 
@@ -255,6 +257,8 @@ public:
     void get_compaction_status(std::string* json_result);
 
     double calculate_scan_frequency();
+    // the scans per minute since the last record of calculate_scan_frequency(), without recording
+    double scan_frequency() const;
 
     Status prepare_compaction_and_calculate_permits(CompactionType compaction_type,
                                                     TabletSharedPtr tablet, int64_t* permits);
@@ -288,7 +292,8 @@ public:
     Status create_rowset_writer(const int64_t& txn_id, const PUniqueId& load_id,
                                 const RowsetStatePB& rowset_state, const SegmentsOverlapPB& overlap,
                                 const TabletSchema* tablet_schema,
-                                std::unique_ptr<RowsetWriter>* rowset_writer);
+                                std::unique_ptr<RowsetWriter>* rowset_writer,
+                                const std::vector<uint32_t>& partial_update_missing_cids = {});
 
     Status create_rowset(RowsetMetaSharedPtr rowset_meta, RowsetSharedPtr* rowset);
     // Cooldown to remote fs.
@@ -300,18 +305,56 @@ public:
 
     bool need_cooldown(int64_t* cooldown_timestamp, size_t* file_size);
 
+    // The local rowsets whose segments were linked by a schema change with index files still to
+    // be built, see IndexBuilder.
+    std::vector<RowsetSharedPtr> pick_rowsets_to_build_indexes();
+
     // Physically remove remote rowsets.
     void remove_all_remote_rowsets();
 
-    // Lookup the row location of `encoded_key`, the function sets `row_location` on success.
+    // Lookup the row location of `encoded_key`, the function sets `row_location` and, if it's
+    // not null, `rowset` on success.
     // NOTE: the method only works in unique key model with primary key index, you will got a
     //       not supported error in other data model.
-    Status lookup_row_key(const Slice& encoded_key, RowLocation* row_location, uint32_t version);
+    Status lookup_row_key(const Slice& encoded_key, RowLocation* row_location, uint32_t version,
+                          RowsetSharedPtr* rowset = nullptr);
+
+    // Read the columns `cids` of `schema` of the visible rows of `sorted_keys`, which are encoded
+    // primary keys in ascending order. A row is appended to each of `columns` for every key, the
+    // default value when the key isn't found or its row is deleted, with `found` set to false.
+    // It's used by partial updates to fill the columns a load doesn't carry.
+    // NOTE: only for unique key model with merge-on-write enabled.
+    Status read_columns_by_keys(const std::vector<Slice>& sorted_keys, const TabletSchema& schema,
+                                const std::vector<uint32_t>& cids,
+                                vectorized::MutableColumns* columns, std::vector<bool>* found);
+
+    // Compute the delete bitmap of `rowset`, which is being published and not yet added
+    // to the tablet: rows of the visible rowsets sharing a primary key with `rowset` are
+    // marked deleted at the version of `rowset` in `delete_bitmap`.
+    // NOTE: only for unique key model with merge-on-write enabled.
+    Status calc_delete_bitmap(const RowsetSharedPtr& rowset, DeleteBitmap* delete_bitmap);
+
+    // Compute the delete bitmap of `rowset` and merge it into the delete bitmap of the tablet.
+    Status update_delete_bitmap(const RowsetSharedPtr& rowset);
+
+    // Apply a light schema change adding or dropping value columns: the schema of the tablet
+    // becomes `columns` at `schema_version` without rewriting any rowset, and the segments
+    // lacking a column read its default value. A stale `schema_version` is ignored.
+    // NOTE: the caller should hold the header lock.
+    Status update_tablet_schema(const std::vector<TabletColumn>& columns, int32_t schema_version);
 
 private:
     Status _init_once_action();
+    const TabletSchema& _tablet_schema_unlocked() const;
     void _print_missed_versions(const std::vector<Version>& missed_versions) const;
     bool _contains_rowset(const RowsetId rowset_id);
+    // Lookup `sorted_keys` in the rowsets with version lower than `version`, the latest row
+    // of a found key is set in `row_locations` and, if it's not null, its rowset in `rowsets`,
+    // missing keys leave `found` false.
+    Status _lookup_row_keys(const std::vector<Slice>& sorted_keys, uint32_t version,
+                            PrimaryKeyLookupCache* lookup_cache,
+                            std::vector<RowLocation>* row_locations, std::vector<bool>* found,
+                            std::vector<RowsetSharedPtr>* rowsets = nullptr);
     Status _contains_version(const Version& version);
 
     // Returns:
@@ -333,6 +376,9 @@ private:
     // When the proportion of empty edges in the adjacency matrix used to represent the version graph
     // in the version tracker is greater than the threshold, rebuild the version tracker
     bool _reconstruct_version_tracker_if_necessary();
+    // Drop the delete bitmaps of the deleted rowsets and fold the bitmaps of the versions
+    // that can't be read any more into one bitmap per segment.
+    void _compact_delete_bitmap_unlocked(const std::vector<RowsetId>& deleted_rowset_ids);
     void _init_context_common_fields(RowsetWriterContext& context);
 
 public:
@@ -437,6 +483,7 @@ inline void Tablet::set_cumulative_layer_point(int64_t new_point) {
             << "Unexpected cumulative point: " << new_point
             << ", origin: " << _cumulative_point.load();
     _cumulative_point = new_point;
+    _mark_compaction_score_dirty();
 }
 
 inline bool Tablet::enable_unique_key_merge_on_write() const {
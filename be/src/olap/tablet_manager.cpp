@@ -214,7 +214,7 @@ Status TabletManager::_add_tablet_to_map_unlocked(TTabletId tablet_id,
 }
 
 bool TabletManager::check_tablet_id_exist(TTabletId tablet_id) {
-    std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
+    StripedSharedLock rdlock(_get_tablets_shard_lock(tablet_id));
     return _check_tablet_id_exist_unlocked(tablet_id);
 }
 
@@ -230,7 +230,7 @@ Status TabletManager::create_tablet(const TCreateTabletReq& request, std::vector
     int64_t tablet_id = request.tablet_id;
     LOG(INFO) << "begin to create tablet. tablet_id=" << tablet_id;
 
-    std::lock_guard<std::shared_mutex> wrlock(_get_tablets_shard_lock(tablet_id));
+    std::lock_guard<StripedSharedMutex> wrlock(_get_tablets_shard_lock(tablet_id));
     TRACE("got tablets shard lock");
     // Make create_tablet operation to be idempotent:
     // 1. Return true if tablet with same tablet_id and schema_hash exist;
@@ -427,7 +427,7 @@ TabletSharedPtr TabletManager::_create_tablet_meta_and_dir_unlocked(
 
 Status TabletManager::drop_tablet(TTabletId tablet_id, TReplicaId replica_id, bool keep_files) {
     auto& shard = _get_tablets_shard(tablet_id);
-    std::lock_guard wrlock(shard.lock);
+    std::lock_guard<StripedSharedMutex> wrlock(shard.lock);
     if (shard.tablets_under_clone.count(tablet_id) > 0) {
         LOG(INFO) << "tablet " << tablet_id << " is under clone, skip drop task";
         return Status::Aborted("aborted");
@@ -498,7 +498,7 @@ Status TabletManager::drop_tablets_on_error_root_path(
         if (local_tmp_vector[i].empty()) {
             continue;
         }
-        std::lock_guard<std::shared_mutex> wrlock(_tablets_shards[i].lock);
+        std::lock_guard<StripedSharedMutex> wrlock(_tablets_shards[i].lock);
         for (size_t idx : local_tmp_vector[i]) {
             const TabletInfo& tablet_info = tablet_info_vec[idx];
             TTabletId tablet_id = tablet_info.tablet_id;
@@ -519,7 +519,7 @@ Status TabletManager::drop_tablets_on_error_root_path(
 }
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, bool include_deleted, string* err) {
-    std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
+    StripedSharedLock rdlock(_get_tablets_shard_lock(tablet_id));
     return _get_tablet_unlocked(tablet_id, include_deleted, err);
 }
 
@@ -558,7 +558,7 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, bool in
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, TabletUid tablet_uid,
                                           bool include_deleted, string* err) {
-    std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
+    StripedSharedLock rdlock(_get_tablets_shard_lock(tablet_id));
     TabletSharedPtr tablet = _get_tablet_unlocked(tablet_id, include_deleted, err);
     if (tablet != nullptr && tablet->tablet_uid() == tablet_uid) {
         return tablet;
@@ -620,63 +620,50 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
     uint32_t compaction_score = 0;
     double tablet_scan_frequency = 0.0;
     TabletSharedPtr best_tablet;
-    for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rdlock(tablets_shard.lock);
-        for (const auto& tablet_map : tablets_shard.tablet_map) {
-            const TabletSharedPtr& tablet_ptr = tablet_map.second;
-            if (!tablet_ptr->can_do_compaction(data_dir->path_hash(), compaction_type)) {
-                continue;
-            }
-
-            auto search = tablet_submitted_compaction.find(tablet_ptr->tablet_id());
-            if (search != tablet_submitted_compaction.end()) {
-                continue;
-            }
-
-            int64_t last_failure_ms = tablet_ptr->last_cumu_compaction_failure_time();
-            if (compaction_type == CompactionType::BASE_COMPACTION) {
-                last_failure_ms = tablet_ptr->last_base_compaction_failure_time();
-            }
-            if (now_ms - last_failure_ms <= config::min_compaction_failure_interval_sec * 1000) {
-                VLOG_DEBUG << "Too often to check compaction, skip it. "
-                           << "compaction_type=" << compaction_type_str
-                           << ", last_failure_time_ms=" << last_failure_ms
-                           << ", tablet_id=" << tablet_ptr->tablet_id();
-                continue;
-            }
-
-            if (compaction_type == CompactionType::BASE_COMPACTION) {
-                std::unique_lock<std::mutex> lock(tablet_ptr->get_base_compaction_lock(),
-                                                  std::try_to_lock);
-                if (!lock.owns_lock()) {
-                    LOG(INFO) << "can not get base lock: " << tablet_ptr->tablet_id();
+    // the more queries on the disk suffer from slow I/O, the more the tablets they scan are
+    // preferred, since compacting them saves the most query I/O
+    double scan_frequency_factor =
+            config::compaction_tablet_scan_frequency_factor *
+            (1 + StorageEngine::instance()->compaction_io_scheduler()->query_io_pressure(data_dir));
+    // The scan frequencies change over time, so the tablets are only picked from the score index
+    // when they are not part of the score.
+    bool use_score_index = config::enable_compaction_score_index &&
+                           config::compaction_tablet_scan_frequency_factor == 0 &&
+                           config::compaction_tablet_compaction_score_factor > 0;
+    if (use_score_index) {
+        best_tablet = _find_best_tablet_by_score_index(
+                compaction_type, data_dir, tablet_submitted_compaction, now_ms, &compaction_score,
+                cumulative_compaction_policy);
+        highest_score = config::compaction_tablet_compaction_score_factor * compaction_score;
+    } else {
+        for (const auto& tablets_shard : _tablets_shards) {
+            for (const auto& tablet_ptr : _get_shard_tablets(tablets_shard)) {
+                if (!_can_pick_for_compaction(tablet_ptr, compaction_type, data_dir,
+                                              tablet_submitted_compaction, now_ms)) {
                     continue;
                 }
-            } else {
-                std::unique_lock<std::mutex> lock(tablet_ptr->get_cumulative_compaction_lock(),
-                                                  std::try_to_lock);
-                if (!lock.owns_lock()) {
-                    LOG(INFO) << "can not get cumu lock: " << tablet_ptr->tablet_id();
+                auto compaction_lock = _try_lock_compaction(tablet_ptr, compaction_type);
+                if (!compaction_lock.owns_lock()) {
                     continue;
                 }
-            }
 
-            uint32_t current_compaction_score = tablet_ptr->calc_compaction_score(
-                    compaction_type, cumulative_compaction_policy);
+                uint32_t current_compaction_score = tablet_ptr->calc_compaction_score(
+                        compaction_type, cumulative_compaction_policy);
 
-            double scan_frequency = 0.0;
-            if (config::compaction_tablet_scan_frequency_factor != 0) {
-                scan_frequency = tablet_ptr->calculate_scan_frequency();
-            }
+                double scan_frequency = 0.0;
+                if (config::compaction_tablet_scan_frequency_factor != 0) {
+                    scan_frequency = tablet_ptr->calculate_scan_frequency();
+                }
 
-            double tablet_score =
-                    config::compaction_tablet_scan_frequency_factor * scan_frequency +
-                    config::compaction_tablet_compaction_score_factor * current_compaction_score;
-            if (tablet_score > highest_score) {
-                highest_score = tablet_score;
-                compaction_score = current_compaction_score;
-                tablet_scan_frequency = scan_frequency;
-                best_tablet = tablet_ptr;
+                double tablet_score = scan_frequency_factor * scan_frequency +
+                                      config::compaction_tablet_compaction_score_factor *
+                                              current_compaction_score;
+                if (tablet_score > highest_score) {
+                    highest_score = tablet_score;
+                    compaction_score = current_compaction_score;
+                    tablet_scan_frequency = scan_frequency;
+                    best_tablet = tablet_ptr;
+                }
             }
         }
     }
@@ -693,6 +680,87 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
     return best_tablet;
 }
 
+TabletSharedPtr TabletManager::_find_best_tablet_by_score_index(
+        CompactionType compaction_type, DataDir* data_dir,
+        const std::unordered_set<TTabletId>& tablet_submitted_compaction, int64_t now_ms,
+        uint32_t* score, std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy) {
+    CompactionScoreIndex* index = data_dir->compaction_score_index(compaction_type);
+    for (TTabletId tablet_id : index->take_dirty()) {
+        TabletSharedPtr tablet = get_tablet(tablet_id);
+        // the tablet is dropped or moved to another dir
+        if (tablet == nullptr || tablet->data_dir() != data_dir) {
+            index->remove(tablet_id);
+            continue;
+        }
+        auto compaction_lock = _try_lock_compaction(tablet, compaction_type);
+        if (!compaction_lock.owns_lock()) {
+            // the score is computed again after the running compaction
+            index->mark_dirty(tablet_id);
+            continue;
+        }
+        index->update(tablet_id,
+                      tablet->calc_compaction_score(compaction_type, cumulative_compaction_policy));
+    }
+
+    CompactionScoreIndex::Entry entry = CompactionScoreIndex::BEGIN;
+    while (index->next_by_score(&entry)) {
+        TabletSharedPtr tablet = get_tablet(entry.second);
+        if (tablet == nullptr || tablet->data_dir() != data_dir ||
+            !_can_pick_for_compaction(tablet, compaction_type, data_dir,
+                                      tablet_submitted_compaction, now_ms)) {
+            continue;
+        }
+        if (!_try_lock_compaction(tablet, compaction_type).owns_lock()) {
+            continue;
+        }
+        *score = entry.first;
+        return tablet;
+    }
+    return nullptr;
+}
+
+bool TabletManager::_can_pick_for_compaction(
+        const TabletSharedPtr& tablet, CompactionType compaction_type, DataDir* data_dir,
+        const std::unordered_set<TTabletId>& tablet_submitted_compaction, int64_t now_ms) {
+    if (!tablet->can_do_compaction(data_dir->path_hash(), compaction_type)) {
+        return false;
+    }
+
+    if (tablet_submitted_compaction.count(tablet->tablet_id()) > 0) {
+        return false;
+    }
+
+    int64_t last_failure_ms = tablet->last_cumu_compaction_failure_time();
+    if (compaction_type == CompactionType::BASE_COMPACTION) {
+        last_failure_ms = tablet->last_base_compaction_failure_time();
+    }
+    if (now_ms - last_failure_ms <= config::min_compaction_failure_interval_sec * 1000) {
+        VLOG_DEBUG << "Too often to check compaction, skip it. "
+                   << "compaction_type="
+                   << (compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative")
+                   << ", last_failure_time_ms=" << last_failure_ms
+                   << ", tablet_id=" << tablet->tablet_id();
+        return false;
+    }
+    return true;
+}
+
+std::unique_lock<std::mutex> TabletManager::_try_lock_compaction(const TabletSharedPtr& tablet,
+                                                                  CompactionType compaction_type) {
+    if (compaction_type == CompactionType::BASE_COMPACTION) {
+        std::unique_lock<std::mutex> lock(tablet->get_base_compaction_lock(), std::try_to_lock);
+        if (!lock.owns_lock()) {
+            LOG(INFO) << "can not get base lock: " << tablet->tablet_id();
+        }
+        return lock;
+    }
+    std::unique_lock<std::mutex> lock(tablet->get_cumulative_compaction_lock(), std::try_to_lock);
+    if (!lock.owns_lock()) {
+        LOG(INFO) << "can not get cumu lock: " << tablet->tablet_id();
+    }
+    return lock;
+}
+
 Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_id,
                                             TSchemaHash schema_hash, const string& meta_binary,
                                             bool update_meta, bool force, bool restore,
@@ -770,7 +838,7 @@ Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_
     RETURN_NOT_OK_LOG(tablet->init(),
                       strings::Substitute("tablet init failed. tablet=$0", tablet->full_name()));
 
-    std::lock_guard<std::shared_mutex> wrlock(_get_tablets_shard_lock(tablet_id));
+    std::lock_guard<StripedSharedMutex> wrlock(_get_tablets_shard_lock(tablet_id));
     RETURN_NOT_OK_LOG(_add_tablet_unlocked(tablet_id, tablet, update_meta, force),
                       strings::Substitute("fail to add tablet. tablet=$0", tablet->full_name()));
 
@@ -852,10 +920,8 @@ Status TabletManager::build_all_report_tablets_info(std::map<TTabletId, TTablet>
     HistogramStat tablet_version_num_hist;
     auto local_cache = std::make_shared<std::vector<TTabletStat>>();
     for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rdlock(tablets_shard.lock);
-        for (const auto& item : tablets_shard.tablet_map) {
-            uint64_t tablet_id = item.first;
-            TabletSharedPtr tablet_ptr = item.second;
+        for (const auto& tablet_ptr : _get_shard_tablets(tablets_shard)) {
+            uint64_t tablet_id = tablet_ptr->tablet_id();
             TTablet t_tablet;
             TTabletInfo tablet_info;
             tablet_ptr->build_tablet_report_info(&tablet_info, true);
@@ -891,22 +957,11 @@ Status TabletManager::build_all_report_tablets_info(std::map<TTabletId, TTablet>
 Status TabletManager::start_trash_sweep() {
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
     {
-        std::vector<TabletSharedPtr>
-                all_tablets; // we use this vector to save all tablet ptr for saving lock time.
         for (auto& tablets_shard : _tablets_shards) {
-            tablet_map_t& tablet_map = tablets_shard.tablet_map;
-            {
-                std::shared_lock rdlock(tablets_shard.lock);
-                for (auto& item : tablet_map) {
-                    // try to clean empty item
-                    all_tablets.push_back(item.second);
-                }
-            }
             // Avoid hold the shard lock too long, so we get tablet to a vector and clean here
-            for (const auto& tablet : all_tablets) {
+            for (const auto& tablet : _get_shard_tablets(tablets_shard)) {
                 tablet->delete_expired_stale_rowset();
             }
-            all_tablets.clear();
         }
     }
 
@@ -919,6 +974,8 @@ Status TabletManager::start_trash_sweep() {
         // should get write lock here, because it will remove tablet from shut_down_tablets
         // and get tablet will access shut_down_tablets
         std::lock_guard<std::shared_mutex> wrlock(_shutdown_tablets_lock);
+        std::unordered_map<const Tablet*, TabletMetaSharedPtr> tablet_metas;
+        _get_shutdown_tablet_metas(&tablet_metas);
         auto it = _shutdown_tablets.begin();
         while (it != _shutdown_tablets.end()) {
             // check if the meta has the tablet info and its state is shutdown
@@ -927,9 +984,19 @@ Status TabletManager::start_trash_sweep() {
                 ++it;
                 continue;
             }
-            TabletMetaSharedPtr tablet_meta(new TabletMeta());
-            Status check_st = TabletMetaManager::get_meta((*it)->data_dir(), (*it)->tablet_id(),
-                                                          (*it)->schema_hash(), tablet_meta);
+            TabletMetaSharedPtr tablet_meta;
+            Status check_st;
+            auto meta_it = tablet_metas.find(it->get());
+            if (meta_it != tablet_metas.end()) {
+                tablet_meta = meta_it->second;
+                check_st = tablet_meta != nullptr
+                                   ? Status::OK()
+                                   : Status::OLAPInternalError(OLAP_ERR_META_KEY_NOT_FOUND);
+            } else {
+                tablet_meta.reset(new TabletMeta());
+                check_st = TabletMetaManager::get_meta((*it)->data_dir(), (*it)->tablet_id(),
+                                                       (*it)->schema_hash(), tablet_meta);
+            }
             if (check_st.ok()) {
                 if (tablet_meta->tablet_state() != TABLET_SHUTDOWN ||
                     tablet_meta->tablet_uid() != (*it)->tablet_uid()) {
@@ -993,15 +1060,37 @@ Status TabletManager::start_trash_sweep() {
     return Status::OK();
 } // start_trash_sweep
 
+void TabletManager::_get_shutdown_tablet_metas(
+        std::unordered_map<const Tablet*, TabletMetaSharedPtr>* tablet_metas) {
+    std::map<DataDir*, std::vector<const Tablet*>> dir_tablets;
+    for (const auto& tablet : _shutdown_tablets) {
+        if (tablet.use_count() == 1) {
+            dir_tablets[tablet->data_dir()].push_back(tablet.get());
+        }
+    }
+    for (const auto& [data_dir, tablets] : dir_tablets) {
+        std::vector<std::pair<TTabletId, TSchemaHash>> keys;
+        keys.reserve(tablets.size());
+        for (const auto* tablet : tablets) {
+            keys.emplace_back(tablet->tablet_id(), tablet->schema_hash());
+        }
+        std::vector<TabletMetaSharedPtr> metas;
+        TabletMetaManager::get_metas(data_dir, keys, &metas);
+        for (size_t i = 0; i < tablets.size(); ++i) {
+            tablet_metas->emplace(tablets[i], std::move(metas[i]));
+        }
+    }
+}
+
 void TabletManager::register_clone_tablet(int64_t tablet_id) {
     tablets_shard& shard = _get_tablets_shard(tablet_id);
-    std::lock_guard<std::shared_mutex> wrlock(shard.lock);
+    std::lock_guard<StripedSharedMutex> wrlock(shard.lock);
     shard.tablets_under_clone.insert(tablet_id);
 }
 
 void TabletManager::unregister_clone_tablet(int64_t tablet_id) {
     tablets_shard& shard = _get_tablets_shard(tablet_id);
-    std::lock_guard<std::shared_mutex> wrlock(shard.lock);
+    std::lock_guard<StripedSharedMutex> wrlock(shard.lock);
     shard.tablets_under_clone.erase(tablet_id);
 }
 
@@ -1012,7 +1101,7 @@ void TabletManager::try_delete_unused_tablet_path(DataDir* data_dir, TTabletId t
     // acquire the read lock, so that there is no creating tablet or load tablet from meta tasks
     // create tablet and load tablet task should check whether the dir exists
     tablets_shard& shard = _get_tablets_shard(tablet_id);
-    std::shared_lock rdlock(shard.lock);
+    StripedSharedLock rdlock(shard.lock);
 
     // check if meta already exists
     TabletMetaSharedPtr tablet_meta(new TabletMeta());
@@ -1045,9 +1134,7 @@ void TabletManager::update_root_path_info(std::map<string, DataDirInfo>* path_ma
     DCHECK(tablet_count);
     *tablet_count = 0;
     for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rdlock(tablets_shard.lock);
-        for (const auto& item : tablets_shard.tablet_map) {
-            TabletSharedPtr tablet = item.second;
+        for (const auto& tablet : _get_shard_tablets(tablets_shard)) {
             ++(*tablet_count);
             auto iter = path_map->find(tablet->data_dir()->path());
             if (iter == path_map->end()) {
@@ -1063,7 +1150,7 @@ void TabletManager::update_root_path_info(std::map<string, DataDirInfo>* path_ma
 
 void TabletManager::get_partition_related_tablets(int64_t partition_id,
                                                   std::set<TabletInfo>* tablet_infos) {
-    std::shared_lock rdlock(_partition_tablet_map_lock);
+    StripedSharedLock rdlock(_partition_tablet_map_lock);
     if (_partition_tablet_map.find(partition_id) != _partition_tablet_map.end()) {
         *tablet_infos = _partition_tablet_map[partition_id];
     }
@@ -1074,9 +1161,7 @@ void TabletManager::do_tablet_meta_checkpoint(DataDir* data_dir) {
     std::vector<TabletSharedPtr> related_tablets;
     {
         for (auto& tablets_shard : _tablets_shards) {
-            std::shared_lock rdlock(tablets_shard.lock);
-            for (auto& item : tablets_shard.tablet_map) {
-                TabletSharedPtr& tablet_ptr = item.second;
+            for (const auto& tablet_ptr : _get_shard_tablets(tablets_shard)) {
                 if (tablet_ptr->tablet_state() != TABLET_RUNNING) {
                     continue;
                 }
@@ -1169,12 +1254,12 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id) {
 }
 
 void TabletManager::_add_tablet_to_partition(const TabletSharedPtr& tablet) {
-    std::lock_guard<std::shared_mutex> wrlock(_partition_tablet_map_lock);
+    std::lock_guard<StripedSharedMutex> wrlock(_partition_tablet_map_lock);
     _partition_tablet_map[tablet->partition_id()].insert(tablet->get_tablet_info());
 }
 
 void TabletManager::_remove_tablet_from_partition(const TabletSharedPtr& tablet) {
-    std::lock_guard<std::shared_mutex> wrlock(_partition_tablet_map_lock);
+    std::lock_guard<StripedSharedMutex> wrlock(_partition_tablet_map_lock);
     _partition_tablet_map[tablet->partition_id()].erase(tablet->get_tablet_info());
     if (_partition_tablet_map[tablet->partition_id()].empty()) {
         _partition_tablet_map.erase(tablet->partition_id());
@@ -1184,7 +1269,7 @@ void TabletManager::_remove_tablet_from_partition(const TabletSharedPtr& tablet)
 void TabletManager::obtain_specific_quantity_tablets(vector<TabletInfo>& tablets_info,
                                                      int64_t num) {
     for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rdlock(tablets_shard.lock);
+        StripedSharedLock rdlock(tablets_shard.lock);
         for (const auto& item : tablets_shard.tablet_map) {
             TabletSharedPtr tablet = item.second;
             if (tablets_info.size() >= num) {
@@ -1198,7 +1283,7 @@ void TabletManager::obtain_specific_quantity_tablets(vector<TabletInfo>& tablets
     }
 }
 
-std::shared_mutex& TabletManager::_get_tablets_shard_lock(TTabletId tabletId) {
+StripedSharedMutex& TabletManager::_get_tablets_shard_lock(TTabletId tabletId) {
     return _get_tablets_shard(tabletId).lock;
 }
 
@@ -1210,6 +1295,16 @@ TabletManager::tablets_shard& TabletManager::_get_tablets_shard(TTabletId tablet
     return _tablets_shards[tabletId & _tablets_shards_mask];
 }
 
+std::vector<TabletSharedPtr> TabletManager::_get_shard_tablets(const tablets_shard& shard) {
+    std::vector<TabletSharedPtr> tablets;
+    StripedSharedLock rdlock(shard.lock);
+    tablets.reserve(shard.tablet_map.size());
+    for (const auto& item : shard.tablet_map) {
+        tablets.push_back(item.second);
+    }
+    return tablets;
+}
+
 void TabletManager::get_tablets_distribution_on_different_disks(
         std::map<int64_t, std::map<DataDir*, int64_t>>& tablets_num_on_disk,
         std::map<int64_t, std::map<DataDir*, std::vector<TabletSize>>>& tablets_info_on_disk) {
@@ -1219,7 +1314,7 @@ void TabletManager::get_tablets_distribution_on_different_disks(
         // When drop tablet, '_partition_tablet_map_lock' is locked in 'tablet_shard_lock'.
         // To avoid locking 'tablet_shard_lock' in '_partition_tablet_map_lock', we lock and
         // copy _partition_tablet_map here.
-        std::shared_lock rdlock(_partition_tablet_map_lock);
+        StripedSharedLock rdlock(_partition_tablet_map_lock);
         partition_tablet_map = _partition_tablet_map;
     }
     std::map<int64_t, std::set<TabletInfo>>::iterator partition_iter = partition_tablet_map.begin();
@@ -1260,9 +1355,7 @@ struct SortCtx {
 void TabletManager::get_cooldown_tablets(std::vector<TabletSharedPtr>* tablets) {
     std::vector<SortCtx> sort_ctx_vec;
     for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rdlock(tablets_shard.lock);
-        for (const auto& item : tablets_shard.tablet_map) {
-            const TabletSharedPtr& tablet = item.second;
+        for (const auto& tablet : _get_shard_tablets(tablets_shard)) {
             int64_t cooldown_timestamp = -1;
             size_t file_size = -1;
             if (tablet->need_cooldown(&cooldown_timestamp, &file_size)) {
@@ -1293,10 +1386,21 @@ void TabletManager::get_cooldown_tablets(std::vector<TabletSharedPtr>* tablets)
     }
 }
 
+void TabletManager::get_tablets_to_build_indexes(std::vector<TabletSharedPtr>* tablets) {
+    for (const auto& tablets_shard : _tablets_shards) {
+        for (const auto& tablet : _get_shard_tablets(tablets_shard)) {
+            if (tablet->tablet_state() == TABLET_RUNNING &&
+                !tablet->pick_rowsets_to_build_indexes().empty()) {
+                tablets->push_back(tablet);
+            }
+        }
+    }
+}
+
 void TabletManager::get_all_tablets_storage_format(TCheckStorageFormatResult* result) {
     DCHECK(result != nullptr);
     for (const auto& tablets_shard : _tablets_shards) {
-        std::shared_lock rdlock(tablets_shard.lock);
+        StripedSharedLock rdlock(tablets_shard.lock);
         for (const auto& item : tablets_shard.tablet_map) {
             uint64_t tablet_id = item.first;
             if (item.second->all_beta()) {
@@ -36,6 +36,7 @@
 #include "olap/olap_meta.h"
 #include "olap/options.h"
 #include "olap/tablet.h"
+#include "util/striped_shared_mutex.h"
 
 namespace doris {
 
@@ -139,6 +140,8 @@ public:
             std::map<int64_t, std::map<DataDir*, std::vector<TabletSize>>>& tablets_info_on_disk);
     void get_cooldown_tablets(std::vector<TabletSharedPtr>* tables);
 
+    void get_tablets_to_build_indexes(std::vector<TabletSharedPtr>* tablets);
+
     void get_all_tablets_storage_format(TCheckStorageFormatResult* result);
 
 private:
@@ -179,7 +182,24 @@ private:
 
     void _remove_tablet_from_partition(const TabletSharedPtr& tablet);
 
-    std::shared_mutex& _get_tablets_shard_lock(TTabletId tabletId);
+    StripedSharedMutex& _get_tablets_shard_lock(TTabletId tabletId);
+
+    // Picks the tablet of the highest compaction score of the dir from its score index, after
+    // computing the scores of the tablets that changed since the last pick.
+    TabletSharedPtr _find_best_tablet_by_score_index(
+            CompactionType compaction_type, DataDir* data_dir,
+            const std::unordered_set<TTabletId>& tablet_submitted_compaction, int64_t now_ms,
+            uint32_t* score,
+            std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy);
+
+    bool _can_pick_for_compaction(const TabletSharedPtr& tablet, CompactionType compaction_type,
+                                  DataDir* data_dir,
+                                  const std::unordered_set<TTabletId>& tablet_submitted_compaction,
+                                  int64_t now_ms);
+
+    // The lock of the compaction of the type of the tablet, if it is not held by another thread.
+    static std::unique_lock<std::mutex> _try_lock_compaction(const TabletSharedPtr& tablet,
+                                                             CompactionType compaction_type);
 
 private:
     DISALLOW_COPY_AND_ASSIGN(TabletManager);
@@ -192,8 +212,9 @@ private:
             tablet_map = std::move(shard.tablet_map);
             tablets_under_clone = std::move(shard.tablets_under_clone);
         }
-        // protect tablet_map, tablets_under_clone and tablets_under_restore
-        mutable std::shared_mutex lock;
+        // protect tablet_map, tablets_under_clone and tablets_under_restore. It is read on every
+        // tablet lookup of the queries, so it is striped to keep the readers from contending.
+        mutable StripedSharedMutex lock;
         tablet_map_t tablet_map;
         std::set<int64_t> tablets_under_clone;
     };
@@ -206,7 +227,7 @@ private:
     std::vector<tablets_shard> _tablets_shards;
 
     // Protect _partition_tablet_map, should not be obtained before _tablet_map_lock to avoid dead lock
-    std::shared_mutex _partition_tablet_map_lock;
+    StripedSharedMutex _partition_tablet_map_lock;
     // Protect _shutdown_tablets, should not be obtained before _tablet_map_lock to avoid dead lock
     std::shared_mutex _shutdown_tablets_lock;
     // partition_id => tablet_info
@@ -220,6 +241,14 @@ private:
     tablet_map_t& _get_tablet_map(TTabletId tablet_id);
 
     tablets_shard& _get_tablets_shard(TTabletId tabletId);
+
+    // The tablets of the shard, copied under its lock so that the tasks going through all the
+    // tablets don't hold the lock, and block the writers and the readers behind them, meanwhile.
+    std::vector<TabletSharedPtr> _get_shard_tablets(const tablets_shard& shard);
+    // reads the metas of the unreferenced shutdown tablets by one multi get per data dir, the
+    // caller should hold _shutdown_tablets_lock
+    void _get_shutdown_tablet_metas(
+            std::unordered_map<const Tablet*, TabletMetaSharedPtr>* tablet_metas);
 };
 
 } // namespace doris
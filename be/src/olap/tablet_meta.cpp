@@ -166,6 +166,29 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
                     DCHECK_EQ(index.columns.size(), 1);
                     if (iequal(tcolumn.column_name, index.columns[0])) {
                         column->set_has_bitmap_index(true);
+                        auto it = index.properties.find("encoding");
+                        column->set_bit_sliced_bitmap_index(it != index.properties.end() &&
+                                                            it->second == "bit_sliced");
+                        break;
+                    }
+                } else if (index.index_type == TIndexType::type::INVERTED) {
+                    DCHECK_EQ(index.columns.size(), 1);
+                    if (iequal(tcolumn.column_name, index.columns[0])) {
+                        // the defaults of the FE, for the indexes created without properties
+                        auto it = index.properties.find("parser");
+                        column->set_inverted_index_parser(
+                                it != index.properties.end() ? it->second : "unicode");
+                        it = index.properties.find("gram_size");
+                        column->set_inverted_index_gram_size(
+                                it != index.properties.end() ? std::atoi(it->second.c_str()) : 3);
+                        break;
+                    }
+                } else if (index.index_type == TIndexType::type::NGRAM_BF) {
+                    DCHECK_EQ(index.columns.size(), 1);
+                    if (iequal(tcolumn.column_name, index.columns[0])) {
+                        auto it = index.properties.find("gram_size");
+                        column->set_ngram_bf_gram_size(
+                                it != index.properties.end() ? std::atoi(it->second.c_str()) : 3);
                         break;
                     }
                 }
@@ -186,6 +209,10 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
         schema->set_delete_sign_idx(tablet_schema.delete_sign_idx);
     }
 
+    if (tablet_schema.__isset.row_store_col_idx) {
+        schema->set_row_store_col_idx(tablet_schema.row_store_col_idx);
+    }
+
     init_from_pb(tablet_meta_pb);
 }
 
@@ -869,6 +896,36 @@ void DeleteBitmap::merge(const DeleteBitmap& other) {
     }
 }
 
+size_t DeleteBitmap::compact(Version version) {
+    std::lock_guard l(lock);
+    size_t num_folded = 0;
+    for (auto it = delete_bitmap.begin(); it != delete_bitmap.end();) {
+        auto& [rowset_id, segment_id, ver] = it->first;
+        if (ver > version) {
+            ++it;
+            continue;
+        }
+        // the bitmaps of a segment are ordered by version, find the last one to fold
+        auto last = it;
+        for (auto next = std::next(it); next != delete_bitmap.end(); ++next) {
+            auto& [next_rowset_id, next_segment_id, next_ver] = next->first;
+            if (next_rowset_id != rowset_id || next_segment_id != segment_id ||
+                next_ver > version) {
+                break;
+            }
+            last = next;
+        }
+        for (auto fold = it; fold != last; ++fold) {
+            last->second |= fold->second;
+            ++num_folded;
+        }
+        auto first = it;
+        it = std::next(last);
+        delete_bitmap.erase(first, last);
+    }
+    return num_folded;
+}
+
 // We cannot just copy the underlying memory to construct a string
 // due to equivalent objects may have different padding bytes.
 // Reading padding bytes is undefined behavior, neither copy nor
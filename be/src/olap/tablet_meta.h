@@ -148,6 +148,9 @@ public:
     const TabletSchema& tablet_schema() const;
 
     TabletSchema* mutable_tablet_schema();
+    // Replace the schema by the newer one of a light schema change. The replaced schema is kept
+    // alive, as the tablet and its readers may still refer to it.
+    void update_tablet_schema(const TabletSchema& tablet_schema);
 
     const std::vector<RowsetMetaSharedPtr>& all_rs_metas() const;
     std::vector<RowsetMetaSharedPtr>& all_mutable_rs_metas();
@@ -227,6 +230,7 @@ private:
     // the reference of _schema may use in tablet, so here need keep
     // the lifetime of tablemeta and _schema is same with tablet
     std::shared_ptr<TabletSchema> _schema;
+    std::vector<std::shared_ptr<TabletSchema>> _replaced_schemas;
 
     std::vector<RowsetMetaSharedPtr> _rs_metas;
     // This variable _stale_rs_metas is used to record these rowsets‘ meta which are be compacted.
@@ -363,6 +367,16 @@ public:
      */
     void merge(const DeleteBitmap& other);
 
+    /**
+     * Folds the bitmaps of each segment with Version <= the given version into one
+     * cumulative bitmap, keyed by the largest folded version. Aggregated bitmaps
+     * of versions >= the given version are unchanged, so the version must not be
+     * greater than the lowest version that can still be read.
+     *
+     * @return the number of bitmaps folded away
+     */
+    size_t compact(Version version);
+
     /**
      * Checks if the given row is marked deleted in bitmap with the condition:
      * all the bitmaps that
@@ -524,6 +538,11 @@ inline TabletSchema* TabletMeta::mutable_tablet_schema() {
     return _schema.get();
 }
 
+inline void TabletMeta::update_tablet_schema(const TabletSchema& tablet_schema) {
+    _replaced_schemas.push_back(std::move(_schema));
+    _schema = std::make_shared<TabletSchema>(tablet_schema);
+}
+
 inline const std::vector<RowsetMetaSharedPtr>& TabletMeta::all_rs_metas() const {
     return _rs_metas;
 }
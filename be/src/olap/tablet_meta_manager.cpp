@@ -69,6 +69,31 @@ Status TabletMetaManager::get_meta(DataDir* store, TTabletId tablet_id, TSchemaH
     return tablet_meta->deserialize(value);
 }
 
+void TabletMetaManager::get_metas(DataDir* store,
+                                  const std::vector<std::pair<TTabletId, TSchemaHash>>& tablets,
+                                  std::vector<TabletMetaSharedPtr>* tablet_metas) {
+    std::vector<std::string> keys;
+    keys.reserve(tablets.size());
+    for (const auto& [tablet_id, schema_hash] : tablets) {
+        keys.push_back(fmt::format("{}{}_{}", HEADER_PREFIX, tablet_id, schema_hash));
+    }
+    std::vector<std::string> values;
+    std::vector<Status> statuses;
+    store->get_meta()->multi_get(META_COLUMN_FAMILY_INDEX, keys, &values, &statuses);
+    tablet_metas->assign(tablets.size(), nullptr);
+    for (size_t i = 0; i < tablets.size(); ++i) {
+        if (!statuses[i].ok()) {
+            LOG(WARNING) << "load tablet_id:" << tablets[i].first
+                         << ", schema_hash:" << tablets[i].second << " failed.";
+            continue;
+        }
+        TabletMetaSharedPtr tablet_meta(new TabletMeta());
+        if (tablet_meta->deserialize(values[i]).ok()) {
+            (*tablet_metas)[i] = std::move(tablet_meta);
+        }
+    }
+}
+
 Status TabletMetaManager::get_json_meta(DataDir* store, TTabletId tablet_id,
                                         TSchemaHash schema_hash, std::string* json_meta) {
     TabletMetaSharedPtr tablet_meta(new TabletMeta());
@@ -35,6 +35,12 @@ public:
     static Status get_meta(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash,
                            TabletMetaSharedPtr tablet_meta);
 
+    // Gets the metas of the tablets in one batch. The meta of a tablet is null if it is not found
+    // or cannot be parsed.
+    static void get_metas(DataDir* store,
+                          const std::vector<std::pair<TTabletId, TSchemaHash>>& tablets,
+                          std::vector<TabletMetaSharedPtr>* tablet_metas);
+
     static Status get_json_meta(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash,
                                 std::string* json_meta);
 
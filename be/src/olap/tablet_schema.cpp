@@ -376,6 +376,10 @@ void TabletColumn::init_from_pb(const ColumnPB& column) {
     } else {
         _has_bitmap_index = false;
     }
+    _bit_sliced_bitmap_index = column.bit_sliced_bitmap_index();
+    _inverted_index_parser = column.inverted_index_parser();
+    _inverted_index_gram_size = column.inverted_index_gram_size();
+    _ngram_bf_gram_size = column.ngram_bf_gram_size();
     _has_referenced_column = column.has_referenced_column_id();
     if (_has_referenced_column) {
         _referenced_column_id = column.referenced_column_id();
@@ -419,6 +423,16 @@ void TabletColumn::to_schema_pb(ColumnPB* column) const {
     if (_has_bitmap_index) {
         column->set_has_bitmap_index(_has_bitmap_index);
     }
+    if (_bit_sliced_bitmap_index) {
+        column->set_bit_sliced_bitmap_index(_bit_sliced_bitmap_index);
+    }
+    if (!_inverted_index_parser.empty()) {
+        column->set_inverted_index_parser(_inverted_index_parser);
+        column->set_inverted_index_gram_size(_inverted_index_gram_size);
+    }
+    if (_ngram_bf_gram_size > 0) {
+        column->set_ngram_bf_gram_size(_ngram_bf_gram_size);
+    }
     column->set_visible(_visible);
 
     if (_type == OLAP_FIELD_TYPE_ARRAY) {
@@ -481,6 +495,27 @@ void TabletSchema::clear_columns() {
     _cols.clear();
 }
 
+void TabletSchema::update_columns(const std::vector<TabletColumn>& columns,
+                                  int32_t schema_version) {
+    auto unique_id_at = [this](int32_t cid) { return cid < 0 ? -1 : _cols[cid].unique_id(); };
+    int32_t delete_sign_unique_id = unique_id_at(_delete_sign_idx);
+    int32_t sequence_col_unique_id = unique_id_at(_sequence_col_idx);
+    int32_t row_store_col_unique_id = unique_id_at(_row_store_col_idx);
+    clear_columns();
+    for (const auto& column : columns) {
+        append_column(column);
+        _next_column_unique_id =
+                std::max<uint32_t>(_next_column_unique_id, column.unique_id() + 1);
+    }
+    auto index_of = [this](int32_t unique_id) {
+        return unique_id < 0 ? -1 : field_index(unique_id);
+    };
+    _delete_sign_idx = index_of(delete_sign_unique_id);
+    _sequence_col_idx = index_of(sequence_col_unique_id);
+    _row_store_col_idx = index_of(row_store_col_unique_id);
+    _schema_version = schema_version;
+}
+
 void TabletSchema::init_from_pb(const TabletSchemaPB& schema) {
     _keys_type = schema.keys_type();
     _num_columns = 0;
@@ -516,6 +551,7 @@ void TabletSchema::init_from_pb(const TabletSchemaPB& schema) {
     _is_in_memory = schema.is_in_memory();
     _delete_sign_idx = schema.delete_sign_idx();
     _sequence_col_idx = schema.sequence_col_idx();
+    _row_store_col_idx = schema.row_store_col_idx();
     _sort_type = schema.sort_type();
     _sort_col_num = schema.sort_col_num();
     _compression_type = schema.compression_type();
@@ -536,6 +572,7 @@ void TabletSchema::build_current_tablet_schema(int64_t index_id,
     _is_in_memory = ori_tablet_schema.is_in_memory();
     _delete_sign_idx = ori_tablet_schema.delete_sign_idx();
     _sequence_col_idx = ori_tablet_schema.sequence_col_idx();
+    _row_store_col_idx = ori_tablet_schema.row_store_col_idx();
     _sort_type = ori_tablet_schema.sort_type();
     _sort_col_num = ori_tablet_schema.sort_col_num();
 
@@ -596,6 +633,7 @@ void TabletSchema::to_schema_pb(TabletSchemaPB* tablet_schema_pb) const {
     tablet_schema_pb->set_is_in_memory(_is_in_memory);
     tablet_schema_pb->set_delete_sign_idx(_delete_sign_idx);
     tablet_schema_pb->set_sequence_col_idx(_sequence_col_idx);
+    tablet_schema_pb->set_row_store_col_idx(_row_store_col_idx);
     tablet_schema_pb->set_sort_type(_sort_type);
     tablet_schema_pb->set_sort_col_num(_sort_col_num);
     tablet_schema_pb->set_schema_version(_schema_version);
@@ -701,6 +739,10 @@ bool operator==(const TabletColumn& a, const TabletColumn& b) {
         if (a._referenced_column != b._referenced_column) return false;
     }
     if (a._has_bitmap_index != b._has_bitmap_index) return false;
+    if (a._bit_sliced_bitmap_index != b._bit_sliced_bitmap_index) return false;
+    if (a._inverted_index_parser != b._inverted_index_parser) return false;
+    if (a._inverted_index_gram_size != b._inverted_index_gram_size) return false;
+    if (a._ngram_bf_gram_size != b._ngram_bf_gram_size) return false;
     return true;
 }
 
@@ -727,6 +769,7 @@ bool operator==(const TabletSchema& a, const TabletSchema& b) {
     }
     if (a._is_in_memory != b._is_in_memory) return false;
     if (a._delete_sign_idx != b._delete_sign_idx) return false;
+    if (a._row_store_col_idx != b._row_store_col_idx) return false;
     return true;
 }
 
@@ -55,6 +55,11 @@ public:
     bool is_nullable() const { return _is_nullable; }
     bool is_bf_column() const { return _is_bf_column; }
     bool has_bitmap_index() const { return _has_bitmap_index; }
+    bool bit_sliced_bitmap_index() const { return _bit_sliced_bitmap_index; }
+    bool has_inverted_index() const { return !_inverted_index_parser.empty(); }
+    const std::string& inverted_index_parser() const { return _inverted_index_parser; }
+    int32_t inverted_index_gram_size() const { return _inverted_index_gram_size; }
+    int32_t ngram_bf_gram_size() const { return _ngram_bf_gram_size; }
     bool is_length_variable_type() const {
         return _type == OLAP_FIELD_TYPE_CHAR || _type == OLAP_FIELD_TYPE_VARCHAR ||
                _type == OLAP_FIELD_TYPE_STRING || _type == OLAP_FIELD_TYPE_HLL ||
@@ -114,6 +119,13 @@ private:
     std::string _referenced_column;
 
     bool _has_bitmap_index = false;
+    // whether the bitmap index is bit-sliced instead of one bitmap per value
+    bool _bit_sliced_bitmap_index = false;
+    // the parser of the inverted index, empty if the column has no inverted index
+    std::string _inverted_index_parser;
+    int32_t _inverted_index_gram_size = 0;
+    // the length of the substrings of the ngram bloom filter index, 0 for no index
+    int32_t _ngram_bf_gram_size = 0;
     bool _visible = true;
 
     TabletColumn* _parent = nullptr;
@@ -158,10 +170,15 @@ public:
     void set_delete_sign_idx(int32_t delete_sign_idx) { _delete_sign_idx = delete_sign_idx; }
     bool has_sequence_col() const { return _sequence_col_idx != -1; }
     int32_t sequence_col_idx() const { return _sequence_col_idx; }
+    bool has_row_store_column() const { return _row_store_col_idx != -1; }
+    int32_t row_store_col_idx() const { return _row_store_col_idx; }
     segment_v2::CompressionTypePB compression_type() const { return _compression_type; }
 
     int32_t schema_version() const { return _schema_version; }
     void clear_columns();
+    // Replace the columns by `columns` for a light schema change adding or dropping columns,
+    // keeping the other properties. The hidden columns are located again by their unique ids.
+    void update_columns(const std::vector<TabletColumn>& columns, int32_t schema_version);
     vectorized::Block create_block(
             const std::vector<uint32_t>& return_columns,
             const std::unordered_set<uint32_t>* tablet_columns_need_convert_null = nullptr) const;
@@ -199,6 +216,7 @@ private:
     bool _is_in_memory = false;
     int32_t _delete_sign_idx = -1;
     int32_t _sequence_col_idx = -1;
+    int32_t _row_store_col_idx = -1;
     int32_t _schema_version = -1;
 };
 
@@ -17,6 +17,9 @@
 
 #include "olap/task/engine_clone_task.h"
 
+#include <atomic>
+#include <filesystem>
+#include <mutex>
 #include <set>
 
 #include "env/env.h"
@@ -31,6 +34,7 @@
 #include "olap/snapshot_manager.h"
 #include "runtime/client_cache.h"
 #include "runtime/thread_context.h"
+#include "util/threadpool.h"
 #include "util/thrift_rpc_helper.h"
 
 using std::set;
@@ -454,10 +458,12 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
     }
 
     // Get copy from remote
-    uint64_t total_file_size = 0;
-    MonotonicStopWatch watch;
-    watch.start();
-    for (auto& file_name : file_name_list) {
+    // The files are downloaded by several threads, which share the download speed limit, and the
+    // header file is downloaded after all the others.
+    int num_threads = std::max(1, config::clone_download_file_threads);
+    int64_t max_speed_kbps = std::max(1, config::max_download_speed_kbps / num_threads);
+    std::atomic<uint64_t> total_file_size {0};
+    auto download_file = [&](const std::string& file_name) -> Status {
         auto remote_file_url = remote_url_prefix + file_name;
 
         // get file length
@@ -488,11 +494,22 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
                   << " to: " << local_file_path << ". size(B): " << file_size
                   << ", timeout(s): " << estimate_timeout;
 
-        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path,
-                            file_size](HttpClient* client) {
+        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size,
+                            max_speed_kbps](HttpClient* client) {
             RETURN_IF_ERROR(client->init(remote_file_url));
             client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
+            // a retry continues after the bytes downloaded by the failed attempts
+            std::error_code ec;
+            uint64_t downloaded_size = std::filesystem::file_size(local_file_path, ec);
+            bool resume = !ec && downloaded_size > 0 && downloaded_size < file_size;
+            Status st = client->download(local_file_path, resume, max_speed_kbps);
+            if (!st.ok()) {
+                if (resume && std::filesystem::file_size(local_file_path, ec) == downloaded_size) {
+                    // the source may not serve ranges, start over at the next retry
+                    std::filesystem::remove(local_file_path, ec);
+                }
+                return st;
+            }
 
             // Check file length
             uint64_t local_file_size = std::filesystem::file_size(local_file_path);
@@ -500,12 +517,46 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
                 LOG(WARNING) << "download file length error"
                              << ", remote_path=" << remote_file_url << ", file_size=" << file_size
                              << ", local_file_size=" << local_file_size;
+                std::filesystem::remove(local_file_path, ec);
                 return Status::InternalError("downloaded file size is not equal");
             }
             chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
             return Status::OK();
         };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
+        return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+    };
+
+    MonotonicStopWatch watch;
+    watch.start();
+    if (!file_name_list.empty()) {
+        std::unique_ptr<ThreadPool> download_pool;
+        RETURN_IF_ERROR(ThreadPoolBuilder("CloneDownloadThreadPool")
+                                .set_min_threads(num_threads)
+                                .set_max_threads(num_threads)
+                                .build(&download_pool));
+        std::mutex status_lock;
+        Status download_status = Status::OK();
+        for (size_t i = 0; i + 1 < file_name_list.size(); ++i) {
+            auto download = [&, i] {
+                {
+                    std::lock_guard<std::mutex> l(status_lock);
+                    if (!download_status.ok()) {
+                        return;
+                    }
+                }
+                Status st = download_file(file_name_list[i]);
+                if (!st.ok()) {
+                    std::lock_guard<std::mutex> l(status_lock);
+                    download_status = st;
+                }
+            };
+            if (!download_pool->submit_func(download).ok()) {
+                download();
+            }
+        }
+        download_pool->wait();
+        RETURN_IF_ERROR(download_status);
+        RETURN_IF_ERROR(download_file(file_name_list.back()));
     } // Clone files from remote backend
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
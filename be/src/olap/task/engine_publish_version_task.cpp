@@ -22,6 +22,7 @@
 #include "olap/data_dir.h"
 #include "olap/rowset/rowset_meta_manager.h"
 #include "olap/tablet_manager.h"
+#include "util/threadpool.h"
 
 namespace doris {
 
@@ -58,9 +59,16 @@ Status EnginePublishVersionTask::finish() {
 
         Version version(par_ver_info.version, par_ver_info.version);
 
-        // each tablet
+        // The tablets are published together: the metas of their rowsets are saved in one write
+        // to the meta of each data dir, then the rowsets are added to the tablets in parallel.
+        struct PublishTablet {
+            TabletInfo tablet_info;
+            TabletSharedPtr tablet;
+            RowsetSharedPtr rowset;
+            Status status;
+        };
+        std::map<DataDir*, std::vector<PublishTablet>> dir_tablets;
         for (auto& tablet_rs : tablet_related_rs) {
-            Status publish_status = Status::OK();
             TabletInfo tablet_info = tablet_rs.first;
             RowsetSharedPtr rowset = tablet_rs.second;
             VLOG_CRITICAL << "begin to publish version on tablet. "
@@ -86,36 +94,69 @@ Status EnginePublishVersionTask::finish() {
                 res = Status::OLAPInternalError(OLAP_ERR_PUSH_TABLE_NOT_EXIST);
                 continue;
             }
+            dir_tablets[tablet->data_dir()].push_back({tablet_info, tablet, rowset, Status::OK()});
+        }
 
-            publish_status = StorageEngine::instance()->txn_manager()->publish_txn(
-                    partition_id, tablet, transaction_id, version);
-            if (publish_status != Status::OK()) {
-                LOG(WARNING) << "failed to publish version. rowset_id=" << rowset->rowset_id()
-                             << ", tablet_id=" << tablet_info.tablet_id
-                             << ", txn_id=" << transaction_id;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = publish_status;
-                continue;
+        for (auto& [data_dir, tablets] : dir_tablets) {
+            std::vector<TabletInfo> tablet_infos;
+            for (auto& publish_tablet : tablets) {
+                tablet_infos.push_back(publish_tablet.tablet_info);
             }
+            std::vector<Status> statuses;
+            StorageEngine::instance()->txn_manager()->publish_txn(
+                    data_dir->get_meta(), partition_id, transaction_id, tablet_infos, version,
+                    &statuses);
+            for (size_t i = 0; i < tablets.size(); ++i) {
+                tablets[i].status = statuses[i];
+                if (!statuses[i].ok()) {
+                    LOG(WARNING) << "failed to publish version. rowset_id="
+                                 << tablets[i].rowset->rowset_id()
+                                 << ", tablet_id=" << tablets[i].tablet_info.tablet_id
+                                 << ", txn_id=" << transaction_id;
+                }
+            }
+        }
 
-            // add visible rowset to tablet
-            publish_status = tablet->add_inc_rowset(rowset);
-            if (publish_status != Status::OK() &&
-                publish_status.precise_code() != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-                LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id="
-                             << rowset->rowset_id() << ", tablet_id=" << tablet_info.tablet_id
-                             << ", txn_id=" << transaction_id << ", res=" << publish_status;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = publish_status;
-                continue;
+        ThreadPool* thread_pool = StorageEngine::instance()->tablet_publish_txn_thread_pool();
+        std::unique_ptr<ThreadPoolToken> token;
+        if (thread_pool != nullptr && tablet_related_rs.size() > 1) {
+            token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+        }
+        for (auto& [data_dir, tablets] : dir_tablets) {
+            for (auto& publish_tablet : tablets) {
+                if (!publish_tablet.status.ok()) {
+                    continue;
+                }
+                auto add_visible_rowset = [this, &publish_tablet] {
+                    publish_tablet.status =
+                            _add_visible_rowset(publish_tablet.tablet, publish_tablet.rowset);
+                };
+                if (token == nullptr || !token->submit_func(add_visible_rowset).ok()) {
+                    add_visible_rowset();
+                }
             }
-            if (_succ_tablet_ids != nullptr) {
-                _succ_tablet_ids->push_back(tablet_info.tablet_id);
+        }
+        if (token != nullptr) {
+            token->wait();
+        }
+
+        for (auto& [data_dir, tablets] : dir_tablets) {
+            for (auto& publish_tablet : tablets) {
+                const TabletInfo& tablet_info = publish_tablet.tablet_info;
+                if (!publish_tablet.status.ok()) {
+                    _error_tablet_ids->push_back(tablet_info.tablet_id);
+                    res = publish_tablet.status;
+                    continue;
+                }
+                if (_succ_tablet_ids != nullptr) {
+                    _succ_tablet_ids->push_back(tablet_info.tablet_id);
+                }
+                partition_related_tablet_infos.erase(tablet_info);
+                VLOG_NOTICE << "publish version successfully on tablet. tablet="
+                            << publish_tablet.tablet->full_name()
+                            << ", transaction_id=" << transaction_id
+                            << ", version=" << version.first;
             }
-            partition_related_tablet_infos.erase(tablet_info);
-            VLOG_NOTICE << "publish version successfully on tablet. tablet=" << tablet->full_name()
-                        << ", transaction_id=" << transaction_id << ", version=" << version.first
-                        << ", res=" << publish_status;
         }
 
         // check if the related tablet remained all have the version
@@ -143,4 +184,29 @@ Status EnginePublishVersionTask::finish() {
     return res;
 }
 
+Status EnginePublishVersionTask::_add_visible_rowset(const TabletSharedPtr& tablet,
+                                                     const RowsetSharedPtr& rowset) {
+    int64_t transaction_id = _publish_version_req.transaction_id;
+    if (tablet->keys_type() == UNIQUE_KEYS && tablet->enable_unique_key_merge_on_write()) {
+        // mark the rows replaced by this rowset deleted before it becomes visible
+        Status status = tablet->update_delete_bitmap(rowset);
+        if (!status.ok()) {
+            LOG(WARNING) << "failed to update delete bitmap. rowset_id=" << rowset->rowset_id()
+                         << ", tablet_id=" << tablet->tablet_id() << ", txn_id=" << transaction_id
+                         << ", res=" << status;
+            return status;
+        }
+    }
+
+    // add visible rowset to tablet
+    Status status = tablet->add_inc_rowset(rowset);
+    if (status != Status::OK() && status.precise_code() != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+        LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id=" << rowset->rowset_id()
+                     << ", tablet_id=" << tablet->tablet_id() << ", txn_id=" << transaction_id
+                     << ", res=" << status;
+        return status;
+    }
+    return Status::OK();
+}
+
 } // namespace doris
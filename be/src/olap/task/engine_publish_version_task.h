@@ -20,6 +20,8 @@
 
 #include "gen_cpp/AgentService_types.h"
 #include "olap/olap_define.h"
+#include "olap/rowset/rowset.h"
+#include "olap/tablet.h"
 #include "olap/task/engine_task.h"
 
 namespace doris {
@@ -34,6 +36,9 @@ public:
     virtual Status finish() override;
 
 private:
+    // Makes the published rowset visible in the tablet.
+    Status _add_visible_rowset(const TabletSharedPtr& tablet, const RowsetSharedPtr& rowset);
+
     const TPublishVersionRequest& _publish_version_req;
     vector<TTabletId>* _error_tablet_ids;
     vector<TTabletId>* _succ_tablet_ids;
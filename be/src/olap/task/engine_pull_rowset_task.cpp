@@ -0,0 +1,193 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/task/engine_pull_rowset_task.h"
+
+#include <sys/stat.h>
+
+#include <filesystem>
+
+#include "http/http_client.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_meta.h"
+#include "runtime/exec_env.h"
+
+namespace doris {
+
+const std::string HTTP_REQUEST_PREFIX = "/api/_tablet/_download?";
+const std::string HTTP_REQUEST_TOKEN_PARAM = "token=";
+const std::string HTTP_REQUEST_FILE_PARAM = "&file=";
+const uint32_t DOWNLOAD_FILE_MAX_RETRY = 3;
+
+EnginePullRowsetTask::EnginePullRowsetTask(const PTabletWriteSlaveRequest& request)
+        : _request(request) {}
+
+Status EnginePullRowsetTask::execute() {
+    RowsetMetaPB rowset_meta_pb;
+    if (!rowset_meta_pb.ParseFromString(_request.rowset_meta())) {
+        return Status::InternalError("failed to parse the rowset meta of the master replica");
+    }
+    TabletSharedPtr tablet =
+            StorageEngine::instance()->tablet_manager()->get_tablet(rowset_meta_pb.tablet_id());
+    if (tablet == nullptr) {
+        return Status::NotFound("tablet {} not found", rowset_meta_pb.tablet_id());
+    }
+
+    auto rowset_meta = std::make_shared<RowsetMeta>();
+    if (!rowset_meta->init_from_pb(rowset_meta_pb)) {
+        return Status::InternalError("failed to init the rowset meta of the master replica");
+    }
+    RowsetId remote_rowset_id = rowset_meta->rowset_id();
+    // the files get a new rowset id of this backend, the rowset ids of different backends may
+    // be the same
+    RowsetId rowset_id = StorageEngine::instance()->next_rowset_id();
+    rowset_meta->set_rowset_id(rowset_id);
+    rowset_meta->set_tablet_uid(tablet->tablet_uid());
+
+    auto files = _rowset_files(tablet->tablet_path(), rowset_id, remote_rowset_id);
+    int64_t total_size = 0;
+    for (auto& file : files) {
+        total_size += file.size;
+    }
+    Status st = tablet->data_dir()->reach_capacity_limit(total_size)
+                        ? Status::InternalError("Disk reach capacity limit")
+                        : _download_files(files);
+    if (st.ok()) {
+        const TabletSchema* schema = rowset_meta->tablet_schema() != nullptr
+                                             ? rowset_meta->tablet_schema()
+                                             : &tablet->tablet_schema();
+        RowsetSharedPtr rowset;
+        st = RowsetFactory::create_rowset(schema, tablet->tablet_path(), rowset_meta, &rowset);
+        if (st.ok()) {
+            st = StorageEngine::instance()->txn_manager()->commit_txn(
+                    rowset_meta->partition_id(), tablet, rowset_meta->txn_id(),
+                    rowset_meta->load_id(), rowset, false);
+        }
+    }
+    if (!st.ok()) {
+        // the rowset has been pulled by a retried request, the files downloaded are not used
+        bool already_exist =
+                st == Status::OLAPInternalError(OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST);
+        if (!already_exist) {
+            LOG(WARNING) << "failed to pull rowset " << remote_rowset_id << " of tablet "
+                         << tablet->tablet_id() << " from " << _request.host()
+                         << ", txn_id=" << rowset_meta->txn_id() << ", err=" << st;
+        }
+        for (auto& file : files) {
+            std::error_code ec;
+            std::filesystem::remove(file.local_path, ec);
+        }
+        StorageEngine::instance()->release_rowset_id(rowset_id);
+        return already_exist ? Status::OK() : st;
+    }
+    VLOG_CRITICAL << "pulled rowset " << remote_rowset_id << " of tablet " << tablet->tablet_id()
+                  << " from " << _request.host() << " as rowset " << rowset_id;
+    return Status::OK();
+}
+
+Status EnginePullRowsetTask::set_rowset_files(const RowsetMeta& rowset_meta,
+                                              const std::string& tablet_path,
+                                              PTabletWriteSlaveRequest* request) {
+    for (int64_t segment_id = 0; segment_id < rowset_meta.num_segments(); ++segment_id) {
+        std::error_code ec;
+        auto file_size = std::filesystem::file_size(
+                BetaRowset::local_segment_path(tablet_path, rowset_meta.rowset_id(), segment_id),
+                ec);
+        if (ec) {
+            return Status::InternalError("failed to get the size of segment {} of rowset {}: {}",
+                                         segment_id, rowset_meta.rowset_id().to_string(),
+                                         ec.message());
+        }
+        (*request->mutable_segments_size())[segment_id] = file_size;
+        if (!rowset_meta.has_index_files()) {
+            continue;
+        }
+        auto index_path = BetaRowset::local_segment_index_path(tablet_path,
+                                                               rowset_meta.rowset_id(), segment_id);
+        if (!std::filesystem::exists(index_path, ec)) {
+            if (ec) {
+                return Status::InternalError("failed to check the index file {}: {}", index_path,
+                                             ec.message());
+            }
+            continue;
+        }
+        file_size = std::filesystem::file_size(index_path, ec);
+        if (ec) {
+            return Status::InternalError("failed to get the size of the index file {}: {}",
+                                         index_path, ec.message());
+        }
+        (*request->mutable_index_files_size())[segment_id] = file_size;
+    }
+    return Status::OK();
+}
+
+std::vector<EnginePullRowsetTask::RowsetFile> EnginePullRowsetTask::_rowset_files(
+        const std::string& tablet_path, const RowsetId& rowset_id,
+        const RowsetId& remote_rowset_id) const {
+    std::vector<RowsetFile> files;
+    for (auto& [segment_id, file_size] : _request.segments_size()) {
+        files.push_back({BetaRowset::local_segment_path(_request.rowset_path(), remote_rowset_id,
+                                                        segment_id),
+                         BetaRowset::local_segment_path(tablet_path, rowset_id, segment_id),
+                         file_size});
+    }
+    for (auto& [segment_id, file_size] : _request.index_files_size()) {
+        files.push_back({BetaRowset::local_segment_index_path(_request.rowset_path(),
+                                                              remote_rowset_id, segment_id),
+                         BetaRowset::local_segment_index_path(tablet_path, rowset_id, segment_id),
+                         file_size});
+    }
+    return files;
+}
+
+Status EnginePullRowsetTask::_download_files(const std::vector<RowsetFile>& files) {
+    for (auto& file : files) {
+        std::string remote_file_url = fmt::format(
+                "http://{}:{}{}{}{}{}", _request.host(), _request.http_port(), HTTP_REQUEST_PREFIX,
+                HTTP_REQUEST_TOKEN_PARAM + ExecEnv::GetInstance()->token(), HTTP_REQUEST_FILE_PARAM,
+                file.remote_path);
+        const std::string& local_file_path = file.local_path;
+        uint64_t file_size = file.size;
+        uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
+        if (estimate_timeout < config::download_low_speed_time) {
+            estimate_timeout = config::download_low_speed_time;
+        }
+
+        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path,
+                            file_size](HttpClient* client) {
+            RETURN_IF_ERROR(client->init(remote_file_url));
+            client->set_timeout_ms(estimate_timeout * 1000);
+            RETURN_IF_ERROR(client->download(local_file_path));
+
+            // Check file length
+            uint64_t local_file_size = std::filesystem::file_size(local_file_path);
+            if (local_file_size != file_size) {
+                LOG(WARNING) << "download file length error"
+                             << ", remote_path=" << remote_file_url << ", file_size=" << file_size
+                             << ", local_file_size=" << local_file_size;
+                return Status::InternalError("downloaded file size is not equal");
+            }
+            chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
+            return Status::OK();
+        };
+        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
+    }
+    return Status::OK();
+}
+
+} // namespace doris
@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef DORIS_BE_SRC_OLAP_TASK_ENGINE_PULL_ROWSET_TASK_H
+#define DORIS_BE_SRC_OLAP_TASK_ENGINE_PULL_ROWSET_TASK_H
+
+#include <string>
+#include <vector>
+
+#include "gen_cpp/internal_service.pb.h"
+#include "olap/task/engine_task.h"
+
+namespace doris {
+
+class RowsetMeta;
+
+// Run by a slave replica in single replica load: download the segment files and the index files
+// of the rowset committed by the master replica of the tablet, and commit them to the same
+// transaction as a rowset of the local tablet, which is published together with the master's.
+class EnginePullRowsetTask : public EngineTask {
+public:
+    EnginePullRowsetTask(const PTabletWriteSlaveRequest& request);
+    ~EnginePullRowsetTask() {}
+
+    Status execute() override;
+
+    // Called by the master replica: set the sizes of all the files of the rowset in the tablet
+    // path to the request. A segment may have no index file, even if the rowset has index files.
+    static Status set_rowset_files(const RowsetMeta& rowset_meta, const std::string& tablet_path,
+                                   PTabletWriteSlaveRequest* request);
+
+private:
+    struct RowsetFile {
+        std::string remote_path;
+        std::string local_path;
+        int64_t size;
+    };
+
+    // the files of the request, and their paths in the tablet path of this backend
+    std::vector<RowsetFile> _rowset_files(const std::string& tablet_path, const RowsetId& rowset_id,
+                                          const RowsetId& remote_rowset_id) const;
+    Status _download_files(const std::vector<RowsetFile>& files);
+
+    const PTabletWriteSlaveRequest& _request;
+};
+
+} // namespace doris
+
+#endif // DORIS_BE_SRC_OLAP_TASK_ENGINE_PULL_ROWSET_TASK_H
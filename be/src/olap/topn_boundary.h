@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <gen_cpp/PaloInternalService_types.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+namespace doris {
+
+// The boundary of the rows a TopN, like ORDER BY ts DESC LIMIT 100, can still take. Once the sort
+// node has kept `limit` rows, a row whose first sort column is after the value of the last of them
+// can't be in the result, so the scan under it can skip the pages whose zone maps have no value
+// up to the boundary, `ts >= value`, or `ts <= value` for an ascending sort. When the nulls are
+// sorted first they beat any value, so the pages having nulls are never skipped. The boundary only
+// tightens as the sort node keeps better rows, and is read by the scanners while they scan.
+class TopNBoundary {
+public:
+    TopNBoundary(std::string column_name, bool is_asc, bool nulls_first)
+            : _column_name(std::move(column_name)), _is_asc(is_asc), _nulls_first(nulls_first) {}
+
+    const std::string& column_name() const { return _column_name; }
+
+    bool nulls_first() const { return _nulls_first; }
+
+    // Sets the value of the boundary, formatted like the operand of a condition of the column.
+    void update(std::string value) {
+        std::lock_guard<std::mutex> l(_lock);
+        _value = std::move(value);
+        _version.fetch_add(1, std::memory_order_release);
+    }
+
+    // The number of updates of the boundary, 0 while there is no boundary yet.
+    int64_t version() const { return _version.load(std::memory_order_acquire); }
+
+    // Sets the condition of the current boundary and returns its version, or returns 0 without
+    // touching the condition when there is no boundary yet.
+    int64_t get_condition(TCondition* condition) const {
+        std::lock_guard<std::mutex> l(_lock);
+        int64_t version = _version.load(std::memory_order_relaxed);
+        if (version > 0) {
+            condition->__set_column_name(_column_name);
+            condition->__set_condition_op(_is_asc ? "<=" : ">=");
+            condition->__set_condition_values({_value});
+        }
+        return version;
+    }
+
+private:
+    const std::string _column_name;
+    const bool _is_asc;
+    const bool _nulls_first;
+    mutable std::mutex _lock;
+    std::string _value;
+    std::atomic<int64_t> _version {0};
+};
+
+} // namespace doris
@@ -257,58 +257,80 @@ Status TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id,
                                TTransactionId transaction_id, TTabletId tablet_id,
                                SchemaHash schema_hash, TabletUid tablet_uid,
                                const Version& version) {
+    std::vector<Status> statuses;
+    publish_txn(meta, partition_id, transaction_id,
+                {TabletInfo(tablet_id, schema_hash, tablet_uid)}, version, &statuses);
+    return statuses[0];
+}
+
+void TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id,
+                             TTransactionId transaction_id,
+                             const std::vector<TabletInfo>& tablet_infos, const Version& version,
+                             std::vector<Status>* statuses) {
     pair<int64_t, int64_t> key(partition_id, transaction_id);
-    TabletInfo tablet_info(tablet_id, schema_hash, tablet_uid);
-    RowsetSharedPtr rowset_ptr = nullptr;
+    statuses->assign(tablet_infos.size(), Status::OK());
+    std::vector<RowsetSharedPtr> rowsets(tablet_infos.size());
     std::unique_lock<std::mutex> txn_lock(_get_txn_lock(transaction_id));
     {
         std::shared_lock rlock(_get_txn_map_lock(transaction_id));
         txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
         auto it = txn_tablet_map.find(key);
         if (it != txn_tablet_map.end()) {
-            auto load_itr = it->second.find(tablet_info);
-            if (load_itr != it->second.end()) {
-                // found load for txn,tablet
-                // case 1: user commit rowset, then the load id must be equal
-                TabletTxnInfo& load_info = load_itr->second;
-                rowset_ptr = load_info.rowset;
+            for (size_t i = 0; i < tablet_infos.size(); ++i) {
+                auto load_itr = it->second.find(tablet_infos[i]);
+                if (load_itr != it->second.end()) {
+                    // found load for txn,tablet
+                    // case 1: user commit rowset, then the load id must be equal
+                    rowsets[i] = load_itr->second.rowset;
+                }
             }
         }
     }
     // save meta need access disk, it maybe very slow, so that it is not in global txn lock
     // it is under a single txn lock
-    if (rowset_ptr != nullptr) {
+    std::vector<RowsetMetaSharedPtr> rowset_metas;
+    for (size_t i = 0; i < tablet_infos.size(); ++i) {
+        if (rowsets[i] == nullptr) {
+            (*statuses)[i] = Status::OLAPInternalError(OLAP_ERR_TRANSACTION_NOT_EXIST);
+            continue;
+        }
         // TODO(ygl): rowset is already set version here, memory is changed, if save failed
         // it maybe a fatal error
-        rowset_ptr->make_visible(version);
-        Status save_status = RowsetMetaManager::save(meta, tablet_uid, rowset_ptr->rowset_id(),
-                                                     rowset_ptr->rowset_meta()->get_rowset_pb());
-        if (save_status != Status::OK()) {
-            LOG(WARNING) << "save committed rowset failed. when publish txn rowset_id:"
-                         << rowset_ptr->rowset_id() << ", tablet id: " << tablet_id
-                         << ", txn id:" << transaction_id;
-            return Status::OLAPInternalError(OLAP_ERR_ROWSET_SAVE_FAILED);
+        rowsets[i]->make_visible(version);
+        rowset_metas.push_back(rowsets[i]->rowset_meta());
+    }
+    Status save_status = RowsetMetaManager::save(meta, rowset_metas);
+    if (save_status != Status::OK()) {
+        LOG(WARNING) << "save committed rowsets failed. when publish txn, rowset num: "
+                     << rowset_metas.size() << ", txn id:" << transaction_id;
+        for (size_t i = 0; i < tablet_infos.size(); ++i) {
+            if (rowsets[i] != nullptr) {
+                (*statuses)[i] = Status::OLAPInternalError(OLAP_ERR_ROWSET_SAVE_FAILED);
+            }
         }
-    } else {
-        return Status::OLAPInternalError(OLAP_ERR_TRANSACTION_NOT_EXIST);
+        return;
     }
     {
         std::lock_guard<std::shared_mutex> wrlock(_get_txn_map_lock(transaction_id));
         txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
         auto it = txn_tablet_map.find(key);
         if (it != txn_tablet_map.end()) {
-            it->second.erase(tablet_info);
-            VLOG_NOTICE << "publish txn successfully."
-                        << " partition_id: " << key.first << ", txn_id: " << key.second
-                        << ", tablet: " << tablet_info.to_string()
-                        << ", rowsetid: " << rowset_ptr->rowset_id()
-                        << ", version: " << version.first << "," << version.second;
+            for (size_t i = 0; i < tablet_infos.size(); ++i) {
+                if (rowsets[i] == nullptr) {
+                    continue;
+                }
+                it->second.erase(tablet_infos[i]);
+                VLOG_NOTICE << "publish txn successfully."
+                            << " partition_id: " << key.first << ", txn_id: " << key.second
+                            << ", tablet: " << tablet_infos[i].to_string()
+                            << ", rowsetid: " << rowsets[i]->rowset_id()
+                            << ", version: " << version.first << "," << version.second;
+            }
             if (it->second.empty()) {
                 txn_tablet_map.erase(it);
                 _clear_txn_partition_map_unlocked(transaction_id, partition_id);
             }
         }
-        return Status::OK();
     }
 }
 
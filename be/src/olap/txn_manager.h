@@ -104,6 +104,12 @@ public:
                        TTabletId tablet_id, SchemaHash schema_hash, TabletUid tablet_uid,
                        const Version& version);
 
+    // Publishes the txn on several tablets of the data dir of the meta, whose rowset metas are
+    // saved in one write. (*statuses)[i] is set to the status of tablet_infos[i].
+    void publish_txn(OlapMeta* meta, TPartitionId partition_id, TTransactionId transaction_id,
+                     const std::vector<TabletInfo>& tablet_infos, const Version& version,
+                     std::vector<Status>* statuses);
+
     // delete the txn from manager if it is not committed(not have a valid rowset)
     Status rollback_txn(TPartitionId partition_id, TTransactionId transaction_id,
                         TTabletId tablet_id, SchemaHash schema_hash, TabletUid tablet_uid);
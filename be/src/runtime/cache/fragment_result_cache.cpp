@@ -0,0 +1,53 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/cache/fragment_result_cache.h"
+
+namespace doris {
+
+FragmentResultCache* FragmentResultCache::_s_instance = nullptr;
+
+void FragmentResultCache::create_global_instance(size_t capacity) {
+    DCHECK(_s_instance == nullptr);
+    static FragmentResultCache instance(capacity);
+    _s_instance = &instance;
+}
+
+FragmentResultCache::FragmentResultCache(size_t capacity)
+        : _cache(new_lru_cache("FragmentResultCache", capacity)) {}
+
+std::shared_ptr<const FragmentResultCache::Entry> FragmentResultCache::lookup(
+        const std::string& key) {
+    auto* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    auto entry = *reinterpret_cast<std::shared_ptr<const Entry>*>(_cache->value(handle));
+    _cache->release(handle);
+    return entry;
+}
+
+void FragmentResultCache::insert(const std::string& key, std::shared_ptr<const Entry> entry) {
+    auto deleter = [](const CacheKey& key, void* value) {
+        delete reinterpret_cast<std::shared_ptr<const Entry>*>(value);
+    };
+    size_t charge = entry->bytes;
+    auto* value = new std::shared_ptr<const Entry>(std::move(entry));
+    _cache->release(_cache->insert(CacheKey(key), value, charge, deleter));
+}
+
+} // namespace doris
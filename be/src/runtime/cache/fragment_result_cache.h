@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "olap/lru_cache.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+// Caches the partial results of the aggregation of a fragment over its tablets, keyed by the
+// digest of the plan and the ids of the tablets. An entry records the versions of the tablets its
+// blocks are the results of, so that a query of newer versions only scans the new rows and sends
+// their results along with the cached ones. See AggregationNode::_init_fragment_cache().
+class FragmentResultCache {
+public:
+    struct Entry {
+        // the version of each tablet whose rows are aggregated into the blocks
+        std::map<int64_t, int64_t> tablet_versions;
+        std::vector<vectorized::Block> blocks;
+        size_t bytes = 0;
+    };
+
+    static void create_global_instance(size_t capacity);
+
+    // Return global instance, null if the cache is disabled.
+    static FragmentResultCache* instance() { return _s_instance; }
+
+    // The entry of the key, or null.
+    std::shared_ptr<const Entry> lookup(const std::string& key);
+
+    void insert(const std::string& key, std::shared_ptr<const Entry> entry);
+
+private:
+    explicit FragmentResultCache(size_t capacity);
+
+    static FragmentResultCache* _s_instance;
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace doris
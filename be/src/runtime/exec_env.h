@@ -55,7 +55,9 @@ class LoadChannelMgr;
 class ThreadResourceMgr;
 class TmpFileMgr;
 class WebPageHandler;
+class WorkloadGroupMgr;
 class StreamLoadExecutor;
+class GroupCommitMgr;
 class RoutineLoadTaskExecutor;
 class SmallFileMgr;
 class StoragePolicyMgr;
@@ -118,11 +120,16 @@ public:
     MemTrackerLimiter* query_pool_mem_tracker() { return _query_pool_mem_tracker; }
     MemTrackerLimiter* load_pool_mem_tracker() { return _load_pool_mem_tracker; }
     MemTrackerTaskPool* task_pool_mem_tracker_registry() { return _task_pool_mem_tracker_registry; }
+    WorkloadGroupMgr* workload_group_mgr() { return _workload_group_mgr; }
     ThreadResourceMgr* thread_mgr() { return _thread_mgr; }
     PriorityThreadPool* scan_thread_pool() { return _scan_thread_pool; }
     ThreadPool* limited_scan_thread_pool() { return _limited_scan_thread_pool.get(); }
     PriorityThreadPool* etl_thread_pool() { return _etl_thread_pool; }
     ThreadPool* send_batch_thread_pool() { return _send_batch_thread_pool.get(); }
+    ThreadPool* tablet_write_thread_pool() { return _tablet_write_thread_pool.get(); }
+    ThreadPool* remote_prefetch_thread_pool() { return _remote_prefetch_thread_pool.get(); }
+    ThreadPool* spill_io_thread_pool() { return _spill_io_thread_pool.get(); }
+    ThreadPool* parallel_operator_thread_pool() { return _parallel_operator_thread_pool.get(); }
     CgroupsMgr* cgroups_mgr() { return _cgroups_mgr; }
     FragmentMgr* fragment_mgr() { return _fragment_mgr; }
     ResultCache* result_cache() { return _result_cache; }
@@ -151,6 +158,7 @@ public:
     void set_storage_engine(StorageEngine* storage_engine) { _storage_engine = storage_engine; }
 
     StreamLoadExecutor* stream_load_executor() { return _stream_load_executor; }
+    GroupCommitMgr* group_commit_mgr() { return _group_commit_mgr; }
     RoutineLoadTaskExecutor* routine_load_task_executor() { return _routine_load_task_executor; }
     HeartbeatFlags* heartbeat_flags() { return _heartbeat_flags; }
 
@@ -189,6 +197,8 @@ private:
     // The ancestor for all load tracker.
     MemTrackerLimiter* _load_pool_mem_tracker;
     MemTrackerTaskPool* _task_pool_mem_tracker_registry;
+    // The workload groups, whose trackers are children of the query pool tracker.
+    WorkloadGroupMgr* _workload_group_mgr = nullptr;
 
     // The following two thread pools are used in different scenarios.
     // _scan_thread_pool is a priority thread pool.
@@ -204,6 +214,14 @@ private:
     std::unique_ptr<ThreadPool> _limited_scan_thread_pool;
 
     std::unique_ptr<ThreadPool> _send_batch_thread_pool;
+    // writes the rows of a received block to the tablet writers concurrently
+    std::unique_ptr<ThreadPool> _tablet_write_thread_pool;
+    // reads the pages of the segments on remote storage ahead of their scans
+    std::unique_ptr<ThreadPool> _remote_prefetch_thread_pool;
+    // writes and reads ahead the spill files of the vectorized operators
+    std::unique_ptr<ThreadPool> _spill_io_thread_pool;
+    // runs the parallel tasks of the vectorized operators, shared by all the queries
+    std::unique_ptr<ThreadPool> _parallel_operator_thread_pool;
     PriorityThreadPool* _etl_thread_pool = nullptr;
     CgroupsMgr* _cgroups_mgr = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
@@ -226,6 +244,7 @@ private:
     StorageEngine* _storage_engine = nullptr;
 
     StreamLoadExecutor* _stream_load_executor = nullptr;
+    GroupCommitMgr* _group_commit_mgr = nullptr;
     RoutineLoadTaskExecutor* _routine_load_task_executor = nullptr;
     SmallFileMgr* _small_file_mgr = nullptr;
     HeartbeatFlags* _heartbeat_flags = nullptr;
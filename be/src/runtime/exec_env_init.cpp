@@ -21,13 +21,17 @@
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/HeartbeatService_types.h"
 #include "gen_cpp/TPaloBrokerService.h"
+#include "gutil/strings/split.h"
+#include "io/fs/file_block_cache.h"
 #include "olap/page_cache.h"
 #include "olap/segment_loader.h"
+#include "olap/segment_meta_cache.h"
 #include "olap/storage_engine.h"
 #include "olap/storage_policy_mgr.h"
 #include "runtime/broker_mgr.h"
 #include "runtime/bufferpool/buffer_pool.h"
 #include "runtime/bufferpool/reservation_tracker.h"
+#include "runtime/cache/fragment_result_cache.h"
 #include "runtime/cache/result_cache.h"
 #include "runtime/client_cache.h"
 #include "runtime/data_stream_mgr.h"
@@ -46,12 +50,15 @@
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/small_file_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/group_commit_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/thread_resource_mgr.h"
 #include "runtime/tmp_file_mgr.h"
+#include "runtime/workload_group.h"
 #include "util/bfd_parser.h"
 #include "util/brpc_client_cache.h"
 #include "util/doris_metrics.h"
+#include "util/fair_scan_thread_pool.hpp"
 #include "util/mem_info.h"
 #include "util/metrics.h"
 #include "util/parse_util.h"
@@ -101,16 +108,25 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _broker_client_cache = new BrokerServiceClientCache(config::max_client_cache_size_per_host);
     _task_pool_mem_tracker_registry = new MemTrackerTaskPool();
     _thread_mgr = new ThreadResourceMgr();
-    if (config::doris_enable_scanner_thread_pool_per_disk &&
-        config::doris_scanner_thread_pool_thread_num >= store_paths.size() &&
-        store_paths.size() > 0) {
+    bool scan_pool_per_disk = config::doris_enable_scanner_thread_pool_per_disk &&
+                              config::doris_scanner_thread_pool_thread_num >= store_paths.size() &&
+                              store_paths.size() > 0;
+    if (config::doris_enable_scanner_thread_pool_fair_scheduling) {
+        _scan_thread_pool = new FairScanThreadPool(config::doris_scanner_thread_pool_thread_num,
+                                                   scan_pool_per_disk ? store_paths.size() : 1,
+                                                   config::doris_scanner_thread_pool_queue_size,
+                                                   config::bind_scanner_threads_to_numa_nodes);
+        LOG(INFO) << "scan thread pool use FairScanThreadPool";
+    } else if (scan_pool_per_disk) {
         _scan_thread_pool = new PriorityWorkStealingThreadPool(
                 config::doris_scanner_thread_pool_thread_num, store_paths.size(),
-                config::doris_scanner_thread_pool_queue_size);
+                config::doris_scanner_thread_pool_queue_size,
+                config::bind_scanner_threads_to_numa_nodes);
         LOG(INFO) << "scan thread pool use PriorityWorkStealingThreadPool";
     } else {
         _scan_thread_pool = new PriorityThreadPool(config::doris_scanner_thread_pool_thread_num,
-                                                   config::doris_scanner_thread_pool_queue_size);
+                                                   config::doris_scanner_thread_pool_queue_size,
+                                                   config::bind_scanner_threads_to_numa_nodes);
         LOG(INFO) << "scan thread pool use PriorityThreadPool";
     }
 
@@ -126,6 +142,26 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_queue_size(config::send_batch_thread_pool_queue_size)
             .build(&_send_batch_thread_pool);
 
+    ThreadPoolBuilder("TabletWriteThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::tablet_writer_write_thread_num)
+            .build(&_tablet_write_thread_pool);
+
+    ThreadPoolBuilder("RemotePrefetchThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::remote_prefetch_thread_num)
+            .build(&_remote_prefetch_thread_pool);
+
+    ThreadPoolBuilder("SpillIOThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::spill_io_thread_num)
+            .build(&_spill_io_thread_pool);
+
+    ThreadPoolBuilder("ParallelOperatorThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::parallel_operator_thread_num)
+            .build(&_parallel_operator_thread_pool);
+
     _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size,
                                               config::etl_thread_pool_queue_size);
     _cgroups_mgr = new CgroupsMgr(this, config::doris_cgroups);
@@ -143,6 +179,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _internal_client_cache = new BrpcClientCache<PBackendService_Stub>();
     _function_client_cache = new BrpcClientCache<PFunctionService_Stub>();
     _stream_load_executor = new StreamLoadExecutor(this);
+    _group_commit_mgr = new GroupCommitMgr(this);
     _routine_load_task_executor = new RoutineLoadTaskExecutor(this);
     _small_file_mgr = new SmallFileMgr(this, config::small_file_dir);
     _storage_policy_mgr = new StoragePolicyMgr();
@@ -201,6 +238,9 @@ Status ExecEnv::_init_mem_tracker() {
     _query_pool_mem_tracker = new MemTrackerLimiter(-1, "QueryPool", _process_mem_tracker);
     REGISTER_HOOK_METRIC(query_mem_consumption,
                          [this]() { return _query_pool_mem_tracker->consumption(); });
+    _workload_group_mgr = new WorkloadGroupMgr();
+    RETURN_IF_ERROR(_workload_group_mgr->init(config::workload_groups, _query_pool_mem_tracker,
+                                              global_memory_limit_bytes));
     _load_pool_mem_tracker = new MemTrackerLimiter(-1, "LoadPool", _process_mem_tracker);
     REGISTER_HOOK_METRIC(load_mem_consumption,
                          [this]() { return _load_pool_mem_tracker->consumption(); });
@@ -261,12 +301,26 @@ Status ExecEnv::_init_mem_tracker() {
     }
     int32_t index_percentage = config::index_page_cache_percentage;
     uint32_t num_shards = config::storage_page_cache_shard_size;
-    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards);
+    StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards,
+                                          config::compressed_page_cache_percentage);
     LOG(INFO) << "Storage page cache memory limit: "
               << PrettyPrinter::print(storage_cache_limit, TUnit::BYTES)
               << ", origin config value: " << config::storage_page_cache_limit;
 
     SegmentLoader::create_global_instance(config::segment_cache_capacity);
+    SegmentMetaCache::create_global_instance(config::segment_meta_cache_capacity);
+    if (config::fragment_result_cache_capacity_mb > 0) {
+        FragmentResultCache::create_global_instance(config::fragment_result_cache_capacity_mb
+                                                    << 20);
+    }
+
+    if (!config::file_cache_path.empty()) {
+        std::vector<std::string> file_cache_paths =
+                strings::Split(config::file_cache_path, ";", strings::SkipWhitespace());
+        RETURN_IF_ERROR(io::FileBlockCache::create_global_instance(
+                file_cache_paths, config::file_cache_capacity_per_path,
+                config::file_cache_block_size));
+    }
 
     // 4. init other managers
     RETURN_IF_ERROR(_disk_io_mgr->init(global_memory_limit_bytes));
@@ -353,10 +407,12 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_result_mgr);
     SAFE_DELETE(_result_queue_mgr);
     SAFE_DELETE(_stream_mgr);
+    SAFE_DELETE(_group_commit_mgr);
     SAFE_DELETE(_stream_load_executor);
     SAFE_DELETE(_routine_load_task_executor);
     SAFE_DELETE(_external_scan_context_mgr);
     SAFE_DELETE(_heartbeat_flags);
+    SAFE_DELETE(_workload_group_mgr);
     SAFE_DELETE(_process_mem_tracker);
     SAFE_DELETE(_query_pool_mem_tracker);
     SAFE_DELETE(_load_pool_mem_tracker);
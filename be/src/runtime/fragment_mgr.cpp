@@ -40,6 +40,10 @@
 #include "runtime/datetime_value.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/memory/mem_arbiter.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/pipeline_task.h"
+#include "runtime/pipeline_task_scheduler.h"
 #include "runtime/plan_fragment_executor.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
@@ -47,6 +51,7 @@
 #include "runtime/stream_load/stream_load_pipe.h"
 #include "runtime/thread_context.h"
 #include "service/backend_options.h"
+#include "util/cpu_info.h"
 #include "util/debug_util.h"
 #include "util/doris_metrics.h"
 #include "util/stopwatch.hpp"
@@ -144,6 +149,7 @@ public:
     std::shared_ptr<StreamLoadPipe> get_pipe() const { return _pipe; }
 
     void set_need_wait_execution_trigger() { _need_wait_execution_trigger = true; }
+    bool need_wait_execution_trigger() const { return _need_wait_execution_trigger; }
 
 private:
     void coordinator_callback(const Status& status, RuntimeProfile* profile, bool done);
@@ -430,7 +436,8 @@ FragmentMgr::FragmentMgr(ExecEnv* exec_env)
         : _exec_env(exec_env),
           _fragment_map(),
           _fragments_ctx_map(),
-          _stop_background_threads_latch(1) {
+          _stop_background_threads_latch(1),
+          _fragment_templates(std::max(config::fragment_template_cache_capacity, 1)) {
     _entity = DorisMetrics::instance()->metric_registry()->register_entity("FragmentMgr");
     INT_UGAUGE_METRIC_REGISTER(_entity, timeout_canceled_fragment_count);
     REGISTER_HOOK_METRIC(plan_fragment_count, [this]() {
@@ -451,6 +458,15 @@ FragmentMgr::FragmentMgr(ExecEnv* exec_env)
                 .set_max_queue_size(config::fragment_pool_queue_size)
                 .build(&_thread_pool);
     CHECK(s.ok()) << s.to_string();
+
+    if (config::enable_pipeline_exec_engine) {
+        int num_workers = config::pipeline_executor_size > 0 ? config::pipeline_executor_size
+                                                             : CpuInfo::num_cores();
+        _pipeline_task_scheduler = std::make_unique<PipelineTaskScheduler>(
+                num_workers, config::pipeline_open_thread_num_max);
+        s = _pipeline_task_scheduler->start();
+        CHECK(s.ok()) << s.to_string();
+    }
 }
 
 FragmentMgr::~FragmentMgr() {
@@ -462,6 +478,9 @@ FragmentMgr::~FragmentMgr() {
     // Stop all the worker, should wait for a while?
     // _thread_pool->wait_for();
     _thread_pool->shutdown();
+    if (_pipeline_task_scheduler) {
+        _pipeline_task_scheduler->shutdown();
+    }
 
     // Only me can delete
     {
@@ -497,7 +516,16 @@ void FragmentMgr::_exec_actual(std::shared_ptr<FragmentExecState> exec_state, Fi
     SCOPED_ATTACH_TASK(exec_state->executor()->runtime_state());
 #endif
     exec_state->execute();
+    // a slow fragment is exported with the stats of its operators, when its spans are recorded
+    RuntimeState* runtime_state = exec_state->executor()->runtime_state();
+    if (runtime_state != nullptr) {
+        telemetry::set_span_profile_attributes(span, runtime_state->runtime_profile());
+    }
+    _finish_fragment(exec_state, cb);
+}
 
+void FragmentMgr::_finish_fragment(std::shared_ptr<FragmentExecState> exec_state,
+                                   FinishCallback cb) {
     std::shared_ptr<QueryFragmentsCtx> fragments_ctx = exec_state->get_fragments_ctx();
     bool all_done = false;
     if (fragments_ctx != nullptr) {
@@ -518,6 +546,28 @@ void FragmentMgr::_exec_actual(std::shared_ptr<FragmentExecState> exec_state, Fi
     cb(exec_state->executor());
 }
 
+Status FragmentMgr::_submit_pipeline_task(std::shared_ptr<FragmentExecState> exec_state,
+                                          FinishCallback cb) {
+    std::function<bool()> can_start;
+    if (exec_state->need_wait_execution_trigger()) {
+        // Instead of waiting for the execPlanFragmentStart RPC on a worker, the task stays
+        // blocked until the query is started, or cancelled meanwhile.
+        auto fragments_ctx = exec_state->get_fragments_ctx();
+        auto runtime_state = exec_state->executor()->runtime_state();
+        can_start = [fragments_ctx, runtime_state]() {
+            return fragments_ctx->is_ready_to_execute() || runtime_state->is_cancelled();
+        };
+    }
+    auto on_finish = [this, exec_state, cb](PipelineTask* task) {
+        DorisMetrics::instance()->fragment_requests_total->increment(1);
+        DorisMetrics::instance()->fragment_request_duration_us->increment(
+                task->elapsed_time_ns() / 1000);
+        _finish_fragment(exec_state, cb);
+    };
+    return _pipeline_task_scheduler->submit(std::make_unique<PipelineTask>(
+            exec_state->executor(), std::move(can_start), std::move(on_finish)));
+}
+
 Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params) {
     if (params.txn_conf.need_txn) {
         StreamLoadContext* stream_load_cxt = new StreamLoadContext(_exec_env);
@@ -569,6 +619,37 @@ Status FragmentMgr::start_query_execution(const PExecPlanFragmentStartRequest* r
     return Status::OK();
 }
 
+Status FragmentMgr::resolve_fragment_templates(std::vector<TExecPlanFragmentParams>* params_list,
+                                               std::vector<std::string>* cached_digests,
+                                               std::vector<std::string>* missing_digests) {
+    std::lock_guard<std::mutex> lock(_fragment_templates_lock);
+    for (auto& params : *params_list) {
+        if (!params.__isset.fragment_digest) {
+            continue;
+        }
+        const std::string& digest = params.fragment_digest;
+        if (params.__isset.fragment) {
+            if (config::fragment_template_cache_capacity > 0) {
+                _fragment_templates.put(digest,
+                                        std::make_shared<const TPlanFragment>(params.fragment));
+                cached_digests->push_back(digest);
+            }
+            continue;
+        }
+        std::shared_ptr<const TPlanFragment> fragment;
+        if (_fragment_templates.get(digest, &fragment)) {
+            params.__set_fragment(*fragment);
+        } else {
+            missing_digests->push_back(digest);
+        }
+    }
+    if (!missing_digests->empty()) {
+        return Status::NotFound("{} plan fragment templates are not cached, host: {}",
+                                missing_digests->size(), BackendOptions::get_localhost());
+    }
+    return Status::OK();
+}
+
 void FragmentMgr::set_pipe(const TUniqueId& fragment_instance_id,
                            std::shared_ptr<StreamLoadPipe> pipe) {
     {
@@ -622,8 +703,10 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
     } else {
         // This may be a first fragment request of the query.
         // Create the query fragments context.
+        RETURN_IF_ERROR(_check_memory_admission(params));
         fragments_ctx.reset(new QueryFragmentsCtx(params.fragment_num_on_host, _exec_env));
         fragments_ctx->query_id = params.params.query_id;
+        RETURN_IF_ERROR(_acquire_workload_group_slot(params, fragments_ctx.get()));
         RETURN_IF_ERROR(DescriptorTbl::create(&(fragments_ctx->obj_pool), params.desc_tbl,
                                               &(fragments_ctx->desc_tbl)));
         fragments_ctx->coord_addr = params.coord;
@@ -676,11 +759,19 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
         _cv.notify_all();
     }
 
-    auto st = _thread_pool->submit_func(
-            [this, exec_state, cb, parent_span = opentelemetry::trace::Tracer::GetCurrentSpan()] {
-                OpentelemetryScope scope {parent_span};
-                _exec_actual(exec_state, cb);
-            });
+    Status st;
+    if (_pipeline_task_scheduler != nullptr &&
+        exec_state->executor()->runtime_state()->enable_vectorized_exec() &&
+        exec_state->executor()->get_sink() != nullptr) {
+        st = _submit_pipeline_task(exec_state, cb);
+    } else {
+        st = _thread_pool->submit_func(
+                [this, exec_state, cb,
+                 parent_span = opentelemetry::trace::Tracer::GetCurrentSpan()] {
+                    OpentelemetryScope scope {parent_span};
+                    _exec_actual(exec_state, cb);
+                });
+    }
     if (!st.ok()) {
         {
             // Remove the exec state added
@@ -695,6 +786,45 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
     return Status::OK();
 }
 
+Status FragmentMgr::_check_memory_admission(const TExecPlanFragmentParams& params) {
+    if (!params.__isset.query_options || params.query_options.query_type != TQueryType::SELECT) {
+        return Status::OK();
+    }
+    {
+        // The fragments of a running query are always admitted, failing them would waste the
+        // work already done.
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_fragments_ctx_map.find(params.params.query_id) != _fragments_ctx_map.end()) {
+            return Status::OK();
+        }
+    }
+    return MemArbiter::check_admission();
+}
+
+Status FragmentMgr::_acquire_workload_group_slot(const TExecPlanFragmentParams& params,
+                                                 QueryFragmentsCtx* fragments_ctx) {
+    if (!params.__isset.query_options || !params.query_options.__isset.workload_group ||
+        params.query_options.workload_group.empty() ||
+        params.query_options.query_type != TQueryType::SELECT) {
+        return Status::OK();
+    }
+    WorkloadGroup* group =
+            _exec_env->workload_group_mgr()->get(params.query_options.workload_group);
+    if (group == nullptr) {
+        return Status::OK();
+    }
+    {
+        // The query already holds a slot if its context was created by another fragment.
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_fragments_ctx_map.find(params.params.query_id) != _fragments_ctx_map.end()) {
+            return Status::OK();
+        }
+    }
+    RETURN_IF_ERROR(group->try_acquire_query_slot());
+    fragments_ctx->workload_group = group;
+    return Status::OK();
+}
+
 Status FragmentMgr::cancel(const TUniqueId& fragment_id, const PPlanFragmentCancelReason& reason,
                            const std::string& msg) {
     std::shared_ptr<FragmentExecState> exec_state;
@@ -759,6 +889,41 @@ void FragmentMgr::debug(std::stringstream& ss) {
     }
 }
 
+void FragmentMgr::get_running_fragments(bool with_profile,
+                                        std::vector<RunningFragmentInfo>* fragments) {
+    // the profiles are copied out of the lock, the exec states are kept alive by the references
+    std::vector<std::shared_ptr<FragmentExecState>> exec_states;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        exec_states.reserve(_fragment_map.size());
+        for (auto& it : _fragment_map) {
+            exec_states.push_back(it.second);
+        }
+    }
+    DateTimeValue now = DateTimeValue::local_time();
+    fragments->reserve(fragments->size() + exec_states.size());
+    for (auto& exec_state : exec_states) {
+        RunningFragmentInfo info;
+        info.query_id = exec_state->query_id();
+        info.fragment_instance_id = exec_state->fragment_instance_id();
+        info.start_time = exec_state->start_time().debug_string();
+        info.elapsed_seconds = now.second_diff(exec_state->start_time());
+        RuntimeState* runtime_state = exec_state->executor()->runtime_state();
+        if (runtime_state != nullptr) {
+            MemTrackerLimiter* tracker = runtime_state->query_mem_tracker();
+            if (tracker != nullptr) {
+                info.query_mem_consumption = tracker->consumption();
+                info.query_peak_mem_consumption = tracker->peak_consumption();
+                info.query_mem_limit = tracker->limit();
+            }
+            if (with_profile) {
+                runtime_state->runtime_profile()->to_thrift(&info.profile);
+            }
+        }
+        fragments->push_back(std::move(info));
+    }
+}
+
 /*
  * 1. resolve opaqued_query_plan to thrift structure
  * 2. build TExecPlanFragmentParams
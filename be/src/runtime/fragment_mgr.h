@@ -26,6 +26,7 @@
 
 #include "common/status.h"
 #include "gen_cpp/DorisExternalService_types.h"
+#include "gen_cpp/RuntimeProfile_types.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "gutil/ref_counted.h"
@@ -33,6 +34,7 @@
 #include "runtime_filter_mgr.h"
 #include "util/countdown_latch.h"
 #include "util/hash_util.hpp"
+#include "util/lru_cache.hpp"
 #include "util/metrics.h"
 #include "util/thread.h"
 
@@ -41,16 +43,33 @@ namespace doris {
 class QueryFragmentsCtx;
 class ExecEnv;
 class FragmentExecState;
+class PipelineTaskScheduler;
 class PlanFragmentExecutor;
 class ThreadPool;
 class TExecPlanFragmentParams;
 class TExecPlanFragmentParamsList;
+class TPlanFragment;
 class TUniqueId;
 class RuntimeFilterMergeController;
 class StreamLoadPipe;
 
 std::string to_load_error_http_path(const std::string& file_name);
 
+// The live state of a fragment instance running on this BE.
+struct RunningFragmentInfo {
+    TUniqueId query_id;
+    TUniqueId fragment_instance_id;
+    std::string start_time;
+    int64_t elapsed_seconds = 0;
+    // the memory of the whole query on this BE, from its query mem tracker
+    int64_t query_mem_consumption = 0;
+    int64_t query_peak_mem_consumption = 0;
+    int64_t query_mem_limit = -1;
+    // the counters of the fragment and its operators so far, like the rows returned and the
+    // memory, spill and scan counters of each exec node
+    TRuntimeProfileTree profile;
+};
+
 // This class used to manage all the fragment execute in this instance
 class FragmentMgr : public RestMonitorIface {
 public:
@@ -67,6 +86,14 @@ public:
 
     Status start_query_execution(const PExecPlanFragmentStartRequest* request);
 
+    // Caches the plan fragments of the requests under their fragment_digest, and fills the ones
+    // the FE omitted from the cache. The digests cached are added to cached_digests. When some of
+    // the omitted fragments are no longer cached, returns NotFound with their digests in
+    // missing_digests, so that the FE sends them again before any request is executed.
+    Status resolve_fragment_templates(std::vector<TExecPlanFragmentParams>* params_list,
+                                      std::vector<std::string>* cached_digests,
+                                      std::vector<std::string>* missing_digests);
+
     Status cancel(const TUniqueId& fragment_id) {
         return cancel(fragment_id, PPlanFragmentCancelReason::INTERNAL_ERROR);
     }
@@ -78,6 +105,10 @@ public:
 
     virtual void debug(std::stringstream& ss);
 
+    // Collects the fragment instances that are running now, with their profiles only when
+    // with_profile is true.
+    void get_running_fragments(bool with_profile, std::vector<RunningFragmentInfo>* fragments);
+
     // input: TScanOpenParams fragment_instance_id
     // output: selected_columns
     // execute external query, all query info are packed in TScanOpenParams
@@ -96,6 +127,22 @@ public:
 private:
     void _exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb);
 
+    // Run the fragment as a PipelineTask on '_pipeline_task_scheduler' instead of holding a
+    // thread of '_thread_pool' until it is done.
+    Status _submit_pipeline_task(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb);
+
+    // Rejects a new query at once with a retryable status while the memory of the BE is above
+    // the admission watermark.
+    Status _check_memory_admission(const TExecPlanFragmentParams& params);
+
+    // Takes a query slot of the workload group of a new query, which its context holds until the
+    // last fragment of the query on this BE is done. Fails at once if the group is full.
+    Status _acquire_workload_group_slot(const TExecPlanFragmentParams& params,
+                                        QueryFragmentsCtx* fragments_ctx);
+
+    // Remove the exec state of a finished fragment and call its callback.
+    void _finish_fragment(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb);
+
     // This is input params
     ExecEnv* _exec_env;
 
@@ -112,11 +159,17 @@ private:
     scoped_refptr<Thread> _cancel_thread;
     // every job is a pool
     std::unique_ptr<ThreadPool> _thread_pool;
+    // Only created when config::enable_pipeline_exec_engine is set.
+    std::unique_ptr<PipelineTaskScheduler> _pipeline_task_scheduler;
 
     std::shared_ptr<MetricEntity> _entity = nullptr;
     UIntGauge* timeout_canceled_fragment_count = nullptr;
 
     RuntimeFilterMergeController _runtimefilter_controller;
+
+    // fragment digest -> the plan fragment sent under it
+    std::mutex _fragment_templates_lock;
+    LruCache<std::string, std::shared_ptr<const TPlanFragment>> _fragment_templates;
 };
 
 } // namespace doris
@@ -127,6 +127,13 @@ bool LoadChannel::_find_largest_consumption_channel(std::shared_ptr<TabletsChann
     return max_consume > 0;
 }
 
+void LoadChannel::get_tablets_channels(std::vector<std::shared_ptr<TabletsChannel>>* channels) {
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& it : _tablets_channels) {
+        channels->push_back(it.second);
+    }
+}
+
 bool LoadChannel::is_finished() {
     if (!_opened) {
         return false;
@@ -72,6 +72,9 @@ public:
 
     bool is_high_priority() const { return _is_high_priority; }
 
+    // append the tablets channels which are not finished yet to 'channels'
+    void get_tablets_channels(std::vector<std::shared_ptr<TabletsChannel>>* channels);
+
 protected:
     Status _get_tablets_channel(std::shared_ptr<TabletsChannel>& channel, bool& is_finished,
                                 const int64_t index_id);
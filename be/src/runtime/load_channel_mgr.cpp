@@ -17,6 +17,9 @@
 
 #include "runtime/load_channel_mgr.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "gutil/strings/substitute.h"
 #include "runtime/load_channel.h"
 #include "runtime/memory/mem_tracker.h"
@@ -172,6 +175,72 @@ void LoadChannelMgr::_handle_mem_exceed_limit() {
     channel->handle_mem_exceed_limit(true);
 }
 
+void LoadChannelMgr::_flush_memtables_if_soft_limit_exceeded() {
+    int64_t soft_limit = _mem_tracker->limit() * config::load_process_soft_mem_limit_percent / 100;
+    int64_t consumption = _mem_tracker->consumption();
+    if (soft_limit <= 0 || consumption < soft_limit) {
+        return;
+    }
+    std::unique_lock<std::mutex> flush_lock(_soft_limit_flush_lock, std::try_to_lock);
+    if (!flush_lock.owns_lock()) {
+        // another thread is flushing memtables
+        return;
+    }
+
+    std::vector<std::shared_ptr<TabletsChannel>> tablets_channels;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        for (auto& kv : _load_channels) {
+            kv.second->get_tablets_channels(&tablets_channels);
+        }
+    }
+
+    struct MemTableInfo {
+        TabletsChannel* channel;
+        int64_t tablet_id;
+        int64_t mem;
+    };
+    std::vector<MemTableInfo> memtables;
+    int64_t flushing_mem = 0;
+    for (auto& channel : tablets_channels) {
+        std::vector<std::pair<int64_t, int64_t>> tablet_memtable_mems;
+        channel->get_memtable_consumptions(&tablet_memtable_mems, &flushing_mem);
+        for (auto& [tablet_id, mem] : tablet_memtable_mems) {
+            memtables.push_back({channel.get(), tablet_id, mem});
+        }
+    }
+
+    // The mem of the memtables in flush queue is going to be released, so only the memtables
+    // being written beyond the half of the soft limit are flushed, the largest first, which
+    // avoids flushing many small memtables into small segments.
+    int64_t mem_to_flush = consumption - flushing_mem - soft_limit / 2;
+    if (mem_to_flush <= 0) {
+        return;
+    }
+    std::sort(memtables.begin(), memtables.end(),
+              [](const MemTableInfo& lhs, const MemTableInfo& rhs) { return lhs.mem > rhs.mem; });
+    std::unordered_map<TabletsChannel*, std::vector<int64_t>> channel_tablets;
+    int64_t sum = 0;
+    for (auto& memtable : memtables) {
+        if (sum >= mem_to_flush) {
+            break;
+        }
+        channel_tablets[memtable.channel].push_back(memtable.tablet_id);
+        sum += memtable.mem;
+    }
+    LOG(INFO) << "flush memtables of " << channel_tablets.size()
+              << " tablets channels in advance, mem to flush: " << sum
+              << ", mem being flushed: " << flushing_mem << ", total load mem consumption "
+              << consumption << " has exceeded soft limit " << soft_limit;
+    for (auto& [channel, tablet_ids] : channel_tablets) {
+        Status st = channel->flush_memtables(tablet_ids);
+        if (!st.ok()) {
+            // the error is returned to the load by its own writes later
+            LOG(WARNING) << "failed to flush memtables in advance, err: " << st;
+        }
+    }
+}
+
 Status LoadChannelMgr::cancel(const PTabletWriterCancelRequest& params) {
     UniqueId load_id(params.id());
     std::shared_ptr<LoadChannel> cancelled_channel;
@@ -67,12 +67,18 @@ private:
     // check if the total load mem consumption exceeds limit.
     // If yes, it will pick a load channel to try to reduce memory consumption.
     void _handle_mem_exceed_limit();
+    // check if the total load mem consumption exceeds the soft limit.
+    // If yes, it will submit the largest memtables of all load channels to flush, without
+    // waiting for them, until the memtables being written are below the half of the soft limit.
+    void _flush_memtables_if_soft_limit_exceeded();
 
     Status _start_bg_worker();
 
 protected:
     // lock protect the load channel map
     std::mutex _lock;
+    // lock so that only one thread flushes memtables when the soft limit is exceeded
+    std::mutex _soft_limit_flush_lock;
     // load id -> load channel
     std::unordered_map<UniqueId, std::shared_ptr<LoadChannel>> _load_channels;
     Cache* _last_success_channel = nullptr;
@@ -121,8 +127,11 @@ Status LoadChannelMgr::add_batch(const TabletWriterAddRequest& request,
         return status;
     }
 
+    // 2. check if mem consumption exceed limit
+    // The memtables are flushed in advance without waiting when the soft limit is exceeded,
+    // which does not block high priority load tasks.
+    _flush_memtables_if_soft_limit_exceeded();
     if (!channel->is_high_priority()) {
-        // 2. check if mem consumption exceed limit
         // If this is a high priority load task, do not handle this.
         // because this may block for a while, which may lead to rpc timeout.
         _handle_mem_exceed_limit();
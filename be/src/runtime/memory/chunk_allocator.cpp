@@ -38,6 +38,7 @@ ChunkAllocator* ChunkAllocator::_s_instance = nullptr;
 
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_local_core_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_other_core_alloc_count, MetricUnit::NOUNIT);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_remote_numa_node_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_free_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_alloc_cost_ns, MetricUnit::NANOSECONDS);
@@ -46,6 +47,7 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(chunk_pool_reserved_bytes, MetricUnit::NOUNIT
 
 static IntCounter* chunk_pool_local_core_alloc_count;
 static IntCounter* chunk_pool_other_core_alloc_count;
+static IntCounter* chunk_pool_remote_numa_node_alloc_count;
 static IntCounter* chunk_pool_system_alloc_count;
 static IntCounter* chunk_pool_system_free_count;
 static IntCounter* chunk_pool_system_alloc_cost_ns;
@@ -128,6 +130,8 @@ ChunkAllocator::ChunkAllocator(size_t reserve_limit)
             DorisMetrics::instance()->metric_registry()->register_entity("chunk_allocator");
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_local_core_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_other_core_alloc_count);
+    INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity,
+                                chunk_pool_remote_numa_node_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_free_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_alloc_cost_ns);
@@ -155,18 +159,30 @@ Status ChunkAllocator::allocate(size_t size, Chunk* chunk) {
     // When the reserved bytes is greater than the limit, the chunk is stolen from other arena.
     // Otherwise, it is allocated from the system first, which can reserve enough memory as soon as possible.
     // After that, allocate from current core arena as much as possible.
+    // The arenas of the cores on the same NUMA node are tried before the others, their chunks
+    // were most likely first touched on this node and are local memory.
     if (_reserved_bytes > _steal_arena_limit) {
-        ++core_id;
-        for (int i = 1; i < _arenas.size(); ++i, ++core_id) {
-            if (_arenas[core_id % _arenas.size()]->pop_free_chunk(size, &chunk->data)) {
-                DCHECK_GE(_reserved_bytes, 0);
-                _reserved_bytes.fetch_sub(size);
-                chunk_pool_other_core_alloc_count->increment(1);
-                // reset chunk's core_id to other
-                chunk->core_id = core_id % _arenas.size();
-                // transfer the memory ownership of allocate from ChunkAllocator::tracker to the tls tracker.
-                THREAD_MEM_TRACKER_TRANSFER_FROM(size, _mem_tracker.get());
-                return Status::OK();
+        const int numa_node = CpuInfo::get_numa_node_of_core(core_id);
+        for (int pass = 0; pass < 2; ++pass) {
+            const bool local = pass == 0;
+            for (int i = 1; i < _arenas.size(); ++i) {
+                int other_core_id = (core_id + i) % _arenas.size();
+                if ((CpuInfo::get_numa_node_of_core(other_core_id) == numa_node) != local) {
+                    continue;
+                }
+                if (_arenas[other_core_id]->pop_free_chunk(size, &chunk->data)) {
+                    DCHECK_GE(_reserved_bytes, 0);
+                    _reserved_bytes.fetch_sub(size);
+                    chunk_pool_other_core_alloc_count->increment(1);
+                    if (!local) {
+                        chunk_pool_remote_numa_node_alloc_count->increment(1);
+                    }
+                    // reset chunk's core_id to other
+                    chunk->core_id = other_core_id;
+                    // transfer the memory ownership from ChunkAllocator::tracker to the tls one
+                    THREAD_MEM_TRACKER_TRANSFER_FROM(size, _mem_tracker.get());
+                    return Status::OK();
+                }
             }
         }
     }
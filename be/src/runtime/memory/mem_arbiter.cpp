@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/mem_arbiter.h"
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "olap/page_cache.h"
+#include "olap/segment_loader.h"
+#include "runtime/memory/mmap_region_cache.h"
+#include "util/mem_info.h"
+#include "util/perf_counters.h"
+#include "util/pretty_printer.h"
+
+namespace doris {
+
+std::atomic<MemArbiter::Pressure> MemArbiter::_s_pressure {MemArbiter::NONE};
+
+MemArbiter::Pressure MemArbiter::pressure_of(int64_t used, int64_t limit) {
+    if (limit <= 0 || config::process_soft_mem_limit_percent <= 0) {
+        return NONE;
+    }
+    if (config::process_admission_mem_limit_percent > 0 &&
+        used >= limit / 100 * config::process_admission_mem_limit_percent) {
+        return ADMISSION;
+    }
+    if (used >= limit / 100 * config::process_soft_mem_limit_percent) {
+        return SPILL;
+    }
+    return NONE;
+}
+
+void MemArbiter::refresh() {
+    if (!MemInfo::initialized()) {
+        return;
+    }
+    int64_t used = PerfCounters::get_vm_rss();
+    Pressure pressure = pressure_of(used, MemInfo::mem_limit());
+    Pressure old_pressure = _s_pressure.exchange(pressure, std::memory_order_relaxed);
+    if (pressure != old_pressure) {
+        LOG(INFO) << "Process memory pressure changed from " << old_pressure << " to "
+                  << pressure << ", used=" << PrettyPrinter::print(used, TUnit::BYTES)
+                  << " limit=" << PrettyPrinter::print(MemInfo::mem_limit(), TUnit::BYTES);
+    }
+    if (pressure >= SPILL) {
+        _shrink_caches();
+    }
+}
+
+Status MemArbiter::check_admission() {
+    if (pressure() >= ADMISSION) {
+        return Status::TooManyTasks(
+                "the memory of the BE is above {}% of its limit, retry the query later",
+                config::process_admission_mem_limit_percent);
+    }
+    return Status::OK();
+}
+
+void MemArbiter::_shrink_caches() {
+    int64_t prune_num = 0;
+    if (StoragePageCache::instance() != nullptr) {
+        prune_num += StoragePageCache::instance()->prune();
+    }
+    if (SegmentLoader::instance() != nullptr) {
+        prune_num += SegmentLoader::instance()->prune_all();
+    }
+    if (prune_num > 0) {
+        LOG(INFO) << "prune " << prune_num << " cache entries under memory pressure";
+    }
+    int64_t freed_bytes = MmapRegionCache::instance()->clear();
+    if (freed_bytes > 0) {
+        LOG(INFO) << "free " << PrettyPrinter::print(freed_bytes, TUnit::BYTES)
+                  << " of cached mmap regions under memory pressure";
+    }
+}
+
+} // namespace doris
@@ -0,0 +1,60 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "common/status.h"
+
+namespace doris {
+
+// Arbitrates the memory of the BE process when it gets close to the limit, so that a query is
+// cancelled only if nothing else helped. The pressure goes up in steps:
+// 1. Above the soft watermark, the operators that can spill (aggregation and sort) spill their
+//    data even below their own threshold, the storage page cache and the segment cache drop
+//    their unused entries, and the cached mmap regions are unmapped.
+// 2. Above the admission watermark, the new queries are rejected with a retryable status, which
+//    the FE retries, until the pressure goes down.
+// The queries still fail with MemoryLimitExceeded when the hard limit of the process is hit.
+class MemArbiter {
+public:
+    enum Pressure { NONE = 0, SPILL = 1, ADMISSION = 2 };
+
+    // Updates the pressure from the physical memory of the process, and shrinks the caches
+    // while it is above the soft watermark. Called periodically.
+    static void refresh();
+
+    // The pressure of 'used' bytes of memory under the hard limit 'limit'.
+    static Pressure pressure_of(int64_t used, int64_t limit);
+
+    static Pressure pressure() { return _s_pressure.load(std::memory_order_relaxed); }
+
+    static bool should_spill() { return pressure() >= SPILL; }
+
+    // Returns TooManyTasks if the pressure is above the admission watermark. It never waits, so
+    // that it can be called from the rpc threads.
+    static Status check_admission();
+
+private:
+    static void _shrink_caches();
+
+    static std::atomic<Pressure> _s_pressure;
+};
+
+} // namespace doris
@@ -49,10 +49,11 @@ MemTrackerLimiter* MemTrackerTaskPool::register_task_mem_tracker_impl(const std:
 }
 
 MemTrackerLimiter* MemTrackerTaskPool::register_query_mem_tracker(const std::string& query_id,
-                                                                  int64_t mem_limit) {
-    return register_task_mem_tracker_impl(query_id, mem_limit,
-                                          fmt::format("Query#queryId={}", query_id),
-                                          ExecEnv::GetInstance()->query_pool_mem_tracker());
+                                                                  int64_t mem_limit,
+                                                                  MemTrackerLimiter* parent) {
+    return register_task_mem_tracker_impl(
+            query_id, mem_limit, fmt::format("Query#queryId={}", query_id),
+            parent != nullptr ? parent : ExecEnv::GetInstance()->query_pool_mem_tracker());
 }
 
 MemTrackerLimiter* MemTrackerTaskPool::register_load_mem_tracker(const std::string& load_id,
@@ -93,8 +94,14 @@ void MemTrackerTaskPool::logout_task_mem_tracker() {
             }
             // In order to ensure that the query pool mem tracker is the sum of all currently running query mem trackers,
             // the effect of the ended query mem tracker on the query pool mem tracker should be cleared, that is,
-            // the negative number of the current value of consume.
-            it->second->parent()->consumption_revise(-it->second->consumption());
+            // the negative number of the current value of consume. The same goes for the tracker
+            // of its workload group, between the query and the query pool.
+            for (MemTrackerLimiter* tracker = it->second->parent();
+                 tracker != nullptr &&
+                 tracker != ExecEnv::GetInstance()->process_mem_tracker();
+                 tracker = tracker->parent()) {
+                tracker->consumption_revise(-it->second->consumption());
+            }
             expired_tasks.emplace_back(it->first);
         } else {
             // Log limit exceeded query tracker.
@@ -40,7 +40,9 @@ public:
     MemTrackerLimiter* register_task_mem_tracker_impl(const std::string& task_id, int64_t mem_limit,
                                                       const std::string& label,
                                                       MemTrackerLimiter* parent);
-    MemTrackerLimiter* register_query_mem_tracker(const std::string& query_id, int64_t mem_limit);
+    // The tracker of the query is a child of 'parent', or of the query pool tracker if it is null.
+    MemTrackerLimiter* register_query_mem_tracker(const std::string& query_id, int64_t mem_limit,
+                                                  MemTrackerLimiter* parent = nullptr);
     MemTrackerLimiter* register_load_mem_tracker(const std::string& load_id, int64_t mem_limit);
 
     MemTrackerLimiter* get_task_mem_tracker(const std::string& task_id);
@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/mmap_region_cache.h"
+
+#include <sys/mman.h>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "runtime/memory/system_allocator.h"
+
+namespace doris {
+
+void* MmapRegionCache::get(size_t size) {
+    if (_cached_bytes.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _regions.find(size);
+    if (it == _regions.end()) {
+        return nullptr;
+    }
+    void* ptr = it->second.back();
+    it->second.pop_back();
+    if (it->second.empty()) {
+        _regions.erase(it);
+    }
+    _cached_bytes.fetch_sub(size, std::memory_order_relaxed);
+    return ptr;
+}
+
+bool MmapRegionCache::put(void* ptr, size_t size) {
+    if (_cached_bytes.load(std::memory_order_relaxed) + (int64_t)size >
+        config::mmap_region_cache_capacity_bytes) {
+        return false;
+    }
+    std::lock_guard<std::mutex> l(_lock);
+    _regions[size].push_back(ptr);
+    _cached_bytes.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+int64_t MmapRegionCache::clear() {
+    std::unordered_map<size_t, std::vector<void*>> regions;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        regions.swap(_regions);
+    }
+    int64_t freed_bytes = 0;
+    for (const auto& [size, ptrs] : regions) {
+        for (void* ptr : ptrs) {
+            if (SystemAllocator::use_huge_pages(size)) {
+                SystemAllocator::release_huge_pages(size);
+            }
+            if (munmap(ptr, size) != 0) {
+                LOG(WARNING) << "fail to munmap a cached region, errno=" << errno;
+            }
+            freed_bytes += size;
+        }
+    }
+    _cached_bytes.fetch_sub(freed_bytes, std::memory_order_relaxed);
+    return freed_bytes;
+}
+
+} // namespace doris
@@ -0,0 +1,60 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace doris {
+
+// Keeps the large anonymous mappings freed by the vectorized Allocator, so that the next
+// allocation of the same size, like a column of the next block of an operator, reuses the mapping
+// and its faulted pages instead of paying for mmap, munmap and the page faults again. The columns
+// grow to powers of two, so the sizes repeat. At most config::mmap_region_cache_capacity_bytes are
+// cached, and the cache is dropped under memory pressure.
+class MmapRegionCache {
+public:
+    static MmapRegionCache* instance() {
+        static MmapRegionCache cache;
+        return &cache;
+    }
+
+    // Returns a cached mapping of exactly 'size' bytes, or nullptr if there is none.
+    void* get(size_t size);
+
+    // Keeps the mapping of 'size' bytes at 'ptr'. Returns false if the cache is full, then the
+    // caller unmaps it.
+    bool put(void* ptr, size_t size);
+
+    // Unmaps all the cached mappings, returns the number of bytes freed.
+    int64_t clear();
+
+    int64_t cached_bytes() const { return _cached_bytes.load(std::memory_order_relaxed); }
+
+private:
+    std::mutex _lock;
+    // the cached mappings by size, the most recently cached last
+    std::unordered_map<size_t, std::vector<void*>> _regions;
+    std::atomic<int64_t> _cached_bytes {0};
+};
+
+} // namespace doris
@@ -29,6 +29,8 @@ namespace doris {
 
 #define PAGE_SIZE (4 * 1024) // 4K
 
+std::atomic<int64_t> SystemAllocator::_s_huge_page_bytes {0};
+
 uint8_t* SystemAllocator::allocate(size_t length) {
     if (config::use_mmap_allocate_chunk) {
         return allocate_via_mmap(length);
@@ -39,6 +41,9 @@ uint8_t* SystemAllocator::allocate(size_t length) {
 
 void SystemAllocator::free(uint8_t* ptr, size_t length) {
     if (config::use_mmap_allocate_chunk) {
+        if (use_huge_pages(length)) {
+            release_huge_pages(length);
+        }
         auto res = munmap(ptr, length);
         if (res != 0) {
             char buf[64];
@@ -76,7 +81,23 @@ uint8_t* SystemAllocator::allocate_via_mmap(size_t length) {
         RELEASE_THREAD_MEM_TRACKER(length);
         return nullptr;
     }
+    if (use_huge_pages(length)) {
+        advise_huge_pages(ptr, length);
+    }
     return ptr;
 }
 
+bool SystemAllocator::use_huge_pages(size_t length) {
+    return config::enable_huge_pages_for_large_allocations && length >= HUGE_PAGE_SIZE;
+}
+
+void SystemAllocator::advise_huge_pages(void* ptr, size_t length) {
+    _s_huge_page_bytes.fetch_add(length);
+    if (madvise(ptr, length, MADV_HUGEPAGE) != 0) {
+        char buf[64];
+        LOG_FIRST_N(WARNING, 1) << "fail to advise huge pages via madvise, errno=" << errno
+                                << ", errmsg=" << strerror_r(errno, buf, 64);
+    }
+}
+
 } // namespace doris
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -30,9 +31,25 @@ public:
 
     static void free(uint8_t* ptr, size_t length);
 
+    // Whether an mmap'ed region of length bytes is backed by transparent huge pages, that is
+    // config::enable_huge_pages_for_large_allocations and it's at least HUGE_PAGE_SIZE.
+    static bool use_huge_pages(size_t length);
+
+    // Advises the kernel to back the mmap'ed region with transparent huge pages, before its
+    // pages are touched. The region must be passed to release_huge_pages when it's unmapped.
+    static void advise_huge_pages(void* ptr, size_t length);
+    static void release_huge_pages(size_t length) { _s_huge_page_bytes.fetch_sub(length); }
+
+    // The bytes of the regions currently advised to be backed by huge pages.
+    static int64_t huge_page_bytes() { return _s_huge_page_bytes.load(); }
+
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
 private:
     static uint8_t* allocate_via_mmap(size_t length);
     static uint8_t* allocate_via_malloc(size_t length);
+
+    static std::atomic<int64_t> _s_huge_page_bytes;
 };
 
 } // namespace doris
@@ -59,9 +59,19 @@ public:
         DCHECK(_consumer_tracker_stack.empty());
     }
 
-    // only for tcmalloc hook
+    // only for tcmalloc hook, for the threads without a thread context. Like consume, the bytes
+    // are buffered in the thread and only consume the process tracker, shared by all threads, once
+    // they reach mem_tracker_consume_min_size_bytes, instead of on every allocation. The buffer
+    // is a trivial thread local that never allocates in the hook, so the bytes still buffered
+    // when such a thread exits are not tracked.
     static void consume_no_attach(int64_t size) {
-        ExecEnv::GetInstance()->process_mem_tracker()->consume(size);
+        static thread_local int64_t untracked_mem = 0;
+        untracked_mem += size;
+        if (untracked_mem >= config::mem_tracker_consume_min_size_bytes ||
+            untracked_mem <= -config::mem_tracker_consume_min_size_bytes) {
+            ExecEnv::GetInstance()->process_mem_tracker()->consume(untracked_mem);
+            untracked_mem = 0;
+        }
     }
 
     // After thread initialization, calling `init` again must call `clear_untracked_mems` first
@@ -0,0 +1,117 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/pipeline_task.h"
+
+#include "runtime/plan_fragment_executor.h"
+#include "runtime/runtime_state.h"
+#include "runtime/thread_context.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+PipelineTask::PipelineTask(PlanFragmentExecutor* executor, std::function<bool()> can_start,
+                           FinishCallback on_finish)
+        : _executor(executor), _can_start(std::move(can_start)), _on_finish(std::move(on_finish)) {}
+
+RuntimeState* PipelineTask::runtime_state() {
+    return _executor->runtime_state();
+}
+
+bool PipelineTask::is_blocked() {
+    if (!_opened) {
+        return _can_start && !_can_start();
+    }
+    return _is_fragment_blocked();
+}
+
+void PipelineTask::open() {
+    DCHECK(!_opened);
+    _opened = true;
+    _watch.start();
+    _state = _open_fragment().ok() ? State::RUNNABLE : State::FINISHED;
+}
+
+void PipelineTask::execute(int64_t time_slice_ns) {
+    if (is_blocked()) {
+        _state = State::BLOCKED;
+        return;
+    }
+    if (!_opened) {
+        _state = State::OPENING;
+        return;
+    }
+
+    MonotonicStopWatch slice_watch;
+    slice_watch.start();
+    while (true) {
+        if (_is_fragment_blocked()) {
+            _state = State::BLOCKED;
+            return;
+        }
+
+        bool eos = false;
+        _execute_fragment(&eos);
+        if (eos) {
+            _state = State::FINISHED;
+            return;
+        }
+
+        if (slice_watch.elapsed_time() >= time_slice_ns) {
+            _state = State::RUNNABLE;
+            return;
+        }
+    }
+}
+
+void PipelineTask::finish() {
+    _close_fragment();
+    _watch.stop();
+    _on_finish(this);
+}
+
+Status PipelineTask::_open_fragment() {
+    SCOPED_ATTACH_TASK(runtime_state());
+    auto st = _executor->open_pipeline();
+    if (!st.ok()) {
+        LOG(WARNING) << "Got error while opening fragment "
+                     << print_id(runtime_state()->fragment_instance_id()) << ": "
+                     << st.to_string();
+    }
+    return st;
+}
+
+Status PipelineTask::_execute_fragment(bool* eos) {
+    SCOPED_ATTACH_TASK(runtime_state());
+    auto st = _executor->execute_pipeline(eos);
+    if (*eos) {
+        WARN_IF_ERROR(st, "Got error while executing fragment " +
+                                  print_id(runtime_state()->fragment_instance_id()));
+    }
+    return st;
+}
+
+bool PipelineTask::_is_fragment_blocked() {
+    return _executor->is_pipeline_blocked();
+}
+
+void PipelineTask::_close_fragment() {
+    SCOPED_ATTACH_TASK(runtime_state());
+    _executor->close();
+}
+
+} // namespace doris
@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <functional>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+#include "util/stopwatch.hpp"
+
+namespace doris {
+
+class PlanFragmentExecutor;
+class RuntimeState;
+
+// A fragment instance run by the PipelineTaskScheduler. Instead of holding a thread until the
+// fragment is done, the task runs the fragment block by block for a time slice, and gives its
+// worker back as soon as the next block would wait for an exchange, a scan or the sink. The
+// scheduler polls the blocked tasks and runs them again once their input or output is ready.
+//
+// Opening the plan is a single blocking step, the nodes consuming their whole input in open(),
+// such as aggregations, sorts and the build side of hash joins, wait for the other fragments
+// meanwhile. So the workers never open a task, they hand it to the open pool of the scheduler,
+// and the task becomes runnable again once it is open.
+class PipelineTask {
+public:
+    enum class State {
+        RUNNABLE,
+        BLOCKED,
+        // The task has to be opened before it can execute.
+        OPENING,
+        FINISHED,
+    };
+
+    using FinishCallback = std::function<void(PipelineTask*)>;
+
+    // 'can_start' tells whether the fragment may start executing, it may be empty.
+    PipelineTask(PlanFragmentExecutor* executor, std::function<bool()> can_start,
+                 FinishCallback on_finish);
+    virtual ~PipelineTask() = default;
+
+    // Run the fragment until it blocks, finishes or has run for 'time_slice_ns'. The state is
+    // OPENING instead if the fragment is not open yet.
+    void execute(int64_t time_slice_ns);
+
+    // Open the fragment, which may block until the input of the blocking nodes is consumed.
+    // The state is RUNNABLE afterwards, or FINISHED if the open failed.
+    void open();
+
+    // Whether a blocked task still has to wait, called by the scheduler to wake it up.
+    bool is_blocked();
+
+    // Close the fragment and call the finish callback. The task is deleted afterwards.
+    void finish();
+
+    State state() const { return _state; }
+
+    RuntimeState* runtime_state();
+
+    // The wall time since the task executed for the first time.
+    int64_t elapsed_time_ns() const { return _watch.elapsed_time(); }
+
+protected:
+    // The steps of the fragment, overridden by the tests.
+    virtual Status _open_fragment();
+    virtual Status _execute_fragment(bool* eos);
+    virtual bool _is_fragment_blocked();
+    virtual void _close_fragment();
+
+private:
+    PlanFragmentExecutor* _executor;
+    std::function<bool()> _can_start;
+    FinishCallback _on_finish;
+
+    State _state = State::RUNNABLE;
+    bool _opened = false;
+    MonotonicStopWatch _watch;
+};
+
+} // namespace doris
@@ -0,0 +1,192 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/pipeline_task_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "common/config.h"
+#include "runtime/pipeline_task.h"
+#include "util/threadpool.h"
+
+namespace doris {
+
+// How long the poller waits before checking the blocked tasks again when none of them woke up,
+// the wait doubles up to the max while they stay blocked.
+static constexpr auto MIN_BLOCKED_TASK_POLL_INTERVAL = std::chrono::microseconds(100);
+static constexpr auto MAX_BLOCKED_TASK_POLL_INTERVAL = std::chrono::microseconds(5000);
+
+PipelineTaskScheduler::~PipelineTaskScheduler() {
+    shutdown();
+}
+
+Status PipelineTaskScheduler::start() {
+    RETURN_IF_ERROR(ThreadPoolBuilder("PipelineTaskWorker")
+                            .set_min_threads(_num_workers)
+                            .set_max_threads(_num_workers)
+                            .build(&_workers));
+    RETURN_IF_ERROR(ThreadPoolBuilder("PipelineTaskOpen")
+                            .set_min_threads(0)
+                            .set_max_threads(_max_open_threads)
+                            .build(&_open_pool));
+    for (int i = 0; i < _num_workers; ++i) {
+        RETURN_IF_ERROR(_workers->submit_func([this]() { _work(); }));
+    }
+    return Thread::create(
+            "PipelineTaskScheduler", "blocked_task_poller", [this]() { _poll_blocked_tasks(); },
+            &_blocked_task_poller);
+}
+
+void PipelineTaskScheduler::shutdown() {
+    if (_shutdown.exchange(true)) {
+        return;
+    }
+    _runnable_cv.notify_all();
+    _blocked_cv.notify_all();
+    if (_workers) {
+        _workers->shutdown();
+    }
+    // The opens in flight put their task back in the queues, which are cleared below.
+    if (_open_pool) {
+        _open_pool->shutdown();
+    }
+    if (_blocked_task_poller) {
+        _blocked_task_poller->join();
+    }
+
+    for (auto task : _runnable_tasks) {
+        delete task;
+    }
+    _runnable_tasks.clear();
+    for (auto task : _blocked_tasks) {
+        delete task;
+    }
+    _blocked_tasks.clear();
+}
+
+Status PipelineTaskScheduler::submit(std::unique_ptr<PipelineTask> task) {
+    if (_shutdown) {
+        return Status::InternalError("pipeline task scheduler is shut down");
+    }
+    _make_runnable(task.release());
+    return Status::OK();
+}
+
+void PipelineTaskScheduler::_dispatch(PipelineTask* task) {
+    switch (task->state()) {
+    case PipelineTask::State::RUNNABLE:
+        _make_runnable(task);
+        break;
+    case PipelineTask::State::BLOCKED:
+        _make_blocked(task);
+        break;
+    case PipelineTask::State::OPENING:
+        _open(task);
+        break;
+    case PipelineTask::State::FINISHED:
+        task->finish();
+        delete task;
+        break;
+    }
+}
+
+void PipelineTaskScheduler::_make_runnable(PipelineTask* task) {
+    {
+        std::lock_guard<std::mutex> l(_runnable_lock);
+        _runnable_tasks.push_back(task);
+    }
+    _runnable_cv.notify_one();
+}
+
+void PipelineTaskScheduler::_make_blocked(PipelineTask* task) {
+    {
+        std::lock_guard<std::mutex> l(_blocked_lock);
+        _blocked_tasks.push_back(task);
+    }
+    _blocked_cv.notify_one();
+}
+
+void PipelineTaskScheduler::_open(PipelineTask* task) {
+    auto st = _open_pool->submit_func([this, task]() {
+        task->open();
+        _dispatch(task);
+    });
+    if (!st.ok()) {
+        // Only happens once the scheduler is shut down, which drops the unfinished tasks.
+        LOG(WARNING) << "Failed to open a pipeline task: " << st.to_string();
+        delete task;
+    }
+}
+
+void PipelineTaskScheduler::_work() {
+    while (!_shutdown) {
+        PipelineTask* task = nullptr;
+        {
+            std::unique_lock<std::mutex> l(_runnable_lock);
+            _runnable_cv.wait(l, [this] { return _shutdown || !_runnable_tasks.empty(); });
+            if (_shutdown) {
+                return;
+            }
+            task = _runnable_tasks.front();
+            _runnable_tasks.pop_front();
+        }
+
+        task->execute(config::pipeline_task_time_slice_ms * 1000 * 1000);
+        _dispatch(task);
+    }
+}
+
+void PipelineTaskScheduler::_poll_blocked_tasks() {
+    auto poll_interval = MIN_BLOCKED_TASK_POLL_INTERVAL;
+    while (!_shutdown) {
+        std::vector<PipelineTask*> ready_tasks;
+        {
+            std::unique_lock<std::mutex> l(_blocked_lock);
+            _blocked_cv.wait(l, [this] { return _shutdown || !_blocked_tasks.empty(); });
+            for (auto it = _blocked_tasks.begin(); it != _blocked_tasks.end();) {
+                if ((*it)->is_blocked()) {
+                    ++it;
+                } else {
+                    ready_tasks.push_back(*it);
+                    it = _blocked_tasks.erase(it);
+                }
+            }
+
+            if (ready_tasks.empty()) {
+                // A newly blocked task is checked right away, and resets the backoff.
+                size_t num_blocked_tasks = _blocked_tasks.size();
+                if (_blocked_cv.wait_for(l, poll_interval, [&] {
+                        return _shutdown || _blocked_tasks.size() != num_blocked_tasks;
+                    })) {
+                    poll_interval = MIN_BLOCKED_TASK_POLL_INTERVAL;
+                } else {
+                    poll_interval = std::min(poll_interval * 2, MAX_BLOCKED_TASK_POLL_INTERVAL);
+                }
+                continue;
+            }
+        }
+
+        poll_interval = MIN_BLOCKED_TASK_POLL_INTERVAL;
+        for (auto task : ready_tasks) {
+            _make_runnable(task);
+        }
+    }
+}
+
+} // namespace doris
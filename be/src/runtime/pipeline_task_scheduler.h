@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "common/status.h"
+#include "gutil/ref_counted.h"
+#include "util/thread.h"
+
+namespace doris {
+
+class PipelineTask;
+class ThreadPool;
+
+// Runs PipelineTasks on a fixed number of worker threads. A worker takes a runnable task, runs
+// it for a time slice, and puts it back at the end of the runnable queue, or in the blocked
+// list if it waits for its input or output. A poller thread moves the blocked tasks whose wait
+// is over back to the runnable queue, it sleeps while no task is blocked, and backs off while
+// none of them wakes up.
+//
+// The tasks are opened on a separate pool of up to 'max_open_threads' threads, so the workers
+// keep executing the open tasks while the others wait for their input in open().
+class PipelineTaskScheduler {
+public:
+    PipelineTaskScheduler(int num_workers, int max_open_threads)
+            : _num_workers(num_workers), _max_open_threads(max_open_threads) {}
+    ~PipelineTaskScheduler();
+
+    Status start();
+
+    // Stop the workers and the poller, the tasks not finished yet are dropped.
+    void shutdown();
+
+    // The scheduler takes the ownership of the task.
+    Status submit(std::unique_ptr<PipelineTask> task);
+
+private:
+    void _work();
+    void _poll_blocked_tasks();
+    // Move the task to the queue or the list of its state, or finish it.
+    void _dispatch(PipelineTask* task);
+    void _make_runnable(PipelineTask* task);
+    void _make_blocked(PipelineTask* task);
+    void _open(PipelineTask* task);
+
+    const int _num_workers;
+    const int _max_open_threads;
+    std::atomic<bool> _shutdown {false};
+
+    std::mutex _runnable_lock;
+    std::condition_variable _runnable_cv;
+    std::deque<PipelineTask*> _runnable_tasks;
+
+    std::mutex _blocked_lock;
+    std::condition_variable _blocked_cv;
+    std::list<PipelineTask*> _blocked_tasks;
+
+    std::unique_ptr<ThreadPool> _workers;
+    std::unique_ptr<ThreadPool> _open_pool;
+    scoped_refptr<Thread> _blocked_task_poller;
+};
+
+} // namespace doris
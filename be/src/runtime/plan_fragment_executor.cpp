@@ -213,6 +213,52 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request,
 }
 
 Status PlanFragmentExecutor::open() {
+    _log_open();
+    _start_report_thread();
+    Status status = Status::OK();
+    if (_runtime_state->enable_vectorized_exec()) {
+        status = open_vectorized_internal();
+    } else {
+        status = open_internal();
+    }
+    return _update_open_status(status);
+}
+
+Status PlanFragmentExecutor::open_pipeline() {
+    DCHECK(_runtime_state->enable_vectorized_exec());
+    _log_open();
+    _start_report_thread();
+    Status status = _open_vectorized_plan_and_sink();
+    if (!status.ok()) {
+        return _update_open_status(status);
+    }
+    return Status::OK();
+}
+
+bool PlanFragmentExecutor::is_pipeline_blocked() {
+    if (_done || _runtime_state->is_cancelled()) {
+        return false;
+    }
+    return !_plan->can_read() || (_sink != nullptr && !_sink->can_write());
+}
+
+Status PlanFragmentExecutor::execute_pipeline(bool* eos) {
+    Status status = _send_vectorized_block(eos);
+    if (status.ok() && !*eos) {
+        return Status::OK();
+    }
+
+    if (_sink != nullptr) {
+        _sink->end_send_span();
+    }
+    if (status.ok()) {
+        status = _close_vectorized_sink();
+    }
+    *eos = true;
+    return _update_open_status(status);
+}
+
+void PlanFragmentExecutor::_log_open() {
     int64_t mem_limit = _runtime_state->instance_mem_tracker()->limit();
     TAG(LOG(INFO))
             .log("PlanFragmentExecutor::open, using query memory limit: " +
@@ -220,7 +266,9 @@ Status PlanFragmentExecutor::open() {
             .query_id(_query_id)
             .instance_id(_runtime_state->fragment_instance_id())
             .tag("mem_limit", std::to_string(mem_limit));
+}
 
+void PlanFragmentExecutor::_start_report_thread() {
     // we need to start the profile-reporting thread before calling Open(), since it
     // may block
     // TODO: if no report thread is started, make sure to send a final profile
@@ -232,13 +280,9 @@ Status PlanFragmentExecutor::open() {
         // with stop_report_thread()
         _report_thread_started_cv.wait(l);
     }
-    Status status = Status::OK();
-    if (_runtime_state->enable_vectorized_exec()) {
-        status = open_vectorized_internal();
-    } else {
-        status = open_internal();
-    }
+}
 
+Status PlanFragmentExecutor::_update_open_status(Status status) {
     if (!status.ok() && !status.is_cancelled() && _runtime_state->log_has_space()) {
         // Log error message in addition to returning in Status. Queries that do not
         // fetch results (e.g. insert) may not receive the message directly and can
@@ -258,6 +302,23 @@ Status PlanFragmentExecutor::open() {
 }
 
 Status PlanFragmentExecutor::open_vectorized_internal() {
+    RETURN_IF_ERROR(_open_vectorized_plan_and_sink());
+    if (_sink == nullptr) {
+        return Status::OK();
+    }
+
+    {
+        auto sink_send_span_guard = Defer {[this]() { this->_sink->end_send_span(); }};
+        bool eos = false;
+        while (!eos) {
+            RETURN_IF_ERROR(_send_vectorized_block(&eos));
+        }
+    }
+
+    return _close_vectorized_sink();
+}
+
+Status PlanFragmentExecutor::_open_vectorized_plan_and_sink() {
     {
         SCOPED_CPU_TIMER(_fragment_cpu_timer);
         SCOPED_TIMER(profile()->total_time_counter());
@@ -270,34 +331,45 @@ Status PlanFragmentExecutor::open_vectorized_internal() {
         SCOPED_CPU_TIMER(_fragment_cpu_timer);
         RETURN_IF_ERROR(_sink->open(runtime_state()));
     }
+    return Status::OK();
+}
+
+Status PlanFragmentExecutor::_send_vectorized_block(bool* eos) {
+    // Without a sink the fragment is done once the plan is open.
+    if (_sink == nullptr) {
+        *eos = true;
+        return Status::OK();
+    }
 
+    doris::vectorized::Block* block;
     {
-        auto sink_send_span_guard = Defer {[this]() { this->_sink->end_send_span(); }};
-        while (true) {
-            doris::vectorized::Block* block;
+        SCOPED_CPU_TIMER(_fragment_cpu_timer);
+        RETURN_IF_ERROR(get_vectorized_internal(&block));
+    }
 
-            {
-                SCOPED_CPU_TIMER(_fragment_cpu_timer);
-                RETURN_IF_ERROR(get_vectorized_internal(&block));
-            }
+    if (block == NULL) {
+        *eos = true;
+        return Status::OK();
+    }
 
-            if (block == NULL) {
-                break;
-            }
+    SCOPED_TIMER(profile()->total_time_counter());
+    SCOPED_CPU_TIMER(_fragment_cpu_timer);
+    // Collect this plan and sub plan statistics, and send to parent plan.
+    if (_collect_query_statistics_with_every_batch) {
+        _collect_query_statistics();
+    }
 
-            SCOPED_TIMER(profile()->total_time_counter());
-            SCOPED_CPU_TIMER(_fragment_cpu_timer);
-            // Collect this plan and sub plan statistics, and send to parent plan.
-            if (_collect_query_statistics_with_every_batch) {
-                _collect_query_statistics();
-            }
+    auto st = _sink->send(runtime_state(), block);
+    if (st.is_end_of_file()) {
+        *eos = true;
+        return Status::OK();
+    }
+    return st;
+}
 
-            auto st = _sink->send(runtime_state(), block);
-            if (st.is_end_of_file()) {
-                break;
-            }
-            RETURN_IF_ERROR(st);
-        }
+Status PlanFragmentExecutor::_close_vectorized_sink() {
+    if (_sink == nullptr) {
+        return Status::OK();
     }
 
     {
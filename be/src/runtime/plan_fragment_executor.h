@@ -112,6 +112,17 @@ public:
     // time when open() returns, and the status-reporting thread will have been stopped.
     Status open();
 
+    // The steps of open() for a vectorized fragment with a sink, run by a PipelineTask so that
+    // the fragment gives its worker thread back whenever it would block, see
+    // runtime/pipeline_task.h. open_pipeline() opens the plan and the sink, then each call to
+    // execute_pipeline() sends one block to the sink, until '*eos' is set, which means the sink
+    // has been closed and the final report sent, or an error occurred.
+    Status open_pipeline();
+    Status execute_pipeline(bool* eos);
+
+    // True if the plan has no data ready to be read, or the sink can't accept a block yet.
+    bool is_pipeline_blocked();
+
     // Return results through 'batch'. Sets '*batch' to nullptr if no more results.
     // '*batch' is owned by PlanFragmentExecutor and must not be deleted.
     // When *batch == nullptr, get_next() should not be called anymore. Also, report_status_cb
@@ -242,6 +253,15 @@ private:
     // have been stopped. _sink will be set to nullptr after successful execution.
     Status open_internal();
     Status open_vectorized_internal();
+    Status _open_vectorized_plan_and_sink();
+    // Send the next block of the plan to the sink, '*eos' is set once there is nothing to send.
+    Status _send_vectorized_block(bool* eos);
+    Status _close_vectorized_sink();
+
+    void _log_open();
+    void _start_report_thread();
+    // Log the error of open(), translate the cancel reason and update _status.
+    Status _update_open_status(Status status);
 
     // Executes get_next() logic and returns resulting status.
     Status get_next_internal(RowBatch** batch);
@@ -25,7 +25,10 @@
 #include "gen_cpp/Types_types.h"               // for TUniqueId
 #include "runtime/datetime_value.h"
 #include "runtime/exec_env.h"
+#include "runtime/runtime_filter_mgr.h"
+#include "runtime/workload_group.h"
 #include "util/threadpool.h"
+#include "vec/runtime/shared_hash_table_controller.h"
 
 namespace doris {
 
@@ -38,6 +41,13 @@ public:
     QueryFragmentsCtx(int total_fragment_num, ExecEnv* exec_env)
             : fragment_num(total_fragment_num), timeout_second(-1), _exec_env(exec_env) {
         _start_time = DateTimeValue::local_time();
+        _shared_hash_table_controller.reset(new vectorized::SharedHashTableController());
+    }
+
+    ~QueryFragmentsCtx() {
+        if (workload_group != nullptr) {
+            workload_group->release_query_slot();
+        }
     }
 
     bool countdown() { return fragment_num.fetch_sub(1) == 1; }
@@ -70,6 +80,16 @@ public:
         _start_cond.notify_all();
     }
 
+    vectorized::SharedHashTableController* get_shared_hash_table_controller() {
+        return _shared_hash_table_controller.get();
+    }
+
+    RuntimeFilterLocalMerger* get_runtime_filter_local_merger() {
+        return &_runtime_filter_local_merger;
+    }
+
+    bool is_ready_to_execute() const { return _ready_to_execute.load(); }
+
     void wait_for_start() {
         std::unique_lock<std::mutex> l(_start_lock);
         while (!_ready_to_execute.load()) {
@@ -83,6 +103,8 @@ public:
     bool set_rsc_info = false;
     std::string user;
     std::string group;
+    // the workload group whose query slot the query holds on this BE, if any
+    WorkloadGroup* workload_group = nullptr;
     TNetworkAddress coord_addr;
     TQueryGlobals query_globals;
 
@@ -113,6 +135,12 @@ private:
     // Only valid when _need_wait_execution_trigger is set to true in FragmentExecState.
     // And all fragments of this query will start execution when this is set to true.
     std::atomic<bool> _ready_to_execute {false};
+
+    // Shares the hash tables of broadcast joins among the fragment instances of this query.
+    std::unique_ptr<vectorized::SharedHashTableController> _shared_hash_table_controller;
+
+    // Merges the runtime filters produced by the fragment instances of this query.
+    RuntimeFilterLocalMerger _runtime_filter_local_merger;
 };
 
 } // namespace doris
@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "gutil/strings/split.h"
@@ -171,13 +172,14 @@ Status KafkaDataConsumer::assign_topic_partitions(
     return Status::OK();
 }
 
-Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
+Status KafkaDataConsumer::group_consume(BlockingQueue<KafkaMessageBatch*>* queue,
                                         int64_t max_running_time_ms) {
     static constexpr int MAX_RETRY_TIMES_FOR_TRANSPORT_FAILURE = 3;
     int64_t left_time = max_running_time_ms;
     LOG(INFO) << "start kafka consumer: " << _id << ", grp: " << _grp_id
               << ", max running time(ms): " << left_time;
 
+    const size_t max_batch_messages = std::max(1, config::routine_load_consumer_batch_messages);
     int64_t received_rows = 0;
     int64_t put_rows = 0;
     int32_t retry_times = 0;
@@ -185,6 +187,7 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
     MonotonicStopWatch consumer_watch;
     MonotonicStopWatch watch;
     watch.start();
+    auto batch = std::make_unique<KafkaMessageBatch>();
     while (true) {
         {
             std::unique_lock<std::mutex> l(_lock);
@@ -198,29 +201,30 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
         }
 
         bool done = false;
-        // consume 1 message at a time
+        // wait for the first message of a batch, the others are taken from the
+        // messages already fetched by librdkafka, without waiting
         consumer_watch.start();
-        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(1000 /* timeout, ms */));
+        std::unique_ptr<RdKafka::Message> msg(
+                _k_consumer->consume(batch->empty() ? 1000 /* timeout, ms */ : 0));
         consumer_watch.stop();
-        switch (msg->err()) {
+        RdKafka::ErrorCode err = msg->err();
+        switch (err) {
         case RdKafka::ERR_NO_ERROR:
             if (msg->len() == 0) {
                 // ignore msg with length 0.
                 // put empty msg into queue will cause the load process shutting down.
                 break;
-            } else if (!queue->blocking_put(msg.get())) {
-                // queue is shutdown
-                done = true;
-            } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
             }
+            // msg will be deleted after being processed
+            batch->push_back(std::move(msg));
             ++received_rows;
             break;
         case RdKafka::ERR__TIMED_OUT:
             // leave the status as OK, because this may happened
             // if there is no data in kafka.
-            LOG(INFO) << "kafka consume timeout: " << _id;
+            if (batch->empty()) {
+                LOG(INFO) << "kafka consume timeout: " << _id;
+            }
             break;
         case RdKafka::ERR__TRANSPORT:
             LOG(INFO) << "kafka consume Disconnected: " << _id
@@ -236,12 +240,32 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
             break;
         }
 
+        // hand the batch over when it is full, or no more message is fetched
+        if (!done && !batch->empty() &&
+            (batch->size() >= max_batch_messages || err != RdKafka::ERR_NO_ERROR)) {
+            size_t batch_size = batch->size();
+            if (!put_batch(queue, &batch)) {
+                // queue is shutdown
+                done = true;
+            } else {
+                put_rows += batch_size;
+            }
+        }
+
         left_time = max_running_time_ms - watch.elapsed_time() / 1000 / 1000;
         if (done) {
             break;
         }
     }
 
+    // the messages fetched since the last batch are handed over too, unless the group is done
+    if (!batch->empty()) {
+        size_t batch_size = batch->size();
+        if (put_batch(queue, &batch)) {
+            put_rows += batch_size;
+        }
+    }
+
     LOG(INFO) << "kafka consumer done: " << _id << ", grp: " << _grp_id
               << ". cancelled: " << _cancelled << ", left time(ms): " << left_time
               << ", total cost(ms): " << watch.elapsed_time() / 1000 / 1000
@@ -251,6 +275,17 @@ Status KafkaDataConsumer::group_consume(BlockingQueue<RdKafka::Message*>* queue,
     return st;
 }
 
+bool KafkaDataConsumer::put_batch(BlockingQueue<KafkaMessageBatch*>* queue,
+                                  std::unique_ptr<KafkaMessageBatch>* batch) {
+    if (!queue->blocking_put(batch->get())) {
+        return false;
+    }
+    // release the ownership, the batch will be deleted after being processed
+    batch->release();
+    *batch = std::make_unique<KafkaMessageBatch>();
+    return true;
+}
+
 Status KafkaDataConsumer::get_partition_meta(std::vector<int32_t>* partition_ids) {
     // create topic conf
     RdKafka::Conf* tconf = RdKafka::Conf::create(RdKafka::Conf::CONF_TOPIC);
@@ -18,8 +18,10 @@
 #pragma once
 
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/stream_load/stream_load_context.h"
@@ -32,6 +34,9 @@ class KafkaConsumerPipe;
 class Status;
 class StreamLoadPipe;
 
+// the kafka messages handed from a consumer to its consumer group at once
+using KafkaMessageBatch = std::vector<std::unique_ptr<RdKafka::Message>>;
+
 class DataConsumer {
 public:
     DataConsumer(StreamLoadContext* ctx)
@@ -137,8 +142,13 @@ public:
     Status assign_topic_partitions(const std::map<int32_t, int64_t>& begin_partition_offset,
                                    const std::string& topic, StreamLoadContext* ctx);
 
-    // start the consumer and put msgs to queue
-    Status group_consume(BlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms);
+    // start the consumer and put msgs to queue, in batches of the messages already fetched
+    Status group_consume(BlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms);
+
+    // Hand the batch over to the queue and start a new one. Returns false, keeping the batch, if
+    // the queue is shutdown.
+    static bool put_batch(BlockingQueue<KafkaMessageBatch*>* queue,
+                          std::unique_ptr<KafkaMessageBatch>* batch);
 
     // get the partitions ids of the topic
     Status get_partition_meta(std::vector<int32_t>* partition_ids);
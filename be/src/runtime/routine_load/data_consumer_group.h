@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include "common/config.h"
 #include "runtime/routine_load/data_consumer.h"
 #include "util/blocking_queue.hpp"
 #include "util/priority_thread_pool.hpp"
@@ -30,7 +33,11 @@ class DataConsumerGroup {
 public:
     typedef std::function<void(const Status&)> ConsumeFinishCallback;
 
-    DataConsumerGroup() : _grp_id(UniqueId::gen_uid()), _thread_pool(3, 10), _counter(0) {}
+    // a thread for each consumer of the group, which has at most max_consumer_num_per_group
+    DataConsumerGroup()
+            : _grp_id(UniqueId::gen_uid()),
+              _thread_pool(std::max(1, config::max_consumer_num_per_group), 10),
+              _counter(0) {}
 
     virtual ~DataConsumerGroup() { _consumers.clear(); }
 
@@ -63,7 +70,7 @@ protected:
 // for kafka
 class KafkaDataConsumerGroup : public DataConsumerGroup {
 public:
-    KafkaDataConsumerGroup() : DataConsumerGroup(), _queue(500) {}
+    KafkaDataConsumerGroup() : DataConsumerGroup(), _queue(queue_capacity()) {}
 
     virtual ~KafkaDataConsumerGroup();
 
@@ -71,15 +78,21 @@ public:
     // assign topic partitions to all consumers equally
     Status assign_topic_partitions(StreamLoadContext* ctx);
 
+    // The number of batches the queue holds, so that it holds about as many messages as the 500
+    // it held when the consumers put the messages one by one.
+    static int queue_capacity() {
+        return std::max(1, 500 / std::max(1, config::routine_load_consumer_batch_messages));
+    }
+
 private:
     // start a single consumer
     void actual_consume(std::shared_ptr<DataConsumer> consumer,
-                        BlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms,
+                        BlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms,
                         ConsumeFinishCallback cb);
 
 private:
-    // blocking queue to receive msgs from all consumers
-    BlockingQueue<RdKafka::Message*> _queue;
+    // blocking queue to receive the batches of msgs from all consumers
+    BlockingQueue<KafkaMessageBatch*> _queue;
 };
 
 } // end namespace doris
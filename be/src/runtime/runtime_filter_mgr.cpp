@@ -20,6 +20,7 @@
 #include <string>
 
 #include "client_cache.h"
+#include "common/config.h"
 #include "exprs/runtime_filter.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/exec_env.h"
@@ -32,14 +33,6 @@
 
 namespace doris {
 
-template <class RPCRequest, class RPCResponse>
-struct async_rpc_context {
-    RPCRequest request;
-    RPCResponse response;
-    brpc::Controller cntl;
-    brpc::CallId cid;
-};
-
 RuntimeFilterMgr::RuntimeFilterMgr(const UniqueId& query_id, RuntimeState* state) : _state(state) {}
 
 RuntimeFilterMgr::~RuntimeFilterMgr() {}
@@ -107,6 +100,15 @@ Status RuntimeFilterMgr::regist_filter(const RuntimeFilterRole role, const TRunt
 
     filter_map->emplace(key, filter_mgr_val);
 
+    auto local_iter = _local_builder_num.find(key);
+    // only the filters without local targets are sent to the merge instance
+    if (role == RuntimeFilterRole::PRODUCER && !desc.has_local_targets &&
+        local_iter != _local_builder_num.end() && local_iter->second > 1 &&
+        _state->get_query_fragments_ctx() != nullptr) {
+        _local_merger = _state->get_query_fragments_ctx()->get_runtime_filter_local_merger();
+        RETURN_IF_ERROR(_local_merger->register_filter(desc, options, local_iter->second));
+    }
+
     return Status::OK();
 }
 
@@ -126,6 +128,9 @@ void RuntimeFilterMgr::set_runtime_filter_params(
         const TRuntimeFilterParams& runtime_filter_params) {
     this->_merge_addr = runtime_filter_params.runtime_filter_merge_addr;
     this->_has_merge_addr = true;
+    if (runtime_filter_params.__isset.runtime_filter_local_builder_num) {
+        _local_builder_num = runtime_filter_params.runtime_filter_local_builder_num;
+    }
 }
 
 Status RuntimeFilterMgr::get_merge_addr(TNetworkAddress* addr) {
@@ -137,6 +142,65 @@ Status RuntimeFilterMgr::get_merge_addr(TNetworkAddress* addr) {
     return Status::InternalError("not found merge addr");
 }
 
+Status RuntimeFilterMgr::local_merge(IRuntimeFilter* filter, int* merged_producer_num,
+                                     bool* is_last) {
+    *merged_producer_num = 1;
+    *is_last = true;
+    auto iter = _local_builder_num.find(filter->filter_id());
+    if (_local_merger == nullptr || iter == _local_builder_num.end() || iter->second <= 1) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_local_merger->merge(filter, is_last));
+    *merged_producer_num = iter->second;
+    return Status::OK();
+}
+
+Status RuntimeFilterLocalMerger::register_filter(const TRuntimeFilterDesc& desc,
+                                                 const TQueryOptions& options, int producer_num) {
+    std::lock_guard<std::mutex> guard(_filter_map_mutex);
+    if (_filter_map.count(desc.filter_id)) {
+        return Status::OK();
+    }
+    auto val = std::make_shared<LocalMergeVal>();
+    val->producer_num = producer_num;
+    val->runtime_filter_desc = desc;
+    val->filter = val->pool.add(new IRuntimeFilter(nullptr, &val->pool));
+    RETURN_IF_ERROR(val->filter->init_with_desc(&val->runtime_filter_desc, &options));
+    _filter_map.emplace(desc.filter_id, val);
+    return Status::OK();
+}
+
+Status RuntimeFilterLocalMerger::merge(IRuntimeFilter* filter, bool* is_last) {
+    std::shared_ptr<LocalMergeVal> val;
+    {
+        std::lock_guard<std::mutex> guard(_filter_map_mutex);
+        auto iter = _filter_map.find(filter->filter_id());
+        if (iter == _filter_map.end()) {
+            LOG(WARNING) << "unknown local merge filter id:" << filter->filter_id();
+            return Status::InvalidArgument("unknown filter id");
+        }
+        val = iter->second;
+    }
+
+    std::lock_guard<std::mutex> guard(val->mutex);
+    DCHECK_LT(val->arrived_num, val->producer_num);
+    *is_last = ++val->arrived_num == val->producer_num;
+    if (*is_last) {
+        return filter->merge_from(val->filter->get_wrapper());
+    }
+    // Copy the filter by serializing it, as its producer may finish before the last one.
+    PMergeFilterRequest request;
+    void* data = nullptr;
+    int len = 0;
+    RETURN_IF_ERROR(filter->serialize(&request, &data, &len));
+    MergeRuntimeFilterParams params;
+    params.data = static_cast<const char*>(data);
+    params.request = &request;
+    RuntimeFilterWrapperHolder holder;
+    RETURN_IF_ERROR(IRuntimeFilter::create_wrapper(&params, &val->pool, holder.getHandle()));
+    return val->filter->merge_from(holder.getHandle()->get());
+}
+
 Status RuntimeFilterMergeControllerEntity::_init_with_desc(
         const TRuntimeFilterDesc* runtime_filter_desc, const TQueryOptions* query_options,
         const std::vector<doris::TRuntimeFilterTargetParams>* target_info,
@@ -182,12 +246,27 @@ Status RuntimeFilterMergeControllerEntity::init(UniqueId query_id, UniqueId frag
     return Status::OK();
 }
 
+// The publish rpc of a merged filter, deleted once it finishes.
+class PublishFilterClosure : public google::protobuf::Closure {
+public:
+    void Run() override {
+        if (cntl.Failed()) {
+            LOG(WARNING) << "runtimefilter rpc err:" << cntl.ErrorText();
+            ExecEnv::GetInstance()->brpc_internal_client_cache()->erase(cntl.remote_side());
+        }
+        delete this;
+    }
+
+    PPublishFilterRequest request;
+    PPublishFilterResponse response;
+    brpc::Controller cntl;
+};
+
 // merge data
 Status RuntimeFilterMergeControllerEntity::merge(const PMergeFilterRequest* request,
                                                  const char* data) {
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
     std::shared_ptr<RuntimeFilterCntlVal> cntVal;
-    int merged_size = 0;
     {
         std::lock_guard<std::mutex> guard(_filter_map_mutex);
         auto iter = _filter_map.find(std::to_string(request->filter_id()));
@@ -197,80 +276,83 @@ Status RuntimeFilterMergeControllerEntity::merge(const PMergeFilterRequest* requ
             return Status::InvalidArgument("unknown filter id");
         }
         cntVal = iter->second;
-        MergeRuntimeFilterParams params;
-        params.data = data;
-        params.request = request;
-        ObjectPool* pool = iter->second->pool.get();
-        RuntimeFilterWrapperHolder holder;
-        RETURN_IF_ERROR(IRuntimeFilter::create_wrapper(&params, pool, holder.getHandle()));
+    }
+
+    // Only the filter being merged is locked, the producers deserialize in parallel.
+    MergeRuntimeFilterParams params;
+    params.data = data;
+    params.request = request;
+    RuntimeFilterWrapperHolder holder;
+    RETURN_IF_ERROR(
+            IRuntimeFilter::create_wrapper(&params, cntVal->pool.get(), holder.getHandle()));
+    {
+        std::lock_guard<std::mutex> guard(cntVal->mutex);
+        if (!cntVal->arrive_id.insert(UniqueId(request->fragment_id()).to_string()).second) {
+            return Status::OK();
+        }
         RETURN_IF_ERROR(cntVal->filter->merge_from(holder.getHandle()->get()));
-        cntVal->arrive_id.insert(UniqueId(request->fragment_id()).to_string());
-        merged_size = cntVal->arrive_id.size();
+        cntVal->merged_size +=
+                request->has_merged_producer_num() ? request->merged_producer_num() : 1;
         // TODO: avoid log when we had acquired a lock
-        VLOG_ROW << "merge size:" << merged_size << ":" << cntVal->producer_size;
-        DCHECK_LE(merged_size, cntVal->producer_size);
-        if (merged_size < cntVal->producer_size) {
+        VLOG_ROW << "merge size:" << cntVal->merged_size << ":" << cntVal->producer_size;
+        DCHECK_LE(cntVal->merged_size, cntVal->producer_size);
+        if (cntVal->merged_size < cntVal->producer_size) {
             return Status::OK();
         }
     }
+    return _publish(request, cntVal.get());
+}
 
-    if (merged_size == cntVal->producer_size) {
-        // prepare rpc context
-        using PPublishFilterRpcContext =
-                async_rpc_context<PPublishFilterRequest, PPublishFilterResponse>;
-        std::vector<std::unique_ptr<PPublishFilterRpcContext>> rpc_contexts;
-        rpc_contexts.reserve(cntVal->target_info.size());
-
-        butil::IOBuf request_attachment;
-
-        PPublishFilterRequest apply_request;
-        // serialize filter
-        void* data = nullptr;
-        int len = 0;
-        bool has_attachment = false;
-        RETURN_IF_ERROR(cntVal->filter->serialize(&apply_request, &data, &len));
-        if (data != nullptr && len > 0) {
-            request_attachment.append(data, len);
-            has_attachment = true;
+Status RuntimeFilterMergeControllerEntity::_publish(const PMergeFilterRequest* request,
+                                                    RuntimeFilterCntlVal* cnt_val) {
+    butil::IOBuf request_attachment;
+
+    PPublishFilterRequest apply_request;
+    // serialize filter
+    void* data = nullptr;
+    int len = 0;
+    bool has_attachment = false;
+    RETURN_IF_ERROR(cnt_val->filter->serialize(&apply_request, &data, &len));
+    if (data != nullptr && len > 0) {
+        request_attachment.append(data, len);
+        has_attachment = true;
+    }
+
+    // The rpcs are sent in parallel, and only waited for if they are not async.
+    std::vector<brpc::CallId> call_ids;
+    call_ids.reserve(cnt_val->target_info.size());
+    for (auto& target : cnt_val->target_info) {
+        auto closure = new PublishFilterClosure();
+        closure->request = apply_request;
+        closure->request.set_filter_id(request->filter_id());
+        *closure->request.mutable_query_id() = request->query_id();
+        if (has_attachment) {
+            // the attachment shares the blocks of request_attachment
+            closure->cntl.request_attachment().append(request_attachment);
         }
 
-        std::vector<TRuntimeFilterTargetParams>& targets = cntVal->target_info;
-        for (size_t i = 0; i < targets.size(); i++) {
-            rpc_contexts.emplace_back(new PPublishFilterRpcContext);
-            rpc_contexts[i]->request = apply_request;
-            rpc_contexts[i]->request.set_filter_id(request->filter_id());
-            *rpc_contexts[i]->request.mutable_query_id() = request->query_id();
-            if (has_attachment) {
-                rpc_contexts[i]->cntl.request_attachment().append(request_attachment);
-            }
-            rpc_contexts[i]->cid = rpc_contexts[i]->cntl.call_id();
-
-            // set fragment-id
-            auto request_fragment_id = rpc_contexts[i]->request.mutable_fragment_id();
-            request_fragment_id->set_hi(targets[i].target_fragment_instance_id.hi);
-            request_fragment_id->set_lo(targets[i].target_fragment_instance_id.lo);
-
-            std::shared_ptr<PBackendService_Stub> stub(
-                    ExecEnv::GetInstance()->brpc_internal_client_cache()->get_client(
-                            targets[i].target_fragment_instance_addr));
-            VLOG_NOTICE << "send filter " << rpc_contexts[i]->request.filter_id()
-                        << " to:" << targets[i].target_fragment_instance_addr.hostname << ":"
-                        << targets[i].target_fragment_instance_addr.port
-                        << rpc_contexts[i]->request.ShortDebugString();
-            if (stub == nullptr) {
-                rpc_contexts.pop_back();
-                continue;
-            }
-            stub->apply_filter(&rpc_contexts[i]->cntl, &rpc_contexts[i]->request,
-                               &rpc_contexts[i]->response, brpc::DoNothing());
+        // set fragment-id
+        auto request_fragment_id = closure->request.mutable_fragment_id();
+        request_fragment_id->set_hi(target.target_fragment_instance_id.hi);
+        request_fragment_id->set_lo(target.target_fragment_instance_id.lo);
+
+        std::shared_ptr<PBackendService_Stub> stub(
+                ExecEnv::GetInstance()->brpc_internal_client_cache()->get_client(
+                        target.target_fragment_instance_addr));
+        VLOG_NOTICE << "send filter " << closure->request.filter_id()
+                    << " to:" << target.target_fragment_instance_addr.hostname << ":"
+                    << target.target_fragment_instance_addr.port
+                    << closure->request.ShortDebugString();
+        if (stub == nullptr) {
+            delete closure;
+            continue;
         }
-        for (auto& rpc_context : rpc_contexts) {
-            brpc::Join(rpc_context->cid);
-            if (rpc_context->cntl.Failed()) {
-                LOG(WARNING) << "runtimefilter rpc err:" << rpc_context->cntl.ErrorText();
-                ExecEnv::GetInstance()->brpc_internal_client_cache()->erase(
-                        rpc_context->cntl.remote_side());
-            }
+        call_ids.push_back(closure->cntl.call_id());
+        stub->apply_filter(&closure->cntl, &closure->request, &closure->response, closure);
+    }
+    if (!config::runtime_filter_use_async_rpc) {
+        for (auto call_id : call_ids) {
+            brpc::Join(call_id);
         }
     }
     return Status::OK();
@@ -38,6 +38,7 @@ class FragmentExecState;
 class PlanFragmentExecutor;
 class PPublishFilterRequest;
 class PMergeFilterRequest;
+class RuntimeFilterLocalMerger;
 
 /// producer:
 /// Filter filter;
@@ -74,6 +75,11 @@ public:
 
     Status get_merge_addr(TNetworkAddress* addr);
 
+    // Merge the filter of a producer with the filters of the other producers on this BE, if it
+    // has any. *is_last is set if 'filter' should be sent to the merge instance, as the filter
+    // of *merged_producer_num producers.
+    Status local_merge(IRuntimeFilter* filter, int* merged_producer_num, bool* is_last);
+
 private:
     Status get_filter_by_role(const int filter_id, const RuntimeFilterRole role,
                               IRuntimeFilter** target);
@@ -96,6 +102,38 @@ private:
     TNetworkAddress _merge_addr;
 
     bool _has_merge_addr;
+
+    // filter-id -> the number of its producers on this BE
+    std::map<int32_t, int32_t> _local_builder_num;
+    // Owned by the QueryFragmentsCtx, nullptr if no filter is merged on this BE.
+    RuntimeFilterLocalMerger* _local_merger = nullptr;
+};
+
+// Merges the filters produced by the fragment instances of a query on this BE, so that only
+// the last producer of each filter sends a merge rpc to the merge instance.
+// Owned by QueryFragmentsCtx, as the producers may finish before the last one.
+class RuntimeFilterLocalMerger {
+public:
+    // Called by each producer, the filter is only created once.
+    Status register_filter(const TRuntimeFilterDesc& desc, const TQueryOptions& options,
+                           int producer_num);
+
+    // Merge the filter of a producer. If it is the last producer of the filter on this BE,
+    // the filters of the other producers are merged into 'filter' and *is_last is set.
+    Status merge(IRuntimeFilter* filter, bool* is_last);
+
+private:
+    struct LocalMergeVal {
+        std::mutex mutex;
+        int producer_num;
+        int arrived_num = 0;
+        TRuntimeFilterDesc runtime_filter_desc;
+        ObjectPool pool;
+        IRuntimeFilter* filter;
+    };
+    std::mutex _filter_map_mutex;
+    // filter-id -> val
+    std::map<int32_t, std::shared_ptr<LocalMergeVal>> _filter_map;
 };
 
 // controller -> <query-id, entity>
@@ -129,8 +167,16 @@ private:
         std::vector<doris::TRuntimeFilterTargetParams> target_info;
         IRuntimeFilter* filter;
         std::unordered_set<std::string> arrive_id; // fragment_instance_id ?
+        // the number of producers merged, a locally merged filter counts for several ones
+        int merged_size = 0;
         std::shared_ptr<ObjectPool> pool;
+        // protect filter and arrive_id, the filters merge in parallel
+        std::mutex mutex;
     };
+
+    // Send the merged filter to all its targets.
+    Status _publish(const PMergeFilterRequest* request, RuntimeFilterCntlVal* cnt_val);
+
     UniqueId _query_id;
     UniqueId _fragment_instance_id;
     // protect _filter_map
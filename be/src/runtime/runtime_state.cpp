@@ -39,11 +39,13 @@
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/memory/mem_tracker_task_pool.h"
 #include "runtime/runtime_filter_mgr.h"
+#include "runtime/workload_group.h"
 #include "util/file_utils.h"
 #include "util/load_error_hub.h"
 #include "util/pretty_printer.h"
 #include "util/timezone_utils.h"
 #include "util/uid_util.h"
+#include "vec/functions/json_documents.h"
 
 namespace doris {
 
@@ -173,6 +175,7 @@ RuntimeState::~RuntimeState() {
     // Manually release the child mem tracker before _instance_mem_tracker is destructed.
     _obj_pool->clear();
     _runtime_filter_mgr.reset();
+    _json_documents_cache.reset();
 }
 
 Status RuntimeState::init(const TUniqueId& fragment_instance_id, const TQueryOptions& query_options,
@@ -233,9 +236,13 @@ Status RuntimeState::init_mem_trackers(const TUniqueId& query_id) {
     mem_tracker_counter->set(bytes_limit);
 
     if (query_type() == TQueryType::SELECT) {
+        if (_query_options.__isset.workload_group && !_query_options.workload_group.empty()) {
+            _workload_group = _exec_env->workload_group_mgr()->get(_query_options.workload_group);
+        }
         _query_mem_tracker =
                 _exec_env->task_pool_mem_tracker_registry()->register_query_mem_tracker(
-                        print_id(query_id), bytes_limit);
+                        print_id(query_id), bytes_limit,
+                        _workload_group != nullptr ? _workload_group->mem_tracker() : nullptr);
     } else if (query_type() == TQueryType::LOAD) {
         _query_mem_tracker = _exec_env->task_pool_mem_tracker_registry()->register_load_mem_tracker(
                 print_id(query_id), bytes_limit);
@@ -264,6 +271,22 @@ Status RuntimeState::init_mem_trackers(const TUniqueId& query_id) {
     return Status::OK();
 }
 
+int64_t RuntimeState::scan_task_group_id() const {
+    return _workload_group != nullptr ? _workload_group->id() : hash_value(_query_id);
+}
+
+int RuntimeState::scan_thread_shares() const {
+    return _workload_group != nullptr ? _workload_group->cpu_share()
+                                      : _query_options.scan_thread_shares;
+}
+
+vectorized::JsonDocumentsCache* RuntimeState::json_documents_cache() {
+    std::call_once(_json_documents_cache_once, [this] {
+        _json_documents_cache = std::make_unique<vectorized::JsonDocumentsCache>(this);
+    });
+    return _json_documents_cache.get();
+}
+
 Status RuntimeState::init_instance_mem_tracker() {
     _instance_mem_tracker = std::make_unique<MemTrackerLimiter>(-1, "RuntimeState:instance");
     return Status::OK();
@@ -60,6 +60,11 @@ class ReservationTracker;
 class InitialReservations;
 class RowDescriptor;
 class RuntimeFilterMgr;
+class WorkloadGroup;
+
+namespace vectorized {
+class JsonDocumentsCache;
+} // namespace vectorized
 
 // A collection of items that are part of the global state of a
 // query and shared across all execution nodes of that query.
@@ -118,6 +123,12 @@ public:
     int max_errors() const { return _query_options.max_errors; }
     int max_io_buffers() const { return _query_options.max_io_buffers; }
     int num_scanner_threads() const { return _query_options.num_scanner_threads; }
+    // The workload group of the query, or nullptr if it has none. Set by init_mem_trackers().
+    WorkloadGroup* workload_group() const { return _workload_group; }
+    // The group the scanners of the query are scheduled by in the scanner thread pool, its
+    // workload group or else the query itself, and the share of the threads of the group.
+    int64_t scan_task_group_id() const;
+    int scan_thread_shares() const;
     TQueryType::type query_type() const { return _query_options.query_type; }
     int64_t timestamp_ms() const { return _timestamp_ms; }
     const std::string& timezone() const { return _timezone; }
@@ -129,6 +140,9 @@ public:
     ExecEnv* exec_env() { return _exec_env; }
     MemTrackerLimiter* query_mem_tracker() { return _query_mem_tracker; }
     MemTrackerLimiter* instance_mem_tracker() { return _instance_mem_tracker.get(); }
+    // The parsed json documents shared by the get_json_* functions of the fragment instance,
+    // created on the first call.
+    vectorized::JsonDocumentsCache* json_documents_cache();
     ThreadResourceMgr::ResourcePool* resource_pool() { return _resource_pool; }
 
     void set_fragment_root_id(PlanNodeId id) {
@@ -346,6 +360,8 @@ public:
         return _query_options.enable_enable_exchange_node_parallel_merge;
     }
 
+    bool enable_perf_counters() const { return _query_options.enable_perf_counters; }
+
     // the following getters are only valid after Prepare()
     InitialReservations* initial_reservations() const { return _initial_reservations; }
 
@@ -391,6 +407,7 @@ private:
     // MemTracker that is shared by all fragment instances running on this host.
     // The query mem tracker must be released after the _instance_mem_tracker.
     MemTrackerLimiter* _query_mem_tracker;
+    WorkloadGroup* _workload_group = nullptr;
 
     // Memory usage of this fragment instance
     std::unique_ptr<MemTrackerLimiter> _instance_mem_tracker;
@@ -405,6 +422,10 @@ private:
     // runtime filter
     std::unique_ptr<RuntimeFilterMgr> _runtime_filter_mgr;
 
+    // the parsed json documents, see json_documents_cache()
+    std::once_flag _json_documents_cache_once;
+    std::unique_ptr<vectorized::JsonDocumentsCache> _json_documents_cache;
+
     // Protects _data_stream_recvrs_pool
     std::mutex _data_stream_recvrs_lock;
 
@@ -521,7 +542,7 @@ private:
     /// TODO: not needed if we call ReleaseResources() in a timely manner (IMPALA-1575).
     std::atomic<int32_t> _initial_reservation_refcnt {0};
 
-    QueryFragmentsCtx* _query_ctx;
+    QueryFragmentsCtx* _query_ctx = nullptr;
 
     // true if max_filter_ratio is 0
     bool _load_zero_tolerance = false;
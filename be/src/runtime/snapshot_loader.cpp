@@ -19,6 +19,13 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "gen_cpp/FrontendService.h"
@@ -36,10 +43,79 @@
 #include "util/file_utils.h"
 #include "util/hdfs_storage_backend.h"
 #include "util/s3_storage_backend.h"
+#include "util/threadpool.h"
 #include "util/thrift_rpc_helper.h"
 
 namespace doris {
 
+namespace {
+
+// Paces the files transferred by all the snapshot loaders of this backend so that they do not
+// exceed snapshot_transfer_max_speed_kbps together. Each file reserves the time its bytes take at
+// that speed, and waits for the files reserved before it.
+class SnapshotTransferThrottle {
+public:
+    static SnapshotTransferThrottle* instance() {
+        static SnapshotTransferThrottle throttle;
+        return &throttle;
+    }
+
+    void acquire(int64_t bytes) {
+        int64_t speed_kbps = config::snapshot_transfer_max_speed_kbps;
+        if (speed_kbps <= 0 || bytes <= 0) {
+            return;
+        }
+        auto cost = std::chrono::microseconds(bytes * 1000 / speed_kbps);
+        std::chrono::steady_clock::time_point start;
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            start = std::max(std::chrono::steady_clock::now(), _next_start);
+            _next_start = start + cost;
+        }
+        std::this_thread::sleep_until(start);
+    }
+
+private:
+    std::mutex _lock;
+    std::chrono::steady_clock::time_point _next_start;
+};
+
+// Runs the transfers of the tablets on snapshot_transfer_threads threads and returns the first
+// error of them. *failed is set at the first error, and the tablets not started yet are skipped.
+Status transfer_in_parallel(const std::string& name,
+                            const std::vector<std::function<Status()>>& tasks,
+                            std::atomic<bool>* failed) {
+    int num_threads = std::max(1, std::min<int>(config::snapshot_transfer_threads, tasks.size()));
+    std::unique_ptr<ThreadPool> pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder(name)
+                            .set_min_threads(num_threads)
+                            .set_max_threads(num_threads)
+                            .build(&pool));
+    std::mutex status_lock;
+    Status transfer_status = Status::OK();
+    for (const auto& task : tasks) {
+        auto transfer = [&] {
+            if (failed->load()) {
+                return;
+            }
+            Status st = task();
+            if (!st.ok()) {
+                std::lock_guard<std::mutex> l(status_lock);
+                if (!failed->exchange(true)) {
+                    transfer_status = st;
+                }
+            }
+        };
+        if (!pool->submit_func(transfer).ok()) {
+            transfer();
+        }
+    }
+    pool->wait();
+    return transfer_status;
+}
+
+} // namespace
+
 SnapshotLoader::SnapshotLoader(ExecEnv* env, int64_t job_id, int64_t task_id,
                                const TNetworkAddress& broker_addr,
                                const std::map<std::string, std::string>& broker_prop)
@@ -95,15 +171,21 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
     RETURN_IF_ERROR(_check_local_snapshot_paths(src_to_dest_path, true));
 
     // 2. for each src path, upload it to remote storage
-    // we report to frontend for every 10 files, and we will cancel the job if
-    // the job has already been cancelled in frontend.
+    // The tablets are uploaded by several threads. We report to frontend for every 10 files, and
+    // we will cancel the job if the job has already been cancelled in frontend.
+    std::mutex report_lock;
     int report_counter = 0;
     int total_num = src_to_dest_path.size();
     int finished_num = 0;
-    for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++) {
-        const std::string& src_path = iter->first;
-        const std::string& dest_path = iter->second;
-
+    std::atomic<bool> failed {false};
+    auto report = [&]() -> Status {
+        if (failed.load()) {
+            return Status::Cancelled("upload of another tablet failed");
+        }
+        std::lock_guard<std::mutex> l(report_lock);
+        return _report_every(10, &report_counter, finished_num, total_num, TTaskType::type::UPLOAD);
+    };
+    auto upload_tablet = [&](const std::string& src_path, const std::string& dest_path) -> Status {
         int64_t tablet_id = 0;
         int32_t schema_hash = 0;
         RETURN_IF_ERROR(
@@ -124,24 +206,23 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
 
         // 2.3 iterate local files
         for (auto it = local_files.begin(); it != local_files.end(); it++) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num,
-                                          TTaskType::type::UPLOAD));
+            RETURN_IF_ERROR(report());
 
             const std::string& local_file = *it;
             // calc md5sum of localfile
             std::string md5sum;
-            status = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
-            if (!status.ok()) {
+            Status st = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
+            if (!st.ok()) {
                 std::stringstream ss;
-                ss << "failed to get md5sum of file: " << local_file << ": "
-                   << status.get_error_msg();
+                ss << "failed to get md5sum of file: " << local_file << ": " << st.get_error_msg();
                 LOG(WARNING) << ss.str();
                 return Status::InternalError(ss.str());
             }
             VLOG_CRITICAL << "get file checksum: " << local_file << ": " << md5sum;
             local_files_with_checksum.push_back(local_file + "." + md5sum);
 
-            // check if this local file need upload
+            // check if this local file need upload. the files uploaded by a failed task are
+            // skipped when it is retried.
             bool need_upload = false;
             auto find = remote_files.find(local_file);
             if (find != remote_files.end()) {
@@ -164,15 +245,29 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
             // upload
             std::string full_remote_file = dest_path + "/" + local_file;
             std::string full_local_file = src_path + "/" + local_file;
+            std::error_code ec;
+            uintmax_t file_size = std::filesystem::file_size(full_local_file, ec);
+            SnapshotTransferThrottle::instance()->acquire(ec ? 0 : file_size);
             RETURN_IF_ERROR(_storage_backend->upload_with_checksum(full_local_file,
                                                                    full_remote_file, md5sum));
         } // end for each tablet's local files
 
-        tablet_files->emplace(tablet_id, local_files_with_checksum);
-        finished_num++;
+        {
+            std::lock_guard<std::mutex> l(report_lock);
+            tablet_files->emplace(tablet_id, local_files_with_checksum);
+            finished_num++;
+        }
         LOG(INFO) << "finished to write tablet to remote. local path: " << src_path
                   << ", remote path: " << dest_path;
-    } // end for each tablet path
+        return Status::OK();
+    };
+
+    std::vector<std::function<Status()>> tasks;
+    for (const auto& iter : src_to_dest_path) {
+        tasks.emplace_back(
+                [&upload_tablet, &iter] { return upload_tablet(iter.first, iter.second); });
+    }
+    RETURN_IF_ERROR(transfer_in_parallel("SnapshotUploadThreadPool", tasks, &failed));
 
     LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
     return status;
@@ -201,18 +296,30 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
     RETURN_IF_ERROR(_check_local_snapshot_paths(src_to_dest_path, false));
 
     // 2. for each src path, download it to local storage
+    // The tablets are downloaded by several threads like the upload.
+    std::mutex report_lock;
     int report_counter = 0;
     int total_num = src_to_dest_path.size();
     int finished_num = 0;
-    for (auto iter = src_to_dest_path.begin(); iter != src_to_dest_path.end(); iter++) {
-        const std::string& remote_path = iter->first;
-        const std::string& local_path = iter->second;
-
+    std::atomic<bool> failed {false};
+    auto report = [&]() -> Status {
+        if (failed.load()) {
+            return Status::Cancelled("download of another tablet failed");
+        }
+        std::lock_guard<std::mutex> l(report_lock);
+        return _report_every(10, &report_counter, finished_num, total_num,
+                             TTaskType::type::DOWNLOAD);
+    };
+    auto download_tablet = [&](const std::string& remote_path,
+                               const std::string& local_path) -> Status {
         int64_t local_tablet_id = 0;
         int32_t schema_hash = 0;
         RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(local_path, &local_tablet_id,
                                                                       &schema_hash));
-        downloaded_tablet_ids->push_back(local_tablet_id);
+        {
+            std::lock_guard<std::mutex> l(report_lock);
+            downloaded_tablet_ids->push_back(local_tablet_id);
+        }
 
         int64_t remote_tablet_id;
         RETURN_IF_ERROR(_get_tablet_id_from_remote_path(remote_path, &remote_tablet_id));
@@ -245,8 +352,7 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
         DataDir* data_dir = tablet->data_dir();
 
         for (auto& iter : remote_files) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num,
-                                          TTaskType::type::DOWNLOAD));
+            RETURN_IF_ERROR(report());
 
             bool need_download = false;
             const std::string& remote_file = iter.first;
@@ -299,16 +405,19 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
             }
             // remove file which will be downloaded now.
             // this file will be added to local_files if it be downloaded successfully.
-            local_files.erase(find);
+            if (find != local_files.end()) {
+                local_files.erase(find);
+            }
+            SnapshotTransferThrottle::instance()->acquire(file_len);
             RETURN_IF_ERROR(_storage_backend->download(full_remote_file, full_local_file));
 
             // 3. check md5 of the downloaded file
             std::string downloaded_md5sum;
-            status = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
-            if (!status.ok()) {
+            Status md5_st = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
+            if (!md5_st.ok()) {
                 std::stringstream ss;
                 ss << "failed to get md5sum of file: " << full_local_file
-                   << ", err: " << status.get_error_msg();
+                   << ", err: " << md5_st.get_error_msg();
                 LOG(WARNING) << ss.str();
                 return Status::InternalError(ss.str());
             }
@@ -355,8 +464,17 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
             }
         }
 
+        std::lock_guard<std::mutex> l(report_lock);
         finished_num++;
-    } // end for src_to_dest_path
+        return Status::OK();
+    };
+
+    std::vector<std::function<Status()>> tasks;
+    for (const auto& iter : src_to_dest_path) {
+        tasks.emplace_back(
+                [&download_tablet, &iter] { return download_tablet(iter.first, iter.second); });
+    }
+    RETURN_IF_ERROR(transfer_in_parallel("SnapshotDownloadThreadPool", tasks, &failed));
 
     LOG(INFO) << "finished to download snapshots. job: " << _job_id << ", task id: " << _task_id;
     return status;
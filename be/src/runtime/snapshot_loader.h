@@ -48,6 +48,9 @@ struct FileStat;
  * to local snapshot dir via broker.
  * It will also only download files which does not exist in local dir.
  *
+ * The tablets of upload() and download() are transferred by several threads,
+ * and the files of all the loaders of a backend share a max speed.
+ *
  * Move:
  * move() is the final step of restore process. it will replace the
  * old tablet data dir with the newly downloaded snapshot dir.
@@ -0,0 +1,265 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/stream_load/group_commit_mgr.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <vector>
+
+#include "common/config.h"
+#include "runtime/message_body_sink.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "runtime/stream_load/stream_load_executor.h"
+#include "util/time.h"
+
+namespace doris {
+
+class GroupCommitMgr::LoadGroup {
+public:
+    LoadGroup(StreamLoadContext* ctx)
+            : _ctx(ctx),
+              _deadline(std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(config::group_commit_interval_ms)) {
+        _ctx->ref();
+    }
+
+    ~LoadGroup() {
+        if (_ctx->unref()) {
+            delete _ctx;
+        }
+    }
+
+    StreamLoadContext* ctx() { return _ctx; }
+
+    // return false if the group has been closed, then the data should go to a new group.
+    // the data is held until the shared load is planned.
+    bool append(const ByteBufferPtr& data, Status* st) {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_closed) {
+            return false;
+        }
+        if (_planned) {
+            *st = _ctx->body_sink->append(data);
+        } else {
+            _pending.push_back(data);
+        }
+        _ctx->receive_bytes += data->remaining();
+        if (_ctx->receive_bytes >= config::group_commit_data_bytes) {
+            _cv.notify_all();
+        }
+        return true;
+    }
+
+    Status set_planned() {
+        std::lock_guard<std::mutex> l(_lock);
+        _planned = true;
+        for (auto& data : _pending) {
+            RETURN_IF_ERROR(_ctx->body_sink->append(data));
+        }
+        _pending.clear();
+        return Status::OK();
+    }
+
+    // wait for the interval of the group to pass, or the group to have enough data
+    void wait_to_close() {
+        std::unique_lock<std::mutex> l(_lock);
+        _cv.wait_until(l, _deadline, [this]() {
+            return _ctx->receive_bytes >= config::group_commit_data_bytes;
+        });
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> l(_lock);
+        _closed = true;
+        _pending.clear();
+    }
+
+    void set_finished(const Status& st) {
+        std::lock_guard<std::mutex> l(_lock);
+        _status = st;
+        _finished = true;
+        _cv.notify_all();
+    }
+
+    Status wait_finished() {
+        std::unique_lock<std::mutex> l(_lock);
+        _cv.wait(l, [this]() { return _finished; });
+        return _status;
+    }
+
+private:
+    StreamLoadContext* _ctx;
+    std::chrono::steady_clock::time_point _deadline;
+
+    std::mutex _lock;
+    std::condition_variable _cv;
+    bool _planned = false;
+    bool _closed = false;
+    bool _finished = false;
+    Status _status;
+    // the data appended before the shared load is planned
+    std::vector<ByteBufferPtr> _pending;
+};
+
+GroupCommitMgr::GroupCommitMgr(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+GroupCommitMgr::~GroupCommitMgr() = default;
+
+static std::string label_key(StreamLoadContext* ctx) {
+    return ctx->db + '\0' + ctx->label;
+}
+
+Status GroupCommitMgr::_add_label(StreamLoadContext* ctx) {
+    std::lock_guard<std::mutex> l(_lock);
+    _remove_expired_labels();
+    auto it = _labels.find(label_key(ctx));
+    if (it != _labels.end()) {
+        // the same job status as the ones of FE
+        ctx->existing_job_status = it->second ? "FINISHED" : "RUNNING";
+        return Status::ErrorFmt(TStatusCode::LABEL_ALREADY_EXISTS,
+                                "Label [{}] has already been used.", ctx->label);
+    }
+    _labels.emplace(label_key(ctx), false);
+    return Status::OK();
+}
+
+void GroupCommitMgr::_finish_label(StreamLoadContext* ctx, bool committed) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (!committed) {
+        _labels.erase(label_key(ctx));
+        return;
+    }
+    _labels[label_key(ctx)] = true;
+    _committed_labels.emplace_back(
+            UnixMillis() + config::group_commit_label_keep_max_second * 1000, label_key(ctx));
+}
+
+void GroupCommitMgr::_remove_expired_labels() {
+    int64_t now = UnixMillis();
+    while (!_committed_labels.empty() && _committed_labels.front().first <= now) {
+        _labels.erase(_committed_labels.front().second);
+        _committed_labels.pop_front();
+    }
+}
+
+Status GroupCommitMgr::group_commit(StreamLoadContext* ctx, const std::string& key,
+                                    const ByteBufferPtr& data, const PlanFunc& plan_func) {
+    RETURN_IF_ERROR(_add_label(ctx));
+    std::shared_ptr<LoadGroup> group;
+    bool is_first_load = false;
+    Status append_status;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            auto it = _groups.find(key);
+            if (it != _groups.end()) {
+                group = it->second;
+                is_first_load = false;
+            } else {
+                auto group_ctx = new StreamLoadContext(_exec_env);
+                group_ctx->load_type = ctx->load_type;
+                group_ctx->load_src_type = ctx->load_src_type;
+                group_ctx->db = ctx->db;
+                group_ctx->table = ctx->table;
+                group_ctx->label = "group_commit_" + generate_uuid_string();
+                group_ctx->auth = ctx->auth;
+                group_ctx->format = ctx->format;
+                group_ctx->timeout_second = ctx->timeout_second;
+                group = std::make_shared<LoadGroup>(group_ctx);
+                _groups.emplace(key, group);
+                is_first_load = true;
+            }
+        }
+        // the group may be closed after it is found
+        if (group->append(data, &append_status)) {
+            break;
+        }
+    }
+    if (is_first_load) {
+        group->set_finished(_run_group(key, group, plan_func));
+    }
+
+    Status st = group->wait_finished();
+    if (st.ok()) {
+        st = append_status;
+    }
+    StreamLoadContext* group_ctx = group->ctx();
+    ctx->txn_id = group_ctx->txn_id;
+    ctx->group_commit_label = group_ctx->label;
+    ctx->number_total_rows = group_ctx->number_total_rows;
+    ctx->number_loaded_rows = group_ctx->number_loaded_rows;
+    ctx->number_filtered_rows = group_ctx->number_filtered_rows;
+    ctx->number_unselected_rows = group_ctx->number_unselected_rows;
+    ctx->error_url = group_ctx->error_url;
+    ctx->begin_txn_cost_nanos = group_ctx->begin_txn_cost_nanos;
+    ctx->stream_load_put_cost_nanos = group_ctx->stream_load_put_cost_nanos;
+    ctx->write_data_cost_nanos = group_ctx->write_data_cost_nanos;
+    ctx->commit_and_publish_txn_cost_nanos = group_ctx->commit_and_publish_txn_cost_nanos;
+    // the txn of a publish timeout is committed, and becomes visible later
+    _finish_label(ctx, st.ok() || st.code() == TStatusCode::PUBLISH_TIMEOUT);
+    return st;
+}
+
+Status GroupCommitMgr::_run_group(const std::string& key, const std::shared_ptr<LoadGroup>& group,
+                                  const PlanFunc& plan_func) {
+    StreamLoadContext* group_ctx = group->ctx();
+    Status st = plan_func(group_ctx);
+    if (st.ok()) {
+        st = group->set_planned();
+    }
+    if (st.ok()) {
+        group->wait_to_close();
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _groups.find(key);
+        if (it != _groups.end() && it->second == group) {
+            _groups.erase(it);
+        }
+    }
+    group->close();
+    LOG(INFO) << "close group commit load " << group_ctx->brief()
+              << ", bytes: " << group_ctx->receive_bytes;
+
+    if (st.ok()) {
+        st = group_ctx->body_sink->finish();
+    }
+    if (st.ok()) {
+        st = group_ctx->future.get();
+    }
+    if (st.ok()) {
+        int64_t commit_and_publish_start_time = MonotonicNanos();
+        st = _exec_env->stream_load_executor()->commit_txn(group_ctx);
+        group_ctx->commit_and_publish_txn_cost_nanos =
+                MonotonicNanos() - commit_and_publish_start_time;
+    }
+    if (!st.ok() && st.code() != TStatusCode::PUBLISH_TIMEOUT) {
+        LOG(WARNING) << "group commit load failed, " << group_ctx->brief()
+                     << ", errmsg=" << st.get_error_msg();
+        if (group_ctx->need_rollback) {
+            _exec_env->stream_load_executor()->rollback_txn(group_ctx);
+            group_ctx->need_rollback = false;
+        }
+        if (group_ctx->body_sink != nullptr) {
+            group_ctx->body_sink->cancel(st.get_error_msg());
+        }
+    }
+    return st;
+}
+
+} // namespace doris
@@ -0,0 +1,80 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+#include "util/byte_buffer.h"
+
+namespace doris {
+
+class ExecEnv;
+class StreamLoadContext;
+
+// Merges the concurrent small stream loads of a table with the same load parameters into one
+// load: the data of each load is sent to the pipe of a load shared by the group, which is
+// committed in one txn when group_commit_interval_ms passes or the group has
+// group_commit_data_bytes of data. So the tiny loads of many clients make one txn, and one rowset
+// per tablet, every interval, and a load waits at most the interval plus the commit of its group.
+class GroupCommitMgr {
+public:
+    // begin the txn of the shared load of a new group and execute its plan fragment
+    using PlanFunc = std::function<Status(StreamLoadContext* group_ctx)>;
+
+    GroupCommitMgr(ExecEnv* exec_env);
+    ~GroupCommitMgr();
+
+    // commit 'data', the whole body received by 'ctx', in the group of the loads with the same
+    // 'key', and wait for the group to be committed. The result of the group is set to 'ctx'.
+    // Return LABEL_ALREADY_EXISTS if the label of 'ctx' is used by a load of a running group or
+    // of a group committed in the last group_commit_label_keep_max_second.
+    Status group_commit(StreamLoadContext* ctx, const std::string& key, const ByteBufferPtr& data,
+                        const PlanFunc& plan_func);
+
+private:
+    class LoadGroup;
+
+    // the first load of a group plans the shared load, and commits it when the group is closed
+    Status _run_group(const std::string& key, const std::shared_ptr<LoadGroup>& group,
+                      const PlanFunc& plan_func);
+
+    // add the label of the load, or return LABEL_ALREADY_EXISTS if it's used
+    Status _add_label(StreamLoadContext* ctx);
+    // keep the label of the load if it's committed, and remove it otherwise so the load can retry
+    void _finish_label(StreamLoadContext* ctx, bool committed);
+    void _remove_expired_labels();
+
+    ExecEnv* _exec_env;
+    std::mutex _lock;
+    // key -> the group accepting new loads
+    std::unordered_map<std::string, std::shared_ptr<LoadGroup>> _groups;
+    // db and label -> whether the load is committed, of the loads which are running in a group
+    // or committed in the last group_commit_label_keep_max_second. The member labels are not
+    // known by FE, which only sees the label of a group.
+    std::unordered_map<std::string, bool> _labels;
+    // the expiration time in ms and the db and label of the committed loads, by the expiration
+    std::deque<std::pair<int64_t, std::string>> _committed_labels;
+};
+
+} // namespace doris
@@ -31,6 +31,7 @@
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "service/backend_options.h"
+#include "util/byte_buffer.h"
 #include "util/string_util.h"
 #include "util/time.h"
 #include "util/uid_util.h"
@@ -205,6 +206,14 @@ public:
     // csv with header type
     std::string header_type = "";
 
+    // the load is committed with the concurrent small loads of the table in one txn,
+    // see GroupCommitMgr
+    bool group_commit = false;
+    // the whole body of a group commit load, which is sent to the load of its group at once
+    ByteBufferPtr group_commit_data;
+    // label of the load of the group
+    std::string group_commit_label = "";
+
 public:
     ExecEnv* exec_env() { return _exec_env; }
 
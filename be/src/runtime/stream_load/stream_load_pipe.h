@@ -146,6 +146,32 @@ public:
         return Status::OK();
     }
 
+    // Take the next chunk appended, without copying it. The chunk is handed over as it is,
+    // with its unread bytes between pos and limit, so a reader parses the buffers received.
+    Status read_chunk(ByteBufferPtr* chunk, bool* eof) {
+        std::unique_lock<std::mutex> l(_lock);
+        while (!_cancelled && !_finished && _buf_queue.empty()) {
+            _get_cond.wait(l);
+        }
+        // cancelled
+        if (_cancelled) {
+            return Status::InternalError("cancelled: {}", _cancelled_reason);
+        }
+        // finished
+        if (_buf_queue.empty()) {
+            DCHECK(_finished);
+            chunk->reset();
+            *eof = true;
+            return Status::OK();
+        }
+        *chunk = _buf_queue.front();
+        _buf_queue.pop_front();
+        _buffered_bytes -= (*chunk)->limit;
+        *eof = false;
+        _put_cond.notify_one();
+        return Status::OK();
+    }
+
     Status readat(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out) override {
         return Status::InternalError("Not implemented");
     }
@@ -23,10 +23,12 @@
 
 #include "common/logging.h"
 #include "runtime/string_value.h"
-#include "vec/common/volnitsky.h"
+#include "vec/common/string_searcher.h"
 
 namespace doris {
 
+// Searches the pattern by filtering the text by its first and last characters with simd, which
+// is cheap to set up, so it also serves the searches of a pattern of each row of a column.
 class StringSearch {
 public:
     virtual ~StringSearch() {}
@@ -36,7 +38,7 @@ public:
 
     void set_pattern(const StringValue* pattern) {
         _pattern = pattern;
-        _vol_searcher.reset(new Volnitsky(pattern->ptr, pattern->len));
+        _searcher.reset(new ASCIICaseSensitiveStringSearcher(pattern->ptr, pattern->len));
     }
 
     // search for this pattern in str.
@@ -59,14 +61,14 @@ public:
             return str + len;
         }
 
-        return _vol_searcher->search(str, len);
+        return _searcher->search(str, len);
     }
 
     inline size_t get_pattern_length() { return _pattern ? _pattern->len : 0; }
 
 private:
     const StringValue* _pattern;
-    std::unique_ptr<Volnitsky> _vol_searcher;
+    std::unique_ptr<ASCIICaseSensitiveStringSearcher> _searcher;
 };
 
 } // namespace doris
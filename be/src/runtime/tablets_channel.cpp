@@ -19,9 +19,13 @@
 
 #include "exec/tablet_info.h"
 #include "olap/memtable.h"
+#include "olap/rowset/rowset_meta.h"
+#include "olap/task/engine_pull_rowset_task.h"
 #include "runtime/row_batch.h"
 #include "runtime/thread_context.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
+#include "util/brpc_client_cache.h"
 #include "util/doris_metrics.h"
 
 namespace doris {
@@ -124,16 +128,25 @@ Status TabletsChannel::close(int sender_id, int64_t backend_id, bool* finished,
         }
 
         // 2. wait delta writers and build the tablet vector
+        std::vector<DeltaWriter*> committed_writers;
         for (auto writer : need_wait_writers) {
             // close may return failed, but no need to handle it here.
             // tablet_vec will only contains success tablet, and then let FE judge it.
-            _close_wait(writer, tablet_vec, tablet_errors);
+            if (_close_wait(writer, tablet_vec, tablet_errors) &&
+                !writer->slave_nodes().empty()) {
+                committed_writers.push_back(writer);
+            }
+        }
+
+        // 3. make the slave replicas pull the committed rowsets in single replica load
+        if (!committed_writers.empty()) {
+            _pull_rowsets_to_slaves(committed_writers, tablet_vec);
         }
     }
     return Status::OK();
 }
 
-void TabletsChannel::_close_wait(DeltaWriter* writer,
+bool TabletsChannel::_close_wait(DeltaWriter* writer,
                                  google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
                                  google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors) {
     Status st = writer->close_wait();
@@ -142,12 +155,80 @@ void TabletsChannel::_close_wait(DeltaWriter* writer,
             PTabletInfo* tablet_info = tablet_vec->Add();
             tablet_info->set_tablet_id(writer->tablet_id());
             tablet_info->set_schema_hash(writer->schema_hash());
+            return true;
         }
     } else {
         PTabletError* tablet_error = tablet_errors->Add();
         tablet_error->set_tablet_id(writer->tablet_id());
         tablet_error->set_msg(st.get_error_msg());
     }
+    return false;
+}
+
+void TabletsChannel::_pull_rowsets_to_slaves(
+        const std::vector<DeltaWriter*>& writers,
+        google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec) {
+    struct SlavePull {
+        DeltaWriter* writer;
+        int64_t node_id;
+        brpc::Controller cntl;
+        PTabletWriteSlaveRequest request;
+        PTabletWriteSlaveResult result;
+    };
+    // the slave replicas of all the tablets pull concurrently
+    std::vector<std::unique_ptr<SlavePull>> pulls;
+    for (auto writer : writers) {
+        RowsetSharedPtr rowset = writer->committed_rowset();
+        PTabletWriteSlaveRequest request;
+        RowsetMetaPB rowset_meta_pb;
+        rowset->rowset_meta()->to_rowset_pb(&rowset_meta_pb);
+        request.set_rowset_meta(rowset_meta_pb.SerializeAsString());
+        request.set_rowset_path(rowset->tablet_path());
+        Status st = EnginePullRowsetTask::set_rowset_files(*rowset->rowset_meta(),
+                                                           rowset->tablet_path(), &request);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to get the files of rowset " << rowset->rowset_id()
+                         << ", err=" << st;
+            continue;
+        }
+        request.set_host(BackendOptions::get_localhost());
+        request.set_http_port(config::webserver_port);
+
+        for (auto& node : writer->slave_nodes()) {
+            auto stub = ExecEnv::GetInstance()->brpc_internal_client_cache()->get_client(
+                    node.host(), node.async_internal_port());
+            if (stub == nullptr) {
+                LOG(WARNING) << "failed to get the brpc stub of slave replica " << node.host()
+                             << ":" << node.async_internal_port();
+                continue;
+            }
+            auto pull = std::make_unique<SlavePull>();
+            pull->writer = writer;
+            pull->node_id = node.id();
+            pull->request = request;
+            pull->cntl.set_timeout_ms(config::slave_replica_pull_rowset_rpc_timeout_sec * 1000);
+            stub->request_slave_tablet_pull_rowset(&pull->cntl, &pull->request, &pull->result,
+                                                   brpc::DoNothing());
+            pulls.push_back(std::move(pull));
+        }
+    }
+
+    for (auto& pull : pulls) {
+        brpc::Join(pull->cntl.call_id());
+        Status st = pull->cntl.Failed() ? Status::InternalError(pull->cntl.ErrorText())
+                                        : Status(pull->result.status());
+        if (!st.ok()) {
+            // the replica is not reported as succeeded, and FE judges the quorum
+            LOG(WARNING) << "slave replica " << pull->node_id << " failed to pull the rowset of "
+                         << "tablet " << pull->writer->tablet_id() << ", txn_id=" << _txn_id
+                         << ", err=" << st;
+            continue;
+        }
+        PTabletInfo* tablet_info = tablet_vec->Add();
+        tablet_info->set_tablet_id(pull->writer->tablet_id());
+        tablet_info->set_schema_hash(pull->writer->schema_hash());
+        tablet_info->set_node_id(pull->node_id);
+    }
 }
 
 Status TabletsChannel::reduce_mem_usage(int64_t mem_limit) {
@@ -215,6 +296,39 @@ int64_t TabletsChannel::mem_consumption() {
     return mem_usage;
 }
 
+void TabletsChannel::get_memtable_consumptions(
+        std::vector<std::pair<int64_t, int64_t>>* tablet_memtable_mems, int64_t* flushing_mem) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_state == kFinished) {
+        return;
+    }
+    for (auto& it : _tablet_writers) {
+        int64_t memtable_mem = it.second->memtable_consumption();
+        int64_t writer_flushing_mem = it.second->mem_consumption() - memtable_mem;
+        if (writer_flushing_mem > 0) {
+            // flush_memtable_and_wait() does not flush a writer with memtables in flush queue
+            *flushing_mem += writer_flushing_mem;
+        } else if (memtable_mem > 0) {
+            tablet_memtable_mems->emplace_back(it.first, memtable_mem);
+        }
+    }
+}
+
+Status TabletsChannel::flush_memtables(const std::vector<int64_t>& tablet_ids) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_state == kFinished) {
+        return _close_status;
+    }
+    for (auto tablet_id : tablet_ids) {
+        auto it = _tablet_writers.find(tablet_id);
+        if (it == _tablet_writers.end()) {
+            continue;
+        }
+        RETURN_IF_ERROR(it->second->flush_memtable_and_wait(false));
+    }
+    return Status::OK();
+}
+
 Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& request) {
     std::vector<SlotDescriptor*>* index_slots = nullptr;
     int32_t schema_hash = 0;
@@ -230,6 +344,10 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& request
         ss << "unknown index id, key=" << _key;
         return Status::InternalError(ss.str());
     }
+    std::unordered_map<int64_t, const PNodeInfo*> slave_nodes;
+    for (auto& node : request.slave_nodes()) {
+        slave_nodes.emplace(node.id(), &node);
+    }
     for (auto& tablet : request.tablets()) {
         WriteRequest wrequest;
         wrequest.index_id = request.index_id();
@@ -243,6 +361,12 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& request
         wrequest.slots = index_slots;
         wrequest.is_high_priority = _is_high_priority;
         wrequest.ptable_schema_param = request.schema();
+        for (auto node_id : tablet.slave_node_ids()) {
+            auto it = slave_nodes.find(node_id);
+            if (it != slave_nodes.end()) {
+                wrequest.slave_nodes.push_back(*it->second);
+            }
+        }
 
         DeltaWriter* writer = nullptr;
         auto st = DeltaWriter::open(&wrequest, &writer, _is_vec);
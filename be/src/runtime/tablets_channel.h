@@ -22,12 +22,14 @@
 #include <utility>
 #include <vector>
 
+#include "common/config.h"
 #include "gen_cpp/PaloInternalService_types.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "gutil/strings/substitute.h"
 #include "olap/delta_writer.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/thread_context.h"
 #include "util/bitmap.h"
@@ -90,6 +92,17 @@ public:
 
     int64_t mem_consumption();
 
+    // get the mem consumption of the memtables being written, of the writers which have no
+    // memtable in flush queue, and add the mem consumption of the flushing memtables to
+    // 'flushing_mem'.
+    // no-op when this channel has been closed or cancelled
+    void get_memtable_consumptions(std::vector<std::pair<int64_t, int64_t>>* tablet_memtable_mems,
+                                   int64_t* flushing_mem);
+
+    // submit the memtables of the given tablets to flush queue, without waiting for them.
+    // no-op when this channel has been closed or cancelled
+    Status flush_memtables(const std::vector<int64_t>& tablet_ids);
+
 private:
     template <typename Request>
     Status _get_current_seq(int64_t& cur_seq, const Request& request);
@@ -98,10 +111,16 @@ private:
     Status _open_all_writers(const PTabletWriterOpenRequest& request);
 
     // deal with DeltaWriter close_wait(), add tablet to list for return.
-    void _close_wait(DeltaWriter* writer,
+    // return true if the tablet is committed and added to the list.
+    bool _close_wait(DeltaWriter* writer,
                      google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
                      google::protobuf::RepeatedPtrField<PTabletError>* tablet_error);
 
+    // make the slave replicas of the tablets pull the rowsets committed by the writers, in single
+    // replica load, and add the slave replicas which succeed to the list.
+    void _pull_rowsets_to_slaves(const std::vector<DeltaWriter*>& writers,
+                                 google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
+
     // id of this load channel
     TabletsChannelKey _key;
 
@@ -205,26 +224,61 @@ Status TabletsChannel::add_batch(const TabletWriterAddRequest& request,
         }
     };
 
-    auto send_data = get_send_data();
-    google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors =
-            response->mutable_tablet_errors();
+    struct TabletWrite {
+        int64_t tablet_id;
+        DeltaWriter* writer;
+        const std::vector<int>* row_idxs;
+    };
+    std::vector<TabletWrite> writes;
+    writes.reserve(tablet_to_rowidxs.size());
     for (const auto& tablet_to_rowidxs_it : tablet_to_rowidxs) {
         auto tablet_writer_it = _tablet_writers.find(tablet_to_rowidxs_it.first);
         if (tablet_writer_it == _tablet_writers.end()) {
             return Status::InternalError("unknown tablet to append data, tablet={}",
                                          tablet_to_rowidxs_it.first);
         }
+        writes.push_back({tablet_to_rowidxs_it.first, tablet_writer_it->second,
+                          &tablet_to_rowidxs_it.second});
+    }
 
-        Status st = tablet_writer_it->second->write(&send_data, tablet_to_rowidxs_it.second);
+    auto send_data = get_send_data();
+    // one request carries the rows of many tablets, the tablet writers have their own locks and
+    // are written concurrently, the errors are collected after all the writes are done
+    std::vector<Status> write_status(writes.size());
+    auto write_tablet = [&](size_t i) {
+        write_status[i] = writes[i].writer->write(&send_data, *writes[i].row_idxs);
+    };
+    ThreadPool* write_pool = ExecEnv::GetInstance()->tablet_write_thread_pool();
+    int max_parallel_writes = config::tablet_writer_max_parallel_writes;
+    if (writes.size() > 1 && max_parallel_writes > 1 && write_pool != nullptr) {
+        auto token =
+                write_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT, max_parallel_writes);
+        for (size_t i = 0; i < writes.size(); ++i) {
+            if (!token->submit_func([&write_tablet, i]() { write_tablet(i); }).ok()) {
+                write_tablet(i);
+            }
+        }
+        token->wait();
+    } else {
+        for (size_t i = 0; i < writes.size(); ++i) {
+            write_tablet(i);
+        }
+    }
+
+    google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors =
+            response->mutable_tablet_errors();
+    for (size_t i = 0; i < writes.size(); ++i) {
+        const Status& st = write_status[i];
         if (!st.ok()) {
+            int64_t tablet_id = writes[i].tablet_id;
             auto err_msg = strings::Substitute(
-                    "tablet writer write failed, tablet_id=$0, txn_id=$1, err=$2",
-                    tablet_to_rowidxs_it.first, _txn_id, st.code());
+                    "tablet writer write failed, tablet_id=$0, txn_id=$1, err=$2", tablet_id,
+                    _txn_id, st.code());
             LOG(WARNING) << err_msg;
             PTabletError* error = tablet_errors->Add();
-            error->set_tablet_id(tablet_to_rowidxs_it.first);
+            error->set_tablet_id(tablet_id);
             error->set_msg(err_msg);
-            _broken_tablets.insert(tablet_to_rowidxs_it.first);
+            _broken_tablets.insert(tablet_id);
             // continue write to other tablet.
             // the error will return back to sender.
         }
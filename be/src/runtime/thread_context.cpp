@@ -18,7 +18,9 @@
 #include "runtime/thread_context.h"
 
 #include "runtime/runtime_state.h"
+#include "util/cpu_sampler.h"
 #include "util/doris_metrics.h"
+#include "util/uid_util.h"
 
 namespace doris {
 
@@ -35,6 +37,13 @@ AttachTask::AttachTask(MemTrackerLimiter* mem_tracker, const ThreadContext::Task
 #ifdef USE_MEM_TRACKER
     thread_context()->attach_task(type, task_id, fragment_instance_id, mem_tracker);
 #endif
+    TUniqueId query_id;
+    if (!task_id.empty()) {
+        // the task ids of the queries and loads are their printed ids
+        std::string id = task_id;
+        parse_id(id, &query_id);
+    }
+    CpuSampler::attach_thread(type, query_id, fragment_instance_id);
 }
 
 // AttachTask::AttachTask(const TQueryType::type& query_type,
@@ -67,9 +76,12 @@ AttachTask::AttachTask(RuntimeState* runtime_state) {
             query_to_task_type(runtime_state->query_type()), print_id(runtime_state->query_id()),
             runtime_state->fragment_instance_id(), runtime_state->instance_mem_tracker());
 #endif // USE_MEM_TRACKER
+    CpuSampler::attach_thread(query_to_task_type(runtime_state->query_type()),
+                              runtime_state->query_id(), runtime_state->fragment_instance_id());
 }
 
 AttachTask::~AttachTask() {
+    CpuSampler::detach_thread();
 #ifdef USE_MEM_TRACKER
     thread_context()->detach_task();
 #ifndef NDEBUG
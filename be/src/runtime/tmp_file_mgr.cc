@@ -23,6 +23,7 @@
 #include <filesystem>
 #include <random>
 
+#include "common/config.h"
 #include "olap/storage_engine.h"
 #include "runtime/exec_env.h"
 #include "util/debug_util.h"
@@ -64,6 +65,10 @@ TmpFileMgr::~TmpFileMgr() {
 
 Status TmpFileMgr::init() {
     vector<string> all_tmp_dirs;
+    if (!config::spill_storage_root_path.empty()) {
+        split(all_tmp_dirs, config::spill_storage_root_path, is_any_of(";"), token_compress_on);
+        return init_custom(all_tmp_dirs, true);
+    }
     for (auto& path : _exec_env->store_paths()) {
         all_tmp_dirs.emplace_back(path.path);
     }
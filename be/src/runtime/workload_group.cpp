@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/workload_group.h"
+
+#include "gutil/strings/split.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "util/mem_info.h"
+#include "util/parse_util.h"
+#include "util/string_parser.hpp"
+
+namespace doris {
+
+WorkloadGroup::WorkloadGroup(int64_t id, const Conf& conf, int64_t mem_limit,
+                             MemTrackerLimiter* parent_tracker)
+        : _id(id),
+          _name(conf.name),
+          _cpu_share(conf.cpu_share),
+          _max_concurrency(conf.max_concurrency),
+          _mem_tracker(std::make_unique<MemTrackerLimiter>(mem_limit, "WorkloadGroup#" + conf.name,
+                                                           parent_tracker)) {}
+
+WorkloadGroup::~WorkloadGroup() = default;
+
+Status WorkloadGroup::try_acquire_query_slot() {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_max_concurrency > 0 && _running_queries >= _max_concurrency) {
+        return Status::TooManyTasks("workload group {} already runs {} queries, retry later",
+                                    _name, _running_queries);
+    }
+    ++_running_queries;
+    return Status::OK();
+}
+
+void WorkloadGroup::release_query_slot() {
+    std::lock_guard<std::mutex> l(_lock);
+    DCHECK_GT(_running_queries, 0);
+    --_running_queries;
+}
+
+Status WorkloadGroupMgr::parse(const std::string& groups,
+                               std::vector<WorkloadGroup::Conf>* confs) {
+    std::vector<std::string> group_strs = strings::Split(groups, ";", strings::SkipWhitespace());
+    for (const auto& group : group_strs) {
+        std::vector<std::string> name_and_props = strings::Split(group, ":");
+        if (name_and_props.size() != 2 || name_and_props[0].empty()) {
+            return Status::InvalidArgument("invalid workload group '{}'", group);
+        }
+        WorkloadGroup::Conf conf;
+        conf.name = name_and_props[0];
+        std::vector<std::string> props =
+                strings::Split(name_and_props[1], ",", strings::SkipWhitespace());
+        for (const auto& prop : props) {
+            std::vector<std::string> key_and_value = strings::Split(prop, "=");
+            if (key_and_value.size() != 2) {
+                return Status::InvalidArgument("invalid property '{}' of workload group {}", prop,
+                                               conf.name);
+            }
+            const std::string& key = key_and_value[0];
+            const std::string& value = key_and_value[1];
+            if (key == "mem_limit") {
+                conf.mem_limit = value;
+                continue;
+            }
+            StringParser::ParseResult result;
+            int32_t int_value =
+                    StringParser::string_to_int<int32_t>(value.data(), value.size(), &result);
+            if (result != StringParser::PARSE_SUCCESS || int_value < 0) {
+                return Status::InvalidArgument("invalid property '{}' of workload group {}", prop,
+                                               conf.name);
+            }
+            if (key == "cpu_share" && int_value > 0) {
+                conf.cpu_share = int_value;
+            } else if (key == "max_concurrency") {
+                conf.max_concurrency = int_value;
+            } else {
+                return Status::InvalidArgument("invalid property '{}' of workload group {}", prop,
+                                               conf.name);
+            }
+        }
+        confs->push_back(std::move(conf));
+    }
+    return Status::OK();
+}
+
+Status WorkloadGroupMgr::init(const std::string& groups, MemTrackerLimiter* parent_tracker,
+                              int64_t process_mem_limit) {
+    std::vector<WorkloadGroup::Conf> confs;
+    RETURN_IF_ERROR(parse(groups, &confs));
+    for (const auto& conf : confs) {
+        bool is_percent = false;
+        int64_t mem_limit = ParseUtil::parse_mem_spec(conf.mem_limit, process_mem_limit,
+                                                      MemInfo::physical_mem(), &is_percent);
+        if (mem_limit < 0) {
+            return Status::InvalidArgument("invalid mem_limit '{}' of workload group {}",
+                                           conf.mem_limit, conf.name);
+        }
+        // small negative ids, which the hashes of the query ids the scanners of the queries
+        // without a group are scheduled by are unlikely to collide with
+        int64_t id = -1 - (int64_t)_groups.size();
+        auto group = std::make_unique<WorkloadGroup>(id, conf, mem_limit > 0 ? mem_limit : -1,
+                                                     parent_tracker);
+        if (!_groups.emplace(conf.name, std::move(group)).second) {
+            return Status::InvalidArgument("duplicated workload group {}", conf.name);
+        }
+    }
+    return Status::OK();
+}
+
+WorkloadGroup* WorkloadGroupMgr::get(const std::string& name) const {
+    auto it = _groups.find(name);
+    return it == _groups.end() ? nullptr : it->second.get();
+}
+
+} // namespace doris
@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+
+namespace doris {
+
+class MemTrackerLimiter;
+
+// A class of queries that share a slice of the BE, so that the interactive queries keep their
+// latency while the batch ones run. Each group has:
+// - cpu_share: its share of the scanner threads, relative to 1024. The group, and not each of its
+//   queries, is the unit the FairScanThreadPool is fair to.
+// - mem_limit: the memory limit of all its queries, enforced by the MemTrackerLimiter that is the
+//   parent of their trackers.
+// - max_concurrency: the number of its queries that run on the BE at the same time. The first
+//   fragment of a next one is rejected at once with a retryable status, so that no rpc thread
+//   waits for a slot and no two queries wait for the slots each other holds on other BEs.
+class WorkloadGroup {
+public:
+    struct Conf {
+        std::string name;
+        int cpu_share = 1024;
+        // the memory limit, like the config mem_limit, in percent of the process limit
+        std::string mem_limit = "-1";
+        // 0 for no limit
+        int max_concurrency = 0;
+    };
+
+    // 'mem_limit' is the limit of conf.mem_limit in bytes, -1 for none.
+    WorkloadGroup(int64_t id, const Conf& conf, int64_t mem_limit,
+                  MemTrackerLimiter* parent_tracker);
+    ~WorkloadGroup();
+
+    int64_t id() const { return _id; }
+    const std::string& name() const { return _name; }
+    int cpu_share() const { return _cpu_share; }
+    MemTrackerLimiter* mem_tracker() const { return _mem_tracker.get(); }
+
+    // Takes a query slot, or returns TooManyTasks at once if none is free.
+    Status try_acquire_query_slot();
+    void release_query_slot();
+
+private:
+    const int64_t _id;
+    const std::string _name;
+    const int _cpu_share;
+    const int _max_concurrency;
+    std::unique_ptr<MemTrackerLimiter> _mem_tracker;
+
+    std::mutex _lock;
+    int _running_queries = 0;
+};
+
+// The workload groups of the BE, defined by the config workload_groups. The FE assigns a query to
+// one of them by name with the session variable workload_group.
+class WorkloadGroupMgr {
+public:
+    // Parses the groups, like "interactive:cpu_share=2048,mem_limit=30%,max_concurrency=20;
+    // batch:cpu_share=512,mem_limit=50%".
+    static Status parse(const std::string& groups, std::vector<WorkloadGroup::Conf>* confs);
+
+    Status init(const std::string& groups, MemTrackerLimiter* parent_tracker,
+                int64_t process_mem_limit);
+
+    // Returns the group of 'name', or nullptr if it is not defined.
+    WorkloadGroup* get(const std::string& name) const;
+
+private:
+    std::map<std::string, std::unique_ptr<WorkloadGroup>> _groups;
+};
+
+} // namespace doris
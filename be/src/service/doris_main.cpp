@@ -51,11 +51,13 @@
 #include "olap/storage_engine.h"
 #include "runtime/exec_env.h"
 #include "runtime/heartbeat_flags.h"
+#include "runtime/memory/mem_arbiter.h"
 #include "runtime/memory/mem_tracker_task_pool.h"
 #include "service/backend_options.h"
 #include "service/backend_service.h"
 #include "service/brpc_service.h"
 #include "service/http_service.h"
+#include "util/cpu_sampler.h"
 #include "util/debug_util.h"
 #include "util/doris_metrics.h"
 #include "util/logging.h"
@@ -461,6 +463,13 @@ int main(int argc, char** argv) {
     }
 #endif
 
+    if (doris::config::enable_cpu_sampling) {
+        status = doris::CpuSampler::instance()->start(doris::config::cpu_sampling_frequency);
+        if (!status.ok()) {
+            LOG(WARNING) << "Failed to start the cpu sampler: " << status.get_error_msg();
+        }
+    }
+
     while (!doris::k_doris_exit) {
 #if defined(LEAK_SANITIZER)
         __lsan_do_leak_check();
@@ -471,6 +480,8 @@ int main(int argc, char** argv) {
         doris::MemInfo::refresh_current_mem();
 #endif
         doris::PerfCounters::refresh_proc_status();
+        doris::MemArbiter::refresh();
+        doris::CpuSampler::instance()->aggregate(doris::config::cpu_sampling_retention_s);
 
         // TODO(zxy) 10s is too long to clear the expired task mem tracker.
         // A query mem tracker is about 57 bytes, assuming 10000 qps, which wastes about 55M of memory.
@@ -479,6 +490,7 @@ int main(int argc, char** argv) {
         sleep(1);
     }
 
+    doris::CpuSampler::instance()->stop();
     http_service.stop();
     brpc_service.join();
     daemon.stop();
@@ -21,6 +21,7 @@
 #include "http/action/checksum_action.h"
 #include "http/action/compaction_action.h"
 #include "http/action/config_action.h"
+#include "http/action/cpu_samples_action.h"
 #include "http/action/download_action.h"
 #include "http/action/health_action.h"
 #include "http/action/meta_action.h"
@@ -29,6 +30,7 @@
 #include "http/action/reload_tablet_action.h"
 #include "http/action/reset_rpc_channel_action.h"
 #include "http/action/restore_tablet_action.h"
+#include "http/action/running_queries_action.h"
 #include "http/action/snapshot_action.h"
 #include "http/action/stream_load.h"
 #include "http/action/stream_load_2pc.h"
@@ -109,6 +111,13 @@ Status HttpService::start() {
     // register pprof actions
     PprofActions::setup(_env, _ev_http_server.get(), _pool);
 
+    CpuSamplesAction* cpu_samples_action = _pool.add(new CpuSamplesAction());
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/cpu_samples", cpu_samples_action);
+
+    RunningQueriesAction* running_queries_action = _pool.add(new RunningQueriesAction(_env));
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/running_queries",
+                                      running_queries_action);
+
     // register metrics
     {
         auto action = _pool.add(new MetricsAction(DorisMetrics::instance()->metric_registry()));
@@ -20,6 +20,7 @@
 #include "common/config.h"
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "olap/task/engine_pull_rowset_task.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/data_stream_mgr.h"
 #include "runtime/exec_env.h"
@@ -32,6 +33,7 @@
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "service/brpc.h"
+#include "service/point_query_executor.h"
 #include "util/brpc_client_cache.h"
 #include "util/md5.h"
 #include "util/proto_util.h"
@@ -40,6 +42,7 @@
 #include "util/telemetry/telemetry.h"
 #include "util/thrift_util.h"
 #include "util/uid_util.h"
+#include "vec/exec/file_arrow_scanner.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 
 namespace doris {
@@ -75,7 +78,10 @@ private:
 };
 
 PInternalServiceImpl::PInternalServiceImpl(ExecEnv* exec_env)
-        : _exec_env(exec_env), _tablet_worker_pool(config::number_tablet_writer_threads, 10240) {
+        : _exec_env(exec_env),
+          _tablet_worker_pool(config::number_tablet_writer_threads, 10240),
+          _slave_replica_download_pool(config::number_slave_replica_download_threads, 10240),
+          _tablet_fetch_pool(config::number_tablet_fetch_data_threads, 10240) {
     REGISTER_HOOK_METRIC(add_batch_task_queue_size,
                          [this]() { return _tablet_worker_pool.get_queue_size(); });
     CHECK_EQ(0, bthread_key_create(&btls_key, thread_context_deleter));
@@ -183,7 +189,7 @@ void PInternalServiceImpl::exec_plan_fragment(google::protobuf::RpcController* c
     bool compact = request->has_compact() ? request->compact() : false;
     PFragmentRequestVersion version =
             request->has_version() ? request->version() : PFragmentRequestVersion::VERSION_1;
-    st = _exec_plan_fragment(request->request(), version, compact);
+    st = _exec_plan_fragment(request->request(), version, compact, response);
     if (!st.ok()) {
         LOG(WARNING) << "exec plan fragment failed, errmsg=" << st.get_error_msg();
     }
@@ -344,7 +350,8 @@ void PInternalServiceImpl::tablet_writer_cancel(google::protobuf::RpcController*
 }
 
 Status PInternalServiceImpl::_exec_plan_fragment(const std::string& ser_request,
-                                                 PFragmentRequestVersion version, bool compact) {
+                                                 PFragmentRequestVersion version, bool compact,
+                                                 PExecPlanFragmentResult* response) {
     if (version == PFragmentRequestVersion::VERSION_1) {
         // VERSION_1 should be removed in v1.2
         TExecPlanFragmentParams t_request;
@@ -362,6 +369,18 @@ Status PInternalServiceImpl::_exec_plan_fragment(const std::string& ser_request,
             RETURN_IF_ERROR(deserialize_thrift_msg(buf, &len, compact, &t_request));
         }
 
+        std::vector<std::string> cached_digests;
+        std::vector<std::string> missing_digests;
+        Status st = _exec_env->fragment_mgr()->resolve_fragment_templates(
+                &t_request.paramsList, &cached_digests, &missing_digests);
+        for (const auto& digest : cached_digests) {
+            response->add_cached_fragment_digests(digest);
+        }
+        for (const auto& digest : missing_digests) {
+            response->add_missing_fragment_digests(digest);
+        }
+        RETURN_IF_ERROR(st);
+
         for (const TExecPlanFragmentParams& params : t_request.paramsList) {
             RETURN_IF_ERROR(_exec_env->fragment_mgr()->exec_plan_fragment(params));
         }
@@ -617,15 +636,46 @@ Status PInternalServiceImpl::_fold_constant_expr(const std::string& ser_request,
     return FoldConstantExecutor().fold_constant_vexpr(t_request, response);
 }
 
+void PInternalServiceImpl::fetch_table_schema(google::protobuf::RpcController* cntl_base,
+                                              const PFetchTableSchemaRequest* request,
+                                              PFetchTableSchemaResult* response,
+                                              google::protobuf::Closure* done) {
+    SCOPED_SWITCH_BTHREAD_TLS();
+    brpc::ClosureGuard closure_guard(done);
+    Status st = _fetch_table_schema(request, response);
+    if (!st.ok()) {
+        LOG(WARNING) << "fetch table schema failed, errmsg=" << st.get_error_msg();
+    }
+    st.to_protobuf(response->mutable_status());
+}
+
+Status PInternalServiceImpl::_fetch_table_schema(const PFetchTableSchemaRequest* request,
+                                                 PFetchTableSchemaResult* response) {
+    TFileScanRange file_scan_range;
+    {
+        const uint8_t* buf = (const uint8_t*)request->file_scan_range().data();
+        uint32_t len = request->file_scan_range().size();
+        RETURN_IF_ERROR(deserialize_thrift_msg(buf, &len, false, &file_scan_range));
+    }
+    if (file_scan_range.ranges.empty()) {
+        return Status::InvalidArgument("No file to fetch the schema from");
+    }
+    std::vector<std::string> names;
+    std::vector<TypeDescriptor> types;
+    RETURN_IF_ERROR(vectorized::FileArrowScanner::read_file_schema(
+            _exec_env, file_scan_range.params, file_scan_range.ranges[0], &names, &types));
+    for (size_t i = 0; i < names.size(); ++i) {
+        response->add_column_names(names[i]);
+        types[i].to_protobuf(response->add_column_types());
+    }
+    return Status::OK();
+}
+
 void PInternalServiceImpl::transmit_block(google::protobuf::RpcController* cntl_base,
                                           const PTransmitDataParams* request,
                                           PTransmitDataResult* response,
                                           google::protobuf::Closure* done) {
     SCOPED_SWITCH_BTHREAD_TLS();
-    // TODO(zxy) delete in 1.2 version
-    brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
-    attachment_transfer_request_block<PTransmitDataParams>(request, cntl);
-
     _transmit_block(cntl_base, request, response, done, Status::OK());
 }
 
@@ -670,7 +720,13 @@ void PInternalServiceImpl::_transmit_block(google::protobuf::RpcController* cntl
     Status st;
     st.to_protobuf(response->mutable_status());
     if (extract_st.ok()) {
-        st = _exec_env->vstream_mgr()->transmit_block(request, &done);
+        // The column values sent as attachment are deserialized straight from it instead of
+        // being copied into the request first.
+        const butil::IOBuf* column_values = nullptr;
+        if (request->transfer_by_attachment()) {
+            column_values = &static_cast<brpc::Controller*>(cntl_base)->request_attachment();
+        }
+        st = _exec_env->vstream_mgr()->transmit_block(request, &done, column_values);
         if (!st.ok()) {
             LOG(WARNING) << "transmit_block failed, message=" << st.get_error_msg()
                          << ", fragment_instance_id=" << print_id(request->finst_id())
@@ -758,4 +814,46 @@ void PInternalServiceImpl::hand_shake(google::protobuf::RpcController* cntl_base
     response->mutable_status()->set_status_code(0);
 }
 
+void PInternalServiceImpl::tablet_fetch_data(google::protobuf::RpcController* cntl_base,
+                                             const PTabletKeyLookupRequest* request,
+                                             PTabletKeyLookupResponse* response,
+                                             google::protobuf::Closure* done) {
+    // the segments are loaded and read synchronously, which should not block the brpc worker
+    bool ret = _tablet_fetch_pool.offer([request, response, done]() {
+        brpc::ClosureGuard closure_guard(done);
+        PointQueryExecutor executor;
+        Status st = executor.init(request, response);
+        if (st.ok()) {
+            st = executor.lookup();
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to fetch data from tablet " << request->tablet_id()
+                         << ", error=" << st.to_string();
+        }
+        st.to_protobuf(response->mutable_status());
+    });
+    if (!ret) {
+        brpc::ClosureGuard closure_guard(done);
+        Status::ServiceUnavailable("the point queries are too many, tablet fetch pool is full")
+                .to_protobuf(response->mutable_status());
+    }
+}
+
+void PInternalServiceImpl::request_slave_tablet_pull_rowset(
+        google::protobuf::RpcController* controller, const PTabletWriteSlaveRequest* request,
+        PTabletWriteSlaveResult* response, google::protobuf::Closure* done) {
+    // downloading the files takes a while, which should not block the brpc worker
+    bool ret = _slave_replica_download_pool.offer([request, response, done]() {
+        brpc::ClosureGuard closure_guard(done);
+        EnginePullRowsetTask task(*request);
+        Status st = task.execute();
+        st.to_protobuf(response->mutable_status());
+    });
+    if (!ret) {
+        brpc::ClosureGuard closure_guard(done);
+        Status::InternalError("failed to offer the pull rowset task")
+                .to_protobuf(response->mutable_status());
+    }
+}
+
 } // namespace doris
@@ -138,6 +138,10 @@ public:
     void fold_constant_expr(google::protobuf::RpcController* controller,
                             const PConstantExprRequest* request, PConstantExprResult* response,
                             google::protobuf::Closure* done) override;
+    void fetch_table_schema(google::protobuf::RpcController* controller,
+                            const PFetchTableSchemaRequest* request,
+                            PFetchTableSchemaResult* response,
+                            google::protobuf::Closure* done) override;
     void check_rpc_channel(google::protobuf::RpcController* controller,
                            const PCheckRPCChannelRequest* request,
                            PCheckRPCChannelResponse* response,
@@ -149,12 +153,25 @@ public:
     void hand_shake(google::protobuf::RpcController* controller, const PHandShakeRequest* request,
                     PHandShakeResponse* response, google::protobuf::Closure* done) override;
 
+    void tablet_fetch_data(google::protobuf::RpcController* controller,
+                           const PTabletKeyLookupRequest* request,
+                           PTabletKeyLookupResponse* response,
+                           google::protobuf::Closure* done) override;
+
+    void request_slave_tablet_pull_rowset(google::protobuf::RpcController* controller,
+                                          const PTabletWriteSlaveRequest* request,
+                                          PTabletWriteSlaveResult* response,
+                                          google::protobuf::Closure* done) override;
+
 private:
     Status _exec_plan_fragment(const std::string& s_request, PFragmentRequestVersion version,
-                               bool compact);
+                               bool compact, PExecPlanFragmentResult* response);
 
     Status _fold_constant_expr(const std::string& ser_request, PConstantExprResult* response);
 
+    Status _fetch_table_schema(const PFetchTableSchemaRequest* request,
+                               PFetchTableSchemaResult* response);
+
     void _transmit_data(::google::protobuf::RpcController* controller,
                         const ::doris::PTransmitDataParams* request,
                         ::doris::PTransmitDataResult* response, ::google::protobuf::Closure* done,
@@ -178,6 +195,10 @@ private:
 private:
     ExecEnv* _exec_env;
     PriorityThreadPool _tablet_worker_pool;
+    // for the slave replicas to download the rowsets in single replica load
+    PriorityThreadPool _slave_replica_download_pool;
+    // for the point queries, which read the segments synchronously
+    PriorityThreadPool _tablet_fetch_pool;
 };
 
 } // namespace doris
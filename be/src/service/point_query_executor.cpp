@@ -0,0 +1,196 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "service/point_query_executor.h"
+
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "olap/row_cursor.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/segment_loader.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet_manager.h"
+#include "olap/tablet_meta.h"
+#include "olap/tuple.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_factory.hpp"
+
+namespace doris {
+
+Status PointQueryExecutor::init(const PTabletKeyLookupRequest* request,
+                                PTabletKeyLookupResponse* response) {
+    _request = request;
+    _response = response;
+    _tablet = StorageEngine::instance()->tablet_manager()->get_tablet(request->tablet_id());
+    if (_tablet == nullptr) {
+        return Status::NotFound("tablet {} not found", request->tablet_id());
+    }
+    if (_tablet->keys_type() != UNIQUE_KEYS || !_tablet->enable_unique_key_merge_on_write()) {
+        return Status::NotSupported("tablet {} is not a unique key tablet with merge-on-write",
+                                    request->tablet_id());
+    }
+    _tablet_schema = &_tablet->tablet_schema();
+    _version = request->has_version() ? request->version() : _tablet->max_version().second;
+
+    if (request->return_columns_size() == 0) {
+        for (uint32_t cid = 0; cid < _tablet_schema->num_columns(); ++cid) {
+            _return_columns.push_back(cid);
+        }
+    } else {
+        for (auto& name : request->return_columns()) {
+            int32_t cid = _tablet_schema->field_index(name);
+            if (cid < 0) {
+                return Status::InvalidArgument("unknown column {} in tablet {}", name,
+                                               request->tablet_id());
+            }
+            _return_columns.push_back(cid);
+        }
+    }
+    return Status::OK();
+}
+
+Status PointQueryExecutor::lookup() {
+    RETURN_IF_ERROR(_encode_keys());
+    RETURN_IF_ERROR(_lookup_row_keys());
+    return _read_rows();
+}
+
+Status PointQueryExecutor::_encode_keys() {
+    size_t num_key_columns = _tablet_schema->num_key_columns();
+    for (auto& key_tuple : _request->key_tuples()) {
+        std::vector<std::string> values(key_tuple.key_column_reps().begin(),
+                                        key_tuple.key_column_reps().end());
+        if (values.size() != num_key_columns) {
+            return Status::InvalidArgument("a key tuple has {} values, but the tablet has {} keys",
+                                           values.size(), num_key_columns);
+        }
+        RowCursor cursor;
+        RETURN_IF_ERROR(cursor.init_scan_key(*_tablet_schema, values));
+        RETURN_IF_ERROR(cursor.from_tuple(OlapTuple(values)));
+        // encoded the same way as the keys of the primary key index
+        std::string encoded_key;
+        for (size_t cid = 0; cid < num_key_columns; ++cid) {
+            auto cell = cursor.cell(cid);
+            if (cell.is_null()) {
+                encoded_key.push_back(KEY_NULL_FIRST_MARKER);
+                continue;
+            }
+            encoded_key.push_back(KEY_NORMAL_MARKER);
+            cursor.schema()->column(cid)->full_encode_ascending(cell.cell_ptr(), &encoded_key);
+        }
+        _encoded_keys.push_back(std::move(encoded_key));
+    }
+    return Status::OK();
+}
+
+Status PointQueryExecutor::_lookup_row_keys() {
+    const DeleteBitmap& delete_bitmap = _tablet->tablet_meta()->delete_bitmap();
+    std::shared_lock rdlock(_tablet->get_header_lock());
+    for (int i = 0; i < _encoded_keys.size(); ++i) {
+        RowReadContext row;
+        Status st = _tablet->lookup_row_key(_encoded_keys[i], &row.location, _version,
+                                            &row.rowset);
+        if (st.is_not_found()) {
+            continue;
+        }
+        RETURN_IF_ERROR(st);
+        if (delete_bitmap.contains_agg(
+                    {row.location.rowset_id, row.location.segment_id, _version},
+                    row.location.row_id)) {
+            continue;
+        }
+        row.key_tuple_index = i;
+        _rows.push_back(std::move(row));
+    }
+    return Status::OK();
+}
+
+Status PointQueryExecutor::_read_rows() {
+    vectorized::Block block = _tablet_schema->create_block(_return_columns);
+    if (_rows.empty()) {
+        return Status::OK();
+    }
+    auto columns = block.mutate_columns();
+    // the segments stay referenced until all the rows are read
+    std::unordered_map<RowsetId, std::vector<segment_v2::SegmentSharedPtr>, HashOfRowsetId>
+            rowset_segments;
+    for (auto& row : _rows) {
+        auto it = rowset_segments.find(row.rowset->rowset_id());
+        if (it == rowset_segments.end()) {
+            SegmentCacheHandle segment_cache_handle;
+            RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(
+                    std::static_pointer_cast<BetaRowset>(row.rowset), &segment_cache_handle,
+                    true));
+            it = rowset_segments
+                         .emplace(row.rowset->rowset_id(), segment_cache_handle.get_segments())
+                         .first;
+        }
+        auto& segment = it->second[row.location.segment_id];
+        bool is_deleted = false;
+        RETURN_IF_ERROR(_is_delete_sign_set(segment, row.location.row_id, &is_deleted));
+        if (is_deleted) {
+            continue;
+        }
+        RETURN_IF_ERROR(_read_row(segment, row.location.row_id, columns));
+        _response->add_key_tuple_indexes(row.key_tuple_index);
+    }
+    block.set_columns(std::move(columns));
+
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    return block.serialize(_response->mutable_block(), &uncompressed_bytes, &compressed_bytes);
+}
+
+Status PointQueryExecutor::_read_row(const segment_v2::SegmentSharedPtr& segment, rowid_t row_id,
+                                     vectorized::MutableColumns& columns) {
+    if (segment->has_row_store()) {
+        std::vector<const TabletColumn*> tablet_columns;
+        std::vector<vectorized::IColumn*> dst;
+        for (size_t i = 0; i < _return_columns.size(); ++i) {
+            tablet_columns.push_back(&_tablet_schema->column(_return_columns[i]));
+            dst.push_back(columns[i].get());
+        }
+        Status st =
+                segment->read_columns_from_row_store(tablet_columns, &row_id, 1, &_stats, dst);
+        if (!st.is_not_supported()) {
+            return st;
+        }
+    }
+    for (size_t i = 0; i < _return_columns.size(); ++i) {
+        RETURN_IF_ERROR(segment->read_column_by_rowids(_tablet_schema->column(_return_columns[i]),
+                                                       &row_id, 1, &_stats, columns[i]));
+    }
+    return Status::OK();
+}
+
+Status PointQueryExecutor::_is_delete_sign_set(const segment_v2::SegmentSharedPtr& segment,
+                                               rowid_t row_id, bool* is_deleted) {
+    int32_t delete_sign_idx = _tablet_schema->delete_sign_idx();
+    if (delete_sign_idx < 0) {
+        *is_deleted = false;
+        return Status::OK();
+    }
+    const TabletColumn& column = _tablet_schema->column(delete_sign_idx);
+    auto delete_sign = vectorized::DataTypeFactory::instance().create_data_type(column)
+                               ->create_column();
+    RETURN_IF_ERROR(segment->read_column_by_rowids(column, &row_id, 1, &_stats, delete_sign));
+    *is_deleted = delete_sign->get_int(0) != 0;
+    return Status::OK();
+}
+
+} // namespace doris
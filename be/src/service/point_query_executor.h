@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/rowset.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/tablet.h"
+#include "olap/utils.h"
+#include "vec/columns/column.h"
+
+namespace doris {
+
+// Serves the queries of rows by their primary keys on a unique key tablet with merge-on-write
+// enabled, without planning and executing a fragment: the rows are located by the primary key
+// index of the segments, filtered by the delete bitmap of the tablet, and read from the column
+// pages, which are usually in the page cache.
+class PointQueryExecutor {
+public:
+    Status init(const PTabletKeyLookupRequest* request, PTabletKeyLookupResponse* response);
+
+    Status lookup();
+
+private:
+    struct RowReadContext {
+        RowsetSharedPtr rowset;
+        RowLocation location;
+        int key_tuple_index;
+    };
+
+    Status _encode_keys();
+    Status _lookup_row_keys();
+    Status _read_rows();
+    // read the return columns of a row, from the row store of the segment if it has one
+    Status _read_row(const segment_v2::SegmentSharedPtr& segment, rowid_t row_id,
+                     vectorized::MutableColumns& columns);
+    // whether the row is deleted by the delete sign column
+    Status _is_delete_sign_set(const segment_v2::SegmentSharedPtr& segment, rowid_t row_id,
+                               bool* is_deleted);
+
+    const PTabletKeyLookupRequest* _request = nullptr;
+    PTabletKeyLookupResponse* _response = nullptr;
+    TabletSharedPtr _tablet;
+    const TabletSchema* _tablet_schema = nullptr;
+    uint32_t _version = 0;
+    std::vector<uint32_t> _return_columns;
+    std::vector<std::string> _encoded_keys;
+    std::vector<RowReadContext> _rows;
+    OlapReaderStatistics _stats;
+};
+
+} // namespace doris
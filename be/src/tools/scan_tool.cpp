@@ -0,0 +1,432 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/status.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/strings/split.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "io/fs/s3_file_system.h"
+#include "olap/comparison_predicate.h"
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/schema.h"
+#include "olap/tablet_schema.h"
+#include "util/file_utils.h"
+#include "util/s3_util.h"
+#include "util/stopwatch.hpp"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/olap/vgeneric_iterators.h"
+
+using doris::Status;
+
+DEFINE_string(column_types, "int,bigint,varchar",
+              "the types of the columns, the first one is the sort key: int, bigint, double, "
+              "varchar, string");
+DEFINE_int32(num_segments, 1, "the number of the segments generated");
+DEFINE_int64(rows_per_segment, 1000000, "the number of the rows of each segment");
+DEFINE_int64(cardinality, 10000, "the number of the distinct values of each column");
+DEFINE_int32(string_length, 16, "the max length of the string values");
+DEFINE_string(encoding, "default",
+              "default, adaptive for the numeric columns or fsst for the string columns");
+DEFINE_string(compression, "LZ4F",
+              "the page compression: NO_COMPRESSION, SNAPPY, LZ4, LZ4F, ZLIB, ZSTD");
+DEFINE_string(predicate, "none", "the predicate on the first int or bigint column: none, eq, lt");
+DEFINE_double(selectivity, 0.1, "the fraction of the rows passing the lt predicate");
+DEFINE_int32(read_columns, 0, "the number of the first columns read, 0 reads all the columns");
+DEFINE_string(reader, "segment",
+              "segment reads the segments one by one, merge merges them by the sort key like "
+              "the reads of the overlapping rowsets");
+DEFINE_bool(use_page_cache, false, "whether the pages read are cached");
+DEFINE_int64(page_cache_mbytes, 1024, "the capacity of the page cache");
+DEFINE_int32(iterations, 3, "the number of the scans measured");
+DEFINE_string(segment_dir, "./scan_tool_segments", "the local directory of the segments");
+DEFINE_string(s3_endpoint, "", "scan the segments uploaded to S3 instead of the local ones if set");
+DEFINE_string(s3_region, "", "the region of S3");
+DEFINE_string(s3_ak, "", "the access key of S3");
+DEFINE_string(s3_sk, "", "the secret key of S3");
+DEFINE_string(s3_bucket, "", "the bucket of the segments on S3");
+DEFINE_string(s3_prefix, "scan_tool", "the prefix of the segments on S3");
+
+std::string get_usage(const std::string& progname) {
+    std::stringstream ss;
+    ss << progname << " is the Doris BE scan tool.\n";
+    ss << "It generates synthetic segments and measures the scans of them.\n";
+    ss << "Usage:\n";
+    ss << "./scan_tool --column_types=int,bigint,varchar --rows_per_segment=1000000 "
+          "--cardinality=10000 --compression=ZSTD\n";
+    ss << "./scan_tool --column_types=int,varchar,varchar --predicate=lt --selectivity=0.01 "
+          "--read_columns=2 --use_page_cache\n";
+    ss << "./scan_tool --num_segments=4 --reader=merge --encoding=adaptive\n";
+    ss << "./scan_tool --s3_endpoint=endpoint --s3_region=region --s3_ak=ak --s3_sk=sk "
+          "--s3_bucket=bucket\n";
+    return ss.str();
+}
+
+namespace doris {
+
+// The values of a column are generated from their index in [0, cardinality), which keeps the
+// order, so the sort key is generated sorted by sorting the indexes.
+class ValueGenerator {
+public:
+    ValueGenerator(FieldType type, int64_t cardinality, std::mt19937_64* rng)
+            : _type(type), _cardinality(cardinality) {
+        if (_type == OLAP_FIELD_TYPE_VARCHAR || _type == OLAP_FIELD_TYPE_STRING) {
+            std::uniform_int_distribution<int> length_dist(1, FLAGS_string_length);
+            std::uniform_int_distribution<int> char_dist('a', 'z');
+            _dictionary.resize(_cardinality);
+            for (auto& value : _dictionary) {
+                value.resize(length_dist(*rng));
+                for (auto& c : value) {
+                    c = char_dist(*rng);
+                }
+            }
+            std::sort(_dictionary.begin(), _dictionary.end());
+        }
+    }
+
+    int64_t to_int(int64_t index) const {
+        return _type == OLAP_FIELD_TYPE_BIGINT ? index * 1000003 : index;
+    }
+
+    void insert(vectorized::IColumn* column, int64_t index) const {
+        switch (_type) {
+        case OLAP_FIELD_TYPE_INT:
+            assert_cast<vectorized::ColumnInt32*>(column)->insert_value(index);
+            break;
+        case OLAP_FIELD_TYPE_BIGINT:
+            assert_cast<vectorized::ColumnInt64*>(column)->insert_value(to_int(index));
+            break;
+        case OLAP_FIELD_TYPE_DOUBLE:
+            assert_cast<vectorized::ColumnFloat64*>(column)->insert_value(index * 0.5);
+            break;
+        default:
+            column->insert_data(_dictionary[index].data(), _dictionary[index].size());
+            break;
+        }
+    }
+
+private:
+    FieldType _type;
+    int64_t _cardinality;
+    std::vector<std::string> _dictionary;
+};
+
+static Status create_tablet_schema(TabletSchema* tablet_schema) {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(DUP_KEYS);
+    schema_pb.set_num_short_key_columns(1);
+    segment_v2::CompressionTypePB compression;
+    if (!segment_v2::CompressionTypePB_Parse(FLAGS_compression, &compression)) {
+        return Status::InvalidArgument("invalid compression {}", FLAGS_compression);
+    }
+    schema_pb.set_compression_type(compression);
+    int32_t unique_id = 0;
+    std::vector<std::string> types =
+            strings::Split(FLAGS_column_types, ",", strings::SkipWhitespace());
+    for (auto& type : types) {
+        ColumnPB* column = schema_pb.add_column();
+        column->set_unique_id(unique_id);
+        column->set_name("c" + std::to_string(unique_id));
+        column->set_is_key(unique_id == 0);
+        column->set_aggregation("NONE");
+        column->set_is_nullable(false);
+        if (type == "int") {
+            column->set_type("INT");
+            column->set_length(4);
+        } else if (type == "bigint") {
+            column->set_type("BIGINT");
+            column->set_length(8);
+        } else if (type == "double") {
+            column->set_type("DOUBLE");
+            column->set_length(8);
+        } else if (type == "varchar") {
+            column->set_type("VARCHAR");
+            column->set_length(65533);
+            column->set_index_length(4);
+        } else if (type == "string") {
+            column->set_type("STRING");
+            column->set_length(2147483643);
+            column->set_index_length(4);
+        } else {
+            return Status::InvalidArgument("invalid column type {}", type);
+        }
+        ++unique_id;
+    }
+    if (unique_id == 0) {
+        return Status::InvalidArgument("no column types");
+    }
+    schema_pb.set_next_column_unique_id(unique_id);
+    tablet_schema->init_from_pb(schema_pb);
+    return Status::OK();
+}
+
+static Status write_segment(const TabletSchema& tablet_schema,
+                            const std::vector<ValueGenerator>& generators, uint32_t segment_id,
+                            std::mt19937_64* rng, std::string* path) {
+    *path = fmt::format("{}/{}.dat", FLAGS_segment_dir, segment_id);
+    io::FileWriterPtr file_writer;
+    RETURN_IF_ERROR(io::global_local_filesystem()->create_file(*path, &file_writer));
+    SegmentWriterOptions opts;
+    segment_v2::SegmentWriter writer(file_writer.get(), segment_id, &tablet_schema, nullptr,
+                                     INT32_MAX, opts);
+    RETURN_IF_ERROR(writer.init(0));
+
+    std::uniform_int_distribution<int64_t> index_dist(0, FLAGS_cardinality - 1);
+    std::vector<int64_t> keys(FLAGS_rows_per_segment);
+    for (auto& key : keys) {
+        key = index_dist(*rng);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    constexpr int64_t BATCH_SIZE = 4096;
+    for (int64_t start = 0; start < FLAGS_rows_per_segment; start += BATCH_SIZE) {
+        int64_t num_rows = std::min(BATCH_SIZE, FLAGS_rows_per_segment - start);
+        auto block = tablet_schema.create_block();
+        auto columns = block.mutate_columns();
+        for (int64_t row = start; row < start + num_rows; ++row) {
+            generators[0].insert(columns[0].get(), keys[row]);
+            for (size_t cid = 1; cid < columns.size(); ++cid) {
+                generators[cid].insert(columns[cid].get(), index_dist(*rng));
+            }
+        }
+        block.set_columns(std::move(columns));
+        RETURN_IF_ERROR(writer.append_block(&block, 0, num_rows));
+    }
+    uint64_t segment_size = 0;
+    uint64_t index_size = 0;
+    RETURN_IF_ERROR(writer.finalize(&segment_size, &index_size));
+    RETURN_IF_ERROR(file_writer->close());
+    std::cout << "wrote segment " << *path << ", size: " << segment_size
+              << ", index size: " << index_size << std::endl;
+    return Status::OK();
+}
+
+template <typename T>
+static ColumnPredicate* create_predicate(T value, T threshold) {
+    if (FLAGS_predicate == "eq") {
+        return new EqualPredicate<T>(0, value);
+    }
+    return new LessPredicate<T>(0, threshold);
+}
+
+static Status create_predicates(const TabletSchema& tablet_schema,
+                                const ValueGenerator& generator,
+                                std::vector<std::unique_ptr<ColumnPredicate>>* predicates) {
+    if (FLAGS_predicate == "none") {
+        return Status::OK();
+    }
+    if (FLAGS_predicate != "eq" && FLAGS_predicate != "lt") {
+        return Status::InvalidArgument("invalid predicate {}", FLAGS_predicate);
+    }
+    int64_t value = generator.to_int(FLAGS_cardinality / 2);
+    int64_t threshold = generator.to_int(FLAGS_cardinality * FLAGS_selectivity);
+    switch (tablet_schema.column(0).type()) {
+    case OLAP_FIELD_TYPE_INT:
+        predicates->emplace_back(create_predicate<int32_t>(value, threshold));
+        break;
+    case OLAP_FIELD_TYPE_BIGINT:
+        predicates->emplace_back(create_predicate<int64_t>(value, threshold));
+        break;
+    default:
+        return Status::InvalidArgument("the predicate needs an int or bigint first column");
+    }
+    return Status::OK();
+}
+
+static Status scan(const TabletSchema& tablet_schema,
+                   const std::vector<std::shared_ptr<segment_v2::Segment>>& segments,
+                   const std::vector<std::unique_ptr<ColumnPredicate>>& predicates,
+                   OlapReaderStatistics* stats, int64_t* rows, int64_t* bytes) {
+    size_t num_columns = tablet_schema.num_columns();
+    if (FLAGS_read_columns > 0) {
+        num_columns = std::min<size_t>(num_columns, FLAGS_read_columns);
+    }
+    std::vector<uint32_t> return_columns(num_columns);
+    std::iota(return_columns.begin(), return_columns.end(), 0);
+    Schema schema(tablet_schema.columns(), return_columns);
+
+    StorageReadOptions read_opts;
+    read_opts.stats = stats;
+    read_opts.use_page_cache = FLAGS_use_page_cache;
+    read_opts.tablet_schema = &tablet_schema;
+    for (auto& predicate : predicates) {
+        read_opts.column_predicates.push_back(predicate.get());
+    }
+
+    std::vector<RowwiseIterator*> iterators;
+    for (auto& segment : segments) {
+        std::unique_ptr<RowwiseIterator> iter;
+        RETURN_IF_ERROR(segment->new_iterator(schema, read_opts, &iter));
+        // the segment is skipped when its zone map doesn't pass the predicates
+        if (iter != nullptr) {
+            iterators.push_back(iter.release());
+        }
+    }
+    if (iterators.empty()) {
+        return Status::OK();
+    }
+    std::unique_ptr<RowwiseIterator> reader(
+            FLAGS_reader == "merge"
+                    ? vectorized::new_merge_iterator(iterators, -1, false, nullptr)
+                    : vectorized::new_union_iterator(iterators));
+    RETURN_IF_ERROR(reader->init(read_opts));
+
+    auto block = tablet_schema.create_block(return_columns);
+    while (true) {
+        Status st = reader->next_batch(&block);
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+        *rows += block.rows();
+        *bytes += block.bytes();
+        block.clear_column_data();
+    }
+    return Status::OK();
+}
+
+static void print_stats(const OlapReaderStatistics& stats, int64_t rows, int64_t bytes,
+                        int64_t elapsed_ns) {
+    double seconds = elapsed_ns / 1e9;
+    auto ms = [](int64_t ns) { return ns / 1000000.0; };
+    std::cout << std::fixed << std::setprecision(2) << "  time: " << ms(elapsed_ns) << " ms"
+              << ", rows: " << rows << ", rows/s: " << rows / seconds
+              << ", output MB/s: " << bytes / seconds / 1048576
+              << ", read MB/s: " << stats.compressed_bytes_read / seconds / 1048576 << "\n";
+    std::cout << "  rows read: " << stats.raw_rows_read
+              << ", filtered by zone map: " << stats.rows_stats_filtered
+              << ", by predicate: " << stats.rows_vec_cond_filtered
+              << ", pages: " << stats.total_pages_num << ", cached: " << stats.cached_pages_num
+              << "\n";
+    std::cout << "  io: " << ms(stats.io_ns) << " ms, decompress: " << ms(stats.decompress_ns)
+              << " ms, index load: " << ms(stats.index_load_ns)
+              << " ms, block init: " << ms(stats.block_init_ns)
+              << " ms, first read: " << ms(stats.first_read_ns)
+              << " ms, lazy read: " << ms(stats.lazy_read_ns)
+              << " ms, vec cond: " << ms(stats.vec_cond_ns)
+              << " ms, short cond: " << ms(stats.short_cond_ns)
+              << " ms, output: " << ms(stats.output_col_ns) << " ms" << std::endl;
+}
+
+static Status run() {
+    if (FLAGS_encoding == "adaptive") {
+        config::enable_adaptive_numeric_encoding = true;
+    } else if (FLAGS_encoding == "fsst") {
+        config::enable_fsst_string_encoding = true;
+    } else if (FLAGS_encoding != "default") {
+        return Status::InvalidArgument("invalid encoding {}", FLAGS_encoding);
+    }
+    if (FLAGS_cardinality <= 0 || FLAGS_rows_per_segment <= 0 || FLAGS_num_segments <= 0) {
+        return Status::InvalidArgument("cardinality, rows and segments should be positive");
+    }
+    TabletSchema tablet_schema;
+    RETURN_IF_ERROR(create_tablet_schema(&tablet_schema));
+
+    std::mt19937_64 rng(20221014);
+    std::vector<ValueGenerator> generators;
+    for (auto& column : tablet_schema.columns()) {
+        generators.emplace_back(column.type(), FLAGS_cardinality, &rng);
+    }
+    std::vector<std::unique_ptr<ColumnPredicate>> predicates;
+    RETURN_IF_ERROR(create_predicates(tablet_schema, generators[0], &predicates));
+
+    if (FileUtils::check_exist(FLAGS_segment_dir)) {
+        RETURN_IF_ERROR(FileUtils::remove_all(FLAGS_segment_dir));
+    }
+    RETURN_IF_ERROR(FileUtils::create_dir(FLAGS_segment_dir));
+    std::vector<std::string> paths(FLAGS_num_segments);
+    for (uint32_t segment_id = 0; segment_id < paths.size(); ++segment_id) {
+        RETURN_IF_ERROR(
+                write_segment(tablet_schema, generators, segment_id, &rng, &paths[segment_id]));
+    }
+
+    io::FileSystemPtr fs;
+    if (FLAGS_s3_endpoint.empty()) {
+        fs = std::shared_ptr<io::FileSystem>(io::global_local_filesystem(), [](auto*) {});
+    } else {
+        std::map<std::string, std::string> properties = {{S3_AK, FLAGS_s3_ak},
+                                                         {S3_SK, FLAGS_s3_sk},
+                                                         {S3_ENDPOINT, FLAGS_s3_endpoint},
+                                                         {S3_REGION, FLAGS_s3_region}};
+        auto s3_fs = std::make_shared<io::S3FileSystem>(properties, FLAGS_s3_bucket,
+                                                        FLAGS_s3_prefix, "scan_tool");
+        RETURN_IF_ERROR(s3_fs->connect());
+        for (auto& path : paths) {
+            std::string remote_path = std::filesystem::path(path).filename();
+            RETURN_IF_ERROR(s3_fs->upload(path, remote_path));
+            path = remote_path;
+        }
+        fs = std::move(s3_fs);
+    }
+
+    std::vector<std::shared_ptr<segment_v2::Segment>> segments(paths.size());
+    for (uint32_t segment_id = 0; segment_id < paths.size(); ++segment_id) {
+        RETURN_IF_ERROR(segment_v2::Segment::open(fs.get(), paths[segment_id], segment_id,
+                                                  &tablet_schema, &segments[segment_id]));
+    }
+
+    for (int i = 0; i < FLAGS_iterations; ++i) {
+        OlapReaderStatistics stats;
+        int64_t rows = 0;
+        int64_t bytes = 0;
+        MonotonicStopWatch watch;
+        watch.start();
+        RETURN_IF_ERROR(scan(tablet_schema, segments, predicates, &stats, &rows, &bytes));
+        std::cout << "scan " << i << ":\n";
+        print_stats(stats, rows, bytes, watch.elapsed_time());
+    }
+    return Status::OK();
+}
+
+} // namespace doris
+
+int main(int argc, char** argv) {
+    std::string usage = get_usage(argv[0]);
+    gflags::SetUsageMessage(usage);
+    google::ParseCommandLineFlags(&argc, &argv, true);
+
+    doris::StoragePageCache::create_global_cache(FLAGS_page_cache_mbytes << 20, 10);
+    Status st = doris::run();
+    if (!st.ok()) {
+        std::cout << "scan failed: " << st.to_string() << std::endl;
+        return -1;
+    }
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}
@@ -309,6 +309,37 @@ public:
         return *this;
     }
 
+    /**
+     * Compute the union like operator|=, but without computing the
+     * cardinalities of the containers, so that many bitmaps can be unioned
+     * without counting the bits after every one of them. repairAfterLazy()
+     * must be called before the bitmap is used for anything but lazyor.
+     */
+    Roaring64Map& lazyor(const Roaring64Map& r) {
+        for (const auto& map_entry : r.roarings) {
+            auto it = roarings.find(map_entry.first);
+            if (it == roarings.end()) {
+                roarings[map_entry.first] = map_entry.second;
+                roarings[map_entry.first].setCopyOnWrite(copyOnWrite);
+            } else {
+                // convert the containers to bitsets like roaring_bitmap_or_many does,
+                // since more unions are expected to follow
+                roaring_bitmap_lazy_or_inplace(&it->second.roaring, &map_entry.second.roaring,
+                                               true);
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * Compute the cardinalities of the containers left by lazyor.
+     */
+    void repairAfterLazy() {
+        for (auto& map_entry : roarings) {
+            roaring_bitmap_repair_after_lazy(&map_entry.second.roaring);
+        }
+    }
+
     /**
      * Compute the symmetric union between the current bitmap and the provided
      * bitmap,
@@ -904,10 +935,10 @@ public:
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
         Roaring64Map ans;
-        // not particularly fast
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            ans.lazyor(*(inputs[lcv]));
         }
+        ans.repairAfterLazy();
         return ans;
     }
 
@@ -1169,6 +1200,7 @@ public:
     }
 
     void add(uint64_t value) {
+        _is_optimized = false;
         switch (_type) {
         case EMPTY:
             _sv = value;
@@ -1189,6 +1221,7 @@ public:
     }
 
     void remove(uint64_t value) {
+        _prepare_for_change();
         switch (_type) {
         case EMPTY:
             break;
@@ -1206,6 +1239,7 @@ public:
 
     // Compute the union between the current bitmap and the provided bitmap.
     BitmapValue& operator-=(const BitmapValue& rhs) {
+        _prepare_for_change();
         switch (rhs._type) {
         case EMPTY:
             break;
@@ -1237,6 +1271,7 @@ public:
     // EMPTY  -> BITMAP
     // SINGLE -> BITMAP
     BitmapValue& operator|=(const BitmapValue& rhs) {
+        _prepare_for_change();
         switch (rhs._type) {
         case EMPTY:
             break;
@@ -1262,12 +1297,52 @@ public:
         return *this;
     }
 
+    // Compute the union like operator|=, but leave the cardinalities of the containers to be
+    // computed by repair_after_lazy(), which must be called before the bitmap is read. Unioning
+    // the bitmaps of many rows into one this way doesn't count the bits after every row.
+    BitmapValue& lazy_or(const BitmapValue& rhs) {
+        _is_optimized = false;
+        switch (rhs._type) {
+        case EMPTY:
+            break;
+        case SINGLE:
+            add(rhs._sv);
+            break;
+        case BITMAP:
+            switch (_type) {
+            case EMPTY:
+                _bitmap = rhs._bitmap;
+                _type = BITMAP;
+                break;
+            case SINGLE:
+                _bitmap = rhs._bitmap;
+                _bitmap.add(_sv);
+                _type = BITMAP;
+                break;
+            case BITMAP:
+                _bitmap.lazyor(rhs._bitmap);
+                _is_lazy = true;
+            }
+            break;
+        }
+        return *this;
+    }
+
+    // Finish the unions done by lazy_or.
+    void repair_after_lazy() {
+        if (_is_lazy) {
+            _bitmap.repairAfterLazy();
+            _is_lazy = false;
+        }
+    }
+
     // Compute the intersection between the current bitmap and the provided bitmap.
     // Possible type transitions are:
     // SINGLE -> EMPTY
     // BITMAP -> EMPTY
     // BITMAP -> SINGLE
     BitmapValue& operator&=(const BitmapValue& rhs) {
+        _prepare_for_change();
         switch (rhs._type) {
         case EMPTY:
             _type = EMPTY;
@@ -1318,6 +1393,7 @@ public:
     // BITMAP -> EMPTY
     // BITMAP -> SINGLE
     BitmapValue& operator^=(const BitmapValue& rhs) {
+        _prepare_for_change();
         switch (rhs._type) {
         case EMPTY:
             break;
@@ -1382,6 +1458,7 @@ public:
     }
 
     uint64_t cardinality() const {
+        DCHECK(!_is_lazy);
         switch (_type) {
         case EMPTY:
             return 0;
@@ -1513,8 +1590,14 @@ public:
             }
             break;
         case BITMAP:
-            _bitmap.runOptimize();
-            _bitmap.shrinkToFit();
+            DCHECK(!_is_lazy);
+            // the bitmaps sent through the exchange are sized several times before they are
+            // written, so they are only optimized again after they change
+            if (!_is_optimized) {
+                _bitmap.runOptimize();
+                _bitmap.shrinkToFit();
+                _is_optimized = true;
+            }
             res = _bitmap.getSizeInBytes();
             break;
         }
@@ -1546,6 +1629,8 @@ public:
     // Deserialize a bitmap value from `src`.
     // Return false if `src` begins with unknown type code, true otherwise.
     bool deserialize(const char* src) {
+        _is_lazy = false;
+        _is_optimized = false;
         switch (*src) {
         case BitmapTypeCode::EMPTY:
             _type = EMPTY;
@@ -1701,6 +1786,8 @@ public:
         _type = EMPTY;
         _bitmap.clear();
         _sv = 0;
+        _is_lazy = false;
+        _is_optimized = false;
     }
 
     // Implement an iterator for convenience
@@ -1711,6 +1798,11 @@ public:
     b_iterator end() const;
 
 private:
+    void _prepare_for_change() {
+        repair_after_lazy();
+        _is_optimized = false;
+    }
+
     void _convert_to_smaller_type() {
         if (_type == BITMAP) {
             uint64_t c = _bitmap.cardinality();
@@ -1733,6 +1825,10 @@ private:
     uint64_t _sv = 0;             // store the single value when _type == SINGLE
     detail::Roaring64Map _bitmap; // used when _type == BITMAP
     BitmapDataType _type;
+    // whether _bitmap has unions of lazy_or that are not repaired
+    bool _is_lazy = false;
+    // whether _bitmap is run optimized and shrunk since it was last changed
+    bool _is_optimized = false;
 };
 
 // A simple implement of bitmap value iterator(Read only)
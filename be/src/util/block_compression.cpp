@@ -25,6 +25,7 @@
 #include <zstd.h>
 #include <zstd_errors.h>
 
+#include <boost/algorithm/string.hpp>
 #include <limits>
 
 #include "gutil/strings/substitute.h"
@@ -550,4 +551,24 @@ Status get_block_compression_codec(segment_v2::CompressionTypePB type,
     return st;
 }
 
+Status get_block_compression_type(const std::string& name, segment_v2::CompressionTypePB* type) {
+    std::string lower_name = boost::algorithm::to_lower_copy(name);
+    if (lower_name == "none") {
+        *type = segment_v2::CompressionTypePB::NO_COMPRESSION;
+    } else if (lower_name == "snappy") {
+        *type = segment_v2::CompressionTypePB::SNAPPY;
+    } else if (lower_name == "lz4") {
+        *type = segment_v2::CompressionTypePB::LZ4;
+    } else if (lower_name == "lz4f") {
+        *type = segment_v2::CompressionTypePB::LZ4F;
+    } else if (lower_name == "zlib") {
+        *type = segment_v2::CompressionTypePB::ZLIB;
+    } else if (lower_name == "zstd") {
+        *type = segment_v2::CompressionTypePB::ZSTD;
+    } else {
+        return Status::InvalidArgument("unknown compression codec: {}", name);
+    }
+    return Status::OK();
+}
+
 } // namespace doris
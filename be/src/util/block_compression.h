@@ -70,4 +70,8 @@ public:
 Status get_block_compression_codec(segment_v2::CompressionTypePB type,
                                    std::unique_ptr<BlockCompressionCodec>& codec);
 
+// Get the compression type named 'name', such as "lz4" or "zstd", ignoring case.
+// "none" means NO_COMPRESSION.
+Status get_block_compression_type(const std::string& name, segment_v2::CompressionTypePB* type);
+
 } // namespace doris
@@ -19,8 +19,12 @@
 
 #include <parallel_hashmap/phmap.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include "common/config.h"
 #include "gen_cpp/Types_types.h" // TNetworkAddress
@@ -29,10 +33,13 @@
 #include "service/brpc.h"
 #include "util/doris_metrics.h"
 
+// host:port -> the stubs of the peer, each one with its own channel
 template <typename T>
 using StubMap = phmap::parallel_flat_hash_map<
-        std::string, std::shared_ptr<T>, std::hash<std::string>, std::equal_to<std::string>,
-        std::allocator<std::pair<const std::string, std::shared_ptr<T>>>, 8, std::mutex>;
+        std::string, std::vector<std::shared_ptr<T>>, std::hash<std::string>,
+        std::equal_to<std::string>,
+        std::allocator<std::pair<const std::string, std::vector<std::shared_ptr<T>>>>, 8,
+        std::mutex>;
 
 namespace doris {
 
@@ -63,44 +70,43 @@ public:
         return get_client(host_port);
     }
 
+    // The internal service has brpc_channels_per_peer stubs per peer, each one with its own
+    // connection, which are returned in turn.
     std::shared_ptr<T> get_client(const std::string& host_port) {
         std::shared_ptr<T> stub_ptr;
-        auto get_value = [&stub_ptr](typename StubMap<T>::mapped_type& v) { stub_ptr = v; };
+        auto get_value = [&stub_ptr, this](typename StubMap<T>::mapped_type& v) {
+            stub_ptr = v.size() == 1 ? v[0] : v[_next_index++ % v.size()];
+        };
         if (LIKELY(_stub_map.if_contains(host_port, get_value))) {
             return stub_ptr;
         }
 
-        // new one stub and insert into map
-        auto stub = get_new_client_no_cache(host_port);
-        _stub_map.try_emplace_l(
-                host_port, [&stub](typename StubMap<T>::mapped_type& v) { stub = v; }, stub);
-        return stub;
+        // new stubs and insert into map
+        std::vector<std::shared_ptr<T>> stubs;
+        int num_channels = 1;
+        if constexpr (std::is_same_v<T, PBackendService_Stub>) {
+            num_channels = std::max(1, config::brpc_channels_per_peer);
+        }
+        for (int i = 0; i < num_channels; ++i) {
+            // the channels of a peer share its connections unless they are in different groups
+            auto stub = _new_client(host_port, "baidu_std", "",
+                                    num_channels > 1 ? std::to_string(i) : "");
+            if (stub == nullptr) {
+                stubs.clear();
+                stubs.push_back(nullptr);
+                break;
+            }
+            stubs.push_back(std::move(stub));
+        }
+        stub_ptr = stubs[0];
+        _stub_map.try_emplace_l(host_port, get_value, std::move(stubs));
+        return stub_ptr;
     }
 
     std::shared_ptr<T> get_new_client_no_cache(const std::string& host_port,
                                                const std::string& protocol = "baidu_std",
                                                const std::string& connect_type = "") {
-        brpc::ChannelOptions options;
-        if constexpr (std::is_same_v<T, PFunctionService_Stub>) {
-            options.protocol = config::function_service_protocol;
-        } else {
-            options.protocol = protocol;
-        }
-        if (connect_type != "") {
-            options.connection_type = connect_type;
-        }
-        std::unique_ptr<brpc::Channel> channel(new brpc::Channel());
-        int ret_code = 0;
-        if (host_port.find("://") == std::string::npos) {
-            ret_code = channel->Init(host_port.c_str(), &options);
-        } else {
-            ret_code =
-                    channel->Init(host_port.c_str(), config::rpc_load_balancer.c_str(), &options);
-        }
-        if (ret_code) {
-            return nullptr;
-        }
-        return std::make_shared<T>(channel.release(), google::protobuf::Service::STUB_OWNS_CHANNEL);
+        return _new_client(host_port, protocol, connect_type, "");
     }
 
     size_t size() { return _stub_map.size(); }
@@ -163,7 +169,41 @@ public:
     }
 
 private:
+    std::shared_ptr<T> _new_client(const std::string& host_port, const std::string& protocol,
+                                   const std::string& connect_type,
+                                   const std::string& connection_group) {
+        brpc::ChannelOptions options;
+        if constexpr (std::is_same_v<T, PFunctionService_Stub>) {
+            options.protocol = config::function_service_protocol;
+        } else {
+            options.protocol = protocol;
+            // trips the connections of the peers with too many errors or latency peaks, so the
+            // calls to them fail fast until they recover
+            options.enable_circuit_breaker = config::enable_brpc_circuit_breaker;
+            if (connect_type == "" && config::brpc_connection_type != "") {
+                options.connection_type = config::brpc_connection_type;
+            }
+        }
+        if (connect_type != "") {
+            options.connection_type = connect_type;
+        }
+        options.connection_group = connection_group;
+        std::unique_ptr<brpc::Channel> channel(new brpc::Channel());
+        int ret_code = 0;
+        if (host_port.find("://") == std::string::npos) {
+            ret_code = channel->Init(host_port.c_str(), &options);
+        } else {
+            ret_code =
+                    channel->Init(host_port.c_str(), config::rpc_load_balancer.c_str(), &options);
+        }
+        if (ret_code) {
+            return nullptr;
+        }
+        return std::make_shared<T>(channel.release(), google::protobuf::Service::STUB_OWNS_CHANNEL);
+    }
+
     StubMap<T> _stub_map;
+    std::atomic<size_t> _next_index {0};
 };
 
 using InternalServiceClientCache = BrpcClientCache<PBackendService_Stub>;
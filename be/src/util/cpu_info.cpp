@@ -37,6 +37,7 @@
 #include <spe.h>
 #endif
 
+#include <pthread.h>
 #include <sched.h>
 #include <stdlib.h>
 #include <string.h>
@@ -103,6 +104,8 @@ static struct {
 } flag_mappings[] = {
         {"ssse3", CpuInfo::SSSE3},   {"sse4_1", CpuInfo::SSE4_1}, {"sse4_2", CpuInfo::SSE4_2},
         {"popcnt", CpuInfo::POPCNT}, {"avx", CpuInfo::AVX},       {"avx2", CpuInfo::AVX2},
+        {"avx512f", CpuInfo::AVX512F}, {"avx512bw", CpuInfo::AVX512BW},
+        {"avx512_vbmi2", CpuInfo::AVX512VBMI2},
 };
 static const long num_flags = sizeof(flag_mappings) / sizeof(flag_mappings[0]);
 
@@ -257,6 +260,19 @@ void CpuInfo::_init_numa_node_to_cores() {
     }
 }
 
+void CpuInfo::bind_current_thread_to_numa_node(int node) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int core : get_cores_of_numa_node(node)) {
+        CPU_SET(core, &cpus);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (ret != 0) {
+        LOG(WARNING) << "Could not bind the thread to NUMA node " << node << ": "
+                     << strerror(ret);
+    }
+}
+
 void CpuInfo::verify_cpu_requirements() {
     if (!CpuInfo::is_supported(CpuInfo::SSSE3)) {
         LOG(ERROR) << "CPU does not support the Supplemental SSE3 (SSSE3) instruction set. "
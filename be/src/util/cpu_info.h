@@ -40,6 +40,9 @@ public:
     static const int64_t POPCNT = (1 << 4);
     static const int64_t AVX = (1 << 5);
     static const int64_t AVX2 = (1 << 6);
+    static const int64_t AVX512F = (1 << 7);
+    static const int64_t AVX512BW = (1 << 8);
+    static const int64_t AVX512VBMI2 = (1 << 9);
 
     /// Cache enums for L1 (data), L2 and L3
     enum CacheLevel {
@@ -139,6 +142,10 @@ public:
         return numa_node_core_idx_[core];
     }
 
+    /// Restricts the current thread to the cores of NUMA node 'node', so that the memory it
+    /// first touches stays local to it. 'node' must be in the range [0, GetMaxNumNumaNodes()).
+    static void bind_current_thread_to_numa_node(int node);
+
     /// Returns the model name of the cpu (e.g. Intel i7-2600)
     static std::string model_name() {
         DCHECK(initialized_);
@@ -0,0 +1,236 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/cpu_sampler.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "util/hash_util.hpp"
+#include "util/time.h"
+#include "util/uid_util.h"
+
+namespace doris {
+
+namespace {
+
+// The signal of the sampling timer. Not SIGPROF, which the gperftools CPU profiler of the pprof
+// actions uses.
+int sampling_signal() {
+    return SIGRTMIN + 4;
+}
+
+// The task of a thread. Only written by the thread itself, and read by the signal handler that
+// interrupts it, so 'valid' is enough to not read a half written task.
+struct ThreadTask {
+    volatile sig_atomic_t valid;
+    int task_type;
+    int64_t query_hi;
+    int64_t query_lo;
+    int64_t instance_hi;
+    int64_t instance_lo;
+};
+
+thread_local ThreadTask t_task;
+
+std::atomic<CpuSampler*> s_sampler {nullptr};
+
+} // namespace
+
+size_t CpuSampler::EntryKeyHash::operator()(const EntryKey& key) const {
+    size_t seed = hash_value(key.query_id);
+    HashUtil::hash_combine(seed, hash_value(key.fragment_instance_id));
+    HashUtil::hash_combine(seed, key.task_type);
+    return seed;
+}
+
+CpuSampler::CpuSampler() : _ring(new Sample[RING_SIZE]) {}
+
+CpuSampler::~CpuSampler() {
+    stop();
+}
+
+CpuSampler* CpuSampler::instance() {
+    static CpuSampler sampler;
+    return &sampler;
+}
+
+Status CpuSampler::start(int frequency) {
+    if (_started) {
+        return Status::OK();
+    }
+    if (frequency <= 0 || frequency > 1000) {
+        return Status::InvalidArgument("invalid cpu sampling frequency: {}", frequency);
+    }
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = _signal_handler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(sampling_signal(), &sa, nullptr) != 0) {
+        return Status::InternalError("failed to install the cpu sampling signal: {}",
+                                     strerror(errno));
+    }
+    s_sampler = this;
+
+    struct sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = sampling_signal();
+    if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &_timer) != 0) {
+        s_sampler = nullptr;
+        return Status::InternalError("failed to create the cpu sampling timer: {}",
+                                     strerror(errno));
+    }
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = 1000L * 1000L * 1000L / frequency;
+    spec.it_value = spec.it_interval;
+    if (timer_settime(_timer, 0, &spec, nullptr) != 0) {
+        timer_delete(_timer);
+        s_sampler = nullptr;
+        return Status::InternalError("failed to start the cpu sampling timer: {}",
+                                     strerror(errno));
+    }
+    _frequency = frequency;
+    _started = true;
+    return Status::OK();
+}
+
+void CpuSampler::stop() {
+    if (!_started) {
+        return;
+    }
+    timer_delete(_timer);
+    signal(sampling_signal(), SIG_IGN);
+    s_sampler = nullptr;
+    _started = false;
+}
+
+void CpuSampler::attach_thread(int task_type, const TUniqueId& query_id,
+                               const TUniqueId& fragment_instance_id) {
+    t_task.valid = 0;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    t_task.task_type = task_type;
+    t_task.query_hi = query_id.hi;
+    t_task.query_lo = query_id.lo;
+    t_task.instance_hi = fragment_instance_id.hi;
+    t_task.instance_lo = fragment_instance_id.lo;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    t_task.valid = 1;
+}
+
+void CpuSampler::detach_thread() {
+    t_task.valid = 0;
+}
+
+void CpuSampler::_signal_handler(int signo) {
+    int saved_errno = errno;
+    CpuSampler* sampler = s_sampler.load(std::memory_order_relaxed);
+    if (sampler != nullptr) {
+        // the expirations of the timer while the signal was pending are samples as well
+        int overrun = timer_getoverrun(sampler->_timer);
+        sampler->sample(1 + std::max(overrun, 0));
+    }
+    errno = saved_errno;
+}
+
+void CpuSampler::sample(int64_t weight) {
+    uint64_t pos = _write_pos.fetch_add(1, std::memory_order_relaxed);
+    Sample& sample = _ring[pos & (RING_SIZE - 1)];
+    sample.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    if (t_task.valid) {
+        sample.task_type = t_task.task_type;
+        sample.query_hi = t_task.query_hi;
+        sample.query_lo = t_task.query_lo;
+        sample.instance_hi = t_task.instance_hi;
+        sample.instance_lo = t_task.instance_lo;
+    } else {
+        sample.task_type = 0;
+        sample.query_hi = 0;
+        sample.query_lo = 0;
+        sample.instance_hi = 0;
+        sample.instance_lo = 0;
+    }
+    sample.weight = weight;
+    sample.seq.store(pos + 1, std::memory_order_release);
+}
+
+void CpuSampler::aggregate(int retention_s) {
+    std::lock_guard<std::mutex> l(_lock);
+    int64_t now = UnixSeconds();
+    uint64_t end = _write_pos.load(std::memory_order_acquire);
+    if (end - _read_pos > RING_SIZE) {
+        _dropped_samples += end - _read_pos - RING_SIZE;
+        _read_pos = end - RING_SIZE;
+    }
+    for (; _read_pos < end; ++_read_pos) {
+        Sample& sample = _ring[_read_pos & (RING_SIZE - 1)];
+        uint64_t seq = sample.seq.load(std::memory_order_acquire);
+        if (seq < _read_pos + 1) {
+            // still being written, read it the next time
+            break;
+        }
+        EntryKey key;
+        key.task_type = sample.task_type;
+        key.query_id.__set_hi(sample.query_hi);
+        key.query_id.__set_lo(sample.query_lo);
+        key.fragment_instance_id.__set_hi(sample.instance_hi);
+        key.fragment_instance_id.__set_lo(sample.instance_lo);
+        int64_t weight = sample.weight;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq != _read_pos + 1 || sample.seq.load(std::memory_order_relaxed) != seq) {
+            // overwritten by a later sample
+            ++_dropped_samples;
+            continue;
+        }
+        Entry& entry = _entries[key];
+        if (entry.samples == 0) {
+            entry.task_type = key.task_type;
+            entry.query_id = key.query_id;
+            entry.fragment_instance_id = key.fragment_instance_id;
+        }
+        entry.samples += weight;
+        entry.last_sample_time_s = now;
+    }
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (now - it->second.last_sample_time_s > retention_s) {
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::vector<CpuSampler::Entry> CpuSampler::entries() {
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        entries.reserve(_entries.size());
+        for (auto& [key, entry] : _entries) {
+            entries.push_back(entry);
+        }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& lhs, const Entry& rhs) { return lhs.samples > rhs.samples; });
+    return entries;
+}
+
+} // namespace doris
@@ -0,0 +1,122 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <signal.h>
+#include <time.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+
+namespace doris {
+
+// Samples the threads of the process on the CPU at a low frequency, and counts the samples of
+// each query and fragment instance that the sampled threads were working for, so that the CPU
+// time of the queries can be told apart without reproducing them under a profiler.
+//
+// A timer of the process CPU time sends a signal to the thread on the CPU every 1/frequency
+// seconds of CPU time. The handler reads the task of the thread, set by AttachTask, and writes
+// it to a ring buffer. aggregate(), called every second, counts the buffered samples.
+class CpuSampler {
+public:
+    struct Entry {
+        // the task type of ThreadContext, or 0 for the threads not attached to a task
+        int task_type = 0;
+        TUniqueId query_id;
+        TUniqueId fragment_instance_id;
+        int64_t samples = 0;
+        int64_t last_sample_time_s = 0;
+    };
+
+    CpuSampler();
+    ~CpuSampler();
+
+    static CpuSampler* instance();
+
+    // Starts to send the sampling signals to the threads of the process.
+    Status start(int frequency);
+    void stop();
+    int frequency() const { return _frequency; }
+
+    // The task of the calling thread, which its samples are counted for until detach_thread().
+    static void attach_thread(int task_type, const TUniqueId& query_id,
+                              const TUniqueId& fragment_instance_id);
+    static void detach_thread();
+
+    // Records 'weight' samples of the calling thread. Async signal safe.
+    void sample(int64_t weight);
+
+    // Counts the buffered samples, and drops the entries without a sample in the last
+    // 'retention_s' seconds.
+    void aggregate(int retention_s);
+
+    // The entries with at least one sample, by descending number of samples.
+    std::vector<Entry> entries();
+    int64_t dropped_samples() const { return _dropped_samples; }
+
+private:
+    static void _signal_handler(int signo);
+
+    static constexpr uint64_t RING_SIZE = 1 << 14;
+
+    struct Sample {
+        // the write position of the sample plus one, once it is written
+        std::atomic<uint64_t> seq {0};
+        int task_type;
+        int64_t query_hi;
+        int64_t query_lo;
+        int64_t instance_hi;
+        int64_t instance_lo;
+        int64_t weight;
+    };
+
+    struct EntryKey {
+        int task_type;
+        TUniqueId query_id;
+        TUniqueId fragment_instance_id;
+
+        bool operator==(const EntryKey& other) const {
+            return task_type == other.task_type && query_id == other.query_id &&
+                   fragment_instance_id == other.fragment_instance_id;
+        }
+    };
+    struct EntryKeyHash {
+        size_t operator()(const EntryKey& key) const;
+    };
+
+    std::unique_ptr<Sample[]> _ring;
+    std::atomic<uint64_t> _write_pos {0};
+    uint64_t _read_pos = 0;
+    std::atomic<int64_t> _dropped_samples {0};
+
+    std::mutex _lock;
+    std::unordered_map<EntryKey, Entry, EntryKeyHash> _entries;
+
+    int _frequency = 0;
+    bool _started = false;
+    timer_t _timer;
+};
+
+} // namespace doris
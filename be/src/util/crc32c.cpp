@@ -207,7 +207,8 @@ static inline uint64_t LE_LOAD64(const uint8_t* p) {
 
 static inline void Fast_CRC32(uint64_t* l, uint8_t const** p) {
 #if defined(__SSE4_2__) || defined(__aarch64__)
-#if (defined(__LP64__) || defined(_WIN64)) && !defined(__aarch64__)
+#if (defined(__LP64__) || defined(_WIN64)) && \
+        (!defined(__aarch64__) || defined(__ARM_FEATURE_CRC32))
     *l = _mm_crc32_u64(*l, LE_LOAD64(*p));
     *p += 8;
 #else
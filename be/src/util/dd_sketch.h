@@ -0,0 +1,268 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// DDSketch: a quantile sketch with a relative error guarantee.
+// See "DDSketch: A Fast and Fully-Mergeable Quantile Sketch with Relative-Error Guarantees"
+// by Charles Masson, Jee E. Rim and Homin K. Lee (VLDB 2019).
+//
+// A value v is counted in the bucket ceil(log(|v|) / log(gamma)), gamma = (1 + a) / (1 - a),
+// and the quantiles are the middles of the buckets, within a relative error a of the exact
+// ones. Adding a value is a logarithm and an increment, two sketches are merged by adding the
+// counts of their buckets, and the number of buckets of each sign is bounded by max_buckets
+// by collapsing the buckets of the smallest magnitudes, which are the least relevant for the
+// high percentiles.
+
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "common/logging.h"
+
+namespace doris {
+
+class DDSketch {
+public:
+    static constexpr double DEFAULT_RELATIVE_ACCURACY = 0.01;
+    static constexpr uint32_t DEFAULT_MAX_BUCKETS = 2048;
+
+    explicit DDSketch(double relative_accuracy = DEFAULT_RELATIVE_ACCURACY,
+                      uint32_t max_buckets = DEFAULT_MAX_BUCKETS)
+            : _relative_accuracy(relative_accuracy), _max_buckets(max_buckets) {
+        _init();
+    }
+
+    void add(double value, uint64_t count = 1) {
+        if (count == 0 || std::isnan(value)) {
+            return;
+        }
+        if (value > _min_indexable_value) {
+            _positive.add(_index(value), count, _max_buckets);
+        } else if (value < -_min_indexable_value) {
+            _negative.add(_index(-value), count, _max_buckets);
+        } else {
+            _zero_count += count;
+        }
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+        _count += count;
+    }
+
+    void merge(const DDSketch& other) {
+        DCHECK_EQ(_relative_accuracy, other._relative_accuracy);
+        if (other._count == 0) {
+            return;
+        }
+        _positive.merge(other._positive, _max_buckets);
+        _negative.merge(other._negative, _max_buckets);
+        _zero_count += other._zero_count;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+        _count += other._count;
+    }
+
+    uint64_t count() const { return _count; }
+
+    // The value of the rank q * (count - 1), or NaN if the sketch is empty.
+    double quantile(double q) const {
+        if (_count == 0 || q < 0 || q > 1) {
+            return std::nan("");
+        }
+        if (q == 0) {
+            return _min;
+        } else if (q == 1) {
+            return _max;
+        }
+        double rank = q * (_count - 1);
+        double value = 0;
+        if (rank < _negative.total()) {
+            // the negative values start from the greatest magnitude
+            value = -_value(_negative.index_of_rank(rank, true));
+        } else if (rank >= _negative.total() + _zero_count) {
+            value = _value(_positive.index_of_rank(rank - _negative.total() - _zero_count, false));
+        }
+        return std::clamp(value, _min, _max);
+    }
+
+    uint32_t serialized_size() const {
+        return sizeof(double) + sizeof(uint32_t) + sizeof(uint64_t) * 2 + sizeof(double) * 2 +
+               _positive.serialized_size() + _negative.serialized_size();
+    }
+
+    size_t serialize(uint8_t* writer) const {
+        uint8_t* dst = writer;
+        _write(&writer, _relative_accuracy);
+        _write(&writer, _max_buckets);
+        _write(&writer, _count);
+        _write(&writer, _zero_count);
+        _write(&writer, _min);
+        _write(&writer, _max);
+        _positive.serialize(&writer);
+        _negative.serialize(&writer);
+        return writer - dst;
+    }
+
+    void unserialize(const uint8_t* reader) {
+        _read(&reader, &_relative_accuracy);
+        _read(&reader, &_max_buckets);
+        _init();
+        _read(&reader, &_count);
+        _read(&reader, &_zero_count);
+        _read(&reader, &_min);
+        _read(&reader, &_max);
+        _positive.unserialize(&reader);
+        _negative.unserialize(&reader);
+    }
+
+private:
+    // The counts of the buckets [_offset, _offset + _counts.size()) of a sign.
+    class Store {
+    public:
+        uint64_t total() const { return _total; }
+
+        void add(int32_t index, uint64_t count, uint32_t max_buckets) {
+            _extend(index, index, max_buckets);
+            _counts[std::max(index, _offset) - _offset] += count;
+            _total += count;
+        }
+
+        void merge(const Store& other, uint32_t max_buckets) {
+            if (other._counts.empty()) {
+                return;
+            }
+            _extend(other._offset, other._offset + (int32_t)other._counts.size() - 1,
+                    max_buckets);
+            for (size_t i = 0; i < other._counts.size(); ++i) {
+                _counts[std::max(other._offset + (int32_t)i, _offset) - _offset] +=
+                        other._counts[i];
+            }
+            _total += other._total;
+        }
+
+        // The index of the bucket of the rank, counted from the greatest index if reversed.
+        int32_t index_of_rank(double rank, bool reversed) const {
+            DCHECK(!_counts.empty());
+            uint64_t seen = 0;
+            for (size_t i = 0; i < _counts.size(); ++i) {
+                size_t pos = reversed ? _counts.size() - 1 - i : i;
+                seen += _counts[pos];
+                if (seen > rank) {
+                    return _offset + pos;
+                }
+            }
+            return reversed ? _offset : _offset + _counts.size() - 1;
+        }
+
+        uint32_t serialized_size() const {
+            return sizeof(int32_t) + sizeof(uint32_t) + sizeof(uint64_t) * _counts.size();
+        }
+
+        void serialize(uint8_t** writer) const {
+            uint32_t size = _counts.size();
+            _write(writer, _offset);
+            _write(writer, size);
+            memcpy(*writer, _counts.data(), sizeof(uint64_t) * size);
+            *writer += sizeof(uint64_t) * size;
+        }
+
+        void unserialize(const uint8_t** reader) {
+            uint32_t size = 0;
+            _read(reader, &_offset);
+            _read(reader, &size);
+            _counts.resize(size);
+            memcpy(_counts.data(), *reader, sizeof(uint64_t) * size);
+            *reader += sizeof(uint64_t) * size;
+            _total = 0;
+            for (auto count : _counts) {
+                _total += count;
+            }
+        }
+
+    private:
+        // Makes the buckets cover [min_index, max_index], collapsing the lowest buckets into
+        // the lowest one kept when there would be more than max_buckets of them.
+        void _extend(int32_t min_index, int32_t max_index, uint32_t max_buckets) {
+            if (_counts.empty()) {
+                _offset = std::max(min_index, max_index - (int32_t)max_buckets + 1);
+                _counts.resize(max_index - _offset + 1);
+                return;
+            }
+            int32_t last = _offset + (int32_t)_counts.size() - 1;
+            int32_t new_last = std::max(last, max_index);
+            int32_t new_offset = std::max(std::min(_offset, min_index),
+                                          new_last - (int32_t)max_buckets + 1);
+            if (new_offset == _offset && new_last == last) {
+                return;
+            }
+            std::vector<uint64_t> counts(new_last - new_offset + 1);
+            for (size_t i = 0; i < _counts.size(); ++i) {
+                counts[std::max(_offset + (int32_t)i, new_offset) - new_offset] += _counts[i];
+            }
+            _counts.swap(counts);
+            _offset = new_offset;
+        }
+
+        int32_t _offset = 0;
+        std::vector<uint64_t> _counts;
+        uint64_t _total = 0;
+    };
+
+    void _init() {
+        _gamma = (1 + _relative_accuracy) / (1 - _relative_accuracy);
+        _log_gamma = std::log(_gamma);
+        _min_indexable_value = DBL_MIN * _gamma;
+    }
+
+    int32_t _index(double value) const {
+        return static_cast<int32_t>(std::ceil(std::log(value) / _log_gamma));
+    }
+
+    // the middle of the bucket of the index, within the relative accuracy of its values
+    double _value(int32_t index) const {
+        return 2 * std::pow(_gamma, index) / (_gamma + 1);
+    }
+
+    template <typename T>
+    static void _write(uint8_t** writer, const T& value) {
+        memcpy(*writer, &value, sizeof(T));
+        *writer += sizeof(T);
+    }
+
+    template <typename T>
+    static void _read(const uint8_t** reader, T* value) {
+        memcpy(value, *reader, sizeof(T));
+        *reader += sizeof(T);
+    }
+
+    double _relative_accuracy;
+    uint32_t _max_buckets;
+    double _gamma;
+    double _log_gamma;
+    double _min_indexable_value;
+
+    Store _positive;
+    Store _negative;
+    uint64_t _zero_count = 0;
+    uint64_t _count = 0;
+    double _min = DBL_MAX;
+    double _max = -DBL_MAX;
+};
+
+} // namespace doris
@@ -21,6 +21,8 @@
 #include <unistd.h>
 
 #include "env/env.h"
+#include "runtime/memory/mmap_region_cache.h"
+#include "runtime/memory/system_allocator.h"
 #include "util/debug_util.h"
 #include "util/file_utils.h"
 #include "util/system_metrics.h"
@@ -140,6 +142,9 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(thread_mem_tracker_exceed_call_back_count,
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(switch_bthread_count, MetricUnit::NOUNIT);
 
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(memory_pool_bytes_total, MetricUnit::BYTES);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(memory_huge_page_advised_bytes, MetricUnit::BYTES);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(memory_anon_huge_pages_bytes, MetricUnit::BYTES);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(memory_mmap_region_cache_bytes, MetricUnit::BYTES);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(process_thread_num, MetricUnit::NOUNIT);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(process_fd_num_used, MetricUnit::NOUNIT);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(process_fd_num_limit_soft, MetricUnit::NOUNIT);
@@ -153,6 +158,12 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(compaction_waitting_permits, MetricUnit::NOUN
 
 DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(tablet_version_num_distribution, MetricUnit::NOUNIT);
 
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(page_cache_lookup_latency_ns, MetricUnit::NANOSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(page_io_read_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(segment_open_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(memtable_flush_latency_us, MetricUnit::MICROSECONDS);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(transmit_block_latency_us, MetricUnit::MICROSECONDS);
+
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(push_request_write_bytes_per_second, MetricUnit::BYTES);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(query_scan_bytes_per_second, MetricUnit::BYTES);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(max_disk_io_util_percent, MetricUnit::PERCENT);
@@ -268,6 +279,9 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, memtable_flush_duration_us);
 
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, memory_pool_bytes_total);
+    INT_GAUGE_METRIC_REGISTER(_server_metric_entity, memory_huge_page_advised_bytes);
+    INT_GAUGE_METRIC_REGISTER(_server_metric_entity, memory_anon_huge_pages_bytes);
+    INT_GAUGE_METRIC_REGISTER(_server_metric_entity, memory_mmap_region_cache_bytes);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, process_thread_num);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, process_fd_num_used);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, process_fd_num_limit_soft);
@@ -281,6 +295,12 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
 
     HISTOGRAM_METRIC_REGISTER(_server_metric_entity, tablet_version_num_distribution);
 
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, page_cache_lookup_latency_ns);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, page_io_read_latency_us);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, segment_open_latency_us);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, memtable_flush_latency_us);
+    CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(_server_metric_entity, transmit_block_latency_us);
+
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, push_request_write_bytes_per_second);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, query_scan_bytes_per_second);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, max_disk_io_util_percent);
@@ -329,6 +349,8 @@ void DorisMetrics::initialize(bool init_system_metrics, const std::set<std::stri
 void DorisMetrics::_update() {
     _update_process_thread_num();
     _update_process_fd_num();
+    _update_huge_page_bytes();
+    memory_mmap_region_cache_bytes->set_value(MmapRegionCache::instance()->cached_bytes());
 }
 
 // get num of thread of doris_be process
@@ -403,4 +425,28 @@ void DorisMetrics::_update_process_fd_num() {
     fclose(fp);
 }
 
+void DorisMetrics::_update_huge_page_bytes() {
+    memory_huge_page_advised_bytes->set_value(SystemAllocator::huge_page_bytes());
+
+    // /proc/self/smaps_rollup
+    // AnonHugePages:     6144 kB
+    FILE* fp = fopen("/proc/self/smaps_rollup", "r");
+    if (fp == nullptr) {
+        return;
+    }
+    int64_t kbytes = 0;
+    size_t line_buf_size = 0;
+    char* line_ptr = nullptr;
+    while (getline(&line_ptr, &line_buf_size, fp) > 0) {
+        if (sscanf(line_ptr, "AnonHugePages: %" PRId64 " kB", &kbytes) == 1) {
+            memory_anon_huge_pages_bytes->set_value(kbytes * 1024);
+            break;
+        }
+    }
+    if (line_ptr != nullptr) {
+        free(line_ptr);
+    }
+    fclose(fp);
+}
+
 } // namespace doris
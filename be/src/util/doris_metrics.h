@@ -133,6 +133,11 @@ public:
     IntCounter* switch_bthread_count;
 
     IntGauge* memory_pool_bytes_total;
+    // the bytes of the allocations advised to be backed by transparent huge pages, and the bytes
+    // of the process actually backed by them
+    IntGauge* memory_huge_page_advised_bytes;
+    IntGauge* memory_anon_huge_pages_bytes;
+    IntGauge* memory_mmap_region_cache_bytes;
     IntGauge* process_thread_num;
     IntGauge* process_fd_num_used;
     IntGauge* process_fd_num_limit_soft;
@@ -151,6 +156,13 @@ public:
 
     HistogramMetric* tablet_version_num_distribution;
 
+    // the latencies of the hot paths
+    CoreLocalHistogramMetric* page_cache_lookup_latency_ns;
+    CoreLocalHistogramMetric* page_io_read_latency_us;
+    CoreLocalHistogramMetric* segment_open_latency_us;
+    CoreLocalHistogramMetric* memtable_flush_latency_us;
+    CoreLocalHistogramMetric* transmit_block_latency_us;
+
     // The following metrics will be calculated
     // by metric calculator
     IntGauge* push_request_write_bytes_per_second;
@@ -236,6 +248,7 @@ private:
     void _update();
     void _update_process_thread_num();
     void _update_process_fd_num();
+    void _update_huge_page_bytes();
 
 private:
     static const std::string _s_registry_name;
@@ -0,0 +1,244 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include "common/config.h"
+#include "util/priority_thread_pool.hpp"
+#include "util/stopwatch.hpp"
+
+namespace doris {
+
+// Threadpool which shares its threads between the groups of tasks, the queries, by the CPU time
+// they consumed, in the style of the Linux CFS scheduler, so that a big query cannot starve the
+// small ones.
+//
+// The tasks of a group (Task::group_id) wait in its FIFO queue. Each group has a virtual runtime,
+// the CPU time of its tasks weighted by DEFAULT_SHARES / Task::shares, and a free thread runs the
+// first task of the group with the smallest virtual runtime. A group that starts waiting again
+// begins at the smallest virtual runtime of the queue, so it gets no credit for the time it was
+// idle. A task is charged the average CPU time of its group when it starts, and the difference
+// when it ends, so that the threads freed at the same time do not all pick the same group.
+//
+// Like PriorityWorkStealingThreadPool, the tasks are sharded by Task::queue_id, each thread
+// serves its own shard and steals from the others when it has nothing to do. The groups are
+// scheduled fairly within each shard. The priority of the tasks is not used.
+class FairScanThreadPool : public PriorityThreadPool {
+public:
+    static constexpr int DEFAULT_SHARES = 1024;
+
+    // Creates a new thread pool and start num_threads threads.
+    //  -- num_threads: how many threads are part of this pool
+    //  -- num_queues: how many shards the tasks are spread over
+    //  -- queue_size: the maximum number of waiting tasks of each shard. If a shard is full,
+    //     subsequent calls to Offer will block until there is capacity available.
+    //  -- bind_to_numa_nodes: whether the threads are spread over the NUMA nodes, see
+    //     PriorityThreadPool.
+    FairScanThreadPool(uint32_t num_threads, uint32_t num_queues, uint32_t queue_size,
+                       bool bind_to_numa_nodes = false)
+            : PriorityThreadPool(0, 0, bind_to_numa_nodes), _queue_size(queue_size) {
+        DCHECK_GT(num_queues, 0);
+        // init _shards first because the work thread needs it
+        for (int i = 0; i < num_queues; ++i) {
+            _shards.emplace_back(std::make_unique<Shard>());
+        }
+        for (int i = 0; i < num_threads; ++i) {
+            _threads.create_thread(
+                    std::bind<void>(std::mem_fn(&FairScanThreadPool::work_thread), this, i));
+        }
+    }
+
+    ~FairScanThreadPool() override {
+        shutdown();
+        join();
+    }
+
+    bool offer(Task task) override {
+        Shard& shard = *_shards[task.queue_id % _shards.size()];
+        std::unique_lock<std::mutex> l(shard.lock);
+        shard.not_full_cv.wait(l, [&] { return shard.num_tasks < _queue_size || is_shutdown(); });
+        if (is_shutdown()) {
+            return false;
+        }
+        Group& group = shard.groups[task.group_id];
+        if (group.tasks.empty()) {
+            if (group.running == 0) {
+                group.vruntime = std::max(group.vruntime, shard.min_vruntime);
+            }
+            shard.runnable.emplace(group.vruntime, task.group_id);
+        }
+        group.shares = task.shares > 0 ? task.shares : DEFAULT_SHARES;
+        group.tasks.push_back(std::move(task));
+        ++shard.num_tasks;
+        ++_num_tasks;
+        shard.not_empty_cv.notify_one();
+        return true;
+    }
+
+    bool offer(WorkFunction func) override {
+        PriorityThreadPool::Task task = {0, func, 0};
+        return offer(std::move(task));
+    }
+
+    void shutdown() override {
+        PriorityThreadPool::shutdown();
+        for (auto& shard : _shards) {
+            std::lock_guard<std::mutex> l(shard->lock);
+            shard->not_empty_cv.notify_all();
+            shard->not_full_cv.notify_all();
+        }
+    }
+
+    uint32_t get_queue_size() const override { return _num_tasks; }
+
+    // Blocks until the work queues are empty, and then calls shutdown to stop the worker
+    // threads and Join to wait until they are finished.
+    void drain_and_shutdown() override {
+        {
+            std::unique_lock<std::mutex> l(_lock);
+            while (get_queue_size() != 0) {
+                _empty_cv.wait(l);
+            }
+        }
+        shutdown();
+        join();
+    }
+
+private:
+    struct Group {
+        std::deque<Task> tasks;
+        int64_t vruntime = 0;
+        // the moving average of the CPU time of the tasks, in nanoseconds
+        int64_t avg_cpu_ns = 1000000;
+        int shares = DEFAULT_SHARES;
+        int running = 0;
+    };
+
+    struct Shard {
+        std::mutex lock;
+        std::condition_variable not_empty_cv;
+        std::condition_variable not_full_cv;
+        std::unordered_map<int64_t, Group> groups;
+        // the groups with waiting tasks by their virtual runtime
+        std::set<std::pair<int64_t, int64_t>> runnable;
+        int64_t min_vruntime = 0;
+        uint32_t num_tasks = 0;
+    };
+
+    static int64_t _weighted(int64_t cpu_ns, int shares) {
+        return cpu_ns * DEFAULT_SHARES / shares;
+    }
+
+    static void _add_vruntime(Shard& shard, int64_t group_id, Group& group, int64_t delta) {
+        if (!group.tasks.empty()) {
+            shard.runnable.erase({group.vruntime, group_id});
+            shard.runnable.emplace(group.vruntime + delta, group_id);
+        }
+        group.vruntime += delta;
+    }
+
+    // Takes the next task of the shard, returns false if it has none. Requires the shard lock.
+    bool _take_locked(Shard& shard, Task* task, int64_t* group_id, int64_t* charged) {
+        if (shard.runnable.empty()) {
+            return false;
+        }
+        *group_id = shard.runnable.begin()->second;
+        shard.min_vruntime = std::max(shard.min_vruntime, shard.runnable.begin()->first);
+        Group& group = shard.groups[*group_id];
+        *task = std::move(group.tasks.front());
+        group.tasks.pop_front();
+        ++group.running;
+        if (group.tasks.empty()) {
+            shard.runnable.erase(shard.runnable.begin());
+        }
+        *charged = _weighted(group.avg_cpu_ns, group.shares);
+        _add_vruntime(shard, *group_id, group, *charged);
+        --shard.num_tasks;
+        --_num_tasks;
+        shard.not_full_cv.notify_one();
+        return true;
+    }
+
+    bool _try_take(size_t shard_id, Task* task, int64_t* group_id, int64_t* charged) {
+        std::lock_guard<std::mutex> l(_shards[shard_id]->lock);
+        return _take_locked(*_shards[shard_id], task, group_id, charged);
+    }
+
+    void _finish(size_t shard_id, int64_t group_id, int64_t cpu_ns, int64_t charged) {
+        Shard& shard = *_shards[shard_id];
+        std::lock_guard<std::mutex> l(shard.lock);
+        auto it = shard.groups.find(group_id);
+        DCHECK(it != shard.groups.end());
+        Group& group = it->second;
+        --group.running;
+        _add_vruntime(shard, group_id, group, _weighted(cpu_ns, group.shares) - charged);
+        group.avg_cpu_ns = (group.avg_cpu_ns * 7 + cpu_ns) / 8;
+        if (group.tasks.empty() && group.running == 0) {
+            shard.groups.erase(it);
+        }
+    }
+
+    // Driver method for each thread in the pool. Continues to read work from the queues
+    // until the pool is shutdown.
+    void work_thread(int thread_id) {
+        const size_t home_id = thread_id % _shards.size();
+        bind_to_numa_node(thread_id);
+        while (!is_shutdown()) {
+            Task task;
+            int64_t group_id = 0;
+            int64_t charged = 0;
+            size_t shard_id = home_id;
+            bool found = _try_take(home_id, &task, &group_id, &charged);
+            // steal work in round-robin if nothing to do
+            for (size_t i = 1; !found && i < _shards.size(); ++i) {
+                shard_id = (home_id + i) % _shards.size();
+                found = _try_take(shard_id, &task, &group_id, &charged);
+            }
+            if (!found) {
+                shard_id = home_id;
+                Shard& shard = *_shards[home_id];
+                std::unique_lock<std::mutex> l(shard.lock);
+                shard.not_empty_cv.wait_for(
+                        l, std::chrono::milliseconds(
+                                   config::doris_blocking_priority_queue_wait_timeout_ms),
+                        [&] { return !shard.runnable.empty() || is_shutdown(); });
+                found = !is_shutdown() && _take_locked(shard, &task, &group_id, &charged);
+            }
+            if (found) {
+                ThreadCpuStopWatch watch;
+                watch.start();
+                task.work_function();
+                _finish(shard_id, group_id, watch.elapsed_time(), charged);
+            }
+            if (_num_tasks == 0) {
+                _empty_cv.notify_all();
+            }
+        }
+    }
+
+    const uint32_t _queue_size;
+    std::vector<std::unique_ptr<Shard>> _shards;
+    std::atomic<uint32_t> _num_tasks {0};
+};
+
+} // namespace doris
@@ -34,6 +34,8 @@
 #endif
 #include <zlib.h>
 
+#include <cstring>
+
 #include "gen_cpp/Types_types.h"
 #include "util/cpu_info.h"
 #include "util/murmur_hash3.h"
@@ -57,9 +59,11 @@ public:
     // TODO: crc32 hashes with different seeds do not result in different hash functions.
     // The resulting hashes are correlated.
     static uint32_t crc_hash(const void* data, int32_t bytes, uint32_t hash) {
+#ifndef __aarch64__
         if (!CpuInfo::is_supported(CpuInfo::SSE4_2)) {
             return zlib_crc_hash(data, bytes, hash);
         }
+#endif
         uint32_t words = bytes / sizeof(uint32_t);
         bytes = bytes % sizeof(uint32_t);
 
@@ -222,6 +226,97 @@ public:
         return h;
     }
 
+    // The seed of the 64 bits murmur3 hash of the hash functions, the same as the 32 bits one.
+    static const uint64_t MURMUR3_64_SEED = 104729;
+
+    static uint64_t murmur_hash3_64(const void* key, int32_t len, uint64_t seed) {
+        uint64_t hash = 0;
+        murmur_hash3_x64_64(key, len, seed, &hash);
+        return hash;
+    }
+
+    static const uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+    static const uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+    static const uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+    static const uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+    static const uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+    ALWAYS_INLINE static uint64_t rotl64(uint64_t x, int8_t r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    ALWAYS_INLINE static uint64_t read64(const uint8_t* p) {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    ALWAYS_INLINE static uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+        acc += input * XXH_PRIME64_2;
+        acc = rotl64(acc, 31);
+        return acc * XXH_PRIME64_1;
+    }
+
+    ALWAYS_INLINE static uint64_t xxh64_merge_round(uint64_t acc, uint64_t val) {
+        acc ^= xxh64_round(0, val);
+        return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+
+    // XXH64 of https://github.com/Cyan4973/xxHash, which is faster than the murmur hashes for
+    // the long strings: the input is consumed by four independent lanes of 8 bytes.
+    static uint64_t xxhash64(const void* key, size_t len, uint64_t seed) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(key);
+        const uint8_t* const end = p + len;
+        uint64_t h;
+
+        if (len >= 32) {
+            const uint8_t* const limit = end - 32;
+            uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+            uint64_t v2 = seed + XXH_PRIME64_2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - XXH_PRIME64_1;
+            do {
+                v1 = xxh64_round(v1, read64(p));
+                v2 = xxh64_round(v2, read64(p + 8));
+                v3 = xxh64_round(v3, read64(p + 16));
+                v4 = xxh64_round(v4, read64(p + 24));
+                p += 32;
+            } while (p <= limit);
+
+            h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+            h = xxh64_merge_round(h, v1);
+            h = xxh64_merge_round(h, v2);
+            h = xxh64_merge_round(h, v3);
+            h = xxh64_merge_round(h, v4);
+        } else {
+            h = seed + XXH_PRIME64_5;
+        }
+        h += static_cast<uint64_t>(len);
+
+        for (; p + 8 <= end; p += 8) {
+            h ^= xxh64_round(0, read64(p));
+            h = rotl64(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        }
+        if (p + 4 <= end) {
+            uint32_t word;
+            memcpy(&word, p, sizeof(word));
+            h ^= static_cast<uint64_t>(word) * XXH_PRIME64_1;
+            h = rotl64(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+            p += 4;
+        }
+        for (; p < end; ++p) {
+            h ^= (*p) * XXH_PRIME64_5;
+            h = rotl64(h, 11) * XXH_PRIME64_1;
+        }
+
+        h ^= h >> 33;
+        h *= XXH_PRIME64_2;
+        h ^= h >> 29;
+        h *= XXH_PRIME64_3;
+        h ^= h >> 32;
+        return h;
+    }
+
     // default values recommended by http://isthe.com/chongo/tech/comp/fnv/
     static const uint32_t FNV_PRIME = 0x01000193; //   16777619
     static const uint32_t FNV_SEED = 0x811C9DC5;  // 2166136261
@@ -327,6 +422,8 @@ public:
             return fnv_hash(data, bytes, seed);
         }
 
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+        return crc_hash(data, bytes, seed);
 #else
         return fnv_hash(data, bytes, seed);
 #endif
@@ -19,6 +19,7 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
 #include <limits>
@@ -29,7 +30,6 @@ HistogramBucketMapper::HistogramBucketMapper() {
     // If you change this, you also need to change
     // size of array buckets_ in HistogramStat
     _bucket_values = {1, 2};
-    _value_index_map = {{1, 0}, {2, 1}};
     double bucket_val = static_cast<double>(_bucket_values.back());
     while ((bucket_val = 1.5 * bucket_val) <=
            static_cast<double>(std::numeric_limits<uint64_t>::max())) {
@@ -42,7 +42,6 @@ HistogramBucketMapper::HistogramBucketMapper() {
             pow_of_ten *= 10;
         }
         _bucket_values.back() *= pow_of_ten;
-        _value_index_map[_bucket_values.back()] = _bucket_values.size() - 1;
     }
     _max_bucket_value = _bucket_values.back();
     _min_bucket_value = _bucket_values.front();
@@ -52,13 +51,9 @@ size_t HistogramBucketMapper::index_for_value(const uint64_t& value) const {
     if (value >= _max_bucket_value) {
         return _bucket_values.size() - 1;
     } else if (value >= _min_bucket_value) {
-        std::map<uint64_t, uint64_t>::const_iterator lowerBound =
-                _value_index_map.lower_bound(value);
-        if (lowerBound != _value_index_map.end()) {
-            return static_cast<size_t>(lowerBound->second);
-        } else {
-            return 0;
-        }
+        // the bucket values are increasing, a binary search on them is cheaper than a tree
+        return std::lower_bound(_bucket_values.begin(), _bucket_values.end(), value) -
+               _bucket_values.begin();
     } else {
         return 0;
     }
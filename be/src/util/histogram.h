@@ -60,7 +60,6 @@ private:
     std::vector<uint64_t> _bucket_values;
     uint64_t _max_bucket_value;
     uint64_t _min_bucket_value;
-    std::map<uint64_t, uint64_t> _value_index_map;
 };
 
 struct HistogramStat {
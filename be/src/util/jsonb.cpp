@@ -0,0 +1,337 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/jsonb.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "util/coding.h"
+
+namespace doris {
+
+namespace {
+
+// the header of an array or object: the type, the count and the body size
+constexpr size_t CONTAINER_HEADER_SIZE = 1 + 2 * sizeof(uint32_t);
+// deeper values are written as null by to_json(), to bound the recursion on corrupted data
+constexpr int MAX_WRITE_DEPTH = 1024;
+
+uint32_t read_u32(const char* data) {
+    return decode_fixed32_le(reinterpret_cast<const uint8_t*>(data));
+}
+
+void write_u32(std::string* jsonb, size_t pos, uint32_t value) {
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(jsonb->data() + pos), value);
+}
+
+void encode(const rapidjson::Value& value, std::string* jsonb);
+
+// Appends the header of an array or object with the offsets to fill, and returns its position.
+size_t begin_container(JsonbValue::Type type, uint32_t count, std::string* jsonb) {
+    size_t pos = jsonb->size();
+    jsonb->push_back(type);
+    put_fixed32_le(jsonb, count);
+    put_fixed32_le(jsonb, 0);
+    jsonb->append(count * sizeof(uint32_t), '\0');
+    return pos;
+}
+
+void end_container(size_t pos, uint32_t count, std::string* jsonb) {
+    size_t body = pos + CONTAINER_HEADER_SIZE + count * sizeof(uint32_t);
+    write_u32(jsonb, pos + 1 + sizeof(uint32_t), jsonb->size() - body);
+}
+
+void set_offset(size_t pos, uint32_t count, uint32_t index, std::string* jsonb) {
+    size_t body = pos + CONTAINER_HEADER_SIZE + count * sizeof(uint32_t);
+    write_u32(jsonb, pos + CONTAINER_HEADER_SIZE + index * sizeof(uint32_t), jsonb->size() - body);
+}
+
+void encode_array(const rapidjson::Value& value, std::string* jsonb) {
+    uint32_t count = value.Size();
+    size_t pos = begin_container(JsonbValue::T_ARRAY, count, jsonb);
+    for (uint32_t i = 0; i < count; ++i) {
+        set_offset(pos, count, i, jsonb);
+        encode(value[i], jsonb);
+    }
+    end_container(pos, count, jsonb);
+}
+
+void encode_object(const rapidjson::Value& value, std::string* jsonb) {
+    uint32_t count = value.MemberCount();
+    std::vector<std::string_view> keys;
+    keys.reserve(count);
+    for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+        keys.emplace_back(it->name.GetString(), it->name.GetStringLength());
+    }
+    // stable, so the first of the members of the same key is found by a binary search
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&keys](uint32_t l, uint32_t r) { return keys[l] < keys[r]; });
+
+    size_t pos = begin_container(JsonbValue::T_OBJECT, count, jsonb);
+    for (uint32_t i = 0; i < count; ++i) {
+        set_offset(pos, count, i, jsonb);
+        const std::string_view& key = keys[order[i]];
+        put_fixed32_le(jsonb, key.size());
+        jsonb->append(key.data(), key.size());
+        encode((value.MemberBegin() + order[i])->value, jsonb);
+    }
+    end_container(pos, count, jsonb);
+}
+
+void encode(const rapidjson::Value& value, std::string* jsonb) {
+    if (value.IsNull()) {
+        jsonb->push_back(JsonbValue::T_NULL);
+    } else if (value.IsBool()) {
+        jsonb->push_back(value.GetBool() ? JsonbValue::T_TRUE : JsonbValue::T_FALSE);
+    } else if (value.IsInt64()) {
+        jsonb->push_back(JsonbValue::T_INT64);
+        put_fixed64_le(jsonb, value.GetInt64());
+    } else if (value.IsNumber()) {
+        // the doubles, and the integers beyond int64 like json parsers without big integers
+        jsonb->push_back(JsonbValue::T_DOUBLE);
+        double number = value.GetDouble();
+        uint64_t bits;
+        memcpy(&bits, &number, sizeof(bits));
+        put_fixed64_le(jsonb, bits);
+    } else if (value.IsString()) {
+        jsonb->push_back(JsonbValue::T_STRING);
+        put_fixed32_le(jsonb, value.GetStringLength());
+        jsonb->append(value.GetString(), value.GetStringLength());
+    } else if (value.IsArray()) {
+        encode_array(value, jsonb);
+    } else {
+        encode_object(value, jsonb);
+    }
+}
+
+} // namespace
+
+bool JsonbValue::from_json(const char* json, size_t size, std::string* jsonb) {
+    rapidjson::Document document;
+    document.Parse(json, size);
+    if (document.HasParseError()) {
+        return false;
+    }
+    jsonb->clear();
+    jsonb->push_back(VERSION);
+    encode(document, jsonb);
+    return true;
+}
+
+JsonbValue JsonbValue::root(const char* data, size_t size) {
+    if (size < 2 || static_cast<uint8_t>(data[0]) != VERSION) {
+        return JsonbValue();
+    }
+    return JsonbValue(data + 1, data + size);
+}
+
+JsonbValue::JsonbValue(const char* data, const char* end) {
+    if (data >= end) {
+        return;
+    }
+    size_t available = end - data;
+    auto type = static_cast<Type>(data[0]);
+    switch (type) {
+    case T_NULL:
+    case T_FALSE:
+    case T_TRUE:
+        end = data + 1;
+        break;
+    case T_INT64:
+    case T_DOUBLE:
+        if (available < 1 + sizeof(uint64_t)) {
+            return;
+        }
+        end = data + 1 + sizeof(uint64_t);
+        break;
+    case T_STRING: {
+        if (available < 1 + sizeof(uint32_t) ||
+            available - 1 - sizeof(uint32_t) < read_u32(data + 1)) {
+            return;
+        }
+        end = data + 1 + sizeof(uint32_t) + read_u32(data + 1);
+        break;
+    }
+    case T_ARRAY:
+    case T_OBJECT: {
+        if (available < CONTAINER_HEADER_SIZE) {
+            return;
+        }
+        uint64_t size = CONTAINER_HEADER_SIZE + uint64_t(read_u32(data + 1)) * sizeof(uint32_t) +
+                        read_u32(data + 1 + sizeof(uint32_t));
+        if (available < size) {
+            return;
+        }
+        end = data + size;
+        break;
+    }
+    default:
+        return;
+    }
+    _type = type;
+    _data = data;
+    _end = end;
+}
+
+uint32_t JsonbValue::size() const {
+    return _type == T_ARRAY || _type == T_OBJECT ? read_u32(_data + 1) : 0;
+}
+
+JsonbValue JsonbValue::at(uint32_t index) const {
+    if (_type != T_ARRAY || index >= size()) {
+        return JsonbValue();
+    }
+    uint32_t offset = read_u32(_offsets() + index * sizeof(uint32_t));
+    if (offset >= _end - _body()) {
+        return JsonbValue();
+    }
+    return JsonbValue(_body() + offset, _end);
+}
+
+JsonbValue JsonbValue::member(uint32_t index, std::string_view* key) const {
+    if (_type != T_OBJECT || index >= size()) {
+        return JsonbValue();
+    }
+    uint32_t offset = read_u32(_offsets() + index * sizeof(uint32_t));
+    size_t available = _end - _body();
+    if (offset >= available || available - offset < sizeof(uint32_t)) {
+        return JsonbValue();
+    }
+    const char* member = _body() + offset;
+    uint32_t key_size = read_u32(member);
+    if (available - offset - sizeof(uint32_t) < key_size) {
+        return JsonbValue();
+    }
+    *key = std::string_view(member + sizeof(uint32_t), key_size);
+    return JsonbValue(member + sizeof(uint32_t) + key_size, _end);
+}
+
+JsonbValue JsonbValue::find(std::string_view key) const {
+    if (_type != T_OBJECT) {
+        return JsonbValue();
+    }
+    // the first member whose key is not less than the key
+    uint32_t low = 0;
+    uint32_t high = size();
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        std::string_view mid_key;
+        member(mid, &mid_key);
+        if (mid_key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == size()) {
+        return JsonbValue();
+    }
+    std::string_view found_key;
+    JsonbValue value = member(low, &found_key);
+    return found_key == key ? value : JsonbValue();
+}
+
+int64_t JsonbValue::get_int64() const {
+    return _type == T_INT64 ? decode_fixed64_le(reinterpret_cast<const uint8_t*>(_data + 1)) : 0;
+}
+
+double JsonbValue::get_double() const {
+    if (_type == T_INT64) {
+        return get_int64();
+    } else if (_type != T_DOUBLE) {
+        return 0;
+    }
+    uint64_t bits = decode_fixed64_le(reinterpret_cast<const uint8_t*>(_data + 1));
+    double number;
+    memcpy(&number, &bits, sizeof(number));
+    return number;
+}
+
+std::string_view JsonbValue::get_string() const {
+    if (_type != T_STRING) {
+        return {};
+    }
+    return std::string_view(_data + 1 + sizeof(uint32_t), read_u32(_data + 1));
+}
+
+namespace {
+
+void write_json(const JsonbValue& value, int depth,
+                rapidjson::Writer<rapidjson::StringBuffer>* writer) {
+    if (depth > MAX_WRITE_DEPTH) {
+        writer->Null();
+        return;
+    }
+    switch (value.type()) {
+    case JsonbValue::T_FALSE:
+        writer->Bool(false);
+        break;
+    case JsonbValue::T_TRUE:
+        writer->Bool(true);
+        break;
+    case JsonbValue::T_INT64:
+        writer->Int64(value.get_int64());
+        break;
+    case JsonbValue::T_DOUBLE:
+        writer->Double(value.get_double());
+        break;
+    case JsonbValue::T_STRING: {
+        std::string_view string = value.get_string();
+        writer->String(string.data(), string.size());
+        break;
+    }
+    case JsonbValue::T_ARRAY:
+        writer->StartArray();
+        for (uint32_t i = 0; i < value.size(); ++i) {
+            write_json(value.at(i), depth + 1, writer);
+        }
+        writer->EndArray();
+        break;
+    case JsonbValue::T_OBJECT:
+        writer->StartObject();
+        for (uint32_t i = 0; i < value.size(); ++i) {
+            std::string_view key;
+            JsonbValue member = value.member(i, &key);
+            writer->Key(key.data(), key.size());
+            write_json(member, depth + 1, writer);
+        }
+        writer->EndObject();
+        break;
+    default:
+        writer->Null();
+    }
+}
+
+} // namespace
+
+void JsonbValue::to_json(std::string* json) const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    write_json(*this, 0, &writer);
+    json->assign(buffer.GetString(), buffer.GetSize());
+}
+
+} // namespace doris
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace doris {
+
+// JSONB is a binary encoding of json documents, whose values are read in place without parsing
+// the document. The members of an object are sorted by their keys, so a member is found by a
+// binary search, and the values of an array by an offset table. It's produced from the json
+// string by jsonb_parse() when loading, and read by the jsonb_extract_* functions.
+//
+// A document is a version byte followed by the root value. A value is a type byte followed by:
+//   T_NULL, T_FALSE, T_TRUE: nothing
+//   T_INT64, T_DOUBLE:       8 bytes in little endian
+//   T_STRING:                uint32 length, bytes
+//   T_ARRAY:                 uint32 count, uint32 body size, uint32 offsets[count] of the values
+//                            in the body, the body of the values
+//   T_OBJECT:                uint32 count, uint32 body size, uint32 offsets[count] of the members
+//                            in the body, the body of the members sorted by key, each a uint32
+//                            length and bytes of the key followed by the value
+class JsonbValue {
+public:
+    enum Type : uint8_t {
+        T_INVALID = 0,
+        T_NULL,
+        T_FALSE,
+        T_TRUE,
+        T_INT64,
+        T_DOUBLE,
+        T_STRING,
+        T_ARRAY,
+        T_OBJECT
+    };
+
+    static constexpr uint8_t VERSION = 1;
+
+    // Encodes the json string. Returns false if it's not valid json.
+    static bool from_json(const char* json, size_t size, std::string* jsonb);
+
+    // Returns the root value of the document, which is T_INVALID if data is not a JSONB
+    // document. All the reads are bounded by the size, so any data can be read safely.
+    static JsonbValue root(const char* data, size_t size);
+
+    JsonbValue() = default;
+
+    Type type() const { return _type; }
+    bool is_valid() const { return _type != T_INVALID; }
+
+    // The member of an object, or T_INVALID if it's not an object or has no such key. Of the
+    // members of the same key, the first one in the json is returned.
+    JsonbValue find(std::string_view key) const;
+    // The value of an array at the index, or T_INVALID if it's not an array or too short.
+    JsonbValue at(uint32_t index) const;
+    // The member of an object at the index in the order of keys, whose key is set to key.
+    JsonbValue member(uint32_t index, std::string_view* key) const;
+    // The number of the values of an array, or the members of an object.
+    uint32_t size() const;
+
+    int64_t get_int64() const;
+    double get_double() const;
+    std::string_view get_string() const;
+
+    // Writes the value as a json string, with the members of objects in the order of keys.
+    void to_json(std::string* json) const;
+
+private:
+    JsonbValue(const char* data, const char* end);
+
+    // the offsets table and the body of an array or object
+    const char* _offsets() const { return _data + 1 + 2 * sizeof(uint32_t); }
+    const char* _body() const { return _offsets() + size() * sizeof(uint32_t); }
+
+    Type _type = T_INVALID;
+    const char* _data = nullptr;
+    // the end of the value, or of the value's container if the value is a scalar
+    const char* _end = nullptr;
+};
+
+} // namespace doris
@@ -19,6 +19,10 @@
 
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
+#include <sched.h>
+
+#include <thread>
+
 namespace doris {
 
 std::ostream& operator<<(std::ostream& os, MetricType type) {
@@ -114,7 +118,8 @@ std::string Metric::to_prometheus(const std::string& display_name, const Labels&
 }
 
 std::map<std::string, double> HistogramMetric::_s_output_percentiles = {
-        {"0.50", 50.0}, {"0.75", 75.0}, {"0.90", 90.0}, {"0.95", 95.0}, {"0.99", 99.0}};
+        {"0.50", 50.0}, {"0.75", 75.0}, {"0.90", 90.0}, {"0.95", 95.0}, {"0.99", 99.0},
+        {"0.999", 99.9}};
 void HistogramMetric::clear() {
     std::lock_guard<SpinLock> l(_lock);
     _stats.clear();
@@ -206,6 +211,65 @@ rj::Value HistogramMetric::to_json_value(rj::Document::AllocatorType& allocator)
     return json_value;
 }
 
+CoreLocalHistogramMetric::CoreLocalHistogramMetric() {
+    // the number of the cores is rounded up to a power of 2, like CoreLocalValue
+    size_t num_cpus = std::thread::hardware_concurrency();
+    _num_cores = 8;
+    while (_num_cores < num_cpus) {
+        _num_cores <<= 1;
+    }
+    _core_stats.reset(new CoreStat[_num_cores]);
+}
+
+void CoreLocalHistogramMetric::clear() {
+    std::lock_guard<SpinLock> l(_lock);
+    for (size_t i = 0; i < _num_cores; ++i) {
+        _core_stats[i].stat.clear();
+    }
+    _stats.clear();
+}
+
+void CoreLocalHistogramMetric::add(const uint64_t& value) {
+    size_t cpu_id = sched_getcpu();
+    _core_stats[cpu_id & (_num_cores - 1)].stat.add(value);
+}
+
+void CoreLocalHistogramMetric::refresh() {
+    std::lock_guard<SpinLock> l(_lock);
+    _stats.clear();
+    for (size_t i = 0; i < _num_cores; ++i) {
+        _stats.merge(_core_stats[i].stat);
+    }
+}
+
+void CoreLocalHistogramMetric::_collect(HistogramMetric* histogram) const {
+    HistogramStat stats;
+    for (size_t i = 0; i < _num_cores; ++i) {
+        stats.merge(_core_stats[i].stat);
+    }
+    histogram->set_histogram(stats);
+}
+
+std::string CoreLocalHistogramMetric::to_string() const {
+    HistogramMetric histogram;
+    _collect(&histogram);
+    return histogram.to_string();
+}
+
+std::string CoreLocalHistogramMetric::to_prometheus(const std::string& display_name,
+                                                    const Labels& entity_labels,
+                                                    const Labels& metric_labels) const {
+    HistogramMetric histogram;
+    _collect(&histogram);
+    return histogram.to_prometheus(display_name, entity_labels, metric_labels);
+}
+
+rj::Value CoreLocalHistogramMetric::to_json_value(rj::Document::AllocatorType& allocator) const {
+    HistogramMetric histogram;
+    _collect(&histogram);
+    return histogram.to_json_value(allocator);
+}
+
 std::string MetricPrototype::simple_name() const {
     return group_name.empty() ? name : group_name;
 }
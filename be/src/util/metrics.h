@@ -23,6 +23,7 @@
 #include <atomic>
 #include <functional>
 #include <iomanip>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <set>
@@ -181,9 +182,9 @@ public:
     HistogramMetric(const HistogramMetric&) = delete;
     HistogramMetric& operator=(const HistogramMetric&) = delete;
 
-    void clear();
+    virtual void clear();
     bool is_empty() const;
-    void add(const uint64_t& value);
+    virtual void add(const uint64_t& value);
     void merge(const HistogramMetric& other);
     void set_histogram(const HistogramStat& stats);
 
@@ -206,6 +207,37 @@ protected:
     HistogramStat _stats;
 };
 
+// A histogram for the hot paths, like the latencies of the page cache lookups. The values are added
+// without a lock into the stats of the core the thread runs on, so the threads don't contend on the
+// same cache lines, and the stats of the cores are merged when the metric is exported.
+// The accessors of HistogramMetric like percentile() read the stats merged by the last refresh().
+class CoreLocalHistogramMetric : public HistogramMetric {
+public:
+    CoreLocalHistogramMetric();
+    ~CoreLocalHistogramMetric() override = default;
+
+    void clear() override;
+    void add(const uint64_t& value) override;
+    // Merges the stats of the cores into the stats of the metric.
+    void refresh();
+
+    std::string to_string() const override;
+    std::string to_prometheus(const std::string& display_name, const Labels& entity_labels,
+                              const Labels& metric_labels) const override;
+    rj::Value to_json_value(rj::Document::AllocatorType& allocator) const override;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) CoreStat {
+        HistogramStat stat;
+    };
+
+    // merges the stats of the cores into a new histogram to export it
+    void _collect(HistogramMetric* histogram) const;
+
+    size_t _num_cores;
+    std::unique_ptr<CoreStat[]> _core_stats;
+};
+
 template <typename T>
 class AtomicCounter : public AtomicMetric<T> {
 public:
@@ -315,6 +347,10 @@ public:
 #define HISTOGRAM_METRIC_REGISTER(entity, metric) \
     metric = (HistogramMetric*)(entity->register_metric<HistogramMetric>(&METRIC_##metric))
 
+#define CORE_LOCAL_HISTOGRAM_METRIC_REGISTER(entity, metric)                                \
+    metric = (CoreLocalHistogramMetric*)(entity->register_metric<CoreLocalHistogramMetric>( \
+            &METRIC_##metric))
+
 #define METRIC_DEREGISTER(entity, metric) entity->deregister_metric(&METRIC_##metric)
 
 // For 'metrics' in MetricEntity.
@@ -21,6 +21,7 @@
 #include <thread>
 
 #include "util/blocking_priority_queue.hpp"
+#include "util/cpu_info.h"
 #include "util/thread_group.h"
 
 namespace doris {
@@ -39,6 +40,10 @@ public:
         int priority;
         WorkFunction work_function;
         int queue_id;
+        // the query or workload group of the task and its share of the threads, used by
+        // FairScanThreadPool
+        int64_t group_id = 0;
+        int shares = 0;
         bool operator<(const Task& o) const { return priority < o.priority; }
 
         Task& operator++() {
@@ -52,8 +57,10 @@ public:
     //  -- queue_size: the maximum size of the queue on which work items are offered. If the
     //     queue exceeds this size, subsequent calls to Offer will block until there is
     //     capacity available.
-    PriorityThreadPool(uint32_t num_threads, uint32_t queue_size)
-            : _work_queue(queue_size), _shutdown(false) {
+    //  -- bind_to_numa_nodes: whether the threads are spread over the NUMA nodes, each one
+    //     bound to the cores of its node, so that the memory it touches stays local.
+    PriorityThreadPool(uint32_t num_threads, uint32_t queue_size, bool bind_to_numa_nodes = false)
+            : _bind_to_numa_nodes(bind_to_numa_nodes), _work_queue(queue_size), _shutdown(false) {
         for (int i = 0; i < num_threads; ++i) {
             _threads.create_thread(
                     std::bind<void>(std::mem_fn(&PriorityThreadPool::work_thread), this, i));
@@ -117,6 +124,16 @@ public:
 protected:
     virtual bool is_shutdown() { return _shutdown; }
 
+    // Binds the thread 'thread_id' to the cores of its NUMA node if the pool is bound.
+    void bind_to_numa_node(int thread_id) {
+        const int num_nodes = CpuInfo::get_max_num_numa_nodes();
+        if (_bind_to_numa_nodes && num_nodes > 1) {
+            CpuInfo::bind_current_thread_to_numa_node(thread_id % num_nodes);
+        }
+    }
+
+    const bool _bind_to_numa_nodes;
+
     // Collection of worker threads that process work from the queue.
     ThreadGroup _threads;
 
@@ -130,6 +147,7 @@ private:
     // Driver method for each thread in the pool. Continues to read work from the queue
     // until the pool is shutdown.
     void work_thread(int thread_id) {
+        bind_to_numa_node(thread_id);
         while (!is_shutdown()) {
             Task task;
             if (_work_queue.blocking_get(&task)) {
@@ -35,8 +35,11 @@ public:
     //  -- queue_size: the maximum size of the queue on which work items are offered. If the
     //     queue exceeds this size, subsequent calls to Offer will block until there is
     //     capacity available.
-    PriorityWorkStealingThreadPool(uint32_t num_threads, uint32_t num_queues, uint32_t queue_size)
-            : PriorityThreadPool(0, 0) {
+    //  -- bind_to_numa_nodes: whether the threads are spread over the NUMA nodes, see
+    //     PriorityThreadPool.
+    PriorityWorkStealingThreadPool(uint32_t num_threads, uint32_t num_queues, uint32_t queue_size,
+                                   bool bind_to_numa_nodes = false)
+            : PriorityThreadPool(0, 0, bind_to_numa_nodes) {
         DCHECK_GT(num_queues, 0);
         DCHECK_GE(num_threads, num_queues);
         // init _work_queues first because the work thread needs it
@@ -111,6 +114,7 @@ private:
     void work_thread(int thread_id) {
         auto queue_id = thread_id % _work_queues.size();
         auto steal_queue_id = (queue_id + 1) % _work_queues.size();
+        bind_to_numa_node(thread_id);
         while (!is_shutdown()) {
             Task task;
             // avoid blocking get
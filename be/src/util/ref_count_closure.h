@@ -36,6 +36,8 @@ public:
     // If unref() returns true, this object should be delete
     bool unref() { return _refs.fetch_sub(1) == 1; }
 
+    int count() { return _refs.load(); }
+
     void Run() override {
         if (unref()) {
             delete this;
@@ -28,6 +28,10 @@ namespace doris {
 
 const static std::string USE_PATH_STYLE = "use_path_style";
 
+// the shared clients are dropped when there are too many of them, an S3Client keeps its pool of
+// connections until the last reader using it is closed
+const static size_t MAX_SHARED_CLIENTS = 128;
+
 ClientFactory::ClientFactory() {
     _aws_options = Aws::SDKOptions {};
     Aws::Utils::Logging::LogLevel logLevel =
@@ -61,10 +65,37 @@ bool ClientFactory::is_s3_conf_valid(const std::map<std::string, std::string>& p
 }
 
 std::shared_ptr<Aws::S3::S3Client> ClientFactory::create(
-        const std::map<std::string, std::string>& prop) {
+        const std::map<std::string, std::string>& prop,
+        std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> write_rate_limiter) {
     if (!is_s3_conf_valid(prop)) {
         return nullptr;
     }
+    if (write_rate_limiter != nullptr) {
+        return _create_client(prop, std::move(write_rate_limiter));
+    }
+    StringCaseMap<std::string> properties(prop.begin(), prop.end());
+    std::string key;
+    for (const auto& name : {S3_AK, S3_SK, S3_ENDPOINT, S3_REGION, S3_MAX_CONN_SIZE,
+                             S3_REQUEST_TIMEOUT_MS, S3_CONN_TIMEOUT_MS, USE_PATH_STYLE}) {
+        auto it = properties.find(name);
+        key.append(it == properties.end() ? "" : it->second).push_back('\0');
+    }
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _clients.find(key);
+    if (it != _clients.end()) {
+        return it->second;
+    }
+    if (_clients.size() >= MAX_SHARED_CLIENTS) {
+        _clients.clear();
+    }
+    auto client = _create_client(prop, nullptr);
+    _clients.emplace(std::move(key), client);
+    return client;
+}
+
+std::shared_ptr<Aws::S3::S3Client> ClientFactory::_create_client(
+        const std::map<std::string, std::string>& prop,
+        std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> write_rate_limiter) {
     StringCaseMap<std::string> properties(prop.begin(), prop.end());
     Aws::Auth::AWSCredentials aws_cred(properties.find(S3_AK)->second,
                                        properties.find(S3_SK)->second);
@@ -75,6 +106,8 @@ std::shared_ptr<Aws::S3::S3Client> ClientFactory::create(
     aws_config.region = properties.find(S3_REGION)->second;
     if (properties.find(S3_MAX_CONN_SIZE) != properties.end()) {
         aws_config.maxConnections = std::atoi(properties.find(S3_MAX_CONN_SIZE)->second.c_str());
+    } else {
+        aws_config.maxConnections = config::s3_client_max_connections;
     }
     if (properties.find(S3_REQUEST_TIMEOUT_MS) != properties.end()) {
         aws_config.requestTimeoutMs =
@@ -86,6 +119,7 @@ std::shared_ptr<Aws::S3::S3Client> ClientFactory::create(
     }
 
     aws_config.verifySSL = false;
+    aws_config.writeRateLimiter = std::move(write_rate_limiter);
     // See https://sdk.amazonaws.com/cpp/api/LATEST/class_aws_1_1_s3_1_1_s3_client.html
     bool use_virtual_addressing = true;
     if (properties.find(USE_PATH_STYLE) != properties.end()) {
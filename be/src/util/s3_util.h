@@ -21,12 +21,17 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace Aws {
 namespace S3 {
 class S3Client;
 } // namespace S3
+namespace Utils::RateLimits {
+class RateLimiterInterface;
+} // namespace Utils::RateLimits
 } // namespace Aws
 
 namespace doris {
@@ -45,14 +50,28 @@ public:
 
     static ClientFactory& instance();
 
-    std::shared_ptr<Aws::S3::S3Client> create(const std::map<std::string, std::string>& prop);
+    // The requests of the client are throttled by write_rate_limiter if it is not null. The clients
+    // without a rate limiter are shared by the callers with the same properties, so the readers of
+    // the files of a bucket reuse the connections in the pool of their client.
+    std::shared_ptr<Aws::S3::S3Client> create(
+            const std::map<std::string, std::string>& prop,
+            std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> write_rate_limiter =
+                    nullptr);
 
     static bool is_s3_conf_valid(const std::map<std::string, std::string>& prop);
 
 private:
     ClientFactory();
 
+    std::shared_ptr<Aws::S3::S3Client> _create_client(
+            const std::map<std::string, std::string>& prop,
+            std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> write_rate_limiter);
+
     Aws::SDKOptions _aws_options;
+
+    std::mutex _lock;
+    // the shared clients by the properties they are created with
+    std::unordered_map<std::string, std::shared_ptr<Aws::S3::S3Client>> _clients;
 };
 std::unique_ptr<Aws::S3::S3Client> create_client(const std::map<std::string, std::string>& prop);
 
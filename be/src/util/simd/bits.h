@@ -37,7 +37,18 @@ inline uint32_t bytes32_mask_to_bits32_mask(const uint8_t* data) {
     auto zero32 = _mm256_setzero_si256();
     uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
             _mm256_cmpgt_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), zero32)));
-#elif defined(__SSE2__) || defined(__aarch64__)
+#elif defined(__aarch64__)
+    // NEON has no movemask, the bytes weighted by their bit are summed pairwise instead
+    const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const int8x16_t zero = vdupq_n_s8(0);
+    const auto* bytes = reinterpret_cast<const int8_t*>(data);
+    uint8x16_t low = vandq_u8(vcgtq_s8(vld1q_s8(bytes), zero), bits);
+    uint8x16_t high = vandq_u8(vcgtq_s8(vld1q_s8(bytes + 16), zero), bits);
+    uint8x16_t sum = vpaddq_u8(low, high);
+    sum = vpaddq_u8(sum, sum);
+    sum = vpaddq_u8(sum, sum);
+    uint32_t mask = vgetq_lane_u32(vreinterpretq_u32_u8(sum), 0);
+#elif defined(__SSE2__)
     auto zero16 = _mm_setzero_si128();
     uint32_t mask =
             (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(
@@ -59,6 +70,19 @@ inline uint32_t bytes32_mask_to_bits32_mask(const bool* data) {
     return bytes32_mask_to_bits32_mask(reinterpret_cast<const uint8_t*>(data));
 }
 
+#ifdef __aarch64__
+/// Transform the 16 bytes of a NEON comparison result, each 0xff or 0, to a 16-bit mask like
+/// _mm_movemask_epi8 does.
+inline uint32_t bytes16_mask_to_bits16_mask(uint8x16_t data) {
+    const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t masked = vandq_u8(data, bits);
+    uint8x8_t sum = vpadd_u8(vget_low_u8(masked), vget_high_u8(masked));
+    sum = vpadd_u8(sum, sum);
+    sum = vpadd_u8(sum, sum);
+    return vget_lane_u16(vreinterpret_u16_u8(sum), 0);
+}
+#endif
+
 inline size_t count_zero_num(const int8_t* __restrict data, size_t size) {
     size_t num = 0;
     const int8_t* end = data + size;
@@ -80,6 +104,12 @@ inline size_t count_zero_num(const int8_t* __restrict data, size_t size) {
                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), zero16)))
                  << 48u));
     }
+#elif defined(__aarch64__)
+    const int8x16_t zero = vdupq_n_s8(0);
+    const int8_t* end16 = data + (size / 16 * 16);
+    for (; data < end16; data += 16) {
+        num += vaddvq_u8(vshrq_n_u8(vceqq_s8(vld1q_s8(data), zero), 7));
+    }
 #endif
     for (; data < end; ++data) {
         num += (*data == 0);
@@ -0,0 +1,77 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif __SSE2__
+#include <emmintrin.h>
+#elif __aarch64__
+#include <sse2neon.h>
+#endif
+
+namespace doris {
+namespace simd {
+
+/// Calls on_field(begin, end) for each field of the line separated by the single byte separator,
+/// including the last one, so a line with n separators has n + 1 fields. The separators are
+/// located 32 bytes (16 bytes without AVX2) at a time: the bytes are compared to the separator
+/// and the positions of the set bits of the comparison mask are the ends of the fields.
+template <typename OnField>
+inline void split_by_char(const char* data, size_t size, char separator, OnField&& on_field) {
+    size_t start = 0;
+    size_t pos = 0;
+#ifdef __AVX2__
+    const __m256i pattern = _mm256_set1_epi8(separator);
+    for (; pos + 32 <= size; pos += 32) {
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos)), pattern)));
+        while (mask != 0) {
+            size_t end = pos + __builtin_ctz(mask);
+            on_field(start, end);
+            start = end + 1;
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__SSE2__) || defined(__aarch64__)
+    const __m128i pattern = _mm_set1_epi8(separator);
+    for (; pos + 16 <= size; pos += 16) {
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos)), pattern)));
+        while (mask != 0) {
+            size_t end = pos + __builtin_ctz(mask);
+            on_field(start, end);
+            start = end + 1;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; pos < size; ++pos) {
+        if (data[pos] == separator) {
+            on_field(start, pos);
+            start = pos + 1;
+        }
+    }
+    on_field(start, size);
+}
+
+} // namespace simd
+} // namespace doris
@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace doris {
+namespace simd {
+
+// Digits are parsed eight at a time in a 64-bit word, as the number parser of simdjson does:
+// a word of eight ascii chars is checked to hold only digits and converted to their number by
+// three multiplications, instead of a compare and a multiply-add per char.
+
+inline uint64_t load_eight_chars(const char* p) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+// Whether the eight chars of a little endian word are all in ['0', '9']: the high nibble of each
+// byte has to be 3, and adding 6 to the byte must not carry into the high nibble.
+inline bool is_eight_digits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0) |
+            (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+inline bool is_eight_digits(const char* p) {
+    return is_eight_digits(load_eight_chars(p));
+}
+
+// The number of eight ascii digits, the first one being the most significant.
+inline uint32_t parse_eight_digits(uint64_t word) {
+    constexpr uint64_t mask = 0x000000FF000000FF;
+    constexpr uint64_t mul1 = 100 + (1000000ULL << 32);
+    constexpr uint64_t mul2 = 1 + (10000ULL << 32);
+    word -= 0x3030303030303030;
+    // pairs of digits, then groups of four and eight of them
+    word = (word * 10) + (word >> 8);
+    word = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(word);
+}
+
+inline uint32_t parse_eight_digits(const char* p) {
+    return parse_eight_digits(load_eight_chars(p));
+}
+
+// Parses the digits of [p, p + len) into *value, which must not overflow: returns false if one of
+// the chars isn't a digit.
+template <typename T>
+bool parse_digits(const char* p, int len, T* value) {
+    T val = 0;
+    int i = 0;
+    if constexpr (sizeof(T) >= sizeof(uint32_t)) {
+        for (; i + 8 <= len; i += 8) {
+            uint64_t word = load_eight_chars(p + i);
+            if (!is_eight_digits(word)) {
+                return false;
+            }
+            val = val * 100000000 + parse_eight_digits(word);
+        }
+    }
+    for (; i < len; ++i) {
+        uint8_t digit = p[i] - '0';
+        if (digit > 9) {
+            return false;
+        }
+        val = val * 10 + digit;
+    }
+    *value = val;
+    return true;
+}
+
+} // namespace simd
+} // namespace doris
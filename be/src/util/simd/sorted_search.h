@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#elif __aarch64__
+#include <sse2neon.h>
+#endif
+
+namespace doris {
+namespace simd {
+
+// The sorted index arrays are searched by a binary search without branches down to a window of
+// SORTED_SEARCH_WINDOW values, which are then compared to the key 2 at a time. Both steps only
+// depend on the size of the array, so the seeks of many keys do not stall on mispredictions.
+static constexpr size_t SORTED_SEARCH_WINDOW = 16;
+
+namespace detail {
+
+// The number of the values of the sorted [data, data + size) less than key, or not greater than
+// key if !strict.
+template <bool strict>
+inline size_t sorted_count(const uint64_t* data, size_t size, uint64_t key) {
+    const uint64_t* base = data;
+    size_t n = size;
+    while (n > SORTED_SEARCH_WINDOW) {
+        size_t half = n / 2;
+        base = (strict ? base[half] < key : base[half] <= key) ? base + half : base;
+        n -= half;
+    }
+    // the values before base are all before the key, the ones of the window are counted
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__SSE4_2__)
+    // there is no unsigned compare of 64 bits, the sign bits are flipped for a signed one
+    const __m128i sign = _mm_set1_epi64x(INT64_MIN);
+    const __m128i k = _mm_xor_si128(_mm_set1_epi64x(key), sign);
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + i));
+        v = _mm_xor_si128(v, sign);
+        // strict: key > v, otherwise: v > key, whose complement is v <= key
+        __m128i gt = strict ? _mm_cmpgt_epi64(k, v) : _mm_cmpgt_epi64(v, k);
+        count += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(gt)));
+    }
+    if (!strict) {
+        count = i - count;
+    }
+#elif defined(__aarch64__)
+    const uint64x2_t k = vdupq_n_u64(key);
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t v = vld1q_u64(base + i);
+        uint64x2_t before = strict ? vcltq_u64(v, k) : vcleq_u64(v, k);
+        count += (vgetq_lane_u64(before, 0) & 1) + (vgetq_lane_u64(before, 1) & 1);
+    }
+#endif
+    for (; i < n; ++i) {
+        count += strict ? base[i] < key : base[i] <= key;
+    }
+    return (base - data) + count;
+}
+
+} // namespace detail
+
+// The position of the first value of the sorted [data, data + size) not less than key, like
+// std::lower_bound.
+inline size_t sorted_lower_bound(const uint64_t* data, size_t size, uint64_t key) {
+    return detail::sorted_count<true>(data, size, key);
+}
+
+// The position of the first value of the sorted [data, data + size) greater than key, like
+// std::upper_bound.
+inline size_t sorted_upper_bound(const uint64_t* data, size_t size, uint64_t key) {
+    return detail::sorted_count<false>(data, size, key);
+}
+
+} // namespace simd
+} // namespace doris
@@ -0,0 +1,212 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __aarch64__
+#include <sse2neon.h>
+#endif
+
+#include "util/simd/lower_upper_impl.h"
+
+namespace doris {
+namespace simd {
+
+// UTF-8 routines that look at 16 bytes at a time, in the way of simdutf: the chars of a valid
+// string are counted as its bytes that are not continuation bytes 10xxxxxx, so the length of each
+// char never has to be decoded. Continuation bytes are the ones below -64 as signed chars.
+
+// The number of the utf-8 chars of [data, data + size).
+inline size_t utf8_char_count(const char* data, size_t size) {
+    size_t continuation_bytes = 0;
+    size_t pos = 0;
+#if defined(__SSE2__) || defined(__aarch64__)
+    const __m128i threshold = _mm_set1_epi8(-64);
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        continuation_bytes += __builtin_popcount(
+                static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(bytes, threshold))));
+    }
+#endif
+    for (; pos < size; ++pos) {
+        continuation_bytes += static_cast<int8_t>(data[pos]) < -64;
+    }
+    return size - continuation_bytes;
+}
+
+// The byte offset of the char n, counted from 0, of [data, data + size), or size if the string
+// has no more than n chars. The blocks of 16 bytes before the char are skipped by counting their
+// chars.
+inline size_t utf8_char_offset(const char* data, size_t size, size_t n) {
+    size_t pos = 0;
+#if defined(__SSE2__) || defined(__aarch64__)
+    const __m128i threshold = _mm_set1_epi8(-64);
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        size_t chars = 16 - __builtin_popcount(static_cast<uint32_t>(
+                                    _mm_movemask_epi8(_mm_cmplt_epi8(bytes, threshold))));
+        if (chars > n) {
+            break;
+        }
+        n -= chars;
+    }
+#endif
+    for (; pos < size; ++pos) {
+        if (static_cast<int8_t>(data[pos]) >= -64) {
+            if (n == 0) {
+                return pos;
+            }
+            --n;
+        }
+    }
+    return size;
+}
+
+inline bool is_ascii(const char* data, size_t size) {
+    size_t pos = 0;
+#if defined(__SSE2__) || defined(__aarch64__)
+    for (; pos + 16 <= size; pos += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos)))) {
+            return false;
+        }
+    }
+#endif
+    uint8_t or_code = 0;
+    for (; pos < size; ++pos) {
+        or_code |= static_cast<uint8_t>(data[pos]);
+    }
+    return !(or_code & 0x80);
+}
+
+// Changes the case of the two bytes char at p if it is one of the Latin-1, Greek or Cyrillic
+// letters whose other case is a two bytes char too, and returns whether p is such a letter.
+template <bool to_upper>
+inline bool transfer_two_bytes_case(uint8_t* p) {
+    const uint8_t lead = p[0];
+    const uint8_t next = p[1];
+    if constexpr (to_upper) {
+        if (lead == 0xC3) {
+            // U+00E0 ~ U+00FE but U+00F7 (division sign)
+            if (next >= 0xA0 && next <= 0xBE && next != 0xB7) {
+                p[1] = next - 0x20;
+                return true;
+            }
+        } else if (lead == 0xCE) {
+            // U+03B1 ~ U+03BF
+            if (next >= 0xB1 && next <= 0xBF) {
+                p[1] = next - 0x20;
+                return true;
+            }
+        } else if (lead == 0xCF) {
+            // U+03C0 ~ U+03C9, whose U+03C2 (final sigma) is U+03A3 in upper case
+            if (next >= 0x80 && next <= 0x89) {
+                p[0] = 0xCE;
+                p[1] = next == 0x82 ? 0xA3 : next + 0x20;
+                return true;
+            }
+        } else if (lead == 0xD0) {
+            // U+0430 ~ U+043F
+            if (next >= 0xB0 && next <= 0xBF) {
+                p[1] = next - 0x20;
+                return true;
+            }
+        } else if (lead == 0xD1) {
+            // U+0440 ~ U+044F and U+0450 ~ U+045F
+            if (next >= 0x80 && next <= 0x9F) {
+                p[0] = 0xD0;
+                p[1] = next <= 0x8F ? next + 0x20 : next - 0x10;
+                return true;
+            }
+        }
+    } else {
+        if (lead == 0xC3) {
+            // U+00C0 ~ U+00DE but U+00D7 (multiplication sign)
+            if (next >= 0x80 && next <= 0x9E && next != 0x97) {
+                p[1] = next + 0x20;
+                return true;
+            }
+        } else if (lead == 0xCE) {
+            // U+0391 ~ U+039F and U+03A0 ~ U+03A9 but the unassigned U+03A2
+            if (next >= 0x91 && next <= 0x9F) {
+                p[1] = next + 0x20;
+                return true;
+            }
+            if (next >= 0xA0 && next <= 0xA9 && next != 0xA2) {
+                p[0] = 0xCF;
+                p[1] = next - 0x20;
+                return true;
+            }
+        } else if (lead == 0xD0) {
+            // U+0400 ~ U+040F, U+0410 ~ U+041F and U+0420 ~ U+042F
+            if (next >= 0x80 && next <= 0xAF) {
+                if (next <= 0x8F) {
+                    p[0] = 0xD1;
+                    p[1] = next + 0x10;
+                } else if (next <= 0x9F) {
+                    p[1] = next + 0x20;
+                } else {
+                    p[0] = 0xD1;
+                    p[1] = next - 0x20;
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Writes [src, src + size) in lower (or upper) case to dst, which has the same size: the ascii
+// letters are changed 16 bytes at a time, and then the Latin-1, Greek and Cyrillic letters, whose
+// lead bytes are 0xC3 ~ 0xD1, are looked for in the non ascii bytes. The other chars, like the CJK
+// ones, are copied as is, so the result always has the size of the source.
+template <bool to_upper>
+inline void utf8_transfer_case(const uint8_t* src, size_t size, uint8_t* dst) {
+    if constexpr (to_upper) {
+        LowerUpperImpl<'a', 'z'>::transfer(src, src + size, dst);
+    } else {
+        LowerUpperImpl<'A', 'Z'>::transfer(src, src + size, dst);
+    }
+    size_t pos = 0;
+    while (pos + 1 < size) {
+#if defined(__SSE2__) || defined(__aarch64__)
+        if (pos + 16 <= size) {
+            // the bytes in [0xC3, 0xD1], which are [-61, -47] as signed chars
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + pos));
+            const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(-62)),
+                                  _mm_cmplt_epi8(bytes, _mm_set1_epi8(-46)))));
+            if (mask == 0) {
+                pos += 16;
+                continue;
+            }
+            pos += __builtin_ctz(mask);
+            if (pos + 1 >= size) {
+                break;
+            }
+        }
+#endif
+        pos += transfer_two_bytes_case<to_upper>(dst + pos) ? 2 : 1;
+    }
+}
+
+} // namespace simd
+} // namespace doris
@@ -27,6 +27,7 @@
 
 #include "runtime/string_value.hpp"
 #include "util/simd/lower_upper_impl.h"
+#include "util/simd/utf8.h"
 
 namespace doris {
 
@@ -192,16 +193,14 @@ public:
         if (len <= 0) {
             return;
         }
-        LowerUpperImpl<'A', 'Z'> lowerUpper;
-        lowerUpper.transfer(src, src + len, dst);
+        utf8_transfer_case<false>(src, len, dst);
     }
 
     static void to_upper(uint8_t* src, int64_t len, uint8_t* dst) {
         if (len <= 0) {
             return;
         }
-        LowerUpperImpl<'a', 'z'> lowerUpper;
-        lowerUpper.transfer(src, src + len, dst);
+        utf8_transfer_case<true>(src, len, dst);
     }
 };
 } // namespace simd
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <sched.h>
+
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "common/compiler_util.h"
+#include "gutil/macros.h"
+
+namespace doris {
+
+// A shared mutex for the data read by many threads at a high rate and rarely written. A single
+// std::shared_mutex makes all the readers update its cache line, which is contended even though
+// they never wait for each other. Here the readers lock one of several stripes chosen by the CPU
+// they run on, and a writer locks all the stripes, so writing is more expensive.
+//
+// The readers must unlock the stripe they locked, so they use StripedSharedLock instead of
+// std::shared_lock. The writers can use std::lock_guard and std::unique_lock.
+class StripedSharedMutex {
+public:
+    StripedSharedMutex() {
+        size_t num_cpus = std::thread::hardware_concurrency();
+        size_t size = 8;
+        while (size < num_cpus && size < kMaxStripes) {
+            size <<= 1;
+        }
+        _stripes = std::vector<Stripe>(size);
+    }
+
+    void lock() {
+        for (auto& stripe : _stripes) {
+            stripe.mutex.lock();
+        }
+    }
+
+    void unlock() {
+        for (auto it = _stripes.rbegin(); it != _stripes.rend(); ++it) {
+            it->mutex.unlock();
+        }
+    }
+
+    // Returns the stripe to pass to unlock_shared().
+    size_t lock_shared() {
+        int cpu = sched_getcpu();
+        size_t stripe = cpu < 0 ? 0 : static_cast<size_t>(cpu) & (_stripes.size() - 1);
+        _stripes[stripe].mutex.lock_shared();
+        return stripe;
+    }
+
+    void unlock_shared(size_t stripe) { _stripes[stripe].mutex.unlock_shared(); }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(StripedSharedMutex);
+
+    static constexpr size_t kMaxStripes = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Stripe {
+        std::shared_mutex mutex;
+    };
+
+    std::vector<Stripe> _stripes;
+};
+
+// Holds the shared lock of a StripedSharedMutex in its scope.
+class StripedSharedLock {
+public:
+    explicit StripedSharedLock(StripedSharedMutex& mutex)
+            : _mutex(mutex), _stripe(mutex.lock_shared()) {}
+    ~StripedSharedLock() { _mutex.unlock_shared(_stripe); }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(StripedSharedLock);
+
+    StripedSharedMutex& _mutex;
+    const size_t _stripe;
+};
+
+} // namespace doris
@@ -0,0 +1,172 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/telemetry/tail_sampling_span_processor.h"
+
+#include "common/logging.h"
+
+namespace doris::telemetry {
+
+namespace trace = opentelemetry::trace;
+namespace nostd = opentelemetry::nostd;
+namespace common = opentelemetry::common;
+namespace trace_sdk = opentelemetry::sdk::trace;
+
+namespace {
+
+// Records the span into the recordable of the next processor, and keeps what the sampling needs.
+class TailSamplingRecordable : public trace_sdk::Recordable {
+public:
+    explicit TailSamplingRecordable(std::unique_ptr<trace_sdk::Recordable> recordable)
+            : recordable(std::move(recordable)) {}
+
+    void SetIdentity(const trace::SpanContext& span_context,
+                     trace::SpanId parent_span_id) noexcept override {
+        const trace::TraceId& id = span_context.trace_id();
+        trace_id.assign(reinterpret_cast<const char*>(id.Id().data()), id.Id().size());
+        recordable->SetIdentity(span_context, parent_span_id);
+    }
+
+    void SetAttribute(nostd::string_view key,
+                      const common::AttributeValue& value) noexcept override {
+        recordable->SetAttribute(key, value);
+    }
+
+    void AddEvent(nostd::string_view name, common::SystemTimestamp timestamp,
+                  const common::KeyValueIterable& attributes) noexcept override {
+        recordable->AddEvent(name, timestamp, attributes);
+    }
+
+    void AddLink(const trace::SpanContext& span_context,
+                 const common::KeyValueIterable& attributes) noexcept override {
+        recordable->AddLink(span_context, attributes);
+    }
+
+    void SetStatus(trace::StatusCode code, nostd::string_view description) noexcept override {
+        recordable->SetStatus(code, description);
+    }
+
+    void SetName(nostd::string_view name) noexcept override { recordable->SetName(name); }
+
+    void SetSpanKind(trace::SpanKind span_kind) noexcept override {
+        recordable->SetSpanKind(span_kind);
+    }
+
+    void SetResource(const opentelemetry::sdk::resource::Resource& resource) noexcept override {
+        recordable->SetResource(resource);
+    }
+
+    void SetStartTime(common::SystemTimestamp start_time) noexcept override {
+        recordable->SetStartTime(start_time);
+    }
+
+    void SetDuration(std::chrono::nanoseconds duration) noexcept override {
+        this->duration = duration;
+        recordable->SetDuration(duration);
+    }
+
+    void SetInstrumentationLibrary(
+            const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary&
+                    instrumentation_library) noexcept override {
+        recordable->SetInstrumentationLibrary(instrumentation_library);
+    }
+
+    std::unique_ptr<trace_sdk::Recordable> recordable;
+    std::string trace_id;
+    bool is_root = false;
+    std::chrono::nanoseconds duration {0};
+};
+
+} // namespace
+
+TailSamplingSpanProcessor::TailSamplingSpanProcessor(
+        std::unique_ptr<trace_sdk::SpanProcessor> processor, std::chrono::nanoseconds threshold,
+        size_t max_buffered_spans)
+        : _processor(std::move(processor)),
+          _threshold(threshold),
+          _max_buffered_spans(max_buffered_spans) {}
+
+std::unique_ptr<trace_sdk::Recordable> TailSamplingSpanProcessor::MakeRecordable() noexcept {
+    return std::unique_ptr<trace_sdk::Recordable>(
+            new TailSamplingRecordable(_processor->MakeRecordable()));
+}
+
+void TailSamplingSpanProcessor::OnStart(trace_sdk::Recordable& span,
+                                        const trace::SpanContext& parent_context) noexcept {
+    auto& recordable = static_cast<TailSamplingRecordable&>(span);
+    recordable.is_root = !parent_context.IsValid() || parent_context.IsRemote();
+    if (recordable.is_root) {
+        std::lock_guard<std::mutex> l(_lock);
+        _traces[recordable.trace_id].open_roots++;
+    }
+    _processor->OnStart(*recordable.recordable, parent_context);
+}
+
+void TailSamplingSpanProcessor::OnEnd(std::unique_ptr<trace_sdk::Recordable>&& span) noexcept {
+    std::unique_ptr<TailSamplingRecordable> recordable(
+            static_cast<TailSamplingRecordable*>(span.release()));
+    // the spans to export, which are passed to the next processor out of the lock
+    std::vector<std::unique_ptr<trace_sdk::Recordable>> sampled_spans;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _traces.find(recordable->trace_id);
+        if (it == _traces.end()) {
+            // the local roots of the trace have ended, or it has none here
+            return;
+        }
+        BufferedTrace& trace = it->second;
+        if (trace.sampled) {
+            sampled_spans.push_back(std::move(recordable->recordable));
+        } else if (_num_buffered_spans < _max_buffered_spans) {
+            trace.spans.push_back(std::move(recordable->recordable));
+            _num_buffered_spans++;
+        }
+        if (recordable->is_root) {
+            if (!trace.sampled && recordable->duration >= _threshold) {
+                trace.sampled = true;
+                _num_buffered_spans -= trace.spans.size();
+                for (auto& buffered_span : trace.spans) {
+                    sampled_spans.push_back(std::move(buffered_span));
+                }
+                trace.spans.clear();
+            }
+            // the children of a span end before it, so the trace is done with its local roots
+            if (--trace.open_roots == 0) {
+                _num_buffered_spans -= trace.spans.size();
+                _traces.erase(it);
+            }
+        }
+    }
+    for (auto& sampled_span : sampled_spans) {
+        _processor->OnEnd(std::move(sampled_span));
+    }
+}
+
+bool TailSamplingSpanProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept {
+    return _processor->ForceFlush(timeout);
+}
+
+bool TailSamplingSpanProcessor::Shutdown(std::chrono::microseconds timeout) noexcept {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _traces.clear();
+        _num_buffered_spans = 0;
+    }
+    return _processor->Shutdown(timeout);
+}
+
+} // namespace doris::telemetry
@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/recordable.h"
+
+namespace doris::telemetry {
+
+/// A span processor that buffers the ended spans of each trace in memory, and only passes them to
+/// the next processor, which exports them, if the trace turns out to be slow.
+///
+/// A span is a local root if its parent is remote or it has no parent, like the span of the
+/// execution of a fragment instance. When a local root of a trace ends after at least the
+/// threshold, the buffered spans of the trace and its spans that end later are exported. When
+/// the last local root of a trace ends and the trace is not sampled, its spans are dropped.
+class TailSamplingSpanProcessor : public opentelemetry::sdk::trace::SpanProcessor {
+public:
+    TailSamplingSpanProcessor(std::unique_ptr<opentelemetry::sdk::trace::SpanProcessor> processor,
+                              std::chrono::nanoseconds threshold, size_t max_buffered_spans);
+
+    std::unique_ptr<opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
+
+    void OnStart(opentelemetry::sdk::trace::Recordable& span,
+                 const opentelemetry::trace::SpanContext& parent_context) noexcept override;
+
+    void OnEnd(std::unique_ptr<opentelemetry::sdk::trace::Recordable>&& span) noexcept override;
+
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+private:
+    struct BufferedTrace {
+        // the recordables of the next processor of the ended spans
+        std::vector<std::unique_ptr<opentelemetry::sdk::trace::Recordable>> spans;
+        int open_roots = 0;
+        bool sampled = false;
+    };
+
+    const std::unique_ptr<opentelemetry::sdk::trace::SpanProcessor> _processor;
+    const std::chrono::nanoseconds _threshold;
+    const size_t _max_buffered_spans;
+
+    std::mutex _lock;
+    // trace id -> the spans of the trace
+    std::unordered_map<std::string, BufferedTrace> _traces;
+    size_t _num_buffered_spans = 0;
+};
+
+} // namespace doris::telemetry
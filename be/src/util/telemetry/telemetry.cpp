@@ -18,6 +18,7 @@
 #include "telemetry.h"
 
 #include "common/config.h"
+#include "gen_cpp/RuntimeProfile_types.h"
 #include "opentelemetry/context/propagation/global_propagator.h"
 #include "opentelemetry/context/propagation/text_map_propagator.h"
 #include "opentelemetry/exporters/zipkin/zipkin_exporter.h"
@@ -27,6 +28,7 @@
 #include "opentelemetry/trace/propagation/http_trace_context.h"
 #include "opentelemetry/trace/provider.h"
 #include "service/backend_options.h"
+#include "util/telemetry/tail_sampling_span_processor.h"
 
 namespace trace = opentelemetry::trace;
 namespace nostd = opentelemetry::nostd;
@@ -53,6 +55,14 @@ void doris::telemetry::initTracer() {
     batchOptions.max_export_batch_size = doris::config::max_span_export_batch_size;
     auto processor = std::unique_ptr<trace_sdk::SpanProcessor>(
             new trace_sdk::BatchSpanProcessor(std::move(exporter), batchOptions));
+    // Only the spans of the slow traces are exported when tail sampling is on.
+    if (doris::config::trace_tail_sampling_threshold_ms > 0) {
+        processor = std::unique_ptr<trace_sdk::SpanProcessor>(
+                new doris::telemetry::TailSamplingSpanProcessor(
+                        std::move(processor),
+                        std::chrono::milliseconds(doris::config::trace_tail_sampling_threshold_ms),
+                        doris::config::max_tail_sampling_buffered_spans));
+    }
 
     std::string service_name = "BACKEND:" + BackendOptions::get_localhost();
     resource::ResourceAttributes attributes = {{"service.name", service_name}};
@@ -68,3 +78,22 @@ void doris::telemetry::initTracer() {
             nostd::shared_ptr<propagation::TextMapPropagator>(
                     new opentelemetry::trace::propagation::HttpTraceContext()));
 }
+
+void doris::telemetry::set_span_profile_attributes(OpentelemetrySpan& span,
+                                                   RuntimeProfile* profile) {
+    if (!span->IsRecording()) {
+        return;
+    }
+    TRuntimeProfileTree tree;
+    profile->to_thrift(&tree);
+    for (auto& node : tree.nodes) {
+        // the profiles of the exec nodes are named like "VOLAP_SCAN_NODE (id=0)"
+        if (node.name.find("(id=") == std::string::npos) {
+            continue;
+        }
+        for (auto& counter : node.counters) {
+            span->SetAttribute(node.name + "." + counter.name,
+                               PrettyPrinter::print(counter.value, counter.type));
+        }
+    }
+}
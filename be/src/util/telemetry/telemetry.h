@@ -91,6 +91,10 @@ inline void set_span_attribute(OpentelemetrySpan& span, RuntimeProfile::Counter*
     span->SetAttribute(counter->name(), PrettyPrinter::print(counter->value(), counter->type()));
 }
 
+/// Sets the counters of the exec nodes in the profile as the attributes of the span, like
+/// "VHASH_JOIN_NODE (id=2).ProbeRows", if the span is recording.
+void set_span_profile_attributes(OpentelemetrySpan& span, RuntimeProfile* profile);
+
 inline void set_current_span_attribute(RuntimeProfile::Counter* const counter) {
     opentelemetry::trace::Tracer::GetCurrentSpan()->SetAttribute(
             counter->name(), PrettyPrinter::print(counter->value(), counter->type()));
@@ -0,0 +1,165 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/thread_perf_counters.h"
+
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace doris {
+
+namespace {
+
+int64_t clock_ns(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec * 1000L * 1000L * 1000L + ts.tv_nsec;
+}
+
+// The perf event group of a thread: the instructions and the last level cache misses of the
+// thread in user space, which is what perf_event_paranoid 2 allows.
+class PerfEventGroup {
+public:
+    enum Event { INSTRUCTIONS, LLC_MISSES, NUM_EVENTS };
+
+    PerfEventGroup() {
+        _open(INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        _open(LLC_MISSES, PERF_TYPE_HW_CACHE,
+              PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    }
+
+    ~PerfEventGroup() {
+        for (int i = 0; i < _num_fds; ++i) {
+            close(_fds[i]);
+        }
+    }
+
+    void read(ThreadPerfCounters::Values* values) const {
+        if (_num_fds == 0) {
+            return;
+        }
+        // the format of PERF_FORMAT_GROUP: the number of events, then their values
+        uint64_t buffer[1 + NUM_EVENTS];
+        ssize_t size = ::read(_fds[0], buffer, sizeof(buffer));
+        if (size < static_cast<ssize_t>(sizeof(uint64_t) * (1 + _num_fds))) {
+            return;
+        }
+        for (int i = 0; i < _num_fds; ++i) {
+            int64_t value = buffer[1 + i];
+            if (_events[i] == INSTRUCTIONS) {
+                values->instructions = value;
+            } else {
+                values->llc_misses = value;
+            }
+        }
+    }
+
+private:
+    void _open(Event event, uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        int group_fd = _num_fds == 0 ? -1 : _fds[0];
+        int fd = syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        _fds[_num_fds] = fd;
+        _events[_num_fds] = event;
+        ++_num_fds;
+    }
+
+    int _fds[NUM_EVENTS];
+    Event _events[NUM_EVENTS];
+    int _num_fds = 0;
+};
+
+thread_local ScopedPerfCounters* t_current_scope = nullptr;
+
+} // namespace
+
+void ThreadPerfCounters::read(Values* values) {
+    static thread_local PerfEventGroup group;
+    values->wall_time_ns = clock_ns(CLOCK_MONOTONIC);
+    values->cpu_time_ns = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+    group.read(values);
+}
+
+ProfilePerfCounters::ProfilePerfCounters(RuntimeProfile* profile) {
+    _cpu_time = ADD_TIMER(profile, "PerfCpuTime");
+    _off_cpu_time = ADD_TIMER(profile, "PerfOffCpuTime");
+    _instructions = ADD_COUNTER(profile, "PerfInstructions", TUnit::UNIT);
+    _llc_misses = ADD_COUNTER(profile, "PerfLLCMisses", TUnit::UNIT);
+}
+
+void ProfilePerfCounters::update(const ThreadPerfCounters::Values& delta) {
+    _cpu_time->update(delta.cpu_time_ns);
+    _off_cpu_time->update(std::max<int64_t>(delta.wall_time_ns - delta.cpu_time_ns, 0));
+    _instructions->update(delta.instructions);
+    _llc_misses->update(delta.llc_misses);
+}
+
+ScopedPerfCounters::ScopedPerfCounters(ProfilePerfCounters* counters) : _counters(counters) {
+    if (_counters == nullptr) {
+        return;
+    }
+    _parent = t_current_scope;
+    t_current_scope = this;
+    ThreadPerfCounters::read(&_start);
+}
+
+void ScopedPerfCounters::stop() {
+    if (_counters == nullptr) {
+        return;
+    }
+    ThreadPerfCounters::Values end;
+    ThreadPerfCounters::read(&end);
+    ThreadPerfCounters::Values total;
+    total.wall_time_ns = end.wall_time_ns - _start.wall_time_ns;
+    total.cpu_time_ns = end.cpu_time_ns - _start.cpu_time_ns;
+    total.instructions = end.instructions - _start.instructions;
+    total.llc_misses = end.llc_misses - _start.llc_misses;
+
+    ThreadPerfCounters::Values own;
+    own.wall_time_ns = total.wall_time_ns - _inner.wall_time_ns;
+    own.cpu_time_ns = total.cpu_time_ns - _inner.cpu_time_ns;
+    own.instructions = total.instructions - _inner.instructions;
+    own.llc_misses = total.llc_misses - _inner.llc_misses;
+    _counters->update(own);
+
+    if (_parent != nullptr) {
+        _parent->_inner.wall_time_ns += total.wall_time_ns;
+        _parent->_inner.cpu_time_ns += total.cpu_time_ns;
+        _parent->_inner.instructions += total.instructions;
+        _parent->_inner.llc_misses += total.llc_misses;
+    }
+    t_current_scope = _parent;
+    _counters = nullptr;
+}
+
+} // namespace doris
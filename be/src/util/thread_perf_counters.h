@@ -0,0 +1,85 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "util/runtime_profile.h"
+#include "util/stopwatch.hpp"
+
+namespace doris {
+
+// The hardware counters of the calling thread, read as one perf event group so that they are
+// sampled together. Each thread opens its group on its first read and closes it when it exits.
+class ThreadPerfCounters {
+public:
+    struct Values {
+        int64_t wall_time_ns = 0;
+        int64_t cpu_time_ns = 0;
+        int64_t instructions = 0;
+        int64_t llc_misses = 0;
+    };
+
+    // Reads the counters of the calling thread. The hardware counters stay 0 when perf events
+    // are not available, e.g. in a container or when perf_event_paranoid forbids them.
+    static void read(Values* values);
+};
+
+// The counters that an operator adds to its profile when the query enables perf counters:
+// thread CPU time, the time off CPU (blocked on I/O, locks or queues), instructions and last
+// level cache misses.
+class ProfilePerfCounters {
+public:
+    explicit ProfilePerfCounters(RuntimeProfile* profile);
+
+    void update(const ThreadPerfCounters::Values& delta);
+
+private:
+    RuntimeProfile::Counter* _cpu_time;
+    RuntimeProfile::Counter* _off_cpu_time;
+    RuntimeProfile::Counter* _instructions;
+    RuntimeProfile::Counter* _llc_misses;
+};
+
+// Adds the counters of the calling thread between its construction and stop() to 'counters'.
+// The scopes of a thread nest, like the get_next of an operator calling the get_next of its
+// child, and each scope only counts what ran outside of its inner scopes, so the counters of an
+// operator are its own and not the ones of its children. Does nothing if 'counters' is null.
+class ScopedPerfCounters {
+public:
+    explicit ScopedPerfCounters(ProfilePerfCounters* counters);
+    ~ScopedPerfCounters() { stop(); }
+
+    // Updates the counters. The scope counts nothing after it.
+    void stop();
+
+    ScopedPerfCounters(const ScopedPerfCounters&) = delete;
+    ScopedPerfCounters& operator=(const ScopedPerfCounters&) = delete;
+
+private:
+    ProfilePerfCounters* _counters;
+    ScopedPerfCounters* _parent = nullptr;
+    ThreadPerfCounters::Values _start;
+    // the counters of the inner scopes, which are not counted by this one
+    ThreadPerfCounters::Values _inner;
+};
+
+#define SCOPED_PERF_COUNTERS(counters) \
+    ScopedPerfCounters MACRO_CONCAT(SCOPED_PERF_COUNTERS, __COUNTER__)(counters)
+
+} // namespace doris
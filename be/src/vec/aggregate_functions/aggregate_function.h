@@ -48,6 +48,8 @@ using ConstAggregateDataPtr = const char*;
   */
 class IAggregateFunction {
 public:
+    static constexpr size_t MAX_DENSE_GROUPS = 256;
+
     IAggregateFunction(const DataTypes& argument_types_, const Array& parameters_)
             : argument_types(argument_types_), parameters(parameters_) {}
 
@@ -107,6 +109,11 @@ public:
     virtual void deserialize_vec(AggregateDataPtr places, ColumnString* column, Arena* arena,
                                  size_t num_rows) const = 0;
 
+    /// Returns true if the state is a trivially copyable value of size_of_data() bytes, so the
+    /// states can be passed between the phases as they are in a ColumnFixedLengthObject and merged
+    /// by merge_vec() without serialize() and deserialize().
+    virtual bool has_fixed_length_state() const { return false; }
+
     /// Returns true if a function requires Arena to handle own states (see add(), merge(), deserialize()).
     virtual bool allocates_memory_in_arena() const { return false; }
 
@@ -128,6 +135,16 @@ public:
     virtual void add_batch(size_t batch_size, AggregateDataPtr* places, size_t place_offset,
                            const IColumn** columns, Arena* arena) const = 0;
 
+    /** The same for a batch whose rows belong to num_groups groups with dense ids: the state of
+      *  row i is at group_places[group_ids[i]] + place_offset. With few groups, a function can add
+      *  the batch into a dense array of partial states indexed by the ids and merge them into the
+      *  states once, instead of updating a random state for every row. The partial states of the
+      *  functions that do so are on the stack, for at most MAX_DENSE_GROUPS groups.
+      */
+    virtual void add_batch_grouped(size_t batch_size, const UInt32* group_ids, size_t num_groups,
+                                   const AggregateDataPtr* group_places, size_t place_offset,
+                                   const IColumn** columns, Arena* arena) const = 0;
+
     /** The same for single place.
       */
     virtual void add_batch_single_place(size_t batch_size, AggregateDataPtr place,
@@ -165,6 +182,15 @@ public:
         }
     }
 
+    void add_batch_grouped(size_t batch_size, const UInt32* group_ids, size_t num_groups,
+                           const AggregateDataPtr* group_places, size_t place_offset,
+                           const IColumn** columns, Arena* arena) const override {
+        for (size_t i = 0; i < batch_size; ++i) {
+            static_cast<const Derived*>(this)->add(group_places[group_ids[i]] + place_offset,
+                                                   columns, i, arena);
+        }
+    }
+
     void add_batch_single_place(size_t batch_size, AggregateDataPtr place, const IColumn** columns,
                                 Arena* arena) const override {
         for (size_t i = 0; i < batch_size; ++i) {
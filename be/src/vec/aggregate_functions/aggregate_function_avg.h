@@ -122,6 +122,8 @@ public:
         this->data(place).count += this->data(rhs).count;
     }
 
+    bool has_fixed_length_state() const override { return true; }
+
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
         this->data(place).write(buf);
     }
@@ -36,12 +36,13 @@ struct AggregateFunctionBitmapUnionOp {
         res.add(data);
     }
 
+    // the unions are lazy, AggregateFunctionBitmapData repairs the result before it is read
     static void add(BitmapValue& res, const BitmapValue& data, bool& is_first) {
         if (UNLIKELY(is_first)) {
             res = data;
             is_first = false;
         } else {
-            res |= data;
+            res.lazy_or(data);
         }
     }
 
@@ -50,7 +51,7 @@ struct AggregateFunctionBitmapUnionOp {
             res = data;
             is_first = false;
         } else {
-            res |= data;
+            res.lazy_or(data);
         }
     }
 };
@@ -89,13 +90,19 @@ struct AggregateFunctionBitmapData {
 
     void merge(const BitmapValue& data) { Op::merge(value, data, is_first); }
 
-    void write(BufferWritable& buf) const { DataTypeBitMap::serialize_as_stream(value, buf); }
+    void write(BufferWritable& buf) const {
+        DataTypeBitMap::serialize_as_stream(const_cast<AggregateFunctionBitmapData*>(this)->get(),
+                                            buf);
+    }
 
     void read(BufferReadable& buf) { DataTypeBitMap::deserialize_as_stream(value, buf); }
 
     void reset() { is_first = true; }
 
-    BitmapValue& get() { return value; }
+    BitmapValue& get() {
+        value.repair_after_lazy();
+        return value;
+    }
 };
 
 template <typename Op>
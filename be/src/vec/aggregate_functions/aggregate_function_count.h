@@ -50,6 +50,24 @@ public:
         ++data(place).count;
     }
 
+    void add_batch_grouped(size_t batch_size, const UInt32* group_ids, size_t num_groups,
+                           const AggregateDataPtr* group_places, size_t place_offset,
+                           const IColumn** columns, Arena* arena) const override {
+        if (num_groups > MAX_DENSE_GROUPS) {
+            IAggregateFunctionDataHelper::add_batch_grouped(batch_size, group_ids, num_groups,
+                                                            group_places, place_offset, columns,
+                                                            arena);
+            return;
+        }
+        UInt64 counts[MAX_DENSE_GROUPS] = {};
+        for (size_t i = 0; i < batch_size; ++i) {
+            ++counts[group_ids[i]];
+        }
+        for (size_t g = 0; g < num_groups; ++g) {
+            data(group_places[g] + place_offset).count += counts[g];
+        }
+    }
+
     void reset(AggregateDataPtr place) const override {
         AggregateFunctionCount::data(place).count = 0;
     }
@@ -59,6 +77,8 @@ public:
         data(place).count += data(rhs).count;
     }
 
+    bool has_fixed_length_state() const override { return true; }
+
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
         write_var_uint(data(place).count, buf);
     }
@@ -97,6 +117,8 @@ public:
         data(place).count += data(rhs).count;
     }
 
+    bool has_fixed_length_state() const override { return true; }
+
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
         write_var_uint(data(place).count, buf);
     }
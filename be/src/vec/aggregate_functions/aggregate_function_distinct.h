@@ -22,6 +22,7 @@
 
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/key_holder_helpers.h"
+#include "vec/aggregate_functions/uniq_exact_set.h"
 #include "vec/common/aggregation_common.h"
 #include "vec/common/assert_cast.h"
 #include "vec/common/field_visitors.h"
@@ -35,7 +36,7 @@ namespace doris::vectorized {
 template <typename T>
 struct AggregateFunctionDistinctSingleNumericData {
     /// When creating, the hash table must be small.
-    using Set = HashSetWithStackMemory<T, DefaultHash<T>, 4>;
+    using Set = UniqExactSet<T, DefaultHash<T>, HashSetWithStackMemory<T, DefaultHash<T>, 4>>;
     using Self = AggregateFunctionDistinctSingleNumericData<T>;
     Set set;
 
@@ -53,9 +54,7 @@ struct AggregateFunctionDistinctSingleNumericData {
     MutableColumns get_arguments(const DataTypes& argument_types) const {
         MutableColumns argument_columns;
         argument_columns.emplace_back(argument_types[0]->create_column());
-        for (const auto& elem : set) {
-            argument_columns[0]->insert(elem.get_value());
-        }
+        set.for_each([&](const T& key) { argument_columns[0]->insert(key); });
 
         return argument_columns;
     }
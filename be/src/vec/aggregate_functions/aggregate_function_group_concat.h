@@ -20,14 +20,17 @@
 #include "common/status.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/common/chunked_string.h"
 #include "vec/common/string_ref.h"
 #include "vec/data_types/data_type_string.h"
 #include "vec/io/io_helper.h"
 
 namespace doris::vectorized {
 
+// The concatenation is appended to a ChunkedString, so that a group of many rows does not copy
+// its bytes again at every reallocation of the string. It is serialized like a std::string.
 struct AggregateFunctionGroupConcatData {
-    std::string data;
+    ChunkedString data;
     std::string separator;
     bool inited = false;
 
@@ -36,11 +39,10 @@ struct AggregateFunctionGroupConcatData {
             inited = true;
             separator.assign(sep.data, sep.data + sep.size);
         } else {
-            data += separator;
+            data.append(separator.data(), separator.size());
         }
 
-        data.resize(data.length() + ref.size);
-        memcpy(data.data() + data.length() - ref.size, ref.data, ref.size);
+        data.append(ref);
     }
 
     void merge(const AggregateFunctionGroupConcatData& rhs) {
@@ -51,29 +53,35 @@ struct AggregateFunctionGroupConcatData {
         if (!inited) {
             inited = true;
             separator = rhs.separator;
-            data = rhs.data;
         } else {
-            data += separator;
-            data += rhs.data;
+            data.append(separator.data(), separator.size());
         }
+        data.append(rhs.data);
     }
 
-    std::string get() const { return data; }
-
     void write(BufferWritable& buf) const {
-        write_binary(data, buf);
+        write_var_uint(data.size(), buf);
+        data.for_each_chunk([&buf](const char* chunk, size_t size) { buf.write(chunk, size); });
         write_binary(separator, buf);
         write_binary(inited, buf);
     }
 
     void read(BufferReadable& buf) {
-        read_binary(data, buf);
+        size_t size = 0;
+        read_var_uint(size, buf);
+        if (size > DEFAULT_MAX_STRING_SIZE) {
+            throw Exception("Too large string size.", TStatusCode::VEC_EXCEPTION);
+        }
+        data.clear();
+        if (size > 0) {
+            buf.read(data.append_uninitialized(size), size);
+        }
         read_binary(separator, buf);
         read_binary(inited, buf);
     }
 
     void reset() {
-        data = "";
+        data.clear();
         separator = "";
         inited = false;
     }
@@ -132,8 +140,14 @@ public:
     }
 
     void insert_result_into(ConstAggregateDataPtr __restrict place, IColumn& to) const override {
-        std::string result = this->data(place).get();
-        static_cast<ColumnString&>(to).insert_data(result.c_str(), result.length());
+        const ChunkedString& result = this->data(place).data;
+        auto& column = static_cast<ColumnString&>(to);
+        auto& chars = column.get_chars();
+        size_t old_size = chars.size();
+        chars.resize(old_size + result.size() + 1);
+        result.copy_to(reinterpret_cast<char*>(chars.data() + old_size));
+        chars.back() = 0;
+        column.get_offsets().push_back(chars.size());
     }
 };
 
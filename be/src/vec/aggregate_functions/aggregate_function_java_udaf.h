@@ -50,6 +50,7 @@ const char* UDAF_EXECUTOR_ADD_SIGNATURE = "(ZJJ)V";
 const char* UDAF_EXECUTOR_SERIALIZE_SIGNATURE = "(J)[B";
 const char* UDAF_EXECUTOR_MERGE_SIGNATURE = "(J[B)V";
 const char* UDAF_EXECUTOR_RESULT_SIGNATURE = "(JJ)Z";
+const char* UDAF_EXECUTOR_RESULTS_SIGNATURE = "(JJ)V";
 // Calling Java method about those signture means: "(argument-types)return-type"
 // https://www.iitk.ac.in/esc101/05Aug/tutorial/native1.1/implementing/method.html
 
@@ -240,6 +241,44 @@ public:
         return JniUtil::GetJniExceptionMsg(env);
     }
 
+    // Inserts the results of the places with one call into java, instead of a call per place. The
+    // results of strings are still got one by one, as their buffer may have to grow for a row.
+    Status get_batch(IColumn& to, const DataTypePtr& result_type,
+                     const std::vector<AggregateDataPtr>& places, size_t offset,
+                     size_t num_rows) const {
+        IColumn* data_col = &to;
+        if (result_type->is_nullable()) {
+            data_col = &assert_cast<ColumnNullable&>(to).get_nested_column();
+        }
+        if (!data_col->is_numeric() && !data_col->is_column_decimal()) {
+            for (size_t i = 0; i < num_rows; ++i) {
+                RETURN_IF_ERROR(
+                        get(to, result_type, reinterpret_cast<int64_t>(places[i] + offset)));
+            }
+            return Status::OK();
+        }
+        JNIEnv* env = nullptr;
+        RETURN_NOT_OK_STATUS_WITH_WARN(JniUtil::GetJNIEnv(&env), "Java-Udaf get values function");
+        std::vector<int64_t> places_address(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            places_address[i] = reinterpret_cast<int64_t>(places[i] + offset);
+        }
+        const size_t row_start = to.size();
+        to.insert_many_defaults(num_rows);
+        if (result_type->is_nullable()) {
+            auto& nullable = assert_cast<ColumnNullable&>(to);
+            *output_null_value =
+                    reinterpret_cast<int64_t>(nullable.get_null_map_column().get_raw_data().data);
+        } else {
+            *output_null_value = -1;
+        }
+        *output_value_buffer = reinterpret_cast<int64_t>(data_col->get_raw_data().data);
+        *input_place_ptrs = reinterpret_cast<int64_t>(places_address.data());
+        env->CallNonvirtualVoidMethod(executor_obj, executor_cl, executor_results_id,
+                                      static_cast<jlong>(row_start), static_cast<jlong>(num_rows));
+        return JniUtil::GetJniExceptionMsg(env);
+    }
+
 private:
     Status register_func_id(JNIEnv* env) {
         auto register_id = [&](const char* func_name, const char* func_sign, jmethodID& func_id) {
@@ -261,6 +300,8 @@ private:
                 register_id("serialize", UDAF_EXECUTOR_SERIALIZE_SIGNATURE, executor_serialize_id));
         RETURN_IF_ERROR(
                 register_id("getValue", UDAF_EXECUTOR_RESULT_SIGNATURE, executor_result_id));
+        RETURN_IF_ERROR(
+                register_id("getValues", UDAF_EXECUTOR_RESULTS_SIGNATURE, executor_results_id));
         RETURN_IF_ERROR(
                 register_id("destroy", UDAF_EXECUTOR_DESTROY_SIGNATURE, executor_destroy_id));
         return Status::OK();
@@ -277,6 +318,7 @@ private:
     jmethodID executor_merge_id;
     jmethodID executor_serialize_id;
     jmethodID executor_result_id;
+    jmethodID executor_results_id;
     jmethodID executor_close_id;
     jmethodID executor_destroy_id;
 
@@ -342,7 +384,7 @@ public:
                    const IColumn** columns, Arena* arena) const override {
         int64_t places_address[batch_size];
         for (size_t i = 0; i < batch_size; ++i) {
-            places_address[i] = reinterpret_cast<int64_t>(places[i]);
+            places_address[i] = reinterpret_cast<int64_t>(places[i] + place_offset);
         }
         this->data(_exec_place).add(places_address, false, columns, 0, batch_size, argument_types);
     }
@@ -387,6 +429,11 @@ public:
         this->data(_exec_place).get(to, _return_type, reinterpret_cast<int64_t>(place));
     }
 
+    void insert_result_into_vec(const std::vector<AggregateDataPtr>& places, const size_t offset,
+                                IColumn& to, const size_t num_rows) const override {
+        this->data(_exec_place).get_batch(to, _return_type, places, offset, num_rows);
+    }
+
 private:
     TFunction _fn;
     DataTypePtr _return_type;
@@ -32,6 +32,9 @@ namespace doris::vectorized {
 /// For numeric values.
 template <typename T>
 struct SingleValueDataFixed {
+public:
+    static constexpr bool IS_FIXED_LENGTH = true;
+
 private:
     using Self = SingleValueDataFixed;
 
@@ -127,6 +130,9 @@ public:
 /// For decimal values.
 template <typename T>
 struct SingleValueDataDecimal {
+public:
+    static constexpr bool IS_FIXED_LENGTH = true;
+
 private:
     using Self = SingleValueDataDecimal;
     using Type = typename NativeType<T>::Type;
@@ -224,6 +230,10 @@ public:
   * NOTE It could also be suitable for arrays of numbers.
   */
 struct SingleValueDataString {
+public:
+    // the value may be in the arena
+    static constexpr bool IS_FIXED_LENGTH = false;
+
 private:
     using Self = SingleValueDataString;
 
@@ -442,6 +452,8 @@ public:
         this->data(place).change_if_better(this->data(rhs), arena);
     }
 
+    bool has_fixed_length_state() const override { return Data::IS_FIXED_LENGTH; }
+
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
         this->data(place).write(buf);
     }
@@ -171,6 +171,11 @@ public:
     }
 
     bool is_state() const override { return nested_function->is_state(); }
+
+    // The flag and the nested state are copied together.
+    bool has_fixed_length_state() const override {
+        return nested_function->has_fixed_length_state();
+    }
 };
 
 /** There are two cases: for single argument and variadic.
@@ -183,11 +183,12 @@ struct OrthBitmapUnionCountData {
 
     void add(const IColumn** columns, size_t row_num) {
         const auto& column = static_cast<const ColumnBitmap&>(*columns[0]);
-        value |= column.get_data()[row_num];
+        value.lazy_or(column.get_data()[row_num]);
     }
     void merge(const OrthBitmapUnionCountData& rhs) { result += rhs.result; }
 
     void write(BufferWritable& buf) {
+        value.repair_after_lazy();
         result = value.cardinality();
         write_binary(result, buf);
     }
@@ -196,7 +197,12 @@ struct OrthBitmapUnionCountData {
 
     void get(IColumn& to) const {
         auto& column = static_cast<ColumnVector<Int64>&>(to);
-        column.get_data().emplace_back(result ? result : value.cardinality());
+        if (result) {
+            column.get_data().emplace_back(result);
+            return;
+        }
+        const_cast<BitmapValue&>(value).repair_after_lazy();
+        column.get_data().emplace_back(value.cardinality());
     }
 
 private:
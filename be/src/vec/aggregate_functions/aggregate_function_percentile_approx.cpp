@@ -18,6 +18,7 @@
 #include "vec/aggregate_functions/aggregate_function_percentile_approx.h"
 
 #include "common/logging.h"
+#include "util/string_util.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/aggregate_functions/factory_helpers.h"
 #include "vec/aggregate_functions/helpers.h"
@@ -29,15 +30,19 @@ AggregateFunctionPtr create_aggregate_function_percentile_approx(const std::stri
                                                                  const DataTypes& argument_types,
                                                                  const Array& parameters,
                                                                  const bool result_is_nullable) {
+    // the sketch of the query is passed by AggFnEvaluator as the only parameter
+    const bool use_ddsketch = !parameters.empty() &&
+                              parameters[0].get_type() == Field::Types::String &&
+                              iequal(parameters[0].get<String>(), "ddsketch");
     if (argument_types.size() == 1) {
         return std::make_shared<AggregateFunctionPercentileApproxMerge<is_nullable>>(
                 argument_types);
     } else if (argument_types.size() == 2) {
         return std::make_shared<AggregateFunctionPercentileApproxTwoParams<is_nullable>>(
-                argument_types);
+                argument_types, use_ddsketch);
     } else if (argument_types.size() == 3) {
         return std::make_shared<AggregateFunctionPercentileApproxThreeParams<is_nullable>>(
-                argument_types);
+                argument_types, use_ddsketch);
     }
     LOG(WARNING) << fmt::format("Illegal number {} of argument for aggregate function {}",
                                 argument_types.size(), name);
@@ -19,6 +19,7 @@
 
 #include "common/status.h"
 #include "util/counts.h"
+#include "util/dd_sketch.h"
 #include "util/tdigest.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/columns_number.h"
@@ -28,13 +29,21 @@
 
 namespace doris::vectorized {
 
+// The values are kept in a TDigest, or in a DDSketch when the query asks for it by the session
+// variable percentile_approx_sketch. A DDSketch adds a value in constant time and merges by
+// adding its bucket counts, instead of compressing the centroids of TDigests.
 struct PercentileApproxState {
     static constexpr double INIT_QUANTILE = -1.0;
+    // written as the compression of the states with a DDSketch, the one of a TDigest is never 0
+    static constexpr double DDSKETCH_COMPRESSION = 0;
     PercentileApproxState() = default;
     ~PercentileApproxState() = default;
 
-    void init(double compression = 10000) {
-        if (!init_flag) {
+    void init(double compression = 10000, bool use_ddsketch = false) {
+        if (!init_flag && use_ddsketch) {
+            sketch.reset(new DDSketch());
+            init_flag = true;
+        } else if (!init_flag) {
             //https://doris.apache.org/zh-CN/sql-reference/sql-functions/aggregate-functions/percentile_approx.html#description
             //The compression parameter setting range is [2048, 10000].
             //If the value of compression parameter is not specified set, or is outside the range of [2048, 10000],
@@ -55,6 +64,13 @@ struct PercentileApproxState {
         }
 
         write_binary(target_quantile, buf);
+        if (sketch != nullptr) {
+            write_binary(DDSKETCH_COMPRESSION, buf);
+            std::string result(sketch->serialized_size(), '0');
+            sketch->serialize((uint8_t*)result.data());
+            write_binary(result, buf);
+            return;
+        }
         write_binary(compressions, buf);
         uint32_t serialize_size = digest->serialized_size();
         std::string result(serialize_size, '0');
@@ -71,15 +87,24 @@ struct PercentileApproxState {
         }
 
         read_binary(target_quantile, buf);
-        read_binary(compressions, buf);
+        double compression = 0;
+        read_binary(compression, buf);
         std::string str;
         read_binary(str, buf);
+        if (compression == DDSKETCH_COMPRESSION) {
+            sketch.reset(new DDSketch());
+            sketch->unserialize((uint8_t*)str.c_str());
+            return;
+        }
+        compressions = compression;
         digest.reset(new TDigest(compressions));
         digest->unserialize((uint8_t*)str.c_str());
     }
 
     double get() const {
-        if (init_flag) {
+        if (init_flag && sketch != nullptr) {
+            return sketch->quantile(target_quantile);
+        } else if (init_flag) {
             return digest->quantile(target_quantile);
         } else {
             return std::nan("");
@@ -90,7 +115,15 @@ struct PercentileApproxState {
         if (!rhs.init_flag) {
             return;
         }
-        if (init_flag) {
+        if (rhs.sketch != nullptr) {
+            // all the states of a query keep the same kind of sketch
+            DCHECK(!init_flag || sketch != nullptr);
+            if (!init_flag) {
+                sketch.reset(new DDSketch());
+                init_flag = true;
+            }
+            sketch->merge(*rhs.sketch);
+        } else if (init_flag) {
             DCHECK(digest.get() != nullptr);
             digest->merge(rhs.digest.get());
         } else {
@@ -104,7 +137,11 @@ struct PercentileApproxState {
     }
 
     void add(double source, double quantile) {
-        digest->add(source);
+        if (sketch != nullptr) {
+            sketch->add(source);
+        } else {
+            digest->add(source);
+        }
         target_quantile = quantile;
     }
 
@@ -112,10 +149,12 @@ struct PercentileApproxState {
         target_quantile = INIT_QUANTILE;
         init_flag = false;
         digest.reset(new TDigest(compressions));
+        sketch.reset();
     }
 
     bool init_flag = false;
     std::unique_ptr<TDigest> digest = nullptr;
+    std::unique_ptr<DDSketch> sketch = nullptr;
     double target_quantile = INIT_QUANTILE;
     double compressions = 10000;
 };
@@ -124,10 +163,10 @@ class AggregateFunctionPercentileApprox
         : public IAggregateFunctionDataHelper<PercentileApproxState,
                                               AggregateFunctionPercentileApprox> {
 public:
-    AggregateFunctionPercentileApprox(const DataTypes& argument_types_)
+    AggregateFunctionPercentileApprox(const DataTypes& argument_types_, bool use_ddsketch = false)
             : IAggregateFunctionDataHelper<PercentileApproxState,
-                                           AggregateFunctionPercentileApprox>(argument_types_, {}) {
-    }
+                                           AggregateFunctionPercentileApprox>(argument_types_, {}),
+              _use_ddsketch(use_ddsketch) {}
 
     String get_name() const override { return "percentile_approx"; }
 
@@ -166,6 +205,9 @@ public:
             nullable_column.get_null_map_data().push_back(0);
         }
     }
+
+protected:
+    const bool _use_ddsketch;
 };
 
 // only for merge
@@ -183,8 +225,9 @@ public:
 template <bool is_nullable>
 class AggregateFunctionPercentileApproxTwoParams : public AggregateFunctionPercentileApprox {
 public:
-    AggregateFunctionPercentileApproxTwoParams(const DataTypes& argument_types_)
-            : AggregateFunctionPercentileApprox(argument_types_) {}
+    AggregateFunctionPercentileApproxTwoParams(const DataTypes& argument_types_,
+                                               bool use_ddsketch)
+            : AggregateFunctionPercentileApprox(argument_types_, use_ddsketch) {}
     void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
              Arena*) const override {
         if constexpr (is_nullable) {
@@ -207,14 +250,14 @@ public:
                 }
             }
 
-            this->data(place).init();
+            this->data(place).init(10000, this->_use_ddsketch);
             this->data(place).add(column_data[0], column_data[1]);
 
         } else {
             const auto& sources = static_cast<const ColumnVector<Float64>&>(*columns[0]);
             const auto& quantile = static_cast<const ColumnVector<Float64>&>(*columns[1]);
 
-            this->data(place).init();
+            this->data(place).init(10000, this->_use_ddsketch);
             this->data(place).add(sources.get_float64(row_num), quantile.get_float64(row_num));
         }
     }
@@ -223,8 +266,9 @@ public:
 template <bool is_nullable>
 class AggregateFunctionPercentileApproxThreeParams : public AggregateFunctionPercentileApprox {
 public:
-    AggregateFunctionPercentileApproxThreeParams(const DataTypes& argument_types_)
-            : AggregateFunctionPercentileApprox(argument_types_) {}
+    AggregateFunctionPercentileApproxThreeParams(const DataTypes& argument_types_,
+                                                 bool use_ddsketch)
+            : AggregateFunctionPercentileApprox(argument_types_, use_ddsketch) {}
     void add(AggregateDataPtr __restrict place, const IColumn** columns, size_t row_num,
              Arena*) const override {
         if constexpr (is_nullable) {
@@ -247,7 +291,7 @@ public:
                 }
             }
 
-            this->data(place).init(column_data[2]);
+            this->data(place).init(column_data[2], this->_use_ddsketch);
             this->data(place).add(column_data[0], column_data[1]);
 
         } else {
@@ -255,7 +299,7 @@ public:
             const auto& quantile = static_cast<const ColumnVector<Float64>&>(*columns[1]);
             const auto& compression = static_cast<const ColumnVector<Float64>&>(*columns[2]);
 
-            this->data(place).init(compression.get_float64(row_num));
+            this->data(place).init(compression.get_float64(row_num), this->_use_ddsketch);
             this->data(place).add(sources.get_float64(row_num), quantile.get_float64(row_num));
         }
     }
@@ -80,6 +80,25 @@ public:
         this->data(place).add(column.get_data()[row_num]);
     }
 
+    void add_batch_grouped(size_t batch_size, const UInt32* group_ids, size_t num_groups,
+                           const AggregateDataPtr* group_places, size_t place_offset,
+                           const IColumn** columns, Arena* arena) const override {
+        if (num_groups > IAggregateFunction::MAX_DENSE_GROUPS) {
+            IAggregateFunctionDataHelper<Data, AggregateFunctionSum<T, TResult, Data>>::
+                    add_batch_grouped(batch_size, group_ids, num_groups, group_places,
+                                      place_offset, columns, arena);
+            return;
+        }
+        const auto* values = static_cast<const ColVecType&>(*columns[0]).get_data().data();
+        Data partials[IAggregateFunction::MAX_DENSE_GROUPS];
+        for (size_t i = 0; i < batch_size; ++i) {
+            partials[group_ids[i]].add(values[i]);
+        }
+        for (size_t g = 0; g < num_groups; ++g) {
+            this->data(group_places[g] + place_offset).merge(partials[g]);
+        }
+    }
+
     void reset(AggregateDataPtr place) const override { this->data(place).sum = {}; }
 
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs,
@@ -87,6 +106,8 @@ public:
         this->data(place).merge(this->data(rhs));
     }
 
+    bool has_fixed_length_state() const override { return true; }
+
     void serialize(ConstAggregateDataPtr __restrict place, BufferWritable& buf) const override {
         this->data(place).write(buf);
     }
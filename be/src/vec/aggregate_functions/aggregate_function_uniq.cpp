@@ -20,7 +20,11 @@
 
 #include "vec/aggregate_functions/aggregate_function_uniq.h"
 
+#include <thread>
+
+#include "common/config.h"
 #include "common/logging.h"
+#include "runtime/thread_context.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/aggregate_functions/factory_helpers.h"
 #include "vec/aggregate_functions/helpers.h"
@@ -28,6 +32,35 @@
 
 namespace doris::vectorized {
 
+namespace detail {
+void merge_partitions_in_parallel(size_t partition_count,
+                                  const std::function<void(size_t)>& merge_partition) {
+    const size_t thread_num = std::min<size_t>(
+            std::max(config::uniq_exact_merge_thread_num, 1), partition_count);
+    auto* mem_tracker = thread_context()->_thread_mem_tracker_mgr->limiter_mem_tracker();
+    if (thread_num == 1 || mem_tracker == nullptr) {
+        for (size_t p = 0; p < partition_count; ++p) {
+            merge_partition(p);
+        }
+        return;
+    }
+    // the partitions never share keys, so every thread merges its own ones
+    std::vector<std::thread> threads;
+    threads.reserve(thread_num);
+    for (size_t t = 0; t < thread_num; ++t) {
+        threads.emplace_back([&, t]() {
+            SCOPED_ATTACH_TASK(mem_tracker, ThreadContext::TaskType::QUERY);
+            for (size_t p = t; p < partition_count; p += thread_num) {
+                merge_partition(p);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+} // namespace detail
+
 template <template <typename> class Data, typename DataForVariadic>
 AggregateFunctionPtr create_aggregate_function_uniq(const std::string& name,
                                                     const DataTypes& argument_types,
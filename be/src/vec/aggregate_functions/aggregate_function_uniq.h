@@ -24,6 +24,7 @@
 
 #include "gutil/hash/city.h"
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/aggregate_functions/uniq_exact_set.h"
 #include "vec/columns/column_decimal.h"
 #include "vec/common/aggregation_common.h"
 #include "vec/common/assert_cast.h"
@@ -41,8 +42,9 @@ struct AggregateFunctionUniqExactData {
     using Key = T;
 
     /// When creating, the hash table must be small.
-    using Set = HashSet<Key, HashCRC32<Key>, HashTableGrower<4>,
-                        HashTableAllocatorWithStackMemory<sizeof(Key) * (1 << 4)>>;
+    using Set = UniqExactSet<Key, HashCRC32<Key>,
+                             HashSet<Key, HashCRC32<Key>, HashTableGrower<4>,
+                                     HashTableAllocatorWithStackMemory<sizeof(Key) * (1 << 4)>>>;
 
     Set set;
 
@@ -55,8 +57,9 @@ struct AggregateFunctionUniqExactData<String> {
     using Key = UInt128;
 
     /// When creating, the hash table must be small.
-    using Set = HashSet<Key, UInt128TrivialHash, HashTableGrower<3>,
-                        HashTableAllocatorWithStackMemory<sizeof(Key) * (1 << 3)>>;
+    using Set = UniqExactSet<Key, UInt128TrivialHash,
+                             HashSet<Key, UInt128TrivialHash, HashTableGrower<3>,
+                                     HashTableAllocatorWithStackMemory<sizeof(Key) * (1 << 3)>>>;
 
     Set set;
 
@@ -0,0 +1,272 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "vec/common/exception.h"
+#include "vec/common/hash_table/hash_set.h"
+#include "vec/io/io_helper.h"
+#include "vec/io/var_int.h"
+
+namespace doris::vectorized {
+
+namespace detail {
+// Calls merge_partition(p) for every partition p of [0, partition_count), on up to
+// config::uniq_exact_merge_thread_num threads tracked by the memory tracker of the caller.
+void merge_partitions_in_parallel(size_t partition_count,
+                                  const std::function<void(size_t)>& merge_partition);
+} // namespace detail
+
+/** The exact set of the distinct keys of a group. It starts as a single small hash set `Single`,
+  * and once it's big it becomes PARTITION_COUNT hash sets partitioned by the high bits of the
+  * hash of the keys, like the two level hash tables of the aggregation. Two big sets are merged
+  * partition by partition, each of which fits the cache better than the whole set, and on several
+  * threads when they are very big.
+  *
+  * The serialized set has no cells: it's the number of keys and the keys, and the integers of up
+  * to 64 bits are written sorted as the var ints of the deltas between them, which takes a byte or
+  * two per key for the dense ids and dates that count distinct usually sees. It starts with
+  * FORMAT_MARKER and the format version. The sets written before had no marker: they were the
+  * var int of the number of keys and the raw keys, like a HashSet, and they are still read.
+  */
+template <typename Key, typename Hash, typename Single>
+class UniqExactSet {
+public:
+    using Partition = HashSet<Key, Hash>;
+
+    static constexpr size_t PARTITION_BITS = 8;
+    static constexpr size_t PARTITION_COUNT = 1ULL << PARTITION_BITS;
+    // the size from which the single set is split into partitions
+    static constexpr size_t PARTITION_THRESHOLD = 1ULL << 16;
+    // the size of a set from which it is merged into another one on several threads
+    static constexpr size_t PARALLEL_MERGE_THRESHOLD = 1ULL << 20;
+    // the var int of 0 with a continuation byte, which no var int written by write_var_uint
+    // starts with, so it tells the versioned format from the legacy one
+    static constexpr uint8_t FORMAT_MARKER[2] = {0x80, 0x00};
+    static constexpr uint8_t FORMAT_V1 = 1;
+
+    void ALWAYS_INLINE insert(const Key& key) {
+        if (is_partitioned()) {
+            _insert_into_partition(key, _single.hash(key));
+        } else {
+            _single.insert(key);
+            if (UNLIKELY(_single.size() > PARTITION_THRESHOLD)) {
+                _convert_to_partitioned();
+            }
+        }
+    }
+
+    void merge(const UniqExactSet& rhs) {
+        if (!rhs.is_partitioned()) {
+            if (is_partitioned()) {
+                for (const auto& elem : rhs._single) {
+                    insert(elem.get_value());
+                }
+            } else {
+                _single.merge(rhs._single);
+                if (_single.size() > PARTITION_THRESHOLD) {
+                    _convert_to_partitioned();
+                }
+            }
+            return;
+        }
+        if (!is_partitioned()) {
+            _convert_to_partitioned();
+        }
+        auto merge_partition = [&](size_t p) { _partitions[p].merge(rhs._partitions[p]); };
+        if (rhs.size() >= PARALLEL_MERGE_THRESHOLD) {
+            detail::merge_partitions_in_parallel(PARTITION_COUNT, merge_partition);
+        } else {
+            for (size_t p = 0; p < PARTITION_COUNT; ++p) {
+                merge_partition(p);
+            }
+        }
+    }
+
+    bool is_partitioned() const { return !_partitions.empty(); }
+
+    size_t size() const {
+        if (!is_partitioned()) {
+            return _single.size();
+        }
+        size_t size = 0;
+        for (const auto& partition : _partitions) {
+            size += partition.size();
+        }
+        return size;
+    }
+
+    template <typename Func>
+    void for_each(Func&& func) const {
+        if (!is_partitioned()) {
+            for (const auto& elem : _single) {
+                func(elem.get_value());
+            }
+            return;
+        }
+        for (const auto& partition : _partitions) {
+            for (const auto& elem : partition) {
+                func(elem.get_value());
+            }
+        }
+    }
+
+    void write(BufferWritable& buf) const {
+        buf.write(reinterpret_cast<const char*>(FORMAT_MARKER), sizeof(FORMAT_MARKER));
+        write_pod_binary(FORMAT_V1, buf);
+        write_var_uint(size(), buf);
+        if constexpr (is_delta_encoded) {
+            using UnsignedKey = std::make_unsigned_t<Key>;
+            std::vector<UnsignedKey> keys;
+            keys.reserve(size());
+            for_each([&](const Key& key) { keys.push_back(_to_ordered(key)); });
+            std::sort(keys.begin(), keys.end());
+            UnsignedKey previous = 0;
+            for (auto key : keys) {
+                write_var_uint(key - previous, buf);
+                previous = key;
+            }
+        } else {
+            for_each([&](const Key& key) { write_pod_binary(key, buf); });
+        }
+    }
+
+    void read(BufferReadable& buf) {
+        bool legacy = false;
+        UInt64 size = _read_header(buf, &legacy);
+        if (!is_partitioned() && _single.size() + size > PARTITION_THRESHOLD) {
+            _convert_to_partitioned();
+        }
+        if (is_partitioned()) {
+            for (auto& partition : _partitions) {
+                partition.expanse_for_add_elem(size / PARTITION_COUNT);
+            }
+        }
+        if (legacy) {
+            for (size_t i = 0; i < size; ++i) {
+                Key key;
+                read_binary(key, buf);
+                insert(key);
+            }
+        } else if constexpr (is_delta_encoded) {
+            using UnsignedKey = std::make_unsigned_t<Key>;
+            UnsignedKey key = 0;
+            for (size_t i = 0; i < size; ++i) {
+                UInt64 delta = 0;
+                read_var_uint(delta, buf);
+                key += static_cast<UnsignedKey>(delta);
+                insert(_from_ordered(key));
+            }
+        } else {
+            for (size_t i = 0; i < size; ++i) {
+                Key key;
+                read_pod_binary(key, buf);
+                insert(key);
+            }
+        }
+    }
+
+private:
+    // Returns the number of keys. Sets 'legacy' if the set has the format without a marker.
+    static UInt64 _read_header(BufferReadable& buf, bool* legacy) {
+        uint8_t byte = 0;
+        read_pod_binary(byte, buf);
+        UInt64 size = byte & 0x7F;
+        if (byte & 0x80) {
+            uint8_t next = 0;
+            read_pod_binary(next, buf);
+            if (byte == FORMAT_MARKER[0] && next == FORMAT_MARKER[1]) {
+                uint8_t version = 0;
+                read_pod_binary(version, buf);
+                if (version != FORMAT_V1) {
+                    throw Exception(fmt::format("Unknown exact distinct set format {}", version),
+                                    TStatusCode::VEC_EXCEPTION);
+                }
+                size = 0;
+                read_var_uint(size, buf);
+                *legacy = false;
+                return size;
+            }
+            // the rest of the legacy var int of the count
+            byte = next;
+            for (size_t shift = 7;; shift += 7) {
+                size |= UInt64(byte & 0x7F) << shift;
+                if (!(byte & 0x80) || shift >= 63) {
+                    break;
+                }
+                read_pod_binary(byte, buf);
+            }
+        }
+        *legacy = true;
+        return size;
+    }
+
+    static constexpr bool is_delta_encoded =
+            std::is_integral_v<Key> && !std::is_same_v<Key, bool> && sizeof(Key) <= 8;
+
+    // maps the signed keys to unsigned ones of the same order, so the sorted deltas are small
+    template <typename T = Key>
+    static std::make_unsigned_t<T> _to_ordered(T key) {
+        using UnsignedKey = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T>) {
+            return static_cast<UnsignedKey>(key) ^ (UnsignedKey(1) << (sizeof(T) * 8 - 1));
+        } else {
+            return key;
+        }
+    }
+
+    template <typename T = Key>
+    static T _from_ordered(std::make_unsigned_t<T> key) {
+        using UnsignedKey = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T>) {
+            return static_cast<T>(key ^ (UnsignedKey(1) << (sizeof(T) * 8 - 1)));
+        } else {
+            return key;
+        }
+    }
+
+    void ALWAYS_INLINE _insert_into_partition(const Key& key, size_t hash_value) {
+        typename Partition::LookupResult it;
+        bool inserted;
+        _partitions[(hash_value >> (32 - PARTITION_BITS)) & (PARTITION_COUNT - 1)].emplace(
+                key, it, inserted, hash_value);
+    }
+
+    void _convert_to_partitioned() {
+        _partitions.resize(PARTITION_COUNT);
+        for (auto& partition : _partitions) {
+            partition.expanse_for_add_elem(_single.size() / PARTITION_COUNT);
+        }
+        for (const auto& elem : _single) {
+            _insert_into_partition(elem.get_value(), _single.hash(elem.get_value()));
+        }
+        _single.clear_and_shrink();
+    }
+
+    Single _single;
+    std::vector<Partition> _partitions;
+};
+
+} // namespace doris::vectorized
@@ -201,6 +201,20 @@ public:
         LOG(FATAL) << "Method insert_many_binary_data is not supported for " << get_name();
     }
 
+    /// Same as insert_many_binary_data for `num` values stored one after the other in `data`, the
+    /// i-th one in [offsets[i], offsets[i + 1]), like in a plain binary page. The columns can
+    /// compute their own offsets in place and copy the values in larger pieces.
+    virtual void insert_many_continuous_binary_data(const char* data, const uint32_t* offsets,
+                                                    size_t num) {
+        std::vector<uint32_t> len_array(num);
+        std::vector<uint32_t> start_offset_array(offsets, offsets + num);
+        for (size_t i = 0; i < num; i++) {
+            len_array[i] = offsets[i + 1] - offsets[i];
+        }
+        insert_many_binary_data(const_cast<char*>(data), len_array.data(),
+                                start_offset_array.data(), num);
+    }
+
     virtual void insert_many_strings(const StringRef* strings, size_t num) {
         LOG(FATAL) << "Method insert_many_binary_data is not supported for " << get_name();
     }
@@ -22,6 +22,7 @@
 
 #include "common/config.h"
 #include "util/simd/bits.h"
+#include "vec/columns/columns_common.h"
 #include "vec/common/arena.h"
 #include "vec/common/assert_cast.h"
 #include "vec/common/exception.h"
@@ -222,6 +223,14 @@ ColumnPtr ColumnDecimal<T>::filter(const IColumn::Filter& filt, ssize_t result_s
     auto res = this->create(0, scale);
     Container& res_data = res->get_data();
 
+    if constexpr (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+        if (is_compress_filter_supported()) {
+            res_data.resize(size);
+            res_data.resize(compress_filter(data.data(), filt.data(), size, res_data.data()));
+            return res;
+        }
+    }
+
     if (result_size_hint) res_data.reserve(result_size_hint > 0 ? result_size_hint : size);
 
     const UInt8* filt_pos = filt.data();
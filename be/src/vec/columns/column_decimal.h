@@ -100,6 +100,10 @@ public:
         data.push_back(static_cast<const Self&>(src).get_data()[n]);
     }
 
+    void insert_many_from(const IColumn& src, size_t position, size_t length) override {
+        data.resize_fill(data.size() + length, static_cast<const Self&>(src).get_data()[position]);
+    }
+
     void insert_indices_from(const IColumn& src, const int* indices_begin,
                              const int* indices_end) override {
         const Self& src_vec = assert_cast<const Self&>(src);
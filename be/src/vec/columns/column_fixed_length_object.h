@@ -0,0 +1,271 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "vec/columns/column.h"
+#include "vec/columns/column_impl.h"
+#include "vec/common/arena.h"
+#include "vec/common/assert_cast.h"
+#include "vec/common/pod_array.h"
+#include "vec/common/sip_hash.h"
+
+namespace doris::vectorized {
+
+// A column of the values of the same size that are copied as raw bytes, like the fixed-width
+// states of the aggregate functions passed from the pre-aggregation to the merge phase.
+class ColumnFixedLengthObject final : public COWHelper<IColumn, ColumnFixedLengthObject> {
+private:
+    friend class COWHelper<IColumn, ColumnFixedLengthObject>;
+
+    explicit ColumnFixedLengthObject(size_t item_size) : _item_size(item_size) {}
+
+    ColumnFixedLengthObject(const ColumnFixedLengthObject& src)
+            : _item_size(src._item_size),
+              _item_count(src._item_count),
+              _data(src._data.begin(), src._data.end()) {}
+
+public:
+    using Self = ColumnFixedLengthObject;
+    using Container = PaddedPODArray<char>;
+
+    const char* get_family_name() const override { return "ColumnFixedLengthObject"; }
+
+    size_t item_size() const { return _item_size; }
+
+    // The item size of a column deserialized from a block is only known from the data.
+    void set_item_size(size_t item_size) {
+        DCHECK(_item_count == 0 || _item_size == item_size);
+        _item_size = item_size;
+    }
+
+    size_t size() const override { return _item_count; }
+
+    Container& get_data() { return _data; }
+
+    const Container& get_data() const { return _data; }
+
+    StringRef get_data_at(size_t n) const override {
+        return StringRef(&_data[n * _item_size], _item_size);
+    }
+
+    void insert_data(const char* pos, size_t length) override {
+        DCHECK_EQ(length, _item_size);
+        size_t old_size = _data.size();
+        _data.resize(old_size + _item_size);
+        memcpy(&_data[old_size], pos, _item_size);
+        ++_item_count;
+    }
+
+    void insert_from(const IColumn& src, size_t n) override {
+        insert_data(assert_cast<const Self&>(src).get_data_at(n).data, _item_size);
+    }
+
+    void insert_range_from(const IColumn& src, size_t start, size_t length) override {
+        const auto& src_col = assert_cast<const Self&>(src);
+        DCHECK_EQ(src_col._item_size, _item_size);
+        if (length == 0) {
+            return;
+        }
+        size_t old_size = _data.size();
+        _data.resize(old_size + length * _item_size);
+        memcpy(&_data[old_size], &src_col._data[start * _item_size], length * _item_size);
+        _item_count += length;
+    }
+
+    void insert_indices_from(const IColumn& src, const int* indices_begin,
+                             const int* indices_end) override {
+        const auto& src_col = assert_cast<const Self&>(src);
+        for (const int* x = indices_begin; x != indices_end; ++x) {
+            if (*x == -1) {
+                insert_default();
+            } else {
+                insert_data(&src_col._data[*x * _item_size], _item_size);
+            }
+        }
+    }
+
+    void insert_default() override {
+        _data.resize_fill(_data.size() + _item_size, 0);
+        ++_item_count;
+    }
+
+    void insert_many_defaults(size_t length) override {
+        _data.resize_fill(_data.size() + length * _item_size, 0);
+        _item_count += length;
+    }
+
+    void pop_back(size_t n) override {
+        DCHECK_LE(n, _item_count);
+        _data.resize(_data.size() - n * _item_size);
+        _item_count -= n;
+    }
+
+    void clear() override {
+        _data.clear();
+        _item_count = 0;
+    }
+
+    void reserve(size_t n) override { _data.reserve(n * _item_size); }
+
+    void resize(size_t n) override {
+        _data.resize_fill(n * _item_size, 0);
+        _item_count = n;
+    }
+
+    size_t byte_size() const override { return _data.size(); }
+
+    size_t allocated_bytes() const override { return _data.allocated_bytes(); }
+
+    void protect() override { _data.protect(); }
+
+    MutableColumnPtr clone_resized(size_t size) const override {
+        auto res = Self::create(_item_size);
+        size_t count = std::min(size, _item_count);
+        if (count > 0) {
+            res->insert_range_from(*this, 0, count);
+        }
+        if (size > count) {
+            res->insert_many_defaults(size - count);
+        }
+        return res;
+    }
+
+    [[noreturn]] void insert(const Field& x) override {
+        LOG(FATAL) << "insert field not implemented";
+    }
+
+    [[noreturn]] Field operator[](size_t n) const override {
+        LOG(FATAL) << "operator[] not implemented";
+    }
+
+    [[noreturn]] void get(size_t n, Field& res) const override {
+        LOG(FATAL) << "get field not implemented";
+    }
+
+    StringRef serialize_value_into_arena(size_t n, Arena& arena,
+                                         char const*& begin) const override {
+        char* pos = arena.alloc_continue(_item_size, begin);
+        memcpy(pos, &_data[n * _item_size], _item_size);
+        return StringRef(pos, _item_size);
+    }
+
+    const char* deserialize_and_insert_from_arena(const char* pos) override {
+        insert_data(pos, _item_size);
+        return pos + _item_size;
+    }
+
+    void update_hash_with_value(size_t n, SipHash& hash) const override {
+        hash.update(&_data[n * _item_size], _item_size);
+    }
+
+    ColumnPtr filter(const IColumn::Filter& filt, ssize_t result_size_hint) const override {
+        DCHECK_EQ(filt.size(), _item_count);
+        auto res = Self::create(_item_size);
+        if (result_size_hint > 0) {
+            res->reserve(result_size_hint);
+        }
+        for (size_t i = 0; i < _item_count; ++i) {
+            if (filt[i]) {
+                res->insert_data(&_data[i * _item_size], _item_size);
+            }
+        }
+        return res;
+    }
+
+    ColumnPtr permute(const IColumn::Permutation& perm, size_t limit) const override {
+        limit = limit == 0 ? _item_count : std::min(_item_count, limit);
+        DCHECK_GE(perm.size(), limit);
+        auto res = Self::create(_item_size);
+        res->reserve(limit);
+        for (size_t i = 0; i < limit; ++i) {
+            res->insert_data(&_data[perm[i] * _item_size], _item_size);
+        }
+        return res;
+    }
+
+    [[noreturn]] int compare_at(size_t n, size_t m, const IColumn& rhs,
+                                int nan_direction_hint) const override {
+        LOG(FATAL) << "compare_at not implemented";
+    }
+
+    [[noreturn]] void get_permutation(bool reverse, size_t limit, int nan_direction_hint,
+                                      IColumn::Permutation& res) const override {
+        LOG(FATAL) << "get_permutation not implemented";
+    }
+
+    ColumnPtr replicate(const IColumn::Offsets& offsets) const override {
+        DCHECK_EQ(offsets.size(), _item_count);
+        auto res = Self::create(_item_size);
+        if (_item_count == 0) {
+            return res;
+        }
+        res->reserve(offsets.back());
+        IColumn::Offset prev_offset = 0;
+        for (size_t i = 0; i < _item_count; ++i) {
+            for (size_t j = prev_offset; j < offsets[i]; ++j) {
+                res->insert_data(&_data[i * _item_size], _item_size);
+            }
+            prev_offset = offsets[i];
+        }
+        return res;
+    }
+
+    void replicate(const uint32_t* counts, size_t target_size, IColumn& column) const override {
+        auto& res = assert_cast<Self&>(column);
+        res.reserve(target_size);
+        for (size_t i = 0; i < _item_count; ++i) {
+            for (size_t j = 0; j < counts[i]; ++j) {
+                res.insert_data(&_data[i * _item_size], _item_size);
+            }
+        }
+    }
+
+    MutableColumns scatter(IColumn::ColumnIndex num_columns,
+                           const IColumn::Selector& selector) const override {
+        return this->template scatter_impl<Self>(num_columns, selector);
+    }
+
+    void get_extremes(Field& min, Field& max) const override {
+        LOG(FATAL) << "get_extremes not implemented";
+    }
+
+    bool can_be_inside_nullable() const override { return true; }
+
+    bool structure_equals(const IColumn& rhs) const override {
+        return typeid(rhs) == typeid(Self) &&
+               assert_cast<const Self&>(rhs)._item_size == _item_size;
+    }
+
+    void replace_column_data(const IColumn& rhs, size_t row, size_t self_row = 0) override {
+        DCHECK(size() > self_row);
+        memcpy(&_data[self_row * _item_size], assert_cast<const Self&>(rhs).get_data_at(row).data,
+               _item_size);
+    }
+
+    void replace_column_data_default(size_t self_row = 0) override {
+        DCHECK(size() > self_row);
+        memset(&_data[self_row * _item_size], 0, _item_size);
+    }
+
+private:
+    size_t _item_size;
+    size_t _item_count = 0;
+    Container _data;
+};
+
+} // namespace doris::vectorized
@@ -204,6 +204,13 @@ void ColumnNullable::insert_from(const IColumn& src, size_t n) {
     get_null_map_data().push_back(src_concrete.get_null_map_data()[n]);
 }
 
+void ColumnNullable::insert_many_from(const IColumn& src, size_t position, size_t length) {
+    const ColumnNullable& src_concrete = assert_cast<const ColumnNullable&>(src);
+    get_nested_column().insert_many_from(src_concrete.get_nested_column(), position, length);
+    get_null_map_data().resize_fill(get_null_map_data().size() + length,
+                                    src_concrete.get_null_map_data()[position]);
+}
+
 void ColumnNullable::insert_from_not_nullable(const IColumn& src, size_t n) {
     get_nested_column().insert_from(src, n);
     get_null_map_data().push_back(0);
@@ -217,9 +224,8 @@ void ColumnNullable::insert_range_from_not_nullable(const IColumn& src, size_t s
 
 void ColumnNullable::insert_many_from_not_nullable(const IColumn& src, size_t position,
                                                    size_t length) {
-    for (size_t i = 0; i < length; ++i) {
-        insert_from_not_nullable(src, position);
-    }
+    get_nested_column().insert_many_from(src, position, length);
+    get_null_map_data().resize_fill(get_null_map_data().size() + length, 0);
 }
 
 void ColumnNullable::pop_back(size_t n) {
@@ -227,8 +233,13 @@ void ColumnNullable::pop_back(size_t n) {
     get_null_map_column().pop_back(n);
 }
 
+// The columns without nulls, which are most of the nullable columns, skip filtering, permuting
+// or replicating their null map: the result null map is zeros of the size of the nested result.
 ColumnPtr ColumnNullable::filter(const Filter& filt, ssize_t result_size_hint) const {
     ColumnPtr filtered_data = get_nested_column().filter(filt, result_size_hint);
+    if (!has_null()) {
+        return ColumnNullable::create(filtered_data, ColumnUInt8::create(filtered_data->size(), 0));
+    }
     ColumnPtr filtered_null_map = get_null_map_column().filter(filt, result_size_hint);
     return ColumnNullable::create(filtered_data, filtered_null_map);
 }
@@ -239,6 +250,10 @@ Status ColumnNullable::filter_by_selector(const uint16_t* sel, size_t sel_size,
     ColumnPtr null_map_ptr = nullable_col_ptr->null_map;
     RETURN_IF_ERROR(get_nested_column().filter_by_selector(
             sel, sel_size, const_cast<doris::vectorized::IColumn*>(nest_col_ptr.get())));
+    if (!has_null()) {
+        const_cast<doris::vectorized::IColumn*>(null_map_ptr.get())->insert_many_defaults(sel_size);
+        return Status::OK();
+    }
     RETURN_IF_ERROR(get_null_map_column().filter_by_selector(
             sel, sel_size, const_cast<doris::vectorized::IColumn*>(null_map_ptr.get())));
     return Status::OK();
@@ -246,6 +261,9 @@ Status ColumnNullable::filter_by_selector(const uint16_t* sel, size_t sel_size,
 
 ColumnPtr ColumnNullable::permute(const Permutation& perm, size_t limit) const {
     ColumnPtr permuted_data = get_nested_column().permute(perm, limit);
+    if (!has_null()) {
+        return ColumnNullable::create(permuted_data, ColumnUInt8::create(permuted_data->size(), 0));
+    }
     ColumnPtr permuted_null_map = get_null_map_column().permute(perm, limit);
     return ColumnNullable::create(permuted_data, permuted_null_map);
 }
@@ -450,6 +468,10 @@ void ColumnNullable::get_extremes(Field& min, Field& max) const {
 
 ColumnPtr ColumnNullable::replicate(const Offsets& offsets) const {
     ColumnPtr replicated_data = get_nested_column().replicate(offsets);
+    if (!has_null()) {
+        return ColumnNullable::create(replicated_data,
+                                      ColumnUInt8::create(replicated_data->size(), 0));
+    }
     ColumnPtr replicated_null_map = get_null_map_column().replicate(offsets);
     return ColumnNullable::create(replicated_data, replicated_null_map);
 }
@@ -457,6 +479,10 @@ ColumnPtr ColumnNullable::replicate(const Offsets& offsets) const {
 void ColumnNullable::replicate(const uint32_t* counts, size_t target_size, IColumn& column) const {
     auto& res = reinterpret_cast<ColumnNullable&>(column);
     get_nested_column().replicate(counts, target_size, res.get_nested_column());
+    if (!has_null()) {
+        res.get_null_map_column().insert_many_defaults(target_size);
+        return;
+    }
     get_null_map_column().replicate(counts, target_size, res.get_null_map_column());
 }
 
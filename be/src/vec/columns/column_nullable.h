@@ -100,6 +100,7 @@ public:
                              const int* indices_end) override;
     void insert(const Field& x) override;
     void insert_from(const IColumn& src, size_t n) override;
+    void insert_many_from(const IColumn& src, size_t position, size_t length) override;
 
     void insert_from_not_nullable(const IColumn& src, size_t n);
     void insert_range_from_not_nullable(const IColumn& src, size_t start, size_t length);
@@ -128,6 +129,12 @@ public:
         get_nested_column().insert_many_binary_data(data_array, len_array, start_offset_array, num);
     }
 
+    void insert_many_continuous_binary_data(const char* data, const uint32_t* offsets,
+                                            size_t num) override {
+        get_null_map_column().fill(0, num);
+        get_nested_column().insert_many_continuous_binary_data(data, offsets, num);
+    }
+
     void insert_default() override {
         get_nested_column().insert_default();
         get_null_map_data().push_back(1);
@@ -180,6 +180,28 @@ public:
         }
     };
 
+    void insert_many_continuous_binary_data(const char* data, const uint32_t* value_offsets,
+                                            size_t num) override {
+        if (num == 0) {
+            return;
+        }
+        const size_t old_size = chars.size();
+        const size_t old_rows = offsets.size();
+        chars.resize(old_size + value_offsets[num] - value_offsets[0] + num);
+        offsets.resize(old_rows + num);
+
+        Char* res_data = chars.data();
+        Offset* res_offsets = offsets.data() + old_rows;
+        size_t offset = old_size;
+        for (size_t i = 0; i < num; i++) {
+            const uint32_t len = value_offsets[i + 1] - value_offsets[i];
+            if (len) memcpy(res_data + offset, data + value_offsets[i], len);
+            res_data[offset + len] = 0;
+            offset += len + 1;
+            res_offsets[i] = offset;
+        }
+    }
+
     void insert_many_strings(const StringRef* strings, size_t num) override {
         size_t new_size = 0;
         for (size_t i = 0; i < num; i++) {
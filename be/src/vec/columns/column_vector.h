@@ -156,6 +156,10 @@ public:
         data.push_back(static_cast<const Self&>(src).get_data()[n]);
     }
 
+    void insert_many_from(const IColumn& src, size_t position, size_t length) override {
+        data.resize_fill(data.size() + length, static_cast<const Self&>(src).get_data()[position]);
+    }
+
     void insert_data(const char* pos, size_t /*length*/) override {
         data.push_back(unaligned_load<T>(pos));
     }
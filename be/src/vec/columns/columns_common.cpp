@@ -18,13 +18,16 @@
 // https://github.com/ClickHouse/ClickHouse/blob/master/src/Columns/ColumnsCommon.cpp
 // and modified by Doris
 
-#if defined(__SSE2__)
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
 #include <emmintrin.h>
 #endif
 #if defined(__aarch64__)
 #include <sse2neon.h>
 #endif
 
+#include "util/cpu_info.h"
 #include "util/simd/bits.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_vector.h"
@@ -33,7 +36,188 @@
 
 namespace doris::vectorized {
 
+#if defined(__x86_64__)
+namespace {
+
+#define AVX512_COMPRESS_TARGET __attribute__((target("avx512f,avx512bw,avx512vbmi2")))
+
+AVX512_COMPRESS_TARGET uint64_t bytes64_mask_to_bits64_mask_avx512(const UInt8* data) {
+    return _mm512_cmpgt_epi8_mask(_mm512_loadu_si512(data), _mm512_setzero_si512());
+}
+
+AVX512_COMPRESS_TARGET size_t count_bytes_in_filter_avx512(const UInt8* filt, size_t size) {
+    size_t count = 0;
+    size_t pos = 0;
+    for (; pos + 64 <= size; pos += 64) {
+        count += __builtin_popcountll(bytes64_mask_to_bits64_mask_avx512(filt + pos));
+    }
+    for (; pos < size; ++pos) {
+        count += static_cast<Int8>(filt[pos]) > 0;
+    }
+    return count;
+}
+
+/// Each 64 bytes of the filter select among 64 values, that are compressed in 64 / sizeof(T)
+/// lanes at a time and stored one after the other.
+template <typename T>
+AVX512_COMPRESS_TARGET size_t compress_filter_avx512(const T* __restrict data,
+                                                     const UInt8* __restrict filt, size_t size,
+                                                     T* __restrict res) {
+    constexpr size_t LANES = 64 / sizeof(T);
+    constexpr uint64_t LANES_MASK = LANES == 64 ? ~0ULL : (1ULL << LANES) - 1;
+    size_t count = 0;
+    size_t pos = 0;
+    for (; pos + 64 <= size; pos += 64) {
+        uint64_t mask = bytes64_mask_to_bits64_mask_avx512(filt + pos);
+        if (mask == 0) {
+            continue;
+        }
+        for (size_t i = 0; i < 64; i += LANES) {
+            uint64_t lanes = (mask >> i) & LANES_MASK;
+            __m512i values = _mm512_loadu_si512(data + pos + i);
+            if constexpr (sizeof(T) == 1) {
+                _mm512_mask_compressstoreu_epi8(res + count, lanes, values);
+            } else if constexpr (sizeof(T) == 2) {
+                _mm512_mask_compressstoreu_epi16(res + count, static_cast<__mmask32>(lanes),
+                                                 values);
+            } else if constexpr (sizeof(T) == 4) {
+                _mm512_mask_compressstoreu_epi32(res + count, static_cast<__mmask16>(lanes),
+                                                 values);
+            } else {
+                _mm512_mask_compressstoreu_epi64(res + count, static_cast<__mmask8>(lanes),
+                                                 values);
+            }
+            count += __builtin_popcountll(lanes);
+        }
+    }
+    for (; pos < size; ++pos) {
+        res[count] = data[pos];
+        count += static_cast<Int8>(filt[pos]) > 0;
+    }
+    return count;
+}
+
+AVX512_COMPRESS_TARGET uint16_t filter_to_selection_avx512(const UInt8* filt, uint16_t size,
+                                                           uint16_t* sel) {
+    alignas(64) static constexpr uint16_t FIRST_POSITIONS[32] = {
+            0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15,
+            16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31};
+    const __m512i step = _mm512_set1_epi16(32);
+    __m512i positions = _mm512_load_si512(FIRST_POSITIONS);
+    uint16_t count = 0;
+    uint32_t pos = 0;
+    for (; pos + 64 <= size; pos += 64) {
+        uint64_t mask = bytes64_mask_to_bits64_mask_avx512(filt + pos);
+        auto low = static_cast<__mmask32>(mask);
+        auto high = static_cast<__mmask32>(mask >> 32);
+        _mm512_mask_compressstoreu_epi16(sel + count, low, positions);
+        count += __builtin_popcount(low);
+        positions = _mm512_add_epi16(positions, step);
+        _mm512_mask_compressstoreu_epi16(sel + count, high, positions);
+        count += __builtin_popcount(high);
+        positions = _mm512_add_epi16(positions, step);
+    }
+    for (; pos < size; ++pos) {
+        sel[count] = pos;
+        count += static_cast<Int8>(filt[pos]) > 0;
+    }
+    return count;
+}
+
+#undef AVX512_COMPRESS_TARGET
+
+} // namespace
+#endif
+
+bool is_compress_filter_supported() {
+#if defined(__x86_64__)
+    return CpuInfo::is_supported(CpuInfo::AVX512F) && CpuInfo::is_supported(CpuInfo::AVX512BW) &&
+           CpuInfo::is_supported(CpuInfo::AVX512VBMI2);
+#else
+    return false;
+#endif
+}
+
+#if defined(__x86_64__)
+size_t compress_filter(const UInt8* data, const UInt8* filt, size_t size, UInt8* res) {
+    return compress_filter_avx512(data, filt, size, res);
+}
+size_t compress_filter(const UInt16* data, const UInt8* filt, size_t size, UInt16* res) {
+    return compress_filter_avx512(data, filt, size, res);
+}
+size_t compress_filter(const UInt32* data, const UInt8* filt, size_t size, UInt32* res) {
+    return compress_filter_avx512(data, filt, size, res);
+}
+size_t compress_filter(const UInt64* data, const UInt8* filt, size_t size, UInt64* res) {
+    return compress_filter_avx512(data, filt, size, res);
+}
+#else
+template <typename T>
+static size_t compress_filter_scalar(const T* data, const UInt8* filt, size_t size, T* res) {
+    size_t count = 0;
+    for (size_t pos = 0; pos < size; ++pos) {
+        res[count] = data[pos];
+        count += static_cast<Int8>(filt[pos]) > 0;
+    }
+    return count;
+}
+size_t compress_filter(const UInt8* data, const UInt8* filt, size_t size, UInt8* res) {
+    return compress_filter_scalar(data, filt, size, res);
+}
+size_t compress_filter(const UInt16* data, const UInt8* filt, size_t size, UInt16* res) {
+    return compress_filter_scalar(data, filt, size, res);
+}
+size_t compress_filter(const UInt32* data, const UInt8* filt, size_t size, UInt32* res) {
+    return compress_filter_scalar(data, filt, size, res);
+}
+size_t compress_filter(const UInt64* data, const UInt8* filt, size_t size, UInt64* res) {
+    return compress_filter_scalar(data, filt, size, res);
+}
+#endif
+
+uint16_t filter_to_selection(const UInt8* filt, uint16_t size, uint16_t* sel) {
+#if defined(__x86_64__)
+    if (is_compress_filter_supported()) {
+        return filter_to_selection_avx512(filt, size, sel);
+    }
+#endif
+    uint16_t new_size = 0;
+    uint32_t sel_pos = 0;
+    static constexpr size_t SIMD_BYTES = 32;
+    const uint32_t sel_end_simd = size / SIMD_BYTES * SIMD_BYTES;
+
+    while (sel_pos < sel_end_simd) {
+        auto mask = simd::bytes32_mask_to_bits32_mask(filt + sel_pos);
+        if (0 == mask) {
+            //pass
+        } else if (0xffffffff == mask) {
+            for (uint32_t i = 0; i < SIMD_BYTES; i++) {
+                sel[new_size++] = sel_pos + i;
+            }
+        } else {
+            while (mask) {
+                const size_t bit_pos = __builtin_ctzll(mask);
+                sel[new_size++] = sel_pos + bit_pos;
+                mask = mask & (mask - 1);
+            }
+        }
+        sel_pos += SIMD_BYTES;
+    }
+
+    for (; sel_pos < size; sel_pos++) {
+        if (filt[sel_pos]) {
+            sel[new_size++] = sel_pos;
+        }
+    }
+    return new_size;
+}
+
 size_t count_bytes_in_filter(const IColumn::Filter& filt) {
+#if defined(__x86_64__)
+    if (is_compress_filter_supported()) {
+        return count_bytes_in_filter_avx512(filt.data(), filt.size());
+    }
+#endif
     size_t count = 0;
 
     /** NOTE: In theory, `filt` should only contain zeros and ones.
@@ -44,7 +228,25 @@ size_t count_bytes_in_filter(const IColumn::Filter& filt) {
     const Int8* pos = reinterpret_cast<const Int8*>(filt.data());
     const Int8* end = pos + filt.size();
 
-#if defined(__SSE2__) || defined(__aarch64__) && defined(__POPCNT__)
+#if defined(__AVX2__)
+    const __m256i zero32 = _mm256_setzero_si256();
+    const Int8* end64 = pos + filt.size() / 64 * 64;
+
+    for (; pos < end64; pos += 64)
+        count += __builtin_popcountll(
+                static_cast<UInt64>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos)), zero32)))) |
+                (static_cast<UInt64>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(
+                         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos + 32)), zero32))))
+                 << 32));
+#elif defined(__aarch64__)
+    const int8x16_t zero16 = vdupq_n_s8(0);
+    const Int8* end16 = pos + filt.size() / 16 * 16;
+
+    for (; pos < end16; pos += 16) {
+        count += vaddvq_u8(vshrq_n_u8(vcgtq_s8(vld1q_s8(pos), zero16), 7));
+    }
+#elif defined(__SSE2__)
     const __m128i zero16 = _mm_setzero_si128();
     const Int8* end64 = pos + filt.size() / 64 * 64;
 
@@ -29,6 +29,35 @@ namespace doris::vectorized {
 /// Counts how many bytes of `filt` are greater than zero.
 size_t count_bytes_in_filter(const IColumn::Filter& filt);
 
+/// Whether the CPU can compact the values that pass a filter with VPCOMPRESS, which needs
+/// AVX-512 VBMI2 for the 1 and 2 bytes values. It is checked from CpuInfo at run time, so a
+/// binary built without -mavx512 flags uses it where it is available.
+bool is_compress_filter_supported();
+
+/// Copies the values of `data` whose byte of `filt` is greater than zero into `res`, which must
+/// have room for `size` values, and returns their number. Only valid when
+/// is_compress_filter_supported().
+size_t compress_filter(const UInt8* data, const UInt8* filt, size_t size, UInt8* res);
+size_t compress_filter(const UInt16* data, const UInt8* filt, size_t size, UInt16* res);
+size_t compress_filter(const UInt32* data, const UInt8* filt, size_t size, UInt32* res);
+size_t compress_filter(const UInt64* data, const UInt8* filt, size_t size, UInt64* res);
+
+/// Same as above for the values of any type with one of these sizes, like Int32 or Float64.
+template <typename T>
+size_t compress_filter(const T* data, const UInt8* filt, size_t size, T* res) {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+    using U = std::conditional_t<
+            sizeof(T) == 1, UInt8,
+            std::conditional_t<sizeof(T) == 2, UInt16,
+                               std::conditional_t<sizeof(T) == 4, UInt32, UInt64>>>;
+    return compress_filter(reinterpret_cast<const U*>(data), filt, size,
+                           reinterpret_cast<U*>(res));
+}
+
+/// Writes the positions of the bytes of `filt` greater than zero into `sel` and returns their
+/// number.
+uint16_t filter_to_selection(const UInt8* filt, uint16_t size, uint16_t* sel);
+
 /// Returns vector with num_columns elements. vector[i] is the count of i values in selector.
 /// Selector must contain values from 0 to num_columns - 1. NOTE: this is not checked.
 std::vector<size_t> count_columns_size_in_selector(IColumn::ColumnIndex num_columns,
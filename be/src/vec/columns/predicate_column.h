@@ -284,6 +284,28 @@ public:
         }
     }
 
+    // the values are copied at once into the pool and referenced where they are
+    void insert_many_continuous_binary_data(const char* data_array, const uint32_t* offsets,
+                                            size_t num) override {
+        if constexpr (std::is_same_v<T, StringValue>) {
+            if (num == 0) {
+                return;
+            }
+            if (_pool == nullptr) {
+                _pool.reset(new MemPool());
+            }
+
+            const uint32_t begin = offsets[0];
+            const size_t total_mem_size = offsets[num] - begin;
+            char* destination = (char*)_pool->allocate(total_mem_size);
+            memcpy(destination, data_array + begin, total_mem_size);
+            for (size_t i = 0; i < num; i++) {
+                StringValue sv(destination + offsets[i] - begin, offsets[i + 1] - offsets[i]);
+                data.push_back_without_reserve(sv);
+            }
+        }
+    }
+
     void insert_default() override { data.push_back(T()); }
 
     void clear() override {
@@ -221,6 +221,82 @@ static inline T ALWAYS_INLINE pack_fixed(size_t i, size_t keys_size,
     return key;
 }
 
+/// Calls `func` with the size of a fixed size key as a constant, or 0 for the uncommon sizes.
+template <typename Func>
+static inline void ALWAYS_INLINE with_key_size(size_t key_size, Func&& func) {
+    switch (key_size) {
+    case 1:
+        func(std::integral_constant<size_t, 1>());
+        break;
+    case 2:
+        func(std::integral_constant<size_t, 2>());
+        break;
+    case 4:
+        func(std::integral_constant<size_t, 4>());
+        break;
+    case 8:
+        func(std::integral_constant<size_t, 8>());
+        break;
+    case 16:
+        func(std::integral_constant<size_t, 16>());
+        break;
+    default:
+        func(std::integral_constant<size_t, 0>());
+    }
+}
+
+/// Packs the keys of the rows [begin, end) into `keys` the same way as pack_fixed above, but a
+/// column at a time, so that the values of a column are copied in one loop with a constant size.
+/// `null_maps` are the null maps of the nullable key columns and null for the others, they are
+/// only used with nullable keys.
+template <typename T, bool has_nullable_keys>
+static inline void pack_fixeds(size_t begin, size_t end, const ColumnRawPtrs& key_columns,
+                               const ColumnRawPtrs& null_maps, const Sizes& key_sizes, T* keys) {
+    const size_t rows = end - begin;
+    memset(static_cast<void*>(keys), 0, rows * sizeof(T));
+    char* bytes = reinterpret_cast<char*>(keys);
+
+    if constexpr (has_nullable_keys) {
+        // a null value takes no space in its key, so the values of a column are at the offset of
+        // every row
+        std::vector<size_t> offsets(rows, std::tuple_size<KeysNullMap<T>>::value);
+        for (size_t j = 0; j < key_columns.size(); ++j) {
+            const char* data =
+                    static_cast<const ColumnVectorHelper*>(key_columns[j])->get_raw_data_begin<1>();
+            const UInt8* null_map =
+                    null_maps[j] == nullptr
+                            ? nullptr
+                            : assert_cast<const ColumnUInt8&>(*null_maps[j]).get_data().data();
+            with_key_size(key_sizes[j], [&](auto constant_size) {
+                constexpr size_t fixed_size = decltype(constant_size)::value;
+                const size_t size = fixed_size != 0 ? fixed_size : key_sizes[j];
+                for (size_t i = 0; i < rows; ++i) {
+                    if (null_map != nullptr && null_map[begin + i]) {
+                        bytes[i * sizeof(T) + j / 8] |= UInt8(1) << (j % 8);
+                        continue;
+                    }
+                    memcpy(bytes + i * sizeof(T) + offsets[i], data + (begin + i) * size, size);
+                    offsets[i] += size;
+                }
+            });
+        }
+    } else {
+        size_t offset = 0;
+        for (size_t j = 0; j < key_columns.size(); ++j) {
+            const char* data =
+                    static_cast<const ColumnVectorHelper*>(key_columns[j])->get_raw_data_begin<1>();
+            with_key_size(key_sizes[j], [&](auto constant_size) {
+                constexpr size_t fixed_size = decltype(constant_size)::value;
+                const size_t size = fixed_size != 0 ? fixed_size : key_sizes[j];
+                for (size_t i = 0; i < rows; ++i) {
+                    memcpy(bytes + i * sizeof(T) + offset, data + (begin + i) * size, size);
+                }
+            });
+            offset += key_sizes[j];
+        }
+    }
+}
+
 /// Hash a set of keys into a UInt128 value.
 static inline UInt128 ALWAYS_INLINE hash128(size_t i, size_t keys_size,
                                             const ColumnRawPtrs& key_columns) {
@@ -30,6 +30,8 @@
 #include "common/status.h"
 #include "runtime/memory/chunk.h"
 #include "runtime/memory/chunk_allocator.h"
+#include "runtime/memory/mmap_region_cache.h"
+#include "runtime/memory/system_allocator.h"
 #include "runtime/thread_context.h"
 
 #ifdef NDEBUG
@@ -86,6 +88,8 @@ static constexpr size_t MMAP_THRESHOLD = 64 * (1ULL << 20);
  * by more detailed test later.
   */
 static constexpr size_t CHUNK_THRESHOLD = 4096;
+/// The freed mmap'ed regions are kept in MmapRegionCache for the next allocations of their size.
+static constexpr bool USE_MMAP_REGION_CACHE = true;
 #else
 /**
   * In debug build, use small mmap threshold to reproduce more memory
@@ -94,6 +98,8 @@ static constexpr size_t CHUNK_THRESHOLD = 4096;
   */
 static constexpr size_t MMAP_THRESHOLD = 4096;
 static constexpr size_t CHUNK_THRESHOLD = 1024;
+/// Reusing the regions would hide the use of freed memory the small threshold is for.
+static constexpr bool USE_MMAP_REGION_CACHE = false;
 #endif
 
 static constexpr size_t MMAP_MIN_ALIGNMENT = 4096;
@@ -125,12 +131,29 @@ public:
                         doris::TStatusCode::VEC_BAD_ARGUMENTS);
 
             CONSUME_THREAD_MEM_TRACKER(size);
-            buf = mmap(get_mmap_hint(), size, PROT_READ | PROT_WRITE, mmap_flags, -1, 0);
+            /// A cached region is dirty, it can't be used when the memory has to be zeroed.
+            if constexpr (USE_MMAP_REGION_CACHE && !clear_memory) {
+                buf = doris::MmapRegionCache::instance()->get(size);
+                if (buf != nullptr) {
+                    return buf;
+                }
+            }
+            /// The pages are populated after they are advised to be huge pages, otherwise
+            /// MAP_POPULATE would already have faulted them in as small ones.
+            const bool huge_pages = doris::SystemAllocator::use_huge_pages(size);
+            buf = mmap(get_mmap_hint(), size, PROT_READ | PROT_WRITE,
+                       huge_pages ? mmap_flags_without_populate : mmap_flags, -1, 0);
             if (MAP_FAILED == buf) {
                 RELEASE_THREAD_MEM_TRACKER(size);
                 doris::vectorized::throwFromErrno(fmt::format("Allocator: Cannot mmap {}.", size),
                                                   doris::TStatusCode::VEC_CANNOT_ALLOCATE_MEMORY);
             }
+            if (huge_pages) {
+                doris::SystemAllocator::advise_huge_pages(buf, size);
+                if constexpr (mmap_populate) {
+                    prefault(buf, size);
+                }
+            }
 
             /// No need for zero-fill, because mmap guarantees it.
         } else if (size >= CHUNK_THRESHOLD) {
@@ -171,6 +194,15 @@ public:
     /// Free memory range.
     void free(void* buf, size_t size) {
         if (size >= MMAP_THRESHOLD) {
+            if constexpr (USE_MMAP_REGION_CACHE) {
+                if (doris::MmapRegionCache::instance()->put(buf, size)) {
+                    RELEASE_THREAD_MEM_TRACKER(size);
+                    return;
+                }
+            }
+            if (doris::SystemAllocator::use_huge_pages(size)) {
+                doris::SystemAllocator::release_huge_pages(size);
+            }
             if (0 != munmap(buf, size)) {
                 doris::vectorized::throwFromErrno(fmt::format("Allocator: Cannot munmap {}.", size),
                                                   doris::TStatusCode::VEC_CANNOT_MUNMAP);
@@ -220,6 +252,12 @@ public:
                                                           std::to_string(new_size) + ".",
                                                   doris::TStatusCode::VEC_CANNOT_MREMAP);
             }
+            if (doris::SystemAllocator::use_huge_pages(old_size)) {
+                doris::SystemAllocator::release_huge_pages(old_size);
+            }
+            if (doris::SystemAllocator::use_huge_pages(new_size)) {
+                doris::SystemAllocator::advise_huge_pages(buf, new_size);
+            }
 
             /// No need for zero-fill, because mmap guarantees it.
 
@@ -256,6 +294,14 @@ protected:
                                       | (mmap_populate ? MAP_POPULATE : 0)
 #endif
             ;
+    static constexpr int mmap_flags_without_populate = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    /// Faults in the pages of [buf, buf + size) by writing to each of them.
+    static void prefault(void* buf, size_t size) {
+        for (size_t offset = 0; offset < size; offset += MMAP_MIN_ALIGNMENT) {
+            reinterpret_cast<volatile char*>(buf)[offset] = 0;
+        }
+    }
 
 private:
 #ifndef NDEBUG
@@ -275,6 +275,22 @@ public:
     size_t size() const { return size_in_bytes; }
 
     size_t remaining_space_in_current_chunk() const { return head->remaining(); }
+
+    /// Free all chunks except the first one and rewind it, so that the arena can be reused
+    /// after all the memory allocated from it is no longer referenced.
+    void clear() {
+        if (head->prev) {
+            Chunk* first = head;
+            while (first->prev->prev) first = first->prev;
+            Chunk* initial = first->prev;
+            first->prev = nullptr;
+            delete head;
+            head = initial;
+        }
+        ASAN_POISON_MEMORY_REGION(head->begin, head->size());
+        head->pos = head->begin;
+        size_in_bytes = head->size();
+    }
 };
 
 using ArenaPtr = std::shared_ptr<Arena>;
@@ -0,0 +1,134 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "vec/common/allocator.h"
+#include "vec/common/string_ref.h"
+
+namespace doris::vectorized {
+
+/** A string that is only appended to, kept in a list of chunks of geometrically growing sizes.
+  * Unlike a std::string, an append never reallocates and copies the bytes already written, and
+  * freeing it frees its few chunks without touching their bytes.
+  */
+class ChunkedString : private Allocator<false> {
+public:
+    ChunkedString() = default;
+    ChunkedString(const ChunkedString&) = delete;
+    ChunkedString& operator=(const ChunkedString&) = delete;
+    ~ChunkedString() { clear(); }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    void append(const char* data, size_t size) {
+        if (_tail != nullptr) {
+            size_t n = std::min(size, _tail->capacity - _tail->size);
+            memcpy(_tail->data() + _tail->size, data, n);
+            _tail->size += n;
+            _size += n;
+            data += n;
+            size -= n;
+        }
+        if (size > 0) {
+            memcpy(append_uninitialized(size), data, size);
+        }
+    }
+
+    void append(const StringRef& ref) { append(ref.data, ref.size); }
+
+    void append(const ChunkedString& rhs) {
+        rhs.for_each_chunk([this](const char* data, size_t size) { append(data, size); });
+    }
+
+    /// Appends size bytes to be filled by the caller, and returns where they are.
+    char* append_uninitialized(size_t size) {
+        if (_tail == nullptr || _tail->capacity - _tail->size < size) {
+            _add_chunk(size);
+        }
+        char* res = _tail->data() + _tail->size;
+        _tail->size += size;
+        _size += size;
+        return res;
+    }
+
+    template <typename Func>
+    void for_each_chunk(Func&& func) const {
+        for (const Chunk* chunk = _head; chunk != nullptr; chunk = chunk->next) {
+            func(chunk->data(), chunk->size);
+        }
+    }
+
+    /// Copies the size() bytes of the string to dst.
+    void copy_to(char* dst) const {
+        for_each_chunk([&dst](const char* data, size_t size) {
+            memcpy(dst, data, size);
+            dst += size;
+        });
+    }
+
+    void clear() {
+        Chunk* chunk = _head;
+        while (chunk != nullptr) {
+            Chunk* next = chunk->next;
+            Allocator<false>::free(chunk, sizeof(Chunk) + chunk->capacity);
+            chunk = next;
+        }
+        _head = nullptr;
+        _tail = nullptr;
+        _size = 0;
+    }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+        size_t capacity;
+
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+        const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    static constexpr size_t MIN_CHUNK_CAPACITY = 64;
+    static constexpr size_t MAX_CHUNK_CAPACITY = 1024 * 1024;
+
+    void _add_chunk(size_t min_capacity) {
+        size_t capacity = _tail == nullptr ? MIN_CHUNK_CAPACITY
+                                           : std::min(_tail->capacity * 2, MAX_CHUNK_CAPACITY);
+        capacity = std::max(capacity, min_capacity);
+        auto chunk = reinterpret_cast<Chunk*>(Allocator<false>::alloc(sizeof(Chunk) + capacity));
+        chunk->next = nullptr;
+        chunk->size = 0;
+        chunk->capacity = capacity;
+        if (_tail == nullptr) {
+            _head = chunk;
+        } else {
+            _tail->next = chunk;
+        }
+        _tail = chunk;
+    }
+
+    Chunk* _head = nullptr;
+    Chunk* _tail = nullptr;
+    size_t _size = 0;
+};
+
+} // namespace doris::vectorized
@@ -188,12 +188,36 @@ struct HashMethodKeysFixed
 
     const Sizes& key_sizes;
     size_t keys_size;
+    // the keys of the rows from `packed_begin` on, packed by pack_keys
+    const Key* packed_keys = nullptr;
+    size_t packed_begin = 0;
 
     HashMethodKeysFixed(const ColumnRawPtrs& key_columns, const Sizes& key_sizes_,
                         const HashMethodContextPtr&)
             : Base(key_columns), key_sizes(key_sizes_), keys_size(key_columns.size()) {}
 
+    /// Packs the keys of the rows [begin, end) into `keys` a column at a time, the keys of these
+    /// rows are then taken from there instead of being packed one by one.
+    void pack_keys(size_t begin, size_t end, Key* keys) {
+        if constexpr (has_nullable_keys_) {
+            pack_fixeds<Key, true>(begin, end, Base::get_actual_columns(), Base::get_null_maps(),
+                                   key_sizes, keys);
+        } else {
+            pack_fixeds<Key, false>(begin, end, Base::get_actual_columns(), {}, key_sizes, keys);
+        }
+        set_packed_keys(keys, begin);
+    }
+
+    /// Takes the keys of the rows from `begin` on from `keys`, packed by pack_keys.
+    void set_packed_keys(const Key* keys, size_t begin = 0) {
+        packed_keys = keys;
+        packed_begin = begin;
+    }
+
     ALWAYS_INLINE Key get_key_holder(size_t row, Arena&) const {
+        if (packed_keys != nullptr) {
+            return packed_keys[row - packed_begin];
+        }
         if constexpr (has_nullable_keys_) {
             auto bitmap = Base::create_bitmap(row);
             return pack_fixed<Key>(row, keys_size, Base::get_actual_columns(), key_sizes, bitmap);
@@ -203,6 +227,17 @@ struct HashMethodKeysFixed
     }
 };
 
+template <typename HashMethod>
+struct IsKeysFixedHashMethodTraits {
+    constexpr static bool value = false;
+};
+
+template <typename Value, typename Key, typename Mapped, bool has_nullable_keys, bool use_cache>
+struct IsKeysFixedHashMethodTraits<
+        HashMethodKeysFixed<Value, Key, Mapped, has_nullable_keys, use_cache>> {
+    constexpr static bool value = true;
+};
+
 template <typename SingleColumnMethod, typename Mapped, bool use_cache>
 struct HashMethodSingleLowNullableColumn : public SingleColumnMethod {
     using Base = SingleColumnMethod;
@@ -242,11 +277,27 @@ struct HashMethodSingleLowNullableColumn : public SingleColumnMethod {
                 return EmplaceResult(!has_null_key);
         }
 
+        return emplace_not_null_key(data, row, pool);
+    }
+
+    template <typename Data>
+    ALWAYS_INLINE EmplaceResult emplace_key_batched(Data& data, size_t row, Arena& pool) {
+        if (key_columns[0]->is_null_at(row)) {
+            return emplace_key(data, row, pool);
+        }
+        Base::prefetch_ahead(data, row);
+        return emplace_not_null_key(data, row, pool, Base::get_hash_value(row));
+    }
+
+private:
+    template <typename Data, typename... HashValue>
+    ALWAYS_INLINE EmplaceResult emplace_not_null_key(Data& data, size_t row, Arena& pool,
+                                                     HashValue... hash_value) {
         auto key_holder = Base::get_key_holder(row, pool);
 
         bool inserted = false;
         typename Data::LookupResult it;
-        data.emplace(key_holder, it, inserted);
+        data.emplace(key_holder, it, inserted, hash_value...);
 
         if constexpr (has_mapped) {
             auto& mapped = *lookup_result_get_mapped(it);
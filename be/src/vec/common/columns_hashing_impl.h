@@ -24,6 +24,7 @@
 #include "vec/columns/column_nullable.h"
 #include "vec/common/aggregation_common.h"
 #include "vec/common/assert_cast.h"
+#include "vec/common/hash_table/hash_table.h"
 #include "vec/common/hash_table/hash_table_key_holder.h"
 // #include <Interpreters/AggregationCommon.h>
 
@@ -139,18 +140,63 @@ public:
         return emplaceImpl(key_holder, hash_value, data);
     }
 
+    /// The hash tables other than phmap take the hash of the key after `inserted`.
+    template <typename Data>
+    ALWAYS_INLINE EmplaceResult emplace_key_with_hash(Data& data, size_t hash_value, size_t row,
+                                                      Arena& pool) {
+        auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
+        return emplace_with<Data>(key_holder, [&](auto& it, bool& inserted) {
+            data.emplace(key_holder, it, inserted, hash_value);
+        });
+    }
+
     template <typename Data>
     ALWAYS_INLINE FindResult find_key(Data& data, size_t row, Arena& pool) {
         auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
         return find_key_impl(key_holder_get_key(key_holder), data);
     }
 
+    template <typename Data>
+    ALWAYS_INLINE FindResult find_key(Data& data, size_t hash_value, size_t row, Arena& pool) {
+        auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
+        return find_key_impl(key_holder_get_key(key_holder), data, hash_value);
+    }
+
     template <typename Data>
     ALWAYS_INLINE size_t get_hash(const Data& data, size_t row, Arena& pool) {
         auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
         return data.hash(key_holder_get_key(key_holder));
     }
 
+    /// Computes the hashes of the keys of the rows [begin, end) in one pass. The batched lookups
+    /// of these rows below then don't hash their keys again, and prefetch the cell of the key
+    /// HASH_MAP_PREFETCH_DIST rows ahead, so that a table much larger than the cache doesn't
+    /// stall every lookup on a miss.
+    template <typename Data>
+    void init_hash_values(const Data& data, size_t begin, size_t end, Arena& pool) {
+        hash_values.resize(end - begin);
+        for (size_t row = begin; row < end; ++row) {
+            auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
+            hash_values[row - begin] = data.hash(key_holder_get_key(key_holder));
+            key_holder_discard_key(key_holder);
+        }
+        hash_begin = begin;
+    }
+
+    ALWAYS_INLINE size_t get_hash_value(size_t row) const { return hash_values[row - hash_begin]; }
+
+    template <typename Data>
+    ALWAYS_INLINE FindResult find_key_batched(Data& data, size_t row, Arena& pool) {
+        prefetch_ahead(data, row);
+        return find_key(data, hash_values[row - hash_begin], row, pool);
+    }
+
+    template <typename Data>
+    ALWAYS_INLINE EmplaceResult emplace_key_batched(Data& data, size_t row, Arena& pool) {
+        prefetch_ahead(data, row);
+        return emplace_key_with_hash(data, hash_values[row - hash_begin], row, pool);
+    }
+
     template <typename Data>
     ALWAYS_INLINE void prefetch(Data& data, size_t row, Arena& pool) {
         auto key_holder = static_cast<Derived&>(*this).get_key_holder(row, pool);
@@ -159,6 +205,17 @@ public:
 
 protected:
     Cache cache;
+    // the hashes of the keys of the rows from `hash_begin` on, see init_hash_values
+    std::vector<size_t> hash_values;
+    size_t hash_begin = 0;
+
+    template <typename Data>
+    ALWAYS_INLINE void prefetch_ahead(Data& data, size_t row) {
+        size_t ahead = row - hash_begin + HASH_MAP_PREFETCH_DIST;
+        if (ahead < hash_values.size()) {
+            data.prefetch_by_hash(hash_values[ahead]);
+        }
+    }
 
     HashMethodBase() {
         if constexpr (consecutive_keys_optimization) {
@@ -173,49 +230,22 @@ protected:
 
     template <typename Data, typename KeyHolder>
     ALWAYS_INLINE EmplaceResult emplaceImpl(KeyHolder& key_holder, Data& data) {
-        if constexpr (Cache::consecutive_keys_optimization) {
-            if (cache.found && cache.check(key_holder_get_key(key_holder))) {
-                if constexpr (has_mapped)
-                    return EmplaceResult(cache.value.second, cache.value.second, false);
-                else
-                    return EmplaceResult(false);
-            }
-        }
-
-        typename Data::LookupResult it;
-        bool inserted = false;
-        data.emplace(key_holder, it, inserted);
-
-        [[maybe_unused]] Mapped* cached = nullptr;
-        if constexpr (has_mapped) cached = lookup_result_get_mapped(it);
-
-        if (inserted) {
-            if constexpr (has_mapped) {
-                new (lookup_result_get_mapped(it)) Mapped();
-            }
-        }
-
-        if constexpr (consecutive_keys_optimization) {
-            cache.found = true;
-            cache.empty = false;
-
-            if constexpr (has_mapped) {
-                cache.value.first = *lookup_result_get_key(it);
-                cache.value.second = *lookup_result_get_mapped(it);
-                cached = &cache.value.second;
-            } else {
-                cache.value = *lookup_result_get_key(it);
-            }
-        }
-
-        if constexpr (has_mapped)
-            return EmplaceResult(*lookup_result_get_mapped(it), *cached, inserted);
-        else
-            return EmplaceResult(inserted);
+        return emplace_with<Data>(key_holder, [&](auto& it, bool& inserted) {
+            data.emplace(key_holder, it, inserted);
+        });
     }
 
     template <typename Data, typename KeyHolder>
     ALWAYS_INLINE EmplaceResult emplaceImpl(KeyHolder& key_holder, size_t hash_value, Data& data) {
+        return emplace_with<Data>(key_holder, [&](auto& it, bool& inserted) {
+            data.emplace(key_holder, it, hash_value, inserted);
+        });
+    }
+
+    /// `emplace(it, inserted)` inserts the key into the hash table, which takes the arguments of
+    /// its own emplace in different orders.
+    template <typename Data, typename KeyHolder, typename Emplace>
+    ALWAYS_INLINE EmplaceResult emplace_with(KeyHolder& key_holder, Emplace&& emplace) {
         if constexpr (Cache::consecutive_keys_optimization) {
             if (cache.found && cache.check(key_holder_get_key(key_holder))) {
                 if constexpr (has_mapped)
@@ -227,7 +257,7 @@ protected:
 
         typename Data::LookupResult it;
         bool inserted = false;
-        data.emplace(key_holder, it, hash_value, inserted);
+        emplace(it, inserted);
 
         [[maybe_unused]] Mapped* cached = nullptr;
         if constexpr (has_mapped) cached = lookup_result_get_mapped(it);
@@ -257,8 +287,8 @@ protected:
             return EmplaceResult(inserted);
     }
 
-    template <typename Data, typename Key>
-    ALWAYS_INLINE FindResult find_key_impl(Key key, Data& data) {
+    template <typename Data, typename Key, typename... HashValue>
+    ALWAYS_INLINE FindResult find_key_impl(Key key, Data& data, HashValue... hash_value) {
         if constexpr (Cache::consecutive_keys_optimization) {
             if (cache.check(key)) {
                 if constexpr (has_mapped)
@@ -268,7 +298,7 @@ protected:
             }
         }
 
-        auto it = data.find(key);
+        auto it = data.find(key, hash_value...);
 
         if constexpr (consecutive_keys_optimization) {
             cache.found = it != nullptr;
@@ -327,6 +357,9 @@ protected:
     /// column. Otherwise we return the key column itself.
     const ColumnRawPtrs& get_actual_columns() const { return actual_columns; }
 
+    /// The null maps of the nullable key columns, null for the others.
+    const ColumnRawPtrs& get_null_maps() const { return null_maps; }
+
     /// Create a bitmap that indicates whether, for a particular row,
     /// a key column bears a null value or not.
     KeysNullMap<Key> create_bitmap(size_t row) const {
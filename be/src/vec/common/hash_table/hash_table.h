@@ -46,6 +46,10 @@
   * Also, key in hash table must be of type, that zero bytes is compared equals to zero key.
   */
 
+/// How many rows ahead the lookups of a batch of keys whose hashes are computed up front prefetch
+/// the cells of their keys, see HashMethodBase::init_hash_values.
+static constexpr size_t HASH_MAP_PREFETCH_DIST = 16;
+
 /** The state of the hash table that affects the properties of its cells.
   * Used as a template parameter.
   * For example, there is an implementation of an instantly clearable hash table - ClearableHashMap.
@@ -842,6 +846,10 @@ public:
         __builtin_prefetch(&buf[place_value]);
     }
 
+    void ALWAYS_INLINE prefetch_by_hash(size_t hash_value) {
+        __builtin_prefetch(&buf[grower.place(hash_value)]);
+    }
+
     /// Reinsert node pointed to by iterator
     void ALWAYS_INLINE reinsert(iterator& it, size_t hash_value) {
         reinsert(*it.get_ptr(), hash_value);
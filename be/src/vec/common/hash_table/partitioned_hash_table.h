@@ -0,0 +1,351 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+#include <type_traits>
+#include <vector>
+
+#include "common/logging.h"
+#include "vec/common/hash_table/hash_map.h"
+#include "vec/common/hash_table/hash_table_key_holder.h"
+
+/** A hash table split into a power of two number of sub-tables by the hash of the key.
+  * The number of partitions is decided at runtime by init_partitions(), before anything
+  * is inserted. With a single partition it behaves exactly like the wrapped table.
+  *
+  * Keys of different partitions never meet, so each partition can be filled by its own
+  * thread without synchronization. Lookups are routed to the partition selected by the
+  * high bits of the 32-bit hash value, the low bits still pick the cell in the sub-table.
+  */
+template <typename Impl>
+class PartitionedHashTable : private boost::noncopyable {
+public:
+    using Self = PartitionedHashTable;
+
+    using key_type = typename Impl::key_type;
+    using mapped_type = typename Impl::mapped_type;
+    using value_type = typename Impl::value_type;
+
+    using LookupResult = typename Impl::LookupResult;
+    using ConstLookupResult = typename Impl::ConstLookupResult;
+
+    static constexpr size_t MAX_PARTITION_BITS = 8;
+    static constexpr size_t MAX_PARTITIONS = 1ULL << MAX_PARTITION_BITS;
+
+    PartitionedHashTable() : _partitions(1) {}
+
+    PartitionedHashTable(PartitionedHashTable&& rhs) { *this = std::move(rhs); }
+
+    PartitionedHashTable& operator=(PartitionedHashTable&& rhs) {
+        _partitions = std::move(rhs._partitions);
+        _partition_mask = rhs._partition_mask;
+        rhs._partitions.resize(1);
+        rhs._partition_mask = 0;
+        return *this;
+    }
+
+    /// Split the empty table into 2^partition_bits partitions.
+    void init_partitions(size_t partition_bits) {
+        DCHECK(empty());
+        DCHECK_LE(partition_bits, MAX_PARTITION_BITS);
+        _partitions = std::vector<Impl>(1ULL << partition_bits);
+        _partition_mask = _partitions.size() - 1;
+    }
+
+    /// Redistribute the elements of a table with a single partition into 2^partition_bits
+    /// partitions. The mapped values are moved as is, so pointers they hold stay valid, but
+    /// all iterators are invalidated.
+    void convert_to_partitioned(size_t partition_bits = MAX_PARTITION_BITS) {
+        DCHECK_EQ(_partitions.size(), 1);
+        DCHECK_LE(partition_bits, MAX_PARTITION_BITS);
+        Impl single = std::move(_partitions[0]);
+        _partitions = std::vector<Impl>(1ULL << partition_bits);
+        _partition_mask = _partitions.size() - 1;
+        init_buf_size(single.size());
+
+        for (auto it = single.begin(), end = single.end(); it != end; ++it) {
+            size_t hash_value = it.get_hash();
+            LookupResult res_it;
+            bool inserted;
+            _partitions[get_partition_from_hash(hash_value)].emplace(it->get_first(), res_it,
+                                                                     inserted, hash_value);
+            DCHECK(inserted);
+            *lookup_result_get_mapped(res_it) = std::move(it->get_second());
+        }
+    }
+
+    bool is_partitioned() const { return _partitions.size() > 1; }
+
+    size_t get_partition_count() const { return _partitions.size(); }
+
+    Impl& get_partition(size_t partition) { return _partitions[partition]; }
+    const Impl& get_partition(size_t partition) const { return _partitions[partition]; }
+
+    size_t ALWAYS_INLINE get_partition_from_hash(size_t hash_value) const {
+        return (hash_value >> (32 - MAX_PARTITION_BITS)) & _partition_mask;
+    }
+
+    size_t hash(const key_type& x) const { return _partitions[0].hash(x); }
+
+    template <typename Derived, bool is_const>
+    class iterator_base {
+        using Container = std::conditional_t<is_const, const Self, Self>;
+        using SubIterator = std::conditional_t<is_const, typename Impl::const_iterator,
+                                               typename Impl::iterator>;
+
+        Container* container = nullptr;
+        size_t partition = 0;
+        SubIterator current;
+
+        friend class PartitionedHashTable;
+
+        /// Skip the partitions which have been iterated over or are empty.
+        void skip_finished_partitions() {
+            while (partition + 1 < container->_partitions.size() &&
+                   current == container->_partitions[partition].end()) {
+                ++partition;
+                current = container->_partitions[partition].begin();
+            }
+        }
+
+    public:
+        iterator_base() {}
+        iterator_base(Container* container_, size_t partition_, SubIterator current_)
+                : container(container_), partition(partition_), current(current_) {
+            skip_finished_partitions();
+        }
+
+        bool operator==(const iterator_base& rhs) const {
+            return partition == rhs.partition && current == rhs.current;
+        }
+        bool operator!=(const iterator_base& rhs) const { return !(*this == rhs); }
+
+        Derived& operator++() {
+            ++current;
+            skip_finished_partitions();
+            return static_cast<Derived&>(*this);
+        }
+
+        auto& operator*() const { return *current; }
+        auto* operator->() const { return current.get_ptr(); }
+
+        auto get_ptr() const { return current.get_ptr(); }
+        size_t get_hash() const { return current.get_hash(); }
+    };
+
+    class iterator : public iterator_base<iterator, false> {
+    public:
+        using iterator_base<iterator, false>::iterator_base;
+    };
+
+    class const_iterator : public iterator_base<const_iterator, true> {
+    public:
+        using iterator_base<const_iterator, true>::iterator_base;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0, _partitions[0].begin()); }
+    const_iterator cbegin() const { return begin(); }
+    iterator begin() { return iterator(this, 0, _partitions[0].begin()); }
+
+    const_iterator end() const {
+        return const_iterator(this, _partitions.size() - 1, _partitions.back().end());
+    }
+    const_iterator cend() const { return end(); }
+    iterator end() { return iterator(this, _partitions.size() - 1, _partitions.back().end()); }
+
+    std::pair<LookupResult, bool> ALWAYS_INLINE insert(const value_type& x) {
+        size_t hash_value = hash(x.first);
+        return _partitions[get_partition_from_hash(hash_value)].insert(x);
+    }
+
+    template <typename KeyHolder>
+    void ALWAYS_INLINE prefetch(KeyHolder& key_holder) {
+        size_t hash_value = hash(key_holder_get_key(key_holder));
+        _partitions[get_partition_from_hash(hash_value)].prefetch_by_hash(hash_value);
+    }
+
+    void ALWAYS_INLINE prefetch_by_hash(size_t hash_value) {
+        _partitions[get_partition_from_hash(hash_value)].prefetch_by_hash(hash_value);
+    }
+
+    template <typename KeyHolder>
+    void ALWAYS_INLINE emplace(KeyHolder&& key_holder, LookupResult& it, bool& inserted) {
+        size_t hash_value = hash(key_holder_get_key(key_holder));
+        emplace(key_holder, it, inserted, hash_value);
+    }
+
+    template <typename KeyHolder>
+    void ALWAYS_INLINE emplace(KeyHolder&& key_holder, LookupResult& it, bool& inserted,
+                               size_t hash_value) {
+        _partitions[get_partition_from_hash(hash_value)].emplace(key_holder, it, inserted,
+                                                                 hash_value);
+    }
+
+    LookupResult ALWAYS_INLINE find(key_type x) {
+        size_t hash_value = hash(x);
+        return _partitions[get_partition_from_hash(hash_value)].find(x, hash_value);
+    }
+
+    ConstLookupResult ALWAYS_INLINE find(key_type x) const {
+        return const_cast<std::decay_t<decltype(*this)>*>(this)->find(x);
+    }
+
+    LookupResult ALWAYS_INLINE find(key_type x, size_t hash_value) {
+        return _partitions[get_partition_from_hash(hash_value)].find(x, hash_value);
+    }
+
+    void delete_zero_key(key_type key) {
+        _partitions[get_partition_from_hash(hash(key))].delete_zero_key(key);
+    }
+
+    /// The elements are assumed to be evenly distributed among the partitions.
+    void expanse_for_add_elem(size_t num_elem) {
+        size_t num_elem_per_partition = (num_elem + _partition_mask) / _partitions.size();
+        for (auto& partition : _partitions) {
+            partition.expanse_for_add_elem(num_elem_per_partition);
+        }
+    }
+
+    void init_buf_size(size_t reserve_for_num_elements) {
+        size_t num_elem_per_partition =
+                (reserve_for_num_elements + _partition_mask) / _partitions.size();
+        for (auto& partition : _partitions) {
+            partition.init_buf_size(num_elem_per_partition);
+        }
+    }
+
+    void reset_resize_timer() {
+        for (auto& partition : _partitions) {
+            partition.reset_resize_timer();
+        }
+    }
+
+    int64_t get_resize_timer_value() const {
+        int64_t value = 0;
+        for (const auto& partition : _partitions) {
+            value += partition.get_resize_timer_value();
+        }
+        return value;
+    }
+
+    size_t size() const {
+        size_t res = 0;
+        for (const auto& partition : _partitions) {
+            res += partition.size();
+        }
+        return res;
+    }
+
+    bool empty() const {
+        for (const auto& partition : _partitions) {
+            if (!partition.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// The number of rows referenced by the mapped values.
+    size_t get_size() {
+        size_t count = 0;
+        for (auto& partition : _partitions) {
+            count += partition.get_size();
+        }
+        return count;
+    }
+
+    float get_factor() const { return _partitions[0].get_factor(); }
+
+    bool should_be_shrink(int64_t valid_row) { return valid_row < get_factor() * (size() / 2.0); }
+
+    size_t get_buffer_size_in_bytes() const {
+        size_t res = 0;
+        for (const auto& partition : _partitions) {
+            res += partition.get_buffer_size_in_bytes();
+        }
+        return res;
+    }
+
+    size_t get_buffer_size_in_cells() const {
+        size_t res = 0;
+        for (const auto& partition : _partitions) {
+            res += partition.get_buffer_size_in_cells();
+        }
+        return res;
+    }
+
+    /// Call func(Mapped &) for each hash map element.
+    template <typename Func>
+    void for_each_mapped(Func&& func) {
+        for (auto& partition : _partitions) {
+            partition.for_each_mapped(func);
+        }
+    }
+
+    /// Call func(const Key &, Mapped &) for each hash map element.
+    template <typename Func>
+    void for_each_value(Func&& func) {
+        for (auto& partition : _partitions) {
+            partition.for_each_value(func);
+        }
+    }
+
+    bool add_elem_size_overflow(size_t add_size) const {
+        size_t add_size_per_partition = (add_size + _partition_mask) / _partitions.size();
+        for (const auto& partition : _partitions) {
+            if (partition.add_elem_size_overflow(add_size_per_partition)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear() {
+        for (auto& partition : _partitions) {
+            partition.clear();
+        }
+    }
+
+    /// After executing this function, the table can only be destroyed,
+    ///  and also you can use the methods `size`, `empty`, `begin`, `end`.
+    void clear_and_shrink() {
+        for (auto& partition : _partitions) {
+            partition.clear_and_shrink();
+        }
+    }
+
+    char* get_null_key_data() { return nullptr; }
+    bool has_null_key_data() const { return false; }
+
+private:
+    std::vector<Impl> _partitions;
+    size_t _partition_mask = 0;
+};
+
+template <typename T, typename = void>
+struct IsPartitionedHashTable : std::false_type {};
+
+/// Also true for the tables derived from a PartitionedHashTable, such as the ones with a null key.
+template <typename T>
+struct IsPartitionedHashTable<T, std::void_t<decltype(std::declval<T&>().is_partitioned())>>
+        : std::true_type {};
+
+template <typename Key, typename Mapped, typename Hash = DefaultHash<Key>,
+          typename Grower = HashTableGrower<>, typename Allocator = HashTableAllocator>
+using PartitionedHashMap = PartitionedHashTable<HashMap<Key, Mapped, Hash, Grower, Allocator>>;
@@ -37,6 +37,16 @@
 #include <smmintrin.h>
 #endif
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#ifdef __aarch64__
+#include <arm_neon.h>
+
+#include "util/simd/bits.h"
+#endif
+
 namespace doris {
 
 // namespace ErrorCodes
@@ -76,6 +86,21 @@ private:
     /// first character in `needle`
     uint8_t first {};
 
+#ifdef __AVX2__
+    /// `needle` is searched by its first and last characters in blocks of 32 octets
+    static constexpr size_t block_size = sizeof(__m256i);
+    __m256i first_block;
+    __m256i last_block;
+#elif defined(__SSE2__)
+    static constexpr size_t block_size = sizeof(__m128i);
+    __m128i first_block;
+    __m128i last_block;
+#elif defined(__aarch64__)
+    static constexpr size_t block_size = sizeof(uint8x16_t);
+    uint8x16_t first_block;
+    uint8x16_t last_block;
+#endif
+
 #ifdef __SSE4_1__
     /// vector filled `first` for determining leftmost position of the first symbol
     __m128i pattern;
@@ -94,6 +119,17 @@ public:
 
         first = *needle;
 
+#ifdef __AVX2__
+        first_block = _mm256_set1_epi8(first);
+        last_block = _mm256_set1_epi8(*(needle_end - 1));
+#elif defined(__SSE2__)
+        first_block = _mm_set1_epi8(first);
+        last_block = _mm_set1_epi8(*(needle_end - 1));
+#elif defined(__aarch64__)
+        first_block = vdupq_n_u8(first);
+        last_block = vdupq_n_u8(*(needle_end - 1));
+#endif
+
 #ifdef __SSE4_1__
         pattern = _mm_set1_epi8(first);
 
@@ -155,6 +191,17 @@ public:
     const CharT* search(const CharT* haystack, const CharT* const haystack_end) const {
         if (needle == needle_end) return haystack;
 
+#if defined(__SSE2__) || defined(__aarch64__)
+        if (needle_end - needle >= 2) {
+            const auto* pos = reinterpret_cast<const uint8_t*>(haystack);
+            const auto* res =
+                    search_first_last(pos, reinterpret_cast<const uint8_t*>(haystack_end));
+            if (res != nullptr) return reinterpret_cast<const CharT*>(res);
+            /// the tail shorter than a block is searched as below
+            haystack = reinterpret_cast<const CharT*>(pos);
+        }
+#endif
+
         while (haystack < haystack_end) {
 #ifdef __SSE4_1__
             if (haystack + n <= haystack_end && page_safe(haystack)) {
@@ -224,6 +271,54 @@ public:
     const CharT* search(const CharT* haystack, const size_t haystack_size) const {
         return search(haystack, haystack + haystack_size);
     }
+
+private:
+#if defined(__SSE2__) || defined(__aarch64__)
+    /// Returns the bit mask of the positions of the block at `pos` where both the first and
+    /// the last characters of `needle` match.
+    ALWAYS_INLINE uint32_t match_first_last(const uint8_t* pos, size_t needle_size) const {
+#ifdef __AVX2__
+        const auto v_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        const auto v_last =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos + needle_size - 1));
+        return _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(v_first, first_block),
+                                                     _mm256_cmpeq_epi8(v_last, last_block)));
+#elif defined(__SSE2__)
+        const auto v_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        const auto v_last =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos + needle_size - 1));
+        return _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v_first, first_block),
+                                               _mm_cmpeq_epi8(v_last, last_block)));
+#else
+        const auto v_first = vld1q_u8(pos);
+        const auto v_last = vld1q_u8(pos + needle_size - 1);
+        return simd::bytes16_mask_to_bits16_mask(
+                vandq_u8(vceqq_u8(v_first, first_block), vceqq_u8(v_last, last_block)));
+#endif
+    }
+
+    /// Filters the positions of the haystack by the first and the last characters of `needle`
+    /// a block at a time, which skips most of the positions of a text without comparing their
+    /// bytes one by one, and compares the middle of `needle` only at the positions passing both.
+    /// The loads never exceed `haystack_end`. Returns nullptr if not found in the blocks, with
+    /// `haystack` moved to the start of the remaining tail.
+    const uint8_t* search_first_last(const uint8_t*& haystack,
+                                     const uint8_t* const haystack_end) const {
+        const size_t needle_size = needle_end - needle;
+        while (haystack + needle_size - 1 + block_size <= haystack_end) {
+            uint32_t mask = match_first_last(haystack, needle_size);
+            while (mask != 0) {
+                const auto offset = __builtin_ctz(mask);
+                if (memcmp(haystack + offset + 1, needle + 1, needle_size - 2) == 0) {
+                    return haystack + offset;
+                }
+                mask &= mask - 1;
+            }
+            haystack += block_size;
+        }
+        return nullptr;
+    }
+#endif
 };
 
 // Searches for needle surrounded by token-separators.
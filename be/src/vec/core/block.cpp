@@ -27,13 +27,16 @@
 #include <iomanip>
 #include <iterator>
 #include <memory>
+#include <unordered_map>
 
 #include "common/status.h"
 #include "runtime/descriptors.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple.h"
 #include "runtime/tuple_row.h"
+#include "service/brpc.h"
 #include "udf/udf.h"
+#include "util/block_compression.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
@@ -74,24 +77,59 @@ Block::Block(const std::vector<SlotDescriptor*>& slots, size_t block_size) {
     }
 }
 
+// The codecs are not thread safe and some of them allocate their contexts when created, so each
+// thread keeps one codec of each type instead of creating one for every block.
+static Status get_thread_local_codec(segment_v2::CompressionTypePB type,
+                                     BlockCompressionCodec** codec) {
+    thread_local std::unordered_map<int, std::unique_ptr<BlockCompressionCodec>> codecs;
+    auto& thread_codec = codecs[type];
+    if (thread_codec == nullptr) {
+        RETURN_IF_ERROR(get_block_compression_codec(type, thread_codec));
+    }
+    *codec = thread_codec.get();
+    return Status::OK();
+}
+
 Block::Block(const PBlock& pblock) {
+    deserialize_columns(pblock, pblock.column_values().data(), pblock.column_values().size());
+}
+
+Block::Block(const PBlock& pblock, const butil::IOBuf& column_values) {
+    if (column_values.backing_block_num() == 1) {
+        auto contiguous_values = column_values.backing_block(0);
+        deserialize_columns(pblock, contiguous_values.data(), contiguous_values.size());
+    } else {
+        // The data types deserialize from a contiguous buffer.
+        std::string contiguous_values;
+        column_values.copy_to(&contiguous_values);
+        deserialize_columns(pblock, contiguous_values.data(), contiguous_values.size());
+    }
+}
+
+void Block::deserialize_columns(const PBlock& pblock, const char* column_values, size_t size) {
     const char* buf = nullptr;
     std::string compression_scratch;
     if (pblock.compressed()) {
         // Decompress
-        const char* compressed_data = pblock.column_values().c_str();
-        size_t compressed_size = pblock.column_values().size();
-        size_t uncompressed_size = 0;
-        bool success =
-                snappy::GetUncompressedLength(compressed_data, compressed_size, &uncompressed_size);
-        DCHECK(success) << "snappy::GetUncompressedLength failed";
+        const char* compressed_data = column_values;
+        size_t compressed_size = size;
+        size_t uncompressed_size = pblock.uncompressed_size();
+        if (!pblock.has_uncompressed_size()) {
+            // The blocks of the senders not setting the uncompressed size are always snappy.
+            bool success = snappy::GetUncompressedLength(compressed_data, compressed_size,
+                                                         &uncompressed_size);
+            DCHECK(success) << "snappy::GetUncompressedLength failed";
+        }
         compression_scratch.resize(uncompressed_size);
-        success =
-                snappy::RawUncompress(compressed_data, compressed_size, compression_scratch.data());
-        DCHECK(success) << "snappy::RawUncompress failed";
+        Slice uncompressed_slice(compression_scratch);
+        BlockCompressionCodec* codec = nullptr;
+        Status st = get_thread_local_codec(pblock.compression_type(), &codec);
+        DCHECK(st.ok() && codec != nullptr) << "no codec for " << pblock.compression_type();
+        st = codec->decompress(Slice(compressed_data, compressed_size), &uncompressed_slice);
+        DCHECK(st.ok()) << "decompress failed: " << st.to_string();
         buf = compression_scratch.data();
     } else {
-        buf = pblock.column_values().data();
+        buf = column_values;
     }
 
     for (const auto& pcol_meta : pblock.column_metas()) {
@@ -666,15 +704,10 @@ Status Block::filter_block(Block* block, int filter_column_id, int column_to_kee
 }
 
 Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes,
-                        bool allow_transfer_large_data) const {
+                        bool allow_transfer_large_data,
+                        segment_v2::CompressionTypePB compression_type) const {
     // calc uncompressed size for allocation
-    size_t content_uncompressed_size = 0;
-    for (const auto& c : *this) {
-        PColumnMeta* pcm = pblock->add_column_metas();
-        c.to_pb_column_meta(pcm);
-        // get serialized size
-        content_uncompressed_size += c.type->get_uncompressed_serialized_bytes(*(c.column));
-    }
+    size_t content_uncompressed_size = serialize_column_metas(pblock);
 
     // serialize data values
     // when data type is HLL, content_uncompressed_size maybe larger than real size.
@@ -696,10 +729,14 @@ Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* comp
         buf = c.type->serialize(*(c.column), buf);
     }
     *uncompressed_bytes = content_uncompressed_size;
+    *compressed_bytes = content_uncompressed_size;
 
     // compress
-    if (config::compress_rowbatches && content_uncompressed_size > 0) {
-        size_t max_compressed_size = snappy::MaxCompressedLength(content_uncompressed_size);
+    if (config::compress_rowbatches && content_uncompressed_size > 0 &&
+        compression_type != segment_v2::CompressionTypePB::NO_COMPRESSION) {
+        BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_thread_local_codec(compression_type, &codec));
+        size_t max_compressed_size = codec->max_compressed_len(content_uncompressed_size);
         std::string compression_scratch;
         try {
             // Try compressing the content to compression_scratch,
@@ -714,18 +751,18 @@ Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* comp
             LOG(WARNING) << msg;
             return Status::BufferAllocFailed(msg);
         }
-        size_t compressed_size = 0;
-        char* compressed_output = compression_scratch.data();
-        snappy::RawCompress(column_values->data(), content_uncompressed_size, compressed_output,
-                            &compressed_size);
+        Slice compressed_slice(compression_scratch);
+        RETURN_IF_ERROR(codec->compress(Slice(column_values->data(), content_uncompressed_size),
+                                        &compressed_slice));
+        size_t compressed_size = compressed_slice.size;
 
         if (LIKELY(compressed_size < content_uncompressed_size)) {
             compression_scratch.resize(compressed_size);
             column_values->swap(compression_scratch);
             pblock->set_compressed(true);
+            pblock->set_compression_type(compression_type);
+            pblock->set_uncompressed_size(content_uncompressed_size);
             *compressed_bytes = compressed_size;
-        } else {
-            *compressed_bytes = content_uncompressed_size;
         }
 
         VLOG_ROW << "uncompressed size: " << content_uncompressed_size
@@ -738,6 +775,71 @@ Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* comp
     return Status::OK();
 }
 
+Status Block::serialize(PBlock* pblock, butil::IOBuf* column_values, size_t* uncompressed_bytes,
+                        size_t* compressed_bytes,
+                        segment_v2::CompressionTypePB compression_type) const {
+    size_t content_uncompressed_size = serialize_column_metas(pblock);
+    *uncompressed_bytes = content_uncompressed_size;
+    *compressed_bytes = content_uncompressed_size;
+    if (content_uncompressed_size == 0) {
+        return Status::OK();
+    }
+
+    // The buffers are malloc-ed, so that the attachment can free them once brpc has sent them.
+    std::unique_ptr<char, void (*)(void*)> buf(
+            static_cast<char*>(malloc(content_uncompressed_size)), free);
+    if (buf == nullptr) {
+        return Status::BufferAllocFailed("Try to alloc {} bytes for column values failed",
+                                         content_uncompressed_size);
+    }
+    char* pos = buf.get();
+    for (const auto& c : *this) {
+        pos = c.type->serialize(*(c.column), pos);
+    }
+
+    if (config::compress_rowbatches &&
+        compression_type != segment_v2::CompressionTypePB::NO_COMPRESSION) {
+        BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_thread_local_codec(compression_type, &codec));
+        size_t max_compressed_size = codec->max_compressed_len(content_uncompressed_size);
+        std::unique_ptr<char, void (*)(void*)> compressed_buf(
+                static_cast<char*>(malloc(max_compressed_size)), free);
+        if (compressed_buf == nullptr) {
+            return Status::BufferAllocFailed(
+                    "Try to alloc {} bytes for compression scratch failed", max_compressed_size);
+        }
+        Slice compressed_slice(compressed_buf.get(), max_compressed_size);
+        RETURN_IF_ERROR(
+                codec->compress(Slice(buf.get(), content_uncompressed_size), &compressed_slice));
+
+        if (LIKELY(compressed_slice.size < content_uncompressed_size)) {
+            buf.swap(compressed_buf);
+            pblock->set_compressed(true);
+            pblock->set_compression_type(compression_type);
+            pblock->set_uncompressed_size(content_uncompressed_size);
+            *compressed_bytes = compressed_slice.size;
+        }
+    }
+
+    if (*compressed_bytes >= std::numeric_limits<int32_t>::max()) {
+        return Status::InternalError("The block is large than 2GB({}), can not send by brpc.",
+                                     *compressed_bytes);
+    }
+    column_values->append_user_data(buf.release(), *compressed_bytes, free);
+    return Status::OK();
+}
+
+size_t Block::serialize_column_metas(PBlock* pblock) const {
+    size_t content_uncompressed_size = 0;
+    for (const auto& c : *this) {
+        PColumnMeta* pcm = pblock->add_column_metas();
+        c.to_pb_column_meta(pcm);
+        // get serialized size
+        content_uncompressed_size += c.type->get_uncompressed_serialized_bytes(*(c.column));
+    }
+    return content_uncompressed_size;
+}
+
 void Block::serialize(RowBatch* output_batch, const RowDescriptor& row_desc) {
     auto num_rows = rows();
     auto mem_pool = output_batch->tuple_data_pool();
@@ -38,6 +38,10 @@
 #include "vec/core/names.h"
 #include "vec/data_types/data_type_nullable.h"
 
+namespace butil {
+class IOBuf;
+}
+
 namespace doris {
 
 class MemPool;
@@ -72,6 +76,9 @@ public:
     Block(std::initializer_list<ColumnWithTypeAndName> il);
     Block(const ColumnsWithTypeAndName& data_);
     Block(const PBlock& pblock);
+    // Deserialize a block serialized by serialize(PBlock*, butil::IOBuf*, ...), whose column
+    // values are in 'column_values' instead of 'pblock'.
+    Block(const PBlock& pblock, const butil::IOBuf& column_values);
     Block(const std::vector<SlotDescriptor*>& slots, size_t block_size);
 
     /// insert the column at the specified position
@@ -256,9 +263,19 @@ public:
         }
     }
 
-    // serialize block to PBlock
+    // serialize block to PBlock, the column values are compressed by 'compression_type' unless
+    // config::compress_rowbatches is off or the compressed data would not be smaller.
     Status serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes,
-                     bool allow_transfer_large_data = false) const;
+                     bool allow_transfer_large_data = false,
+                     segment_v2::CompressionTypePB compression_type =
+                             segment_v2::CompressionTypePB::SNAPPY) const;
+
+    // Same as above, but the column values are serialized into a buffer owned by
+    // 'column_values' instead of 'pblock', so that they can be sent as a brpc attachment
+    // without being copied again.
+    Status serialize(PBlock* pblock, butil::IOBuf* column_values, size_t* uncompressed_bytes,
+                     size_t* compressed_bytes,
+                     segment_v2::CompressionTypePB compression_type) const;
 
     // serialize block to PRowbatch
     void serialize(RowBatch*, const RowDescriptor&);
@@ -316,6 +333,11 @@ public:
 private:
     void erase_impl(size_t position);
     void initialize_index_by_name();
+    // Deserialize the columns described by 'pblock' from the 'size' bytes of column values at
+    // 'column_values', which may be compressed.
+    void deserialize_columns(const PBlock& pblock, const char* column_values, size_t size);
+    // Add the column metas to 'pblock' and return the size of the serialized column values.
+    size_t serialize_column_metas(PBlock* pblock) const;
     bool is_column_data_null(const doris::TypeDescriptor& type_desc, const StringRef& data_ref,
                              const IColumn* column_with_type_and_name, int row);
     void deep_copy_slot(void* dst, MemPool* pool, const doris::TypeDescriptor& type_desc,
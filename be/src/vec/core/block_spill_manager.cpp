@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/block_spill_manager.h"
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "util/threadpool.h"
+
+namespace doris::vectorized {
+
+std::atomic<int64_t> BlockSpillManager::_s_spilled_bytes {0};
+
+Status BlockSpillManager::reserve(int64_t bytes) {
+    int64_t spilled = _s_spilled_bytes.fetch_add(bytes) + bytes;
+    int64_t limit = config::spill_storage_limit_bytes;
+    if (limit >= 0 && spilled > limit) {
+        _s_spilled_bytes.fetch_sub(bytes);
+        return Status::InternalError(
+                "spilled data exceeds spill_storage_limit_bytes {}, {} bytes are spilled", limit,
+                spilled - bytes);
+    }
+    return Status::OK();
+}
+
+void BlockSpillManager::release(int64_t bytes) {
+    _s_spilled_bytes.fetch_sub(bytes);
+}
+
+Status SpillIOTask::submit(std::function<Status()> task) {
+    RETURN_IF_ERROR(wait());
+    auto* pool = ExecEnv::GetInstance()->spill_io_thread_pool();
+    if (pool == nullptr) {
+        return task();
+    }
+    _running = true;
+    auto st = pool->submit_func([this, task = std::move(task)]() {
+        auto st = task();
+        std::lock_guard<std::mutex> l(_lock);
+        _status = st;
+        _running = false;
+        _finished.notify_all();
+    });
+    if (!st.ok()) {
+        _running = false;
+    }
+    return st;
+}
+
+Status SpillIOTask::wait() {
+    std::unique_lock<std::mutex> l(_lock);
+    _finished.wait(l, [this] { return !_running; });
+    Status st = _status;
+    _status = Status::OK();
+    return st;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#include "common/status.h"
+
+namespace doris::vectorized {
+
+// BlockSpillManager accounts the spill files of all the queries against
+// spill_storage_limit_bytes. BlockSpillWriter reserves the bytes it writes, and the bytes of a
+// file are released when the file is removed.
+class BlockSpillManager {
+public:
+    // Fails if the spilled data would exceed the limit with 'bytes' more.
+    static Status reserve(int64_t bytes);
+
+    static void release(int64_t bytes);
+
+    static int64_t spilled_bytes() { return _s_spilled_bytes.load(); }
+
+private:
+    static std::atomic<int64_t> _s_spilled_bytes;
+};
+
+// The I/O of a spill file run in the background by the spill I/O thread pool, so that the caller
+// serializes or deserializes the next block meanwhile. There is at most one task at a time, and
+// the tasks run in the caller without the thread pool.
+class SpillIOTask {
+public:
+    SpillIOTask() = default;
+    ~SpillIOTask() { WARN_IF_ERROR(wait(), "failed to run spill I/O task"); }
+
+    // Waits for the previous task, and returns its error instead of running 'task' if it failed.
+    Status submit(std::function<Status()> task);
+
+    // Waits for the task and returns its status, which is cleared.
+    Status wait();
+
+private:
+    std::mutex _lock;
+    std::condition_variable _finished;
+    bool _running = false;
+    Status _status;
+};
+
+} // namespace doris::vectorized
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/block_spill_reader.h"
+
+#include "io/fs/local_file_system.h"
+#include "util/slice.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+BlockSpillReader::~BlockSpillReader() {
+    WARN_IF_ERROR(close(), "failed to close spill reader " + _file_path);
+}
+
+Status BlockSpillReader::open() {
+    return io::global_local_filesystem()->open_file(_file_path, &_file_reader);
+}
+
+Status BlockSpillReader::read(Block* block, bool* eos) {
+    DCHECK(_file_reader);
+    block->clear();
+    RETURN_IF_ERROR(_io.wait());
+    if (_read_ahead) {
+        _read_ahead = false;
+        _read_buffer.swap(_read_ahead_buffer);
+    } else if (_read_offset >= _file_reader->size()) {
+        *eos = true;
+        return Status::OK();
+    } else {
+        RETURN_IF_ERROR(_read_block_data(&_read_buffer));
+    }
+    *eos = false;
+
+    // the next block is read while this one is parsed and consumed
+    if (_read_offset < _file_reader->size()) {
+        _read_ahead = true;
+        RETURN_IF_ERROR(_io.submit([this]() { return _read_block_data(&_read_ahead_buffer); }));
+    }
+
+    PBlock pblock;
+    if (!pblock.ParseFromString(_read_buffer)) {
+        return Status::Corruption("failed to parse spilled block in {}", _file_path);
+    }
+    *block = Block(pblock);
+    return Status::OK();
+}
+
+Status BlockSpillReader::_read_block_data(std::string* buffer) {
+    uint64_t length = 0;
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(_file_reader->read_at(
+            _read_offset, Slice(reinterpret_cast<char*>(&length), sizeof(length)), &bytes_read));
+    if (bytes_read != sizeof(length)) {
+        return Status::Corruption("truncated spill file {}, offset {}", _file_path, _read_offset);
+    }
+    _read_offset += sizeof(length);
+
+    buffer->resize(length);
+    RETURN_IF_ERROR(
+            _file_reader->read_at(_read_offset, Slice(buffer->data(), length), &bytes_read));
+    if (bytes_read != length) {
+        return Status::Corruption("truncated spill file {}, offset {}", _file_path, _read_offset);
+    }
+    _read_offset += length;
+    return Status::OK();
+}
+
+Status BlockSpillReader::close() {
+    if (!_file_reader) {
+        return Status::OK();
+    }
+    WARN_IF_ERROR(_io.wait(), "failed to read spill file " + _file_path);
+    auto file_size = _file_reader->size();
+    auto st = _file_reader->close();
+    _file_reader.reset();
+    if (_delete_after_read) {
+        RETURN_IF_ERROR(io::global_local_filesystem()->delete_file(_file_path));
+        BlockSpillManager::release(file_size);
+    }
+    return st;
+}
+
+} // namespace doris::vectorized
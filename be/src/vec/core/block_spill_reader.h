@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "common/status.h"
+#include "io/fs/file_reader.h"
+#include "vec/core/block_spill_manager.h"
+
+namespace doris {
+namespace vectorized {
+
+class Block;
+
+// Read back the blocks written by BlockSpillWriter, in the order they were written. The next
+// block is read ahead in the background while the caller consumes the current one.
+class BlockSpillReader {
+public:
+    BlockSpillReader(std::string file_path, bool delete_after_read = true)
+            : _file_path(std::move(file_path)), _delete_after_read(delete_after_read) {}
+
+    ~BlockSpillReader();
+
+    Status open();
+
+    // Read the next spilled block, 'eos' is set when all blocks are consumed.
+    Status read(Block* block, bool* eos);
+
+    // Close the file, and remove it if 'delete_after_read' is true.
+    Status close();
+
+    const std::string& file_path() const { return _file_path; }
+
+private:
+    // reads the next block at _read_offset, and moves the offset past it
+    Status _read_block_data(std::string* buffer);
+
+    std::string _file_path;
+    bool _delete_after_read;
+    io::FileReaderSPtr _file_reader;
+    size_t _read_offset = 0;
+    std::string _read_buffer;
+    // the next block if it is read ahead by _io
+    std::string _read_ahead_buffer;
+    bool _read_ahead = false;
+    // last, to wait for the I/O before the members it uses are destroyed
+    SpillIOTask _io;
+};
+
+using BlockSpillReaderUPtr = std::unique_ptr<BlockSpillReader>;
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,139 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/block_spill_writer.h"
+
+#include <atomic>
+
+#include "io/fs/local_file_system.h"
+#include "runtime/exec_env.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/slice.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+BlockSpillWriter::~BlockSpillWriter() {
+    if (!_closed) {
+        WARN_IF_ERROR(abort(), "failed to abort spill writer " + _file_path);
+    }
+}
+
+Status BlockSpillWriter::create(const TUniqueId& query_id, size_t batch_size,
+                                std::unique_ptr<BlockSpillWriter>* writer) {
+    auto* tmp_file_mgr = ExecEnv::GetInstance()->tmp_file_mgr();
+    auto devices = tmp_file_mgr->active_tmp_devices();
+    if (devices.empty()) {
+        return Status::InternalError("no available scratch directory for spilling");
+    }
+    // Spread spill files of different operators over all scratch devices.
+    static std::atomic<uint32_t> next_device {0};
+    auto device_id = devices[next_device.fetch_add(1) % devices.size()];
+
+    TmpFileMgr::File* tmp_file = nullptr;
+    RETURN_IF_ERROR(tmp_file_mgr->get_file(device_id, query_id, &tmp_file));
+    std::unique_ptr<TmpFileMgr::File> tmp_file_holder(tmp_file);
+
+    writer->reset(new BlockSpillWriter(tmp_file->path(), batch_size));
+    return (*writer)->open();
+}
+
+Status BlockSpillWriter::open() {
+    return io::global_local_filesystem()->create_file(_file_path, &_file_writer);
+}
+
+Status BlockSpillWriter::write(const Block& block) {
+    DCHECK(!_closed);
+    auto rows = block.rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+    if (rows <= _batch_size) {
+        return _write_one_block(block);
+    }
+
+    for (size_t start = 0; start < rows; start += _batch_size) {
+        auto length = std::min(_batch_size, rows - start);
+        Columns columns;
+        for (const auto& column : block) {
+            columns.emplace_back(column.column->cut(start, length));
+        }
+        RETURN_IF_ERROR(_write_one_block(block.clone_with_columns(columns)));
+    }
+    return Status::OK();
+}
+
+Status BlockSpillWriter::_write_one_block(const Block& block) {
+    PBlock pblock;
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    RETURN_IF_ERROR(block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes, true,
+                                    segment_v2::CompressionTypePB::LZ4));
+
+    std::string buff;
+    if (!pblock.SerializeToString(&buff)) {
+        return Status::InternalError("failed to serialize spilled block");
+    }
+
+    uint64_t length = buff.size();
+    RETURN_IF_ERROR(BlockSpillManager::reserve(sizeof(length) + length));
+    // the block is appended while the caller serializes the next one
+    RETURN_IF_ERROR(_io.wait());
+    _write_buffer.swap(buff);
+    RETURN_IF_ERROR(_io.submit([this, length]() {
+        Slice slices[2] = {Slice(reinterpret_cast<const char*>(&length), sizeof(length)),
+                           Slice(_write_buffer)};
+        return _file_writer->appendv(slices, 2);
+    }));
+
+    _written_rows += block.rows();
+    _written_bytes += sizeof(length) + length;
+    ++_written_blocks;
+    return Status::OK();
+}
+
+Status BlockSpillWriter::close() {
+    if (_closed) {
+        return Status::OK();
+    }
+    _closed = true;
+    RETURN_IF_ERROR(_io.wait());
+    return _file_writer->close();
+}
+
+Status BlockSpillWriter::abort() {
+    if (!_file_writer) {
+        return Status::OK();
+    }
+    WARN_IF_ERROR(_io.wait(), "failed to write spill file " + _file_path);
+    if (!_closed) {
+        _closed = true;
+        RETURN_IF_ERROR(_file_writer->abort());
+        BlockSpillManager::release(_written_bytes);
+        return Status::OK();
+    }
+    // The file is already closed, it has to be removed explicitly, unless a reader removed it.
+    bool exists = false;
+    RETURN_IF_ERROR(io::global_local_filesystem()->exists(_file_path, &exists));
+    if (exists) {
+        RETURN_IF_ERROR(io::global_local_filesystem()->delete_file(_file_path));
+        BlockSpillManager::release(_written_bytes);
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
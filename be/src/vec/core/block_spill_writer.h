@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+#include "io/fs/file_writer.h"
+#include "vec/core/block_spill_manager.h"
+
+namespace doris {
+namespace vectorized {
+
+class Block;
+
+// BlockSpillWriter appends blocks to a local scratch file so that an operator can release
+// the memory they hold and read them back later through BlockSpillReader.
+//
+// Every block is stored as a length prefixed, serialized PBlock compressed by LZ4. Blocks larger
+// than 'batch_size' rows are split so that the reader never has to materialize more than one
+// batch at a time. A block is appended in the background while the next one is serialized, and
+// its bytes are reserved from the spill quota of BlockSpillManager.
+class BlockSpillWriter {
+public:
+    BlockSpillWriter(std::string file_path, size_t batch_size)
+            : _file_path(std::move(file_path)), _batch_size(batch_size) {}
+
+    ~BlockSpillWriter();
+
+    // Create a writer whose file lives in one of the scratch directories of TmpFileMgr.
+    static Status create(const TUniqueId& query_id, size_t batch_size,
+                         std::unique_ptr<BlockSpillWriter>* writer);
+
+    Status open();
+
+    Status write(const Block& block);
+
+    // Flush and close the file, it can be read by BlockSpillReader afterwards.
+    Status close();
+
+    // Remove the file from disk, no matter whether it is closed or not.
+    Status abort();
+
+    const std::string& file_path() const { return _file_path; }
+
+    int64_t written_rows() const { return _written_rows; }
+
+    int64_t written_bytes() const { return _written_bytes; }
+
+    int64_t written_blocks() const { return _written_blocks; }
+
+private:
+    Status _write_one_block(const Block& block);
+
+    std::string _file_path;
+    size_t _batch_size;
+    io::FileWriterPtr _file_writer;
+    bool _closed = false;
+
+    int64_t _written_rows = 0;
+    int64_t _written_bytes = 0;
+    int64_t _written_blocks = 0;
+
+    // the block being appended by _io
+    std::string _write_buffer;
+    // last, to wait for the I/O before the members it uses are destroyed
+    SpillIOTask _io;
+};
+
+using BlockSpillWriterUPtr = std::unique_ptr<BlockSpillWriter>;
+
+} // namespace vectorized
+} // namespace doris
@@ -22,7 +22,11 @@
 
 #include <pdqsort.h>
 
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/radix_sort.h"
 #include "vec/common/typeid_cast.h"
 
 namespace doris::vectorized {
@@ -65,6 +69,188 @@ struct PartialSortingLess {
     }
 };
 
+// When all the sort columns are integers, decimals or dates, the sort keys of a row are normalized
+// into one unsigned integer whose order is the order of the rows, so that the rows are sorted by
+// comparing integers rather than by a compare_at of every column. Each column takes the bits of its
+// value, with the sign bit flipped for signed types and all bits inverted for descending columns,
+// after one bit that puts the NULLs before or after the values when it is nullable.
+namespace {
+
+template <size_t size>
+struct UnsignedOfSize;
+template <>
+struct UnsignedOfSize<1> {
+    using Type = UInt8;
+};
+template <>
+struct UnsignedOfSize<2> {
+    using Type = UInt16;
+};
+template <>
+struct UnsignedOfSize<4> {
+    using Type = UInt32;
+};
+template <>
+struct UnsignedOfSize<8> {
+    using Type = UInt64;
+};
+template <>
+struct UnsignedOfSize<16> {
+    using Type = unsigned __int128;
+};
+
+template <typename T>
+T native_value(T value) {
+    return value;
+}
+
+template <typename T>
+T native_value(const Decimal<T>& value) {
+    return value.value;
+}
+
+template <typename ColumnType, typename Func>
+bool visit_if(const IColumn& column, Func& func) {
+    if (const auto* typed = check_and_get_column<ColumnType>(column)) {
+        func(typed->get_data());
+        return true;
+    }
+    return false;
+}
+
+// calls func with the data of the column if it is a column of fixed width values that compare
+// by their native values, and returns whether it is one
+template <typename Func>
+bool visit_fixed_column(const IColumn& column, Func&& func) {
+    return visit_if<ColumnUInt8>(column, func) || visit_if<ColumnUInt16>(column, func) ||
+           visit_if<ColumnUInt32>(column, func) || visit_if<ColumnUInt64>(column, func) ||
+           visit_if<ColumnInt8>(column, func) || visit_if<ColumnInt16>(column, func) ||
+           visit_if<ColumnInt32>(column, func) || visit_if<ColumnInt64>(column, func) ||
+           visit_if<ColumnInt128>(column, func) ||
+           visit_if<ColumnDecimal<Decimal32>>(column, func) ||
+           visit_if<ColumnDecimal<Decimal64>>(column, func) ||
+           visit_if<ColumnDecimal<Decimal128>>(column, func);
+}
+
+template <typename Key>
+struct NormalizedKeyWithIndex {
+    Key key;
+    UInt32 index;
+};
+
+template <typename Key>
+struct NormalizedKeyRadixSortTraits : RadixSortUIntTraits<Key> {
+    using Element = NormalizedKeyWithIndex<Key>;
+    static Key& extract_key(Element& element) { return element.key; }
+};
+
+template <typename Key>
+void normalize_keys(const ColumnsWithSortDescriptions& columns, size_t rows,
+                    PaddedPODArray<NormalizedKeyWithIndex<Key>>& keys) {
+    keys.resize(rows);
+    for (UInt32 i = 0; i < rows; ++i) {
+        keys[i] = {0, i};
+    }
+    for (const auto& [column, description] : columns) {
+        const NullMap* null_map = nullptr;
+        const IColumn* nested = column;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            null_map = &nullable->get_null_map_data();
+            nested = &nullable->get_nested_column();
+        }
+        const bool nulls_greater = description.direction * description.nulls_direction > 0;
+        const bool descending = description.direction < 0;
+
+        visit_fixed_column(*nested, [&](const auto& data) {
+            using Native = decltype(native_value(data[0]));
+            using Bits = typename UnsignedOfSize<sizeof(Native)>::Type;
+            constexpr size_t value_bits = sizeof(Native) * 8;
+            // a key of several columns is always wider than any one of them
+            if constexpr (value_bits < sizeof(Key) * 8) {
+                const size_t column_bits = value_bits + (null_map != nullptr);
+                constexpr bool is_signed =
+                        std::is_signed_v<Native> || std::is_same_v<Native, Int128>;
+                const Bits sign = is_signed ? Bits(1) << (value_bits - 1) : 0;
+                const Key flag_bit = Key(1) << value_bits;
+                const Key not_null_flag = null_map != nullptr && !nulls_greater ? flag_bit : 0;
+                const Key null_bits = nulls_greater ? flag_bit : 0;
+
+                for (size_t i = 0; i < rows; ++i) {
+                    Key bits;
+                    if (null_map != nullptr && (*null_map)[i]) {
+                        bits = null_bits;
+                    } else {
+                        Bits value = static_cast<Bits>(native_value(data[i])) ^ sign;
+                        bits = Key(descending ? Bits(~value) : value) | not_null_flag;
+                    }
+                    keys[i].key = (keys[i].key << column_bits) | bits;
+                }
+            } else {
+                DCHECK(false) << "a sort key column is as wide as the normalized key";
+            }
+        });
+    }
+}
+
+template <typename Key>
+void sort_normalized_keys(const ColumnsWithSortDescriptions& columns, size_t rows, UInt64 limit,
+                          IColumn::Permutation& perm) {
+    PaddedPODArray<NormalizedKeyWithIndex<Key>> keys;
+    normalize_keys(columns, rows, keys);
+
+    auto less = [](const NormalizedKeyWithIndex<Key>& lhs, const NormalizedKeyWithIndex<Key>& rhs) {
+        return lhs.key < rhs.key;
+    };
+    if (limit) {
+        std::partial_sort(keys.begin(), keys.begin() + limit, keys.end(), less);
+    } else if (std::is_same_v<Key, UInt64> && rows >= 256) {
+        if constexpr (std::is_same_v<Key, UInt64>) {
+            RadixSort<NormalizedKeyRadixSortTraits<Key>>::execute_lsd(keys.data(), rows);
+        }
+    } else {
+        pdqsort(keys.begin(), keys.end(), less);
+    }
+
+    const size_t sorted_rows = limit ? limit : rows;
+    for (size_t i = 0; i < sorted_rows; ++i) {
+        perm[i] = keys[i].index;
+    }
+}
+
+// sorts perm by the normalized keys of the columns, and returns false if they can not be normalized
+bool sort_by_normalized_keys(const ColumnsWithSortDescriptions& columns, size_t rows, UInt64 limit,
+                             IColumn::Permutation& perm) {
+    if (rows > std::numeric_limits<UInt32>::max()) {
+        return false;
+    }
+    size_t key_bits = 0;
+    for (const auto& [column, description] : columns) {
+        const IColumn* nested = column;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            nested = &nullable->get_nested_column();
+            key_bits += 1;
+        }
+        size_t value_bits = 0;
+        if (!visit_fixed_column(*nested, [&](const auto& data) {
+                value_bits = sizeof(decltype(native_value(data[0]))) * 8;
+            })) {
+            return false;
+        }
+        key_bits += value_bits;
+    }
+
+    if (key_bits <= 64) {
+        sort_normalized_keys<UInt64>(columns, rows, limit, perm);
+    } else if (key_bits <= 128) {
+        sort_normalized_keys<unsigned __int128>(columns, rows, limit, perm);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 void sort_block(Block& block, const SortDescription& description, UInt64 limit) {
     if (!block) {
         return;
@@ -99,7 +285,7 @@ void sort_block(Block& block, const SortDescription& description, UInt64 limit)
 
         ColumnsWithSortDescriptions columns_with_sort_desc =
                 get_columns_with_sort_description(block, description);
-        {
+        if (!sort_by_normalized_keys(columns_with_sort_desc, size, limit, perm)) {
             PartialSortingLess less(columns_with_sort_desc);
 
             if (limit) {
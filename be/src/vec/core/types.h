@@ -77,6 +77,7 @@ enum class TypeIndex {
     DateV2,
     DateTimeV2,
     TimeV2,
+    FixedLengthObject,
 };
 
 struct Consted {
@@ -447,6 +448,8 @@ inline const char* getTypeName(TypeIndex idx) {
         return TypeName<BitmapValue>::get();
     case TypeIndex::HLL:
         return TypeName<HyperLogLog>::get();
+    case TypeIndex::FixedLengthObject:
+        return "FixedLengthObject";
     }
 
     __builtin_unreachable();
@@ -139,6 +139,8 @@ PGenericType_TypeId IDataType::get_pdata_type(const IDataType* data_type) {
         return PGenericType::BITMAP;
     case TypeIndex::HLL:
         return PGenericType::HLL;
+    case TypeIndex::FixedLengthObject:
+        return PGenericType::FIXEDLENGTHOBJECT;
     case TypeIndex::Array:
         return PGenericType::LIST;
     default:
@@ -20,6 +20,7 @@
 
 #include "vec/data_types/data_type_factory.hpp"
 
+#include "vec/data_types/data_type_fixed_length_object.h"
 #include "vec/data_types/data_type_hll.h"
 
 namespace doris::vectorized {
@@ -267,6 +268,9 @@ DataTypePtr DataTypeFactory::create_data_type(const PColumnMeta& pcolumn) {
     case PGenericType::HLL:
         nested = std::make_shared<DataTypeHLL>();
         break;
+    case PGenericType::FIXEDLENGTHOBJECT:
+        nested = std::make_shared<DataTypeFixedLengthObject>();
+        break;
     case PGenericType::LIST:
         DCHECK(pcolumn.children_size() == 1);
         nested = std::make_shared<DataTypeArray>(create_data_type(pcolumn.children(0)));
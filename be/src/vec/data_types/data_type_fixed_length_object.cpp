@@ -0,0 +1,60 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/data_types/data_type_fixed_length_object.h"
+
+#include "vec/common/assert_cast.h"
+
+namespace doris::vectorized {
+
+// <item count> | <item size> | <items>
+char* DataTypeFixedLengthObject::serialize(const IColumn& column, char* buf) const {
+    auto ptr = column.convert_to_full_column_if_const();
+    const auto& data_column = assert_cast<const ColumnType&>(*ptr);
+
+    *reinterpret_cast<size_t*>(buf) = data_column.size();
+    buf += sizeof(size_t);
+    *reinterpret_cast<size_t*>(buf) = data_column.item_size();
+    buf += sizeof(size_t);
+    size_t bytes = data_column.byte_size();
+    if (bytes > 0) {
+        memcpy(buf, data_column.get_data().data(), bytes);
+    }
+    return buf + bytes;
+}
+
+const char* DataTypeFixedLengthObject::deserialize(const char* buf, IColumn* column) const {
+    auto& data_column = assert_cast<ColumnType&>(*column);
+
+    size_t row_num = *reinterpret_cast<const size_t*>(buf);
+    buf += sizeof(size_t);
+    size_t item_size = *reinterpret_cast<const size_t*>(buf);
+    buf += sizeof(size_t);
+    data_column.set_item_size(item_size);
+    data_column.resize(row_num);
+    size_t bytes = row_num * item_size;
+    if (bytes > 0) {
+        memcpy(data_column.get_data().data(), buf, bytes);
+    }
+    return buf + bytes;
+}
+
+int64_t DataTypeFixedLengthObject::get_uncompressed_serialized_bytes(const IColumn& column) const {
+    return sizeof(size_t) * 2 + column.byte_size();
+}
+
+} // namespace doris::vectorized
@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include "exec/arrow/orc_reader.h"
 #include "exec/arrow/parquet_reader.h"
 #include "io/buffered_reader.h"
 #include "io/file_factory.h"
@@ -45,6 +46,51 @@ FileArrowScanner::~FileArrowScanner() {
     FileArrowScanner::close();
 }
 
+Status FileArrowScanner::read_file_schema(ExecEnv* env, const TFileScanRangeParams& params,
+                                          const TFileRangeDesc& range,
+                                          std::vector<std::string>* names,
+                                          std::vector<TypeDescriptor>* types) {
+    RuntimeProfile profile("FileSchemaReader");
+    std::unique_ptr<FileReader> file_reader;
+    RETURN_IF_ERROR(FileFactory::create_file_reader(env, &profile, params, range, file_reader));
+    RETURN_IF_ERROR(file_reader->open());
+    std::unique_ptr<ArrowReaderWrap> reader;
+    switch (params.format_type) {
+    case TFileFormatType::FORMAT_PARQUET:
+        reader.reset(new ParquetReaderWrap(file_reader.release(), 0, 0, 0, -1));
+        break;
+    case TFileFormatType::FORMAT_ORC:
+        reader.reset(new ORCReaderWrap(file_reader.release(), 0, 0));
+        break;
+    default:
+        return Status::NotSupported("The schema of file {} can't be read, format type: {}",
+                                    range.path, static_cast<int>(params.format_type));
+    }
+    std::shared_ptr<arrow::Schema> schema;
+    RETURN_IF_ERROR(reader->read_schema(&schema));
+    for (int i = 0; i < schema->num_fields(); ++i) {
+        auto& field = schema->field(i);
+        PrimitiveType type = arrow_type_to_primitive_type(field->type()->id());
+        if (type == INVALID_TYPE) {
+            VLOG_NOTICE << "skip column " << field->name() << " of file " << range.path
+                        << ", type not supported: " << field->type()->ToString();
+            continue;
+        }
+        TypeDescriptor type_desc;
+        if (type == TYPE_VARCHAR) {
+            // the length of the strings in the file is unknown
+            type_desc = TypeDescriptor::create_string_type();
+        } else if (type == TYPE_DECIMALV2) {
+            type_desc = TypeDescriptor::create_decimalv2_type(27, 9);
+        } else {
+            type_desc = TypeDescriptor(type);
+        }
+        names->push_back(field->name());
+        types->push_back(type_desc);
+    }
+    return Status::OK();
+}
+
 Status FileArrowScanner::_open_next_reader() {
     // open_file_reader
     if (_cur_file_reader != nullptr) {
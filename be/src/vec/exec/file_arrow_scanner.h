@@ -30,6 +30,7 @@
 
 #include "common/status.h"
 #include "exec/base_scanner.h"
+#include "runtime/types.h"
 #include "util/runtime_profile.h"
 #include "vec/exec/file_scanner.h"
 
@@ -51,6 +52,13 @@ public:
 
     void close() override;
 
+    // Reads the names and the types of the columns in the footer of the parquet or orc file of
+    // range, for the table valued functions on files. The columns of the types not supported
+    // are skipped.
+    static Status read_file_schema(ExecEnv* env, const TFileScanRangeParams& params,
+                                   const TFileRangeDesc& range, std::vector<std::string>* names,
+                                   std::vector<TypeDescriptor>* types);
+
 protected:
     virtual ArrowReaderWrap* _new_arrow_reader(FileReader* file_reader, int64_t batch_size,
                                                int32_t num_of_columns_from_file,
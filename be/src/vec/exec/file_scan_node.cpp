@@ -17,6 +17,9 @@
 
 #include "vec/exec/file_scan_node.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "common/config.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/memory/mem_tracker.h"
@@ -206,23 +209,21 @@ Status FileScanNode::_acquire_and_build_runtime_filter(RuntimeState* state) {
 Status FileScanNode::start_scanners() {
     {
         std::unique_lock<std::mutex> l(_batch_queue_lock);
-        _num_running_scanners = _scan_ranges.size();
+        _num_running_scanners = _num_scanner_workers;
     }
 
-    _scanners_status.resize(_scan_ranges.size());
-    COUNTER_UPDATE(_num_scanners, _scan_ranges.size());
+    _scanners_status.resize(_num_scanner_workers);
+    COUNTER_UPDATE(_num_scanners, _num_scanner_workers);
     ThreadPoolToken* thread_token = _runtime_state->get_query_fragments_ctx()->get_token();
     PriorityThreadPool* thread_pool = _runtime_state->exec_env()->scan_thread_pool();
-    for (int i = 0; i < _scan_ranges.size(); ++i) {
+    for (int i = 0; i < _num_scanner_workers; ++i) {
         Status submit_status = Status::OK();
         if (thread_token != nullptr) {
             submit_status = thread_token->submit_func(std::bind(&FileScanNode::scanner_worker, this,
-                                                                i, _scan_ranges.size(),
-                                                                std::ref(_scanners_status[i])));
+                                                                i, std::ref(_scanners_status[i])));
         } else {
-            PriorityThreadPool::WorkFunction task =
-                    std::bind(&FileScanNode::scanner_worker, this, i, _scan_ranges.size(),
-                              std::ref(_scanners_status[i]));
+            PriorityThreadPool::WorkFunction task = std::bind(&FileScanNode::scanner_worker, this,
+                                                              i, std::ref(_scanners_status[i]));
             if (!thread_pool->offer(task)) {
                 submit_status = Status::Cancelled("Failed to submit scan task");
             }
@@ -231,13 +232,13 @@ Status FileScanNode::start_scanners() {
             LOG(WARNING) << "Failed to assign file scanner task to thread pool! "
                          << submit_status.get_error_msg();
             _scanners_status[i].set_value(submit_status);
-            for (int j = i + 1; j < _scan_ranges.size(); ++j) {
+            for (int j = i + 1; j < _num_scanner_workers; ++j) {
                 _scanners_status[j].set_value(Status::Cancelled("Cancelled"));
             }
             {
                 std::lock_guard<std::mutex> l(_batch_queue_lock);
                 update_status(submit_status);
-                _num_running_scanners -= _scan_ranges.size() - i;
+                _num_running_scanners -= _num_scanner_workers - i;
             }
             _queue_writer_cond.notify_all();
             break;
@@ -430,15 +431,28 @@ Status FileScanNode::scanner_scan(const TFileScanRange& scan_range, ScannerCount
     return Status::OK();
 }
 
-void FileScanNode::scanner_worker(int start_idx, int length, std::promise<Status>& p_status) {
+bool FileScanNode::next_split(TFileScanRange* split) {
+    std::lock_guard<std::mutex> l(_splits_lock);
+    if (_splits.empty()) {
+        return false;
+    }
+    *split = std::move(_splits.front());
+    _splits.pop_front();
+    return true;
+}
+
+void FileScanNode::scanner_worker(int worker_idx, std::promise<Status>& p_status) {
     Thread::set_self_name("file_scanner");
     Status status = Status::OK();
     ScannerCounter counter;
-    const TFileScanRange& scan_range =
-            _scan_ranges[start_idx].scan_range.ext_scan_range.file_scan_range;
-    status = scanner_scan(scan_range, &counter);
+    // scan the splits left until all of them are taken, so the workers finishing early help
+    // with the splits of the large files
+    TFileScanRange split;
+    while (status.ok() && !_scan_finished.load() && next_split(&split)) {
+        status = scanner_scan(split, &counter);
+    }
     if (!status.ok()) {
-        LOG(WARNING) << "Scanner[" << start_idx
+        LOG(WARNING) << "Scanner[" << worker_idx
                      << "] process failed. status=" << status.get_error_msg();
     }
 
@@ -486,29 +500,60 @@ std::unique_ptr<FileScanner> FileScanNode::create_scanner(const TFileScanRange&
     return scanner;
 }
 
-// This function is called after plan node has been prepared.
-Status FileScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges) {
-    int max_scanners = config::doris_scanner_thread_pool_thread_num;
-    if (scan_ranges.size() <= max_scanners) {
-        _scan_ranges = scan_ranges;
-    } else {
-        // There is no need for the number of scanners to exceed the number of threads in thread pool.
-        _scan_ranges.clear();
-        auto range_iter = scan_ranges.begin();
-        for (int i = 0; i < max_scanners && range_iter != scan_ranges.end(); ++i, ++range_iter) {
-            _scan_ranges.push_back(*range_iter);
+void FileScanNode::split_scan_range(const TFileScanRange& scan_range) {
+    // the text scanner skips the partial first line of a range not at the start of a file, and
+    // the parquet reader reads the row groups starting in its range when it filters row groups
+    int64_t split_size = config::file_scan_split_size_bytes;
+    auto format_type = scan_range.params.format_type;
+    bool splittable = split_size > 0 &&
+                      (format_type == TFileFormatType::FORMAT_CSV_PLAIN ||
+                       (format_type == TFileFormatType::FORMAT_PARQUET &&
+                        config::parquet_predicate_push_down));
+    for (auto& range : scan_range.ranges) {
+        // the size of a range read to the end of its file is unknown, it is not split
+        int64_t num_splits = 1;
+        if (splittable && range.__isset.size && range.size > split_size) {
+            num_splits = (range.size + split_size - 1) / split_size;
         }
-        for (int i = 0; range_iter != scan_ranges.end(); ++i, ++range_iter) {
-            if (i == max_scanners) {
-                i = 0;
+        for (int64_t i = 0; i < num_splits; ++i) {
+            TFileScanRange split;
+            split.__set_params(scan_range.params);
+            TFileRangeDesc split_range = range;
+            if (num_splits > 1) {
+                int64_t start = range.size * i / num_splits;
+                int64_t end = range.size * (i + 1) / num_splits;
+                split_range.__set_start_offset(range.start_offset + start);
+                split_range.__set_size(end - start);
             }
-            auto& ranges = _scan_ranges[i].scan_range.ext_scan_range.file_scan_range.ranges;
-            auto& merged_ranges = range_iter->scan_range.ext_scan_range.file_scan_range.ranges;
-            ranges.insert(ranges.end(), merged_ranges.begin(), merged_ranges.end());
+            split.ranges.push_back(std::move(split_range));
+            split.__isset.ranges = true;
+            _splits.push_back(std::move(split));
         }
-        _scan_ranges.shrink_to_fit();
-        LOG(INFO) << "Merge " << scan_ranges.size() << " scan ranges to " << _scan_ranges.size();
     }
+}
+
+// This function is called after plan node has been prepared.
+Status FileScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges) {
+    _scan_ranges = scan_ranges;
+    for (auto& scan_range : _scan_ranges) {
+        split_scan_range(scan_range.scan_range.ext_scan_range.file_scan_range);
+    }
+    // scan the large splits first, to balance the splits left between the workers at the end
+    std::stable_sort(_splits.begin(), _splits.end(),
+                     [](const TFileScanRange& lhs, const TFileScanRange& rhs) {
+                         auto size = [](const TFileScanRange& split) {
+                             auto& range = split.ranges[0];
+                             return range.__isset.size && range.size >= 0
+                                            ? range.size
+                                            : std::numeric_limits<int64_t>::max();
+                         };
+                         return size(lhs) > size(rhs);
+                     });
+    // There is no need for the number of scanners to exceed the number of threads in thread pool.
+    _num_scanner_workers =
+            std::min<int>(_splits.size(), config::doris_scanner_thread_pool_thread_num);
+    LOG(INFO) << "Split " << scan_ranges.size() << " scan ranges to " << _splits.size()
+              << " splits read by " << _num_scanner_workers << " scanners";
     return Status::OK();
 }
 
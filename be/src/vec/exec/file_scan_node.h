@@ -19,6 +19,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <future>
 #include <map>
 #include <mutex>
@@ -85,7 +86,12 @@ private:
 
     Status start_scanners();
 
-    void scanner_worker(int start_idx, int length, std::promise<Status>& p_status);
+    // Append the splits of the ranges of a scan range to _splits
+    void split_scan_range(const TFileScanRange& scan_range);
+    // Take the next split to scan, return false if there is none left
+    bool next_split(TFileScanRange* split);
+
+    void scanner_worker(int worker_idx, std::promise<Status>& p_status);
     // Scan one range
     Status scanner_scan(const TFileScanRange& scan_range, ScannerCounter* counter);
 
@@ -97,6 +103,12 @@ private:
     std::map<std::string, SlotDescriptor*> _slots_map;
     std::vector<TScanRangeParams> _scan_ranges;
 
+    // the splits not scanned yet, each with one file range, shared by the scanners so that the
+    // splits of a large file are read in parallel
+    std::mutex _splits_lock;
+    std::deque<TFileScanRange> _splits;
+    int _num_scanner_workers = 0;
+
     std::mutex _batch_queue_lock;
     std::condition_variable _queue_reader_cond;
     std::condition_variable _queue_writer_cond;
@@ -30,6 +30,7 @@
 #include "io/buffered_reader.h"
 #include "io/file_factory.h"
 #include "io/hdfs_reader_writer.h"
+#include "util/simd/field_splitter.h"
 #include "util/types.h"
 #include "util/utf8_check.h"
 
@@ -222,55 +223,66 @@ Status FileTextScanner::_split_line(const Slice& line) {
     tmp_split_values.reserve(_num_of_columns_from_file);
 
     const char* value = line.data;
-    size_t start = 0;     // point to the start pos of next col value.
-    size_t curpos = 0;    // point to the start pos of separator matching sequence.
-    size_t p1 = 0;        // point to the current pos of separator matching sequence.
-    size_t non_space = 0; // point to the last pos of non_space charactor.
-
-    // Separator: AAAA
-    //
-    //    p1
-    //     ▼
-    //     AAAA
-    //   1000AAAA2000AAAA
-    //   ▲   ▲
-    // Start │
-    //     curpos
-
-    while (curpos < line.size) {
-        if (*(value + curpos + p1) != _value_separator[p1]) {
-            // Not match, move forward:
-            curpos += (p1 == 0 ? 1 : p1);
-            p1 = 0;
-        } else {
-            p1++;
-            if (p1 == _value_separator_length) {
-                // Match a separator
-                non_space = curpos;
-                // Trim tailing spaces. Be consistent with hive and trino's behavior.
-                if (_state->trim_tailing_spaces_for_external_table_query()) {
-                    while (non_space > start && *(value + non_space - 1) == ' ') {
-                        non_space--;
+    if (_value_separator_length == 1) {
+        bool trim_tailing_spaces = _state->trim_tailing_spaces_for_external_table_query();
+        simd::split_by_char(value, line.size, _value_separator[0], [&](size_t start, size_t end) {
+            // Trim tailing spaces. Be consistent with hive and trino's behavior.
+            while (trim_tailing_spaces && end > start && *(value + end - 1) == ' ') {
+                end--;
+            }
+            tmp_split_values.emplace_back(value + start, end - start);
+        });
+    } else {
+        size_t start = 0;     // point to the start pos of next col value.
+        size_t curpos = 0;    // point to the start pos of separator matching sequence.
+        size_t p1 = 0;        // point to the current pos of separator matching sequence.
+        size_t non_space = 0; // point to the last pos of non_space charactor.
+
+        // Separator: AAAA
+        //
+        //    p1
+        //     ▼
+        //     AAAA
+        //   1000AAAA2000AAAA
+        //   ▲   ▲
+        // Start │
+        //     curpos
+
+        while (curpos < line.size) {
+            if (*(value + curpos + p1) != _value_separator[p1]) {
+                // Not match, move forward:
+                curpos += (p1 == 0 ? 1 : p1);
+                p1 = 0;
+            } else {
+                p1++;
+                if (p1 == _value_separator_length) {
+                    // Match a separator
+                    non_space = curpos;
+                    // Trim tailing spaces. Be consistent with hive and trino's behavior.
+                    if (_state->trim_tailing_spaces_for_external_table_query()) {
+                        while (non_space > start && *(value + non_space - 1) == ' ') {
+                            non_space--;
+                        }
                     }
+                    tmp_split_values.emplace_back(value + start, non_space - start);
+                    start = curpos + _value_separator_length;
+                    curpos = start;
+                    p1 = 0;
+                    non_space = 0;
                 }
-                tmp_split_values.emplace_back(value + start, non_space - start);
-                start = curpos + _value_separator_length;
-                curpos = start;
-                p1 = 0;
-                non_space = 0;
             }
         }
-    }
 
-    CHECK(curpos == line.size) << curpos << " vs " << line.size;
-    non_space = curpos;
-    if (_state->trim_tailing_spaces_for_external_table_query()) {
-        while (non_space > start && *(value + non_space - 1) == ' ') {
-            non_space--;
+        CHECK(curpos == line.size) << curpos << " vs " << line.size;
+        non_space = curpos;
+        if (_state->trim_tailing_spaces_for_external_table_query()) {
+            while (non_space > start && *(value + non_space - 1) == ' ') {
+                non_space--;
+            }
         }
-    }
 
-    tmp_split_values.emplace_back(value + start, non_space - start);
+        tmp_split_values.emplace_back(value + start, non_space - start);
+    }
     for (const auto& slot : _file_slot_descs) {
         auto it = _file_slot_index_map.find(slot->id());
         if (it == std::end(_file_slot_index_map)) {
@@ -67,10 +67,16 @@ struct RowRefList : RowRef {
     class ForwardIterator {
     public:
         ForwardIterator(RowRefList* begin)
-                : root(begin), first(true), batch(root->next), position(0) {}
+                : root(begin),
+                  first(true),
+                  batch(root->compacted ? nullptr : root->next),
+                  rows(root->compacted ? root->rows : nullptr),
+                  rows_size(root->row_count - 1),
+                  position(0) {}
 
         RowRef& operator*() {
             if (first) return *root;
+            if (rows) return rows[position];
             return batch->row_refs[position];
         }
         RowRef* operator->() { return &(**this); }
@@ -82,7 +88,7 @@ struct RowRefList : RowRef {
             if (first && rhs.first) {
                 return true;
             }
-            return batch == rhs.batch && position == rhs.position;
+            return batch == rhs.batch && rows == rhs.rows && position == rhs.position;
         }
         bool operator!=(const ForwardIterator& rhs) const { return !(*this == rhs); }
 
@@ -92,7 +98,13 @@ struct RowRefList : RowRef {
                 return;
             }
 
-            if (batch) {
+            if (rows) {
+                ++position;
+                if (position >= rows_size) {
+                    rows = nullptr;
+                    position = 0;
+                }
+            } else if (batch) {
                 ++position;
                 if (position >= batch->size) {
                     batch = batch->next;
@@ -101,7 +113,7 @@ struct RowRefList : RowRef {
             }
         }
 
-        bool ok() const { return first || batch; }
+        bool ok() const { return first || batch || rows; }
 
         static ForwardIterator end() { return ForwardIterator(); }
 
@@ -109,9 +121,18 @@ struct RowRefList : RowRef {
         RowRefList* root;
         bool first;
         Batch* batch;
+        // the rows after the first one of a compacted list
+        RowRef* rows;
+        size_t rows_size;
         size_t position;
 
-        ForwardIterator() : root(nullptr), first(false), batch(nullptr), position(0) {}
+        ForwardIterator()
+                : root(nullptr),
+                  first(false),
+                  batch(nullptr),
+                  rows(nullptr),
+                  rows_size(0),
+                  position(0) {}
     };
 
     RowRefList() {}
@@ -122,6 +143,7 @@ struct RowRefList : RowRef {
 
     /// insert element after current one
     void insert(RowRef&& row_ref, Arena& pool) {
+        DCHECK(!compacted);
         row_count++;
 
         if (!next) {
@@ -133,9 +155,35 @@ struct RowRefList : RowRef {
 
     uint32_t get_row_count() { return row_count; }
 
+    /// Copies the rows of the batches into one array in the order they are iterated, so that the
+    /// rows of a key with many duplicates are read from contiguous memory instead of chasing the
+    /// batches. Nothing can be inserted into the list afterwards. The lists that fit in a single
+    /// batch are contiguous already and left as they are.
+    void compact(Arena& pool) {
+        if (compacted || row_count <= Batch::MAX_SIZE + 1) {
+            return;
+        }
+        auto* compacted_rows = reinterpret_cast<RowRef*>(
+                pool.aligned_alloc(sizeof(RowRef) * (row_count - 1), alignof(RowRef)));
+        size_t size = 0;
+        for (auto* batch = next; batch; batch = batch->next) {
+            for (size_t i = 0; i < batch->size; ++i) {
+                compacted_rows[size++] = batch->row_refs[i];
+            }
+        }
+        DCHECK_EQ(size, row_count - 1);
+        rows = compacted_rows;
+        compacted = true;
+    }
+
 private:
-    Batch* next = nullptr;
+    union {
+        Batch* next = nullptr;
+        // the rows after the first one once the list is compacted
+        RowRef* rows;
+    };
     uint32_t row_count = 1;
+    bool compacted = false;
 };
 
 } // namespace doris::vectorized
@@ -17,11 +17,13 @@
 
 #include "vec/exec/join/vhash_join_node.h"
 
+#include "common/config.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "util/defer_op.h"
+#include "vec/common/sip_hash.h"
 #include "vec/core/materialize_block.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/exprs/vexpr.h"
@@ -40,17 +42,20 @@ std::variant<std::false_type, std::true_type> static inline make_bool_variant(bo
 }
 
 using ProfileCounter = RuntimeProfile::Counter;
+
 template <class HashTableContext>
 struct ProcessHashTableBuild {
     ProcessHashTableBuild(int rows, Block& acquired_block, ColumnRawPtrs& build_raw_ptrs,
-                          HashJoinNode* join_node, int batch_size, uint8_t offset)
+                          HashJoinNode* join_node, int batch_size, uint8_t offset,
+                          RuntimeState* state)
             : _rows(rows),
               _skip_rows(0),
               _acquired_block(acquired_block),
               _build_raw_ptrs(build_raw_ptrs),
               _join_node(join_node),
               _batch_size(batch_size),
-              _offset(offset) {}
+              _offset(offset),
+              _state(state) {}
 
     template <bool ignore_null, bool build_unique, bool has_runtime_filter>
     void run(HashTableContext& hash_table_ctx, ConstNullMapPtr null_map) {
@@ -65,9 +70,18 @@ struct ProcessHashTableBuild {
             COUNTER_SET(_join_node->_build_buckets_counter, bucket_size);
         }};
 
+        SCOPED_TIMER(_join_node->_build_table_insert_timer);
+        if (hash_table_ctx.hash_table.get_partition_count() > 1) {
+            hash_table_ctx.hash_table.reset_resize_timer();
+            _run_in_parallel<ignore_null, build_unique, has_runtime_filter>(hash_table_ctx,
+                                                                            null_map);
+            COUNTER_UPDATE(_join_node->_build_table_expanse_timer,
+                           hash_table_ctx.hash_table.get_resize_timer_value());
+            return;
+        }
+
         KeyGetter key_getter(_build_raw_ptrs, _join_node->_build_key_sz, nullptr);
 
-        SCOPED_TIMER(_join_node->_build_table_insert_timer);
         // only not build_unique, we need expanse hash table before insert data
         if constexpr (!build_unique) {
             // _rows contains null row, which will cause hash table resize to be large.
@@ -75,11 +89,20 @@ struct ProcessHashTableBuild {
         }
         hash_table_ctx.hash_table.reset_resize_timer();
 
-        vector<int>& inserted_rows = _join_node->_inserted_rows[&_acquired_block];
+        vector<int>& inserted_rows = (*_join_node->_inserted_rows)[&_acquired_block];
         if constexpr (has_runtime_filter) {
             inserted_rows.reserve(_batch_size);
         }
 
+        // The keys are hashed in one pass first, and the inserts prefetch the cells of the keys
+        // ahead of them. Fixed keys are packed a column at a time before.
+        std::vector<typename HashTableContext::HashTable::key_type> keys;
+        if constexpr (ColumnsHashing::IsKeysFixedHashMethodTraits<KeyGetter>::value) {
+            keys.resize(_rows);
+            key_getter.pack_keys(0, _rows, keys.data());
+        }
+        key_getter.init_hash_values(hash_table_ctx.hash_table, 0, _rows, *_join_node->_arena);
+
         for (size_t k = 0; k < _rows; ++k) {
             if constexpr (ignore_null) {
                 if ((*null_map)[k]) {
@@ -87,11 +110,8 @@ struct ProcessHashTableBuild {
                 }
             }
 
-            auto emplace_result =
-                    key_getter.emplace_key(hash_table_ctx.hash_table, k, _join_node->_arena);
-            if (k + 1 < _rows) {
-                key_getter.prefetch(hash_table_ctx.hash_table, k + 1, _join_node->_arena);
-            }
+            auto emplace_result = key_getter.emplace_key_batched(hash_table_ctx.hash_table, k,
+                                                                 *_join_node->_arena);
 
             if (emplace_result.is_inserted()) {
                 new (&emplace_result.get_mapped()) Mapped({k, _offset});
@@ -101,7 +121,7 @@ struct ProcessHashTableBuild {
             } else {
                 if constexpr (!build_unique) {
                     /// The first element of the list is stored in the value of the hash table, the rest in the pool.
-                    emplace_result.get_mapped().insert({k, _offset}, _join_node->_arena);
+                    emplace_result.get_mapped().insert({k, _offset}, *_join_node->_arena);
                     if constexpr (has_runtime_filter) {
                         inserted_rows.push_back(k);
                     }
@@ -125,6 +145,117 @@ struct ProcessHashTableBuild {
     };
 
 private:
+    // Every partition of the hash table is filled by its own thread with the rows whose keys
+    // hash to it, so the threads never touch the same sub-table or arena.
+    template <bool ignore_null, bool build_unique, bool has_runtime_filter>
+    void _run_in_parallel(HashTableContext& hash_table_ctx, ConstNullMapPtr null_map) {
+        using KeyGetter = typename HashTableContext::State;
+        using Mapped = typename HashTableContext::Mapped;
+
+        auto& hash_table = hash_table_ctx.hash_table;
+        const size_t partition_count = hash_table.get_partition_count();
+        DCHECK_EQ(partition_count, _join_node->_build_arenas.size());
+
+        auto run_in_threads = [&](auto&& func) {
+            std::vector<std::thread> threads;
+            threads.reserve(partition_count);
+            for (size_t i = 0; i < partition_count; ++i) {
+                threads.emplace_back([&, i]() {
+                    SCOPED_ATTACH_TASK(_state);
+                    func(i);
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        };
+
+        // Find out the partition of every row, each thread hashes a range of the rows. The
+        // hashes are kept for the inserts, and so are the keys when they are packed.
+        std::vector<uint8_t> row_partitions(_rows);
+        std::vector<size_t> hash_values(_rows);
+        std::vector<typename HashTableContext::HashTable::key_type> keys;
+        if constexpr (ColumnsHashing::IsKeysFixedHashMethodTraits<KeyGetter>::value) {
+            keys.resize(_rows);
+        }
+        std::vector<std::vector<size_t>> partition_rows(partition_count,
+                                                        std::vector<size_t>(partition_count));
+        const size_t range_size = (_rows + partition_count - 1) / partition_count;
+        run_in_threads([&](size_t thread_index) {
+            KeyGetter key_getter(_build_raw_ptrs, _join_node->_build_key_sz, nullptr);
+            // serialized keys are only written here to be hashed
+            Arena arena;
+            auto& rows = partition_rows[thread_index];
+            const size_t begin = std::min<size_t>(_rows, thread_index * range_size);
+            const size_t end = std::min<size_t>(_rows, (thread_index + 1) * range_size);
+            if constexpr (ColumnsHashing::IsKeysFixedHashMethodTraits<KeyGetter>::value) {
+                key_getter.pack_keys(begin, end, keys.data() + begin);
+            }
+            for (size_t k = begin; k < end; ++k) {
+                if constexpr (ignore_null) {
+                    if ((*null_map)[k]) {
+                        continue;
+                    }
+                }
+                hash_values[k] = key_getter.get_hash(hash_table, k, arena);
+                auto partition = hash_table.get_partition_from_hash(hash_values[k]);
+                row_partitions[k] = partition;
+                rows[partition]++;
+            }
+        });
+
+        std::vector<std::vector<int>> partition_inserted_rows(partition_count);
+        run_in_threads([&](size_t partition_index) {
+            KeyGetter key_getter(_build_raw_ptrs, _join_node->_build_key_sz, nullptr);
+            if constexpr (ColumnsHashing::IsKeysFixedHashMethodTraits<KeyGetter>::value) {
+                key_getter.set_packed_keys(keys.data());
+            }
+            auto& partition = hash_table.get_partition(partition_index);
+            auto& arena = *_join_node->_build_arenas[partition_index];
+            auto& inserted_rows = partition_inserted_rows[partition_index];
+
+            if constexpr (!build_unique) {
+                size_t rows = 0;
+                for (const auto& thread_rows : partition_rows) {
+                    rows += thread_rows[partition_index];
+                }
+                partition.expanse_for_add_elem(rows);
+            }
+
+            for (size_t k = 0; k < _rows; ++k) {
+                if (row_partitions[k] != partition_index) {
+                    continue;
+                }
+                if constexpr (ignore_null) {
+                    if ((*null_map)[k]) {
+                        continue;
+                    }
+                }
+
+                auto emplace_result =
+                        key_getter.emplace_key_with_hash(partition, hash_values[k], k, arena);
+                if (emplace_result.is_inserted()) {
+                    new (&emplace_result.get_mapped()) Mapped({k, _offset});
+                    if constexpr (has_runtime_filter) {
+                        inserted_rows.push_back(k);
+                    }
+                } else if constexpr (!build_unique) {
+                    emplace_result.get_mapped().insert({k, _offset}, arena);
+                    if constexpr (has_runtime_filter) {
+                        inserted_rows.push_back(k);
+                    }
+                }
+            }
+        });
+
+        if constexpr (has_runtime_filter) {
+            vector<int>& inserted_rows = (*_join_node->_inserted_rows)[&_acquired_block];
+            for (const auto& rows : partition_inserted_rows) {
+                inserted_rows.insert(inserted_rows.end(), rows.begin(), rows.end());
+            }
+        }
+    }
+
     const int _rows;
     int _skip_rows;
     Block& _acquired_block;
@@ -132,6 +263,7 @@ private:
     HashJoinNode* _join_node;
     int _batch_size;
     uint8_t _offset;
+    RuntimeState* _state;
 };
 
 template <class HashTableContext>
@@ -148,12 +280,23 @@ struct ProcessRuntimeFilterBuild {
 
         RETURN_IF_ERROR(runtime_filter_slots.init(state, hash_table_ctx.hash_table.get_size()));
 
-        if (!runtime_filter_slots.empty() && !_join_node->_inserted_rows.empty()) {
+        auto controller = _join_node->_shared_hash_table_controller;
+        if (controller != nullptr && !_join_node->_should_build_hash_table) {
+            // The build exprs of this instance were never executed, so the filters are copied
+            // from the ones the builder built.
+            SCOPED_TIMER(_join_node->_push_compute_timer);
+            RETURN_IF_ERROR(runtime_filter_slots.copy_from_shared_context(
+                    *controller->get_context(_join_node->id()), state->obj_pool()));
+        } else if (!runtime_filter_slots.empty() && !_join_node->_inserted_rows->empty()) {
             {
                 SCOPED_TIMER(_join_node->_push_compute_timer);
-                runtime_filter_slots.insert(_join_node->_inserted_rows);
+                runtime_filter_slots.insert(*_join_node->_inserted_rows);
             }
         }
+        if (controller != nullptr && _join_node->_should_build_hash_table) {
+            RETURN_IF_ERROR(runtime_filter_slots.copy_to_shared_context(
+                    controller->get_context(_join_node->id()).get()));
+        }
         {
             SCOPED_TIMER(_join_node->_push_down_timer);
             runtime_filter_slots.publish();
@@ -172,7 +315,7 @@ struct ProcessHashTableProbe {
             : _join_node(join_node),
               _batch_size(batch_size),
               _probe_rows(probe_rows),
-              _build_blocks(join_node->_build_blocks),
+              _build_blocks(*join_node->_build_blocks),
               _probe_block(join_node->_probe_block),
               _probe_index(join_node->_probe_index),
               _probe_raw_ptrs(join_node->_probe_columns),
@@ -295,6 +438,7 @@ struct ProcessHashTableProbe {
         int right_col_len = _join_node->_right_table_data_types.size();
 
         KeyGetter key_getter(_probe_raw_ptrs, _join_node->_probe_key_sz, nullptr);
+        _init_probe_keys(hash_table_ctx, key_getter);
         auto& mcol = mutable_block.mutable_columns();
         int current_offset = 0;
 
@@ -325,11 +469,9 @@ struct ProcessHashTableProbe {
                 }
                 int last_offset = current_offset;
                 auto find_result = (*null_map)[_probe_index]
-                                           ? decltype(key_getter.find_key(hash_table_ctx.hash_table,
-                                                                          _probe_index,
-                                                                          _arena)) {nullptr, false}
-                                           : key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 _probe_index, _arena);
+                                           ? typename KeyGetter::FindResult {nullptr, false}
+                                           : key_getter.find_key_batched(hash_table_ctx.hash_table,
+                                                                         _probe_index, _arena);
 
                 if constexpr (JoinOpType::value == TJoinOp::LEFT_ANTI_JOIN) {
                     if (!find_result.is_found()) {
@@ -353,11 +495,6 @@ struct ProcessHashTableProbe {
                                 ++current_offset;
                             }
                         } else {
-                            // prefetch is more useful while matching to multiple rows
-                            if (_probe_index + 2 < _probe_rows)
-                                key_getter.prefetch(hash_table_ctx.hash_table, _probe_index + 2,
-                                                    _arena);
-
                             for (auto it = mapped.begin(); it.ok(); ++it) {
                                 if constexpr (!is_right_semi_anti_join) {
                                     if (current_offset < _batch_size) {
@@ -415,6 +552,7 @@ struct ProcessHashTableProbe {
         using KeyGetter = typename HashTableContext::State;
         using Mapped = typename HashTableContext::Mapped;
         KeyGetter key_getter(_probe_raw_ptrs, _join_node->_probe_key_sz, nullptr);
+        _init_probe_keys(hash_table_ctx, key_getter);
 
         int right_col_idx = _join_node->_left_table_data_types.size();
         int right_col_len = _join_node->_right_table_data_types.size();
@@ -445,11 +583,10 @@ struct ProcessHashTableProbe {
             }
 
             auto last_offset = current_offset;
-            auto find_result =
-                    (*null_map)[_probe_index]
-                            ? decltype(key_getter.find_key(hash_table_ctx.hash_table, _probe_index,
-                                                           _arena)) {nullptr, false}
-                            : key_getter.find_key(hash_table_ctx.hash_table, _probe_index, _arena);
+            auto find_result = (*null_map)[_probe_index]
+                                       ? typename KeyGetter::FindResult {nullptr, false}
+                                       : key_getter.find_key_batched(hash_table_ctx.hash_table,
+                                                                     _probe_index, _arena);
 
             if (find_result.is_found()) {
                 auto& mapped = find_result.get_mapped();
@@ -694,6 +831,19 @@ struct ProcessHashTableProbe {
     }
 
 private:
+    // Hashes the keys of the probe rows left in one pass, for the batched lookups that prefetch
+    // the cells of the keys ahead of them. Fixed keys are packed a column at a time before. A
+    // probe block is rarely probed by more than one call, and then every call has a full batch
+    // to output.
+    template <typename KeyGetter>
+    void _init_probe_keys(HashTableContext& hash_table_ctx, KeyGetter& key_getter) {
+        if constexpr (ColumnsHashing::IsKeysFixedHashMethodTraits<KeyGetter>::value) {
+            _probe_keys.resize(_probe_rows - _probe_index);
+            key_getter.pack_keys(_probe_index, _probe_rows, _probe_keys.data());
+        }
+        key_getter.init_hash_values(hash_table_ctx.hash_table, _probe_index, _probe_rows, _arena);
+    }
+
     HashJoinNode* _join_node;
     const int _batch_size;
     const size_t _probe_rows;
@@ -715,6 +865,9 @@ private:
     ProfileCounter* _search_hashtable_timer;
     ProfileCounter* _build_side_output_timer;
     ProfileCounter* _probe_side_output_timer;
+
+    // the packed fixed keys of the probe rows from `_probe_index` on
+    std::vector<typename HashTableContext::HashTable::key_type> _probe_keys;
 };
 
 HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
@@ -739,12 +892,19 @@ HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const Descr
                   std::vector<bool>(tnode.hash_join_node.vintermediate_tuple_id_list.size())),
           _output_row_desc(descs, {tnode.hash_join_node.voutput_tuple_id}, {false}) {
     _runtime_filter_descs = tnode.runtime_filters;
+    _is_broadcast_join = tnode.hash_join_node.__isset.is_broadcast_join &&
+                         tnode.hash_join_node.is_broadcast_join;
     init_join_op();
 
+    _arena = std::make_shared<Arena>();
+    _hash_table_variants = std::make_shared<HashTableVariants>();
+    _build_blocks = std::make_shared<std::vector<Block>>();
+    _inserted_rows = std::make_shared<std::unordered_map<const Block*, std::vector<int>>>();
+
     // avoid vector expand change block address.
     // one block can store 4g data, _build_blocks can store 128*4g data.
     // if probe data bigger than 512g, runtime filter maybe will core dump when insert data.
-    _build_blocks.reserve(_MAX_BUILD_BLOCK_COUNT);
+    _build_blocks->reserve(_MAX_BUILD_BLOCK_COUNT);
 }
 
 HashJoinNode::~HashJoinNode() = default;
@@ -878,6 +1038,7 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _build_table_insert_timer = ADD_TIMER(build_phase_profile, "BuildTableInsertTime");
     _build_expr_call_timer = ADD_TIMER(build_phase_profile, "BuildExprCallTime");
     _build_table_expanse_timer = ADD_TIMER(build_phase_profile, "BuildTableExpanseTime");
+    _build_table_compact_timer = ADD_TIMER(build_phase_profile, "BuildTableCompactTime");
     _build_rows_counter = ADD_COUNTER(build_phase_profile, "BuildRows", TUnit::UNIT);
 
     // Probe phase
@@ -894,6 +1055,26 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _push_compute_timer = ADD_TIMER(runtime_profile(), "PushDownComputeTime");
     _build_buckets_counter = ADD_COUNTER(runtime_profile(), "BuildBuckets", TUnit::UNIT);
 
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spill_build_rows_counter = ADD_COUNTER(runtime_profile(), "SpillBuildRows", TUnit::UNIT);
+    _spill_probe_rows_counter = ADD_COUNTER(runtime_profile(), "SpillProbeRows", TUnit::UNIT);
+
+    // The probe of these joins never writes the hash table, so the instances of a broadcast join
+    // on one BE can probe a single hash table concurrently.
+    bool can_share_hash_table =
+            _is_broadcast_join && config::enable_share_hash_table_for_broadcast_join &&
+            state->get_query_fragments_ctx() != nullptr && !_have_other_join_conjunct &&
+            (_join_op == TJoinOp::INNER_JOIN || _join_op == TJoinOp::LEFT_SEMI_JOIN ||
+             _join_op == TJoinOp::LEFT_ANTI_JOIN || _join_op == TJoinOp::LEFT_OUTER_JOIN);
+    if (can_share_hash_table) {
+        _shared_hash_table_controller =
+                state->get_query_fragments_ctx()->get_shared_hash_table_controller();
+        _should_build_hash_table = _shared_hash_table_controller->should_build_hash_table(
+                state->fragment_instance_id(), id());
+    }
+    // A shared hash table must stay in memory for all the instances, so it is never spilled.
+    _enable_spill = config::enable_hash_join_spill && _shared_hash_table_controller == nullptr;
+
     RETURN_IF_ERROR(VExpr::prepare(_build_expr_ctxs, state, child(1)->row_desc()));
     RETURN_IF_ERROR(VExpr::prepare(_probe_expr_ctxs, state, child(0)->row_desc()));
 
@@ -928,6 +1109,8 @@ Status HashJoinNode::close(RuntimeState* state) {
     if (_vother_join_conjunct_ptr) (*_vother_join_conjunct_ptr)->close(state);
     VExpr::close(_output_expr_ctxs, state);
 
+    _release_spill_files();
+
     return ExecNode::close(state);
 }
 
@@ -938,6 +1121,7 @@ Status HashJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eo
 Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "HashJoinNode::get_next");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_TIMER(_probe_timer);
 
     size_t probe_rows = _probe_block.rows();
@@ -945,11 +1129,16 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
         _probe_index = 0;
         _prepare_probe_block();
 
-        do {
-            SCOPED_TIMER(_probe_next_timer);
-            RETURN_IF_ERROR_AND_CHECK_SPAN(child(0)->get_next(state, &_probe_block, &_probe_eos),
-                                           child(0)->get_next_span(), _probe_eos);
-        } while (_probe_block.rows() == 0 && !_probe_eos);
+        if (_spilled) {
+            RETURN_IF_ERROR(_get_next_spilled_probe_block(state));
+        } else {
+            do {
+                SCOPED_TIMER(_probe_next_timer);
+                RETURN_IF_ERROR_AND_CHECK_SPAN(
+                        child(0)->get_next(state, &_probe_block, &_probe_eos),
+                        child(0)->get_next_span(), _probe_eos);
+            } while (_probe_block.rows() == 0 && !_probe_eos);
+        }
 
         probe_rows = _probe_block.rows();
         if (probe_rows != 0) {
@@ -978,7 +1167,7 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
                         }
                         __builtin_unreachable();
                     },
-                    _hash_table_variants);
+                    *_hash_table_variants);
 
             RETURN_IF_ERROR(st);
         }
@@ -1017,11 +1206,13 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
                         }
                     }
                 },
-                _hash_table_variants, _join_op_variants,
+                *_hash_table_variants, _join_op_variants,
                 make_bool_variant(_have_other_join_conjunct),
                 make_bool_variant(_probe_ignore_null));
     } else if (_probe_eos) {
-        if (_is_right_semi_anti || (_is_outer_join && _join_op != TJoinOp::LEFT_OUTER_JOIN)) {
+        const bool need_process_data_in_hashtable =
+                _is_right_semi_anti || (_is_outer_join && _join_op != TJoinOp::LEFT_OUTER_JOIN);
+        if (need_process_data_in_hashtable) {
             std::visit(
                     [&](auto&& arg, auto&& join_op_variants) {
                         using JoinOpType = std::decay_t<decltype(join_op_variants)>;
@@ -1035,9 +1226,18 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
                             LOG(FATAL) << "FATAL: uninited hash table";
                         }
                     },
-                    _hash_table_variants, _join_op_variants);
+                    *_hash_table_variants, _join_op_variants);
         } else {
             *eos = true;
+        }
+
+        // The current partition of a grace hash join is finished, go on with the next one.
+        if (*eos && _spilled && _spill_partition_index + 1 < _spill_partitions.size()) {
+            RETURN_IF_ERROR(st);
+            RETURN_IF_ERROR(_restore_spill_partition(state, _spill_partition_index + 1));
+            *eos = false;
+        }
+        if (!need_process_data_in_hashtable) {
             return Status::OK();
         }
     } else {
@@ -1089,6 +1289,7 @@ void HashJoinNode::_construct_mutable_join_block() {
 Status HashJoinNode::open(RuntimeState* state) {
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "HashJoinNode::open");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(ExecNode::open(state));
     SCOPED_CONSUME_MEM_TRACKER(mem_tracker());
     RETURN_IF_CANCELLED(state);
@@ -1121,7 +1322,58 @@ Status HashJoinNode::open(RuntimeState* state) {
 void HashJoinNode::_hash_table_build_thread(RuntimeState* state, std::promise<Status>* status) {
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "HashJoinNode::_hash_table_build_thread");
     SCOPED_ATTACH_TASK(state);
-    status->set_value(_hash_table_build(state));
+    if (_shared_hash_table_controller == nullptr) {
+        status->set_value(_hash_table_build(state));
+    } else if (_should_build_hash_table) {
+        status->set_value(_build_shared_hash_table(state));
+    } else {
+        status->set_value(_wait_for_shared_hash_table(state));
+    }
+}
+
+Status HashJoinNode::_build_shared_hash_table(RuntimeState* state) {
+    auto st = _hash_table_build(state);
+    auto context = _shared_hash_table_controller->get_context(id());
+    if (st.ok()) {
+        context->arena = _arena;
+        context->build_arenas = _build_arenas;
+        context->hash_table_variants = _hash_table_variants;
+        context->blocks = _build_blocks;
+        context->inserted_rows = _inserted_rows;
+    }
+    // Always signal, the waiting instances would hang otherwise.
+    _shared_hash_table_controller->signal(id(), st);
+    return st;
+}
+
+Status HashJoinNode::_wait_for_shared_hash_table(RuntimeState* state) {
+    // The build side is not needed, close it early so that the senders of the broadcast data
+    // don't wait for this instance.
+    RETURN_IF_ERROR(child(1)->close(state));
+    SCOPED_TIMER(_build_timer);
+    auto context = _shared_hash_table_controller->get_context(id());
+    RETURN_IF_ERROR(_shared_hash_table_controller->wait_for_signal(state, context));
+
+    _arena = context->arena;
+    _build_arenas = context->build_arenas;
+    _hash_table_variants =
+            std::static_pointer_cast<HashTableVariants>(context->hash_table_variants);
+    _build_blocks = context->blocks;
+    _inserted_rows = context->inserted_rows;
+
+    // Each instance publishes its runtime filters, the merge expects one from every instance.
+    // They are copied from the filters the builder saved in the context.
+    return std::visit(
+            [&](auto&& arg) -> Status {
+                using HashTableCtxType = std::decay_t<decltype(arg)>;
+                if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
+                    ProcessRuntimeFilterBuild<HashTableCtxType> runtime_filter_build_process(this);
+                    return runtime_filter_build_process(state, arg);
+                } else {
+                    return Status::InternalError("uninited hash table");
+                }
+            },
+            *_hash_table_variants);
 }
 
 Status HashJoinNode::_hash_table_build(RuntimeState* state) {
@@ -1134,9 +1386,6 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
     int64_t last_mem_used = 0;
     bool eos = false;
 
-    // make one block for each 4 gigabytes
-    constexpr static auto BUILD_BLOCK_MAX_SIZE = 4 * 1024UL * 1024UL * 1024UL;
-
     Block block;
     while (!eos) {
         block.clear_column_data();
@@ -1144,22 +1393,35 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
 
         RETURN_IF_ERROR_AND_CHECK_SPAN(child(1)->get_next(state, &block, &eos),
                                        child(1)->get_next_span(), eos);
+
+        if (_spilled) {
+            if (block.rows() != 0) {
+                RETURN_IF_ERROR(_spill_block(state, block, true));
+            }
+            continue;
+        }
+
         _mem_used += block.allocated_bytes();
 
         if (block.rows() != 0) {
             mutable_block.merge(block);
         }
 
-        if (UNLIKELY(_mem_used - last_mem_used > BUILD_BLOCK_MAX_SIZE)) {
-            if (_build_blocks.size() == _MAX_BUILD_BLOCK_COUNT) {
+        if (_should_spill()) {
+            RETURN_IF_ERROR(_start_spill(state, mutable_block));
+            continue;
+        }
+
+        if (UNLIKELY(_mem_used - last_mem_used > _BUILD_BLOCK_MAX_SIZE)) {
+            if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
                 return Status::NotSupported(
                         strings::Substitute("data size of right table in hash join > $0",
-                                            BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
+                                            _BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
             }
-            _build_blocks.emplace_back(mutable_block.to_block());
+            _build_blocks->emplace_back(mutable_block.to_block());
             // TODO:: Rethink may we should do the proess after we recevie all build blocks ?
             // which is better.
-            RETURN_IF_ERROR(_process_build_block(state, _build_blocks[index], index));
+            RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[index], index));
 
             mutable_block = MutableBlock();
             ++index;
@@ -1167,15 +1429,29 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
         }
     }
 
+    if (_spilled) {
+        for (auto& partition : _spill_partitions) {
+            if (partition.build_writer) {
+                RETURN_IF_ERROR(partition.build_writer->close());
+            }
+        }
+        if (_spill_runtime_filter_slots) {
+            SCOPED_TIMER(_push_down_timer);
+            _spill_runtime_filter_slots->publish();
+        }
+        return Status::OK();
+    }
+
     if (!mutable_block.empty()) {
-        if (_build_blocks.size() == _MAX_BUILD_BLOCK_COUNT) {
+        if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
             return Status::NotSupported(
                     strings::Substitute("data size of right table in hash join > $0",
-                                        BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
+                                        _BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
         }
-        _build_blocks.emplace_back(mutable_block.to_block());
-        RETURN_IF_ERROR(_process_build_block(state, _build_blocks[index], index));
+        _build_blocks->emplace_back(mutable_block.to_block());
+        RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[index], index));
     }
+    _compact_hash_table();
 
     return std::visit(
             [&](auto&& arg) -> Status {
@@ -1187,7 +1463,23 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
                     LOG(FATAL) << "FATAL: uninited hash table";
                 }
             },
-            _hash_table_variants);
+            *_hash_table_variants);
+}
+
+void HashJoinNode::_compact_hash_table() {
+    if (!config::join_compact_duplicate_rows) {
+        return;
+    }
+    SCOPED_TIMER(_build_table_compact_timer);
+    std::visit(
+            [&](auto&& arg) {
+                using HashTableCtxType = std::decay_t<decltype(arg)>;
+                if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
+                    arg.hash_table.for_each_mapped(
+                            [&](RowRefList& mapped) { mapped.compact(*_arena); });
+                }
+            },
+            *_hash_table_variants);
 }
 
 // TODO:: unify the code of extract probe join column
@@ -1286,6 +1578,11 @@ Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uin
     }
     COUNTER_UPDATE(_build_rows_counter, rows);
 
+    // the hash table is split before the first build block is inserted
+    if (offset == 0) {
+        _init_hash_table_partitions(rows);
+    }
+
     ColumnRawPtrs raw_ptrs(_build_expr_ctxs.size());
 
     NullMap null_map_val(rows);
@@ -1304,16 +1601,17 @@ Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uin
                 }
                 __builtin_unreachable();
             },
-            _hash_table_variants);
+            *_hash_table_variants);
 
-    bool has_runtime_filter = !_runtime_filter_descs.empty();
+    // runtime filters of a grace hash join are built while its build side is partitioned
+    bool has_runtime_filter = !_runtime_filter_descs.empty() && !_spilled;
 
     std::visit(
             [&](auto&& arg) {
                 using HashTableCtxType = std::decay_t<decltype(arg)>;
                 if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
                     ProcessHashTableBuild<HashTableCtxType> hash_table_build_process(
-                            rows, block, raw_ptrs, this, state->batch_size(), offset);
+                            rows, block, raw_ptrs, this, state->batch_size(), offset, state);
 
                     constexpr_3_bool_match<ProcessHashTableBuild<
                             HashTableCtxType>::template Reducer>::run(has_null, _build_unique,
@@ -1324,7 +1622,7 @@ Status HashJoinNode::_process_build_block(RuntimeState* state, Block& block, uin
                     LOG(FATAL) << "FATAL: uninited hash table";
                 }
             },
-            _hash_table_variants);
+            *_hash_table_variants);
 
     return st;
 }
@@ -1335,21 +1633,21 @@ void HashJoinNode::_hash_table_init() {
         switch (_build_expr_ctxs[0]->root()->result_type()) {
         case TYPE_BOOLEAN:
         case TYPE_TINYINT:
-            _hash_table_variants.emplace<I8HashTableContext>();
+            _hash_table_variants->emplace<I8HashTableContext>();
             break;
         case TYPE_SMALLINT:
-            _hash_table_variants.emplace<I16HashTableContext>();
+            _hash_table_variants->emplace<I16HashTableContext>();
             break;
         case TYPE_INT:
         case TYPE_FLOAT:
         case TYPE_DATEV2:
-            _hash_table_variants.emplace<I32HashTableContext>();
+            _hash_table_variants->emplace<I32HashTableContext>();
             break;
         case TYPE_BIGINT:
         case TYPE_DOUBLE:
         case TYPE_DATETIME:
         case TYPE_DATE:
-            _hash_table_variants.emplace<I64HashTableContext>();
+            _hash_table_variants->emplace<I64HashTableContext>();
             break;
         case TYPE_LARGEINT:
         case TYPE_DECIMALV2:
@@ -1364,16 +1662,16 @@ void HashJoinNode::_hash_table_init() {
                                     : type_ptr->get_type_id();
             WhichDataType which(idx);
             if (which.is_decimal32()) {
-                _hash_table_variants.emplace<I32HashTableContext>();
+                _hash_table_variants->emplace<I32HashTableContext>();
             } else if (which.is_decimal64()) {
-                _hash_table_variants.emplace<I64HashTableContext>();
+                _hash_table_variants->emplace<I64HashTableContext>();
             } else {
-                _hash_table_variants.emplace<I128HashTableContext>();
+                _hash_table_variants->emplace<I128HashTableContext>();
             }
             break;
         }
         default:
-            _hash_table_variants.emplace<SerializedHashTableContext>();
+            _hash_table_variants->emplace<SerializedHashTableContext>();
         }
         return;
     }
@@ -1409,24 +1707,51 @@ void HashJoinNode::_hash_table_init() {
         // TODO: may we should support uint256 in the future
         if (has_null) {
             if (std::tuple_size<KeysNullMap<UInt64>>::value + key_byte_size <= sizeof(UInt64)) {
-                _hash_table_variants.emplace<I64FixedKeyHashTableContext<true>>();
+                _hash_table_variants->emplace<I64FixedKeyHashTableContext<true>>();
             } else if (std::tuple_size<KeysNullMap<UInt128>>::value + key_byte_size <=
                        sizeof(UInt128)) {
-                _hash_table_variants.emplace<I128FixedKeyHashTableContext<true>>();
+                _hash_table_variants->emplace<I128FixedKeyHashTableContext<true>>();
             } else {
-                _hash_table_variants.emplace<I256FixedKeyHashTableContext<true>>();
+                _hash_table_variants->emplace<I256FixedKeyHashTableContext<true>>();
             }
         } else {
             if (key_byte_size <= sizeof(UInt64)) {
-                _hash_table_variants.emplace<I64FixedKeyHashTableContext<false>>();
+                _hash_table_variants->emplace<I64FixedKeyHashTableContext<false>>();
             } else if (key_byte_size <= sizeof(UInt128)) {
-                _hash_table_variants.emplace<I128FixedKeyHashTableContext<false>>();
+                _hash_table_variants->emplace<I128FixedKeyHashTableContext<false>>();
             } else {
-                _hash_table_variants.emplace<I256FixedKeyHashTableContext<false>>();
+                _hash_table_variants->emplace<I256FixedKeyHashTableContext<false>>();
             }
         }
     } else {
-        _hash_table_variants.emplace<SerializedHashTableContext>();
+        _hash_table_variants->emplace<SerializedHashTableContext>();
+    }
+}
+
+void HashJoinNode::_init_hash_table_partitions(size_t build_rows) {
+    _build_arenas.clear();
+    const int thread_num = std::min(config::hash_join_build_thread_num, 256);
+    if (thread_num < 2 || build_rows < config::hash_join_parallel_build_min_rows) {
+        return;
+    }
+
+    // use the largest power of two partitions not more than the thread number
+    size_t partition_bits = 0;
+    while ((2 << partition_bits) <= thread_num) {
+        ++partition_bits;
+    }
+    std::visit(
+            [&](auto&& arg) {
+                using HashTableCtxType = std::decay_t<decltype(arg)>;
+                if constexpr (!std::is_same_v<HashTableCtxType, std::monostate>) {
+                    arg.hash_table.init_partitions(partition_bits);
+                } else {
+                    LOG(FATAL) << "FATAL: uninited hash table";
+                }
+            },
+            *_hash_table_variants);
+    for (size_t i = 0; i < (1 << partition_bits); ++i) {
+        _build_arenas.emplace_back(std::make_shared<Arena>());
     }
 }
 
@@ -1520,4 +1845,230 @@ void HashJoinNode::_reset_tuple_is_null_column() {
     }
 }
 
+bool HashJoinNode::_should_spill() const {
+    if (!_enable_spill || _spilled) {
+        return false;
+    }
+    // Spill before any build block is inserted into the hash table, so all build rows are
+    // still in the pending block when the switch to grace hash join happens.
+    return _mem_used > std::min<int64_t>(config::hash_join_spill_mem_threshold_bytes,
+                                         _BUILD_BLOCK_MAX_SIZE);
+}
+
+Status HashJoinNode::_start_spill(RuntimeState* state, MutableBlock& mutable_block) {
+    DCHECK(_build_blocks->empty());
+    _spilled = true;
+    _spill_partitions.resize(std::max(config::hash_join_spill_partition_count, 1));
+
+    if (!_runtime_filter_descs.empty()) {
+        _spill_runtime_filter_slots = std::make_unique<VRuntimeFilterSlots>(
+                _probe_expr_ctxs, _build_expr_ctxs, _runtime_filter_descs);
+        // The build side is too large to be kept in memory, so it is too large for an IN
+        // filter as well.
+        RETURN_IF_ERROR(
+                _spill_runtime_filter_slots->init(state, std::numeric_limits<int64_t>::max()));
+        if (_spill_runtime_filter_slots->empty()) {
+            _spill_runtime_filter_slots.reset();
+        }
+    }
+
+    Block block = mutable_block.to_block();
+    mutable_block = MutableBlock();
+    _mem_used = 0;
+    if (block.rows() != 0) {
+        RETURN_IF_ERROR(_spill_block(state, block, true));
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_block(RuntimeState* state, Block& block, bool is_build) {
+    SCOPED_TIMER(_spill_timer);
+    const auto& expr_ctxs = is_build ? _build_expr_ctxs : _probe_expr_ctxs;
+    const size_t rows = block.rows();
+    const size_t origin_columns = block.columns();
+    const size_t partition_count = _spill_partitions.size();
+
+    // The hash only depends on the values of the join keys, null values included, so that
+    // the matched rows of both sides always go to the same partition.
+    IColumn::Selector selector(rows);
+    {
+        std::vector<SipHash> siphashs(rows);
+        for (auto* ctx : expr_ctxs) {
+            int result_col_id = -1;
+            RETURN_IF_ERROR(ctx->execute(&block, &result_col_id));
+            auto column =
+                    block.get_by_position(result_col_id).column->convert_to_full_column_if_const();
+            for (size_t i = 0; i < rows; ++i) {
+                column->update_hash_with_value(i, siphashs[i]);
+            }
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            selector[i] = siphashs[i].get64() % partition_count;
+        }
+    }
+
+    if (is_build && _spill_runtime_filter_slots) {
+        SCOPED_TIMER(_push_compute_timer);
+        std::unordered_map<const Block*, std::vector<int>> inserted_rows;
+        auto& block_rows = inserted_rows[&block];
+        block_rows.reserve(rows);
+        for (int i = 0; i < rows; ++i) {
+            block_rows.push_back(i);
+        }
+        _spill_runtime_filter_slots->insert(inserted_rows);
+    }
+
+    // the results of the join key exprs are computed again when the partition is restored
+    Block::erase_useless_column(&block, origin_columns);
+
+    std::vector<MutableColumns> partition_columns(partition_count);
+    for (size_t i = 0; i < origin_columns; ++i) {
+        auto scattered = block.get_by_position(i).column->scatter(partition_count, selector);
+        for (size_t p = 0; p < partition_count; ++p) {
+            partition_columns[p].emplace_back(std::move(scattered[p]));
+        }
+    }
+
+    for (size_t p = 0; p < partition_count; ++p) {
+        if (partition_columns[p][0]->empty()) {
+            continue;
+        }
+        auto& writer = is_build ? _spill_partitions[p].build_writer
+                                : _spill_partitions[p].probe_writer;
+        if (!writer) {
+            RETURN_IF_ERROR(
+                    BlockSpillWriter::create(state->query_id(), state->batch_size(), &writer));
+        }
+        RETURN_IF_ERROR(
+                writer->write(block.clone_with_columns(std::move(partition_columns[p]))));
+    }
+    COUNTER_UPDATE(is_build ? _spill_build_rows_counter : _spill_probe_rows_counter, rows);
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_probe_side(RuntimeState* state) {
+    _probe_spilled = true;
+    bool eos = false;
+    Block block;
+    while (!eos) {
+        block.clear_column_data();
+        RETURN_IF_CANCELLED(state);
+        {
+            SCOPED_TIMER(_probe_next_timer);
+            RETURN_IF_ERROR_AND_CHECK_SPAN(child(0)->get_next(state, &block, &eos),
+                                           child(0)->get_next_span(), eos);
+        }
+        if (block.rows() != 0) {
+            RETURN_IF_ERROR(_spill_block(state, block, false));
+        }
+    }
+
+    for (auto& partition : _spill_partitions) {
+        if (partition.probe_writer) {
+            RETURN_IF_ERROR(partition.probe_writer->close());
+        }
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_restore_spill_partition(RuntimeState* state, size_t partition_index) {
+    SCOPED_TIMER(_build_timer);
+    _spill_partition_index = partition_index;
+    auto& partition = _spill_partitions[partition_index];
+
+    // drop the hash table of the previous partition
+    _build_blocks->clear();
+    _inserted_rows->clear();
+    _hash_table_init();
+    _arena->clear();
+    _build_arenas.clear();
+    _mem_used = 0;
+    _probe_eos = false;
+
+    if (partition.build_writer) {
+        BlockSpillReader reader(partition.build_writer->file_path());
+        RETURN_IF_ERROR(reader.open());
+        MutableBlock mutable_block(child(1)->row_desc().tuple_descriptors());
+        uint8_t index = 0;
+        bool eos = false;
+        Block block;
+        while (!eos) {
+            RETURN_IF_CANCELLED(state);
+            RETURN_IF_ERROR(reader.read(&block, &eos));
+            if (block.rows() == 0) {
+                continue;
+            }
+            mutable_block.merge(block);
+            if (UNLIKELY(mutable_block.allocated_bytes() > _BUILD_BLOCK_MAX_SIZE)) {
+                if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
+                    return Status::NotSupported(strings::Substitute(
+                            "data size of spill partition in hash join > $0",
+                            _BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
+                }
+                _build_blocks->emplace_back(mutable_block.to_block());
+                RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[index], index));
+                mutable_block = MutableBlock();
+                ++index;
+            }
+        }
+        if (!mutable_block.empty()) {
+            if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
+                return Status::NotSupported(
+                        strings::Substitute("data size of spill partition in hash join > $0",
+                                            _BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
+            }
+            _build_blocks->emplace_back(mutable_block.to_block());
+            RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[index], index));
+        }
+        RETURN_IF_ERROR(reader.close());
+        _compact_hash_table();
+        partition.build_writer.reset();
+    }
+
+    _spill_probe_reader.reset();
+    if (partition.probe_writer) {
+        _spill_probe_reader =
+                std::make_unique<BlockSpillReader>(partition.probe_writer->file_path());
+        RETURN_IF_ERROR(_spill_probe_reader->open());
+        partition.probe_writer.reset();
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_get_next_spilled_probe_block(RuntimeState* state) {
+    if (!_probe_spilled) {
+        RETURN_IF_ERROR(_spill_probe_side(state));
+        RETURN_IF_ERROR(_restore_spill_partition(state, 0));
+    }
+
+    if (!_spill_probe_reader) {
+        // no probe rows fall into this partition
+        _probe_eos = true;
+        return Status::OK();
+    }
+    SCOPED_TIMER(_probe_next_timer);
+    do {
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(_spill_probe_reader->read(&_probe_block, &_probe_eos));
+    } while (_probe_block.rows() == 0 && !_probe_eos);
+    if (_probe_eos) {
+        RETURN_IF_ERROR(_spill_probe_reader->close());
+        _spill_probe_reader.reset();
+    }
+    return Status::OK();
+}
+
+void HashJoinNode::_release_spill_files() {
+    _spill_probe_reader.reset();
+    for (auto& partition : _spill_partitions) {
+        if (partition.build_writer) {
+            WARN_IF_ERROR(partition.build_writer->abort(), "failed to remove spill file");
+        }
+        if (partition.probe_writer) {
+            WARN_IF_ERROR(partition.probe_writer->abort(), "failed to remove spill file");
+        }
+    }
+    _spill_partitions.clear();
+}
+
 } // namespace doris::vectorized
@@ -25,16 +25,20 @@
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/hash_map.h"
 #include "vec/common/hash_table/hash_table.h"
+#include "vec/common/hash_table/partitioned_hash_table.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/exec/join/join_op.h"
 #include "vec/exec/join/vacquire_list.hpp"
 #include "vec/functions/function.h"
+#include "vec/runtime/shared_hash_table_controller.h"
 
 namespace doris {
 namespace vectorized {
 
 struct SerializedHashTableContext {
     using Mapped = RowRefList;
-    using HashTable = HashMap<StringRef, Mapped>;
+    using HashTable = PartitionedHashMap<StringRef, Mapped>;
     using State = ColumnsHashing::HashMethodSerialized<typename HashTable::value_type, Mapped>;
     using Iter = typename HashTable::iterator;
 
@@ -54,7 +58,7 @@ struct SerializedHashTableContext {
 template <class T>
 struct PrimaryTypeHashTableContext {
     using Mapped = RowRefList;
-    using HashTable = HashMap<T, Mapped, HashCRC32<T>>;
+    using HashTable = PartitionedHashMap<T, Mapped, HashCRC32<T>>;
     using State =
             ColumnsHashing::HashMethodOneNumber<typename HashTable::value_type, Mapped, T, false>;
     using Iter = typename HashTable::iterator;
@@ -82,7 +86,7 @@ using I256HashTableContext = PrimaryTypeHashTableContext<UInt256>;
 template <class T, bool has_null>
 struct FixedKeyHashTableContext {
     using Mapped = RowRefList;
-    using HashTable = HashMap<T, Mapped, HashCRC32<T>>;
+    using HashTable = PartitionedHashMap<T, Mapped, HashCRC32<T>>;
     using State = ColumnsHashing::HashMethodKeysFixed<typename HashTable::value_type, T, Mapped,
                                                       has_null, false>;
     using Iter = typename HashTable::iterator;
@@ -153,7 +157,7 @@ public:
     Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
     Status get_next(RuntimeState* state, Block* block, bool* eos) override;
     Status close(RuntimeState* state) override;
-    HashTableVariants& get_hash_table_variants() { return _hash_table_variants; }
+    HashTableVariants& get_hash_table_variants() { return *_hash_table_variants; }
     void init_join_op();
 
     const RowDescriptor& row_desc() const override { return _output_row_desc; }
@@ -192,6 +196,7 @@ private:
     RuntimeProfile::Counter* _build_expr_call_timer;
     RuntimeProfile::Counter* _build_table_insert_timer;
     RuntimeProfile::Counter* _build_table_expanse_timer;
+    RuntimeProfile::Counter* _build_table_compact_timer;
     RuntimeProfile::Counter* _probe_timer;
     RuntimeProfile::Counter* _probe_expr_call_timer;
     RuntimeProfile::Counter* _probe_next_timer;
@@ -203,14 +208,21 @@ private:
     RuntimeProfile::Counter* _search_hashtable_timer;
     RuntimeProfile::Counter* _build_side_output_timer;
     RuntimeProfile::Counter* _probe_side_output_timer;
+    RuntimeProfile::Counter* _spill_timer;
+    RuntimeProfile::Counter* _spill_build_rows_counter;
+    RuntimeProfile::Counter* _spill_probe_rows_counter;
 
     int64_t _hash_table_rows;
     int64_t _mem_used;
 
-    Arena _arena;
-    HashTableVariants _hash_table_variants;
+    // The hash table and everything it refers to are held by shared pointers, so the instances
+    // of a broadcast join on the same BE can share the hash table built by one of them.
+    std::shared_ptr<Arena> _arena;
+    std::shared_ptr<HashTableVariants> _hash_table_variants;
+    // Arenas of the partitions of a hash table built in parallel, one for each build thread.
+    std::vector<std::shared_ptr<Arena>> _build_arenas;
 
-    std::vector<Block> _build_blocks;
+    std::shared_ptr<std::vector<Block>> _build_blocks;
     Block _probe_block;
     ColumnRawPtrs _probe_columns;
     ColumnUInt8::MutablePtr _null_map_column;
@@ -246,13 +258,38 @@ private:
     MutableColumnPtr _tuple_is_null_left_flag_column;
     MutableColumnPtr _tuple_is_null_right_flag_column;
 
+    // Spilled rows of both sides of a grace hash join which belong to the same hash partition.
+    struct SpillPartition {
+        BlockSpillWriterUPtr build_writer;
+        BlockSpillWriterUPtr probe_writer;
+    };
+
+    bool _enable_spill = false;
+    // The build side exceeds the memory threshold, all input of both sides is partitioned to
+    // disk and the partitions are joined one by one.
+    bool _spilled = false;
+    bool _probe_spilled = false;
+    std::vector<SpillPartition> _spill_partitions;
+    size_t _spill_partition_index = 0;
+    BlockSpillReaderUPtr _spill_probe_reader;
+    // Runtime filters of a grace hash join have to be built from all the build rows while
+    // they are partitioned, since no hash table ever holds all of them.
+    std::unique_ptr<VRuntimeFilterSlots> _spill_runtime_filter_slots;
+
 private:
     void _hash_table_build_thread(RuntimeState* state, std::promise<Status>* status);
 
     Status _hash_table_build(RuntimeState* state);
 
+    Status _build_shared_hash_table(RuntimeState* state);
+
+    Status _wait_for_shared_hash_table(RuntimeState* state);
+
     Status _process_build_block(RuntimeState* state, Block& block, uint8_t offset);
 
+    // makes the rows of each key of the built hash table contiguous for the probe
+    void _compact_hash_table();
+
     Status _extract_build_join_column(Block& block, NullMap& null_map, ColumnRawPtrs& raw_ptrs,
                                       bool& ignore_null, RuntimeProfile::Counter& expr_call_timer);
 
@@ -261,8 +298,33 @@ private:
 
     void _hash_table_init();
 
+    // Split the hash table into partitions built by separate threads if the build side is
+    // large enough, must be called before the first build block is inserted.
+    void _init_hash_table_partitions(size_t build_rows);
+
     static constexpr auto _MAX_BUILD_BLOCK_COUNT = 128;
 
+    // make one block for each 4 gigabytes
+    static constexpr auto _BUILD_BLOCK_MAX_SIZE = 4 * 1024UL * 1024UL * 1024UL;
+
+    bool _should_spill() const;
+
+    Status _start_spill(RuntimeState* state, MutableBlock& mutable_block);
+
+    // Partition the block by the hash of its join keys and append each part to the spill
+    // file of its partition.
+    Status _spill_block(RuntimeState* state, Block& block, bool is_build);
+
+    Status _spill_probe_side(RuntimeState* state);
+
+    // Build the hash table from the spilled build rows of the partition and prepare to
+    // read its spilled probe rows.
+    Status _restore_spill_partition(RuntimeState* state, size_t partition_index);
+
+    Status _get_next_spilled_probe_block(RuntimeState* state);
+
+    void _release_spill_files();
+
     void _prepare_probe_block();
 
     void _construct_mutable_join_block();
@@ -287,7 +349,13 @@ private:
     friend struct ProcessRuntimeFilterBuild;
 
     std::vector<TRuntimeFilterDesc> _runtime_filter_descs;
-    std::unordered_map<const Block*, std::vector<int>> _inserted_rows;
+    std::shared_ptr<std::unordered_map<const Block*, std::vector<int>>> _inserted_rows;
+
+    bool _is_broadcast_join = false;
+    // Whether this instance builds the hash table itself, false if it waits for the hash table
+    // built by another instance of the same broadcast join.
+    bool _should_build_hash_table = true;
+    SharedHashTableController* _shared_hash_table_controller = nullptr;
 };
 } // namespace vectorized
 } // namespace doris
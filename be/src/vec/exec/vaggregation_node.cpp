@@ -17,14 +17,25 @@
 
 #include "vec/exec/vaggregation_node.h"
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 
+#include "common/config.h"
 #include "exec/exec_node.h"
 #include "runtime/mem_pool.h"
+#include "runtime/memory/mem_arbiter.h"
 #include "runtime/row_batch.h"
+#include "runtime/thread_context.h"
+#include "util/stopwatch.hpp"
+#include "vec/common/sip_hash.h"
+#include "vec/common/unaligned.h"
 #include "vec/core/block.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/data_types/data_type_fixed_length_object.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/data_types/data_type_string.h"
+#include "vec/exec/volap_scan_node.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
 #include "vec/exprs/vslot_ref.h"
@@ -32,9 +43,6 @@
 
 namespace doris::vectorized {
 
-// Here is an empirical value.
-static constexpr size_t HASH_MAP_PREFETCH_DIST = 16;
-
 /// The minimum reduction factor (input rows divided by output rows) to grow hash tables
 /// in a streaming preaggregation, given that the hash tables are currently the given
 /// size or above. The sizes roughly correspond to hash table sizes where the bucket
@@ -78,6 +86,13 @@ static constexpr StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
 static constexpr int STREAMING_HT_MIN_REDUCTION_SIZE =
         sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
 
+/// The reduction factor and the cost of the hash table lookups are measured on the blocks
+/// aggregated by a streaming preaggregation, the older blocks weighing less and less. A hash
+/// table bigger than the last level cache is only considered to be in main memory if its
+/// lookups are at least this many times slower than the fastest ones measured.
+static constexpr double STREAMING_HT_CACHE_MISS_SLOWDOWN = 1.5;
+static constexpr double PREAGG_STATISTICS_DECAY = 0.5;
+
 AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
                                  const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
@@ -102,6 +117,9 @@ AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
     } else {
         _is_streaming_preagg = false;
     }
+    if (tnode.agg_node.__isset.is_input_sorted_by_group_keys) {
+        _is_sorted_input = tnode.agg_node.is_input_sorted_by_group_keys;
+    }
 }
 
 AggregationNode::~AggregationNode() = default;
@@ -183,12 +201,24 @@ void AggregationNode::_init_hash_method(std::vector<VExprContext*>& probe_exprs)
         bool use_fixed_key = true;
         bool has_null = false;
         int key_byte_size = 0;
+        std::vector<bool> dictionary_keys(_probe_expr_ctxs.size(), false);
 
         _probe_key_sz.resize(_probe_expr_ctxs.size());
         for (int i = 0; i < _probe_expr_ctxs.size(); ++i) {
             const auto vexpr = _probe_expr_ctxs[i]->root();
             const auto& data_type = vexpr->data_type();
 
+            const auto type = vexpr->result_type();
+            if (config::enable_agg_string_key_dictionary &&
+                (type == TYPE_CHAR || type == TYPE_VARCHAR || type == TYPE_STRING)) {
+                // The key is grouped by the code of its string in a dictionary.
+                dictionary_keys[i] = true;
+                has_null |= data_type->is_nullable();
+                _probe_key_sz[i] = sizeof(UInt32);
+                key_byte_size += _probe_key_sz[i];
+                continue;
+            }
+
             if (!data_type->have_maximum_size_of_value()) {
                 use_fixed_key = false;
                 break;
@@ -204,6 +234,17 @@ void AggregationNode::_init_hash_method(std::vector<VExprContext*>& probe_exprs)
             use_fixed_key = false;
         }
 
+        _key_dictionaries.clear();
+        if (use_fixed_key && std::find(dictionary_keys.begin(), dictionary_keys.end(), true) !=
+                                     dictionary_keys.end()) {
+            _key_dictionaries.resize(_probe_expr_ctxs.size());
+            for (size_t i = 0; i < dictionary_keys.size(); ++i) {
+                if (dictionary_keys[i]) {
+                    _key_dictionaries[i] = std::make_unique<AggregationKeyDictionary>();
+                }
+            }
+        }
+
         if (use_fixed_key) {
             if (has_null) {
                 if (std::tuple_size<KeysNullMap<UInt64>>::value + key_byte_size <= sizeof(UInt64)) {
@@ -239,6 +280,22 @@ Status AggregationNode::prepare(RuntimeState* state) {
     _merge_timer = ADD_TIMER(runtime_profile(), "MergeTime");
     _expr_timer = ADD_TIMER(runtime_profile(), "ExprTime");
     _get_results_timer = ADD_TIMER(runtime_profile(), "GetResultsTime");
+    _hash_table_convert_timer = ADD_TIMER(runtime_profile(), "HashTableConvertTime");
+    _preagg_passthrough_rows_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingPreaggPassthroughRows", TUnit::UNIT);
+    _preagg_to_passthrough_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingPreaggToPassthroughCount", TUnit::UNIT);
+    _preagg_to_aggregation_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingPreaggToAggregationCount", TUnit::UNIT);
+    _preagg_reduction_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingPreaggReduction", TUnit::DOUBLE_VALUE);
+    _preagg_min_reduction_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingPreaggMinReduction", TUnit::DOUBLE_VALUE);
+    _preagg_slowdown_counter = ADD_COUNTER(runtime_profile(), "StreamingPreaggHashTableSlowdown",
+                                           TUnit::DOUBLE_VALUE);
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spill_rows_counter = ADD_COUNTER(runtime_profile(), "SpillRows", TUnit::UNIT);
+    _spill_count_counter = ADD_COUNTER(runtime_profile(), "SpillCount", TUnit::UNIT);
     _data_mem_tracker = std::make_unique<MemTracker>("AggregationNode:Data");
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
     _output_tuple_desc = state->desc_tbl().get_tuple_descriptor(_output_tuple_id);
@@ -270,11 +327,14 @@ Status AggregationNode::prepare(RuntimeState* state) {
     }
 
     _offsets_of_aggregate_states.resize(_aggregate_evaluators.size());
+    _fixed_length_states.resize(_aggregate_evaluators.size());
 
     for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
         _offsets_of_aggregate_states[i] = _total_size_of_aggregate_states;
 
         const auto& agg_function = _aggregate_evaluators[i]->function();
+        _fixed_length_states[i] = config::enable_agg_fixed_length_states &&
+                                  agg_function->has_fixed_length_state();
         // aggreate states are aligned based on maximum requirement
         _align_aggregate_states = std::max(_align_aggregate_states, agg_function->align_of_data());
         _total_size_of_aggregate_states += agg_function->size_of_data();
@@ -295,6 +355,10 @@ Status AggregationNode::prepare(RuntimeState* state) {
         }
     }
 
+    // Only a one-phase aggregation of the raw rows streams the groups of a sorted input, the
+    // other ones keep using the hash table.
+    _is_sorted_input = _is_sorted_input && !_probe_expr_ctxs.empty() && !_is_merge &&
+                       _needs_finalize && !_is_streaming_preagg;
     if (_probe_expr_ctxs.empty()) {
         _agg_data.init(AggregatedDataVariants::Type::without_key);
 
@@ -322,8 +386,17 @@ Status AggregationNode::prepare(RuntimeState* state) {
         _executor.update_memusage =
                 std::bind<void>(&AggregationNode::_update_memusage_without_key, this);
         _executor.close = std::bind<void>(&AggregationNode::_close_without_key, this);
+    } else if (_is_sorted_input) {
+        runtime_profile()->append_exec_option("Sorted Input Aggregation");
+        _executor.get_result = std::bind<Status>(
+                &AggregationNode::_get_with_sorted_input_result, this, std::placeholders::_1,
+                std::placeholders::_2, std::placeholders::_3);
+        _executor.update_memusage =
+                std::bind<void>(&AggregationNode::_update_memusage_with_sorted_input, this);
+        _executor.close = std::bind<void>(&AggregationNode::_close_with_sorted_input, this);
     } else {
         _init_hash_method(_probe_expr_ctxs);
+        _use_dense_group_ids = config::enable_agg_dense_group_add;
         if (_is_merge) {
             _executor.execute = std::bind<Status>(&AggregationNode::_merge_with_serialized_key,
                                                   this, std::placeholders::_1);
@@ -351,6 +424,10 @@ Status AggregationNode::prepare(RuntimeState* state) {
         _executor.update_memusage =
                 std::bind<void>(&AggregationNode::_update_memusage_with_serialized_key, this);
         _executor.close = std::bind<void>(&AggregationNode::_close_with_serialized_key, this);
+
+        // Streaming preaggregation passes rows through instead of growing the hash table,
+        // so only the blocking aggregation needs to spill.
+        _enable_spill = config::enable_agg_spill && !_is_streaming_preagg;
     }
 
     return Status::OK();
@@ -359,6 +436,7 @@ Status AggregationNode::prepare(RuntimeState* state) {
 Status AggregationNode::open(RuntimeState* state) {
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "AggregationNode::open");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_UPDATE_MEM_EXCEED_CALL_BACK("aggregator, while execute open.");
     RETURN_IF_ERROR(ExecNode::open(state));
     SCOPED_CONSUME_MEM_TRACKER(mem_tracker());
@@ -369,10 +447,12 @@ Status AggregationNode::open(RuntimeState* state) {
         RETURN_IF_ERROR(_aggregate_evaluators[i]->open(state));
     }
 
+    RETURN_IF_ERROR(_init_fragment_cache());
     RETURN_IF_ERROR(_children[0]->open(state));
 
-    // Streaming preaggregations do all processing in GetNext().
-    if (_is_streaming_preagg) return Status::OK();
+    // Streaming preaggregations and the aggregations of a sorted input do all processing in
+    // GetNext().
+    if (_is_streaming_preagg || _is_sorted_input) return Status::OK();
     // move _create_agg_status to open not in during prepare,
     // because during prepare and open thread is not the same one,
     // this could cause unable to get JVM
@@ -391,6 +471,24 @@ Status AggregationNode::open(RuntimeState* state) {
         }
         RETURN_IF_ERROR(_executor.execute(&block));
         _executor.update_memusage();
+        if (_should_spill()) {
+            RETURN_IF_ERROR(_spill_hash_table(state));
+        }
+    }
+
+    if (!_spill_partitions.empty()) {
+        // Keys of the in-memory hash table may also exist in the spilled partitions,
+        // spill the rest of it too and then merge the partitions one by one.
+        RETURN_IF_ERROR(_spill_hash_table(state));
+        for (auto& partition : _spill_partitions) {
+            if (partition) {
+                RETURN_IF_ERROR(partition->close());
+            }
+        }
+        _spilled_partition_get_result = std::move(_executor.get_result);
+        _executor.get_result = std::bind<Status>(&AggregationNode::_get_result_with_spilled_data,
+                                                 this, std::placeholders::_1,
+                                                 std::placeholders::_2, std::placeholders::_3);
     }
 
     return Status::OK();
@@ -403,9 +501,14 @@ Status AggregationNode::get_next(RuntimeState* state, RowBatch* row_batch, bool*
 Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "AggregationNode::get_next");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_CONSUME_MEM_TRACKER(mem_tracker());
     SCOPED_UPDATE_MEM_EXCEED_CALL_BACK("aggregator, while execute get_next.");
 
+    if (_sending_cached_results) {
+        return _get_cached_results(block, eos);
+    }
+
     if (_is_streaming_preagg) {
         bool child_eos = false;
 
@@ -434,10 +537,118 @@ Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
         reached_limit(block, eos);
     }
 
+    if (_fragment_cache_entry != nullptr) {
+        _add_to_fragment_cache(*block);
+    }
+    if (*eos && _cached_results != nullptr) {
+        *eos = false;
+        _sending_cached_results = true;
+    } else if (*eos) {
+        _finish_fragment_cache();
+    }
     _executor.update_memusage();
     return Status::OK();
 }
 
+static size_t max_entry_bytes() {
+    return static_cast<size_t>(config::fragment_result_cache_max_entry_mb) << 20;
+}
+
+static Block copy_block(const Block& block) {
+    Block copy;
+    for (auto& column : block) {
+        copy.insert({column.column->clone_resized(column.column->size()), column.type,
+                     column.name});
+    }
+    return copy;
+}
+
+Status AggregationNode::_init_fragment_cache() {
+    auto* cache = FragmentResultCache::instance();
+    if (cache == nullptr || plan_digest().empty() || _needs_finalize || _limit != -1 ||
+        _vconjunct_ctx_ptr != nullptr) {
+        return Status::OK();
+    }
+    auto* scan_node = dynamic_cast<VOlapScanNode*>(_children[0]);
+    if (scan_node == nullptr || scan_node->limit() != -1 ||
+        !scan_node->runtime_filter_descs().empty()) {
+        return Status::OK();
+    }
+    auto tablet_versions = scan_node->tablet_versions();
+    if (tablet_versions.empty()) {
+        return Status::OK();
+    }
+    _fragment_cache_key = plan_digest();
+    for (auto& [tablet_id, version] : tablet_versions) {
+        _fragment_cache_key += fmt::format(":{}", tablet_id);
+    }
+
+    auto cached_results = cache->lookup(_fragment_cache_key);
+    if (cached_results != nullptr && cached_results->tablet_versions == tablet_versions) {
+        // the results of the scan are all cached, the scan reads nothing
+        scan_node->scan_versions_after(tablet_versions);
+        _cached_results = std::move(cached_results);
+        _sending_cached_results = true;
+        _runtime_profile->add_info_string("FragmentCache", "Hit");
+        return Status::OK();
+    }
+    _fragment_cache_entry = std::make_shared<FragmentResultCache::Entry>();
+    _fragment_cache_entry->tablet_versions = std::move(tablet_versions);
+    if (cached_results != nullptr &&
+        scan_node->scan_versions_after(cached_results->tablet_versions)) {
+        _cached_results = std::move(cached_results);
+        _runtime_profile->add_info_string("FragmentCache", "NewVersions");
+    } else {
+        _runtime_profile->add_info_string("FragmentCache", "Miss");
+    }
+    return Status::OK();
+}
+
+void AggregationNode::_add_to_fragment_cache(const Block& block) {
+    if (block.rows() == 0) {
+        return;
+    }
+    Block copy = copy_block(block);
+    _fragment_cache_entry->bytes += copy.allocated_bytes();
+    _fragment_cache_entry->blocks.push_back(std::move(copy));
+    if (_fragment_cache_entry->bytes > max_entry_bytes()) {
+        _fragment_cache_entry.reset();
+    }
+}
+
+Status AggregationNode::_get_cached_results(Block* block, bool* eos) {
+    auto& blocks = _cached_results->blocks;
+    if (_next_cached_block < blocks.size()) {
+        // the cached block is copied since the parent may change the block in place
+        block->swap(copy_block(blocks[_next_cached_block++]));
+        _num_rows_returned += block->rows();
+        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    }
+    *eos = _next_cached_block >= blocks.size();
+    if (*eos) {
+        _finish_fragment_cache();
+    }
+    return Status::OK();
+}
+
+void AggregationNode::_finish_fragment_cache() {
+    if (_fragment_cache_entry == nullptr) {
+        return;
+    }
+    if (_cached_results != nullptr) {
+        // the blocks in the cache are not changed, so they are shared by the entries
+        _fragment_cache_entry->blocks.insert(_fragment_cache_entry->blocks.end(),
+                                             _cached_results->blocks.begin(),
+                                             _cached_results->blocks.end());
+        _fragment_cache_entry->bytes += _cached_results->bytes;
+    }
+    if (_fragment_cache_entry->bytes <= max_entry_bytes()) {
+        FragmentResultCache::instance()->insert(_fragment_cache_key,
+                                                std::move(_fragment_cache_entry));
+    }
+    _fragment_cache_entry.reset();
+}
+
 Status AggregationNode::close(RuntimeState* state) {
     if (is_closed()) return Status::OK();
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "AggregationNode::close");
@@ -445,6 +656,7 @@ Status AggregationNode::close(RuntimeState* state) {
     for (auto* aggregate_evaluator : _aggregate_evaluators) aggregate_evaluator->close(state);
     VExpr::close(_probe_expr_ctxs, state);
     if (_executor.close) _executor.close();
+    _release_spill_files();
 
     return ExecNode::close(state);
 }
@@ -506,6 +718,71 @@ Status AggregationNode::_get_without_key_result(RuntimeState* state, Block* bloc
     return Status::OK();
 }
 
+DataTypePtr AggregationNode::_serialized_state_type(size_t i) const {
+    if (_fixed_length_states[i]) {
+        return std::make_shared<DataTypeFixedLengthObject>();
+    }
+    return std::make_shared<DataTypeString>();
+}
+
+MutableColumnPtr AggregationNode::_create_serialized_state_column(size_t i) const {
+    if (_fixed_length_states[i]) {
+        const size_t size_of_data = _aggregate_evaluators[i]->function()->size_of_data();
+        return ColumnFixedLengthObject::create(size_of_data);
+    }
+    return ColumnString::create();
+}
+
+void AggregationNode::_serialize_states(size_t i, const std::vector<AggregateDataPtr>& places,
+                                        size_t num_rows, IColumn& dst) {
+    const auto& function = _aggregate_evaluators[i]->function();
+    const size_t offset = _offsets_of_aggregate_states[i];
+    if (_fixed_length_states[i]) {
+        auto& column = assert_cast<ColumnFixedLengthObject&>(dst);
+        const size_t size_of_data = function->size_of_data();
+        const size_t old_rows = column.size();
+        column.resize(old_rows + num_rows);
+        char* data = column.get_data().data() + old_rows * size_of_data;
+        for (size_t j = 0; j < num_rows; ++j) {
+            memcpy(data + j * size_of_data, places[j] + offset, size_of_data);
+        }
+        return;
+    }
+    VectorBufferWriter writer(assert_cast<ColumnString&>(dst));
+    function->serialize_vec(places, offset, writer, num_rows);
+}
+
+Status AggregationNode::_merge_serialized_states(size_t i, const IColumn& column,
+                                                 const AggregateDataPtr* places, size_t num_rows) {
+    const auto& function = _aggregate_evaluators[i]->function();
+    const size_t size_of_data = function->size_of_data();
+    const IColumn* nested = &column;
+    if (column.is_nullable()) {
+        nested = &assert_cast<const ColumnNullable&>(column).get_nested_column();
+    }
+    // the states are merged from the column directly, whatever this node would send
+    if (const auto* fixed = check_and_get_column<ColumnFixedLengthObject>(nested)) {
+        if (fixed->item_size() != size_of_data) {
+            return Status::InternalError("the states of {} are {} bytes, but {} bytes are expected",
+                                         function->get_name(), fixed->item_size(), size_of_data);
+        }
+        function->merge_vec(places, _offsets_of_aggregate_states[i], fixed->get_data().data(),
+                            &_agg_arena_pool, num_rows);
+        return Status::OK();
+    }
+
+    std::unique_ptr<char[]> deserialize_buffer(new char[size_of_data * num_rows]);
+    function->deserialize_vec(deserialize_buffer.get(),
+                              const_cast<ColumnString*>(&assert_cast<const ColumnString&>(*nested)),
+                              &_agg_arena_pool, num_rows);
+    function->merge_vec(places, _offsets_of_aggregate_states[i], deserialize_buffer.get(),
+                        &_agg_arena_pool, num_rows);
+    for (size_t j = 0; j < num_rows; ++j) {
+        function->destroy(deserialize_buffer.get() + size_of_data * j);
+    }
+    return Status::OK();
+}
+
 Status AggregationNode::_serialize_without_key(RuntimeState* state, Block* block, bool* eos) {
     // 1. `child(0)->rows_returned() == 0` mean not data from child
     // in level two aggregation node should return NULL result
@@ -522,19 +799,11 @@ Status AggregationNode::_serialize_without_key(RuntimeState* state, Block* block
     MutableColumns value_columns(agg_size);
     std::vector<DataTypePtr> data_types(agg_size);
 
-    // will serialize data to string column
-    std::vector<VectorBufferWriter> value_buffer_writers;
-    auto serialize_string_type = std::make_shared<DataTypeString>();
+    std::vector<AggregateDataPtr> places {_agg_data.without_key};
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-        data_types[i] = serialize_string_type;
-        value_columns[i] = serialize_string_type->create_column();
-        value_buffer_writers.emplace_back(*reinterpret_cast<ColumnString*>(value_columns[i].get()));
-    }
-
-    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-        _aggregate_evaluators[i]->function()->serialize(
-                _agg_data.without_key + _offsets_of_aggregate_states[i], value_buffer_writers[i]);
-        value_buffer_writers[i].commit();
+        data_types[i] = _serialized_state_type(i);
+        value_columns[i] = _create_serialized_state_column(i);
+        _serialize_states(i, places, 1, *value_columns[i]);
     }
     {
         ColumnsWithTypeAndName data_with_schema;
@@ -563,34 +832,16 @@ Status AggregationNode::_execute_without_key(Block* block) {
 Status AggregationNode::_merge_without_key(Block* block) {
     SCOPED_TIMER(_merge_timer);
     DCHECK(_agg_data.without_key != nullptr);
-    std::unique_ptr<char[]> deserialize_buffer(new char[_total_size_of_aggregate_states]);
     int rows = block->rows();
+    std::vector<AggregateDataPtr> places(rows, _agg_data.without_key);
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         DCHECK(_aggregate_evaluators[i]->input_exprs_ctxs().size() == 1 &&
                _aggregate_evaluators[i]->input_exprs_ctxs()[0]->root()->is_slot_ref());
         int col_id =
                 ((VSlotRef*)_aggregate_evaluators[i]->input_exprs_ctxs()[0]->root())->column_id();
         if (_aggregate_evaluators[i]->is_merge()) {
-            auto column = block->get_by_position(col_id).column;
-            if (column->is_nullable()) {
-                column = ((ColumnNullable*)column.get())->get_nested_column_ptr();
-            }
-
-            for (int j = 0; j < rows; ++j) {
-                VectorBufferReader buffer_reader(((ColumnString*)(column.get()))->get_data_at(j));
-                _create_agg_status(deserialize_buffer.get());
-
-                _aggregate_evaluators[i]->function()->deserialize(
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
-                        &_agg_arena_pool);
-
-                _aggregate_evaluators[i]->function()->merge(
-                        _agg_data.without_key + _offsets_of_aggregate_states[i],
-                        deserialize_buffer.get() + _offsets_of_aggregate_states[i],
-                        &_agg_arena_pool);
-
-                _destroy_agg_status(deserialize_buffer.get());
-            }
+            RETURN_IF_ERROR(_merge_serialized_states(i, *block->get_by_position(col_id).column,
+                                                     places.data(), rows));
         } else {
             _aggregate_evaluators[i]->execute_single_add(
                     block, _agg_data.without_key + _offsets_of_aggregate_states[i],
@@ -620,8 +871,25 @@ void AggregationNode::_make_nullable_output_key(Block* block) {
 }
 
 bool AggregationNode::_should_expand_preagg_hash_tables() {
-    if (!_should_expand_hash_table) return false;
+    if (!_should_expand_hash_table) {
+        // Aggregate a block from time to time anyway, to find out whether the pre-aggregation
+        // starts reducing the input again.
+        const int64_t interval = std::max(config::streaming_preagg_probe_interval_blocks, 1);
+        return ++_preagg_passthrough_blocks % interval == 0;
+    }
+
+    if (!_preagg_reduces_enough()) {
+        _should_expand_hash_table = false;
+        _preagg_passthrough_blocks = 0;
+        // Whether to aggregate again is decided on the blocks aggregated from now on only.
+        _preagg_recent_input_rows = 0;
+        _preagg_recent_new_groups = 0;
+        COUNTER_UPDATE(_preagg_to_passthrough_counter, 1);
+    }
+    return _should_expand_hash_table;
+}
 
+bool AggregationNode::_preagg_reduces_enough() {
     return std::visit(
             [&](auto&& agg_method) -> bool {
                 auto& hash_tbl = agg_method.data;
@@ -629,7 +897,7 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
                         std::pair {hash_tbl.get_buffer_size_in_bytes(), hash_tbl.size()};
 
                 // Need some rows in tables to have valid statistics.
-                if (ht_rows == 0) return true;
+                if (ht_rows == 0 || _preagg_recent_input_rows <= 0) return true;
 
                 // Find the appropriate reduction factor in our table for the current hash table sizes.
                 int cache_level = 0;
@@ -638,40 +906,52 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
                     ++cache_level;
                 }
 
-                // Compare the number of rows in the hash table with the number of input rows that
-                // were aggregated into it. Exclude passed through rows from this calculation since
-                // they were not in hash tables.
-                const int64_t input_rows = _children[0]->rows_returned();
-                const int64_t aggregated_input_rows = input_rows - _num_rows_returned;
-                // TODO chenhao
-                //  const int64_t expected_input_rows = estimated_input_cardinality_ - num_rows_returned_;
-                double current_reduction = static_cast<double>(aggregated_input_rows) / ht_rows;
-
-                // TODO: workaround for IMPALA-2490: subplan node rows_returned counter may be
-                // inaccurate, which could lead to a divide by zero below.
-                if (aggregated_input_rows <= 0) return true;
-
-                // Extrapolate the current reduction factor (r) using the formula
-                // R = 1 + (N / n) * (r - 1), where R is the reduction factor over the full input data
-                // set, N is the number of input rows, excluding passed-through rows, and n is the
-                // number of rows inserted or merged into the hash tables. This is a very rough
-                // approximation but is good enough to be useful.
-                // TODO: consider collecting more statistics to better estimate reduction.
-                //  double estimated_reduction = aggregated_input_rows >= expected_input_rows
-                //      ? current_reduction
-                //      : 1 + (expected_input_rows / aggregated_input_rows) * (current_reduction - 1);
+                // A hash table outgrowing the cache only costs more if its lookups actually miss
+                // the cache, which they don't if a few skewed keys take most of the lookups.
+                double slowdown = _preagg_min_ns_per_row > 0
+                                          ? _preagg_ns_per_row / _preagg_min_ns_per_row
+                                          : 1.0;
+                if (cache_level > 1 && slowdown < STREAMING_HT_CACHE_MISS_SLOWDOWN) {
+                    cache_level = 1;
+                }
+
+                // The reduction of the recently aggregated blocks rather than of all the input,
+                // so that the decision follows the changes of the key distribution.
+                double current_reduction = _preagg_recent_input_rows /
+                                           std::max(_preagg_recent_new_groups, 1.0);
                 double min_reduction =
                         STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction;
 
-                //  COUNTER_SET(preagg_estimated_reduction_, estimated_reduction);
-                //    COUNTER_SET(preagg_streaming_ht_min_reduction_, min_reduction);
-                //  return estimated_reduction > min_reduction;
-                _should_expand_hash_table = current_reduction > min_reduction;
-                return _should_expand_hash_table;
+                _preagg_reduction_counter->set(current_reduction);
+                _preagg_min_reduction_counter->set(min_reduction);
+                _preagg_slowdown_counter->set(slowdown);
+                return current_reduction > min_reduction;
             },
             _agg_data._aggregated_method_variant);
 }
 
+void AggregationNode::_update_preagg_statistics(size_t rows, size_t new_groups,
+                                                int64_t emplace_ns) {
+    _preagg_recent_input_rows = _preagg_recent_input_rows * PREAGG_STATISTICS_DECAY + rows;
+    _preagg_recent_new_groups = _preagg_recent_new_groups * PREAGG_STATISTICS_DECAY + new_groups;
+
+    double ns_per_row = static_cast<double>(emplace_ns) / rows;
+    if (_preagg_ns_per_row > 0) {
+        _preagg_ns_per_row = _preagg_ns_per_row * PREAGG_STATISTICS_DECAY +
+                             ns_per_row * (1 - PREAGG_STATISTICS_DECAY);
+    } else {
+        _preagg_ns_per_row = ns_per_row;
+    }
+    if (_preagg_min_ns_per_row <= 0 || _preagg_ns_per_row < _preagg_min_ns_per_row) {
+        _preagg_min_ns_per_row = _preagg_ns_per_row;
+    }
+
+    if (!_should_expand_hash_table && _preagg_reduces_enough()) {
+        _should_expand_hash_table = true;
+        COUNTER_UPDATE(_preagg_to_aggregation_counter, 1);
+    }
+}
+
 Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* in_block,
                                                      doris::vectorized::Block* out_block) {
     SCOPED_TIMER(_build_timer);
@@ -725,10 +1005,7 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
                                     _streaming_pre_places.data(), &_agg_arena_pool);
                         }
 
-                        // will serialize value data to string column
-                        std::vector<VectorBufferWriter> value_buffer_writers;
                         bool mem_reuse = out_block->mem_reuse();
-                        auto serialize_string_type = std::make_shared<DataTypeString>();
                         MutableColumns value_columns;
                         for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
                             if (mem_reuse) {
@@ -736,20 +1013,9 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
                                         std::move(*out_block->get_by_position(i + key_size).column)
                                                 .mutate());
                             } else {
-                                // slot type of value it should always be string type
-                                value_columns.emplace_back(serialize_string_type->create_column());
-                            }
-                            value_buffer_writers.emplace_back(
-                                    *reinterpret_cast<ColumnString*>(value_columns[i].get()));
-                        }
-
-                        for (size_t j = 0; j < rows; ++j) {
-                            for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
-                                _aggregate_evaluators[i]->function()->serialize(
-                                        _streaming_pre_places[j] + _offsets_of_aggregate_states[i],
-                                        value_buffer_writers[i]);
-                                value_buffer_writers[i].commit();
+                                value_columns.emplace_back(_create_serialized_state_column(i));
                             }
+                            _serialize_states(i, _streaming_pre_places, rows, *value_columns[i]);
                         }
 
                         for (size_t i = 0; i < rows; ++i) {
@@ -766,7 +1032,7 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
                             }
                             for (int i = 0; i < value_columns.size(); ++i) {
                                 columns_with_schema.emplace_back(std::move(value_columns[i]),
-                                                                 serialize_string_type, "");
+                                                                 _serialized_state_type(i), "");
                             }
                             out_block->swap(Block(columns_with_schema));
                         } else {
@@ -782,99 +1048,110 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
             _agg_data._aggregated_method_variant);
 
     if (!ret_flag) {
-        std::visit(
-                [&](auto&& agg_method) -> void {
-                    using HashMethodType = std::decay_t<decltype(agg_method)>;
-                    using HashTableType = std::decay_t<decltype(agg_method.data)>;
-                    using AggState = typename HashMethodType::State;
-                    AggState state(key_columns, _probe_key_sz, nullptr);
-
-                    _pre_serialize_key_if_need(state, agg_method, key_columns, rows);
-
-                    std::vector<size_t> hash_values;
-
-                    if constexpr (IsPhmapTraits<HashTableType>::value) {
-                        if (hash_values.size() < rows) hash_values.resize(rows);
-                        for (size_t i = 0; i < rows; ++i) {
-                            hash_values[i] = agg_method.data.hash(agg_method.keys[i]);
-                        }
-                    }
-
-                    /// For all rows.
-                    for (size_t i = 0; i < rows; ++i) {
-                        AggregateDataPtr aggregate_data = nullptr;
-
-                        auto emplace_result = [&]() {
-                            if constexpr (IsPhmapTraits<HashTableType>::value) {
-                                if (LIKELY(i + HASH_MAP_PREFETCH_DIST < rows)) {
-                                    agg_method.data.prefetch_by_hash(
-                                            hash_values[i + HASH_MAP_PREFETCH_DIST]);
-                                }
-
-                                return state.emplace_key(agg_method.data, hash_values[i], i,
-                                                         _agg_arena_pool);
-                            } else {
-                                return state.emplace_key(agg_method.data, i, _agg_arena_pool);
-                            }
-                        }();
-
-                        /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                        if (emplace_result.is_inserted()) {
-                            /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                            emplace_result.set_mapped(nullptr);
-
-                            aggregate_data = _agg_arena_pool.aligned_alloc(
-                                    _total_size_of_aggregate_states, _align_aggregate_states);
-                            _create_agg_status(aggregate_data);
+        const size_t groups_before = _get_hash_table_size();
+        MonotonicStopWatch emplace_watch;
+        emplace_watch.start();
+        PODArray<UInt32> group_ids(_use_dense_group_ids ? rows : 0);
+        _emplace_into_hash_table(places.data(), key_columns, rows, group_ids.data());
+        emplace_watch.stop();
+        _update_preagg_statistics(rows, _get_hash_table_size() - groups_before,
+                                  emplace_watch.elapsed_time());
+
+        _execute_batch_add(in_block, places.data(), group_ids.data());
+    } else {
+        COUNTER_UPDATE(_preagg_passthrough_rows_counter, rows);
+    }
 
-                            emplace_result.set_mapped(aggregate_data);
-                        } else
-                            aggregate_data = emplace_result.get_mapped();
+    return Status::OK();
+}
 
-                        places[i] = aggregate_data;
-                        assert(places[i] != nullptr);
-                    }
-                },
-                _agg_data._aggregated_method_variant);
+size_t AggregationNode::_get_hash_table_size() {
+    return std::visit([&](auto&& agg_method) -> size_t { return agg_method.data.size(); },
+                      _agg_data._aggregated_method_variant);
+}
 
-        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-            _aggregate_evaluators[i]->execute_batch_add(in_block, _offsets_of_aggregate_states[i],
-                                                        places.data(), &_agg_arena_pool);
+void AggregationNode::_encode_dictionary_keys(ColumnRawPtrs& key_columns, Columns& code_columns) {
+    SCOPED_TIMER(_serialize_key_timer);
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        const auto& dictionary = _key_dictionaries[i];
+        if (!dictionary) {
+            continue;
+        }
+        auto codes = ColumnUInt32::create();
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*key_columns[i])) {
+            dictionary->encode(assert_cast<const ColumnString&>(nullable->get_nested_column()),
+                               codes->get_data(), _agg_arena_pool);
+            code_columns.emplace_back(
+                    ColumnNullable::create(std::move(codes), nullable->get_null_map_column_ptr()));
+        } else {
+            dictionary->encode(assert_cast<const ColumnString&>(*key_columns[i]),
+                               codes->get_data(), _agg_arena_pool);
+            code_columns.emplace_back(std::move(codes));
         }
+        key_columns[i] = code_columns.back().get();
     }
-
-    return Status::OK();
 }
 
-Status AggregationNode::_execute_with_serialized_key(Block* block) {
-    SCOPED_TIMER(_build_timer);
-    DCHECK(!_probe_expr_ctxs.empty());
+template <typename AggMethod, typename KeyType>
+void AggregationNode::_insert_keys_into_columns(AggMethod& agg_method, std::vector<KeyType>& keys,
+                                                MutableColumns& key_columns,
+                                                const size_t num_rows) {
+    if (_key_dictionaries.empty()) {
+        agg_method.insert_keys_into_columns(keys, key_columns, num_rows, _probe_key_sz);
+        return;
+    }
 
-    size_t key_size = _probe_expr_ctxs.size();
-    ColumnRawPtrs key_columns(key_size);
-    {
-        SCOPED_TIMER(_expr_timer);
-        for (size_t i = 0; i < key_size; ++i) {
-            int result_column_id = -1;
-            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
-            block->get_by_position(result_column_id).column =
-                    block->get_by_position(result_column_id)
-                            .column->convert_to_full_column_if_const();
-            key_columns[i] = block->get_by_position(result_column_id).column.get();
+    // The hash keys hold the codes of the dictionary keys, which are inserted into columns of
+    // codes of the same nullability as the output columns and looked up afterwards.
+    MutableColumns columns(key_columns.size());
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        if (!_key_dictionaries[i]) {
+            columns[i] = std::move(key_columns[i]);
+        } else if (key_columns[i]->is_nullable()) {
+            columns[i] = ColumnNullable::create(ColumnUInt32::create(), ColumnUInt8::create());
+        } else {
+            columns[i] = ColumnUInt32::create();
         }
     }
 
-    int rows = block->rows();
-    PODArray<AggregateDataPtr> places(rows);
+    agg_method.insert_keys_into_columns(keys, columns, num_rows, _probe_key_sz);
+
+    for (size_t i = 0; i < key_columns.size(); ++i) {
+        if (!_key_dictionaries[i]) {
+            key_columns[i] = std::move(columns[i]);
+        } else if (key_columns[i]->is_nullable()) {
+            const auto& codes = assert_cast<const ColumnNullable&>(*columns[i]);
+            auto& strings = assert_cast<ColumnNullable&>(*key_columns[i]);
+            const auto& null_map = codes.get_null_map_data();
+            strings.get_null_map_data().insert(null_map.begin(), null_map.end());
+            _key_dictionaries[i]->decode(
+                    assert_cast<const ColumnUInt32&>(codes.get_nested_column()).get_data(),
+                    &null_map, strings.get_nested_column());
+        } else {
+            _key_dictionaries[i]->decode(assert_cast<const ColumnUInt32&>(*columns[i]).get_data(),
+                                         nullptr, *key_columns[i]);
+        }
+    }
+}
+
+void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places,
+                                               ColumnRawPtrs& key_columns, const size_t rows,
+                                               UInt32* group_ids) {
+    // The keys of the hash table, with the dictionary keys replaced by their codes.
+    ColumnRawPtrs hash_key_columns = key_columns;
+    Columns code_columns;
+    if (!_key_dictionaries.empty()) {
+        _encode_dictionary_keys(hash_key_columns, code_columns);
+    }
 
     std::visit(
             [&](auto&& agg_method) -> void {
                 using HashMethodType = std::decay_t<decltype(agg_method)>;
                 using HashTableType = std::decay_t<decltype(agg_method.data)>;
                 using AggState = typename HashMethodType::State;
-                AggState state(key_columns, _probe_key_sz, nullptr);
+                AggState state(hash_key_columns, _probe_key_sz, nullptr);
 
-                _pre_serialize_key_if_need(state, agg_method, key_columns, rows);
+                _pre_serialize_key_if_need(state, agg_method, hash_key_columns, rows);
 
                 std::vector<size_t> hash_values;
 
@@ -883,6 +1160,8 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
                     for (size_t i = 0; i < rows; ++i) {
                         hash_values[i] = agg_method.data.hash(agg_method.keys[i]);
                     }
+                } else if constexpr (IsPartitionedHashTable<HashTableType>::value) {
+                    state.init_hash_values(agg_method.data, 0, rows, _agg_arena_pool);
                 }
 
                 /// For all rows.
@@ -898,6 +1177,8 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
 
                             return state.emplace_key(agg_method.data, hash_values[i], i,
                                                      _agg_arena_pool);
+                        } else if constexpr (IsPartitionedHashTable<HashTableType>::value) {
+                            return state.emplace_key_batched(agg_method.data, i, _agg_arena_pool);
                         } else {
                             return state.emplace_key(agg_method.data, i, _agg_arena_pool);
                         }
@@ -908,9 +1189,22 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
                         /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
                         emplace_result.set_mapped(nullptr);
 
+                        if (_use_dense_group_ids && _dense_group_places.size() ==
+                                                            IAggregateFunction::MAX_DENSE_GROUPS) {
+                            _use_dense_group_ids = false;
+                            std::vector<AggregateDataPtr>().swap(_dense_group_places);
+                        }
                         aggregate_data = _agg_arena_pool.aligned_alloc(
-                                _total_size_of_aggregate_states, _align_aggregate_states);
+                                _total_size_of_aggregate_states +
+                                        (_use_dense_group_ids ? sizeof(UInt32) : 0),
+                                _align_aggregate_states);
                         _create_agg_status(aggregate_data);
+                        if (_use_dense_group_ids) {
+                            unaligned_store<UInt32>(
+                                    aggregate_data + _total_size_of_aggregate_states,
+                                    _dense_group_places.size());
+                            _dense_group_places.push_back(aggregate_data);
+                        }
 
                         emplace_result.set_mapped(aggregate_data);
                     } else
@@ -918,20 +1212,83 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
 
                     places[i] = aggregate_data;
                     assert(places[i] != nullptr);
+                    if (group_ids != nullptr && _use_dense_group_ids) {
+                        group_ids[i] = unaligned_load<UInt32>(aggregate_data +
+                                                              _total_size_of_aggregate_states);
+                    }
+                }
+
+                if constexpr (IsPartitionedHashTable<HashTableType>::value) {
+                    if (!agg_method.data.is_partitioned() &&
+                        agg_method.data.size() >= config::agg_two_level_hash_table_min_rows) {
+                        SCOPED_TIMER(_hash_table_convert_timer);
+                        agg_method.data.convert_to_partitioned();
+                    }
                 }
             },
             _agg_data._aggregated_method_variant);
+}
 
-    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-        _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
-                                                    places.data(), &_agg_arena_pool);
+Status AggregationNode::_execute_with_serialized_key(Block* block) {
+    SCOPED_TIMER(_build_timer);
+    DCHECK(!_probe_expr_ctxs.empty());
+
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    {
+        SCOPED_TIMER(_expr_timer);
+        for (size_t i = 0; i < key_size; ++i) {
+            int result_column_id = -1;
+            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
+            block->get_by_position(result_column_id).column =
+                    block->get_by_position(result_column_id)
+                            .column->convert_to_full_column_if_const();
+            key_columns[i] = block->get_by_position(result_column_id).column.get();
+        }
     }
 
+    int rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+    PODArray<UInt32> group_ids(_use_dense_group_ids ? rows : 0);
+
+    _emplace_into_hash_table(places.data(), key_columns, rows, group_ids.data());
+    _execute_batch_add(block, places.data(), group_ids.data());
+
     return Status::OK();
 }
 
+void AggregationNode::_execute_batch_add(Block* block, AggregateDataPtr* places,
+                                         const UInt32* group_ids) {
+    // the ids are only complete if the table still has them after the whole batch
+    if (_use_dense_group_ids) {
+        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+            _aggregate_evaluators[i]->execute_batch_add_grouped(
+                    block, _offsets_of_aggregate_states[i], group_ids, _dense_group_places.size(),
+                    _dense_group_places.data(), &_agg_arena_pool);
+        }
+    } else {
+        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+            _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
+                                                        places, &_agg_arena_pool);
+        }
+    }
+}
+
 Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Block* block,
                                                         bool* eos) {
+    if (!_parallel_finalize_checked) {
+        _parallel_finalize_checked = true;
+        _finalize_in_parallel(state);
+    }
+    if (_finalized_in_parallel) {
+        if (_finalized_block_index < _finalized_blocks.size()) {
+            block->swap(_finalized_blocks[_finalized_block_index]);
+            _finalized_blocks[_finalized_block_index++].clear();
+        }
+        *eos = _finalized_block_index >= _finalized_blocks.size();
+        return Status::OK();
+    }
+
     bool mem_reuse = block->mem_reuse();
     auto column_withschema = VectorizedUtils::create_columns_with_type_and_name(row_desc());
     int key_size = _probe_expr_ctxs.size();
@@ -972,7 +1329,7 @@ Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Blo
                     ++num_rows;
                 }
 
-                agg_method.insert_keys_into_columns(keys, key_columns, num_rows, _probe_key_sz);
+                _insert_keys_into_columns(agg_method, keys, key_columns, num_rows);
 
                 for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
                     _aggregate_evaluators[i]->insert_result_info_vec(
@@ -1018,6 +1375,122 @@ Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Blo
     return Status::OK();
 }
 
+void AggregationNode::_finalize_in_parallel(RuntimeState* state) {
+    const size_t thread_num = std::max(config::agg_finalize_thread_num, 1);
+    if (thread_num == 1) {
+        return;
+    }
+
+    SCOPED_TIMER(_get_results_timer);
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (IsPartitionedHashTable<HashTableType>::value) {
+                    auto& data = agg_method.data;
+                    if (!data.is_partitioned()) {
+                        return;
+                    }
+                    _finalized_in_parallel = true;
+
+                    const size_t key_size = _probe_expr_ctxs.size();
+                    const size_t batch_size = state->batch_size();
+                    auto make_block = [&](MutableColumns& key_columns,
+                                          MutableColumns& value_columns) {
+                        auto columns_with_schema =
+                                VectorizedUtils::create_columns_with_type_and_name(row_desc());
+                        for (size_t i = 0; i < columns_with_schema.size(); ++i) {
+                            columns_with_schema[i].column =
+                                    i < key_size ? std::move(key_columns[i])
+                                                 : std::move(value_columns[i - key_size]);
+                        }
+                        return Block(columns_with_schema);
+                    };
+                    auto create_columns = [&](MutableColumns& key_columns,
+                                              MutableColumns& value_columns) {
+                        auto columns_with_schema =
+                                VectorizedUtils::create_columns_with_type_and_name(row_desc());
+                        for (size_t i = 0; i < columns_with_schema.size(); ++i) {
+                            auto column = columns_with_schema[i].type->create_column();
+                            if (i < key_size) {
+                                key_columns.emplace_back(std::move(column));
+                            } else {
+                                value_columns.emplace_back(std::move(column));
+                            }
+                        }
+                    };
+
+                    // Every thread finalizes its own subset of the partitions into its own
+                    // blocks, the states of different partitions are never shared.
+                    const size_t partition_count = data.get_partition_count();
+                    const size_t real_thread_num = std::min(thread_num, partition_count);
+                    std::vector<std::vector<Block>> thread_blocks(real_thread_num);
+                    std::vector<std::thread> threads;
+                    threads.reserve(real_thread_num);
+                    for (size_t t = 0; t < real_thread_num; ++t) {
+                        threads.emplace_back([&, t]() {
+                            SCOPED_ATTACH_TASK(state);
+                            using KeyType = std::decay_t<decltype(data.begin()->get_first())>;
+                            std::vector<KeyType> keys(batch_size);
+                            std::vector<AggregateDataPtr> values(batch_size);
+                            for (size_t p = t; p < partition_count; p += real_thread_num) {
+                                auto& partition = data.get_partition(p);
+                                auto iter = partition.begin();
+                                while (iter != partition.end()) {
+                                    size_t num_rows = 0;
+                                    while (iter != partition.end() && num_rows < batch_size) {
+                                        keys[num_rows] = iter->get_first();
+                                        values[num_rows] = iter->get_second();
+                                        ++iter;
+                                        ++num_rows;
+                                    }
+
+                                    MutableColumns key_columns;
+                                    MutableColumns value_columns;
+                                    create_columns(key_columns, value_columns);
+                                    _insert_keys_into_columns(agg_method, keys, key_columns,
+                                                              num_rows);
+                                    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                                        _aggregate_evaluators[i]->insert_result_info_vec(
+                                                values, _offsets_of_aggregate_states[i],
+                                                value_columns[i].get(), num_rows);
+                                    }
+                                    thread_blocks[t].emplace_back(
+                                            make_block(key_columns, value_columns));
+                                }
+                            }
+                        });
+                    }
+                    for (auto& thread : threads) {
+                        thread.join();
+                    }
+
+                    for (auto& blocks : thread_blocks) {
+                        for (auto& block : blocks) {
+                            _finalized_blocks.emplace_back(std::move(block));
+                        }
+                    }
+
+                    if (data.has_null_key_data()) {
+                        // only one key of group by support wrap null key
+                        MutableColumns key_columns;
+                        MutableColumns value_columns;
+                        create_columns(key_columns, value_columns);
+                        DCHECK(key_columns.size() == 1);
+                        DCHECK(key_columns[0]->is_nullable());
+                        key_columns[0]->insert_data(nullptr, 0);
+                        auto mapped = data.get_null_key_data();
+                        for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                            _aggregate_evaluators[i]->insert_result_info(
+                                    mapped + _offsets_of_aggregate_states[i],
+                                    value_columns[i].get());
+                        }
+                        _finalized_blocks.emplace_back(make_block(key_columns, value_columns));
+                    }
+                }
+            },
+            _agg_data._aggregated_method_variant);
+}
+
 Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* state, Block* block,
                                                               bool* eos) {
     int key_size = _probe_expr_ctxs.size();
@@ -1036,17 +1509,13 @@ Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* stat
         }
     }
 
-    // will serialize data to string column
-    std::vector<VectorBufferWriter> value_buffer_writers;
-    auto serialize_string_type = std::make_shared<DataTypeString>();
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-        value_data_types[i] = serialize_string_type;
+        value_data_types[i] = _serialized_state_type(i);
         if (mem_reuse) {
             value_columns[i] = std::move(*block->get_by_position(i + key_size).column).mutate();
         } else {
-            value_columns[i] = serialize_string_type->create_column();
+            value_columns[i] = _create_serialized_state_column(i);
         }
-        value_buffer_writers.emplace_back(*reinterpret_cast<ColumnString*>(value_columns[i].get()));
     }
 
     std::visit(
@@ -1068,12 +1537,10 @@ Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* stat
                     ++num_rows;
                 }
 
-                agg_method.insert_keys_into_columns(keys, key_columns, num_rows, _probe_key_sz);
+                _insert_keys_into_columns(agg_method, keys, key_columns, num_rows);
 
                 for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
-                    _aggregate_evaluators[i]->function()->serialize_vec(
-                            values, _offsets_of_aggregate_states[i], value_buffer_writers[i],
-                            num_rows);
+                    _serialize_states(i, values, num_rows, *value_columns[i]);
                 }
 
                 if (iter == data.end()) {
@@ -1082,12 +1549,10 @@ Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* stat
                         DCHECK(key_columns[0]->is_nullable());
                         if (agg_method.data.has_null_key_data()) {
                             key_columns[0]->insert_data(nullptr, 0);
-                            auto mapped = agg_method.data.get_null_key_data();
+                            std::vector<AggregateDataPtr> mapped {
+                                    agg_method.data.get_null_key_data()};
                             for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
-                                _aggregate_evaluators[i]->function()->serialize(
-                                        mapped + _offsets_of_aggregate_states[i],
-                                        value_buffer_writers[i]);
-                                value_buffer_writers[i].commit();
+                                _serialize_states(i, mapped, 1, *value_columns[i]);
                             }
                             *eos = true;
                         }
@@ -1129,60 +1594,7 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
     int rows = block->rows();
     PODArray<AggregateDataPtr> places(rows);
 
-    std::visit(
-            [&](auto&& agg_method) -> void {
-                using HashMethodType = std::decay_t<decltype(agg_method)>;
-                using HashTableType = std::decay_t<decltype(agg_method.data)>;
-                using AggState = typename HashMethodType::State;
-                AggState state(key_columns, _probe_key_sz, nullptr);
-
-                _pre_serialize_key_if_need(state, agg_method, key_columns, rows);
-
-                std::vector<size_t> hash_values;
-
-                if constexpr (IsPhmapTraits<HashTableType>::value) {
-                    if (hash_values.size() < rows) hash_values.resize(rows);
-                    for (size_t i = 0; i < rows; ++i) {
-                        hash_values[i] = agg_method.data.hash(agg_method.keys[i]);
-                    }
-                }
-
-                /// For all rows.
-                for (size_t i = 0; i < rows; ++i) {
-                    AggregateDataPtr aggregate_data = nullptr;
-
-                    auto emplace_result = [&]() {
-                        if constexpr (IsPhmapTraits<HashTableType>::value) {
-                            if (LIKELY(i + HASH_MAP_PREFETCH_DIST < rows)) {
-                                agg_method.data.prefetch_by_hash(
-                                        hash_values[i + HASH_MAP_PREFETCH_DIST]);
-                            }
-
-                            return state.emplace_key(agg_method.data, hash_values[i], i,
-                                                     _agg_arena_pool);
-                        } else {
-                            return state.emplace_key(agg_method.data, i, _agg_arena_pool);
-                        }
-                    }();
-
-                    /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                    if (emplace_result.is_inserted()) {
-                        /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                        emplace_result.set_mapped(nullptr);
-
-                        aggregate_data = _agg_arena_pool.aligned_alloc(
-                                _total_size_of_aggregate_states, _align_aggregate_states);
-                        _create_agg_status(aggregate_data);
-
-                        emplace_result.set_mapped(aggregate_data);
-                    } else
-                        aggregate_data = emplace_result.get_mapped();
-
-                    places[i] = aggregate_data;
-                    assert(places[i] != nullptr);
-                }
-            },
-            _agg_data._aggregated_method_variant);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
 
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         DCHECK(_aggregate_evaluators[i]->input_exprs_ctxs().size() == 1 &&
@@ -1190,21 +1602,8 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
         int col_id =
                 ((VSlotRef*)_aggregate_evaluators[i]->input_exprs_ctxs()[0]->root())->column_id();
         if (_aggregate_evaluators[i]->is_merge()) {
-            auto column = block->get_by_position(col_id).column;
-            if (column->is_nullable()) {
-                column = ((ColumnNullable*)column.get())->get_nested_column_ptr();
-            }
-
-            std::unique_ptr<char> deserialize_buffer(
-                    new char[_aggregate_evaluators[i]->function()->size_of_data() * rows]);
-
-            _aggregate_evaluators[i]->function()->deserialize_vec(deserialize_buffer.get(),
-                                                                  (ColumnString*)(column.get()),
-                                                                  &_agg_arena_pool, rows);
-            _aggregate_evaluators[i]->function()->merge_vec(
-                    places.data(), _offsets_of_aggregate_states[i], deserialize_buffer.get(),
-                    &_agg_arena_pool, rows);
-
+            RETURN_IF_ERROR(_merge_serialized_states(i, *block->get_by_position(col_id).column,
+                                                     places.data(), rows));
         } else {
             _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
                                                         places.data(), &_agg_arena_pool);
@@ -1242,6 +1641,326 @@ void AggregationNode::_close_with_serialized_key() {
     release_tracker();
 }
 
+Status AggregationNode::_get_with_sorted_input_result(RuntimeState* state, Block* block,
+                                                      bool* eos) {
+    const size_t key_size = _probe_expr_ctxs.size();
+    auto column_withschema = VectorizedUtils::create_columns_with_type_and_name(row_desc());
+    MutableColumns key_columns(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+        // the output keys are made nullable later if needed, see `_make_nullable_output_key`
+        column_withschema[i].type = _probe_expr_ctxs[i]->root()->data_type();
+        key_columns[i] = column_withschema[i].type->create_column();
+    }
+    MutableColumns value_columns;
+    for (size_t i = key_size; i < column_withschema.size(); ++i) {
+        value_columns.emplace_back(column_withschema[i].type->create_column());
+    }
+
+    // read on until some groups are complete, a block can be part of a single group
+    while (key_columns[0]->empty() && !_sorted_input_eos) {
+        RETURN_IF_CANCELLED(state);
+        release_block_memory(_sorted_input_block);
+        RETURN_IF_ERROR_AND_CHECK_SPAN(
+                _children[0]->get_next(state, &_sorted_input_block, &_sorted_input_eos),
+                _children[0]->get_next_span(), _sorted_input_eos);
+        if (_sorted_input_block.rows() != 0) {
+            RETURN_IF_ERROR(
+                    _execute_sorted_block(&_sorted_input_block, key_columns, value_columns));
+        }
+    }
+    if (_sorted_input_eos && _sorted_group_place != nullptr) {
+        for (size_t i = 0; i < key_size; ++i) {
+            key_columns[i]->insert_from(*_sorted_group_keys[i], 0);
+        }
+        _insert_sorted_group_result(_sorted_group_place, value_columns);
+        _sorted_group_place = nullptr;
+        _sorted_arenas.clear();
+    }
+    *eos = _sorted_input_eos;
+
+    *block = column_withschema;
+    MutableColumns columns(block->columns());
+    for (size_t i = 0; i < block->columns(); ++i) {
+        if (i < key_size) {
+            columns[i] = std::move(key_columns[i]);
+        } else {
+            columns[i] = std::move(value_columns[i - key_size]);
+        }
+    }
+    block->set_columns(std::move(columns));
+    return Status::OK();
+}
+
+Status AggregationNode::_execute_sorted_block(Block* block, MutableColumns& key_columns,
+                                              MutableColumns& value_columns) {
+    SCOPED_TIMER(_build_timer);
+    const size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs input_keys(key_size);
+    {
+        SCOPED_TIMER(_expr_timer);
+        for (size_t i = 0; i < key_size; ++i) {
+            int result_column_id = -1;
+            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
+            block->get_by_position(result_column_id).column =
+                    block->get_by_position(result_column_id)
+                            .column->convert_to_full_column_if_const();
+            input_keys[i] = block->get_by_position(result_column_id).column.get();
+        }
+    }
+
+    _sorted_arenas.push_back(std::make_unique<Arena>());
+    Arena* arena = _sorted_arenas.back().get();
+    const size_t rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+    // the first rows and the states of the groups created by this block
+    std::vector<size_t> group_starts;
+    std::vector<AggregateDataPtr> group_places;
+    AggregateDataPtr place = _sorted_group_place;
+    for (size_t row = 0; row < rows; ++row) {
+        bool new_group = place == nullptr;
+        for (size_t i = 0; i < key_size && !new_group; ++i) {
+            new_group = row == 0 ? input_keys[i]->compare_at(0, 0, *_sorted_group_keys[i], 1) != 0
+                                 : input_keys[i]->compare_at(row, row - 1, *input_keys[i], 1) != 0;
+        }
+        if (new_group) {
+            place = arena->aligned_alloc(_total_size_of_aggregate_states, _align_aggregate_states);
+            RETURN_IF_ERROR(_create_agg_status(place));
+            group_starts.push_back(row);
+            group_places.push_back(place);
+        }
+        places[row] = place;
+    }
+    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+        _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
+                                                    places.data(), arena);
+    }
+    if (group_starts.empty()) {
+        return Status::OK();
+    }
+
+    // all the groups before the last one are complete
+    if (_sorted_group_place != nullptr) {
+        for (size_t i = 0; i < key_size; ++i) {
+            key_columns[i]->insert_from(*_sorted_group_keys[i], 0);
+        }
+        _insert_sorted_group_result(_sorted_group_place, value_columns);
+    }
+    for (size_t group = 0; group + 1 < group_starts.size(); ++group) {
+        for (size_t i = 0; i < key_size; ++i) {
+            key_columns[i]->insert_from(*input_keys[i], group_starts[group]);
+        }
+        _insert_sorted_group_result(group_places[group], value_columns);
+    }
+    _sorted_group_place = group_places.back();
+    _sorted_group_keys.resize(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+        _sorted_group_keys[i] = input_keys[i]->cut(group_starts.back(), 1);
+    }
+    _sorted_arenas.erase(_sorted_arenas.begin(), _sorted_arenas.end() - 1);
+    return Status::OK();
+}
+
+void AggregationNode::_insert_sorted_group_result(AggregateDataPtr place,
+                                                  MutableColumns& value_columns) {
+    for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+        _aggregate_evaluators[i]->insert_result_info(place + _offsets_of_aggregate_states[i],
+                                                     value_columns[i].get());
+    }
+    _destroy_agg_status(place);
+}
+
+void AggregationNode::_update_memusage_with_sorted_input() {
+    int64_t used_in_arena = 0;
+    for (const auto& arena : _sorted_arenas) {
+        used_in_arena += arena->size();
+    }
+    _data_mem_tracker->consume(used_in_arena - _mem_usage_record.used_in_arena);
+    _mem_usage_record.used_in_arena = used_in_arena;
+}
+
+void AggregationNode::_close_with_sorted_input() {
+    if (_sorted_group_place != nullptr) {
+        _destroy_agg_status(_sorted_group_place);
+        _sorted_group_place = nullptr;
+    }
+    _sorted_arenas.clear();
+    release_tracker();
+}
+
+bool AggregationNode::_should_spill() const {
+    if (!_enable_spill) {
+        return false;
+    }
+    int64_t mem_usage = _mem_usage_record.used_in_arena + _mem_usage_record.used_in_state;
+    return mem_usage > config::agg_spill_mem_threshold_bytes ||
+           (MemArbiter::should_spill() && mem_usage > config::mem_pressure_spill_min_bytes);
+}
+
+Status AggregationNode::_spill_hash_table(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    if (_spill_partitions.empty()) {
+        _spill_partitions.resize(std::max(config::agg_spill_partition_count, 1));
+    }
+
+    const size_t key_size = _probe_expr_ctxs.size();
+    const size_t partition_count = _spill_partitions.size();
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        RETURN_IF_ERROR(_serialize_with_serialized_key_result(state, &block, &eos));
+        const size_t rows = block.rows();
+        if (rows == 0) {
+            continue;
+        }
+
+        // The same key must always land in the same partition, so the partition is chosen
+        // by the hash of the key columns rather than by the hash table layout.
+        IColumn::Selector selector(rows);
+        {
+            std::vector<SipHash> siphashs(rows);
+            for (size_t i = 0; i < key_size; ++i) {
+                const auto& column = block.get_by_position(i).column;
+                for (size_t j = 0; j < rows; ++j) {
+                    column->update_hash_with_value(j, siphashs[j]);
+                }
+            }
+            for (size_t j = 0; j < rows; ++j) {
+                selector[j] = siphashs[j].get64() % partition_count;
+            }
+        }
+
+        std::vector<MutableColumns> partition_columns(partition_count);
+        for (size_t i = 0; i < block.columns(); ++i) {
+            auto scattered = block.get_by_position(i).column->scatter(partition_count, selector);
+            for (size_t p = 0; p < partition_count; ++p) {
+                partition_columns[p].emplace_back(std::move(scattered[p]));
+            }
+        }
+
+        for (size_t p = 0; p < partition_count; ++p) {
+            if (partition_columns[p][0]->empty()) {
+                continue;
+            }
+            if (!_spill_partitions[p]) {
+                RETURN_IF_ERROR(BlockSpillWriter::create(state->query_id(), state->batch_size(),
+                                                         &_spill_partitions[p]));
+            }
+            RETURN_IF_ERROR(_spill_partitions[p]->write(
+                    block.clone_with_columns(std::move(partition_columns[p]))));
+        }
+        COUNTER_UPDATE(_spill_rows_counter, rows);
+    }
+    COUNTER_UPDATE(_spill_count_counter, 1);
+
+    return _reset_hash_table();
+}
+
+Status AggregationNode::_reset_hash_table() {
+    std::visit(
+            [&](auto&& agg_method) -> void {
+                auto& data = agg_method.data;
+                data.for_each_mapped([&](auto& mapped) {
+                    if (mapped) {
+                        _destroy_agg_status(mapped);
+                        mapped = nullptr;
+                    }
+                });
+                if (data.has_null_key_data()) {
+                    _destroy_agg_status(data.get_null_key_data());
+                }
+            },
+            _agg_data._aggregated_method_variant);
+
+    // Re-create the hash table, it also rewinds the iterator used for getting results.
+    _init_hash_method(_probe_expr_ctxs);
+    _use_dense_group_ids = config::enable_agg_dense_group_add;
+    _dense_group_places.clear();
+    _parallel_finalize_checked = false;
+    _finalized_in_parallel = false;
+    _finalized_blocks.clear();
+    _finalized_block_index = 0;
+    _agg_arena_pool.clear();
+    _executor.update_memusage();
+    return Status::OK();
+}
+
+Status AggregationNode::_merge_spilled_block(Block* block) {
+    SCOPED_TIMER(_merge_timer);
+
+    // A spilled block has the key columns first, followed by the serialized states.
+    const size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+        key_columns[i] = block->get_by_position(i).column.get();
+    }
+
+    const size_t rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
+
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        RETURN_IF_ERROR(_merge_serialized_states(i, *block->get_by_position(key_size + i).column,
+                                                 places.data(), rows));
+    }
+    return Status::OK();
+}
+
+Status AggregationNode::_restore_spilled_partition(size_t partition) {
+    auto& writer = _spill_partitions[partition];
+    if (!writer) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_spill_timer);
+    BlockSpillReader reader(writer->file_path());
+    RETURN_IF_ERROR(reader.open());
+    // The reader removes the file once the partition is consumed.
+    writer.reset();
+
+    bool eos = false;
+    Block block;
+    while (!eos) {
+        RETURN_IF_ERROR(reader.read(&block, &eos));
+        if (block.rows() != 0) {
+            RETURN_IF_ERROR(_merge_spilled_block(&block));
+            _executor.update_memusage();
+        }
+    }
+    return reader.close();
+}
+
+Status AggregationNode::_get_result_with_spilled_data(RuntimeState* state, Block* block,
+                                                      bool* eos) {
+    while (_spill_partition_index < _spill_partitions.size()) {
+        if (!_spill_partition_restored) {
+            RETURN_IF_ERROR(_restore_spilled_partition(_spill_partition_index));
+            _spill_partition_restored = true;
+        }
+
+        bool partition_eos = false;
+        RETURN_IF_ERROR(_spilled_partition_get_result(state, block, &partition_eos));
+        if (partition_eos) {
+            RETURN_IF_ERROR(_reset_hash_table());
+            _spill_partition_restored = false;
+            ++_spill_partition_index;
+        }
+        if (block->rows() != 0) {
+            return Status::OK();
+        }
+    }
+    *eos = true;
+    return Status::OK();
+}
+
+void AggregationNode::_release_spill_files() {
+    for (auto& partition : _spill_partitions) {
+        if (partition) {
+            WARN_IF_ERROR(partition->abort(), "failed to remove spilled aggregation data");
+        }
+    }
+    _spill_partitions.clear();
+}
+
 void AggregationNode::release_tracker() {
     _data_mem_tracker->release(_mem_usage_record.used_in_state + _mem_usage_record.used_in_arena);
 }
@@ -17,14 +17,23 @@
 
 #pragma once
 
+#include <parallel_hashmap/phmap.h>
+
 #include <functional>
 #include <variant>
 
 #include "common/object_pool.h"
 #include "exec/exec_node.h"
+#include "runtime/cache/fragment_result_cache.h"
 #include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arena.h"
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/fixed_hash_map.h"
+#include "vec/common/hash_table/partitioned_hash_table.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 
 namespace doris {
@@ -240,6 +249,7 @@ struct AggregationMethodKeysFixed {
     Data data;
     Iterator iterator;
     bool inited = false;
+    std::vector<Key> keys;
 
     AggregationMethodKeysFixed() {}
 
@@ -356,10 +366,14 @@ struct AggregationMethodSingleNullableColumn : public SingleColumnMethod {
 using AggregatedDataWithUInt8Key =
         FixedImplicitZeroHashMapWithCalculatedSize<UInt8, AggregateDataPtr>;
 using AggregatedDataWithUInt16Key = FixedImplicitZeroHashMap<UInt16, AggregateDataPtr>;
-using AggregatedDataWithUInt32Key = HashMap<UInt32, AggregateDataPtr, HashCRC32<UInt32>>;
-using AggregatedDataWithUInt64Key = HashMap<UInt64, AggregateDataPtr, HashCRC32<UInt64>>;
-using AggregatedDataWithUInt128Key = HashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
-using AggregatedDataWithUInt256Key = HashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
+// The tables start with a single level, and are converted to two level tables once they hold
+// agg_two_level_hash_table_min_rows groups, see AggregationNode::_emplace_into_hash_table.
+using AggregatedDataWithUInt32Key = PartitionedHashMap<UInt32, AggregateDataPtr, HashCRC32<UInt32>>;
+using AggregatedDataWithUInt64Key = PartitionedHashMap<UInt64, AggregateDataPtr, HashCRC32<UInt64>>;
+using AggregatedDataWithUInt128Key =
+        PartitionedHashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
+using AggregatedDataWithUInt256Key =
+        PartitionedHashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
 
 using AggregatedDataWithNullableUInt8Key = AggregationDataWithNullKey<AggregatedDataWithUInt8Key>;
 using AggregatedDataWithNullableUInt16Key = AggregationDataWithNullKey<AggregatedDataWithUInt16Key>;
@@ -524,7 +538,62 @@ struct AggregatedDataVariants {
 
 using AggregatedDataVariantsPtr = std::shared_ptr<AggregatedDataVariants>;
 
-// not support spill
+/// Maps the distinct values of a string group by key to dense UInt32 codes. Grouping by
+/// several low cardinality string keys then packs their codes into a fixed size hash key
+/// instead of serializing the strings of every row, and the strings are only looked up again
+/// for the rows of the result.
+class AggregationKeyDictionary {
+public:
+    /// Replace the strings of 'column' by their codes, the unseen strings are copied to 'arena'.
+    void encode(const ColumnString& column, ColumnUInt32::Container& codes, Arena& arena) {
+        const size_t rows = column.size();
+        codes.resize(rows);
+        StringRef last_value;
+        UInt32 last_code = 0;
+        bool has_last = false;
+        for (size_t i = 0; i < rows; ++i) {
+            const StringRef value = column.get_data_at(i);
+            // Low cardinality keys often come in runs, which skip the lookup.
+            if (has_last && value == last_value) {
+                codes[i] = last_code;
+                continue;
+            }
+            auto it = _codes.find(value);
+            if (it == _codes.end()) {
+                const StringRef stored(arena.insert(value.data, value.size), value.size);
+                it = _codes.emplace(stored, static_cast<UInt32>(_values.size())).first;
+                _values.push_back(stored);
+            }
+            last_value = it->first;
+            last_code = it->second;
+            has_last = true;
+            codes[i] = last_code;
+        }
+    }
+
+    /// Append the strings of 'codes' to 'column', a default value for the rows set in 'null_map'.
+    void decode(const ColumnUInt32::Container& codes, const NullMap* null_map,
+                IColumn& column) const {
+        const size_t rows = codes.size();
+        column.reserve(column.size() + rows);
+        for (size_t i = 0; i < rows; ++i) {
+            if (null_map && (*null_map)[i]) {
+                column.insert_default();
+            } else {
+                const StringRef& value = _values[codes[i]];
+                column.insert_data(value.data, value.size);
+            }
+        }
+    }
+
+private:
+    phmap::flat_hash_map<StringRef, UInt32, StringRefHash> _codes;
+    std::vector<StringRef> _values;
+};
+
+// When `enable_agg_spill` is set, a hash table growing beyond `agg_spill_mem_threshold_bytes`
+// is serialized, partitioned by the hash of the group by keys and spilled to scratch files.
+// After all the input is consumed, the spilled partitions are merged back one at a time.
 class AggregationNode : public ::doris::ExecNode {
 public:
     using Sizes = std::vector<size_t>;
@@ -545,6 +614,9 @@ private:
     // nullable diff. so we need make nullable of it.
     std::vector<size_t> _make_nullable_keys;
     std::vector<size_t> _probe_key_sz;
+    // The dictionary of every string key grouped by its codes, null for the other keys. Empty
+    // when no key is encoded, the strings are kept in `_agg_arena_pool`.
+    std::vector<std::unique_ptr<AggregationKeyDictionary>> _key_dictionaries;
 
     std::vector<AggFnEvaluator*> _aggregate_evaluators;
 
@@ -566,10 +638,19 @@ private:
     Sizes _offsets_of_aggregate_states;
     /// The total size of the row from the aggregate functions.
     size_t _total_size_of_aggregate_states = 0;
+    // Whether the states of the n-th aggregate function are passed to the merge phase as they are
+    // in a ColumnFixedLengthObject instead of serialized into a ColumnString.
+    std::vector<bool> _fixed_length_states;
 
     AggregatedDataVariants _agg_data;
 
     Arena _agg_arena_pool;
+    // While the hash table holds at most IAggregateFunction::MAX_DENSE_GROUPS groups, every group
+    // has a dense id, stored right after its states, and _dense_group_places[id] is its states.
+    // The functions then add the batches by the ids of their rows, see
+    // IAggregateFunction::add_batch_grouped.
+    bool _use_dense_group_ids = false;
+    std::vector<AggregateDataPtr> _dense_group_places;
 
     RuntimeProfile::Counter* _build_timer;
     RuntimeProfile::Counter* _serialize_key_timer;
@@ -577,22 +658,64 @@ private:
     RuntimeProfile::Counter* _merge_timer;
     RuntimeProfile::Counter* _expr_timer;
     RuntimeProfile::Counter* _get_results_timer;
+    RuntimeProfile::Counter* _hash_table_convert_timer;
+    RuntimeProfile::Counter* _preagg_passthrough_rows_counter;
+    RuntimeProfile::Counter* _preagg_to_passthrough_counter;
+    RuntimeProfile::Counter* _preagg_to_aggregation_counter;
+    RuntimeProfile::Counter* _preagg_reduction_counter;
+    RuntimeProfile::Counter* _preagg_min_reduction_counter;
+    RuntimeProfile::Counter* _preagg_slowdown_counter;
+    RuntimeProfile::Counter* _spill_timer;
+    RuntimeProfile::Counter* _spill_rows_counter;
+    RuntimeProfile::Counter* _spill_count_counter;
 
     bool _is_streaming_preagg;
     Block _preagg_block = Block();
     bool _should_expand_hash_table = true;
+    // Statistics of the recently aggregated blocks of a streaming preaggregation, see
+    // `_update_preagg_statistics`.
+    double _preagg_recent_input_rows = 0;
+    double _preagg_recent_new_groups = 0;
+    double _preagg_ns_per_row = 0;
+    double _preagg_min_ns_per_row = 0;
+    int64_t _preagg_passthrough_blocks = 0;
     std::vector<char*> _streaming_pre_places;
 
+    // When the input is sorted by the group by keys, a group is complete as soon as a row of
+    // another one comes, so only the last group is kept while the input streams through.
+    bool _is_sorted_input = false;
+    bool _sorted_input_eos = false;
+    Block _sorted_input_block;
+    // the keys of the open group, one row per column, and its states
+    Columns _sorted_group_keys;
+    AggregateDataPtr _sorted_group_place = nullptr;
+    // The arenas of the blocks added since the open group was created, the states can point to
+    // any of them. The older ones are freed when a new group is created.
+    std::vector<std::unique_ptr<Arena>> _sorted_arenas;
+
 private:
     /// Return true if we should keep expanding hash tables in the preagg. If false,
     /// the preagg should pass through any rows it can't fit in its tables.
     bool _should_expand_preagg_hash_tables();
+    bool _preagg_reduces_enough();
+    void _update_preagg_statistics(size_t rows, size_t new_groups, int64_t emplace_ns);
+    size_t _get_hash_table_size();
 
     void _make_nullable_output_key(Block* block);
 
     Status _create_agg_status(AggregateDataPtr data);
     Status _destroy_agg_status(AggregateDataPtr data);
 
+    // The type of the column of the serialized states of the i-th aggregate function.
+    DataTypePtr _serialized_state_type(size_t i) const;
+    MutableColumnPtr _create_serialized_state_column(size_t i) const;
+    // Appends the states of the i-th aggregate function at places[j] to dst.
+    void _serialize_states(size_t i, const std::vector<AggregateDataPtr>& places,
+                           size_t num_rows, IColumn& dst);
+    // Merges the serialized states of the i-th aggregate function in column into places[j].
+    Status _merge_serialized_states(size_t i, const IColumn& column, const AggregateDataPtr* places,
+                                    size_t num_rows);
+
     Status _get_without_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _serialize_without_key(RuntimeState* state, Block* block, bool* eos);
     Status _execute_without_key(Block* block);
@@ -601,13 +724,41 @@ private:
     void _close_without_key();
 
     Status _get_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
+    void _finalize_in_parallel(RuntimeState* state);
     Status _serialize_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _pre_agg_with_serialized_key(Block* in_block, Block* out_block);
     Status _execute_with_serialized_key(Block* block);
     Status _merge_with_serialized_key(Block* block);
     void _update_memusage_with_serialized_key();
     void _close_with_serialized_key();
+    Status _get_with_sorted_input_result(RuntimeState* state, Block* block, bool* eos);
+    // Aggregates a block of a sorted input, inserting the groups it closes into the columns.
+    Status _execute_sorted_block(Block* block, MutableColumns& key_columns,
+                                 MutableColumns& value_columns);
+    void _insert_sorted_group_result(AggregateDataPtr place, MutableColumns& value_columns);
+    void _update_memusage_with_sorted_input();
+    void _close_with_sorted_input();
     void _init_hash_method(std::vector<VExprContext*>& probe_exprs);
+    // Sets the states of the rows, and their dense group ids if group_ids isn't null and the table
+    // still has them.
+    void _emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+                                  const size_t num_rows, UInt32* group_ids = nullptr);
+    void _execute_batch_add(Block* block, AggregateDataPtr* places, const UInt32* group_ids);
+    // Replace the string keys having a dictionary by their codes, 'code_columns' keeps the
+    // columns of codes alive.
+    void _encode_dictionary_keys(ColumnRawPtrs& key_columns, Columns& code_columns);
+    // Insert the hash keys into 'key_columns', looking up the strings of the dictionary keys.
+    template <typename AggMethod, typename KeyType>
+    void _insert_keys_into_columns(AggMethod& agg_method, std::vector<KeyType>& keys,
+                                   MutableColumns& key_columns, const size_t num_rows);
+
+    bool _should_spill() const;
+    Status _spill_hash_table(RuntimeState* state);
+    Status _reset_hash_table();
+    Status _merge_spilled_block(Block* block);
+    Status _restore_spilled_partition(size_t partition);
+    Status _get_result_with_spilled_data(RuntimeState* state, Block* block, bool* eos);
+    void _release_spill_files();
 
     template <typename AggState, typename AggMethod>
     void _pre_serialize_key_if_need(AggState& state, AggMethod& agg_method,
@@ -616,6 +767,10 @@ private:
             SCOPED_TIMER(_serialize_key_timer);
             agg_method.serialize_keys(key_columns, num_rows);
             state.set_serialized_keys(agg_method.keys.data());
+        } else if constexpr (ColumnsHashing::IsKeysFixedHashMethodTraits<AggState>::value) {
+            SCOPED_TIMER(_serialize_key_timer);
+            if (agg_method.keys.size() < num_rows) agg_method.keys.resize(num_rows);
+            state.pack_keys(0, num_rows, agg_method.keys.data());
         }
     }
 
@@ -638,6 +793,39 @@ private:
 
     executor _executor;
 
+    bool _enable_spill = false;
+    // One spill file per hash partition, created lazily when the partition gets its first row.
+    std::vector<BlockSpillWriterUPtr> _spill_partitions;
+    size_t _spill_partition_index = 0;
+    bool _spill_partition_restored = false;
+    // The result getter of a restored partition, `_executor.get_result` is replaced by
+    // `_get_result_with_spilled_data` once something has been spilled.
+    vectorized_get_result _spilled_partition_get_result;
+
+    // A two level hash table is finalized by several threads at once on the first call to
+    // `_get_with_serialized_key_result`, the result blocks are then returned one by one.
+    bool _parallel_finalize_checked = false;
+    bool _finalized_in_parallel = false;
+    std::vector<Block> _finalized_blocks;
+    size_t _finalized_block_index = 0;
+
+    // The partial results of an aggregation right above an olap scan are cached by the versions
+    // of its tablets. A later query of newer versions only aggregates their new rows and sends
+    // the cached results after its own, and a query of the same versions only sends them.
+    Status _init_fragment_cache();
+    void _add_to_fragment_cache(const Block& block);
+    Status _get_cached_results(Block* block, bool* eos);
+    void _finish_fragment_cache();
+
+    std::string _fragment_cache_key;
+    // the results of this query to cache, null if they are not cached
+    std::shared_ptr<FragmentResultCache::Entry> _fragment_cache_entry;
+    // the cached results of the versions not scanned, which are sent after the results of the
+    // new versions, or right away if no version is new
+    std::shared_ptr<const FragmentResultCache::Entry> _cached_results;
+    bool _sending_cached_results = false;
+    size_t _next_cached_block = 0;
+
     struct MemoryRecord {
         MemoryRecord() : used_in_arena(0), used_in_state(0) {}
         int64_t used_in_arena;
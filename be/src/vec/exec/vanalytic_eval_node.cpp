@@ -17,12 +17,19 @@
 
 #include "vec/exec/vanalytic_eval_node.h"
 
+#include <algorithm>
+
+#include "common/config.h"
 #include "exprs/agg_fn_evaluator.h"
 #include "exprs/anyval_util.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
+#include "runtime/thread_context.h"
 #include "udf/udf_internal.h"
+#include "util/countdown_latch.h"
+#include "util/threadpool.h"
 #include "vec/utils/util.hpp"
 
 namespace doris::vectorized {
@@ -185,6 +192,29 @@ Status VAnalyticEvalNode::prepare(RuntimeState* state) {
     _fn_place_ptr =
             _agg_arena_pool.aligned_alloc(_total_size_of_aggregate_states, _align_aggregate_states);
     _create_agg_status();
+    // the frames of the ROWS windows that aren't accumulated from the start of the partition move
+    // forward with the current row, so the aggregates are slid instead of computed for every frame
+    bool sliding_frames = _fn_scope == AnalyticFnScope::ROWS &&
+                          (_window.__isset.window_start ||
+                           _window.window_end.type != TAnalyticWindowBoundaryType::CURRENT_ROW);
+    _sliding_windows.resize(_agg_functions_size);
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        const auto& agg_function = _agg_functions[i]->function();
+        if (sliding_frames && SlidingWindowAggregator::is_supported(agg_function)) {
+            _sliding_windows[i].reset(new SlidingWindowAggregator(agg_function));
+        }
+    }
+    // the partitions are independent of each other, so they can be evaluated by several threads
+    // with their own states if the functions are builtin
+    bool evaluate_in_parallel =
+            config::analytic_eval_thread_num > 1 && !_partition_by_eq_expr_ctxs.empty() &&
+            std::all_of(_agg_functions.begin(), _agg_functions.end(),
+                        [](AggFnEvaluator* evaluator) { return evaluator->is_builtin(); });
+    if (evaluate_in_parallel) {
+        _executor.get_next = std::bind<Status>(&VAnalyticEvalNode::_get_next_in_parallel, this,
+                                               std::placeholders::_1, std::placeholders::_2,
+                                               std::placeholders::_3);
+    }
     _executor.insert_result =
             std::bind<void>(&VAnalyticEvalNode::_insert_result_info, this, std::placeholders::_1);
     _executor.execute =
@@ -239,6 +269,7 @@ Status VAnalyticEvalNode::close(RuntimeState* state) {
     for (auto* agg_function : _agg_functions) agg_function->close(state);
 
     _destroy_agg_status();
+    _sliding_windows.clear();
     return ExecNode::close(state);
 }
 
@@ -250,6 +281,7 @@ Status VAnalyticEvalNode::get_next(RuntimeState* state, vectorized::Block* block
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span,
                                  "VAnalyticEvalNode::get_next");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_CONSUME_MEM_TRACKER(mem_tracker());
     RETURN_IF_CANCELLED(state);
 
@@ -348,6 +380,201 @@ Status VAnalyticEvalNode::_get_next_for_rows(RuntimeState* state, Block* block,
     return Status::OK();
 }
 
+Status VAnalyticEvalNode::_get_next_in_parallel(RuntimeState* state, Block* block, bool* eos) {
+    if (!_input_eos) {
+        // all the input is held until the evaluation, so it stops once the query is over its limit
+        while (!_input_eos) {
+            RETURN_IF_ERROR(_fetch_next_block_data(state));
+            RETURN_IF_ERROR(state->check_query_state(
+                    "VAnalyticEvalNode, while reading the input of the parallel evaluation."));
+        }
+        SCOPED_TIMER(_evaluation_timer);
+        std::vector<int64_t> partition_starts = _find_group_starts(_partition_by_column_idxs);
+        std::vector<int64_t> peer_starts;
+        if (_fn_scope == AnalyticFnScope::RANGE) {
+            std::vector<int64_t> column_idxs = _partition_by_column_idxs;
+            column_idxs.insert(column_idxs.end(), _ordey_by_column_idxs.begin(),
+                               _ordey_by_column_idxs.end());
+            peer_starts = _find_group_starts(column_idxs);
+        }
+
+        // every task evaluates a range of whole partitions with about the same number of rows
+        const size_t partition_count = partition_starts.size() - 1;
+        const size_t task_num = std::min<size_t>(config::analytic_eval_thread_num, partition_count);
+        std::vector<size_t> first_partitions(task_num + 1, partition_count);
+        for (size_t t = 0; t < task_num; ++t) {
+            int64_t first_row = _input_total_rows * t / task_num;
+            first_partitions[t] =
+                    std::lower_bound(partition_starts.begin(), partition_starts.end() - 1,
+                                     first_row) -
+                    partition_starts.begin();
+        }
+        std::vector<MutableColumns> task_results(task_num);
+        for (size_t t = 0; t < task_num; ++t) {
+            for (size_t i = 0; i < _agg_functions_size; ++i) {
+                task_results[t].emplace_back(_agg_functions[i]->data_type()->create_column());
+            }
+        }
+        auto evaluate = [&](size_t t) {
+            _evaluate_partitions(partition_starts, peer_starts, first_partitions[t],
+                                 first_partitions[t + 1], task_results[t]);
+        };
+        if (task_num > 0) {
+            // the first range is evaluated by this thread, and so are the ranges the pool can't
+            // take
+            ThreadPool* pool = ExecEnv::GetInstance()->parallel_operator_thread_pool();
+            CountDownLatch latch(task_num - 1);
+            for (size_t t = 1; t < task_num; ++t) {
+                auto task = [&, t]() {
+                    SCOPED_ATTACH_TASK(state);
+                    SCOPED_CONSUME_MEM_TRACKER(mem_tracker());
+                    evaluate(t);
+                    latch.count_down();
+                };
+                if (pool == nullptr || !pool->submit_func(task).ok()) {
+                    evaluate(t);
+                    latch.count_down();
+                }
+            }
+            evaluate(0);
+            latch.wait();
+        }
+
+        _parallel_results.resize(_agg_functions_size);
+        for (size_t i = 0; i < _agg_functions_size && task_num > 0; ++i) {
+            auto result = std::move(task_results[0][i]);
+            for (size_t t = 1; t < task_num; ++t) {
+                result->insert_range_from(*task_results[t][i], 0, task_results[t][i]->size());
+                task_results[t][i].reset();
+            }
+            _parallel_results[i] = std::move(result);
+        }
+        RETURN_IF_ERROR(state->check_query_state(
+                "VAnalyticEvalNode, while evaluating the partitions in parallel."));
+    }
+
+    if (_output_block_index == _input_blocks.size()) {
+        *eos = true;
+        return Status::OK();
+    }
+    int64_t first_row = input_block_first_row_positions[_output_block_index];
+    size_t block_rows = _input_blocks[_output_block_index].rows();
+    _result_window_columns.resize(_agg_functions_size);
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        _result_window_columns[i] = _agg_functions[i]->data_type()->create_column();
+        _result_window_columns[i]->insert_range_from(*_parallel_results[i], first_row, block_rows);
+    }
+    return _output_current_block(block);
+}
+
+std::vector<int64_t> VAnalyticEvalNode::_find_group_starts(
+        const std::vector<int64_t>& column_idxs) {
+    std::vector<int64_t> group_starts;
+    for (size_t b = 0; b < _input_blocks.size(); ++b) {
+        const Block& block = _input_blocks[b];
+        // the row before the first row of a block is the last row of the previous block
+        size_t previous_block = b == 0 ? 0 : b - 1;
+        for (size_t row = 0; row < block.rows(); ++row) {
+            bool new_group = b == 0 && row == 0;
+            size_t previous_row = row == 0 ? _input_blocks[previous_block].rows() - 1 : row - 1;
+            const Block& previous = row == 0 ? _input_blocks[previous_block] : block;
+            for (size_t i = 0; i < column_idxs.size() && !new_group; ++i) {
+                const auto& column = block.get_by_position(column_idxs[i]).column;
+                const auto& previous_column = previous.get_by_position(column_idxs[i]).column;
+                new_group = column->compare_at(row, previous_row, *previous_column, 1) != 0;
+            }
+            if (new_group) {
+                group_starts.push_back(input_block_first_row_positions[b] + row);
+            }
+        }
+    }
+    group_starts.push_back(_input_total_rows);
+    return group_starts;
+}
+
+void VAnalyticEvalNode::_evaluate_partitions(const std::vector<int64_t>& partition_starts,
+                                             const std::vector<int64_t>& peer_starts,
+                                             size_t first, size_t last, MutableColumns& results) {
+    Arena arena;
+    AggregateDataPtr places =
+            arena.aligned_alloc(_total_size_of_aggregate_states, _align_aggregate_states);
+    std::vector<std::vector<const IColumn*>> agg_columns(_agg_functions_size);
+    std::vector<std::unique_ptr<SlidingWindowAggregator>> sliding_windows(_agg_functions_size);
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        _agg_functions[i]->create(places + _offsets_of_aggregate_states[i]);
+        for (const auto& column : _agg_intput_columns[i]) {
+            agg_columns[i].push_back(column.get());
+        }
+        if (_sliding_windows[i] != nullptr) {
+            sliding_windows[i].reset(new SlidingWindowAggregator(_agg_functions[i]->function()));
+        }
+    }
+    auto execute = [&](int64_t partition_start, int64_t partition_end, int64_t frame_start,
+                       int64_t frame_end) {
+        for (size_t i = 0; i < _agg_functions_size; ++i) {
+            AggregateDataPtr place = places + _offsets_of_aggregate_states[i];
+            if (sliding_windows[i] != nullptr) {
+                sliding_windows[i]->slide(partition_start, partition_end, frame_start, frame_end,
+                                          place, agg_columns[i].data());
+            } else {
+                _agg_functions[i]->function()->add_range_single_place(
+                        partition_start, partition_end, frame_start, frame_end, place,
+                        agg_columns[i].data(), nullptr);
+            }
+        }
+    };
+    auto insert_result = [&](int64_t rows) {
+        for (size_t i = 0; i < _agg_functions_size; ++i) {
+            for (int64_t row = 0; row < rows; ++row) {
+                _agg_functions[i]->insert_result_info(places + _offsets_of_aggregate_states[i],
+                                                      results[i].get());
+            }
+        }
+    };
+    auto reset = [&]() {
+        for (size_t i = 0; i < _agg_functions_size; ++i) {
+            _agg_functions[i]->reset(places + _offsets_of_aggregate_states[i]);
+        }
+    };
+
+    // the same frames as the ones of _get_next_for_partition, _get_next_for_range and
+    // _get_next_for_rows
+    bool accumulate_rows = _fn_scope == AnalyticFnScope::ROWS && !_window.__isset.window_start &&
+                           _window.window_end.type == TAnalyticWindowBoundaryType::CURRENT_ROW;
+    for (size_t p = first; p < last; ++p) {
+        int64_t partition_start = partition_starts[p];
+        int64_t partition_end = partition_starts[p + 1];
+        reset();
+        if (_fn_scope == AnalyticFnScope::PARTITION) {
+            execute(partition_start, partition_end, partition_start, partition_end);
+            insert_result(partition_end - partition_start);
+        } else if (_fn_scope == AnalyticFnScope::RANGE) {
+            auto peer = std::lower_bound(peer_starts.begin(), peer_starts.end(), partition_start);
+            for (; *peer < partition_end; ++peer) {
+                execute(*peer, *(peer + 1), *peer, *(peer + 1));
+                insert_result(*(peer + 1) - *peer);
+            }
+        } else {
+            for (int64_t row = partition_start; row < partition_end; ++row) {
+                int64_t frame_start = row;
+                int64_t frame_end = row + 1;
+                if (!accumulate_rows) {
+                    reset();
+                    frame_start = _window.__isset.window_start ? row + _rows_start_offset
+                                                               : partition_start;
+                    frame_end = row + _rows_end_offset + 1;
+                }
+                execute(partition_start, partition_end, frame_start, frame_end);
+                insert_result(1);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < _agg_functions_size; ++i) {
+        _agg_functions[i]->destroy(places + _offsets_of_aggregate_states[i]);
+    }
+}
+
 Status VAnalyticEvalNode::_consumed_block_and_init_partition(RuntimeState* state,
                                                              bool* next_partition, bool* eos) {
     BlockRowPos found_partition_end = _get_partition_by_end(); //claculate current partition end
@@ -591,9 +818,15 @@ void VAnalyticEvalNode::_execute_for_win_func(BlockRowPos partition_start,
         for (int j = 0; j < _agg_intput_columns[i].size(); ++j) {
             _agg_columns.push_back(_agg_intput_columns[i][j].get());
         }
-        _agg_functions[i]->function()->add_range_single_place(
-                partition_start.pos, partition_end.pos, frame_start.pos, frame_end.pos,
-                _fn_place_ptr + _offsets_of_aggregate_states[i], _agg_columns.data(), nullptr);
+        if (_sliding_windows[i] != nullptr) {
+            _sliding_windows[i]->slide(
+                    partition_start.pos, partition_end.pos, frame_start.pos, frame_end.pos,
+                    _fn_place_ptr + _offsets_of_aggregate_states[i], _agg_columns.data());
+        } else {
+            _agg_functions[i]->function()->add_range_single_place(
+                    partition_start.pos, partition_end.pos, frame_start.pos, frame_end.pos,
+                    _fn_place_ptr + _offsets_of_aggregate_states[i], _agg_columns.data(), nullptr);
+        }
     }
 }
 
@@ -691,4 +924,91 @@ std::string VAnalyticEvalNode::debug_window_bound_string(TAnalyticWindowBoundary
     return ss.str();
 }
 
+SlidingWindowAggregator::~SlidingWindowAggregator() {
+    _clear();
+    if (_back != nullptr) {
+        _function->destroy(_back);
+    }
+}
+
+bool SlidingWindowAggregator::is_supported(const AggregateFunctionPtr& function) {
+    // the nullable wrappers are named after the nested functions
+    const std::string name = function->get_name();
+    return name == "sum" || name == "count" || name == "avg" || name == "min" || name == "max";
+}
+
+void SlidingWindowAggregator::slide(int64_t partition_start, int64_t partition_end,
+                                    int64_t frame_start, int64_t frame_end, AggregateDataPtr place,
+                                    const IColumn** columns) {
+    frame_start = std::max<int64_t>(frame_start, partition_start);
+    frame_end = std::max(std::min<int64_t>(frame_end, partition_end), frame_start);
+    if (_back == nullptr) {
+        _back = _create_state();
+    }
+    if (partition_start != _partition_start || frame_start >= _end) {
+        // none of the rows aggregated before are in the frame
+        _partition_start = partition_start;
+        _clear();
+        _start = _middle = _end = frame_start;
+    }
+    while (_start < frame_start) {
+        _pop_front(columns);
+    }
+    for (; _end < frame_end; ++_end) {
+        _function->add(_back, columns, _end, nullptr);
+    }
+
+    _function->reset(place);
+    if (!_front.empty()) {
+        _function->merge(place, _front.back(), nullptr);
+    }
+    _function->merge(place, _back, nullptr);
+}
+
+AggregateDataPtr SlidingWindowAggregator::_create_state() {
+    AggregateDataPtr state = nullptr;
+    if (_free_states.empty()) {
+        state = _arena.aligned_alloc(_function->size_of_data(), _function->align_of_data());
+    } else {
+        state = _free_states.back();
+        _free_states.pop_back();
+    }
+    _function->create(state);
+    return state;
+}
+
+void SlidingWindowAggregator::_destroy_state(AggregateDataPtr state) {
+    _function->destroy(state);
+    _free_states.push_back(state);
+}
+
+void SlidingWindowAggregator::_pop_front(const IColumn** columns) {
+    if (_front.empty()) {
+        // move the rows of the back into the front, the newest row at the bottom
+        for (int64_t row = _end - 1; row >= _middle; --row) {
+            AggregateDataPtr state = _create_state();
+            _function->add(state, columns, row, nullptr);
+            if (!_front.empty()) {
+                _function->merge(state, _front.back(), nullptr);
+            }
+            _front.push_back(state);
+        }
+        _function->reset(_back);
+        _middle = _end;
+    }
+    _destroy_state(_front.back());
+    _front.pop_back();
+    ++_start;
+}
+
+void SlidingWindowAggregator::_clear() {
+    for (auto state : _front) {
+        _destroy_state(state);
+    }
+    _front.clear();
+    if (_back != nullptr) {
+        _function->reset(_back);
+    }
+}
+
 } // namespace doris::vectorized
@@ -36,6 +36,47 @@ struct BlockRowPos {
     int64_t pos;       //pos = all blocks size + row_num
 };
 
+// Aggregates the sliding frames of a window, like ROWS BETWEEN 100 PRECEDING AND CURRENT ROW, with
+// an amortized constant number of adds and merges per row instead of adding all the rows of every
+// frame. The rows of the frame are a queue kept as two stacks: the newer rows are added into one
+// back state, and each older row has a front state of itself and the older rows after it, so the
+// oldest row leaves by popping its state. When the front is empty, the back rows are moved into it
+// by adding them again from the newest one. Only add and merge are needed, so it works for the
+// aggregates without an inverse like min and max.
+class SlidingWindowAggregator {
+public:
+    explicit SlidingWindowAggregator(const AggregateFunctionPtr& function)
+            : _function(function) {}
+    ~SlidingWindowAggregator();
+
+    // Whether the function is an aggregate of the rows of the frame that can be merged, and not a
+    // window function that depends on the position of the rows like first_value or lead.
+    static bool is_supported(const AggregateFunctionPtr& function);
+
+    // Sets the state at place to the aggregate of the rows [frame_start, frame_end) of the
+    // partition. The frames of a partition are expected to move forward only.
+    void slide(int64_t partition_start, int64_t partition_end, int64_t frame_start,
+               int64_t frame_end, AggregateDataPtr place, const IColumn** columns);
+
+private:
+    AggregateDataPtr _create_state();
+    void _destroy_state(AggregateDataPtr state);
+    void _pop_front(const IColumn** columns);
+    void _clear();
+
+    const AggregateFunctionPtr _function;
+    Arena _arena;
+    int64_t _partition_start = -1;
+    // the rows of the frame: [_start, _middle) are in the front, [_middle, _end) in the back
+    int64_t _start = 0;
+    int64_t _middle = 0;
+    int64_t _end = 0;
+    // _front.back() is the state of the rows [_start, _middle)
+    std::vector<AggregateDataPtr> _front;
+    AggregateDataPtr _back = nullptr;
+    std::vector<AggregateDataPtr> _free_states;
+};
+
 class AggFnEvaluator;
 class VAnalyticEvalNode : public ExecNode {
 public:
@@ -57,6 +98,15 @@ private:
     Status _get_next_for_rows(RuntimeState* state, Block* block, bool* eos);
     Status _get_next_for_range(RuntimeState* state, Block* block, bool* eos);
     Status _get_next_for_partition(RuntimeState* state, Block* block, bool* eos);
+    // reads all the input and evaluates its partitions in parallel tasks before the output
+    Status _get_next_in_parallel(RuntimeState* state, Block* block, bool* eos);
+    // the positions of the first rows of the groups of equal values of the columns in the input,
+    // followed by the number of input rows
+    std::vector<int64_t> _find_group_starts(const std::vector<int64_t>& column_idxs);
+    // evaluates the functions on the partitions [first, last) into the result columns
+    void _evaluate_partitions(const std::vector<int64_t>& partition_starts,
+                              const std::vector<int64_t>& peer_starts, size_t first, size_t last,
+                              MutableColumns& results);
 
     void _execute_for_win_func(BlockRowPos partition_start, BlockRowPos partition_end,
                                BlockRowPos frame_start, BlockRowPos frame_end);
@@ -133,6 +183,10 @@ private:
     size_t _align_aggregate_states = 1;
     Arena _agg_arena_pool;
     AggregateDataPtr _fn_place_ptr;
+    // the aggregators of the functions computed by sliding frames, or null for the others
+    std::vector<std::unique_ptr<SlidingWindowAggregator>> _sliding_windows;
+    // the results of all the input rows when the partitions are evaluated in parallel
+    std::vector<ColumnPtr> _parallel_results;
 
     TTupleId _buffered_tuple_id = 0;
     TupleId _intermediate_tuple_id;
@@ -67,6 +67,8 @@ protected:
                                                int32_t num_of_columns_from_file,
                                                int64_t range_start_offset, int64_t range_size) = 0;
 
+    Status _cast_src_block(Block* block);
+
 private:
     // Read next buffer from reader
     Status _open_next_reader();
@@ -74,7 +76,6 @@ private:
     Status _init_arrow_batch_if_necessary();
     Status _init_src_block() override;
     Status _append_batch_to_src_block(Block* block);
-    Status _cast_src_block(Block* block);
 
 private:
     // Reader
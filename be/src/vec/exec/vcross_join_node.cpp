@@ -91,6 +91,7 @@ Status VCrossJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "VCrossJoinNode::get_next");
     RETURN_IF_CANCELLED(state);
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_CONSUME_MEM_TRACKER(mem_tracker());
     *eos = false;
 
@@ -99,6 +100,36 @@ Status VCrossJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
         return Status::OK();
     }
 
+    if (_vconjunct_ctx_ptr == nullptr) {
+        RETURN_IF_ERROR(fill_product_block(state, block));
+    } else {
+        // The conjuncts are evaluated on each batch of the product as it is made, and the output
+        // block collects the matched rows of several batches, rather than returning the few rows
+        // left of one batch by a selective condition like a range join.
+        do {
+            Block product;
+            RETURN_IF_ERROR(fill_product_block(state, &product));
+            RETURN_IF_ERROR(
+                    VExprContext::filter_block(_vconjunct_ctx_ptr, &product, product.columns()));
+            if (block->rows() == 0) {
+                block->swap(product);
+            } else if (product.rows() != 0) {
+                auto dst_columns = block->mutate_columns();
+                for (size_t i = 0; i < dst_columns.size(); ++i) {
+                    dst_columns[i]->insert_range_from(*product.get_by_position(i).column, 0,
+                                                      product.rows());
+                }
+                block->set_columns(std::move(dst_columns));
+            }
+        } while (block->rows() < state->batch_size() && !_eos);
+    }
+    *eos = _eos;
+
+    reached_limit(block, eos);
+    return Status::OK();
+}
+
+Status VCrossJoinNode::fill_product_block(RuntimeState* state, Block* block) {
     auto dst_columns = get_mutable_columns(block);
     ScopedTimer<MonotonicStopWatch> timer(_left_child_timer);
 
@@ -112,7 +143,7 @@ Status VCrossJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
                 _left_block_pos = 0;
 
                 if (_left_side_eos) {
-                    *eos = _eos = true;
+                    _eos = true;
                 } else {
                     do {
                         release_block_memory(_left_block);
@@ -124,7 +155,7 @@ Status VCrossJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
                     } while (_left_block.rows() == 0 && !_left_side_eos);
                     COUNTER_UPDATE(_left_child_row_counter, _left_block.rows());
                     if (_left_block.rows() == 0) {
-                        *eos = _eos = _left_side_eos;
+                        _eos = _left_side_eos;
                     }
                 }
             }
@@ -139,9 +170,6 @@ Status VCrossJoinNode::get_next(RuntimeState* state, Block* block, bool* eos) {
         }
     }
     dst_columns.clear();
-    RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
-
-    reached_limit(block, eos);
     return Status::OK();
 }
 
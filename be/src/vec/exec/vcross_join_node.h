@@ -64,6 +64,9 @@ private:
     uint64_t _build_rows = 0;
     uint64_t _total_mem_usage = 0;
 
+    // Fills block with the next batch_size rows of the product of the left and right child.
+    Status fill_product_block(RuntimeState* state, Block* block);
+
     // Build mutable columns to insert data.
     // if block can mem reuse, just clear data in block
     // else build a new block and alloc mem of column from left and right child block
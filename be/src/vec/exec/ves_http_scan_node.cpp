@@ -17,6 +17,7 @@
 
 #include "vec/exec/ves_http_scan_node.h"
 
+#include "common/config.h"
 #include "exec/es/es_predicate.h"
 #include "exec/es/es_query_builder.h"
 #include "exec/es/es_scan_reader.h"
@@ -185,23 +186,37 @@ static std::string get_host_port(const std::vector<TNetworkAddress>& es_hosts) {
 }
 
 Status VEsHttpScanNode::start_scanners() {
+    // a scroll with a limit returns its documents in one search, so it is not sliced
+    int num_slices = std::max(1, config::es_scroll_slices_per_shard);
+    if (_limit_pushed_down()) {
+        num_slices = 1;
+    }
     {
         std::unique_lock<std::mutex> l(_batch_queue_lock);
-        _num_running_scanners = _scan_ranges.size();
+        _num_running_scanners = _scan_ranges.size() * num_slices;
     }
 
-    _scanners_status.resize(_scan_ranges.size());
+    _scanners_status.resize(_scan_ranges.size() * num_slices);
     for (int i = 0; i < _scan_ranges.size(); i++) {
-        _scanner_threads.emplace_back(
-                [this, i, length = _scan_ranges.size(), &p_status = _scanners_status[i],
-                 parent_span = opentelemetry::trace::Tracer::GetCurrentSpan()] {
-                    OpentelemetryScope scope {parent_span};
-                    this->scanner_worker(i, length, p_status);
-                });
+        for (int slice_id = 0; slice_id < num_slices; slice_id++) {
+            _scanner_threads.emplace_back(
+                    [this, i, length = _scan_ranges.size(), slice_id, num_slices,
+                     &p_status = _scanners_status[i * num_slices + slice_id],
+                     parent_span = opentelemetry::trace::Tracer::GetCurrentSpan()] {
+                        OpentelemetryScope scope {parent_span};
+                        this->scanner_worker(i, length, slice_id, num_slices, p_status);
+                    });
+        }
     }
     return Status::OK();
 }
 
+bool VEsHttpScanNode::_limit_pushed_down() {
+    // if predicate in _conjunct_ctxs can not be processed by Elasticsearch, we can not push down
+    // limit operator to Elasticsearch
+    return limit() != -1 && limit() <= _runtime_state->batch_size() && _conjunct_ctxs.empty();
+}
+
 Status VEsHttpScanNode::get_next(RuntimeState* state, vectorized::Block* block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "VEsHttpScanNode::get_next");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
@@ -382,7 +397,8 @@ void VEsHttpScanNode::debug_string(int ident_level, std::stringstream* out) cons
     (*out) << "VEsHttpScanNode";
 }
 
-void VEsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Status>& p_status) {
+void VEsHttpScanNode::scanner_worker(int start_idx, int length, int slice_id, int num_slices,
+                                     std::promise<Status>& p_status) {
     START_AND_SCOPE_SPAN(_runtime_state->get_tracer(), span, "VEsHttpScanNode::scanner_worker");
     SCOPED_ATTACH_TASK(_runtime_state);
     // Clone expr context
@@ -406,10 +422,13 @@ void VEsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Sta
     properties[ESScanReader::KEY_BATCH_SIZE] = std::to_string(_runtime_state->batch_size());
     properties[ESScanReader::KEY_HOST_PORT] = get_host_port(es_scan_range.es_hosts);
     // push down limit to Elasticsearch
-    // if predicate in _conjunct_ctxs can not be processed by Elasticsearch, we can not push down limit operator to Elasticsearch
-    if (limit() != -1 && limit() <= _runtime_state->batch_size() && _conjunct_ctxs.empty()) {
+    if (_limit_pushed_down()) {
         properties[ESScanReader::KEY_TERMINATE_AFTER] = std::to_string(limit());
     }
+    if (num_slices > 1) {
+        properties[ESScanReader::KEY_SLICE_ID] = std::to_string(slice_id);
+        properties[ESScanReader::KEY_SLICE_MAX] = std::to_string(num_slices);
+    }
 
     bool doc_value_mode = false;
     properties[ESScanReader::KEY_QUERY] = ESScrollQueryBuilder::build(
@@ -421,8 +440,8 @@ void VEsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Sta
                                            scanner_expr_ctxs, &counter, doc_value_mode));
     status = scanner_scan(std::move(scanner));
     if (!status.ok()) {
-        LOG(WARNING) << "Scanner[" << start_idx
-                     << "] process failed. status=" << status.get_error_msg();
+        LOG(WARNING) << "Scanner[" << start_idx << "] slice " << slice_id
+                     << " process failed. status=" << status.get_error_msg();
     }
 
     // scanner is going to finish
@@ -59,8 +59,10 @@ private:
         }
         return false;
     }
-    // One scanner worker, This scanner will handle 'length' ranges start from start_idx
-    virtual void scanner_worker(int start_idx, int length, std::promise<Status>& p_status);
+    // One scanner worker, This scanner will handle 'length' ranges start from start_idx,
+    // reading the slice slice_id of num_slices of the scroll of the shard
+    virtual void scanner_worker(int start_idx, int length, int slice_id, int num_slices,
+                                std::promise<Status>& p_status);
 
     TupleId _tuple_id;
     RuntimeState* _runtime_state;
@@ -84,6 +86,8 @@ private:
 
     // Collect all scanners 's status
     Status collect_scanners_status();
+    // whether the limit is pushed down to Elasticsearch as terminate_after
+    bool _limit_pushed_down();
 
     Status build_conjuncts_list();
 
@@ -43,20 +43,28 @@ Status VExceptNode::prepare(RuntimeState* state) {
 
 Status VExceptNode::open(RuntimeState* state) {
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "VExceptNode::open");
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(VSetOperationNode::open(state));
     bool eos = false;
     Status st;
     for (int i = 1; i < _children.size(); ++i) {
+        // all the rows are already excepted, the rest of the children are not read
+        if (_valid_element_in_hash_tbl == 0) {
+            break;
+        }
         if (i > 1) {
             refresh_hash_table<false>();
         }
 
-        RETURN_IF_ERROR(child(i)->open(state));
+        // child(1) is opened with the build of the hash table
+        if (i > 1) {
+            RETURN_IF_ERROR(child(i)->open(state));
+        }
         eos = false;
         int probe_expr_ctxs_sz = _child_expr_lists[i].size();
         _probe_columns.resize(probe_expr_ctxs_sz);
 
-        while (!eos) {
+        while (!eos && _valid_element_in_hash_tbl > 0) {
             RETURN_IF_ERROR(process_probe_block(state, i, &eos));
             if (_probe_rows == 0) continue;
 
@@ -81,6 +89,7 @@ Status VExceptNode::open(RuntimeState* state) {
 Status VExceptNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "VExceptNode::get_next");
     SCOPED_TIMER(_probe_timer);
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     Status st;
     create_mutable_cols(output_block);
 
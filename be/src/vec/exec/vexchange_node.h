@@ -38,6 +38,8 @@ public:
     virtual Status get_next(RuntimeState* state, Block* row_batch, bool* eos) override;
     virtual Status close(RuntimeState* state) override;
 
+    bool can_read() override { return _stream_recvr == nullptr || _stream_recvr->ready_to_read(); }
+
     // Status collect_query_statistics(QueryStatistics* statistics) override;
     void set_num_senders(int num_senders) { _num_senders = num_senders; }
 
@@ -43,21 +43,31 @@ Status VIntersectNode::prepare(RuntimeState* state) {
 
 Status VIntersectNode::open(RuntimeState* state) {
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "VIntersectNode::open");
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(VSetOperationNode::open(state));
     bool eos = false;
     Status st;
 
     for (int i = 1; i < _children.size(); ++i) {
+        // the intersection is already empty, the rest of the children are not read
+        if (_valid_element_in_hash_tbl == 0) {
+            break;
+        }
         if (i > 1) {
             refresh_hash_table<true>();
         }
 
+        const int64_t hash_table_size = _valid_element_in_hash_tbl;
         _valid_element_in_hash_tbl = 0;
-        RETURN_IF_ERROR(child(i)->open(state));
+        // child(1) is opened with the build of the hash table
+        if (i > 1) {
+            RETURN_IF_ERROR(child(i)->open(state));
+        }
         eos = false;
         _probe_columns.resize(_child_expr_lists[i].size());
 
-        while (!eos) {
+        // the rest of the child is not read once all the rows of the hash table are matched
+        while (!eos && _valid_element_in_hash_tbl < hash_table_size) {
             RETURN_IF_ERROR(process_probe_block(state, i, &eos));
             if (_probe_rows == 0) continue;
 
@@ -82,6 +92,7 @@ Status VIntersectNode::open(RuntimeState* state) {
 Status VIntersectNode::get_next(RuntimeState* state, Block* output_block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "VIntersectNode::get_next");
     SCOPED_TIMER(_probe_timer);
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     create_mutable_cols(output_block);
     Status st;
 
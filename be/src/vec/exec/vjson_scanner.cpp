@@ -20,7 +20,9 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cctype>
 
+#include "common/config.h"
 #include "exec/line_reader.h"
 #include "exprs/json_functions.h"
 #include "runtime/runtime_state.h"
@@ -61,8 +63,13 @@ Status VJsonScanner::get_next(vectorized::Block* output_block, bool* eof) {
         }
 
         bool is_empty_row = false;
-        RETURN_IF_ERROR(_cur_vjson_reader->read_json_column(columns, _src_slot_descs, &is_empty_row,
-                                                            &_cur_reader_eof));
+        if (_cur_vsimd_json_reader != nullptr) {
+            RETURN_IF_ERROR(_cur_vsimd_json_reader->read_json_column(
+                    columns, _src_slot_descs, &is_empty_row, &_cur_reader_eof));
+        } else {
+            RETURN_IF_ERROR(_cur_vjson_reader->read_json_column(
+                    columns, _src_slot_descs, &is_empty_row, &_cur_reader_eof));
+        }
         if (is_empty_row) {
             // Read empty row, just continue
             continue;
@@ -90,6 +97,9 @@ Status VJsonScanner::open_vjson_reader() {
     if (_cur_vjson_reader != nullptr) {
         _cur_vjson_reader.reset();
     }
+    if (_cur_vsimd_json_reader != nullptr) {
+        _cur_vsimd_json_reader.reset();
+    }
     std::string json_root = "";
     std::string jsonpath = "";
     bool strip_outer_array = false;
@@ -98,6 +108,23 @@ Status VJsonScanner::open_vjson_reader() {
 
     RETURN_IF_ERROR(JsonScanner::get_range_params(jsonpath, json_root, strip_outer_array,
                                                   num_as_string, fuzzy_parse));
+    if (config::enable_simdjson_reader) {
+        if (_read_json_by_line) {
+            _cur_vsimd_json_reader.reset(new VSIMDJsonReader(
+                    _state, _counter, _profile, strip_outer_array, num_as_string, fuzzy_parse,
+                    &_scanner_eof, nullptr, _cur_line_reader));
+        } else {
+            _cur_vsimd_json_reader.reset(new VSIMDJsonReader(
+                    _state, _counter, _profile, strip_outer_array, num_as_string, fuzzy_parse,
+                    &_scanner_eof, _cur_file_reader.get()));
+        }
+        Status st = _cur_vsimd_json_reader->init(jsonpath, json_root, _src_slot_descs);
+        if (!st.is_not_supported()) {
+            return st;
+        }
+        // the jsonpaths or the json root are not supported, read the range with rapidjson
+        _cur_vsimd_json_reader.reset();
+    }
     if (_read_json_by_line) {
         _cur_vjson_reader.reset(new VJsonReader(_state, _counter, _profile, strip_outer_array,
                                                 num_as_string, fuzzy_parse, &_scanner_eof, nullptr,
@@ -504,4 +531,403 @@ Status VJsonReader::_append_error_msg(const rapidjson::Value& objectValue, std::
     return Status::OK();
 }
 
+VSIMDJsonReader::VSIMDJsonReader(RuntimeState* state, ScannerCounter* counter,
+                                 RuntimeProfile* profile, bool strip_outer_array,
+                                 bool num_as_string, bool fuzzy_parse, bool* scanner_eof,
+                                 FileReader* file_reader, LineReader* line_reader)
+        : JsonReader(state, counter, profile, strip_outer_array, num_as_string, fuzzy_parse,
+                     scanner_eof, file_reader, line_reader) {}
+
+VSIMDJsonReader::~VSIMDJsonReader() {}
+
+static std::string parse_error_msg(simdjson::error_code err) {
+    return fmt::format("Parse json data failed. code: {}, error info: {}", static_cast<int>(err),
+                       simdjson::error_message(err));
+}
+
+// the keys of a jsonpath, which must start with "$" and contain object keys only
+static Status get_json_keys(const std::vector<JsonPath>& path, std::vector<std::string>* keys) {
+    if (path.empty() || !path[0].is_valid || path[0].key != "$" || path[0].idx != -1) {
+        return Status::NotSupported("json path does not start with $");
+    }
+    for (size_t i = 1; i < path.size(); ++i) {
+        if (!path[i].is_valid || path[i].key.empty() || path[i].idx != -1) {
+            return Status::NotSupported("json path {} is not made of object keys",
+                                        path[i].to_string());
+        }
+        keys->push_back(path[i].key);
+    }
+    return Status::OK();
+}
+
+Status VSIMDJsonReader::init(const std::string& jsonpath, const std::string& json_root,
+                             const std::vector<SlotDescriptor*>& slot_descs) {
+    RETURN_IF_ERROR(JsonReader::_parse_jsonpath_and_json_root(jsonpath, json_root));
+
+    _has_jsonpaths = !_parsed_jsonpaths.empty();
+    if (_has_jsonpaths) {
+        // the slots after the jsonpaths are not matched
+        for (size_t i = 0; i < _parsed_jsonpaths.size() && i < slot_descs.size(); ++i) {
+            std::vector<std::string> keys;
+            RETURN_IF_ERROR(get_json_keys(_parsed_jsonpaths[i], &keys));
+            RETURN_IF_ERROR(_add_key_path(keys, i));
+        }
+    } else {
+        for (size_t i = 0; i < slot_descs.size(); ++i) {
+            if (slot_descs[i]->is_materialized()) {
+                RETURN_IF_ERROR(_add_key_path({slot_descs[i]->col_name()}, i));
+            }
+        }
+    }
+    if (!_parsed_json_root.empty()) {
+        RETURN_IF_ERROR(get_json_keys(_parsed_json_root, &_json_root_keys));
+    }
+    _values.resize(slot_descs.size());
+    return Status::OK();
+}
+
+Status VSIMDJsonReader::_add_key_path(const std::vector<std::string>& keys, int slot) {
+    KeyNode* node = &_key_tree;
+    for (const auto& key : keys) {
+        if (!node->slots.empty()) {
+            // the value of a key can only be read once, so it can not be both a column value
+            // and an object to read other columns from
+            return Status::NotSupported("json path of slot {} is in another one", slot);
+        }
+        auto it = node->children.find(key);
+        if (it == node->children.end()) {
+            auto child = std::make_unique<KeyNode>();
+            child->key = key;
+            std::string_view child_key = child->key;
+            it = node->children.emplace(child_key, std::move(child)).first;
+        }
+        node = it->second.get();
+    }
+    if (node == &_key_tree || !node->children.empty()) {
+        return Status::NotSupported("json path of slot {} is the root or in another one", slot);
+    }
+    node->slots.push_back(slot);
+    return Status::OK();
+}
+
+Status VSIMDJsonReader::read_json_column(std::vector<MutableColumnPtr>& columns,
+                                         const std::vector<SlotDescriptor*>& slot_descs,
+                                         bool* is_empty_row, bool* eof) {
+    while (true) {
+        if (!_has_rows) {
+            Status st = _next_document(eof);
+            if (st.is_data_quality_error()) {
+                continue; // continue to read next
+            }
+            RETURN_IF_ERROR(st);
+            if (*eof) {
+                *is_empty_row = true;
+                return Status::OK();
+            }
+            if (!_has_rows) {
+                continue;
+            }
+        }
+
+        for (auto& value : _values) {
+            value = ColumnValue();
+        }
+        simdjson::error_code err = simdjson::SUCCESS;
+        if (_is_array) {
+            if (_array_iter == _array_end) {
+                _has_rows = false;
+                continue;
+            }
+            simdjson::ondemand::object object;
+            err = (*_array_iter).get_object().get(object);
+            if (err == simdjson::SUCCESS) {
+                err = _read_object(object, _key_tree);
+            }
+            ++_array_iter;
+        } else {
+            _has_rows = false;
+            err = _read_object(_object, _key_tree);
+        }
+
+        bool valid = true;
+        if (err == simdjson::INCORRECT_TYPE) {
+            // Here we expect the row to be a Json Object, such as {"key" : "value"}
+            RETURN_IF_ERROR(_append_error_msg("Expect json object value", &valid));
+        } else if (err != simdjson::SUCCESS) {
+            // the on demand parser finds some errors only when it reaches them, the rest of the
+            // document can not be read
+            _has_rows = false;
+            RETURN_IF_ERROR(_append_error_msg(
+                    parse_error_msg(err), &valid));
+        } else {
+            RETURN_IF_ERROR(_write_row(columns, slot_descs, &valid));
+        }
+        if (valid) {
+            *is_empty_row = false;
+            return Status::OK();
+        }
+        if (*_scanner_eof) {
+            // When _scanner_eof is true and valid is false, it means that we have encountered
+            // unqualified data and decided to stop the scan.
+            *is_empty_row = true;
+            return Status::OK();
+        }
+    }
+}
+
+Status VSIMDJsonReader::_next_document(bool* eof) {
+    _has_rows = false;
+    const uint8_t* json_str = nullptr;
+    std::unique_ptr<uint8_t[]> json_str_ptr;
+    size_t size = 0;
+    {
+        SCOPED_TIMER(_file_read_timer);
+        if (_line_reader != nullptr) {
+            RETURN_IF_ERROR(_line_reader->read_line(&json_str, &size, eof));
+        } else {
+            int64_t length = 0;
+            RETURN_IF_ERROR(_file_reader->read_one_message(&json_str_ptr, &length));
+            json_str = json_str_ptr.get();
+            size = length;
+            if (length == 0) {
+                *eof = true;
+            }
+        }
+    }
+    COUNTER_UPDATE(_bytes_read_counter, size);
+    if (*eof || size == 0) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_read_timer);
+    _json_buf.resize(size + simdjson::SIMDJSON_PADDING);
+    memcpy(_json_buf.data(), json_str, size);
+    _json_size = size;
+    auto err = _parser.iterate(_json_buf.data(), size, _json_buf.size()).get(_document);
+    if (err != simdjson::SUCCESS) {
+        return _document_error(parse_error_msg(err), eof);
+    }
+
+    if (_json_root_keys.empty()) {
+        return _start_rows(_document, eof);
+    }
+    auto root = _document.find_field_unordered(_json_root_keys[0]);
+    for (size_t i = 1; i < _json_root_keys.size(); ++i) {
+        root = root.find_field_unordered(_json_root_keys[i]);
+    }
+    simdjson::ondemand::value root_value;
+    err = std::move(root).get(root_value);
+    if (err == simdjson::NO_SUCH_FIELD || err == simdjson::INCORRECT_TYPE) {
+        return _document_error("JSON Root not found.", eof);
+    } else if (err != simdjson::SUCCESS) {
+        return _document_error(parse_error_msg(err), eof);
+    }
+    return _start_rows(root_value, eof);
+}
+
+template <typename JsonValue>
+Status VSIMDJsonReader::_start_rows(JsonValue& value, bool* eof) {
+    simdjson::ondemand::json_type type;
+    auto err = value.type().get(type);
+    if (err == simdjson::SUCCESS) {
+        if (type == simdjson::ondemand::json_type::array) {
+            if (!_strip_outer_array) {
+                return _document_error(
+                        "JSON data is array-object, `strip_outer_array` must be TRUE.", eof);
+            }
+            simdjson::ondemand::array array;
+            err = value.get_array().get(array);
+            if (err == simdjson::SUCCESS) {
+                err = array.begin().get(_array_iter);
+            }
+            if (err == simdjson::SUCCESS) {
+                err = array.end().get(_array_end);
+            }
+            _is_array = true;
+        } else {
+            if (_strip_outer_array) {
+                return _document_error(
+                        "JSON data is not an array-object, `strip_outer_array` must be FALSE.",
+                        eof);
+            }
+            err = value.get_object().get(_object);
+            if (err == simdjson::INCORRECT_TYPE) {
+                return _document_error("Expect json object value", eof);
+            }
+            _is_array = false;
+        }
+    }
+    if (err != simdjson::SUCCESS) {
+        return _document_error(parse_error_msg(err), eof);
+    }
+    _has_rows = true;
+    return Status::OK();
+}
+
+simdjson::error_code VSIMDJsonReader::_read_object(simdjson::ondemand::object& object,
+                                                   const KeyNode& node) {
+    for (auto field_result : object) {
+        simdjson::ondemand::field field;
+        std::string_view key;
+        auto err = std::move(field_result).get(field);
+        if (err == simdjson::SUCCESS) {
+            err = field.unescaped_key().get(key);
+        }
+        if (err != simdjson::SUCCESS) {
+            return err;
+        }
+        auto it = node.children.find(key);
+        if (it == node.children.end()) {
+            // the value is skipped without being parsed
+            continue;
+        }
+        err = _read_value(field.value(), *it->second);
+        if (err != simdjson::SUCCESS) {
+            return err;
+        }
+    }
+    return simdjson::SUCCESS;
+}
+
+simdjson::error_code VSIMDJsonReader::_read_value(simdjson::ondemand::value& value,
+                                                  const KeyNode& node) {
+    simdjson::ondemand::json_type type;
+    auto err = value.type().get(type);
+    if (err != simdjson::SUCCESS) {
+        return err;
+    }
+    if (node.slots.empty()) {
+        // the keys of the children are searched in the value, which is not matched if it is not
+        // an object
+        if (type != simdjson::ondemand::json_type::object) {
+            return simdjson::SUCCESS;
+        }
+        simdjson::ondemand::object object;
+        err = value.get_object().get(object);
+        if (err != simdjson::SUCCESS) {
+            return err;
+        }
+        return _read_object(object, node);
+    }
+
+    ColumnValue column_value;
+    column_value.found = true;
+    switch (type) {
+    case simdjson::ondemand::json_type::string:
+        err = value.get_string().get(column_value.value);
+        break;
+    case simdjson::ondemand::json_type::number: {
+        // the number is kept as it is in the json data, it is converted by the load expressions
+        std::string_view token = value.raw_json_token();
+        while (!token.empty() && std::isspace(static_cast<unsigned char>(token.back()))) {
+            token.remove_suffix(1);
+        }
+        column_value.value = token;
+        break;
+    }
+    case simdjson::ondemand::json_type::boolean: {
+        bool bool_value = false;
+        err = value.get_bool().get(bool_value);
+        column_value.value = bool_value ? "1" : "0";
+        break;
+    }
+    case simdjson::ondemand::json_type::null:
+        column_value.is_null = true;
+        break;
+    default:
+        // for other type like array or object. we convert it to string to save
+        err = simdjson::to_json_string(value).get(column_value.value);
+        break;
+    }
+    for (int slot : node.slots) {
+        // the first one of duplicated keys is used, as rapidjson FindMember() does
+        if (!_values[slot].found) {
+            _values[slot] = column_value;
+        }
+    }
+    return err;
+}
+
+Status VSIMDJsonReader::_write_row(std::vector<MutableColumnPtr>& columns,
+                                   const std::vector<SlotDescriptor*>& slot_descs, bool* valid) {
+    // check the row before writing it, so the columns are not left with different sizes
+    int nullcount = 0;
+    for (size_t i = 0; i < slot_descs.size(); ++i) {
+        auto* slot_desc = slot_descs[i];
+        if (!_has_jsonpaths && !slot_desc->is_materialized()) {
+            continue;
+        }
+        const ColumnValue& value = _values[i];
+        if (!value.found) {
+            nullcount++;
+        }
+        if (slot_desc->is_nullable()) {
+            continue;
+        }
+        if (!value.found) {
+            return _append_error_msg(
+                    fmt::format("The column `{}` is not nullable, but it's not found in jsondata.",
+                                slot_desc->col_name()),
+                    valid);
+        } else if (value.is_null) {
+            return _append_error_msg(
+                    fmt::format("Json value is null, but the column `{}` is not nullable.",
+                                slot_desc->col_name()),
+                    valid);
+        }
+    }
+    if (nullcount == slot_descs.size()) {
+        return _append_error_msg(
+                _has_jsonpaths ? "All fields is null or not matched, this is a invalid row."
+                               : "All fields is null, this is a invalid row.",
+                valid);
+    }
+
+    int ctx_idx = 0;
+    for (size_t i = 0; i < slot_descs.size(); ++i) {
+        auto* slot_desc = slot_descs[i];
+        if (!_has_jsonpaths && !slot_desc->is_materialized()) {
+            continue;
+        }
+        const ColumnValue& value = _values[i];
+        auto* column_ptr = columns[ctx_idx++].get();
+        if (slot_desc->is_nullable()) {
+            auto* nullable_column = reinterpret_cast<vectorized::ColumnNullable*>(column_ptr);
+            if (!value.found || value.is_null) {
+                nullable_column->insert_default();
+                continue;
+            }
+            nullable_column->get_null_map_data().push_back(0);
+            column_ptr = &nullable_column->get_nested_column();
+        }
+        DCHECK(slot_desc->type().type == TYPE_VARCHAR);
+        assert_cast<ColumnString*>(column_ptr)->insert_data(value.value.data(), value.value.size());
+    }
+    *valid = true;
+    return Status::OK();
+}
+
+Status VSIMDJsonReader::_document_error(const std::string& error_msg, bool* eof) {
+    RETURN_IF_ERROR(_state->append_error_msg_to_file(
+            [&]() -> std::string { return std::string(_json_buf.data(), _json_size); },
+            [&]() -> std::string { return error_msg; }, _scanner_eof));
+    _counter->num_rows_filtered++;
+    if (*_scanner_eof) {
+        // we meet enough invalid rows and the scanner should be stopped, so we set eof to true
+        // and return OK, the caller will stop the process as we meet the end of file.
+        *eof = true;
+        return Status::OK();
+    }
+    return Status::DataQualityError(error_msg);
+}
+
+Status VSIMDJsonReader::_append_error_msg(const std::string& error_msg, bool* valid) {
+    RETURN_IF_ERROR(_state->append_error_msg_to_file(
+            [&]() -> std::string { return std::string(_json_buf.data(), _json_size); },
+            [&]() -> std::string { return error_msg; }, _scanner_eof));
+    _counter->num_rows_filtered++;
+    *valid = false;
+    return Status::OK();
+}
+
 } // namespace doris::vectorized
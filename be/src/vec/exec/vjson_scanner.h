@@ -21,11 +21,13 @@
 #include <rapidjson/error/en.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
+#include <simdjson.h>
 
 #include <map>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -40,6 +42,7 @@ class ExprContext;
 
 namespace vectorized {
 class VJsonReader;
+class VSIMDJsonReader;
 
 class VJsonScanner : public JsonScanner {
 public:
@@ -60,6 +63,9 @@ private:
 
 private:
     std::unique_ptr<VJsonReader> _cur_vjson_reader;
+    // used instead of _cur_vjson_reader if enable_simdjson_reader is set and it supports the
+    // jsonpaths and the json root of the range
+    std::unique_ptr<VSIMDJsonReader> _cur_vsimd_json_reader;
 };
 
 class VJsonReader : public JsonReader {
@@ -110,5 +116,82 @@ private:
                              std::string col_name, bool* valid);
 };
 
+// Reads the json data with the on-demand parser of simdjson, which does not build a DOM: the
+// values of the columns are taken while the fields of each object are iterated once, looked up in
+// a tree of the keys of the jsonpaths, or of the column names if there is no jsonpath. It supports
+// record-per-line and array (strip_outer_array) data, and jsonpaths and a json root made of object
+// keys only; init() returns NotSupported for the others, which are read by VJsonReader.
+class VSIMDJsonReader : public JsonReader {
+public:
+    VSIMDJsonReader(RuntimeState* state, ScannerCounter* counter, RuntimeProfile* profile,
+                    bool strip_outer_array, bool num_as_string, bool fuzzy_parse,
+                    bool* scanner_eof, FileReader* file_reader = nullptr,
+                    LineReader* line_reader = nullptr);
+
+    ~VSIMDJsonReader();
+
+    Status init(const std::string& jsonpath, const std::string& json_root,
+                const std::vector<SlotDescriptor*>& slot_descs);
+
+    Status read_json_column(std::vector<MutableColumnPtr>& columns,
+                            const std::vector<SlotDescriptor*>& slot_descs, bool* is_empty_row,
+                            bool* eof);
+
+private:
+    // a key of the object the node is in, the value of the key is the value of the slots of the
+    // node if it has any, or an object searched for the keys of the children of the node
+    struct KeyNode {
+        std::string key;
+        // the keys of the children are views of their own key
+        std::unordered_map<std::string_view, std::unique_ptr<KeyNode>> children;
+        std::vector<int> slots;
+    };
+
+    struct ColumnValue {
+        bool found = false;
+        bool is_null = false;
+        std::string_view value;
+    };
+
+    // add the slot at the path of the keys to the key tree
+    Status _add_key_path(const std::vector<std::string>& keys, int slot);
+
+    // read and parse the next json document, and position the rows to read in it
+    Status _next_document(bool* eof);
+
+    template <typename JsonValue>
+    Status _start_rows(JsonValue& value, bool* eof);
+
+    // record an invalid document, the same way as JsonReader::_parse_json_doc() does
+    Status _document_error(const std::string& error_msg, bool* eof);
+
+    simdjson::error_code _read_object(simdjson::ondemand::object& object, const KeyNode& node);
+
+    simdjson::error_code _read_value(simdjson::ondemand::value& value, const KeyNode& node);
+
+    Status _write_row(std::vector<MutableColumnPtr>& columns,
+                      const std::vector<SlotDescriptor*>& slot_descs, bool* valid);
+
+    Status _append_error_msg(const std::string& error_msg, bool* valid);
+
+    simdjson::ondemand::parser _parser;
+    simdjson::ondemand::document _document;
+    // the current document, padded for the parser which reads past its end
+    std::vector<char> _json_buf;
+    size_t _json_size = 0;
+
+    bool _has_rows = false;
+    bool _is_array = false;
+    simdjson::ondemand::object _object;
+    simdjson::ondemand::array_iterator _array_iter;
+    simdjson::ondemand::array_iterator _array_end;
+
+    KeyNode _key_tree;
+    std::vector<std::string> _json_root_keys;
+    // the values of the current row, by slot index
+    std::vector<ColumnValue> _values;
+    bool _has_jsonpaths = false;
+};
+
 } // namespace vectorized
 } // namespace doris
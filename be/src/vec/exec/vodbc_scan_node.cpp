@@ -159,21 +159,18 @@ Status VOdbcScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
             }
         }
 
-        for (int row_index = 0; true; row_index++) {
-            // block is full, break
-            if (state->batch_size() <= columns[0]->size()) {
-                break;
-            }
-
-            RETURN_IF_ERROR(odbc_scanner->get_next_row(&odbc_eos));
+        // the rows are fetched in batches and converted a column at a time
+        while (columns[0]->size() < state->batch_size()) {
+            size_t first_row = 0;
+            size_t num_rows = 0;
+            RETURN_IF_ERROR(odbc_scanner->get_next_rows(state->batch_size() - columns[0]->size(),
+                                                        &first_row, &num_rows, &odbc_eos));
 
             if (odbc_eos) {
                 *eos = true;
                 break;
             }
 
-            // Read one row from reader
-
             for (int column_index = 0, materialized_column_index = 0; column_index < column_size;
                  ++column_index) {
                 auto slot_desc = tuple_desc->slots()[column_index];
@@ -182,16 +179,27 @@ Status VOdbcScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
                     continue;
                 }
                 const auto& column_data = odbc_scanner->get_column_data(materialized_column_index);
-
-                char* value_data = static_cast<char*>(column_data.target_value_ptr);
-                int value_len = column_data.strlen_or_ind;
-
-                if (!text_converter->write_column(slot_desc, &columns[column_index], value_data,
-                                                  value_len, true, false)) {
-                    std::stringstream ss;
-                    ss << "Fail to convert odbc value:'" << value_data << "' to "
-                       << slot_desc->type() << " on column:`" << slot_desc->col_name() + "`";
-                    return Status::InternalError(ss.str());
+                IColumn* column = columns[column_index].get();
+                for (size_t row = first_row; row < first_row + num_rows; ++row) {
+                    char* value_data = column_data.value(row);
+                    auto value_len = column_data.strlen_or_ind[row];
+                    if (value_len == SQL_NULL_DATA && !slot_desc->is_nullable()) {
+                        return Status::InternalError(
+                                "nonnull column contains NULL. table={}, column={}", _table_name,
+                                slot_desc->col_name());
+                    } else if (value_len > column_data.buffer_length) {
+                        return Status::InternalError(
+                                "odbc value is longer than {} bytes. table={}, column={}",
+                                column_data.buffer_length, _table_name, slot_desc->col_name());
+                    }
+
+                    if (!text_converter->write_vec_column(slot_desc, column, value_data,
+                                                          value_len, true, false)) {
+                        std::stringstream ss;
+                        ss << "Fail to convert odbc value:'" << value_data << "' to "
+                           << slot_desc->type() << " on column:`" << slot_desc->col_name() + "`";
+                        return Status::InternalError(ss.str());
+                    }
                 }
                 materialized_column_index++;
             }
@@ -21,6 +21,7 @@
 #include "exec/scan_node.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "olap/storage_engine.h"
+#include "olap/topn_boundary.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/large_int_value.h"
@@ -32,10 +33,91 @@
 #include "vec/exec/volap_scanner.h"
 #include "vec/exprs/vcompound_pred.h"
 #include "vec/exprs/vexpr.h"
+#include "vec/exprs/vfolded_constant.h"
 
 namespace doris::vectorized {
 using doris::operator<<;
 
+// the weight of a new observation in the moving averages
+static constexpr double TUNER_OBSERVATION_WEIGHT = 0.125;
+// a scan returning less of the rows it reads is selective
+static constexpr double TUNER_SELECTIVE_RATIO = 1.0 / 16;
+// the number of blocks taken by the consumer between two updates of the scanners
+static constexpr int TUNER_UPDATE_INTERVAL = 16;
+
+ScannerScheduleTuner::ScannerScheduleTuner(int max_scanners, int64_t min_block_rows,
+                                           int64_t max_block_rows, int64_t initial_block_rows,
+                                           int64_t target_block_bytes,
+                                           int64_t memory_budget_bytes)
+        : _max_scanners(std::max(max_scanners, 1)),
+          _min_block_rows(std::max<int64_t>(min_block_rows, 1)),
+          _max_block_rows(std::max(max_block_rows, _min_block_rows)),
+          _initial_block_rows(std::clamp(initial_block_rows, _min_block_rows, _max_block_rows)),
+          _target_block_bytes(target_block_bytes),
+          _memory_budget_bytes(memory_budget_bytes),
+          _max_running_scanners(_max_scanners),
+          _block_rows(_initial_block_rows) {}
+
+void ScannerScheduleTuner::on_scanned(int64_t raw_rows, int64_t rows, int64_t bytes) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (rows > 0) {
+        double bytes_per_row = static_cast<double>(bytes) / rows;
+        _bytes_per_row = _bytes_per_row == 0
+                                 ? bytes_per_row
+                                 : _bytes_per_row + TUNER_OBSERVATION_WEIGHT *
+                                                            (bytes_per_row - _bytes_per_row);
+    }
+    if (raw_rows > 0) {
+        double selectivity = std::min(1.0, static_cast<double>(rows) / raw_rows);
+        _selectivity += TUNER_OBSERVATION_WEIGHT * (selectivity - _selectivity);
+    }
+    _update_block_rows();
+}
+
+void ScannerScheduleTuner::on_consumed(bool waited) {
+    std::lock_guard<std::mutex> l(_lock);
+    ++_num_consumed;
+    _num_waited += waited;
+    if (_num_consumed >= TUNER_UPDATE_INTERVAL) {
+        _update_scanners();
+    }
+}
+
+void ScannerScheduleTuner::on_queue_full() {
+    std::lock_guard<std::mutex> l(_lock);
+    _queue_full = true;
+}
+
+void ScannerScheduleTuner::_update_block_rows() {
+    int64_t block_rows = _initial_block_rows;
+    if (_bytes_per_row > 0) {
+        block_rows = static_cast<int64_t>(_target_block_bytes / _bytes_per_row);
+    }
+    if (_selectivity < TUNER_SELECTIVE_RATIO) {
+        block_rows = std::min(block_rows, _initial_block_rows);
+    }
+    _block_rows = std::clamp(block_rows, _min_block_rows, _max_block_rows);
+}
+
+void ScannerScheduleTuner::_update_scanners() {
+    int scanners = _max_running_scanners;
+    if (_queue_full) {
+        --scanners;
+    } else if (_num_waited * 2 > _num_consumed) {
+        ++scanners;
+    }
+    int limit = _max_scanners;
+    if (_bytes_per_row > 0 && _memory_budget_bytes > 0) {
+        double block_bytes = std::max(1.0, _block_rows * _bytes_per_row);
+        auto blocks_in_budget = static_cast<int64_t>(_memory_budget_bytes / block_bytes);
+        limit = static_cast<int>(std::min<int64_t>(limit, blocks_in_budget));
+    }
+    _max_running_scanners = std::clamp(scanners, 1, std::max(limit, 1));
+    _num_consumed = 0;
+    _num_waited = 0;
+    _queue_full = false;
+}
+
 VOlapScanNode::VOlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
         : ScanNode(pool, tnode, descs),
           _tuple_id(tnode.olap_scan_node.tuple_id),
@@ -79,7 +161,7 @@ Status VOlapScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
     /// TODO: could one filter used in the different scan_node ?
     int filter_size = _runtime_filter_descs.size();
     _runtime_filter_ctxs.resize(filter_size);
-    _runtime_filter_ready_flag.resize(filter_size);
+    _late_runtime_filters.resize(filter_size);
     for (int i = 0; i < filter_size; ++i) {
         IRuntimeFilter* runtime_filter = nullptr;
         const auto& filter_desc = _runtime_filter_descs[i];
@@ -89,7 +171,6 @@ Status VOlapScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
                                                                         &runtime_filter));
 
         _runtime_filter_ctxs[i].runtimefilter = runtime_filter;
-        _runtime_filter_ready_flag[i] = false;
         _rf_locks.push_back(std::make_unique<std::mutex>());
     }
 
@@ -142,6 +223,7 @@ void VOlapScanNode::_init_counter(RuntimeState* state) {
 
     _stats_filtered_counter = ADD_COUNTER(_segment_profile, "RowsStatsFiltered", TUnit::UNIT);
     _bf_filtered_counter = ADD_COUNTER(_segment_profile, "RowsBloomFilterFiltered", TUnit::UNIT);
+    _topn_filtered_counter = ADD_COUNTER(_segment_profile, "RowsTopNFiltered", TUnit::UNIT);
     _del_filtered_counter = ADD_COUNTER(_scanner_profile, "RowsDelFiltered", TUnit::UNIT);
     _conditions_filtered_counter =
             ADD_COUNTER(_segment_profile, "RowsConditionsFiltered", TUnit::UNIT);
@@ -154,18 +236,31 @@ void VOlapScanNode::_init_counter(RuntimeState* state) {
 
     _scan_timer = ADD_TIMER(_scanner_profile, "ScanTime");
     _scan_cpu_timer = ADD_TIMER(_scanner_profile, "ScanCpuTime");
+    if (state->enable_perf_counters()) {
+        _scanner_perf_counters = std::make_unique<ProfilePerfCounters>(_scanner_profile.get());
+    }
 
     _total_pages_num_counter = ADD_COUNTER(_segment_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_segment_profile, "CachedPagesNum", TUnit::UNIT);
+    _cached_compressed_pages_num_counter =
+            ADD_COUNTER(_segment_profile, "CachedCompressedPagesNum", TUnit::UNIT);
 
     _bitmap_index_filter_counter =
             ADD_COUNTER(_segment_profile, "RowsBitmapIndexFiltered", TUnit::UNIT);
     _bitmap_index_filter_timer = ADD_TIMER(_segment_profile, "BitmapIndexFilterTimer");
+    _inverted_index_filter_counter =
+            ADD_COUNTER(_segment_profile, "RowsInvertedIndexFiltered", TUnit::UNIT);
+    _inverted_index_filter_timer = ADD_TIMER(_segment_profile, "InvertedIndexFilterTimer");
 
     _num_scanners = ADD_COUNTER(_runtime_profile, "NumScanners", TUnit::UNIT);
+    // scanners applying a runtime filter arrived after the scan started
+    _late_runtime_filter_counter =
+            ADD_COUNTER(_runtime_profile, "LateArrivalRuntimeFilterScanners", TUnit::UNIT);
 
     _filtered_segment_counter = ADD_COUNTER(_segment_profile, "NumSegmentFiltered", TUnit::UNIT);
     _total_segment_counter = ADD_COUNTER(_segment_profile, "NumSegmentTotal", TUnit::UNIT);
+    _metadata_answered_segment_counter =
+            ADD_COUNTER(_segment_profile, "NumSegmentAnsweredByMetadata", TUnit::UNIT);
 
     // time of transfer thread to wait for row batch from scan thread
     _scanner_wait_batch_timer = ADD_TIMER(_runtime_profile, "ScannerBatchWaitTime");
@@ -191,6 +286,8 @@ Status VOlapScanNode::prepare(RuntimeState* state) {
     // create timer
     _tablet_counter = ADD_COUNTER(runtime_profile(), "TabletCount ", TUnit::UNIT);
     _scanner_sched_counter = ADD_COUNTER(runtime_profile(), "ScannerSchedCount ", TUnit::UNIT);
+    _tuned_scanner_num_counter = ADD_COUNTER(runtime_profile(), "TunedScannerNum", TUnit::UNIT);
+    _tuned_block_rows_counter = ADD_COUNTER(runtime_profile(), "TunedBlockRows", TUnit::UNIT);
 
     _rows_pushed_cond_filtered_counter =
             ADD_COUNTER(_scanner_profile, "RowsPushedCondFiltered", TUnit::UNIT);
@@ -231,6 +328,17 @@ Status VOlapScanNode::prepare(RuntimeState* state) {
     return Status::OK();
 }
 
+std::shared_ptr<TopNBoundary> VOlapScanNode::create_topn_boundary(SlotId slot_id, bool is_asc,
+                                                                  bool nulls_first) {
+    for (auto slot : _tuple_desc->slots()) {
+        if (slot->id() == slot_id && slot->is_materialized()) {
+            _topn_boundary = std::make_shared<TopNBoundary>(slot->col_name(), is_asc, nulls_first);
+            return _topn_boundary;
+        }
+    }
+    return nullptr;
+}
+
 Status VOlapScanNode::open(RuntimeState* state) {
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "VOlapScanNode::open");
     VLOG_CRITICAL << "VOlapScanNode::Open";
@@ -312,6 +420,7 @@ void VOlapScanNode::transfer_thread(RuntimeState* state) {
     _block_size = _limit == -1 ? state->batch_size()
                                : std::min(static_cast<int64_t>(state->batch_size()), _limit);
     auto block_per_scanner = (doris_scanner_row_num + (_block_size - 1)) / _block_size;
+    _block_per_scanner = block_per_scanner;
     auto pre_block_count =
             std::min(_volap_scanners.size(),
                      static_cast<size_t>(config::doris_scanner_thread_pool_thread_num)) *
@@ -370,6 +479,11 @@ void VOlapScanNode::transfer_thread(RuntimeState* state) {
         }
     }
     telemetry::set_span_attribute(span, _scanner_sched_counter);
+    if (_tuner) {
+        COUNTER_SET(_tuned_scanner_num_counter,
+                    static_cast<int64_t>(_tuner->max_running_scanners()));
+        COUNTER_SET(_tuned_block_rows_counter, _tuner->block_rows());
+    }
 
     VLOG_CRITICAL << "TransferThread finish.";
     _transfer_done = true;
@@ -381,6 +495,74 @@ void VOlapScanNode::transfer_thread(RuntimeState* state) {
     VLOG_CRITICAL << "Scanner threads have been exited. TransferThread exit.";
 }
 
+void VOlapScanNode::_append_late_runtime_filters(VOlapScanner* scanner) {
+    auto& scanner_filter_apply_marks = *scanner->mutable_runtime_filter_marks();
+    DCHECK(scanner_filter_apply_marks.size() == _runtime_filter_descs.size());
+    for (size_t i = 0; i < scanner_filter_apply_marks.size(); i++) {
+        if (scanner_filter_apply_marks[i] || _runtime_filter_ctxs[i].apply_mark) {
+            continue;
+        }
+        IRuntimeFilter* runtime_filter = nullptr;
+        _runtime_state->runtime_filter_mgr()->get_consume_filter(
+                _runtime_filter_descs[i].filter_id, &runtime_filter);
+        DCHECK(runtime_filter != nullptr);
+        if (runtime_filter == nullptr || !runtime_filter->is_ready()) {
+            continue;
+        }
+        scanner_filter_apply_marks[i] = true;
+
+        // The conjunct only holds the nodes of this filter: the nodes of a context cloned by
+        // a running scanner must not be prepared again.
+        VExprContext* vconjunct_ctx = nullptr;
+        {
+            std::lock_guard<std::mutex> l(*(_rf_locks[i]));
+            auto& late_filter = _late_runtime_filters[i];
+            if (!late_filter.built) {
+                late_filter.built = true;
+                std::vector<VExpr*> vexprs;
+                auto st = runtime_filter->get_prepared_vexprs(&vexprs, row_desc());
+                if (st.ok() && !vexprs.empty()) {
+                    auto last_expr = vexprs[0];
+                    for (size_t j = 1; j < vexprs.size(); j++) {
+                        TExprNode texpr_node;
+                        texpr_node.__set_type(create_type_desc(PrimitiveType::TYPE_BOOLEAN));
+                        texpr_node.__set_node_type(TExprNodeType::COMPOUND_PRED);
+                        texpr_node.__set_opcode(TExprOpcode::COMPOUND_AND);
+                        VExpr* new_node = _pool->add(new VcompoundPred(texpr_node));
+                        new_node->add_child(last_expr);
+                        new_node->add_child(vexprs[j]);
+                        last_expr = new_node;
+                    }
+                    auto ctx = _pool->add(new VExprContext(last_expr));
+                    st = ctx->prepare(_runtime_state, row_desc());
+                    if (st.ok()) {
+                        st = ctx->open(_runtime_state);
+                    }
+                    if (st.ok()) {
+                        late_filter.vconjunct_ctx = ctx;
+                    } else {
+                        ctx->close(_runtime_state);
+                    }
+                }
+                // If error occurs, discard the runtime filter directly.
+                WARN_IF_ERROR(st, "Something wrong for runtime filters: ");
+            }
+            vconjunct_ctx = late_filter.vconjunct_ctx;
+        }
+        if (vconjunct_ctx == nullptr) {
+            continue;
+        }
+        VExprContext* scanner_ctx = nullptr;
+        auto st = vconjunct_ctx->clone(_runtime_state, &scanner_ctx);
+        if (st.ok()) {
+            scanner->append_runtime_filter_ctx(scanner_ctx);
+            COUNTER_UPDATE(_late_runtime_filter_counter, 1);
+        } else {
+            LOG(WARNING) << "Something wrong for runtime filters: " << st;
+        }
+    }
+}
+
 void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     START_AND_SCOPE_SPAN(scanner->runtime_state()->get_tracer(), span,
                          "VOlapScanNode::scanner_thread");
@@ -391,6 +573,7 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     // (_scan_cpu_timer, the class member) is not destroyed after `_running_thread==0`.
     ThreadCpuStopWatch cpu_watch;
     cpu_watch.start();
+    ScopedPerfCounters perf_counters(_scanner_perf_counters.get());
     Status status = Status::OK();
     bool eos = false;
     RuntimeState* state = scanner->runtime_state();
@@ -405,89 +588,6 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
         scanner->set_opened();
     }
 
-    /*
-    // the following code will cause coredump when running tpcds_sf1 sqls,
-    // disable temporariy to avoid it, SHOULD BE FIX LATER
-    std::vector<VExpr*> vexprs;
-    auto& scanner_filter_apply_marks = *scanner->mutable_runtime_filter_marks();
-    DCHECK(scanner_filter_apply_marks.size() == _runtime_filter_descs.size());
-    for (size_t i = 0; i < scanner_filter_apply_marks.size(); i++) {
-        if (!scanner_filter_apply_marks[i] && !_runtime_filter_ctxs[i].apply_mark) {
-            /// When runtime filters are ready during running, we should use them to filter data
-            /// in VOlapScanner.
-            /// New arrival rf will be processed as below:
-            /// 1. convert these runtime filters to vectorized expressions
-            /// 2. if this is the first scanner thread to receive this rf, construct a new
-            /// VExprContext and update `_vconjunct_ctx_ptr` in scan node. Notice that we use
-            /// `_runtime_filter_ready_flag` to ensure `_vconjunct_ctx_ptr` will be updated only
-            /// once after any runtime_filters are ready.
-            /// 3. finally, just copy this new VExprContext to scanner and use it to filter data.
-            IRuntimeFilter* runtime_filter = nullptr;
-            state->runtime_filter_mgr()->get_consume_filter(_runtime_filter_descs[i].filter_id,
-                                                            &runtime_filter);
-            DCHECK(runtime_filter != nullptr);
-            bool ready = runtime_filter->is_ready();
-            if (ready) {
-                runtime_filter->get_prepared_vexprs(&vexprs, row_desc());
-                scanner_filter_apply_marks[i] = true;
-                if (!_runtime_filter_ready_flag[i] && !vexprs.empty()) {
-                    std::unique_lock<std::mutex> l(*(_rf_locks[i]));
-                    if (!_runtime_filter_ready_flag[i]) {
-                        // Use all conjuncts and new arrival runtime filters to construct a new
-                        // expression tree here.
-                        auto last_expr =
-                                _vconjunct_ctx_ptr ? (*_vconjunct_ctx_ptr)->root() : vexprs[0];
-                        for (size_t j = _vconjunct_ctx_ptr ? 0 : 1; j < vexprs.size(); j++) {
-                            if (_rf_vexpr_set.find(vexprs[j]) != _rf_vexpr_set.end()) {
-                                continue;
-                            }
-                            TExprNode texpr_node;
-                            texpr_node.__set_type(create_type_desc(PrimitiveType::TYPE_BOOLEAN));
-                            texpr_node.__set_node_type(TExprNodeType::COMPOUND_PRED);
-                            texpr_node.__set_opcode(TExprOpcode::COMPOUND_AND);
-                            VExpr* new_node = _pool->add(new VcompoundPred(texpr_node));
-                            new_node->add_child(last_expr);
-                            new_node->add_child(vexprs[j]);
-                            last_expr = new_node;
-                            _rf_vexpr_set.insert(vexprs[j]);
-                        }
-                        auto new_vconjunct_ctx_ptr = _pool->add(new VExprContext(last_expr));
-                        auto expr_status = new_vconjunct_ctx_ptr->prepare(state, row_desc());
-                        // If error occurs in `prepare` or `open` phase, discard these runtime
-                        // filters directly.
-                        if (UNLIKELY(!expr_status.OK())) {
-                            LOG(WARNING) << "Something wrong for runtime filters: " << expr_status;
-                            vexprs.clear();
-                            break;
-                        }
-                        expr_status = new_vconjunct_ctx_ptr->open(state);
-                        if (UNLIKELY(!expr_status.OK())) {
-                            LOG(WARNING) << "Something wrong for runtime filters: " << expr_status;
-                            vexprs.clear();
-                            break;
-                        }
-                        if (_vconjunct_ctx_ptr) {
-                            _stale_vexpr_ctxs.push_back(std::move(_vconjunct_ctx_ptr));
-                        }
-                        _vconjunct_ctx_ptr.reset(new doris::vectorized::VExprContext*);
-                        *(_vconjunct_ctx_ptr.get()) = new_vconjunct_ctx_ptr;
-                        _runtime_filter_ready_flag[i] = true;
-                    }
-                }
-            }
-        }
-    }
-
-    if (!vexprs.empty()) {
-        if (*scanner->vconjunct_ctx_ptr()) {
-            (*scanner->vconjunct_ctx_ptr())->close(state);
-            *scanner->vconjunct_ctx_ptr() = nullptr;
-        }
-        WARN_IF_ERROR((*_vconjunct_ctx_ptr)->clone(state, scanner->vconjunct_ctx_ptr()),
-                      "Something wrong for runtime filters: ");
-        scanner->set_use_pushdown_conjuncts(true);
-    }
-    */
 
     std::vector<Block*> blocks;
 
@@ -498,17 +598,30 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     // judge if we need to yield. So we record all raw data read in this round
     // scan, if this exceed row number or bytes threshold, we yield this thread.
     int64_t raw_rows_read = scanner->raw_rows_read();
+    int64_t raw_rows_start = raw_rows_read;
     int64_t raw_rows_threshold = raw_rows_read + config::doris_scanner_row_num;
     int64_t raw_bytes_read = 0;
+    int64_t rows_returned = 0;
+    // the rows the blocks of this slice are filled up to
+    int64_t block_rows = _tuner ? _tuner->block_rows() : _runtime_state->batch_size();
     int64_t raw_bytes_threshold = config::doris_scanner_row_bytes;
+    // When the queued blocks take more than a quarter of the budget, the consumer is slower than
+    // the scanners: fill a single block in this slice instead of queueing more of them.
+    if (_materialized_row_batches_bytes + _scan_row_batches_bytes >
+        _max_scanner_queue_size_bytes / 4) {
+        raw_rows_threshold = raw_rows_read;
+    }
     bool get_free_block = true;
     int num_rows_in_block = 0;
+    // the free blocks of this slice, taken from and given back to _free_blocks at once to not
+    // lock it for each block
+    std::vector<Block*> free_blocks;
 
     // Has to wait at least one full block, or it will cause a lot of schedule task in priority
     // queue, it will affect query latency and query concurrency for example ssb 3.3.
     while (!eos && raw_bytes_read < raw_bytes_threshold &&
            ((raw_rows_read < raw_rows_threshold && get_free_block) ||
-            num_rows_in_block < _runtime_state->batch_size())) {
+            num_rows_in_block < block_rows)) {
         if (UNLIKELY(_transfer_done)) {
             eos = true;
             status = Status::Cancelled("Cancelled");
@@ -516,7 +629,8 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
             break;
         }
 
-        auto block = _alloc_block(get_free_block);
+        _append_late_runtime_filters(scanner);
+        auto block = _alloc_block(&free_blocks, get_free_block);
         status = scanner->get_block(_runtime_state, block, &eos);
         VLOG_ROW << "VOlapScanNode input rows: " << block->rows();
         if (!status.ok()) {
@@ -529,23 +643,26 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
 
         raw_bytes_read += block->bytes();
         num_rows_in_block += block->rows();
+        rows_returned += block->rows();
         // 4. if status not ok, change status_.
         if (UNLIKELY(block->rows() == 0)) {
-            std::lock_guard<std::mutex> l(_free_blocks_lock);
-            _free_blocks.emplace_back(block);
+            free_blocks.emplace_back(block);
         } else {
             if (!blocks.empty() &&
-                blocks.back()->rows() + block->rows() <= _runtime_state->batch_size()) {
+                blocks.back()->rows() + block->rows() <= block_rows) {
                 MutableBlock(blocks.back()).merge(*block);
                 block->clear_column_data();
-                std::lock_guard<std::mutex> l(_free_blocks_lock);
-                _free_blocks.emplace_back(block);
+                free_blocks.emplace_back(block);
             } else {
                 blocks.push_back(block);
             }
         }
         raw_rows_read = scanner->raw_rows_read();
     }
+    _return_free_blocks(&free_blocks);
+    if (_tuner) {
+        _tuner->on_scanned(raw_rows_read - raw_rows_start, rows_returned, raw_bytes_read);
+    }
 
     {
         // if we failed, check status.
@@ -588,6 +705,7 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
         }
     }
     _scan_cpu_timer->update(cpu_watch.elapsed_time());
+    perf_counters.stop();
     _scanner_wait_worker_timer->update(wait_time);
 
     std::unique_lock<std::mutex> l(_scan_blocks_lock);
@@ -604,11 +722,16 @@ Status VOlapScanNode::_add_blocks(std::vector<Block*>& block) {
         std::unique_lock<std::mutex> l(_blocks_lock);
 
         // check queue limit for both block queue size and bytes
+        bool queue_full = false;
         while (UNLIKELY((_materialized_blocks.size() >= _max_materialized_blocks ||
                          _materialized_row_batches_bytes >= _max_scanner_queue_size_bytes / 2) &&
                         !_transfer_done)) {
+            queue_full = true;
             _block_consumed_cv.wait(l);
         }
+        if (queue_full && _tuner) {
+            _tuner->on_queue_full();
+        }
 
         VLOG_CRITICAL << "Push block to materialized_blocks";
         _materialized_blocks.insert(_materialized_blocks.end(), block.cbegin(), block.cend());
@@ -632,6 +755,11 @@ void VOlapScanNode::eval_const_conjuncts() {
             }
         }
     }
+    // the vectorized conjuncts folded to a constant false, e.g. `k1 > 1 and 1 = 2`
+    if (_vconjunct_ctx_ptr != nullptr &&
+        VFoldedConstant::is_always_false((*_vconjunct_ctx_ptr)->root())) {
+        _eos = true;
+    }
 }
 
 Status VOlapScanNode::normalize_conjuncts() {
@@ -1599,6 +1727,7 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
                 std::max(1, (int)ranges->size() /
                                     std::min(scanners_per_tablet, size_based_scanners_per_tablet));
         int num_ranges = ranges->size();
+        std::vector<std::vector<OlapScanRange*>> scanners_ranges;
         for (int i = 0; i < num_ranges;) {
             std::vector<OlapScanRange*> scanner_ranges;
             scanner_ranges.push_back((*ranges)[i].get());
@@ -1608,17 +1737,34 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
                  ++j, ++i) {
                 scanner_ranges.push_back((*ranges)[i].get());
             }
-            VOlapScanner* scanner =
-                    new VOlapScanner(state, this, _olap_scan_node.is_preaggregation,
-                                     _need_agg_finalize, *scan_range, _scanner_mem_tracker.get());
-            // add scanner to pool before doing prepare.
-            // so that scanner can be automatically deconstructed if prepare failed.
-            _scanner_pool.add(scanner);
-            RETURN_IF_ERROR(scanner->prepare(*scan_range, scanner_ranges, _olap_filter,
-                                             _bloom_filters_push_down, _push_down_functions));
-
-            _volap_scanners.push_back(scanner);
-            disk_set.insert(scanner->scan_disk());
+            scanners_ranges.push_back(std::move(scanner_ranges));
+        }
+
+        // A tablet read by a single scanner is split into parts of its segments, if its rows
+        // need not to be merged by key, so that a few big tablets are still scanned in parallel.
+        int num_splits = 1;
+        if (scanners_ranges.size() == 1 && limit() == -1 && tablet->all_beta() &&
+            (tablet->keys_type() == DUP_KEYS || _olap_scan_node.is_preaggregation)) {
+            int64_t row_based_splits = tablet->num_rows() / config::doris_scan_range_row_count;
+            num_splits = std::max<int64_t>(1, std::min<int64_t>(scanners_per_tablet,
+                                                                row_based_splits));
+        }
+
+        for (auto& scanner_ranges : scanners_ranges) {
+            for (int split = 0; split < num_splits; ++split) {
+                VOlapScanner* scanner = new VOlapScanner(
+                        state, this, _olap_scan_node.is_preaggregation, _need_agg_finalize,
+                        *scan_range, _scanner_mem_tracker.get());
+                // add scanner to pool before doing prepare.
+                // so that scanner can be automatically deconstructed if prepare failed.
+                _scanner_pool.add(scanner);
+                scanner->set_split(split, num_splits);
+                RETURN_IF_ERROR(scanner->prepare(*scan_range, scanner_ranges, _olap_filter,
+                                                 _bloom_filters_push_down, _push_down_functions));
+
+                _volap_scanners.push_back(scanner);
+                disk_set.insert(scanner->scan_disk());
+            }
         }
     }
     COUNTER_SET(_num_disks_accessed_counter, static_cast<int64_t>(disk_set.size()));
@@ -1631,6 +1777,22 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
     ss << "ScanThread complete (node=" << id() << "):";
     _progress = ProgressUpdater(ss.str(), _volap_scanners.size(), 1);
 
+    _max_scanner_threads = config::doris_scanner_queue_size;
+    if (config::doris_scanner_row_num > state->batch_size()) {
+        _max_scanner_threads /= config::doris_scanner_row_num / state->batch_size();
+        if (_max_scanner_threads <= 0) _max_scanner_threads = 1;
+    }
+    if (config::enable_adaptive_scan_tuning) {
+        int64_t batch_size = state->batch_size();
+        int64_t max_block_rows =
+                _limit == -1 ? std::max<int64_t>(batch_size, config::doris_scanner_row_num)
+                             : std::min(batch_size, _limit);
+        _tuner = std::make_unique<ScannerScheduleTuner>(
+                static_cast<int>(std::min(_max_scanner_threads, _volap_scanners.size())),
+                std::min(batch_size / 16, max_block_rows), max_block_rows, batch_size,
+                config::doris_scanner_block_target_bytes, _max_scanner_queue_size_bytes);
+    }
+
     _transfer_thread.reset(new std::thread(
             [this, state, parent_span = opentelemetry::trace::Tracer::GetCurrentSpan()] {
                 opentelemetry::trace::Scope scope {parent_span};
@@ -1688,14 +1850,29 @@ Status VOlapScanNode::close(RuntimeState* state) {
     for (auto& ctx : _stale_vexpr_ctxs) {
         (*ctx)->close(state);
     }
+    for (auto& late_filter : _late_runtime_filters) {
+        if (late_filter.vconjunct_ctx != nullptr) {
+            late_filter.vconjunct_ctx->close(state);
+        }
+    }
 
     VLOG_CRITICAL << "VOlapScanNode::close()";
     return ScanNode::close(state);
 }
 
+bool VOlapScanNode::can_read() {
+    // get_next() starts the scan, which may wait for the runtime filters.
+    if (!_start || _eos) {
+        return true;
+    }
+    std::lock_guard<std::mutex> l(_blocks_lock);
+    return !_materialized_blocks.empty() || _transfer_done;
+}
+
 Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "VOlapScanNode::get_next");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_CONSUME_MEM_TRACKER(mem_tracker());
 
     // check if Canceled.
@@ -1734,6 +1911,7 @@ Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     {
         std::unique_lock<std::mutex> l(_blocks_lock);
         SCOPED_TIMER(_olap_wait_batch_queue_timer);
+        bool waited = _materialized_blocks.empty() && !_transfer_done;
         while (_materialized_blocks.empty() && !_transfer_done) {
             if (state->is_cancelled()) {
                 _transfer_done = true;
@@ -1748,6 +1926,9 @@ Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
             DCHECK(materialized_block != nullptr);
             _materialized_blocks.pop_back();
             _materialized_row_batches_bytes -= materialized_block->allocated_bytes();
+            if (_tuner) {
+                _tuner->on_consumed(waited);
+            }
         }
     }
 
@@ -1788,14 +1969,18 @@ Status VOlapScanNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     return _status;
 }
 
-Block* VOlapScanNode::_alloc_block(bool& get_free_block) {
-    {
+Block* VOlapScanNode::_alloc_block(std::vector<Block*>* free_blocks, bool& get_free_block) {
+    if (free_blocks->empty()) {
         std::lock_guard<std::mutex> l(_free_blocks_lock);
-        if (!_free_blocks.empty()) {
-            auto block = _free_blocks.back();
-            _free_blocks.pop_back();
-            return block;
-        }
+        size_t num_blocks = std::min(_free_blocks.size(), _block_per_scanner);
+        free_blocks->insert(free_blocks->end(), _free_blocks.end() - num_blocks,
+                            _free_blocks.end());
+        _free_blocks.resize(_free_blocks.size() - num_blocks);
+    }
+    if (!free_blocks->empty()) {
+        auto block = free_blocks->back();
+        free_blocks->pop_back();
+        return block;
     }
 
     get_free_block = false;
@@ -1805,14 +1990,24 @@ Block* VOlapScanNode::_alloc_block(bool& get_free_block) {
     return block;
 }
 
+void VOlapScanNode::_return_free_blocks(std::vector<Block*>* free_blocks) {
+    if (!free_blocks->empty()) {
+        std::lock_guard<std::mutex> l(_free_blocks_lock);
+        _free_blocks.insert(_free_blocks.end(), free_blocks->begin(), free_blocks->end());
+        free_blocks->clear();
+    }
+}
+
 int VOlapScanNode::_start_scanner_thread_task(RuntimeState* state, int block_per_scanner) {
     std::list<VOlapScanner*> olap_scanners;
     int assigned_thread_num = _running_thread;
-    size_t max_thread = config::doris_scanner_queue_size;
-    if (config::doris_scanner_row_num > state->batch_size()) {
-        max_thread /= config::doris_scanner_row_num / state->batch_size();
-        if (max_thread <= 0) max_thread = 1;
+    size_t max_thread = _max_scanner_threads;
+    if (_tuner) {
+        max_thread = std::min(max_thread, static_cast<size_t>(_tuner->max_running_scanners()));
     }
+    size_t free_thread_num =
+            max_thread > static_cast<size_t>(assigned_thread_num) ? max_thread - assigned_thread_num
+                                                                  : 0;
     // copy to local
     {
         // How many thread can apply to this query
@@ -1822,8 +2017,10 @@ int VOlapScanNode::_start_scanner_thread_task(RuntimeState* state, int block_per
                 std::lock_guard<std::mutex> l(_free_blocks_lock);
                 thread_slot_num = _free_blocks.size() / block_per_scanner;
                 thread_slot_num += (_free_blocks.size() % block_per_scanner != 0);
-                thread_slot_num = std::min(thread_slot_num, max_thread - assigned_thread_num);
-                if (thread_slot_num <= 0) {
+                thread_slot_num = std::min(thread_slot_num, free_thread_num);
+                // one more scanner to allocate new blocks when there is no free one, unless the
+                // running ones already reach the tuned number
+                if (thread_slot_num <= 0 && (free_thread_num > 0 || assigned_thread_num == 0)) {
                     thread_slot_num = 1;
                 }
             } else {
@@ -1869,6 +2066,8 @@ int VOlapScanNode::_start_scanner_thread_task(RuntimeState* state, int block_per
         };
         task.priority = _nice;
         task.queue_id = state->exec_env()->store_path_to_index((*iter)->scan_disk());
+        task.group_id = state->scan_task_group_id();
+        task.shares = state->scan_thread_shares();
         (*iter)->start_wait_worker_timer();
         COUNTER_UPDATE(_scanner_sched_counter, 1);
         if (thread_pool->offer(task)) {
@@ -1906,6 +2105,59 @@ Status VOlapScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& scan_
     return Status::OK();
 }
 
+std::map<int64_t, int64_t> VOlapScanNode::tablet_versions() const {
+    std::map<int64_t, int64_t> versions;
+    for (auto& scan_range : _scan_ranges) {
+        versions[scan_range->tablet_id] = strtoul(scan_range->version.c_str(), nullptr, 10);
+    }
+    return versions;
+}
+
+bool VOlapScanNode::scan_versions_after(const std::map<int64_t, int64_t>& versions) {
+    auto scan_versions = tablet_versions();
+    if (scan_versions.size() != versions.size()) {
+        return false;
+    }
+    for (auto& [tablet_id, scan_version] : scan_versions) {
+        auto it = versions.find(tablet_id);
+        if (it == versions.end() || it->second > scan_version) {
+            return false;
+        }
+        if (it->second == scan_version) {
+            continue;
+        }
+        TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id);
+        if (tablet == nullptr || tablet->keys_type() != DUP_KEYS) {
+            return false;
+        }
+        // a delete predicate of a new version also deletes the older rows
+        std::shared_lock rdlock(tablet->get_header_lock());
+        std::vector<Version> version_path;
+        if (!tablet->capture_consistent_versions(Version(it->second + 1, scan_version),
+                                                 &version_path, true)
+                     .ok()) {
+            return false;
+        }
+        for (auto& version : version_path) {
+            auto rowset = tablet->get_rowset_by_version(version, true);
+            if (rowset == nullptr || rowset->rowset_meta()->has_delete_predicate()) {
+                return false;
+            }
+        }
+    }
+    for (auto& [tablet_id, version] : versions) {
+        _start_versions[tablet_id] = version + 1;
+    }
+    // the tablets without new versions are not scanned
+    _scan_ranges.erase(std::remove_if(_scan_ranges.begin(), _scan_ranges.end(),
+                                      [&](const std::unique_ptr<TPaloScanRange>& scan_range) {
+                                          return versions.at(scan_range->tablet_id) ==
+                                                 scan_versions.at(scan_range->tablet_id);
+                                      }),
+                       _scan_ranges.end());
+    return true;
+}
+
 Status VOlapScanNode::get_hints(TabletSharedPtr table, const TPaloScanRange& scan_range,
                                 int block_row_count, bool is_begin_include, bool is_end_include,
                                 const std::vector<std::unique_ptr<OlapScanRange>>& scan_key_range,
@@ -29,6 +29,7 @@
 
 namespace doris {
 class ObjectPool;
+class TopNBoundary;
 class TPlanNode;
 class DescriptorTbl;
 class RowBatch;
@@ -36,6 +37,53 @@ namespace vectorized {
 
 class VOlapScanner;
 
+// Tunes the number of running scanners and the rows of the blocks of a scan node from what it
+// observes while the query runs, instead of the static scanner settings. The blocks are sized by
+// bytes from the moving average of the bytes per row, so the blocks of wide rows are smaller and
+// those of narrow rows larger, and a selective scan that returns few of the rows it reads does not
+// grow its blocks to not wait long for them. Each few blocks taken by the consumer, a scanner is
+// added if the consumer had to wait for most of them and one is removed if the queue was full,
+// and the scanners never hold more blocks than fit in the memory budget.
+class ScannerScheduleTuner {
+public:
+    ScannerScheduleTuner(int max_scanners, int64_t min_block_rows, int64_t max_block_rows,
+                         int64_t initial_block_rows, int64_t target_block_bytes,
+                         int64_t memory_budget_bytes);
+
+    // A scanner slice read raw_rows rows from the storage and returned rows of them in bytes.
+    void on_scanned(int64_t raw_rows, int64_t rows, int64_t bytes);
+    // The consumer took a block, after waiting for it when waited is true.
+    void on_consumed(bool waited);
+    // The scanned blocks waited for the consumer because the queue was full.
+    void on_queue_full();
+
+    int max_running_scanners() const { return _max_running_scanners; }
+    int64_t block_rows() const { return _block_rows; }
+
+private:
+    void _update_block_rows();
+    void _update_scanners();
+
+    const int _max_scanners;
+    const int64_t _min_block_rows;
+    const int64_t _max_block_rows;
+    const int64_t _initial_block_rows;
+    const int64_t _target_block_bytes;
+    const int64_t _memory_budget_bytes;
+
+    std::mutex _lock;
+    // the moving averages of the bytes of a returned row and of the returned rows per read row
+    double _bytes_per_row = 0;
+    double _selectivity = 1;
+    // what the consumer saw since the scanners were last updated
+    int _num_consumed = 0;
+    int _num_waited = 0;
+    bool _queue_full = false;
+
+    std::atomic<int> _max_running_scanners;
+    std::atomic<int64_t> _block_rows;
+};
+
 class VOlapScanNode final : public ScanNode {
 public:
     VOlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
@@ -51,10 +99,27 @@ public:
     Status get_next(RuntimeState* state, Block* block, bool* eos) override;
     Status close(RuntimeState* state) override;
 
+    bool can_read() override;
+
     Status set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges) override;
 
     void set_no_agg_finalize() { _need_agg_finalize = false; }
 
+    // Creates the boundary of the TopN right above the scan, whose first sort column is the slot
+    // `slot_id` of the scan, to let the scanners skip the pages that can't be in its result.
+    // Returns null if the slot isn't one of the scan. Must be called before open().
+    std::shared_ptr<TopNBoundary> create_topn_boundary(SlotId slot_id, bool is_asc,
+                                                       bool nulls_first);
+
+    // The version of each tablet scanned.
+    std::map<int64_t, int64_t> tablet_versions() const;
+
+    // Makes the scan read only the rows of the tablets newer than `versions`, whose older rows
+    // are aggregated elsewhere. Returns false and leaves the scan unchanged if the older rows
+    // can't be left out, which needs a duplicate key table without delete predicates in the new
+    // versions. Must be called before open().
+    bool scan_versions_after(const std::map<int64_t, int64_t>& versions);
+
     Status get_hints(TabletSharedPtr table, const TPaloScanRange& scan_range, int block_row_count,
                      bool is_begin_include, bool is_end_include,
                      const std::vector<std::unique_ptr<OlapScanRange>>& scan_key_range,
@@ -102,11 +167,18 @@ private:
 
     void transfer_thread(RuntimeState* state);
     void scanner_thread(VOlapScanner* scanner);
+    // Hand the runtime filters which became ready after open() over to the scanner.
+    void _append_late_runtime_filters(VOlapScanner* scanner);
     Status start_scan_thread(RuntimeState* state);
 
     Status _add_blocks(std::vector<Block*>& block);
     int _start_scanner_thread_task(RuntimeState* state, int block_per_scanner);
-    Block* _alloc_block(bool& get_free_block);
+    // Takes a block from 'free_blocks', the free blocks of a scanner slice, which is refilled
+    // from _free_blocks with up to _block_per_scanner blocks at once. Allocates a new block and
+    // sets 'get_free_block' to false if there is none.
+    Block* _alloc_block(std::vector<Block*>* free_blocks, bool& get_free_block);
+    // Gives the blocks a scanner slice did not use back to _free_blocks.
+    void _return_free_blocks(std::vector<Block*>* free_blocks);
 
     void _init_counter(RuntimeState* state);
     // OLAP_SCAN_NODE profile layering: OLAP_SCAN_NODE, OlapScanner, and SegmentIterator
@@ -122,6 +194,8 @@ private:
     TOlapScanNode _olap_scan_node;
     // tuple descriptors
     const TupleDescriptor* _tuple_desc;
+    // the boundary of the TopN above the scan, or null
+    std::shared_ptr<TopNBoundary> _topn_boundary;
     // tuple index
     int _tuple_idx;
     // string slots
@@ -140,6 +214,8 @@ private:
     OlapScanKeys _scan_keys;
 
     std::vector<std::unique_ptr<TPaloScanRange>> _scan_ranges;
+    // the first version scanned of the tablets set by scan_versions_after(), 0 for the others
+    std::unordered_map<int64_t, int64_t> _start_versions;
 
     std::vector<TCondition> _olap_filter;
     // push down bloom filters to storage engine.
@@ -211,6 +287,8 @@ private:
 
     RuntimeProfile::Counter* _scan_timer;
     RuntimeProfile::Counter* _scan_cpu_timer = nullptr;
+    // the perf counters of the scanner threads, only when the query enables them
+    std::unique_ptr<ProfilePerfCounters> _scanner_perf_counters;
     RuntimeProfile::Counter* _tablet_counter;
     RuntimeProfile::Counter* _rows_pushed_cond_filtered_counter = nullptr;
     RuntimeProfile::Counter* _reader_init_timer = nullptr;
@@ -243,7 +321,13 @@ private:
     };
     std::vector<TRuntimeFilterDesc> _runtime_filter_descs;
     std::vector<RuntimeFilterContext> _runtime_filter_ctxs;
-    std::vector<bool> _runtime_filter_ready_flag;
+    // The conjunct of a runtime filter arriving after open(), built by the first scanner seeing
+    // it ready, under the lock of the filter, and cloned by every scanner.
+    struct LateRuntimeFilter {
+        bool built = false;
+        VExprContext* vconjunct_ctx = nullptr;
+    };
+    std::vector<LateRuntimeFilter> _late_runtime_filters;
     std::vector<std::unique_ptr<std::mutex>> _rf_locks;
     std::map<int, RuntimeFilterContext*> _conjunctid_to_runtime_filter_ctxs;
 
@@ -264,6 +348,7 @@ private:
 
     RuntimeProfile::Counter* _stats_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bf_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _topn_filtered_counter = nullptr;
     RuntimeProfile::Counter* _del_filtered_counter = nullptr;
     RuntimeProfile::Counter* _conditions_filtered_counter = nullptr;
     RuntimeProfile::Counter* _key_range_filtered_counter = nullptr;
@@ -297,18 +382,25 @@ private:
     // page read from cache
     // used by segment v2
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _cached_compressed_pages_num_counter = nullptr;
 
     // row count filtered by bitmap inverted index
     RuntimeProfile::Counter* _bitmap_index_filter_counter = nullptr;
     // time fro bitmap inverted index read and filter
     RuntimeProfile::Counter* _bitmap_index_filter_timer = nullptr;
+    // row count filtered by the inverted index of the string columns
+    RuntimeProfile::Counter* _inverted_index_filter_counter = nullptr;
+    RuntimeProfile::Counter* _inverted_index_filter_timer = nullptr;
     // number of created olap scanners
     RuntimeProfile::Counter* _num_scanners = nullptr;
+    RuntimeProfile::Counter* _late_runtime_filter_counter = nullptr;
 
     // number of segment filtered by column stat when creating seg iterator
     RuntimeProfile::Counter* _filtered_segment_counter = nullptr;
     // total number of segment related to this scan node
     RuntimeProfile::Counter* _total_segment_counter = nullptr;
+    // the segments answering the aggregate above from their metadata
+    RuntimeProfile::Counter* _metadata_answered_segment_counter = nullptr;
 
     RuntimeProfile::Counter* _scanner_wait_batch_timer = nullptr;
     RuntimeProfile::Counter* _scanner_wait_worker_timer = nullptr;
@@ -336,8 +428,15 @@ private:
     int _max_materialized_blocks;
 
     size_t _block_size = 0;
+    // the number of blocks a scanner fills in a slice
+    size_t _block_per_scanner = 1;
+    // the most scanners running at once
+    size_t _max_scanner_threads = 1;
+    // null when enable_adaptive_scan_tuning is off
+    std::unique_ptr<ScannerScheduleTuner> _tuner;
+    RuntimeProfile::Counter* _tuned_scanner_num_counter = nullptr;
+    RuntimeProfile::Counter* _tuned_block_rows_counter = nullptr;
 
-    phmap::flat_hash_set<VExpr*> _rf_vexpr_set;
     std::vector<std::unique_ptr<VExprContext*>> _stale_vexpr_ctxs;
 };
 } // namespace vectorized
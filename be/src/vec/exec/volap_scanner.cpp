@@ -17,9 +17,11 @@
 
 #include "vec/exec/volap_scanner.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "olap/storage_engine.h"
+#include "olap/topn_boundary.h"
 #include "runtime/runtime_state.h"
 #include "vec/core/block.h"
 #include "vec/exec/volap_scan_node.h"
@@ -58,6 +60,9 @@ Status VOlapScanner::prepare(
     TTabletId tablet_id = scan_range.tablet_id;
     SchemaHash schema_hash = strtoul(scan_range.schema_hash.c_str(), nullptr, 10);
     _version = strtoul(scan_range.version.c_str(), nullptr, 10);
+    if (auto it = _parent->_start_versions.find(tablet_id); it != _parent->_start_versions.end()) {
+        _start_version = it->second;
+    }
     {
         std::string err;
         _tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, true, &err);
@@ -93,7 +98,7 @@ Status VOlapScanner::prepare(
             // acquire tablet rowset readers at the beginning of the scan node
             // to prevent this case: when there are lots of olap scanners to run for example 10000
             // the rowsets maybe compacted when the last olap scanner starts
-            Version rd_version(0, _version);
+            Version rd_version(_start_version, _version);
             Status acquire_reader_st =
                     _tablet->capture_rs_readers(rd_version, &_tablet_reader_params.rs_readers);
             if (!acquire_reader_st.ok()) {
@@ -105,6 +110,9 @@ Status VOlapScanner::prepare(
                 return Status::InternalError(ss.str().c_str());
             }
         }
+        if (_num_splits > 1) {
+            _split_rs_readers();
+        }
     }
 
     {
@@ -116,6 +124,66 @@ Status VOlapScanner::prepare(
     return Status::OK();
 }
 
+void VOlapScanner::_split_rs_readers() {
+    // The rows of a segment are estimated by the average of its rowset, so the last part of
+    // each segment reads up to its end whatever its real size is.
+    auto segment_rows = [](const RowsetSharedPtr& rowset, int64_t seg_id) {
+        int64_t num_segments = rowset->num_segments();
+        int64_t rows_per_segment = std::max<int64_t>(1, rowset->num_rows() / num_segments);
+        if (seg_id + 1 < num_segments) {
+            return rows_per_segment;
+        }
+        return std::max<int64_t>(1, rowset->num_rows() - rows_per_segment * seg_id);
+    };
+
+    // the offsets of the segments in the rows of all the rowsets
+    std::vector<int64_t> segment_offsets {0};
+    for (auto& rs_reader : _tablet_reader_params.rs_readers) {
+        auto rowset = rs_reader->rowset();
+        for (int64_t seg_id = 0; seg_id < rowset->num_segments(); ++seg_id) {
+            segment_offsets.push_back(segment_offsets.back() + segment_rows(rowset, seg_id));
+        }
+    }
+    int64_t total_rows = segment_offsets.back();
+    // A split ends at the nearest segment boundary when the segments are not bigger than a
+    // split, so that a segment is read by one scanner, and the big segments are split by rows.
+    // Every scanner computes the same boundaries, so the splits still cover all the rows once.
+    int64_t split_rows = std::max<int64_t>(1, total_rows / _num_splits);
+    auto split_boundary = [&](int64_t split) {
+        int64_t pos = total_rows * split / _num_splits;
+        auto it = std::upper_bound(segment_offsets.begin(), segment_offsets.end(), pos);
+        if (it == segment_offsets.begin() || it == segment_offsets.end()) {
+            return pos;
+        }
+        int64_t seg_begin = *(it - 1);
+        int64_t seg_end = *it;
+        if (seg_end - seg_begin > split_rows) {
+            return pos;
+        }
+        return pos - seg_begin < seg_end - pos ? seg_begin : seg_end;
+    };
+    int64_t split_begin = split_boundary(_split_index);
+    int64_t split_end = split_boundary(_split_index + 1);
+
+    int64_t offset = 0;
+    for (auto& rs_reader : _tablet_reader_params.rs_readers) {
+        auto rowset = rs_reader->rowset();
+        SegmentRowRanges ranges;
+        for (int64_t seg_id = 0; seg_id < rowset->num_segments(); ++seg_id) {
+            int64_t seg_rows = segment_rows(rowset, seg_id);
+            int64_t begin = std::max(offset, split_begin);
+            int64_t end = std::min(offset + seg_rows, split_end);
+            if (begin < end) {
+                uint32_t seg_begin = begin - offset;
+                uint32_t seg_end = end == offset + seg_rows ? UINT32_MAX : end - offset;
+                ranges.emplace(seg_id, std::make_pair(seg_begin, seg_end));
+            }
+            offset += seg_rows;
+        }
+        rs_reader->set_segment_row_ranges(std::move(ranges));
+    }
+}
+
 Status VOlapScanner::open() {
     SCOPED_TIMER(_parent->_reader_init_timer);
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker);
@@ -137,6 +205,36 @@ Status VOlapScanner::open() {
     return Status::OK();
 }
 
+// Whether the pages of the column can be skipped by the boundary of a TopN. The boundary is the
+// text of a value of the column, which parses back to the same value for these types, and the
+// rows of a value column of a table whose rows are merged can't be skipped before the merge.
+static bool can_skip_by_topn_boundary(const TabletSchema& schema, const TabletColumn& column) {
+    if (schema.keys_type() != KeysType::DUP_KEYS && !column.is_key()) {
+        return false;
+    }
+    switch (column.type()) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_DATEV2:
+    case OLAP_FIELD_TYPE_DATETIMEV2:
+    case OLAP_FIELD_TYPE_DECIMAL:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+    case OLAP_FIELD_TYPE_DECIMAL128:
+    case OLAP_FIELD_TYPE_CHAR:
+    case OLAP_FIELD_TYPE_VARCHAR:
+    case OLAP_FIELD_TYPE_STRING:
+        return true;
+    default:
+        return false;
+    }
+}
+
 // it will be called under tablet read lock because capture rs readers need
 Status VOlapScanner::_init_tablet_reader_params(
         const std::vector<OlapScanRange*>& key_ranges, const std::vector<TCondition>& filters,
@@ -166,7 +264,7 @@ Status VOlapScanner::_init_tablet_reader_params(
     _tablet_reader_params.tablet_schema = &_tablet_schema;
     _tablet_reader_params.reader_type = READER_QUERY;
     _tablet_reader_params.aggregation = _aggregation;
-    _tablet_reader_params.version = Version(0, _version);
+    _tablet_reader_params.version = Version(_start_version, _version);
 
     // Condition
     for (auto& filter : filters) {
@@ -223,6 +321,29 @@ Status VOlapScanner::_init_tablet_reader_params(
 
     if (!config::disable_storage_page_cache) {
         _tablet_reader_params.use_page_cache = true;
+        _tablet_reader_params.bulk_scan =
+                config::storage_page_cache_bulk_scan_tablet_bytes >= 0 &&
+                (int64_t)_tablet->tablet_footprint() >
+                        config::storage_page_cache_bulk_scan_tablet_bytes;
+    }
+
+    if (_parent->_topn_boundary != nullptr) {
+        int32_t index = _tablet_schema.field_index(_parent->_topn_boundary->column_name());
+        if (index >= 0 && can_skip_by_topn_boundary(_tablet_schema, _tablet_schema.column(index))) {
+            _tablet_reader_params.topn_boundary = _parent->_topn_boundary.get();
+        }
+    }
+
+    // Without conjuncts left after the storage, the rows of the segments of a table whose rows
+    // are not merged are the rows of the scan. The segments can then stop at the limit, and
+    // answer the aggregate above from their metadata.
+    if (_parent->_vconjunct_ctx_ptr == nullptr && _parent->runtime_filter_descs().empty() &&
+        _tablet_schema.keys_type() == KeysType::DUP_KEYS) {
+        _tablet_reader_params.read_limit = _parent->limit();
+        if (_parent->_olap_scan_node.__isset.push_down_agg_type_opt) {
+            _tablet_reader_params.push_down_agg_type_opt =
+                    _parent->_olap_scan_node.push_down_agg_type_opt;
+        }
     }
 
     return Status::OK();
@@ -300,8 +421,18 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
             _update_realtime_counter();
             RETURN_IF_ERROR(
                     VExprContext::filter_block(_vconjunct_ctx, block, _tuple_desc->slots().size()));
+            for (auto ctx : _runtime_filter_vconjunct_ctxs) {
+                RETURN_IF_ERROR(
+                        VExprContext::filter_block(ctx, block, _tuple_desc->slots().size()));
+            }
         } while (block->rows() == 0 && !(*eof) && raw_rows_read() < raw_rows_threshold);
     }
+    // the rows read are not filtered when the segments are limited, see
+    // `_init_tablet_reader_params`
+    if (_tablet_reader_params.read_limit >= 0 &&
+        _num_rows_read >= _tablet_reader_params.read_limit) {
+        *eof = true;
+    }
     // NOTE:
     // There is no need to check raw_bytes_threshold since block->rows() == 0 is checked first.
     // But checking raw_bytes_threshold is still added here for consistency with raw_rows_threshold
@@ -327,6 +458,9 @@ Status VOlapScanner::close(RuntimeState* state) {
         return Status::OK();
     }
     if (_vconjunct_ctx) _vconjunct_ctx->close(state);
+    for (auto ctx : _runtime_filter_vconjunct_ctxs) {
+        ctx->close(state);
+    }
     // olap scan node will call scanner.close() when finished
     // will release resources here
     // if not clear rowset readers in read_params here
@@ -351,6 +485,9 @@ void VOlapScanner::update_counter() {
     COUNTER_UPDATE(_parent->_rows_pushed_cond_filtered_counter, _num_rows_pushed_cond_filtered);
 
     COUNTER_UPDATE(_parent->_io_timer, stats.io_ns);
+    StorageEngine::instance()->compaction_io_scheduler()->report_query_io(
+            _tablet->data_dir(), stats.io_ns,
+            stats.total_pages_num - stats.cached_pages_num - stats.cached_compressed_pages_num);
     COUNTER_UPDATE(_parent->_read_compressed_counter, stats.compressed_bytes_read);
     _compressed_bytes_read += stats.compressed_bytes_read;
     COUNTER_UPDATE(_parent->_decompressor_timer, stats.decompress_ns);
@@ -384,6 +521,7 @@ void VOlapScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_stats_filtered_counter, stats.rows_stats_filtered);
     COUNTER_UPDATE(_parent->_bf_filtered_counter, stats.rows_bf_filtered);
+    COUNTER_UPDATE(_parent->_topn_filtered_counter, stats.rows_topn_filtered);
     COUNTER_UPDATE(_parent->_del_filtered_counter, stats.rows_del_filtered);
     COUNTER_UPDATE(_parent->_del_filtered_counter, stats.rows_vec_del_cond_filtered);
 
@@ -399,12 +537,18 @@ void VOlapScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_total_pages_num_counter, stats.total_pages_num);
     COUNTER_UPDATE(_parent->_cached_pages_num_counter, stats.cached_pages_num);
+    COUNTER_UPDATE(_parent->_cached_compressed_pages_num_counter,
+                   stats.cached_compressed_pages_num);
 
     COUNTER_UPDATE(_parent->_bitmap_index_filter_counter, stats.rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bitmap_index_filter_timer, stats.bitmap_index_filter_timer);
+    COUNTER_UPDATE(_parent->_inverted_index_filter_counter, stats.rows_inverted_index_filtered);
+    COUNTER_UPDATE(_parent->_inverted_index_filter_timer, stats.inverted_index_filter_timer);
 
     COUNTER_UPDATE(_parent->_filtered_segment_counter, stats.filtered_segment_number);
     COUNTER_UPDATE(_parent->_total_segment_counter, stats.total_segment_number);
+    COUNTER_UPDATE(_parent->_metadata_answered_segment_counter,
+                   stats.metadata_answered_segment_number);
 
     DorisMetrics::instance()->query_scan_bytes->increment(_compressed_bytes_read);
     DorisMetrics::instance()->query_scan_rows->increment(_raw_rows_read);
@@ -65,6 +65,14 @@ public:
 
     bool need_to_close() { return _need_to_close; }
 
+    // Only read the 'index'-th of 'num' parts of the rows of the tablet, must be called before
+    // prepare(). The rows of the tablet are split by segment and by estimated row range, so this
+    // is only used when the rows need not to be merged by key.
+    void set_split(int index, int num) {
+        _split_index = index;
+        _num_splits = num;
+    }
+
     int id() const { return _id; }
     void set_id(int id) { _id = id; }
     bool is_open() const { return _is_open; }
@@ -89,6 +97,12 @@ public:
 
     std::vector<bool>* mutable_runtime_filter_marks() { return &_runtime_filter_marks; }
 
+    // Filter the blocks read from now on by a runtime filter which arrived during the scan.
+    // The scanner takes the ownership of the cloned context.
+    void append_runtime_filter_ctx(VExprContext* ctx) {
+        _runtime_filter_vconjunct_ctxs.push_back(ctx);
+    }
+
 private:
     Status _init_tablet_reader_params(
             const std::vector<OlapScanRange*>& key_ranges, const std::vector<TCondition>& filters,
@@ -97,6 +111,9 @@ private:
             const std::vector<FunctionFilter>& function_filters);
     Status _init_return_columns(bool need_seq_col);
 
+    // Restrict the captured rowset readers to the rows of this split.
+    void _split_rs_readers();
+
     // Update profile that need to be reported in realtime.
     void _update_realtime_counter();
 
@@ -116,12 +133,16 @@ private:
     bool _need_agg_finalize = true;
     bool _has_update_counter = false;
     bool _use_pushdown_conjuncts = false;
+    int _split_index = 0;
+    int _num_splits = 1;
 
     TabletReader::ReaderParams _tablet_reader_params;
     std::unique_ptr<TabletReader> _tablet_reader;
 
     TabletSharedPtr _tablet;
     int64_t _version;
+    // the first version read, which is after the versions aggregated elsewhere
+    int64_t _start_version = 0;
 
     std::vector<uint32_t> _return_columns;
     std::unordered_set<uint32_t> _tablet_columns_convert_to_null_set;
@@ -141,6 +162,8 @@ private:
     MemTracker* _mem_tracker;
 
     VExprContext* _vconjunct_ctx = nullptr;
+    // the conjuncts of the runtime filters arrived after the scanner started
+    std::vector<VExprContext*> _runtime_filter_vconjunct_ctxs;
     bool _need_to_close = false;
 
     TabletSchema _tablet_schema;
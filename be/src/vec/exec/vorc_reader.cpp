@@ -0,0 +1,450 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vorc_reader.h"
+
+#include <orc/sargs/SearchArgument.hh>
+
+#include <algorithm>
+#include <list>
+
+#include "common/logging.h"
+#include "exec/orc_scanner.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "exprs/hybrid_set.h"
+#include "exprs/in_predicate.h"
+#include "exprs/slot_ref.h"
+#include "runtime/descriptors.h"
+#include "runtime/string_value.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_date.h"
+#include "vec/data_types/data_type_date_time.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+// the predicate type of the search arguments on a column of the kind, or false if the column is
+// not filtered by search arguments
+static bool predicate_data_type(orc::TypeKind kind, orc::PredicateDataType* type) {
+    switch (kind) {
+    case orc::BYTE:
+    case orc::SHORT:
+    case orc::INT:
+    case orc::LONG:
+        *type = orc::PredicateDataType::LONG;
+        return true;
+    case orc::FLOAT:
+    case orc::DOUBLE:
+        *type = orc::PredicateDataType::FLOAT;
+        return true;
+    case orc::STRING:
+    case orc::VARCHAR:
+    case orc::CHAR:
+        *type = orc::PredicateDataType::STRING;
+        return true;
+    default:
+        return false;
+    }
+}
+
+// convert the value of a conjunct to a literal of the predicate type, the source slots of a load
+// are usually strings, so a value is only pushed down to a column of the same type family
+static bool to_literal(PrimitiveType value_type, const void* value, orc::PredicateDataType type,
+                       std::vector<orc::Literal>* literals) {
+    if (value == nullptr) {
+        return false;
+    }
+    switch (value_type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT: {
+        if (type != orc::PredicateDataType::LONG) {
+            return false;
+        }
+        int64_t v = value_type == TYPE_TINYINT    ? *reinterpret_cast<const int8_t*>(value)
+                    : value_type == TYPE_SMALLINT ? *reinterpret_cast<const int16_t*>(value)
+                    : value_type == TYPE_INT      ? *reinterpret_cast<const int32_t*>(value)
+                                                  : *reinterpret_cast<const int64_t*>(value);
+        literals->emplace_back(v);
+        return true;
+    }
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE: {
+        if (type != orc::PredicateDataType::FLOAT) {
+            return false;
+        }
+        double v = value_type == TYPE_FLOAT ? *reinterpret_cast<const float*>(value)
+                                            : *reinterpret_cast<const double*>(value);
+        literals->emplace_back(v);
+        return true;
+    }
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+    case TYPE_STRING: {
+        if (type != orc::PredicateDataType::STRING) {
+            return false;
+        }
+        auto* v = reinterpret_cast<const StringValue*>(value);
+        literals->emplace_back(v->ptr, v->len);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+VORCReader::VORCReader(FileReader* file_reader, const std::string& file_name,
+                       int32_t num_of_columns_from_file)
+        : _input_stream(new ORCFileStream(file_reader, file_name)),
+          _num_of_columns_from_file(num_of_columns_from_file),
+          _statistics(std::make_shared<Statistics>()) {}
+
+Status VORCReader::init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
+                               const std::vector<ExprContext*>& conjunct_ctxs,
+                               const cctz::time_zone& ctz) {
+    try {
+        orc::ReaderOptions options;
+        _reader = orc::createReader(std::move(_input_stream), options);
+        // the files with only a header and a footer have no schema to select the columns from
+        if (_reader->getNumberOfRows() == 0) {
+            return Status::EndOfFile("Empty Orc File");
+        }
+        _ctz = ctz;
+        _statistics->total_groups = _reader->getNumberOfStripes();
+        _statistics->total_rows = _reader->getNumberOfRows();
+
+        const orc::Type& schema = _reader->getType();
+        std::map<std::string, const orc::Type*> fields;
+        for (int i = 0; i < schema.getSubtypeCount(); ++i) {
+            fields.emplace(schema.getFieldName(i), schema.getSubtype(i));
+        }
+        DCHECK(_num_of_columns_from_file <= tuple_slot_descs.size());
+        std::list<std::string> include_cols;
+        for (int i = 0; i < _num_of_columns_from_file; i++) {
+            auto slot_desc = tuple_slot_descs.at(i);
+            auto iter = fields.find(slot_desc->col_name());
+            if (iter == fields.end()) {
+                return Status::InvalidArgument("Invalid Column Name:{}", slot_desc->col_name());
+            }
+            orc::TypeKind kind = iter->second->getKind();
+            DataTypePtr type = _column_type(kind);
+            if (type == nullptr) {
+                return Status::NotSupported("Not support orc type {} of column {}",
+                                            iter->second->toString(), slot_desc->col_name());
+            }
+            include_cols.push_back(slot_desc->col_name());
+            _column_kinds.push_back(kind);
+            _column_types.push_back(std::move(type));
+        }
+
+        orc::RowReaderOptions row_reader_options;
+        row_reader_options.include(include_cols);
+        row_reader_options.setEnableLazyDecoding(true);
+        auto search_argument = _build_search_argument(tuple_slot_descs, conjunct_ctxs);
+        if (search_argument != nullptr) {
+            row_reader_options.searchArgument(std::move(search_argument));
+        }
+        _row_reader = _reader->createRowReader(row_reader_options);
+
+        // include_cols is in the order of the slots, and the batch is in the order of the file
+        _position_in_orc_original.resize(_num_of_columns_from_file);
+        const orc::Type& selected_type = _row_reader->getSelectedType();
+        for (int i = 0; i < selected_type.getSubtypeCount(); ++i) {
+            auto pos = std::find(include_cols.begin(), include_cols.end(),
+                                 selected_type.getFieldName(i));
+            _position_in_orc_original.at(std::distance(include_cols.begin(), pos)) = i;
+        }
+        return Status::OK();
+    } catch (std::exception& e) {
+        std::string error_msg = fmt::format("Init orc reader fail. {}", e.what());
+        LOG(WARNING) << error_msg;
+        return Status::InternalError(error_msg);
+    }
+}
+
+DataTypePtr VORCReader::_column_type(orc::TypeKind kind) {
+    DataTypePtr nested_type;
+    switch (kind) {
+    case orc::BOOLEAN:
+        nested_type = std::make_shared<DataTypeUInt8>();
+        break;
+    case orc::BYTE:
+        nested_type = std::make_shared<DataTypeInt8>();
+        break;
+    case orc::SHORT:
+        nested_type = std::make_shared<DataTypeInt16>();
+        break;
+    case orc::INT:
+        nested_type = std::make_shared<DataTypeInt32>();
+        break;
+    case orc::LONG:
+        nested_type = std::make_shared<DataTypeInt64>();
+        break;
+    case orc::FLOAT:
+        nested_type = std::make_shared<DataTypeFloat32>();
+        break;
+    case orc::DOUBLE:
+        nested_type = std::make_shared<DataTypeFloat64>();
+        break;
+    case orc::STRING:
+    case orc::VARCHAR:
+    case orc::CHAR:
+    case orc::BINARY:
+        nested_type = std::make_shared<DataTypeString>();
+        break;
+    case orc::DATE:
+        nested_type = std::make_shared<DataTypeDate>();
+        break;
+    case orc::TIMESTAMP:
+        nested_type = std::make_shared<DataTypeDateTime>();
+        break;
+    default:
+        return nullptr;
+    }
+    // let src column be nullable for simplify converting, as the arrow reader does
+    return make_nullable(nested_type);
+}
+
+std::unique_ptr<orc::SearchArgument> VORCReader::_build_search_argument(
+        const std::vector<SlotDescriptor*>& tuple_slot_descs,
+        const std::vector<ExprContext*>& conjunct_ctxs) {
+    std::map<SlotId, int> slot_columns;
+    for (int i = 0; i < _num_of_columns_from_file; i++) {
+        slot_columns.emplace(tuple_slot_descs[i]->id(), i);
+    }
+    auto builder = orc::SearchArgumentFactory::newBuilder();
+    builder->startAnd();
+    int num_predicates = 0;
+    for (auto* ctx : conjunct_ctxs) {
+        Expr* conjunct = ctx->root();
+        if (conjunct->get_num_children() < 2 ||
+            conjunct->get_child(0)->node_type() != TExprNodeType::SLOT_REF) {
+            continue;
+        }
+        auto iter = slot_columns.find(static_cast<SlotRef*>(conjunct->get_child(0))->slot_id());
+        orc::PredicateDataType type = orc::PredicateDataType::LONG;
+        if (iter == slot_columns.end() ||
+            !predicate_data_type(_column_kinds[iter->second], &type)) {
+            continue;
+        }
+        const std::string& column = tuple_slot_descs[iter->second]->col_name();
+        std::vector<orc::Literal> literals;
+        if (conjunct->node_type() == TExprNodeType::BINARY_PRED) {
+            Expr* expr = conjunct->get_child(1);
+            if (!to_literal(expr->type().type, ctx->get_value(expr, nullptr), type, &literals)) {
+                continue;
+            }
+            switch (conjunct->op()) {
+            case TExprOpcode::EQ:
+                builder->equals(column, type, literals[0]);
+                break;
+            case TExprOpcode::LT:
+                builder->lessThan(column, type, literals[0]);
+                break;
+            case TExprOpcode::LE:
+                builder->lessThanEquals(column, type, literals[0]);
+                break;
+            case TExprOpcode::GT:
+                builder->startNot().lessThanEquals(column, type, literals[0]).end();
+                break;
+            case TExprOpcode::GE:
+                builder->startNot().lessThan(column, type, literals[0]).end();
+                break;
+            default:
+                continue;
+            }
+            ++num_predicates;
+        } else if (conjunct->node_type() == TExprNodeType::IN_PRED &&
+                   conjunct->op() == TExprOpcode::FILTER_IN) {
+            auto* pred = static_cast<InPredicate*>(conjunct);
+            if (pred->is_not_in()) {
+                continue;
+            }
+            auto value_type = conjunct->get_child(1)->type().type;
+            bool all_values = true;
+            HybridSetBase::IteratorBase* value_iter = pred->hybrid_set()->begin();
+            while (value_iter->has_next()) {
+                if (!to_literal(value_type, value_iter->get_value(), type, &literals)) {
+                    all_values = false;
+                    break;
+                }
+                value_iter->next();
+            }
+            if (!all_values || literals.empty()) {
+                continue;
+            }
+            builder->in(column, type, literals);
+            ++num_predicates;
+        }
+    }
+    if (num_predicates == 0) {
+        return nullptr;
+    }
+    builder->end();
+    return builder->build();
+}
+
+Status VORCReader::read(MutableColumns& columns, size_t max_rows, bool* eof) {
+    DCHECK_EQ(columns.size(), _column_kinds.size());
+    *eof = false;
+    size_t read_rows = 0;
+    try {
+        if (_batch == nullptr) {
+            _batch = _row_reader->createRowBatch(max_rows);
+        }
+        while (read_rows < max_rows) {
+            if (_batch_pos >= _batch->numElements) {
+                if (!_row_reader->next(*_batch)) {
+                    *eof = true;
+                    return Status::OK();
+                }
+                _batch_pos = 0;
+                continue;
+            }
+            size_t rows = std::min<size_t>(max_rows - read_rows, _batch->numElements - _batch_pos);
+            auto* fields = static_cast<orc::StructVectorBatch*>(_batch.get());
+            for (size_t i = 0; i < _column_kinds.size(); ++i) {
+                RETURN_IF_ERROR(_read_column(fields->fields[_position_in_orc_original[i]],
+                                             _column_kinds[i], _batch_pos, rows,
+                                             columns[i].get()));
+            }
+            _batch_pos += rows;
+            read_rows += rows;
+        }
+    } catch (std::exception& e) {
+        std::string error_msg = fmt::format("Read orc file fail. {}", e.what());
+        LOG(WARNING) << error_msg;
+        return Status::InternalError(error_msg);
+    }
+    return Status::OK();
+}
+
+template <typename T, typename Batch>
+static void append_numbers(const orc::ColumnVectorBatch* batch, size_t start, size_t rows,
+                           IColumn& nested) {
+    auto& data = assert_cast<ColumnVector<T>&>(nested).get_data();
+    auto* values = static_cast<const Batch*>(batch)->data.data();
+    size_t size = data.size();
+    data.resize(size + rows);
+    for (size_t i = 0; i < rows; ++i) {
+        data[size + i] = static_cast<T>(values[start + i]);
+    }
+}
+
+Status VORCReader::_read_column(const orc::ColumnVectorBatch* batch, orc::TypeKind kind,
+                                size_t start, size_t rows, IColumn* dst) {
+    auto* nullable = assert_cast<ColumnNullable*>(dst);
+    auto& null_map = nullable->get_null_map_data();
+    auto& nested = nullable->get_nested_column();
+    size_t null_map_size = null_map.size();
+    null_map.resize_fill(null_map_size + rows, 0);
+    if (batch->hasNulls) {
+        const char* not_null = batch->notNull.data() + start;
+        for (size_t i = 0; i < rows; ++i) {
+            null_map[null_map_size + i] = !not_null[i];
+        }
+    }
+
+    switch (kind) {
+    case orc::BOOLEAN:
+        append_numbers<UInt8, orc::LongVectorBatch>(batch, start, rows, nested);
+        break;
+    case orc::BYTE:
+        append_numbers<Int8, orc::LongVectorBatch>(batch, start, rows, nested);
+        break;
+    case orc::SHORT:
+        append_numbers<Int16, orc::LongVectorBatch>(batch, start, rows, nested);
+        break;
+    case orc::INT:
+        append_numbers<Int32, orc::LongVectorBatch>(batch, start, rows, nested);
+        break;
+    case orc::LONG:
+        append_numbers<Int64, orc::LongVectorBatch>(batch, start, rows, nested);
+        break;
+    case orc::FLOAT:
+        append_numbers<Float32, orc::DoubleVectorBatch>(batch, start, rows, nested);
+        break;
+    case orc::DOUBLE:
+        append_numbers<Float64, orc::DoubleVectorBatch>(batch, start, rows, nested);
+        break;
+    case orc::STRING:
+    case orc::VARCHAR:
+    case orc::CHAR:
+    case orc::BINARY: {
+        auto& data = assert_cast<ColumnString&>(nested);
+        if (batch->isEncoded) {
+            // the values of the dictionary encoded strings are copied from the dictionary
+            auto* encoded = static_cast<const orc::EncodedStringVectorBatch*>(batch);
+            const char* blob = encoded->dictionary->dictionaryBlob.data();
+            const int64_t* offsets = encoded->dictionary->dictionaryOffset.data();
+            const int64_t* indexes = encoded->index.data() + start;
+            for (size_t i = 0; i < rows; ++i) {
+                if (null_map[null_map_size + i]) {
+                    data.insert_default();
+                    continue;
+                }
+                int64_t index = indexes[i];
+                data.insert_data(blob + offsets[index], offsets[index + 1] - offsets[index]);
+            }
+        } else {
+            auto* strings = static_cast<const orc::StringVectorBatch*>(batch);
+            for (size_t i = start; i < start + rows; ++i) {
+                if (null_map[null_map_size + i - start]) {
+                    data.insert_default();
+                    continue;
+                }
+                data.insert_data(strings->data[i], strings->length[i]);
+            }
+        }
+        break;
+    }
+    case orc::DATE: {
+        // days since the epoch, converted the same way as the arrow reader does
+        auto& data = assert_cast<ColumnInt64&>(nested).get_data();
+        auto* days = static_cast<const orc::LongVectorBatch*>(batch)->data.data();
+        for (size_t i = start; i < start + rows; ++i) {
+            VecDateTimeValue v;
+            v.from_unixtime(days[i] * 24 * 60 * 60, _ctz);
+            v.cast_to_date();
+            data.push_back(binary_cast<VecDateTimeValue, Int64>(v));
+        }
+        break;
+    }
+    case orc::TIMESTAMP: {
+        auto& data = assert_cast<ColumnInt64&>(nested).get_data();
+        auto* seconds = static_cast<const orc::TimestampVectorBatch*>(batch)->data.data();
+        for (size_t i = start; i < start + rows; ++i) {
+            VecDateTimeValue v;
+            v.from_unixtime(seconds[i], _ctz);
+            data.push_back(binary_cast<VecDateTimeValue, Int64>(v));
+        }
+        break;
+    }
+    default:
+        return Status::NotSupported("Not support orc type {}", static_cast<int>(kind));
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
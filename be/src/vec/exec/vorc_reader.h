@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cctz/time_zone.h>
+#include <orc/OrcFile.hh>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "exec/arrow/arrow_reader.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type.h"
+
+namespace orc {
+class SearchArgument;
+} // namespace orc
+
+namespace doris {
+
+class FileReader;
+class SlotDescriptor;
+class TupleDescriptor;
+class ExprContext;
+
+namespace vectorized {
+
+// Reads an orc file with the RowReader of the orc library into doris columns, without converting
+// the batches into arrow arrays. The binary and in predicates of the conjuncts on the columns read
+// are pushed to the RowReader as a SearchArgument, which skips the stripes and the row groups of
+// the row indexes they exclude. The dictionary encoded strings are decoded lazily: the values are
+// copied from the dictionary by their indexes instead of being materialized in the batches first.
+//
+// It reads the columns of the boolean, integer, float, double, string, date and timestamp types;
+// init_reader() returns NotSupported if a column read is of another type.
+class VORCReader {
+public:
+    VORCReader(FileReader* file_reader, const std::string& file_name,
+               int32_t num_of_columns_from_file);
+    ~VORCReader() = default;
+
+    Status init_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
+                       const std::vector<ExprContext*>& conjunct_ctxs,
+                       const cctz::time_zone& ctz);
+
+    // the nullable types of the columns read, in the order of the slots
+    const DataTypes& column_types() const { return _column_types; }
+
+    // append at most max_rows rows to the columns, *eof is set after the last row of the file
+    Status read(MutableColumns& columns, size_t max_rows, bool* eof);
+
+    std::shared_ptr<Statistics>& statistics() { return _statistics; }
+
+private:
+    static DataTypePtr _column_type(orc::TypeKind kind);
+
+    std::unique_ptr<orc::SearchArgument> _build_search_argument(
+            const std::vector<SlotDescriptor*>& tuple_slot_descs,
+            const std::vector<ExprContext*>& conjunct_ctxs);
+
+    Status _read_column(const orc::ColumnVectorBatch* batch, orc::TypeKind kind, size_t start,
+                        size_t rows, IColumn* dst);
+
+    std::unique_ptr<orc::InputStream> _input_stream;
+    const int32_t _num_of_columns_from_file;
+    cctz::time_zone _ctz;
+
+    std::unique_ptr<orc::Reader> _reader;
+    std::unique_ptr<orc::RowReader> _row_reader;
+    std::unique_ptr<orc::ColumnVectorBatch> _batch;
+    size_t _batch_pos = 0;
+
+    // the kinds of the columns read, in the order of the slots
+    std::vector<orc::TypeKind> _column_kinds;
+    DataTypes _column_types;
+    // the batch is in the order of the file, this is the field of each column read in it
+    std::vector<int> _position_in_orc_original;
+
+    std::shared_ptr<Statistics> _statistics;
+};
+
+} // namespace vectorized
+} // namespace doris
@@ -19,6 +19,11 @@
 
 #include <exec/arrow/orc_reader.h>
 
+#include "common/config.h"
+#include "io/file_factory.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+
 namespace doris::vectorized {
 
 VORCScanner::VORCScanner(RuntimeState* state, RuntimeProfile* profile,
@@ -27,7 +32,12 @@ VORCScanner::VORCScanner(RuntimeState* state, RuntimeProfile* profile,
                          const std::vector<TNetworkAddress>& broker_addresses,
                          const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter)
         : VArrowScanner(state, profile, params, ranges, broker_addresses, pre_filter_texprs,
-                        counter) {}
+                        counter),
+          _use_native_reader(config::enable_native_orc_reader) {}
+
+VORCScanner::~VORCScanner() {
+    close();
+}
 
 ArrowReaderWrap* VORCScanner::_new_arrow_reader(FileReader* file_reader, int64_t batch_size,
                                                 int32_t num_of_columns_from_file,
@@ -35,4 +45,100 @@ ArrowReaderWrap* VORCScanner::_new_arrow_reader(FileReader* file_reader, int64_t
     return new ORCReaderWrap(file_reader, batch_size, num_of_columns_from_file);
 }
 
+Status VORCScanner::_open_next_native_reader() {
+    _native_reader.reset();
+    while (true) {
+        if (_next_range >= _ranges.size()) {
+            _scanner_eof = true;
+            return Status::OK();
+        }
+        const TBrokerRangeDesc& range = _ranges[_next_range++];
+        std::unique_ptr<FileReader> file_reader;
+        RETURN_IF_ERROR(FileFactory::create_file_reader(
+                range.file_type, _state->exec_env(), _profile, _broker_addresses,
+                _params.properties, range, range.start_offset, file_reader));
+        RETURN_IF_ERROR(file_reader->open());
+        if (file_reader->size() == 0) {
+            file_reader->close();
+            continue;
+        }
+
+        int32_t num_of_columns_from_file = _src_slot_descs.size();
+        if (range.__isset.num_of_columns_from_file) {
+            num_of_columns_from_file = range.num_of_columns_from_file;
+        }
+        _native_reader.reset(
+                new VORCReader(file_reader.release(), range.path, num_of_columns_from_file));
+        Status status = _native_reader->init_reader(_src_slot_descs, _conjunct_ctxs,
+                                                    _state->timezone_obj());
+        if (status.is_end_of_file()) {
+            continue;
+        } else if (status.is_not_supported()) {
+            // the range is read again by the arrow reader
+            _native_reader.reset();
+            _next_range--;
+            return status;
+        } else if (!status.ok()) {
+            return Status::InternalError(" file: {} error:{}", range.path,
+                                         status.get_error_msg());
+        }
+        update_profile(_native_reader->statistics());
+        return status;
+    }
+}
+
+Status VORCScanner::_init_native_src_block() {
+    _src_block.clear();
+    size_t column_pos = 0;
+    for (auto i = 0; i < _num_of_columns_from_file; ++i) {
+        SlotDescriptor* slot_desc = _src_slot_descs[i];
+        if (slot_desc == nullptr) {
+            continue;
+        }
+        auto& data_type = _native_reader->column_types()[column_pos++];
+        _src_block.insert(ColumnWithTypeAndName(data_type->create_column(), data_type,
+                                                slot_desc->col_name()));
+    }
+    return Status::OK();
+}
+
+Status VORCScanner::get_next(vectorized::Block* block, bool* eof) {
+    if (!_use_native_reader) {
+        return VArrowScanner::get_next(block, eof);
+    }
+    SCOPED_TIMER(_read_timer);
+    if (_native_reader == nullptr && !_scanner_eof) {
+        Status st = _open_next_native_reader();
+        if (st.is_not_supported()) {
+            LOG(INFO) << "read orc files with the arrow reader: " << st.get_error_msg();
+            _use_native_reader = false;
+            return VArrowScanner::get_next(block, eof);
+        }
+        RETURN_IF_ERROR(st);
+    }
+    if (_scanner_eof) {
+        *eof = true;
+        return Status::OK();
+    }
+
+    // a block ends at the end of a file, for the columns from the path of the file
+    RETURN_IF_ERROR(_init_native_src_block());
+    auto columns = _src_block.mutate_columns();
+    bool file_eof = false;
+    RETURN_IF_ERROR(_native_reader->read(columns, _state->batch_size(), &file_eof));
+    _src_block.set_columns(std::move(columns));
+    if (file_eof) {
+        _native_reader.reset();
+    }
+    COUNTER_UPDATE(_rows_read_counter, _src_block.rows());
+    SCOPED_TIMER(_materialize_timer);
+    RETURN_IF_ERROR(_cast_src_block(&_src_block));
+    return _fill_dest_block(block, eof);
+}
+
+void VORCScanner::close() {
+    _native_reader.reset();
+    VArrowScanner::close();
+}
+
 } // namespace doris::vectorized
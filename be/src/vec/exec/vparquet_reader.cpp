@@ -0,0 +1,348 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vparquet_reader.h"
+
+#include <arrow/io/caching.h>
+#include <arrow/io/interfaces.h>
+
+#include <unordered_set>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "io/file_reader.h"
+#include "runtime/descriptors.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_date.h"
+#include "vec/data_types/data_type_date_time.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+VParquetReader::VParquetReader(FileReader* file_reader, int32_t num_of_columns_from_file,
+                               int64_t range_start_offset, int64_t range_size)
+        : _arrow_file(std::make_shared<ArrowFile>(file_reader)),
+          _num_of_columns_from_file(num_of_columns_from_file),
+          _range_start_offset(range_start_offset),
+          _range_size(range_size),
+          _statistics(std::make_shared<Statistics>()) {}
+
+Status VParquetReader::init_reader(const TupleDescriptor* tuple_desc,
+                                   const std::vector<SlotDescriptor*>& tuple_slot_descs,
+                                   const std::vector<ExprContext*>& conjunct_ctxs,
+                                   const cctz::time_zone& ctz) {
+    try {
+        _file_reader = parquet::ParquetFileReader::Open(_arrow_file);
+        _file_metadata = _file_reader->metadata();
+        if (_file_metadata->num_row_groups() == 0) {
+            return Status::EndOfFile("Empty Parquet File");
+        }
+        _ctz = ctz;
+
+        // map the column names to the columns of the file, the same way as ParquetReaderWrap
+        std::map<std::string, int> map_column;
+        auto* schema = _file_metadata->schema();
+        for (int i = 0; i < _file_metadata->num_columns(); ++i) {
+            if (schema->Column(i)->max_definition_level() > 1) {
+                map_column.emplace(schema->Column(i)->path()->ToDotVector()[0], i);
+            } else {
+                map_column.emplace(schema->Column(i)->name(), i);
+            }
+        }
+
+        DCHECK(_num_of_columns_from_file <= tuple_slot_descs.size());
+        std::vector<int> include_column_ids;
+        for (int i = 0; i < _num_of_columns_from_file; i++) {
+            auto slot_desc = tuple_slot_descs.at(i);
+            auto iter = map_column.find(slot_desc->col_name());
+            if (iter == map_column.end()) {
+                return Status::InvalidArgument("Invalid Column Name:{}", slot_desc->col_name());
+            }
+            ColumnContext column;
+            DataTypePtr type;
+            RETURN_IF_ERROR(_init_column(iter->second, &column, &type));
+            include_column_ids.push_back(iter->second);
+            _columns.push_back(std::move(column));
+            _column_types.push_back(std::move(type));
+        }
+
+        std::unordered_set<int> filter_groups;
+        if (config::parquet_predicate_push_down) {
+            auto file_size = _arrow_file->GetSize();
+            _row_group_reader.reset(new RowGroupReader(
+                    _range_start_offset, _range_size, conjunct_ctxs, _file_metadata,
+                    _statistics.get()));
+            RETURN_IF_ERROR(_row_group_reader->init_filter_groups(
+                    tuple_desc, map_column, include_column_ids,
+                    file_size.ok() ? file_size.ValueOrDie() : 0));
+            filter_groups = _row_group_reader->filter_groups();
+        }
+        for (int i = 0; i < _file_metadata->num_row_groups(); ++i) {
+            if (filter_groups.find(i) == filter_groups.end()) {
+                _row_groups.push_back(i);
+            }
+        }
+        return Status::OK();
+    } catch (parquet::ParquetException& e) {
+        std::string error_msg = fmt::format("Init parquet reader fail. {}", e.what());
+        LOG(WARNING) << error_msg;
+        return Status::InternalError(error_msg);
+    }
+}
+
+Status VParquetReader::_init_column(int parquet_column_id, ColumnContext* column,
+                                    DataTypePtr* type) {
+    const parquet::ColumnDescriptor* descr = _file_metadata->schema()->Column(parquet_column_id);
+    if (descr->max_repetition_level() > 0 || descr->max_definition_level() > 1) {
+        return Status::NotSupported("Not support nested parquet column {}",
+                                    descr->path()->ToDotString());
+    }
+    column->parquet_column_id = parquet_column_id;
+    column->max_definition_level = descr->max_definition_level();
+
+    const auto& logical_type = descr->logical_type();
+    DataTypePtr nested_type;
+    switch (descr->physical_type()) {
+    case parquet::Type::BOOLEAN:
+        column->kind = ValueKind::BOOLEAN;
+        nested_type = std::make_shared<DataTypeUInt8>();
+        break;
+    case parquet::Type::INT32:
+        if (logical_type->is_date()) {
+            column->kind = ValueKind::DATE;
+            nested_type = std::make_shared<DataTypeDate>();
+        } else if (logical_type->is_none() ||
+                   (logical_type->is_int() &&
+                    static_cast<const parquet::IntLogicalType&>(*logical_type).is_signed())) {
+            column->kind = ValueKind::INT32;
+            nested_type = std::make_shared<DataTypeInt32>();
+        }
+        break;
+    case parquet::Type::INT64:
+        if (logical_type->is_timestamp()) {
+            switch (static_cast<const parquet::TimestampLogicalType&>(*logical_type).time_unit()) {
+            case parquet::LogicalType::TimeUnit::MILLIS:
+                column->timestamp_divisor = 1000L;
+                break;
+            case parquet::LogicalType::TimeUnit::MICROS:
+                column->timestamp_divisor = 1000000L;
+                break;
+            case parquet::LogicalType::TimeUnit::NANOS:
+                column->timestamp_divisor = 1000000000L;
+                break;
+            default:
+                return Status::NotSupported("Not support parquet time unit of column {}",
+                                            descr->path()->ToDotString());
+            }
+            column->kind = ValueKind::TIMESTAMP;
+            nested_type = std::make_shared<DataTypeDateTime>();
+        } else if (logical_type->is_none() ||
+                   (logical_type->is_int() &&
+                    static_cast<const parquet::IntLogicalType&>(*logical_type).is_signed())) {
+            column->kind = ValueKind::INT64;
+            nested_type = std::make_shared<DataTypeInt64>();
+        }
+        break;
+    case parquet::Type::FLOAT:
+        column->kind = ValueKind::FLOAT;
+        nested_type = std::make_shared<DataTypeFloat32>();
+        break;
+    case parquet::Type::DOUBLE:
+        column->kind = ValueKind::DOUBLE;
+        nested_type = std::make_shared<DataTypeFloat64>();
+        break;
+    case parquet::Type::BYTE_ARRAY:
+        if (logical_type->is_none() || logical_type->is_string()) {
+            column->kind = ValueKind::STRING;
+            nested_type = std::make_shared<DataTypeString>();
+        }
+        break;
+    default:
+        break;
+    }
+    if (nested_type == nullptr) {
+        return Status::NotSupported("Not support parquet type {} of column {}",
+                                    logical_type->ToString(), descr->path()->ToDotString());
+    }
+    // let src column be nullable for simplify converting, as the arrow reader does
+    *type = make_nullable(nested_type);
+    return Status::OK();
+}
+
+Status VParquetReader::_next_row_group(bool* eof) {
+    while (_next_row_group_idx < _row_groups.size()) {
+        int row_group_id = _row_groups[_next_row_group_idx++];
+        _rows_of_group = _file_metadata->RowGroup(row_group_id)->num_rows();
+        _read_rows_of_group = 0;
+        if (_rows_of_group == 0) {
+            continue;
+        }
+        // fetch the column chunks read of the row group with coalesced reads ahead of decoding,
+        // which replaces the buffers of the previous row group
+        std::vector<int> column_ids;
+        for (auto& column : _columns) {
+            column_ids.push_back(column.parquet_column_id);
+        }
+        _file_reader->PreBuffer({row_group_id}, column_ids, arrow::io::default_io_context(),
+                                arrow::io::CacheOptions::Defaults());
+        auto row_group = _file_reader->RowGroup(row_group_id);
+        for (auto& column : _columns) {
+            column.reader = row_group->Column(column.parquet_column_id);
+        }
+        _has_row_group = true;
+        *eof = false;
+        return Status::OK();
+    }
+    _has_row_group = false;
+    *eof = true;
+    return Status::OK();
+}
+
+Status VParquetReader::read(MutableColumns& columns, size_t max_rows, bool* eof) {
+    DCHECK_EQ(columns.size(), _columns.size());
+    *eof = false;
+    size_t read_rows = 0;
+    try {
+        while (read_rows < max_rows) {
+            if (!_has_row_group || _read_rows_of_group >= _rows_of_group) {
+                RETURN_IF_ERROR(_next_row_group(eof));
+                if (*eof) {
+                    return Status::OK();
+                }
+            }
+            size_t rows = std::min<size_t>(max_rows - read_rows,
+                                           _rows_of_group - _read_rows_of_group);
+            for (size_t i = 0; i < _columns.size(); ++i) {
+                RETURN_IF_ERROR(_read_column(_columns[i], rows, columns[i].get()));
+            }
+            _read_rows_of_group += rows;
+            read_rows += rows;
+        }
+    } catch (parquet::ParquetException& e) {
+        std::string error_msg = fmt::format("Read parquet file fail. {}", e.what());
+        LOG(WARNING) << error_msg;
+        return Status::InternalError(error_msg);
+    }
+    return Status::OK();
+}
+
+Status VParquetReader::_read_column(ColumnContext& column, size_t rows, IColumn* dst) {
+    auto& nested = assert_cast<ColumnNullable*>(dst)->get_nested_column();
+    switch (column.kind) {
+    case ValueKind::BOOLEAN: {
+        auto& data = assert_cast<ColumnUInt8&>(nested).get_data();
+        return _read_values<parquet::BooleanType>(column, rows, dst,
+                                                  [&](bool value) { data.push_back(value); });
+    }
+    case ValueKind::INT32: {
+        auto& data = assert_cast<ColumnInt32&>(nested).get_data();
+        return _read_values<parquet::Int32Type>(column, rows, dst,
+                                                [&](int32_t value) { data.push_back(value); });
+    }
+    case ValueKind::INT64: {
+        auto& data = assert_cast<ColumnInt64&>(nested).get_data();
+        return _read_values<parquet::Int64Type>(column, rows, dst,
+                                                [&](int64_t value) { data.push_back(value); });
+    }
+    case ValueKind::FLOAT: {
+        auto& data = assert_cast<ColumnFloat32&>(nested).get_data();
+        return _read_values<parquet::FloatType>(column, rows, dst,
+                                                [&](float value) { data.push_back(value); });
+    }
+    case ValueKind::DOUBLE: {
+        auto& data = assert_cast<ColumnFloat64&>(nested).get_data();
+        return _read_values<parquet::DoubleType>(column, rows, dst,
+                                                 [&](double value) { data.push_back(value); });
+    }
+    case ValueKind::STRING: {
+        auto& data = assert_cast<ColumnString&>(nested);
+        return _read_values<parquet::ByteArrayType>(
+                column, rows, dst, [&](const parquet::ByteArray& value) {
+                    data.insert_data(reinterpret_cast<const char*>(value.ptr), value.len);
+                });
+    }
+    case ValueKind::DATE: {
+        auto& data = assert_cast<ColumnInt64&>(nested).get_data();
+        return _read_values<parquet::Int32Type>(column, rows, dst, [&](int32_t days) {
+            VecDateTimeValue v;
+            v.from_unixtime(static_cast<int64_t>(days) * 24 * 60 * 60, _ctz);
+            v.cast_to_date();
+            data.push_back(binary_cast<VecDateTimeValue, Int64>(v));
+        });
+    }
+    case ValueKind::TIMESTAMP: {
+        auto& data = assert_cast<ColumnInt64&>(nested).get_data();
+        return _read_values<parquet::Int64Type>(column, rows, dst, [&](int64_t value) {
+            VecDateTimeValue v;
+            v.from_unixtime(value / column.timestamp_divisor, _ctz);
+            data.push_back(binary_cast<VecDateTimeValue, Int64>(v));
+        });
+    }
+    }
+    return Status::OK();
+}
+
+template <typename ParquetType, typename Convert>
+Status VParquetReader::_read_values(ColumnContext& column, size_t rows, IColumn* dst,
+                                    Convert&& convert) {
+    using T = typename ParquetType::c_type;
+    auto* reader = static_cast<parquet::TypedColumnReader<ParquetType>*>(column.reader.get());
+    auto* nullable = assert_cast<ColumnNullable*>(dst);
+    auto& null_map = nullable->get_null_map_data();
+    auto& nested = nullable->get_nested_column();
+
+    _def_levels.resize(rows);
+    _values_buf.resize(rows * sizeof(T));
+    T* values = reinterpret_cast<T*>(_values_buf.data());
+    size_t read_rows = 0;
+    while (read_rows < rows) {
+        int64_t values_read = 0;
+        // the values are read densely, without slots for the nulls
+        int64_t levels_read = reader->ReadBatch(rows - read_rows, _def_levels.data(), nullptr,
+                                                values, &values_read);
+        if (levels_read <= 0) {
+            return Status::Corruption("Parquet column {} has less rows than its row group",
+                                      column.parquet_column_id);
+        }
+        if (column.max_definition_level == 0 || values_read == levels_read) {
+            null_map.resize_fill(null_map.size() + levels_read, 0);
+            for (int64_t i = 0; i < values_read; ++i) {
+                convert(values[i]);
+            }
+        } else {
+            int64_t value_idx = 0;
+            for (int64_t i = 0; i < levels_read; ++i) {
+                if (_def_levels[i] < column.max_definition_level) {
+                    null_map.push_back(1);
+                    nested.insert_default();
+                } else {
+                    null_map.push_back(0);
+                    convert(values[value_idx++]);
+                }
+            }
+        }
+        read_rows += levels_read;
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
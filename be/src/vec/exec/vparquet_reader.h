@@ -0,0 +1,127 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cctz/time_zone.h>
+#include <parquet/api/reader.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "exec/arrow/arrow_reader.h"
+#include "exec/arrow/parquet_row_group_reader.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type.h"
+
+namespace doris {
+
+class FileReader;
+class SlotDescriptor;
+class TupleDescriptor;
+class ExprContext;
+
+namespace vectorized {
+
+// Reads a parquet file with the column readers of parquet-cpp, which decode the pages of the
+// column chunks into buffers the values are copied from into doris columns, without building
+// arrow record batches. The row groups are filtered by their statistics with RowGroupReader, and
+// only the column chunks of the columns read are fetched, with the ranges of a row group coalesced
+// and read ahead by ParquetFileReader::PreBuffer().
+//
+// It reads the flat columns of the boolean, integer, float, double, string, date and timestamp
+// types; init_reader() returns NotSupported if a column read is of another type or nested.
+class VParquetReader {
+public:
+    VParquetReader(FileReader* file_reader, int32_t num_of_columns_from_file,
+                   int64_t range_start_offset, int64_t range_size);
+    ~VParquetReader() = default;
+
+    Status init_reader(const TupleDescriptor* tuple_desc,
+                       const std::vector<SlotDescriptor*>& tuple_slot_descs,
+                       const std::vector<ExprContext*>& conjunct_ctxs,
+                       const cctz::time_zone& ctz);
+
+    // the nullable types of the columns read, in the order of the slots
+    const DataTypes& column_types() const { return _column_types; }
+
+    // append at most max_rows rows to the columns, *eof is set after the last row of the file
+    Status read(MutableColumns& columns, size_t max_rows, bool* eof);
+
+    std::shared_ptr<Statistics>& statistics() { return _statistics; }
+
+private:
+    enum class ValueKind {
+        BOOLEAN,
+        INT32,
+        INT64,
+        FLOAT,
+        DOUBLE,
+        STRING,
+        // days since the epoch
+        DATE,
+        // a unit of time since the epoch, the divisor converts it to seconds
+        TIMESTAMP,
+    };
+
+    struct ColumnContext {
+        int parquet_column_id;
+        ValueKind kind;
+        int64_t timestamp_divisor = 1;
+        int16_t max_definition_level = 0;
+        std::shared_ptr<parquet::ColumnReader> reader;
+    };
+
+    Status _init_column(int parquet_column_id, ColumnContext* column, DataTypePtr* type);
+
+    Status _next_row_group(bool* eof);
+
+    Status _read_column(ColumnContext& column, size_t rows, IColumn* dst);
+
+    template <typename ParquetType, typename Convert>
+    Status _read_values(ColumnContext& column, size_t rows, IColumn* dst, Convert&& convert);
+
+    std::shared_ptr<ArrowFile> _arrow_file;
+    std::unique_ptr<parquet::ParquetFileReader> _file_reader;
+    std::shared_ptr<parquet::FileMetaData> _file_metadata;
+    const int32_t _num_of_columns_from_file;
+    int64_t _range_start_offset;
+    int64_t _range_size;
+    cctz::time_zone _ctz;
+
+    std::vector<ColumnContext> _columns;
+    DataTypes _column_types;
+
+    // the row groups to read, after the filtered ones are removed
+    std::vector<int> _row_groups;
+    size_t _next_row_group_idx = 0;
+    int64_t _rows_of_group = 0;
+    int64_t _read_rows_of_group = 0;
+    bool _has_row_group = false;
+
+    std::vector<int16_t> _def_levels;
+    std::vector<uint8_t> _values_buf;
+
+    std::unique_ptr<doris::RowGroupReader> _row_group_reader;
+    std::shared_ptr<Statistics> _statistics;
+};
+
+} // namespace vectorized
+} // namespace doris
@@ -32,6 +32,7 @@
 #include "gen_cpp/Types_types.h"
 #include "runtime/mem_pool.h"
 #include "util/runtime_profile.h"
+#include "vec/exec/vparquet_reader.h"
 
 namespace doris::vectorized {
 
@@ -44,12 +45,26 @@ public:
                     const std::vector<TNetworkAddress>& broker_addresses,
                     const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter);
 
-    ~VParquetScanner() override = default;
+    ~VParquetScanner() override;
+
+    using VArrowScanner::get_next;
+
+    Status get_next(Block* block, bool* eof) override;
+
+    void close() override;
 
 protected:
     ArrowReaderWrap* _new_arrow_reader(FileReader* file_reader, int64_t batch_size,
                                        int32_t num_of_columns_from_file, int64_t range_start_offset,
                                        int64_t range_size) override;
+
+private:
+    Status _open_next_native_reader();
+    Status _init_native_src_block();
+
+    // read the files with VParquetReader, until a file has a column it does not support
+    bool _use_native_reader;
+    std::unique_ptr<VParquetReader> _native_reader;
 };
 
 } // namespace doris::vectorized
@@ -45,6 +45,7 @@ Status VSelectNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos
 Status VSelectNode::get_next(RuntimeState* state, vectorized::Block* block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "VSelectNode::get_next");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_CANCELLED(state);
     do {
         RETURN_IF_CANCELLED(state);
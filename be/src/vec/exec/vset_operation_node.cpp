@@ -120,8 +120,21 @@ Status VSetOperationNode::open(RuntimeState* state) {
     for (const std::vector<VExprContext*>& exprs : _child_expr_lists) {
         RETURN_IF_ERROR(VExpr::open(exprs, state));
     }
-    RETURN_IF_ERROR(hash_table_build(state));
-    return Status::OK();
+
+    std::promise<Status> build_status;
+    std::thread([this, state, build_status_p = &build_status,
+                 parent_span = opentelemetry::trace::Tracer::GetCurrentSpan()] {
+        OpentelemetryScope scope {parent_span};
+        SCOPED_ATTACH_TASK(state);
+        SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
+        build_status_p->set_value(hash_table_build(state));
+    }).detach();
+
+    // Open the first probe child while the hash table is built from child(0). Wait for the build
+    // thread even if the open fails, since it sets build_status.
+    Status open_status = child(1)->open(state);
+    RETURN_IF_ERROR(build_status.get_future().get());
+    return open_status;
 }
 
 Status VSetOperationNode::prepare(RuntimeState* state) {
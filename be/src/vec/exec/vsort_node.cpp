@@ -17,24 +17,160 @@
 
 #include "vec/exec/vsort_node.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include "common/config.h"
 #include "exec/sort_exec_exprs.h"
+#include "olap/topn_boundary.h"
+#include "runtime/exec_env.h"
+#include "runtime/memory/mem_arbiter.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
+#include "runtime/thread_context.h"
+#include "util/countdown_latch.h"
 #include "util/debug_util.h"
+#include "util/threadpool.h"
+#include "vec/core/block_spill_reader.h"
 #include "vec/core/sort_block.h"
+#include "vec/exec/volap_scan_node.h"
+#include "vec/exprs/vslot_ref.h"
+#include "vec/runtime/vsorted_run_merger.h"
 
 namespace doris::vectorized {
 
+void PartitionTopNFilter::filter(Block& block, const SortDescription& description) {
+    const size_t rows = block.rows();
+    Columns columns;
+    for (const auto& column_description : description) {
+        columns.emplace_back(block.get_by_position(column_description.column_number)
+                                     .column->convert_to_full_column_if_const());
+    }
+    if (_keys.empty()) {
+        for (size_t i = _partition_exprs_num; i < description.size(); ++i) {
+            _keys.emplace_back(columns[i]->clone_empty());
+        }
+    }
+    auto less = [&](size_t lhs, size_t rhs) {
+        for (size_t i = _partition_exprs_num; i < description.size(); ++i) {
+            const auto& column = _keys[i - _partition_exprs_num];
+            int res = description[i].direction *
+                      column->compare_at(lhs, rhs, *column, description[i].nulls_direction);
+            if (res != 0) {
+                return res < 0;
+            }
+        }
+        return false;
+    };
+
+    IColumn::Filter filter(rows, 1);
+    size_t kept_rows = 0;
+    for (size_t row = 0; row < rows; ++row) {
+        const char* begin = nullptr;
+        size_t key_size = 0;
+        for (size_t i = 0; i < _partition_exprs_num; ++i) {
+            key_size += columns[i]->serialize_value_into_arena(row, _arena, begin).size;
+        }
+        StringRef key(begin, key_size);
+        auto it = _partitions.find(key);
+        if (it == _partitions.end()) {
+            it = _partitions.emplace(key, std::vector<size_t>()).first;
+        } else {
+            // the key is already in the arena
+            _arena.rollback(key_size);
+        }
+
+        auto& heap = it->second;
+        if (heap.size() == static_cast<size_t>(_limit)) {
+            int res = _compare(columns, row, heap.front(), description);
+            if (res > 0) {
+                filter[row] = 0;
+                continue;
+            }
+            ++kept_rows;
+            if (res == 0) {
+                continue;
+            }
+            std::pop_heap(heap.begin(), heap.end(), less);
+            heap.pop_back();
+            --_heap_rows;
+        } else {
+            ++kept_rows;
+        }
+        for (size_t i = _partition_exprs_num; i < description.size(); ++i) {
+            _keys[i - _partition_exprs_num]->insert_from(*columns[i], row);
+        }
+        heap.push_back(_keys.empty() ? 0 : _keys[0]->size() - 1);
+        std::push_heap(heap.begin(), heap.end(), less);
+        ++_heap_rows;
+    }
+    if (!_keys.empty() && _keys[0]->size() > std::max<size_t>(2 * _heap_rows, 4096)) {
+        _compact();
+    }
+
+    if (kept_rows != rows) {
+        for (size_t i = 0; i < block.columns(); ++i) {
+            block.get_by_position(i).column = block.get_by_position(i).column->filter(filter, 0);
+        }
+    }
+}
+
+int64_t PartitionTopNFilter::top_row() const {
+    DCHECK_EQ(_partition_exprs_num, 0);
+    if (_partitions.empty()) {
+        return -1;
+    }
+    const auto& heap = _partitions.begin()->second;
+    return heap.size() == static_cast<size_t>(_limit) ? heap.front() : -1;
+}
+
+void PartitionTopNFilter::_compact() {
+    MutableColumns keys;
+    for (const auto& column : _keys) {
+        keys.emplace_back(column->clone_empty());
+        keys.back()->reserve(_heap_rows);
+    }
+    // the heaps keep their order, as the keys of their rows don't change
+    for (auto& [_, heap] : _partitions) {
+        for (auto& index : heap) {
+            for (size_t i = 0; i < keys.size(); ++i) {
+                keys[i]->insert_from(*_keys[i], index);
+            }
+            index = keys[0]->size() - 1;
+        }
+    }
+    _keys.swap(keys);
+}
+
+int PartitionTopNFilter::_compare(const Columns& columns, size_t row, size_t index,
+                                  const SortDescription& description) const {
+    for (size_t i = _partition_exprs_num; i < description.size(); ++i) {
+        int res = description[i].direction *
+                  columns[i]->compare_at(row, index, *_keys[i - _partition_exprs_num],
+                                         description[i].nulls_direction);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
 VSortNode::VSortNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
           _offset(tnode.sort_node.__isset.offset ? tnode.sort_node.offset : 0),
           _num_rows_skipped(0) {}
 
+VSortNode::~VSortNode() = default;
+
 Status VSortNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
     RETURN_IF_ERROR(_vsort_exec_exprs.init(tnode.sort_node.sort_info, _pool));
     _is_asc_order = tnode.sort_node.sort_info.is_asc_order;
     _nulls_first = tnode.sort_node.sort_info.nulls_first;
+    if (tnode.sort_node.__isset.partition_topn_limit) {
+        _partition_topn_filter.reset(new PartitionTopNFilter(
+                tnode.sort_node.partition_topn_limit, tnode.sort_node.partition_exprs_num));
+    }
     return Status::OK();
 }
 
@@ -44,17 +180,30 @@ Status VSortNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::prepare(state));
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
     RETURN_IF_ERROR(_vsort_exec_exprs.prepare(state, child(0)->row_desc(), _row_descriptor));
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spill_rows_counter = ADD_COUNTER(runtime_profile(), "SpillRows", TUnit::UNIT);
+    _spill_runs_counter = ADD_COUNTER(runtime_profile(), "SpillRuns", TUnit::UNIT);
+    if (_partition_topn_filter != nullptr) {
+        _partition_topn_filtered_rows =
+                ADD_COUNTER(runtime_profile(), "PartitionTopNFilteredRows", TUnit::UNIT);
+    }
     return Status::OK();
 }
 
 Status VSortNode::open(RuntimeState* state) {
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "VSortNode::open");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     RETURN_IF_ERROR(ExecNode::open(state));
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
     RETURN_IF_ERROR(_vsort_exec_exprs.open(state));
     RETURN_IF_CANCELLED(state);
     RETURN_IF_ERROR(state->check_query_state("vsort, while open."));
+    _init_topn_boundary();
+    // a TopN keeps its blocks by comparing them with the sorted ones it already has
+    if (_limit == -1 && config::sort_thread_num > 1) {
+        _sort_thread_num = config::sort_thread_num;
+    }
     RETURN_IF_ERROR(child(0)->open(state));
 
     // The child has been opened and the sorter created. Sort the input.
@@ -77,10 +226,15 @@ Status VSortNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos)
 Status VSortNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span, "VSortNode::get_next");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
 
     auto status = Status::OK();
-    if (_sorted_blocks.empty()) {
+    if (_spill_merger) {
+        RETURN_IF_ERROR(_spill_merger->get_next(block, eos));
+    } else if (_merged_in_parallel) {
+        RETURN_IF_ERROR(_read_merged_block(state, block, eos));
+    } else if (_sorted_blocks.empty()) {
         *eos = true;
     } else if (_sorted_blocks.size() == 1) {
         if (_offset != 0) {
@@ -106,6 +260,7 @@ Status VSortNode::close(RuntimeState* state) {
         return Status::OK();
     }
     START_AND_SCOPE_SPAN(state->get_tracer(), span, "VSortNode::close");
+    _release_spill_files();
     _vsort_exec_exprs.close(state);
     return ExecNode::close(state);
 }
@@ -131,6 +286,11 @@ Status VSortNode::sort_input(RuntimeState* state) {
 
         if (rows != 0) {
             RETURN_IF_ERROR(pretreat_block(block));
+            // the partition topn filter may have dropped all the rows
+            rows = block.rows();
+            if (rows == 0) {
+                continue;
+            }
             size_t mem_usage = block.allocated_bytes();
 
             // dispose TOP-N logic
@@ -160,6 +320,10 @@ Status VSortNode::sort_input(RuntimeState* state) {
                 // dispose normal sort logic
                 _total_mem_usage += mem_usage;
                 _sorted_blocks.emplace_back(std::move(block));
+                if (_should_spill()) {
+                    _sort_blocks_in_parallel(state);
+                    RETURN_IF_ERROR(_spill_sorted_blocks(state));
+                }
             }
 
             RETURN_IF_CANCELLED(state);
@@ -167,6 +331,20 @@ Status VSortNode::sort_input(RuntimeState* state) {
         }
     } while (!eos);
 
+    _sort_blocks_in_parallel(state);
+    if (!_spilled_runs.empty()) {
+        return _prepare_spilled_merge(state);
+    }
+    size_t total_rows = 0;
+    for (const auto& block : _sorted_blocks) {
+        total_rows += block.rows();
+    }
+    // a merge of fewer rows doesn't pay for the threads
+    if (_sort_thread_num > 1 && _sorted_blocks.size() > 1 &&
+        total_rows >= _sort_thread_num * state->batch_size()) {
+        _prepare_parallel_merge(state);
+        return Status::OK();
+    }
     build_merge_tree();
     return Status::OK();
 }
@@ -196,11 +374,73 @@ Status VSortNode::pretreat_block(doris::vectorized::Block& block) {
                 _nulls_first[i] ? -_sort_description[i].direction : _sort_description[i].direction;
     }
 
-    sort_block(block, _sort_description, _offset + _limit);
+    if (_partition_topn_filter != nullptr) {
+        size_t rows = block.rows();
+        _partition_topn_filter->filter(block, _sort_description);
+        COUNTER_UPDATE(_partition_topn_filtered_rows, rows - block.rows());
+    }
+    if (_topn_filter != nullptr) {
+        _topn_filter->filter(block, _sort_description);
+        _update_topn_boundary(block);
+    }
+    if (_sort_thread_num < 2) {
+        sort_block(block, _sort_description, _offset + _limit);
+    }
 
     return Status::OK();
 }
 
+void VSortNode::_init_topn_boundary() {
+    auto* scan_node = dynamic_cast<VOlapScanNode*>(child(0));
+    if (_limit <= 0 || !config::enable_topn_scan_filter || scan_node == nullptr) {
+        return;
+    }
+    auto* root = _vsort_exec_exprs.lhs_ordering_expr_ctxs()[0]->root();
+    if (!root->is_slot_ref()) {
+        return;
+    }
+    auto slot_id = static_cast<VSlotRef*>(root)->slot_id();
+    if (_vsort_exec_exprs.need_materialize_tuple()) {
+        // the ordering expr is a slot of the sort tuple, and the slot's expr is on the input
+        const auto& slots = _row_descriptor.tuple_descriptors()[0]->slots();
+        const auto& slot_exprs = _vsort_exec_exprs.sort_tuple_slot_expr_ctxs();
+        auto it = std::find_if(slots.begin(), slots.end(),
+                               [&](const SlotDescriptor* slot) { return slot->id() == slot_id; });
+        size_t index = it - slots.begin();
+        if (index >= slot_exprs.size()) {
+            return;
+        }
+        root = slot_exprs[index]->root();
+        if (!root->is_slot_ref()) {
+            return;
+        }
+        slot_id = static_cast<VSlotRef*>(root)->slot_id();
+    }
+    _topn_boundary =
+            scan_node->create_topn_boundary(slot_id, _is_asc_order[0], _nulls_first[0]);
+    if (_topn_boundary != nullptr) {
+        _topn_filter.reset(new PartitionTopNFilter(_offset + _limit, 0));
+    }
+}
+
+void VSortNode::_update_topn_boundary(const Block& block) {
+    int64_t row = _topn_filter->top_row();
+    if (row < 0) {
+        return;
+    }
+    const auto& column = _topn_filter->keys()[0];
+    // a null boundary leaves only the null rows to compete, which the zone maps can't tell
+    if (column->is_null_at(row)) {
+        return;
+    }
+    auto value = block.get_by_position(_sort_description[0].column_number)
+                         .type->to_string(*column, row);
+    if (value != _topn_boundary_value) {
+        _topn_boundary_value = value;
+        _topn_boundary->update(std::move(value));
+    }
+}
+
 void VSortNode::build_merge_tree() {
     for (const auto& block : _sorted_blocks) {
         _cursors.emplace_back(block, _sort_description);
@@ -254,4 +494,293 @@ Status VSortNode::merge_sort_read(doris::RuntimeState* state, doris::vectorized:
     return Status::OK();
 }
 
+void VSortNode::_run_in_parallel(RuntimeState* state, size_t task_num,
+                                 const std::function<void(size_t)>& task) {
+    if (task_num == 0) {
+        return;
+    }
+    // the first task is run by this thread, and so are the tasks the pool can't take
+    ThreadPool* pool = ExecEnv::GetInstance()->parallel_operator_thread_pool();
+    CountDownLatch latch(task_num - 1);
+    for (size_t t = 1; t < task_num; ++t) {
+        auto run = [&, t]() {
+            SCOPED_ATTACH_TASK(state);
+            SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
+            task(t);
+            latch.count_down();
+        };
+        if (pool == nullptr || !pool->submit_func(run).ok()) {
+            task(t);
+            latch.count_down();
+        }
+    }
+    task(0);
+    latch.wait();
+}
+
+void VSortNode::_sort_blocks_in_parallel(RuntimeState* state) {
+    if (_sort_thread_num < 2 || _num_sorted_blocks == _sorted_blocks.size()) {
+        return;
+    }
+    // the tasks take the next unsorted block until there is none left
+    std::atomic<size_t> next_block(_num_sorted_blocks);
+    _run_in_parallel(state, std::min(_sort_thread_num, _sorted_blocks.size() - _num_sorted_blocks),
+                     [&](size_t) {
+                         for (size_t i = next_block++; i < _sorted_blocks.size();
+                              i = next_block++) {
+                             sort_block(_sorted_blocks[i], _sort_description, _offset + _limit);
+                         }
+                     });
+    _num_sorted_blocks = _sorted_blocks.size();
+}
+
+int VSortNode::_compare_rows(size_t lhs_block, size_t lhs_row, size_t rhs_block,
+                             size_t rhs_row) const {
+    return SortCursor(const_cast<SortCursorImpl*>(&_merge_cursors[lhs_block]))
+            .greater_at(SortCursor(const_cast<SortCursorImpl*>(&_merge_cursors[rhs_block])),
+                        lhs_row, rhs_row);
+}
+
+size_t VSortNode::_lower_bound(size_t block, const std::pair<size_t, size_t>& key) const {
+    size_t low = 0;
+    size_t high = _merge_cursors[block].rows;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (_compare_rows(block, middle, key.first, key.second) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void VSortNode::_prepare_parallel_merge(RuntimeState* state) {
+    size_t total_rows = 0;
+    for (const auto& block : _sorted_blocks) {
+        _merge_cursors.emplace_back(block, _sort_description);
+        total_rows += block.rows();
+    }
+
+    // The ranges hold a few batches each, so that a round of merges holds only a small part of
+    // the input, and there are at most 64 of them per task to bound the cost of their bounds.
+    const size_t num_ranges =
+            std::clamp<size_t>(total_rows / (4 * state->batch_size()), _sort_thread_num,
+                               _sort_thread_num * 64);
+    // Evenly spaced rows of every block are sampled, so that the quantiles of the sorted samples
+    // are close to the ones of all the rows and split them into ranges of about the same size.
+    const size_t step = std::max<size_t>(1, total_rows / (num_ranges * 4));
+    std::vector<std::pair<size_t, size_t>> samples;
+    for (size_t i = 0; i < _merge_cursors.size(); ++i) {
+        for (size_t row = step / 2; row < _merge_cursors[i].rows; row += step) {
+            samples.emplace_back(i, row);
+        }
+    }
+    std::sort(samples.begin(), samples.end(), [&](const auto& lhs, const auto& rhs) {
+        return _compare_rows(lhs.first, lhs.second, rhs.first, rhs.second) < 0;
+    });
+    for (size_t r = 1; r < num_ranges && !samples.empty(); ++r) {
+        _merge_splitters.push_back(samples[samples.size() * r / num_ranges]);
+    }
+    _merged_in_parallel = true;
+}
+
+void VSortNode::_merge_range(size_t range, size_t batch_size, std::vector<Block>* blocks) const {
+    // the range holds the rows not less than its splitter and less than the next one
+    const size_t num_ranges = _merge_splitters.size() + 1;
+    std::vector<SortCursorImpl> cursors;
+    cursors.reserve(_merge_cursors.size());
+    for (size_t i = 0; i < _merge_cursors.size(); ++i) {
+        size_t begin = range == 0 ? 0 : _lower_bound(i, _merge_splitters[range - 1]);
+        size_t end = range + 1 == num_ranges ? _merge_cursors[i].rows
+                                             : _lower_bound(i, _merge_splitters[range]);
+        if (begin < end) {
+            cursors.push_back(_merge_cursors[i]);
+            cursors.back().pos = begin;
+            cursors.back().rows = end;
+        }
+    }
+    std::priority_queue<SortCursor> queue;
+    for (auto& cursor : cursors) {
+        queue.push(SortCursor(&cursor));
+    }
+    const size_t num_columns = _sorted_blocks[0].columns();
+    MutableColumns columns;
+    while (!queue.empty()) {
+        if (columns.empty()) {
+            columns = _sorted_blocks[0].clone_empty_columns();
+        }
+        auto current = queue.top();
+        queue.pop();
+        for (size_t i = 0; i < num_columns; ++i) {
+            columns[i]->insert_from(*current->all_columns[i], current->pos);
+        }
+        if (!current->isLast()) {
+            current->next();
+            queue.push(current);
+        }
+        if (columns[0]->size() == batch_size) {
+            blocks->emplace_back(_sorted_blocks[0].clone_with_columns(std::move(columns)));
+            columns.clear();
+        }
+    }
+    if (!columns.empty() && columns[0]->size() != 0) {
+        blocks->emplace_back(_sorted_blocks[0].clone_with_columns(std::move(columns)));
+    }
+}
+
+Status VSortNode::_read_merged_block(RuntimeState* state, Block* block, bool* eos) {
+    const size_t num_ranges = _merge_splitters.size() + 1;
+    while (true) {
+        if (_next_merged_block == _merged_blocks.size()) {
+            if (_next_merge_range == num_ranges) {
+                // all the rows are returned, the input isn't needed anymore
+                _merge_cursors.clear();
+                _sorted_blocks.clear();
+                *eos = true;
+                return Status::OK();
+            }
+            // the next ranges are merged once the merged rows of the last ones are read, so only
+            // the rows of a round of ranges are held besides the input
+            const size_t first = _next_merge_range;
+            const size_t task_num = std::min(_sort_thread_num, num_ranges - first);
+            std::vector<std::vector<Block>> range_blocks(task_num);
+            _run_in_parallel(state, task_num, [&](size_t t) {
+                _merge_range(first + t, state->batch_size(), &range_blocks[t]);
+            });
+            _next_merge_range += task_num;
+            _merged_blocks.clear();
+            _next_merged_block = 0;
+            for (auto& blocks : range_blocks) {
+                for (auto& merged : blocks) {
+                    _merged_blocks.emplace_back(std::move(merged));
+                }
+            }
+            RETURN_IF_ERROR(state->check_query_state("vsort, while merging in parallel."));
+            continue;
+        }
+
+        auto& merged = _merged_blocks[_next_merged_block++];
+        if (_offset >= static_cast<int64_t>(merged.rows())) {
+            _offset -= merged.rows();
+            merged.clear();
+            continue;
+        }
+        if (_offset != 0) {
+            merged.skip_num_rows(_offset);
+            _offset = 0;
+        }
+        block->swap(merged);
+        *eos = false;
+        return Status::OK();
+    }
+}
+
+bool VSortNode::_should_spill() const {
+    if (!config::enable_sort_spill) {
+        return false;
+    }
+    return _total_mem_usage > config::sort_spill_mem_threshold_bytes ||
+           (MemArbiter::should_spill() && _total_mem_usage > config::mem_pressure_spill_min_bytes);
+}
+
+// Every block in `_sorted_blocks` is sorted by itself, so each of them is a run to merge.
+static std::vector<BlockSupplier> create_in_memory_suppliers(std::vector<Block>& blocks) {
+    std::vector<BlockSupplier> suppliers;
+    for (auto& block : blocks) {
+        suppliers.emplace_back([block = &block, consumed = false](Block** out) mutable {
+            *out = consumed ? nullptr : block;
+            consumed = true;
+            return Status::OK();
+        });
+    }
+    return suppliers;
+}
+
+Status VSortNode::_spill_sorted_blocks(RuntimeState* state) {
+    RETURN_IF_ERROR(_merge_runs_to_spill(state, create_in_memory_suppliers(_sorted_blocks)));
+    _sorted_blocks.clear();
+    _num_sorted_blocks = 0;
+    _total_mem_usage = 0;
+    return Status::OK();
+}
+
+Status VSortNode::_merge_runs_to_spill(RuntimeState* state,
+                                       const std::vector<BlockSupplier>& runs) {
+    SCOPED_TIMER(_spill_timer);
+    BlockSpillWriterUPtr writer;
+    RETURN_IF_ERROR(BlockSpillWriter::create(state->query_id(), state->batch_size(), &writer));
+
+    VSortedRunMerger merger(_vsort_exec_exprs.lhs_ordering_expr_ctxs(), _is_asc_order,
+                            _nulls_first, state->batch_size(), -1, 0, runtime_profile());
+    RETURN_IF_ERROR(merger.prepare(runs));
+    bool eos = false;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        Block block;
+        RETURN_IF_ERROR(merger.get_next(&block, &eos));
+        RETURN_IF_ERROR(writer->write(block));
+    }
+    RETURN_IF_ERROR(writer->close());
+
+    COUNTER_UPDATE(_spill_rows_counter, writer->written_rows());
+    COUNTER_UPDATE(_spill_runs_counter, 1);
+    _spilled_runs.emplace_back(std::move(writer));
+    return Status::OK();
+}
+
+Status VSortNode::_create_spilled_run_suppliers(size_t begin, size_t end,
+                                                std::vector<BlockSupplier>* suppliers) {
+    for (size_t i = begin; i < end; ++i) {
+        std::shared_ptr<BlockSpillReader> reader(
+                new BlockSpillReader(_spilled_runs[i]->file_path()));
+        RETURN_IF_ERROR(reader->open());
+        // The reader owns the file from now on and removes it once it is destroyed.
+        _spilled_runs[i].reset();
+
+        auto block = std::make_shared<Block>();
+        suppliers->emplace_back([reader, block](Block** out) {
+            bool eos = false;
+            RETURN_IF_ERROR(reader->read(block.get(), &eos));
+            *out = eos ? nullptr : block.get();
+            return Status::OK();
+        });
+    }
+    return Status::OK();
+}
+
+Status VSortNode::_prepare_spilled_merge(RuntimeState* state) {
+    // Runs are merged level by level, so that the final merge opens at most
+    // `sort_spill_merge_fan_in` spilled files at the same time.
+    const size_t fan_in = std::max(config::sort_spill_merge_fan_in, 2);
+    size_t merged = 0;
+    while (_spilled_runs.size() - merged > fan_in) {
+        size_t end = merged + fan_in;
+        std::vector<BlockSupplier> suppliers;
+        RETURN_IF_ERROR(_create_spilled_run_suppliers(merged, end, &suppliers));
+        RETURN_IF_ERROR(_merge_runs_to_spill(state, suppliers));
+        merged = end;
+    }
+
+    auto suppliers = create_in_memory_suppliers(_sorted_blocks);
+    RETURN_IF_ERROR(_create_spilled_run_suppliers(merged, _spilled_runs.size(), &suppliers));
+    _spilled_runs.clear();
+
+    _spill_merger.reset(new VSortedRunMerger(_vsort_exec_exprs.lhs_ordering_expr_ctxs(),
+                                             _is_asc_order, _nulls_first, state->batch_size(),
+                                             -1, _offset, runtime_profile()));
+    return _spill_merger->prepare(suppliers);
+}
+
+void VSortNode::_release_spill_files() {
+    // Dropping the merger closes the readers of the spilled runs, which removes their files.
+    _spill_merger.reset();
+    for (auto& run : _spilled_runs) {
+        if (run) {
+            WARN_IF_ERROR(run->abort(), "failed to remove spilled sort run");
+        }
+    }
+    _spilled_runs.clear();
+}
+
 } // namespace doris::vectorized
@@ -17,24 +17,88 @@
 
 #pragma once
 
+#include <parallel_hashmap/phmap.h>
+
+#include <functional>
 #include <queue>
 
 #include "exec/exec_node.h"
+#include "vec/common/arena.h"
+#include "vec/common/string_ref.h"
 #include "vec/core/block.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/core/sort_cursor.h"
 #include "vec/exec/vsort_exec_exprs.h"
 
+namespace doris {
+class TopNBoundary;
+}
+
 namespace doris::vectorized {
+class VSortedRunMerger;
+
+// Drops the rows of the input of the sort of an analytic node that can't be among the first `limit`
+// rows of their partition, for a filter like row_number() <= limit or rank() <= limit on its
+// output. For every partition, the sort keys of at most `limit` of the rows kept so far are in a
+// heap whose top is the last one in the sort order. A row after the top of a full heap has
+// `limit` rows before it in the partition, so it's dropped; a row before it replaces it, and a
+// row equal to it is kept for the ties of rank(). Without partition exprs all the rows are in one
+// partition, which filters the input of a TopN.
+class PartitionTopNFilter {
+public:
+    // The first `partition_exprs_num` columns of the sort description are the partition exprs.
+    PartitionTopNFilter(int64_t limit, size_t partition_exprs_num)
+            : _limit(limit), _partition_exprs_num(partition_exprs_num) {
+        DCHECK_GT(limit, 0);
+    }
+
+    // Removes the dropped rows from the block, the columns of the sort description must be in it.
+    void filter(Block& block, const SortDescription& description);
+
+    // The row of `keys()` at the top of the heap of the only partition once it's full, the last of
+    // the `limit` rows kept so far, or -1. Only used without partition exprs.
+    int64_t top_row() const;
+
+    const MutableColumns& keys() const { return _keys; }
+
+private:
+    // compares the sort keys of the row of the sort columns with the kept row `index`
+    int _compare(const Columns& columns, size_t row, size_t index,
+                 const SortDescription& description) const;
+    // drops the sort keys of the rows that have left the heaps
+    void _compact();
+
+    const int64_t _limit;
+    const size_t _partition_exprs_num;
+    // the serialized partition keys, and the indexes of the rows in the heap of each partition
+    Arena _arena;
+    phmap::flat_hash_map<StringRef, std::vector<size_t>, StringRefHash> _partitions;
+    // the sort keys, after the partition exprs, of the rows that have been in heaps
+    MutableColumns _keys;
+    // the number of rows in the heaps
+    size_t _heap_rows = 0;
+};
+
 // Node that implements a full sort of its input with a fixed memory budget
 // In open() the input Block to VSortNode will sort firstly, using the expressions specified in _sort_exec_exprs.
 // In get_next(), VSortNode do the merge sort to gather data to a new block
-
-// support spill to disk in the future
+//
+// When `enable_sort_spill` is set and the sorted blocks of a full sort exceed
+// `sort_spill_mem_threshold_bytes`, they are merged into one sorted run that is written to a
+// scratch file. In get_next(), the spilled runs and the blocks still in memory are merged by
+// a VSortedRunMerger.
+//
+// With `sort_thread_num` of 2 or more, the blocks of a full sort are sorted by that many tasks on
+// the parallel operator pool once the input is read or before they are spilled, instead of one by
+// one on the fragment thread. The sorted blocks kept in memory are then merged by the tasks too:
+// sampled rows split the keys into ranges, and while the output is read, every round of tasks
+// merges the rows of the next ranges of all the blocks, whose merged blocks follow each other in
+// the output.
 class VSortNode : public doris::ExecNode {
 public:
     VSortNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
 
-    ~VSortNode() override = default;
+    ~VSortNode() override;
 
     virtual Status init(const TPlanNode& tnode, RuntimeState* state = nullptr) override;
 
@@ -63,6 +127,44 @@ private:
 
     Status merge_sort_read(RuntimeState* state, Block* block, bool* eos);
 
+    // Runs task(0) to task(task_num - 1) on the parallel operator pool and waits for them.
+    void _run_in_parallel(RuntimeState* state, size_t task_num,
+                          const std::function<void(size_t)>& task);
+    // Sorts the blocks of `_sorted_blocks` added since the last call on `_sort_thread_num`
+    // tasks. Does nothing when the blocks are sorted as they arrive.
+    void _sort_blocks_in_parallel(RuntimeState* state);
+    // compares the row `lhs_row` of the sorted block `lhs_block` with `rhs_row` of `rhs_block`
+    int _compare_rows(size_t lhs_block, size_t lhs_row, size_t rhs_block, size_t rhs_row) const;
+    // the first row of the sorted block `block` that isn't less than the row `key`
+    size_t _lower_bound(size_t block, const std::pair<size_t, size_t>& key) const;
+    // Splits the keys of the sorted blocks into the ranges of the parallel merge.
+    void _prepare_parallel_merge(RuntimeState* state);
+    // Merges the rows of the range `range` of all the sorted blocks into blocks of `batch_size`.
+    void _merge_range(size_t range, size_t batch_size, std::vector<Block>* blocks) const;
+    Status _read_merged_block(RuntimeState* state, Block* block, bool* eos);
+
+    bool _should_spill() const;
+
+    // Merge the blocks in `_sorted_blocks` into one sorted run and spill it to disk.
+    Status _spill_sorted_blocks(RuntimeState* state);
+
+    // Merge the given sorted runs and write the result to a new spilled run.
+    Status _merge_runs_to_spill(RuntimeState* state, const std::vector<BlockSupplier>& runs);
+
+    Status _create_spilled_run_suppliers(size_t begin, size_t end,
+                                         std::vector<BlockSupplier>* suppliers);
+
+    // Build `_spill_merger` for the final merge of all spilled runs and in-memory blocks.
+    Status _prepare_spilled_merge(RuntimeState* state);
+
+    void _release_spill_files();
+
+    // Lets the olap scan right below a TopN skip the pages that can't be in its result, see
+    // TopNBoundary.
+    void _init_topn_boundary();
+    // publishes the first sort key of the last row kept by `_topn_filter` as the boundary
+    void _update_topn_boundary(const Block& block);
+
     // Number of rows to skip.
     int64_t _offset;
 
@@ -76,6 +178,21 @@ private:
     std::vector<Block> _sorted_blocks;
     std::priority_queue<SortCursor> _priority_queue;
 
+    // the number of threads of a full sort, 1 if the blocks are sorted as they arrive
+    size_t _sort_thread_num = 1;
+    // the blocks of `_sorted_blocks` before this one are sorted
+    size_t _num_sorted_blocks = 0;
+    bool _merged_in_parallel = false;
+    // the cursors of the sorted blocks merged in parallel
+    std::vector<SortCursorImpl> _merge_cursors;
+    // the (block, row) of the first key of every range of the parallel merge but the first one
+    std::vector<std::pair<size_t, size_t>> _merge_splitters;
+    // the next range to merge
+    size_t _next_merge_range = 0;
+    // the merged blocks of the last round of ranges in order, and the next one to return
+    std::vector<Block> _merged_blocks;
+    size_t _next_merged_block = 0;
+
     // TODO: Not using now, maybe should be delete
     // Keeps track of the number of rows skipped for handling _offset.
     int64_t _num_rows_skipped;
@@ -84,6 +201,21 @@ private:
     // only valid in TOP-N node
     uint64_t _num_rows_in_block = 0;
     std::priority_queue<SortBlockCursor> _block_priority_queue;
+
+    std::vector<BlockSpillWriterUPtr> _spilled_runs;
+    std::unique_ptr<VSortedRunMerger> _spill_merger;
+
+    std::unique_ptr<PartitionTopNFilter> _partition_topn_filter;
+    RuntimeProfile::Counter* _partition_topn_filtered_rows = nullptr;
+
+    // the filter of the input of a TopN whose scan skips pages by its boundary
+    std::unique_ptr<PartitionTopNFilter> _topn_filter;
+    std::shared_ptr<TopNBoundary> _topn_boundary;
+    std::string _topn_boundary_value;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_rows_counter = nullptr;
+    RuntimeProfile::Counter* _spill_runs_counter = nullptr;
 };
 
 } // namespace doris::vectorized
@@ -82,6 +82,7 @@ Status VTableFunctionNode::get_next(RuntimeState* state, Block* block, bool* eos
     INIT_AND_SCOPE_GET_NEXT_SPAN(state->get_tracer(), _get_next_span,
                                  "VTableFunctionNode::get_next");
     SCOPED_TIMER(_runtime_profile->total_time_counter());
+    SCOPED_PERF_COUNTERS(_perf_counters.get());
 
     RETURN_IF_CANCELLED(state);
 
@@ -154,9 +155,10 @@ Status VTableFunctionNode::get_expanded_block(RuntimeState* state, Block* output
                 continue;
             }
 
-            // get slots from every table function.
+            // get slots from every table function but the last one, whose values are the ones
+            // that change from one output row to the next and are inserted in a batch below.
             // notice that _fn_values[i] may be null if the table function has empty result set.
-            for (int i = 0; i < _fn_num; i++) {
+            for (int i = 0; i < _fn_num - 1; i++) {
                 RETURN_IF_ERROR(_fns[i]->get_value(&_fn_values[i]));
                 RETURN_IF_ERROR(_fns[i]->get_value_length(&_fn_value_lengths[i]));
             }
@@ -164,26 +166,30 @@ Status VTableFunctionNode::get_expanded_block(RuntimeState* state, Block* output
             // The tuples order in parent row batch should be
             //      child1, child2, tf1, tf2, ...
 
-            // 1. copy data from child_block.
+            // 1. copy the values of the current row of the last table function, as many as fit
+            // in the batch, and forward it past them.
+            int last_slot_idx = _child_slots.size() + _fn_num - 1;
+            int output_rows = columns[_child_slots.size()]->size();
+            int max_step = std::max(1, state->batch_size() - output_rows);
+            int step = 0;
+            RETURN_IF_ERROR(_fns[_fn_num - 1]->get_many_values(columns[last_slot_idx].get(),
+                                                               max_step, &step));
+
+            // 2. copy data from child_block and the results of the other functions step times.
             for (int i = 0; i < _child_slots.size(); i++) {
                 auto src_column = _child_block->get_by_position(i).column;
-                columns[i]->insert_from(*src_column, _cur_child_offset);
+                columns[i]->insert_many_from(*src_column, _cur_child_offset, step);
             }
-
-            // 2. copy function result
-            for (int i = 0; i < _fns.size(); i++) {
+            for (int i = 0; i < _fn_num - 1; i++) {
                 int output_slot_idx = i + _child_slots.size();
                 if (_fn_values[i] == nullptr) {
-                    columns[output_slot_idx]->insert_default();
+                    columns[output_slot_idx]->insert_many_defaults(step);
                 } else {
-                    columns[output_slot_idx]->insert_data(reinterpret_cast<char*>(_fn_values[i]),
-                                                          _fn_value_lengths[i]);
+                    columns[output_slot_idx]->insert_many_data(
+                            reinterpret_cast<char*>(_fn_values[i]), _fn_value_lengths[i], step);
                 }
             }
 
-            bool tmp = false;
-            _fns[_fn_num - 1]->forward(&tmp);
-
             if (columns[_child_slots.size()]->size() >= state->batch_size()) {
                 break;
             }
@@ -105,4 +105,26 @@ Status VExplodeTableFunction::get_value_length(int64_t* length) {
     return Status::OK();
 }
 
+Status VExplodeTableFunction::get_many_values(IColumn* column, int max_step, int* step) {
+    if (_is_current_empty || !column->is_nullable()) {
+        return TableFunction::get_many_values(column, max_step, step);
+    }
+
+    // the elements are a range of the nested column
+    *step = std::min<int64_t>(max_step, _cur_size - _cur_offset);
+    size_t pos = _array_offset + _cur_offset;
+    auto* nullable_column = assert_cast<ColumnNullable*>(column);
+    nullable_column->get_nested_column().insert_range_from(*_detail.nested_col, pos, *step);
+    auto& null_map = nullable_column->get_null_map_data();
+    if (_detail.nested_nullmap_data) {
+        const auto* nested_nullmap = _detail.nested_nullmap_data + pos;
+        null_map.insert(nested_nullmap, nested_nullmap + *step);
+    } else {
+        null_map.resize_fill(null_map.size() + *step, 0);
+    }
+    _cur_offset += *step;
+    _eos = _cur_offset == _cur_size;
+    return Status::OK();
+}
+
 } // namespace doris::vectorized
@@ -38,6 +38,7 @@ public:
     virtual Status reset() override;
     virtual Status get_value(void** output) override;
     virtual Status get_value_length(int64_t* length) override;
+    virtual Status get_many_values(IColumn* column, int max_step, int* step) override;
 
 private:
     ColumnPtr _array_column;
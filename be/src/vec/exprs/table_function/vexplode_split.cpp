@@ -61,11 +61,10 @@ Status VExplodeSplitTableFunction::process_row(size_t row_idx) {
         _cur_size = 0;
         _cur_offset = 0;
     } else {
-        //TODO: implement non-copy split string reference
-        _backup = strings::Split(StringPiece((char*)text.data, text.size),
+        _pieces = strings::Split(StringPiece((char*)text.data, text.size),
                                  StringPiece((char*)delimiter.data, delimiter.size));
 
-        _cur_size = _backup.size();
+        _cur_size = _pieces.size();
         _cur_offset = 0;
         _is_current_empty = (_cur_size == 0);
     }
@@ -75,6 +74,7 @@ Status VExplodeSplitTableFunction::process_row(size_t row_idx) {
 Status VExplodeSplitTableFunction::process_close() {
     _text_column = nullptr;
     _delimiter_column = nullptr;
+    _pieces.clear();
     return Status::OK();
 }
 
@@ -82,7 +82,7 @@ Status VExplodeSplitTableFunction::get_value(void** output) {
     if (_is_current_empty) {
         *output = nullptr;
     } else {
-        *output = _backup[_cur_offset].data();
+        *output = const_cast<char*>(_pieces[_cur_offset].data());
     }
     return Status::OK();
 }
@@ -91,9 +91,27 @@ Status VExplodeSplitTableFunction::get_value_length(int64_t* length) {
     if (_is_current_empty) {
         *length = -1;
     } else {
-        *length = _backup[_cur_offset].length();
+        *length = _pieces[_cur_offset].length();
     }
     return Status::OK();
 }
 
+Status VExplodeSplitTableFunction::get_many_values(IColumn* column, int max_step, int* step) {
+    if (_is_current_empty) {
+        column->insert_default();
+        *step = 1;
+        _eos = true;
+        return Status::OK();
+    }
+
+    *step = std::min<int64_t>(max_step, _cur_size - _cur_offset);
+    for (int i = 0; i < *step; ++i) {
+        const auto& piece = _pieces[_cur_offset + i];
+        column->insert_data(piece.data(), piece.length());
+    }
+    _cur_offset += *step;
+    _eos = _cur_offset == _cur_size;
+    return Status::OK();
+}
+
 } // namespace doris::vectorized
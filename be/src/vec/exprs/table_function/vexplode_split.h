@@ -35,12 +35,15 @@ public:
     virtual Status process_close() override;
     virtual Status get_value(void** output) override;
     virtual Status get_value_length(int64_t* length) override;
+    virtual Status get_many_values(IColumn* column, int max_step, int* step) override;
 
 private:
     using ExplodeSplitTableFunction::process;
 
     ColumnPtr _text_column;
     ColumnPtr _delimiter_column;
+    // the pieces of the text of the current row, which point into `_text_column`
+    std::vector<StringPiece> _pieces;
 };
 
 } // namespace doris::vectorized
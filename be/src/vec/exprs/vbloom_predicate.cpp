@@ -19,6 +19,12 @@
 
 #include <string_view>
 
+#include "runtime/datetime_value.h"
+#include "runtime/string_value.h"
+#include "util/binary_cast.hpp"
+#include "vec/columns/column_nullable.h"
+#include "vec/runtime/vdatetime_value.h"
+
 namespace doris::vectorized {
 
 VBloomPredicate::VBloomPredicate(const TExprNode& node)
@@ -73,8 +79,41 @@ Status VBloomPredicate::execute(VExprContext* context, Block* block, int* result
     size_t sz = argument_column->size();
     res_data_column->resize(sz);
     auto ptr = ((ColumnVector<UInt8>*)res_data_column.get())->get_data().data();
-    for (size_t i = 0; i < sz; i++) {
-        ptr[i] = _filter->find(reinterpret_cast<const void*>(argument_column->get_data_at(i).data));
+
+    const uint8_t* null_map = nullptr;
+    const IColumn* data_column = argument_column.get();
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(*argument_column)) {
+        null_map = nullable->get_null_map_data().data();
+        data_column = &nullable->get_nested_column();
+    }
+    // The values are probed the way the build side inserted them, see
+    // RuntimePredicateWrapper::insert(const StringRef&).
+    auto type = _children[0]->type().type;
+    if (is_string_type(type)) {
+        for (size_t i = 0; i < sz; i++) {
+            if (null_map != nullptr && null_map[i]) {
+                ptr[i] = false;
+                continue;
+            }
+            auto ref = data_column->get_data_at(i);
+            StringValue value(const_cast<char*>(ref.data), ref.size);
+            ptr[i] = _filter->find(reinterpret_cast<const void*>(&value));
+        }
+    } else if (type == TYPE_DATE || type == TYPE_DATETIME) {
+        const auto* date_times = reinterpret_cast<const Int64*>(data_column->get_raw_data().data);
+        for (size_t i = 0; i < sz; i++) {
+            if (null_map != nullptr && null_map[i]) {
+                ptr[i] = false;
+                continue;
+            }
+            auto vec_date_time_value = binary_cast<Int64, VecDateTimeValue>(date_times[i]);
+            DateTimeValue date_time_value;
+            vec_date_time_value.convert_vec_dt_to_dt(&date_time_value);
+            ptr[i] = _filter->find(reinterpret_cast<const void*>(&date_time_value));
+        }
+    } else {
+        // the column holds the values just like the build side inserted them
+        _filter->find_fixed_len(data_column->get_raw_data().data, null_map, sz, ptr);
     }
     if (_data_type->is_nullable()) {
         auto null_map = ColumnVector<UInt8>::create(block->rows(), 0);
@@ -17,6 +17,7 @@
 
 #include "vec/exprs/vcase_expr.h"
 
+#include "common/config.h"
 #include "vec/columns/column_nullable.h"
 
 namespace doris::vectorized {
@@ -92,13 +93,16 @@ void VCaseExpr::close(RuntimeState* state, VExprContext* context,
 Status VCaseExpr::execute(VExprContext* context, Block* block, int* result_column_id) {
     ColumnNumbers arguments(_children.size());
 
-    for (int i = 0; i < _children.size(); i++) {
-        int column_id = -1;
-        _children[i]->execute(context, block, &column_id);
-        arguments[i] = column_id;
+    if (config::enable_short_circuit_evaluation) {
+        RETURN_IF_ERROR(_execute_branches(context, block, &arguments));
+    } else {
+        for (int i = 0; i < _children.size(); i++) {
+            int column_id = -1;
+            _children[i]->execute(context, block, &column_id);
+            arguments[i] = column_id;
 
-        block->replace_by_position_if_const(column_id);
-        auto child_column = block->get_by_position(column_id).column;
+            block->replace_by_position_if_const(column_id);
+        }
     }
 
     size_t num_columns_without_result = block->columns();
@@ -111,6 +115,75 @@ Status VCaseExpr::execute(VExprContext* context, Block* block, int* result_colum
     return Status::OK();
 }
 
+Status VCaseExpr::_execute_branches(VExprContext* context, Block* block,
+                                    ColumnNumbers* arguments) {
+    const size_t rows = block->rows();
+    auto insert_argument = [&](int child, ColumnPtr column) {
+        block->insert({std::move(column), _children[child]->data_type(),
+                       _children[child]->expr_name()});
+        (*arguments)[child] = block->columns() - 1;
+    };
+
+    ColumnPtr case_column;
+    int begin = 0;
+    if (_has_case_expr) {
+        int column_id = -1;
+        RETURN_IF_ERROR(_children[0]->execute(context, block, &column_id));
+        block->replace_by_position_if_const(column_id);
+        (*arguments)[0] = column_id;
+        case_column = block->get_by_position(column_id).column;
+        begin = 1;
+    }
+    const int end = _children.size() - _has_else_expr;
+
+    // the rows not matched by the branches executed so far, and the ones matched by this branch
+    IColumn::Filter remaining(rows, 1);
+    size_t remaining_count = rows;
+    IColumn::Filter matched(rows);
+    for (int i = begin; i < end; i += 2) {
+        ColumnPtr when;
+        RETURN_IF_ERROR(_children[i]->execute_on_selected_rows(context, block, remaining,
+                                                               remaining_count, &when));
+        // the same matching as the case function
+        ColumnPtr case_to_compare = case_column;
+        ColumnPtr when_to_compare = when;
+        if (_has_case_expr && (case_column->is_nullable() || when->is_nullable())) {
+            case_to_compare = make_nullable(case_column);
+            when_to_compare = make_nullable(when);
+        }
+        size_t matched_count = 0;
+        for (size_t row = 0; row < rows; ++row) {
+            bool match = false;
+            if (remaining[row] && _has_case_expr) {
+                match = !case_to_compare->is_null_at(row) &&
+                        case_to_compare->compare_at(row, row, *when_to_compare, -1) == 0;
+            } else if (remaining[row]) {
+                match = when->get_bool(row);
+            }
+            matched[row] = match;
+            matched_count += match;
+        }
+
+        ColumnPtr then;
+        RETURN_IF_ERROR(_children[i + 1]->execute_on_selected_rows(context, block, matched,
+                                                                   matched_count, &then));
+        for (size_t row = 0; row < rows; ++row) {
+            remaining[row] &= !matched[row];
+        }
+        remaining_count -= matched_count;
+        insert_argument(i, std::move(when));
+        insert_argument(i + 1, std::move(then));
+    }
+
+    if (_has_else_expr) {
+        ColumnPtr else_column;
+        RETURN_IF_ERROR(_children[end]->execute_on_selected_rows(context, block, remaining,
+                                                                 remaining_count, &else_column));
+        insert_argument(end, std::move(else_column));
+    }
+    return Status::OK();
+}
+
 const std::string& VCaseExpr::expr_name() const {
     return _expr_name;
 }
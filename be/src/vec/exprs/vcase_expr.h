@@ -40,7 +40,15 @@ public:
     virtual const std::string& expr_name() const override;
     virtual std::string debug_string() const override;
 
+    bool has_case_expr() const { return _has_case_expr; }
+    bool has_else_expr() const { return _has_else_expr; }
+
 private:
+    // Executes the case expr, the whens of each branch on the rows not matched by the branches
+    // before it, and its then on the rows it matches, and the else on the rows left. The columns
+    // of all the rows are inserted into the block for the case function.
+    Status _execute_branches(VExprContext* context, Block* block, ColumnNumbers* arguments);
+
     bool _is_prepare;
     bool _has_case_expr;
     bool _has_else_expr;
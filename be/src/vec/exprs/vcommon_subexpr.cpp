@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vcommon_subexpr.h"
+
+#include <fmt/format.h>
+
+#include <typeinfo>
+#include <unordered_map>
+
+#include "vec/exprs/vcase_expr.h"
+#include "vec/exprs/vcast_expr.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vin_predicate.h"
+#include "vec/exprs/vliteral.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+class CommonSubexprFinder {
+public:
+    void find(VExpr* root) { _compute_key(root); }
+    VExpr* rewrite(ObjectPool* pool, VExpr* expr);
+
+private:
+    // Computes the keys of the subtrees under the expr, and returns false if the subtree of the
+    // expr has no key, e.g. it calls a udf or a nondeterministic function.
+    bool _compute_key(VExpr* expr);
+    bool _compute_node_key(VExpr* expr, std::string* key);
+
+    std::unordered_map<VExpr*, std::string> _keys;
+    std::unordered_map<std::string, int> _counts;
+};
+
+bool CommonSubexprFinder::_compute_key(VExpr* expr) {
+    if (auto* common_subexpr = dynamic_cast<VCommonSubexpr*>(expr)) {
+        // wrapped by a former elimination, which is redone
+        VExpr* wrapped = common_subexpr->children()[0];
+        if (!_compute_key(wrapped)) {
+            return false;
+        }
+        _keys[expr] = _keys[wrapped];
+        return true;
+    }
+    bool has_key = true;
+    for (auto child : expr->children()) {
+        has_key &= _compute_key(child);
+    }
+    std::string key;
+    if (!has_key || !_compute_node_key(expr, &key)) {
+        return false;
+    }
+    for (auto child : expr->children()) {
+        key.push_back(',');
+        key.append(_keys[child]);
+    }
+    key.push_back(')');
+    // only the subtrees computing a column are shared
+    if (dynamic_cast<VSlotRef*>(expr) == nullptr && dynamic_cast<VLiteral*>(expr) == nullptr &&
+        !expr->is_constant()) {
+        _counts[key]++;
+    }
+    _keys[expr] = std::move(key);
+    return true;
+}
+
+bool CommonSubexprFinder::_compute_node_key(VExpr* expr, std::string* key) {
+    const std::string& type_name = expr->data_type()->get_name();
+    if (auto* slot_ref = dynamic_cast<VSlotRef*>(expr)) {
+        *key = fmt::format("slot({}", slot_ref->slot_id());
+    } else if (typeid(*expr) == typeid(VLiteral)) {
+        StringRef value = static_cast<VLiteral*>(expr)->column()->get_data_at(0);
+        if (value.data == nullptr) {
+            *key = fmt::format("literal({},null", type_name);
+        } else {
+            *key = fmt::format("literal({},{}:", type_name, value.size);
+            key->append(value.data, value.size);
+        }
+    } else if (auto* fn_call = dynamic_cast<VectorizedFnCall*>(expr)) {
+        const TFunction& fn = expr->fn();
+        if (!fn_call->is_deterministic()) {
+            return false;
+        }
+        *key = fmt::format("fn({},{},{}", static_cast<int>(expr->node_type()),
+                           fn.name.function_name, type_name);
+    } else if (dynamic_cast<VCastExpr*>(expr) != nullptr) {
+        *key = fmt::format("cast({}", type_name);
+    } else if (auto* case_expr = dynamic_cast<VCaseExpr*>(expr)) {
+        *key = fmt::format("case({},{},{}", case_expr->has_case_expr(),
+                           case_expr->has_else_expr(), type_name);
+    } else if (auto* in_predicate = dynamic_cast<VInPredicate*>(expr)) {
+        *key = fmt::format("in({},{}", in_predicate->is_not_in(), type_name);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+VExpr* CommonSubexprFinder::rewrite(ObjectPool* pool, VExpr* expr) {
+    if (auto* common_subexpr = dynamic_cast<VCommonSubexpr*>(expr)) {
+        return rewrite(pool, common_subexpr->children()[0]);
+    }
+    std::vector<VExpr*> children = expr->children();
+    for (auto& child : children) {
+        child = rewrite(pool, child);
+    }
+    expr->set_children(std::move(children));
+    auto it = _keys.find(expr);
+    if (it == _keys.end()) {
+        return expr;
+    }
+    auto count = _counts.find(it->second);
+    if (count == _counts.end() || count->second < 2) {
+        return expr;
+    }
+    return pool->add(new VCommonSubexpr(expr, it->second));
+}
+
+} // namespace
+
+void VCommonSubexpr::eliminate(ObjectPool* pool, const std::vector<VExprContext*>& ctxs) {
+    CommonSubexprFinder finder;
+    for (auto ctx : ctxs) {
+        if (ctx != nullptr) {
+            finder.find(ctx->root());
+        }
+    }
+    for (auto ctx : ctxs) {
+        if (ctx != nullptr) {
+            ctx->set_root(finder.rewrite(pool, ctx->root()));
+        }
+    }
+}
+
+VCommonSubexpr::VCommonSubexpr(VExpr* expr, std::string key) : VExpr(*expr), _key(std::move(key)) {
+    // not taken as the wrapped expr by the exprs inspecting the tree
+    _node_type = TExprNodeType::FUNCTION_CALL;
+    _fn = TFunction();
+    _fn_context_index = -1;
+    _children = {expr};
+}
+
+Status VCommonSubexpr::execute(VExprContext* context, Block* block, int* result_column_id) {
+    auto& columns = context->common_subexpr_columns();
+    auto it = columns.find(_key);
+    if (it != columns.end()) {
+        *result_column_id = it->second;
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_children[0]->execute(context, block, result_column_id));
+    columns.emplace(_key, *result_column_id);
+    return Status::OK();
+}
+
+std::string VCommonSubexpr::debug_string() const {
+    std::stringstream out;
+    out << "CommonSubexpr{" << _children[0]->debug_string() << "}";
+    return out.str();
+}
+
+} // namespace doris::vectorized
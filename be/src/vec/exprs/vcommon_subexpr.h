@@ -0,0 +1,52 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "vec/exprs/vexpr.h"
+
+namespace doris::vectorized {
+
+// A subtree that occurs more than once in an expr tree, or in the exprs executed on the same
+// block one after another, e.g. the output exprs of a sink. The occurrences are identified by
+// the structure of the subtree, and the column computed by the first occurrence executed on a
+// block is reused by the others. See VExprContext::execute.
+class VCommonSubexpr final : public VExpr {
+public:
+    // Wraps the subtrees that occur more than once in the exprs. It's called after the exprs are
+    // prepared, and can be called again with more exprs.
+    static void eliminate(ObjectPool* pool, const std::vector<VExprContext*>& ctxs);
+
+    VCommonSubexpr(VExpr* expr, std::string key);
+    ~VCommonSubexpr() override = default;
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new VCommonSubexpr(*this)); }
+    const std::string& expr_name() const override { return _children[0]->expr_name(); }
+    std::string debug_string() const override;
+
+    // the structure of the subtree
+    const std::string& key() const { return _key; }
+
+private:
+    std::string _key;
+};
+
+} // namespace doris::vectorized
@@ -16,7 +16,11 @@
 // under the License.
 
 #pragma once
+#include "common/config.h"
 #include "runtime/runtime_state.h"
+#include "util/simd/bits.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
 #include "vec/exprs/vectorized_fn_call.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/functions/function.h"
@@ -39,6 +43,61 @@ public:
         }
     }
 
+    VExpr* clone(doris::ObjectPool* pool) const override {
+        return pool->add(new VcompoundPred(*this));
+    }
+
+    // The right side of an AND is only executed on the rows whose left side is true or null, and
+    // the right side of an OR on the rows whose left side is false or null. The other rows of the
+    // right side are defaults, which don't change their results.
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        if (!config::enable_short_circuit_evaluation || _children.size() != 2) {
+            return VectorizedFnCall::execute(context, block, result_column_id);
+        }
+        const bool is_and = _fn.name.function_name == "and";
+        int left_id = -1;
+        RETURN_IF_ERROR(_children[0]->execute(context, block, &left_id));
+        auto left = block->get_by_position(left_id).column->convert_to_full_column_if_const();
+        const NullMap* null_map = nullptr;
+        const IColumn* nested = left.get();
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*left)) {
+            null_map = &nullable->get_null_map_data();
+            nested = &nullable->get_nested_column();
+        }
+        const auto* left_data = check_and_get_column<ColumnUInt8>(*nested);
+
+        const size_t rows = left->size();
+        IColumn::Filter filter(rows, 1);
+        size_t count = rows;
+        if (left_data != nullptr) {
+            const auto& data = left_data->get_data();
+            for (size_t i = 0; i < rows; ++i) {
+                filter[i] = (data[i] != 0) == is_and;
+            }
+            if (null_map != nullptr) {
+                for (size_t i = 0; i < rows; ++i) {
+                    filter[i] |= (*null_map)[i];
+                }
+            }
+            count = rows -
+                    simd::count_zero_num(reinterpret_cast<const int8_t*>(filter.data()), rows);
+        }
+        ColumnPtr right;
+        RETURN_IF_ERROR(_children[1]->execute_on_selected_rows(context, block, filter, count,
+                                                               &right));
+
+        size_t right_id = block->columns();
+        block->insert({std::move(right), _children[1]->data_type(), _children[1]->expr_name()});
+        // call function
+        size_t num_columns_without_result = block->columns();
+        block->insert({nullptr, _data_type, expr_name()});
+        RETURN_IF_ERROR(_function->execute(context->fn_context(_fn_context_index), *block,
+                                           {static_cast<size_t>(left_id), right_id},
+                                           num_columns_without_result, block->rows(), false));
+        *result_column_id = num_columns_without_result;
+        return Status::OK();
+    }
+
     std::string debug_string() const override {
         std::stringstream out;
         out << "CompoundPredicate {" << _fn.name.function_name;
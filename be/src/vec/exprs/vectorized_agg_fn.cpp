@@ -20,6 +20,7 @@
 #include "fmt/format.h"
 #include "fmt/ranges.h"
 #include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
 #include "vec/aggregate_functions/aggregate_function_java_udaf.h"
 #include "vec/aggregate_functions/aggregate_function_rpc.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
@@ -94,8 +95,15 @@ Status AggFnEvaluator::prepare(RuntimeState* state, const RowDescriptor& desc, M
     } else if (_fn.binary_type == TFunctionBinaryType::RPC) {
         _function = AggregateRpcUdaf::create(_fn, _argument_types, {}, _data_type);
     } else {
+        Array parameters;
+        // the sketch percentile_approx keeps its values in is chosen by the query
+        if (_fn.name.function_name == "percentile_approx" && state != nullptr &&
+            state->query_options().__isset.percentile_approx_sketch) {
+            const auto& sketch = state->query_options().percentile_approx_sketch;
+            parameters.emplace_back(sketch.data(), sketch.size());
+        }
         _function = AggregateFunctionSimpleFactory::instance().get(
-                _fn.name.function_name, _argument_types, {}, _data_type->is_nullable());
+                _fn.name.function_name, _argument_types, parameters, _data_type->is_nullable());
     }
     if (_function == nullptr) {
         return Status::InternalError("Agg Function {} is not implemented", _fn.name.function_name);
@@ -132,6 +140,16 @@ void AggFnEvaluator::execute_batch_add(Block* block, size_t offset, AggregateDat
     _function->add_batch(block->rows(), places, offset, _agg_columns.data(), arena);
 }
 
+void AggFnEvaluator::execute_batch_add_grouped(Block* block, size_t offset,
+                                               const UInt32* group_ids, size_t num_groups,
+                                               const AggregateDataPtr* group_places,
+                                               Arena* arena) {
+    _calc_argment_columns(block);
+    SCOPED_TIMER(_exec_timer);
+    _function->add_batch_grouped(block->rows(), group_ids, num_groups, group_places, offset,
+                                 _agg_columns.data(), arena);
+}
+
 void AggFnEvaluator::insert_result_info(AggregateDataPtr place, IColumn* column) {
     _function->insert_result_into(place, *column);
 }
@@ -56,6 +56,11 @@ public:
     void execute_batch_add(Block* block, size_t offset, AggregateDataPtr* places,
                            Arena* arena = nullptr);
 
+    // adds block to the groups of dense ids, see IAggregateFunction::add_batch_grouped
+    void execute_batch_add_grouped(Block* block, size_t offset, const UInt32* group_ids,
+                                   size_t num_groups, const AggregateDataPtr* group_places,
+                                   Arena* arena = nullptr);
+
     void insert_result_info(AggregateDataPtr place, IColumn* column);
 
     void insert_result_info_vec(const std::vector<AggregateDataPtr>& place, size_t offset,
@@ -69,6 +74,7 @@ public:
     static std::string debug_string(const std::vector<AggFnEvaluator*>& exprs);
     std::string debug_string() const;
     bool is_merge() const { return _is_merge; }
+    bool is_builtin() const { return _fn.binary_type == TFunctionBinaryType::BUILTIN; }
     const std::vector<VExprContext*>& input_exprs_ctxs() const { return _input_exprs_ctxs; }
 
 private:
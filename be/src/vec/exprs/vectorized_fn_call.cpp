@@ -18,6 +18,7 @@
 #include "vec/exprs/vectorized_fn_call.h"
 
 #include <string_view>
+#include <unordered_set>
 
 #include "exprs/anyval_util.h"
 #include "exprs/rpc_fn.h"
@@ -102,6 +103,13 @@ const std::string& VectorizedFnCall::expr_name() const {
     return _expr_name;
 }
 
+bool VectorizedFnCall::is_deterministic() const {
+    static const std::unordered_set<std::string> nondeterministic_functions = {"random", "rand",
+                                                                               "uuid", "sleep"};
+    return _fn.binary_type == TFunctionBinaryType::BUILTIN &&
+           nondeterministic_functions.count(_fn.name.function_name) == 0;
+}
+
 std::string VectorizedFnCall::debug_string() const {
     std::stringstream out;
     out << "VectorizedFn[";
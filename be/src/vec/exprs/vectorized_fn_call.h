@@ -39,7 +39,11 @@ public:
     virtual std::string debug_string() const override;
     static std::string debug_string(const std::vector<VectorizedFnCall*>& exprs);
 
-private:
+    // Whether the function is a builtin whose result is the same for the same arguments, unlike
+    // random() or the udfs.
+    bool is_deterministic() const;
+
+protected:
     FunctionBasePtr _function;
     std::string _expr_name;
 };
@@ -22,12 +22,14 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "exprs/anyval_util.h"
 #include "gen_cpp/Exprs_types.h"
 #include "vec/data_types/data_type_factory.hpp"
 #include "vec/exprs/varray_literal.h"
 #include "vec/exprs/vcase_expr.h"
 #include "vec/exprs/vcast_expr.h"
+#include "vec/exprs/vcommon_subexpr.h"
 #include "vec/exprs/vcompound_pred.h"
 #include "vec/exprs/vectorized_fn_call.h"
 #include "vec/exprs/vin_predicate.h"
@@ -228,6 +230,9 @@ Status VExpr::prepare(const std::vector<VExprContext*>& ctxs, RuntimeState* stat
     for (int i = 0; i < ctxs.size(); ++i) {
         RETURN_IF_ERROR(ctxs[i]->prepare(state, row_desc));
     }
+    if (config::enable_common_subexpr_elimination) {
+        VCommonSubexpr::eliminate(state->obj_pool(), ctxs);
+    }
     return Status::OK();
 }
 
@@ -323,6 +328,68 @@ ColumnPtrWrapper* VExpr::get_const_col(VExprContext* context) {
     return _constant_col.get();
 }
 
+void VExpr::collect_column_ids(std::set<int>* column_ids) const {
+    for (const VExpr* child : _children) {
+        child->collect_column_ids(column_ids);
+    }
+}
+
+Status VExpr::execute_on_selected_rows(VExprContext* context, Block* block,
+                                       const IColumn::Filter& filter, size_t count,
+                                       ColumnPtr* result) {
+    const size_t rows = block->rows();
+    if (count == rows) {
+        int column_id = -1;
+        RETURN_IF_ERROR(execute(context, block, &column_id));
+        *result = block->get_by_position(column_id).column->convert_to_full_column_if_const();
+        return Status::OK();
+    }
+    if (count == 0) {
+        auto column = _data_type->create_column();
+        column->insert_many_defaults(rows);
+        *result = std::move(column);
+        return Status::OK();
+    }
+
+    // The other columns are left empty, but the first one is kept to give the selected block its
+    // number of rows.
+    std::set<int> column_ids;
+    collect_column_ids(&column_ids);
+    Block selected_block;
+    bool has_rows = false;
+    for (size_t i = 0; i < block->columns(); ++i) {
+        const auto& elem = block->get_by_position(i);
+        ColumnPtr column;
+        if (elem.column != nullptr && (!has_rows || column_ids.count(i) > 0)) {
+            column = elem.column->filter(filter, count);
+            has_rows = true;
+        }
+        selected_block.insert({std::move(column), elem.type, elem.name});
+    }
+
+    // the columns of the common subexprs computed on the block aren't in the selected block
+    auto common_subexpr_columns = std::move(context->common_subexpr_columns());
+    context->common_subexpr_columns().clear();
+    int column_id = -1;
+    Status st = execute(context, &selected_block, &column_id);
+    context->common_subexpr_columns() = std::move(common_subexpr_columns);
+    RETURN_IF_ERROR(st);
+
+    auto selected =
+            selected_block.get_by_position(column_id).column->convert_to_full_column_if_const();
+    auto column = selected->clone_empty();
+    column->reserve(rows);
+    for (size_t i = 0, j = 0; i < rows; ++i) {
+        if (filter[i]) {
+            column->insert_from(*selected, j++);
+        } else {
+            column->insert_default();
+        }
+    }
+    *result = std::move(column);
+    return Status::OK();
+}
+
 void VExpr::register_function_context(doris::RuntimeState* state, VExprContext* context) {
     FunctionContext::TypeDesc return_type = AnyValUtil::column_type_to_type_desc(_type);
     std::vector<FunctionContext::TypeDesc> arg_types;
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "common/status.h"
@@ -137,6 +138,19 @@ public:
     /// expr.
     virtual ColumnPtrWrapper* get_const_col(VExprContext* context);
 
+    /// Adds the positions of the columns of the block read by this expr and its children. The
+    /// exprs that take a column of the block by its position, like the slot refs, must add it.
+    virtual void collect_column_ids(std::set<int>* column_ids) const;
+
+    /// Executes this expr only on the rows of the block selected by the filter, count of them,
+    /// and sets *result to a column of all the rows of the block, with the default values on the
+    /// rows that aren't selected. The columns of the block used by the expr are filtered into a
+    /// block of the selected rows, which the expr is executed on. It's used to skip the rows
+    /// whose result is already decided, e.g. by the left side of an AND.
+    Status execute_on_selected_rows(VExprContext* context, Block* block,
+                                    const IColumn::Filter& filter, size_t count,
+                                    ColumnPtr* result);
+
 protected:
     /// Simple debug string that provides no expr subclass-specific information
     std::string debug_string(const std::string& expr_name) const {
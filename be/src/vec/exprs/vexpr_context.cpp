@@ -17,9 +17,14 @@
 
 #include "vec/exprs/vexpr_context.h"
 
+#include "common/config.h"
 #include "runtime/thread_context.h"
 #include "udf/udf_internal.h"
+#include "vec/exprs/vcommon_subexpr.h"
 #include "vec/exprs/vexpr.h"
+#include "vec/exprs/vfolded_constant.h"
+#include "vec/exprs/vfused_expr.h"
+#include "vec/exprs/vmulti_match_pred.h"
 
 namespace doris::vectorized {
 VExprContext::VExprContext(VExpr* expr)
@@ -39,6 +44,9 @@ VExprContext::~VExprContext() {
 }
 
 doris::Status VExprContext::execute(doris::vectorized::Block* block, int* result_column_id) {
+    if (_shared_common_subexpr_columns == nullptr) {
+        _common_subexpr_columns.clear();
+    }
     Status st = _root->execute(this, block, result_column_id);
     _last_result_column_id = *result_column_id;
     return st;
@@ -48,7 +56,11 @@ doris::Status VExprContext::prepare(doris::RuntimeState* state,
                                     const doris::RowDescriptor& row_desc) {
     _prepared = true;
     _pool.reset(new MemPool());
-    return _root->prepare(state, row_desc, this);
+    RETURN_IF_ERROR(_root->prepare(state, row_desc, this));
+    if (config::enable_common_subexpr_elimination) {
+        VCommonSubexpr::eliminate(state->obj_pool(), {this});
+    }
+    return Status::OK();
 }
 
 doris::Status VExprContext::open(doris::RuntimeState* state) {
@@ -57,11 +69,23 @@ doris::Status VExprContext::open(doris::RuntimeState* state) {
         return Status::OK();
     }
     _opened = true;
+    if (!_is_clone && config::enable_multi_pattern_match) {
+        _root = VMultiMatchPred::rewrite(state->obj_pool(), _root);
+    }
+    // fused after the common subexprs of all the exprs prepared together are eliminated
+    if (!_is_clone && config::enable_vexpr_fusion) {
+        _root = VFusedExpr::fuse(state->obj_pool(), _root);
+    }
     // Fragment-local state is only initialized for original contexts. Clones inherit the
     // original's fragment state and only need to have thread-local state initialized.
     FunctionContext::FunctionStateScope scope =
             _is_clone ? FunctionContext::THREAD_LOCAL : FunctionContext::FRAGMENT_LOCAL;
-    return _root->open(state, this, scope);
+    RETURN_IF_ERROR(_root->open(state, this, scope));
+    // folded after opened, with the states of the functions to evaluate the constants
+    if (!_is_clone && config::enable_vexpr_constant_folding) {
+        RETURN_IF_ERROR(VFoldedConstant::fold(state->obj_pool(), this, &_root));
+    }
+    return Status::OK();
 }
 
 void VExprContext::close(doris::RuntimeState* state) {
@@ -131,9 +155,13 @@ Block VExprContext::get_output_block_after_execute_exprs(
         Status& status) {
     vectorized::Block tmp_block(input_block.get_columns_with_type_and_name());
     vectorized::ColumnsWithTypeAndName result_columns;
+    // the common subexprs of the output exprs are computed once for the block
+    std::unordered_map<std::string, int> common_subexpr_columns;
     for (auto vexpr_ctx : output_vexpr_ctxs) {
         int result_column_id = -1;
+        vexpr_ctx->_shared_common_subexpr_columns = &common_subexpr_columns;
         status = vexpr_ctx->execute(&tmp_block, &result_column_id);
+        vexpr_ctx->_shared_common_subexpr_columns = nullptr;
         if (UNLIKELY(!status)) {
             return {};
         }
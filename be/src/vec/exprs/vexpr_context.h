@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include "common/status.h"
 #include "runtime/runtime_state.h"
 #include "vec/core/block.h"
@@ -65,6 +68,13 @@ public:
         return _last_result_column_id;
     }
 
+    /// The columns of the common subexprs computed on the block being executed, by the keys of
+    /// the subexprs. See VCommonSubexpr.
+    std::unordered_map<std::string, int>& common_subexpr_columns() {
+        return _shared_common_subexpr_columns != nullptr ? *_shared_common_subexpr_columns
+                                                         : _common_subexpr_columns;
+    }
+
     FunctionContext::FunctionStateScope get_function_state_scope() const {
         return _is_clone ? FunctionContext::THREAD_LOCAL : FunctionContext::FRAGMENT_LOCAL;
     }
@@ -91,5 +101,10 @@ private:
     std::unique_ptr<MemPool> _pool;
 
     int _last_result_column_id;
+
+    /// Cleared by each execution, unless the columns are shared with the other exprs executed
+    /// on the same block.
+    std::unordered_map<std::string, int> _common_subexpr_columns;
+    std::unordered_map<std::string, int>* _shared_common_subexpr_columns = nullptr;
 };
 } // namespace doris::vectorized
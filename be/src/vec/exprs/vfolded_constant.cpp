@@ -0,0 +1,144 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vfolded_constant.h"
+
+#include "vec/columns/column_const.h"
+#include "vec/exprs/vcase_expr.h"
+#include "vec/exprs/vcast_expr.h"
+#include "vec/exprs/vcompound_pred.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vin_predicate.h"
+#include "vec/exprs/vliteral.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+const ColumnPtr* constant_column(const VExpr* expr) {
+    if (const auto* folded = dynamic_cast<const VFoldedConstant*>(expr)) {
+        return &folded->column();
+    } else if (const auto* literal = dynamic_cast<const VLiteral*>(expr)) {
+        return &literal->column();
+    }
+    return nullptr;
+}
+
+// Whether the subtree is computed from the constants only, by the exprs whose results are the
+// same on each evaluation.
+bool is_foldable(VExpr* expr) {
+    if (constant_column(expr) != nullptr) {
+        return true;
+    }
+    if (auto* fn_call = dynamic_cast<VectorizedFnCall*>(expr)) {
+        if (!fn_call->is_deterministic()) {
+            return false;
+        }
+    } else if (dynamic_cast<VCastExpr*>(expr) == nullptr &&
+               dynamic_cast<VCaseExpr*>(expr) == nullptr &&
+               dynamic_cast<VInPredicate*>(expr) == nullptr) {
+        return false;
+    }
+    for (auto child : expr->children()) {
+        if (!is_foldable(child)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+Status VFoldedConstant::fold(ObjectPool* pool, VExprContext* context, VExpr** root) {
+    VExpr* expr = *root;
+    if (constant_column(expr) != nullptr) {
+        return Status::OK();
+    }
+    if (is_foldable(expr)) {
+        Block block;
+        int result = -1;
+        // if it fails, e.g. on an invalid cast, it fails as before when executed on the blocks
+        if (expr->execute(context, &block, &result).ok() && result != -1 &&
+            block.get_by_position(result).column->size() == 1) {
+            const ColumnPtr& column = block.get_by_position(result).column;
+            *root = pool->add(new VFoldedConstant(
+                    expr, ColumnConst::create(column->convert_to_full_column_if_const(), 1)));
+            return Status::OK();
+        }
+    }
+
+    std::vector<VExpr*> children = expr->children();
+    for (auto& child : children) {
+        RETURN_IF_ERROR(fold(pool, context, &child));
+    }
+    expr->set_children(children);
+
+    // false for an and, or true for an or, whatever the other child is
+    if (dynamic_cast<VcompoundPred*>(expr) != nullptr && expr->children().size() == 2 &&
+        (expr->fn().name.function_name == "and" || expr->fn().name.function_name == "or")) {
+        bool absorbing = expr->fn().name.function_name == "or";
+        for (auto child : children) {
+            const ColumnPtr* column = constant_column(child);
+            if (column != nullptr && !(*column)->is_null_at(0) &&
+                (*column)->get_bool(0) == absorbing) {
+                *root = pool->add(new VFoldedConstant(
+                        expr, expr->data_type()->create_column_const(1, Field(UInt64(absorbing)))));
+                break;
+            }
+        }
+    }
+    return Status::OK();
+}
+
+bool VFoldedConstant::is_always_false(const VExpr* expr) {
+    const ColumnPtr* column = constant_column(expr);
+    return column != nullptr && ((*column)->is_null_at(0) || !(*column)->get_bool(0));
+}
+
+VFoldedConstant::VFoldedConstant(VExpr* expr, ColumnPtr column)
+        : VExpr(*expr), _expr(expr), _column(std::move(column)) {
+    // not taken as the folded expr by the exprs inspecting the tree
+    _node_type = TExprNodeType::FUNCTION_CALL;
+    _fn = TFunction();
+    _fn_context_index = -1;
+    _children.clear();
+}
+
+Status VFoldedConstant::open(RuntimeState* state, VExprContext* context,
+                             FunctionContext::FunctionStateScope scope) {
+    return _expr->open(state, context, scope);
+}
+
+void VFoldedConstant::close(RuntimeState* state, VExprContext* context,
+                            FunctionContext::FunctionStateScope scope) {
+    _expr->close(state, context, scope);
+}
+
+Status VFoldedConstant::execute(VExprContext* context, Block* block, int* result_column_id) {
+    // a constant returns at least one row like a literal
+    size_t row_size = std::max(block->rows(), size_t(1));
+    *result_column_id = insert_param(block, {_column, _data_type, expr_name()}, row_size);
+    return Status::OK();
+}
+
+std::string VFoldedConstant::debug_string() const {
+    std::stringstream out;
+    out << "FoldedConstant{" << _expr->debug_string() << "}";
+    return out.str();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+
+#include "vec/exprs/vexpr.h"
+
+namespace doris::vectorized {
+
+// A constant subtree of an expr evaluated once when the expr is opened, e.g.
+// date_sub(now(), interval 7 day), instead of on each block. An and with a false child and an or
+// with a true child are constants too.
+class VFoldedConstant final : public VExpr {
+public:
+    // Replaces the constant subtrees of the opened tree of the context with their values.
+    static Status fold(ObjectPool* pool, VExprContext* context, VExpr** root);
+
+    // Whether the expr is a constant false or null, where a conjunct filters out all the rows.
+    static bool is_always_false(const VExpr* expr);
+
+    VFoldedConstant(VExpr* expr, ColumnPtr column);
+    ~VFoldedConstant() override = default;
+
+    // The folded subtree is opened and closed with the context, for the states it holds.
+    Status open(RuntimeState* state, VExprContext* context,
+                FunctionContext::FunctionStateScope scope) override;
+    void close(RuntimeState* state, VExprContext* context,
+               FunctionContext::FunctionStateScope scope) override;
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new VFoldedConstant(*this)); }
+    const std::string& expr_name() const override { return _expr->expr_name(); }
+    std::string debug_string() const override;
+
+    // the const column of the value
+    const ColumnPtr& column() const { return _column; }
+
+private:
+    VExpr* _expr;
+    ColumnPtr _column;
+};
+
+} // namespace doris::vectorized
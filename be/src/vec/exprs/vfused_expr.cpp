@@ -0,0 +1,705 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vfused_expr.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/exprs/vcase_expr.h"
+#include "vec/exprs/vcast_expr.h"
+#include "vec/exprs/vectorized_fn_call.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// The types of the values in the registers, the integers are widened to Int64 and the floats
+// to Float64 when they are loaded, as the arithmetic functions do.
+enum class ValueType : uint8_t { INT64, FLOAT64, BOOL };
+
+enum class OpCode : uint8_t {
+    LOAD,
+    TO_FLOAT64,
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+    AND,
+    OR,
+    NOT,
+    CASE,
+};
+
+// The registers of a program take MAX_OPS * CHUNK_ROWS * 8 bytes of the stack.
+constexpr size_t CHUNK_ROWS = 256;
+constexpr size_t MAX_OPS = 16;
+constexpr size_t MAX_CACHED_PROGRAMS = 4096;
+
+struct ChunkState {
+    // the values of the ops for the rows of the chunk
+    uint8_t* regs[MAX_OPS];
+    // the data of the input columns
+    const uint8_t* inputs[MAX_OPS];
+    bool input_is_const[MAX_OPS];
+    size_t offset;
+    size_t rows;
+};
+
+struct FusedOp;
+using Kernel = void (*)(const FusedOp& op, ChunkState* state);
+
+struct FusedOp {
+    OpCode code;
+    ValueType type;
+    // the type of the arguments, which is different from the type of a comparison
+    ValueType arg_type;
+    // the type of the input column of a LOAD
+    TypeIndex input_type = TypeIndex::Nothing;
+    int input = -1;
+    std::vector<int> args;
+    // the register of the value, an op is the only writer of its register
+    int reg = -1;
+    Kernel kernel = nullptr;
+};
+
+bool value_type_of(TypeIndex type, ValueType* value_type) {
+    switch (type) {
+    case TypeIndex::Int8:
+    case TypeIndex::Int16:
+    case TypeIndex::Int32:
+    case TypeIndex::Int64:
+        *value_type = ValueType::INT64;
+        return true;
+    case TypeIndex::Float32:
+    case TypeIndex::Float64:
+        *value_type = ValueType::FLOAT64;
+        return true;
+    case TypeIndex::UInt8:
+        *value_type = ValueType::BOOL;
+        return true;
+    default:
+        return false;
+    }
+}
+
+// the result of an op has the exact type of its register
+bool result_type_of(TypeIndex type, ValueType* value_type) {
+    switch (type) {
+    case TypeIndex::Int64:
+    case TypeIndex::Float64:
+    case TypeIndex::UInt8:
+        return value_type_of(type, value_type);
+    default:
+        return false;
+    }
+}
+
+bool is_logic_op(OpCode code) {
+    return code == OpCode::AND || code == OpCode::OR || code == OpCode::NOT ||
+           code == OpCode::CASE;
+}
+
+template <typename T>
+T* reg(ChunkState* state, int reg) {
+    return reinterpret_cast<T*>(state->regs[reg]);
+}
+
+template <typename Src, typename Dst>
+void load_kernel(const FusedOp& op, ChunkState* state) {
+    const auto* src = reinterpret_cast<const Src*>(state->inputs[op.input]);
+    if (state->input_is_const[op.input]) {
+        std::fill_n(reg<Dst>(state, op.reg), state->rows, static_cast<Dst>(*src));
+    } else if constexpr (std::is_same_v<Src, Dst>) {
+        // the values are read from the column in place
+        state->regs[op.reg] =
+                const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(src + state->offset));
+    } else {
+        src += state->offset;
+        auto* dst = reg<Dst>(state, op.reg);
+        for (size_t i = 0; i < state->rows; ++i) {
+            dst[i] = static_cast<Dst>(src[i]);
+        }
+    }
+}
+
+void to_float64_kernel(const FusedOp& op, ChunkState* state) {
+    const auto* src = reg<Int64>(state, op.args[0]);
+    auto* dst = reg<Float64>(state, op.reg);
+    for (size_t i = 0; i < state->rows; ++i) {
+        dst[i] = static_cast<Float64>(src[i]);
+    }
+}
+
+struct AddOp {
+    template <typename T>
+    static T apply(T a, T b) {
+        return a + b;
+    }
+};
+struct SubtractOp {
+    template <typename T>
+    static T apply(T a, T b) {
+        return a - b;
+    }
+};
+struct MultiplyOp {
+    template <typename T>
+    static T apply(T a, T b) {
+        return a * b;
+    }
+};
+struct EqOp {
+    template <typename T>
+    static UInt8 apply(T a, T b) {
+        return a == b;
+    }
+};
+struct NeOp {
+    template <typename T>
+    static UInt8 apply(T a, T b) {
+        return a != b;
+    }
+};
+struct LtOp {
+    template <typename T>
+    static UInt8 apply(T a, T b) {
+        return a < b;
+    }
+};
+struct LeOp {
+    template <typename T>
+    static UInt8 apply(T a, T b) {
+        return a <= b;
+    }
+};
+struct GtOp {
+    template <typename T>
+    static UInt8 apply(T a, T b) {
+        return a > b;
+    }
+};
+struct GeOp {
+    template <typename T>
+    static UInt8 apply(T a, T b) {
+        return a >= b;
+    }
+};
+struct AndOp {
+    static UInt8 apply(UInt8 a, UInt8 b) { return a & b; }
+};
+struct OrOp {
+    static UInt8 apply(UInt8 a, UInt8 b) { return a | b; }
+};
+
+template <typename T, typename Op>
+void binary_kernel(const FusedOp& op, ChunkState* state) {
+    using R = decltype(Op::apply(T(), T()));
+    const auto* a = reg<T>(state, op.args[0]);
+    const auto* b = reg<T>(state, op.args[1]);
+    auto* dst = reg<R>(state, op.reg);
+    for (size_t i = 0; i < state->rows; ++i) {
+        dst[i] = Op::apply(a[i], b[i]);
+    }
+}
+
+void not_kernel(const FusedOp& op, ChunkState* state) {
+    const auto* src = reg<UInt8>(state, op.args[0]);
+    auto* dst = reg<UInt8>(state, op.reg);
+    for (size_t i = 0; i < state->rows; ++i) {
+        dst[i] = !src[i];
+    }
+}
+
+// The args are the pairs of when and then, followed by the else. The whens are applied from
+// the last one, so the first matched when of a row takes effect.
+template <typename T>
+void case_kernel(const FusedOp& op, ChunkState* state) {
+    const auto* else_values = reg<T>(state, op.args.back());
+    auto* dst = reg<T>(state, op.reg);
+    std::copy_n(else_values, state->rows, dst);
+    for (int i = op.args.size() - 3; i >= 0; i -= 2) {
+        const auto* whens = reg<UInt8>(state, op.args[i]);
+        const auto* thens = reg<T>(state, op.args[i + 1]);
+        for (size_t j = 0; j < state->rows; ++j) {
+            dst[j] = whens[j] ? thens[j] : dst[j];
+        }
+    }
+}
+
+template <typename Dst>
+Kernel load_kernel_of(TypeIndex input_type) {
+    switch (input_type) {
+    case TypeIndex::Int8:
+        return &load_kernel<Int8, Dst>;
+    case TypeIndex::Int16:
+        return &load_kernel<Int16, Dst>;
+    case TypeIndex::Int32:
+        return &load_kernel<Int32, Dst>;
+    case TypeIndex::Int64:
+        return &load_kernel<Int64, Dst>;
+    case TypeIndex::Float32:
+        return &load_kernel<Float32, Dst>;
+    case TypeIndex::Float64:
+        return &load_kernel<Float64, Dst>;
+    case TypeIndex::UInt8:
+        return &load_kernel<UInt8, Dst>;
+    default:
+        return nullptr;
+    }
+}
+
+template <typename Op>
+Kernel binary_kernel_of(ValueType arg_type) {
+    return arg_type == ValueType::INT64 ? &binary_kernel<Int64, Op> : &binary_kernel<Float64, Op>;
+}
+
+Kernel resolve_kernel(const FusedOp& op) {
+    switch (op.code) {
+    case OpCode::LOAD:
+        switch (op.type) {
+        case ValueType::INT64:
+            return load_kernel_of<Int64>(op.input_type);
+        case ValueType::FLOAT64:
+            return load_kernel_of<Float64>(op.input_type);
+        case ValueType::BOOL:
+            return load_kernel_of<UInt8>(op.input_type);
+        }
+        return nullptr;
+    case OpCode::TO_FLOAT64:
+        return &to_float64_kernel;
+    case OpCode::ADD:
+        return binary_kernel_of<AddOp>(op.arg_type);
+    case OpCode::SUBTRACT:
+        return binary_kernel_of<SubtractOp>(op.arg_type);
+    case OpCode::MULTIPLY:
+        return binary_kernel_of<MultiplyOp>(op.arg_type);
+    case OpCode::EQ:
+        return binary_kernel_of<EqOp>(op.arg_type);
+    case OpCode::NE:
+        return binary_kernel_of<NeOp>(op.arg_type);
+    case OpCode::LT:
+        return binary_kernel_of<LtOp>(op.arg_type);
+    case OpCode::LE:
+        return binary_kernel_of<LeOp>(op.arg_type);
+    case OpCode::GT:
+        return binary_kernel_of<GtOp>(op.arg_type);
+    case OpCode::GE:
+        return binary_kernel_of<GeOp>(op.arg_type);
+    case OpCode::AND:
+        return &binary_kernel<UInt8, AndOp>;
+    case OpCode::OR:
+        return &binary_kernel<UInt8, OrOp>;
+    case OpCode::NOT:
+        return &not_kernel;
+    case OpCode::CASE:
+        return op.type == ValueType::INT64 ? &case_kernel<Int64> : &case_kernel<Float64>;
+    }
+    return nullptr;
+}
+
+// Translates an expr tree to the ops of a program, in the post order of the tree. The exprs
+// that can't be fused become the inputs of the program.
+class FusedProgramBuilder {
+public:
+    // Returns false if the root can't be fused, or the fusion gains nothing.
+    bool build(VExpr* root);
+
+    std::vector<FusedOp>& ops() { return _ops; }
+    const std::vector<VExpr*>& inputs() const { return _inputs; }
+    std::string fingerprint() const;
+
+private:
+    // Appends the ops computing the expr as an operation of the program. Returns the register
+    // of its value, or -1 if the expr can't be fused.
+    int _visit_op(VExpr* expr, ValueType* type);
+    // Like _visit_op, but the expr is loaded as an input if it can't be fused.
+    int _visit(VExpr* expr, ValueType* type);
+    // Like _visit, and converts the value to the type.
+    int _visit_as(VExpr* expr, ValueType type);
+    int _emit(FusedOp op);
+
+    std::vector<FusedOp> _ops;
+    std::vector<VExpr*> _inputs;
+};
+
+bool FusedProgramBuilder::build(VExpr* root) {
+    ValueType type;
+    if (_visit_op(root, &type) < 0) {
+        return false;
+    }
+    size_t num_compute_ops = 0;
+    bool has_logic_op = false;
+    for (auto& op : _ops) {
+        num_compute_ops += op.code != OpCode::LOAD;
+        has_logic_op |= is_logic_op(op.code);
+    }
+    if (num_compute_ops < 2) {
+        return false;
+    }
+    bool has_nullable_input = std::any_of(_inputs.begin(), _inputs.end(), [](VExpr* input) {
+        return input->data_type()->is_nullable();
+    });
+    // a row is null if any of its inputs is null, which only holds for the arithmetic and
+    // the comparisons
+    return !has_nullable_input || (!has_logic_op && root->data_type()->is_nullable());
+}
+
+std::string FusedProgramBuilder::fingerprint() const {
+    fmt::memory_buffer buffer;
+    for (auto& op : _ops) {
+        fmt::format_to(buffer, "{}:{}:{}:{}:{}(", static_cast<int>(op.code),
+                       static_cast<int>(op.type), static_cast<int>(op.arg_type),
+                       static_cast<int>(op.input_type), op.input);
+        for (int arg : op.args) {
+            fmt::format_to(buffer, "{},", arg);
+        }
+        fmt::format_to(buffer, ");");
+    }
+    return fmt::to_string(buffer);
+}
+
+int FusedProgramBuilder::_visit_op(VExpr* expr, ValueType* type) {
+    ValueType result_type;
+    if (!result_type_of(remove_nullable(expr->data_type())->get_type_id(), &result_type)) {
+        return -1;
+    }
+    const auto& children = expr->children();
+    FusedOp op;
+    op.type = result_type;
+    op.arg_type = result_type;
+
+    if (dynamic_cast<VCastExpr*>(expr) != nullptr) {
+        // a cast to bigint or double widens the value, which is done by the loads
+        if (result_type == ValueType::BOOL || children.size() != 1) {
+            return -1;
+        }
+        *type = result_type;
+        return _visit_as(children[0], result_type);
+    }
+
+    if (auto* case_expr = dynamic_cast<VCaseExpr*>(expr)) {
+        if (case_expr->has_case_expr() || !case_expr->has_else_expr() ||
+            result_type == ValueType::BOOL || children.size() % 2 == 0) {
+            return -1;
+        }
+        op.code = OpCode::CASE;
+        for (size_t i = 0; i + 1 < children.size(); i += 2) {
+            int when = _visit_as(children[i], ValueType::BOOL);
+            int then = when < 0 ? -1 : _visit_as(children[i + 1], result_type);
+            if (then < 0) {
+                return -1;
+            }
+            op.args.push_back(when);
+            op.args.push_back(then);
+        }
+        int else_reg = _visit_as(children.back(), result_type);
+        if (else_reg < 0) {
+            return -1;
+        }
+        op.args.push_back(else_reg);
+        *type = result_type;
+        return _emit(std::move(op));
+    }
+
+    if (dynamic_cast<VectorizedFnCall*>(expr) == nullptr) {
+        return -1;
+    }
+    const std::string& fn_name = expr->fn().name.function_name;
+    static const std::unordered_map<std::string, OpCode> arithmetic_ops = {
+            {"add", OpCode::ADD}, {"subtract", OpCode::SUBTRACT}, {"multiply", OpCode::MULTIPLY}};
+    static const std::unordered_map<std::string, OpCode> comparison_ops = {
+            {"eq", OpCode::EQ}, {"ne", OpCode::NE}, {"lt", OpCode::LT},
+            {"le", OpCode::LE}, {"gt", OpCode::GT}, {"ge", OpCode::GE}};
+    static const std::unordered_map<std::string, OpCode> logic_ops = {
+            {"and", OpCode::AND}, {"or", OpCode::OR}, {"not", OpCode::NOT}};
+    const std::unordered_map<std::string, OpCode>* ops = nullptr;
+    switch (expr->node_type()) {
+    case TExprNodeType::ARITHMETIC_EXPR:
+        ops = result_type == ValueType::BOOL ? nullptr : &arithmetic_ops;
+        break;
+    case TExprNodeType::BINARY_PRED:
+        ops = result_type == ValueType::BOOL ? &comparison_ops : nullptr;
+        break;
+    case TExprNodeType::COMPOUND_PRED:
+        ops = result_type == ValueType::BOOL ? &logic_ops : nullptr;
+        break;
+    default:
+        break;
+    }
+    if (ops == nullptr || ops->count(fn_name) == 0) {
+        return -1;
+    }
+    op.code = ops->at(fn_name);
+    size_t num_args = op.code == OpCode::NOT ? 1 : 2;
+    if (children.size() != num_args) {
+        return -1;
+    }
+
+    if (ops == &comparison_ops) {
+        // both sides must be integers or floats, the comparisons of an integer and a float
+        // are not a plain comparison of doubles
+        ValueType left_type = ValueType::BOOL;
+        ValueType right_type = ValueType::BOOL;
+        int left = _visit(children[0], &left_type);
+        int right = left < 0 ? -1 : _visit(children[1], &right_type);
+        if (right < 0 || left_type != right_type || left_type == ValueType::BOOL) {
+            return -1;
+        }
+        op.arg_type = left_type;
+        op.args = {left, right};
+    } else {
+        for (auto child : children) {
+            int arg = _visit_as(child, op.arg_type);
+            if (arg < 0) {
+                return -1;
+            }
+            op.args.push_back(arg);
+        }
+    }
+    *type = result_type;
+    return _emit(std::move(op));
+}
+
+int FusedProgramBuilder::_visit(VExpr* expr, ValueType* type) {
+    size_t num_ops = _ops.size();
+    size_t num_inputs = _inputs.size();
+    int reg = _visit_op(expr, type);
+    if (reg >= 0) {
+        return reg;
+    }
+    // the expr is executed as an input instead
+    _ops.resize(num_ops);
+    _inputs.resize(num_inputs);
+    if (_inputs.size() == MAX_OPS ||
+        !value_type_of(remove_nullable(expr->data_type())->get_type_id(), type)) {
+        return -1;
+    }
+    FusedOp op;
+    op.code = OpCode::LOAD;
+    op.type = *type;
+    op.arg_type = *type;
+    op.input_type = remove_nullable(expr->data_type())->get_type_id();
+    op.input = _inputs.size();
+    _inputs.push_back(expr);
+    return _emit(std::move(op));
+}
+
+int FusedProgramBuilder::_visit_as(VExpr* expr, ValueType type) {
+    ValueType value_type;
+    int reg = _visit(expr, &value_type);
+    if (reg < 0 || value_type == type) {
+        return reg;
+    }
+    if (value_type != ValueType::INT64 || type != ValueType::FLOAT64) {
+        return -1;
+    }
+    FusedOp op;
+    op.code = OpCode::TO_FLOAT64;
+    op.type = ValueType::FLOAT64;
+    op.arg_type = ValueType::INT64;
+    op.args = {reg};
+    return _emit(std::move(op));
+}
+
+int FusedProgramBuilder::_emit(FusedOp op) {
+    if (_ops.size() == MAX_OPS) {
+        return -1;
+    }
+    op.reg = _ops.size();
+    _ops.push_back(std::move(op));
+    return _ops.back().reg;
+}
+
+} // namespace
+
+struct FusedProgram {
+    std::vector<FusedOp> ops;
+
+    ValueType result_type() const { return ops.back().type; }
+
+    void execute(ChunkState* state, size_t rows, uint8_t* result) const {
+        alignas(64) uint8_t registers[MAX_OPS][CHUNK_ROWS * sizeof(Int64)];
+        const FusedOp& result_op = ops.back();
+        size_t result_width = result_op.type == ValueType::BOOL ? sizeof(UInt8) : sizeof(Int64);
+        for (size_t offset = 0; offset < rows; offset += CHUNK_ROWS) {
+            state->offset = offset;
+            state->rows = std::min(CHUNK_ROWS, rows - offset);
+            for (size_t i = 0; i < ops.size(); ++i) {
+                state->regs[i] = registers[i];
+            }
+            // the last op writes the result column in place
+            state->regs[result_op.reg] = result + offset * result_width;
+            for (const auto& op : ops) {
+                op.kernel(op, state);
+            }
+        }
+    }
+};
+
+namespace {
+
+std::shared_ptr<const FusedProgram> get_program(FusedProgramBuilder* builder) {
+    static std::mutex lock;
+    static std::unordered_map<std::string, std::shared_ptr<const FusedProgram>> programs;
+
+    std::string fingerprint = builder->fingerprint();
+    std::lock_guard<std::mutex> l(lock);
+    auto it = programs.find(fingerprint);
+    if (it != programs.end()) {
+        return it->second;
+    }
+    auto program = std::make_shared<FusedProgram>();
+    program->ops = std::move(builder->ops());
+    for (auto& op : program->ops) {
+        op.kernel = resolve_kernel(op);
+        DCHECK(op.kernel != nullptr);
+    }
+    if (programs.size() >= MAX_CACHED_PROGRAMS) {
+        programs.clear();
+    }
+    programs.emplace(std::move(fingerprint), program);
+    return program;
+}
+
+template <typename T>
+MutableColumnPtr execute_program(const FusedProgram& program, ChunkState* state, size_t rows) {
+    MutableColumnPtr column = ColumnVector<T>::create(rows);
+    auto* data = assert_cast<ColumnVector<T>&>(*column).get_data().data();
+    program.execute(state, rows, reinterpret_cast<uint8_t*>(data));
+    return column;
+}
+
+} // namespace
+
+VExpr* VFusedExpr::fuse(ObjectPool* pool, VExpr* expr) {
+    // the conjuncts of an and are kept apart, since they are pushed down by the scan nodes
+    if (!expr->is_constant() && !expr->is_and_expr() &&
+        dynamic_cast<VFusedExpr*>(expr) == nullptr) {
+        FusedProgramBuilder builder;
+        if (builder.build(expr)) {
+            std::vector<VExpr*> inputs = builder.inputs();
+            for (auto& input : inputs) {
+                input = fuse(pool, input);
+            }
+            return pool->add(new VFusedExpr(*expr, std::move(inputs), get_program(&builder)));
+        }
+    }
+    std::vector<VExpr*> children = expr->children();
+    for (auto& child : children) {
+        child = fuse(pool, child);
+    }
+    expr->set_children(std::move(children));
+    return expr;
+}
+
+VFusedExpr::VFusedExpr(const VExpr& root, std::vector<VExpr*> inputs,
+                       std::shared_ptr<const FusedProgram> program)
+        : VExpr(root),
+          _program(std::move(program)),
+          _expr_name(fmt::format("fused({})", root.expr_name())) {
+    // not taken as the function of the root by the exprs inspecting the tree, e.g. the
+    // pushdown of the predicates
+    _node_type = TExprNodeType::FUNCTION_CALL;
+    _fn = TFunction();
+    _fn_context_index = -1;
+    _children = std::move(inputs);
+}
+
+Status VFusedExpr::execute(VExprContext* context, Block* block, int* result_column_id) {
+    ChunkState state;
+    ColumnUInt8::MutablePtr null_map;
+    size_t rows = block->rows();
+    if (_data_type->is_nullable()) {
+        null_map = ColumnUInt8::create(rows, 0);
+    }
+    for (size_t i = 0; i < _children.size(); ++i) {
+        int column_id = -1;
+        RETURN_IF_ERROR(_children[i]->execute(context, block, &column_id));
+        const IColumn* column = block->get_by_position(column_id).column.get();
+        bool is_const = is_column_const(*column);
+        if (is_const) {
+            column = &assert_cast<const ColumnConst*>(column)->get_data_column();
+        }
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(column)) {
+            DCHECK(null_map != nullptr);
+            const auto& nulls = nullable->get_null_map_data();
+            auto& result_nulls = null_map->get_data();
+            if (!is_const) {
+                for (size_t j = 0; j < rows; ++j) {
+                    result_nulls[j] |= nulls[j];
+                }
+            } else if (nulls[0]) {
+                std::fill(result_nulls.begin(), result_nulls.end(), 1);
+            }
+            column = &nullable->get_nested_column();
+        }
+        state.inputs[i] = reinterpret_cast<const uint8_t*>(column->get_raw_data().data);
+        state.input_is_const[i] = is_const;
+    }
+
+    MutableColumnPtr result;
+    switch (_program->result_type()) {
+    case ValueType::INT64:
+        result = execute_program<Int64>(*_program, &state, rows);
+        break;
+    case ValueType::FLOAT64:
+        result = execute_program<Float64>(*_program, &state, rows);
+        break;
+    case ValueType::BOOL:
+        result = execute_program<UInt8>(*_program, &state, rows);
+        break;
+    }
+    if (null_map != nullptr) {
+        result = ColumnNullable::create(std::move(result), std::move(null_map));
+    }
+    block->insert({std::move(result), _data_type, _expr_name});
+    *result_column_id = block->columns() - 1;
+    return Status::OK();
+}
+
+std::string VFusedExpr::debug_string() const {
+    std::stringstream out;
+    out << "FusedExpr[" << _expr_name << "]{";
+    bool first = true;
+    for (VExpr* input_expr : children()) {
+        if (first) {
+            first = false;
+        } else {
+            out << ",";
+        }
+        out << input_expr->debug_string();
+    }
+    out << "}";
+    return out.str();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,56 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vec/exprs/vexpr.h"
+
+namespace doris::vectorized {
+
+struct FusedProgram;
+
+// Evaluates a subtree of element-wise numeric exprs, i.e. arithmetic, comparisons, compound
+// predicates, numeric casts and case exprs, as one program over chunks of rows that stay in the
+// cpu cache, so no temporary column is materialized for the inner nodes of the subtree. The
+// children of a fused expr are the inputs of the program, the exprs under the subtree that can't
+// be fused, which are executed as usual. The programs are cached by the fingerprint of their
+// operations, and shared by the exprs of all the queries with the same subtree.
+class VFusedExpr final : public VExpr {
+public:
+    // Replaces the subtrees of the tree that can be fused by fused exprs, and returns the new
+    // root of the tree. It's called after the tree is prepared.
+    static VExpr* fuse(ObjectPool* pool, VExpr* expr);
+
+    VFusedExpr(const VExpr& root, std::vector<VExpr*> inputs,
+               std::shared_ptr<const FusedProgram> program);
+    ~VFusedExpr() override = default;
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new VFusedExpr(*this)); }
+    const std::string& expr_name() const override { return _expr_name; }
+    std::string debug_string() const override;
+
+private:
+    std::shared_ptr<const FusedProgram> _program;
+    std::string _expr_name;
+};
+
+} // namespace doris::vectorized
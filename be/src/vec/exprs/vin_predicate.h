@@ -41,6 +41,8 @@ public:
 
     virtual std::string debug_string() const override;
 
+    bool is_not_in() const { return _is_not_in; }
+
 private:
     FunctionBasePtr _function;
     std::string _expr_name;
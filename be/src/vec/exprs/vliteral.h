@@ -43,6 +43,9 @@ public:
 
     virtual std::string debug_string() const override;
 
+    // the const column of the value
+    const ColumnPtr& column() const { return _column_ptr; }
+
 protected:
     ColumnPtr _column_ptr;
     std::string _expr_name;
@@ -0,0 +1,306 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vmulti_match_pred.h"
+
+#include <fmt/format.h>
+#include <re2/re2.h>
+#include <re2/set.h>
+
+#include <typeinfo>
+
+#ifdef DORIS_WITH_HYPERSCAN
+#include <hs/hs.h>
+
+#include "util/utf8_check.h"
+#endif
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/exprs/vcompound_pred.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vliteral.h"
+#include "vec/exprs/vslot_ref.h"
+#include "vec/functions/like.h"
+
+namespace doris::vectorized {
+
+class MultiPatternMatcher {
+public:
+    // The patterns are regexes in the syntax of RE2. Returns nullptr if RE2 can't compile them.
+    static std::shared_ptr<const MultiPatternMatcher> create(
+            const std::vector<std::string>& patterns);
+
+    ~MultiPatternMatcher();
+
+    // Sets the result of a string to 1 if it matches any of the patterns, and 0 otherwise.
+    void match(const ColumnString& values, ColumnUInt8::Container* result) const;
+
+private:
+    std::unique_ptr<re2::RE2::Set> _re2_set;
+#ifdef DORIS_WITH_HYPERSCAN
+    hs_database_t* _hs_database = nullptr;
+#endif
+};
+
+#ifdef DORIS_WITH_HYPERSCAN
+namespace {
+
+// The scratch space of the scans of a thread, grown to fit the databases it scans.
+struct HyperscanScratch {
+    hs_scratch_t* scratch = nullptr;
+    ~HyperscanScratch() {
+        if (scratch != nullptr) {
+            hs_free_scratch(scratch);
+        }
+    }
+};
+
+hs_scratch_t* thread_scratch(const hs_database_t* database) {
+    static thread_local HyperscanScratch scratch;
+    if (hs_alloc_scratch(database, &scratch.scratch) != HS_SUCCESS) {
+        return nullptr;
+    }
+    return scratch.scratch;
+}
+
+int on_hyperscan_match(unsigned int id, unsigned long long from, unsigned long long to,
+                       unsigned int flags, void* context) {
+    *static_cast<bool*>(context) = true;
+    // stops the scan at the first match
+    return 1;
+}
+
+hs_database_t* compile_hyperscan(const std::vector<std::string>& patterns) {
+    std::vector<const char*> expressions;
+    std::vector<unsigned int> flags;
+    std::vector<unsigned int> ids;
+    for (int i = 0; i < patterns.size(); ++i) {
+        expressions.push_back(patterns[i].c_str());
+        flags.push_back(HS_FLAG_DOTALL | HS_FLAG_SINGLEMATCH | HS_FLAG_ALLOWEMPTY | HS_FLAG_UTF8);
+        ids.push_back(i);
+    }
+    hs_database_t* database = nullptr;
+    hs_compile_error_t* error = nullptr;
+    if (hs_compile_multi(expressions.data(), flags.data(), ids.data(), expressions.size(),
+                         HS_MODE_BLOCK, nullptr, &database, &error) != HS_SUCCESS) {
+        // e.g. back references, the patterns are matched by RE2
+        VLOG_DEBUG << "hyperscan can't compile the patterns: " << error->message;
+        hs_free_compile_error(error);
+        return nullptr;
+    }
+    return database;
+}
+
+} // namespace
+#endif
+
+std::shared_ptr<const MultiPatternMatcher> MultiPatternMatcher::create(
+        const std::vector<std::string>& patterns) {
+    RE2::Options options;
+    options.set_never_nl(false);
+    options.set_dot_nl(true);
+    auto matcher = std::make_shared<MultiPatternMatcher>();
+    matcher->_re2_set = std::make_unique<re2::RE2::Set>(options, RE2::UNANCHORED);
+    for (auto& pattern : patterns) {
+        std::string error;
+        if (matcher->_re2_set->Add(pattern, &error) < 0) {
+            VLOG_DEBUG << "invalid pattern " << pattern << ": " << error;
+            return nullptr;
+        }
+    }
+    if (!matcher->_re2_set->Compile()) {
+        return nullptr;
+    }
+#ifdef DORIS_WITH_HYPERSCAN
+    matcher->_hs_database = compile_hyperscan(patterns);
+#endif
+    return matcher;
+}
+
+MultiPatternMatcher::~MultiPatternMatcher() {
+#ifdef DORIS_WITH_HYPERSCAN
+    if (_hs_database != nullptr) {
+        hs_free_database(_hs_database);
+    }
+#endif
+}
+
+void MultiPatternMatcher::match(const ColumnString& values, ColumnUInt8::Container* result) const {
+    size_t rows = values.size();
+    result->resize(rows);
+#ifdef DORIS_WITH_HYPERSCAN
+    hs_scratch_t* scratch = _hs_database != nullptr ? thread_scratch(_hs_database) : nullptr;
+#endif
+    for (size_t i = 0; i < rows; ++i) {
+        StringRef value = values.get_data_at(i);
+#ifdef DORIS_WITH_HYPERSCAN
+        // the utf-8 mode of hyperscan requires valid utf-8
+        if (scratch != nullptr && validate_utf8(value.data, value.size)) {
+            bool matched = false;
+            hs_scan(_hs_database, value.data, value.size, 0, scratch, on_hyperscan_match,
+                    &matched);
+            (*result)[i] = matched;
+            continue;
+        }
+#endif
+        (*result)[i] = _re2_set->Match(re2::StringPiece(value.data, value.size), nullptr);
+    }
+}
+
+namespace {
+
+bool is_or(VExpr* expr) {
+    return dynamic_cast<VcompoundPred*>(expr) != nullptr && expr->fn().name.function_name == "or";
+}
+
+void collect_disjuncts(VExpr* expr, std::vector<VExpr*>* disjuncts) {
+    if (is_or(expr)) {
+        for (auto child : expr->children()) {
+            collect_disjuncts(child, disjuncts);
+        }
+    } else {
+        disjuncts->push_back(expr);
+    }
+}
+
+// Whether the escape chars of a LIKE pattern only escape the wildcards. FunctionLike keeps the
+// other escape chars in the patterns it matches by comparing strings, but drops them in the
+// regexes, so such patterns are left to it.
+bool has_only_wildcard_escapes(const StringRef& pattern, char escape_char) {
+    for (size_t i = 0; i < pattern.size; ++i) {
+        if (pattern.data[i] != escape_char) {
+            continue;
+        }
+        if (i + 1 == pattern.size || (pattern.data[i + 1] != '%' && pattern.data[i + 1] != '_')) {
+            return false;
+        }
+        ++i;
+    }
+    return true;
+}
+
+// Appends the pattern of a LIKE or REGEXP predicate with a constant pattern on the value.
+// Returns false if the expr is not one, or its value is not the same as the others.
+bool collect_pattern(VExpr* expr, VSlotRef** value, std::vector<std::string>* patterns) {
+    const std::string& fn_name = expr->fn().name.function_name;
+    const auto& children = expr->children();
+    if (dynamic_cast<VectorizedFnCall*>(expr) == nullptr ||
+        (fn_name != FunctionLike::name && fn_name != FunctionRegexp::name) ||
+        children.size() != 2) {
+        return false;
+    }
+    auto* slot_ref = dynamic_cast<VSlotRef*>(children[0]);
+    if (slot_ref == nullptr || (*value != nullptr && (*value)->slot_id() != slot_ref->slot_id()) ||
+        typeid(*children[1]) != typeid(VLiteral)) {
+        return false;
+    }
+    StringRef pattern = static_cast<VLiteral*>(children[1])->column()->get_data_at(0);
+    if (pattern.data == nullptr) {
+        return false;
+    }
+    if (fn_name == FunctionLike::name) {
+        LikeSearchState state;
+        if (!has_only_wildcard_escapes(pattern, state.escape_char)) {
+            return false;
+        }
+        std::string re_pattern;
+        FunctionLike::convert_like_pattern(&state, pattern.to_string(), &re_pattern);
+        patterns->push_back(fmt::format("\\A(?:{})\\z", re_pattern));
+    } else {
+        patterns->push_back(pattern.to_string());
+    }
+    *value = slot_ref;
+    return true;
+}
+
+} // namespace
+
+VExpr* VMultiMatchPred::rewrite(ObjectPool* pool, VExpr* expr) {
+    if (is_or(expr)) {
+        std::vector<VExpr*> disjuncts;
+        collect_disjuncts(expr, &disjuncts);
+        VSlotRef* value = nullptr;
+        std::vector<std::string> patterns;
+        bool can_rewrite = true;
+        for (auto disjunct : disjuncts) {
+            can_rewrite &= collect_pattern(disjunct, &value, &patterns);
+        }
+        if (can_rewrite) {
+            auto matcher = MultiPatternMatcher::create(patterns);
+            if (matcher != nullptr) {
+                return pool->add(new VMultiMatchPred(*expr, value, std::move(matcher)));
+            }
+        }
+    }
+    std::vector<VExpr*> children = expr->children();
+    for (auto& child : children) {
+        child = rewrite(pool, child);
+    }
+    expr->set_children(std::move(children));
+    return expr;
+}
+
+VMultiMatchPred::VMultiMatchPred(const VExpr& root, VExpr* value,
+                                 std::shared_ptr<const MultiPatternMatcher> matcher)
+        : VExpr(root),
+          _matcher(std::move(matcher)),
+          _expr_name(fmt::format("multi_match({})", value->expr_name())) {
+    // not taken as an or by the exprs inspecting the tree
+    _node_type = TExprNodeType::FUNCTION_CALL;
+    _fn = TFunction();
+    _fn_context_index = -1;
+    _children = {value};
+}
+
+Status VMultiMatchPred::execute(VExprContext* context, Block* block, int* result_column_id) {
+    int column_id = -1;
+    RETURN_IF_ERROR(_children[0]->execute(context, block, &column_id));
+    ColumnPtr column = block->get_by_position(column_id).column->convert_to_full_column_if_const();
+    ColumnPtr null_map;
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(column.get())) {
+        null_map = nullable->get_null_map_column_ptr();
+        column = nullable->get_nested_column_ptr();
+    }
+    const auto* values = check_and_get_column<ColumnString>(column.get());
+    if (values == nullptr) {
+        return Status::InternalError("Not supported input arguments types");
+    }
+    auto result = ColumnUInt8::create();
+    _matcher->match(*values, &result->get_data());
+
+    if (_data_type->is_nullable()) {
+        if (null_map == nullptr) {
+            null_map = ColumnUInt8::create(values->size(), 0);
+        }
+        block->insert({ColumnNullable::create(std::move(result), null_map), _data_type,
+                       _expr_name});
+    } else {
+        block->insert({std::move(result), _data_type, _expr_name});
+    }
+    *result_column_id = block->columns() - 1;
+    return Status::OK();
+}
+
+std::string VMultiMatchPred::debug_string() const {
+    std::stringstream out;
+    out << "MultiMatchPred{" << _children[0]->debug_string() << "}";
+    return out.str();
+}
+
+} // namespace doris::vectorized
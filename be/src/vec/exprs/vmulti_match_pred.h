@@ -0,0 +1,55 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vec/exprs/vexpr.h"
+
+namespace doris::vectorized {
+
+class MultiPatternMatcher;
+
+// An or of LIKE and REGEXP predicates with constant patterns on the same column, e.g.
+// `url LIKE '%a%' OR url LIKE '%b%' OR url REGEXP 'c+'`, evaluated by a matcher of all the
+// patterns which scans each string once, instead of once for each pattern. The matcher is a
+// Hyperscan database if the BE is built with Hyperscan and it accepts all the patterns, and a
+// RE2::Set otherwise, which also matches the strings that are not valid utf-8 for Hyperscan.
+class VMultiMatchPred final : public VExpr {
+public:
+    // Replaces the or-chains of the tree that can be matched at once, and returns the new root
+    // of the tree. It's called after the tree is prepared.
+    static VExpr* rewrite(ObjectPool* pool, VExpr* expr);
+
+    VMultiMatchPred(const VExpr& root, VExpr* value,
+                    std::shared_ptr<const MultiPatternMatcher> matcher);
+    ~VMultiMatchPred() override = default;
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override;
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new VMultiMatchPred(*this)); }
+    const std::string& expr_name() const override { return _expr_name; }
+    std::string debug_string() const override;
+
+private:
+    std::shared_ptr<const MultiPatternMatcher> _matcher;
+    std::string _expr_name;
+};
+
+} // namespace doris::vectorized
@@ -41,6 +41,12 @@ public:
 
     const int column_id() const { return _column_id; }
 
+    void collect_column_ids(std::set<int>* column_ids) const override {
+        column_ids->insert(_column_id);
+    }
+
+    int slot_id() const { return _slot_id; }
+
 private:
     FunctionPtr _function;
     int _slot_id;
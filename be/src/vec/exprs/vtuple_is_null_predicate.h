@@ -39,6 +39,10 @@ public:
 
     virtual std::string debug_string() const override;
 
+    void collect_column_ids(std::set<int>* column_ids) const override {
+        column_ids->insert(_column_to_check);
+    }
+
 private:
     std::string _expr_name;
     bool _is_left_null_side;
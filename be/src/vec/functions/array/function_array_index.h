@@ -22,6 +22,7 @@
 #include <string_view>
 
 #include "vec/columns/column_array.h"
+#include "vec/columns/column_const.h"
 #include "vec/columns/column_string.h"
 #include "vec/data_types/data_type_array.h"
 #include "vec/data_types/data_type_number.h"
@@ -67,8 +68,24 @@ public:
     }
 
 private:
+    // Sets the result of each row from the matches of its elements with the right value.
+    static void _apply_matches(const ColumnArray::Offsets& offsets, const UInt8* matches,
+                               PaddedPODArray<ResultType>& dst_data) {
+        for (size_t row = 0; row < offsets.size(); ++row) {
+            ResultType res = 0;
+            size_t off = offsets[row - 1];
+            size_t len = offsets[row] - off;
+            const auto* found = static_cast<const UInt8*>(memchr(matches + off, 1, len));
+            if (found != nullptr) {
+                ConcreteAction::apply(res, found - (matches + off));
+            }
+            dst_data[row] = res;
+        }
+    }
+
     ColumnPtr _execute_string(const ColumnArray::Offsets& offsets, const UInt8* nested_null_map,
-                              const IColumn& nested_column, const IColumn& right_column) {
+                              const IColumn& nested_column, const IColumn& right_column,
+                              bool right_const) {
         // check array nested column type and get data
         const auto& str_offs = reinterpret_cast<const ColumnString&>(nested_column).get_offsets();
         const auto& str_chars = reinterpret_cast<const ColumnString&>(nested_column).get_chars();
@@ -81,6 +98,29 @@ private:
         auto dst = ColumnVector<ResultType>::create(offsets.size());
         auto& dst_data = dst->get_data();
 
+        if (right_const) {
+            // match all the elements with the constant in one pass over the nested column, the
+            // lengths are compared before the strings
+            size_t num_elements = offsets.empty() ? 0 : offsets.back();
+            const auto right_value =
+                    reinterpret_cast<const ColumnString&>(right_column).get_data_at(0);
+            // the sizes of the offsets include the terminating zeros
+            const size_t right_size = right_value.size + 1;
+            PaddedPODArray<UInt8> matches(num_elements);
+            for (size_t i = 0; i < num_elements; ++i) {
+                matches[i] = str_offs[i] - str_offs[i - 1] == right_size;
+            }
+            for (size_t i = 0; i < num_elements; ++i) {
+                if (matches[i]) {
+                    matches[i] = memcmp(&str_chars[str_offs[i - 1]], right_value.data,
+                                        right_value.size) == 0 &&
+                                 !(nested_null_map && nested_null_map[i]);
+                }
+            }
+            _apply_matches(offsets, matches.data(), dst_data);
+            return dst;
+        }
+
         // process
         for (size_t row = 0; row < offsets.size(); ++row) {
             ResultType res = 0;
@@ -111,7 +151,8 @@ private:
 
     template <typename NestedColumnType, typename RightColumnType>
     ColumnPtr _execute_number(const ColumnArray::Offsets& offsets, const UInt8* nested_null_map,
-                              const IColumn& nested_column, const IColumn& right_column) {
+                              const IColumn& nested_column, const IColumn& right_column,
+                              bool right_const) {
         // check array nested column type and get data
         const auto& nested_data =
                 reinterpret_cast<const NestedColumnType&>(nested_column).get_data();
@@ -123,6 +164,24 @@ private:
         auto dst = ColumnVector<ResultType>::create(offsets.size());
         auto& dst_data = dst->get_data();
 
+        if (right_const) {
+            // compare all the elements with the constant in one pass over the nested column,
+            // which the compiler vectorizes
+            size_t num_elements = offsets.empty() ? 0 : offsets.back();
+            const auto right_value = right_data[0];
+            PaddedPODArray<UInt8> matches(num_elements);
+            for (size_t i = 0; i < num_elements; ++i) {
+                matches[i] = nested_data[i] == right_value;
+            }
+            if (nested_null_map) {
+                for (size_t i = 0; i < num_elements; ++i) {
+                    matches[i] &= !nested_null_map[i];
+                }
+            }
+            _apply_matches(offsets, matches.data(), dst_data);
+            return dst;
+        }
+
         // process
         for (size_t row = 0; row < offsets.size(); ++row) {
             ResultType res = 0;
@@ -146,43 +205,43 @@ private:
     template <typename NestedColumnType>
     ColumnPtr _execute_number_expanded(const ColumnArray::Offsets& offsets,
                                        const UInt8* nested_null_map, const IColumn& nested_column,
-                                       const IColumn& right_column) {
+                                       const IColumn& right_column, bool right_const) {
         if (check_column<ColumnUInt8>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnUInt8>(offsets, nested_null_map,
-                                                                  nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnUInt8>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (check_column<ColumnInt8>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnInt8>(offsets, nested_null_map,
-                                                                 nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnInt8>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (check_column<ColumnInt16>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnInt16>(offsets, nested_null_map,
-                                                                  nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnInt16>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (check_column<ColumnInt32>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnInt32>(offsets, nested_null_map,
-                                                                  nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnInt32>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (check_column<ColumnInt64>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnInt64>(offsets, nested_null_map,
-                                                                  nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnInt64>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (check_column<ColumnInt128>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnInt128>(offsets, nested_null_map,
-                                                                   nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnInt128>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (check_column<ColumnFloat32>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnFloat32>(offsets, nested_null_map,
-                                                                    nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnFloat32>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (check_column<ColumnFloat64>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnFloat64>(offsets, nested_null_map,
-                                                                    nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnFloat64>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (right_column.is_date_type()) {
-            return _execute_number<NestedColumnType, ColumnDate>(offsets, nested_null_map,
-                                                                 nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnDate>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (right_column.is_date_v2_type()) {
-            return _execute_number<NestedColumnType, ColumnDateV2>(offsets, nested_null_map,
-                                                                   nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnDateV2>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (right_column.is_datetime_type()) {
-            return _execute_number<NestedColumnType, ColumnDateTime>(offsets, nested_null_map,
-                                                                     nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnDateTime>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         } else if (check_column<ColumnDecimal128>(right_column)) {
-            return _execute_number<NestedColumnType, ColumnDecimal128>(offsets, nested_null_map,
-                                                                       nested_column, right_column);
+            return _execute_number<NestedColumnType, ColumnDecimal128>(
+                    offsets, nested_null_map, nested_column, right_column, right_const);
         }
         return nullptr;
     }
@@ -205,9 +264,12 @@ private:
             nested_column = array_column.get_data_ptr();
         }
 
-        // get right column
-        auto right_column =
-                block.get_by_position(arguments[1]).column->convert_to_full_column_if_const();
+        // get right column, a constant is matched against the elements without being expanded
+        ColumnPtr right_column = block.get_by_position(arguments[1]).column;
+        bool right_const = is_column_const(*right_column);
+        if (right_const) {
+            right_column = assert_cast<const ColumnConst&>(*right_column).get_data_column_ptr();
+        }
 
         // execute
         auto left_element_type = remove_nullable(
@@ -217,49 +279,49 @@ private:
 
         ColumnPtr return_column = nullptr;
         if (is_string(right_type) && is_string(left_element_type)) {
-            return_column =
-                    _execute_string(offsets, nested_null_map, *nested_column, *right_column);
+            return_column = _execute_string(offsets, nested_null_map, *nested_column,
+                                            *right_column, right_const);
         } else if (is_number(right_type) && is_number(left_element_type)) {
             if (check_column<ColumnUInt8>(*nested_column)) {
                 return_column = _execute_number_expanded<ColumnUInt8>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (check_column<ColumnInt8>(*nested_column)) {
-                return_column = _execute_number_expanded<ColumnInt8>(offsets, nested_null_map,
-                                                                     *nested_column, *right_column);
+                return_column = _execute_number_expanded<ColumnInt8>(
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (check_column<ColumnInt16>(*nested_column)) {
                 return_column = _execute_number_expanded<ColumnInt16>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (check_column<ColumnInt32>(*nested_column)) {
                 return_column = _execute_number_expanded<ColumnInt32>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (check_column<ColumnInt64>(*nested_column)) {
                 return_column = _execute_number_expanded<ColumnInt64>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (check_column<ColumnInt128>(*nested_column)) {
                 return_column = _execute_number_expanded<ColumnInt128>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (check_column<ColumnFloat32>(*nested_column)) {
                 return_column = _execute_number_expanded<ColumnFloat32>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (check_column<ColumnFloat64>(*nested_column)) {
                 return_column = _execute_number_expanded<ColumnFloat64>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (check_column<ColumnDecimal128>(*nested_column)) {
                 return_column = _execute_number_expanded<ColumnDecimal128>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             }
         } else if ((is_date_or_datetime(right_type) || is_date_v2_or_datetime_v2(right_type)) &&
                    (is_date_or_datetime(left_element_type) ||
                     is_date_v2_or_datetime_v2(left_element_type))) {
             if (nested_column->is_date_type()) {
-                return_column = _execute_number_expanded<ColumnDate>(offsets, nested_null_map,
-                                                                     *nested_column, *right_column);
+                return_column = _execute_number_expanded<ColumnDate>(
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (nested_column->is_date_v2_type()) {
                 return_column = _execute_number_expanded<ColumnDateV2>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             } else if (nested_column->is_datetime_type()) {
                 return_column = _execute_number_expanded<ColumnDateTime>(
-                        offsets, nested_null_map, *nested_column, *right_column);
+                        offsets, nested_null_map, *nested_column, *right_column, right_const);
             }
         }
 
@@ -29,6 +29,7 @@
 #include "vec/core/types.h"
 #include "vec/data_types/data_type_date_time.h"
 #include "vec/functions/function_helpers.h"
+#include "vec/runtime/vdatetime_packed.h"
 #include "vec/runtime/vdatetime_value.h"
 
 namespace doris::vectorized {
@@ -41,7 +42,7 @@ namespace doris::vectorized {
                                                                              \
         static inline auto execute(const ARG_TYPE& t, bool& is_null) {       \
             const auto& date_time_value = (DateValueType&)(t);               \
-            is_null = !date_time_value.is_valid_date();                      \
+            is_null = !packed_date::is_valid_date(t);                        \
             return date_time_value.FUNCTION;                                 \
         }                                                                    \
                                                                              \
@@ -69,8 +70,26 @@ TIME_FUNCTION_IMPL(DayOfYearImpl, dayofyear, day_of_year());
 TIME_FUNCTION_IMPL(DayOfMonthImpl, dayofmonth, day());
 TIME_FUNCTION_IMPL(DayOfWeekImpl, dayofweek, day_of_week());
 TIME_FUNCTION_IMPL(WeekDayImpl, weekday, weekday());
+
 // TODO: the method should be always not nullable
-TIME_FUNCTION_IMPL(ToDaysImpl, to_days, daynr());
+template <typename DateValueType, typename ArgType>
+struct ToDaysImpl {
+    using ARG_TYPE = ArgType;
+    static constexpr auto name = "to_days";
+
+    static inline auto execute(const ARG_TYPE& t, bool& is_null) {
+        is_null = !packed_date::is_valid_date(t);
+        return packed_date::daynr(t);
+    }
+
+    static DataTypes get_variadic_argument_types() {
+        if constexpr (std::is_same_v<DateValueType, VecDateTimeValue>) {
+            return {std::make_shared<DataTypeDateTime>()};
+        } else {
+            return {std::make_shared<DataTypeDateV2>()};
+        }
+    }
+};
 
 #define TIME_FUNCTION_ONE_ARG_IMPL(CLASS, UNIT, FUNCTION)                    \
     template <typename DateValueType, typename ArgType>                      \
@@ -80,7 +99,7 @@ TIME_FUNCTION_IMPL(ToDaysImpl, to_days, daynr());
                                                                              \
         static inline auto execute(const ARG_TYPE& t, bool& is_null) {       \
             const auto& date_time_value = (DateValueType&)(t);               \
-            is_null = !date_time_value.is_valid_date();                      \
+            is_null = !packed_date::is_valid_date(t);                        \
             return date_time_value.FUNCTION;                                 \
         }                                                                    \
                                                                              \
@@ -102,12 +121,8 @@ struct ToDateImpl {
     static constexpr auto name = "to_date";
 
     static inline auto execute(const ArgType& t, bool& is_null) {
-        auto dt = binary_cast<ArgType, DateValueType>(t);
-        is_null = !dt.is_valid_date();
-        if constexpr (!std::is_same_v<DateValueType, doris::vectorized::DateV2Value>) {
-            dt.cast_to_date();
-        }
-        return binary_cast<DateValueType, ArgType>(dt);
+        is_null = !packed_date::is_valid_date(t);
+        return packed_date::to_date(t);
     }
 
     static DataTypes get_variadic_argument_types() {
@@ -48,6 +48,7 @@ ColumnPtr wrap_in_nullable(const ColumnPtr& src, const Block& block, const Colum
         result_null_map_column = nullable->get_null_map_column_ptr();
     }
 
+    std::vector<const ColumnUInt8*> null_maps;
     for (const auto& arg : args) {
         const ColumnWithTypeAndName& elem = block.get_by_position(arg);
         if (!elem.type->is_nullable()) continue;
@@ -60,25 +61,36 @@ ColumnPtr wrap_in_nullable(const ColumnPtr& src, const Block& block, const Colum
         if (is_column_const(*elem.column)) continue;
 
         if (auto* nullable = check_and_get_column<ColumnNullable>(*elem.column)) {
-            const ColumnPtr& null_map_column = nullable->get_null_map_column_ptr();
-            if (!result_null_map_column) {
-                result_null_map_column = null_map_column->clone_resized(null_map_column->size());
-            } else {
-                MutableColumnPtr mutable_result_null_map_column =
-                        (*std::move(result_null_map_column)).assume_mutable();
-
-                NullMap& result_null_map =
-                        assert_cast<ColumnUInt8&>(*mutable_result_null_map_column).get_data();
-                const NullMap& src_null_map =
-                        assert_cast<const ColumnUInt8&>(*null_map_column).get_data();
-
-                VectorizedUtils::update_null_map(result_null_map, src_null_map);
-                result_null_map_column = std::move(mutable_result_null_map_column);
-            }
+            null_maps.push_back(&nullable->get_null_map_column());
         }
     }
 
-    if (!result_null_map_column) return make_nullable(src);
+    if (!result_null_map_column) {
+        if (null_maps.empty()) return make_nullable(src);
+        if (null_maps.size() == 1) {
+            result_null_map_column = null_maps[0]->clone_resized(null_maps[0]->size());
+        } else {
+            /// The null maps of the two first arguments are merged while they are copied, so
+            /// that a binary function reads each null map only once.
+            auto null_map_column = ColumnUInt8::create(null_maps[0]->size());
+            VectorizedUtils::merge_null_maps(null_map_column->get_data(), null_maps[0]->get_data(),
+                                             null_maps[1]->get_data());
+            for (size_t i = 2; i < null_maps.size(); ++i) {
+                VectorizedUtils::update_null_map(null_map_column->get_data(),
+                                                 null_maps[i]->get_data());
+            }
+            result_null_map_column = std::move(null_map_column);
+        }
+    } else if (!null_maps.empty()) {
+        MutableColumnPtr mutable_result_null_map_column =
+                (*std::move(result_null_map_column)).assume_mutable();
+        NullMap& result_null_map =
+                assert_cast<ColumnUInt8&>(*mutable_result_null_map_column).get_data();
+        for (const auto* null_map : null_maps) {
+            VectorizedUtils::update_null_map(result_null_map, null_map->get_data());
+        }
+        result_null_map_column = std::move(mutable_result_null_map_column);
+    }
 
     return ColumnNullable::create(src_not_nullable->convert_to_full_column_if_const(),
                                   result_null_map_column);
@@ -242,9 +242,8 @@ struct DecimalBinaryOperation {
         }
 
         /// default: use it if no return before
-        for (size_t i = 0; i < size; ++i) {
-            c[i] = apply(a[i], b[i]);
-        }
+        apply_batch(
+                size, c, [&](size_t i) { return a[i]; }, [&](size_t i) { return b[i]; });
     }
 
     /// null_map for divide and mod
@@ -302,9 +301,8 @@ struct DecimalBinaryOperation {
         }
 
         /// default: use it if no return before
-        for (size_t i = 0; i < size; ++i) {
-            c[i] = apply(a[i], b);
-        }
+        apply_batch(
+                size, c, [&](size_t i) { return a[i]; }, [&](size_t) { return b; });
     }
 
     static void vector_constant(const typename Traits::ArrayA& a, B b, ArrayC& c,
@@ -359,9 +357,8 @@ struct DecimalBinaryOperation {
         }
 
         /// default: use it if no return before
-        for (size_t i = 0; i < size; ++i) {
-            c[i] = apply(a, b[i]);
-        }
+        apply_batch(
+                size, c, [&](size_t) { return a; }, [&](size_t i) { return b[i]; });
     }
 
     static void constant_vector(A a, const typename Traits::ArrayB& b, ArrayC& c,
@@ -499,6 +496,48 @@ struct DecimalBinaryOperation {
     }
 
 private:
+    /// Computes the rows of a block without a branch per row, so that the loop is vectorized on
+    /// the native type of the result: the overflow flags of the rows are or-ed and checked once
+    /// per block, and only a block that overflowed is computed again row by row.
+    template <typename GetA, typename GetB>
+    static void apply_batch(size_t size, ArrayC& c, GetA&& get_a, GetB&& get_b) {
+        if (config::enable_decimalv3) {
+            if constexpr (OpTraits::can_overflow && check_overflow) {
+                bool overflow = false;
+                for (size_t i = 0; i < size; ++i) {
+                    NativeResultType x = get_a(i);
+                    NativeResultType y = get_b(i);
+                    NativeResultType res;
+                    overflow |= Op::template apply<NativeResultType>(x, y, res);
+                    c[i] = res;
+                }
+                if (!overflow) {
+                    return;
+                }
+            }
+        } else if constexpr (OpTraits::is_plus_minus && std::is_same_v<NativeResultType, Int128>) {
+            // DecimalV2Value saturates the sums out of its range, which never overflow int128,
+            // so that a sum equals the one of DecimalV2Value if it is in the range.
+            constexpr Int128 max = DecimalV2Value::MAX_DECIMAL_VALUE;
+            bool overflow = false;
+            for (size_t i = 0; i < size; ++i) {
+                NativeResultType x = get_a(i);
+                NativeResultType y = get_b(i);
+                NativeResultType res = Op::template apply<NativeResultType>(x, y);
+                overflow |= static_cast<unsigned __int128>(res + max) >
+                            static_cast<unsigned __int128>(2 * max);
+                c[i] = res;
+            }
+            if (!overflow) {
+                return;
+            }
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            c[i] = apply(get_a(i), get_b(i));
+        }
+    }
+
     /// there's implicit type convertion here
     static NativeResultType apply(NativeResultType a, NativeResultType b) {
         if (config::enable_decimalv3) {
@@ -29,6 +29,7 @@
 #include "vec/data_types/data_type_number.h"
 #include "vec/functions/function.h"
 #include "vec/functions/function_helpers.h"
+#include "vec/runtime/vdatetime_packed.h"
 #include "vec/runtime/vdatetime_value.h"
 namespace doris::vectorized {
 
@@ -153,10 +154,8 @@ struct DateDiffImpl {
     static constexpr auto name = "datediff";
     static constexpr auto is_nullable = false;
     static inline Int32 execute(const ArgType1& t0, const ArgType2& t1, bool& is_null) {
-        const auto& ts0 = reinterpret_cast<const DateValueType1&>(t0);
-        const auto& ts1 = reinterpret_cast<const DateValueType2&>(t1);
-        is_null = !ts0.is_valid_date() || !ts1.is_valid_date();
-        return ts0.daynr() - ts1.daynr();
+        is_null = !packed_date::is_valid_date(t0) | !packed_date::is_valid_date(t1);
+        return packed_date::daynr(t0) - packed_date::daynr(t1);
     }
 
     static DataTypes get_variadic_argument_types() {
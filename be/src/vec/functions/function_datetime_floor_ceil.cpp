@@ -20,6 +20,7 @@
 #include "vec/data_types/data_type_date_time.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/functions/simple_function_factory.h"
+#include "vec/runtime/vdatetime_packed.h"
 
 namespace doris::vectorized {
 
@@ -115,6 +116,24 @@ struct FloorCeilImpl {
 
     static void vector(const PaddedPODArray<Int64>& dates, PaddedPODArray<Int64>& res,
                        NullMap& null_map) {
+        if constexpr (Impl::can_floor_packed) {
+            // flooring to one unit from the default origin truncates the packed datetimes,
+            // only the invalid ones are left to the calendar code
+            bool all_valid = true;
+            for (int i = 0; i < dates.size(); ++i) {
+                res[i] = packed_date::floor_to_unit<Impl::Unit>(dates[i]);
+                all_valid &= packed_date::is_valid_date(dates[i]);
+            }
+            if (all_valid) {
+                return;
+            }
+            for (int i = 0; i < dates.size(); ++i) {
+                if (!packed_date::is_valid_date(dates[i])) {
+                    Impl::time_round(dates[i], Int32(1), res[i], null_map[i]);
+                }
+            }
+            return;
+        }
         vector_constant(dates, Int32(1), res, null_map);
     }
 
@@ -165,6 +184,8 @@ struct TimeRound {
     static constexpr uint64_t FIRST_SUNDAY = 19700104000000;
     static constexpr int8_t FLOOR = 0;
     static constexpr int8_t CEIL = 1;
+    static constexpr TimeUnit Unit = Impl::Unit;
+    static constexpr bool can_floor_packed = Impl::Type == FLOOR && Impl::Unit != WEEK;
 
     static void time_round(const doris::vectorized::VecDateTimeValue& ts2, Int32 period,
                            doris::vectorized::VecDateTimeValue& ts1, UInt8& is_null) {
@@ -222,8 +222,110 @@ struct MurmurHash3Impl32 {
 };
 using FunctionMurmurHash3_32 = FunctionVariadicArgumentsBase<DataTypeInt32, MurmurHash3Impl32>;
 
+// The 64 bits hashes of whole columns: the hash of each argument is the seed of the hash of the
+// next one, and the hashes of a column are computed in one pass over its chars and offsets, so
+// they are written in place instead of being inserted one by one.
+template <typename Hasher>
+struct Hash64Impl {
+    static constexpr auto name = Hasher::name;
+    using ReturnType = Int64;
+
+    static Status empty_apply(IColumn& icolumn, size_t input_rows_count) {
+        assert_cast<ColumnVector<ReturnType>&>(icolumn).get_data().assign(
+                input_rows_count, static_cast<ReturnType>(Hasher::hash("", 0, Hasher::SEED)));
+        return Status::OK();
+    }
+
+    static Status first_apply(const IDataType* type, const IColumn* column, size_t input_rows_count,
+                              IColumn& icolumn) {
+        auto& hashes = assert_cast<ColumnVector<ReturnType>&>(icolumn).get_data();
+        hashes.resize_fill(input_rows_count, static_cast<ReturnType>(Hasher::SEED));
+        return execute(type, column, input_rows_count, hashes);
+    }
+
+    static Status combine_apply(const IDataType* type, const IColumn* column,
+                                size_t input_rows_count, IColumn& icolumn) {
+        auto& hashes = assert_cast<ColumnVector<ReturnType>&>(icolumn).get_data();
+        return execute(type, column, input_rows_count, hashes);
+    }
+
+    static Status execute(const IDataType* type, const IColumn* column, size_t input_rows_count,
+                          PaddedPODArray<ReturnType>& hashes) {
+        if (const ColumnString* col_from = check_and_get_column<ColumnString>(column)) {
+            const typename ColumnString::Chars& data = col_from->get_chars();
+            const typename ColumnString::Offsets& offsets = col_from->get_offsets();
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                hashes[i] = Hasher::hash(&data[offsets[i - 1]], offsets[i] - offsets[i - 1] - 1,
+                                         hashes[i]);
+            }
+            return Status::OK();
+        }
+        if (const ColumnConst* col_from_const =
+                    check_and_get_column_const_string_or_fixedstring(column)) {
+            StringRef value = col_from_const->get_data_at(0);
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                hashes[i] = Hasher::hash(value.data, value.size, hashes[i]);
+            }
+            return Status::OK();
+        }
+
+        WhichDataType which(type);
+#define DISPATCH(TYPE, COLUMN_TYPE)   \
+    if (which.idx == TypeIndex::TYPE) \
+        return execute_number<TYPE>(column, input_rows_count, hashes);
+        NUMERIC_TYPE_TO_COLUMN_TYPE(DISPATCH)
+#undef DISPATCH
+        return Status::NotSupported("Illegal column {} of argument of function {}",
+                                    column->get_name(), name);
+    }
+
+    template <typename FromType>
+    static Status execute_number(const IColumn* column, size_t input_rows_count,
+                                 PaddedPODArray<ReturnType>& hashes) {
+        if (const auto* col_from = check_and_get_column<ColumnVector<FromType>>(column)) {
+            const auto& vec_from = col_from->get_data();
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                hashes[i] = Hasher::hash(&vec_from[i], sizeof(FromType), hashes[i]);
+            }
+        } else if (const auto* col_from_const =
+                           check_and_get_column_const<ColumnVector<FromType>>(column)) {
+            auto value = col_from_const->template get_value<FromType>();
+            for (size_t i = 0; i < input_rows_count; ++i) {
+                hashes[i] = Hasher::hash(&value, sizeof(FromType), hashes[i]);
+            }
+        } else {
+            return Status::NotSupported("Illegal column {} of argument of function {}",
+                                        column->get_name(), name);
+        }
+        return Status::OK();
+    }
+};
+
+struct XxHash64 {
+    static constexpr auto name = "xxhash_64";
+    static constexpr uint64_t SEED = 0;
+
+    static uint64_t hash(const void* data, size_t size, uint64_t seed) {
+        return HashUtil::xxhash64(data, size, seed);
+    }
+};
+using FunctionXxHash64 = FunctionVariadicArgumentsBase<DataTypeInt64, Hash64Impl<XxHash64>>;
+
+struct MurmurHash3_64 {
+    static constexpr auto name = "murmur_hash3_64";
+    static constexpr uint64_t SEED = HashUtil::MURMUR3_64_SEED;
+
+    static uint64_t hash(const void* data, size_t size, uint64_t seed) {
+        return HashUtil::murmur_hash3_64(data, size, seed);
+    }
+};
+using FunctionMurmurHash3_64 =
+        FunctionVariadicArgumentsBase<DataTypeInt64, Hash64Impl<MurmurHash3_64>>;
+
 void register_function_hash(SimpleFunctionFactory& factory) {
     factory.register_function<FunctionMurmurHash2_64>();
     factory.register_function<FunctionMurmurHash3_32>();
+    factory.register_function<FunctionMurmurHash3_64>();
+    factory.register_function<FunctionXxHash64>();
 }
 } // namespace doris::vectorized
\ No newline at end of file
@@ -107,6 +107,9 @@ Status JavaFunctionCall::execute(FunctionContext* context, Block& block,
     JniContext* jni_ctx = reinterpret_cast<JniContext*>(
             context->get_function_state(FunctionContext::THREAD_LOCAL));
     int arg_idx = 0;
+    // the string results are often about as long as the string arguments, so their buffer starts
+    // at that size instead of growing from a small one with a call into java per growth
+    size_t input_chars_size = 0;
     for (size_t col_idx : arguments) {
         ColumnWithTypeAndName& column = block.get_by_position(col_idx);
         auto col = column.column->convert_to_full_column_if_const();
@@ -132,6 +135,7 @@ Status JavaFunctionCall::execute(FunctionContext* context, Block& block,
                     reinterpret_cast<int64_t>(str_col->get_chars().data());
             jni_ctx->input_offsets_ptrs.get()[arg_idx] =
                     reinterpret_cast<int64_t>(str_col->get_offsets().data());
+            input_chars_size += str_col->get_chars().size();
         } else if (data_col->is_numeric() || data_col->is_column_decimal()) {
             jni_ctx->input_values_buffer_ptr.get()[arg_idx] =
                     reinterpret_cast<int64_t>(data_col->get_raw_data().data);
@@ -159,8 +163,8 @@ Status JavaFunctionCall::execute(FunctionContext* context, Block& block,
         ColumnString::Chars& chars = const_cast<ColumnString::Chars&>(str_col->get_chars());       \
         ColumnString::Offsets& offsets =                                                           \
                 const_cast<ColumnString::Offsets&>(str_col->get_offsets());                        \
-        int increase_buffer_size = 0;                                                              \
-        int32_t buffer_size = JniUtil::IncreaseReservedBufferSize(increase_buffer_size);           \
+        int32_t buffer_size = std::max<size_t>(JniUtil::IncreaseReservedBufferSize(0),             \
+                                               input_chars_size);                                  \
         chars.reserve(buffer_size);                                                                \
         chars.resize(buffer_size);                                                                 \
         offsets.reserve(num_rows);                                                                 \
@@ -172,8 +176,7 @@ Status JavaFunctionCall::execute(FunctionContext* context, Block& block,
         env->CallNonvirtualVoidMethodA(jni_ctx->executor, executor_cl_, executor_evaluate_id_,     \
                                        nullptr);                                                   \
         while (jni_ctx->output_intermediate_state_ptr->row_idx < num_rows) {                       \
-            increase_buffer_size++;                                                                \
-            int32_t buffer_size = JniUtil::IncreaseReservedBufferSize(increase_buffer_size);       \
+            buffer_size *= 2;                                                                      \
             chars.resize(buffer_size);                                                             \
             *(jni_ctx->output_value_buffer) = reinterpret_cast<int64_t>(chars.data());             \
             jni_ctx->output_intermediate_state_ptr->buffer_size = buffer_size;                     \
@@ -20,9 +20,12 @@
 #include <rapidjson/writer.h>
 
 #include <boost/token_functions.hpp>
+#include <limits>
 #include <vector>
 
 #include "exprs/json_functions.h"
+#include "udf/udf_internal.h"
+#include "util/jsonb.h"
 #include "util/string_parser.hpp"
 #include "util/string_util.h"
 #include "vec/columns/column.h"
@@ -34,6 +37,7 @@
 #include "vec/data_types/data_type_string.h"
 #include "vec/functions/function_string.h"
 #include "vec/functions/function_totype.h"
+#include "vec/functions/json_documents.h"
 #include "vec/functions/simple_function_factory.h"
 #include "vec/utils/template_helpers.hpp"
 
@@ -88,6 +92,7 @@ void get_parsed_paths(const T& path_exprs, std::vector<JsonPath>* parsed_paths)
     }
 }
 
+// The document is not modified, so it can be matched against other paths afterwards.
 rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjson::Value* document,
                               rapidjson::Document::AllocatorType& mem_allocator,
                               bool is_insert_null = false) {
@@ -133,11 +138,15 @@ rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjs
                         if (obj->IsArray()) {
                             is_null = false;
                             for (int k = 0; k < obj->Size(); k++) {
-                                array_obj->PushBack((*obj)[k], mem_allocator);
+                                rapidjson::Value v;
+                                v.CopyFrom((*obj)[k], mem_allocator);
+                                array_obj->PushBack(v, mem_allocator);
                             }
                         } else if (!obj->IsNull()) {
                             is_null = false;
-                            array_obj->PushBack(*obj, mem_allocator);
+                            rapidjson::Value v;
+                            v.CopyFrom(*obj, mem_allocator);
+                            array_obj->PushBack(v, mem_allocator);
                         }
                     }
                 }
@@ -186,39 +195,45 @@ rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjs
     return root;
 }
 
-template <JsonFunctionType fntype>
-rapidjson::Value* get_json_object(const std::string_view& json_string,
-                                  const std::string_view& path_string,
-                                  rapidjson::Document* document) {
-    std::vector<JsonPath>* parsed_paths;
-    std::vector<JsonPath> tmp_parsed_paths;
+// The parsed paths of the path strings, which are usually the same for all the rows.
+class JsonPaths {
+public:
+    const std::vector<JsonPath>& get(const std::string_view& path_string) {
+        if (!_parsed || path_string != _path_string) {
+            auto tok = get_json_token(path_string);
+            std::vector<std::string> paths(tok.begin(), tok.end());
+            _parsed_paths.clear();
+            get_parsed_paths(paths, &_parsed_paths);
+            _path_string = std::string(path_string);
+            _parsed = true;
+        }
+        return _parsed_paths;
+    }
 
-    auto tok = get_json_token(path_string);
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
+private:
+    bool _parsed = false;
+    std::string _path_string;
+    std::vector<JsonPath> _parsed_paths;
+};
 
-    if (!(*parsed_paths)[0].is_valid) {
-        return document;
+template <JsonFunctionType fntype>
+rapidjson::Value* get_json_object(JsonDocuments* documents, size_t row,
+                                  const std::vector<JsonPath>& parsed_paths) {
+    if (UNLIKELY(parsed_paths.empty()) || !parsed_paths[0].is_valid) {
+        return nullptr;
     }
 
-    if (UNLIKELY((*parsed_paths).size() == 1)) {
-        if (fntype == JSON_FUN_STRING) {
-            document->SetString(json_string.data(), document->GetAllocator());
-        } else {
-            return document;
-        }
+    // "$" returns the whole document only for the strings
+    if (UNLIKELY(parsed_paths.size() == 1) && fntype != JSON_FUN_STRING) {
+        return nullptr;
     }
 
-    document->Parse(json_string.data());
-    if (UNLIKELY(document->HasParseError())) {
-        // VLOG_CRITICAL << "Error at offset " << document->GetErrorOffset() << ": "
-        //         << GetParseError_En(document->GetParseError());
-        document->SetNull();
-        return document;
+    rapidjson::Document* document = documents->get(row);
+    if (UNLIKELY(document == nullptr)) {
+        return nullptr;
     }
 
-    return match_value(*parsed_paths, document, document->GetAllocator());
+    return match_value(parsed_paths, document, documents->allocator());
 }
 
 template <typename NumberType>
@@ -233,10 +248,9 @@ struct GetJsonNumberType {
                               NullMap& null_map) {
         size_t size = loffsets.size();
         res.resize(size);
+        auto documents = JsonDocumentsCache::of(context->impl()->state(), ldata, loffsets);
+        JsonPaths paths;
         for (size_t i = 0; i < size; ++i) {
-            const char* l_raw_str = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
-            int l_str_size = loffsets[i] - loffsets[i - 1] - 1;
-
             const char* r_raw_str = reinterpret_cast<const char*>(&rdata[roffsets[i - 1]]);
             int r_str_size = roffsets[i] - roffsets[i - 1] - 1;
 
@@ -245,17 +259,15 @@ struct GetJsonNumberType {
                 continue;
             }
 
-            std::string_view json_string(l_raw_str, l_str_size);
             std::string_view path_string(r_raw_str, r_str_size);
-
-            rapidjson::Document document;
+            const auto& parsed_paths = paths.get(path_string);
             rapidjson::Value* root = nullptr;
 
             if constexpr (std::is_same_v<double, typename NumberType::T>) {
-                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document);
+                root = get_json_object<JSON_FUN_DOUBLE>(documents.get(), i, parsed_paths);
                 handle_result<double>(root, res[i], null_map[i]);
             } else if constexpr (std::is_same_v<int32_t, typename NumberType::T>) {
-                root = get_json_object<JSON_FUN_DOUBLE>(json_string, path_string, &document);
+                root = get_json_object<JSON_FUN_DOUBLE>(documents.get(), i, parsed_paths);
                 handle_result<int32_t>(root, res[i], null_map[i]);
             }
         }
@@ -321,11 +333,10 @@ struct GetJsonString {
                               Offsets& res_offsets, NullMap& null_map) {
         size_t input_rows_count = loffsets.size();
         res_offsets.resize(input_rows_count);
+        auto documents = JsonDocumentsCache::of(context->impl()->state(), ldata, loffsets);
+        JsonPaths paths;
 
         for (size_t i = 0; i < input_rows_count; ++i) {
-            int l_size = loffsets[i] - loffsets[i - 1] - 1;
-            const auto l_raw = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
-
             int r_size = roffsets[i] - roffsets[i - 1] - 1;
             const auto r_raw = reinterpret_cast<const char*>(&rdata[roffsets[i - 1]]);
 
@@ -334,13 +345,9 @@ struct GetJsonString {
                 continue;
             }
 
-            std::string_view json_string(l_raw, l_size);
             std::string_view path_string(r_raw, r_size);
-
-            rapidjson::Document document;
-            rapidjson::Value* root = nullptr;
-
-            root = get_json_object<JSON_FUN_STRING>(json_string, path_string, &document);
+            rapidjson::Value* root =
+                    get_json_object<JSON_FUN_STRING>(documents.get(), i, paths.get(path_string));
             const int max_string_len = 65535;
 
             if (root == nullptr || root->IsNull()) {
@@ -362,6 +369,146 @@ struct GetJsonString {
     }
 };
 
+// Returns the value of the jsonb document at the path, or an invalid value if there is none. The
+// keys of objects and the indexes of arrays are supported, but not the keys over the objects of
+// an array like get_json_*.
+JsonbValue match_jsonb_value(const std::vector<JsonPath>& parsed_paths, JsonbValue value) {
+    if (UNLIKELY(parsed_paths.empty()) || !parsed_paths[0].is_valid) {
+        return JsonbValue();
+    }
+    for (int i = 1; i < parsed_paths.size() && value.is_valid(); i++) {
+        const JsonPath& path = parsed_paths[i];
+        if (UNLIKELY(!path.is_valid)) {
+            return JsonbValue();
+        }
+        if (LIKELY(!path.key.empty())) {
+            value = value.find(path.key);
+        }
+        if (UNLIKELY(path.idx >= 0)) {
+            value = value.at(path.idx);
+        } else if (UNLIKELY(path.idx == -2) && value.type() != JsonbValue::T_ARRAY) {
+            // [*] is the whole array
+            return JsonbValue();
+        }
+    }
+    return value;
+}
+
+struct JsonbParse {
+    static constexpr auto name = "jsonb_parse";
+    using ReturnType = DataTypeString;
+    using ColumnType = ColumnString;
+    static void vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                       ColumnString::Chars& res_data, ColumnString::Offsets& res_offsets,
+                       NullMap& null_map) {
+        size_t size = offsets.size();
+        res_offsets.resize(size);
+        std::string jsonb;
+        for (size_t i = 0; i < size; ++i) {
+            const char* raw_str = reinterpret_cast<const char*>(&data[offsets[i - 1]]);
+            size_t str_size = offsets[i] - offsets[i - 1] - 1;
+            if (JsonbValue::from_json(raw_str, str_size, &jsonb)) {
+                StringOP::push_value_string(jsonb, i, res_data, res_offsets);
+            } else {
+                StringOP::push_null_string(i, res_data, res_offsets, null_map);
+            }
+        }
+    }
+};
+
+template <typename NumberType>
+struct JsonbExtractNumber {
+    using Container = typename NumberType::ColumnType::Container;
+    static void vector_vector(FunctionContext* context, const ColumnString::Chars& ldata,
+                              const ColumnString::Offsets& loffsets,
+                              const ColumnString::Chars& rdata,
+                              const ColumnString::Offsets& roffsets, Container& res,
+                              NullMap& null_map) {
+        size_t size = loffsets.size();
+        res.resize_fill(size, 0);
+        JsonPaths paths;
+        for (size_t i = 0; i < size; ++i) {
+            if (null_map[i]) {
+                continue;
+            }
+            const char* l_raw_str = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
+            size_t l_str_size = loffsets[i] - loffsets[i - 1] - 1;
+            const char* r_raw_str = reinterpret_cast<const char*>(&rdata[roffsets[i - 1]]);
+            size_t r_str_size = roffsets[i] - roffsets[i - 1] - 1;
+
+            JsonbValue value =
+                    match_jsonb_value(paths.get(std::string_view(r_raw_str, r_str_size)),
+                                      JsonbValue::root(l_raw_str, l_str_size));
+            if constexpr (std::is_same_v<double, typename NumberType::T>) {
+                if (value.type() == JsonbValue::T_INT64 || value.type() == JsonbValue::T_DOUBLE) {
+                    res[i] = value.get_double();
+                } else {
+                    null_map[i] = 1;
+                }
+            } else {
+                int64_t number = value.get_int64();
+                if (value.type() == JsonbValue::T_INT64 &&
+                    number >= std::numeric_limits<int32_t>::min() &&
+                    number <= std::numeric_limits<int32_t>::max()) {
+                    res[i] = number;
+                } else {
+                    null_map[i] = 1;
+                }
+            }
+        }
+    }
+};
+
+struct JsonbExtractDouble : public JsonbExtractNumber<JsonNumberTypeDouble> {
+    static constexpr auto name = "jsonb_extract_double";
+    using ReturnType = typename JsonNumberTypeDouble::ReturnType;
+    using ColumnType = typename JsonNumberTypeDouble::ColumnType;
+};
+
+struct JsonbExtractInt : public JsonbExtractNumber<JsonNumberTypeInt> {
+    static constexpr auto name = "jsonb_extract_int";
+    using ReturnType = typename JsonNumberTypeInt::ReturnType;
+    using ColumnType = typename JsonNumberTypeInt::ColumnType;
+};
+
+struct JsonbExtractString {
+    static constexpr auto name = "jsonb_extract_string";
+    using ReturnType = DataTypeString;
+    using ColumnType = ColumnString;
+    using Chars = ColumnString::Chars;
+    using Offsets = ColumnString::Offsets;
+    static void vector_vector(FunctionContext* context, const Chars& ldata, const Offsets& loffsets,
+                              const Chars& rdata, const Offsets& roffsets, Chars& res_data,
+                              Offsets& res_offsets, NullMap& null_map) {
+        size_t size = loffsets.size();
+        res_offsets.resize(size);
+        JsonPaths paths;
+        std::string json;
+        for (size_t i = 0; i < size; ++i) {
+            if (null_map[i]) {
+                StringOP::push_null_string(i, res_data, res_offsets, null_map);
+                continue;
+            }
+            const char* l_raw_str = reinterpret_cast<const char*>(&ldata[loffsets[i - 1]]);
+            size_t l_str_size = loffsets[i] - loffsets[i - 1] - 1;
+            const char* r_raw_str = reinterpret_cast<const char*>(&rdata[roffsets[i - 1]]);
+            size_t r_str_size = roffsets[i] - roffsets[i - 1] - 1;
+
+            JsonbValue value =
+                    match_jsonb_value(paths.get(std::string_view(r_raw_str, r_str_size)),
+                                      JsonbValue::root(l_raw_str, l_str_size));
+            if (value.type() == JsonbValue::T_STRING) {
+                StringOP::push_value_string(value.get_string(), i, res_data, res_offsets);
+            } else if (value.is_valid() && value.type() != JsonbValue::T_NULL) {
+                value.to_json(&json);
+                StringOP::push_value_string(json, i, res_data, res_offsets);
+            } else {
+                StringOP::push_null_string(i, res_data, res_offsets, null_map);
+            }
+        }
+    }
+};
+
 template <int flag>
 struct JsonParser {
     //string
@@ -586,11 +733,19 @@ public:
 using FunctionGetJsonDouble = FunctionBinaryStringOperateToNullType<GetJsonDouble>;
 using FunctionGetJsonInt = FunctionBinaryStringOperateToNullType<GetJsonInt>;
 using FunctionGetJsonString = FunctionBinaryStringOperateToNullType<GetJsonString>;
+using FunctionJsonbParse = FunctionStringOperateToNullType<JsonbParse>;
+using FunctionJsonbExtractDouble = FunctionBinaryStringOperateToNullType<JsonbExtractDouble>;
+using FunctionJsonbExtractInt = FunctionBinaryStringOperateToNullType<JsonbExtractInt>;
+using FunctionJsonbExtractString = FunctionBinaryStringOperateToNullType<JsonbExtractString>;
 
 void register_function_json(SimpleFunctionFactory& factory) {
     factory.register_function<FunctionGetJsonInt>();
     factory.register_function<FunctionGetJsonDouble>();
     factory.register_function<FunctionGetJsonString>();
+    factory.register_function<FunctionJsonbParse>();
+    factory.register_function<FunctionJsonbExtractInt>();
+    factory.register_function<FunctionJsonbExtractDouble>();
+    factory.register_function<FunctionJsonbExtractString>();
 
     factory.register_function<FunctionJson<FunctionJsonImpl<FunctionJsonArrayImpl>>>();
     factory.register_function<FunctionJson<FunctionJsonImpl<FunctionJsonObjectImpl>>>();
@@ -269,22 +269,15 @@ struct NameToUpper {
     static constexpr auto name = "upper";
 };
 
-using char_transter_op = int (*)(int);
-template <char_transter_op op>
+// Changes the case of the ascii, Latin-1, Greek and Cyrillic letters of the utf-8 strings, whose
+// size stays the same, so the offsets are kept and the chars are transferred as a whole.
+template <bool to_upper>
 struct TransferImpl {
     static Status vector(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
                          ColumnString::Chars& res_data, ColumnString::Offsets& res_offsets) {
-        size_t offset_size = offsets.size();
-        res_offsets.resize(offsets.size());
-        for (size_t i = 0; i < offset_size; ++i) {
-            res_offsets[i] = offsets[i];
-        }
-
-        size_t data_length = data.size();
-        res_data.resize(data_length);
-        for (size_t i = 0; i < data_length; ++i) {
-            res_data[i] = op(data[i]);
-        }
+        res_offsets.assign(offsets);
+        res_data.resize(data.size());
+        simd::utf8_transfer_case<to_upper>(data.data(), data.size(), res_data.data());
         return Status::OK();
     }
 };
@@ -609,9 +602,9 @@ using FunctionReverse = FunctionStringToString<ReverseImpl, NameReverse>;
 
 using FunctionUnHex = FunctionStringOperateToNullType<UnHexImpl>;
 
-using FunctionToLower = FunctionStringToString<TransferImpl<::tolower>, NameToLower>;
+using FunctionToLower = FunctionStringToString<TransferImpl<false>, NameToLower>;
 
-using FunctionToUpper = FunctionStringToString<TransferImpl<::toupper>, NameToUpper>;
+using FunctionToUpper = FunctionStringToString<TransferImpl<true>, NameToUpper>;
 
 using FunctionLTrim = FunctionStringToString<TrimImpl<true, false>, NameLTrim>;
 
@@ -28,6 +28,7 @@
 #include "exprs/string_functions.h"
 #include "udf/udf.h"
 #include "util/md5.h"
+#include "util/simd/utf8.h"
 #include "util/sm3.h"
 #include "util/url_parser.h"
 #include "vec/columns/column_array.h"
@@ -87,12 +88,7 @@ inline size_t get_char_len(const StringVal& str, std::vector<size_t>* str_index)
 }
 
 inline size_t get_char_len(const StringValue& str, size_t end_pos) {
-    size_t char_len = 0;
-    for (size_t i = 0, char_size = 0; i < std::min(str.len, end_pos); i += char_size) {
-        char_size = get_utf8_byte_length((unsigned)(str.ptr)[i]);
-        ++char_len;
-    }
-    return char_len;
+    return simd::utf8_char_count(str.ptr, std::min(str.len, end_pos));
 }
 
 struct StringOP {
@@ -162,10 +158,9 @@ private:
         int size = offsets.size();
         res_offsets.resize(size);
         res_chars.reserve(chars.size());
-        std::vector<size_t> index;
 
         for (int i = 0; i < size; ++i) {
-            auto* raw_str = reinterpret_cast<const unsigned char*>(&chars[offsets[i - 1]]);
+            auto* raw_str = reinterpret_cast<const char*>(&chars[offsets[i - 1]]);
             int str_size = offsets[i] - offsets[i - 1] - 1;
             // return empty string if start > src.length
             if (start[i] > str_size) {
@@ -177,41 +172,25 @@ private:
                 StringOP::push_empty_string(i, res_chars, res_offsets);
                 continue;
             }
-            // reference to string_function.cpp: substring
-            size_t byte_pos = 0;
-            index.clear();
-            for (size_t j = 0, char_size = 0; j < str_size; j += char_size) {
-                char_size = get_utf8_byte_length((unsigned)(raw_str)[j]);
-                index.push_back(j);
-                if (start[i] > 0 && index.size() > start[i] + len[i]) {
-                    break;
-                }
-            }
-
-            int fixed_pos = start[i];
+            // reference to string_function.cpp: substring, the chars are located by counting
+            // them 16 bytes at a time instead of collecting the offsets of all of them
+            int64_t fixed_pos = start[i];
             if (fixed_pos < 0) {
-                fixed_pos = index.size() + fixed_pos + 1;
+                fixed_pos += static_cast<int64_t>(simd::utf8_char_count(raw_str, str_size)) + 1;
             }
-            if (fixed_pos > index.size()) {
+            // return null if the start is out of the string
+            size_t byte_pos = str_size;
+            if (fixed_pos > 0) {
+                byte_pos = simd::utf8_char_offset(raw_str, str_size, fixed_pos - 1);
+            }
+            if (byte_pos >= str_size) {
                 StringOP::push_null_string(i, res_chars, res_offsets, null_map);
                 continue;
             }
-
-            byte_pos = index[fixed_pos - 1];
-            int fixed_len = str_size - byte_pos;
-            if (fixed_pos + len[i] <= index.size()) {
-                fixed_len = index[fixed_pos + len[i] - 1] - byte_pos;
-            }
-
-            if (byte_pos <= str_size && fixed_len > 0) {
-                // return StringVal(str.ptr + byte_pos, fixed_len);
-                StringOP::push_value_string(
-                        std::string_view {reinterpret_cast<const char*>(raw_str + byte_pos),
-                                          (size_t)fixed_len},
-                        i, res_chars, res_offsets);
-            } else {
-                StringOP::push_empty_string(i, res_chars, res_offsets);
-            }
+            size_t fixed_len =
+                    simd::utf8_char_offset(raw_str + byte_pos, str_size - byte_pos, len[i]);
+            StringOP::push_value_string(std::string_view {raw_str + byte_pos, fixed_len}, i,
+                                        res_chars, res_offsets);
         }
     }
 };
@@ -21,6 +21,8 @@
 #include "geo/geo_types.h"
 #include "gutil/strings/substitute.h"
 #include "vec/columns/column_const.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
 #include "vec/functions/simple_function_factory.h"
 
 namespace doris::vectorized {
@@ -46,8 +48,7 @@ struct StPoint {
         GeoPoint point;
         std::string buf;
         for (int row = 0; row < size; ++row) {
-            auto cur_res = point.from_coord(column_x->operator[](row).get<Float64>(),
-                                            column_y->operator[](row).get<Float64>());
+            auto cur_res = point.from_coord(column_x->get_float64(row), column_y->get_float64(row));
             if (cur_res != GEO_PARSE_OK) {
                 res->insert_data(nullptr, 0);
                 continue;
@@ -182,7 +183,6 @@ struct StDistanceSphere {
     static const size_t NUM_ARGS = 4;
     static Status execute(Block& block, const ColumnNumbers& arguments, size_t result) {
         DCHECK_EQ(arguments.size(), 4);
-        auto return_type = remove_nullable(block.get_data_type(result));
 
         auto x_lng = block.get_by_position(arguments[0]).column->convert_to_full_column_if_const();
         auto x_lat = block.get_by_position(arguments[1]).column->convert_to_full_column_if_const();
@@ -191,23 +191,22 @@ struct StDistanceSphere {
 
         const auto size = x_lng->size();
 
-        MutableColumnPtr res = nullptr;
-        auto null_type = std::reinterpret_pointer_cast<const DataTypeNullable>(return_type);
-        res = ColumnNullable::create(return_type->create_column(), ColumnUInt8::create());
+        auto res = ColumnFloat64::create(size);
+        auto null_map = ColumnUInt8::create(size, 0);
+        auto& res_data = res->get_data();
+        auto& null_map_data = null_map->get_data();
 
         for (int row = 0; row < size; ++row) {
-            double distance = 0;
-            if (!GeoPoint::ComputeDistance(x_lng->operator[](row).get<Float64>(),
-                                           x_lat->operator[](row).get<Float64>(),
-                                           y_lng->operator[](row).get<Float64>(),
-                                           y_lat->operator[](row).get<Float64>(), &distance)) {
-                res->insert_data(nullptr, 0);
-                continue;
+            if (!GeoPoint::ComputeDistance(x_lng->get_float64(row), x_lat->get_float64(row),
+                                           y_lng->get_float64(row), y_lat->get_float64(row),
+                                           &res_data[row])) {
+                res_data[row] = 0;
+                null_map_data[row] = 1;
             }
-            res->insert_data(const_cast<const char*>((char*)&distance), 0);
         }
 
-        block.replace_by_position(result, std::move(res));
+        block.replace_by_position(result,
+                                  ColumnNullable::create(std::move(res), std::move(null_map)));
         return Status::OK();
     }
 };
@@ -329,31 +328,43 @@ struct StContains {
             return Status::OK();
         }
 
-        int i;
-        std::vector<std::shared_ptr<GeoShape>> shapes = {nullptr, nullptr};
+        auto res_data = ColumnUInt8::create(size, 0);
+        auto null_map = ColumnUInt8::create(size, 0);
+        auto& contains_data = res_data->get_data();
+        auto& null_map_data = null_map->get_data();
+
+        const GeoShape* shapes[2] = {nullptr, nullptr};
+        std::unique_ptr<GeoShape> row_shapes[2];
+        // the points of the rows are decoded into the same ones instead of new shapes
+        GeoPoint row_points[2];
+        const IColumn* columns[2] = {shape1.get(), shape2.get()};
         for (int row = 0; row < size; ++row) {
-            auto lhs_value = shape1->get_data_at(row);
-            auto rhs_value = shape2->get_data_at(row);
-            StringRef* strs[2] = {&lhs_value, &rhs_value};
-            for (i = 0; i < 2; ++i) {
+            int i = 0;
+            for (; i < 2; ++i) {
                 if (state != nullptr && state->shapes[i] != nullptr) {
-                    shapes[i] = state->shapes[i];
+                    shapes[i] = state->shapes[i].get();
+                    continue;
+                }
+                auto value = columns[i]->get_data_at(row);
+                if (value.size > 1 && value.data[1] == GEO_SHAPE_POINT) {
+                    shapes[i] = row_points[i].decode_from(value.data, value.size) ? &row_points[i]
+                                                                                  : nullptr;
                 } else {
-                    shapes[i] = std::shared_ptr<GeoShape>(
-                            GeoShape::from_encoded(strs[i]->data, strs[i]->size));
-                    if (shapes[i] == nullptr) {
-                        res->insert_data(nullptr, 0);
-                        break;
-                    }
+                    row_shapes[i].reset(GeoShape::from_encoded(value.data, value.size));
+                    shapes[i] = row_shapes[i].get();
+                }
+                if (shapes[i] == nullptr) {
+                    null_map_data[row] = 1;
+                    break;
                 }
             }
 
             if (i == 2) {
-                auto contains_value = shapes[0]->contains(shapes[1].get());
-                res->insert_data(const_cast<const char*>((char*)&contains_value), 0);
+                contains_data[row] = shapes[0]->contains(shapes[1]);
             }
         }
-        block.replace_by_position(result, std::move(res));
+        block.replace_by_position(result,
+                                  ColumnNullable::create(std::move(res_data), std::move(null_map)));
         return Status::OK();
     }
 
@@ -377,6 +388,9 @@ struct StContains {
                             std::shared_ptr<GeoShape>(GeoShape::from_encoded(str->ptr, str->len));
                     if (contains_ctx->shapes[i] == nullptr) {
                         contains_ctx->is_null = true;
+                    } else if (i == 0) {
+                        // a constant shape is tested against the shapes of all the rows
+                        contains_ctx->shapes[i]->prepare_contains();
                     }
                 }
             }
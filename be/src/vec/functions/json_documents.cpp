@@ -0,0 +1,115 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/functions/json_documents.h"
+
+#include <cstring>
+
+#include "runtime/memory/mem_tracker.h"
+#include "runtime/runtime_state.h"
+
+namespace doris::vectorized {
+
+JsonDocuments::JsonDocuments(const ColumnString::Chars& data,
+                             const ColumnString::Offsets& offsets, MemTracker* mem_tracker)
+        : _mem_tracker(mem_tracker), _rows(offsets.size()), _states(offsets.size(), UNPARSED) {
+    if (_mem_tracker != nullptr) {
+        _data_copy.assign(data);
+        _offsets_copy.assign(offsets);
+        _data = _data_copy.data();
+        _offsets = _offsets_copy.data();
+    } else {
+        _data = data.data();
+        _offsets = offsets.data();
+    }
+    _documents.reserve(_rows);
+    for (size_t i = 0; i < _rows; ++i) {
+        _documents.emplace_back(&_allocator);
+    }
+    if (_mem_tracker != nullptr) {
+        _consumed_bytes = _data_copy.allocated_bytes() + _offsets_copy.allocated_bytes() +
+                          _documents.capacity() * sizeof(rapidjson::Document) + _states.capacity();
+        _mem_tracker->consume(_consumed_bytes);
+    }
+}
+
+JsonDocuments::~JsonDocuments() {
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->release(_consumed_bytes);
+    }
+}
+
+bool JsonDocuments::is_of(const ColumnString::Chars& data,
+                          const ColumnString::Offsets& offsets) const {
+    return _mem_tracker != nullptr && data.size() == _data_copy.size() && offsets.size() == _rows &&
+           memcmp(offsets.data(), _offsets, _rows * sizeof(IColumn::Offset)) == 0 &&
+           memcmp(data.data(), _data, data.size()) == 0;
+}
+
+rapidjson::Document* JsonDocuments::get(size_t row) {
+    if (_states[row] == UNPARSED) {
+        // the strings are terminated by zeros
+        _documents[row].Parse(reinterpret_cast<const char*>(_data + _offsets[row - 1]));
+        _states[row] = _documents[row].HasParseError() ? INVALID : PARSED;
+        if (_mem_tracker != nullptr) {
+            // the documents of all the rows are in the chunks of the allocator
+            int64_t bytes = _allocator.Capacity() - _allocator_bytes;
+            _allocator_bytes += bytes;
+            _consumed_bytes += bytes;
+            _mem_tracker->consume(bytes);
+        }
+    }
+    return _states[row] == PARSED ? &_documents[row] : nullptr;
+}
+
+JsonDocumentsCache::JsonDocumentsCache(RuntimeState* state)
+        : _mem_tracker(std::make_unique<MemTracker>("JsonDocumentsCache",
+                                                    state->instance_mem_tracker())) {}
+
+JsonDocumentsCache::~JsonDocumentsCache() = default;
+
+std::shared_ptr<JsonDocuments> JsonDocumentsCache::of(RuntimeState* state,
+                                                      const ColumnString::Chars& data,
+                                                      const ColumnString::Offsets& offsets) {
+    if (state == nullptr || data.size() > MAX_CACHED_BYTES) {
+        return std::make_shared<JsonDocuments>(data, offsets, nullptr);
+    }
+    return state->json_documents_cache()->_get(data, offsets);
+}
+
+int64_t JsonDocumentsCache::consumption() const {
+    return _mem_tracker->consumption();
+}
+
+std::shared_ptr<JsonDocuments> JsonDocumentsCache::_get(const ColumnString::Chars& data,
+                                                        const ColumnString::Offsets& offsets) {
+    std::lock_guard<std::mutex> l(_lock);
+    for (auto& documents : _cached) {
+        // the documents parse lazily, so they are not shared by the scanners of columns with the
+        // same strings while another one is using them
+        if (documents != nullptr && documents.use_count() == 1 &&
+            documents->is_of(data, offsets)) {
+            return documents;
+        }
+    }
+    auto documents = std::make_shared<JsonDocuments>(data, offsets, _mem_tracker.get());
+    _cached[_next_evicted] = documents;
+    _next_evicted = (_next_evicted + 1) % MAX_CACHED_COLUMNS;
+    return documents;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,105 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <rapidjson/document.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "vec/columns/column_string.h"
+
+namespace doris {
+
+class MemTracker;
+class RuntimeState;
+
+namespace vectorized {
+
+// The json documents of the strings of a column, each parsed on the first access.
+class JsonDocuments {
+public:
+    // The documents of a cached column keep a copy of the strings, so that a later column can be
+    // compared with them, and consume their memory on the tracker. The others read the strings
+    // of the column, which must outlive them.
+    JsonDocuments(const ColumnString::Chars& data, const ColumnString::Offsets& offsets,
+                  MemTracker* mem_tracker);
+
+    ~JsonDocuments();
+
+    // Whether the column has the strings of the documents.
+    bool is_of(const ColumnString::Chars& data, const ColumnString::Offsets& offsets) const;
+
+    // Returns the document of the string of the row, or nullptr if it's not valid json.
+    rapidjson::Document* get(size_t row);
+
+    rapidjson::Document::AllocatorType& allocator() { return _allocator; }
+
+private:
+    enum State : uint8_t { UNPARSED, PARSED, INVALID };
+
+    MemTracker* _mem_tracker;
+    int64_t _consumed_bytes = 0;
+    int64_t _allocator_bytes = 0;
+    ColumnString::Chars _data_copy;
+    ColumnString::Offsets _offsets_copy;
+    const UInt8* _data;
+    // offsets[-1] is 0 for the start of the first string
+    const IColumn::Offset* _offsets;
+    size_t _rows;
+    // shared by the documents, instead of a memory pool of at least 64KB for each document
+    rapidjson::Document::AllocatorType _allocator;
+    std::vector<rapidjson::Document> _documents;
+    std::vector<State> _states;
+};
+
+// The documents of the last few json columns of a fragment instance, so the get_json_* functions
+// extracting different paths from the same json column of a block, e.g. several fields of a log,
+// parse each string once instead of once for each function.
+class JsonDocumentsCache {
+public:
+    explicit JsonDocumentsCache(RuntimeState* state);
+
+    ~JsonDocumentsCache();
+
+    // Returns the documents of the column, from the cache of the fragment instance of the state,
+    // or not cached if there is no state.
+    static std::shared_ptr<JsonDocuments> of(RuntimeState* state, const ColumnString::Chars& data,
+                                             const ColumnString::Offsets& offsets);
+
+    int64_t consumption() const;
+
+private:
+    // at most MAX_CACHED_COLUMNS columns whose chars are at most MAX_CACHED_BYTES are kept
+    static constexpr size_t MAX_CACHED_COLUMNS = 2;
+    static constexpr size_t MAX_CACHED_BYTES = 16 * 1024 * 1024;
+
+    std::shared_ptr<JsonDocuments> _get(const ColumnString::Chars& data,
+                                        const ColumnString::Offsets& offsets);
+
+    std::unique_ptr<MemTracker> _mem_tracker;
+    // the scanners of a fragment instance evaluate their conjuncts in parallel
+    std::mutex _lock;
+    // the cache holds the only reference to the documents no one is using
+    std::shared_ptr<JsonDocuments> _cached[MAX_CACHED_COLUMNS];
+    size_t _next_evicted = 0;
+};
+
+} // namespace vectorized
+} // namespace doris
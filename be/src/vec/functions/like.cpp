@@ -354,4 +354,12 @@ Status FunctionRegexp::regexp_fn(LikeSearchState* state, const StringValue& val,
     }
 }
 
+void register_function_like(SimpleFunctionFactory& factory) {
+    factory.register_function<FunctionLike>();
+}
+
+void register_function_regexp(SimpleFunctionFactory& factory) {
+    factory.register_function<FunctionRegexp>();
+}
+
 } // namespace doris::vectorized
@@ -117,6 +117,10 @@ public:
 
     Status prepare(FunctionContext* context, FunctionContext::FunctionStateScope scope) override;
 
+    // Converts a LIKE pattern to a regex of RE2, which matches the whole string.
+    static void convert_like_pattern(LikeSearchState* state, const std::string& pattern,
+                                     std::string* re_pattern);
+
 private:
     static Status like_fn(LikeSearchState* state, const StringValue& val,
                           const StringValue& pattern, unsigned char* result);
@@ -124,9 +128,6 @@ private:
     static Status constant_regex_full_fn(LikeSearchState* state, const StringValue& val,
                                          const StringValue& pattern, unsigned char* result);
 
-    static void convert_like_pattern(LikeSearchState* state, const std::string& pattern,
-                                     std::string* re_pattern);
-
     static void remove_escape_character(std::string* search_string);
 };
 
@@ -148,11 +149,4 @@ private:
                                             const StringValue& pattern, unsigned char* result);
 };
 
-void register_function_like(SimpleFunctionFactory& factory) {
-    factory.register_function<FunctionLike>();
-}
-
-void register_function_regexp(SimpleFunctionFactory& factory) {
-    factory.register_function<FunctionRegexp>();
-}
 } // namespace doris::vectorized
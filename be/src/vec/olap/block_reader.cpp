@@ -191,7 +191,15 @@ Status BlockReader::_agg_key_next_block(Block* block, MemPool* mem_pool, ObjectP
     _append_agg_data(target_columns);
 
     while (true) {
-        auto res = _vcollect_iter.next(&_next_row);
+        // the rows after this one that are before the rows of the other rowsets each have a key
+        // of their own
+        int run_rows = _vcollect_iter.next_run_rows(_batch_size - target_block_row);
+        if (run_rows > 0) {
+            _append_agg_run(target_columns, run_rows);
+            target_block_row += run_rows;
+        }
+
+        auto res = _vcollect_iter.next(&_next_row, run_rows);
         if (UNLIKELY(res.precise_code() == OLAP_ERR_DATA_EOF)) {
             *eof = true;
             break;
@@ -241,8 +249,14 @@ Status BlockReader::_unique_key_next_block(Block* block, MemPool* mem_pool, Obje
 
         // the version is in reverse order, the first row is the highest version,
         // in UNIQUE_KEY highest version is the final result, there is no need to
-        // merge the lower versions
-        auto res = _vcollect_iter.next(&_next_row);
+        // merge the lower versions. The rows after this one that are before the rows of the
+        // other rowsets have no lower versions and are copied at once.
+        int run_rows = _vcollect_iter.next_run_rows(_batch_size - target_block_row);
+        if (run_rows > 0) {
+            _insert_range_normal(target_columns, run_rows);
+            target_block_row += run_rows;
+        }
+        auto res = _vcollect_iter.next(&_next_row, run_rows);
         if (UNLIKELY(res.precise_code() == OLAP_ERR_DATA_EOF)) {
             *eof = true;
             break;
@@ -265,6 +279,24 @@ void BlockReader::_insert_data_normal(MutableColumns& columns) {
     }
 }
 
+void BlockReader::_insert_range_normal(MutableColumns& columns, int rows) {
+    auto block = _next_row.block.get();
+    for (auto idx : _normal_columns_idx) {
+        columns[_return_columns_loc[idx]]->insert_range_from(*block->get_by_position(idx).column,
+                                                             _next_row.row_pos + 1, rows);
+    }
+}
+
+void BlockReader::_append_agg_run(MutableColumns& columns, int rows) {
+    _insert_range_normal(columns, rows);
+    for (int i = 0; i < rows; ++i) {
+        _agg_data_counters.push_back(_last_agg_data_counter);
+        _last_agg_data_counter = 0;
+        _next_row.row_pos++;
+        _append_agg_data(columns);
+    }
+}
+
 void BlockReader::_append_agg_data(MutableColumns& columns) {
     _stored_row_ref.push_back(_next_row);
     _last_agg_data_counter++;
@@ -68,6 +68,13 @@ private:
 
     void _insert_data_normal(MutableColumns& columns);
 
+    // inserts the normal columns of the rows after `_next_row` in its block
+    void _insert_range_normal(MutableColumns& columns, int rows);
+
+    // appends the rows after `_next_row` in its block, each of which has a key of its own, and
+    // moves `_next_row` to the last of them
+    void _append_agg_run(MutableColumns& columns, int rows);
+
     void _append_agg_data(MutableColumns& columns);
 
     void _update_agg_data(MutableColumns& columns);
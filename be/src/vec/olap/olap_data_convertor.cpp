@@ -34,6 +34,14 @@ OlapBlockDataConvertor::OlapBlockDataConvertor(const TabletSchema* tablet_schema
     }
 }
 
+OlapBlockDataConvertor::OlapBlockDataConvertor(const TabletSchema* tablet_schema,
+                                               const std::vector<uint32_t>& column_ids) {
+    assert(tablet_schema);
+    for (auto cid : column_ids) {
+        _convertors.emplace_back(create_olap_column_data_convertor(tablet_schema->column(cid)));
+    }
+}
+
 OlapBlockDataConvertor::OlapColumnDataConvertorBaseUPtr
 OlapBlockDataConvertor::create_olap_column_data_convertor(const TabletColumn& column) {
     switch (column.type()) {
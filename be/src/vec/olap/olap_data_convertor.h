@@ -47,6 +47,9 @@ public:
 class OlapBlockDataConvertor {
 public:
     OlapBlockDataConvertor(const TabletSchema* tablet_schema);
+    // convert the blocks of the columns 'column_ids' of the schema only
+    OlapBlockDataConvertor(const TabletSchema* tablet_schema,
+                           const std::vector<uint32_t>& column_ids);
     void set_source_content(const vectorized::Block* block, size_t row_pos, size_t num_rows);
     void clear_source_content();
     std::pair<Status, IOlapColumnDataAccessor*> convert_column_data(size_t cid);
@@ -0,0 +1,148 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/row_store.h"
+
+#include "util/coding.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/assert_cast.h"
+
+namespace doris {
+
+namespace vectorized {
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "the fixed width values are stored with their in-memory bytes");
+
+static void encode_value(const IColumn& column, size_t row, std::string* dst) {
+    const IColumn* value_column = &column;
+    if (const auto* nullable = check_and_get_column<ColumnNullable>(column)) {
+        bool is_null = nullable->is_null_at(row);
+        dst->push_back(is_null ? 1 : 0);
+        if (is_null) {
+            return;
+        }
+        value_column = &nullable->get_nested_column();
+    }
+    StringRef value = value_column->get_data_at(row);
+    if (!value_column->is_fixed_and_contiguous()) {
+        put_varint32(dst, value.size);
+    }
+    dst->append(value.data, value.size);
+}
+
+static Status decode_value(const uint8_t** pos, const uint8_t* end, IColumn* column) {
+    IColumn* value_column = column;
+    ColumnNullable* nullable =
+            column->is_nullable() ? assert_cast<ColumnNullable*>(column) : nullptr;
+    if (nullable != nullptr) {
+        if (*pos == end) {
+            return Status::Corruption("bad row store value: missing null flag");
+        }
+        if (*(*pos)++ != 0) {
+            nullable->insert_default();
+            return Status::OK();
+        }
+        value_column = &nullable->get_nested_column();
+    }
+    uint32_t size = 0;
+    if (value_column->is_fixed_and_contiguous()) {
+        size = value_column->size_of_value_if_fixed();
+    } else {
+        *pos = decode_varint32_ptr(*pos, end, &size);
+        if (*pos == nullptr) {
+            return Status::Corruption("bad row store value: invalid length");
+        }
+    }
+    if (static_cast<size_t>(end - *pos) < size) {
+        return Status::Corruption("bad row store value: {} bytes are left instead of {}",
+                                  end - *pos, size);
+    }
+    value_column->insert_data(reinterpret_cast<const char*>(*pos), size);
+    if (nullable != nullptr) {
+        nullable->get_null_map_data().push_back(0);
+    }
+    *pos += size;
+    return Status::OK();
+}
+
+Status RowStore::check_schema(const TabletSchema& schema) {
+    for (size_t cid = 0; cid < schema.num_columns(); ++cid) {
+        switch (schema.column(cid).type()) {
+        // the complex columns have no encoding in the row store
+        case OLAP_FIELD_TYPE_OBJECT:
+        case OLAP_FIELD_TYPE_HLL:
+        case OLAP_FIELD_TYPE_QUANTILE_STATE:
+        case OLAP_FIELD_TYPE_STRUCT:
+        case OLAP_FIELD_TYPE_ARRAY:
+        case OLAP_FIELD_TYPE_MAP:
+            return Status::NotSupported("column {} can't be stored in the row store",
+                                        schema.column(cid).name());
+        default:
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+void RowStore::encode_rows(const TabletSchema& schema, const Block& block, size_t row_pos,
+                           size_t num_rows, ColumnString* dst) {
+    DCHECK(schema.has_row_store_column());
+    DCHECK_EQ(block.columns(), schema.num_columns());
+    size_t row_store_col_idx = schema.row_store_col_idx();
+    std::vector<ColumnPtr> columns;
+    for (size_t cid = 0; cid < block.columns(); ++cid) {
+        if (cid != row_store_col_idx) {
+            columns.push_back(block.get_by_position(cid).column->convert_to_full_column_if_const());
+        }
+    }
+    std::string row;
+    for (size_t i = row_pos; i < row_pos + num_rows; ++i) {
+        row.clear();
+        row.push_back(ROW_ENCODING_V1);
+        put_varint32(&row, columns.size());
+        for (const auto& column : columns) {
+            encode_value(*column, i, &row);
+        }
+        dst->insert_data(row.data(), row.size());
+    }
+}
+
+Status RowStore::decode_row(const StringRef& row, MutableColumns& columns) {
+    const auto* pos = reinterpret_cast<const uint8_t*>(row.data);
+    const auto* end = pos + row.size;
+    if (pos == end || *pos != ROW_ENCODING_V1) {
+        return Status::Corruption("bad row store value: unknown version {}",
+                                  pos == end ? 0 : static_cast<int>(*pos));
+    }
+    uint32_t num_values = 0;
+    pos = decode_varint32_ptr(pos + 1, end, &num_values);
+    if (pos == nullptr || num_values != columns.size()) {
+        return Status::Corruption("bad row store value: {} values are stored instead of {}",
+                                  num_values, columns.size());
+    }
+    for (auto& column : columns) {
+        RETURN_IF_ERROR(decode_value(&pos, end, column.get()));
+    }
+    if (pos != end) {
+        return Status::Corruption("bad row store value: {} bytes are left", end - pos);
+    }
+    return Status::OK();
+}
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,60 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "common/status.h"
+#include "olap/tablet_schema.h"
+#include "vec/columns/column_string.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+namespace vectorized {
+
+// Encodes the rows of a tablet into, and decodes them from, the hidden row store column of its
+// schema, so that a whole row can be fetched with a single page read instead of one per column.
+//
+// The rows are stored in segment files, so their encoding doesn't depend on the in-memory layout
+// of the columns:
+//     Row := Version(1) NumValues(varint32) Value*
+//     Value := [IsNull(1)] [Body]
+// The values are those of all the other columns, in the order of the schema. IsNull is only
+// present for the nullable columns, it is 1 for a null, which has no Body. The Body of a fixed
+// width value (numbers, decimals, dates) is its little endian bytes, the Body of a string is its
+// length as a varint32 followed by its bytes.
+class RowStore {
+public:
+    // The only version of the row encoding so far.
+    static constexpr uint8_t ROW_ENCODING_V1 = 1;
+
+    // Returns error if some column of `schema` can't be encoded into the row store.
+    static Status check_schema(const TabletSchema& schema);
+
+    // Appends the rows [row_pos, row_pos + num_rows) of `block`, whose columns are those of
+    // `schema`, encoded to `dst`.
+    static void encode_rows(const TabletSchema& schema, const Block& block, size_t row_pos,
+                            size_t num_rows, ColumnString* dst);
+
+    // Appends the values of the encoded `row` to `columns`, which are the columns of the schema
+    // the row was encoded with, except the row store column. Returns Corruption if the row is
+    // not a valid encoding of such values, `columns` may have been partially appended to then.
+    static Status decode_row(const StringRef& row, MutableColumns& columns);
+};
+
+} // namespace vectorized
+} // namespace doris
@@ -125,9 +125,12 @@ bool VCollectIterator::LevelIteratorComparator::operator()(LevelIterator* lhs, L
     const IteratorRowRef& lhs_ref = *lhs->current_row_ref();
     const IteratorRowRef& rhs_ref = *rhs->current_row_ref();
 
-    int cmp_res =
-            lhs_ref.block->compare_at(lhs_ref.row_pos, rhs_ref.row_pos,
-                                      lhs->tablet_schema().num_key_columns(), *rhs_ref.block, -1);
+    int cmp_res = _zorder_comparator != nullptr
+                          ? _zorder_comparator->compare_at(lhs_ref.row_pos, rhs_ref.row_pos,
+                                                           *lhs_ref.block, *rhs_ref.block)
+                          : lhs_ref.block->compare_at(lhs_ref.row_pos, rhs_ref.row_pos,
+                                                      lhs->tablet_schema().num_key_columns(),
+                                                      *rhs_ref.block, -1);
     if (cmp_res != 0) {
         return cmp_res > 0;
     }
@@ -168,6 +171,18 @@ Status VCollectIterator::next(IteratorRowRef* ref) {
     }
 }
 
+int VCollectIterator::next_run_rows(int max_rows) {
+    return LIKELY(_inner_iter) ? _inner_iter->next_run_rows(max_rows) : 0;
+}
+
+Status VCollectIterator::next(IteratorRowRef* ref, int run_rows) {
+    if (LIKELY(_inner_iter)) {
+        return _inner_iter->next(ref, run_rows);
+    } else {
+        return Status::OLAPInternalError(OLAP_ERR_DATA_EOF);
+    }
+}
+
 Status VCollectIterator::next(Block* block) {
     if (LIKELY(_inner_iter)) {
         return _inner_iter->next(block);
@@ -261,6 +276,10 @@ VCollectIterator::Level1Iterator::~Level1Iterator() {
         }
     }
 
+    if (_cur_child_popped) {
+        delete _cur_child;
+    }
+
     if (_heap) {
         while (!_heap->empty()) {
             auto child = _heap->top();
@@ -303,6 +322,69 @@ Status VCollectIterator::Level1Iterator::next(Block* block) {
     }
 }
 
+int VCollectIterator::Level1Iterator::next_run_rows(int max_rows) {
+    if (UNLIKELY(_cur_child == nullptr || _cur_child_popped)) {
+        return 0;
+    }
+    int rows = std::min(max_rows, _cur_child->skippable_rows());
+    if (rows <= 0 || !_merge) {
+        return std::max(rows, 0);
+    }
+    if (_zorder_comparator != nullptr) {
+        return 0;
+    }
+
+    // the rows of the current child before the current row of the next child in the heap need no
+    // merging, the rows of all the other children are after that one
+    _heap->pop();
+    _cur_child_popped = true;
+    if (_heap->empty()) {
+        return rows;
+    }
+    const IteratorRowRef& cur_ref = *_cur_child->current_row_ref();
+    const IteratorRowRef& next_ref = *_heap->top()->current_row_ref();
+    int num_key_columns = _cur_child->tablet_schema().num_key_columns();
+    // a row with the same keys as the next one is left to the heap, which orders them by the
+    // sequence column and the version and marks the lower ones as the same
+    auto is_before_next = [&](int offset) {
+        return cur_ref.block->compare_at(cur_ref.row_pos + offset, next_ref.row_pos,
+                                         num_key_columns, *next_ref.block, -1) < 0;
+    };
+    if (!is_before_next(1)) {
+        return 0;
+    }
+    // the rows of the block are sorted, gallop to a row that is not before and search back
+    int before = 1;
+    int after = 2;
+    while (after <= rows && is_before_next(after)) {
+        before = after;
+        after *= 2;
+    }
+    after = std::min(after, rows + 1);
+    while (after - before > 1) {
+        int mid = before + (after - before) / 2;
+        if (is_before_next(mid)) {
+            before = mid;
+        } else {
+            after = mid;
+        }
+    }
+    return before;
+}
+
+Status VCollectIterator::Level1Iterator::next(IteratorRowRef* ref, int run_rows) {
+    if (UNLIKELY(_cur_child == nullptr)) {
+        _ref.row_pos = -1;
+        return Status::OLAPInternalError(OLAP_ERR_DATA_EOF);
+    }
+    _cur_child->skip_rows(run_rows);
+    if (_merge) {
+        return _merge_next(ref);
+    } else {
+        return _normal_next(ref);
+    }
+}
+
 int64_t VCollectIterator::Level1Iterator::version() const {
     if (_cur_child != nullptr) {
         return _cur_child->version();
@@ -324,7 +406,14 @@ Status VCollectIterator::Level1Iterator::init() {
                 break;
             }
         }
-        _heap.reset(new MergeHeap {LevelIteratorComparator(sequence_loc)});
+        const TabletSchema& tablet_schema = *_reader->_tablet_schema;
+        if (tablet_schema.sort_type() == SortType::ZORDER &&
+            tablet_schema.keys_type() == KeysType::DUP_KEYS) {
+            _zorder_comparator = std::make_unique<ZOrderComparator>(tablet_schema,
+                                                                    tablet_schema.sort_col_num());
+        }
+        _heap.reset(new MergeHeap {
+                LevelIteratorComparator(sequence_loc, _zorder_comparator.get())});
         for (auto child : _children) {
             DCHECK(child != nullptr);
             //DCHECK(child->current_row().ok());
@@ -343,7 +432,11 @@ Status VCollectIterator::Level1Iterator::init() {
 }
 
 Status VCollectIterator::Level1Iterator::_merge_next(IteratorRowRef* ref) {
-    _heap->pop();
+    if (_cur_child_popped) {
+        _cur_child_popped = false;
+    } else {
+        _heap->pop();
+    }
     auto res = _cur_child->next(ref);
     if (LIKELY(res.ok())) {
         _heap->push(_cur_child);
@@ -414,7 +507,16 @@ Status VCollectIterator::Level1Iterator::_merge_next(Block* block) {
                                            cur_row.row_pos);
         }
         ++target_block_row;
-        auto res = _merge_next(&cur_row);
+        // copy the rows that need no merging after this one at once
+        int run_rows = next_run_rows(_batch_size - target_block_row);
+        if (run_rows > 0) {
+            for (size_t i = 0; i < column_count; ++i) {
+                target_columns[i]->insert_range_from(*(src_block->get_by_position(i).column),
+                                                     cur_row.row_pos + 1, run_rows);
+            }
+            target_block_row += run_rows;
+        }
+        auto res = next(&cur_row, run_rows);
         if (UNLIKELY(res.precise_code() == OLAP_ERR_DATA_EOF)) {
             return res;
         }
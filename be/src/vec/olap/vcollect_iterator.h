@@ -27,6 +27,7 @@
 #include "olap/reader.h"
 #include "olap/rowset/rowset_reader.h"
 #include "vec/core/block.h"
+#include "vec/olap/zorder_comparator.h"
 
 namespace doris {
 
@@ -60,6 +61,14 @@ public:
     //      Others when error happens
     Status next(IteratorRowRef* ref);
 
+    // Returns the number of rows after the current row in its block, at most max_rows, that come
+    // before the current rows of all the other rowsets, so that they can be read from the block in
+    // one go instead of through the merge heap. next(ref, run_rows) must be called next to move
+    // past them to the row after.
+    int next_run_rows(int max_rows);
+
+    Status next(IteratorRowRef* ref, int run_rows);
+
     Status next(Block* block);
 
     bool is_merge() const { return _merge; }
@@ -89,6 +98,12 @@ private:
 
         bool is_same() { return _ref.is_same; }
 
+        // The number of rows after the current row in the block of current_row_ref() that
+        // skip_rows() can move over, only the iterators reading a rowset directly can.
+        virtual int skippable_rows() const { return 0; }
+
+        virtual void skip_rows(int rows) { DCHECK_EQ(rows, 0); }
+
         virtual ~LevelIterator() = default;
 
         const TabletSchema& tablet_schema() const { return _schema; };
@@ -102,12 +117,16 @@ private:
     // if row cursors equal, compare data version.
     class LevelIteratorComparator {
     public:
-        LevelIteratorComparator(int sequence = -1) : _sequence(sequence) {}
+        LevelIteratorComparator(int sequence = -1,
+                                const ZOrderComparator* zorder_comparator = nullptr)
+                : _sequence(sequence), _zorder_comparator(zorder_comparator) {}
 
         bool operator()(LevelIterator* lhs, LevelIterator* rhs);
 
     private:
         int _sequence;
+        // compares the rows by z-order instead of by the keys when not null
+        const ZOrderComparator* _zorder_comparator;
     };
 
 #ifdef USE_LIBCPP
@@ -132,6 +151,12 @@ private:
 
         Status next(Block* block) override;
 
+        int skippable_rows() const override {
+            return _ref.row_pos < 0 ? 0 : _block->rows() - _ref.row_pos - 1;
+        }
+
+        void skip_rows(int rows) override { _ref.row_pos += rows; }
+
     private:
         Status _refresh_current_row();
 
@@ -154,6 +179,11 @@ private:
 
         Status next(Block* block) override;
 
+        // See VCollectIterator::next_run_rows().
+        int next_run_rows(int max_rows);
+
+        Status next(IteratorRowRef* ref, int run_rows);
+
         ~Level1Iterator();
 
     private:
@@ -181,14 +211,19 @@ private:
         bool _merge = true;
 
         bool _skip_same;
+        // used by `_heap` when the tablet is sorted by z-order
+        std::unique_ptr<ZOrderComparator> _zorder_comparator;
         // used when `_merge == true`
         std::unique_ptr<MergeHeap> _heap;
+        // whether next_run_rows() has popped `_cur_child` from `_heap` to find the rows of the
+        // other children, next() pushes it back then
+        bool _cur_child_popped = false;
 
         // batch size, get from TabletReader
         int _batch_size;
     };
 
-    std::unique_ptr<LevelIterator> _inner_iter;
+    std::unique_ptr<Level1Iterator> _inner_iter;
 
     // Each LevelIterator corresponds to a rowset reader,
     // it will be cleared after '_inner_iter' has been initialized.
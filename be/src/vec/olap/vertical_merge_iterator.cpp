@@ -0,0 +1,347 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/vertical_merge_iterator.h"
+
+#include "io/fs/local_file_system.h"
+#include "olap/tablet_schema.h"
+#include "vec/aggregate_functions/aggregate_function_reader.h"
+
+namespace doris::vectorized {
+
+// the number of row sources read at a time
+static constexpr size_t ROW_SOURCES_BATCH_SIZE = 4096;
+
+RowSourcesBuffer::RowSourcesBuffer(std::string tmp_path, size_t max_memory_bytes)
+        : _tmp_path(std::move(tmp_path)),
+          _max_memory_sources(std::max<size_t>(1, max_memory_bytes / sizeof(RowSource))) {}
+
+RowSourcesBuffer::~RowSourcesBuffer() {
+    if (_file_writer != nullptr) {
+        WARN_IF_ERROR(_file_writer->close(), "failed to close " + _tmp_path);
+        WARN_IF_ERROR(io::global_local_filesystem()->delete_file(_tmp_path),
+                      "failed to delete " + _tmp_path);
+    }
+}
+
+Status RowSourcesBuffer::append(RowSource source) {
+    _sources.push_back(source);
+    ++_total_size;
+    if (_sources.size() >= _max_memory_sources) {
+        RETURN_IF_ERROR(_spill());
+    }
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::_spill() {
+    if (_file_writer == nullptr) {
+        RETURN_IF_ERROR(io::global_local_filesystem()->create_file(_tmp_path, &_file_writer));
+    }
+    RETURN_IF_ERROR(_file_writer->append(
+            Slice(reinterpret_cast<const char*>(_sources.data()),
+                  _sources.size() * sizeof(RowSource))));
+    _sources.clear();
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::flush() {
+    if (_file_writer != nullptr) {
+        if (!_sources.empty()) {
+            RETURN_IF_ERROR(_spill());
+        }
+        RETURN_IF_ERROR(_file_writer->close());
+    }
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::create_reader(std::unique_ptr<Reader>* reader) const {
+    reader->reset(new Reader());
+    (*reader)->_buffer = this;
+    if (_file_writer != nullptr) {
+        RETURN_IF_ERROR(
+                io::global_local_filesystem()->open_file(_tmp_path, &(*reader)->_file_reader));
+    }
+    return Status::OK();
+}
+
+Status RowSourcesBuffer::Reader::next_batch(std::vector<RowSource>* sources) {
+    size_t num_sources = std::min<uint64_t>(ROW_SOURCES_BATCH_SIZE, _buffer->_total_size - _offset);
+    if (_file_reader == nullptr) {
+        auto begin = _buffer->_sources.begin() + _offset;
+        sources->assign(begin, begin + num_sources);
+    } else {
+        sources->resize(num_sources);
+        size_t bytes_to_read = num_sources * sizeof(RowSource);
+        size_t bytes_read = 0;
+        RETURN_IF_ERROR(_file_reader->read_at(
+                _offset * sizeof(RowSource),
+                Slice(reinterpret_cast<char*>(sources->data()), bytes_to_read), &bytes_read));
+        if (bytes_read != bytes_to_read) {
+            return Status::IOError("failed to read row sources from {}, read {} of {} bytes",
+                                   _file_reader->path().native(), bytes_read, bytes_to_read);
+        }
+    }
+    _offset += num_sources;
+    return Status::OK();
+}
+
+std::vector<VerticalMergeSource> vertical_merge_sources(
+        const std::vector<RowsetSharedPtr>& rowsets) {
+    std::vector<VerticalMergeSource> sources;
+    for (auto& rowset : rowsets) {
+        if (rowset->num_segments() > 1 && rowset->rowset_meta()->is_segments_overlapping()) {
+            // the segments are merged one by one, like the segment iterators of a rowset reader
+            for (int64_t segment_id = 0; segment_id < rowset->num_segments(); ++segment_id) {
+                sources.push_back({rowset, segment_id});
+            }
+        } else if (rowset->num_segments() > 0) {
+            sources.push_back({rowset, -1});
+        }
+    }
+    return sources;
+}
+
+VerticalSourceReaders::VerticalSourceReaders(const TabletSchema* tablet_schema,
+                                             std::vector<uint32_t> column_ids,
+                                             ReaderType reader_type, int batch_size)
+        : _tablet_schema(tablet_schema),
+          _column_ids(std::move(column_ids)),
+          _batch_size(batch_size) {
+    _reader_context.reader_type = reader_type;
+    _reader_context.tablet_schema = tablet_schema;
+    // the segments of a source do not overlap, they are read one after another
+    _reader_context.need_ordered_result = false;
+    _reader_context.return_columns = &_column_ids;
+    _reader_context.seek_columns = &_column_ids;
+    _reader_context.stats = &_stats;
+    _reader_context.batch_size = batch_size;
+    _reader_context.is_vec = true;
+}
+
+Status VerticalSourceReaders::init(const std::vector<VerticalMergeSource>& sources) {
+    _cursors.resize(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        auto& cursor = _cursors[i];
+        cursor.source = i;
+        RETURN_IF_ERROR(sources[i].rowset->create_reader(&cursor.reader));
+        if (sources[i].segment_id >= 0) {
+            cursor.reader->set_segment_row_ranges({{sources[i].segment_id, {0, UINT32_MAX}}});
+        }
+        RETURN_IF_ERROR(cursor.reader->init(&_reader_context));
+        cursor.block = std::make_unique<Block>(_tablet_schema->create_block(_column_ids));
+        RETURN_IF_ERROR(cursor.refresh());
+    }
+    return Status::OK();
+}
+
+Status VerticalSourceReaders::Cursor::refresh() {
+    while (!eof && pos >= block->rows()) {
+        block->clear_column_data();
+        pos = 0;
+        auto res = reader->next_block(block.get());
+        if (!res.ok()) {
+            if (res.precise_code() != OLAP_ERR_DATA_EOF) {
+                return res;
+            }
+            // the last rows may come with EOF
+            eof = block->rows() == 0;
+        }
+    }
+    return Status::OK();
+}
+
+VerticalKeyMerger::VerticalKeyMerger(const TabletSchema* tablet_schema,
+                                     std::vector<uint32_t> column_ids, ReaderType reader_type,
+                                     int batch_size, int sequence_loc)
+        : VerticalSourceReaders(tablet_schema, std::move(column_ids), reader_type, batch_size),
+          _num_key_columns(tablet_schema->num_key_columns()),
+          _merge_same_keys(tablet_schema->keys_type() != KeysType::DUP_KEYS),
+          _heap(CursorComparator(_num_key_columns, sequence_loc)) {}
+
+Status VerticalKeyMerger::init(const std::vector<VerticalMergeSource>& sources) {
+    RETURN_IF_ERROR(VerticalSourceReaders::init(sources));
+    for (auto& cursor : _cursors) {
+        if (!cursor.eof) {
+            _heap.push(&cursor);
+        }
+    }
+    return Status::OK();
+}
+
+bool VerticalKeyMerger::CursorComparator::operator()(const Cursor* lhs, const Cursor* rhs) const {
+    int cmp_res = lhs->block->compare_at(lhs->pos, rhs->pos, _num_key_columns, *rhs->block, -1);
+    if (cmp_res != 0) {
+        return cmp_res > 0;
+    }
+    // the rows with the same key are merged from the highest sequence to the lowest, and then
+    // from the newest source to the oldest
+    if (_sequence_loc != -1) {
+        cmp_res = lhs->block->compare_column_at(lhs->pos, rhs->pos, _sequence_loc, *rhs->block,
+                                                -1);
+        if (cmp_res != 0) {
+            return cmp_res < 0;
+        }
+    }
+    return lhs->source < rhs->source;
+}
+
+bool VerticalKeyMerger::_same_as_last(const Cursor* cursor, const MutableColumns& columns) const {
+    size_t last = columns[0]->size() - 1;
+    for (size_t i = 0; i < _num_key_columns; ++i) {
+        if (columns[i]->compare_at(last, cursor->pos, *cursor->block->get_by_position(i).column,
+                                   -1) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status VerticalKeyMerger::_advance(Cursor* cursor) {
+    ++cursor->pos;
+    RETURN_IF_ERROR(cursor->refresh());
+    if (!cursor->eof) {
+        _heap.push(cursor);
+    }
+    return Status::OK();
+}
+
+Status VerticalKeyMerger::next_block(Block* block, RowSourcesBuffer* row_sources) {
+    auto columns = block->mutate_columns();
+    size_t num_rows = 0;
+    while (num_rows < _batch_size && !_heap.empty()) {
+        Cursor* cursor = _heap.top();
+        _heap.pop();
+        for (size_t i = 0; i < columns.size(); ++i) {
+            columns[i]->insert_from(*cursor->block->get_by_position(i).column, cursor->pos);
+        }
+        ++num_rows;
+        RETURN_IF_ERROR(row_sources->append(RowSource(cursor->source, false)));
+        RETURN_IF_ERROR(_advance(cursor));
+
+        // the rows with the same key are skipped here, so a key never spans two blocks
+        while (_merge_same_keys && !_heap.empty() && _same_as_last(_heap.top(), columns)) {
+            cursor = _heap.top();
+            _heap.pop();
+            RETURN_IF_ERROR(row_sources->append(RowSource(cursor->source, true)));
+            ++_merged_rows;
+            RETURN_IF_ERROR(_advance(cursor));
+        }
+    }
+    if (num_rows == 0) {
+        return Status::OLAPInternalError(OLAP_ERR_DATA_EOF);
+    }
+    return Status::OK();
+}
+
+VerticalValueMerger::VerticalValueMerger(const TabletSchema* tablet_schema,
+                                         std::vector<uint32_t> column_ids, ReaderType reader_type,
+                                         int batch_size)
+        : VerticalSourceReaders(tablet_schema, std::move(column_ids), reader_type, batch_size),
+          _keys_type(tablet_schema->keys_type()) {}
+
+VerticalValueMerger::~VerticalValueMerger() {
+    for (size_t i = 0; i < _agg_functions.size(); ++i) {
+        _agg_functions[i]->destroy(_agg_places[i]);
+        delete[] _agg_places[i];
+    }
+}
+
+Status VerticalValueMerger::init(const std::vector<VerticalMergeSource>& sources,
+                                 const RowSourcesBuffer& row_sources) {
+    RETURN_IF_ERROR(VerticalSourceReaders::init(sources));
+    RETURN_IF_ERROR(row_sources.create_reader(&_row_sources_reader));
+    if (_keys_type == KeysType::AGG_KEYS) {
+        auto block = _tablet_schema->create_block(_column_ids);
+        for (size_t i = 0; i < _column_ids.size(); ++i) {
+            const auto& column = _tablet_schema->column(_column_ids[i]);
+            auto function =
+                    column.get_aggregate_function({block.get_data_type(i)}, AGG_READER_SUFFIX);
+            if (function == nullptr) {
+                return Status::InternalError("no aggregate function of column {}", column.name());
+            }
+            AggregateDataPtr place = new char[function->size_of_data()];
+            function->create(place);
+            _agg_functions.push_back(function);
+            _agg_places.push_back(place);
+        }
+    }
+    return Status::OK();
+}
+
+void VerticalValueMerger::_insert_agg_result(MutableColumns& columns) {
+    for (size_t i = 0; i < _agg_functions.size(); ++i) {
+        _agg_functions[i]->insert_result_into(_agg_places[i], *columns[i]);
+        _agg_functions[i]->destroy(_agg_places[i]);
+        _agg_functions[i]->create(_agg_places[i]);
+    }
+}
+
+Status VerticalValueMerger::next_block(Block* block) {
+    auto columns = block->mutate_columns();
+    size_t num_rows = 0;
+    while (true) {
+        if (_row_sources_pos == _row_sources.size()) {
+            RETURN_IF_ERROR(_row_sources_reader->next_batch(&_row_sources));
+            _row_sources_pos = 0;
+            if (_row_sources.empty()) {
+                break;
+            }
+        }
+        RowSource row_source = _row_sources[_row_sources_pos];
+        // stop before the first row of a new key, so the rows of a key are in one block
+        if (!row_source.is_same() && num_rows == _batch_size) {
+            break;
+        }
+        ++_row_sources_pos;
+        if (row_source.source() >= _cursors.size() || _cursors[row_source.source()].eof) {
+            return Status::InternalError("source {} has less rows than its row sources",
+                                         row_source.source());
+        }
+        auto& cursor = _cursors[row_source.source()];
+
+        if (!row_source.is_same()) {
+            ++num_rows;
+            if (_keys_type != KeysType::AGG_KEYS) {
+                for (size_t i = 0; i < columns.size(); ++i) {
+                    columns[i]->insert_from(*cursor.block->get_by_position(i).column, cursor.pos);
+                }
+            } else if (_agg_pending) {
+                _insert_agg_result(columns);
+            }
+            _agg_pending = _keys_type == KeysType::AGG_KEYS;
+        }
+        // for UNIQUE_KEYS the rows with the same key as the row before are skipped
+        if (_keys_type == KeysType::AGG_KEYS) {
+            for (size_t i = 0; i < _agg_functions.size(); ++i) {
+                const IColumn* column = cursor.block->get_by_position(i).column.get();
+                _agg_functions[i]->add(_agg_places[i], &column, cursor.pos, nullptr);
+            }
+        }
+        ++cursor.pos;
+        RETURN_IF_ERROR(cursor.refresh());
+    }
+    if (_agg_pending) {
+        _insert_agg_result(columns);
+        _agg_pending = false;
+    }
+    if (num_rows == 0) {
+        return Status::OLAPInternalError(OLAP_ERR_DATA_EOF);
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,215 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "io/fs/file_reader.h"
+#include "io/fs/file_writer.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/rowset.h"
+#include "olap/rowset/rowset_reader.h"
+#include "olap/rowset/rowset_reader_context.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+class TabletSchema;
+
+namespace vectorized {
+
+// The source of a row read by the key merge of the vertical compaction: the input it is read
+// from, and whether it has the same key as the row merged before it. The rows with the same
+// key come out of the merge from the newest to the oldest.
+class RowSource {
+public:
+    static constexpr uint16_t MAX_SOURCE = 0x7FFF;
+
+    RowSource() = default;
+    RowSource(uint16_t source, bool is_same) : _data(source | (is_same ? 0x8000 : 0)) {}
+
+    uint16_t source() const { return _data & MAX_SOURCE; }
+    bool is_same() const { return _data & 0x8000; }
+
+private:
+    uint16_t _data = 0;
+};
+
+// The row sources of a vertical compaction in merge order. They are kept in memory up to
+// 'max_memory_bytes' and spilled to the temporary file 'tmp_path' beyond it, which is removed
+// with the buffer.
+class RowSourcesBuffer {
+public:
+    RowSourcesBuffer(std::string tmp_path, size_t max_memory_bytes);
+    ~RowSourcesBuffer();
+
+    Status append(RowSource source);
+
+    // must be called after the last source is appended
+    Status flush();
+
+    uint64_t total_size() const { return _total_size; }
+
+    // Reads the sources from the first one, a buffer may be read by several readers at the
+    // same time after it is flushed.
+    class Reader {
+    public:
+        // an empty 'sources' means all sources are read
+        Status next_batch(std::vector<RowSource>* sources);
+
+    private:
+        friend class RowSourcesBuffer;
+
+        const RowSourcesBuffer* _buffer = nullptr;
+        io::FileReaderSPtr _file_reader;
+        uint64_t _offset = 0;
+    };
+
+    Status create_reader(std::unique_ptr<Reader>* reader) const;
+
+private:
+    Status _spill();
+
+    std::string _tmp_path;
+    size_t _max_memory_sources;
+    std::vector<RowSource> _sources;
+    io::FileWriterPtr _file_writer;
+    uint64_t _total_size = 0;
+};
+
+// An input of the vertical compaction, which returns its rows in key order: a rowset whose
+// segments do not overlap, or one segment of a rowset.
+struct VerticalMergeSource {
+    RowsetSharedPtr rowset;
+    // -1 for all segments of the rowset
+    int64_t segment_id = -1;
+};
+
+// The sources of 'rowsets', ordered from the oldest to the newest.
+std::vector<VerticalMergeSource> vertical_merge_sources(
+        const std::vector<RowsetSharedPtr>& rowsets);
+
+// Reads a group of columns from each source of a vertical compaction.
+class VerticalSourceReaders {
+public:
+    VerticalSourceReaders(const TabletSchema* tablet_schema, std::vector<uint32_t> column_ids,
+                          ReaderType reader_type, int batch_size);
+
+    Status init(const std::vector<VerticalMergeSource>& sources);
+
+    const OlapReaderStatistics& stats() const { return _stats; }
+
+protected:
+    // The rows of a source, 'pos' is the next row in 'block'.
+    struct Cursor {
+        size_t source = 0;
+        RowsetReaderSharedPtr reader;
+        std::unique_ptr<Block> block;
+        size_t pos = 0;
+        // the source has no more rows
+        bool eof = false;
+
+        // make sure 'pos' is a row of 'block' unless eof
+        Status refresh();
+    };
+
+    const TabletSchema* _tablet_schema;
+    std::vector<uint32_t> _column_ids;
+    int _batch_size;
+    OlapReaderStatistics _stats;
+    RowsetReaderContext _reader_context;
+    std::vector<Cursor> _cursors;
+};
+
+// Merges the key group of the sources by a heap, and records the source of every row read.
+// The rows with the same key as the row before them are not returned for UNIQUE_KEYS and
+// AGG_KEYS, the group starts with the key columns, and ends with the sequence column if any.
+class VerticalKeyMerger : public VerticalSourceReaders {
+public:
+    VerticalKeyMerger(const TabletSchema* tablet_schema, std::vector<uint32_t> column_ids,
+                      ReaderType reader_type, int batch_size, int sequence_loc);
+
+    Status init(const std::vector<VerticalMergeSource>& sources);
+
+    // Returns EOF if there are no more rows in 'block'.
+    Status next_block(Block* block, RowSourcesBuffer* row_sources);
+
+    int64_t merged_rows() const { return _merged_rows; }
+
+private:
+    class CursorComparator {
+    public:
+        CursorComparator(size_t num_key_columns, int sequence_loc)
+                : _num_key_columns(num_key_columns), _sequence_loc(sequence_loc) {}
+
+        // whether 'lhs' is merged after 'rhs'
+        bool operator()(const Cursor* lhs, const Cursor* rhs) const;
+
+    private:
+        size_t _num_key_columns;
+        int _sequence_loc;
+    };
+
+    // whether the row of the cursor has the same key as the last one of 'columns'
+    bool _same_as_last(const Cursor* cursor, const MutableColumns& columns) const;
+
+    // move the cursor to its next row and put it back to the heap unless eof
+    Status _advance(Cursor* cursor);
+
+    size_t _num_key_columns;
+    bool _merge_same_keys;
+    int64_t _merged_rows = 0;
+    std::priority_queue<Cursor*, std::vector<Cursor*>, CursorComparator> _heap;
+};
+
+// Reads a group of value columns of the sources in the order of the row sources, the rows
+// with the same key are aggregated for AGG_KEYS, only the first of them is kept for
+// UNIQUE_KEYS.
+class VerticalValueMerger : public VerticalSourceReaders {
+public:
+    VerticalValueMerger(const TabletSchema* tablet_schema, std::vector<uint32_t> column_ids,
+                        ReaderType reader_type, int batch_size);
+    ~VerticalValueMerger();
+
+    Status init(const std::vector<VerticalMergeSource>& sources,
+                const RowSourcesBuffer& row_sources);
+
+    // Returns EOF if there are no more rows in 'block'.
+    Status next_block(Block* block);
+
+private:
+    void _insert_agg_result(MutableColumns& columns);
+
+    KeysType _keys_type;
+    std::unique_ptr<RowSourcesBuffer::Reader> _row_sources_reader;
+    std::vector<RowSource> _row_sources;
+    size_t _row_sources_pos = 0;
+
+    std::vector<AggregateFunctionPtr> _agg_functions;
+    std::vector<AggregateDataPtr> _agg_places;
+    // whether the rows of a key are being aggregated
+    bool _agg_pending = false;
+};
+
+} // namespace vectorized
+} // namespace doris
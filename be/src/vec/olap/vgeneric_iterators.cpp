@@ -21,6 +21,7 @@
 #include "olap/iterators.h"
 #include "olap/row.h"
 #include "olap/row_block2.h"
+#include "olap/tablet_schema.h"
 
 namespace doris {
 
@@ -119,10 +120,12 @@ Status VAutoIncrementIterator::init(const StorageReadOptions& opts) {
 //      }
 class VMergeIteratorContext {
 public:
-    VMergeIteratorContext(RowwiseIterator* iter, int sequence_id_idx, bool is_unique)
+    VMergeIteratorContext(RowwiseIterator* iter, int sequence_id_idx, bool is_unique,
+                          const ZOrderComparator* zorder_comparator)
             : _iter(iter),
               _sequence_id_idx(sequence_id_idx),
               _is_unique(is_unique),
+              _zorder_comparator(zorder_comparator),
               _num_columns(iter->schema().num_column_ids()),
               _num_key_columns(iter->schema().num_key_columns()) {}
 
@@ -161,8 +164,12 @@ public:
     Status init(const StorageReadOptions& opts);
 
     bool compare(const VMergeIteratorContext& rhs) const {
-        int cmp_res = this->_block.compare_at(_index_in_block, rhs._index_in_block,
-                                              _num_key_columns, rhs._block, -1);
+        int cmp_res = _zorder_comparator != nullptr
+                              ? _zorder_comparator->compare_at(_index_in_block,
+                                                               rhs._index_in_block, _block,
+                                                               rhs._block)
+                              : _block.compare_at(_index_in_block, rhs._index_in_block,
+                                                  _num_key_columns, rhs._block, -1);
         if (cmp_res != 0) {
             return cmp_res > 0;
         }
@@ -223,6 +230,8 @@ private:
 
     int _sequence_id_idx = -1;
     bool _is_unique = false;
+    // compares the rows by z-order instead of by the keys when not null
+    const ZOrderComparator* _zorder_comparator;
     bool _valid = false;
     mutable bool _skip = false;
     size_t _index_in_block = -1;
@@ -278,11 +287,17 @@ class VMergeIterator : public RowwiseIterator {
 public:
     // VMergeIterator takes the ownership of input iterators
     VMergeIterator(std::vector<RowwiseIterator*>& iters, int sequence_id_idx, bool is_unique,
-                   uint64_t* merged_rows)
+                   uint64_t* merged_rows, const TabletSchema* tablet_schema)
             : _origin_iters(iters),
               _sequence_id_idx(sequence_id_idx),
               _is_unique(is_unique),
-              _merged_rows(merged_rows) {}
+              _merged_rows(merged_rows) {
+        if (tablet_schema != nullptr && tablet_schema->sort_type() == SortType::ZORDER &&
+            tablet_schema->keys_type() == KeysType::DUP_KEYS) {
+            _zorder_comparator = std::make_unique<ZOrderComparator>(
+                    *tablet_schema, tablet_schema->sort_col_num());
+        }
+    }
 
     ~VMergeIterator() override {
         while (!_merge_heap.empty()) {
@@ -320,6 +335,7 @@ private:
     int _sequence_id_idx = -1;
     bool _is_unique = false;
     uint64_t* _merged_rows = nullptr;
+    std::unique_ptr<ZOrderComparator> _zorder_comparator;
 };
 
 Status VMergeIterator::init(const StorageReadOptions& opts) {
@@ -329,7 +345,8 @@ Status VMergeIterator::init(const StorageReadOptions& opts) {
     _schema = &(*_origin_iters.begin())->schema();
 
     for (auto iter : _origin_iters) {
-        auto ctx = std::make_unique<VMergeIteratorContext>(iter, _sequence_id_idx, _is_unique);
+        auto ctx = std::make_unique<VMergeIteratorContext>(iter, _sequence_id_idx, _is_unique,
+                                                           _zorder_comparator.get());
         RETURN_IF_ERROR(ctx->init(opts));
         if (!ctx->valid()) {
             continue;
@@ -430,11 +447,12 @@ Status VUnionIterator::next_batch(vectorized::Block* block) {
 }
 
 RowwiseIterator* new_merge_iterator(std::vector<RowwiseIterator*>& inputs, int sequence_id_idx,
-                                    bool is_unique, uint64_t* merged_rows) {
+                                    bool is_unique, uint64_t* merged_rows,
+                                    const TabletSchema* tablet_schema) {
     if (inputs.size() == 1) {
         return *(inputs.begin());
     }
-    return new VMergeIterator(inputs, sequence_id_idx, is_unique, merged_rows);
+    return new VMergeIterator(inputs, sequence_id_idx, is_unique, merged_rows, tablet_schema);
 }
 
 RowwiseIterator* new_union_iterator(std::vector<RowwiseIterator*>& inputs) {
@@ -16,6 +16,7 @@
 // under the License.
 
 #include "olap/iterators.h"
+#include "vec/olap/zorder_comparator.h"
 
 namespace doris {
 
@@ -27,8 +28,11 @@ namespace vectorized {
 //
 // Inputs iterators' ownership is taken by created merge iterator. And client
 // should delete returned iterator after usage.
+//
+// The rows are merged by the z-order of the tablet_schema when it is not null and sorted by it.
 RowwiseIterator* new_merge_iterator(std::vector<RowwiseIterator*>& inputs, int sequence_id_idx,
-                                    bool is_unique, uint64_t* merged_rows);
+                                    bool is_unique, uint64_t* merged_rows,
+                                    const TabletSchema* tablet_schema = nullptr);
 
 // Create a union iterator for input iterators. Union iterator will read
 // input iterators one by one.
@@ -0,0 +1,181 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/zorder_comparator.h"
+
+#include <cmath>
+#include <type_traits>
+
+#include "olap/tablet_schema.h"
+#include "util/bit_util.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/assert_cast.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+template <typename U, typename T>
+U shared_int_representation(T val) {
+    constexpr U mask = (U)1 << (sizeof(U) * 8 - 1);
+    constexpr int shift_size = sizeof(U) > sizeof(T) ? (sizeof(U) - sizeof(T)) * 8 : 0;
+    return (static_cast<U>(val) << shift_size) ^ mask;
+}
+
+// the values of the unsigned types are only shifted, as they have no sign bit
+template <typename U, typename T>
+U shared_uint_representation(T val) {
+    constexpr int shift_size = sizeof(U) > sizeof(T) ? (sizeof(U) - sizeof(T)) * 8 : 0;
+    return static_cast<U>(val) << shift_size;
+}
+
+template <typename U, typename T>
+U shared_float_representation(const char* data) {
+    constexpr U mask = (U)1 << (sizeof(U) * 8 - 1);
+    T floating_value;
+    memcpy(&floating_value, data, sizeof(T));
+    if (UNLIKELY(std::isnan(floating_value))) {
+        return 0;
+    }
+    std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> bits;
+    memcpy(&bits, &floating_value, sizeof(T));
+    constexpr int shift_size = sizeof(U) > sizeof(T) ? (sizeof(U) - sizeof(T)) * 8 : 0;
+    if (floating_value < 0.0) {
+        // Flipping all bits for negative values.
+        return static_cast<U>(~bits) << shift_size;
+    } else {
+        // Flipping only first bit.
+        return (static_cast<U>(bits) << shift_size) ^ mask;
+    }
+}
+
+template <typename U>
+U shared_string_representation(const char* char_ptr, size_t length) {
+    size_t len = std::min(length, sizeof(U));
+    if (len == 0) {
+        return 0;
+    }
+    U dst = 0;
+    // We copy the bytes from the string but swap the bytes because of integer endianness.
+    BitUtil::ByteSwapScalar(&dst, char_ptr, len);
+    return dst << ((sizeof(U) - len) * 8);
+}
+
+template <typename T>
+T unaligned_value(const char* data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+ZOrderComparator::ZOrderComparator(const TabletSchema& tablet_schema, int sort_col_num) {
+    DCHECK_GT(sort_col_num, 0);
+    for (int i = 0; i < sort_col_num; ++i) {
+        _types.push_back(tablet_schema.column(i).type());
+        _max_col_size = std::max(_max_col_size, _type_byte_size(_types.back()));
+    }
+}
+
+template <typename U>
+U ZOrderComparator::_shared_representation(const IColumn& column, size_t row, FieldType type) {
+    const IColumn* data_column = &column;
+    if (column.is_nullable()) {
+        const auto& nullable_column = assert_cast<const ColumnNullable&>(column);
+        if (nullable_column.is_null_at(row)) {
+            return 0;
+        }
+        data_column = &nullable_column.get_nested_column();
+    }
+    StringRef value = data_column->get_data_at(row);
+    switch (type) {
+    case OLAP_FIELD_TYPE_BOOL:
+        return static_cast<U>(value.data[0] != 0) << (sizeof(U) * 8 - 1);
+    case OLAP_FIELD_TYPE_TINYINT:
+        return shared_int_representation<U>(unaligned_value<int8_t>(value.data));
+    case OLAP_FIELD_TYPE_SMALLINT:
+        return shared_int_representation<U>(unaligned_value<int16_t>(value.data));
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+        return shared_int_representation<U>(unaligned_value<int32_t>(value.data));
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+        return shared_int_representation<U>(unaligned_value<int64_t>(value.data));
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_DECIMAL:
+    case OLAP_FIELD_TYPE_DECIMAL128:
+        return shared_int_representation<U>(unaligned_value<__int128>(value.data));
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATETIME:
+        return shared_int_representation<U>(
+                reinterpret_cast<const VecDateTimeValue*>(value.data)->to_int64());
+    case OLAP_FIELD_TYPE_DATEV2:
+        return shared_uint_representation<U>(unaligned_value<uint32_t>(value.data));
+    case OLAP_FIELD_TYPE_DATETIMEV2:
+        return shared_uint_representation<U>(unaligned_value<uint64_t>(value.data));
+    case OLAP_FIELD_TYPE_FLOAT:
+        return shared_float_representation<U, float>(value.data);
+    case OLAP_FIELD_TYPE_DOUBLE:
+        return shared_float_representation<U, double>(value.data);
+    case OLAP_FIELD_TYPE_CHAR:
+    case OLAP_FIELD_TYPE_VARCHAR:
+    case OLAP_FIELD_TYPE_STRING:
+        return shared_string_representation<U>(value.data, value.size);
+    default:
+        return 0;
+    }
+}
+
+template uint32_t ZOrderComparator::_shared_representation<uint32_t>(const IColumn&, size_t,
+                                                                     FieldType);
+template uint64_t ZOrderComparator::_shared_representation<uint64_t>(const IColumn&, size_t,
+                                                                     FieldType);
+template __uint128_t ZOrderComparator::_shared_representation<__uint128_t>(const IColumn&,
+                                                                           size_t, FieldType);
+
+int ZOrderComparator::_type_byte_size(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_BOOL:
+    case OLAP_FIELD_TYPE_TINYINT:
+        return 1;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        return 2;
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_FLOAT:
+    case OLAP_FIELD_TYPE_DATEV2:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+        return 4;
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_DOUBLE:
+    case OLAP_FIELD_TYPE_DATE:
+    case OLAP_FIELD_TYPE_DATETIME:
+    case OLAP_FIELD_TYPE_DATETIMEV2:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+        return 8;
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_DECIMAL:
+    case OLAP_FIELD_TYPE_DECIMAL128:
+        return 16;
+    default:
+        // the strings are compared by as many first bytes as the other columns have
+        return 0;
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <vector>
+
+#include "olap/olap_common.h"
+#include "vec/columns/column.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+class TabletSchema;
+
+namespace vectorized {
+
+// Compares the rows of blocks by the z-order of their first sort_col_num columns, the order of
+// the interleaved bits of the values, so that the rows near in the order are near in each of
+// the columns and the zone maps of all of them prune. It is the block version of
+// TupleRowZOrderComparator: each value is mapped to an unsigned integer of the width of the
+// widest column keeping the order of the values, the strings by their first bytes, and the
+// nulls are the least values.
+class ZOrderComparator {
+public:
+    ZOrderComparator(const TabletSchema& tablet_schema, int sort_col_num);
+
+    // Like Block::compare_at with the sort columns, compares the row n of lhs and the row m of
+    // rhs.
+    int compare_at(size_t n, size_t m, const Block& lhs, const Block& rhs) const {
+        return _compare_at(n, m, lhs, rhs);
+    }
+    int compare_at(size_t n, size_t m, const MutableBlock& lhs, const MutableBlock& rhs) const {
+        return _compare_at(n, m, lhs, rhs);
+    }
+
+private:
+    using uint128_t = __uint128_t;
+
+    static const IColumn& _column(const Block& block, size_t i) {
+        return *block.get_by_position(i).column;
+    }
+    static const IColumn& _column(const MutableBlock& block, size_t i) {
+        return *block.get_column_by_position(i);
+    }
+
+    template <typename BlockType>
+    int _compare_at(size_t n, size_t m, const BlockType& lhs, const BlockType& rhs) const {
+        if (_max_col_size <= 4) {
+            return _compare<uint32_t>(n, m, lhs, rhs);
+        } else if (_max_col_size <= 8) {
+            return _compare<uint64_t>(n, m, lhs, rhs);
+        } else {
+            return _compare<uint128_t>(n, m, lhs, rhs);
+        }
+    }
+
+    // the column whose most significant differing bit is the highest decides the order
+    template <typename U, typename BlockType>
+    int _compare(size_t n, size_t m, const BlockType& lhs, const BlockType& rhs) const {
+        auto less_msb = [](U x, U y) { return x < y && x < (x ^ y); };
+        U msd_lhs = _shared_representation<U>(_column(lhs, 0), n, _types[0]);
+        U msd_rhs = _shared_representation<U>(_column(rhs, 0), m, _types[0]);
+        for (size_t i = 1; i < _types.size(); ++i) {
+            U lhsi = _shared_representation<U>(_column(lhs, i), n, _types[i]);
+            U rhsi = _shared_representation<U>(_column(rhs, i), m, _types[i]);
+            if (less_msb(msd_lhs ^ msd_rhs, lhsi ^ rhsi)) {
+                msd_lhs = lhsi;
+                msd_rhs = rhsi;
+            }
+        }
+        return msd_lhs < msd_rhs ? -1 : (msd_lhs > msd_rhs ? 1 : 0);
+    }
+
+    template <typename U>
+    static U _shared_representation(const IColumn& column, size_t row, FieldType type);
+
+    static int _type_byte_size(FieldType type);
+
+    std::vector<FieldType> _types;
+    int _max_col_size = 0;
+};
+
+} // namespace vectorized
+} // namespace doris
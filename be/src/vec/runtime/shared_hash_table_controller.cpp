@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/shared_hash_table_controller.h"
+
+#include "runtime/runtime_state.h"
+
+namespace doris::vectorized {
+
+bool SharedHashTableController::should_build_hash_table(const TUniqueId& fragment_instance_id,
+                                                        int node_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _builder_fragment_ids.find(node_id);
+    if (it == _builder_fragment_ids.end()) {
+        _builder_fragment_ids.emplace(node_id, fragment_instance_id);
+        _shared_contexts.emplace(node_id, std::make_shared<SharedHashTableContext>());
+        return true;
+    }
+    return it->second == fragment_instance_id;
+}
+
+SharedHashTableContextPtr SharedHashTableController::get_context(int node_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _shared_contexts.find(node_id);
+    DCHECK(it != _shared_contexts.end());
+    return it->second;
+}
+
+void SharedHashTableController::signal(int node_id, const Status& status) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _shared_contexts.find(node_id);
+        DCHECK(it != _shared_contexts.end());
+        it->second->status = status;
+        it->second->signaled = true;
+    }
+    _cv.notify_all();
+}
+
+Status SharedHashTableController::wait_for_signal(RuntimeState* state,
+                                                  const SharedHashTableContextPtr& context) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    // wake up regularly to check whether the query is cancelled
+    while (!context->signaled) {
+        _cv.wait_for(lock, std::chrono::milliseconds(400));
+        RETURN_IF_CANCELLED(state);
+    }
+    return context->status;
+}
+
+} // namespace doris::vectorized
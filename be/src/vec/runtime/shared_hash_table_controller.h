@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "gen_cpp/Types_types.h"
+
+namespace doris {
+
+class RuntimeState;
+
+namespace vectorized {
+
+class Arena;
+class Block;
+
+// A runtime filter built by the builder, serialized so that the waiting instances can merge it
+// into their own filters even after the builder is gone.
+struct SharedRuntimeFilter {
+    PMergeFilterRequest request;
+    std::string data;
+};
+
+// The build side of a hash join which is shared by the instances of a fragment on one BE.
+// The hash table variants are type erased so that the controller doesn't depend on the
+// hash join node.
+struct SharedHashTableContext {
+    Status status;
+    std::shared_ptr<Arena> arena;
+    std::vector<std::shared_ptr<Arena>> build_arenas;
+    std::shared_ptr<void> hash_table_variants;
+    std::shared_ptr<std::vector<Block>> blocks;
+    std::shared_ptr<std::unordered_map<const Block*, std::vector<int>>> inserted_rows;
+    // filter id -> the runtime filter the builder published for the shared hash table
+    std::map<int, SharedRuntimeFilter> runtime_filters;
+    bool signaled = false;
+};
+
+using SharedHashTableContextPtr = std::shared_ptr<SharedHashTableContext>;
+
+// SharedHashTableController lets the instances of a fragment build the hash table of a
+// broadcast join only once per query on a BE, since all of them receive the same build
+// data. The first instance asking for a join node builds its hash table and signals the
+// others, which wait for it and then probe the same hash table read only.
+//
+// It is owned by QueryFragmentsCtx, so the shared hash tables live as long as the query.
+class SharedHashTableController {
+public:
+    // Return true if the fragment instance is the one who builds the hash table of the node.
+    bool should_build_hash_table(const TUniqueId& fragment_instance_id, int node_id);
+
+    SharedHashTableContextPtr get_context(int node_id);
+
+    // Called by the builder once the context is filled, or the build failed.
+    void signal(int node_id, const Status& status);
+
+    // Wait until the builder signals, return the status of the build.
+    Status wait_for_signal(RuntimeState* state, const SharedHashTableContextPtr& context);
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::map<int, TUniqueId> _builder_fragment_ids;
+    std::map<int, SharedHashTableContextPtr> _shared_contexts;
+};
+
+} // namespace vectorized
+} // namespace doris
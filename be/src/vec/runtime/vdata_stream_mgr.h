@@ -26,6 +26,10 @@
 #include "common/status.h"
 #include "gen_cpp/Types_types.h"
 
+namespace butil {
+class IOBuf;
+}
+
 namespace google {
 namespace protobuf {
 class Closure;
@@ -59,7 +63,10 @@ public:
 
     Status deregister_recvr(const TUniqueId& fragment_instance_id, PlanNodeId node_id);
 
-    Status transmit_block(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
+    // 'column_values' is the brpc attachment holding the column values of the block of
+    // 'request', if it is sent by attachment.
+    Status transmit_block(const PTransmitDataParams* request, ::google::protobuf::Closure** done,
+                          const butil::IOBuf* column_values = nullptr);
 
     void cancel(const TUniqueId& fragment_instance_id);
 
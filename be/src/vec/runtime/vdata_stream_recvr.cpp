@@ -20,6 +20,7 @@
 #include "gen_cpp/data.pb.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/thread_context.h"
+#include "service/brpc.h"
 #include "util/uid_util.h"
 #include "vec/core/block.h"
 #include "vec/core/materialize_block.h"
@@ -38,6 +39,11 @@ VDataStreamRecvr::SenderQueue::SenderQueue(VDataStreamRecvr* parent_recvr, int n
 
 VDataStreamRecvr::SenderQueue::~SenderQueue() = default;
 
+bool VDataStreamRecvr::SenderQueue::should_wait() {
+    std::lock_guard<std::mutex> l(_lock);
+    return !_is_cancelled && _block_queue.empty() && _num_remaining_senders > 0;
+}
+
 Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
     std::unique_lock<std::mutex> l(_lock);
     // wait until something shows up or we know we're done
@@ -89,7 +95,8 @@ Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
 
 void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_number,
                                               int64_t packet_seq,
-                                              ::google::protobuf::Closure** done) {
+                                              ::google::protobuf::Closure** done,
+                                              const butil::IOBuf* column_values) {
     // Avoid deadlock when calling SenderQueue::cancel() in tcmalloc hook,
     // limit memory via DataStreamRecvr::exceeds_limit.
     STOP_CHECK_THREAD_MEM_TRACKER_LIMIT();
@@ -110,6 +117,9 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
         _packet_seq_map.emplace(be_number, packet_seq);
     }
     auto block_byte_size = pblock.ByteSizeLong();
+    if (column_values != nullptr) {
+        block_byte_size += column_values->size();
+    }
     COUNTER_UPDATE(_recvr->_bytes_received_counter, block_byte_size);
 
     if (_num_remaining_senders <= 0) {
@@ -124,7 +134,7 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
     Block* block = nullptr;
     {
         SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
-        block = new Block(pblock);
+        block = column_values == nullptr ? new Block(pblock) : new Block(pblock, *column_values);
     }
 
     VLOG_ROW << "added #rows=" << block->rows() << " batch_size=" << block_byte_size << "\n";
@@ -145,27 +155,32 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
     // Avoid deadlock when calling SenderQueue::cancel() in tcmalloc hook,
     // limit memory via DataStreamRecvr::exceeds_limit.
     STOP_CHECK_THREAD_MEM_TRACKER_LIMIT();
-    std::unique_lock<std::mutex> l(_lock);
-    if (_is_cancelled) {
-        return;
-    }
-    Block* nblock = new Block(block->get_columns_with_type_and_name());
+    // Copy the block before taking the lock, so that the senders on this BE do not copy their
+    // blocks one after another.
+    std::unique_ptr<Block> nblock(new Block(block->get_columns_with_type_and_name()));
     nblock->info = block->info;
 
-    // local exchange should copy the block contented if use move == false
+    // local exchange should copy the block contented if use move == false, and the moved columns
+    // that are still referenced elsewhere, which may be changed in place by their owners
+    auto rows = block->rows();
     if (use_move) {
         block->clear();
-    } else {
-        auto rows = block->rows();
-        for (int i = 0; i < nblock->columns(); ++i) {
-            nblock->get_by_position(i).column =
-                    nblock->get_by_position(i).column->clone_resized(rows);
+    }
+    for (int i = 0; i < nblock->columns(); ++i) {
+        auto& column = nblock->get_by_position(i).column;
+        if (!use_move || column->use_count() > 1) {
+            column = column->clone_resized(rows);
         }
     }
     materialize_block_inplace(*nblock);
-
     size_t block_size = nblock->bytes();
-    _block_queue.emplace_back(block_size, nblock);
+
+    std::unique_lock<std::mutex> l(_lock);
+    if (_is_cancelled) {
+        return;
+    }
+    COUNTER_UPDATE(_recvr->_bytes_received_counter, block_size);
+    _block_queue.emplace_back(block_size, nblock.release());
     _data_arrival_cv.notify_one();
 
     if (_recvr->exceeds_limit(block_size)) {
@@ -309,10 +324,11 @@ Status VDataStreamRecvr::create_merger(const std::vector<VExprContext*>& orderin
 }
 
 void VDataStreamRecvr::add_block(const PBlock& pblock, int sender_id, int be_number,
-                                 int64_t packet_seq, ::google::protobuf::Closure** done) {
+                                 int64_t packet_seq, ::google::protobuf::Closure** done,
+                                 const butil::IOBuf* column_values) {
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
     int use_sender_id = _is_merging ? sender_id : 0;
-    _sender_queues[use_sender_id]->add_block(pblock, be_number, packet_seq, done);
+    _sender_queues[use_sender_id]->add_block(pblock, be_number, packet_seq, done, column_values);
 }
 
 void VDataStreamRecvr::add_block(Block* block, int sender_id, bool use_move) {
@@ -339,6 +355,15 @@ Status VDataStreamRecvr::get_next(Block* block, bool* eos) {
     return Status::OK();
 }
 
+bool VDataStreamRecvr::ready_to_read() {
+    for (auto* sender_queue : _sender_queues) {
+        if (sender_queue->should_wait()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void VDataStreamRecvr::remove_sender(int sender_id, int be_number) {
     int use_sender_id = _is_merging ? sender_id : 0;
     _sender_queues[use_sender_id]->decrement_senders(be_number);
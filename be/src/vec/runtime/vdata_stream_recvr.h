@@ -31,6 +31,10 @@
 #include "runtime/query_statistics.h"
 #include "util/runtime_profile.h"
 
+namespace butil {
+class IOBuf;
+}
+
 namespace google {
 namespace protobuf {
 class Closure;
@@ -63,13 +67,19 @@ public:
                          const std::vector<bool>& nulls_first, size_t batch_size, int64_t limit,
                          size_t offset);
 
+    // 'column_values' holds the column values of 'pblock' when they came as brpc attachment.
     void add_block(const PBlock& pblock, int sender_id, int be_number, int64_t packet_seq,
-                   ::google::protobuf::Closure** done);
+                   ::google::protobuf::Closure** done,
+                   const butil::IOBuf* column_values = nullptr);
 
     void add_block(Block* block, int sender_id, bool use_move);
 
     Status get_next(Block* block, bool* eos);
 
+    // Whether get_next() would return without waiting for a sender. A merging receiver may
+    // read from any sender, so it is only ready when all the senders are.
+    bool ready_to_read();
+
     const TUniqueId& fragment_instance_id() const { return _fragment_instance_id; }
     PlanNodeId dest_node_id() const { return _dest_node_id; }
     const RowDescriptor& row_desc() const { return _row_desc; }
@@ -149,8 +159,11 @@ public:
 
     Status get_batch(Block** next_block);
 
+    // Whether get_batch() would wait for a block to arrive.
+    bool should_wait();
+
     void add_block(const PBlock& pblock, int be_number, int64_t packet_seq,
-                   ::google::protobuf::Closure** done);
+                   ::google::protobuf::Closure** done, const butil::IOBuf* column_values);
 
     void add_block(Block* block, bool use_move);
 
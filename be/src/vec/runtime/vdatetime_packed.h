@@ -0,0 +1,145 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "vec/core/types.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+// Kernels on the packed representations of the date values, which is what the columns hold:
+// the fields of a DateV2Value are the bit fields of its UInt32, and the ones of a
+// VecDateTimeValue are the bit fields and bytes of its Int64 (neg:1, type:3, second:12,
+// minute:8, hour:8, day:8, month:8 and year:16 from the lowest bit). They're read by shifts and
+// checked against a table with no branch and no call into the calendar code of the values, so
+// that the loops of the transforms over a column are vectorized. Each one gives the same result
+// as its method of the values.
+namespace packed_date {
+
+// days of the months of a non leap year, indexed by the month and 0 for the invalid ones
+inline constexpr uint8_t DAYS_IN_MONTH[16] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+inline bool is_leap(uint32_t year) {
+    return ((year % 4) == 0) & (((year % 100) != 0) | (((year % 400) == 0) & (year != 0)));
+}
+
+// the same as doris::calc_daynr()
+inline uint32_t daynr(uint32_t year, uint32_t month, uint32_t day) {
+    // the leap day of a year is counted from March
+    int32_t y = int32_t(year) - (month <= 2);
+    int32_t m = month;
+    int32_t days = 365 * int32_t(year) + 31 * (m - 1) + int32_t(day);
+    days -= (m > 2) * ((m * 4 + 23) / 10);
+    uint32_t res = days + y / 4 - y / 100 + y / 400;
+    return (year == 0 && month == 0) ? 0 : res;
+}
+
+inline bool is_valid_date(uint32_t year, uint32_t month, uint32_t day, uint32_t max_year) {
+    uint32_t days_in_month =
+            DAYS_IN_MONTH[month & 0xf] * (month <= 12) + ((month == 2) & is_leap(year));
+    return (year <= max_year) & (day != 0) & (day <= days_in_month);
+}
+
+inline uint32_t year(UInt32 v) {
+    return v >> 9;
+}
+inline uint32_t month(UInt32 v) {
+    return (v >> 5) & 0xf;
+}
+inline uint32_t day(UInt32 v) {
+    return v & 0x1f;
+}
+
+inline uint32_t year(Int64 v) {
+    return uint64_t(v) >> 48;
+}
+inline uint32_t month(Int64 v) {
+    return (v >> 40) & 0xff;
+}
+inline uint32_t day(Int64 v) {
+    return (v >> 32) & 0xff;
+}
+inline uint32_t hour(Int64 v) {
+    return (v >> 24) & 0xff;
+}
+inline uint32_t minute(Int64 v) {
+    return (v >> 16) & 0xff;
+}
+inline uint32_t second(Int64 v) {
+    return (v >> 4) & 0xfff;
+}
+inline uint32_t type(Int64 v) {
+    return (v >> 1) & 0x7;
+}
+
+// DateV2Value::is_valid_date()
+inline bool is_valid_date(UInt32 v) {
+    return (year(v) >= MIN_YEAR) & is_valid_date(year(v), month(v), day(v), MAX_YEAR);
+}
+
+// VecDateTimeValue::is_valid_date()
+inline bool is_valid_date(Int64 v) {
+    uint32_t max_hour = type(v) == TIME_TIME ? TIME_MAX_HOUR : 23;
+    return (hour(v) <= max_hour) & (minute(v) <= 59) & (second(v) <= 59) &
+           is_valid_date(year(v), month(v), day(v), 9999);
+}
+
+template <typename T>
+uint32_t daynr(T v) {
+    return daynr(year(v), month(v), day(v));
+}
+
+// VecDateTimeValue::cast_to_date(), which keeps the neg bit and the date
+inline Int64 to_date(Int64 v) {
+    return (v & ~Int64(0xfffffffe)) | (TIME_DATE << 1);
+}
+
+inline UInt32 to_date(UInt32 v) {
+    return v;
+}
+
+// Truncates a datetime to the start of its year, month, day, hour or minute, as a datetime: the
+// same as flooring it to a period of one unit from the default origin, for a valid datetime.
+template <TimeUnit unit>
+Int64 floor_to_unit(Int64 v) {
+    static_assert(unit == YEAR || unit == MONTH || unit == DAY || unit == HOUR || unit == MINUTE ||
+                  unit == SECOND);
+    uint64_t res = uint64_t(v) & ~uint64_t(0xf);
+    if constexpr (unit != SECOND) {
+        res &= ~uint64_t(0xfff0);
+    }
+    if constexpr (unit != SECOND && unit != MINUTE) {
+        res &= ~(uint64_t(0xff) << 16);
+    }
+    if constexpr (unit == DAY || unit == MONTH || unit == YEAR) {
+        res &= ~(uint64_t(0xff) << 24);
+    }
+    if constexpr (unit == MONTH || unit == YEAR) {
+        res = (res & ~(uint64_t(0xff) << 32)) | (uint64_t(1) << 32);
+    }
+    if constexpr (unit == YEAR) {
+        res = (res & ~(uint64_t(0xff) << 40)) | (uint64_t(1) << 40);
+    }
+    return res | (TIME_DATETIME << 1);
+}
+
+} // namespace packed_date
+
+} // namespace doris::vectorized
@@ -61,7 +61,50 @@ bool VecDateTimeValue::check_date(uint32_t year, uint32_t month, uint32_t day) {
 // The interval format is that with no delimiters
 // YYYY-MM-DD HH-MM-DD.FFFFFF AM in default format
 // 0    1  2  3  4  5  6      7
+// Parses the canonical "YYYY-MM-DD" and "YYYY-MM-DD HH:MM:SS" by the positions of their fields,
+// which is what the general parsing below gives for them.
+bool VecDateTimeValue::from_canonical_date_str(const char* date_str, int len, bool* res) {
+    auto is_digit = [](char c) { return static_cast<uint8_t>(c - '0') <= 9; };
+    auto digits = [](const char* p, int n) {
+        uint32_t val = 0;
+        for (int i = 0; i < n; ++i) {
+            val = val * 10 + (p[i] - '0');
+        }
+        return val;
+    };
+    if (len != 10 && len != 19) {
+        return false;
+    }
+    // the positions of the digits of "YYYY-MM-DD HH:MM:SS"
+    constexpr uint32_t DIGITS_MASK = 0b1101101101101101111;
+    for (int i = 0; i < len; ++i) {
+        if (is_digit(date_str[i]) != ((DIGITS_MASK >> i) & 1)) {
+            return false;
+        }
+    }
+    if (date_str[4] != '-' || date_str[7] != '-' ||
+        (len == 19 && (date_str[10] != ' ' || date_str[13] != ':' || date_str[16] != ':'))) {
+        return false;
+    }
+    _neg = false;
+    _type = len == 10 ? TIME_DATE : TIME_DATETIME;
+    uint32_t hour = 0;
+    uint32_t minute = 0;
+    uint32_t second = 0;
+    if (len == 19) {
+        hour = digits(date_str + 11, 2);
+        minute = digits(date_str + 14, 2);
+        second = digits(date_str + 17, 2);
+    }
+    *res = check_range_and_set_time(digits(date_str, 4), digits(date_str + 5, 2),
+                                    digits(date_str + 8, 2), hour, minute, second, _type);
+    return true;
+}
+
 bool VecDateTimeValue::from_date_str(const char* date_str, int len) {
+    if (bool res; from_canonical_date_str(date_str, len, &res)) {
+        return res;
+    }
     const char* ptr = date_str;
     const char* end = date_str + len;
     // ONLY 2, 6 can follow by a sapce
@@ -608,6 +608,10 @@ private:
     bool from_date_format_str(const char* format, int format_len, const char* value, int value_len,
                               const char** sub_val_end);
 
+    // Returns false if date_str isn't of a canonical format, else sets *res to the result of
+    // from_date_str()
+    bool from_canonical_date_str(const char* date_str, int len, bool* res);
+
     // 1 bits for neg. 3 bits for type. 12bit for second
     uint16_t _neg : 1;  // Used for time value.
     uint16_t _type : 3; // Which type of this value.
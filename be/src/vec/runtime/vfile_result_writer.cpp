@@ -117,7 +117,10 @@ Status VFileResultWriter::_create_file_writer(const std::string& file_name) {
         // just use file writer is enough
         break;
     case TFileFormatType::FORMAT_PARQUET:
-        return Status::NotSupported("Parquet Writer is not supported yet!");
+        _parquet_writer.reset(new VParquetWriterWrapper(
+                _file_writer_impl.get(), _output_vexpr_ctxs, _file_opts->file_properties,
+                _file_opts->schema, _output_object_data));
+        RETURN_IF_ERROR(_parquet_writer->init());
         break;
     default:
         return Status::InternalError("unsupported file format: {}", _file_opts->file_format);
@@ -183,18 +186,18 @@ Status VFileResultWriter::append_block(Block& block) {
     }
     RETURN_IF_ERROR(write_csv_header());
     SCOPED_TIMER(_append_row_batch_timer);
+    Status status = Status::OK();
+    // Exec vectorized expr here to speed up, block.rows() == 0 means expr exec
+    // failed, just return the error status
+    auto output_block = VExprContext::get_output_block_after_execute_exprs(_output_vexpr_ctxs,
+                                                                           block, status);
+    auto num_rows = output_block.rows();
+    if (UNLIKELY(num_rows == 0)) {
+        return status;
+    }
     if (_parquet_writer != nullptr) {
-        return Status::NotSupported("Parquet Writer is not supported yet!");
+        RETURN_IF_ERROR(_write_parquet_file(output_block));
     } else {
-        Status status = Status::OK();
-        // Exec vectorized expr here to speed up, block.rows() == 0 means expr exec
-        // failed, just return the error status
-        auto output_block = VExprContext::get_output_block_after_execute_exprs(_output_vexpr_ctxs,
-                                                                               block, status);
-        auto num_rows = output_block.rows();
-        if (UNLIKELY(num_rows == 0)) {
-            return status;
-        }
         RETURN_IF_ERROR(_write_csv_file(output_block));
     }
 
@@ -202,6 +205,16 @@ Status VFileResultWriter::append_block(Block& block) {
     return Status::OK();
 }
 
+Status VFileResultWriter::_write_parquet_file(const Block& block) {
+    {
+        SCOPED_TIMER(_file_write_timer);
+        RETURN_IF_ERROR(_parquet_writer->write(block));
+    }
+    // split file if exceed limit
+    _current_written_bytes = _parquet_writer->written_len();
+    return _create_new_file_if_exceed_size();
+}
+
 Status VFileResultWriter::_write_csv_file(const Block& block) {
     for (size_t i = 0; i < block.rows(); i++) {
         for (size_t col_id = 0; col_id < block.columns(); col_id++) {
@@ -385,7 +398,10 @@ Status VFileResultWriter::_create_new_file_if_exceed_size() {
 
 Status VFileResultWriter::_close_file_writer(bool done) {
     if (_parquet_writer != nullptr) {
-        return Status::NotSupported("Parquet Writer is not supported yet!");
+        // the parquet writer closes the file writer as well
+        RETURN_IF_ERROR(_parquet_writer->close());
+        COUNTER_UPDATE(_written_data_bytes, _parquet_writer->written_len());
+        _parquet_writer.reset();
     } else if (_file_writer_impl) {
         _file_writer_impl->close();
     }
@@ -19,6 +19,7 @@
 
 #include "io/file_writer.h"
 #include "runtime/file_result_writer.h"
+#include "vec/runtime/vparquet_writer.h"
 #include "vec/sink/vresult_sink.h"
 
 namespace doris {
@@ -52,6 +53,7 @@ public:
 
 private:
     Status _write_csv_file(const Block& block);
+    Status _write_parquet_file(const Block& block);
 
     // if buffer exceed the limit, write the data buffered in _plain_text_outstream via file_writer
     // if eos, write the data even if buffer is not full.
@@ -83,10 +85,10 @@ private:
     const std::vector<VExprContext*>& _output_vexpr_ctxs;
 
     // If the result file format is plain text, like CSV, this _file_writer is owned by this FileResultWriter.
-    // If the result file format is Parquet, this _file_writer is owned by _parquet_writer.
+    // If the result file format is Parquet, this _file_writer is closed by _parquet_writer.
     std::unique_ptr<FileWriter> _file_writer_impl;
     // parquet file writer
-    ParquetWriterWrapper* _parquet_writer = nullptr;
+    std::unique_ptr<VParquetWriterWrapper> _parquet_writer;
     // Used to buffer the export data of plain text
     // TODO(cmy): I simply use a stringstrteam to buffer the data, to avoid calling
     // file writer's write() for every single row.
@@ -0,0 +1,253 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vparquet_writer.h"
+
+#include "common/config.h"
+#include "io/file_writer.h"
+#include "runtime/decimalv2_value.h"
+#include "util/binary_cast.hpp"
+#include "util/mysql_global.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// Appends the rows of a column to its column chunk in one batch. A column that is optional in
+// the schema gets the definition levels of the rows and the values of the non-null rows only, and
+// a null of a required column is written as the default value, as the row based writer does.
+template <typename ParquetColumnWriter, typename GetValue>
+void write_batch(parquet::ColumnWriter* column_writer, const NullMap* null_map, size_t num_rows,
+                 GetValue get_value) {
+    using Value = typename ParquetColumnWriter::T;
+    auto* writer = static_cast<ParquetColumnWriter*>(column_writer);
+    const bool optional = writer->descr()->max_definition_level() > 0;
+    std::unique_ptr<Value[]> values(new Value[num_rows]);
+    std::vector<int16_t> def_levels(optional ? num_rows : 0);
+    size_t num_values = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+        const bool is_null = null_map != nullptr && (*null_map)[i];
+        if (optional) {
+            def_levels[i] = !is_null;
+        }
+        if (!is_null) {
+            values[num_values++] = get_value(i);
+        } else if (!optional) {
+            values[num_values++] = Value();
+        }
+    }
+    writer->WriteBatch(num_rows, optional ? def_levels.data() : nullptr, nullptr, values.get());
+}
+
+template <typename ParquetColumnWriter, typename T>
+void write_numbers(parquet::ColumnWriter* column_writer, const NullMap* null_map,
+                   const IColumn& column) {
+    const auto& data = assert_cast<const ColumnVector<T>&>(column).get_data();
+    write_batch<ParquetColumnWriter>(column_writer, null_map, data.size(), [&](size_t i) {
+        return static_cast<typename ParquetColumnWriter::T>(data[i]);
+    });
+}
+
+void write_bytes(parquet::ColumnWriter* column_writer, const NullMap* null_map,
+                 const IColumn& column) {
+    write_batch<parquet::ByteArrayWriter>(column_writer, null_map, column.size(), [&](size_t i) {
+        const auto value = column.get_data_at(i);
+        return parquet::ByteArray(value.size, reinterpret_cast<const uint8_t*>(value.data));
+    });
+}
+
+} // namespace
+
+VParquetWriterWrapper::VParquetWriterWrapper(FileWriter* file_writer,
+                                             const std::vector<VExprContext*>& output_vexpr_ctxs,
+                                             const std::map<std::string, std::string>& properties,
+                                             const std::vector<std::vector<std::string>>& schema,
+                                             bool output_object_data)
+        : _output_vexpr_ctxs(output_vexpr_ctxs),
+          _str_schema(schema),
+          _output_object_data(output_object_data) {
+    _outstream = std::make_shared<ParquetOutputStream>(file_writer);
+    _properties = ParquetWriterWrapper::build_properties(properties);
+    _schema = ParquetWriterWrapper::build_schema(schema);
+}
+
+Status VParquetWriterWrapper::init() {
+    try {
+        _writer = parquet::ParquetFileWriter::Open(_outstream, _schema, _properties);
+    } catch (const std::exception& e) {
+        return Status::InternalError("Failed to create parquet file writer: {}", e.what());
+    }
+    if (_writer == nullptr) {
+        return Status::InternalError("Failed to create file writer");
+    }
+    return Status::OK();
+}
+
+Status VParquetWriterWrapper::write(const Block& block) {
+    if (block.columns() != _str_schema.size()) {
+        return Status::InternalError("project field size is not equal to schema column size");
+    }
+    try {
+        if (_rg_writer == nullptr) {
+            _rg_writer = _writer->AppendBufferedRowGroup();
+        }
+        for (int i = 0; i < block.columns(); ++i) {
+            RETURN_IF_ERROR(_write_column(block.get_by_position(i), i));
+        }
+        if (_rg_writer->total_bytes_written() + _rg_writer->total_compressed_bytes() >=
+            config::parquet_writer_max_row_group_bytes) {
+            _rg_writer->Close();
+            _rg_writer = nullptr;
+        }
+    } catch (const std::exception& e) {
+        LOG(WARNING) << "Parquet write error: " << e.what();
+        return Status::InternalError(e.what());
+    }
+    return Status::OK();
+}
+
+Status VParquetWriterWrapper::_write_column(const ColumnWithTypeAndName& column, int index) {
+    ColumnPtr column_ptr = column.column->convert_to_full_column_if_const();
+    const NullMap* null_map = nullptr;
+    if (const auto* nullable_column = check_and_get_column<ColumnNullable>(*column_ptr)) {
+        null_map = &nullable_column->get_null_map_data();
+        column_ptr = nullable_column->get_nested_column_ptr();
+    }
+    const IColumn& data_column = *column_ptr;
+    parquet::ColumnWriter* column_writer = _rg_writer->column(index);
+
+    const auto& type = _output_vexpr_ctxs[index]->root()->type();
+    auto check_type = [&](const std::string& parquet_type, const std::string& type_name) {
+        if (_str_schema[index][1] != parquet_type) {
+            return Status::InvalidArgument(
+                    "project field type is {}, should use {}, "
+                    "but the definition type of column {} is {}",
+                    type_name, parquet_type, _str_schema[index][2], _str_schema[index][1]);
+        }
+        return Status::OK();
+    };
+
+    switch (type.type) {
+    case TYPE_BOOLEAN: {
+        RETURN_IF_ERROR(check_type("boolean", "boolean"));
+        const auto& data = assert_cast<const ColumnUInt8&>(data_column).get_data();
+        write_batch<parquet::BoolWriter>(column_writer, null_map, data.size(),
+                                         [&](size_t i) { return data[i] != 0; });
+        break;
+    }
+    case TYPE_TINYINT:
+        RETURN_IF_ERROR(check_type("int32", "tiny int"));
+        write_numbers<parquet::Int32Writer, Int8>(column_writer, null_map, data_column);
+        break;
+    case TYPE_SMALLINT:
+        RETURN_IF_ERROR(check_type("int32", "small int"));
+        write_numbers<parquet::Int32Writer, Int16>(column_writer, null_map, data_column);
+        break;
+    case TYPE_INT:
+        RETURN_IF_ERROR(check_type("int32", "int"));
+        write_numbers<parquet::Int32Writer, Int32>(column_writer, null_map, data_column);
+        break;
+    case TYPE_BIGINT:
+        RETURN_IF_ERROR(check_type("int64", "big int"));
+        write_numbers<parquet::Int64Writer, Int64>(column_writer, null_map, data_column);
+        break;
+    case TYPE_LARGEINT:
+        return Status::InvalidArgument("do not support large int type.");
+    case TYPE_FLOAT:
+        RETURN_IF_ERROR(check_type("float", "float"));
+        write_numbers<parquet::FloatWriter, Float32>(column_writer, null_map, data_column);
+        break;
+    case TYPE_DOUBLE:
+        RETURN_IF_ERROR(check_type("double", "double"));
+        write_numbers<parquet::DoubleWriter, Float64>(column_writer, null_map, data_column);
+        break;
+    case TYPE_DATE:
+    case TYPE_DATETIME: {
+        RETURN_IF_ERROR(check_type("int64", "date/datetime"));
+        const auto& data = assert_cast<const ColumnVector<Int64>&>(data_column).get_data();
+        write_batch<parquet::Int64Writer>(column_writer, null_map, data.size(), [&](size_t i) {
+            return static_cast<int64_t>(
+                    binary_cast<Int64, VecDateTimeValue>(data[i]).to_olap_datetime());
+        });
+        break;
+    }
+    case TYPE_HLL:
+    case TYPE_OBJECT:
+        if (!_output_object_data) {
+            return Status::InvalidArgument("unsupported file format: {}", type.type);
+        }
+        RETURN_IF_ERROR(check_type("byte_array", "hll/bitmap"));
+        write_bytes(column_writer, null_map, data_column);
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+    case TYPE_STRING:
+        RETURN_IF_ERROR(check_type("byte_array", "char/varchar"));
+        write_bytes(column_writer, null_map, data_column);
+        break;
+    case TYPE_DECIMALV2: {
+        RETURN_IF_ERROR(check_type("byte_array", "decimal v2"));
+        const auto& data = assert_cast<const ColumnDecimal<Decimal128>&>(data_column).get_data();
+        // the formatted values have to live until the batch is written
+        std::vector<char> buffer(data.size() * MAX_DECIMAL_WIDTH);
+        write_batch<parquet::ByteArrayWriter>(column_writer, null_map, data.size(), [&](size_t i) {
+            char* value = buffer.data() + i * MAX_DECIMAL_WIDTH;
+            int32_t len = DecimalV2Value(data[i]).to_buffer(value, type.scale);
+            return parquet::ByteArray(len, reinterpret_cast<const uint8_t*>(value));
+        });
+        break;
+    }
+    default:
+        return Status::InvalidArgument("unsupported file format: {}", type.type);
+    }
+    return Status::OK();
+}
+
+int64_t VParquetWriterWrapper::written_len() {
+    int64_t written_len = _outstream->get_written_len();
+    if (_rg_writer != nullptr) {
+        written_len += _rg_writer->total_bytes_written() + _rg_writer->total_compressed_bytes();
+    }
+    return written_len;
+}
+
+Status VParquetWriterWrapper::close() {
+    try {
+        if (_rg_writer != nullptr) {
+            _rg_writer->Close();
+            _rg_writer = nullptr;
+        }
+        _writer->Close();
+    } catch (const std::exception& e) {
+        _rg_writer = nullptr;
+        LOG(WARNING) << "Parquet writer close error: " << e.what();
+        return Status::InternalError(e.what());
+    }
+    arrow::Status st = _outstream->Close();
+    if (!st.ok()) {
+        return Status::InternalError("close parquet file error: {}", st.ToString());
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <parquet/api/writer.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "exec/parquet_writer.h"
+#include "vec/core/block.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris {
+class FileWriter;
+
+namespace vectorized {
+
+// Writes blocks to a parquet file a column at a time. Each column of a block is appended to the
+// column chunk of the buffered row group in one batch, and the row group is flushed to the file
+// when it reaches parquet_writer_max_row_group_bytes.
+class VParquetWriterWrapper {
+public:
+    VParquetWriterWrapper(FileWriter* file_writer,
+                          const std::vector<VExprContext*>& output_vexpr_ctxs,
+                          const std::map<std::string, std::string>& properties,
+                          const std::vector<std::vector<std::string>>& schema,
+                          bool output_object_data);
+    ~VParquetWriterWrapper() = default;
+
+    Status init();
+
+    Status write(const Block& block);
+
+    Status close();
+
+    // the bytes flushed to the file and the compressed bytes of the buffered row group
+    int64_t written_len();
+
+private:
+    Status _write_column(const ColumnWithTypeAndName& column, int index);
+
+    std::shared_ptr<ParquetOutputStream> _outstream;
+    std::shared_ptr<parquet::WriterProperties> _properties;
+    std::shared_ptr<parquet::schema::GroupNode> _schema;
+    std::unique_ptr<parquet::ParquetFileWriter> _writer;
+    parquet::RowGroupWriter* _rg_writer = nullptr;
+    const std::vector<VExprContext*>& _output_vexpr_ctxs;
+    std::vector<std::vector<std::string>> _str_schema;
+    bool _output_object_data;
+};
+
+} // namespace vectorized
+} // namespace doris
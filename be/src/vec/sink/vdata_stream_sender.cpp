@@ -28,6 +28,8 @@
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
+#include "util/block_compression.h"
+#include "util/doris_metrics.h"
 #include "util/proto_util.h"
 #include "vec/common/sip_hash.h"
 #include "vec/runtime/vdata_stream_mgr.h"
@@ -36,6 +38,47 @@
 
 namespace doris::vectorized {
 
+// The closure of the rpc sending a block. It owns the request, and is referenced by the caller
+// issuing the rpc and by the rpc itself, as the callback may run before the caller returns.
+class VDataStreamSender::Channel::TransmitClosure : public google::protobuf::Closure {
+public:
+    TransmitClosure(Channel* channel, PendingBlock pending)
+            : pending(std::move(pending)), _channel(channel) {}
+
+    void Run() override {
+        _channel->_on_transmit_done(this);
+        unref();
+    }
+
+    void unref() {
+        if (_refs.fetch_sub(1) == 1) {
+            delete this;
+        }
+    }
+
+    brpc::Controller cntl;
+    PTransmitDataParams request;
+    PTransmitDataResult result;
+    PendingBlock pending;
+
+private:
+    Channel* _channel;
+    std::atomic<int> _refs {2};
+};
+
+VDataStreamSender::Channel::~Channel() {
+    std::unique_lock<std::mutex> l(_send_lock);
+    _pending_blocks.clear();
+    if (_rpc_in_flight) {
+        auto call_id = _in_flight_call_id;
+        l.unlock();
+        // The callback of the canceled rpc may run in this thread.
+        brpc::StartCancel(call_id);
+        l.lock();
+        _send_cv.wait(l, [this] { return !_rpc_in_flight; });
+    }
+}
+
 Status VDataStreamSender::Channel::init(RuntimeState* state) {
     _be_number = state->be_number();
 
@@ -47,18 +90,11 @@ Status VDataStreamSender::Channel::init(RuntimeState* state) {
         return Status::InternalError("no brpc destination");
     }
 
-    // initialize brpc request
     _finst_id.set_hi(_fragment_instance_id.hi);
     _finst_id.set_lo(_fragment_instance_id.lo);
-    _brpc_request.set_allocated_finst_id(&_finst_id);
 
     _query_id.set_hi(state->query_id().hi);
     _query_id.set_lo(state->query_id().lo);
-    _brpc_request.set_allocated_query_id(&_query_id);
-
-    _brpc_request.set_node_id(_dest_node_id);
-    _brpc_request.set_sender_id(_parent->_sender_id);
-    _brpc_request.set_be_number(_be_number);
 
     _brpc_timeout_ms = std::min(3600, state->query_options().query_timeout) * 1000;
 
@@ -78,97 +114,210 @@ Status VDataStreamSender::Channel::init(RuntimeState* state) {
 }
 
 Status VDataStreamSender::Channel::send_current_block(bool eos) {
-    // TODO: Now, local exchange will cause the performance problem is in a multi-threaded scenario
-    //  so this feature is turned off here. We need to re-examine this logic
-    //    if (is_local()) {
-    //        return send_local_block(eos);
-    //    }
+    if (is_local()) {
+        return send_local_block(eos);
+    }
     auto block = _mutable_block->to_block();
-    RETURN_IF_ERROR(_parent->serialize_block(&block, _ch_cur_pb_block));
+    auto pblock = std::make_shared<PBlock>();
+    butil::IOBuf column_values;
+    RETURN_IF_ERROR(_parent->serialize_block(&block, pblock.get(), 1, &column_values));
     block.clear_column_data();
     _mutable_block->set_muatable_columns(block.mutate_columns());
-    RETURN_IF_ERROR(send_block(_ch_cur_pb_block, eos));
-    ch_roll_pb_block();
-    return Status::OK();
+    return send_block(std::move(pblock), eos, &column_values);
+}
+
+VDataStreamRecvr* VDataStreamSender::Channel::_find_local_recvr() {
+    if (_local_recvr == nullptr) {
+        _local_recvr = _parent->state()->exec_env()->vstream_mgr()->find_recvr(
+                _fragment_instance_id, _dest_node_id);
+    }
+    return _local_recvr.get();
 }
 
 Status VDataStreamSender::Channel::send_local_block(bool eos) {
-    std::shared_ptr<VDataStreamRecvr> recvr =
-            _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
-                                                                    _dest_node_id);
-    if (recvr != nullptr) {
-        Block block = _mutable_block->to_block();
-        COUNTER_UPDATE(_parent->_local_bytes_send_counter, block.bytes());
-        recvr->add_block(&block, _parent->_sender_id, true);
-        if (eos) {
-            recvr->remove_sender(_parent->_sender_id, _be_number);
+    if (_mutable_block != nullptr && _mutable_block->rows() > 0) {
+        auto recvr = _find_local_recvr();
+        if (recvr != nullptr) {
+            Block block = _mutable_block->to_block();
+            COUNTER_UPDATE(_parent->_local_bytes_send_counter, block.bytes());
+            recvr->add_block(&block, _parent->_sender_id, true);
         }
+        _mutable_block->clear();
+    }
+    if (eos) {
+        // The eos still goes through brpc, as it carries the query statistics.
+        RETURN_IF_ERROR(send_block(nullptr, true));
     }
-    _mutable_block->clear();
     return Status::OK();
 }
 
-Status VDataStreamSender::Channel::send_local_block(Block* block) {
-    std::shared_ptr<VDataStreamRecvr> recvr =
-            _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
-                                                                    _dest_node_id);
+Status VDataStreamSender::Channel::send_local_block(Block* block, bool can_move) {
+    auto recvr = _find_local_recvr();
     if (recvr != nullptr) {
         COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->bytes());
-        recvr->add_block(block, _parent->_sender_id, false);
+        if (can_move) {
+            // the owner of the block fills the empty columns left in it again
+            Block moved_block = block->clone_empty();
+            moved_block.swap(*block);
+            recvr->add_block(&moved_block, _parent->_sender_id, true);
+        } else {
+            recvr->add_block(block, _parent->_sender_id, false);
+        }
     }
     return Status::OK();
 }
 
-Status VDataStreamSender::Channel::send_block(PBlock* block, bool eos) {
-    if (_closure == nullptr) {
-        _closure = new RefCountClosure<PTransmitDataResult>();
-        _closure->ref();
-    } else {
-        RETURN_IF_ERROR(_wait_last_brpc());
-        _closure->cntl.Reset();
-    }
+Status VDataStreamSender::Channel::send_block(std::shared_ptr<PBlock> block, bool eos,
+                                             const butil::IOBuf* column_values) {
     VLOG_ROW << "Channel::send_batch() instance_id=" << _fragment_instance_id
              << " dest_node=" << _dest_node_id << " to_host=" << _brpc_dest_addr.hostname
              << " _packet_seq=" << _packet_seq << " row_desc=" << _row_desc.debug_string();
+    PendingBlock pending;
+    pending.eos = eos;
     if (_is_transfer_chain && (_send_query_statistics_with_every_batch || eos)) {
-        auto statistic = _brpc_request.mutable_query_statistics();
-        _parent->_query_statistics->to_pb(statistic);
+        pending.query_statistics = std::make_unique<PQueryStatistics>();
+        _parent->_query_statistics->to_pb(pending.query_statistics.get());
+    }
+    if (block != nullptr) {
+        pending.bytes = block->column_values().size();
+        if (column_values != nullptr) {
+            // The buffers of 'column_values' are shared instead of copied.
+            pending.column_values = *column_values;
+            pending.bytes += column_values->size();
+        }
+        pending.block = std::move(block);
     }
 
-    _brpc_request.set_eos(eos);
+    std::unique_lock<std::mutex> l(_send_lock);
+    if (_pending_blocks.size() >= std::max(1, config::data_stream_sender_channel_queue_size)) {
+        SCOPED_TIMER(_parent->_send_queue_wait_timer);
+        while (_send_status.ok() && !_state->is_cancelled() &&
+               _pending_blocks.size() >=
+                       std::max(1, config::data_stream_sender_channel_queue_size)) {
+            _send_cv.wait_for(l, std::chrono::milliseconds(100));
+        }
+    }
+    RETURN_IF_ERROR(_send_status);
+    if (_state->is_cancelled()) {
+        return Status::Cancelled("Cancelled");
+    }
+    _parent->_add_queued_bytes(pending.bytes);
+    if (_rpc_in_flight) {
+        _pending_blocks.push_back(std::move(pending));
+        return Status::OK();
+    }
+    _rpc_in_flight = true;
+    l.unlock();
+    _transmit(std::move(pending));
+    return Status::OK();
+}
+
+void VDataStreamSender::Channel::_transmit(PendingBlock pending) {
+    auto closure = new TransmitClosure(this, std::move(pending));
+    auto& request = closure->request;
+    *request.mutable_finst_id() = _finst_id;
+    *request.mutable_query_id() = _query_id;
+    request.set_node_id(_dest_node_id);
+    request.set_sender_id(_parent->_sender_id);
+    request.set_be_number(_be_number);
+    request.set_eos(closure->pending.eos);
+    if (closure->pending.query_statistics != nullptr) {
+        request.set_allocated_query_statistics(closure->pending.query_statistics.release());
+    }
+    // The block may be shared with other channels, the request borrows it until the rpc is
+    // issued.
+    PBlock* block = closure->pending.block.get();
     if (block != nullptr) {
-        _brpc_request.set_allocated_block(block);
-    }
-    _brpc_request.set_packet_seq(_packet_seq++);
-
-    _closure->ref();
-    _closure->cntl.set_timeout_ms(_brpc_timeout_ms);
-
-    if (_parent->_transfer_large_data_by_brpc && _brpc_request.has_block() &&
-        _brpc_request.block().has_column_values() &&
-        _brpc_request.ByteSizeLong() > MIN_HTTP_BRPC_SIZE) {
-        Status st = request_embed_attachment_contain_block<PTransmitDataParams,
-                                                           RefCountClosure<PTransmitDataResult>>(
-                &_brpc_request, _closure);
-        RETURN_IF_ERROR(st);
-        std::string brpc_url =
-                fmt::format("http://{}:{}", _brpc_dest_addr.hostname, _brpc_dest_addr.port);
-        std::shared_ptr<PBackendService_Stub> _brpc_http_stub =
-                _state->exec_env()->brpc_internal_client_cache()->get_new_client_no_cache(brpc_url,
-                                                                                          "http");
-        _closure->cntl.http_request().uri() =
-                brpc_url + "/PInternalServiceImpl/transmit_block_by_http";
-        _closure->cntl.http_request().set_method(brpc::HTTP_METHOD_POST);
-        _closure->cntl.http_request().set_content_type("application/json");
-        _brpc_http_stub->transmit_block_by_http(&_closure->cntl, NULL, &_closure->result, _closure);
+        request.set_allocated_block(block);
+    }
+    bool by_attachment = block != nullptr && !closure->pending.column_values.empty();
+    request.set_transfer_by_attachment(by_attachment);
+    if (by_attachment) {
+        closure->cntl.request_attachment().append(closure->pending.column_values);
+    }
+    request.set_packet_seq(_packet_seq++);
+    closure->cntl.set_timeout_ms(_brpc_timeout_ms);
+    {
+        std::lock_guard<std::mutex> l(_send_lock);
+        _in_flight_call_id = closure->cntl.call_id();
+    }
+
+    // The channel may be gone once the rpc is issued, as the callback notifies the destructor.
+    Status st = Status::OK();
+    if (_parent->_transfer_large_data_by_brpc && request.has_block() &&
+        request.block().has_column_values() && request.ByteSizeLong() > MIN_HTTP_BRPC_SIZE) {
+        st = request_embed_attachment_contain_block<PTransmitDataParams, TransmitClosure>(
+                &request, closure);
+        if (st.ok()) {
+            std::string brpc_url =
+                    fmt::format("http://{}:{}", _brpc_dest_addr.hostname, _brpc_dest_addr.port);
+            std::shared_ptr<PBackendService_Stub> brpc_http_stub =
+                    _state->exec_env()->brpc_internal_client_cache()->get_new_client_no_cache(
+                            brpc_url, "http");
+            closure->cntl.http_request().uri() =
+                    brpc_url + "/PInternalServiceImpl/transmit_block_by_http";
+            closure->cntl.http_request().set_method(brpc::HTTP_METHOD_POST);
+            closure->cntl.http_request().set_content_type("application/json");
+            brpc_http_stub->transmit_block_by_http(&closure->cntl, nullptr, &closure->result,
+                                                   closure);
+        }
     } else {
-        _closure->cntl.http_request().Clear();
-        _brpc_stub->transmit_block(&_closure->cntl, &_brpc_request, &_closure->result, _closure);
+        _brpc_stub->transmit_block(&closure->cntl, &request, &closure->result, closure);
+    }
+    if (!st.ok()) {
+        closure->cntl.SetFailed(st.get_error_msg());
+        closure->Run();
     }
     if (block != nullptr) {
-        _brpc_request.release_block();
+        request.release_block();
     }
-    return Status::OK();
+    closure->unref();
+}
+
+void VDataStreamSender::Channel::_on_transmit_done(TransmitClosure* closure) {
+    Status st = Status::OK();
+    if (closure->cntl.Failed()) {
+        std::string err = fmt::format(
+                "failed to send brpc batch, error={}, error_text={}, client: {}",
+                berror(closure->cntl.ErrorCode()), closure->cntl.ErrorText(),
+                BackendOptions::get_localhost());
+        LOG(WARNING) << err;
+        st = Status::ThriftRpcError(err);
+    } else {
+        DorisMetrics::instance()->transmit_block_latency_us->add(closure->cntl.latency_us());
+    }
+
+    PendingBlock next;
+    bool send_next = false;
+    {
+        std::lock_guard<std::mutex> l(_send_lock);
+        int64_t released_bytes = closure->pending.bytes;
+        if (!st.ok() && _send_status.ok()) {
+            _send_status = st;
+            for (auto& pending : _pending_blocks) {
+                released_bytes += pending.bytes;
+            }
+            _pending_blocks.clear();
+        }
+        if (!_pending_blocks.empty()) {
+            next = std::move(_pending_blocks.front());
+            _pending_blocks.pop_front();
+            send_next = true;
+        } else {
+            _rpc_in_flight = false;
+        }
+        _parent->_release_queued_bytes(released_bytes);
+        // Notify with the lock held, the destructor may run as soon as it is released.
+        _send_cv.notify_all();
+    }
+    if (send_next) {
+        _transmit(std::move(next));
+    }
+}
+
+bool VDataStreamSender::Channel::is_send_queue_full() {
+    std::lock_guard<std::mutex> l(_send_lock);
+    return _pending_blocks.size() >= std::max(1, config::data_stream_sender_channel_queue_size);
 }
 
 Status VDataStreamSender::Channel::add_row(Block* block, int row) {
@@ -224,7 +373,12 @@ Status VDataStreamSender::Channel::add_rows(Block* block, const std::vector<int>
 
 Status VDataStreamSender::Channel::close_wait(RuntimeState* state) {
     if (_need_close) {
-        Status st = _wait_last_brpc();
+        Status st;
+        {
+            std::unique_lock<std::mutex> l(_send_lock);
+            _send_cv.wait(l, [this] { return !_rpc_in_flight; });
+            st = _send_status;
+        }
         if (!st.ok()) {
             state->log_error(st.get_error_msg());
         }
@@ -259,10 +413,6 @@ Status VDataStreamSender::Channel::close(RuntimeState* state) {
     return st;
 }
 
-void VDataStreamSender::Channel::ch_roll_pb_block() {
-    _ch_cur_pb_block = (_ch_cur_pb_block == &_ch_pb_block1 ? &_ch_pb_block2 : &_ch_pb_block1);
-}
-
 VDataStreamSender::VDataStreamSender(ObjectPool* pool, int sender_id, const RowDescriptor& row_desc,
                                      const TDataStreamSink& sink,
                                      const std::vector<TPlanFragmentDestination>& destinations,
@@ -274,7 +424,6 @@ VDataStreamSender::VDataStreamSender(ObjectPool* pool, int sender_id, const RowD
           _current_channel_idx(0),
           _part_type(sink.output_partition.type),
           _ignore_not_found(sink.__isset.ignore_not_found ? sink.ignore_not_found : true),
-          _cur_pb_block(&_pb_block1),
           _profile(nullptr),
           _serialize_batch_timer(nullptr),
           _bytes_sent_counter(nullptr),
@@ -400,6 +549,12 @@ Status VDataStreamSender::prepare(RuntimeState* state) {
             "VDataStreamSender:" + print_id(state->fragment_instance_id()), nullptr, _profile);
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
 
+    if (state->query_options().__isset.fragment_transmission_compression_codec) {
+        RETURN_IF_ERROR(get_block_compression_type(
+                state->query_options().fragment_transmission_compression_codec,
+                &_compression_type));
+    }
+
     if (_part_type == TPartitionType::UNPARTITIONED || _part_type == TPartitionType::RANDOM) {
         std::random_device rd;
         std::mt19937 g(rd());
@@ -424,6 +579,7 @@ Status VDataStreamSender::prepare(RuntimeState* state) {
                                profile()->total_time_counter()),
             "");
     _local_bytes_send_counter = ADD_COUNTER(profile(), "LocalBytesSent", TUnit::BYTES);
+    _send_queue_wait_timer = ADD_TIMER(profile(), "SendQueueWaitTime");
     for (int i = 0; i < _channels.size(); ++i) {
         RETURN_IF_ERROR(_channels[i]->init(state));
     }
@@ -445,44 +601,88 @@ Status VDataStreamSender::send(RuntimeState* state, RowBatch* batch) {
     return Status::NotSupported("Not Implemented VOlapScanNode Node::get_next scalar");
 }
 
+bool VDataStreamSender::can_write() {
+    if (_queued_bytes > config::data_stream_sender_max_queued_bytes) {
+        return false;
+    }
+    for (auto channel : _channels) {
+        if (!channel->is_local() && channel->is_send_queue_full()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VDataStreamSender::_add_queued_bytes(int64_t bytes) {
+    _queued_bytes += bytes;
+}
+
+void VDataStreamSender::_release_queued_bytes(int64_t bytes) {
+    std::lock_guard<std::mutex> l(_queued_bytes_lock);
+    _queued_bytes -= bytes;
+    _queued_bytes_cv.notify_all();
+}
+
+Status VDataStreamSender::_wait_for_queued_bytes(RuntimeState* state) {
+    if (_queued_bytes <= config::data_stream_sender_max_queued_bytes) {
+        return Status::OK();
+    }
+    SCOPED_TIMER(_send_queue_wait_timer);
+    std::unique_lock<std::mutex> l(_queued_bytes_lock);
+    while (_queued_bytes > config::data_stream_sender_max_queued_bytes) {
+        if (state->is_cancelled()) {
+            return Status::Cancelled("Cancelled");
+        }
+        _queued_bytes_cv.wait_for(l, std::chrono::milliseconds(100));
+    }
+    return Status::OK();
+}
+
 Status VDataStreamSender::send(RuntimeState* state, Block* block) {
     INIT_AND_SCOPE_SEND_SPAN(state->get_tracer(), _send_span, "VDataStreamSender::send")
     SCOPED_TIMER(_profile->total_time_counter());
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
     if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) {
         // 1. serialize depends on it is not local exchange
-        // 2. send block
-        // 3. rollover block
+        // 2. send block, the serialized block is shared by the channels
+        // 3. the last local channel takes the columns of the block, the others copy them
         int local_size = 0;
-        for (auto channel : _channels) {
-            if (channel->is_local()) local_size++;
+        int last_local = -1;
+        for (int i = 0; i < _channels.size(); ++i) {
+            if (_channels[i]->is_local()) {
+                local_size++;
+                last_local = i;
+            }
         }
         if (local_size == _channels.size()) {
-            for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_local_block(block));
+            for (int i = 0; i < _channels.size(); ++i) {
+                RETURN_IF_ERROR(_channels[i]->send_local_block(block, i == last_local));
             }
         } else {
-            RETURN_IF_ERROR(serialize_block(block, _cur_pb_block, _channels.size()));
-            for (auto channel : _channels) {
+            auto pblock = std::make_shared<PBlock>();
+            butil::IOBuf column_values;
+            RETURN_IF_ERROR(
+                    serialize_block(block, pblock.get(), _channels.size(), &column_values));
+            for (int i = 0; i < _channels.size(); ++i) {
+                auto channel = _channels[i];
                 if (channel->is_local()) {
-                    RETURN_IF_ERROR(channel->send_local_block(block));
+                    RETURN_IF_ERROR(channel->send_local_block(block, i == last_local));
                 } else {
-                    RETURN_IF_ERROR(channel->send_block(_cur_pb_block));
+                    RETURN_IF_ERROR(channel->send_block(pblock, false, &column_values));
                 }
             }
-            // rollover
-            _roll_pb_block();
         }
     } else if (_part_type == TPartitionType::RANDOM) {
         // 1. select channel
         Channel* current_channel = _channels[_current_channel_idx];
-        // 2. serialize, send and rollover block
+        // 2. serialize and send block
         if (current_channel->is_local()) {
-            RETURN_IF_ERROR(current_channel->send_local_block(block));
+            RETURN_IF_ERROR(current_channel->send_local_block(block, true));
         } else {
-            RETURN_IF_ERROR(serialize_block(block, current_channel->ch_cur_pb_block()));
-            RETURN_IF_ERROR(current_channel->send_block(current_channel->ch_cur_pb_block()));
-            current_channel->ch_roll_pb_block();
+            auto pblock = std::make_shared<PBlock>();
+            butil::IOBuf column_values;
+            RETURN_IF_ERROR(serialize_block(block, pblock.get(), 1, &column_values));
+            RETURN_IF_ERROR(current_channel->send_block(std::move(pblock), false, &column_values));
         }
         _current_channel_idx = (_current_channel_idx + 1) % _channels.size();
     } else if (_part_type == TPartitionType::HASH_PARTITIONED) {
@@ -493,6 +693,7 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block) {
         int result_size = _partition_expr_ctxs.size();
         int result[result_size];
         RETURN_IF_ERROR(get_partition_column_result(block, result));
+        _sample_partition_keys(block, result, result_size);
 
         // vectorized calculate hash
         int rows = block->rows();
@@ -523,6 +724,7 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block) {
         int result_size = _partition_expr_ctxs.size();
         int result[result_size];
         RETURN_IF_ERROR(get_partition_column_result(block, result));
+        _sample_partition_keys(block, result, result_size);
 
         // vectorized calculate hash val
         int rows = block->rows();
@@ -555,7 +757,7 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block) {
         // 1. calculate range
         // 2. dispatch rows to channel
     }
-    return Status::OK();
+    return _wait_for_queued_bytes(state);
 }
 
 Status VDataStreamSender::close(RuntimeState* state, Status exec_status) {
@@ -580,17 +782,83 @@ Status VDataStreamSender::close(RuntimeState* state, Status exec_status) {
         iter->close(state);
     }
     VExpr::close(_partition_expr_ctxs, state);
+    _report_skew();
     DataSink::close(state, exec_status);
     return final_st;
 }
 
-Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_receivers) {
+// one row out of this many is sampled for the hot partition keys
+static constexpr int HOT_KEY_SAMPLE_INTERVAL = 256;
+// the keys with the smallest counts are dropped when more keys are tracked
+static constexpr uint32_t MAX_TRACKED_HOT_KEYS = 1024;
+static constexpr uint32_t NUM_REPORTED_HOT_KEYS = 5;
+
+void VDataStreamSender::_sample_partition_keys(Block* block, const int* result, int result_size) {
+    int rows = block->rows();
+    for (; _next_sample_row < rows; _next_sample_row += HOT_KEY_SAMPLE_INTERVAL) {
+        std::string key;
+        for (int j = 0; j < result_size; ++j) {
+            const auto& column = block->get_by_position(result[j]);
+            if (j > 0) {
+                key.append(", ");
+            }
+            key.append(column.type->to_string(*column.column, _next_sample_row));
+        }
+        _hot_keys.add_item(key, 1);
+        if (++_sampled_keys % (MAX_TRACKED_HOT_KEYS * 4) == 0) {
+            std::vector<Counter> retained;
+            _hot_keys.sort_retain(MAX_TRACKED_HOT_KEYS, &retained);
+        }
+    }
+    _next_sample_row -= rows;
+}
+
+void VDataStreamSender::_report_skew() {
+    if (_channel_rows.empty()) {
+        return;
+    }
+    int64_t total_rows = 0;
+    int64_t max_rows = 0;
+    for (auto rows : _channel_rows) {
+        total_rows += rows;
+        max_rows = std::max(max_rows, rows);
+    }
+    if (total_rows == 0) {
+        return;
+    }
+    // a receiver with much more rows than the average sets the latency of the exchange
+    _profile->add_info_string("MaxChannelRows",
+                              fmt::format("{} of {} rows sent to {} channels", max_rows,
+                                          total_rows, _channel_rows.size()));
+    if (_sampled_keys == 0) {
+        return;
+    }
+    std::vector<Counter> hot_keys;
+    _hot_keys.sort_retain(NUM_REPORTED_HOT_KEYS, &hot_keys);
+    fmt::memory_buffer buffer;
+    for (auto& hot_key : hot_keys) {
+        fmt::format_to(buffer, "{}{}: {:.1f}%", buffer.size() == 0 ? "" : ", ", hot_key.get_item(),
+                       hot_key.get_count() * 100.0 / _sampled_keys);
+    }
+    _profile->add_info_string("HotPartitionKeys", fmt::to_string(buffer));
+}
+
+Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_receivers,
+                                         butil::IOBuf* column_values) {
     {
         SCOPED_TIMER(_serialize_batch_timer);
         dest->Clear();
         size_t uncompressed_bytes = 0, compressed_bytes = 0;
-        RETURN_IF_ERROR(src->serialize(dest, &uncompressed_bytes, &compressed_bytes,
-                                       _transfer_large_data_by_brpc));
+        // The blocks larger than MIN_HTTP_BRPC_SIZE go through the http brpc.
+        if (column_values != nullptr && config::brpc_block_attachment_min_bytes >= 0 &&
+            static_cast<int64_t>(src->bytes()) >= config::brpc_block_attachment_min_bytes &&
+            src->bytes() < MIN_HTTP_BRPC_SIZE) {
+            RETURN_IF_ERROR(src->serialize(dest, column_values, &uncompressed_bytes,
+                                           &compressed_bytes, _compression_type));
+        } else {
+            RETURN_IF_ERROR(src->serialize(dest, &uncompressed_bytes, &compressed_bytes,
+                                           _transfer_large_data_by_brpc, _compression_type));
+        }
         COUNTER_UPDATE(_bytes_sent_counter, compressed_bytes * num_receivers);
         COUNTER_UPDATE(_uncompressed_bytes_counter, uncompressed_bytes * num_receivers);
     }
@@ -598,8 +866,4 @@ Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_rece
     return Status::OK();
 }
 
-void VDataStreamSender::_roll_pb_block() {
-    _cur_pb_block = (_cur_pb_block == &_pb_block1 ? &_pb_block2 : &_pb_block1);
-}
-
 } // namespace doris::vectorized
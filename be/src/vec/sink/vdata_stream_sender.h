@@ -17,6 +17,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include "common/global_types.h"
 #include "exec/data_sink.h"
 #include "gen_cpp/PaloInternalService_types.h"
@@ -28,6 +33,7 @@
 #include "util/brpc_client_cache.h"
 #include "util/network_util.h"
 #include "util/ref_count_closure.h"
+#include "util/topn_counter.h"
 #include "util/uid_util.h"
 #include "vec/exprs/vexpr.h"
 
@@ -42,6 +48,7 @@ class MemTracker;
 class PartRangeKey;
 
 namespace vectorized {
+class VDataStreamRecvr;
 class VExprContext;
 class VPartitionInfo;
 
@@ -69,17 +76,29 @@ public:
     virtual Status send(RuntimeState* state, RowBatch* batch) override;
     virtual Status send(RuntimeState* state, Block* block) override;
 
+    // False while the queued blocks exceed the memory budget or the send queue of a channel
+    // is full.
+    bool can_write() override;
+
     virtual Status close(RuntimeState* state, Status exec_status) override;
     virtual RuntimeProfile* profile() override { return _profile; }
 
     RuntimeState* state() { return _state; }
 
-    Status serialize_block(Block* src, PBlock* dest, int num_receivers = 1);
+    // If 'column_values' is not null and 'src' is large enough, the column values are
+    // serialized into 'column_values' instead of 'dest', to be sent as brpc attachment.
+    Status serialize_block(Block* src, PBlock* dest, int num_receivers = 1,
+                           butil::IOBuf* column_values = nullptr);
 
 protected:
-    void _roll_pb_block();
     class Channel;
 
+    // Account the bytes of a block queued by a channel, until its rpc finishes.
+    void _add_queued_bytes(int64_t bytes);
+    void _release_queued_bytes(int64_t bytes);
+    // Wait until the queued blocks are back within config::data_stream_sender_max_queued_bytes.
+    Status _wait_for_queued_bytes(RuntimeState* state);
+
     Status get_partition_column_result(Block* block, int* result) const {
         int counter = 0;
         for (auto ctx : _partition_expr_ctxs) {
@@ -101,6 +120,12 @@ protected:
 
     Status handle_unpartitioned(Block* block);
 
+    // Samples the partition keys of the rows of the block, to find the hot keys that skew the
+    // rows sent to the channels.
+    void _sample_partition_keys(Block* block, const int* result, int result_size);
+    // Adds the rows of the channels and the hot partition keys to the profile.
+    void _report_skew();
+
     // Sender instance id, unique within a fragment.
     int _sender_id;
 
@@ -113,12 +138,6 @@ protected:
     TPartitionType::type _part_type;
     bool _ignore_not_found;
 
-    // serialized batches for broadcasting; we need two so we can write
-    // one while the other one is still being sent
-    PBlock _pb_block1;
-    PBlock _pb_block2;
-    PBlock* _cur_pb_block = nullptr;
-
     // compute per-row partition values
     std::vector<VExprContext*> _partition_expr_ctxs;
 
@@ -141,14 +160,31 @@ protected:
     RuntimeProfile::Counter* _overall_throughput;
     // Used to counter send bytes under local data exchange
     RuntimeProfile::Counter* _local_bytes_send_counter;
+    // The time spent waiting for a full send queue or the memory budget.
+    RuntimeProfile::Counter* _send_queue_wait_timer = nullptr;
     // Identifier of the destination plan node.
     PlanNodeId _dest_node_id;
 
     // User can change this config at runtime, avoid it being modified during query or loading process.
     bool _transfer_large_data_by_brpc = false;
-};
 
-// TODO: support local exechange
+    // The codec compressing the serialized blocks, set by the query option
+    // fragment_transmission_compression_codec.
+    segment_v2::CompressionTypePB _compression_type = segment_v2::CompressionTypePB::SNAPPY;
+
+    // The bytes of the blocks queued or in flight in all channels, released by the rpc callbacks.
+    std::mutex _queued_bytes_lock;
+    std::condition_variable _queued_bytes_cv;
+    std::atomic<int64_t> _queued_bytes {0};
+
+    // the rows sent to each channel by the hash partitions
+    std::vector<int64_t> _channel_rows;
+    // the approximate counts of the sampled partition keys, like a Space-Saving summary
+    TopNCounter _hot_keys;
+    int64_t _sampled_keys = 0;
+    // the row of the next block to sample, so the sampled rows are evenly spaced across blocks
+    int _next_sample_row = 0;
+};
 
 class VDataStreamSender::Channel {
 public:
@@ -170,24 +206,17 @@ public:
               _need_close(false),
               _brpc_dest_addr(brpc_dest),
               _is_transfer_chain(is_transfer_chain),
-              _send_query_statistics_with_every_batch(send_query_statistics_with_every_batch),
-              _ch_cur_pb_block(&_ch_pb_block1) {
+              _send_query_statistics_with_every_batch(send_query_statistics_with_every_batch) {
         std::string localhost = BackendOptions::get_localhost();
-        _is_local = (_brpc_dest_addr.hostname == localhost) &&
+        _is_local = config::enable_local_exchange && (_brpc_dest_addr.hostname == localhost) &&
                     (_brpc_dest_addr.port == config::brpc_port);
         if (_is_local) {
             LOG(INFO) << "will use local Exchange, dest_node_id is : " << _dest_node_id;
         }
     }
 
-    virtual ~Channel() {
-        if (_closure != nullptr && _closure->unref()) {
-            delete _closure;
-        }
-        // release this before request desctruct
-        _brpc_request.release_finst_id();
-        _brpc_request.release_query_id();
-    }
+    // Drops the queued blocks and cancels the rpc in flight, if any.
+    virtual ~Channel();
 
     // Initialize channel.
     // Returns OK if successful, error indication otherwise.
@@ -198,33 +227,40 @@ public:
     // Returns error status if any of the preceding rpcs failed, OK otherwise.
     //Status add_row(TupleRow* row);
 
-    // Asynchronously sends a row batch.
-    // Returns the status of the most recently finished transmit_data
-    // rpc (or OK if there wasn't one that hasn't been reported yet).
-    // if batch is nullptr, send the eof packet
-    Status send_block(PBlock* block, bool eos = false);
+    // Queue a serialized block to be sent once the rpcs of the blocks queued before it finish,
+    // only waits if the send queue of the channel is full. 'block' may be shared with other
+    // channels and must not be modified afterwards.
+    // Returns the error of the first rpc of this channel that failed, OK otherwise.
+    // if block is nullptr, send the eof packet
+    // 'column_values' holds the column values of 'block' if they are sent as attachment, it
+    // is shared and not copied.
+    Status send_block(std::shared_ptr<PBlock> block, bool eos = false,
+                      const butil::IOBuf* column_values = nullptr);
 
     Status add_row(Block* block, int row);
     Status add_rows(Block* block, const std::vector<int>& row);
 
     Status send_current_block(bool eos = false);
 
+    // Hand the buffered rows over to the receiver on this BE, without serializing them.
     Status send_local_block(bool eos = false);
 
-    Status send_local_block(Block* block);
+    // Hand 'block' over to the receiver on this BE. With can_move, the receiver takes its columns
+    // without copying them and 'block' is left with empty columns of the same types, otherwise
+    // 'block' is copied and left unchanged.
+    Status send_local_block(Block* block, bool can_move);
+
     // Flush buffered rows and close channel. This function don't wait the response
     // of close operation, client should call close_wait() to finish channel's close.
     // We split one close operation into two phases in order to make multiple channels
     // can run parallel.
     Status close(RuntimeState* state);
 
-    // Get close wait's response, to finish channel close operation.
+    // Wait until all the queued blocks are sent, to finish channel close operation.
     Status close_wait(RuntimeState* state);
 
     int64_t num_data_bytes_sent() const { return _num_data_bytes_sent; }
 
-    PBlock* ch_cur_pb_block() { return _ch_cur_pb_block; }
-
     std::string get_fragment_instance_id_str() {
         UniqueId uid(_fragment_instance_id);
         return uid.to_string();
@@ -234,25 +270,30 @@ public:
 
     bool is_local() const { return _is_local; }
 
-    void ch_roll_pb_block();
+    // Whether the channel can't queue another block before an rpc finishes.
+    bool is_send_queue_full();
 
 private:
-    Status _wait_last_brpc() {
-        if (_closure == nullptr) return Status::OK();
-        auto cntl = &_closure->cntl;
-        auto call_id = _closure->cntl.call_id();
-        brpc::Join(call_id);
-        if (cntl->Failed()) {
-            std::string err = fmt::format(
-                    "failed to send brpc batch, error={}, error_text={}, client: {}",
-                    berror(cntl->ErrorCode()), cntl->ErrorText(), BackendOptions::get_localhost());
-            LOG(WARNING) << err;
-            return Status::ThriftRpcError(err);
-        }
-        return Status::OK();
-    }
+    // A serialized block waiting for the rpc of the previous block of the channel.
+    struct PendingBlock {
+        std::shared_ptr<PBlock> block;
+        butil::IOBuf column_values;
+        bool eos = false;
+        // The query statistics when the block was queued.
+        std::unique_ptr<PQueryStatistics> query_statistics;
+        int64_t bytes = 0;
+    };
+    class TransmitClosure;
+
+    // Send 'pending' by an rpc, _rpc_in_flight must have been set by the caller. Must not be
+    // called with _send_lock, as the callback of a failed rpc may run in this thread.
+    void _transmit(PendingBlock pending);
+    // The callback of the rpc sending a block, which sends the next queued block.
+    void _on_transmit_done(TransmitClosure* closure);
+
+    // The receiver is looked up once instead of for each block.
+    VDataStreamRecvr* _find_local_recvr();
 
-private:
     // Serialize _batch into _thrift_batch and send via send_batch().
     // Returns send_batch() status.
     Status send_current_batch(bool eos = false);
@@ -279,10 +320,7 @@ private:
 
     PUniqueId _finst_id;
     PUniqueId _query_id;
-    PBlock _pb_block;
-    PTransmitDataParams _brpc_request;
     std::shared_ptr<PBackendService_Stub> _brpc_stub = nullptr;
-    RefCountClosure<PTransmitDataResult>* _closure = nullptr;
     int32_t _brpc_timeout_ms = 500;
     // whether the dest can be treated as query statistics transfer chain.
     bool _is_transfer_chain;
@@ -291,14 +329,16 @@ private:
 
     size_t _capacity;
     bool _is_local;
-
-    // serialized blocks for broadcasting; we need two so we can write
-    // one while the other one is still being sent.
-    // Which is for same reason as `_cur_pb_block`, `_pb_block1` and `_pb_block2`
-    // in VDataStreamSender.
-    PBlock* _ch_cur_pb_block = nullptr;
-    PBlock _ch_pb_block1;
-    PBlock _ch_pb_block2;
+    std::shared_ptr<VDataStreamRecvr> _local_recvr;
+
+    // The blocks are sent one rpc at a time, in the order they are queued.
+    std::mutex _send_lock;
+    std::condition_variable _send_cv;
+    std::deque<PendingBlock> _pending_blocks;
+    bool _rpc_in_flight = false;
+    brpc::CallId _in_flight_call_id;
+    // The error of the first failed rpc, the blocks queued after it are dropped.
+    Status _send_status;
 };
 
 template <typename Channels, typename HashVals>
@@ -311,8 +351,10 @@ Status VDataStreamSender::channel_add_rows(Channels& channels, int num_channels,
         channel2rows[cid].emplace_back(i);
     }
 
+    _channel_rows.resize(num_channels, 0);
     for (int i = 0; i < num_channels; ++i) {
         if (!channel2rows[i].empty()) {
+            _channel_rows[i] += channel2rows[i].size();
             RETURN_IF_ERROR(channels[i]->add_rows(block, channel2rows[i]));
         }
     }
@@ -20,7 +20,9 @@
 #include "runtime/buffer_control_block.h"
 #include "runtime/large_int_value.h"
 #include "runtime/runtime_state.h"
+#include "util/mysql_global.h"
 #include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
 #include "vec/columns/column_vector.h"
 #include "vec/common/assert_cast.h"
 #include "vec/data_types/data_type_array.h"
@@ -64,8 +66,12 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
     const auto row_size = column_ptr->size();
 
     doris::vectorized::ColumnPtr column;
+    // read the null map directly rather than by a virtual is_null_at() per row
+    const UInt8* null_map = nullptr;
     if constexpr (is_nullable) {
-        column = assert_cast<const ColumnNullable&>(*column_ptr).get_nested_column_ptr();
+        auto& nullable_column = assert_cast<const ColumnNullable&>(*column_ptr);
+        column = nullable_column.get_nested_column_ptr();
+        null_map = nullable_column.get_null_map_data().data();
     } else {
         column = column_ptr;
     }
@@ -81,7 +87,7 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
             _buffer.reset();
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = _buffer.push_null();
                     result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
                     continue;
@@ -119,7 +125,7 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
             _buffer.reset();
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = _buffer.push_null();
                     result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
                     continue;
@@ -160,7 +166,7 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
             _buffer.reset();
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = _buffer.push_null();
                     result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
                     continue;
@@ -181,7 +187,7 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
             _buffer.reset();
 
             if constexpr (is_nullable) {
-                if (column_ptr->is_null_at(i)) {
+                if (null_map[i]) {
                     buf_ret = _buffer.push_null();
                     result->result_batch.rows[i].append(_buffer.buf(), _buffer.length());
                     continue;
@@ -205,8 +211,7 @@ Status VMysqlResultWriter::_add_one_column(const ColumnPtr& column_ptr,
                 buf_ret = _buffer.push_bigint(data[i]);
             }
             if constexpr (type == TYPE_LARGEINT) {
-                auto v = LargeIntValue::to_string(data[i]);
-                buf_ret = _buffer.push_string(v.c_str(), v.size());
+                buf_ret = _buffer.push_largeint(data[i]);
             }
             if constexpr (type == TYPE_FLOAT) {
                 buf_ret = _buffer.push_float(data[i]);
@@ -282,8 +287,7 @@ int VMysqlResultWriter::_add_one_cell(const ColumnPtr& column_ptr, size_t row_id
         return buffer.push_bigint(data[row_idx]);
     } else if (which.is_int128()) {
         auto& data = assert_cast<const ColumnInt128&>(*column).get_data();
-        auto v = LargeIntValue::to_string(data[row_idx]);
-        return buffer.push_string(v.c_str(), v.size());
+        return buffer.push_largeint(data[row_idx]);
     } else if (which.is_float32()) {
         auto& data = assert_cast<const ColumnFloat32&>(*column).get_data();
         return buffer.push_float(data[row_idx]);
@@ -398,6 +402,74 @@ Status VMysqlResultWriter::append_row_batch(const RowBatch* batch) {
     return Status::RuntimeError("Not Implemented MysqlResultWriter::append_row_batch scalar");
 }
 
+// The upper bound of the length encoded size of a cell of a fixed width type, or 0 for the types
+// whose cells are as long as their values.
+static size_t max_cell_size(PrimitiveType type) {
+    switch (type) {
+    case TYPE_BOOLEAN:
+    case TYPE_TINYINT:
+        return 2 + MAX_TINYINT_WIDTH;
+    case TYPE_SMALLINT:
+        return 2 + MAX_SMALLINT_WIDTH;
+    case TYPE_INT:
+        return 2 + MAX_INT_WIDTH;
+    case TYPE_BIGINT:
+        return 2 + MAX_BIGINT_WIDTH;
+    case TYPE_LARGEINT:
+        return 2 + MAX_LARGEINT_WIDTH;
+    case TYPE_FLOAT:
+        return 2 + MAX_FLOAT_STR_LENGTH;
+    case TYPE_DOUBLE:
+        return 2 + MAX_DOUBLE_STR_LENGTH;
+    case TYPE_TIME:
+        return 1 + MAX_TIME_WIDTH;
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DATEV2:
+    case TYPE_DATETIMEV2:
+        return 1 + MAX_DATETIME_WIDTH;
+    case TYPE_DECIMALV2:
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+        return 1 + MAX_DECIMAL_WIDTH;
+    case TYPE_DECIMAL128:
+        // the length, the sign, the point and 38 digits
+        return 3 + 38;
+    default:
+        return 0;
+    }
+}
+
+// The rows are built a column at a time, so without reserving them each row string reallocates
+// several times as the columns are appended to it.
+static void reserve_rows(const std::vector<VExprContext*>& output_vexpr_ctxs,
+                         const std::vector<ColumnPtr>& columns, std::vector<std::string>& rows) {
+    size_t fixed_size = 0;
+    std::vector<const ColumnString*> string_columns;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto type = output_vexpr_ctxs[i]->root()->result_type();
+        if (size_t size = max_cell_size(type); size > 0) {
+            fixed_size += size;
+            continue;
+        }
+        const auto* column = columns[i].get();
+        if (const auto* nullable_column = check_and_get_column<ColumnNullable>(column)) {
+            column = nullable_column->get_nested_column_ptr().get();
+        }
+        if (const auto* string_column = check_and_get_column<ColumnString>(column)) {
+            string_columns.push_back(string_column);
+        }
+    }
+    for (size_t row = 0; row < rows.size(); ++row) {
+        // 9 for the longest length prefix of a string
+        size_t size = fixed_size + 9 * string_columns.size();
+        for (const auto* string_column : string_columns) {
+            size += string_column->size_at(row);
+        }
+        rows[row].reserve(size);
+    }
+}
+
 Status VMysqlResultWriter::append_block(Block& input_block) {
     SCOPED_TIMER(_append_row_batch_timer);
     Status status = Status::OK();
@@ -417,8 +489,13 @@ Status VMysqlResultWriter::append_block(Block& input_block) {
     // convert one batch
     auto result = std::make_unique<TFetchDataResult>();
     result->result_batch.rows.resize(num_rows);
+    std::vector<ColumnPtr> columns(_output_vexpr_ctxs.size());
+    for (int i = 0; i < _output_vexpr_ctxs.size(); ++i) {
+        columns[i] = block.get_by_position(i).column->convert_to_full_column_if_const();
+    }
+    reserve_rows(_output_vexpr_ctxs, columns, result->result_batch.rows);
     for (int i = 0; status.ok() && i < _output_vexpr_ctxs.size(); ++i) {
-        auto column_ptr = block.get_by_position(i).column->convert_to_full_column_if_const();
+        const auto& column_ptr = columns[i];
         auto type_ptr = block.get_by_position(i).type;
 
         switch (_output_vexpr_ctxs[i]->root()->result_type()) {
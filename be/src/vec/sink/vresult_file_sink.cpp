@@ -175,9 +175,10 @@ Status VResultFileSink::close(RuntimeState* state, Status exec_status) {
                 state->fragment_instance_id());
     } else {
         if (final_status.ok()) {
-            RETURN_IF_ERROR(serialize_block(_output_block.get(), _cur_pb_block, _channels.size()));
+            auto pblock = std::make_shared<PBlock>();
+            RETURN_IF_ERROR(serialize_block(_output_block.get(), pblock.get(), _channels.size()));
             for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_block(_cur_pb_block));
+                RETURN_IF_ERROR(channel->send_block(pblock));
             }
         }
         Status final_st = Status::OK();
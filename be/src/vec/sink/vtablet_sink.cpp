@@ -57,6 +57,7 @@ Status VNodeChannel::init(RuntimeState* state) {
     RETURN_IF_ERROR(NodeChannel::init(state));
 
     _cur_mutable_block.reset(new vectorized::MutableBlock({_tuple_desc}));
+    _max_block_rows = std::max(_batch_size, config::tablet_sink_max_block_rows);
 
     // Initialize _cur_add_block_request
     _cur_add_block_request.set_allocated_id(&_parent->_load_id);
@@ -121,7 +122,8 @@ Status VNodeChannel::open_wait() {
                 for (auto& tablet : result.tablet_vec()) {
                     TTabletCommitInfo commit_info;
                     commit_info.tabletId = tablet.tablet_id();
-                    commit_info.backendId = _node_id;
+                    // set for the slave replicas in single replica load
+                    commit_info.backendId = tablet.has_node_id() ? tablet.node_id() : _node_id;
                     _tablet_commit_infos.emplace_back(std::move(commit_info));
                 }
                 _add_batches_finished = true;
@@ -170,8 +172,10 @@ Status VNodeChannel::add_row(const BlockRow& block_row, int64_t tablet_id) {
     _cur_mutable_block->add_row(block_row.first, block_row.second);
     _cur_add_block_request.add_tablet_ids(tablet_id);
 
-    if (_cur_mutable_block->rows() == _batch_size ||
-        _cur_mutable_block->bytes() > config::doris_scanner_row_bytes) {
+    // the block carries the rows of all the tablets of this index on the backend, so it is sent
+    // once it is large, rather than after each batch of the input
+    if (_cur_mutable_block->rows() >= _max_block_rows ||
+        _cur_mutable_block->bytes() >= config::tablet_sink_max_block_bytes) {
         {
             SCOPED_ATOMIC_TIMER(&_queue_push_lock_ns);
             std::lock_guard<std::mutex> l(_pending_batches_lock);
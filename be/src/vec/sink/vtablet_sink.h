@@ -58,6 +58,8 @@ protected:
 private:
     std::unique_ptr<vectorized::MutableBlock> _cur_mutable_block;
     PTabletWriterAddBlockRequest _cur_add_block_request;
+    // the current block is sent once it has this many rows or tablet_sink_max_block_bytes bytes
+    int _max_block_rows = 0;
 
     using AddBlockReq =
             std::pair<std::unique_ptr<vectorized::MutableBlock>, PTabletWriterAddBlockRequest>;
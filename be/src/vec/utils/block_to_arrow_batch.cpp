@@ -0,0 +1,206 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/utils/block_to_arrow_batch.h"
+
+#include <arrow/array.h>
+#include <arrow/array/builder_primitive.h>
+#include <arrow/builder.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/status.h>
+#include <arrow/type.h>
+#include <arrow/visit_type_inline.h>
+#include <arrow/visitor.h>
+
+#include <vector>
+
+#include "util/arrow/utils.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+
+namespace doris::vectorized {
+
+// Converts the columns of a Block to Arrow Arrays, a column at a time. The numbers and booleans
+// are appended with their null maps in one call, the other values are appended row by row.
+class FromBlockConverter : public arrow::TypeVisitor {
+public:
+    FromBlockConverter(const Block& block, const std::shared_ptr<arrow::Schema>& schema,
+                       arrow::MemoryPool* pool)
+            : _block(block), _schema(schema), _pool(pool), _num_rows(block.rows()) {}
+
+    ~FromBlockConverter() override = default;
+
+    // Use base class function
+    using arrow::TypeVisitor::Visit;
+
+#define PRIMITIVE_VISIT(TYPE) \
+    arrow::Status Visit(const arrow::TYPE& type) override { return _visit(type); }
+
+    PRIMITIVE_VISIT(Int8Type);
+    PRIMITIVE_VISIT(Int16Type);
+    PRIMITIVE_VISIT(Int32Type);
+    PRIMITIVE_VISIT(Int64Type);
+    PRIMITIVE_VISIT(FloatType);
+    PRIMITIVE_VISIT(DoubleType);
+
+#undef PRIMITIVE_VISIT
+
+    // process string-transformable field
+    arrow::Status Visit(const arrow::StringType& type) override {
+        arrow::StringBuilder builder(_pool);
+        ARROW_RETURN_NOT_OK(builder.Reserve(_num_rows));
+        const auto* string_column = check_and_get_column<ColumnString>(*_cur_column);
+        for (size_t i = 0; i < _num_rows; ++i) {
+            if (_is_null(i)) {
+                ARROW_RETURN_NOT_OK(builder.AppendNull());
+                continue;
+            }
+            if (string_column != nullptr) {
+                auto value = string_column->get_data_at(i);
+                ARROW_RETURN_NOT_OK(builder.Append(value.data, value.size));
+            } else {
+                // dates, datetimes and largeints are sent as their text
+                ARROW_RETURN_NOT_OK(builder.Append(_cur_type->to_string(*_cur_column, i)));
+            }
+        }
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    // process doris DecimalV2
+    arrow::Status Visit(const arrow::Decimal128Type& type) override {
+        const auto* decimal_column = check_and_get_column<ColumnDecimal<Decimal128>>(*_cur_column);
+        if (decimal_column == nullptr) {
+            return arrow::Status::TypeError("unsupported column type ", _cur_type->get_name());
+        }
+        std::shared_ptr<arrow::DataType> s_decimal_ptr =
+                std::make_shared<arrow::Decimal128Type>(27, 9);
+        arrow::Decimal128Builder builder(s_decimal_ptr, _pool);
+        ARROW_RETURN_NOT_OK(builder.Reserve(_num_rows));
+        const auto& data = decimal_column->get_data();
+        for (size_t i = 0; i < _num_rows; ++i) {
+            if (_is_null(i)) {
+                ARROW_RETURN_NOT_OK(builder.AppendNull());
+                continue;
+            }
+            Int128 value = data[i].value;
+            int64_t high = value >> 64;
+            uint64_t low = value;
+            ARROW_RETURN_NOT_OK(builder.Append(arrow::Decimal128(high, low)));
+        }
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    // process boolean
+    arrow::Status Visit(const arrow::BooleanType& type) override {
+        const auto* bool_column = check_and_get_column<ColumnUInt8>(*_cur_column);
+        if (bool_column == nullptr) {
+            return arrow::Status::TypeError("unsupported column type ", _cur_type->get_name());
+        }
+        arrow::BooleanBuilder builder(_pool);
+        ARROW_RETURN_NOT_OK(
+                builder.AppendValues(bool_column->get_data().data(), _num_rows, _valid_bytes()));
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    Status convert(std::shared_ptr<arrow::RecordBatch>* out);
+
+private:
+    template <typename T>
+    typename std::enable_if<std::is_base_of<arrow::PrimitiveCType, T>::value, arrow::Status>::type
+    _visit(const T& type) {
+        const auto* column = check_and_get_column<ColumnVector<typename T::c_type>>(*_cur_column);
+        if (column == nullptr) {
+            return arrow::Status::TypeError("unsupported column type ", _cur_type->get_name());
+        }
+        arrow::NumericBuilder<T> builder(_pool);
+        ARROW_RETURN_NOT_OK(builder.AppendValues(column->get_data().data(), _num_rows,
+                                                 _valid_bytes()));
+        return builder.Finish(&_arrays[_cur_field_idx]);
+    }
+
+    bool _is_null(size_t row) const { return _cur_null_map != nullptr && (*_cur_null_map)[row]; }
+
+    // the validity of the rows in the arrow layout, or null if they are all valid
+    const uint8_t* _valid_bytes() {
+        if (_cur_null_map == nullptr) {
+            return nullptr;
+        }
+        _cur_valid_bytes.resize(_num_rows);
+        for (size_t i = 0; i < _num_rows; ++i) {
+            _cur_valid_bytes[i] = !(*_cur_null_map)[i];
+        }
+        return _cur_valid_bytes.data();
+    }
+
+private:
+    const Block& _block;
+    const std::shared_ptr<arrow::Schema>& _schema;
+    arrow::MemoryPool* _pool;
+    size_t _num_rows;
+
+    size_t _cur_field_idx = 0;
+    ColumnPtr _cur_full_column;
+    // the column without the null map of the current field
+    const IColumn* _cur_column = nullptr;
+    DataTypePtr _cur_type;
+    const NullMap* _cur_null_map = nullptr;
+    std::vector<uint8_t> _cur_valid_bytes;
+
+    std::vector<std::shared_ptr<arrow::Array>> _arrays;
+};
+
+Status FromBlockConverter::convert(std::shared_ptr<arrow::RecordBatch>* out) {
+    size_t num_fields = _schema->num_fields();
+    if (_block.columns() != num_fields) {
+        return Status::InvalidArgument("number fields not match");
+    }
+
+    _arrays.resize(num_fields);
+
+    for (size_t idx = 0; idx < num_fields; ++idx) {
+        _cur_field_idx = idx;
+        const auto& column_with_type = _block.get_by_position(idx);
+        _cur_full_column = column_with_type.column->convert_to_full_column_if_const();
+        _cur_column = _cur_full_column.get();
+        _cur_type = remove_nullable(column_with_type.type);
+        _cur_null_map = nullptr;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*_cur_column)) {
+            _cur_null_map = &nullable->get_null_map_data();
+            _cur_column = &nullable->get_nested_column();
+        }
+        auto arrow_st = arrow::VisitTypeInline(*_schema->field(idx)->type(), this);
+        if (!arrow_st.ok()) {
+            return to_status(arrow_st);
+        }
+    }
+    *out = arrow::RecordBatch::Make(_schema, _num_rows, std::move(_arrays));
+    return Status::OK();
+}
+
+Status convert_to_arrow_batch(const Block& block, const std::shared_ptr<arrow::Schema>& schema,
+                              arrow::MemoryPool* pool,
+                              std::shared_ptr<arrow::RecordBatch>* result) {
+    FromBlockConverter converter(block, schema, pool);
+    return converter.convert(result);
+}
+
+} // namespace doris::vectorized
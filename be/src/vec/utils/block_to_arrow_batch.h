@@ -0,0 +1,45 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "common/status.h"
+
+// This file converts the Blocks of the vectorized engine to Arrow's RecordBatch,
+// the way util/arrow/row_batch.h does for RowBatch.
+
+namespace arrow {
+
+class MemoryPool;
+class RecordBatch;
+class Schema;
+
+} // namespace arrow
+
+namespace doris::vectorized {
+
+class Block;
+
+// Convert a Block to an Arrow RecordBatch. The columns of the block should match the fields of
+// the given schema by position, which is converted from the row descriptor of the block by
+// convert_to_arrow_schema(). Memory used by the result RecordBatch will be allocated from pool.
+Status convert_to_arrow_batch(const Block& block, const std::shared_ptr<arrow::Schema>& schema,
+                              arrow::MemoryPool* pool, std::shared_ptr<arrow::RecordBatch>* result);
+
+} // namespace doris::vectorized
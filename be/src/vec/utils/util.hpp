@@ -54,6 +54,17 @@ public:
         }
     }
 
+    // dst = lhs | rhs in one pass, dst must have the size of lhs and rhs
+    static void merge_null_maps(NullMap& dst, const NullMap& lhs, const NullMap& rhs) {
+        size_t size = dst.size();
+        auto* __restrict d = dst.data();
+        auto* __restrict l = lhs.data();
+        auto* __restrict r = rhs.data();
+        for (size_t i = 0; i < size; ++i) {
+            d[i] = l[i] | r[i];
+        }
+    }
+
     static DataTypes get_data_types(const RowDescriptor& row_desc) {
         DataTypes data_types;
         for (const auto& tuple_desc : row_desc.tuple_descriptors()) {
@@ -19,10 +19,47 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
 #include "io/local_file_reader.h"
 #include "util/stopwatch.hpp"
 
 namespace doris {
+
+// A file of 'size' bytes in memory, recording the bytes asked by each readat().
+class MemoryFileReader : public FileReader {
+public:
+    MemoryFileReader(int64_t size, std::vector<int64_t>* reads) : _reads(reads) {
+        for (int64_t i = 0; i < size; ++i) {
+            _data.push_back('a' + i % 26);
+        }
+    }
+
+    Status open() override { return Status::OK(); }
+    Status read(uint8_t* buf, int64_t buf_len, int64_t* bytes_read, bool* eof) override {
+        return Status::NotSupported("read");
+    }
+    Status readat(int64_t position, int64_t nbytes, int64_t* bytes_read, void* out) override {
+        _reads->push_back(nbytes);
+        *bytes_read = std::max<int64_t>(0, std::min(nbytes, size() - position));
+        memcpy(out, _data.data() + position, *bytes_read);
+        return Status::OK();
+    }
+    Status read_one_message(std::unique_ptr<uint8_t[]>* buf, int64_t* length) override {
+        return Status::NotSupported("read_one_message");
+    }
+    int64_t size() override { return _data.size(); }
+    Status seek(int64_t position) override { return Status::OK(); }
+    Status tell(int64_t* position) override {
+        *position = 0;
+        return Status::OK();
+    }
+    void close() override {}
+    bool closed() override { return false; }
+
+    std::string _data;
+    std::vector<int64_t>* _reads;
+};
+
 class BufferedReaderTest : public testing::Test {
 public:
     BufferedReaderTest() {}
@@ -179,4 +216,46 @@ TEST_F(BufferedReaderTest, test_miss) {
     EXPECT_EQ(45, bytes_read);
 }
 
+TEST_F(BufferedReaderTest, read_ahead) {
+    int32_t min_read_ahead_kb = config::remote_storage_min_read_ahead_kb;
+    config::remote_storage_min_read_ahead_kb = 1;
+    RuntimeProfile profile("test");
+    std::vector<int64_t> reads;
+    auto file_reader = new MemoryFileReader(20000, &reads);
+    BufferedReader reader(&profile, file_reader, 8192);
+    ASSERT_TRUE(reader.open().ok());
+
+    // the sequential reads double the bytes read ahead up to the buffer size
+    uint8_t buf[10000];
+    int64_t bytes_read = 0;
+    for (int64_t offset = 0; offset < 20000; offset += bytes_read) {
+        ASSERT_TRUE(reader.readat(offset, 100, &bytes_read, buf).ok());
+        ASSERT_EQ(100, bytes_read);
+        EXPECT_EQ(file_reader->_data.substr(offset, 100), std::string((char*)buf, 100));
+    }
+    EXPECT_EQ((std::vector<int64_t> {1024, 2048, 4096, 8192, 8192}), reads);
+
+    // a seek starts from the min read ahead again, a read larger than it is read at once
+    reads.clear();
+    ASSERT_TRUE(reader.readat(500, 100, &bytes_read, buf).ok());
+    ASSERT_TRUE(reader.readat(5000, 2000, &bytes_read, buf).ok());
+    EXPECT_EQ(2000, bytes_read);
+    EXPECT_EQ(file_reader->_data.substr(5000, 2000), std::string((char*)buf, 2000));
+    ASSERT_TRUE(reader.readat(7000, 100, &bytes_read, buf).ok());
+    EXPECT_EQ((std::vector<int64_t> {1024, 2000, 4000}), reads);
+
+    // a read larger than the buffer is not buffered
+    reads.clear();
+    ASSERT_TRUE(reader.readat(0, 10000, &bytes_read, buf).ok());
+    EXPECT_EQ(10000, bytes_read);
+    EXPECT_EQ((std::vector<int64_t> {10000}), reads);
+
+    // 0 fills the whole buffer on every miss
+    config::remote_storage_min_read_ahead_kb = 0;
+    reads.clear();
+    ASSERT_TRUE(reader.readat(12000, 100, &bytes_read, buf).ok());
+    EXPECT_EQ((std::vector<int64_t> {8192}), reads);
+    config::remote_storage_min_read_ahead_kb = min_read_ahead_kb;
+}
+
 } // end namespace doris
@@ -24,6 +24,8 @@
 
 #include "common/logging.h"
 #include "exec/es/es_predicate.h"
+#include "exec/es/es_scan_reader.h"
+#include "exec/es/es_scroll_query.h"
 #include "rapidjson/document.h"
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/stringbuffer.h"
@@ -621,4 +623,35 @@ TEST_F(BooleanQueryBuilderTest, validate_compound_and) {
             "{\"fv\":[\"8.0\",\"16.0\"]}}]}}]}}]}},{\"wildcard\":{\"content\":\"a*e*g?\"}}]}}]}}";
     EXPECT_STREQ(expected_json.c_str(), actual_bool_json.c_str());
 }
+
+TEST_F(BooleanQueryBuilderTest, sliced_scroll_query) {
+    std::vector<std::string> fields = {"id"};
+    std::vector<EsPredicate*> predicates;
+    std::map<std::string, std::string> docvalue_context;
+    std::map<std::string, std::string> props;
+    props[ESScanReader::KEY_BATCH_SIZE] = "100";
+    bool doc_value_mode = false;
+
+    rapidjson::Document query;
+    query.Parse(ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context,
+                                            &doc_value_mode)
+                        .c_str());
+    EXPECT_FALSE(query.HasMember("slice"));
+
+    props[ESScanReader::KEY_SLICE_ID] = "1";
+    props[ESScanReader::KEY_SLICE_MAX] = "3";
+    query.Parse(ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context,
+                                            &doc_value_mode)
+                        .c_str());
+    ASSERT_TRUE(query.HasMember("slice"));
+    EXPECT_EQ(1, query["slice"]["id"].GetInt());
+    EXPECT_EQ(3, query["slice"]["max"].GetInt());
+
+    // a search with terminate_after is not a scroll
+    props[ESScanReader::KEY_TERMINATE_AFTER] = "10";
+    query.Parse(ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context,
+                                            &doc_value_mode)
+                        .c_str());
+    EXPECT_FALSE(query.HasMember("slice"));
+}
 } // namespace doris
@@ -20,6 +20,7 @@
 #include "exec/decompressor.h"
 #include "exec/plain_text_line_reader.h"
 #include "io/local_file_reader.h"
+#include "runtime/stream_load/stream_load_pipe.h"
 #include "util/runtime_profile.h"
 
 namespace doris {
@@ -290,4 +291,30 @@ TEST_F(PlainTextLineReaderUncompressedTest, uncompressed_test_empty) {
     EXPECT_TRUE(eof);
 }
 
+TEST_F(PlainTextLineReaderUncompressedTest, uncompressed_stream_load_pipe) {
+    StreamLoadPipe pipe(1024, 8);
+    // the second line is split between the first two chunks, the third is a whole chunk
+    for (const std::string& chunk : {"1,2\n3,", "4,5\n", "6\n", "7,8"}) {
+        auto byte_buf = ByteBuffer::allocate(chunk.size());
+        byte_buf->put_bytes(chunk.data(), chunk.size());
+        byte_buf->flip();
+        EXPECT_TRUE(pipe.append(byte_buf).ok());
+    }
+    EXPECT_TRUE(pipe.finish().ok());
+
+    PlainTextLineReader line_reader(&_profile, &pipe, nullptr, -1, "\n", 1);
+    const uint8_t* ptr;
+    size_t size;
+    bool eof;
+    for (const std::string& expected : {"1,2", "3,4,5", "6", "7,8"}) {
+        auto st = line_reader.read_line(&ptr, &size, &eof);
+        EXPECT_TRUE(st.ok());
+        EXPECT_FALSE(eof);
+        EXPECT_EQ(expected, std::string((const char*)ptr, size));
+    }
+    auto st = line_reader.read_line(&ptr, &size, &eof);
+    EXPECT_TRUE(st.ok());
+    EXPECT_TRUE(eof);
+}
+
 } // end namespace doris
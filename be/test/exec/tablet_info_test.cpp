@@ -639,6 +639,26 @@ TEST_F(OlapTablePartitionParamTest, to_protobuf) {
     }
 }
 
+TEST_F(OlapTablePartitionParamTest, partial_update) {
+    TDescriptorTable t_desc_tbl;
+    auto t_schema = get_schema(&t_desc_tbl);
+    t_schema.__set_is_partial_update(true);
+    t_schema.__set_partial_update_input_columns({"c1", "c3"});
+    std::shared_ptr<OlapTableSchemaParam> schema(new OlapTableSchemaParam());
+    auto st = schema->init(t_schema);
+    EXPECT_TRUE(st.ok());
+    EXPECT_TRUE(schema->is_partial_update());
+    EXPECT_EQ(std::set<std::string>({"c1", "c3"}), schema->partial_update_input_columns());
+
+    POlapTableSchemaParam pschema;
+    schema->to_protobuf(&pschema);
+    std::shared_ptr<OlapTableSchemaParam> schema2(new OlapTableSchemaParam());
+    st = schema2->init(pschema);
+    EXPECT_TRUE(st.ok());
+    EXPECT_TRUE(schema2->is_partial_update());
+    EXPECT_EQ(schema->partial_update_input_columns(), schema2->partial_update_input_columns());
+}
+
 TEST_F(OlapTablePartitionParamTest, unknown_index_column) {
     TDescriptorTable t_desc_tbl;
     auto tschema = get_schema(&t_desc_tbl);
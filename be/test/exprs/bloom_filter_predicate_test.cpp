@@ -50,6 +50,44 @@ TEST_F(BloomFilterPredicateTest, bloom_filter_func_int_test) {
     func->find(nullptr);
 }
 
+TEST_F(BloomFilterPredicateTest, bloom_filter_func_find_fixed_len_test) {
+    std::unique_ptr<IBloomFilterFuncBase> func(create_bloom_filter(PrimitiveType::TYPE_BIGINT));
+    EXPECT_TRUE(func->init(1024, 0.05).ok());
+    // more values than a batch of the block bloom filter
+    const int data_size = 1000;
+    int64_t data[data_size];
+    uint8_t null_map[data_size];
+    for (int i = 0; i < data_size; i++) {
+        data[i] = i * 2;
+        null_map[i] = i % 7 == 0;
+        if (i % 2 == 0) {
+            func->insert((const void*)&data[i]);
+        }
+    }
+
+    uint8_t results[data_size];
+    func->find_fixed_len((const char*)data, nullptr, data_size, results);
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_EQ(func->find((const void*)&data[i]), results[i]);
+        if (i % 2 == 0) {
+            EXPECT_TRUE(results[i]);
+        }
+    }
+
+    func->find_fixed_len((const char*)data, null_map, data_size, results);
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_EQ(!null_map[i] && func->find((const void*)&data[i]), results[i]);
+    }
+
+    // nothing is found in an empty filter
+    func.reset(create_bloom_filter(PrimitiveType::TYPE_BIGINT));
+    EXPECT_TRUE(func->init(1024, 0.05).ok());
+    func->find_fixed_len((const char*)data, nullptr, data_size, results);
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_FALSE(results[i]);
+    }
+}
+
 TEST_F(BloomFilterPredicateTest, bloom_filter_func_stringval_test) {
     std::unique_ptr<IBloomFilterFuncBase> func(create_bloom_filter(PrimitiveType::TYPE_VARCHAR));
     EXPECT_TRUE(func->init(1024, 0.05).ok());
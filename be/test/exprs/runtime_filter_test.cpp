@@ -55,8 +55,7 @@ private:
     // std::unique_ptr<IRuntimeFilter> _runtime_filter;
 };
 
-IRuntimeFilter* create_runtime_filter(TRuntimeFilterType::type type, TQueryOptions* options,
-                                      RuntimeState* _runtime_stat, ObjectPool* _obj_pool) {
+TRuntimeFilterDesc create_runtime_filter_desc(TRuntimeFilterType::type type) {
     TRuntimeFilterDesc desc;
     desc.__set_filter_id(0);
     desc.__set_expr_order(0);
@@ -102,7 +101,12 @@ IRuntimeFilter* create_runtime_filter(TRuntimeFilterType::type type, TQueryOptio
         std::map<int, TExpr> planid_to_target_expr = {{0, target_expr}};
         desc.__set_planId_to_target_expr(planid_to_target_expr);
     }
+    return desc;
+}
 
+IRuntimeFilter* create_runtime_filter(TRuntimeFilterType::type type, TQueryOptions* options,
+                                      RuntimeState* _runtime_stat, ObjectPool* _obj_pool) {
+    TRuntimeFilterDesc desc = create_runtime_filter_desc(type);
     IRuntimeFilter* runtime_filter = nullptr;
     Status status = IRuntimeFilter::create(_runtime_stat, _obj_pool, &desc, options,
                                            RuntimeFilterRole::PRODUCER, -1, &runtime_filter);
@@ -529,4 +533,114 @@ TEST_F(RuntimeFilterTest, runtime_filter_in_or_bloom_filter_bloom_filter_merge_b
     }
 }
 
+TEST_F(RuntimeFilterTest, runtime_filter_bloom_filter_range_test) {
+    SlotRef* expr = _obj_pool.add(new SlotRef(TYPE_INT, 0));
+    ExprContext* prob_expr_ctx = _obj_pool.add(new ExprContext(expr));
+    ExprContext* build_expr_ctx = _obj_pool.add(new ExprContext(expr));
+
+    TQueryOptions options;
+    options.runtime_filter_max_in_num = 1024;
+
+    auto rows = create_rows(&_obj_pool, 100, 200);
+    auto less_data = create_rows(&_obj_pool, 1, 99);
+    auto greater_data = create_rows(&_obj_pool, 201, 300);
+
+    IRuntimeFilter* runtime_filter = create_runtime_filter(TRuntimeFilterType::BLOOM, &options,
+                                                           _runtime_stat.get(), &_obj_pool);
+    insert(runtime_filter, build_expr_ctx, rows);
+
+    // the range is sent along with the bloom filter
+    PMergeFilterRequest request;
+    void* data = nullptr;
+    int len = 0;
+    EXPECT_TRUE(runtime_filter->serialize(&request, &data, &len).ok());
+    EXPECT_TRUE(request.has_minmax_filter());
+    EXPECT_EQ(100, request.minmax_filter().min_val().intval());
+    EXPECT_EQ(200, request.minmax_filter().max_val().intval());
+
+    MergeRuntimeFilterParams params;
+    params.data = static_cast<const char*>(data);
+    params.request = &request;
+    RuntimeFilterWrapperHolder holder;
+    EXPECT_TRUE(IRuntimeFilter::create_wrapper(&params, &_obj_pool, holder.getHandle()).ok());
+
+    IRuntimeFilter* runtime_filter2 = create_runtime_filter(TRuntimeFilterType::BLOOM, &options,
+                                                            _runtime_stat.get(), &_obj_pool);
+    EXPECT_TRUE(runtime_filter2->merge_from(holder.getHandle()->get()).ok());
+
+    // a bloom filter and the range predicates
+    std::list<ExprContext*> expr_context_list;
+    EXPECT_TRUE(runtime_filter2->get_push_expr_ctxs(&expr_context_list, prob_expr_ctx).ok());
+    EXPECT_EQ(3, expr_context_list.size());
+
+    for (TupleRow& row : *rows) {
+        for (ExprContext* ctx : expr_context_list) {
+            EXPECT_TRUE(ctx->get_boolean_val(&row).val);
+        }
+    }
+    for (auto* out_of_range : {less_data, greater_data}) {
+        for (TupleRow& row : *out_of_range) {
+            int rejected = 0;
+            for (ExprContext* ctx : expr_context_list) {
+                rejected += !ctx->get_boolean_val(&row).val;
+            }
+            // rejected by the range even if the bloom filter has a false positive
+            EXPECT_GE(rejected, 1);
+        }
+    }
+}
+
+TEST_F(RuntimeFilterTest, runtime_filter_local_merge_test) {
+    SlotRef* expr = _obj_pool.add(new SlotRef(TYPE_INT, 0));
+    ExprContext* prob_expr_ctx = _obj_pool.add(new ExprContext(expr));
+    ExprContext* build_expr_ctx = _obj_pool.add(new ExprContext(expr));
+
+    TQueryOptions options;
+    options.runtime_filter_max_in_num = 1024 * 2 + 1;
+
+    auto rows1 = create_rows(&_obj_pool, 1, 1024);
+    auto rows2 = create_rows(&_obj_pool, 1025, 2048);
+    auto not_exist_data = create_rows(&_obj_pool, 2049, 3072);
+
+    RuntimeFilterLocalMerger merger;
+    EXPECT_TRUE(merger.register_filter(create_runtime_filter_desc(TRuntimeFilterType::IN),
+                                       options, 2)
+                        .ok());
+
+    IRuntimeFilter* runtime_filter = create_runtime_filter(TRuntimeFilterType::IN, &options,
+                                                           _runtime_stat.get(), &_obj_pool);
+    insert(runtime_filter, build_expr_ctx, rows1);
+
+    IRuntimeFilter* runtime_filter2 = create_runtime_filter(TRuntimeFilterType::IN, &options,
+                                                            _runtime_stat.get(), &_obj_pool);
+    insert(runtime_filter2, build_expr_ctx, rows2);
+
+    bool is_last = true;
+    EXPECT_TRUE(merger.merge(runtime_filter, &is_last).ok());
+    EXPECT_FALSE(is_last);
+    EXPECT_TRUE(merger.merge(runtime_filter2, &is_last).ok());
+    EXPECT_TRUE(is_last);
+
+    // the last producer holds the filters of both
+    std::list<ExprContext*> expr_context_list;
+    EXPECT_TRUE(runtime_filter2->get_push_expr_ctxs(&expr_context_list, prob_expr_ctx).ok());
+    EXPECT_TRUE(!expr_context_list.empty());
+
+    for (TupleRow& row : *rows1) {
+        for (ExprContext* ctx : expr_context_list) {
+            EXPECT_TRUE(ctx->get_boolean_val(&row).val);
+        }
+    }
+    for (TupleRow& row : *rows2) {
+        for (ExprContext* ctx : expr_context_list) {
+            EXPECT_TRUE(ctx->get_boolean_val(&row).val);
+        }
+    }
+    for (TupleRow& row : *not_exist_data) {
+        for (ExprContext* ctx : expr_context_list) {
+            EXPECT_FALSE(ctx->get_boolean_val(&row).val);
+        }
+    }
+}
+
 } // namespace doris
@@ -181,6 +181,26 @@ TEST_F(GeoTypesTest, polygon_hole_contains) {
     }
 }
 
+TEST_F(GeoTypesTest, polygon_prepared_contains) {
+    const char* wkt =
+            "POLYGON ((10 10, 50 10, 50 50, 10 50, 10 10), (20 20, 40 20, 40 40, 20 40, 20 20))";
+    GeoParseStatus status;
+    std::unique_ptr<GeoShape> polygon(GeoShape::from_wkt(wkt, strlen(wkt), &status));
+    EXPECT_EQ(GEO_PARSE_OK, status);
+    std::unique_ptr<GeoShape> prepared(GeoShape::from_wkt(wkt, strlen(wkt), &status));
+    EXPECT_EQ(GEO_PARSE_OK, status);
+    prepared->prepare_contains();
+
+    // the points inside, in the hole, outside and on the edges and vertices
+    for (double x = 0; x <= 60; x += 2.5) {
+        for (double y = 0; y <= 60; y += 2.5) {
+            GeoPoint point;
+            EXPECT_EQ(GEO_PARSE_OK, point.from_coord(x, y));
+            EXPECT_EQ(polygon->contains(&point), prepared->contains(&point)) << x << " " << y;
+        }
+    }
+}
+
 TEST_F(GeoTypesTest, circle) {
     GeoCircle circle;
     auto res = circle.init(110.123, 64, 1000);
@@ -20,11 +20,13 @@
 #include <gtest/gtest.h>
 
 #include "boost/algorithm/string.hpp"
+#include "common/config.h"
 #include "common/logging.h"
 #include "http/ev_http_server.h"
 #include "http/http_channel.h"
 #include "http/http_handler.h"
 #include "http/http_request.h"
+#include "http/utils.h"
 
 namespace doris {
 
@@ -68,7 +70,15 @@ public:
     }
 };
 
+static std::string s_file_path = ".http_client_test_file.dat";
+
+class HttpClientTestFileHandler : public HttpHandler {
+public:
+    void handle(HttpRequest* req) override { do_file_response(s_file_path, req); }
+};
+
 static HttpClientTestSimpleGetHandler s_simple_get_handler = HttpClientTestSimpleGetHandler();
+static HttpClientTestFileHandler s_file_handler = HttpClientTestFileHandler();
 static HttpClientTestSimplePostHandler s_simple_post_handler = HttpClientTestSimplePostHandler();
 static EvHttpServer* s_server = nullptr;
 static int real_port = 0;
@@ -84,6 +94,7 @@ public:
         s_server->register_handler(GET, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(HEAD, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(POST, "/simple_post", &s_simple_post_handler);
+        s_server->register_handler(GET, "/file", &s_file_handler);
         s_server->start();
         real_port = s_server->get_real_port();
         EXPECT_NE(0, real_port);
@@ -133,6 +144,33 @@ TEST_F(HttpClientTest, download) {
     unlink(local_file.c_str());
 }
 
+TEST_F(HttpClientTest, download_resume) {
+    std::string content = "0123456789abcdefghij";
+    auto fp = fopen(s_file_path.c_str(), "w");
+    fwrite(content.data(), 1, content.size(), fp);
+    fclose(fp);
+
+    // the first half was downloaded before
+    std::string local_file = ".http_client_test_resume.dat";
+    fp = fopen(local_file.c_str(), "w");
+    fwrite(content.data(), 1, 10, fp);
+    fclose(fp);
+
+    HttpClient client;
+    auto st = client.init(hostname + "/file");
+    EXPECT_TRUE(st.ok());
+    st = client.download(local_file, true);
+    EXPECT_TRUE(st.ok());
+    char buf[50];
+    fp = fopen(local_file.c_str(), "r");
+    auto size = fread(buf, 1, 50, fp);
+    fclose(fp);
+    buf[size] = 0;
+    EXPECT_STREQ(content.c_str(), buf);
+    unlink(local_file.c_str());
+    unlink(s_file_path.c_str());
+}
+
 TEST_F(HttpClientTest, get_failed) {
     HttpClient client;
     auto st = client.init(hostname + "/simple_get");
@@ -172,4 +210,25 @@ TEST_F(HttpClientTest, post_failed) {
     EXPECT_TRUE(boost::algorithm::contains(st.get_error_msg(), not_found));
 }
 
+TEST_F(HttpClientTest, reuse_port_server) {
+    config::enable_http_server_reuseport = true;
+    EvHttpServer server(0, 4);
+    server.register_handler(GET, "/simple_get", &s_simple_get_handler);
+    server.start();
+    config::enable_http_server_reuseport = false;
+    int port = server.get_real_port();
+    EXPECT_NE(0, port);
+    for (int i = 0; i < 16; ++i) {
+        HttpClient client;
+        auto st = client.init("http://127.0.0.1:" + std::to_string(port) + "/simple_get");
+        EXPECT_TRUE(st.ok());
+        client.set_method(GET);
+        client.set_basic_auth("test1", "");
+        std::string response;
+        st = client.execute(&response);
+        EXPECT_TRUE(st.ok());
+        EXPECT_STREQ("test1", response.c_str());
+    }
+}
+
 } // namespace doris
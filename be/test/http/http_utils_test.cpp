@@ -40,6 +40,21 @@ private:
     evhttp_request* _evhttp_req = nullptr;
 };
 
+TEST_F(HttpUtilsTest, parse_range_header) {
+    int64_t start = 0;
+    int64_t end = -1;
+    EXPECT_TRUE(parse_range_header("bytes=100-", &start, &end));
+    EXPECT_EQ(100, start);
+    EXPECT_EQ(-1, end);
+    EXPECT_TRUE(parse_range_header("bytes=10-19", &start, &end));
+    EXPECT_EQ(10, start);
+    EXPECT_EQ(19, end);
+    EXPECT_FALSE(parse_range_header("bytes=-100", &start, &end));
+    EXPECT_FALSE(parse_range_header("bytes=0-1,5-6", &start, &end));
+    EXPECT_FALSE(parse_range_header("bytes=a-", &start, &end));
+    EXPECT_FALSE(parse_range_header("lines=1-", &start, &end));
+}
+
 TEST_F(HttpUtilsTest, parse_basic_auth) {
     {
         HttpRequest req(_evhttp_req);
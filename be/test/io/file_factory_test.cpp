@@ -0,0 +1,155 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/file_factory.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+
+#include "common/config.h"
+#include "util/file_utils.h"
+#include "vec/exec/file_arrow_scanner.h"
+
+namespace doris {
+
+class FileFactoryTest : public testing::Test {
+public:
+    void SetUp() override {
+        _secure_path = config::user_files_secure_path;
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir + "/user_files/sub").ok());
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir + "/user_files_other").ok());
+        write_file(kTestDir + "/user_files/sub/data.txt");
+        write_file(kTestDir + "/user_files_other/data.txt");
+        write_file(kTestDir + "/secret.txt");
+        config::user_files_secure_path = kTestDir + "/user_files";
+    }
+
+    void TearDown() override {
+        config::user_files_secure_path = _secure_path;
+        EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+    }
+
+protected:
+    static void write_file(const std::string& path) {
+        std::ofstream file(path);
+        file << "data";
+    }
+
+    static void expect_denied(const std::string& path) {
+        std::string real_path;
+        EXPECT_FALSE(FileFactory::check_user_file_path(path, &real_path).ok()) << path;
+    }
+
+    const std::string kTestDir = "./ut_dir/file_factory_test";
+    std::string _secure_path;
+};
+
+TEST_F(FileFactoryTest, UserFileUnderSecurePath) {
+    std::string real_path;
+    EXPECT_TRUE(
+            FileFactory::check_user_file_path(kTestDir + "/user_files/sub/data.txt", &real_path)
+                    .ok());
+    EXPECT_EQ('/', real_path[0]);
+    EXPECT_NE(std::string::npos, real_path.find("/user_files/sub/data.txt"));
+
+    // the '..' staying under the secure path are fine
+    EXPECT_TRUE(FileFactory::check_user_file_path(
+                        kTestDir + "/user_files/sub/../sub/data.txt", &real_path)
+                        .ok());
+
+    // a secure path with a trailing slash is the same path
+    config::user_files_secure_path = kTestDir + "/user_files/";
+    EXPECT_TRUE(
+            FileFactory::check_user_file_path(kTestDir + "/user_files/sub/data.txt", &real_path)
+                    .ok());
+}
+
+TEST_F(FileFactoryTest, UserFileOutsideSecurePath) {
+    expect_denied(kTestDir + "/secret.txt");
+    expect_denied(kTestDir + "/user_files/../secret.txt");
+    expect_denied(kTestDir + "/user_files/sub/../../secret.txt");
+    // a sibling directory sharing the prefix of the secure path
+    expect_denied(kTestDir + "/user_files_other/data.txt");
+    // a file which doesn't exist
+    expect_denied(kTestDir + "/user_files/sub/missing.txt");
+
+    // a link under the secure path to a file outside of it
+    ASSERT_EQ(0, symlink("../../secret.txt", (kTestDir + "/user_files/sub/link.txt").c_str()));
+    expect_denied(kTestDir + "/user_files/sub/link.txt");
+    // and a link to a directory outside of it
+    ASSERT_EQ(0, symlink("../../user_files_other", (kTestDir + "/user_files/sub/dir").c_str()));
+    expect_denied(kTestDir + "/user_files/sub/dir/data.txt");
+
+    // an empty secure path disables the local files
+    config::user_files_secure_path = "";
+    expect_denied(kTestDir + "/user_files/sub/data.txt");
+}
+
+TEST_F(FileFactoryTest, ReadUserFileSchema) {
+    EXPECT_TRUE(FileUtils::copy_file("./be/test/exec/test_data/parquet_scanner/localfile.parquet",
+                                     kTestDir + "/user_files/data.parquet")
+                        .ok());
+    EXPECT_TRUE(FileUtils::copy_file("./be/test/exec/test_data/orc_scanner/my-file.orc",
+                                     kTestDir + "/user_files/data.orc")
+                        .ok());
+    auto read_schema = [&](TFileFormatType::type format, const std::string& path,
+                           std::vector<std::string>* names) {
+        TFileScanRangeParams params;
+        params.__set_file_type(TFileType::FILE_LOCAL);
+        params.__set_format_type(format);
+        TFileRangeDesc range;
+        range.__set_path(path);
+        range.__set_start_offset(0);
+        std::vector<TypeDescriptor> types;
+        Status st = vectorized::FileArrowScanner::read_file_schema(nullptr, params, range, names,
+                                                                   &types);
+        EXPECT_EQ(names->size(), types.size());
+        return st;
+    };
+
+    std::vector<std::string> names;
+    EXPECT_TRUE(read_schema(TFileFormatType::FORMAT_PARQUET, kTestDir + "/user_files/data.parquet",
+                            &names)
+                        .ok());
+    EXPECT_FALSE(names.empty());
+
+    names.clear();
+    EXPECT_TRUE(
+            read_schema(TFileFormatType::FORMAT_ORC, kTestDir + "/user_files/data.orc", &names)
+                    .ok());
+    EXPECT_FALSE(names.empty());
+
+    // the files of other formats have no schema to read
+    names.clear();
+    EXPECT_FALSE(read_schema(TFileFormatType::FORMAT_CSV_PLAIN,
+                             kTestDir + "/user_files/sub/data.txt", &names)
+                         .ok());
+    // and the files outside of the secure path are not opened
+    EXPECT_TRUE(FileUtils::copy_file("./be/test/exec/test_data/parquet_scanner/localfile.parquet",
+                                     kTestDir + "/data.parquet")
+                        .ok());
+    EXPECT_FALSE(
+            read_schema(TFileFormatType::FORMAT_PARQUET, kTestDir + "/data.parquet", &names).ok());
+    EXPECT_TRUE(names.empty());
+}
+
+} // namespace doris
@@ -0,0 +1,172 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/file_block_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace doris {
+namespace io {
+
+static const std::string kCacheDir = "./ut_dir/file_block_cache_test";
+
+// A remote file held in memory, counting the reads reaching it.
+class MemoryFileReader final : public FileReader {
+public:
+    MemoryFileReader(std::string data) : _path("s3://bucket/file"), _data(std::move(data)) {}
+
+    Status close() override { return Status::OK(); }
+
+    Status read_at(size_t offset, Slice result, size_t* bytes_read) override {
+        ++num_reads;
+        *bytes_read = std::min(result.size, _data.size() - offset);
+        memcpy(result.data, _data.data() + offset, *bytes_read);
+        return Status::OK();
+    }
+
+    const Path& path() const override { return _path; }
+
+    size_t size() const override { return _data.size(); }
+
+    bool closed() const override { return false; }
+
+    int num_reads = 0;
+
+private:
+    Path _path;
+    std::string _data;
+};
+
+class FileBlockCacheTest : public testing::Test {
+public:
+    void SetUp() override {
+        std::filesystem::remove_all(kCacheDir);
+        for (int i = 0; i < 10000; ++i) {
+            _data.push_back('a' + i % 26);
+        }
+    }
+
+    void TearDown() override { std::filesystem::remove_all(kCacheDir); }
+
+protected:
+    std::string _data;
+};
+
+TEST_F(FileBlockCacheTest, read_through_cache) {
+    MemoryFileReader remote(_data);
+    std::string buf(3000, '\0');
+    size_t bytes_read = 0;
+    {
+        FileBlockCache cache(4096);
+        ASSERT_TRUE(cache.add_path(kCacheDir, 1 << 20).ok());
+        ASSERT_TRUE(cache.read_at(&remote, 3000, Slice(buf), &bytes_read).ok());
+        ASSERT_EQ(3000, bytes_read);
+        ASSERT_EQ(_data.substr(3000, 3000), buf);
+        // Two blocks are read from the remote file.
+        ASSERT_EQ(2, remote.num_reads);
+
+        ASSERT_TRUE(cache.read_at(&remote, 4000, Slice(buf), &bytes_read).ok());
+        ASSERT_EQ(_data.substr(4000, 3000), buf);
+        ASSERT_EQ(2, remote.num_reads);
+
+        // The last block is shorter than the block size.
+        ASSERT_TRUE(cache.read_at(&remote, 9000, Slice(buf), &bytes_read).ok());
+        ASSERT_EQ(1000, bytes_read);
+        ASSERT_EQ(_data.substr(9000), buf.substr(0, 1000));
+        ASSERT_EQ(3, remote.num_reads);
+    }
+
+    // The blocks are loaded again by a new cache.
+    std::ofstream(kCacheDir + "/unfinished.tmp") << "x";
+    FileBlockCache cache(4096);
+    ASSERT_TRUE(cache.add_path(kCacheDir, 1 << 20).ok());
+    ASSERT_FALSE(std::filesystem::exists(kCacheDir + "/unfinished.tmp"));
+    ASSERT_TRUE(cache.read_at(&remote, 0, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(_data.substr(0, 3000), buf);
+    ASSERT_EQ(3, remote.num_reads);
+}
+
+TEST_F(FileBlockCacheTest, evict_blocks) {
+    MemoryFileReader remote(_data);
+    std::string buf(100, '\0');
+    size_t bytes_read = 0;
+    // Holds a single block.
+    FileBlockCache cache(4096);
+    ASSERT_TRUE(cache.add_path(kCacheDir, 4096).ok());
+    ASSERT_TRUE(cache.read_at(&remote, 0, Slice(buf), &bytes_read).ok());
+    ASSERT_TRUE(cache.read_at(&remote, 5000, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(_data.substr(5000, 100), buf);
+    ASSERT_EQ(2, remote.num_reads);
+
+    size_t num_files = 0;
+    for (auto& entry : std::filesystem::directory_iterator(kCacheDir)) {
+        (void)entry;
+        ++num_files;
+    }
+    ASSERT_EQ(1, num_files);
+
+    ASSERT_TRUE(cache.read_at(&remote, 0, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(_data.substr(0, 100), buf);
+    ASSERT_EQ(3, remote.num_reads);
+}
+
+TEST_F(FileBlockCacheTest, download_evicted_block_in_use) {
+    MemoryFileReader remote(_data);
+    std::string buf(100, '\0');
+    size_t bytes_read = 0;
+    // Holds a single block.
+    FileBlockCache cache(4096);
+    ASSERT_TRUE(cache.add_path(kCacheDir, 4096).ok());
+    ASSERT_TRUE(cache.read_at(&remote, 0, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(1, remote.num_reads);
+
+    // A reader still holds the first block when it is evicted and downloaded again.
+    Cache* lru = cache._dirs[0]->cache.get();
+    std::string key;
+    for (auto& entry : std::filesystem::directory_iterator(kCacheDir)) {
+        std::string name = entry.path().filename().native();
+        key = name.substr(0, name.rfind('_'));
+    }
+    Cache::Handle* handle = lru->lookup(CacheKey(key));
+    ASSERT_NE(nullptr, handle);
+    ASSERT_TRUE(cache.read_at(&remote, 5000, Slice(buf), &bytes_read).ok());
+    ASSERT_TRUE(cache.read_at(&remote, 0, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(3, remote.num_reads);
+
+    // Releasing the evicted block removes its own file, not the file of the new download.
+    lru->release(handle);
+    size_t num_files = 0;
+    for (auto& entry : std::filesystem::directory_iterator(kCacheDir)) {
+        (void)entry;
+        ++num_files;
+    }
+    ASSERT_EQ(1, num_files);
+    ASSERT_TRUE(cache.read_at(&remote, 100, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(_data.substr(100, 100), buf);
+    ASSERT_EQ(3, remote.num_reads);
+
+    // The generations go on after a restart.
+    FileBlockCache reloaded(4096);
+    ASSERT_TRUE(reloaded.add_path(kCacheDir, 4096).ok());
+    ASSERT_EQ(cache._next_generation, reloaded._next_generation);
+}
+
+} // namespace io
+} // namespace doris
@@ -0,0 +1,124 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/local_file_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <vector>
+
+#include "common/config.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/io_uring.h"
+#include "io/fs/local_file_system.h"
+
+namespace doris {
+namespace io {
+
+static const std::string kTestDir = "./ut_dir/local_file_reader_test";
+
+class LocalFileReaderTest : public testing::TestWithParam<bool> {
+public:
+    void SetUp() override {
+        std::filesystem::remove_all(kTestDir);
+        std::filesystem::create_directories(kTestDir);
+        for (int i = 0; i < 100000; ++i) {
+            _data.push_back('a' + i % 26);
+        }
+        FileWriterPtr writer;
+        ASSERT_TRUE(global_local_filesystem()->create_file(_path, &writer).ok());
+        ASSERT_TRUE(writer->append(Slice(_data)).ok());
+        ASSERT_TRUE(writer->close().ok());
+        _enable_io_uring = config::enable_io_uring;
+        config::enable_io_uring = GetParam();
+    }
+
+    void TearDown() override {
+        config::enable_io_uring = _enable_io_uring;
+        std::filesystem::remove_all(kTestDir);
+    }
+
+protected:
+    std::string _path = kTestDir + "/data";
+    std::string _data;
+    bool _enable_io_uring;
+};
+
+TEST_P(LocalFileReaderTest, read_at_batch) {
+    FileReaderSPtr reader;
+    ASSERT_TRUE(global_local_filesystem()->open_file(_path, &reader).ok());
+
+    // More ranges than the queue depth, the last one is cut at the end of the file.
+    const size_t num_ranges = config::io_uring_queue_depth + 10;
+    std::vector<std::string> bufs(num_ranges, std::string(1000, '\0'));
+    std::vector<ReadRange> ranges(num_ranges);
+    for (size_t i = 0; i < num_ranges; ++i) {
+        ranges[i].offset = i * 1000 + (i % 3) * 7;
+        ranges[i].result = Slice(bufs[i]);
+    }
+    ranges.back().offset = _data.size() - 300;
+    ASSERT_TRUE(reader->read_at_batch(ranges.data(), num_ranges).ok());
+    for (size_t i = 0; i + 1 < num_ranges; ++i) {
+        ASSERT_EQ(1000, ranges[i].bytes_read);
+        ASSERT_EQ(_data.substr(ranges[i].offset, 1000), bufs[i]);
+    }
+    ASSERT_EQ(300, ranges.back().bytes_read);
+    ASSERT_EQ(_data.substr(_data.size() - 300), bufs.back().substr(0, 300));
+
+    std::string buf(100, '\0');
+    size_t bytes_read = 0;
+    ASSERT_TRUE(reader->read_at(500, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(100, bytes_read);
+    ASSERT_EQ(_data.substr(500, 100), buf);
+    ASSERT_FALSE(reader->read_at(_data.size() + 1, Slice(buf), &bytes_read).ok());
+}
+
+TEST_P(LocalFileReaderTest, io_uring_enter_failure) {
+    IoUring* ring = IoUring::thread_local_ring();
+    if (!GetParam() || ring == nullptr) {
+        GTEST_SKIP() << "io_uring is not used";
+    }
+    FileReaderSPtr reader;
+    ASSERT_TRUE(global_local_filesystem()->open_file(_path, &reader).ok());
+    std::vector<std::string> bufs(3, std::string(1000, '\0'));
+    std::vector<ReadRange> ranges(3);
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        ranges[i].offset = i * 1000;
+        ranges[i].result = Slice(bufs[i]);
+    }
+
+    // The ring can't be entered, the read fails instead of aborting.
+    int ring_fd = ring->_ring_fd;
+    ring->_ring_fd = -1;
+    auto st = reader->read_at_batch(ranges.data(), ranges.size());
+    ring->_ring_fd = ring_fd;
+    ASSERT_FALSE(st.ok());
+    ASSERT_TRUE(st.is_io_error()) << st.to_string();
+
+    // The reads taken back from the ring are not submitted by the next read.
+    ASSERT_TRUE(reader->read_at_batch(ranges.data(), ranges.size()).ok());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        ASSERT_EQ(1000, ranges[i].bytes_read);
+        ASSERT_EQ(_data.substr(i * 1000, 1000), bufs[i]);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(IoUring, LocalFileReaderTest, testing::Values(false, true));
+
+} // namespace io
+} // namespace doris
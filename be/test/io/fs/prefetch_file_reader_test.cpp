@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/prefetch_file_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+
+#include "util/threadpool.h"
+
+namespace doris {
+namespace io {
+
+class CountingFileReader final : public FileReader {
+public:
+    CountingFileReader(std::string data) : _path("s3://bucket/file"), _data(std::move(data)) {}
+
+    Status close() override { return Status::OK(); }
+
+    Status read_at(size_t offset, Slice result, size_t* bytes_read) override {
+        ++num_reads;
+        *bytes_read = std::min(result.size, _data.size() - offset);
+        memcpy(result.data, _data.data() + offset, *bytes_read);
+        return Status::OK();
+    }
+
+    const Path& path() const override { return _path; }
+
+    size_t size() const override { return _data.size(); }
+
+    bool closed() const override { return false; }
+
+    std::atomic<int> num_reads {0};
+
+private:
+    Path _path;
+    std::string _data;
+};
+
+TEST(PrefetchFileReaderTest, read_prefetched_ranges) {
+    std::string data;
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back('a' + i % 26);
+    }
+    CountingFileReader remote(data);
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_TRUE(ThreadPoolBuilder("PrefetchTest").set_max_threads(2).build(&pool).ok());
+
+    PrefetchFileReader reader(&remote, pool.get());
+    reader.prefetch(100, 200);
+    reader.prefetch(400, 100);
+
+    std::string buf(50, '\0');
+    size_t bytes_read = 0;
+    ASSERT_TRUE(reader.read_at(100, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(data.substr(100, 50), buf);
+    ASSERT_TRUE(reader.read_at(250, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(data.substr(250, 50), buf);
+    // Not covered by a prefetched range.
+    ASSERT_TRUE(reader.read_at(320, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(data.substr(320, 50), buf);
+    ASSERT_TRUE(reader.read_at(440, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(data.substr(440, 50), buf);
+    ASSERT_EQ(3, remote.num_reads);
+
+    reader.prefetch(600, 100);
+    reader.reset();
+    ASSERT_TRUE(reader.read_at(600, Slice(buf), &bytes_read).ok());
+    ASSERT_EQ(data.substr(600, 50), buf);
+}
+
+} // namespace io
+} // namespace doris
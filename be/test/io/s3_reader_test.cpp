@@ -0,0 +1,188 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/s3_reader.h"
+
+#include <aws/core/auth/AWSCredentials.h>
+#include <aws/s3/S3Client.h>
+#include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "util/threadpool.h"
+
+namespace doris {
+
+// An S3 file in memory, whose reads of the ranges starting at short_offset return a byte less.
+class S3ReaderClientMock : public Aws::S3::S3Client {
+public:
+    explicit S3ReaderClientMock(std::string data) : _data(std::move(data)) {}
+
+    Aws::S3::Model::HeadObjectOutcome HeadObject(
+            const Aws::S3::Model::HeadObjectRequest& request) const override {
+        Aws::S3::Model::HeadObjectOutcome response;
+        response.GetResult().SetContentLength(_data.size());
+        response.success = true;
+        return response;
+    }
+
+    Aws::S3::Model::GetObjectOutcome GetObject(
+            const Aws::S3::Model::GetObjectRequest& request) const override {
+        int64_t first = 0;
+        int64_t last = 0;
+        EXPECT_EQ(2, sscanf(request.GetRange().c_str(), "bytes=%ld-%ld", &first, &last));
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            _ranges.emplace_back(first, last);
+        }
+        int64_t len = std::min<int64_t>(last + 1, _data.size()) - first;
+        if (first == short_offset) {
+            --len;
+        }
+        Aws::IOStream* body = request.GetResponseStreamFactory()();
+        body->write(_data.data() + first, len);
+        Aws::S3::Model::GetObjectOutcome response;
+        response.GetResult().ReplaceBody(body);
+        response.GetResult().SetContentLength(len);
+        response.success = true;
+        return response;
+    }
+
+    std::vector<std::pair<int64_t, int64_t>> ranges() const {
+        std::lock_guard<std::mutex> l(_lock);
+        auto ranges = _ranges;
+        std::sort(ranges.begin(), ranges.end());
+        return ranges;
+    }
+
+    int64_t short_offset = -1;
+
+private:
+    std::string _data;
+    mutable std::mutex _lock;
+    mutable std::vector<std::pair<int64_t, int64_t>> _ranges;
+};
+
+class S3ReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        for (int i = 0; i < 10000; ++i) {
+            _data.push_back('a' + i % 26);
+        }
+        _part_size = config::s3_parallel_read_part_size_bytes;
+        config::s3_parallel_read_part_size_bytes = 1000;
+        ASSERT_TRUE(ThreadPoolBuilder("S3ReaderTest")
+                            .set_max_threads(2)
+                            .build(&ExecEnv::GetInstance()->_remote_prefetch_thread_pool)
+                            .ok());
+    }
+
+    void TearDown() override {
+        config::s3_parallel_read_part_size_bytes = _part_size;
+        ExecEnv::GetInstance()->_remote_prefetch_thread_pool.reset();
+    }
+
+protected:
+    // Opens the reader of the file on the mock client.
+    void _open(S3Reader* reader, std::shared_ptr<S3ReaderClientMock>* client) {
+        *client = std::make_shared<S3ReaderClientMock>(_data);
+        reader->_client = *client;
+        ASSERT_TRUE(reader->open().ok());
+        ASSERT_EQ(_data.size(), static_cast<size_t>(reader->size()));
+    }
+
+    const std::map<std::string, std::string> _properties = {{"AWS_ACCESS_KEY", "ak"},
+                                                            {"AWS_SECRET_KEY", "sk"},
+                                                            {"AWS_ENDPOINT", "127.0.0.1:9000"},
+                                                            {"AWS_REGION", "region"}};
+    std::string _data;
+    int64_t _part_size;
+};
+
+TEST_F(S3ReaderTest, parts_at_file_tail) {
+    S3Reader reader(_properties, "s3://bucket/file", 0);
+    std::shared_ptr<S3ReaderClientMock> client;
+    _open(&reader, &client);
+
+    // the read is cut at the end of the file, whose last part is shorter
+    std::string buf(5000, '\0');
+    int64_t bytes_read = 0;
+    ASSERT_TRUE(reader.readat(7500, buf.size(), &bytes_read, buf.data()).ok());
+    ASSERT_EQ(2500, bytes_read);
+    EXPECT_EQ(_data.substr(7500), buf.substr(0, bytes_read));
+    std::vector<std::pair<int64_t, int64_t>> ranges = {{7500, 8499}, {8500, 9499}, {9500, 9999}};
+    EXPECT_EQ(ranges, client->ranges());
+
+    // the parts of a read of a multiple of the part size
+    ASSERT_TRUE(reader.readat(1000, 2000, &bytes_read, buf.data()).ok());
+    ASSERT_EQ(2000, bytes_read);
+    EXPECT_EQ(_data.substr(1000, 2000), buf.substr(0, bytes_read));
+    ranges.insert(ranges.begin(), {{1000, 1999}, {2000, 2999}});
+    EXPECT_EQ(ranges, client->ranges());
+
+    // a read of one part, and a read after the end of the file
+    ASSERT_TRUE(reader.readat(9000, 1000, &bytes_read, buf.data()).ok());
+    ASSERT_EQ(1000, bytes_read);
+    EXPECT_EQ(_data.substr(9000), buf.substr(0, bytes_read));
+    ASSERT_TRUE(reader.readat(10000, 1000, &bytes_read, buf.data()).ok());
+    EXPECT_EQ(0, bytes_read);
+    EXPECT_EQ(6, client->ranges().size());
+}
+
+TEST_F(S3ReaderTest, one_range_without_pool) {
+    ExecEnv::GetInstance()->_remote_prefetch_thread_pool.reset();
+    S3Reader reader(_properties, "s3://bucket/file", 0);
+    std::shared_ptr<S3ReaderClientMock> client;
+    _open(&reader, &client);
+
+    std::string buf(4000, '\0');
+    int64_t bytes_read = 0;
+    ASSERT_TRUE(reader.readat(100, buf.size(), &bytes_read, buf.data()).ok());
+    ASSERT_EQ(4000, bytes_read);
+    EXPECT_EQ(_data.substr(100, 4000), buf);
+    std::vector<std::pair<int64_t, int64_t>> ranges = {{100, 4099}};
+    EXPECT_EQ(ranges, client->ranges());
+}
+
+TEST_F(S3ReaderTest, short_body) {
+    S3Reader reader(_properties, "s3://bucket/file", 0);
+    std::shared_ptr<S3ReaderClientMock> client;
+    _open(&reader, &client);
+
+    // a part fetched by the pool, the part read by the caller and a read of one part
+    std::string buf(3000, '\0');
+    int64_t bytes_read = 0;
+    client->short_offset = 2000;
+    EXPECT_FALSE(reader.readat(1000, 3000, &bytes_read, buf.data()).ok());
+    client->short_offset = 1000;
+    EXPECT_FALSE(reader.readat(1000, 3000, &bytes_read, buf.data()).ok());
+    client->short_offset = 5000;
+    EXPECT_FALSE(reader.readat(5000, 1000, &bytes_read, buf.data()).ok());
+    client->short_offset = -1;
+    ASSERT_TRUE(reader.readat(1000, 3000, &bytes_read, buf.data()).ok());
+    EXPECT_EQ(3000, bytes_read);
+}
+
+} // namespace doris
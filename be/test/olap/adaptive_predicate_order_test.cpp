@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/adaptive_predicate_order.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace doris {
+
+TEST(AdaptivePredicateOrderTest, SelectiveAndCheapFirst) {
+    AdaptivePredicateOrder<int> order(2);
+    std::vector<int> predicates {1, 2, 3};
+
+    // 1 is expensive and keeps most rows, 2 is cheap and removes most, 3 removes none
+    order.update(0, 1000, 900, 100000);
+    order.update(1, 900, 90, 900);
+    order.update(2, 90, 90, 90);
+    EXPECT_FALSE(order.reorder(&predicates));
+    EXPECT_EQ((std::vector<int> {1, 2, 3}), predicates);
+
+    EXPECT_TRUE(order.reorder(&predicates));
+    EXPECT_EQ((std::vector<int> {2, 1, 3}), predicates);
+
+    // the measures follow the predicates they are of
+    order.update(0, 1000, 100, 1000);
+    order.update(1, 100, 90, 10000);
+    EXPECT_FALSE(order.reorder(&predicates));
+    EXPECT_FALSE(order.reorder(&predicates));
+    EXPECT_EQ((std::vector<int> {2, 1, 3}), predicates);
+}
+
+TEST(AdaptivePredicateOrderTest, NotReachedGoLast) {
+    AdaptivePredicateOrder<int> order(1);
+    std::vector<int> predicates {1, 2, 3};
+
+    // 1 removes all the rows, so 2 is never evaluated
+    order.update(0, 1000, 0, 1000);
+    order.update(2, 0, 0, 0);
+    order.update(1, 0, 0, 0);
+    std::vector<int> expected {1, 2, 3};
+    order.reorder(&predicates);
+    EXPECT_EQ(expected, predicates);
+
+    // a predicate that becomes selective moves ahead of the ones removing nothing
+    AdaptivePredicateOrder<int> order2(1);
+    std::vector<int> predicates2 {1, 2};
+    order2.update(0, 1000, 1000, 1000);
+    order2.update(1, 1000, 10, 1000);
+    EXPECT_TRUE(order2.reorder(&predicates2));
+    EXPECT_EQ((std::vector<int> {2, 1}), predicates2);
+}
+
+} // namespace doris
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_io_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "common/config.h"
+#include "olap/data_dir.h"
+#include "util/stopwatch.hpp"
+
+namespace doris {
+
+static constexpr int64_t MB = 1024 * 1024;
+
+class CompactionIOSchedulerTest : public testing::Test {
+public:
+    void SetUp() override {
+        _enable = config::enable_compaction_io_scheduler;
+        config::enable_compaction_io_scheduler = true;
+        config::compaction_io_max_mbytes_per_sec_per_disk = 100;
+        config::compaction_io_min_mbytes_per_sec_per_disk = 10;
+        config::compaction_io_query_latency_target_us = 10000;
+    }
+
+    void TearDown() override { config::enable_compaction_io_scheduler = _enable; }
+
+protected:
+    // wait for the rate of the disk to be adjusted on its next access
+    void wait_for_adjustment() { std::this_thread::sleep_for(std::chrono::milliseconds(1100)); }
+
+    bool _enable;
+    DataDir _data_dir {"./ut_dir/compaction_io_scheduler_test"};
+};
+
+TEST_F(CompactionIOSchedulerTest, AdaptToQueryLatency) {
+    CompactionIOScheduler scheduler;
+    EXPECT_EQ(100 * MB, scheduler.rate(&_data_dir));
+    EXPECT_EQ(0, scheduler.query_io_pressure(&_data_dir));
+
+    // the queries read 100 pages in 20ms each, twice the target
+    scheduler.report_query_io(&_data_dir, 100 * 20 * 1000 * 1000L, 100);
+    wait_for_adjustment();
+    EXPECT_EQ(50 * MB, scheduler.rate(&_data_dir));
+    EXPECT_EQ(1, scheduler.query_io_pressure(&_data_dir));
+
+    // never below the min rate
+    for (int i = 0; i < 3; ++i) {
+        scheduler.report_query_io(&_data_dir, 100 * 20 * 1000 * 1000L, 100);
+        wait_for_adjustment();
+        scheduler.rate(&_data_dir);
+    }
+    EXPECT_EQ(10 * MB, scheduler.rate(&_data_dir));
+
+    // the rate grows back without slow queries
+    wait_for_adjustment();
+    EXPECT_EQ(20 * MB, scheduler.rate(&_data_dir));
+    EXPECT_EQ(0, scheduler.query_io_pressure(&_data_dir));
+}
+
+TEST_F(CompactionIOSchedulerTest, Acquire) {
+    CompactionIOScheduler scheduler;
+    MonotonicStopWatch watch;
+    watch.start();
+    // within the tokens saved up
+    scheduler.acquire(&_data_dir, 10 * MB, false);
+    EXPECT_LT(watch.elapsed_time(), 500UL * 1000 * 1000);
+
+    // 100MB of debt at 100MB/s
+    watch.reset();
+    scheduler.acquire(&_data_dir, 190 * MB, false);
+    EXPECT_GE(watch.elapsed_time(), 500UL * 1000 * 1000);
+
+    // nothing is metered when the scheduler is disabled
+    config::enable_compaction_io_scheduler = false;
+    watch.reset();
+    scheduler.acquire(&_data_dir, 1000 * MB, false);
+    EXPECT_LT(watch.elapsed_time(), 500UL * 1000 * 1000);
+}
+
+} // namespace doris
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_score_index.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace doris {
+
+TEST(CompactionScoreIndexTest, NextByScore) {
+    CompactionScoreIndex index;
+    index.update(1, 10);
+    index.update(2, 30);
+    index.update(3, 20);
+    // the tablets of score 0 are never compacted
+    index.update(4, 0);
+    EXPECT_EQ(3U, index.size());
+
+    std::vector<TTabletId> tablet_ids;
+    CompactionScoreIndex::Entry entry = CompactionScoreIndex::BEGIN;
+    while (index.next_by_score(&entry)) {
+        tablet_ids.push_back(entry.second);
+    }
+    EXPECT_EQ((std::vector<TTabletId> {2, 3, 1}), tablet_ids);
+
+    // a new score replaces the old one
+    index.update(1, 40);
+    index.update(2, 0);
+    entry = CompactionScoreIndex::BEGIN;
+    ASSERT_TRUE(index.next_by_score(&entry));
+    EXPECT_EQ(40U, entry.first);
+    EXPECT_EQ(1, entry.second);
+    ASSERT_TRUE(index.next_by_score(&entry));
+    EXPECT_EQ(3, entry.second);
+    EXPECT_FALSE(index.next_by_score(&entry));
+
+    index.remove(1);
+    index.remove(3);
+    EXPECT_EQ(0U, index.size());
+    entry = CompactionScoreIndex::BEGIN;
+    EXPECT_FALSE(index.next_by_score(&entry));
+}
+
+TEST(CompactionScoreIndexTest, TakeDirty) {
+    CompactionScoreIndex index;
+    index.mark_dirty(1);
+    index.mark_dirty(2);
+    index.mark_dirty(1);
+    std::vector<TTabletId> tablet_ids = index.take_dirty();
+    std::sort(tablet_ids.begin(), tablet_ids.end());
+    EXPECT_EQ((std::vector<TTabletId> {1, 2}), tablet_ids);
+    EXPECT_TRUE(index.take_dirty().empty());
+}
+
+} // namespace doris
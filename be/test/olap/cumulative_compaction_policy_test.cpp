@@ -24,6 +24,7 @@
 #include "olap/cumulative_compaction.h"
 #include "olap/rowset/rowset_meta.h"
 #include "olap/tablet_meta.h"
+#include "util/time.h"
 
 namespace doris {
 
@@ -952,6 +953,141 @@ TEST_F(TestSizeBasedCumulativeCompactionPolicy, _pick_missing_version_cumulative
     compaction.find_longest_consecutive_version(&rowsets3, nullptr);
     EXPECT_EQ(0, rowsets3.size());
 }
+
+class TestTimeSeriesCumulativeCompactionPolicy : public testing::Test {
+public:
+    TestTimeSeriesCumulativeCompactionPolicy() {}
+    void SetUp() {
+        config::time_series_compaction_goal_size_mbytes = 1;
+        config::time_series_compaction_file_count_threshold = 1000;
+        config::time_series_compaction_time_threshold_seconds = 3600;
+
+        _tablet_meta = static_cast<TabletMetaSharedPtr>(new TabletMeta(
+                1, 2, 15673, 15674, 4, 5, TTabletSchema(), 6, {{7, 8}}, UniqueId(9, 10),
+                TTabletType::TABLET_TYPE_DISK, TCompressionType::LZ4F));
+
+        _json_rowset_meta = R"({
+            "rowset_id": 540081,
+            "tablet_id": 15673,
+            "txn_id": 4042,
+            "tablet_schema_hash": 567997577,
+            "rowset_type": "BETA_ROWSET",
+            "rowset_state": "VISIBLE",
+            "start_version": 2,
+            "end_version": 2,
+            "num_rows": 3929,
+            "total_disk_size": 409600,
+            "data_disk_size": 409600,
+            "index_disk_size": 235,
+            "empty": false,
+            "load_id": {
+                "hi": -5350970832824939812,
+                "lo": -6717994719194512122
+            },
+            "creation_time": 1553765670,
+            "num_segments": 3
+        })";
+    }
+    void TearDown() {}
+
+    void init_rs_meta(RowsetMetaSharedPtr& pb1, int64_t start, int64_t end,
+                      int64_t creation_time) {
+        pb1->init_from_json(_json_rowset_meta);
+        pb1->set_start_version(start);
+        pb1->set_end_version(end);
+        pb1->set_creation_time(creation_time);
+    }
+
+    // a base rowset followed by `num_loads` overlapping loads
+    TabletSharedPtr create_tablet(int num_loads, int64_t creation_time) {
+        RowsetMetaSharedPtr base(new RowsetMeta());
+        init_rs_meta(base, 0, 1, creation_time);
+        base->set_segments_overlap(NONOVERLAPPING);
+        _tablet_meta->add_rs_meta(base);
+        for (int i = 0; i < num_loads; ++i) {
+            RowsetMetaSharedPtr load(new RowsetMeta());
+            init_rs_meta(load, i + 2, i + 2, creation_time);
+            load->set_segments_overlap(OVERLAPPING);
+            _tablet_meta->add_rs_meta(load);
+        }
+        TabletSharedPtr tablet(new Tablet(_tablet_meta, nullptr, CUMULATIVE_TIME_SERIES_POLICY));
+        tablet->init();
+        tablet->calculate_cumulative_point();
+        return tablet;
+    }
+
+    size_t pick_input_rowsets(TabletSharedPtr tablet, std::vector<RowsetSharedPtr>* input_rowsets) {
+        std::vector<RowsetSharedPtr> candidate_rowsets;
+        tablet->pick_candidate_rowsets_to_cumulative_compaction(&candidate_rowsets);
+        Version last_delete_version {-1, -1};
+        size_t compaction_score = 0;
+        tablet->_cumulative_compaction_policy->pick_input_rowsets(
+                tablet.get(), candidate_rowsets, 1000, 5, input_rowsets, &last_delete_version,
+                &compaction_score);
+        return compaction_score;
+    }
+
+protected:
+    std::string _json_rowset_meta;
+    TabletMetaSharedPtr _tablet_meta;
+};
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, calculate_cumulative_point) {
+    TabletSharedPtr tablet = create_tablet(4, UnixSeconds());
+    EXPECT_EQ(2, tablet->cumulative_layer_point());
+}
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, pick_input_rowsets_goal_size) {
+    TabletSharedPtr tablet = create_tablet(4, UnixSeconds());
+    std::vector<RowsetSharedPtr> input_rowsets;
+    size_t compaction_score = pick_input_rowsets(tablet, &input_rowsets);
+
+    // three loads of 400KB reach the goal size of 1MB
+    EXPECT_EQ(3, input_rowsets.size());
+    EXPECT_EQ(9, compaction_score);
+    EXPECT_EQ(4, input_rowsets.back()->end_version());
+}
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, pick_input_rowsets_wait) {
+    TabletSharedPtr tablet = create_tablet(2, UnixSeconds());
+    std::vector<RowsetSharedPtr> input_rowsets;
+    size_t compaction_score = pick_input_rowsets(tablet, &input_rowsets);
+
+    EXPECT_EQ(0, input_rowsets.size());
+    EXPECT_EQ(0, compaction_score);
+    const uint32_t score = tablet->calc_compaction_score(
+            CompactionType::CUMULATIVE_COMPACTION, tablet->_cumulative_compaction_policy);
+    EXPECT_EQ(0, score);
+}
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, pick_input_rowsets_time_threshold) {
+    TabletSharedPtr tablet = create_tablet(2, UnixSeconds() - 7200);
+    std::vector<RowsetSharedPtr> input_rowsets;
+    size_t compaction_score = pick_input_rowsets(tablet, &input_rowsets);
+
+    EXPECT_EQ(2, input_rowsets.size());
+    EXPECT_EQ(6, compaction_score);
+    const uint32_t score = tablet->calc_compaction_score(
+            CompactionType::CUMULATIVE_COMPACTION, tablet->_cumulative_compaction_policy);
+    EXPECT_EQ(6, score);
+}
+
+TEST_F(TestTimeSeriesCumulativeCompactionPolicy, update_cumulative_point) {
+    TabletSharedPtr tablet = create_tablet(4, UnixSeconds());
+    std::vector<RowsetSharedPtr> input_rowsets;
+    pick_input_rowsets(tablet, &input_rowsets);
+    Version last_delete_version {-1, -1};
+    // the output rowset is promoted without reaching any size
+    tablet->_cumulative_compaction_policy->update_cumulative_point(
+            tablet.get(), input_rowsets, tablet->get_rowset_by_version({4, 4}),
+            last_delete_version);
+    EXPECT_EQ(5, tablet->cumulative_layer_point());
+
+    // the promoted rowsets without delete predicates are not base compacted
+    const uint32_t score = tablet->calc_compaction_score(CompactionType::BASE_COMPACTION,
+                                                         tablet->_cumulative_compaction_policy);
+    EXPECT_EQ(0, score);
+}
 } // namespace doris
 
 // @brief Test Stub
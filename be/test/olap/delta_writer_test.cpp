@@ -20,13 +20,16 @@
 #include <gtest/gtest.h>
 #include <sys/file.h>
 
+#include <numeric>
 #include <string>
 
 #include "gen_cpp/Descriptors_types.h"
 #include "gen_cpp/PaloInternalService_types.h"
 #include "gen_cpp/Types_types.h"
 #include "olap/field.h"
+#include "olap/key_coder.h"
 #include "olap/options.h"
+#include "olap/short_key_index.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
 #include "olap/tablet_meta_manager.h"
@@ -283,6 +286,33 @@ static void create_tablet_request_with_sequence_col(int64_t tablet_id, int32_t s
     request->tablet_schema.columns.push_back(v2);
 }
 
+static void create_tablet_request_with_merge_on_write(int64_t tablet_id, int32_t schema_hash,
+                                                      TCreateTabletReq* request) {
+    request->tablet_id = tablet_id;
+    request->__set_version(1);
+    request->tablet_schema.schema_hash = schema_hash;
+    request->tablet_schema.short_key_column_count = 1;
+    request->tablet_schema.keys_type = TKeysType::UNIQUE_KEYS;
+    request->tablet_schema.storage_type = TStorageType::COLUMN;
+    request->__set_storage_format(TStorageFormat::V2);
+    request->__set_enable_unique_key_merge_on_write(true);
+
+    TColumn k1;
+    k1.column_name = "k1";
+    k1.__set_is_key(true);
+    k1.column_type.type = TPrimitiveType::INT;
+    request->tablet_schema.columns.push_back(k1);
+
+    for (const char* name : {"v1", "v2"}) {
+        TColumn v;
+        v.column_name = name;
+        v.__set_is_key(false);
+        v.column_type.type = TPrimitiveType::INT;
+        v.__set_aggregation_type(TAggregationType::REPLACE);
+        request->tablet_schema.columns.push_back(v);
+    }
+}
+
 static TDescriptorTable create_descriptor_tablet() {
     TDescriptorTableBuilder dtb;
     TTupleDescriptorBuilder tuple_builder;
@@ -359,6 +389,23 @@ static TDescriptorTable create_descriptor_tablet_with_sequence_col() {
     return dtb.desc_tbl();
 }
 
+static TDescriptorTable create_descriptor_tablet_with_merge_on_write() {
+    TDescriptorTableBuilder dtb;
+    TTupleDescriptorBuilder tuple_builder;
+    int column_pos = 0;
+    for (const char* name : {"k1", "v1", "v2"}) {
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .type(TYPE_INT)
+                                       .nullable(false)
+                                       .column_name(name)
+                                       .column_pos(column_pos++)
+                                       .build());
+    }
+    tuple_builder.build(&dtb);
+
+    return dtb.desc_tbl();
+}
+
 class TestDeltaWriter : public ::testing::Test {
 public:
     TestDeltaWriter() {}
@@ -836,4 +883,122 @@ TEST_F(TestDeltaWriter, vec_sequence_col) {
     delete delta_writer;
 }
 
+TEST_F(TestDeltaWriter, partial_update_of_merge_on_write_table) {
+    TCreateTabletReq request;
+    create_tablet_request_with_merge_on_write(10006, 270068378, &request);
+    Status res = k_engine->create_tablet(request);
+    ASSERT_TRUE(res.ok());
+    TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(request.tablet_id);
+
+    TDescriptorTable tdesc_tbl = create_descriptor_tablet_with_merge_on_write();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+
+    auto make_block = [&](const std::vector<std::vector<int32_t>>& rows) {
+        vectorized::Block block;
+        for (const auto& slot_desc : tuple_desc->slots()) {
+            block.insert(vectorized::ColumnWithTypeAndName(slot_desc->get_empty_mutable_column(),
+                                                           slot_desc->get_data_type_ptr(),
+                                                           slot_desc->col_name()));
+        }
+        auto columns = block.mutate_columns();
+        for (const auto& row : rows) {
+            for (size_t i = 0; i < row.size(); ++i) {
+                columns[i]->insert_data((const char*)&row[i], sizeof(row[i]));
+            }
+        }
+        block.set_columns(std::move(columns));
+        return block;
+    };
+
+    // Loads the rows (k1, v1, v2) and publishes them. A partial update carries the default 0
+    // in the columns it doesn't load, like the load planned by the FE.
+    auto load = [&](int64_t txn_id, const std::vector<std::vector<int32_t>>& rows,
+                    const std::vector<std::string>& partial_update_input_columns) {
+        PUniqueId load_id;
+        load_id.set_hi(0);
+        load_id.set_lo(txn_id);
+        WriteRequest write_req = {request.tablet_id, 270068378,  WriteType::LOAD,
+                                  txn_id,            30004,      load_id,
+                                  tuple_desc,        &tuple_desc->slots()};
+        if (!partial_update_input_columns.empty()) {
+            write_req.ptable_schema_param.set_partial_update(true);
+            for (const auto& column : partial_update_input_columns) {
+                write_req.ptable_schema_param.add_partial_update_input_columns(column);
+            }
+        }
+        DeltaWriter* delta_writer = nullptr;
+        DeltaWriter::open(&write_req, &delta_writer, true);
+        ASSERT_NE(delta_writer, nullptr);
+
+        vectorized::Block block = make_block(rows);
+        std::vector<int> row_idxs(rows.size());
+        std::iota(row_idxs.begin(), row_idxs.end(), 0);
+        ASSERT_TRUE(delta_writer->write(&block, row_idxs).ok());
+        ASSERT_TRUE(delta_writer->close().ok());
+        ASSERT_TRUE(delta_writer->close_wait().ok());
+        delete delta_writer;
+
+        Version version(tablet->max_version().second + 1, tablet->max_version().second + 1);
+        std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+        k_engine->txn_manager()->get_txn_related_tablets(txn_id, write_req.partition_id,
+                                                           &tablet_related_rs);
+        ASSERT_EQ(1, tablet_related_rs.size());
+        for (auto& [tablet_info, rowset] : tablet_related_rs) {
+            ASSERT_TRUE(k_engine->txn_manager()
+                                ->publish_txn(tablet->data_dir()->get_meta(),
+                                              write_req.partition_id, txn_id, tablet->tablet_id(),
+                                              tablet->schema_hash(), tablet_info.tablet_uid,
+                                              version)
+                                .ok());
+            ASSERT_TRUE(tablet->update_delete_bitmap(rowset).ok());
+            ASSERT_TRUE(tablet->add_inc_rowset(rowset).ok());
+        }
+    };
+    load(20004, {{1, 10, 100}, {2, 20, 200}}, {});
+    load(20005, {{1, 11, 0}, {3, 31, 0}}, {"k1", "v1"});
+    load(20006, {{2, 0, 222}}, {"k1", "v2"});
+
+    std::vector<std::string> keys;
+    for (int32_t k1 : {1, 2, 3}) {
+        std::string key;
+        key.push_back(KEY_NORMAL_MARKER);
+        get_key_coder(OLAP_FIELD_TYPE_INT)->full_encode_ascending(&k1, &key);
+        keys.push_back(key);
+    }
+    std::vector<Slice> sorted_keys(keys.begin(), keys.end());
+    std::vector<uint32_t> cids = {1, 2};
+    auto columns = tablet->tablet_schema().create_block(cids).mutate_columns();
+    std::vector<bool> found;
+    res = tablet->read_columns_by_keys(sorted_keys, tablet->tablet_schema(), cids, &columns,
+                                       &found);
+    ASSERT_TRUE(res.ok()) << res;
+    EXPECT_EQ(std::vector<bool>({true, true, true}), found);
+    // key 1 keeps its v2, key 2 its v1 and the new key 3 the default of v2
+    std::vector<std::pair<int32_t, int32_t>> expected = {{11, 100}, {20, 222}, {31, 0}};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].first, columns[0]->get_int(i));
+        EXPECT_EQ(expected[i].second, columns[1]->get_int(i));
+    }
+
+    // a partial update needs the key columns
+    PUniqueId load_id;
+    WriteRequest write_req = {request.tablet_id, 270068378,  WriteType::LOAD,
+                              20007,             30004,      load_id,
+                              tuple_desc,        &tuple_desc->slots()};
+    write_req.ptable_schema_param.set_partial_update(true);
+    write_req.ptable_schema_param.add_partial_update_input_columns("v1");
+    DeltaWriter* delta_writer = nullptr;
+    DeltaWriter::open(&write_req, &delta_writer, true);
+    ASSERT_NE(delta_writer, nullptr);
+    vectorized::Block block = make_block({{4, 40, 400}});
+    EXPECT_FALSE(delta_writer->write(&block, {0}).ok());
+    delete delta_writer;
+
+    res = k_engine->tablet_manager()->drop_tablet(request.tablet_id, request.replica_id);
+    ASSERT_TRUE(res.ok());
+}
+
 } // namespace doris
@@ -0,0 +1,202 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/task/engine_pull_rowset_task.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "gen_cpp/HeartbeatService_types.h"
+#include "http/ev_http_server.h"
+#include "http/http_handler.h"
+#include "http/http_request.h"
+#include "http/utils.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/rowset_meta.h"
+#include "runtime/exec_env.h"
+#include "util/file_utils.h"
+
+namespace doris {
+
+static const std::string kTestDir = "./ut_dir/engine_pull_rowset_task_test";
+
+// the download action of the master replica
+class TabletDownloadHandler : public HttpHandler {
+public:
+    void handle(HttpRequest* req) override { do_file_response(req->param("file"), req); }
+};
+
+static TabletDownloadHandler s_download_handler;
+static EvHttpServer* s_server = nullptr;
+static TMasterInfo s_master_info;
+static TMasterInfo* s_saved_master_info = nullptr;
+
+class EnginePullRowsetTaskTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        s_server = new EvHttpServer(0);
+        s_server->register_handler(GET, "/api/_tablet/_download", &s_download_handler);
+        s_server->start();
+        // the token of the download requests
+        s_saved_master_info = ExecEnv::GetInstance()->_master_info;
+        ExecEnv::GetInstance()->_master_info = &s_master_info;
+    }
+
+    static void TearDownTestSuite() {
+        delete s_server;
+        s_server = nullptr;
+        ExecEnv::GetInstance()->_master_info = s_saved_master_info;
+    }
+
+    void SetUp() override {
+        FileUtils::remove_all(kTestDir);
+        _master_path = std::filesystem::absolute(kTestDir + "/master").string();
+        _slave_path = std::filesystem::absolute(kTestDir + "/slave").string();
+        std::filesystem::create_directories(_master_path);
+        std::filesystem::create_directories(_slave_path);
+        _remote_rowset_id.init(10001);
+        _rowset_id.init(20002);
+        _rowset_meta.set_rowset_id(_remote_rowset_id);
+    }
+
+    void TearDown() override { FileUtils::remove_all(kTestDir); }
+
+protected:
+    static void write_file(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    static std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // segment 0 with an index file, and segment 1 without one
+    void write_master_rowset() {
+        _rowset_meta.set_num_segments(2);
+        _rowset_meta.set_has_index_files(true);
+        write_file(BetaRowset::local_segment_path(_master_path, _remote_rowset_id, 0),
+                   "segment 0");
+        write_file(BetaRowset::local_segment_index_path(_master_path, _remote_rowset_id, 0),
+                   "index of segment 0");
+        write_file(BetaRowset::local_segment_path(_master_path, _remote_rowset_id, 1),
+                   "segment 1 of the rowset");
+    }
+
+    PTabletWriteSlaveRequest make_request() {
+        PTabletWriteSlaveRequest request;
+        EXPECT_TRUE(
+                EnginePullRowsetTask::set_rowset_files(_rowset_meta, _master_path, &request).ok());
+        request.set_rowset_path(_master_path);
+        request.set_host("127.0.0.1");
+        request.set_http_port(s_server->get_real_port());
+        return request;
+    }
+
+    std::string _master_path;
+    std::string _slave_path;
+    RowsetId _remote_rowset_id;
+    RowsetId _rowset_id;
+    RowsetMeta _rowset_meta;
+};
+
+TEST_F(EnginePullRowsetTaskTest, master_lists_segment_and_index_files) {
+    write_master_rowset();
+    PTabletWriteSlaveRequest request = make_request();
+    ASSERT_EQ(2, request.segments_size().size());
+    EXPECT_EQ(9, request.segments_size().at(0));
+    EXPECT_EQ(23, request.segments_size().at(1));
+    ASSERT_EQ(1, request.index_files_size().size());
+    EXPECT_EQ(18, request.index_files_size().at(0));
+
+    // the index files are not looked for without the flag
+    PTabletWriteSlaveRequest no_index_request;
+    _rowset_meta.set_has_index_files(false);
+    ASSERT_TRUE(EnginePullRowsetTask::set_rowset_files(_rowset_meta, _master_path,
+                                                       &no_index_request)
+                        .ok());
+    EXPECT_EQ(2, no_index_request.segments_size().size());
+    EXPECT_TRUE(no_index_request.index_files_size().empty());
+
+    // a missing segment file fails the pull
+    std::filesystem::remove(BetaRowset::local_segment_path(_master_path, _remote_rowset_id, 1));
+    PTabletWriteSlaveRequest failed_request;
+    EXPECT_FALSE(
+            EnginePullRowsetTask::set_rowset_files(_rowset_meta, _master_path, &failed_request)
+                    .ok());
+}
+
+TEST_F(EnginePullRowsetTaskTest, slave_pulls_all_files) {
+    write_master_rowset();
+    PTabletWriteSlaveRequest request = make_request();
+    EnginePullRowsetTask task(request);
+    auto files = task._rowset_files(_slave_path, _rowset_id, _remote_rowset_id);
+    ASSERT_EQ(3, files.size());
+    ASSERT_TRUE(task._download_files(files).ok());
+
+    // the files get the rowset id of the slave
+    EXPECT_EQ("segment 0",
+              read_file(BetaRowset::local_segment_path(_slave_path, _rowset_id, 0)));
+    EXPECT_EQ("index of segment 0",
+              read_file(BetaRowset::local_segment_index_path(_slave_path, _rowset_id, 0)));
+    EXPECT_EQ("segment 1 of the rowset",
+              read_file(BetaRowset::local_segment_path(_slave_path, _rowset_id, 1)));
+    EXPECT_FALSE(std::filesystem::exists(
+            BetaRowset::local_segment_index_path(_slave_path, _rowset_id, 1)));
+}
+
+TEST_F(EnginePullRowsetTaskTest, failed_downloads) {
+    write_master_rowset();
+    PTabletWriteSlaveRequest request = make_request();
+
+    // the index file is gone from the master, e.g. the rowset is compacted
+    std::filesystem::remove(
+            BetaRowset::local_segment_index_path(_master_path, _remote_rowset_id, 0));
+    {
+        EnginePullRowsetTask task(request);
+        EXPECT_FALSE(task._download_files(task._rowset_files(_slave_path, _rowset_id,
+                                                             _remote_rowset_id))
+                             .ok());
+    }
+
+    // the size of a downloaded file is not the one listed by the master
+    write_file(BetaRowset::local_segment_index_path(_master_path, _remote_rowset_id, 0),
+               "a longer index of segment 0");
+    {
+        EnginePullRowsetTask task(request);
+        EXPECT_FALSE(task._download_files(task._rowset_files(_slave_path, _rowset_id,
+                                                             _remote_rowset_id))
+                             .ok());
+    }
+
+    // the slave pulls again with a new request of the master
+    PTabletWriteSlaveRequest new_request = make_request();
+    EnginePullRowsetTask task(new_request);
+    EXPECT_TRUE(
+            task._download_files(task._rowset_files(_slave_path, _rowset_id, _remote_rowset_id))
+                    .ok());
+    EXPECT_EQ("a longer index of segment 0",
+              read_file(BetaRowset::local_segment_index_path(_slave_path, _rowset_id, 0)));
+}
+
+} // namespace doris
@@ -192,6 +192,56 @@ TEST_F(TestHll, Normal) {
     }
 }
 
+TEST_F(TestHll, SparseInMemory) {
+    HyperLogLog sparse_hll;
+    for (int i = 0; i < 500; ++i) {
+        sparse_hll.update(hash(i));
+    }
+    // the 500 registers are kept without allocating all of them
+    EXPECT_LT(sparse_hll.memory_consumed(), HLL_REGISTERS_COUNT / 4);
+
+    // the same values through a full value give the same estimate and serialized value
+    HyperLogLog full_hll;
+    for (int i = 0; i < 64 * 1024; ++i) {
+        full_hll.update(hash(1024 * 1024 + i));
+    }
+    HyperLogLog merged_hll;
+    for (int i = 0; i < 500; ++i) {
+        merged_hll.update(hash(i));
+    }
+    merged_hll.merge(full_hll);
+    HyperLogLog other_merged_hll(full_hll);
+    other_merged_hll.merge(sparse_hll);
+    EXPECT_GE(merged_hll.memory_consumed(), HLL_REGISTERS_COUNT);
+    EXPECT_EQ(merged_hll.estimate_cardinality(), other_merged_hll.estimate_cardinality());
+
+    uint8_t buf[HLL_REGISTERS_COUNT + 1];
+    size_t len = sparse_hll.serialize(buf);
+    EXPECT_LE(len, sparse_hll.max_serialized_size());
+    EXPECT_EQ(HLL_DATA_SPARSE, buf[0]);
+    HyperLogLog test_hll(Slice((char*)buf, len));
+    EXPECT_EQ(sparse_hll.estimate_cardinality(), test_hll.estimate_cardinality());
+
+    // merging sparse values keeps them sparse until they have too many registers
+    HyperLogLog other_sparse_hll;
+    for (int i = 250; i < 750; ++i) {
+        other_sparse_hll.update(hash(i));
+    }
+    test_hll.merge(other_sparse_hll);
+    HyperLogLog expected_hll;
+    for (int i = 0; i < 750; ++i) {
+        expected_hll.update(hash(i));
+    }
+    EXPECT_EQ(expected_hll.estimate_cardinality(), test_hll.estimate_cardinality());
+    EXPECT_LT(test_hll.memory_consumed(), HLL_REGISTERS_COUNT / 2);
+    for (int i = 0; i < 4 * HLL_SPARSE_MEMORY_THRESHOLD; ++i) {
+        test_hll.update(hash(i));
+        expected_hll.update(hash(i));
+    }
+    EXPECT_GE(test_hll.memory_consumed(), HLL_REGISTERS_COUNT);
+    EXPECT_EQ(expected_hll.estimate_cardinality(), test_hll.estimate_cardinality());
+}
+
 TEST_F(TestHll, InvalidPtr) {
     {
         HyperLogLog hll(Slice((char*)nullptr, 0));
@@ -314,6 +314,66 @@ TEST_F(CacheTest, Prune) {
     EXPECT_EQ(0, cache.get_usage());
 }
 
+TEST_F(CacheTest, VisitedEntriesGetAnotherChance) {
+    LRUCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(3);
+
+    CacheKey key1("100");
+    CacheKey key2("200");
+    CacheKey key3("300");
+    insert_LRUCache(cache, key1, 100, CachePriority::NORMAL);
+    insert_LRUCache(cache, key2, 200, CachePriority::NORMAL);
+    insert_LRUCache(cache, key3, 300, CachePriority::NORMAL);
+
+    // key1 is the oldest entry, but it is visited, so key2 is evicted instead
+    Cache::Handle* handle = cache.lookup(key1, key1.hash(key1.data(), key1.size(), 0));
+    ASSERT_NE(handle, nullptr);
+    cache.release(handle);
+
+    // key3 is in use and can not be evicted, so key1 is evicted at last
+    Cache::Handle* in_use = cache.lookup(key3, key3.hash(key3.data(), key3.size(), 0));
+    ASSERT_NE(in_use, nullptr);
+
+    CacheKey key4("400");
+    insert_LRUCache(cache, key4, 400, CachePriority::NORMAL);
+    EXPECT_EQ(3, cache.get_usage());
+    EXPECT_EQ(nullptr, cache.lookup(key2, key2.hash(key2.data(), key2.size(), 0)));
+
+    CacheKey key5("500");
+    insert_LRUCache(cache, key5, 500, CachePriority::NORMAL);
+    EXPECT_EQ(3, cache.get_usage());
+    EXPECT_EQ(nullptr, cache.lookup(key1, key1.hash(key1.data(), key1.size(), 0)));
+    cache.release(in_use);
+}
+
+TEST_F(CacheTest, ProbationEntriesEvictedFirst) {
+    LRUCache cache(LRUCacheType::NUMBER);
+    cache.set_capacity(4);
+
+    CacheKey key1("100");
+    CacheKey key2("200");
+    insert_LRUCache(cache, key1, 100, CachePriority::NORMAL);
+    insert_LRUCache(cache, key2, 200, CachePriority::NORMAL);
+
+    // the probation entries beyond a quarter of the capacity evict each other
+    std::vector<std::string> probation_keys = {"300", "400", "500", "600"};
+    for (size_t i = 0; i < probation_keys.size(); ++i) {
+        insert_LRUCache(cache, CacheKey(probation_keys[i]), 300 + i * 100,
+                        CachePriority::PROBATION);
+    }
+    EXPECT_EQ(4, cache.get_usage());
+
+    for (auto& key : {key1, key2}) {
+        Cache::Handle* handle = cache.lookup(key, key.hash(key.data(), key.size(), 0));
+        ASSERT_NE(handle, nullptr);
+        cache.release(handle);
+    }
+    for (int i = 0; i < 2; ++i) {
+        CacheKey key(probation_keys[i]);
+        EXPECT_EQ(nullptr, cache.lookup(key, key.hash(key.data(), key.size(), 0)));
+    }
+}
+
 TEST_F(CacheTest, HeavyEntries) {
     // Add a bunch of light and heavy entries and then count the combined
     // size of items still in the cache, which must be approximately the
@@ -94,6 +94,32 @@ TEST_F(OlapMetaTest, TestRemove) {
     EXPECT_EQ(Status::OK(), s);
 }
 
+TEST_F(OlapMetaTest, TestMultiGetAndBatchRemove) {
+    std::vector<std::pair<std::string, std::string>> entries = {{"key_1", "value_1"},
+                                                                {"key_2", "value_2"}};
+    Status s = _meta->put(META_COLUMN_FAMILY_INDEX, entries);
+    EXPECT_EQ(Status::OK(), s);
+
+    std::vector<std::string> values;
+    std::vector<Status> statuses;
+    _meta->multi_get(META_COLUMN_FAMILY_INDEX, {"key_1", "key_not_exist", "key_2"}, &values,
+                     &statuses);
+    ASSERT_EQ(3U, statuses.size());
+    EXPECT_EQ(Status::OK(), statuses[0]);
+    EXPECT_EQ("value_1", values[0]);
+    EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_META_KEY_NOT_FOUND), statuses[1]);
+    EXPECT_EQ(Status::OK(), statuses[2]);
+    EXPECT_EQ("value_2", values[2]);
+
+    s = _meta->remove(META_COLUMN_FAMILY_INDEX, {"key_1", "key_2", "key_not_exist"});
+    EXPECT_EQ(Status::OK(), s);
+    std::string value_get;
+    s = _meta->get(META_COLUMN_FAMILY_INDEX, "key_1", &value_get);
+    EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_META_KEY_NOT_FOUND), s);
+    s = _meta->get(META_COLUMN_FAMILY_INDEX, "key_2", &value_get);
+    EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_META_KEY_NOT_FOUND), s);
+}
+
 TEST_F(OlapMetaTest, TestIterate) {
     // normal cases
     std::string key = "hdr_key";
@@ -245,4 +245,33 @@ TEST(StoragePageCacheTest, mixed_pages) {
     }
 }
 
+TEST(StoragePageCacheTest, compressed_pages) {
+    StoragePageCache cache(kNumShards * 2048, 10, kNumShards, 50);
+    EXPECT_TRUE(cache.is_compressed_cache_available());
+
+    StoragePageCache::CacheKey key("abc", 0);
+    segment_v2::PageTypePB page_type = segment_v2::DATA_PAGE;
+    {
+        // the compressed pages are apart from the decompressed ones
+        char* buf = new char[512];
+        PageCacheHandle handle;
+        cache.insert_compressed(key, Slice(buf, 512), &handle);
+        EXPECT_EQ(handle.data().data, buf);
+        EXPECT_FALSE(cache.lookup(key, &handle, page_type));
+
+        PageCacheHandle compressed_handle;
+        EXPECT_TRUE(cache.lookup_compressed(key, &compressed_handle));
+        EXPECT_EQ(compressed_handle.data().data, buf);
+    }
+
+    {
+        PageCacheHandle handle;
+        StoragePageCache::CacheKey miss_key("abc", 1);
+        EXPECT_FALSE(cache.lookup_compressed(miss_key, &handle));
+    }
+
+    StoragePageCache no_compressed_cache(kNumShards * 2048, 10, kNumShards);
+    EXPECT_FALSE(no_compressed_cache.is_compressed_cache_available());
+}
+
 } // namespace doris
@@ -33,6 +33,7 @@
 #include "olap/rowset/rowset_reader_context.h"
 #include "olap/rowset/rowset_writer.h"
 #include "olap/rowset/rowset_writer_context.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet_schema.h"
 #include "olap/utils.h"
@@ -418,6 +419,115 @@ class S3ClientMockGetErrorData : public S3ClientMock {
     }
 };
 
+TEST_F(BetaRowsetTest, SegmentsKeyBoundsTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    RowsetSharedPtr rowset;
+    const int num_segments = 2;
+    const int32_t rows_per_segment = 100;
+    {
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        writer_context.rowset_id.init(10001);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        Status s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+        EXPECT_EQ(Status::OK(), s);
+
+        // for segment "i", row "rid": k1 := k2 := v1 := i * rows_per_segment + rid
+        for (int i = 0; i < num_segments; ++i) {
+            auto block = tablet_schema.create_block();
+            auto columns = block.mutate_columns();
+            for (int32_t rid = 0; rid < rows_per_segment; ++rid) {
+                int32_t value = i * rows_per_segment + rid;
+                for (auto& column : columns) {
+                    column->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+                }
+            }
+            block.set_columns(std::move(columns));
+            EXPECT_EQ(Status::OK(), rowset_writer->add_block(&block));
+            EXPECT_EQ(Status::OK(), rowset_writer->flush());
+        }
+        rowset = rowset_writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+    }
+
+    std::vector<KeyBoundsPB> key_bounds;
+    EXPECT_EQ(Status::OK(), rowset->get_segments_key_bounds(&key_bounds));
+    EXPECT_EQ(num_segments, key_bounds.size());
+    for (int i = 0; i < num_segments; ++i) {
+        EXPECT_LT(key_bounds[i].min_key(), key_bounds[i].max_key());
+        if (i > 0) {
+            EXPECT_LT(key_bounds[i - 1].max_key(), key_bounds[i].min_key());
+        }
+    }
+
+    // link the segments of the rowset twice into a new rowset
+    RowsetWriterContext writer_context;
+    create_rowset_writer_context(&tablet_schema, &writer_context);
+    writer_context.rowset_id.init(10002);
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    EXPECT_EQ(Status::OK(), RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+    EXPECT_EQ(Status::OK(), rowset_writer->add_rowset(rowset));
+    EXPECT_EQ(Status::OK(), rowset_writer->add_rowset(rowset));
+    EXPECT_EQ(Status::OK(), rowset_writer->flush());
+    auto linked_rowset = rowset_writer->build();
+    EXPECT_TRUE(linked_rowset != nullptr);
+    EXPECT_EQ(2 * num_segments, linked_rowset->num_segments());
+    EXPECT_EQ(2 * num_segments * rows_per_segment, linked_rowset->num_rows());
+    for (int i = 0; i < 2 * num_segments; ++i) {
+        EXPECT_TRUE(FileUtils::check_exist(
+                BetaRowset::local_segment_path(kTestDir, writer_context.rowset_id, i)));
+    }
+    std::vector<KeyBoundsPB> linked_key_bounds;
+    EXPECT_EQ(Status::OK(), linked_rowset->get_segments_key_bounds(&linked_key_bounds));
+    EXPECT_EQ(2 * num_segments, linked_key_bounds.size());
+    for (int i = 0; i < 2 * num_segments; ++i) {
+        EXPECT_EQ(key_bounds[i % num_segments].min_key(), linked_key_bounds[i].min_key());
+        EXPECT_EQ(key_bounds[i % num_segments].max_key(), linked_key_bounds[i].max_key());
+    }
+}
+
+TEST_F(BetaRowsetTest, SegmentMaxRowsAndSize) {
+    EXPECT_EQ(230U << 20, segment_v2::target_segment_size());
+    int64_t segment_max_size_mbytes = config::segment_max_size_mbytes;
+    config::segment_max_size_mbytes = 64;
+    EXPECT_EQ(64U << 20, segment_v2::target_segment_size());
+    // at most the max segment size
+    config::segment_max_size_mbytes = 1024;
+    EXPECT_EQ(MAX_SEGMENT_SIZE, segment_v2::target_segment_size());
+    config::segment_max_size_mbytes = 0;
+    EXPECT_EQ(MAX_SEGMENT_SIZE, segment_v2::target_segment_size());
+    config::segment_max_size_mbytes = segment_max_size_mbytes;
+
+    // the 100 rows of a block are cut into segments of 40 rows
+    int64_t segment_max_rows = config::segment_max_rows;
+    config::segment_max_rows = 40;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetWriterContext writer_context;
+    create_rowset_writer_context(&tablet_schema, &writer_context);
+    writer_context.rowset_id.init(10002);
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    EXPECT_EQ(Status::OK(), RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+    auto block = tablet_schema.create_block();
+    auto columns = block.mutate_columns();
+    for (int32_t value = 0; value < 100; ++value) {
+        for (auto& column : columns) {
+            column->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+    block.set_columns(std::move(columns));
+    EXPECT_EQ(Status::OK(), rowset_writer->add_block(&block));
+    EXPECT_EQ(Status::OK(), rowset_writer->flush());
+    RowsetSharedPtr rowset = rowset_writer->build();
+    config::segment_max_rows = segment_max_rows;
+    ASSERT_TRUE(rowset != nullptr);
+    EXPECT_EQ(3, rowset->num_segments());
+    EXPECT_EQ(100, rowset->num_rows());
+}
+
 TEST_F(BetaRowsetTest, ReadTest) {
     RowsetMetaSharedPtr rowset_meta = std::make_shared<RowsetMeta>();
     BetaRowset rowset(nullptr, "", rowset_meta);
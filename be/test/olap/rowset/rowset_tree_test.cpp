@@ -29,6 +29,7 @@
 #include <cstring>
 #include <functional>
 #include <memory>
+#include <set>
 #include <string>
 #include <tuple>
 #include <unordered_set>
@@ -77,14 +78,20 @@ public:
 
     RowsetSharedPtr create_rowset(const string& min_key, const string& max_key,
                                   bool is_mem_rowset = false) {
+        return create_rowset({{min_key, max_key}}, is_mem_rowset);
+    }
+
+    // Create a rowset with one segment for each pair of min and max keys.
+    RowsetSharedPtr create_rowset(const vector<std::pair<string, string>>& segments_key_bounds,
+                                  bool is_mem_rowset = false) {
         RowsetMetaPB rs_meta_pb;
         rs_meta_pb.set_rowset_id_v2(rowset_id_generator_.next_id().to_string());
-        rs_meta_pb.set_num_segments(1);
-        KeyBoundsPB key_bounds;
-        key_bounds.set_min_key(min_key);
-        key_bounds.set_max_key(max_key);
-        KeyBoundsPB* new_key_bounds = rs_meta_pb.add_segments_key_bounds();
-        *new_key_bounds = key_bounds;
+        rs_meta_pb.set_num_segments(segments_key_bounds.size());
+        for (auto& [min_key, max_key] : segments_key_bounds) {
+            KeyBoundsPB* new_key_bounds = rs_meta_pb.add_segments_key_bounds();
+            new_key_bounds->set_min_key(min_key);
+            new_key_bounds->set_max_key(max_key);
+        }
         RowsetMetaSharedPtr meta_ptr = make_shared<RowsetMeta>();
         meta_ptr->init_from_pb(rs_meta_pb);
         RowsetSharedPtr res_ptr;
@@ -98,6 +105,24 @@ private:
     UniqueRowsetIdGenerator rowset_id_generator_;
 };
 
+TEST_F(TestRowsetTree, TestSegmentsContainingKeys) {
+    RowsetVector vec;
+    vec.push_back(create_rowset({{"0", "3"}, {"5", "9"}}));
+    vec.push_back(create_rowset("2", "6"));
+
+    RowsetTree tree;
+    ASSERT_TRUE(tree.Init(vec).ok());
+
+    vector<Slice> keys = {"1", "4", "6"};
+    std::set<std::tuple<Rowset*, int32_t, int>> matches;
+    tree.ForEachRowsetContainingKeys(keys, [&](RowsetSharedPtr rs, int32_t segment_id, int idx) {
+        matches.emplace(rs.get(), segment_id, idx);
+    });
+    std::set<std::tuple<Rowset*, int32_t, int>> expected = {
+            {vec[0].get(), 0, 0}, {vec[1].get(), 0, 1}, {vec[0].get(), 1, 2}, {vec[1].get(), 0, 2}};
+    ASSERT_EQ(expected, matches);
+}
+
 TEST_F(TestRowsetTree, TestTree) {
     RowsetVector vec;
     vec.push_back(create_rowset("0", "5"));
@@ -367,7 +392,8 @@ TEST_P(TestRowsetTreePerformance, TestPerformance) {
         int bulk_matches = 0;
         {
             tree.ForEachRowsetContainingKeys(
-                    query_slices, [&](RowsetSharedPtr rs, int slice_idx) { bulk_matches++; });
+                    query_slices,
+                    [&](RowsetSharedPtr rs, int32_t segment_id, int slice_idx) { bulk_matches++; });
         }
         batch_timer.stop();
 
@@ -0,0 +1,189 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "olap/rowset/segment_v2/adaptive_page.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "olap/rowset/segment_v2/options.h"
+#include "runtime/mem_pool.h"
+
+using doris::segment_v2::PageBuilderOptions;
+using doris::segment_v2::PageDecoderOptions;
+
+namespace doris {
+using namespace segment_v2;
+
+class AdaptivePageTest : public testing::Test {
+public:
+    template <FieldType Type>
+    void copy_one(AdaptivePageDecoder<Type>* decoder, typename TypeTraits<Type>::CppType* ret) {
+        MemPool pool;
+        std::unique_ptr<ColumnVectorBatch> cvb;
+        ColumnVectorBatch::create(1, true, get_scalar_type_info(Type), nullptr, &cvb);
+        ColumnBlock block(cvb.get(), &pool);
+        ColumnBlockView column_block_view(&block);
+
+        size_t n = 1;
+        decoder->next_batch(&n, &column_block_view);
+        EXPECT_EQ(1, n);
+        *ret = *reinterpret_cast<const typename TypeTraits<Type>::CppType*>(block.cell_ptr(0));
+    }
+
+    // Encodes and decodes the values, and returns the mode chosen for the page.
+    template <FieldType Type>
+    int test_encode_decode_page(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        AdaptivePageBuilder<Type> page_builder(builder_options);
+        size_t size = src.size();
+        page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), &size);
+        OwnedSlice s = page_builder.finish();
+        EXPECT_EQ(src.size(), page_builder.count());
+        int mode = s.slice().data[4];
+        LOG(INFO) << "Adaptive encoded size for " << size << " values: " << s.slice().size
+                  << ", original size:" << size * sizeof(CppType) << ", mode:" << mode;
+
+        PageDecoderOptions decoder_options;
+        AdaptivePageDecoder<Type> page_decoder(s.slice(), decoder_options);
+        EXPECT_TRUE(page_decoder.init().ok());
+        EXPECT_EQ(0, page_decoder.current_index());
+        EXPECT_EQ(size, page_decoder.count());
+        if (size == 0) {
+            return mode;
+        }
+
+        MemPool pool;
+        std::unique_ptr<ColumnVectorBatch> cvb;
+        ColumnVectorBatch::create(size, true, get_scalar_type_info(Type), nullptr, &cvb);
+        ColumnBlock block(cvb.get(), &pool);
+        ColumnBlockView column_block_view(&block);
+        size_t size_to_fetch = size;
+        EXPECT_TRUE(page_decoder.next_batch(&size_to_fetch, &column_block_view).ok());
+        EXPECT_EQ(size, size_to_fetch);
+        const CppType* values = reinterpret_cast<const CppType*>(column_block_view.data());
+        for (size_t i = 0; i < size; i++) {
+            if (memcmp(&src[i], &values[i], sizeof(CppType)) != 0) {
+                ADD_FAILURE() << "Fail at index " << i << " inserted=" << src[i]
+                              << " got=" << values[i];
+                return mode;
+            }
+        }
+
+        for (int i = 0; i < 100; i++) {
+            size_t seek_off = random() % size;
+            page_decoder.seek_to_position_in_page(seek_off);
+            EXPECT_EQ(seek_off, page_decoder.current_index());
+            CppType ret;
+            copy_one<Type>(&page_decoder, &ret);
+            EXPECT_EQ(0, memcmp(&src[seek_off], &ret, sizeof(CppType)));
+        }
+        return mode;
+    }
+};
+
+TEST_F(AdaptivePageTest, TestPeriodicTimestamps) {
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 10000; i++) {
+        values.push_back(1600000000000 + i * 1000);
+    }
+    EXPECT_EQ(ADAPTIVE_DELTA, test_encode_decode_page<OLAP_FIELD_TYPE_DATETIME>(values));
+}
+
+TEST_F(AdaptivePageTest, TestDeltaOfDelta) {
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 10000; i++) {
+        values.push_back(i * i * 3 - 7);
+    }
+    EXPECT_EQ(ADAPTIVE_DELTA_OF_DELTA, test_encode_decode_page<OLAP_FIELD_TYPE_BIGINT>(values));
+}
+
+TEST_F(AdaptivePageTest, TestCounter) {
+    std::vector<int64_t> values;
+    int64_t value = 5;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(value);
+        value += random() % 100;
+    }
+    EXPECT_EQ(ADAPTIVE_DELTA, test_encode_decode_page<OLAP_FIELD_TYPE_BIGINT>(values));
+}
+
+TEST_F(AdaptivePageTest, TestSmallNegatives) {
+    std::vector<int32_t> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(random() % 200 - 100);
+    }
+    EXPECT_EQ(ADAPTIVE_FOR, test_encode_decode_page<OLAP_FIELD_TYPE_INT>(values));
+}
+
+TEST_F(AdaptivePageTest, TestLowCardinalityRuns) {
+    std::vector<int32_t> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back((i / 500) * 99991 - 777777);
+    }
+    EXPECT_EQ(ADAPTIVE_DICT_RLE, test_encode_decode_page<OLAP_FIELD_TYPE_INT>(values));
+}
+
+TEST_F(AdaptivePageTest, TestDouble) {
+    std::vector<double> values;
+    double value = 20.5;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(value);
+        if (i % 10 == 0) {
+            value += 0.25;
+        }
+    }
+    test_encode_decode_page<OLAP_FIELD_TYPE_DOUBLE>(values);
+
+    values.clear();
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(std::sin(i) * 1e6);
+    }
+    test_encode_decode_page<OLAP_FIELD_TYPE_DOUBLE>(values);
+}
+
+TEST_F(AdaptivePageTest, TestEdgeValues) {
+    test_encode_decode_page<OLAP_FIELD_TYPE_BIGINT>({});
+    test_encode_decode_page<OLAP_FIELD_TYPE_BIGINT>({42});
+    test_encode_decode_page<OLAP_FIELD_TYPE_BIGINT>({42, -7});
+    test_encode_decode_page<OLAP_FIELD_TYPE_BIGINT>({std::numeric_limits<int64_t>::min(),
+                                                     std::numeric_limits<int64_t>::max(), 0, -1,
+                                                     1, std::numeric_limits<int64_t>::min()});
+    std::vector<int8_t> tiny;
+    for (int i = 0; i < 1001; i++) {
+        tiny.push_back(random());
+    }
+    test_encode_decode_page<OLAP_FIELD_TYPE_TINYINT>(tiny);
+}
+
+TEST_F(AdaptivePageTest, TestCorruptedPage) {
+    PageBuilderOptions builder_options;
+    AdaptivePageBuilder<OLAP_FIELD_TYPE_INT> page_builder(builder_options);
+    std::vector<int32_t> values = {1, 2, 3, 4, 5};
+    size_t size = values.size();
+    page_builder.add(reinterpret_cast<const uint8_t*>(values.data()), &size);
+    OwnedSlice s = page_builder.finish();
+
+    Slice truncated(s.slice().data, s.slice().size - ADAPTIVE_PAGE_PADDING - 1);
+    AdaptivePageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(truncated, PageDecoderOptions());
+    EXPECT_FALSE(page_decoder.init().ok());
+}
+
+} // namespace doris
@@ -0,0 +1,186 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/binary_fsst_page.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "olap/comparison_predicate.h"
+#include "olap/olap_common.h"
+#include "olap/types.h"
+#include "runtime/mem_pool.h"
+#include "vec/columns/column_string.h"
+
+namespace doris {
+namespace segment_v2 {
+
+// the strings starting with a prefix
+class PrefixPredicate : public ColumnPredicate {
+public:
+    PrefixPredicate(std::string prefix) : ColumnPredicate(0), _prefix(std::move(prefix)) {}
+
+    PredicateType type() const override { return PredicateType::EQ; }
+    void evaluate(ColumnBlock* block, uint16_t* sel, uint16_t* size) const override {}
+    void evaluate_or(ColumnBlock* block, uint16_t* sel, uint16_t size, bool* flags) const override {
+    }
+    void evaluate_and(ColumnBlock* block, uint16_t* sel, uint16_t size,
+                      bool* flags) const override {}
+    Status evaluate(const Schema& schema, const std::vector<BitmapIndexIterator*>& iterators,
+                    uint32_t num_rows, roaring::Roaring* roaring) const override {
+        return Status::OK();
+    }
+
+    bool is_string_prefix(std::string* prefix) const override {
+        *prefix = _prefix;
+        return true;
+    }
+
+private:
+    std::string _prefix;
+};
+
+class BinaryFsstPageTest : public testing::Test {
+public:
+    void SetUp() override {
+        for (int i = 0; i < 1000; ++i) {
+            _values.push_back("https://www.example.com/item/" + std::to_string(i % 97) +
+                              "?user=" + std::to_string(i * 7919 % 1000));
+        }
+        _values.push_back("");
+        _values.push_back(std::string("\xff\x00\xfe binary", 10));
+        for (auto& value : _values) {
+            _slices.emplace_back(value);
+        }
+
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        BinaryFsstPageBuilder<OLAP_FIELD_TYPE_VARCHAR> builder(options);
+        size_t count = _slices.size();
+        EXPECT_TRUE(builder.add(reinterpret_cast<const uint8_t*>(_slices.data()), &count).ok());
+        EXPECT_EQ(_slices.size(), count);
+        _page = builder.finish();
+
+        Slice first_value;
+        EXPECT_TRUE(builder.get_first_value(&first_value).ok());
+        EXPECT_EQ(_slices.front(), first_value);
+        Slice last_value;
+        EXPECT_TRUE(builder.get_last_value(&last_value).ok());
+        EXPECT_EQ(_slices.back(), last_value);
+    }
+
+protected:
+    std::vector<std::string> _values;
+    std::vector<Slice> _slices;
+    OwnedSlice _page;
+};
+
+TEST_F(BinaryFsstPageTest, TestRoundTrip) {
+    size_t raw_size = 0;
+    for (auto& value : _values) {
+        raw_size += value.size();
+    }
+    // the urls share most of their bytes
+    EXPECT_LT(_page.slice().size, raw_size / 2);
+
+    BinaryFsstPageDecoder<OLAP_FIELD_TYPE_VARCHAR> decoder(_page.slice());
+    EXPECT_TRUE(decoder.init().ok());
+    EXPECT_EQ(_values.size(), decoder.count());
+
+    auto column = vectorized::ColumnString::create();
+    vectorized::MutableColumnPtr dst = std::move(column);
+    size_t n = _values.size();
+    EXPECT_TRUE(decoder.next_batch(&n, dst).ok());
+    EXPECT_EQ(_values.size(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(_values[i], dst->get_data_at(i).to_string());
+    }
+
+    MemPool pool;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    ColumnVectorBatch::create(2, true, get_scalar_type_info(OLAP_FIELD_TYPE_VARCHAR), nullptr,
+                              &cvb);
+    ColumnBlock block(cvb.get(), &pool);
+    ColumnBlockView block_view(&block);
+    EXPECT_TRUE(decoder.seek_to_position_in_page(_values.size() - 2).ok());
+    n = 2;
+    EXPECT_TRUE(decoder.next_batch(&n, &block_view).ok());
+    EXPECT_EQ(2, n);
+    Slice* values = reinterpret_cast<Slice*>(block.data());
+    EXPECT_EQ(_values[_values.size() - 2], values[0].to_string());
+    EXPECT_EQ(_values[_values.size() - 1], values[1].to_string());
+
+    rowid_t rowids[] = {100, 103, 1101, 1102};
+    dst = vectorized::ColumnString::create();
+    n = 4;
+    EXPECT_TRUE(decoder.read_by_rowids(rowids, 100, &n, dst).ok());
+    EXPECT_EQ(3, n);
+    EXPECT_EQ(_values[0], dst->get_data_at(0).to_string());
+    EXPECT_EQ(_values[3], dst->get_data_at(1).to_string());
+    EXPECT_EQ(_values[1001], dst->get_data_at(2).to_string());
+}
+
+TEST_F(BinaryFsstPageTest, TestEvaluatePredicates) {
+    BinaryFsstPageDecoder<OLAP_FIELD_TYPE_VARCHAR> decoder(_page.slice());
+    EXPECT_TRUE(decoder.init().ok());
+    vectorized::MutableColumnPtr scratch = vectorized::ColumnString::create();
+
+    std::string target = _values[10];
+    EqualPredicate<StringValue> equal(0, StringValue(target.data(), target.size()));
+    PrefixPredicate prefix("https://www.example.com/item/10?");
+    std::vector<ColumnPredicate*> predicates {&equal, &prefix};
+
+    std::unique_ptr<bool[]> flags(new bool[_values.size()]);
+    EXPECT_TRUE(decoder.seek_to_position_in_page(5).ok());
+    size_t n = _values.size();
+    EXPECT_TRUE(decoder.evaluate_predicates(predicates, &n, scratch, flags.get()).ok());
+    EXPECT_EQ(_values.size() - 5, n);
+    EXPECT_EQ(_values.size(), decoder.current_index());
+    for (size_t i = 0; i < n; ++i) {
+        const std::string& value = _values[i + 5];
+        EXPECT_EQ(value == target && value.rfind("https://www.example.com/item/10?", 0) == 0,
+                  flags[i]);
+    }
+
+    predicates = {&prefix};
+    EXPECT_TRUE(decoder.seek_to_position_in_page(0).ok());
+    n = _values.size();
+    EXPECT_TRUE(decoder.evaluate_predicates(predicates, &n, scratch, flags.get()).ok());
+    size_t num_matched = 0;
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(_values[i].rfind("https://www.example.com/item/10?", 0) == 0, flags[i]);
+        num_matched += flags[i];
+    }
+    EXPECT_EQ(11, num_matched);
+
+    // the other predicates are evaluated on the decoded strings
+    NotEqualPredicate<StringValue> not_equal(0, StringValue(target.data(), target.size()));
+    predicates = {&not_equal};
+    n = _values.size();
+    EXPECT_FALSE(decoder.evaluate_predicates(predicates, &n, scratch, flags.get()).ok());
+}
+
+TEST_F(BinaryFsstPageTest, TestCorruption) {
+    std::string data(_page.slice().data, _page.slice().size - 1);
+    BinaryFsstPageDecoder<OLAP_FIELD_TYPE_VARCHAR> decoder(Slice(data));
+    EXPECT_FALSE(decoder.init().ok());
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -28,6 +28,10 @@
 #include "olap/rowset/segment_v2/page_decoder.h"
 #include "olap/types.h"
 #include "runtime/mem_pool.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/columns/predicate_column.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -110,5 +114,52 @@ TEST_F(BinaryPlainPageTest, TestBinaryPlainPageBuilderSeekByValueSmallPage) {
                                    BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR>>();
 }
 
+// The vectorized columns must get the same strings from the offsets of the page, including the
+// last value of the page whose end is the start of the offsets.
+TEST_F(BinaryPlainPageTest, TestNextBatchIntoColumns) {
+    std::vector<std::string> strings;
+    for (int i = 0; i < 100; ++i) {
+        strings.push_back(i % 10 == 0 ? "" : "value-" + std::to_string(i * 37));
+    }
+    std::vector<Slice> slices(strings.begin(), strings.end());
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    BinaryPlainPageBuilder<OLAP_FIELD_TYPE_VARCHAR> page_builder(options);
+    size_t count = slices.size();
+    EXPECT_TRUE(page_builder.add(reinterpret_cast<const uint8_t*>(slices.data()), &count).ok());
+    OwnedSlice owned_slice = page_builder.finish();
+
+    std::vector<vectorized::MutableColumnPtr> columns;
+    columns.push_back(vectorized::ColumnString::create());
+    columns.push_back(vectorized::ColumnNullable::create(vectorized::ColumnString::create(),
+                                                         vectorized::ColumnUInt8::create()));
+    columns.push_back(vectorized::PredicateColumnType<StringValue>::create());
+    for (auto& column : columns) {
+        column->reserve(strings.size());
+        PageDecoderOptions decoder_options;
+        BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR> page_decoder(owned_slice.slice(),
+                                                                     decoder_options);
+        EXPECT_TRUE(page_decoder.init().ok());
+        // two batches, the second one ends with the page
+        size_t n = 30;
+        EXPECT_TRUE(page_decoder.next_batch(&n, column).ok());
+        EXPECT_EQ(30, n);
+        n = 100;
+        EXPECT_TRUE(page_decoder.next_batch(&n, column).ok());
+        EXPECT_EQ(70, n);
+        ASSERT_EQ(strings.size(), column->size());
+
+        for (size_t i = 0; i < strings.size(); ++i) {
+            if (auto* predicate_column =
+                        dynamic_cast<vectorized::PredicateColumnType<StringValue>*>(
+                                column.get())) {
+                EXPECT_EQ(strings[i], predicate_column->get_data()[i].to_string());
+            } else {
+                EXPECT_EQ(strings[i], column->get_data_at(i).to_string());
+            }
+        }
+    }
+}
+
 } // namespace segment_v2
 } // namespace doris
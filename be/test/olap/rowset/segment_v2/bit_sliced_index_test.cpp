@@ -0,0 +1,124 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/fs/file_reader.h"
+#include "io/fs/file_system.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/bit_sliced_index_reader.h"
+#include "olap/rowset/segment_v2/bit_sliced_index_writer.h"
+#include "olap/types.h"
+#include "util/file_utils.h"
+
+namespace doris {
+namespace segment_v2 {
+using roaring::Roaring;
+
+class BitSlicedIndexTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/bit_sliced_index_test";
+
+    void SetUp() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir).ok());
+    }
+    void TearDown() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+    }
+
+    // writes the values, followed by null_count nulls, and checks compare() with each probe
+    void check(const std::string& name, const std::vector<int64_t>& values, size_t null_count,
+               const std::vector<int64_t>& probes) {
+        std::string file_name = kTestDir + "/" + name;
+        ColumnIndexMetaPB meta;
+        {
+            io::FileWriterPtr file_writer;
+            EXPECT_TRUE(io::global_local_filesystem()->create_file(file_name, &file_writer).ok());
+            std::unique_ptr<BitmapIndexWriter> writer;
+            EXPECT_TRUE(BitSlicedIndexWriter::create(
+                                get_scalar_type_info<OLAP_FIELD_TYPE_BIGINT>(), &writer)
+                                .ok());
+            writer->add_values(values.data(), values.size());
+            writer->add_nulls(null_count);
+            EXPECT_TRUE(writer->finish(file_writer.get(), &meta).ok());
+            EXPECT_EQ(BIT_SLICED_INDEX, meta.type());
+            EXPECT_TRUE(file_writer->close().ok());
+        }
+
+        io::FileReaderSPtr file_reader;
+        ASSERT_TRUE(io::global_local_filesystem()->open_file(file_name, &file_reader).ok());
+        BitSlicedIndexReader reader(std::move(file_reader), &meta.bit_sliced_index(),
+                                    OLAP_FIELD_TYPE_BIGINT);
+        ASSERT_TRUE(reader.load(true, false).ok());
+        BitSlicedIndexIterator* iter = nullptr;
+        ASSERT_TRUE(reader.new_iterator(&iter).ok());
+        std::unique_ptr<BitSlicedIndexIterator> iter_holder(iter);
+
+        for (int64_t probe : probes) {
+            Roaring expected_less;
+            Roaring expected_equal;
+            for (uint32_t i = 0; i < values.size(); ++i) {
+                if (values[i] < probe) {
+                    expected_less.add(i);
+                } else if (values[i] == probe) {
+                    expected_equal.add(i);
+                }
+            }
+            Roaring less;
+            Roaring equal;
+            Roaring not_null;
+            ASSERT_TRUE(iter->compare(&probe, &less, &equal, &not_null).ok());
+            EXPECT_EQ(values.size(), not_null.cardinality());
+            EXPECT_TRUE(expected_less == less) << probe;
+            EXPECT_TRUE(expected_equal == equal) << probe;
+        }
+    }
+};
+
+TEST_F(BitSlicedIndexTest, compare) {
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 10000; ++i) {
+        values.push_back((i * 7919) % 20011 - 10000);
+    }
+    check("compare", values, 100, {-20000, -10000, -9999, -1, 0, 1, 77, 10010, 10011, 20000});
+}
+
+TEST_F(BitSlicedIndexTest, extreme_values) {
+    std::vector<int64_t> values = {INT64_MIN, -1, 0, 1, INT64_MAX, INT64_MIN, INT64_MAX};
+    check("extreme_values", values, 3,
+          {INT64_MIN, INT64_MIN + 1, -1, 0, 2, INT64_MAX - 1, INT64_MAX});
+}
+
+TEST_F(BitSlicedIndexTest, single_value) {
+    std::vector<int64_t> values(100, 42);
+    check("single_value", values, 10, {41, 42, 43});
+    check("all_null", {}, 10, {0, 42});
+}
+
+} // namespace segment_v2
+} // namespace doris
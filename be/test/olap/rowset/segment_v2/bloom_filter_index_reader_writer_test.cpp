@@ -286,5 +286,50 @@ TEST_F(BloomFilterIndexReaderWriterTest, test_decimal) {
     delete[] val;
 }
 
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram) {
+    std::vector<std::string> page0 = {"the quick brown fox", "jumps over"};
+    std::vector<std::string> page1 = {"the lazy dog"};
+    std::string fname = dname + "/ngram_bloom_filter";
+    ColumnIndexMetaPB meta;
+    {
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(io::global_local_filesystem()->create_file(fname, &file_writer).ok());
+        std::unique_ptr<BloomFilterIndexWriter> writer;
+        EXPECT_TRUE(BloomFilterIndexWriter::create_ngram(
+                            BloomFilterOptions(), get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>(),
+                            3, &writer)
+                            .ok());
+        for (auto* page : {&page0, &page1}) {
+            std::vector<Slice> slices(page->begin(), page->end());
+            writer->add_values(slices.data(), slices.size());
+            EXPECT_TRUE(writer->flush().ok());
+        }
+        EXPECT_TRUE(writer->finish(file_writer.get(), &meta).ok());
+        EXPECT_TRUE(file_writer->close().ok());
+        EXPECT_EQ(NGRAM_BLOOM_FILTER_INDEX, meta.type());
+        EXPECT_EQ(3, meta.ngram_bloom_filter_index().gram_size());
+    }
+
+    io::FileReaderSPtr file_reader;
+    ASSERT_TRUE(io::global_local_filesystem()->open_file(fname, &file_reader).ok());
+    BloomFilterIndexReader reader(std::move(file_reader), &meta.ngram_bloom_filter_index());
+    ASSERT_TRUE(reader.load(true, false).ok());
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    ASSERT_TRUE(reader.new_iterator(&iter).ok());
+
+    std::unique_ptr<BloomFilter> bf;
+    ASSERT_TRUE(iter->read_bloom_filter(0, &bf).ok());
+    for (std::string gram : {"the", "qui", "wn ", "ver"}) {
+        EXPECT_TRUE(bf->test_bytes(gram.data(), gram.size())) << gram;
+    }
+    // the grams across the values are not added
+    std::string across = "foxjum";
+    EXPECT_FALSE(bf->test_bytes(across.data() + 2, 3));
+    ASSERT_TRUE(iter->read_bloom_filter(1, &bf).ok());
+    for (std::string gram : {"laz", "dog"}) {
+        EXPECT_TRUE(bf->test_bytes(gram.data(), gram.size())) << gram;
+    }
+}
+
 } // namespace segment_v2
 } // namespace doris
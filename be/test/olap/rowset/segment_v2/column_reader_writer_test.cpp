@@ -74,7 +74,7 @@ private:
 
 template <FieldType type, EncodingTypePB encoding>
 void test_nullable_data(uint8_t* src_data, uint8_t* src_is_null, int num_rows,
-                        std::string test_name) {
+                        std::string test_name, uint32_t compression_sample_pages = 0) {
     using Type = typename TypeTraits<type>::CppType;
     Type* src = (Type*)src_data;
 
@@ -102,6 +102,7 @@ void test_nullable_data(uint8_t* src_data, uint8_t* src_is_null, int num_rows,
         writer_opts.meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
         writer_opts.meta->set_is_nullable(true);
         writer_opts.need_zone_map = true;
+        writer_opts.compression_sample_pages = compression_sample_pages;
 
         TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, type);
         if (type == OLAP_FIELD_TYPE_VARCHAR) {
@@ -672,6 +673,31 @@ TEST_F(ColumnReaderWriterTest, test_nullable) {
     delete[] double_vals;
 }
 
+TEST_F(ColumnReaderWriterTest, test_adaptive_compression) {
+    const int num_rows = 100000;
+    uint8_t* is_null = new uint8_t[num_rows];
+    int64_t* vals = new int64_t[num_rows];
+    for (int i = 0; i < num_rows; ++i) {
+        BitmapChange(is_null, i, (i % 16) == 0);
+    }
+
+    // the pages are compressed by zstd or lz4f
+    for (int i = 0; i < num_rows; ++i) {
+        vals[i] = (i / 64) % 1000;
+    }
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>((uint8_t*)vals, is_null, num_rows,
+                                                               "adaptive_compressible", 2);
+
+    // the pages are stored uncompressed
+    for (int i = 0; i < num_rows; ++i) {
+        vals[i] = ((int64_t)random() << 32) | random();
+    }
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>((uint8_t*)vals, is_null, num_rows,
+                                                               "adaptive_incompressible", 2);
+    delete[] vals;
+    delete[] is_null;
+}
+
 TEST_F(ColumnReaderWriterTest, test_types) {
     size_t num_uint8_rows = LOOP_LESS_OR_MORE(1024, 1024 * 1024);
     uint8_t* is_null = new uint8_t[num_uint8_rows];
@@ -0,0 +1,162 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "io/fs/file_reader.h"
+#include "io/fs/file_system.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/rowset/segment_v2/inverted_index_parser.h"
+#include "olap/rowset/segment_v2/inverted_index_reader.h"
+#include "olap/rowset/segment_v2/inverted_index_writer.h"
+#include "olap/types.h"
+#include "util/file_utils.h"
+
+namespace doris {
+namespace segment_v2 {
+using roaring::Roaring;
+
+class InvertedIndexTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/inverted_index_test";
+
+    void SetUp() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir).ok());
+    }
+    void TearDown() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+    }
+
+    static std::vector<std::string> parse(InvertedIndexParserPB type, const std::string& text) {
+        std::unique_ptr<InvertedIndexParser> parser;
+        EXPECT_TRUE(InvertedIndexParser::create(type, 2, &parser).ok());
+        std::vector<InvertedIndexTerm> terms;
+        parser->parse(text, &terms);
+        std::vector<std::string> res;
+        for (auto& term : terms) {
+            res.emplace_back(text.substr(term.begin, term.end - term.begin));
+        }
+        return res;
+    }
+
+    static std::vector<std::string> like_terms(InvertedIndexParserPB type,
+                                               const std::string& pattern) {
+        std::unique_ptr<InvertedIndexParser> parser;
+        EXPECT_TRUE(InvertedIndexParser::create(type, 2, &parser).ok());
+        std::vector<std::string> terms;
+        parser->required_terms_of_like(pattern, &terms);
+        return terms;
+    }
+};
+
+TEST_F(InvertedIndexTest, parse) {
+    using Terms = std::vector<std::string>;
+    EXPECT_EQ(Terms({"hello,", "world"}), parse(WHITESPACE_PARSER, " hello,  world\n"));
+    EXPECT_EQ(Terms({"hello", "world", "42"}), parse(UNICODE_PARSER, "hello, world-42!"));
+    // every CJK character is a term
+    EXPECT_EQ(Terms({"doris", "数", "据", "库"}), parse(UNICODE_PARSER, "doris数据库。"));
+    EXPECT_EQ(Terms({"ab", "bc", "c数"}), parse(NGRAM_PARSER, "abc数"));
+    EXPECT_EQ(Terms({}), parse(NGRAM_PARSER, "a"));
+    std::string long_word(InvertedIndexParser::MAX_TERM_LENGTH + 1, 'a');
+    EXPECT_EQ(Terms({"b"}), parse(UNICODE_PARSER, long_word + " b"));
+}
+
+TEST_F(InvertedIndexTest, required_terms_of_like) {
+    using Terms = std::vector<std::string>;
+    // the words at the edges of '%' may be parts of longer words
+    EXPECT_EQ(Terms({"quick"}), like_terms(UNICODE_PARSER, "%the quick brown%"));
+    EXPECT_EQ(Terms({"the", "quick", "brown"}), like_terms(UNICODE_PARSER, "the quick brown"));
+    EXPECT_EQ(Terms({"the"}), like_terms(UNICODE_PARSER, "the _uick"));
+    EXPECT_EQ(Terms({"100%"}), like_terms(WHITESPACE_PARSER, "100\\% off%"));
+    EXPECT_EQ(Terms({"数", "据"}), like_terms(UNICODE_PARSER, "%数据%"));
+    EXPECT_EQ(Terms({"ab", "bc"}), like_terms(NGRAM_PARSER, "%abc%"));
+    EXPECT_EQ(Terms({}), like_terms(UNICODE_PARSER, "%abc%"));
+}
+
+TEST_F(InvertedIndexTest, write_and_read) {
+    std::vector<std::string> values = {"the quick brown fox", "the lazy dog", "quick dog",
+                                       "数据库"};
+    std::vector<Slice> slices;
+    for (auto& value : values) {
+        slices.emplace_back(value);
+    }
+
+    std::string file_name = kTestDir + "/unicode";
+    ColumnIndexMetaPB meta;
+    {
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(io::global_local_filesystem()->create_file(file_name, &file_writer).ok());
+        std::unique_ptr<InvertedIndexWriter> writer;
+        EXPECT_TRUE(InvertedIndexWriter::create(get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>(),
+                                                UNICODE_PARSER, 0, &writer)
+                            .ok());
+        writer->add_values(slices.data(), 2);
+        writer->add_nulls(1);
+        writer->add_values(slices.data() + 2, 2);
+        EXPECT_TRUE(writer->finish(file_writer.get(), &meta).ok());
+        EXPECT_EQ(INVERTED_INDEX, meta.type());
+        EXPECT_TRUE(file_writer->close().ok());
+    }
+
+    io::FileReaderSPtr file_reader;
+    ASSERT_TRUE(io::global_local_filesystem()->open_file(file_name, &file_reader).ok());
+    InvertedIndexReader reader(std::move(file_reader), &meta.inverted_index());
+    ASSERT_TRUE(reader.load(true, false).ok());
+    InvertedIndexIterator* raw_iter = nullptr;
+    ASSERT_TRUE(reader.new_iterator(&raw_iter).ok());
+    std::unique_ptr<InvertedIndexIterator> iter(raw_iter);
+
+    Roaring bitmap;
+    EXPECT_TRUE(iter->read_term("quick", &bitmap).ok());
+    EXPECT_EQ(Roaring::bitmapOf(2, 0, 3), bitmap);
+    EXPECT_TRUE(iter->read_term("cat", &bitmap).ok());
+    EXPECT_TRUE(bitmap.isEmpty());
+    EXPECT_TRUE(iter->read_term("zzz", &bitmap).ok());
+    EXPECT_TRUE(bitmap.isEmpty());
+
+    EXPECT_TRUE(iter->query({"the", "dog"}, InvertedIndexIterator::MATCH_ALL, 5, &bitmap).ok());
+    EXPECT_EQ(Roaring::bitmapOf(1, 1), bitmap);
+    EXPECT_TRUE(iter->query({"fox", "dog"}, InvertedIndexIterator::MATCH_ANY, 5, &bitmap).ok());
+    EXPECT_EQ(Roaring::bitmapOf(3, 0, 1, 3), bitmap);
+
+    bool pruned = false;
+    EXPECT_TRUE(iter->like_candidates("%the quick brown%", 5, &bitmap, &pruned).ok());
+    EXPECT_TRUE(pruned);
+    EXPECT_EQ(Roaring::bitmapOf(2, 0, 3), bitmap);
+    EXPECT_TRUE(iter->like_candidates("%数据%", 5, &bitmap, &pruned).ok());
+    EXPECT_TRUE(pruned);
+    EXPECT_EQ(Roaring::bitmapOf(1, 4), bitmap);
+    EXPECT_TRUE(iter->like_candidates("%qu%", 5, &bitmap, &pruned).ok());
+    EXPECT_FALSE(pruned);
+    EXPECT_EQ(5, bitmap.cardinality());
+
+    EXPECT_TRUE(iter->equal_candidates("quick dog", 5, &bitmap, &pruned).ok());
+    EXPECT_TRUE(pruned);
+    EXPECT_EQ(Roaring::bitmapOf(1, 3), bitmap);
+}
+
+} // namespace segment_v2
+} // namespace doris
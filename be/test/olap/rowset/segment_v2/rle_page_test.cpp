@@ -21,9 +21,11 @@
 
 #include <memory>
 
+#include "olap/comparison_predicate.h"
 #include "olap/rowset/segment_v2/options.h"
 #include "olap/rowset/segment_v2/page_builder.h"
 #include "olap/rowset/segment_v2/page_decoder.h"
+#include "olap/schema.h"
 #include "runtime/mem_pool.h"
 #include "util/logging.h"
 
@@ -201,4 +203,46 @@ TEST_F(RlePageTest, TestRleBoolBlockEncoderSize) {
     EXPECT_EQ(7, s.slice().size);
 }
 
+TEST_F(RlePageTest, TestRleEvaluatePredicates) {
+    size_t size = 1000;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        ints.get()[i] = i / 100;
+    }
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    segment_v2::RlePageBuilder<OLAP_FIELD_TYPE_INT> rle_page_builder(builder_options);
+    rle_page_builder.add(reinterpret_cast<const uint8_t*>(ints.get()), &size);
+    OwnedSlice s = rle_page_builder.finish();
+
+    PageDecoderOptions decoder_options;
+    segment_v2::RlePageDecoder<OLAP_FIELD_TYPE_INT> rle_page_decoder(s.slice(), decoder_options);
+    EXPECT_TRUE(rle_page_decoder.init().ok());
+    EXPECT_TRUE(rle_page_decoder.seek_to_position_in_page(250).ok());
+
+    std::unique_ptr<ColumnPredicate> equal(new EqualPredicate<int32_t>(0, 3));
+    std::unique_ptr<ColumnPredicate> not_equal(new NotEqualPredicate<int32_t>(0, 2));
+    std::vector<ColumnPredicate*> predicates {equal.get()};
+    auto scratch = Schema::get_predicate_column_ptr(OLAP_FIELD_TYPE_INT);
+    size_t n = 500;
+    std::unique_ptr<bool[]> flags(new bool[n]);
+    EXPECT_TRUE(rle_page_decoder.evaluate_predicates(predicates, &n, scratch, flags.get()).ok());
+    EXPECT_EQ(500, n);
+    EXPECT_EQ(750, rle_page_decoder.current_index());
+    // the rows 250 to 749 are made of 6 runs
+    EXPECT_EQ(6, scratch->size());
+    for (int i = 0; i < n; i++) {
+        EXPECT_EQ(ints.get()[250 + i] == 3, flags[i]) << "Fail at index " << i;
+    }
+
+    scratch->clear();
+    predicates = {not_equal.get(), equal.get()};
+    n = 1000;
+    EXPECT_TRUE(rle_page_decoder.evaluate_predicates(predicates, &n, scratch, flags.get()).ok());
+    EXPECT_EQ(250, n);
+    for (int i = 0; i < n; i++) {
+        EXPECT_FALSE(flags[i]) << "Fail at index " << i;
+    }
+}
+
 } // namespace doris
@@ -27,22 +27,31 @@
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
 #include "io/fs/local_file_system.h"
+#include "olap/block_column_predicate.h"
 #include "olap/comparison_predicate.h"
 #include "olap/data_dir.h"
 #include "olap/in_list_predicate.h"
+#include "olap/key_coder.h"
+#include "olap/null_predicate.h"
+#include "olap/olap_cond.h"
 #include "olap/olap_common.h"
 #include "olap/row_block.h"
 #include "olap/row_block2.h"
 #include "olap/row_cursor.h"
+#include "olap/rowset/segment_v2/segment_index_file.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
+#include "olap/segment_meta_cache.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet_schema.h"
 #include "olap/tablet_schema_helper.h"
+#include "olap/topn_boundary.h"
 #include "olap/types.h"
 #include "runtime/mem_pool.h"
 #include "testutil/test_util.h"
+#include "util/defer_op.h"
 #include "util/file_utils.h"
+#include "vec/columns/column_nullable.h"
 
 namespace doris {
 namespace segment_v2 {
@@ -304,6 +313,262 @@ TEST_F(SegmentReaderWriterTest, normal) {
     }
 }
 
+TEST_F(SegmentReaderWriterTest, SegmentRowRanges) {
+    TabletSchema tablet_schema = create_schema(
+            {create_int_key(1), create_int_key(2), create_int_value(3), create_int_value(4)});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, tablet_schema, 4096, DefaultIntGenerator, &segment);
+
+    Schema schema(tablet_schema);
+    OlapReaderStatistics stats;
+    auto read_rows = [&](const SegmentRowRanges& ranges, RowCursor* lower_bound,
+                         RowCursor* upper_bound, std::vector<int>* keys) {
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        read_opts.tablet_schema = &tablet_schema;
+        read_opts.segment_row_ranges = &ranges;
+        if (lower_bound != nullptr) {
+            read_opts.key_ranges.emplace_back(lower_bound, true, upper_bound, true);
+        }
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+
+        RowBlockV2 block(schema, 1024);
+        while (true) {
+            block.clear();
+            auto st = iter->next_batch(&block);
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok());
+            auto column_block = block.column_block(0);
+            for (int i = 0; i < block.num_rows(); ++i) {
+                keys->push_back(*(int*)column_block.cell_ptr(i));
+            }
+        }
+    };
+
+    // a range inside the segment
+    {
+        std::vector<int> keys;
+        read_rows({{0, {1000, 3000}}}, nullptr, nullptr, &keys);
+        ASSERT_EQ(2000, keys.size());
+        for (int i = 0; i < keys.size(); ++i) {
+            EXPECT_EQ((1000 + i) * 10, keys[i]);
+        }
+    }
+    // the end of a range is capped by the rows of the segment
+    {
+        std::vector<int> keys;
+        read_rows({{0, {4000, UINT32_MAX}}}, nullptr, nullptr, &keys);
+        ASSERT_EQ(96, keys.size());
+        EXPECT_EQ(40000, keys.front());
+        EXPECT_EQ(40950, keys.back());
+    }
+    // a range and a key range are both applied
+    {
+        std::unique_ptr<RowCursor> lower_bound(new RowCursor());
+        lower_bound->init(tablet_schema, 1);
+        lower_bound->cell(0).set_not_null();
+        *(int*)lower_bound->cell(0).mutable_cell_ptr() = 100;
+        std::unique_ptr<RowCursor> upper_bound(new RowCursor());
+        upper_bound->init(tablet_schema, 1);
+        upper_bound->cell(0).set_not_null();
+        *(int*)upper_bound->cell(0).mutable_cell_ptr() = 200;
+
+        std::vector<int> keys;
+        read_rows({{0, {15, 100}}}, lower_bound.get(), upper_bound.get(), &keys);
+        ASSERT_EQ(6, keys.size());
+        EXPECT_EQ(150, keys.front());
+        EXPECT_EQ(200, keys.back());
+    }
+}
+
+TEST_F(SegmentReaderWriterTest, PushDownAggAndLimit) {
+    TabletSchema tablet_schema = create_schema(
+            {create_int_key(1), create_int_key(2), create_int_value(3), create_int_value(4)});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    shared_ptr<Segment> segment;
+    build_segment(opts, tablet_schema, tablet_schema, 4096, DefaultIntGenerator, &segment);
+
+    Schema schema(tablet_schema);
+    OlapReaderStatistics stats;
+    auto read_rows = [&](TPushAggOp::type agg_type, int64_t limit, RowCursor* lower_bound,
+                         std::vector<std::vector<int64_t>>* rows) {
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        read_opts.tablet_schema = &tablet_schema;
+        read_opts.push_down_agg_type_opt = agg_type;
+        read_opts.read_limit = limit;
+        if (lower_bound != nullptr) {
+            read_opts.key_ranges.emplace_back(lower_bound, true, nullptr, false);
+        }
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+
+        vectorized::Block block;
+        for (auto cid : schema.column_ids()) {
+            auto type = Schema::get_data_type_ptr(*schema.column(cid));
+            block.insert({type->create_column(), type, std::to_string(cid)});
+        }
+        while (true) {
+            auto st = iter->next_batch(&block);
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok());
+            for (size_t i = 0; i < block.rows(); ++i) {
+                std::vector<int64_t> row;
+                for (size_t j = 0; j < block.columns(); ++j) {
+                    row.push_back(block.get_by_position(j).column->get_int(i));
+                }
+                rows->push_back(std::move(row));
+            }
+        }
+    };
+
+    // the min and the max of every column from the zone maps
+    {
+        std::vector<std::vector<int64_t>> rows;
+        read_rows(TPushAggOp::MINMAX, -1, nullptr, &rows);
+        ASSERT_EQ(2, rows.size());
+        for (int cid = 0; cid < 4; ++cid) {
+            EXPECT_EQ(cid, rows[0][cid]);
+            EXPECT_EQ(40950 + cid, rows[1][cid]);
+        }
+        EXPECT_EQ(1, stats.metadata_answered_segment_number);
+    }
+    // as many rows as the segment has
+    {
+        std::vector<std::vector<int64_t>> rows;
+        read_rows(TPushAggOp::COUNT, -1, nullptr, &rows);
+        EXPECT_EQ(4096, rows.size());
+        EXPECT_EQ(2, stats.metadata_answered_segment_number);
+    }
+    // the rows of a key range are read
+    {
+        std::unique_ptr<RowCursor> lower_bound(new RowCursor());
+        lower_bound->init(tablet_schema, 1);
+        lower_bound->cell(0).set_not_null();
+        *(int*)lower_bound->cell(0).mutable_cell_ptr() = 40000;
+
+        std::vector<std::vector<int64_t>> rows;
+        read_rows(TPushAggOp::MINMAX, -1, lower_bound.get(), &rows);
+        ASSERT_EQ(96, rows.size());
+        EXPECT_EQ(40000, rows.front()[0]);
+        EXPECT_EQ(2, stats.metadata_answered_segment_number);
+    }
+    // the segment stops at the limit
+    {
+        std::vector<std::vector<int64_t>> rows;
+        read_rows(TPushAggOp::NONE, 100, nullptr, &rows);
+        ASSERT_EQ(100, rows.size());
+        EXPECT_EQ(990, rows.back()[0]);
+    }
+}
+
+TEST_F(SegmentReaderWriterTest, PushDownAggOfNullableColumns) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1, false), create_int_value(2)});
+    // every third value is null
+    ValueGenerator data_gen = [](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+        if (cid == 1 && rid % 3 == 0) {
+            cell.set_null();
+            return;
+        }
+        cell.set_not_null();
+        *(int*)(cell.mutable_cell_ptr()) = cid == 0 ? rid : rid * 10;
+    };
+    shared_ptr<Segment> segment;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, 100, data_gen, &segment);
+
+    Schema schema(tablet_schema);
+    OlapReaderStatistics stats;
+    // the rows read, and the number of nulls of the value column among them
+    auto read_rows = [&](TPushAggOp::type agg_type, std::vector<std::vector<int64_t>>* rows,
+                         size_t* nulls) {
+        StorageReadOptions read_opts;
+        read_opts.stats = &stats;
+        read_opts.tablet_schema = &tablet_schema;
+        read_opts.push_down_agg_type_opt = agg_type;
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+
+        vectorized::Block block;
+        for (auto cid : schema.column_ids()) {
+            auto type = Schema::get_data_type_ptr(*schema.column(cid));
+            block.insert({type->create_column(), type, std::to_string(cid)});
+        }
+        *nulls = 0;
+        while (true) {
+            auto st = iter->next_batch(&block);
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok());
+            const auto& value = assert_cast<const vectorized::ColumnNullable&>(
+                    *block.get_by_position(1).column);
+            for (size_t i = 0; i < block.rows(); ++i) {
+                if (value.is_null_at(i)) {
+                    ++*nulls;
+                    continue;
+                }
+                rows->push_back({block.get_by_position(0).column->get_int(i),
+                                 value.get_nested_column().get_int(i)});
+            }
+        }
+    };
+
+    std::vector<std::vector<int64_t>> rows;
+    size_t nulls = 0;
+    read_rows(TPushAggOp::NONE, &rows, &nulls);
+    EXPECT_EQ(66, rows.size());
+    EXPECT_EQ(34, nulls);
+    EXPECT_EQ(0, stats.metadata_answered_segment_number);
+
+    // count(*) and count(v) of the rows of the metadata are those of the segment
+    rows.clear();
+    read_rows(TPushAggOp::COUNT, &rows, &nulls);
+    EXPECT_EQ(66, rows.size());
+    EXPECT_EQ(34, nulls);
+    EXPECT_EQ(1, stats.metadata_answered_segment_number);
+
+    // the zone map of the value column leaves out its nulls
+    rows.clear();
+    read_rows(TPushAggOp::MINMAX, &rows, &nulls);
+    ASSERT_EQ(2, rows.size());
+    EXPECT_EQ(0, nulls);
+    EXPECT_EQ(0, rows[0][0]);
+    EXPECT_EQ(10, rows[0][1]);
+    EXPECT_EQ(99, rows[1][0]);
+    EXPECT_EQ(980, rows[1][1]);
+    EXPECT_EQ(2, stats.metadata_answered_segment_number);
+
+    // a column added after the segment is written has no metadata in it
+    TabletSchema new_schema =
+            create_schema({create_int_key(1, false), create_int_value(2), create_int_value(3)});
+    Schema read_schema(new_schema);
+    StorageReadOptions read_opts;
+    read_opts.stats = &stats;
+    read_opts.tablet_schema = &new_schema;
+    read_opts.push_down_agg_type_opt = TPushAggOp::COUNT;
+    std::unique_ptr<RowwiseIterator> iter;
+    ASSERT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+    vectorized::Block block;
+    for (auto cid : read_schema.column_ids()) {
+        auto type = Schema::get_data_type_ptr(*read_schema.column(cid));
+        block.insert({type->create_column(), type, std::to_string(cid)});
+    }
+    ASSERT_TRUE(iter->next_batch(&block).ok());
+    EXPECT_EQ(2, stats.metadata_answered_segment_number);
+}
+
 TEST_F(SegmentReaderWriterTest, LazyMaterialization) {
     TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_value(2)});
     ValueGenerator data_gen = [](size_t rid, int cid, int block_id, RowCursorCell& cell) {
@@ -426,6 +691,253 @@ TEST_F(SegmentReaderWriterTest, LazyMaterialization) {
     }
 }
 
+TEST_F(SegmentReaderWriterTest, PagePredicatesAcrossBlocks) {
+    // the bool column is RLE encoded, so its predicate is evaluated on the pages
+    TabletSchema tablet_schema = create_schema(
+            {create_int_key(1), TabletColumn(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_BOOL,
+                                             false, 2, 1)});
+    // runs of 7 rows alternately pass and fail the predicate, so the selected rows of a block
+    // never end where the next block starts
+    ValueGenerator data_gen = [](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+        cell.set_not_null();
+        if (cid == 0) {
+            *(int*)(cell.mutable_cell_ptr()) = rid;
+        } else {
+            *(bool*)(cell.mutable_cell_ptr()) = (rid / 7) % 2 == 0;
+        }
+    };
+    shared_ptr<Segment> segment;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, 4096, data_gen, &segment);
+
+    Schema read_schema(tablet_schema);
+    std::unique_ptr<ColumnPredicate> predicate(new EqualPredicate<bool>(1, true));
+    const std::vector<ColumnPredicate*> predicates = {predicate.get()};
+    OlapReaderStatistics stats;
+    StorageReadOptions read_opts;
+    read_opts.column_predicates = predicates;
+    read_opts.stats = &stats;
+    read_opts.tablet_schema = &tablet_schema;
+    read_opts.block_row_max = 100;
+    std::unique_ptr<RowwiseIterator> iter;
+    ASSERT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+
+    vectorized::Block block;
+    for (auto cid : read_schema.column_ids()) {
+        auto type = Schema::get_data_type_ptr(*read_schema.column(cid));
+        block.insert({type->create_column(), type, std::to_string(cid)});
+    }
+    std::vector<int64_t> keys;
+    while (true) {
+        auto st = iter->next_batch(&block);
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok());
+        for (size_t i = 0; i < block.rows(); ++i) {
+            keys.push_back(block.get_by_position(0).column->get_int(i));
+            EXPECT_EQ(1, block.get_by_position(1).column->get_int(i));
+        }
+        block.clear_column_data();
+    }
+    EXPECT_TRUE(iter->is_lazy_materialization_read());
+
+    std::vector<int64_t> expected_keys;
+    for (int64_t rid = 0; rid < 4096; ++rid) {
+        if ((rid / 7) % 2 == 0) {
+            expected_keys.push_back(rid);
+        }
+    }
+    EXPECT_EQ(expected_keys, keys);
+}
+
+TEST_F(SegmentReaderWriterTest, DeletedRowsCache) {
+    SegmentMetaCache meta_cache(16 * 1024 * 1024);
+    SegmentMetaCache* global_meta_cache = SegmentMetaCache::_s_instance;
+    SegmentMetaCache::_s_instance = &meta_cache;
+    Defer restore_meta_cache {[&]() { SegmentMetaCache::_s_instance = global_meta_cache; }};
+
+    // k1 INT, v2 INT NULL, v3 INT, the value v2 is null every 10 rows
+    TabletSchema tablet_schema =
+            create_schema({create_int_key(1, false), create_int_value(2),
+                           create_int_value(3, OLAP_FIELD_AGGREGATION_SUM, false)});
+    ValueGenerator data_gen = [](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+        if (cid == 1 && rid % 10 == 0) {
+            cell.set_null();
+            return;
+        }
+        cell.set_not_null();
+        *(int*)(cell.mutable_cell_ptr()) = cid == 0 ? rid : (cid == 1 ? rid % 7 : rid % 5);
+    };
+    const size_t num_rows = 4096;
+    shared_ptr<Segment> segment;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, num_rows, data_gen,
+                  &segment);
+    auto cached_rows = [&](int64_t version) -> std::shared_ptr<roaring::Roaring> {
+        return meta_cache.lookup<roaring::Roaring>(SegmentMetaCache::key(
+                segment->_file_reader->path().native(), SegmentMetaCache::DELETED_ROWS, version));
+    };
+
+    // Reads the keys of the rows in [begin, end) with the deletes up to the version: the version
+    // 3 deletes v2 = 3 and v3 = 1, the version 4 deletes v2 is null.
+    Schema read_schema(tablet_schema);
+    auto read_keys = [&](int64_t version, uint32_t begin, uint32_t end,
+                         std::vector<int64_t>* keys) {
+        std::vector<std::unique_ptr<ColumnPredicate>> predicates;
+        std::vector<std::unique_ptr<Conditions>> conditions;
+        StorageReadOptions read_opts;
+        auto add_condition = [&](const std::string& column, const std::string& op,
+                                 const std::string& value) {
+            TCondition condition;
+            condition.__set_column_name(column);
+            condition.__set_condition_op(op);
+            condition.__set_condition_values({value});
+            ASSERT_TRUE(conditions.back()->append_condition(condition).ok());
+        };
+        // the predicates of a delete select the rows it does not delete
+        conditions.emplace_back(new Conditions());
+        conditions.back()->set_tablet_schema(&tablet_schema);
+        add_condition("2", "=", "3");
+        add_condition("3", "=", "1");
+        predicates.emplace_back(new EqualPredicate<int32_t>(1, 3, true));
+        predicates.emplace_back(new EqualPredicate<int32_t>(2, 1, true));
+        auto or_predicate = new OrBlockColumnPredicate();
+        or_predicate->add_column_predicate(new SingleColumnBlockPredicate(predicates[0].get()));
+        or_predicate->add_column_predicate(new SingleColumnBlockPredicate(predicates[1].get()));
+        read_opts.delete_condition_predicates->add_column_predicate(or_predicate);
+        if (version >= 4) {
+            conditions.emplace_back(new Conditions());
+            conditions.back()->set_tablet_schema(&tablet_schema);
+            add_condition("2", "is", "null");
+            predicates.emplace_back(new NullPredicate(1, true, true));
+            read_opts.delete_condition_predicates->add_column_predicate(
+                    new SingleColumnBlockPredicate(predicates.back().get()));
+        }
+        for (const auto& condition : conditions) {
+            read_opts.delete_conditions.push_back(condition.get());
+        }
+        read_opts.delete_condition_version = version;
+        OlapReaderStatistics stats;
+        read_opts.stats = &stats;
+        read_opts.tablet_schema = &tablet_schema;
+        read_opts.block_row_max = 1000;
+        SegmentRowRanges ranges = {{segment->id(), {begin, end}}};
+        read_opts.segment_row_ranges = &ranges;
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+
+        vectorized::Block block;
+        for (auto cid : read_schema.column_ids()) {
+            auto type = Schema::get_data_type_ptr(*read_schema.column(cid));
+            block.insert({type->create_column(), type, std::to_string(cid)});
+        }
+        while (true) {
+            auto st = iter->next_batch(&block);
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            for (size_t i = 0; i < block.rows(); ++i) {
+                keys->push_back(block.get_by_position(0).column->get_int(i));
+            }
+            block.clear_column_data();
+        }
+    };
+    auto expected_keys = [&](int64_t version, uint32_t begin, uint32_t end) {
+        std::vector<int64_t> keys;
+        for (int64_t rid = begin; rid < end; ++rid) {
+            bool is_null = rid % 10 == 0;
+            if ((!is_null && rid % 7 == 3 && rid % 5 == 1) || (version >= 4 && is_null)) {
+                continue;
+            }
+            keys.push_back(rid);
+        }
+        return keys;
+    };
+    auto check = [&](int64_t version, uint32_t begin, uint32_t end) {
+        std::vector<int64_t> keys;
+        read_keys(version, begin, end, &keys);
+        EXPECT_EQ(expected_keys(version, begin, end), keys)
+                << "version: " << version << ", rows: [" << begin << ", " << end << ")";
+    };
+
+    // a read of a small part of the segment evaluates the deletes on the rows read
+    check(3, 100, 1100);
+    EXPECT_EQ(nullptr, cached_rows(3));
+
+    // the first read of the segment computes its deleted rows, which the next one uses
+    check(3, 0, num_rows);
+    ASSERT_NE(nullptr, cached_rows(3));
+    EXPECT_EQ(num_rows - expected_keys(3, 0, num_rows).size(), cached_rows(3)->cardinality());
+    check(3, 0, num_rows);
+    check(3, 100, 1100);
+
+    // a new delete has a version of its own, and a reader at the older version still reads the
+    // rows the new one deletes
+    check(4, 0, num_rows);
+    ASSERT_NE(nullptr, cached_rows(4));
+    EXPECT_EQ(num_rows - expected_keys(4, 0, num_rows).size(), cached_rows(4)->cardinality());
+    check(3, 0, num_rows);
+    check(4, 2000, num_rows);
+
+    config::enable_deleted_rows_cache = false;
+    check(4, 0, num_rows);
+    config::enable_deleted_rows_cache = true;
+}
+
+TEST_F(SegmentReaderWriterTest, TopNBoundaryNullsFirst) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1, false), create_int_value(2)});
+    // the values of the first quarter of the rows are null
+    ValueGenerator data_gen = [](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+        if (cid == 1 && rid < 16 * 1024) {
+            cell.set_null();
+            return;
+        }
+        cell.set_not_null();
+        *(int*)(cell.mutable_cell_ptr()) = cid == 0 ? rid : rid * 10;
+    };
+    shared_ptr<Segment> segment;
+    build_segment(SegmentWriterOptions(), tablet_schema, tablet_schema, 64 * 1024, data_gen,
+                  &segment);
+
+    // ORDER BY c2 DESC LIMIT n has kept rows above every value of the segment
+    auto read_null_rows = [&](OlapReaderStatistics* stats) {
+        TopNBoundary boundary("2", false, true);
+        boundary.update("100000000");
+        Schema read_schema(tablet_schema);
+        StorageReadOptions read_opts;
+        read_opts.stats = stats;
+        read_opts.tablet_schema = &tablet_schema;
+        read_opts.topn_boundary = &boundary;
+        std::unique_ptr<RowwiseIterator> iter;
+        EXPECT_TRUE(segment->new_iterator(read_schema, read_opts, &iter).ok());
+
+        vectorized::Block block;
+        for (auto cid : read_schema.column_ids()) {
+            auto type = Schema::get_data_type_ptr(*read_schema.column(cid));
+            block.insert({type->create_column(), type, std::to_string(cid)});
+        }
+        size_t null_rows = 0;
+        while (true) {
+            auto st = iter->next_batch(&block);
+            if (st.is_end_of_file()) {
+                break;
+            }
+            EXPECT_TRUE(st.ok());
+            for (size_t i = 0; i < block.rows(); ++i) {
+                null_rows += block.get_by_position(1).column->is_null_at(i);
+            }
+            block.clear_column_data();
+        }
+        return null_rows;
+    };
+
+    // with NULLS FIRST the null rows beat the boundary, none of them is skipped
+    OlapReaderStatistics stats;
+    EXPECT_EQ(16 * 1024, read_null_rows(&stats));
+    // while the pages having only values are skipped
+    EXPECT_GT(stats.rows_topn_filtered, 0);
+}
+
 TEST_F(SegmentReaderWriterTest, TestIndex) {
     TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_key(2, true, true),
                                                 create_int_key(3), create_int_value(4)});
@@ -618,6 +1130,66 @@ TEST_F(SegmentReaderWriterTest, TestIndex) {
     }
 }
 
+TEST_F(SegmentReaderWriterTest, TestIndexFile) {
+    // the segment is written without the indexes of column 2, as if linked by a schema change
+    TabletSchema build_schema = create_schema(
+            {create_int_key(1), create_int_key(2), create_int_value(3), create_int_value(4)});
+    TabletSchema tablet_schema =
+            create_schema({create_int_key(1), create_int_key(2, true, true, true),
+                           create_int_value(3), create_int_value(4)});
+    EXPECT_TRUE(SegmentIndexFile::lacks_indexes(build_schema, tablet_schema));
+    EXPECT_FALSE(SegmentIndexFile::lacks_indexes(tablet_schema, build_schema));
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    std::shared_ptr<Segment> segment;
+    build_segment(opts, build_schema, tablet_schema, 64 * 1024, DefaultIntGenerator, &segment);
+    EXPECT_FALSE(segment->_column_readers[2]->has_bloom_filter_index());
+
+    auto fs = io::global_local_filesystem();
+    std::string path = segment->_file_reader->path().native();
+    std::string index_path = path + ".idx";
+    size_t bytes_read = 0;
+    bool built = false;
+    ASSERT_TRUE(SegmentIndexFile::build(
+                        segment.get(), index_path, [&](size_t bytes) { bytes_read += bytes; },
+                        &built)
+                        .ok());
+    EXPECT_TRUE(built);
+    EXPECT_GT(bytes_read, 0);
+
+    ASSERT_TRUE(Segment::open(fs, path, 0, &tablet_schema, &segment, index_path).ok());
+    EXPECT_TRUE(segment->_column_readers[2]->has_bloom_filter_index());
+    EXPECT_TRUE(segment->_column_readers[2]->has_bitmap_index());
+    EXPECT_FALSE(segment->_column_readers[1]->has_bloom_filter_index());
+
+    // the segment lacks no index with its index file
+    ASSERT_TRUE(SegmentIndexFile::build(
+                        segment.get(), index_path + ".2", [](size_t) {}, &built)
+                        .ok());
+    EXPECT_FALSE(built);
+
+    // select * where c2 = 1001 is answered by the bitmap index of the index file
+    Schema schema(tablet_schema);
+    std::unique_ptr<ColumnPredicate> predicate(new EqualPredicate<int32_t>(1, 1001));
+    const std::vector<ColumnPredicate*> predicates = {predicate.get()};
+    OlapReaderStatistics stats;
+    StorageReadOptions read_opts;
+    read_opts.column_predicates = predicates;
+    read_opts.stats = &stats;
+    read_opts.tablet_schema = &tablet_schema;
+    std::unique_ptr<RowwiseIterator> iter;
+    ASSERT_TRUE(segment->new_iterator(schema, read_opts, &iter).ok());
+
+    RowBlockV2 block(schema, 1024);
+    EXPECT_TRUE(iter->next_batch(&block).ok());
+    EXPECT_EQ(1, block.selected_size());
+    EXPECT_EQ(64 * 1024 - 1, stats.rows_bitmap_index_filtered);
+    auto row = block.row(block.selection_vector()[0]);
+    EXPECT_EQ(1001, *(int*)row.cell_ptr(1));
+}
+
 TEST_F(SegmentReaderWriterTest, estimate_segment_size) {
     size_t num_rows_per_block = 10;
 
@@ -1188,5 +1760,49 @@ TEST_F(SegmentReaderWriterTest, TestBloomFilterIndexUniqueModel) {
     EXPECT_TRUE(column_contains_index(seg2->footer().columns(3), BLOOM_FILTER_INDEX));
 }
 
+TEST_F(SegmentReaderWriterTest, TestPrimaryKeyIndex) {
+    TabletSchema schema = create_schema({create_int_key(1), create_int_key(2),
+                                         create_int_value(3, OLAP_FIELD_AGGREGATION_REPLACE)});
+    schema._keys_type = UNIQUE_KEYS;
+
+    SegmentWriterOptions opts;
+    opts.enable_unique_key_merge_on_write = true;
+    shared_ptr<Segment> segment;
+    build_segment(opts, schema, schema, 4096, DefaultIntGenerator, &segment);
+    EXPECT_TRUE(segment->footer().has_primary_key_index_meta());
+
+    auto encode_key = [](int32_t k1, int32_t k2) {
+        const KeyCoder* key_coder = get_key_coder(OLAP_FIELD_TYPE_INT);
+        std::string encoded_key;
+        for (int32_t k : {k1, k2}) {
+            encoded_key.push_back(KEY_NORMAL_MARKER);
+            key_coder->full_encode_ascending(&k, &encoded_key);
+        }
+        return encoded_key;
+    };
+
+    std::unique_ptr<IndexedColumnIterator> index_iterator;
+    EXPECT_TRUE(segment->new_primary_key_index_iterator(&index_iterator).ok());
+    for (uint32_t rid = 0; rid < 4096; rid += 7) {
+        std::string key = encode_key(rid * 10, rid * 10 + 1);
+        RowLocation loc;
+        EXPECT_TRUE(segment->lookup_row_key(key, index_iterator.get(), &loc).ok());
+        EXPECT_EQ(rid, loc.row_id);
+        EXPECT_EQ(0, loc.segment_id);
+    }
+    RowLocation loc;
+    EXPECT_TRUE(segment->lookup_row_key(encode_key(10, 12), &loc).is_not_found());
+    EXPECT_TRUE(segment->lookup_row_key(encode_key(50, 51), &loc).ok());
+    EXPECT_EQ(5, loc.row_id);
+
+    // only unique key segments have a primary key index
+    SegmentWriterOptions dup_opts;
+    shared_ptr<Segment> dup_segment;
+    schema._keys_type = DUP_KEYS;
+    dup_opts.enable_unique_key_merge_on_write = true;
+    build_segment(dup_opts, schema, schema, 100, DefaultIntGenerator, &dup_segment);
+    EXPECT_FALSE(dup_segment->footer().has_primary_key_index_meta());
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -201,6 +201,19 @@ TEST_F(ColumnZoneMapTest, NormalTestIntPage) {
 
     EXPECT_EQ(true, zone_maps[2].has_null());
     EXPECT_EQ(false, zone_maps[2].has_not_null());
+
+    EXPECT_EQ(0, zone_maps[0].null_count());
+    EXPECT_EQ(1, zone_maps[1].null_count());
+    EXPECT_EQ(6, zone_maps[2].null_count());
+    EXPECT_EQ(7, index_meta.zone_map_index().segment_zone_map().null_count());
+
+    HyperLogLog sketch;
+    bool has_sketch = false;
+    EXPECT_TRUE(ZoneMapIndexReader::load_ndv_sketch(file_reader, index_meta.zone_map_index(),
+                                                    &sketch, &has_sketch)
+                        .ok());
+    EXPECT_TRUE(has_sketch);
+    EXPECT_EQ(10, sketch.estimate_cardinality());
     delete field;
 }
 
@@ -229,5 +242,57 @@ TEST_F(ColumnZoneMapTest, ZoneMapCut) {
     delete field;
 }
 
+// Test for the upper bound of the max cut to MAX_ZONE_MAP_INDEX_SIZE bytes
+TEST_F(ColumnZoneMapTest, TruncatedMaxUpperBound) {
+    std::string filename = kTestDir + "/TruncatedMaxUpperBound";
+    auto fs = io::global_local_filesystem();
+
+    TabletColumn varchar_column = create_varchar_key(0);
+    Field* field = FieldFactory::create(varchar_column);
+
+    ZoneMapIndexWriter builder(field);
+    // cut to 511 'a' and a 0xFF
+    std::string value1 = std::string(511, 'a') + "\xFF" + "zzz";
+    Slice slice1(value1);
+    builder.add_values((const uint8_t*)&slice1, 1);
+    builder.flush();
+    // not cut
+    std::string value2(MAX_ZONE_MAP_INDEX_SIZE, 'c');
+    Slice slice2(value2);
+    builder.add_values((const uint8_t*)&slice2, 1);
+    builder.flush();
+    // cut to bytes that are all 0xFF
+    std::string value3(600, '\xFF');
+    Slice slice3(value3);
+    builder.add_values((const uint8_t*)&slice3, 1);
+    builder.flush();
+
+    ColumnIndexMetaPB index_meta;
+    {
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(fs->create_file(filename, &file_writer).ok());
+        EXPECT_TRUE(builder.finish(file_writer.get(), &index_meta).ok());
+        EXPECT_TRUE(file_writer->close().ok());
+    }
+
+    io::FileReaderSPtr file_reader;
+    EXPECT_TRUE(fs->open_file(filename, &file_reader).ok());
+    ZoneMapIndexReader column_zone_map(file_reader, &index_meta.zone_map_index());
+    EXPECT_TRUE(column_zone_map.load(true, false).ok());
+    const std::vector<ZoneMapPB>& zone_maps = column_zone_map.page_zone_maps();
+    EXPECT_EQ(3, zone_maps.size());
+
+    EXPECT_EQ(std::string(510, 'a') + "b", zone_maps[0].max());
+    EXPECT_GT(zone_maps[0].max(), value1);
+    EXPECT_FALSE(zone_maps[0].pass_all());
+
+    EXPECT_EQ(value2, zone_maps[1].max());
+    EXPECT_FALSE(zone_maps[1].pass_all());
+
+    EXPECT_TRUE(zone_maps[2].pass_all());
+    EXPECT_TRUE(index_meta.zone_map_index().segment_zone_map().pass_all());
+    delete field;
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/schema_change.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "util/threadpool.h"
+
+namespace doris {
+
+class SchemaChangeTest : public testing::Test {
+public:
+    void SetUp() override {
+        EXPECT_TRUE(ThreadPoolBuilder("SchemaChangeTestPool")
+                            .set_min_threads(4)
+                            .set_max_threads(4)
+                            .build(&_pool)
+                            .ok());
+    }
+
+    void TearDown() override { _pool->shutdown(); }
+
+protected:
+    std::unique_ptr<ThreadPool> _pool;
+};
+
+TEST_F(SchemaChangeTest, ConvertInline) {
+    std::vector<size_t> converted;
+    auto convert = [&](size_t i) {
+        converted.push_back(i);
+        return Status::OK();
+    };
+    // without a pool the rowsets are converted in order on the calling thread
+    EXPECT_TRUE(SchemaChangeHandler::run_rowset_conversions(nullptr, 4, 3, convert).ok());
+    EXPECT_EQ((std::vector<size_t> {0, 1, 2}), converted);
+
+    converted.clear();
+    EXPECT_TRUE(SchemaChangeHandler::run_rowset_conversions(_pool.get(), 1, 3, convert).ok());
+    EXPECT_EQ((std::vector<size_t> {0, 1, 2}), converted);
+
+    EXPECT_TRUE(SchemaChangeHandler::run_rowset_conversions(_pool.get(), 4, 0, convert).ok());
+}
+
+TEST_F(SchemaChangeTest, ConvertInParallel) {
+    std::atomic<int> running(0);
+    std::atomic<int> max_running(0);
+    std::vector<std::atomic<bool>> converted(8);
+    auto convert = [&](size_t i) {
+        int now = ++running;
+        int prev = max_running.load();
+        while (now > prev && !max_running.compare_exchange_weak(prev, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        converted[i] = true;
+        --running;
+        return Status::OK();
+    };
+    EXPECT_TRUE(SchemaChangeHandler::run_rowset_conversions(_pool.get(), 2, 8, convert).ok());
+    for (auto& done : converted) {
+        EXPECT_TRUE(done);
+    }
+    // the token bounds the conversions running at once
+    EXPECT_LE(max_running, 2);
+    EXPECT_GE(max_running, 1);
+}
+
+TEST_F(SchemaChangeTest, CancelAfterFailure) {
+    std::atomic<int> calls(0);
+    auto convert = [&](size_t i) {
+        ++calls;
+        if (i == 0) {
+            return Status::InternalError("rowset {} is corrupted", i);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return Status::OK();
+    };
+    Status st = SchemaChangeHandler::run_rowset_conversions(nullptr, 1, 5, convert);
+    // the first failure is reported, and the rowsets after it are not converted
+    EXPECT_FALSE(st.ok());
+    EXPECT_FALSE(st.is_cancelled());
+    EXPECT_NE(std::string::npos, st.to_string().find("rowset 0 is corrupted"));
+    EXPECT_EQ(1, calls);
+
+    calls = 0;
+    st = SchemaChangeHandler::run_rowset_conversions(_pool.get(), 2, 100, convert);
+    EXPECT_FALSE(st.ok());
+    EXPECT_FALSE(st.is_cancelled());
+    EXPECT_NE(std::string::npos, st.to_string().find("rowset 0 is corrupted"));
+    EXPECT_LT(calls, 100);
+}
+
+TEST_F(SchemaChangeTest, ReportFailureOfLaterRowset) {
+    auto convert = [&](size_t i) {
+        if (i == 3) {
+            return Status::MemoryLimitExceeded("no memory for rowset {}", i);
+        }
+        return Status::OK();
+    };
+    Status st = SchemaChangeHandler::run_rowset_conversions(_pool.get(), 4, 6, convert);
+    EXPECT_FALSE(st.ok());
+    EXPECT_NE(std::string::npos, st.to_string().find("no memory for rowset 3"));
+}
+
+} // namespace doris
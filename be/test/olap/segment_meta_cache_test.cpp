@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/segment_meta_cache.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "gen_cpp/segment_v2.pb.h"
+
+namespace doris {
+
+TEST(SegmentMetaCacheTest, insert_and_lookup) {
+    SegmentMetaCache cache(16 * 1024 * 1024);
+    std::string key = SegmentMetaCache::key("/data/0.dat", SegmentMetaCache::FOOTER);
+    ASSERT_EQ(nullptr, cache.lookup<const segment_v2::SegmentFooterPB>(key));
+
+    auto footer = std::make_shared<segment_v2::SegmentFooterPB>();
+    footer->set_num_rows(100);
+    cache.insert(key, footer, footer->SpaceUsedLong(), false);
+    auto cached = cache.lookup<const segment_v2::SegmentFooterPB>(key);
+    ASSERT_EQ(footer.get(), cached.get());
+    ASSERT_EQ(100, cached->num_rows());
+
+    // The metadata of other files or at other offsets don't collide.
+    ASSERT_EQ(nullptr, cache.lookup<const segment_v2::SegmentFooterPB>(
+                               SegmentMetaCache::key("/data/1.dat", SegmentMetaCache::FOOTER)));
+    ASSERT_EQ(nullptr, cache.lookup<const segment_v2::SegmentFooterPB>(SegmentMetaCache::key(
+                               "/data/0.dat", SegmentMetaCache::ORDINAL_INDEX, 0)));
+}
+
+TEST(SegmentMetaCacheTest, pinned_entries_outlive_normal_ones) {
+    // each of the 16 shards holds one normal entry besides the pinned one
+    SegmentMetaCache cache(16 * 2048);
+    auto pinned_key = SegmentMetaCache::key("/data/pinned.dat", SegmentMetaCache::FOOTER);
+    auto pinned = std::make_shared<segment_v2::SegmentFooterPB>();
+    cache.insert(pinned_key, pinned, 100, true);
+
+    auto first = std::make_shared<segment_v2::SegmentFooterPB>();
+    first->set_num_rows(1);
+    cache.insert(SegmentMetaCache::key("/data/first.dat", SegmentMetaCache::FOOTER), first, 1024,
+                 false);
+    for (int i = 0; i < 1000; ++i) {
+        auto key = SegmentMetaCache::key(fmt::format("/data/{}.dat", i), SegmentMetaCache::FOOTER);
+        cache.insert(key, std::make_shared<segment_v2::SegmentFooterPB>(), 1024, false);
+    }
+    ASSERT_EQ(pinned.get(), cache.lookup<segment_v2::SegmentFooterPB>(pinned_key).get());
+    // the evicted metadata is still valid for its holders
+    ASSERT_EQ(1, first.use_count());
+    ASSERT_EQ(1, first->num_rows());
+}
+
+} // namespace doris
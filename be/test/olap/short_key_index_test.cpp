@@ -93,6 +93,36 @@ TEST_F(ShortKeyIndexTest, builder) {
     }
 }
 
+TEST_F(ShortKeyIndexTest, shared_prefix) {
+    // the keys longer than 8 bytes share their prefixes, and "ab" and "ab\0" have the same one
+    std::vector<std::string> keys = {std::string("ab"), std::string("ab\0", 3), "abcdefgh",
+                                     "abcdefgh1", "abcdefgh2", "abcdefgh2a", "abcdefgi"};
+    ShortKeyIndexBuilder builder(0, 1024);
+    for (auto& key : keys) {
+        builder.add_item(key);
+    }
+    std::vector<Slice> slices;
+    segment_v2::PageFooterPB footer;
+    EXPECT_TRUE(builder.finalize(keys.size() * 1024, &slices, &footer).ok());
+    std::string buf;
+    for (auto& slice : slices) {
+        buf.append(slice.data, slice.size);
+    }
+    ShortKeyIndexDecoder decoder;
+    EXPECT_TRUE(decoder.parse(buf, footer.short_key_page_footer()).ok());
+
+    std::vector<std::string> probes = keys;
+    for (auto probe : {"a", "abc", "abcdefgh0", "abcdefgh3", "abcdefgi0", "b", ""}) {
+        probes.emplace_back(probe);
+    }
+    for (auto& probe : probes) {
+        auto lower = std::lower_bound(keys.begin(), keys.end(), probe);
+        auto upper = std::upper_bound(keys.begin(), keys.end(), probe);
+        EXPECT_EQ(lower - keys.begin(), decoder.lower_bound(probe).ordinal()) << probe;
+        EXPECT_EQ(upper - keys.begin(), decoder.upper_bound(probe).ordinal()) << probe;
+    }
+}
+
 TEST_F(ShortKeyIndexTest, encode) {
     TabletSchema tablet_schema;
     tablet_schema._cols.push_back(create_int_key(0));
@@ -169,4 +169,46 @@ TEST(TabletMetaTest, TestDeleteBitmap) {
     }
 }
 
+TEST(TabletMetaTest, TestDeleteBitmapCompact) {
+    DeleteBitmap dbmp(10087);
+    RowsetId rowset_id {2, 0, 1, 1};
+    for (uint32_t seg_id = 0; seg_id < 2; ++seg_id) {
+        for (uint32_t ver = 1; ver <= 5; ++ver) {
+            dbmp.add({rowset_id, seg_id, ver}, ver * 10 + seg_id);
+        }
+    }
+    dbmp.add({RowsetId {2, 0, 1, 2}, 0, 4}, 100);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 11);
+
+    // Nothing to fold
+    ASSERT_EQ(dbmp.compact(0), 0);
+    ASSERT_EQ(dbmp.compact(1), 0);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 11);
+
+    // Versions 1 to 3 of each segment of rowset 1 are folded into version 3
+    ASSERT_EQ(dbmp.compact(3), 4);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 7);
+    for (uint32_t seg_id = 0; seg_id < 2; ++seg_id) {
+        ASSERT_EQ(dbmp.get({rowset_id, seg_id, 1}), nullptr);
+        ASSERT_EQ(dbmp.get({rowset_id, seg_id, 2}), nullptr);
+        auto bm = dbmp.get({rowset_id, seg_id, 3});
+        ASSERT_NE(bm, nullptr);
+        ASSERT_EQ(bm->cardinality(), 3);
+        for (uint32_t ver = 1; ver <= 3; ++ver) {
+            ASSERT_TRUE(bm->contains(ver * 10 + seg_id));
+        }
+        ASSERT_EQ(dbmp.get({rowset_id, seg_id, 4})->cardinality(), 1);
+        // Aggregated bitmaps of the versions still readable are unchanged
+        ASSERT_EQ(dbmp.get_agg({rowset_id, seg_id, 3})->cardinality(), 3);
+        ASSERT_EQ(dbmp.get_agg({rowset_id, seg_id, 5})->cardinality(), 5);
+    }
+
+    // Fold all versions
+    ASSERT_EQ(dbmp.compact(100), 4);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 3);
+    ASSERT_EQ(dbmp.get({rowset_id, 0, 5})->cardinality(), 5);
+    ASSERT_EQ(dbmp.get({rowset_id, 1, 5})->cardinality(), 5);
+    ASSERT_EQ(dbmp.get({RowsetId {2, 0, 1, 2}, 0, 4})->cardinality(), 1);
+}
+
 } // namespace doris
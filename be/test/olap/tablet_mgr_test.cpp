@@ -322,4 +322,68 @@ TEST_F(TabletMgrTest, GetRowsetId) {
     }
 }
 
+TEST_F(TabletMgrTest, LoadTablets) {
+    TColumn col1;
+    col1.column_type.type = TPrimitiveType::SMALLINT;
+    col1.__set_column_name("col1");
+    col1.__set_is_key(true);
+    TTabletSchema tablet_schema;
+    tablet_schema.__set_short_key_column_count(1);
+    tablet_schema.__set_schema_hash(3333);
+    tablet_schema.__set_keys_type(TKeysType::AGG_KEYS);
+    tablet_schema.__set_storage_type(TStorageType::COLUMN);
+    tablet_schema.__set_columns({col1});
+    std::vector<DataDir*> data_dirs {_data_dir};
+
+    // the tablets of the version [0-1], and the rowsets [2-2] and [3-3] in the meta env
+    const int64_t num_tablets = 100;
+    for (int64_t tablet_id = 1000; tablet_id < 1000 + num_tablets; ++tablet_id) {
+        TCreateTabletReq create_tablet_req;
+        create_tablet_req.__set_tablet_schema(tablet_schema);
+        create_tablet_req.__set_tablet_id(tablet_id);
+        create_tablet_req.__set_version(1);
+        ASSERT_TRUE(_tablet_mgr->create_tablet(create_tablet_req, data_dirs).ok());
+        TabletSharedPtr tablet = _tablet_mgr->get_tablet(tablet_id);
+        ASSERT_TRUE(tablet != nullptr);
+        for (int64_t version = 2; version <= 3; ++version) {
+            RowsetMetaPB rowset_meta_pb;
+            tablet->tablet_meta()->all_rs_metas()[0]->to_rowset_pb(&rowset_meta_pb);
+            RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
+            ASSERT_TRUE(rowset_meta->init_from_pb(rowset_meta_pb));
+            rowset_meta->set_rowset_id(k_engine->next_rowset_id());
+            rowset_meta->set_version({version, version});
+            rowset_meta->set_rowset_state(RowsetStatePB::VISIBLE);
+            if (tablet_id == 1000 && version == 3) {
+                // the rowset of a dropped tablet is skipped
+                rowset_meta->set_tablet_id(999);
+            }
+            ASSERT_TRUE(RowsetMetaManager::save(_data_dir->get_meta(), tablet->tablet_uid(),
+                                                rowset_meta->rowset_id(),
+                                                rowset_meta->get_rowset_pb())
+                                .ok());
+        }
+    }
+
+    // the tablets and their rowsets are the same whatever the number of the load threads
+    int32_t tablet_load_threads_per_disk = config::tablet_load_threads_per_disk;
+    TabletManager* tablet_manager = _data_dir->_tablet_manager;
+    for (int32_t num_threads : {1, 4}) {
+        config::tablet_load_threads_per_disk = num_threads;
+        TabletManager tablet_mgr(1);
+        _data_dir->_tablet_manager = &tablet_mgr;
+        EXPECT_TRUE(_data_dir->load().ok());
+        _data_dir->_tablet_manager = tablet_manager;
+        for (int64_t tablet_id = 1000; tablet_id < 1000 + num_tablets; ++tablet_id) {
+            TabletSharedPtr tablet = tablet_mgr.get_tablet(tablet_id);
+            ASSERT_TRUE(tablet != nullptr) << tablet_id;
+            int64_t max_version = tablet_id == 1000 ? 2 : 3;
+            EXPECT_EQ(max_version, tablet->max_version().second) << tablet_id;
+            int64_t num_rowsets = tablet->tablet_meta()->all_rs_metas().size();
+            EXPECT_EQ(max_version, num_rowsets) << tablet_id;
+        }
+        EXPECT_TRUE(tablet_mgr.get_tablet(999) == nullptr);
+    }
+    config::tablet_load_threads_per_disk = tablet_load_threads_per_disk;
+}
+
 } // namespace doris
@@ -370,6 +370,45 @@ TEST_F(TestTablet, cooldown_policy) {
     }
 }
 
+TEST_F(TestTablet, cooldown_of_hot_tablet) {
+    RowsetMetaSharedPtr ptr1(new RowsetMeta());
+    init_rs_meta(ptr1, 1, 2, 100, 200);
+    _tablet_meta->add_rs_meta(ptr1);
+    RowsetSharedPtr rowset1 = make_shared<BetaRowset>(nullptr, "", ptr1);
+
+    TabletSharedPtr _tablet(new Tablet(_tablet_meta, nullptr));
+    _tablet->init();
+    _tablet->set_cooldown_resource("test_policy_name");
+    _tablet->_rs_version_map[ptr1->version()] = rowset1;
+
+    if (ExecEnv::GetInstance()->_storage_policy_mgr == nullptr) {
+        ExecEnv::GetInstance()->_storage_policy_mgr = new StoragePolicyMgr();
+    }
+    auto policy = std::make_shared<StoragePolicy>();
+    policy->storage_policy_name = "test_policy_name";
+    policy->cooldown_datetime = 250;
+    policy->cooldown_ttl = -1;
+    ExecEnv::GetInstance()->storage_policy_mgr()->_policy_map["test_policy_name"] = policy;
+
+    // 30 scans in the last minute
+    _tablet->_last_record_scan_count_timestamp = time(nullptr) - 60;
+    _tablet->query_scan_count->increment(30);
+    EXPECT_NEAR(30, _tablet->scan_frequency(), 1);
+    // the record of the scans is not moved
+    EXPECT_EQ(0, _tablet->_last_record_scan_count);
+
+    double cooldown_hot_tablet_scan_frequency = config::cooldown_hot_tablet_scan_frequency;
+    for (double frequency : {0.0, 10.0, 50.0}) {
+        config::cooldown_hot_tablet_scan_frequency = frequency;
+        int64_t cooldown_timestamp = -1;
+        size_t file_size = -1;
+        // only a frequency below the scans of the tablet keeps it local
+        EXPECT_EQ(frequency != 10.0, _tablet->need_cooldown(&cooldown_timestamp, &file_size))
+                << frequency;
+    }
+    config::cooldown_hot_tablet_scan_frequency = cooldown_hot_tablet_scan_frequency;
+}
+
 TEST_F(TestTablet, rowset_tree_update) {
     TTabletSchema tschema;
     tschema.keys_type = TKeysType::UNIQUE_KEYS;
@@ -417,4 +456,56 @@ TEST_F(TestTablet, rowset_tree_update) {
                 OLAP_ERR_ROWSET_LOAD_FAILED);
 }
 
+TEST_F(TestTablet, update_tablet_schema) {
+    auto new_column = [](const std::string& name, int32_t unique_id, bool is_key,
+                         bool is_nullable) {
+        TColumn column;
+        column.column_name = name;
+        column.column_type.type = TPrimitiveType::INT;
+        column.__set_is_key(is_key);
+        column.__set_aggregation_type(TAggregationType::REPLACE);
+        column.__set_is_allow_null(is_nullable);
+        column.__set_col_unique_id(unique_id);
+        return column;
+    };
+    TTabletSchema tschema;
+    tschema.keys_type = TKeysType::UNIQUE_KEYS;
+    tschema.short_key_column_count = 1;
+    tschema.columns = {new_column("k1", 0, true, false), new_column("v1", 1, false, true)};
+    TabletMetaSharedPtr tablet_meta = new_tablet_meta(tschema);
+    RowsetMetaSharedPtr rs_meta(new RowsetMeta());
+    init_rs_meta(rs_meta, 0, 1);
+    rs_meta->set_tablet_schema(&tablet_meta->tablet_schema());
+    tablet_meta->add_rs_meta(rs_meta);
+    TabletSharedPtr tablet(new Tablet(tablet_meta, nullptr));
+    EXPECT_EQ(2, tablet->tablet_schema().num_columns());
+
+    // add a nullable column
+    std::vector<TabletColumn> columns = {TabletColumn(new_column("k1", 0, true, false)),
+                                         TabletColumn(new_column("v1", 1, false, true)),
+                                         TabletColumn(new_column("v2", 2, false, true))};
+    EXPECT_TRUE(tablet->update_tablet_schema(columns, 1).ok());
+    EXPECT_EQ(3, tablet->tablet_schema().num_columns());
+    EXPECT_EQ(1, tablet->tablet_schema().schema_version());
+    EXPECT_EQ(2, tablet->tablet_schema().field_index("v2"));
+
+    // a stale schema version is ignored
+    EXPECT_TRUE(tablet->update_tablet_schema({columns[0]}, 1).ok());
+    EXPECT_EQ(3, tablet->tablet_schema().num_columns());
+
+    // drop a column
+    EXPECT_TRUE(tablet->update_tablet_schema({columns[0], columns[2]}, 2).ok());
+    EXPECT_EQ(2, tablet->tablet_schema().num_columns());
+    EXPECT_EQ(-1, tablet->tablet_schema().field_index("v1"));
+
+    // neither the key columns nor the types can change, and an added column needs a default
+    TabletColumn not_null_column(new_column("v3", 3, false, false));
+    EXPECT_FALSE(tablet->update_tablet_schema({columns[0], columns[2], not_null_column}, 3).ok());
+    EXPECT_FALSE(tablet->update_tablet_schema({columns[2]}, 3).ok());
+    TColumn bigint_column = new_column("v2", 2, false, true);
+    bigint_column.column_type.type = TPrimitiveType::BIGINT;
+    EXPECT_FALSE(tablet->update_tablet_schema({columns[0], TabletColumn(bigint_column)}, 3).ok());
+    EXPECT_EQ(2, tablet->tablet_schema().schema_version());
+}
+
 } // namespace doris
@@ -286,6 +286,42 @@ TEST_F(TxnManagerTest, PublishVersionSuccessful) {
     EXPECT_TRUE(rowset_meta->end_version() == 11);
 }
 
+// 1. publish version on several tablets, whose rowset metas are saved in one write
+TEST_F(TxnManagerTest, PublishVersionOfTablets) {
+    TabletUid other_tablet_uid(11, 11);
+    Status status = _txn_mgr->commit_txn(_meta, partition_id, transaction_id, tablet_id,
+                                         schema_hash, _tablet_uid, load_id, _rowset, false);
+    EXPECT_TRUE(status == Status::OK());
+    status = _txn_mgr->commit_txn(_meta, partition_id, transaction_id, tablet_id + 1, schema_hash,
+                                  other_tablet_uid, load_id, _rowset_diff_id, false);
+    EXPECT_TRUE(status == Status::OK());
+
+    Version new_version(10, 10);
+    std::vector<TabletInfo> tablet_infos = {
+            TabletInfo(tablet_id, schema_hash, _tablet_uid),
+            TabletInfo(tablet_id + 1, schema_hash, other_tablet_uid),
+            TabletInfo(tablet_id + 2, schema_hash, _tablet_uid)};
+    std::vector<Status> statuses;
+    _txn_mgr->publish_txn(_meta, partition_id, transaction_id, tablet_infos, new_version,
+                          &statuses);
+    ASSERT_EQ(3U, statuses.size());
+    EXPECT_TRUE(statuses[0].ok());
+    EXPECT_TRUE(statuses[1].ok());
+    // the txn was not committed on the last tablet
+    EXPECT_FALSE(statuses[2].ok());
+
+    RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
+    status = RowsetMetaManager::get_rowset_meta(_meta, _tablet_uid, _rowset->rowset_id(),
+                                                rowset_meta);
+    EXPECT_TRUE(status == Status::OK());
+    EXPECT_EQ(10, rowset_meta->start_version());
+    RowsetMetaSharedPtr other_rowset_meta(new RowsetMeta());
+    status = RowsetMetaManager::get_rowset_meta(_meta, other_tablet_uid,
+                                                _rowset_diff_id->rowset_id(), other_rowset_meta);
+    EXPECT_TRUE(status == Status::OK());
+    EXPECT_EQ(10, other_rowset_meta->start_version());
+}
+
 // 1. publish version failed if not found related txn and rowset
 TEST_F(TxnManagerTest, PublishNotExistedTxn) {
     Version new_version(10, 11);
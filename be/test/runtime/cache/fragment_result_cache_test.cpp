@@ -0,0 +1,130 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/cache/fragment_result_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "common/object_pool.h"
+#include "exec/exec_node.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris {
+
+class FragmentResultCacheTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        if (FragmentResultCache::instance() == nullptr) {
+            FragmentResultCache::create_global_instance(64 << 20);
+        }
+    }
+
+protected:
+    static std::shared_ptr<FragmentResultCache::Entry> create_entry(int64_t version,
+                                                                    int32_t value) {
+        auto column = vectorized::ColumnInt32::create();
+        column->insert_value(value);
+        vectorized::Block block;
+        block.insert({std::move(column), std::make_shared<vectorized::DataTypeInt32>(), "v"});
+
+        auto entry = std::make_shared<FragmentResultCache::Entry>();
+        entry->tablet_versions = {{10001, version}, {10002, version}};
+        entry->bytes = block.allocated_bytes();
+        entry->blocks.push_back(std::move(block));
+        return entry;
+    }
+
+    // The descriptor table of a scan of `k1` and the value column `column`.
+    static TDescriptorTable create_desc_tbl(const std::string& column, int32_t unique_id,
+                                            bool nullable) {
+        TDescriptorTableBuilder builder;
+        TSlotDescriptor key =
+                TSlotDescriptorBuilder().type(TYPE_INT).column_name("k1").column_pos(0).build();
+        key.__set_col_unique_id(0);
+        TSlotDescriptor value = TSlotDescriptorBuilder()
+                                        .type(TYPE_BIGINT)
+                                        .nullable(nullable)
+                                        .column_name(column)
+                                        .column_pos(1)
+                                        .build();
+        value.__set_col_unique_id(unique_id);
+        TTupleDescriptorBuilder().add_slot(key).add_slot(value).build(&builder);
+        return builder.desc_tbl();
+    }
+
+    static std::string scan_digest(const TDescriptorTable& thrift_tbl) {
+        ObjectPool pool;
+        DescriptorTbl* descs = nullptr;
+        EXPECT_TRUE(DescriptorTbl::create(&pool, thrift_tbl, &descs).ok());
+
+        TPlanNode tnode;
+        tnode.node_id = 0;
+        tnode.node_type = TPlanNodeType::OLAP_SCAN_NODE;
+        tnode.num_children = 0;
+        tnode.limit = -1;
+        tnode.row_tuples.push_back(0);
+        tnode.nullable_tuples.push_back(false);
+        tnode.__isset.olap_scan_node = true;
+        tnode.olap_scan_node.tuple_id = 0;
+        tnode.olap_scan_node.key_column_name = {"k1"};
+        tnode.olap_scan_node.key_column_type = {TPrimitiveType::INT};
+        tnode.olap_scan_node.is_preaggregation = true;
+
+        std::string digest;
+        EXPECT_TRUE(ExecNode::compute_plan_digest(tnode, *descs, {}, &digest).ok());
+        return digest;
+    }
+};
+
+TEST_F(FragmentResultCacheTest, LookupAndInsert) {
+    auto* cache = FragmentResultCache::instance();
+    EXPECT_EQ(nullptr, cache->lookup("digest:10001:10002"));
+
+    cache->insert("digest:10001:10002", create_entry(3, 7));
+    auto entry = cache->lookup("digest:10001:10002");
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(3, entry->tablet_versions.at(10001));
+    ASSERT_EQ(1U, entry->blocks.size());
+    EXPECT_EQ(7, entry->blocks[0].get_by_position(0).column->get_int(0));
+    EXPECT_EQ(nullptr, cache->lookup("digest:10001"));
+
+    // the entry of newer versions replaces the old one, which stays valid while it is used
+    cache->insert("digest:10001:10002", create_entry(5, 9));
+    auto new_entry = cache->lookup("digest:10001:10002");
+    ASSERT_NE(nullptr, new_entry);
+    EXPECT_EQ(5, new_entry->tablet_versions.at(10002));
+    EXPECT_EQ(9, new_entry->blocks[0].get_by_position(0).column->get_int(0));
+    EXPECT_EQ(7, entry->blocks[0].get_by_position(0).column->get_int(0));
+}
+
+// The slots of the thrift of two scans of different columns have the same ids, only the
+// descriptor table tells them apart.
+TEST_F(FragmentResultCacheTest, PlanDigestCoversDescriptors) {
+    std::string digest = scan_digest(create_desc_tbl("v1", 1, true));
+    EXPECT_FALSE(digest.empty());
+    EXPECT_EQ(digest, scan_digest(create_desc_tbl("v1", 1, true)));
+
+    EXPECT_NE(digest, scan_digest(create_desc_tbl("v2", 2, true)));
+    // a column dropped and added again under the same name gets a new unique id
+    EXPECT_NE(digest, scan_digest(create_desc_tbl("v1", 2, true)));
+    EXPECT_NE(digest, scan_digest(create_desc_tbl("v1", 1, false)));
+}
+
+} // namespace doris
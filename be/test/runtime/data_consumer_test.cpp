@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/routine_load/data_consumer.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "runtime/routine_load/data_consumer_group.h"
+
+namespace doris {
+
+// the batches only hold placeholders, the messages are never read
+static std::unique_ptr<KafkaMessageBatch> create_batch(size_t size) {
+    auto batch = std::make_unique<KafkaMessageBatch>();
+    batch->resize(size);
+    return batch;
+}
+
+TEST(DataConsumerTest, PutBatch) {
+    BlockingQueue<KafkaMessageBatch*> queue(2);
+    // a partial batch is handed over as it is, and a new batch is started
+    auto batch = create_batch(3);
+    auto* partial_batch = batch.get();
+    EXPECT_TRUE(KafkaDataConsumer::put_batch(&queue, &batch));
+    ASSERT_NE(nullptr, batch);
+    EXPECT_TRUE(batch->empty());
+    EXPECT_NE(partial_batch, batch.get());
+
+    KafkaMessageBatch* received = nullptr;
+    EXPECT_TRUE(queue.blocking_get(&received));
+    EXPECT_EQ(partial_batch, received);
+    EXPECT_EQ(3, received->size());
+    delete received;
+
+    // once the group is done the consumer keeps its batch, which is not committed
+    queue.shutdown();
+    batch = create_batch(2);
+    EXPECT_FALSE(KafkaDataConsumer::put_batch(&queue, &batch));
+    ASSERT_NE(nullptr, batch);
+    EXPECT_EQ(2, batch->size());
+}
+
+TEST(DataConsumerTest, QueueCapacity) {
+    int batch_messages = config::routine_load_consumer_batch_messages;
+    // the queue holds about 500 messages whatever the batch size
+    config::routine_load_consumer_batch_messages = 1;
+    EXPECT_EQ(500, KafkaDataConsumerGroup::queue_capacity());
+    config::routine_load_consumer_batch_messages = 100;
+    EXPECT_EQ(5, KafkaDataConsumerGroup::queue_capacity());
+    config::routine_load_consumer_batch_messages = 1024;
+    EXPECT_EQ(1, KafkaDataConsumerGroup::queue_capacity());
+    config::routine_load_consumer_batch_messages = 0;
+    EXPECT_EQ(500, KafkaDataConsumerGroup::queue_capacity());
+    config::routine_load_consumer_batch_messages = batch_messages;
+}
+
+} // namespace doris
@@ -148,4 +148,35 @@ TEST_F(FragmentMgrTest, OfferPoolFailed) {
     EXPECT_EQ(3, s_abort_cnt);
 }
 
+TEST_F(FragmentMgrTest, FragmentTemplates) {
+    FragmentMgr mgr(nullptr);
+    std::vector<TExecPlanFragmentParams> params_list(3);
+    params_list[0].fragment.plan.nodes.resize(1);
+    params_list[0].fragment.plan.nodes[0].node_id = 7;
+    params_list[0].__isset.fragment = true;
+    // the second omits the fragment sent before it in the same request, the third has no digest
+    params_list[0].__set_fragment_digest("digest");
+    params_list[1].__set_fragment_digest("digest");
+    std::vector<std::string> cached_digests;
+    std::vector<std::string> missing_digests;
+    EXPECT_TRUE(
+            mgr.resolve_fragment_templates(&params_list, &cached_digests, &missing_digests).ok());
+    EXPECT_EQ(cached_digests, std::vector<std::string> {"digest"});
+    EXPECT_TRUE(missing_digests.empty());
+    EXPECT_TRUE(params_list[1].__isset.fragment);
+    EXPECT_EQ(params_list[1].fragment.plan.nodes[0].node_id, 7);
+    EXPECT_FALSE(params_list[2].__isset.fragment);
+
+    // a later request omits the fragment of an unknown digest
+    std::vector<TExecPlanFragmentParams> later(2);
+    later[0].__set_fragment_digest("digest");
+    later[1].__set_fragment_digest("unknown");
+    cached_digests.clear();
+    Status st = mgr.resolve_fragment_templates(&later, &cached_digests, &missing_digests);
+    EXPECT_TRUE(st.is_not_found());
+    EXPECT_TRUE(cached_digests.empty());
+    EXPECT_EQ(missing_digests, std::vector<std::string> {"unknown"});
+    EXPECT_EQ(later[0].fragment.plan.nodes[0].node_id, 7);
+}
+
 } // namespace doris
@@ -0,0 +1,280 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/stream_load/group_commit_mgr.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "common/config.h"
+#include "gen_cpp/FrontendService_types.h"
+#include "gen_cpp/HeartbeatService_types.h"
+#include "runtime/exec_env.h"
+#include "runtime/message_body_sink.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "runtime/stream_load/stream_load_executor.h"
+
+namespace doris {
+
+extern TLoadTxnCommitResult k_stream_load_commit_result;
+extern TLoadTxnRollbackResult k_stream_load_rollback_result;
+
+namespace {
+
+// the sink of the shared load of a group, which keeps the data and finishes the load
+class CollectingSink : public MessageBodySink {
+public:
+    CollectingSink(StreamLoadContext* ctx) : _ctx(ctx) {}
+
+    Status append(const char* data, size_t size) override {
+        std::lock_guard<std::mutex> l(_lock);
+        _data.append(data, size);
+        return Status::OK();
+    }
+    Status finish() override {
+        _finished = true;
+        _ctx->promise.set_value(Status::OK());
+        return Status::OK();
+    }
+    void cancel(const std::string& reason) override { _cancelled = true; }
+
+    std::string data() {
+        std::lock_guard<std::mutex> l(_lock);
+        return _data;
+    }
+
+private:
+    StreamLoadContext* _ctx;
+    std::mutex _lock;
+    std::string _data;
+};
+
+} // namespace
+
+class GroupCommitMgrTest : public testing::Test {
+public:
+    void SetUp() override {
+        k_stream_load_commit_result = TLoadTxnCommitResult();
+        k_stream_load_rollback_result = TLoadTxnRollbackResult();
+        _env._master_info = new TMasterInfo();
+        _env._load_stream_mgr = new LoadStreamMgr();
+        _env._stream_load_executor = new StreamLoadExecutor(&_env);
+        _mgr.reset(new GroupCommitMgr(&_env));
+
+        _saved_interval_ms = config::group_commit_interval_ms;
+        _saved_data_bytes = config::group_commit_data_bytes;
+        _saved_label_keep_second = config::group_commit_label_keep_max_second;
+        config::group_commit_interval_ms = 300;
+    }
+
+    void TearDown() override {
+        config::group_commit_interval_ms = _saved_interval_ms;
+        config::group_commit_data_bytes = _saved_data_bytes;
+        config::group_commit_label_keep_max_second = _saved_label_keep_second;
+        _mgr.reset();
+        delete _env._stream_load_executor;
+        _env._stream_load_executor = nullptr;
+        delete _env._load_stream_mgr;
+        _env._load_stream_mgr = nullptr;
+        delete _env._master_info;
+        _env._master_info = nullptr;
+    }
+
+protected:
+    std::unique_ptr<StreamLoadContext> make_ctx(const std::string& label,
+                                                const std::string& db = "db") {
+        std::unique_ptr<StreamLoadContext> ctx(new StreamLoadContext(&_env));
+        ctx->load_type = TLoadType::MANUL_LOAD;
+        ctx->db = db;
+        ctx->table = "tbl";
+        ctx->label = label;
+        return ctx;
+    }
+
+    // plan the shared load of a group, which fails with 'plan_status' if it's set
+    Status plan(StreamLoadContext* group_ctx) {
+        std::lock_guard<std::mutex> l(_lock);
+        if (!_plan_status.ok()) {
+            return _plan_status;
+        }
+        auto sink = std::make_shared<CollectingSink>(group_ctx);
+        group_ctx->body_sink = sink;
+        group_ctx->txn_id = _sinks.size() + 1;
+        group_ctx->need_rollback = true;
+        _sinks.push_back(sink);
+        return Status::OK();
+    }
+
+    Status group_commit(StreamLoadContext* ctx, const std::string& body,
+                        const std::string& key = "key") {
+        auto data = ByteBuffer::allocate(body.size());
+        data->put_bytes(body.data(), body.size());
+        data->flip();
+        return _mgr->group_commit(ctx, key, data,
+                                  [this](StreamLoadContext* group_ctx) { return plan(group_ctx); });
+    }
+
+    size_t plans() {
+        std::lock_guard<std::mutex> l(_lock);
+        return _sinks.size();
+    }
+
+    ExecEnv _env;
+    std::unique_ptr<GroupCommitMgr> _mgr;
+    std::mutex _lock;
+    Status _plan_status;
+    std::vector<std::shared_ptr<CollectingSink>> _sinks;
+
+    int32_t _saved_interval_ms;
+    int64_t _saved_data_bytes;
+    int32_t _saved_label_keep_second;
+};
+
+TEST_F(GroupCommitMgrTest, loads_of_a_key_share_a_group) {
+    config::group_commit_interval_ms = 1000;
+    std::vector<std::unique_ptr<StreamLoadContext>> ctxs;
+    std::vector<Status> statuses(5);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 5; ++i) {
+        ctxs.push_back(make_ctx("label_" + std::to_string(i)));
+    }
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i]() {
+            statuses[i] = group_commit(ctxs[i].get(), std::to_string(i) + "\n");
+        });
+    }
+    // another key makes another group
+    threads.emplace_back([&]() { statuses[4] = group_commit(ctxs[4].get(), "4\n", "other"); });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(2, plans());
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(statuses[i].ok()) << statuses[i].to_string();
+        EXPECT_FALSE(ctxs[i]->group_commit_label.empty());
+    }
+    for (int i = 1; i < 4; ++i) {
+        EXPECT_EQ(ctxs[0]->group_commit_label, ctxs[i]->group_commit_label);
+        EXPECT_EQ(ctxs[0]->txn_id, ctxs[i]->txn_id);
+    }
+    EXPECT_NE(ctxs[0]->group_commit_label, ctxs[4]->group_commit_label);
+
+    // the data of all the loads of a group is sent to its load
+    std::string data = _sinks[0]->data() + _sinks[1]->data();
+    std::sort(data.begin(), data.end());
+    EXPECT_EQ("\n\n\n\n\n01234", data);
+    EXPECT_TRUE(_sinks[0]->finished());
+    EXPECT_TRUE(_sinks[1]->finished());
+}
+
+TEST_F(GroupCommitMgrTest, group_committed_after_interval_or_enough_data) {
+    config::group_commit_interval_ms = 200;
+    auto first = make_ctx("first");
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(group_commit(first.get(), "a\n").ok());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(200));
+
+    // the closed group takes no more loads
+    auto second = make_ctx("second");
+    ASSERT_TRUE(group_commit(second.get(), "b\n").ok());
+    EXPECT_EQ(2, plans());
+    EXPECT_NE(first->group_commit_label, second->group_commit_label);
+    EXPECT_EQ("a\n", _sinks[0]->data());
+    EXPECT_EQ("b\n", _sinks[1]->data());
+
+    // a group with enough data doesn't wait for the interval
+    config::group_commit_interval_ms = 60 * 1000;
+    config::group_commit_data_bytes = 4;
+    auto third = make_ctx("third");
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(group_commit(third.get(), "cccc\n").ok());
+    elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::seconds(30));
+    EXPECT_EQ(3, plans());
+}
+
+TEST_F(GroupCommitMgrTest, failed_group_fails_all_its_loads) {
+    _plan_status = Status::InternalError("plan failed");
+    auto first = make_ctx("first");
+    auto second = make_ctx("second");
+    Status second_status;
+    std::thread thread([&]() { second_status = group_commit(second.get(), "b\n"); });
+    Status first_status = group_commit(first.get(), "a\n");
+    thread.join();
+    EXPECT_EQ(TStatusCode::INTERNAL_ERROR, first_status.code());
+    EXPECT_EQ(TStatusCode::INTERNAL_ERROR, second_status.code());
+
+    // the commit of the txn fails
+    _plan_status = Status::OK();
+    Status::InternalError("commit failed").to_thrift(&k_stream_load_commit_result.status);
+    auto third = make_ctx("third");
+    EXPECT_EQ(TStatusCode::INTERNAL_ERROR, group_commit(third.get(), "c\n").code());
+    ASSERT_EQ(1, plans());
+    EXPECT_TRUE(_sinks[0]->finished());
+
+    // the labels of the failed loads can be used again
+    k_stream_load_commit_result = TLoadTxnCommitResult();
+    for (auto& label : {"first", "second", "third"}) {
+        auto retry = make_ctx(label);
+        EXPECT_TRUE(group_commit(retry.get(), "d\n").ok()) << label;
+    }
+}
+
+TEST_F(GroupCommitMgrTest, duplicate_labels) {
+    config::group_commit_interval_ms = 500;
+    auto running = make_ctx("label");
+    Status running_status;
+    std::thread thread([&]() { running_status = group_commit(running.get(), "a\n"); });
+    while (plans() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    auto duplicate = make_ctx("label");
+    Status st = group_commit(duplicate.get(), "b\n");
+    EXPECT_EQ(TStatusCode::LABEL_ALREADY_EXISTS, st.code());
+    EXPECT_EQ("RUNNING", duplicate->existing_job_status);
+    thread.join();
+    ASSERT_TRUE(running_status.ok());
+
+    config::group_commit_interval_ms = 10;
+    duplicate = make_ctx("label");
+    st = group_commit(duplicate.get(), "b\n");
+    EXPECT_EQ(TStatusCode::LABEL_ALREADY_EXISTS, st.code());
+    EXPECT_EQ("FINISHED", duplicate->existing_job_status);
+    // the data of the duplicate is not loaded
+    ASSERT_EQ(1, plans());
+    EXPECT_EQ("a\n", _sinks[0]->data());
+
+    // the labels are by db
+    auto other_db = make_ctx("label", "other_db");
+    EXPECT_TRUE(group_commit(other_db.get(), "c\n").ok());
+
+    // the labels of the committed loads expire
+    config::group_commit_label_keep_max_second = 0;
+    auto first = make_ctx("expired");
+    EXPECT_TRUE(group_commit(first.get(), "d\n").ok());
+    auto second = make_ctx("expired");
+    EXPECT_TRUE(group_commit(second.get(), "e\n").ok());
+}
+
+} // namespace doris
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/mem_arbiter.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace doris {
+
+TEST(MemArbiterTest, pressure_of) {
+    config::process_soft_mem_limit_percent = 80;
+    config::process_admission_mem_limit_percent = 90;
+    EXPECT_EQ(MemArbiter::NONE, MemArbiter::pressure_of(700, 1000));
+    EXPECT_EQ(MemArbiter::SPILL, MemArbiter::pressure_of(800, 1000));
+    EXPECT_EQ(MemArbiter::SPILL, MemArbiter::pressure_of(899, 1000));
+    EXPECT_EQ(MemArbiter::ADMISSION, MemArbiter::pressure_of(900, 1000));
+    EXPECT_EQ(MemArbiter::ADMISSION, MemArbiter::pressure_of(2000, 1000));
+    EXPECT_EQ(MemArbiter::NONE, MemArbiter::pressure_of(2000, -1));
+
+    config::process_admission_mem_limit_percent = 0;
+    EXPECT_EQ(MemArbiter::SPILL, MemArbiter::pressure_of(2000, 1000));
+
+    config::process_soft_mem_limit_percent = 0;
+    EXPECT_EQ(MemArbiter::NONE, MemArbiter::pressure_of(2000, 1000));
+
+    config::process_soft_mem_limit_percent = 80;
+    config::process_admission_mem_limit_percent = 90;
+}
+
+TEST(MemArbiterTest, admission) {
+    EXPECT_TRUE(MemArbiter::check_admission().ok());
+
+    MemArbiter::_s_pressure = MemArbiter::SPILL;
+    EXPECT_TRUE(MemArbiter::check_admission().ok());
+
+    MemArbiter::_s_pressure = MemArbiter::ADMISSION;
+    auto st = MemArbiter::check_admission();
+    EXPECT_EQ(TStatusCode::TOO_MANY_TASKS, st.code()) << st;
+
+    MemArbiter::_s_pressure = MemArbiter::NONE;
+}
+
+} // namespace doris
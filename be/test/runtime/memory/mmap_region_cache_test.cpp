@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/mmap_region_cache.h"
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+
+#include "common/config.h"
+
+namespace doris {
+
+static void* map(size_t size) {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    EXPECT_NE(MAP_FAILED, ptr);
+    return ptr;
+}
+
+TEST(MmapRegionCacheTest, normal) {
+    config::mmap_region_cache_capacity_bytes = 3 * 4096;
+    MmapRegionCache cache;
+    EXPECT_EQ(nullptr, cache.get(4096));
+
+    void* region = map(4096);
+    void* large_region = map(2 * 4096);
+    EXPECT_TRUE(cache.put(region, 4096));
+    EXPECT_TRUE(cache.put(large_region, 2 * 4096));
+    EXPECT_EQ(3 * 4096, cache.cached_bytes());
+
+    // full
+    void* other_region = map(4096);
+    EXPECT_FALSE(cache.put(other_region, 4096));
+    munmap(other_region, 4096);
+
+    // only the regions of the same size are reused
+    EXPECT_EQ(nullptr, cache.get(3 * 4096));
+    EXPECT_EQ(region, cache.get(4096));
+    EXPECT_EQ(nullptr, cache.get(4096));
+    EXPECT_EQ(2 * 4096, cache.cached_bytes());
+
+    EXPECT_TRUE(cache.put(region, 4096));
+    EXPECT_EQ(3 * 4096, cache.clear());
+    EXPECT_EQ(0, cache.cached_bytes());
+    EXPECT_EQ(nullptr, cache.get(2 * 4096));
+    config::mmap_region_cache_capacity_bytes = 1073741824;
+}
+
+} // namespace doris
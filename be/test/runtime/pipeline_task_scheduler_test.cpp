@@ -0,0 +1,194 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/pipeline_task_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "common/config.h"
+#include "runtime/pipeline_task.h"
+#include "util/countdown_latch.h"
+
+namespace doris {
+
+// A task running 'num_blocks' blocks without a fragment, the steps call the given functions.
+class FakePipelineTask : public PipelineTask {
+public:
+    FakePipelineTask(int num_blocks, CountDownLatch* finished, std::function<bool()> can_start = {})
+            : PipelineTask(nullptr, std::move(can_start),
+                           [finished](PipelineTask*) { finished->count_down(); }),
+              _num_blocks(num_blocks) {}
+
+    std::function<Status()> open_func;
+    std::function<bool()> blocked_func;
+    std::atomic<int> num_executed_blocks {0};
+    std::atomic<bool>* closed = nullptr;
+
+protected:
+    Status _open_fragment() override { return open_func ? open_func() : Status::OK(); }
+
+    Status _execute_fragment(bool* eos) override {
+        *eos = ++num_executed_blocks >= _num_blocks;
+        return Status::OK();
+    }
+
+    bool _is_fragment_blocked() override { return blocked_func && blocked_func(); }
+
+    void _close_fragment() override {
+        if (closed != nullptr) {
+            *closed = true;
+        }
+    }
+
+private:
+    const int _num_blocks;
+};
+
+class PipelineTaskSchedulerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _time_slice_ms = config::pipeline_task_time_slice_ms;
+        config::pipeline_task_time_slice_ms = 1;
+    }
+
+    void TearDown() override { config::pipeline_task_time_slice_ms = _time_slice_ms; }
+
+private:
+    int64_t _time_slice_ms;
+};
+
+TEST_F(PipelineTaskSchedulerTest, execute) {
+    PipelineTaskScheduler scheduler(2, 2);
+    ASSERT_TRUE(scheduler.start().ok());
+
+    CountDownLatch finished(10);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(scheduler.submit(std::make_unique<FakePipelineTask>(100, &finished)).ok());
+    }
+    EXPECT_TRUE(finished.wait_for(std::chrono::seconds(10)));
+
+    scheduler.shutdown();
+    EXPECT_FALSE(scheduler.submit(std::make_unique<FakePipelineTask>(1, &finished)).ok());
+}
+
+TEST_F(PipelineTaskSchedulerTest, open_does_not_hold_worker) {
+    // With a single worker, the first task can only be opened once the second one has run,
+    // which needs the worker while the first task is opening.
+    PipelineTaskScheduler scheduler(1, 2);
+    ASSERT_TRUE(scheduler.start().ok());
+
+    CountDownLatch finished(2);
+    CountDownLatch second_executed(1);
+    auto waiting_task = std::make_unique<FakePipelineTask>(1, &finished);
+    waiting_task->open_func = [&]() {
+        EXPECT_TRUE(second_executed.wait_for(std::chrono::seconds(10)));
+        return Status::OK();
+    };
+    auto task = std::make_unique<FakePipelineTask>(1, &finished);
+    task->blocked_func = [&]() {
+        second_executed.count_down();
+        return false;
+    };
+    EXPECT_TRUE(scheduler.submit(std::move(waiting_task)).ok());
+    EXPECT_TRUE(scheduler.submit(std::move(task)).ok());
+    EXPECT_TRUE(finished.wait_for(std::chrono::seconds(10)));
+}
+
+TEST_F(PipelineTaskSchedulerTest, open_failure) {
+    PipelineTaskScheduler scheduler(1, 1);
+    ASSERT_TRUE(scheduler.start().ok());
+
+    CountDownLatch finished(1);
+    std::atomic<bool> closed {false};
+    auto task = std::make_unique<FakePipelineTask>(1, &finished);
+    task->open_func = []() { return Status::InternalError("open failed"); };
+    task->closed = &closed;
+    EXPECT_TRUE(scheduler.submit(std::move(task)).ok());
+    EXPECT_TRUE(finished.wait_for(std::chrono::seconds(10)));
+    EXPECT_TRUE(closed);
+}
+
+TEST_F(PipelineTaskSchedulerTest, blocked_task) {
+    PipelineTaskScheduler scheduler(1, 1);
+    ASSERT_TRUE(scheduler.start().ok());
+
+    std::atomic<bool> blocked {true};
+    std::atomic<int> num_checks {0};
+    CountDownLatch finished(1);
+    auto task = std::make_unique<FakePipelineTask>(1, &finished);
+    task->blocked_func = [&]() {
+        ++num_checks;
+        return blocked.load();
+    };
+    EXPECT_TRUE(scheduler.submit(std::move(task)).ok());
+
+    // The poller backs off while the task stays blocked.
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_FALSE(finished.wait_for(std::chrono::milliseconds(0)));
+    EXPECT_LT(num_checks, 200);
+
+    blocked = false;
+    EXPECT_TRUE(finished.wait_for(std::chrono::seconds(10)));
+}
+
+TEST_F(PipelineTaskSchedulerTest, can_start) {
+    PipelineTaskScheduler scheduler(1, 1);
+    ASSERT_TRUE(scheduler.start().ok());
+
+    std::atomic<bool> started {false};
+    std::atomic<bool> opened {false};
+    CountDownLatch finished(1);
+    auto task = std::make_unique<FakePipelineTask>(1, &finished, [&]() { return started.load(); });
+    task->open_func = [&]() {
+        opened = true;
+        return Status::OK();
+    };
+    EXPECT_TRUE(scheduler.submit(std::move(task)).ok());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(opened);
+    started = true;
+    EXPECT_TRUE(finished.wait_for(std::chrono::seconds(10)));
+    EXPECT_TRUE(opened);
+}
+
+TEST_F(PipelineTaskSchedulerTest, time_slice) {
+    // The endless task yields its single worker at the end of each slice, so the other task
+    // still runs.
+    PipelineTaskScheduler scheduler(1, 1);
+    ASSERT_TRUE(scheduler.start().ok());
+
+    CountDownLatch endless_finished(1);
+    CountDownLatch finished(1);
+    auto endless_task = std::make_unique<FakePipelineTask>(INT32_MAX, &endless_finished);
+    auto raw_endless_task = endless_task.get();
+    EXPECT_TRUE(scheduler.submit(std::move(endless_task)).ok());
+    EXPECT_TRUE(scheduler.submit(std::make_unique<FakePipelineTask>(1, &finished)).ok());
+
+    EXPECT_TRUE(finished.wait_for(std::chrono::seconds(10)));
+    EXPECT_GT(raw_endless_task->num_executed_blocks, 0);
+    EXPECT_FALSE(endless_finished.wait_for(std::chrono::milliseconds(0)));
+    // The unfinished task is dropped.
+    scheduler.shutdown();
+}
+
+} // namespace doris
@@ -17,10 +17,19 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
+#include "common/config.h"
+#include "gen_cpp/HeartbeatService_types.h"
+#include "runtime/client_cache.h"
 #include "runtime/exec_env.h"
 #include "util/cpu_info.h"
+#include "util/storage_backend.h"
+#include "util/thrift_rpc_helper.h"
 
 #define private public // hack compiler
 #define protected public
@@ -37,6 +46,142 @@ private:
     ExecEnv* _exec_env;
 };
 
+// A remote storage keeping the uploaded files in memory, and counting the uploads running at the
+// same time.
+class MockStorageBackend : public StorageBackend {
+public:
+    Status download(const std::string& remote, const std::string& local) override {
+        return Status::NotSupported("download");
+    }
+    Status direct_download(const std::string& remote, std::string* content) override {
+        return Status::NotSupported("direct_download");
+    }
+    Status upload(const std::string& local, const std::string& remote) override {
+        return Status::NotSupported("upload");
+    }
+    Status upload_with_checksum(const std::string& local, const std::string& remote,
+                                const std::string& checksum) override {
+        int running = ++_running;
+        int max_running = _max_running.load();
+        while (running > max_running && !_max_running.compare_exchange_weak(max_running, running)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        --_running;
+        std::lock_guard<std::mutex> l(_lock);
+        if (remote.find(_failed_path) != std::string::npos) {
+            return Status::InternalError("failed to upload {}", remote);
+        }
+        _files[remote] = checksum;
+        ++_num_uploads;
+        return Status::OK();
+    }
+    Status list(const std::string& remote_path, bool contain_md5, bool recursion,
+                std::map<std::string, FileStat>* files) override {
+        std::lock_guard<std::mutex> l(_lock);
+        for (auto& [path, checksum] : _files) {
+            if (path.rfind(remote_path + "/", 0) == 0) {
+                std::string name = path.substr(remote_path.size() + 1);
+                files->emplace(name, FileStat {name, checksum, 0});
+            }
+        }
+        return Status::OK();
+    }
+    Status rename(const std::string& orig_name, const std::string& new_name) override {
+        return Status::NotSupported("rename");
+    }
+    Status rename_dir(const std::string& orig_name, const std::string& new_name) override {
+        return Status::NotSupported("rename_dir");
+    }
+    Status direct_upload(const std::string& remote, const std::string& content) override {
+        return Status::NotSupported("direct_upload");
+    }
+    Status copy(const std::string& src, const std::string& dst) override {
+        return Status::NotSupported("copy");
+    }
+    Status copy_dir(const std::string& src, const std::string& dst) override {
+        return Status::NotSupported("copy_dir");
+    }
+    Status rm(const std::string& remote) override { return Status::NotSupported("rm"); }
+    Status rmdir(const std::string& remote) override { return Status::NotSupported("rmdir"); }
+    Status mkdir(const std::string& path) override { return Status::NotSupported("mkdir"); }
+    Status mkdirs(const std::string& path) override { return Status::NotSupported("mkdirs"); }
+    Status exist(const std::string& path) override { return Status::NotSupported("exist"); }
+    Status exist_dir(const std::string& path) override {
+        return Status::NotSupported("exist_dir");
+    }
+
+    std::mutex _lock;
+    // the remote path and the checksum of the uploaded files
+    std::map<std::string, std::string> _files;
+    int _num_uploads = 0;
+    // the uploads of the files under this path fail
+    std::string _failed_path = "no failure";
+    std::atomic<int> _running {0};
+    std::atomic<int> _max_running {0};
+};
+
+TEST_F(SnapshotLoaderTest, ParallelUpload) {
+    // the reports to the frontend fail to connect, and are ignored
+    ExecEnv env;
+    env._master_info = new TMasterInfo();
+    env._master_info->network_address.hostname = "127.0.0.1";
+    env._master_info->network_address.port = 1;
+    env._frontend_client_cache = new FrontendServiceClientCache(1);
+    ExecEnv* rpc_exec_env = ThriftRpcHelper::_s_exec_env;
+    ThriftRpcHelper::setup(&env);
+    int32_t snapshot_transfer_threads = config::snapshot_transfer_threads;
+    config::snapshot_transfer_threads = 4;
+
+    // 8 tablets of 3 files each
+    const std::string root_path = "./ss_upload_test";
+    std::filesystem::remove_all(root_path);
+    std::map<std::string, std::string> src_to_dest;
+    for (int64_t tablet_id = 10; tablet_id < 18; ++tablet_id) {
+        std::string src_path = root_path + "/" + std::to_string(tablet_id) + "/1111";
+        std::filesystem::create_directories(src_path);
+        for (const std::string& name : {std::to_string(tablet_id) + ".hdr", "0_0.dat", "1_0.dat"}) {
+            std::ofstream(src_path + "/" + name) << name << tablet_id;
+        }
+        src_to_dest[src_path] = "remote/" + std::to_string(tablet_id);
+    }
+
+    auto* backend = new MockStorageBackend();
+    SnapshotLoader loader(&env, 1L, 2L);
+    loader._storage_backend.reset(backend);
+    std::map<int64_t, std::vector<std::string>> tablet_files;
+    Status st = loader.upload(src_to_dest, &tablet_files);
+    EXPECT_TRUE(st.ok()) << st;
+    EXPECT_EQ(8, tablet_files.size());
+    for (auto& [tablet_id, files] : tablet_files) {
+        EXPECT_EQ(3, files.size()) << tablet_id;
+    }
+    EXPECT_EQ(24, backend->_num_uploads);
+    EXPECT_EQ(24, backend->_files.size());
+    EXPECT_GT(backend->_max_running.load(), 1);
+    EXPECT_LE(backend->_max_running.load(), 4);
+
+    // the upload of a task retried skips the files already uploaded
+    tablet_files.clear();
+    st = loader.upload(src_to_dest, &tablet_files);
+    EXPECT_TRUE(st.ok()) << st;
+    EXPECT_EQ(8, tablet_files.size());
+    EXPECT_EQ(24, backend->_num_uploads);
+
+    // the failure of a tablet fails the task
+    backend->_files.clear();
+    backend->_failed_path = "remote/13/";
+    tablet_files.clear();
+    st = loader.upload(src_to_dest, &tablet_files);
+    EXPECT_FALSE(st.ok());
+    EXPECT_EQ(0, tablet_files.count(13));
+
+    std::filesystem::remove_all(root_path);
+    config::snapshot_transfer_threads = snapshot_transfer_threads;
+    ThriftRpcHelper::setup(rpc_exec_env);
+    SAFE_DELETE(env._frontend_client_cache);
+    SAFE_DELETE(env._master_info);
+}
+
 TEST_F(SnapshotLoaderTest, NormalCase) {
     SnapshotLoader loader(_exec_env, 1L, 2L);
 
@@ -199,6 +199,33 @@ TEST_F(StreamLoadPipeTest, append_mix) {
     t1.join();
 }
 
+TEST_F(StreamLoadPipeTest, read_chunk) {
+    StreamLoadPipe pipe(66, 64);
+
+    auto byte_buf = ByteBuffer::allocate(64);
+    byte_buf->put_bytes("0123456789", 10);
+    byte_buf->flip();
+    EXPECT_TRUE(pipe.append(byte_buf).ok());
+    EXPECT_TRUE(pipe.finish().ok());
+
+    // the bytes read are not copied again
+    char buf[4];
+    int64_t read_bytes = 0;
+    bool eof = false;
+    EXPECT_TRUE(pipe.read((uint8_t*)buf, 4, &read_bytes, &eof).ok());
+    EXPECT_EQ(4, read_bytes);
+
+    ByteBufferPtr chunk;
+    EXPECT_TRUE(pipe.read_chunk(&chunk, &eof).ok());
+    EXPECT_FALSE(eof);
+    EXPECT_EQ(byte_buf.get(), chunk.get());
+    EXPECT_EQ("456789", std::string(chunk->ptr + chunk->pos, chunk->remaining()));
+
+    EXPECT_TRUE(pipe.read_chunk(&chunk, &eof).ok());
+    EXPECT_TRUE(eof);
+    EXPECT_EQ(nullptr, chunk);
+}
+
 TEST_F(StreamLoadPipeTest, cancel) {
     StreamLoadPipe pipe(66, 64);
 
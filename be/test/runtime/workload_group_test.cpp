@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/workload_group.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/memory/mem_tracker_limiter.h"
+
+namespace doris {
+
+TEST(WorkloadGroupTest, parse) {
+    std::vector<WorkloadGroup::Conf> confs;
+    EXPECT_TRUE(WorkloadGroupMgr::parse("", &confs).ok());
+    EXPECT_TRUE(confs.empty());
+
+    std::string groups = "interactive:cpu_share=2048,mem_limit=30%,max_concurrency=20;batch:";
+    EXPECT_TRUE(WorkloadGroupMgr::parse(groups, &confs).ok());
+    ASSERT_EQ(2, confs.size());
+    EXPECT_EQ("interactive", confs[0].name);
+    EXPECT_EQ(2048, confs[0].cpu_share);
+    EXPECT_EQ("30%", confs[0].mem_limit);
+    EXPECT_EQ(20, confs[0].max_concurrency);
+    EXPECT_EQ("batch", confs[1].name);
+    EXPECT_EQ(1024, confs[1].cpu_share);
+    EXPECT_EQ("-1", confs[1].mem_limit);
+    EXPECT_EQ(0, confs[1].max_concurrency);
+
+    for (auto groups : {"batch", ":cpu_share=1", "batch:cpu_share", "batch:cpu_share=0",
+                        "batch:cpu_share=x", "batch:max_concurrency=-1", "batch:cpu=1"}) {
+        confs.clear();
+        EXPECT_FALSE(WorkloadGroupMgr::parse(groups, &confs).ok()) << groups;
+    }
+}
+
+TEST(WorkloadGroupTest, query_slots) {
+    WorkloadGroup::Conf conf;
+    conf.name = "batch";
+    conf.max_concurrency = 2;
+    WorkloadGroup group(-1, conf, -1, nullptr);
+    EXPECT_EQ("batch", group.name());
+    EXPECT_FALSE(group.mem_tracker()->has_limit());
+
+    EXPECT_TRUE(group.try_acquire_query_slot().ok());
+    EXPECT_TRUE(group.try_acquire_query_slot().ok());
+    auto st = group.try_acquire_query_slot();
+    EXPECT_EQ(TStatusCode::TOO_MANY_TASKS, st.code()) << st;
+
+    group.release_query_slot();
+    EXPECT_TRUE(group.try_acquire_query_slot().ok());
+    group.release_query_slot();
+    group.release_query_slot();
+
+    // no limit
+    conf.max_concurrency = 0;
+    WorkloadGroup unlimited(-2, conf, -1, nullptr);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(unlimited.try_acquire_query_slot().ok());
+    }
+}
+
+} // namespace doris
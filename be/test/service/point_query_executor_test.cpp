@@ -0,0 +1,239 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "service/point_query_executor.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <numeric>
+#include <string>
+
+#include "gen_cpp/Descriptors_types.h"
+#include "olap/delta_writer.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet.h"
+#include "olap/tablet_manager.h"
+#include "olap/txn_manager.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "util/file_utils.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+static const int64_t kTabletId = 10100;
+static const int32_t kSchemaHash = 270068379;
+static const int64_t kPartitionId = 30100;
+
+static StorageEngine* k_engine = nullptr;
+
+class PointQueryExecutorTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        config::min_file_descriptor_number = 100;
+        char buffer[1024];
+        EXPECT_NE(getcwd(buffer, sizeof(buffer)), nullptr);
+        config::storage_root_path = std::string(buffer) + "/point_query_test";
+        FileUtils::remove_all(config::storage_root_path);
+        FileUtils::create_dir(config::storage_root_path);
+        doris::EngineOptions options;
+        options.store_paths.emplace_back(config::storage_root_path, -1);
+        Status st = doris::StorageEngine::open(options, &k_engine);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        ExecEnv::GetInstance()->set_storage_engine(k_engine);
+
+        // a unique key tablet (k1 INT, v1 INT, v2 INT) with merge-on-write
+        TCreateTabletReq request;
+        request.tablet_id = kTabletId;
+        request.__set_version(1);
+        request.tablet_schema.schema_hash = kSchemaHash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::UNIQUE_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+        request.__set_storage_format(TStorageFormat::V2);
+        request.__set_enable_unique_key_merge_on_write(true);
+        for (const char* name : {"k1", "v1", "v2"}) {
+            TColumn column;
+            column.column_name = name;
+            column.__set_is_key(std::string(name) == "k1");
+            column.column_type.type = TPrimitiveType::INT;
+            if (!column.is_key) {
+                column.__set_aggregation_type(TAggregationType::REPLACE);
+            }
+            request.tablet_schema.columns.push_back(column);
+        }
+        st = k_engine->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+
+        // version 2, then version 3 which updates the key 1
+        _load(20100, {{1, 10, 100}, {2, 20, 200}});
+        _load(20101, {{1, 11, 111}, {3, 30, 300}});
+    }
+
+    static void TearDownTestSuite() {
+        if (k_engine != nullptr) {
+            static_cast<void>(k_engine->tablet_manager()->drop_tablet(kTabletId, 0));
+            k_engine->stop();
+            delete k_engine;
+            k_engine = nullptr;
+        }
+        FileUtils::remove_all(config::storage_root_path);
+    }
+
+protected:
+    // Loads the rows (k1, v1, v2) in a new version.
+    static void _load(int64_t txn_id, const std::vector<std::vector<int32_t>>& rows) {
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        int column_pos = 0;
+        for (const char* name : {"k1", "v1", "v2"}) {
+            tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                           .type(TYPE_INT)
+                                           .nullable(false)
+                                           .column_name(name)
+                                           .column_pos(column_pos++)
+                                           .build());
+        }
+        tuple_builder.build(&dtb);
+        ObjectPool obj_pool;
+        DescriptorTbl* desc_tbl = nullptr;
+        DescriptorTbl::create(&obj_pool, dtb.desc_tbl(), &desc_tbl);
+        TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+
+        vectorized::Block block;
+        for (const auto& slot_desc : tuple_desc->slots()) {
+            block.insert(vectorized::ColumnWithTypeAndName(slot_desc->get_empty_mutable_column(),
+                                                           slot_desc->get_data_type_ptr(),
+                                                           slot_desc->col_name()));
+        }
+        auto columns = block.mutate_columns();
+        for (const auto& row : rows) {
+            for (size_t i = 0; i < row.size(); ++i) {
+                columns[i]->insert_data((const char*)&row[i], sizeof(row[i]));
+            }
+        }
+        block.set_columns(std::move(columns));
+
+        PUniqueId load_id;
+        load_id.set_hi(0);
+        load_id.set_lo(txn_id);
+        WriteRequest write_req = {kTabletId,  kSchemaHash,  WriteType::LOAD,
+                                  txn_id,     kPartitionId, load_id,
+                                  tuple_desc, &tuple_desc->slots()};
+        DeltaWriter* delta_writer = nullptr;
+        DeltaWriter::open(&write_req, &delta_writer, true);
+        ASSERT_NE(delta_writer, nullptr);
+        std::vector<int> row_idxs(rows.size());
+        std::iota(row_idxs.begin(), row_idxs.end(), 0);
+        ASSERT_TRUE(delta_writer->write(&block, row_idxs).ok());
+        ASSERT_TRUE(delta_writer->close().ok());
+        ASSERT_TRUE(delta_writer->close_wait().ok());
+        delete delta_writer;
+
+        TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(kTabletId);
+        Version version(tablet->max_version().second + 1, tablet->max_version().second + 1);
+        std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+        k_engine->txn_manager()->get_txn_related_tablets(txn_id, kPartitionId,
+                                                           &tablet_related_rs);
+        ASSERT_EQ(1, tablet_related_rs.size());
+        for (auto& [tablet_info, rowset] : tablet_related_rs) {
+            ASSERT_TRUE(k_engine->txn_manager()
+                                ->publish_txn(tablet->data_dir()->get_meta(), kPartitionId,
+                                              txn_id, kTabletId, kSchemaHash,
+                                              tablet_info.tablet_uid, version)
+                                .ok());
+            ASSERT_TRUE(tablet->update_delete_bitmap(rowset).ok());
+            ASSERT_TRUE(tablet->add_inc_rowset(rowset).ok());
+        }
+    }
+
+    // Looks the keys up at 'version', the last version if it is 0.
+    static Status _lookup(const std::vector<int32_t>& keys, const std::vector<std::string>& columns,
+                          int64_t version, PTabletKeyLookupResponse* response) {
+        PTabletKeyLookupRequest request;
+        request.set_tablet_id(kTabletId);
+        for (int32_t key : keys) {
+            request.add_key_tuples()->add_key_column_reps(std::to_string(key));
+        }
+        for (const auto& column : columns) {
+            request.add_return_columns(column);
+        }
+        if (version > 0) {
+            request.set_version(version);
+        }
+        PointQueryExecutor executor;
+        RETURN_IF_ERROR(executor.init(&request, response));
+        return executor.lookup();
+    }
+};
+
+TEST_F(PointQueryExecutorTest, lookup) {
+    PTabletKeyLookupResponse response;
+    Status st = _lookup({3, 5, 1, 2}, {}, 0, &response);
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    // the key 5 is not found, the key 1 has its last values
+    std::map<int32_t, std::vector<int64_t>> expected = {
+            {0, {3, 30, 300}}, {2, {1, 11, 111}}, {3, {2, 20, 200}}};
+    ASSERT_EQ(3, response.key_tuple_indexes_size());
+    vectorized::Block block(response.block());
+    ASSERT_EQ(3, block.columns());
+    ASSERT_EQ(3, block.rows());
+    for (size_t row = 0; row < block.rows(); ++row) {
+        int32_t index = response.key_tuple_indexes(row);
+        ASSERT_EQ(1, expected.count(index)) << index;
+        for (size_t cid = 0; cid < 3; ++cid) {
+            EXPECT_EQ(expected[index][cid], block.get_by_position(cid).column->get_int(row));
+        }
+    }
+}
+
+TEST_F(PointQueryExecutorTest, return_columns_and_version) {
+    // at the version of the first load, the key 3 is not loaded yet
+    PTabletKeyLookupResponse response;
+    Status st = _lookup({1, 3}, {"v2"}, 2, &response);
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    ASSERT_EQ(1, response.key_tuple_indexes_size());
+    EXPECT_EQ(0, response.key_tuple_indexes(0));
+    vectorized::Block block(response.block());
+    ASSERT_EQ(1, block.columns());
+    ASSERT_EQ(1, block.rows());
+    EXPECT_EQ(100, block.get_by_position(0).column->get_int(0));
+}
+
+TEST_F(PointQueryExecutorTest, bad_request) {
+    PTabletKeyLookupResponse response;
+    EXPECT_TRUE(_lookup({1}, {"v3"}, 0, &response).is_invalid_argument());
+
+    // a key tuple with more values than key columns
+    PTabletKeyLookupRequest request;
+    request.set_tablet_id(kTabletId);
+    auto key_tuple = request.add_key_tuples();
+    key_tuple->add_key_column_reps("1");
+    key_tuple->add_key_column_reps("2");
+    PointQueryExecutor executor;
+    ASSERT_TRUE(executor.init(&request, &response).ok());
+    EXPECT_TRUE(executor.lookup().is_invalid_argument());
+
+    request.set_tablet_id(kTabletId + 1);
+    PointQueryExecutor missing_tablet_executor;
+    EXPECT_TRUE(missing_tablet_executor.init(&request, &response).is_not_found());
+}
+
+} // namespace doris
@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "exec/exec_node.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+// A leaf node returning the given blocks from get_next(), the input of the node under test.
+class MockBlockNode : public ExecNode {
+public:
+    MockBlockNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                  std::vector<vectorized::Block> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("MockBlockNode only returns blocks");
+    }
+
+    Status get_next(RuntimeState* state, vectorized::Block* block, bool* eos) override {
+        if (_next_block < _blocks.size()) {
+            block->swap(_blocks[_next_block++]);
+            _num_rows_returned += block->rows();
+        }
+        *eos = _next_block >= _blocks.size();
+        return Status::OK();
+    }
+
+    // the number of blocks returned so far
+    size_t blocks_returned() const { return _next_block; }
+
+private:
+    std::vector<vectorized::Block> _blocks;
+    size_t _next_block = 0;
+};
+
+// A plan node producing the rows of `row_tuples`, none of them nullable.
+inline TPlanNode create_plan_node(TPlanNodeId node_id, TPlanNodeType::type node_type,
+                                  const std::vector<TTupleId>& row_tuples, int num_children) {
+    TPlanNode tnode;
+    tnode.node_id = node_id;
+    tnode.node_type = node_type;
+    tnode.num_children = num_children;
+    tnode.limit = -1;
+    tnode.row_tuples = row_tuples;
+    tnode.nullable_tuples.assign(row_tuples.size(), false);
+    return tnode;
+}
+
+inline TExprNode create_slot_ref_node(const SlotDescriptor* slot) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::SLOT_REF);
+    node.__set_type(slot->type().to_thrift());
+    node.__set_num_children(0);
+    node.__set_is_nullable(slot->is_nullable());
+    TSlotRef slot_ref;
+    slot_ref.slot_id = slot->id();
+    slot_ref.tuple_id = slot->parent();
+    node.__set_slot_ref(slot_ref);
+    return node;
+}
+
+inline TExpr create_slot_ref(const SlotDescriptor* slot) {
+    TExpr expr;
+    expr.nodes.push_back(create_slot_ref_node(slot));
+    return expr;
+}
+
+// The aggregate function `name` of the raw rows of `arg`, returning a nullable `ret_type`.
+inline TExpr create_agg_fn(const std::string& name, const SlotDescriptor* arg,
+                           const TypeDescriptor& ret_type) {
+    TTypeDesc arg_type = arg->type().to_thrift();
+    arg_type.__set_is_nullable(arg->is_nullable());
+
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::AGG_EXPR);
+    node.__set_type(ret_type.to_thrift());
+    node.__set_num_children(1);
+    node.__set_is_nullable(true);
+    TFunction fn;
+    fn.name.__set_function_name(name);
+    fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+    fn.arg_types.push_back(arg->type().to_thrift());
+    fn.__set_ret_type(ret_type.to_thrift());
+    fn.__set_has_var_args(false);
+    node.__set_fn(fn);
+    TAggregateExpr agg_expr;
+    agg_expr.is_merge_agg = false;
+    agg_expr.param_types.push_back(arg_type);
+    node.__set_agg_expr(agg_expr);
+
+    TExpr expr;
+    expr.nodes.push_back(node);
+    expr.nodes.push_back(create_slot_ref_node(arg));
+    return expr;
+}
+
+} // namespace doris
@@ -36,7 +36,8 @@ class MockRowset : public Rowset {
         return Status::NotSupported("MockRowset not support this method.");
     }
 
-    virtual Status link_files_to(const std::string& dir, RowsetId new_rowset_id) override {
+    virtual Status link_files_to(const std::string& dir, RowsetId new_rowset_id,
+                                 size_t new_segment_start_id) override {
         return Status::NotSupported("MockRowset not support this method.");
     }
 
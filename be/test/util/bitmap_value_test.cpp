@@ -66,6 +66,59 @@ TEST(BitmapValueTest, bitmap_union) {
     EXPECT_EQ(5, bitmap2.cardinality());
 }
 
+TEST(BitmapValueTest, bitmap_lazy_union) {
+    BitmapValue expected;
+    BitmapValue lazy;
+    std::vector<BitmapValue> rows;
+    for (uint64_t i = 0; i < 100; ++i) {
+        // dense and sparse values, some of them above 32 bits
+        std::vector<uint64_t> values;
+        for (uint64_t j = 0; j < 1000; ++j) {
+            values.push_back(i * 500 + j);
+            values.push_back(((i % 3) << 32) + i * 100003 + j * 7);
+        }
+        rows.emplace_back(values);
+    }
+    rows.emplace_back(1ULL << 40);
+    rows.emplace_back();
+    for (const auto& row : rows) {
+        expected |= row;
+        lazy.lazy_or(row);
+    }
+    lazy.repair_after_lazy();
+    EXPECT_EQ(expected.cardinality(), lazy.cardinality());
+    EXPECT_EQ(expected.to_string(), lazy.to_string());
+
+    std::vector<const detail::Roaring64Map*> inputs;
+    std::vector<detail::Roaring64Map> maps(3);
+    for (uint64_t i = 0; i < maps.size(); ++i) {
+        for (uint64_t j = 0; j < 10000; ++j) {
+            maps[i].add((i << 32) + j * (i + 1));
+            maps[i].add(j * 3);
+        }
+        inputs.push_back(&maps[i]);
+    }
+    auto fast = detail::Roaring64Map::fastunion(inputs.size(), inputs.data());
+    detail::Roaring64Map slow;
+    for (const auto& map : maps) {
+        slow |= map;
+    }
+    EXPECT_EQ(slow.cardinality(), fast.cardinality());
+    EXPECT_TRUE(slow == fast);
+
+    // the size stays the same when the optimized bitmap is sized again
+    size_t size = lazy.getSizeInBytes();
+    EXPECT_EQ(size, lazy.getSizeInBytes());
+    std::string buf(size, '\0');
+    lazy.write(buf.data());
+    BitmapValue deserialized(buf.data());
+    EXPECT_EQ(expected.to_string(), deserialized.to_string());
+    lazy.add(1ULL << 41);
+    buf.resize(lazy.getSizeInBytes());
+    lazy.write(buf.data());
+    EXPECT_EQ(expected.cardinality() + 1, BitmapValue(buf.data()).cardinality());
+}
+
 TEST(BitmapValueTest, bitmap_intersect) {
     BitmapValue empty;
     BitmapValue single(1024);
@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 namespace doris {
 
 class BrpcClientCacheTest : public testing::Test {
@@ -43,6 +45,25 @@ TEST_F(BrpcClientCacheTest, normal) {
     EXPECT_EQ(stub1, stub3);
 }
 
+TEST_F(BrpcClientCacheTest, channels_per_peer) {
+    int origin_channels = config::brpc_channels_per_peer;
+    config::brpc_channels_per_peer = 3;
+    BrpcClientCache<PBackendService_Stub> cache;
+    TNetworkAddress address;
+    address.hostname = "127.0.0.1";
+    address.port = 123;
+    // the stubs of a peer are returned in turn
+    std::set<std::shared_ptr<PBackendService_Stub>> stubs;
+    for (int i = 0; i < 6; ++i) {
+        auto stub = cache.get_client(address);
+        EXPECT_NE(nullptr, stub);
+        stubs.insert(stub);
+    }
+    EXPECT_EQ(3, stubs.size());
+    EXPECT_EQ(1, cache.size());
+    config::brpc_channels_per_peer = origin_channels;
+}
+
 TEST_F(BrpcClientCacheTest, invalid) {
     BrpcClientCache<PBackendService_Stub> cache;
     TNetworkAddress address;
@@ -0,0 +1,107 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/cpu_sampler.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace doris {
+
+static TUniqueId make_id(int64_t hi, int64_t lo) {
+    TUniqueId id;
+    id.__set_hi(hi);
+    id.__set_lo(lo);
+    return id;
+}
+
+TEST(CpuSamplerTest, CountsSamplesOfTasks) {
+    CpuSampler sampler;
+    CpuSampler::attach_thread(1, make_id(1, 2), make_id(1, 3));
+    sampler.sample(1);
+    sampler.sample(2);
+    CpuSampler::attach_thread(1, make_id(1, 2), make_id(1, 4));
+    sampler.sample(1);
+    CpuSampler::detach_thread();
+    sampler.sample(1);
+    sampler.aggregate(600);
+
+    auto entries = sampler.entries();
+    ASSERT_EQ(3, entries.size());
+    EXPECT_EQ(3, entries[0].samples);
+    EXPECT_EQ(1, entries[0].task_type);
+    EXPECT_EQ(make_id(1, 2), entries[0].query_id);
+    EXPECT_EQ(make_id(1, 3), entries[0].fragment_instance_id);
+    int64_t unattributed = 0;
+    for (auto& entry : entries) {
+        if (entry.task_type == 0) {
+            EXPECT_EQ(TUniqueId(), entry.query_id);
+            unattributed += entry.samples;
+        }
+    }
+    EXPECT_EQ(1, unattributed);
+
+    // the samples are only counted once
+    sampler.aggregate(600);
+    EXPECT_EQ(3, sampler.entries()[0].samples);
+
+    // the entries without a recent sample are dropped
+    sampler.aggregate(-1);
+    EXPECT_TRUE(sampler.entries().empty());
+}
+
+TEST(CpuSamplerTest, DropsSamplesOverTheBuffer) {
+    CpuSampler sampler;
+    CpuSampler::attach_thread(1, make_id(1, 2), make_id(1, 3));
+    for (int i = 0; i < (1 << 14) + 10; ++i) {
+        sampler.sample(1);
+    }
+    CpuSampler::detach_thread();
+    sampler.aggregate(600);
+    EXPECT_EQ(10, sampler.dropped_samples());
+    ASSERT_EQ(1, sampler.entries().size());
+    EXPECT_EQ(1 << 14, sampler.entries()[0].samples);
+}
+
+TEST(CpuSamplerTest, SamplesThreadsOnCpu) {
+    CpuSampler sampler;
+    ASSERT_TRUE(sampler.start(99).ok());
+    CpuSampler::attach_thread(1, make_id(5, 6), make_id(5, 7));
+    timespec start;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    timespec now;
+    do {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000L * 1000L * 1000L + now.tv_nsec - start.tv_nsec <
+             1000L * 1000L * 1000L);
+    CpuSampler::detach_thread();
+    sampler.stop();
+    sampler.aggregate(600);
+
+    int64_t samples = 0;
+    for (auto& entry : sampler.entries()) {
+        if (entry.query_id == make_id(5, 6)) {
+            samples += entry.samples;
+        }
+    }
+    // about 99 samples of the 1 second of CPU time
+    EXPECT_GT(samples, 50);
+    EXPECT_LT(samples, 150);
+}
+
+} // namespace doris
@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/dd_sketch.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+namespace doris {
+
+static void expect_quantiles(const DDSketch& sketch, std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    for (double q : {0.0, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+        double expected = values[(size_t)(q * (values.size() - 1))];
+        EXPECT_NEAR(expected, sketch.quantile(q),
+                    std::abs(expected) * DDSketch::DEFAULT_RELATIVE_ACCURACY * 1.01)
+                << "q=" << q;
+    }
+}
+
+TEST(DDSketchTest, relative_accuracy) {
+    std::mt19937_64 rng(0);
+    std::lognormal_distribution<double> lognormal(0, 3);
+    std::normal_distribution<double> normal(0, 100);
+    std::vector<double> values;
+    DDSketch sketch;
+    for (int i = 0; i < 100000; ++i) {
+        double value = i % 2 ? lognormal(rng) : normal(rng);
+        values.push_back(value);
+        sketch.add(value);
+    }
+    values.push_back(0);
+    sketch.add(0);
+    EXPECT_EQ(values.size(), sketch.count());
+    expect_quantiles(sketch, values);
+
+    DDSketch empty;
+    EXPECT_TRUE(std::isnan(empty.quantile(0.5)));
+    DDSketch single;
+    single.add(-5);
+    EXPECT_EQ(-5, single.quantile(0.99));
+}
+
+TEST(DDSketchTest, merge_and_serialize) {
+    std::mt19937_64 rng(1);
+    std::exponential_distribution<double> exponential(0.01);
+    std::vector<double> values;
+    DDSketch merged;
+    for (int part = 0; part < 10; ++part) {
+        DDSketch sketch;
+        for (int i = 0; i < 10000; ++i) {
+            double value = exponential(rng) * (part + 1);
+            values.push_back(value);
+            sketch.add(value);
+        }
+        std::string buf(sketch.serialized_size(), '\0');
+        EXPECT_EQ(buf.size(), sketch.serialize((uint8_t*)buf.data()));
+        DDSketch deserialized;
+        deserialized.unserialize((const uint8_t*)buf.data());
+        EXPECT_EQ(sketch.quantile(0.5), deserialized.quantile(0.5));
+        merged.merge(deserialized);
+    }
+    EXPECT_EQ(values.size(), merged.count());
+    expect_quantiles(merged, values);
+}
+
+TEST(DDSketchTest, max_buckets) {
+    DDSketch sketch(DDSketch::DEFAULT_RELATIVE_ACCURACY, 64);
+    for (int i = 1; i <= 100000; ++i) {
+        sketch.add(i);
+    }
+    // only the buckets of the smallest values are collapsed
+    EXPECT_NEAR(99000, sketch.quantile(0.99), 99000 * DDSketch::DEFAULT_RELATIVE_ACCURACY);
+    EXPECT_LT(sketch.serialized_size(), 64 * sizeof(uint64_t) * 2);
+}
+
+} // namespace doris
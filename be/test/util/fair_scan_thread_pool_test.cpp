@@ -0,0 +1,121 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/fair_scan_thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace doris {
+
+static void burn_cpu_ms(int ms) {
+    ThreadCpuStopWatch watch;
+    watch.start();
+    while (watch.elapsed_time() < ms * 1000000L) {
+    }
+}
+
+static PriorityThreadPool::Task make_task(int64_t group_id, int shares, std::function<void()> f) {
+    PriorityThreadPool::Task task;
+    task.priority = 0;
+    task.work_function = std::move(f);
+    task.queue_id = 0;
+    task.group_id = group_id;
+    task.shares = shares;
+    return task;
+}
+
+class FairScanThreadPoolTest : public testing::Test {
+protected:
+    // Offers the tasks while the only thread of the pool is busy, then returns the groups of the
+    // tasks in the order they ran.
+    std::vector<int64_t> run(const std::vector<std::pair<int64_t, int>>& tasks) {
+        FairScanThreadPool pool(1, 1, 1024);
+        std::promise<void> started;
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        EXPECT_TRUE(pool.offer(make_task(-1, 0, [&] {
+            started.set_value();
+            released.wait();
+        })));
+        started.get_future().wait();
+
+        std::mutex lock;
+        std::vector<int64_t> order;
+        std::atomic<int> done = 0;
+        for (auto [group_id, shares] : tasks) {
+            EXPECT_TRUE(pool.offer(make_task(group_id, shares, [&, group_id = group_id] {
+                burn_cpu_ms(1);
+                std::lock_guard<std::mutex> l(lock);
+                order.push_back(group_id);
+                ++done;
+            })));
+        }
+        release.set_value();
+        while (done < tasks.size()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return order;
+    }
+};
+
+TEST_F(FairScanThreadPoolTest, small_query_is_not_starved) {
+    std::vector<std::pair<int64_t, int>> tasks(50, {1, 0});
+    tasks.emplace_back(2, 0);
+    tasks.emplace_back(2, 0);
+    auto order = run(tasks);
+    ASSERT_EQ(52, order.size());
+    int small_done = 0;
+    for (int i = 0; i < 6; ++i) {
+        small_done += order[i] == 2;
+    }
+    EXPECT_EQ(2, small_done);
+}
+
+TEST_F(FairScanThreadPoolTest, shares) {
+    std::vector<std::pair<int64_t, int>> tasks;
+    for (int i = 0; i < 60; ++i) {
+        tasks.emplace_back(1, 2048);
+        tasks.emplace_back(2, 1024);
+    }
+    auto order = run(tasks);
+    int big_share = 0;
+    for (int i = 0; i < 60; ++i) {
+        big_share += order[i] == 1;
+    }
+    EXPECT_GE(big_share, 35);
+    EXPECT_LE(big_share, 45);
+}
+
+TEST_F(FairScanThreadPoolTest, steal) {
+    FairScanThreadPool pool(1, 4, 16);
+    std::atomic<int> done = 0;
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(pool.offer(make_task(i, 0, [&] { ++done; })));
+        auto task = make_task(i, 0, [&] { ++done; });
+        task.queue_id = i % 4;
+        EXPECT_TRUE(pool.offer(task));
+    }
+    pool.drain_and_shutdown();
+    EXPECT_EQ(16, done);
+    EXPECT_FALSE(pool.offer([] {}));
+}
+
+} // namespace doris
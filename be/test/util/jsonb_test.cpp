@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/jsonb.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace doris {
+
+namespace {
+
+JsonbValue parse(const std::string& json, std::string* jsonb) {
+    EXPECT_TRUE(JsonbValue::from_json(json.data(), json.size(), jsonb));
+    return JsonbValue::root(jsonb->data(), jsonb->size());
+}
+
+} // namespace
+
+TEST(JsonbTest, scalars) {
+    std::string jsonb;
+    EXPECT_EQ(JsonbValue::T_NULL, parse("null", &jsonb).type());
+    EXPECT_EQ(JsonbValue::T_TRUE, parse("true", &jsonb).type());
+    EXPECT_EQ(JsonbValue::T_FALSE, parse("false", &jsonb).type());
+    EXPECT_EQ(-12, parse("-12", &jsonb).get_int64());
+    EXPECT_EQ(1.5, parse("1.5", &jsonb).get_double());
+    EXPECT_EQ(JsonbValue::T_DOUBLE, parse("18446744073709551615", &jsonb).type());
+    EXPECT_EQ("a\"b", parse("\"a\\\"b\"", &jsonb).get_string());
+    EXPECT_FALSE(JsonbValue::from_json("{\"k\":", 5, &jsonb));
+}
+
+TEST(JsonbTest, objects_and_arrays) {
+    std::string jsonb;
+    JsonbValue root = parse(R"({"k3":[1,"v",{"k":null}],"k1":1,"k2":{"a":2.5},"k1":2})", &jsonb);
+    ASSERT_EQ(JsonbValue::T_OBJECT, root.type());
+    EXPECT_EQ(4, root.size());
+    // the first of the duplicated keys
+    EXPECT_EQ(1, root.find("k1").get_int64());
+    EXPECT_EQ(2.5, root.find("k2").find("a").get_double());
+    EXPECT_FALSE(root.find("k0").is_valid());
+    EXPECT_FALSE(root.find("k4").is_valid());
+    EXPECT_FALSE(root.at(0).is_valid());
+
+    JsonbValue array = root.find("k3");
+    ASSERT_EQ(JsonbValue::T_ARRAY, array.type());
+    EXPECT_EQ(3, array.size());
+    EXPECT_EQ(1, array.at(0).get_int64());
+    EXPECT_EQ("v", array.at(1).get_string());
+    EXPECT_EQ(JsonbValue::T_NULL, array.at(2).find("k").type());
+    EXPECT_FALSE(array.at(3).is_valid());
+
+    std::string json;
+    root.to_json(&json);
+    EXPECT_EQ(R"({"k1":1,"k1":2,"k2":{"a":2.5},"k3":[1,"v",{"k":null}]})", json);
+}
+
+TEST(JsonbTest, invalid_data) {
+    EXPECT_FALSE(JsonbValue::root("", 0).is_valid());
+    EXPECT_FALSE(JsonbValue::root("{\"k\":1}", 7).is_valid());
+
+    std::string jsonb;
+    parse(R"({"key":["value", 1]})", &jsonb);
+    // every truncation of a document is read without overflowing it
+    for (size_t size = 0; size < jsonb.size(); ++size) {
+        std::string truncated = jsonb.substr(0, size);
+        JsonbValue root = JsonbValue::root(truncated.data(), truncated.size());
+        EXPECT_FALSE(root.is_valid() && root.find("key").at(1).is_valid()) << size;
+        std::string json;
+        root.to_json(&json);
+    }
+}
+
+} // namespace doris
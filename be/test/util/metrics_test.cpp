@@ -431,6 +431,7 @@ test_registry_task_duration{quantile="0.75"} 75
 test_registry_task_duration{quantile="0.90"} 95.8333
 test_registry_task_duration{quantile="0.95"} 100
 test_registry_task_duration{quantile="0.99"} 100
+test_registry_task_duration{quantile="0.999"} 100
 test_registry_task_duration_sum 5050
 test_registry_task_duration_count 100
 test_registry_task_duration_max 100
@@ -443,7 +444,7 @@ test_registry_task_duration_standard_deviation 28.8661
         EXPECT_EQ(
                 R"*([{"tags":{"metric":"task_duration"},"unit":"milliseconds",)*"
                 R"*("value":{"total_count":100,"min":1,"average":50.5,"median":50.0,)*"
-                R"*("percentile_50":50.0,"percentile_75":75.0,"percentile_90":95.83333333333334,"percentile_95":100.0,"percentile_99":100.0,)*"
+                R"*("percentile_50":50.0,"percentile_75":75.0,"percentile_90":95.83333333333334,"percentile_95":100.0,"percentile_99":100.0,"percentile_999":100.0,)*"
                 R"*("standard_deviation":28.86607004772212,"max":100,"total_sum":5050}}])*",
                 registry.to_json());
         registry.deregister_entity(entity);
@@ -467,6 +468,7 @@ test_registry_task_duration{instance="test",type="create_tablet",quantile="0.75"
 test_registry_task_duration{instance="test",type="create_tablet",quantile="0.90"} 95.8333
 test_registry_task_duration{instance="test",type="create_tablet",quantile="0.95"} 100
 test_registry_task_duration{instance="test",type="create_tablet",quantile="0.99"} 100
+test_registry_task_duration{instance="test",type="create_tablet",quantile="0.999"} 100
 test_registry_task_duration_sum{instance="test",type="create_tablet"} 5050
 test_registry_task_duration_count{instance="test",type="create_tablet"} 100
 test_registry_task_duration_max{instance="test",type="create_tablet"} 100
@@ -479,10 +481,36 @@ test_registry_task_duration_standard_deviation{instance="test",type="create_tabl
         EXPECT_EQ(
                 R"*([{"tags":{"metric":"task_duration","type":"create_tablet","instance":"test"},"unit":"milliseconds",)*"
                 R"*("value":{"total_count":100,"min":1,"average":50.5,"median":50.0,)*"
-                R"*("percentile_50":50.0,"percentile_75":75.0,"percentile_90":95.83333333333334,"percentile_95":100.0,"percentile_99":100.0,)*"
+                R"*("percentile_50":50.0,"percentile_75":75.0,"percentile_90":95.83333333333334,"percentile_95":100.0,"percentile_99":100.0,"percentile_999":100.0,)*"
                 R"*("standard_deviation":28.86607004772212,"max":100,"total_sum":5050}}])*",
                 registry.to_json());
         registry.deregister_entity(entity);
     }
 }
+TEST_F(MetricsTest, CoreLocalHistogram) {
+    CoreLocalHistogramMetric core_local;
+    HistogramMetric expected;
+    for (int j = 1; j <= 1000; j++) {
+        core_local.add(j);
+        expected.add(j);
+    }
+    Labels labels({{"type", "test"}});
+    EXPECT_EQ(expected.to_prometheus("test_latency", labels, Labels()),
+              core_local.to_prometheus("test_latency", labels, Labels()));
+    EXPECT_EQ(expected.to_string(), core_local.to_string());
+
+    // the accessors read the stats merged by refresh()
+    EXPECT_EQ(0, core_local.num());
+    core_local.refresh();
+    EXPECT_EQ(1000, core_local.num());
+    EXPECT_EQ(1, core_local.min());
+    EXPECT_EQ(1000, core_local.max());
+    EXPECT_EQ(expected.percentile(99.9), core_local.percentile(99.9));
+
+    core_local.clear();
+    EXPECT_EQ(0, core_local.num());
+    core_local.refresh();
+    EXPECT_TRUE(core_local.is_empty());
+}
+
 } // namespace doris
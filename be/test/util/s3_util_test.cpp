@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/s3_util.h"
+
+#include <aws/core/utils/ratelimiter/DefaultRateLimiter.h>
+#include <aws/s3/S3Client.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+namespace doris {
+
+static std::map<std::string, std::string> s3_properties(const std::string& ak,
+                                                        const std::string& sk) {
+    return {{S3_AK, ak}, {S3_SK, sk}, {S3_ENDPOINT, "127.0.0.1:9000"}, {S3_REGION, "region"}};
+}
+
+TEST(S3UtilTest, shared_clients) {
+    auto& factory = ClientFactory::instance();
+    auto client = factory.create(s3_properties("ak", "sk"));
+    ASSERT_NE(nullptr, client);
+    EXPECT_EQ(client, factory.create(s3_properties("ak", "sk")));
+
+    // the names of the properties are case insensitive
+    std::map<std::string, std::string> lower_case_properties;
+    for (const auto& [name, value] : s3_properties("ak", "sk")) {
+        std::string lower_case_name = name;
+        std::transform(name.begin(), name.end(), lower_case_name.begin(), ::tolower);
+        lower_case_properties.emplace(lower_case_name, value);
+    }
+    EXPECT_EQ(client, factory.create(lower_case_properties));
+
+    // any other property makes another client
+    EXPECT_NE(client, factory.create(s3_properties("ak2", "sk")));
+    auto properties = s3_properties("ak", "sk");
+    properties[S3_MAX_CONN_SIZE] = "8";
+    EXPECT_NE(client, factory.create(properties));
+    properties[S3_MAX_CONN_SIZE] = "16";
+    auto other_client = factory.create(properties);
+    EXPECT_NE(client, other_client);
+    EXPECT_EQ(other_client, factory.create(properties));
+
+    // the values are not mixed up with each other
+    EXPECT_NE(factory.create(s3_properties("ab", "c")), factory.create(s3_properties("a", "bc")));
+}
+
+TEST(S3UtilTest, rate_limited_clients) {
+    auto& factory = ClientFactory::instance();
+    auto client = factory.create(s3_properties("ak", "sk"));
+    auto rate_limiter = std::make_shared<Aws::Utils::RateLimits::DefaultRateLimiter<>>(1024);
+    auto limited_client = factory.create(s3_properties("ak", "sk"), rate_limiter);
+    ASSERT_NE(nullptr, limited_client);
+    EXPECT_NE(client, limited_client);
+    EXPECT_NE(limited_client, factory.create(s3_properties("ak", "sk"), rate_limiter));
+    EXPECT_EQ(client, factory.create(s3_properties("ak", "sk")));
+}
+
+} // namespace doris
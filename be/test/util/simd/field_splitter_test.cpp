@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/simd/field_splitter.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace doris {
+
+static std::vector<std::string> split(const std::string& line, char separator) {
+    std::vector<std::string> fields;
+    simd::split_by_char(line.data(), line.size(), separator, [&](size_t start, size_t end) {
+        fields.emplace_back(line.data() + start, end - start);
+    });
+    return fields;
+}
+
+TEST(FieldSplitterTest, short_line) {
+    EXPECT_EQ(std::vector<std::string>({""}), split("", ','));
+    EXPECT_EQ(std::vector<std::string>({"abc"}), split("abc", ','));
+    EXPECT_EQ(std::vector<std::string>({"a", "", "c", ""}), split("a,,c,", ','));
+    EXPECT_EQ(std::vector<std::string>({"", ""}), split("\t", '\t'));
+}
+
+TEST(FieldSplitterTest, long_line) {
+    // the fields cross the boundaries of the vectors compared at a time
+    std::vector<std::string> expected;
+    std::string line;
+    for (int i = 0; i < 200; ++i) {
+        expected.emplace_back(std::string(i % 37, 'a' + i % 26));
+        if (i > 0) {
+            line.push_back('|');
+        }
+        line.append(expected.back());
+    }
+    EXPECT_EQ(expected, split(line, '|'));
+}
+
+TEST(FieldSplitterTest, all_separators) {
+    std::string line(100, ',');
+    auto fields = split(line, ',');
+    ASSERT_EQ(101, fields.size());
+    for (auto& field : fields) {
+        EXPECT_TRUE(field.empty());
+    }
+}
+
+} // namespace doris
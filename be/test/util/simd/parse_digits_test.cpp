@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/simd/parse_digits.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace doris {
+
+static bool parse(const std::string& str, uint64_t* value) {
+    return simd::parse_digits(str.data(), str.size(), value);
+}
+
+TEST(ParseDigitsTest, eight_digits) {
+    EXPECT_TRUE(simd::is_eight_digits("01234567"));
+    EXPECT_EQ(1234567, simd::parse_eight_digits("01234567"));
+    EXPECT_EQ(99999999, simd::parse_eight_digits("99999999"));
+    EXPECT_FALSE(simd::is_eight_digits("0123456/"));
+    EXPECT_FALSE(simd::is_eight_digits(":1234567"));
+    EXPECT_FALSE(simd::is_eight_digits("0123 567"));
+}
+
+TEST(ParseDigitsTest, digit_runs) {
+    uint64_t value = 1;
+    EXPECT_TRUE(parse("", &value));
+    EXPECT_EQ(0, value);
+    // the runs shorter than, equal to and longer than a word
+    for (std::string str : {"7", "1234567", "12345678", "123456789", "1234567890123456789"}) {
+        EXPECT_TRUE(parse(str, &value));
+        EXPECT_EQ(std::stoull(str), value);
+    }
+    EXPECT_FALSE(parse("1234567a", &value));
+    EXPECT_FALSE(parse("123456789a", &value));
+    EXPECT_FALSE(parse("-1", &value));
+    EXPECT_FALSE(parse("1.5", &value));
+}
+
+} // namespace doris
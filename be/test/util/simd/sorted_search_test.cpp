@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/simd/sorted_search.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace doris {
+
+TEST(SortedSearchTest, small) {
+    std::vector<uint64_t> values = {1, 3, 3, 5};
+    EXPECT_EQ(0, simd::sorted_lower_bound(values.data(), 0, 3));
+    EXPECT_EQ(0, simd::sorted_lower_bound(values.data(), values.size(), 0));
+    EXPECT_EQ(1, simd::sorted_lower_bound(values.data(), values.size(), 3));
+    EXPECT_EQ(3, simd::sorted_upper_bound(values.data(), values.size(), 3));
+    EXPECT_EQ(4, simd::sorted_upper_bound(values.data(), values.size(), 5));
+}
+
+TEST(SortedSearchTest, random) {
+    std::mt19937_64 rng(0);
+    for (int round = 0; round < 1000; ++round) {
+        // the values with their high bit set check the unsigned compare
+        std::vector<uint64_t> values(rng() % 100);
+        for (auto& value : values) {
+            value = round % 2 == 0 ? rng() % 20 : rng();
+        }
+        std::sort(values.begin(), values.end());
+        for (int i = 0; i < 20; ++i) {
+            uint64_t key = round % 2 == 0 ? rng() % 22 : rng();
+            if (i == 0 && !values.empty()) {
+                key = values[rng() % values.size()];
+            }
+            EXPECT_EQ(std::lower_bound(values.begin(), values.end(), key) - values.begin(),
+                      simd::sorted_lower_bound(values.data(), values.size(), key));
+            EXPECT_EQ(std::upper_bound(values.begin(), values.end(), key) - values.begin(),
+                      simd::sorted_upper_bound(values.data(), values.size(), key));
+        }
+    }
+    std::vector<uint64_t> extremes = {0, 0, UINT64_MAX, UINT64_MAX};
+    EXPECT_EQ(2, simd::sorted_lower_bound(extremes.data(), extremes.size(), UINT64_MAX));
+    EXPECT_EQ(2, simd::sorted_upper_bound(extremes.data(), extremes.size(), 0));
+}
+
+} // namespace doris
@@ -0,0 +1,85 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/simd/utf8.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace doris {
+
+static std::string transfer_case(const std::string& str, bool to_upper) {
+    std::string res(str.size(), '\0');
+    const auto* src = reinterpret_cast<const uint8_t*>(str.data());
+    auto* dst = reinterpret_cast<uint8_t*>(res.data());
+    if (to_upper) {
+        simd::utf8_transfer_case<true>(src, str.size(), dst);
+    } else {
+        simd::utf8_transfer_case<false>(src, str.size(), dst);
+    }
+    return res;
+}
+
+TEST(Utf8Test, char_count) {
+    EXPECT_EQ(0, simd::utf8_char_count("", 0));
+    std::string str;
+    // the strings shorter than, equal to and longer than a block of 16 bytes
+    for (int i = 1; i <= 20; ++i) {
+        str += i % 2 ? "a" : "你好";
+        EXPECT_EQ(i / 2 * 3 + i % 2, simd::utf8_char_count(str.data(), str.size()));
+    }
+}
+
+TEST(Utf8Test, char_offset) {
+    std::string str = "abc你好😀defghijklmn世界";
+    // the offsets of the chars a, 你, 😀, d and 世, and of the end of the string
+    EXPECT_EQ(0, simd::utf8_char_offset(str.data(), str.size(), 0));
+    EXPECT_EQ(3, simd::utf8_char_offset(str.data(), str.size(), 3));
+    EXPECT_EQ(9, simd::utf8_char_offset(str.data(), str.size(), 5));
+    EXPECT_EQ(13, simd::utf8_char_offset(str.data(), str.size(), 6));
+    EXPECT_EQ(24, simd::utf8_char_offset(str.data(), str.size(), 17));
+    EXPECT_EQ(27, simd::utf8_char_offset(str.data(), str.size(), 18));
+    EXPECT_EQ(str.size(), simd::utf8_char_offset(str.data(), str.size(), 19));
+    EXPECT_EQ(str.size(), simd::utf8_char_offset(str.data(), str.size(), 100));
+}
+
+TEST(Utf8Test, is_ascii) {
+    EXPECT_TRUE(simd::is_ascii("", 0));
+    std::string str(40, 'a');
+    EXPECT_TRUE(simd::is_ascii(str.data(), str.size()));
+    for (size_t pos : {0, 15, 16, 39}) {
+        std::string non_ascii = str;
+        non_ascii[pos] = '\xE4';
+        EXPECT_FALSE(simd::is_ascii(non_ascii.data(), non_ascii.size()));
+    }
+}
+
+TEST(Utf8Test, transfer_case) {
+    EXPECT_EQ("", transfer_case("", false));
+    EXPECT_EQ("hello, 你好 world!", transfer_case("HeLLo, 你好 World!", false));
+    EXPECT_EQ("HELLO, 你好 WORLD!", transfer_case("HeLLo, 你好 World!", true));
+    // Latin-1, Greek and Cyrillic letters around the blocks of 16 bytes
+    EXPECT_EQ("àéîõü×ß ÷ ÿ αβγδεπσωσ абвгдежзийклмнопрстуфхцчшщъыьэюяёђџ",
+              transfer_case("ÀÉÎÕÜ×ß ÷ ÿ ΑΒΓΔΕΠΣΩσ АБВГДЕЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯЁЂЏ", false));
+    EXPECT_EQ("ÀÉÎÕÜ×ß ÷ ÿ ΑΒΓΔΕΠΣΩΣ АБВГДЕЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯЁЂЏ",
+              transfer_case("àéîõü×ß ÷ ÿ αβγδεπσως абвгдежзийклмнопрстуфхцчшщъыьэюяёђџ", true));
+    // the other letters are kept
+    EXPECT_EQ("ĀŁ中文", transfer_case("ĀŁ中文", false));
+}
+
+} // namespace doris
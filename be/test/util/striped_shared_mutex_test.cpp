@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/striped_shared_mutex.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "testutil/test_util.h"
+
+namespace doris {
+
+TEST(StripedSharedMutexTest, ReadersAndWriters) {
+    int64_t loop = LOOP_LESS_OR_MORE(1000, 100000);
+    StripedSharedMutex mutex;
+    // the writers keep the two values equal, which the readers must always see
+    int64_t first = 0;
+    int64_t second = 0;
+    std::atomic<int64_t> torn_reads {0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i) {
+        threads.emplace_back([&] {
+            for (int64_t j = 0; j < loop; ++j) {
+                std::lock_guard<StripedSharedMutex> wrlock(mutex);
+                ++first;
+                ++second;
+            }
+        });
+    }
+    for (int i = 0; i < 6; ++i) {
+        threads.emplace_back([&] {
+            for (int64_t j = 0; j < loop; ++j) {
+                StripedSharedLock rdlock(mutex);
+                if (first != second) {
+                    ++torn_reads;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, torn_reads.load());
+    EXPECT_EQ(2 * loop, first);
+    EXPECT_EQ(2 * loop, second);
+}
+
+TEST(StripedSharedMutexTest, ReadersShareTheLock) {
+    StripedSharedMutex mutex;
+    StripedSharedLock rdlock(mutex);
+    // another reader is not blocked by the one holding the lock
+    std::thread reader([&mutex] { StripedSharedLock other(mutex); });
+    reader.join();
+}
+
+} // namespace doris
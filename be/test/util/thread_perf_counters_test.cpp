@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/thread_perf_counters.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+namespace doris {
+
+static void burn_cpu(int64_t ns) {
+    ThreadPerfCounters::Values start;
+    ThreadPerfCounters::read(&start);
+    ThreadPerfCounters::Values now;
+    do {
+        ThreadPerfCounters::read(&now);
+    } while (now.cpu_time_ns - start.cpu_time_ns < ns);
+}
+
+TEST(ThreadPerfCountersTest, CountsCpuAndOffCpuTime) {
+    RuntimeProfile profile("test");
+    ProfilePerfCounters counters(&profile);
+    {
+        SCOPED_PERF_COUNTERS(&counters);
+        burn_cpu(10 * 1000 * 1000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    EXPECT_GE(profile.get_counter("PerfCpuTime")->value(), 10 * 1000 * 1000);
+    EXPECT_GE(profile.get_counter("PerfOffCpuTime")->value(), 40 * 1000 * 1000);
+    EXPECT_GE(profile.get_counter("PerfInstructions")->value(), 0);
+    EXPECT_GE(profile.get_counter("PerfLLCMisses")->value(), 0);
+}
+
+TEST(ThreadPerfCountersTest, InnerScopesAreNotCounted) {
+    RuntimeProfile outer_profile("outer");
+    ProfilePerfCounters outer(&outer_profile);
+    RuntimeProfile inner_profile("inner");
+    ProfilePerfCounters inner(&inner_profile);
+    {
+        ScopedPerfCounters outer_scope(&outer);
+        {
+            ScopedPerfCounters inner_scope(&inner);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        burn_cpu(10 * 1000 * 1000);
+    }
+    EXPECT_GE(inner_profile.get_counter("PerfOffCpuTime")->value(), 40 * 1000 * 1000);
+    EXPECT_LT(outer_profile.get_counter("PerfOffCpuTime")->value(), 40 * 1000 * 1000);
+    EXPECT_GE(outer_profile.get_counter("PerfCpuTime")->value(), 10 * 1000 * 1000);
+}
+
+TEST(ThreadPerfCountersTest, StopCountsOnce) {
+    RuntimeProfile profile("test");
+    ProfilePerfCounters counters(&profile);
+    {
+        ScopedPerfCounters scope(&counters);
+        scope.stop();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    EXPECT_LT(profile.get_counter("PerfOffCpuTime")->value(), 40 * 1000 * 1000);
+
+    // does nothing without counters
+    ScopedPerfCounters scope(nullptr);
+    scope.stop();
+}
+
+} // namespace doris
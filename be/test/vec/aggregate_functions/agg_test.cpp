@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "vec/aggregate_functions/aggregate_function.h"
@@ -61,6 +62,42 @@ TEST(AggTest, basic_test) {
     agg_function->destroy(place);
 }
 
+TEST(AggTest, grouped_add_test) {
+    auto column_vector_int32 = ColumnVector<Int32>::create();
+    for (int i = 0; i < agg_test_batch_size; i++) {
+        column_vector_int32->insert(cast_to_nearest_field_type(i));
+    }
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_sum(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt32>()};
+    Array array;
+    auto agg_function = factory.get("sum", data_types, array);
+    const IColumn* column[1] = {column_vector_int32.get()};
+
+    // more groups than MAX_DENSE_GROUPS are added state by state
+    for (size_t num_groups : {size_t(1), size_t(7), IAggregateFunction::MAX_DENSE_GROUPS,
+                              IAggregateFunction::MAX_DENSE_GROUPS + 1}) {
+        std::unique_ptr<char[]> memory(new char[agg_function->size_of_data() * num_groups]);
+        std::vector<AggregateDataPtr> places(num_groups);
+        for (size_t g = 0; g < num_groups; g++) {
+            places[g] = memory.get() + agg_function->size_of_data() * g;
+            agg_function->create(places[g]);
+        }
+        std::vector<UInt32> group_ids(agg_test_batch_size);
+        std::vector<int64_t> expected(num_groups);
+        for (int i = 0; i < agg_test_batch_size; i++) {
+            group_ids[i] = (i * 31) % num_groups;
+            expected[group_ids[i]] += i;
+        }
+        agg_function->add_batch_grouped(agg_test_batch_size, group_ids.data(), num_groups,
+                                        places.data(), 0, column, nullptr);
+        for (size_t g = 0; g < num_groups; g++) {
+            EXPECT_EQ(expected[g], *reinterpret_cast<int64_t*>(places[g]));
+            agg_function->destroy(places[g]);
+        }
+    }
+}
+
 TEST(AggTest, topn_test) {
     MutableColumns datas(2);
     datas[0] = ColumnString::create();
@@ -0,0 +1,156 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/aggregate_functions/uniq_exact_set.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/string_buffer.hpp"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+void register_aggregate_function_uniq(AggregateFunctionSimpleFactory& factory);
+
+using Int64Set = UniqExactSet<Int64, HashCRC32<Int64>, HashSet<Int64, HashCRC32<Int64>>>;
+
+static void serialize(const Int64Set& set, ColumnString& column) {
+    VectorBufferWriter writer(column);
+    set.write(writer);
+    writer.commit();
+}
+
+// The set is split into partitions once it's big, and the single and the partitioned sets merge
+// with each other and round trip through the sorted deltas.
+TEST(UniqExactSetTest, partition_merge_and_serialize) {
+    std::set<Int64> expected;
+    Int64Set small;
+    Int64Set big;
+    for (Int64 i = 0; i < 1000; ++i) {
+        small.insert(i * 3 - 500);
+        expected.insert(i * 3 - 500);
+    }
+    for (Int64 i = 0; i < 100000; ++i) {
+        big.insert(-i);
+        big.insert(-i);
+        expected.insert(-i);
+    }
+    EXPECT_FALSE(small.is_partitioned());
+    EXPECT_TRUE(big.is_partitioned());
+    EXPECT_EQ(100000, big.size());
+
+    auto column = ColumnString::create();
+    serialize(big, *column);
+    serialize(small, *column);
+    // the keys of the big set are dense, which takes a byte per key
+    EXPECT_LT(column->get_data_at(0).size, 100000 + 16);
+
+    Int64Set merged;
+    for (size_t i = 0; i < column->size(); ++i) {
+        Int64Set set;
+        VectorBufferReader reader(column->get_data_at(i));
+        set.read(reader);
+        merged.merge(set);
+    }
+    merged.merge(small);
+    EXPECT_EQ(expected.size(), merged.size());
+    std::set<Int64> keys;
+    merged.for_each([&](Int64 key) { keys.insert(key); });
+    EXPECT_EQ(expected, keys);
+}
+
+// The sets serialized by the plain hash sets before the versioned format are still read.
+TEST(UniqExactSetTest, read_legacy_format) {
+    for (Int64 count : {0, 5, 128, 300, 70000}) {
+        HashSet<Int64, HashCRC32<Int64>> legacy;
+        std::set<Int64> expected;
+        for (Int64 i = 0; i < count; ++i) {
+            legacy.insert(i * 7 - 1000);
+            expected.insert(i * 7 - 1000);
+        }
+        auto column = ColumnString::create();
+        VectorBufferWriter writer(*column);
+        legacy.write(writer);
+        writer.commit();
+
+        Int64Set set;
+        VectorBufferReader reader(column->get_data_at(0));
+        set.read(reader);
+        std::set<Int64> keys;
+        set.for_each([&](Int64 key) { keys.insert(key); });
+        EXPECT_EQ(expected, keys) << count;
+
+        // written again in the versioned format
+        auto versioned = ColumnString::create();
+        serialize(set, *versioned);
+        EXPECT_EQ(0x80, uint8_t(versioned->get_data_at(0).data[0]));
+        EXPECT_EQ(0x00, uint8_t(versioned->get_data_at(0).data[1]));
+        Int64Set reread;
+        VectorBufferReader versioned_reader(versioned->get_data_at(0));
+        reread.read(versioned_reader);
+        EXPECT_EQ(expected.size(), reread.size());
+    }
+}
+
+// multi_distinct_count gives the same count whichever states are merged and serialized.
+TEST(UniqExactSetTest, multi_distinct_count) {
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_uniq(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt32>()};
+    Array params;
+    auto function = factory.get("multi_distinct_count", data_types, params);
+    ASSERT_NE(function, nullptr);
+
+    auto values = ColumnInt32::create();
+    for (Int32 i = 0; i < 150000; ++i) {
+        values->insert_value(i % 70000 - 35000);
+    }
+    const IColumn* columns[1] = {values.get()};
+
+    std::vector<std::unique_ptr<char[]>> memory;
+    std::vector<AggregateDataPtr> places;
+    for (int i = 0; i < 3; ++i) {
+        memory.emplace_back(new char[function->size_of_data()]);
+        places.push_back(memory.back().get());
+        function->create(places.back());
+    }
+    for (size_t row = 0; row < values->size(); ++row) {
+        function->add(places[row % 2], columns, row, nullptr);
+    }
+
+    auto buffer = ColumnString::create();
+    VectorBufferWriter writer(*buffer);
+    function->serialize(places[1], writer);
+    writer.commit();
+    VectorBufferReader reader(buffer->get_data_at(0));
+    function->deserialize(places[2], reader, nullptr);
+    function->merge(places[0], places[2], nullptr);
+
+    auto result = ColumnInt64::create();
+    function->insert_result_into(places[0], *result);
+    EXPECT_EQ(70000, result->get_element(0));
+    for (auto place : places) {
+        function->destroy(place);
+    }
+}
+
+} // namespace doris::vectorized
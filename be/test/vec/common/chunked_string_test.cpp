@@ -0,0 +1,71 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/chunked_string.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace doris::vectorized {
+
+namespace {
+
+std::string to_string(const ChunkedString& str) {
+    std::string res(str.size(), '\0');
+    str.copy_to(res.data());
+    return res;
+}
+
+} // namespace
+
+TEST(ChunkedStringTest, append) {
+    ChunkedString str;
+    EXPECT_TRUE(str.empty());
+    std::string expected;
+    for (size_t i = 0; i < 2000; ++i) {
+        std::string piece(i % 300, 'a' + i % 26);
+        str.append(piece.data(), piece.size());
+        expected += piece;
+    }
+    EXPECT_EQ(expected.size(), str.size());
+    EXPECT_EQ(expected, to_string(str));
+
+    size_t chunks = 0;
+    str.for_each_chunk([&chunks](const char*, size_t) { ++chunks; });
+    EXPECT_LT(chunks, 20);
+
+    ChunkedString copy;
+    copy.append(StringRef("x", 1));
+    copy.append(str);
+    EXPECT_EQ("x" + expected, to_string(copy));
+
+    str.clear();
+    EXPECT_TRUE(str.empty());
+    str.append("abc", 3);
+    EXPECT_EQ("abc", to_string(str));
+}
+
+TEST(ChunkedStringTest, append_uninitialized) {
+    ChunkedString str;
+    str.append("ab", 2);
+    memcpy(str.append_uninitialized(1000), std::string(1000, 'c').data(), 1000);
+    str.append("d", 1);
+    EXPECT_EQ("ab" + std::string(1000, 'c') + "d", to_string(str));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/aggregation_common.h"
+
+namespace doris::vectorized {
+
+// Every third value of the first column and every fifth of the third one are null.
+static Columns create_key_columns(size_t rows) {
+    auto first = ColumnInt32::create();
+    auto first_nulls = ColumnUInt8::create();
+    auto second = ColumnInt8::create();
+    auto third = ColumnInt16::create();
+    auto third_nulls = ColumnUInt8::create();
+    for (size_t i = 0; i < rows; ++i) {
+        first->insert_value(static_cast<Int32>(i * 7919));
+        first_nulls->insert_value(i % 3 == 0);
+        second->insert_value(static_cast<Int8>(i));
+        third->insert_value(static_cast<Int16>(i * 31));
+        third_nulls->insert_value(i % 5 == 0);
+    }
+    Columns columns;
+    columns.emplace_back(ColumnNullable::create(std::move(first), std::move(first_nulls)));
+    columns.emplace_back(std::move(second));
+    columns.emplace_back(ColumnNullable::create(std::move(third), std::move(third_nulls)));
+    return columns;
+}
+
+TEST(PackFixedKeysTest, not_nullable) {
+    const size_t rows = 100;
+    auto first = ColumnInt64::create();
+    auto second = ColumnInt32::create();
+    auto third = ColumnInt8::create();
+    for (size_t i = 0; i < rows; ++i) {
+        first->insert_value(static_cast<Int64>(i * 1000003));
+        second->insert_value(static_cast<Int32>(i * 17));
+        third->insert_value(static_cast<Int8>(i));
+    }
+    ColumnRawPtrs key_columns {first.get(), second.get(), third.get()};
+    Sizes key_sizes {8, 4, 1};
+
+    const size_t begin = 10;
+    std::vector<UInt128> keys(rows - begin);
+    pack_fixeds<UInt128, false>(begin, rows, key_columns, {}, key_sizes, keys.data());
+    for (size_t i = begin; i < rows; ++i) {
+        EXPECT_EQ(pack_fixed<UInt128>(i, key_columns.size(), key_columns, key_sizes),
+                  keys[i - begin]);
+    }
+}
+
+TEST(PackFixedKeysTest, nullable) {
+    const size_t rows = 100;
+    auto columns = create_key_columns(rows);
+    ColumnRawPtrs key_columns;
+    ColumnRawPtrs null_maps;
+    for (const auto& column : columns) {
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            key_columns.push_back(&nullable->get_nested_column());
+            null_maps.push_back(&nullable->get_null_map_column());
+        } else {
+            key_columns.push_back(column.get());
+            null_maps.push_back(nullptr);
+        }
+    }
+    Sizes key_sizes {4, 1, 2};
+
+    std::vector<UInt64> keys(rows);
+    pack_fixeds<UInt64, true>(0, rows, key_columns, null_maps, key_sizes, keys.data());
+    for (size_t i = 0; i < rows; ++i) {
+        KeysNullMap<UInt64> bitmap {};
+        for (size_t j = 0; j < null_maps.size(); ++j) {
+            if (null_maps[j] != nullptr &&
+                assert_cast<const ColumnUInt8&>(*null_maps[j]).get_data()[i]) {
+                bitmap[j / 8] |= UInt8(1) << (j % 8);
+            }
+        }
+        EXPECT_EQ(pack_fixed<UInt64>(i, key_columns.size(), key_columns, key_sizes, bitmap),
+                  keys[i]);
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,187 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/hash_table/partitioned_hash_table.h"
+
+#include <gtest/gtest.h>
+
+#include "vec/columns/columns_number.h"
+#include "vec/common/columns_hashing.h"
+#include "vec/common/hash_table/hash.h"
+
+namespace doris::vectorized {
+
+using TestHashMap = PartitionedHashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+
+static void fill(TestHashMap& map, size_t num) {
+    for (UInt64 i = 0; i < num; ++i) {
+        TestHashMap::LookupResult it;
+        bool inserted = false;
+        map.emplace(i, it, inserted);
+        EXPECT_TRUE(inserted);
+        new (lookup_result_get_mapped(it)) UInt64(i * 2);
+    }
+}
+
+TEST(PartitionedHashTableTest, single_partition) {
+    TestHashMap map;
+    EXPECT_EQ(1, map.get_partition_count());
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.begin() == map.end());
+
+    fill(map, 1000);
+    EXPECT_EQ(1000, map.size());
+    for (UInt64 i = 0; i < 1000; ++i) {
+        auto it = map.find(i);
+        ASSERT_NE(nullptr, it);
+        EXPECT_EQ(i * 2, *lookup_result_get_mapped(it));
+    }
+    EXPECT_EQ(nullptr, map.find(1000));
+}
+
+TEST(PartitionedHashTableTest, multiple_partitions) {
+    TestHashMap map;
+    map.init_partitions(3);
+    EXPECT_EQ(8, map.get_partition_count());
+
+    fill(map, 10000);
+    EXPECT_EQ(10000, map.size());
+
+    size_t partition_sizes = 0;
+    for (size_t i = 0; i < map.get_partition_count(); ++i) {
+        const auto& partition = map.get_partition(i);
+        partition_sizes += partition.size();
+        // every key lives in the partition selected by its hash
+        for (auto it = partition.begin(); it != partition.end(); ++it) {
+            EXPECT_EQ(i, map.get_partition_from_hash(map.hash(it->get_first())));
+        }
+    }
+    EXPECT_EQ(10000, partition_sizes);
+
+    for (UInt64 i = 0; i < 10000; ++i) {
+        auto it = map.find(i);
+        ASSERT_NE(nullptr, it);
+        EXPECT_EQ(i * 2, *lookup_result_get_mapped(it));
+    }
+    EXPECT_EQ(nullptr, map.find(10000));
+
+    // the iterator walks through all the partitions
+    size_t count = 0;
+    UInt64 sum = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        ++count;
+        sum += it->get_first();
+    }
+    EXPECT_EQ(10000, count);
+    EXPECT_EQ(10000 * 9999 / 2, sum);
+}
+
+TEST(PartitionedHashTableTest, zero_key) {
+    TestHashMap map;
+    map.init_partitions(2);
+    fill(map, 10);
+    EXPECT_NE(nullptr, map.find(0));
+    map.delete_zero_key(0);
+    EXPECT_EQ(nullptr, map.find(0));
+    EXPECT_EQ(9, map.size());
+}
+
+TEST(PartitionedHashTableTest, move) {
+    TestHashMap map;
+    map.init_partitions(2);
+    fill(map, 100);
+
+    TestHashMap other;
+    other = std::move(map);
+    EXPECT_EQ(4, other.get_partition_count());
+    EXPECT_EQ(100, other.size());
+    EXPECT_EQ(1, map.get_partition_count());
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(PartitionedHashTableTest, convert_to_partitioned) {
+    TestHashMap map;
+    fill(map, 10000);
+    EXPECT_FALSE(map.is_partitioned());
+
+    map.convert_to_partitioned();
+    EXPECT_TRUE(map.is_partitioned());
+    EXPECT_EQ(TestHashMap::MAX_PARTITIONS, map.get_partition_count());
+    EXPECT_EQ(10000, map.size());
+    // the zero key is moved too
+    for (UInt64 i = 0; i < 10000; ++i) {
+        auto it = map.find(i);
+        ASSERT_NE(nullptr, it);
+        EXPECT_EQ(i * 2, *lookup_result_get_mapped(it));
+    }
+
+    // new keys go to the partitions of their hash
+    TestHashMap::LookupResult it;
+    bool inserted = false;
+    map.emplace(10000, it, inserted);
+    EXPECT_TRUE(inserted);
+    new (lookup_result_get_mapped(it)) UInt64(0);
+    EXPECT_EQ(10001, map.size());
+
+    UInt64 sum = 0;
+    map.for_each_mapped([&](UInt64& mapped) { sum += mapped; });
+    EXPECT_EQ(10000 * 9999, sum);
+}
+
+TEST(PartitionedHashTableTest, batched_lookups) {
+    using KeyGetter = ColumnsHashing::HashMethodOneNumber<TestHashMap::value_type, UInt64, UInt64,
+                                                          false>;
+    TestHashMap map;
+    map.init_partitions(2);
+    Arena arena;
+
+    // every key is inserted twice
+    auto keys = ColumnUInt64::create();
+    for (UInt64 i = 0; i < 1000; ++i) {
+        keys->insert_value(i % 500);
+    }
+    ColumnRawPtrs key_columns {keys.get()};
+    KeyGetter build_getter(key_columns, {}, nullptr);
+    build_getter.init_hash_values(map, 0, keys->size(), arena);
+    for (size_t row = 0; row < keys->size(); ++row) {
+        EXPECT_EQ(map.hash(keys->get_element(row)), build_getter.get_hash_value(row));
+        auto result = build_getter.emplace_key_batched(map, row, arena);
+        EXPECT_EQ(row < 500, result.is_inserted());
+        if (result.is_inserted()) {
+            result.set_mapped(row * 2);
+        }
+    }
+    EXPECT_EQ(500, map.size());
+
+    // the lookups of the rows from 100 on
+    auto probe_keys = ColumnUInt64::create();
+    for (UInt64 i = 0; i < 1000; ++i) {
+        probe_keys->insert_value(i);
+    }
+    ColumnRawPtrs probe_columns {probe_keys.get()};
+    KeyGetter probe_getter(probe_columns, {}, nullptr);
+    probe_getter.init_hash_values(map, 100, probe_keys->size(), arena);
+    for (size_t row = 100; row < probe_keys->size(); ++row) {
+        auto result = probe_getter.find_key_batched(map, row, arena);
+        ASSERT_EQ(row < 500, result.is_found());
+        if (result.is_found()) {
+            EXPECT_EQ(row * 2, result.get_mapped());
+        }
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/string_searcher.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace doris {
+
+namespace {
+
+// Returns the offset of the first occurrence of needle in haystack, or -1 if not found.
+int64_t search(const std::string& haystack, const std::string& needle) {
+    ASCIICaseSensitiveStringSearcher searcher(needle.data(), needle.size());
+    const char* end = haystack.data() + haystack.size();
+    const char* pos = searcher.search(haystack.data(), end);
+    return pos == end ? -1 : pos - haystack.data();
+}
+
+} // namespace
+
+TEST(StringSearcherTest, positions) {
+    for (const std::string needle : {"x", "xy", "xyz", "abcdefghijklmnopqrstuvwxyz0123456789"}) {
+        for (size_t size = needle.size(); size < 200; ++size) {
+            for (size_t offset = 0; offset + needle.size() <= size; offset += 7) {
+                std::string haystack(size, '-');
+                haystack.replace(offset, needle.size(), needle);
+                EXPECT_EQ(offset, search(haystack, needle)) << size << " " << offset;
+            }
+        }
+    }
+}
+
+TEST(StringSearcherTest, first_and_last_candidates) {
+    // the first and last characters match at many positions, the middle only at the end
+    std::string haystack;
+    for (int i = 0; i < 20; ++i) {
+        haystack += "a-a-b-";
+    }
+    EXPECT_EQ(-1, search(haystack, "a-c-b"));
+    haystack += "a-c-b-";
+    EXPECT_EQ(haystack.size() - 6, search(haystack, "a-c-b"));
+    EXPECT_EQ(0, search(haystack, "a-a"));
+}
+
+TEST(StringSearcherTest, not_found) {
+    EXPECT_EQ(-1, search("", "x"));
+    EXPECT_EQ(-1, search("xy", "xyz"));
+    EXPECT_EQ(-1, search(std::string(100, 'x'), "xy"));
+    EXPECT_EQ(-1, search(std::string(100, 'x') + "x\\y", "xy"));
+    EXPECT_EQ(0, search("abc", ""));
+}
+
+} // namespace doris
@@ -0,0 +1,160 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "common/config.h"
+#include "util/file_utils.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/core/block_spill_manager.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class BlockSpillTest : public testing::Test {
+public:
+    void SetUp() override {
+        if (FileUtils::check_exist(TEST_DIR)) {
+            EXPECT_TRUE(FileUtils::remove_all(TEST_DIR).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(TEST_DIR).ok());
+    }
+
+    void TearDown() override { EXPECT_TRUE(FileUtils::remove_all(TEST_DIR).ok()); }
+
+    static Block create_block(int rows) {
+        auto int_column = ColumnInt32::create();
+        auto str_column = ColumnString::create();
+        auto null_map = ColumnUInt8::create();
+        for (int i = 0; i < rows; ++i) {
+            int_column->insert_value(i);
+            auto str = std::to_string(i);
+            str_column->insert_data(str.data(), str.size());
+            null_map->insert_value(i % 7 == 0);
+        }
+        auto nullable_column = ColumnNullable::create(std::move(str_column), std::move(null_map));
+
+        Block block;
+        block.insert({std::move(int_column), std::make_shared<DataTypeInt32>(), "k1"});
+        block.insert({std::move(nullable_column),
+                      make_nullable(std::make_shared<DataTypeString>()), "v1"});
+        return block;
+    }
+
+    static const std::string TEST_DIR;
+};
+
+const std::string BlockSpillTest::TEST_DIR = "./ut_dir/block_spill_test";
+
+TEST_F(BlockSpillTest, write_and_read) {
+    const std::string path = TEST_DIR + "/spill_0";
+    auto block = create_block(10000);
+
+    BlockSpillWriter writer(path, 4096);
+    EXPECT_TRUE(writer.open().ok());
+    EXPECT_TRUE(writer.write(block).ok());
+    EXPECT_TRUE(writer.write(create_block(0)).ok());
+    EXPECT_TRUE(writer.close().ok());
+    EXPECT_EQ(10000, writer.written_rows());
+    EXPECT_EQ(3, writer.written_blocks());
+
+    BlockSpillReader reader(path);
+    EXPECT_TRUE(reader.open().ok());
+    std::vector<size_t> rows;
+    size_t offset = 0;
+    bool eos = false;
+    while (!eos) {
+        Block read_block;
+        EXPECT_TRUE(reader.read(&read_block, &eos).ok());
+        if (eos) {
+            break;
+        }
+        rows.push_back(read_block.rows());
+        ASSERT_EQ(2, read_block.columns());
+        for (size_t i = 0; i < read_block.rows(); ++i, ++offset) {
+            EXPECT_EQ(0, read_block.compare_at(i, offset, block, 1));
+        }
+    }
+    EXPECT_EQ((std::vector<size_t> {4096, 4096, 1808}), rows);
+    EXPECT_TRUE(reader.close().ok());
+    EXPECT_FALSE(FileUtils::check_exist(path));
+}
+
+TEST_F(BlockSpillTest, abort) {
+    const std::string path = TEST_DIR + "/spill_1";
+    {
+        BlockSpillWriter writer(path, 1024);
+        EXPECT_TRUE(writer.open().ok());
+        EXPECT_TRUE(writer.write(create_block(100)).ok());
+        EXPECT_TRUE(writer.close().ok());
+        EXPECT_TRUE(FileUtils::check_exist(path));
+        EXPECT_TRUE(writer.abort().ok());
+    }
+    EXPECT_FALSE(FileUtils::check_exist(path));
+
+    {
+        // a writer which is not closed removes its file on destruction
+        BlockSpillWriter writer(path, 1024);
+        EXPECT_TRUE(writer.open().ok());
+        EXPECT_TRUE(writer.write(create_block(100)).ok());
+    }
+    EXPECT_FALSE(FileUtils::check_exist(path));
+}
+
+TEST_F(BlockSpillTest, spill_quota) {
+    const std::string path = TEST_DIR + "/spill_2";
+    int64_t spilled_bytes = BlockSpillManager::spilled_bytes();
+    {
+        BlockSpillWriter writer(path, 1024);
+        EXPECT_TRUE(writer.open().ok());
+        EXPECT_TRUE(writer.write(create_block(100)).ok());
+        EXPECT_TRUE(writer.close().ok());
+        EXPECT_EQ(spilled_bytes + writer.written_bytes(), BlockSpillManager::spilled_bytes());
+
+        // the bytes are released by the reader removing the file
+        BlockSpillReader reader(path);
+        EXPECT_TRUE(reader.open().ok());
+        EXPECT_TRUE(reader.close().ok());
+        EXPECT_EQ(spilled_bytes, BlockSpillManager::spilled_bytes());
+        EXPECT_TRUE(writer.abort().ok());
+        EXPECT_EQ(spilled_bytes, BlockSpillManager::spilled_bytes());
+    }
+
+    // a spill beyond the limit fails
+    int64_t limit = config::spill_storage_limit_bytes;
+    config::spill_storage_limit_bytes = spilled_bytes + 1;
+    {
+        BlockSpillWriter writer(path, 1024);
+        EXPECT_TRUE(writer.open().ok());
+        EXPECT_FALSE(writer.write(create_block(100)).ok());
+    }
+    config::spill_storage_limit_bytes = limit;
+    EXPECT_EQ(spilled_bytes, BlockSpillManager::spilled_bytes());
+    EXPECT_FALSE(FileUtils::check_exist(path));
+}
+
+} // namespace doris::vectorized
@@ -28,6 +28,8 @@
 #include "runtime/row_batch.h"
 #include "runtime/string_value.h"
 #include "runtime/tuple_row.h"
+#include "service/brpc.h"
+#include "util/block_compression.h"
 #include "vec/columns/column_decimal.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/columns/column_string.h"
@@ -411,6 +413,103 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
     }
 }
 
+TEST(BlockTest, SerializeAndDeserializeBlockWithCodecs) {
+    config::compress_rowbatches = true;
+    auto vec = vectorized::ColumnVector<Int32>::create();
+    auto strcol = vectorized::ColumnString::create();
+    for (int i = 0; i < 1024; ++i) {
+        vec->get_data().push_back(i % 16);
+        std::string is = std::to_string(i % 16);
+        strcol->insert_data(is.c_str(), is.size());
+    }
+    vectorized::DataTypePtr int32_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::DataTypePtr string_type(std::make_shared<vectorized::DataTypeString>());
+    vectorized::ColumnWithTypeAndName test_int(vec->get_ptr(), int32_type, "test_int");
+    vectorized::ColumnWithTypeAndName test_string(strcol->get_ptr(), string_type, "test_string");
+    vectorized::Block block({test_int, test_string});
+
+    for (auto type : {segment_v2::CompressionTypePB::NO_COMPRESSION,
+                      segment_v2::CompressionTypePB::SNAPPY, segment_v2::CompressionTypePB::LZ4,
+                      segment_v2::CompressionTypePB::ZSTD}) {
+        PBlock pblock;
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        Status st = block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes, false, type);
+        EXPECT_TRUE(st.ok());
+        EXPECT_EQ(compressed_bytes, pblock.column_values().size());
+        if (type == segment_v2::CompressionTypePB::NO_COMPRESSION) {
+            EXPECT_FALSE(pblock.compressed());
+            EXPECT_EQ(uncompressed_bytes, compressed_bytes);
+        } else {
+            EXPECT_TRUE(pblock.compressed());
+            EXPECT_EQ(type, pblock.compression_type());
+            EXPECT_LT(compressed_bytes, uncompressed_bytes);
+        }
+
+        vectorized::Block block2(pblock);
+        EXPECT_EQ(block.dump_data(), block2.dump_data());
+    }
+
+    // the blocks of older senders are snappy without the uncompressed size
+    PBlock pblock;
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    Status st = block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes);
+    EXPECT_TRUE(st.ok());
+    pblock.clear_compression_type();
+    pblock.clear_uncompressed_size();
+    vectorized::Block block2(pblock);
+    EXPECT_EQ(block.dump_data(), block2.dump_data());
+
+    segment_v2::CompressionTypePB type;
+    EXPECT_TRUE(get_block_compression_type("ZSTD", &type).ok());
+    EXPECT_EQ(segment_v2::CompressionTypePB::ZSTD, type);
+    EXPECT_TRUE(get_block_compression_type("none", &type).ok());
+    EXPECT_EQ(segment_v2::CompressionTypePB::NO_COMPRESSION, type);
+    EXPECT_FALSE(get_block_compression_type("brotli", &type).ok());
+}
+
+TEST(BlockTest, SerializeAndDeserializeBlockByAttachment) {
+    config::compress_rowbatches = true;
+    auto vec = vectorized::ColumnVector<Int32>::create();
+    auto strcol = vectorized::ColumnString::create();
+    for (int i = 0; i < 4096; ++i) {
+        vec->get_data().push_back(i);
+        std::string is = std::to_string(i);
+        strcol->insert_data(is.c_str(), is.size());
+    }
+    vectorized::DataTypePtr int32_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::DataTypePtr string_type(std::make_shared<vectorized::DataTypeString>());
+    vectorized::ColumnWithTypeAndName test_int(vec->get_ptr(), int32_type, "test_int");
+    vectorized::ColumnWithTypeAndName test_string(strcol->get_ptr(), string_type, "test_string");
+    vectorized::Block block({test_int, test_string});
+
+    for (auto type : {segment_v2::CompressionTypePB::NO_COMPRESSION,
+                      segment_v2::CompressionTypePB::LZ4}) {
+        PBlock pblock;
+        butil::IOBuf column_values;
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        Status st = block.serialize(&pblock, &column_values, &uncompressed_bytes,
+                                    &compressed_bytes, type);
+        EXPECT_TRUE(st.ok());
+        EXPECT_FALSE(pblock.has_column_values());
+        EXPECT_EQ(compressed_bytes, column_values.size());
+        EXPECT_EQ(type != segment_v2::CompressionTypePB::NO_COMPRESSION, pblock.compressed());
+
+        vectorized::Block block2(pblock, column_values);
+        EXPECT_EQ(block.dump_data(), block2.dump_data());
+
+        // the column values received from the network are split into several buffers
+        butil::IOBuf split_values;
+        column_values.cutn(&split_values, column_values.size() / 2);
+        split_values.append(column_values);
+        EXPECT_GT(split_values.backing_block_num(), 1u);
+        vectorized::Block block3(pblock, split_values);
+        EXPECT_EQ(block.dump_data(), block3.dump_data());
+    }
+}
+
 TEST(BlockTest, dump_data) {
     auto vec = vectorized::ColumnVector<Int32>::create();
     auto& int32_data = vec->get_data();
@@ -0,0 +1,94 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "util/cpu_info.h"
+#include "vec/common/assert_cast.h"
+#include "vec/columns/columns_common.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+IColumn::Filter make_filter(size_t size, int seed) {
+    IColumn::Filter filter(size);
+    for (size_t i = 0; i < size; ++i) {
+        // runs of passing and failing rows, mixed with single rows
+        filter[i] = (i / 70 + seed) % 3 == 0 || (i * 7 + seed) % 5 == 0;
+    }
+    return filter;
+}
+
+template <typename Column>
+void check_filter(size_t size, int seed) {
+    auto column = Column::create();
+    for (size_t i = 0; i < size; ++i) {
+        column->insert_value(i * 3 % 127);
+    }
+    auto filter = make_filter(size, seed);
+    auto filtered = column->filter(filter, -1);
+    const auto& filtered_data = assert_cast<const Column&>(*filtered).get_data();
+    size_t passed = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (filter[i]) {
+            ASSERT_TRUE(column->get_data()[i] == filtered_data[passed]);
+            ++passed;
+        }
+    }
+    EXPECT_EQ(passed, filtered->size());
+    EXPECT_EQ(passed, count_bytes_in_filter(filter));
+
+    if (size <= 65535) {
+        std::vector<uint16_t> sel(size);
+        uint16_t sel_size = filter_to_selection(filter.data(), size, sel.data());
+        ASSERT_EQ(passed, sel_size);
+        for (size_t i = 0, pos = 0; i < size; ++i) {
+            if (filter[i]) {
+                EXPECT_EQ(i, sel[pos++]);
+            }
+        }
+    }
+}
+
+void check_all_filters() {
+    for (size_t size : {0, 1, 31, 64, 65, 1000, 4096, 70000}) {
+        for (int seed = 0; seed < 3; ++seed) {
+            check_filter<ColumnInt8>(size, seed);
+            check_filter<ColumnInt16>(size, seed);
+            check_filter<ColumnInt32>(size, seed);
+            check_filter<ColumnInt64>(size, seed);
+            check_filter<ColumnFloat64>(size, seed);
+            check_filter<ColumnInt128>(size, seed);
+        }
+    }
+}
+
+} // namespace
+
+// The values kept by the filters must be the same with and without the VPCOMPRESS kernels.
+TEST(ColumnFilterTest, filter_count_and_select) {
+    check_all_filters();
+    CpuInfo::TempDisable disable_avx512(CpuInfo::AVX512VBMI2);
+    EXPECT_FALSE(is_compress_filter_supported());
+    check_all_filters();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_fixed_length_object.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "vec/data_types/data_type_fixed_length_object.h"
+
+namespace doris::vectorized {
+
+TEST(ColumnFixedLengthObjectTest, InsertAndFilter) {
+    auto column = ColumnFixedLengthObject::create(sizeof(int64_t));
+    for (int64_t i = 0; i < 5; ++i) {
+        column->insert_data(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+    EXPECT_EQ(column->size(), 5);
+    EXPECT_EQ(column->byte_size(), 5 * sizeof(int64_t));
+
+    IColumn::Filter filter = {1, 0, 1, 0, 1};
+    auto filtered = column->filter(filter, 3);
+    ASSERT_EQ(filtered->size(), 3);
+    for (size_t i = 0; i < filtered->size(); ++i) {
+        StringRef ref = filtered->get_data_at(i);
+        EXPECT_EQ(ref.size, sizeof(int64_t));
+        EXPECT_EQ(*reinterpret_cast<const int64_t*>(ref.data), static_cast<int64_t>(i * 2));
+    }
+}
+
+TEST(ColumnFixedLengthObjectTest, SerializeRoundTrip) {
+    struct State {
+        int64_t sum;
+        int64_t count;
+    };
+    auto column = ColumnFixedLengthObject::create(sizeof(State));
+    for (int64_t i = 0; i < 3; ++i) {
+        State state {i * 10, i + 1};
+        column->insert_data(reinterpret_cast<const char*>(&state), sizeof(state));
+    }
+
+    DataTypeFixedLengthObject type;
+    std::string buf(type.get_uncompressed_serialized_bytes(*column), '\0');
+    char* end = type.serialize(*column, buf.data());
+    EXPECT_EQ(static_cast<size_t>(end - buf.data()), buf.size());
+
+    // the item size is not known until the data is read
+    auto res = type.create_column();
+    type.deserialize(buf.data(), res.get());
+    auto& res_column = assert_cast<ColumnFixedLengthObject&>(*res);
+    EXPECT_EQ(res_column.item_size(), sizeof(State));
+    ASSERT_EQ(res_column.size(), 3);
+    for (int64_t i = 0; i < 3; ++i) {
+        auto state = reinterpret_cast<const State*>(res_column.get_data_at(i).data);
+        EXPECT_EQ(state->sum, i * 10);
+        EXPECT_EQ(state->count, i + 1);
+    }
+}
+
+} // namespace doris::vectorized
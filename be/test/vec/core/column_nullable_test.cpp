@@ -24,6 +24,7 @@
 #include <string>
 
 #include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
 #include "vec/common/sip_hash.h"
 
 namespace doris::vectorized {
@@ -50,4 +51,59 @@ TEST(ColumnNullableTest, HashTest) {
     EXPECT_NE(hashes[0].get64(), hashes[1].get64());
 }
 
+// The columns with and without nulls must give the same rows whether or not their null map is
+// filtered, permuted or replicated.
+TEST(ColumnNullableTest, FilterPermuteReplicateTest) {
+    for (bool with_nulls : {false, true}) {
+        auto nested = ColumnVector<int>::create();
+        auto null_map = ColumnUInt8::create();
+        for (int i = 0; i < 100; ++i) {
+            nested->insert_value(i);
+            null_map->insert_value(with_nulls && i % 3 == 0);
+        }
+        auto column = ColumnNullable::create(std::move(nested), std::move(null_map));
+
+        IColumn::Filter filter(100);
+        IColumn::Permutation perm(100);
+        IColumn::Offsets offsets(100);
+        for (int i = 0; i < 100; ++i) {
+            filter[i] = i % 2;
+            perm[i] = 99 - i;
+            offsets[i] = (i == 0 ? 0 : offsets[i - 1]) + i % 3;
+        }
+
+        auto filtered = column->filter(filter, -1);
+        ASSERT_EQ(50, filtered->size());
+        for (size_t i = 0; i < filtered->size(); ++i) {
+            int row = i * 2 + 1;
+            EXPECT_EQ(with_nulls && row % 3 == 0, filtered->is_null_at(i));
+            EXPECT_EQ(row, assert_cast<const ColumnNullable&>(*filtered)
+                                   .get_nested_column()
+                                   .get_int(i));
+        }
+
+        auto permuted = column->permute(perm, 0);
+        ASSERT_EQ(100, permuted->size());
+        for (size_t i = 0; i < permuted->size(); ++i) {
+            EXPECT_EQ(column->is_null_at(99 - i), permuted->is_null_at(i));
+        }
+
+        auto replicated = column->replicate(offsets);
+        ASSERT_EQ(offsets.back(), replicated->size());
+        for (size_t i = 0, row = 0; row < 100; ++row) {
+            for (; i < offsets[row]; ++i) {
+                EXPECT_EQ(column->is_null_at(row), replicated->is_null_at(i));
+            }
+        }
+
+        uint16_t sel[] = {1, 3, 6, 9};
+        auto selected = ColumnNullable::create(ColumnVector<int>::create(), ColumnUInt8::create());
+        EXPECT_TRUE(column->filter_by_selector(sel, 4, selected.get()).ok());
+        ASSERT_EQ(4, selected->size());
+        for (size_t i = 0; i < 4; ++i) {
+            EXPECT_EQ(column->is_null_at(sel[i]), selected->is_null_at(i));
+        }
+    }
+}
+
 } // namespace doris::vectorized
@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_block.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+static Block make_block(size_t rows) {
+    std::mt19937 rng(42);
+    auto a = ColumnInt32::create();
+    auto a_null = ColumnUInt8::create();
+    auto b = ColumnInt64::create();
+    auto c = ColumnUInt8::create();
+    for (size_t i = 0; i < rows; ++i) {
+        a->insert_value(static_cast<Int32>(rng() % 21) - 10);
+        a_null->insert_value(rng() % 7 == 0);
+        b->insert_value(static_cast<Int64>(rng() % 5) - 2);
+        c->insert_value(rng() % 2);
+    }
+    Block block;
+    block.insert({ColumnNullable::create(std::move(a), std::move(a_null)),
+                  make_nullable(std::make_shared<DataTypeInt32>()), "a"});
+    block.insert({std::move(b), std::make_shared<DataTypeInt64>(), "b"});
+    block.insert({std::move(c), std::make_shared<DataTypeUInt8>(), "c"});
+    return block;
+}
+
+// the sort of the normalized keys sorts the rows in the order of the compare of their columns
+static void check_sort(size_t rows, const SortDescription& description, UInt64 limit) {
+    Block expected = make_block(rows);
+    stable_sort_block(expected, description);
+    Block block = make_block(rows);
+    sort_block(block, description, limit);
+
+    size_t sorted_rows = limit != 0 && limit < rows ? limit : rows;
+    for (size_t i = 0; i < sorted_rows; ++i) {
+        for (const auto& column : description) {
+            const auto& actual_column = *block.get_by_position(column.column_number).column;
+            const auto& expected_column = *expected.get_by_position(column.column_number).column;
+            ASSERT_EQ(0, actual_column.compare_at(i, i, expected_column, column.nulls_direction))
+                    << "row " << i << " column " << column.column_number;
+        }
+    }
+}
+
+TEST(SortBlockTest, normalized_keys) {
+    for (size_t rows : {100, 1000}) {
+        check_sort(rows, {{0, 1, 1}, {1, 1, 1}}, 0);
+        check_sort(rows, {{0, -1, 1}, {1, 1, -1}}, 0);
+        check_sort(rows, {{0, 1, -1}, {1, -1, 1}, {2, -1, -1}}, 0);
+        check_sort(rows, {{2, 1, 1}, {1, -1, -1}, {0, -1, -1}}, 10);
+    }
+}
+
+} // namespace doris::vectorized
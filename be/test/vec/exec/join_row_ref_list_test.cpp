@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "vec/exec/join/join_op.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+std::vector<std::pair<uint32_t, uint8_t>> collect_rows(RowRefList& list) {
+    std::vector<std::pair<uint32_t, uint8_t>> rows;
+    for (auto it = list.begin(); it.ok(); ++it) {
+        rows.emplace_back(it->row_num, it->block_offset);
+    }
+    return rows;
+}
+
+} // namespace
+
+// A compacted list must iterate the same rows in the same order as before, and the visited flags
+// set through the iterator must stay on its rows.
+TEST(RowRefListTest, compact) {
+    Arena arena;
+    for (size_t count : {1, 2, 8, 9, 100}) {
+        RowRefList list(0, 0);
+        for (size_t i = 1; i < count; ++i) {
+            list.insert({i, static_cast<uint8_t>(i % 3)}, arena);
+        }
+        auto expected = collect_rows(list);
+        ASSERT_EQ(count, expected.size());
+
+        list.compact(arena);
+        EXPECT_EQ(expected, collect_rows(list));
+        EXPECT_EQ(count, list.get_row_count());
+
+        size_t visited = 0;
+        for (auto it = list.begin(); it.ok(); ++it) {
+            it->visited = it->row_num % 2 == 0;
+        }
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            visited += it->visited;
+        }
+        EXPECT_EQ((count + 1) / 2, visited);
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arena.h"
+#include "vec/exec/vaggregation_node.h"
+
+namespace doris::vectorized {
+
+TEST(AggregationKeyDictionaryTest, encode_and_decode) {
+    Arena arena;
+    AggregationKeyDictionary dictionary;
+
+    auto strings = ColumnString::create();
+    for (const auto* value : {"b", "a", "b", "b", "", "a"}) {
+        strings->insert_data(value, strlen(value));
+    }
+    ColumnUInt32::Container codes;
+    dictionary.encode(*strings, codes, arena);
+    ASSERT_EQ(6, codes.size());
+    EXPECT_EQ(0, codes[0]);
+    EXPECT_EQ(1, codes[1]);
+    EXPECT_EQ(0, codes[2]);
+    EXPECT_EQ(0, codes[3]);
+    EXPECT_EQ(2, codes[4]);
+    EXPECT_EQ(1, codes[5]);
+
+    // The codes stay the same across blocks.
+    auto more_strings = ColumnString::create();
+    more_strings->insert_data("c", 1);
+    more_strings->insert_data("a", 1);
+    ColumnUInt32::Container more_codes;
+    dictionary.encode(*more_strings, more_codes, arena);
+    EXPECT_EQ(3, more_codes[0]);
+    EXPECT_EQ(1, more_codes[1]);
+
+    auto decoded = ColumnString::create();
+    dictionary.decode(codes, nullptr, *decoded);
+    ASSERT_EQ(strings->size(), decoded->size());
+    for (size_t i = 0; i < strings->size(); ++i) {
+        EXPECT_EQ(strings->get_data_at(i), decoded->get_data_at(i));
+    }
+
+    NullMap null_map = {0, 1};
+    auto nullable_decoded = ColumnString::create();
+    dictionary.decode(more_codes, &null_map, *nullable_decoded);
+    ASSERT_EQ(2, nullable_decoded->size());
+    EXPECT_EQ(StringRef("c", 1), nullable_decoded->get_data_at(0));
+    EXPECT_EQ(0, nullable_decoded->get_data_at(1).size);
+}
+
+} // namespace doris::vectorized
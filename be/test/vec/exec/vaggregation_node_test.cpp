@@ -0,0 +1,169 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vaggregation_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
+#include "testutil/mock_exec_node.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+using Rows = std::vector<std::pair<std::optional<int64_t>, std::optional<int64_t>>>;
+
+class VAggregationNodeTest : public testing::Test {
+public:
+    VAggregationNodeTest() : _state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+        DescriptorTblBuilder builder(&_pool);
+        // the input (k, v), and the intermediate and output (k, sum(v)) of the aggregation
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT;
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT;
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT;
+        _desc_tbl = builder.build();
+        _state.set_desc_tbl(_desc_tbl);
+    }
+
+protected:
+    static Block create_block(const Rows& rows) {
+        auto k = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+        auto v = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+        for (auto& [key, value] : rows) {
+            key ? k->insert(Field(*key)) : k->insert_default();
+            value ? v->insert(Field(*value)) : v->insert_default();
+        }
+        auto type = make_nullable(std::make_shared<DataTypeInt64>());
+        Block block;
+        block.insert({std::move(k), type, "k"});
+        block.insert({std::move(v), type, "v"});
+        return block;
+    }
+
+    // Runs `select k, sum(v) group by k` over `blocks` and returns its rows as "k:sum".
+    std::vector<std::string> aggregate(const std::vector<Rows>& blocks, bool sorted_input) {
+        std::vector<Block> input;
+        for (auto& rows : blocks) {
+            input.push_back(create_block(rows));
+        }
+        TPlanNode child_tnode = create_plan_node(0, TPlanNodeType::EXCHANGE_NODE, {0}, 0);
+        auto* child =
+                _pool.add(new MockBlockNode(&_pool, child_tnode, *_desc_tbl, std::move(input)));
+        EXPECT_TRUE(child->init(child_tnode, &_state).ok());
+
+        const auto* input_tuple = _desc_tbl->get_tuple_descriptor(0);
+        TPlanNode tnode = create_plan_node(1, TPlanNodeType::AGGREGATION_NODE, {2}, 1);
+        tnode.__isset.agg_node = true;
+        tnode.agg_node.__set_grouping_exprs({create_slot_ref(input_tuple->slots()[0])});
+        tnode.agg_node.aggregate_functions.push_back(
+                create_agg_fn("sum", input_tuple->slots()[1], TypeDescriptor(TYPE_BIGINT)));
+        tnode.agg_node.intermediate_tuple_id = 1;
+        tnode.agg_node.output_tuple_id = 2;
+        tnode.agg_node.need_finalize = true;
+        if (sorted_input) {
+            tnode.agg_node.__set_is_input_sorted_by_group_keys(true);
+        }
+        auto* node = _pool.add(new AggregationNode(&_pool, tnode, *_desc_tbl));
+        node->_children.push_back(child);
+        EXPECT_TRUE(node->init(tnode, &_state).ok());
+        EXPECT_TRUE(node->prepare(&_state).ok());
+        EXPECT_EQ(sorted_input, node->_is_sorted_input);
+        EXPECT_TRUE(node->open(&_state).ok());
+
+        std::vector<std::string> result;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node->get_next(&_state, &block, &eos).ok());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                auto& k = block.get_by_position(0);
+                auto& sum = block.get_by_position(1);
+                result.push_back(k.type->to_string(*k.column, row) + ":" +
+                                 sum.type->to_string(*sum.column, row));
+            }
+        }
+        EXPECT_TRUE(node->close(&_state).ok());
+        return result;
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    DescriptorTbl* _desc_tbl = nullptr;
+};
+
+TEST_F(VAggregationNodeTest, sorted_input) {
+    // groups span blocks, a block holds only a part of a group, the null keys come first
+    std::vector<Rows> blocks = {{{std::nullopt, 1}, {std::nullopt, 2}, {1, 3}},
+                                {{1, 4}},
+                                {},
+                                {{1, std::nullopt}, {2, 5}, {3, 6}, {3, 7}},
+                                {{4, std::nullopt}},
+                                {{5, 8}, {5, 9}}};
+    std::vector<std::string> expected = {"NULL:3", "1:7", "2:5", "3:13", "4:NULL", "5:17"};
+    // the groups come out in the order of the input
+    EXPECT_EQ(expected, aggregate(blocks, true));
+
+    auto hashed = aggregate(blocks, false);
+    std::sort(hashed.begin(), hashed.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, hashed);
+}
+
+TEST_F(VAggregationNodeTest, sorted_input_of_one_group) {
+    std::vector<Rows> blocks = {{{7, 1}, {7, 2}}, {{7, 3}}, {{7, 4}}};
+    EXPECT_EQ(std::vector<std::string> {"7:10"}, aggregate(blocks, true));
+}
+
+TEST_F(VAggregationNodeTest, empty_sorted_input) {
+    EXPECT_TRUE(aggregate({}, true).empty());
+    EXPECT_TRUE(aggregate({{}, {}}, true).empty());
+}
+
+// Only a one-phase aggregation of the raw rows streams a sorted input.
+TEST_F(VAggregationNodeTest, sorted_input_of_a_preaggregation) {
+    TPlanNode tnode = create_plan_node(1, TPlanNodeType::AGGREGATION_NODE, {2}, 1);
+    const auto* input_tuple = _desc_tbl->get_tuple_descriptor(0);
+    tnode.__isset.agg_node = true;
+    tnode.agg_node.__set_grouping_exprs({create_slot_ref(input_tuple->slots()[0])});
+    tnode.agg_node.aggregate_functions.push_back(
+            create_agg_fn("sum", input_tuple->slots()[1], TypeDescriptor(TYPE_BIGINT)));
+    tnode.agg_node.intermediate_tuple_id = 1;
+    tnode.agg_node.output_tuple_id = 2;
+    tnode.agg_node.need_finalize = false;
+    tnode.agg_node.__set_is_input_sorted_by_group_keys(true);
+
+    TPlanNode child_tnode = create_plan_node(0, TPlanNodeType::EXCHANGE_NODE, {0}, 0);
+    auto* child = _pool.add(new MockBlockNode(&_pool, child_tnode, *_desc_tbl, {}));
+    ASSERT_TRUE(child->init(child_tnode, &_state).ok());
+    auto* node = _pool.add(new AggregationNode(&_pool, tnode, *_desc_tbl));
+    node->_children.push_back(child);
+    ASSERT_TRUE(node->init(tnode, &_state).ok());
+    ASSERT_TRUE(node->prepare(&_state).ok());
+    EXPECT_FALSE(node->_is_sorted_input);
+    EXPECT_TRUE(node->close(&_state).ok());
+}
+
+} // namespace doris::vectorized
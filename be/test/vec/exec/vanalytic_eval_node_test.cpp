@@ -0,0 +1,222 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vanalytic_eval_node.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "common/config.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
+#include "testutil/mock_exec_node.h"
+#include "util/threadpool.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+// the input rows (k, o, v), sorted by k and o
+using Rows = std::vector<std::tuple<std::optional<int64_t>, int64_t, std::optional<int64_t>>>;
+
+class VAnalyticEvalNodeTest : public testing::Test {
+public:
+    VAnalyticEvalNodeTest() : _state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+        DescriptorTblBuilder builder(&_pool);
+        // the input (k, o, v), the intermediate and output (sum(v), max(v)) and the buffered
+        // tuple of the analytic node
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT << TYPE_BIGINT;
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT;
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT;
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT << TYPE_BIGINT;
+        _desc_tbl = builder.build();
+        _state.set_desc_tbl(_desc_tbl);
+    }
+
+    void SetUp() override { _saved_thread_num = config::analytic_eval_thread_num; }
+
+    void TearDown() override {
+        config::analytic_eval_thread_num = _saved_thread_num;
+        ExecEnv::GetInstance()->_parallel_operator_thread_pool.reset();
+    }
+
+protected:
+    // 40 partitions of 1 to 11 rows with duplicated order by values and null values, the first
+    // one of the null keys, cut into blocks of 1 to 13 rows
+    static std::vector<Block> create_input() {
+        Rows rows;
+        for (int64_t i = 0; i < 40; ++i) {
+            std::optional<int64_t> k = i == 0 ? std::nullopt : std::optional<int64_t>(i);
+            for (int64_t j = 0; j < (i * 7) % 11 + 1; ++j) {
+                std::optional<int64_t> v;
+                if (j % 5 != 0) {
+                    v = (i * 31 + j * 17) % 97 - 40;
+                }
+                rows.emplace_back(k, j / 2, v);
+            }
+        }
+        std::vector<Block> blocks;
+        size_t block_rows = 1;
+        for (size_t first = 0; first < rows.size(); first += block_rows) {
+            block_rows = blocks.size() % 13 + 1;
+            auto k = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+            auto o = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+            auto v = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+            for (size_t row = first; row < std::min(first + block_rows, rows.size()); ++row) {
+                auto& [key, order, value] = rows[row];
+                key ? k->insert(Field(*key)) : k->insert_default();
+                o->insert(Field(order));
+                value ? v->insert(Field(*value)) : v->insert_default();
+            }
+            auto type = make_nullable(std::make_shared<DataTypeInt64>());
+            Block block;
+            block.insert({std::move(k), type, "k"});
+            block.insert({std::move(o), type, "o"});
+            block.insert({std::move(v), type, "v"});
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
+    // Runs `sum(v), max(v) over (partition by k [order by o] window)` and returns its rows as
+    // "k:o:v:sum:max".
+    std::vector<std::string> evaluate(const std::optional<TAnalyticWindow>& window,
+                                      bool order_by) {
+        TPlanNode child_tnode = create_plan_node(0, TPlanNodeType::EXCHANGE_NODE, {0}, 0);
+        auto* child = _pool.add(new MockBlockNode(&_pool, child_tnode, *_desc_tbl, create_input()));
+        EXPECT_TRUE(child->init(child_tnode, &_state).ok());
+
+        const auto* input_tuple = _desc_tbl->get_tuple_descriptor(0);
+        TPlanNode tnode = create_plan_node(1, TPlanNodeType::ANALYTIC_EVAL_NODE, {0, 2}, 1);
+        tnode.__isset.analytic_node = true;
+        tnode.analytic_node.partition_exprs = {create_slot_ref(input_tuple->slots()[0])};
+        if (order_by) {
+            tnode.analytic_node.order_by_exprs = {create_slot_ref(input_tuple->slots()[1])};
+        }
+        for (const char* name : {"sum", "max"}) {
+            tnode.analytic_node.analytic_functions.push_back(
+                    create_agg_fn(name, input_tuple->slots()[2], TypeDescriptor(TYPE_BIGINT)));
+        }
+        if (window) {
+            tnode.analytic_node.__set_window(*window);
+        }
+        tnode.analytic_node.intermediate_tuple_id = 1;
+        tnode.analytic_node.output_tuple_id = 2;
+        tnode.analytic_node.__set_buffered_tuple_id(3);
+        auto* node = _pool.add(new VAnalyticEvalNode(&_pool, tnode, *_desc_tbl));
+        node->_children.push_back(child);
+        EXPECT_TRUE(node->init(tnode, &_state).ok());
+        EXPECT_TRUE(node->prepare(&_state).ok());
+        EXPECT_TRUE(node->open(&_state).ok());
+
+        std::vector<std::string> result;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node->get_next(&_state, &block, &eos).ok());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                std::string line;
+                for (size_t c = 0; c < block.columns(); ++c) {
+                    auto& column = block.get_by_position(c);
+                    line += (c == 0 ? "" : ":") + column.type->to_string(*column.column, row);
+                }
+                result.push_back(line);
+            }
+        }
+        EXPECT_EQ(config::analytic_eval_thread_num > 1, !node->_parallel_results.empty());
+        EXPECT_TRUE(node->close(&_state).ok());
+        return result;
+    }
+
+    // Compares the parallel evaluation, with and without the pool, to the streaming one.
+    void check_same_as_streaming(const std::optional<TAnalyticWindow>& window, bool order_by) {
+        config::analytic_eval_thread_num = 1;
+        auto expected = evaluate(window, order_by);
+        ASSERT_EQ(count_input_rows(), expected.size());
+
+        config::analytic_eval_thread_num = 4;
+        EXPECT_EQ(expected, evaluate(window, order_by));
+        std::unique_ptr<ThreadPool> pool;
+        ASSERT_TRUE(ThreadPoolBuilder("ParallelOperatorTest").set_max_threads(2).build(&pool).ok());
+        ExecEnv::GetInstance()->_parallel_operator_thread_pool = std::move(pool);
+        EXPECT_EQ(expected, evaluate(window, order_by));
+        // more tasks than partitions
+        config::analytic_eval_thread_num = 64;
+        EXPECT_EQ(expected, evaluate(window, order_by));
+    }
+
+    static size_t count_input_rows() {
+        size_t rows = 0;
+        for (auto& block : create_input()) {
+            rows += block.rows();
+        }
+        return rows;
+    }
+
+    static TAnalyticWindowBoundary boundary(TAnalyticWindowBoundaryType::type type,
+                                            std::optional<int64_t> offset = std::nullopt) {
+        TAnalyticWindowBoundary b;
+        b.type = type;
+        if (offset) {
+            b.__set_rows_offset_value(*offset);
+        }
+        return b;
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    DescriptorTbl* _desc_tbl = nullptr;
+    int32_t _saved_thread_num = 1;
+};
+
+TEST_F(VAnalyticEvalNodeTest, partition) {
+    check_same_as_streaming(std::nullopt, false);
+}
+
+TEST_F(VAnalyticEvalNodeTest, range_to_current_row) {
+    TAnalyticWindow window;
+    window.type = TAnalyticWindowType::RANGE;
+    window.__set_window_end(boundary(TAnalyticWindowBoundaryType::CURRENT_ROW));
+    check_same_as_streaming(window, true);
+}
+
+TEST_F(VAnalyticEvalNodeTest, rows_to_current_row) {
+    TAnalyticWindow window;
+    window.type = TAnalyticWindowType::ROWS;
+    window.__set_window_end(boundary(TAnalyticWindowBoundaryType::CURRENT_ROW));
+    check_same_as_streaming(window, false);
+}
+
+TEST_F(VAnalyticEvalNodeTest, sliding_rows) {
+    TAnalyticWindow window;
+    window.type = TAnalyticWindowType::ROWS;
+    window.__set_window_start(boundary(TAnalyticWindowBoundaryType::PRECEDING, 2));
+    window.__set_window_end(boundary(TAnalyticWindowBoundaryType::FOLLOWING, 1));
+    check_same_as_streaming(window, false);
+
+    window.__set_window_start(boundary(TAnalyticWindowBoundaryType::FOLLOWING, 1));
+    window.__set_window_end(boundary(TAnalyticWindowBoundaryType::FOLLOWING, 3));
+    check_same_as_streaming(window, false);
+}
+
+} // namespace doris::vectorized
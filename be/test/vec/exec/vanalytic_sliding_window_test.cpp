@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exec/vanalytic_eval_node.h"
+
+namespace doris::vectorized {
+
+void register_aggregate_function_sum(AggregateFunctionSimpleFactory& factory);
+void register_aggregate_function_minmax(AggregateFunctionSimpleFactory& factory);
+
+class SlidingWindowAggregatorTest : public ::testing::TestWithParam<std::string> {};
+
+// Compares the slid aggregates against adding all the rows of every frame, for frames of the ROWS
+// windows with different bounds over two partitions.
+TEST_P(SlidingWindowAggregatorTest, same_as_adding_frames) {
+    AggregateFunctionSimpleFactory factory;
+    register_aggregate_function_sum(factory);
+    register_aggregate_function_minmax(factory);
+    DataTypes data_types = {std::make_shared<DataTypeInt32>()};
+    auto function = factory.get(GetParam(), data_types, {});
+    ASSERT_TRUE(SlidingWindowAggregator::is_supported(function));
+
+    auto input = ColumnInt32::create();
+    for (int i = 0; i < 200; ++i) {
+        input->insert_value((i * 7919) % 101 - 50);
+    }
+    const IColumn* columns[1] = {input.get()};
+    std::unique_ptr<char[]> memory(new char[function->size_of_data()]);
+    AggregateDataPtr place = memory.get();
+    function->create(place);
+
+    const std::pair<int64_t, int64_t> partitions[] = {{0, 120}, {120, 200}};
+    const std::pair<int64_t, int64_t> bounds[] = {{-3, 0}, {-10, 5}, {2, 6}, {-1, -1}, {-500, 2}};
+    for (const auto& [start_offset, end_offset] : bounds) {
+        SlidingWindowAggregator aggregator(function);
+        auto expected = function->get_return_type()->create_column();
+        auto actual = function->get_return_type()->create_column();
+        for (const auto& [partition_start, partition_end] : partitions) {
+            for (int64_t row = partition_start; row < partition_end; ++row) {
+                int64_t frame_start = row + start_offset;
+                int64_t frame_end = row + end_offset + 1;
+                function->reset(place);
+                function->add_range_single_place(partition_start, partition_end, frame_start,
+                                                 frame_end, place, columns, nullptr);
+                function->insert_result_into(place, *expected);
+                aggregator.slide(partition_start, partition_end, frame_start, frame_end, place,
+                                 columns);
+                function->insert_result_into(place, *actual);
+            }
+        }
+        ASSERT_EQ(expected->size(), actual->size());
+        for (size_t i = 0; i < expected->size(); ++i) {
+            EXPECT_EQ(expected->get_data_at(i), actual->get_data_at(i))
+                    << GetParam() << " [" << start_offset << ", " << end_offset << "] row " << i;
+        }
+    }
+    function->destroy(place);
+}
+
+INSTANTIATE_TEST_SUITE_P(Params, SlidingWindowAggregatorTest,
+                         ::testing::ValuesIn(std::vector<std::string> {"sum", "max", "min"}));
+
+} // namespace doris::vectorized
@@ -0,0 +1,176 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vcross_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
+#include "testutil/mock_exec_node.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+static TQueryOptions create_query_options() {
+    TQueryOptions query_options;
+    query_options.__set_batch_size(8);
+    return query_options;
+}
+
+class VCrossJoinNodeTest : public testing::Test {
+public:
+    VCrossJoinNodeTest()
+            : _state(TUniqueId(), create_query_options(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+        DescriptorTblBuilder builder(&_pool);
+        // the (k) of the left and of the right child
+        builder.declare_tuple() << TYPE_BIGINT;
+        builder.declare_tuple() << TYPE_BIGINT;
+        _desc_tbl = builder.build();
+        _state.set_desc_tbl(_desc_tbl);
+    }
+
+protected:
+    // A block of the keys [begin, end).
+    static Block create_block(int64_t begin, int64_t end) {
+        auto k = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+        for (int64_t key = begin; key < end; ++key) {
+            k->insert(Field(key));
+        }
+        Block block;
+        block.insert({std::move(k), make_nullable(std::make_shared<DataTypeInt64>()), "k"});
+        return block;
+    }
+
+    static int64_t key_at(const Block& block, size_t column, size_t row) {
+        const auto& k = assert_cast<const ColumnNullable&>(*block.get_by_position(column).column);
+        return k.get_nested_column().get_int(row);
+    }
+
+    // the condition left.k = right.k
+    VExprContext* create_eq_conjunct() {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::BINARY_PRED);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        node.__set_is_nullable(true);
+        node.__set_num_children(2);
+        TFunction fn;
+        fn.name.__set_function_name("eq");
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        node.__set_fn(fn);
+        VExpr* expr = _pool.add(new VectorizedFnCall(node));
+        for (int i = 0; i < 2; ++i) {
+            const auto* slot = _desc_tbl->get_tuple_descriptor(i)->slots()[0];
+            expr->add_child(_pool.add(new VSlotRef(slot)));
+        }
+        return _pool.add(new VExprContext(expr));
+    }
+
+    // Joins the left blocks with the right blocks, on the given conjunct if any, and returns the
+    // output blocks.
+    std::vector<Block> join(std::vector<Block> left, std::vector<Block> right,
+                            VExprContext* conjunct) {
+        TPlanNode left_tnode = create_plan_node(0, TPlanNodeType::EXCHANGE_NODE, {0}, 0);
+        auto* left_child =
+                _pool.add(new MockBlockNode(&_pool, left_tnode, *_desc_tbl, std::move(left)));
+        EXPECT_TRUE(left_child->init(left_tnode, &_state).ok());
+        TPlanNode right_tnode = create_plan_node(1, TPlanNodeType::EXCHANGE_NODE, {1}, 0);
+        auto* right_child =
+                _pool.add(new MockBlockNode(&_pool, right_tnode, *_desc_tbl, std::move(right)));
+        EXPECT_TRUE(right_child->init(right_tnode, &_state).ok());
+
+        TPlanNode tnode = create_plan_node(2, TPlanNodeType::CROSS_JOIN_NODE, {0, 1}, 2);
+        auto* node = _pool.add(new VCrossJoinNode(&_pool, tnode, *_desc_tbl));
+        node->_children.push_back(left_child);
+        node->_children.push_back(right_child);
+        EXPECT_TRUE(node->init(tnode, &_state).ok());
+        if (conjunct != nullptr) {
+            node->_vconjunct_ctx_ptr.reset(new VExprContext*(conjunct));
+        }
+        EXPECT_TRUE(node->prepare(&_state).ok());
+        EXPECT_TRUE(node->open(&_state).ok());
+
+        std::vector<Block> result;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node->get_next(&_state, &block, &eos).ok());
+            result.push_back(std::move(block));
+        }
+        EXPECT_TRUE(node->close(&_state).ok());
+        return result;
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    DescriptorTbl* _desc_tbl = nullptr;
+};
+
+TEST_F(VCrossJoinNodeTest, product) {
+    std::vector<Block> left;
+    for (int64_t begin = 0; begin < 30; begin += 10) {
+        left.push_back(create_block(begin, begin + 10));
+    }
+    auto result = join(std::move(left), {create_block(0, 5), create_block(5, 7)}, nullptr);
+    size_t rows = 0;
+    for (auto& block : result) {
+        EXPECT_LE(block.rows(), _state.batch_size());
+        rows += block.rows();
+    }
+    EXPECT_EQ(30 * 7, rows);
+}
+
+TEST_F(VCrossJoinNodeTest, filtered_product) {
+    // 1 row of each 20 rows of the product is matched
+    std::vector<Block> left;
+    for (int64_t begin = 0; begin < 100; begin += 10) {
+        left.push_back(create_block(begin, begin + 10));
+    }
+    auto result = join(std::move(left), {create_block(0, 10), create_block(10, 20)},
+                       create_eq_conjunct());
+
+    // the output blocks are filled with the matched rows of several product batches
+    std::set<int64_t> keys;
+    for (size_t i = 0; i < result.size(); ++i) {
+        auto& block = result[i];
+        ASSERT_EQ(2, block.columns());
+        if (i + 1 < result.size()) {
+            EXPECT_GE(block.rows(), _state.batch_size()) << i;
+        }
+        for (size_t row = 0; row < block.rows(); ++row) {
+            int64_t key = key_at(block, 0, row);
+            EXPECT_EQ(key, key_at(block, 1, row));
+            EXPECT_TRUE(keys.insert(key).second) << key;
+        }
+    }
+    EXPECT_EQ(20, keys.size());
+    EXPECT_EQ(0, *keys.begin());
+    EXPECT_EQ(19, *keys.rbegin());
+}
+
+} // namespace doris::vectorized
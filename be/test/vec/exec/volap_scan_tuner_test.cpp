@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include "vec/exec/volap_scan_node.h"
+
+namespace doris::vectorized {
+
+// 8 scanners at most, blocks of 64 to 4096 rows starting at 1024, 64KB blocks and a 1MB budget
+static ScannerScheduleTuner make_tuner() {
+    return ScannerScheduleTuner(8, 64, 4096, 1024, 64 * 1024, 1024 * 1024);
+}
+
+TEST(ScannerScheduleTunerTest, block_rows_follow_row_width) {
+    auto tuner = make_tuner();
+    EXPECT_EQ(tuner.block_rows(), 1024);
+
+    // 16 bytes per row: 4096 rows fill the target bytes
+    tuner.on_scanned(1024, 1024, 1024 * 16);
+    EXPECT_EQ(tuner.block_rows(), 4096);
+
+    // the average moves to the wide rows
+    for (int i = 0; i < 64; ++i) {
+        tuner.on_scanned(1024, 1024, 1024 * 1024);
+    }
+    EXPECT_EQ(tuner.block_rows(), 64);
+}
+
+TEST(ScannerScheduleTunerTest, selective_scan_keeps_small_blocks) {
+    auto tuner = make_tuner();
+    for (int i = 0; i < 64; ++i) {
+        tuner.on_scanned(100000, 100, 100 * 16);
+    }
+    EXPECT_EQ(tuner.block_rows(), 1024);
+}
+
+TEST(ScannerScheduleTunerTest, scanners_follow_consumer) {
+    auto tuner = make_tuner();
+    tuner.on_scanned(1024, 1024, 1024 * 16);
+    EXPECT_EQ(tuner.max_running_scanners(), 8);
+
+    // the queue is full while the consumer takes blocks
+    for (int i = 0; i < 3; ++i) {
+        tuner.on_queue_full();
+        for (int j = 0; j < 16; ++j) {
+            tuner.on_consumed(false);
+        }
+    }
+    EXPECT_EQ(tuner.max_running_scanners(), 5);
+
+    // the consumer waits for the blocks
+    for (int i = 0; i < 16 * 16; ++i) {
+        tuner.on_consumed(true);
+    }
+    EXPECT_EQ(tuner.max_running_scanners(), 8);
+}
+
+TEST(ScannerScheduleTunerTest, scanners_fit_memory_budget) {
+    auto tuner = make_tuner();
+    // the blocks of rows of 4KB have the fewest 64 rows, and four of them fill the budget
+    tuner.on_scanned(1024, 1024, 1024 * 4096);
+    EXPECT_EQ(tuner.block_rows(), 64);
+    for (int i = 0; i < 16; ++i) {
+        tuner.on_consumed(true);
+    }
+    EXPECT_EQ(tuner.max_running_scanners(), 4);
+}
+
+} // namespace doris::vectorized
@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exec/orc_scanner.h"
 #include "exprs/cast_functions.h"
@@ -537,6 +538,125 @@ TEST_F(VOrcScannerTest, normal2) {
     scanner.close();
 }
 
+TEST_F(VOrcScannerTest, native_reader) {
+    config::enable_native_orc_reader = true;
+    TBrokerScanRangeParams params;
+    TTypeDesc varchar_type;
+    {
+        TTypeNode node;
+        node.__set_type(TTypeNodeType::SCALAR);
+        TScalarType scalar_type;
+        scalar_type.__set_type(TPrimitiveType::VARCHAR);
+        scalar_type.__set_len(65535);
+        node.__set_scalar_type(scalar_type);
+        varchar_type.types.push_back(node);
+    }
+
+    TTypeDesc int_type;
+    {
+        TTypeNode node;
+        node.__set_type(TTypeNodeType::SCALAR);
+        TScalarType scalar_type;
+        scalar_type.__set_type(TPrimitiveType::INT);
+        node.__set_scalar_type(scalar_type);
+        int_type.types.push_back(node);
+    }
+
+    {
+        TExprNode slot_ref;
+        slot_ref.node_type = TExprNodeType::SLOT_REF;
+        slot_ref.type = varchar_type;
+        slot_ref.num_children = 0;
+        slot_ref.__isset.slot_ref = true;
+        slot_ref.slot_ref.slot_id = 1;
+        slot_ref.slot_ref.tuple_id = 0;
+
+        TExpr expr;
+        expr.nodes.push_back(slot_ref);
+
+        params.expr_of_dest_slot.emplace(3, expr);
+        params.src_slot_ids.push_back(0);
+        params.src_slot_ids.push_back(1);
+        params.src_slot_ids.push_back(2);
+    }
+    params.__set_src_tuple_id(0);
+    params.__set_dest_tuple_id(1);
+
+    //init_desc_table
+    TDescriptorTable t_desc_table;
+
+    // table descriptors
+    TTableDescriptor t_table_desc;
+
+    t_table_desc.id = 0;
+    t_table_desc.tableType = TTableType::BROKER_TABLE;
+    t_table_desc.numCols = 0;
+    t_table_desc.numClusteringCols = 0;
+    t_desc_table.tableDescriptors.push_back(t_table_desc);
+    t_desc_table.__isset.tableDescriptors = true;
+
+    TDescriptorTableBuilder dtb;
+    TTupleDescriptorBuilder src_tuple_builder;
+    src_tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .string_type(65535)
+                                       .nullable(true)
+                                       .column_name("col1")
+                                       .column_pos(1)
+                                       .build());
+    src_tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .string_type(65535)
+                                       .nullable(true)
+                                       .column_name("col2")
+                                       .column_pos(2)
+                                       .build());
+    src_tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .string_type(65535)
+                                       .nullable(true)
+                                       .column_name("col3")
+                                       .column_pos(3)
+                                       .build());
+    src_tuple_builder.build(&dtb);
+    TTupleDescriptorBuilder dest_tuple_builder;
+    dest_tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                        .string_type(65535)
+                                        .column_name("value_from_col2")
+                                        .column_pos(1)
+                                        .build());
+
+    dest_tuple_builder.build(&dtb);
+    t_desc_table = dtb.desc_tbl();
+
+    DescriptorTbl::create(&_obj_pool, t_desc_table, &_desc_tbl);
+    _runtime_state.set_desc_tbl(_desc_tbl);
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc rangeDesc;
+    rangeDesc.start_offset = 0;
+    rangeDesc.size = -1;
+    rangeDesc.format_type = TFileFormatType::FORMAT_ORC;
+    rangeDesc.splittable = false;
+
+    rangeDesc.path = "./be/test/exec/test_data/orc_scanner/my-file.orc";
+    rangeDesc.file_type = TFileType::FILE_LOCAL;
+    ranges.push_back(rangeDesc);
+
+    VORCScanner scanner(&_runtime_state, _profile, params, ranges, _addresses, _pre_filter,
+                        &_counter);
+    EXPECT_TRUE(scanner.open().ok());
+
+    // the same rows are read by the native reader, or by the arrow reader it falls back to
+    bool eof = false;
+    size_t total_rows = 0;
+    while (!eof) {
+        vectorized::Block block;
+        EXPECT_TRUE(scanner.get_next(&block, &eof).ok());
+        total_rows += block.rows();
+    }
+    EXPECT_EQ(10, total_rows);
+    scanner.close();
+    config::enable_native_orc_reader = false;
+}
+
 TEST_F(VOrcScannerTest, normal3) {
     TBrokerScanRangeParams params;
     TTypeDesc varchar_type;
@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exprs/cast_functions.h"
 #include "gen_cpp/Descriptors_types.h"
@@ -495,5 +496,55 @@ TEST_F(VParquetScannerTest, normal) {
     }
 }
 
+TEST_F(VParquetScannerTest, native_reader) {
+    config::enable_native_parquet_reader = true;
+    VBrokerScanNode scan_node(&_obj_pool, _tnode, *_desc_tbl);
+    scan_node.init(_tnode);
+    auto status = scan_node.prepare(&_runtime_state);
+    EXPECT_TRUE(status.ok());
+
+    std::vector<TScanRangeParams> scan_ranges;
+    {
+        TScanRangeParams scan_range_params;
+
+        TBrokerScanRange broker_scan_range;
+        broker_scan_range.params = _params;
+        TBrokerRangeDesc range;
+        range.start_offset = 0;
+        range.size = -1;
+        range.format_type = TFileFormatType::FORMAT_PARQUET;
+        range.splittable = true;
+
+        std::vector<std::string> columns_from_path {"value"};
+        range.__set_columns_from_path(columns_from_path);
+        range.__set_num_of_columns_from_file(19);
+        range.path = "./be/test/exec/test_data/parquet_scanner/localfile.parquet";
+        range.file_type = TFileType::FILE_LOCAL;
+        broker_scan_range.ranges.push_back(range);
+        scan_range_params.scan_range.__set_broker_scan_range(broker_scan_range);
+        scan_ranges.push_back(scan_range_params);
+    }
+
+    scan_node.set_scan_ranges(scan_ranges);
+    status = scan_node.open(&_runtime_state);
+    EXPECT_TRUE(status.ok());
+
+    // the same rows are read by the native reader, or by the arrow reader it falls back to
+    vectorized::Block block;
+    bool eof = false;
+    size_t total_rows = 0;
+    while (!eof) {
+        status = scan_node.get_next(&_runtime_state, &block, &eof);
+        EXPECT_TRUE(status.ok());
+        EXPECT_LE(block.rows(), 2048);
+        total_rows += block.rows();
+        block.clear();
+    }
+    EXPECT_EQ(14 * 2048 + 1328, total_rows);
+
+    scan_node.close(&_runtime_state);
+    config::enable_native_parquet_reader = false;
+}
+
 } // namespace vectorized
 } // namespace doris
\ No newline at end of file
@@ -0,0 +1,116 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exec/vsort_node.h"
+
+namespace doris::vectorized {
+
+// Every row with less than `limit` rows before it in its partition must be kept, whatever the
+// order of the input, and the rows after a full heap are dropped.
+TEST(PartitionTopNFilterTest, keep_first_rows_of_partitions) {
+    const int64_t limit = 3;
+    // partition by column 0, order by column 1 desc
+    SortDescription description;
+    description.emplace_back(0, 1, 1);
+    description.emplace_back(1, -1, -1);
+    PartitionTopNFilter filter(limit, 1);
+
+    std::vector<std::pair<int32_t, int32_t>> input;
+    std::vector<std::pair<int32_t, int32_t>> kept;
+    for (int b = 0; b < 10; ++b) {
+        auto partitions = ColumnInt32::create();
+        auto values = ColumnInt32::create();
+        for (int i = 0; i < 100; ++i) {
+            int32_t partition = (b * 100 + i) * 7 % 5;
+            int32_t value = (b * 100 + i) * 7919 % 31;
+            partitions->insert_value(partition);
+            values->insert_value(value);
+            input.emplace_back(partition, value);
+        }
+        auto type = std::make_shared<DataTypeInt32>();
+        Block block({{std::move(partitions), type, "p"}, {std::move(values), type, "v"}});
+        filter.filter(block, description);
+        for (size_t row = 0; row < block.rows(); ++row) {
+            kept.emplace_back(block.get_by_position(0).column->get_int(row),
+                              block.get_by_position(1).column->get_int(row));
+        }
+    }
+    EXPECT_LT(kept.size(), input.size());
+
+    // the number of kept rows of each partition and value
+    std::map<std::pair<int32_t, int32_t>, int> kept_counts;
+    for (const auto& row : kept) {
+        ++kept_counts[row];
+    }
+    for (const auto& [partition, value] : input) {
+        int64_t greater = 0;
+        for (const auto& [other_partition, other_value] : input) {
+            greater += other_partition == partition && other_value > value;
+        }
+        int64_t count = std::count(input.begin(), input.end(), std::make_pair(partition, value));
+        if (greater < limit) {
+            // the rank of the row is at most limit, so all its ties are kept
+            EXPECT_EQ(count, kept_counts[{partition, value}]) << partition << " " << value;
+        }
+    }
+}
+
+// Without partition exprs the filter is the one of a TopN, whose top row is its boundary, and the
+// keys of the rows that have left the heap are dropped.
+TEST(PartitionTopNFilterTest, topn_boundary) {
+    const int64_t limit = 10;
+    SortDescription description;
+    description.emplace_back(0, 1, 1);
+    PartitionTopNFilter filter(limit, 0);
+    EXPECT_EQ(-1, filter.top_row());
+
+    // the values only decrease, so every row gets into the heap of an ascending sort
+    auto type = std::make_shared<DataTypeInt32>();
+    for (int b = 0; b < 20; ++b) {
+        auto values = ColumnInt32::create();
+        for (int i = 0; i < 1000; ++i) {
+            values->insert_value(100000 - (b * 1000 + i));
+        }
+        Block block({{std::move(values), type, "v"}});
+        filter.filter(block, description);
+        EXPECT_EQ(1000, block.rows());
+        ASSERT_GE(filter.top_row(), 0);
+        EXPECT_EQ(100000 - (b * 1000 + 999) + limit - 1,
+                  filter.keys()[0]->get_int(filter.top_row()));
+        EXPECT_LE(filter.keys()[0]->size(), size_t(4096));
+    }
+
+    // the rows after the boundary are dropped, and its ties are kept
+    auto values = ColumnInt32::create();
+    for (int32_t value : {80010, 80011, 90000, 80009}) {
+        values->insert_value(value);
+    }
+    Block block({{std::move(values), type, "v"}});
+    filter.filter(block, description);
+    ASSERT_EQ(2, block.rows());
+    EXPECT_EQ(80010, block.get_by_position(0).column->get_int(0));
+    EXPECT_EQ(80009, block.get_by_position(0).column->get_int(1));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,172 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vset_operation_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
+#include "testutil/mock_exec_node.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exec/vexcept_node.h"
+#include "vec/exec/vintersect_node.h"
+
+namespace doris::vectorized {
+
+using Rows = std::vector<std::optional<int64_t>>;
+
+class VSetOperationNodeTest : public testing::Test {
+public:
+    VSetOperationNodeTest() : _state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+        DescriptorTblBuilder builder(&_pool);
+        // the (k) of the three children, and the output (k) of the set operation
+        for (int i = 0; i < 4; ++i) {
+            builder.declare_tuple() << TYPE_BIGINT;
+        }
+        _desc_tbl = builder.build();
+        _state.set_desc_tbl(_desc_tbl);
+    }
+
+protected:
+    static Block create_block(const Rows& rows) {
+        auto k = ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create());
+        for (auto& key : rows) {
+            key ? k->insert(Field(*key)) : k->insert_default();
+        }
+        Block block;
+        block.insert({std::move(k), make_nullable(std::make_shared<DataTypeInt64>()), "k"});
+        return block;
+    }
+
+    // Runs the INTERSECT or EXCEPT of the children, each one the given blocks, and returns the
+    // sorted output keys. `children` is set to the children, to count the blocks they returned.
+    std::vector<std::string> run(TPlanNodeType::type node_type,
+                                 const std::vector<std::vector<Rows>>& inputs,
+                                 std::vector<MockBlockNode*>* children) {
+        TPlanNode tnode = create_plan_node(inputs.size(), node_type, {3}, inputs.size());
+        std::vector<std::vector<TExpr>> result_expr_lists;
+        for (int i = 0; i < inputs.size(); ++i) {
+            std::vector<Block> blocks;
+            for (auto& rows : inputs[i]) {
+                blocks.push_back(create_block(rows));
+            }
+            TPlanNode child_tnode = create_plan_node(i, TPlanNodeType::EXCHANGE_NODE, {i}, 0);
+            auto* child = _pool.add(
+                    new MockBlockNode(&_pool, child_tnode, *_desc_tbl, std::move(blocks)));
+            EXPECT_TRUE(child->init(child_tnode, &_state).ok());
+            children->push_back(child);
+            result_expr_lists.push_back(
+                    {create_slot_ref(_desc_tbl->get_tuple_descriptor(i)->slots()[0])});
+        }
+
+        ExecNode* node = nullptr;
+        if (node_type == TPlanNodeType::INTERSECT_NODE) {
+            tnode.__isset.intersect_node = true;
+            tnode.intersect_node.tuple_id = 3;
+            tnode.intersect_node.result_expr_lists = result_expr_lists;
+            node = _pool.add(new VIntersectNode(&_pool, tnode, *_desc_tbl));
+        } else {
+            tnode.__isset.except_node = true;
+            tnode.except_node.tuple_id = 3;
+            tnode.except_node.result_expr_lists = result_expr_lists;
+            node = _pool.add(new VExceptNode(&_pool, tnode, *_desc_tbl));
+        }
+        node->_children.assign(children->begin(), children->end());
+        EXPECT_TRUE(node->init(tnode, &_state).ok());
+        EXPECT_TRUE(node->prepare(&_state).ok());
+        EXPECT_TRUE(node->open(&_state).ok());
+
+        std::vector<std::string> result;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node->get_next(&_state, &block, &eos).ok());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                auto& k = block.get_by_position(0);
+                result.push_back(k.type->to_string(*k.column, row));
+            }
+        }
+        EXPECT_TRUE(node->close(&_state).ok());
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    DescriptorTbl* _desc_tbl = nullptr;
+};
+
+TEST_F(VSetOperationNodeTest, intersect) {
+    std::vector<MockBlockNode*> children;
+    auto result = run(TPlanNodeType::INTERSECT_NODE,
+                      {{{1, 2, 3}, {std::nullopt, 4}}, {{2}, {std::nullopt, 5}, {3}}, {{3, 2}}},
+                      &children);
+    EXPECT_EQ((std::vector<std::string> {"2", "3"}), result);
+    EXPECT_EQ(3, children[1]->blocks_returned());
+    EXPECT_EQ(1, children[2]->blocks_returned());
+}
+
+TEST_F(VSetOperationNodeTest, empty_intersect) {
+    // the intersection of the first two children is empty, the third one is not read
+    std::vector<MockBlockNode*> children;
+    auto result = run(TPlanNodeType::INTERSECT_NODE, {{{1, 2}}, {{3}, {4}}, {{1}, {2}}},
+                      &children);
+    EXPECT_TRUE(result.empty());
+    EXPECT_EQ(2, children[1]->blocks_returned());
+    EXPECT_EQ(0, children[2]->blocks_returned());
+}
+
+TEST_F(VSetOperationNodeTest, intersect_of_all_rows) {
+    // all the rows are matched by the first block of the second child, the rest is not read
+    std::vector<MockBlockNode*> children;
+    auto result = run(TPlanNodeType::INTERSECT_NODE, {{{1}, {2}}, {{2, 1, 3}, {4}, {5}}, {{2}}},
+                      &children);
+    EXPECT_EQ((std::vector<std::string> {"2"}), result);
+    EXPECT_EQ(1, children[1]->blocks_returned());
+    EXPECT_EQ(1, children[2]->blocks_returned());
+}
+
+TEST_F(VSetOperationNodeTest, except) {
+    std::vector<MockBlockNode*> children;
+    auto result = run(TPlanNodeType::EXCEPT_NODE,
+                      {{{1, 2, 3}, {std::nullopt, 4}}, {{2}, {5}}, {{std::nullopt}}}, &children);
+    EXPECT_EQ((std::vector<std::string> {"1", "3", "4"}), result);
+    EXPECT_EQ(2, children[1]->blocks_returned());
+    EXPECT_EQ(1, children[2]->blocks_returned());
+}
+
+TEST_F(VSetOperationNodeTest, except_of_all_rows) {
+    // all the rows are excepted by the first two blocks of the second child, the rest of it and
+    // the third child are not read
+    std::vector<MockBlockNode*> children;
+    auto result = run(TPlanNodeType::EXCEPT_NODE, {{{1, 2}, {2}}, {{2}, {1, 3}, {4}}, {{5}}},
+                      &children);
+    EXPECT_TRUE(result.empty());
+    EXPECT_EQ(2, children[1]->blocks_returned());
+    EXPECT_EQ(0, children[2]->blocks_returned());
+}
+
+} // namespace doris::vectorized
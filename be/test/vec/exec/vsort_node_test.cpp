@@ -0,0 +1,205 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vsort_node.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "common/config.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
+#include "testutil/mock_exec_node.h"
+#include "util/threadpool.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+using Row = std::vector<std::optional<int64_t>>;
+
+static TQueryOptions create_query_options() {
+    TQueryOptions options;
+    options.__set_batch_size(16);
+    return options;
+}
+
+class VSortNodeTest : public testing::Test {
+public:
+    VSortNodeTest() : _state(TUniqueId(), create_query_options(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+        DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT << TYPE_BIGINT;
+        _desc_tbl = builder.build();
+        _state.set_desc_tbl(_desc_tbl);
+    }
+
+    void SetUp() override {
+        _saved_thread_num = config::sort_thread_num;
+        std::unique_ptr<ThreadPool> pool;
+        ASSERT_TRUE(ThreadPoolBuilder("ParallelOperatorTest").set_max_threads(3).build(&pool).ok());
+        ExecEnv::GetInstance()->_parallel_operator_thread_pool = std::move(pool);
+    }
+
+    void TearDown() override {
+        config::sort_thread_num = _saved_thread_num;
+        ExecEnv::GetInstance()->_parallel_operator_thread_pool.reset();
+    }
+
+protected:
+    // cuts the rows (a, b, c) into blocks of 1 to 97 rows
+    static std::vector<Block> create_blocks(const std::vector<Row>& rows) {
+        std::vector<Block> blocks;
+        size_t block_rows = 1;
+        for (size_t first = 0; first < rows.size(); first += block_rows) {
+            block_rows = (blocks.size() * 37) % 97 + 1;
+            MutableColumns columns;
+            for (int c = 0; c < 3; ++c) {
+                columns.push_back(
+                        ColumnNullable::create(ColumnInt64::create(), ColumnUInt8::create()));
+            }
+            for (size_t row = first; row < std::min(first + block_rows, rows.size()); ++row) {
+                for (int c = 0; c < 3; ++c) {
+                    rows[row][c] ? columns[c]->insert(Field(*rows[row][c]))
+                                 : columns[c]->insert_default();
+                }
+            }
+            auto type = make_nullable(std::make_shared<DataTypeInt64>());
+            Block block;
+            block.insert({std::move(columns[0]), type, "a"});
+            block.insert({std::move(columns[1]), type, "b"});
+            block.insert({std::move(columns[2]), type, "c"});
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
+    // Sorts the rows by (a, b, c) in the directions `is_asc_order` and `nulls_first` and returns
+    // them as "a:b:c".
+    std::vector<std::string> sort(const std::vector<Row>& rows,
+                                  const std::vector<bool>& is_asc_order,
+                                  const std::vector<bool>& nulls_first, int64_t offset,
+                                  bool expect_parallel) {
+        TPlanNode child_tnode = create_plan_node(0, TPlanNodeType::EXCHANGE_NODE, {0}, 0);
+        auto* child =
+                _pool.add(new MockBlockNode(&_pool, child_tnode, *_desc_tbl, create_blocks(rows)));
+        EXPECT_TRUE(child->init(child_tnode, &_state).ok());
+
+        const auto* tuple = _desc_tbl->get_tuple_descriptor(0);
+        TPlanNode tnode = create_plan_node(1, TPlanNodeType::SORT_NODE, {0}, 1);
+        tnode.__isset.sort_node = true;
+        for (auto* slot : tuple->slots()) {
+            tnode.sort_node.sort_info.ordering_exprs.push_back(create_slot_ref(slot));
+        }
+        tnode.sort_node.sort_info.is_asc_order = is_asc_order;
+        tnode.sort_node.sort_info.nulls_first = nulls_first;
+        tnode.sort_node.use_top_n = false;
+        tnode.sort_node.__set_offset(offset);
+        auto* node = _pool.add(new VSortNode(&_pool, tnode, *_desc_tbl));
+        node->_children.push_back(child);
+        EXPECT_TRUE(node->init(tnode, &_state).ok());
+        EXPECT_TRUE(node->prepare(&_state).ok());
+        EXPECT_TRUE(node->open(&_state).ok());
+        EXPECT_EQ(expect_parallel, node->_merged_in_parallel);
+
+        std::vector<std::string> result;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(node->get_next(&_state, &block, &eos).ok());
+            for (size_t row = 0; row < block.rows(); ++row) {
+                std::string line;
+                for (size_t c = 0; c < block.columns(); ++c) {
+                    auto& column = block.get_by_position(c);
+                    line += (c == 0 ? "" : ":") + column.type->to_string(*column.column, row);
+                }
+                result.push_back(line);
+            }
+        }
+        EXPECT_TRUE(node->close(&_state).ok());
+        return result;
+    }
+
+    // Compares the parallel sort and merge to the one of the fragment thread.
+    void check_same_as_serial(const std::vector<Row>& rows, const std::vector<bool>& is_asc_order,
+                              const std::vector<bool>& nulls_first, int64_t offset = 0) {
+        config::sort_thread_num = 1;
+        auto expected = sort(rows, is_asc_order, nulls_first, offset, false);
+        ASSERT_EQ(rows.size() - std::min<size_t>(offset, rows.size()), expected.size());
+        config::sort_thread_num = 4;
+        EXPECT_EQ(expected, sort(rows, is_asc_order, nulls_first, offset, true));
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    DescriptorTbl* _desc_tbl = nullptr;
+    int32_t _saved_thread_num = 1;
+};
+
+// a few distinct values of a and b, so that many samples and splitters are equal
+static std::vector<Row> create_rows_with_duplicates(size_t count) {
+    std::vector<Row> rows;
+    for (size_t i = 0; i < count; ++i) {
+        auto value = [&](size_t modulo, size_t null_modulo) {
+            size_t x = (i * 7919) % 10007;
+            return x % null_modulo == 0 ? std::nullopt : std::optional<int64_t>(x % modulo);
+        };
+        rows.push_back({value(3, 11), value(5, 13), value(7, 17)});
+    }
+    return rows;
+}
+
+TEST_F(VSortNodeTest, duplicate_keys) {
+    check_same_as_serial(create_rows_with_duplicates(3000), {true, true, true},
+                         {false, false, false});
+}
+
+TEST_F(VSortNodeTest, mixed_directions_and_nulls) {
+    auto rows = create_rows_with_duplicates(3000);
+    check_same_as_serial(rows, {true, false, true}, {true, false, false});
+    check_same_as_serial(rows, {false, true, false}, {false, true, true});
+    check_same_as_serial(rows, {false, false, false}, {true, true, true});
+}
+
+TEST_F(VSortNodeTest, all_keys_equal) {
+    std::vector<Row> rows(2000, Row {1, std::nullopt, 2});
+    check_same_as_serial(rows, {true, true, true}, {false, false, false});
+}
+
+TEST_F(VSortNodeTest, offset) {
+    auto rows = create_rows_with_duplicates(3000);
+    check_same_as_serial(rows, {true, false, true}, {true, false, false}, 37);
+    // an offset past the first round of ranges, and one past all the rows
+    check_same_as_serial(rows, {true, true, true}, {false, false, false}, 2500);
+    check_same_as_serial(rows, {true, true, true}, {false, false, false}, 5000);
+}
+
+// A merge of fewer rows than a batch per task stays on the fragment thread.
+TEST_F(VSortNodeTest, small_merge) {
+    config::sort_thread_num = 4;
+    auto rows = create_rows_with_duplicates(40);
+    auto result = sort(rows, {true, true, true}, {true, true, true}, 0, false);
+    config::sort_thread_num = 1;
+    EXPECT_EQ(sort(rows, {true, true, true}, {true, true, true}, 0, false), result);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,262 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vcommon_subexpr.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+class VCommonSubexprTest : public testing::Test {
+public:
+    VCommonSubexprTest() : _state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+        DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << TYPE_BIGINT << TYPE_BIGINT;
+        DescriptorTbl* desc_tbl = builder.build();
+        _state.set_desc_tbl(desc_tbl);
+        _tuple_desc = const_cast<TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0));
+        _row_desc.reset(new RowDescriptor(_tuple_desc, false));
+    }
+
+    void TearDown() override { config::enable_common_subexpr_elimination = true; }
+
+protected:
+    // the nullable bigint slot c0 or c1
+    VExpr* slot(int index) { return _pool.add(new VSlotRef(_tuple_desc->slots()[index])); }
+
+    VExpr* fn_call(TExprNodeType::type node_type, const std::string& name, PrimitiveType type,
+                   const std::vector<VExpr*>& children,
+                   TFunctionBinaryType::type binary_type = TFunctionBinaryType::BUILTIN) {
+        TExprNode node;
+        node.__set_node_type(node_type);
+        node.__set_type(TypeDescriptor(type).to_thrift());
+        node.__set_is_nullable(true);
+        node.__set_num_children(children.size());
+        TFunction fn;
+        fn.name.__set_function_name(name);
+        fn.__set_binary_type(binary_type);
+        node.__set_fn(fn);
+        VExpr* expr = _pool.add(new VectorizedFnCall(node));
+        for (auto child : children) {
+            expr->add_child(child);
+        }
+        return expr;
+    }
+
+    VExpr* add(VExpr* left, VExpr* right) {
+        return fn_call(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT, {left, right});
+    }
+
+    VExpr* multiply(VExpr* left, VExpr* right) {
+        return fn_call(TExprNodeType::ARITHMETIC_EXPR, "multiply", TYPE_BIGINT, {left, right});
+    }
+
+    // The keys of the common subexprs in the tree.
+    static void collect_keys(VExpr* expr, std::vector<std::string>* keys) {
+        if (auto* common_subexpr = dynamic_cast<VCommonSubexpr*>(expr)) {
+            keys->push_back(common_subexpr->key());
+        }
+        for (auto child : expr->children()) {
+            collect_keys(child, keys);
+        }
+    }
+
+    static std::vector<std::string> keys_of(VExprContext* context) {
+        std::vector<std::string> keys;
+        collect_keys(context->root(), &keys);
+        return keys;
+    }
+
+    // c0 is null at every 5th row
+    static Block make_block(int64_t c0_base, int64_t c1_base) {
+        auto c0 = ColumnInt64::create();
+        auto nulls = ColumnUInt8::create();
+        auto c1 = ColumnInt64::create();
+        for (int i = 0; i < 100; ++i) {
+            c0->insert_value(c0_base + i);
+            nulls->insert_value(i % 5 == 0);
+            c1->insert_value(c1_base - i * 3);
+        }
+        auto type = make_nullable(std::make_shared<DataTypeInt64>());
+        auto c1_nulls = ColumnUInt8::create(100, 0);
+        return Block({{ColumnNullable::create(std::move(c0), std::move(nulls)), type, "c0"},
+                      {ColumnNullable::create(std::move(c1), std::move(c1_nulls)), type, "c1"}});
+    }
+
+    // Executes the context on a copy of the block, and returns the result and the number of the
+    // columns of the copy after the execution.
+    ColumnPtr execute(VExprContext* context, const Block& block, size_t* columns = nullptr) {
+        Block tmp_block(block.get_columns_with_type_and_name());
+        int result_column_id = -1;
+        EXPECT_TRUE(context->execute(&tmp_block, &result_column_id).ok());
+        if (columns != nullptr) {
+            *columns = tmp_block.columns();
+        }
+        return tmp_block.get_by_position(result_column_id).column;
+    }
+
+    static void check_equal(const ColumnPtr& expected, const ColumnPtr& actual) {
+        ASSERT_EQ(expected->size(), actual->size());
+        for (size_t row = 0; row < expected->size(); ++row) {
+            EXPECT_EQ((*expected)[row], (*actual)[row]) << "row " << row;
+        }
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    TupleDescriptor* _tuple_desc;
+    std::unique_ptr<RowDescriptor> _row_desc;
+};
+
+TEST_F(VCommonSubexprTest, shared_subtree_in_one_expr) {
+    Block block = make_block(-50, 40);
+    ColumnPtr results[2];
+    size_t columns[2];
+    for (int i = 0; i < 2; ++i) {
+        config::enable_common_subexpr_elimination = i == 1;
+        // (c0 + c1) * (c0 + c1)
+        auto context = _pool.add(
+                new VExprContext(multiply(add(slot(0), slot(1)), add(slot(0), slot(1)))));
+        ASSERT_TRUE(context->prepare(&_state, *_row_desc).ok());
+        ASSERT_TRUE(context->open(&_state).ok());
+        auto keys = keys_of(context);
+        if (i == 1) {
+            ASSERT_EQ(2, keys.size());
+            EXPECT_EQ(keys[0], keys[1]);
+        } else {
+            EXPECT_TRUE(keys.empty());
+        }
+        results[i] = execute(context, block, &columns[i]);
+        context->close(&_state);
+    }
+    check_equal(results[0], results[1]);
+    // the sum is computed once
+    EXPECT_EQ(columns[0] - 1, columns[1]);
+}
+
+TEST_F(VCommonSubexprTest, shared_subtree_across_output_exprs) {
+    Block block = make_block(7, -3);
+    std::vector<VExprContext*> ctxs[2];
+    for (int i = 0; i < 2; ++i) {
+        config::enable_common_subexpr_elimination = i == 1;
+        // c0 + c1, (c0 + c1) * c0, c1
+        ctxs[i] = {_pool.add(new VExprContext(add(slot(0), slot(1)))),
+                   _pool.add(new VExprContext(multiply(add(slot(0), slot(1)), slot(0)))),
+                   _pool.add(new VExprContext(slot(1)))};
+        ASSERT_TRUE(VExpr::prepare(ctxs[i], &_state, *_row_desc).ok());
+        ASSERT_TRUE(VExpr::open(ctxs[i], &_state).ok());
+    }
+    // only shared by the exprs prepared together
+    EXPECT_TRUE(keys_of(ctxs[0][0]).empty());
+    auto first_keys = keys_of(ctxs[1][0]);
+    auto second_keys = keys_of(ctxs[1][1]);
+    ASSERT_EQ(1, first_keys.size());
+    ASSERT_EQ(1, second_keys.size());
+    EXPECT_EQ(first_keys[0], second_keys[0]);
+    EXPECT_TRUE(keys_of(ctxs[1][2]).empty());
+
+    Status status[2];
+    Block output[2];
+    for (int i = 0; i < 2; ++i) {
+        output[i] = VExprContext::get_output_block_after_execute_exprs(ctxs[i], block, status[i]);
+        ASSERT_TRUE(status[i].ok());
+    }
+    ASSERT_EQ(3, output[1].columns());
+    for (size_t i = 0; i < 3; ++i) {
+        check_equal(output[0].get_by_position(i).column, output[1].get_by_position(i).column);
+    }
+    VExpr::close(ctxs[0], &_state);
+    VExpr::close(ctxs[1], &_state);
+}
+
+TEST_F(VCommonSubexprTest, conjuncts_and_reset_between_blocks) {
+    std::vector<VExprContext*> ctxs[2];
+    for (int i = 0; i < 2; ++i) {
+        config::enable_common_subexpr_elimination = i == 1;
+        // c0 + c1 > c1 and c0 + c1 < c0, executed one by one like conjuncts
+        ctxs[i] = {_pool.add(new VExprContext(fn_call(TExprNodeType::BINARY_PRED, "gt",
+                                                       TYPE_BOOLEAN,
+                                                       {add(slot(0), slot(1)), slot(1)}))),
+                   _pool.add(new VExprContext(fn_call(TExprNodeType::BINARY_PRED, "lt",
+                                                       TYPE_BOOLEAN,
+                                                       {add(slot(0), slot(1)), slot(0)})))};
+        ASSERT_TRUE(VExpr::prepare(ctxs[i], &_state, *_row_desc).ok());
+        ASSERT_TRUE(VExpr::open(ctxs[i], &_state).ok());
+    }
+    EXPECT_EQ(1, keys_of(ctxs[1][0]).size());
+    EXPECT_EQ(1, keys_of(ctxs[1][1]).size());
+
+    // Each execution computes the subexprs again, so the columns of a former block or of the
+    // other conjunct aren't taken.
+    Block blocks[] = {make_block(-50, 40), make_block(1000, -7), make_block(3, 3)};
+    for (const auto& block : blocks) {
+        for (size_t j = 0; j < 2; ++j) {
+            check_equal(execute(ctxs[0][j], block), execute(ctxs[1][j], block));
+        }
+    }
+    VExpr::close(ctxs[0], &_state);
+    VExpr::close(ctxs[1], &_state);
+}
+
+TEST_F(VCommonSubexprTest, nondeterministic_functions_not_shared) {
+    auto make_tree = [&](const std::string& name, TFunctionBinaryType::type binary_type) {
+        auto call = [&]() {
+            return add(fn_call(TExprNodeType::FUNCTION_CALL, name, TYPE_BIGINT, {slot(0)},
+                               binary_type),
+                       slot(1));
+        };
+        return _pool.add(new VExprContext(multiply(call(), call())));
+    };
+    for (const std::string& name : {"rand", "random"}) {
+        auto context = make_tree(name, TFunctionBinaryType::BUILTIN);
+        VCommonSubexpr::eliminate(&_pool, {context});
+        EXPECT_TRUE(keys_of(context).empty()) << name;
+    }
+    auto udf = make_tree("my_udf", TFunctionBinaryType::JAVA_UDF);
+    VCommonSubexpr::eliminate(&_pool, {udf});
+    EXPECT_TRUE(keys_of(udf).empty());
+
+    // uuid() takes no arguments, but still changes from one call to another
+    auto concat_uuid = [&]() {
+        return fn_call(TExprNodeType::FUNCTION_CALL, "concat", TYPE_VARCHAR,
+                       {fn_call(TExprNodeType::FUNCTION_CALL, "uuid", TYPE_VARCHAR, {}), slot(0)});
+    };
+    auto uuid = _pool.add(new VExprContext(fn_call(TExprNodeType::BINARY_PRED, "eq", TYPE_BOOLEAN,
+                                                   {concat_uuid(), concat_uuid()})));
+    VCommonSubexpr::eliminate(&_pool, {uuid});
+    EXPECT_TRUE(keys_of(uuid).empty());
+
+    // the same tree with a deterministic function is shared
+    auto abs = make_tree("abs", TFunctionBinaryType::BUILTIN);
+    VCommonSubexpr::eliminate(&_pool, {abs});
+    EXPECT_EQ(2, keys_of(abs).size());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,152 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vfolded_constant.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/runtime_state.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vcompound_pred.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vliteral.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// the column of the block at the position
+class BlockColumnExpr final : public VExpr {
+public:
+    BlockColumnExpr(int column_id, PrimitiveType type)
+            : VExpr(TypeDescriptor(type), true, false), _column_id(column_id) {}
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        *result_column_id = _column_id;
+        return Status::OK();
+    }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new BlockColumnExpr(*this)); }
+    const std::string& expr_name() const override { return _expr_name; }
+    bool is_constant() const override { return false; }
+
+private:
+    int _column_id;
+    const std::string _expr_name = "block_column";
+};
+
+} // namespace
+
+class VFoldedConstantTest : public testing::Test {
+public:
+    VFoldedConstantTest() : _state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+    }
+
+protected:
+    VExpr* column(int column_id) { return _pool.add(new BlockColumnExpr(column_id, TYPE_BIGINT)); }
+
+    VExpr* int_literal(int64_t value) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::INT_LITERAL);
+        node.__set_type(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        TIntLiteral literal;
+        literal.__set_value(value);
+        node.__set_int_literal(literal);
+        return _pool.add(new VLiteral(node));
+    }
+
+    VExpr* fn_call(TExprNodeType::type node_type, const std::string& name, PrimitiveType type,
+                   const std::vector<VExpr*>& children) {
+        TExprNode node;
+        node.__set_node_type(node_type);
+        node.__set_type(TypeDescriptor(type).to_thrift());
+        node.__set_num_children(children.size());
+        TFunction fn;
+        fn.name.__set_function_name(name);
+        node.__set_fn(fn);
+        VExpr* expr = _pool.add(new VectorizedFnCall(node));
+        for (auto child : children) {
+            expr->add_child(child);
+        }
+        return expr;
+    }
+
+    VExpr* and_pred(VExpr* left, VExpr* right) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::COMPOUND_PRED);
+        node.__set_opcode(TExprOpcode::COMPOUND_AND);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        node.__set_num_children(2);
+        VExpr* expr = _pool.add(new VcompoundPred(node));
+        expr->add_child(left);
+        expr->add_child(right);
+        return expr;
+    }
+
+    VExprContext* open(VExpr* root) {
+        auto context = _pool.add(new VExprContext(root));
+        EXPECT_TRUE(context->prepare(&_state, RowDescriptor()).ok());
+        EXPECT_TRUE(context->open(&_state).ok());
+        return context;
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+};
+
+TEST_F(VFoldedConstantTest, constant_subtree) {
+    auto c0 = ColumnInt64::create();
+    for (int i = 0; i < 10; ++i) {
+        c0->insert_value(i);
+    }
+    Block block({{std::move(c0), std::make_shared<DataTypeInt64>(), "c0"}});
+
+    // c0 > 1 + 2
+    auto add = fn_call(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT,
+                       {int_literal(1), int_literal(2)});
+    auto context = open(fn_call(TExprNodeType::BINARY_PRED, "gt", TYPE_BOOLEAN, {column(0), add}));
+    ASSERT_NE(nullptr, dynamic_cast<VFoldedConstant*>(context->root()->children()[1]));
+    EXPECT_FALSE(VFoldedConstant::is_always_false(context->root()));
+
+    int result_column_id = -1;
+    ASSERT_TRUE(context->execute(&block, &result_column_id).ok());
+    const auto& result = block.get_by_position(result_column_id).column;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i > 3, result->get_bool(i)) << i;
+    }
+    context->close(&_state);
+}
+
+TEST_F(VFoldedConstantTest, always_false_conjunct) {
+    // c0 > 1 and 1 = 2
+    auto gt = fn_call(TExprNodeType::BINARY_PRED, "gt", TYPE_BOOLEAN, {column(0), int_literal(1)});
+    auto eq = fn_call(TExprNodeType::BINARY_PRED, "eq", TYPE_BOOLEAN,
+                      {int_literal(1), int_literal(2)});
+    auto context = open(and_pred(gt, eq));
+    EXPECT_TRUE(VFoldedConstant::is_always_false(context->root()));
+    context->close(&_state);
+}
+
+TEST_F(VFoldedConstantTest, nondeterministic_function) {
+    auto context = open(fn_call(TExprNodeType::FUNCTION_CALL, "random", TYPE_DOUBLE, {}));
+    EXPECT_EQ(nullptr, dynamic_cast<VFoldedConstant*>(context->root()));
+    context->close(&_state);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,198 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vfused_expr.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+// a leaf of the tree, which takes a column of the block
+class ColumnRefExpr final : public VExpr {
+public:
+    ColumnRefExpr(int column_id, PrimitiveType type, bool is_nullable)
+            : VExpr(TypeDescriptor(type), true, is_nullable), _column_id(column_id) {}
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        *result_column_id = _column_id;
+        return Status::OK();
+    }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new ColumnRefExpr(*this)); }
+    const std::string& expr_name() const override { return _expr_name; }
+    bool is_constant() const override { return false; }
+
+private:
+    int _column_id;
+    const std::string _expr_name = "column_ref";
+};
+
+class VFusedExprTest : public testing::Test {
+public:
+    VFusedExprTest() : _state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+    }
+
+    void TearDown() override { config::enable_vexpr_fusion = false; }
+
+protected:
+    VExpr* column_ref(int column_id, PrimitiveType type, bool is_nullable = false) {
+        return _pool.add(new ColumnRefExpr(column_id, type, is_nullable));
+    }
+
+    VExpr* fn_call(TExprNodeType::type node_type, const std::string& name, PrimitiveType type,
+                   const std::vector<VExpr*>& children) {
+        bool is_nullable = false;
+        for (auto child : children) {
+            is_nullable |= child->is_nullable();
+        }
+        TExprNode node;
+        node.__set_node_type(node_type);
+        node.__set_type(TypeDescriptor(type).to_thrift());
+        node.__set_is_nullable(is_nullable);
+        node.__set_num_children(children.size());
+        TFunction fn;
+        fn.name.__set_function_name(name);
+        node.__set_fn(fn);
+        VExpr* expr = _pool.add(new VectorizedFnCall(node));
+        for (auto child : children) {
+            expr->add_child(child);
+        }
+        return expr;
+    }
+
+    // Executes the tree made by the function with and without the fusion, and checks that the
+    // results are the same.
+    void check(const std::function<VExpr*()>& make_tree, const Block& block, bool fused) {
+        ColumnPtr results[2];
+        for (int i = 0; i < 2; ++i) {
+            config::enable_vexpr_fusion = i == 1;
+            auto context = _pool.add(new VExprContext(make_tree()));
+            ASSERT_TRUE(context->prepare(&_state, RowDescriptor()).ok());
+            ASSERT_TRUE(context->open(&_state).ok());
+            if (i == 1) {
+                EXPECT_EQ(fused, dynamic_cast<VFusedExpr*>(context->root()) != nullptr);
+            }
+            Block tmp_block(block.get_columns_with_type_and_name());
+            int result_column_id = -1;
+            ASSERT_TRUE(context->execute(&tmp_block, &result_column_id).ok());
+            results[i] = tmp_block.get_by_position(result_column_id).column;
+            context->close(&_state);
+        }
+        ASSERT_EQ(block.rows(), results[1]->size());
+        for (size_t row = 0; row < block.rows(); ++row) {
+            EXPECT_EQ((*results[0])[row], (*results[1])[row]) << "row " << row;
+        }
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+};
+
+TEST_F(VFusedExprTest, arithmetic_and_comparison) {
+    auto c0 = ColumnInt64::create();
+    auto c1 = ColumnInt64::create();
+    auto c2 = ColumnInt32::create();
+    for (int i = 0; i < 1000; ++i) {
+        c0->insert_value(i - 500);
+        c1->insert_value(i * 7 % 13);
+        c2->insert_value(i * 3);
+    }
+    Block block({{std::move(c0), std::make_shared<DataTypeInt64>(), "c0"},
+                 {std::move(c1), std::make_shared<DataTypeInt64>(), "c1"},
+                 {std::move(c2), std::make_shared<DataTypeInt32>(), "c2"}});
+
+    // c0 * c1 + c0 > c2
+    check(
+            [&]() {
+                auto mul = fn_call(TExprNodeType::ARITHMETIC_EXPR, "multiply", TYPE_BIGINT,
+                                   {column_ref(0, TYPE_BIGINT), column_ref(1, TYPE_BIGINT)});
+                auto add = fn_call(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT,
+                                   {mul, column_ref(0, TYPE_BIGINT)});
+                return fn_call(TExprNodeType::BINARY_PRED, "gt", TYPE_BOOLEAN,
+                               {add, column_ref(2, TYPE_INT)});
+            },
+            block, true);
+
+    // c0 > c2 or c1 <= c0 - c2
+    check(
+            [&]() {
+                auto gt = fn_call(TExprNodeType::BINARY_PRED, "gt", TYPE_BOOLEAN,
+                                  {column_ref(0, TYPE_BIGINT), column_ref(2, TYPE_INT)});
+                auto sub = fn_call(TExprNodeType::ARITHMETIC_EXPR, "subtract", TYPE_BIGINT,
+                                   {column_ref(0, TYPE_BIGINT), column_ref(2, TYPE_INT)});
+                auto le = fn_call(TExprNodeType::BINARY_PRED, "le", TYPE_BOOLEAN,
+                                  {column_ref(1, TYPE_BIGINT), sub});
+                return fn_call(TExprNodeType::COMPOUND_PRED, "or", TYPE_BOOLEAN, {gt, le});
+            },
+            block, true);
+
+    // a single operation is not fused
+    check(
+            [&]() {
+                return fn_call(TExprNodeType::ARITHMETIC_EXPR, "add", TYPE_BIGINT,
+                               {column_ref(0, TYPE_BIGINT), column_ref(1, TYPE_BIGINT)});
+            },
+            block, false);
+}
+
+TEST_F(VFusedExprTest, nullable_inputs) {
+    auto c0 = ColumnFloat64::create();
+    auto c1 = ColumnFloat64::create();
+    auto nulls = ColumnUInt8::create();
+    for (int i = 0; i < 1000; ++i) {
+        c0->insert_value(i * 0.5);
+        c1->insert_value(1000 - i);
+        nulls->insert_value(i % 3 == 0);
+    }
+    auto nullable_type = make_nullable(std::make_shared<DataTypeFloat64>());
+    Block block({{ColumnNullable::create(std::move(c0), std::move(nulls)), nullable_type, "c0"},
+                 {std::move(c1), std::make_shared<DataTypeFloat64>(), "c1"}});
+
+    // c0 * c1 - c1 < c0
+    check(
+            [&]() {
+                auto mul = fn_call(TExprNodeType::ARITHMETIC_EXPR, "multiply", TYPE_DOUBLE,
+                                   {column_ref(0, TYPE_DOUBLE, true), column_ref(1, TYPE_DOUBLE)});
+                auto sub = fn_call(TExprNodeType::ARITHMETIC_EXPR, "subtract", TYPE_DOUBLE,
+                                   {mul, column_ref(1, TYPE_DOUBLE)});
+                return fn_call(TExprNodeType::BINARY_PRED, "lt", TYPE_BOOLEAN,
+                               {sub, column_ref(0, TYPE_DOUBLE, true)});
+            },
+            block, true);
+
+    // the nulls don't propagate through the compound predicates
+    check(
+            [&]() {
+                auto lt = fn_call(TExprNodeType::BINARY_PRED, "lt", TYPE_BOOLEAN,
+                                  {column_ref(0, TYPE_DOUBLE, true), column_ref(1, TYPE_DOUBLE)});
+                auto ge = fn_call(TExprNodeType::BINARY_PRED, "ge", TYPE_BOOLEAN,
+                                  {column_ref(1, TYPE_DOUBLE), column_ref(0, TYPE_DOUBLE, true)});
+                return fn_call(TExprNodeType::COMPOUND_PRED, "or", TYPE_BOOLEAN, {lt, ge});
+            },
+            block, false);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,256 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exprs/vmulti_match_pred.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "common/config.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "testutil/desc_tbl_builder.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exprs/vcompound_pred.h"
+#include "vec/exprs/vectorized_fn_call.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vliteral.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// a LIKE or REGEXP predicate on a slot
+struct Disjunct {
+    std::string fn_name;
+    std::string pattern;
+    int slot = 0;
+};
+
+} // namespace
+
+class VMultiMatchPredTest : public testing::Test {
+public:
+    VMultiMatchPredTest() : _state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+        DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << TypeDescriptor::create_varchar_type(64)
+                                << TypeDescriptor::create_varchar_type(64);
+        DescriptorTbl* desc_tbl = builder.build();
+        _state.set_desc_tbl(desc_tbl);
+        _tuple_desc = const_cast<TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0));
+        _row_desc.reset(new RowDescriptor(_tuple_desc, false));
+    }
+
+    void TearDown() override { config::enable_multi_pattern_match = true; }
+
+protected:
+    VExpr* slot(int index) { return _pool.add(new VSlotRef(_tuple_desc->slots()[index])); }
+
+    VExpr* string_literal(const std::string& value) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::STRING_LITERAL);
+        node.__set_type(TypeDescriptor::create_varchar_type(64).to_thrift());
+        node.__set_is_nullable(false);
+        node.__set_num_children(0);
+        TStringLiteral literal;
+        literal.__set_value(value);
+        node.__set_string_literal(literal);
+        return _pool.add(new VLiteral(node));
+    }
+
+    VExpr* match_pred(const std::string& fn_name, VExpr* value, VExpr* pattern) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::FUNCTION_CALL);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        node.__set_is_nullable(true);
+        node.__set_num_children(2);
+        TFunction fn;
+        fn.name.__set_function_name(fn_name);
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        node.__set_fn(fn);
+        VExpr* expr = _pool.add(new VectorizedFnCall(node));
+        expr->add_child(value);
+        expr->add_child(pattern);
+        return expr;
+    }
+
+    VExpr* or_pred(VExpr* left, VExpr* right) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::COMPOUND_PRED);
+        node.__set_opcode(TExprOpcode::COMPOUND_OR);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        node.__set_is_nullable(true);
+        node.__set_num_children(2);
+        VExpr* expr = _pool.add(new VcompoundPred(node));
+        expr->add_child(left);
+        expr->add_child(right);
+        return expr;
+    }
+
+    VExpr* make_tree(const std::vector<Disjunct>& disjuncts) {
+        VExpr* root = nullptr;
+        for (auto& disjunct : disjuncts) {
+            VExpr* pred = match_pred(disjunct.fn_name, slot(disjunct.slot),
+                                     string_literal(disjunct.pattern));
+            root = root == nullptr ? pred : or_pred(root, pred);
+        }
+        return root;
+    }
+
+    // the values of both slots, where the null values are nulls
+    static Block make_block(const std::vector<std::optional<std::string>>& values) {
+        auto type = make_nullable(std::make_shared<DataTypeString>());
+        Block block;
+        for (int i = 0; i < 2; ++i) {
+            auto column = ColumnNullable::create(ColumnString::create(), ColumnUInt8::create());
+            for (auto& value : values) {
+                if (value.has_value()) {
+                    column->insert_data(value->data(), value->size());
+                } else {
+                    column->insert_default();
+                }
+            }
+            block.insert({std::move(column), type, fmt::format("c{}", i)});
+        }
+        return block;
+    }
+
+    static bool has_multi_match(VExpr* expr) {
+        if (dynamic_cast<VMultiMatchPred*>(expr) != nullptr) {
+            return true;
+        }
+        for (auto child : expr->children()) {
+            if (has_multi_match(child)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Executes the tree with and without the rewrite, checks that the results are the same, and
+    // that an or-chain of the tree is rewritten or not.
+    void check_tree(const std::function<VExpr*()>& make_root, const Block& block, bool rewritten) {
+        ColumnPtr results[2];
+        for (int i = 0; i < 2; ++i) {
+            config::enable_multi_pattern_match = i == 1;
+            auto context = _pool.add(new VExprContext(make_root()));
+            ASSERT_TRUE(context->prepare(&_state, *_row_desc).ok());
+            ASSERT_TRUE(context->open(&_state).ok());
+            EXPECT_EQ(i == 1 && rewritten, has_multi_match(context->root()));
+            Block tmp_block(block.get_columns_with_type_and_name());
+            int result_column_id = -1;
+            ASSERT_TRUE(context->execute(&tmp_block, &result_column_id).ok());
+            results[i] = tmp_block.get_by_position(result_column_id).column;
+            context->close(&_state);
+        }
+        ASSERT_EQ(block.rows(), results[1]->size());
+        for (size_t row = 0; row < block.rows(); ++row) {
+            EXPECT_EQ((*results[0])[row], (*results[1])[row]) << "row " << row;
+        }
+    }
+
+    void check(const std::vector<Disjunct>& disjuncts, const Block& block, bool rewritten) {
+        check_tree([&]() { return make_tree(disjuncts); }, block, rewritten);
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    TupleDescriptor* _tuple_desc;
+    std::unique_ptr<RowDescriptor> _row_desc;
+};
+
+TEST_F(VMultiMatchPredTest, like_anchored_regexp_not) {
+    Block block = make_block({"abc", "xabcx", "ab", "cab", "", "ABC", "b", "abcabc"});
+    // LIKE matches the whole string
+    check({{"like", "abc"}, {"like", "ab"}}, block, true);
+    // REGEXP matches any part of the string unless it's anchored
+    check({{"regexp", "abc"}, {"regexp", "^b"}}, block, true);
+    check({{"like", "ab"}, {"regexp", "c$"}, {"like", "b"}}, block, true);
+    // the anchors of a REGEXP don't leak into the other patterns
+    check({{"regexp", "^a|x$"}, {"like", "%b%"}}, block, true);
+}
+
+TEST_F(VMultiMatchPredTest, like_wildcards) {
+    Block block = make_block({"abc", "ac", "a\nc", "abbc", "h\xc3\xa9llo", "hello", "hllo", "_",
+                              "%", "a.c", "a*c", "", "x"});
+    check({{"like", "a%c"}, {"like", "_"}}, block, true);
+    check({{"like", "h_llo"}, {"like", "a_c"}}, block, true);
+    check({{"like", "%b%"}, {"like", "%"}}, block, true);
+    // the regex chars of a LIKE pattern are literals
+    check({{"like", "a.c"}, {"like", "a*c"}, {"like", "(%"}}, block, true);
+}
+
+TEST_F(VMultiMatchPredTest, like_escapes) {
+    Block block = make_block({"a%c", "a_c", "abc", "a\\c", "a\\bc", "abc%", "%", "_", "\\"});
+    check({{"like", "a\\%c"}, {"like", "a\\_c"}}, block, true);
+    check({{"like", "%\\%"}, {"like", "\\_"}}, block, true);
+    // FunctionLike matches the other escapes differently by string comparison and by regex, so
+    // they are left to it
+    check({{"like", "a\\bc"}, {"like", "a\\%c"}}, block, false);
+    check({{"like", "a\\\\c"}, {"like", "a_c"}}, block, false);
+    check({{"like", "\\"}, {"like", "a_c"}}, block, false);
+}
+
+TEST_F(VMultiMatchPredTest, null_values) {
+    Block block = make_block({std::nullopt, "abc", std::nullopt, "", "xyz", std::nullopt});
+    check({{"like", "a%"}, {"regexp", "y"}}, block, true);
+    check({{"like", "%"}, {"regexp", ""}}, block, true);
+}
+
+TEST_F(VMultiMatchPredTest, not_rewritten) {
+    Block block = make_block({"abc", "xabcx", std::nullopt, "b"});
+    // not on the same column
+    check({{"like", "abc", 0}, {"like", "b", 1}}, block, false);
+    // a single predicate is not an or
+    check({{"regexp", "b"}}, block, false);
+    // the pattern is not a constant
+    check_tree(
+            [&]() {
+                return or_pred(match_pred("like", slot(0), slot(1)),
+                               match_pred("like", slot(0), string_literal("b")));
+            },
+            block, false);
+}
+
+TEST_F(VMultiMatchPredTest, nested_or_chain) {
+    Block block = make_block({"abc", "xabcx", std::nullopt, "b", "ax"});
+    // (c0 LIKE '%b%' OR c0 REGEXP 'x$') AND c1 LIKE 'a%'
+    check_tree(
+            [&]() {
+                TExprNode node;
+                node.__set_node_type(TExprNodeType::COMPOUND_PRED);
+                node.__set_opcode(TExprOpcode::COMPOUND_AND);
+                node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+                node.__set_is_nullable(true);
+                node.__set_num_children(2);
+                VExpr* expr = _pool.add(new VcompoundPred(node));
+                expr->add_child(make_tree({{"like", "%b%"}, {"regexp", "x$"}}));
+                expr->add_child(match_pred("like", slot(1), string_literal("a%")));
+                return expr;
+            },
+            block, true);
+}
+
+} // namespace doris::vectorized
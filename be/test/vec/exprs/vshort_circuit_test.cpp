@@ -0,0 +1,267 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vcase_expr.h"
+#include "vec/exprs/vcompound_pred.h"
+#include "vec/exprs/vexpr_context.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// the column of the block at the position, which counts the rows it's executed on
+class CountingColumnExpr final : public VExpr {
+public:
+    CountingColumnExpr(int column_id, PrimitiveType type, bool is_nullable, size_t* rows)
+            : VExpr(TypeDescriptor(type), true, is_nullable), _column_id(column_id), _rows(rows) {}
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        *_rows += block->rows();
+        *result_column_id = _column_id;
+        return Status::OK();
+    }
+    VExpr* clone(ObjectPool* pool) const override {
+        return pool->add(new CountingColumnExpr(*this));
+    }
+    const std::string& expr_name() const override { return _expr_name; }
+    bool is_constant() const override { return false; }
+    void collect_column_ids(std::set<int>* column_ids) const override {
+        column_ids->insert(_column_id);
+    }
+
+private:
+    int _column_id;
+    size_t* _rows;
+    const std::string _expr_name = "counting_column";
+};
+
+} // namespace
+
+class VShortCircuitTest : public testing::Test {
+public:
+    VShortCircuitTest() : _state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr) {
+        _state.init_instance_mem_tracker();
+    }
+
+    void TearDown() override { config::enable_short_circuit_evaluation = true; }
+
+protected:
+    VExpr* column(int column_id, PrimitiveType type, bool is_nullable = false,
+                  size_t* rows = nullptr) {
+        return _pool.add(new CountingColumnExpr(column_id, type, is_nullable,
+                                                rows != nullptr ? rows : &_ignored_rows));
+    }
+
+    VExpr* compound_pred(TExprOpcode::type opcode, VExpr* left, VExpr* right) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::COMPOUND_PRED);
+        node.__set_opcode(opcode);
+        node.__set_type(TypeDescriptor(TYPE_BOOLEAN).to_thrift());
+        node.__set_is_nullable(left->is_nullable() || right->is_nullable());
+        node.__set_num_children(2);
+        VExpr* expr = _pool.add(new VcompoundPred(node));
+        expr->add_child(left);
+        expr->add_child(right);
+        return expr;
+    }
+
+    VExpr* case_expr(PrimitiveType type, bool has_else, const std::vector<VExpr*>& children) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::CASE_EXPR);
+        node.__set_type(TypeDescriptor(type).to_thrift());
+        node.__set_is_nullable(!has_else);
+        TCaseExpr case_node;
+        case_node.__set_has_case_expr(false);
+        case_node.__set_has_else_expr(has_else);
+        node.__set_case_expr(case_node);
+        node.__set_num_children(children.size());
+        VExpr* expr = _pool.add(new VCaseExpr(node));
+        for (auto child : children) {
+            expr->add_child(child);
+        }
+        return expr;
+    }
+
+    // Executes the tree with and without the short-circuit evaluation, checks that the results are
+    // the same and returns the one of the short-circuit evaluation.
+    ColumnPtr execute(const std::function<VExpr*()>& make_tree, const Block& block) {
+        ColumnPtr results[2];
+        for (int i = 0; i < 2; ++i) {
+            config::enable_short_circuit_evaluation = i == 1;
+            auto context = _pool.add(new VExprContext(make_tree()));
+            EXPECT_TRUE(context->prepare(&_state, RowDescriptor()).ok());
+            EXPECT_TRUE(context->open(&_state).ok());
+            Block tmp_block(block.get_columns_with_type_and_name());
+            int result_column_id = -1;
+            EXPECT_TRUE(context->execute(&tmp_block, &result_column_id).ok());
+            results[i] = tmp_block.get_by_position(result_column_id).column;
+            context->close(&_state);
+        }
+        EXPECT_EQ(block.rows(), results[1]->size());
+        for (size_t row = 0; row < block.rows(); ++row) {
+            EXPECT_EQ((*results[0])[row], (*results[1])[row]) << "row " << row;
+        }
+        return results[1];
+    }
+
+    ObjectPool _pool;
+    RuntimeState _state;
+    size_t _ignored_rows = 0;
+};
+
+// the rows of c0 are true on the rows divisible by 3 and null on the rows divisible by 5, the ones
+// of c1 are true on the even rows
+static Block make_bool_block(size_t rows) {
+    auto c0 = ColumnUInt8::create();
+    auto null_map = ColumnUInt8::create();
+    auto c1 = ColumnUInt8::create();
+    for (size_t i = 0; i < rows; ++i) {
+        c0->insert_value(i % 3 == 0);
+        null_map->insert_value(i % 5 == 0);
+        c1->insert_value(i % 2 == 0);
+    }
+    auto bool_type = std::make_shared<DataTypeUInt8>();
+    return Block({{ColumnNullable::create(std::move(c0), std::move(null_map)),
+                   make_nullable(bool_type), "c0"},
+                  {std::move(c1), bool_type, "c1"}});
+}
+
+TEST_F(VShortCircuitTest, and_pred) {
+    const size_t rows = 1000;
+    Block block = make_bool_block(rows);
+    size_t right_rows = 0;
+    auto result = execute(
+            [&]() {
+                right_rows = 0;
+                return compound_pred(TExprOpcode::COMPOUND_AND, column(0, TYPE_BOOLEAN, true),
+                                     column(1, TYPE_BOOLEAN, false, &right_rows));
+            },
+            block);
+
+    size_t expected_rows = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        bool left_null = i % 5 == 0;
+        bool left = i % 3 == 0;
+        bool right = i % 2 == 0;
+        expected_rows += left || left_null;
+        if (left_null && right) {
+            EXPECT_TRUE(result->is_null_at(i)) << i;
+        } else {
+            EXPECT_FALSE(result->is_null_at(i)) << i;
+            EXPECT_EQ(!left_null && left && right, result->get_bool(i)) << i;
+        }
+    }
+    // the right side is only executed on the rows whose left side is true or null
+    EXPECT_EQ(expected_rows, right_rows);
+}
+
+TEST_F(VShortCircuitTest, or_pred) {
+    const size_t rows = 1000;
+    Block block = make_bool_block(rows);
+    size_t right_rows = 0;
+    auto result = execute(
+            [&]() {
+                right_rows = 0;
+                return compound_pred(TExprOpcode::COMPOUND_OR, column(0, TYPE_BOOLEAN, true),
+                                     column(1, TYPE_BOOLEAN, false, &right_rows));
+            },
+            block);
+
+    size_t expected_rows = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        bool left_null = i % 5 == 0;
+        bool left = i % 3 == 0;
+        bool right = i % 2 == 0;
+        expected_rows += !left || left_null;
+        if (left_null && !right) {
+            EXPECT_TRUE(result->is_null_at(i)) << i;
+        } else {
+            EXPECT_FALSE(result->is_null_at(i)) << i;
+            EXPECT_EQ((!left_null && left) || right, result->get_bool(i)) << i;
+        }
+    }
+    // the right side is only executed on the rows whose left side is false or null
+    EXPECT_EQ(expected_rows, right_rows);
+}
+
+TEST_F(VShortCircuitTest, case_expr) {
+    // case when c0 then c2 when c1 then c3 else c4 end
+    const size_t rows = 1000;
+    auto c0 = ColumnUInt8::create();
+    auto c1 = ColumnUInt8::create();
+    auto c2 = ColumnInt64::create();
+    auto c3 = ColumnInt64::create();
+    auto c4 = ColumnInt64::create();
+    for (size_t i = 0; i < rows; ++i) {
+        c0->insert_value(i % 3 == 0);
+        c1->insert_value(i % 2 == 0);
+        c2->insert_value(i);
+        c3->insert_value(i * 10);
+        c4->insert_value(-1);
+    }
+    auto bool_type = std::make_shared<DataTypeUInt8>();
+    auto int_type = std::make_shared<DataTypeInt64>();
+    Block block({{std::move(c0), bool_type, "c0"},
+                 {std::move(c1), bool_type, "c1"},
+                 {std::move(c2), int_type, "c2"},
+                 {std::move(c3), int_type, "c3"},
+                 {std::move(c4), int_type, "c4"}});
+
+    size_t branch_rows[5] = {0, 0, 0, 0, 0};
+    auto result = execute(
+            [&]() {
+                std::vector<VExpr*> children;
+                for (int i = 0; i < 5; ++i) {
+                    branch_rows[i] = 0;
+                    children.push_back(column(i, i < 2 ? TYPE_BOOLEAN : TYPE_BIGINT, false,
+                                              &branch_rows[i]));
+                }
+                return case_expr(TYPE_BIGINT, true, children);
+            },
+            block);
+
+    size_t matched[3] = {0, 0, 0};
+    for (size_t i = 0; i < rows; ++i) {
+        int64_t expected = -1;
+        if (i % 3 == 0) {
+            expected = i;
+            ++matched[0];
+        } else if (i % 2 == 0) {
+            expected = i * 10;
+            ++matched[1];
+        } else {
+            ++matched[2];
+        }
+        EXPECT_EQ(expected, result->get_int(i)) << i;
+    }
+    // each when is executed on the rows not matched before it, and each then on its matched rows
+    EXPECT_EQ(rows, branch_rows[0]);
+    EXPECT_EQ(matched[0], branch_rows[2]);
+    EXPECT_EQ(rows - matched[0], branch_rows[1]);
+    EXPECT_EQ(matched[1], branch_rows[3]);
+    EXPECT_EQ(matched[2], branch_rows[4]);
+}
+
+} // namespace doris::vectorized
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "function_test_util.h"
+#include "runtime/decimalv2_value.h"
 #include "runtime/tuple_row.h"
 #include "util/url_coding.h"
 #include "vec/core/field.h"
@@ -55,6 +56,35 @@ TEST(function_arithmetic_test, function_arithmetic_divide_test) {
     }
 }
 
+TEST(function_arithmetic_test, decimal_plus_minus_test) {
+    Decimal128 max_decimal(DecimalV2Value::MAX_DECIMAL_VALUE);
+    Decimal128 min_decimal(-DecimalV2Value::MAX_DECIMAL_VALUE);
+    InputTypeSet input_types = {TypeIndex::Decimal128, TypeIndex::Decimal128};
+
+    {
+        DataSet data_set = {{{DECIMAL(1.5), DECIMAL(2.25)}, DECIMAL(3.75)},
+                            {{DECIMAL(-1.5), DECIMAL(0.5)}, DECIMAL(-1.0)},
+                            {{max_decimal, DECIMAL(-1.0)}, Decimal128(max_decimal - DECIMAL(1.0))},
+                            {{Null(), DECIMAL(1.0)}, Null()}};
+        check_function<DataTypeDecimal<Decimal128>, true>("add", input_types, data_set);
+    }
+
+    {
+        // the sums out of the range saturate
+        DataSet data_set = {{{DECIMAL(1.5), DECIMAL(2.25)}, DECIMAL(3.75)},
+                            {{max_decimal, DECIMAL(1.0)}, max_decimal},
+                            {{min_decimal, DECIMAL(-1.0)}, min_decimal}};
+        check_function<DataTypeDecimal<Decimal128>, true>("add", input_types, data_set);
+    }
+
+    {
+        DataSet data_set = {{{DECIMAL(1.5), DECIMAL(2.25)}, DECIMAL(-0.75)},
+                            {{max_decimal, DECIMAL(-1.0)}, max_decimal},
+                            {{min_decimal, DECIMAL(1.0)}, min_decimal}};
+        check_function<DataTypeDecimal<Decimal128>, true>("subtract", input_types, data_set);
+    }
+}
+
 TEST(function_arithmetic_test, bitnot_test) {
     std::string func_name = "bitnot";
 
@@ -166,6 +166,41 @@ TEST(function_array_index_test, array_contains) {
 
         check_function<DataTypeUInt8, true>(func_name, input_types, data_set);
     }
+
+    // array_contains(Array<Int32>, const Int32)
+    {
+        InputTypeSet input_types = {TypeIndex::Array, TypeIndex::Int32, Consted {TypeIndex::Int32}};
+
+        Array vec = {Int32(1), Int32(2), Int32(3)};
+        Array vec_with_null = {Int32(1), Null(), Int32(2)};
+        DataSet data_set = {{{vec, 2}, UInt8(1)},
+                            {{vec, 4}, UInt8(0)},
+                            {{vec_with_null, 2}, UInt8(1)},
+                            {{Null(), 1}, Null()},
+                            {{empty_arr, 1}, UInt8(0)}};
+        for (const auto& line : data_set) {
+            DataSet const_dataset = {line};
+            check_function<DataTypeUInt8, true>(func_name, input_types, const_dataset);
+        }
+    }
+
+    // array_contains(Array<String>, const String)
+    {
+        InputTypeSet input_types = {TypeIndex::Array, TypeIndex::String,
+                                    Consted {TypeIndex::String}};
+
+        Array vec = {Field("abc", 3), Field("", 0), Field("def", 3)};
+        DataSet data_set = {{{vec, std::string("abc")}, UInt8(1)},
+                            {{vec, std::string("ab")}, UInt8(0)},
+                            {{vec, std::string("aaa")}, UInt8(0)},
+                            {{vec, std::string("")}, UInt8(1)},
+                            {{Null(), std::string("abc")}, Null()},
+                            {{empty_arr, std::string("")}, UInt8(0)}};
+        for (const auto& line : data_set) {
+            DataSet const_dataset = {line};
+            check_function<DataTypeUInt8, true>(func_name, input_types, const_dataset);
+        }
+    }
 }
 
 TEST(function_array_index_test, array_position) {
@@ -268,6 +303,22 @@ TEST(function_array_index_test, array_position) {
 
         check_function<DataTypeInt64, true>(func_name, input_types, data_set);
     }
+
+    // array_position(Array<String>, const String)
+    {
+        InputTypeSet input_types = {TypeIndex::Array, TypeIndex::String,
+                                    Consted {TypeIndex::String}};
+
+        Array vec = {Field("abc", 3), Field("", 0), Field("def", 3)};
+        DataSet data_set = {{{vec, std::string("def")}, Int64(3)},
+                            {{vec, std::string("aaa")}, Int64(0)},
+                            {{vec, std::string("")}, Int64(2)},
+                            {{empty_arr, std::string("")}, Int64(0)}};
+        for (const auto& line : data_set) {
+            DataSet const_dataset = {line};
+            check_function<DataTypeInt64, true>(func_name, input_types, const_dataset);
+        }
+    }
 }
 
 } // namespace doris::vectorized
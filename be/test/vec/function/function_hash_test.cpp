@@ -88,4 +88,55 @@ TEST(HashFunctionTest, murmur_hash_2_test) {
     };
 }
 
+TEST(HashFunctionTest, murmur_hash_3_64_test) {
+    std::string func_name = "murmur_hash3_64";
+
+    {
+        InputTypeSet input_types = {TypeIndex::String};
+
+        DataSet data_set = {{{Null()}, Null()},
+                            {{std::string("hello")}, (int64_t)4118559451821261121ll}};
+
+        check_function<DataTypeInt64, true>(func_name, input_types, data_set);
+    };
+
+    {
+        InputTypeSet input_types = {TypeIndex::String, TypeIndex::String};
+
+        DataSet data_set = {
+                {{std::string("hello"), std::string("world")}, (int64_t)5194444502277058613ll},
+                {{std::string("hello"), Null()}, Null()}};
+
+        check_function<DataTypeInt64, true>(func_name, input_types, data_set);
+    };
+}
+
+TEST(HashFunctionTest, xxhash_64_test) {
+    std::string func_name = "xxhash_64";
+
+    {
+        InputTypeSet input_types = {TypeIndex::String};
+
+        // the reference values of XXH64 with the seed 0
+        DataSet data_set = {
+                {{Null()}, Null()},
+                {{std::string("")}, (int64_t)-1205034819632174695ll},
+                {{std::string("hello")}, (int64_t)2794345569481354659ll},
+                {{std::string("Nobody inspects the spammish repetition")},
+                 (int64_t)-302119147016844303ll}};
+
+        check_function<DataTypeInt64, true>(func_name, input_types, data_set);
+    };
+
+    {
+        InputTypeSet input_types = {TypeIndex::String, TypeIndex::String};
+
+        DataSet data_set = {
+                {{std::string("hello"), std::string("world")}, (int64_t)8004569595807101537ll},
+                {{std::string("hello"), Null()}, Null()}};
+
+        check_function<DataTypeInt64, true>(func_name, input_types, data_set);
+    };
+}
+
 } // namespace doris::vectorized
@@ -18,8 +18,11 @@
 #include <gtest/gtest.h>
 
 #include "function_test_util.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_string.h"
 #include "vec/data_types/data_type_number.h"
 #include "vec/data_types/data_type_string.h"
+#include "vec/functions/json_documents.h"
 
 namespace doris::vectorized {
 using namespace ut_type;
@@ -66,4 +69,67 @@ TEST(FunctionJsonTEST, GetJsonStringTest) {
     check_function<DataTypeString, true>(func_name, input_types, data_set);
 }
 
+TEST(FunctionJsonTEST, GetJsonStringPathsTest) {
+    std::string func_name = "get_json_string";
+    InputTypeSet input_types = {TypeIndex::String, TypeIndex::String};
+    // the paths vary between the rows
+    std::string json = "[{\"k1\":[\"v1\", \"v2\"]}, {\"k1\":\"v3\"}]";
+    DataSet data_set = {
+            {{VARCHAR(json), VARCHAR("$.k1")}, VARCHAR("[\"v1\",\"v2\",\"v3\"]")},
+            {{VARCHAR(json), VARCHAR("$.k1")}, VARCHAR("[\"v1\",\"v2\",\"v3\"]")},
+            {{VARCHAR(json), VARCHAR("$")},
+             VARCHAR("[{\"k1\":[\"v1\",\"v2\"]},{\"k1\":\"v3\"}]")},
+            {{VARCHAR(json), VARCHAR("$.k2")}, Null()},
+            {{VARCHAR("{\"k1\":"), VARCHAR("$.k1")}, Null()},
+            {{VARCHAR("{\"k1\":\"v1\"}"), VARCHAR("k1")}, Null()}};
+
+    check_function<DataTypeString, true>(func_name, input_types, data_set);
+}
+
+TEST(FunctionJsonTEST, JsonDocumentsCacheTest) {
+    RuntimeState state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+    ASSERT_TRUE(state.init_instance_mem_tracker().ok());
+    auto make_column = [](const std::vector<std::string>& strings) {
+        auto column = ColumnString::create();
+        for (const auto& str : strings) {
+            column->insert_data(str.data(), str.size());
+        }
+        return column;
+    };
+    auto column = make_column({"{\"k1\":1}", "{\"k1\":2}", "{\"k1\":"});
+
+    auto documents = JsonDocumentsCache::of(&state, column->get_chars(), column->get_offsets());
+    ASSERT_NE(documents->get(1), nullptr);
+    EXPECT_EQ(2, (*documents->get(1))["k1"].GetInt());
+    EXPECT_EQ(documents->get(2), nullptr);
+    JsonDocumentsCache* cache = state.json_documents_cache();
+    EXPECT_GT(cache->consumption(), 0);
+
+    // documents in use are not shared with another column of the same strings
+    auto other = JsonDocumentsCache::of(&state, column->get_chars(), column->get_offsets());
+    EXPECT_NE(documents, other);
+    JsonDocuments* raw_documents = documents.get();
+    documents.reset();
+    other.reset();
+
+    // the strings of another column are compared, not its buffers
+    auto same_column = make_column({"{\"k1\":1}", "{\"k1\":2}", "{\"k1\":"});
+    documents = JsonDocumentsCache::of(&state, same_column->get_chars(),
+                                       same_column->get_offsets());
+    EXPECT_EQ(raw_documents, documents.get());
+    auto changed_column = make_column({"{\"k1\":1}", "{\"k1\":3}", "{\"k1\":"});
+    other = JsonDocumentsCache::of(&state, changed_column->get_chars(),
+                                   changed_column->get_offsets());
+    EXPECT_NE(documents, other);
+    EXPECT_EQ(3, (*other->get(1))["k1"].GetInt());
+    documents.reset();
+    other.reset();
+
+    // without a state the documents are not cached
+    int64_t consumption = cache->consumption();
+    documents = JsonDocumentsCache::of(nullptr, column->get_chars(), column->get_offsets());
+    EXPECT_EQ(1, (*documents->get(0))["k1"].GetInt());
+    EXPECT_EQ(consumption, cache->consumption());
+}
+
 } // namespace doris::vectorized
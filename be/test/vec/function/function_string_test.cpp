@@ -45,6 +45,9 @@ TEST(function_string_test, function_string_substr_test) {
                 {{std::string(""), 0, 4}, std::string("")},
                 {{std::string("123"), 0, 4}, std::string("")},
                 {{std::string("123"), 1, 0}, std::string("")},
+                {{std::string("你好世界"), -3, 2}, std::string("好世")},
+                {{std::string("你好"), 3, 1}, Null()},
+                {{std::string("123"), -4, 1}, Null()},
                 {{Null(), 5, 4}, Null()}};
 
         check_function<DataTypeString, true>(func_name, input_types, data_set);
@@ -107,6 +110,7 @@ TEST(function_string_test, function_string_lower_test) {
                         {{std::string("HELLO123")}, std::string("hello123")},
                         {{std::string("MYtestSTR")}, std::string("myteststr")},
                         {{std::string("HELLO,!^%")}, std::string("hello,!^%")},
+                        {{std::string("ÀÉ ΑΣΩ ЖЯЁ 你好")}, std::string("àé ασω жяё 你好")},
                         {{std::string("")}, std::string("")}};
 
     check_function<DataTypeString, true>(func_name, input_types, data_set);
@@ -119,6 +123,7 @@ TEST(function_string_test, function_string_upper_test) {
                         {{std::string("hello123")}, std::string("HELLO123")},
                         {{std::string("HELLO,!^%")}, std::string("HELLO,!^%")},
                         {{std::string("MYtestStr")}, std::string("MYTESTSTR")},
+                        {{std::string("àé ασως жяё 你好")}, std::string("ÀÉ ΑΣΩΣ ЖЯЁ 你好")},
                         {{std::string("")}, std::string("")}};
 
     check_function<DataTypeString, true>(func_name, input_types, data_set);
@@ -303,6 +308,7 @@ TEST(function_string_test, function_char_length_test) {
     DataSet data_set = {{{std::string("")}, 0},    {{std::string("aa")}, 2},
                         {{std::string("我")}, 1},  {{std::string("我a")}, 2},
                         {{std::string("a我")}, 2}, {{std::string("123")}, 3},
+                        {{std::string("数据库管理系统Doris")}, 12},
                         {{Null()}, Null()}};
 
     check_function<DataTypeInt32, true>(func_name, input_types, data_set);
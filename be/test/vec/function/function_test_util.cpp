@@ -265,7 +265,7 @@ Block* create_block_from_inputset(const InputTypeSet& input_types, const InputDa
 }
 
 Block* process_table_function(TableFunction* fn, Block* input_block,
-                              const InputTypeSet& output_types) {
+                              const InputTypeSet& output_types, int max_step) {
     // pasrse output data types
     ut_type::UTDataTypeDescs descs;
     if (!parse_ut_data_type(output_types, descs)) {
@@ -297,6 +297,19 @@ Block* process_table_function(TableFunction* fn, Block* input_block,
             continue;
         }
 
+        if (max_step > 0) {
+            do {
+                int step = 0;
+                if (fn->get_many_values(column.get(), max_step, &step) != Status::OK()) {
+                    LOG(WARNING) << "TableFunction get_many_values failed";
+                    return nullptr;
+                }
+                EXPECT_GT(step, 0);
+                EXPECT_LE(step, max_step);
+            } while (!fn->eos());
+            continue;
+        }
+
         bool tmp_eos = false;
         do {
             void* cell = nullptr;
@@ -333,18 +346,21 @@ void check_vec_table_function(TableFunction* fn, const InputTypeSet& input_types
             create_block_from_inputset(output_types, output_set));
     EXPECT_TRUE(expect_output_block != nullptr);
 
-    std::unique_ptr<Block> real_output_block(
-            process_table_function(fn, input_block.get(), output_types));
-    EXPECT_TRUE(real_output_block != nullptr);
+    // the values one by one, and in batches of at most two
+    for (int max_step : {0, 2}) {
+        std::unique_ptr<Block> real_output_block(
+                process_table_function(fn, input_block.get(), output_types, max_step));
+        EXPECT_TRUE(real_output_block != nullptr);
 
-    // compare real_output_block with expect_output_block
-    EXPECT_EQ(expect_output_block->columns(), real_output_block->columns());
-    EXPECT_EQ(expect_output_block->rows(), real_output_block->rows());
-    for (size_t col = 0; col < expect_output_block->columns(); ++col) {
-        auto left_col = expect_output_block->get_by_position(col).column;
-        auto right_col = real_output_block->get_by_position(col).column;
-        for (size_t row = 0; row < expect_output_block->rows(); ++row) {
-            EXPECT_EQ(left_col->compare_at(row, row, *right_col, 0), 0);
+        // compare real_output_block with expect_output_block
+        EXPECT_EQ(expect_output_block->columns(), real_output_block->columns());
+        EXPECT_EQ(expect_output_block->rows(), real_output_block->rows());
+        for (size_t col = 0; col < expect_output_block->columns(); ++col) {
+            auto left_col = expect_output_block->get_by_position(col).column;
+            auto right_col = real_output_block->get_by_position(col).column;
+            for (size_t row = 0; row < expect_output_block->rows(); ++row) {
+                EXPECT_EQ(left_col->compare_at(row, row, *right_col, 0), 0);
+            }
         }
     }
 }
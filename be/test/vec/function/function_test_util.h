@@ -150,8 +150,9 @@ bool insert_cell(MutableColumnPtr& column, DataTypePtr type_ptr, const std::any&
 
 Block* create_block_from_inputset(const InputTypeSet& input_types, const InputDataSet& input_set);
 
+// reads the values by get_many_values() in batches of at most max_step values when it is positive
 Block* process_table_function(TableFunction* fn, Block* input_block,
-                              const InputTypeSet& output_types);
+                              const InputTypeSet& output_types, int max_step = 0);
 void check_vec_table_function(TableFunction* fn, const InputTypeSet& input_types,
                               const InputDataSet& input_set, const InputTypeSet& output_types,
                               const InputDataSet& output_set);
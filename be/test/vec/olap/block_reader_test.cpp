@@ -0,0 +1,328 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/block_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <numeric>
+#include <string>
+#include <tuple>
+
+#include "gen_cpp/Descriptors_types.h"
+#include "olap/delta_writer.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet.h"
+#include "olap/tablet_manager.h"
+#include "olap/txn_manager.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "util/file_utils.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+static const int64_t kUniqueTabletId = 10200;
+static const int64_t kAggTabletId = 10201;
+static const int32_t kSchemaHash = 270068380;
+static const int64_t kPartitionId = 30200;
+static const int kBatchSize = 100;
+
+static StorageEngine* k_engine = nullptr;
+static int64_t k_txn_id = 20200;
+
+class BlockReaderTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        config::min_file_descriptor_number = 100;
+        char buffer[1024];
+        EXPECT_NE(getcwd(buffer, sizeof(buffer)), nullptr);
+        config::storage_root_path = std::string(buffer) + "/block_reader_test";
+        FileUtils::remove_all(config::storage_root_path);
+        FileUtils::create_dir(config::storage_root_path);
+        doris::EngineOptions options;
+        options.store_paths.emplace_back(config::storage_root_path, -1);
+        Status st = doris::StorageEngine::open(options, &k_engine);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        ExecEnv::GetInstance()->set_storage_engine(k_engine);
+
+        // a unique key tablet (k1 INT, v1 INT) with a sequence column
+        _create_tablet(kUniqueTabletId, TKeysType::UNIQUE_KEYS, TAggregationType::REPLACE,
+                       {"k1", "v1", "__DORIS_SEQUENCE_COL__"});
+        // an aggregate key tablet (k1 INT, v1 INT SUM)
+        _create_tablet(kAggTabletId, TKeysType::AGG_KEYS, TAggregationType::SUM, {"k1", "v1"});
+    }
+
+    static void TearDownTestSuite() {
+        if (k_engine != nullptr) {
+            for (int64_t tablet_id : {kUniqueTabletId, kAggTabletId}) {
+                static_cast<void>(k_engine->tablet_manager()->drop_tablet(tablet_id, 0));
+            }
+            k_engine->stop();
+            delete k_engine;
+            k_engine = nullptr;
+        }
+        FileUtils::remove_all(config::storage_root_path);
+    }
+
+protected:
+    static void _create_tablet(int64_t tablet_id, TKeysType::type keys_type,
+                               TAggregationType::type aggregation,
+                               const std::vector<std::string>& names) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.tablet_schema.schema_hash = kSchemaHash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = keys_type;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+        request.__set_storage_format(TStorageFormat::V2);
+        for (const auto& name : names) {
+            TColumn column;
+            column.column_name = name;
+            column.__set_is_key(name == "k1");
+            column.column_type.type = TPrimitiveType::INT;
+            if (!column.is_key) {
+                column.__set_aggregation_type(name == "v1" ? aggregation
+                                                           : TAggregationType::REPLACE);
+            }
+            request.tablet_schema.columns.push_back(column);
+        }
+        if (names.size() > 2) {
+            request.tablet_schema.__set_sequence_col_idx(2);
+        }
+        Status st = k_engine->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+    }
+
+    // Loads the rows, one value per column of the tablet, in a new version.
+    static void _load(int64_t tablet_id, const std::vector<std::vector<int32_t>>& rows) {
+        TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(tablet_id);
+        ASSERT_NE(tablet, nullptr);
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        for (size_t i = 0; i < tablet->tablet_schema().num_columns(); ++i) {
+            tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                           .type(TYPE_INT)
+                                           .nullable(false)
+                                           .column_name(tablet->tablet_schema().column(i).name())
+                                           .column_pos(i)
+                                           .build());
+        }
+        tuple_builder.build(&dtb);
+        ObjectPool obj_pool;
+        DescriptorTbl* desc_tbl = nullptr;
+        DescriptorTbl::create(&obj_pool, dtb.desc_tbl(), &desc_tbl);
+        TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+
+        Block block;
+        for (const auto& slot_desc : tuple_desc->slots()) {
+            block.insert(ColumnWithTypeAndName(slot_desc->get_empty_mutable_column(),
+                                               slot_desc->get_data_type_ptr(),
+                                               slot_desc->col_name()));
+        }
+        auto columns = block.mutate_columns();
+        for (const auto& row : rows) {
+            for (size_t i = 0; i < row.size(); ++i) {
+                columns[i]->insert_data((const char*)&row[i], sizeof(row[i]));
+            }
+        }
+        block.set_columns(std::move(columns));
+
+        int64_t txn_id = k_txn_id++;
+        PUniqueId load_id;
+        load_id.set_hi(0);
+        load_id.set_lo(txn_id);
+        WriteRequest write_req = {tablet_id,  kSchemaHash,  WriteType::LOAD,
+                                  txn_id,     kPartitionId, load_id,
+                                  tuple_desc, &tuple_desc->slots()};
+        DeltaWriter* delta_writer = nullptr;
+        DeltaWriter::open(&write_req, &delta_writer, true);
+        ASSERT_NE(delta_writer, nullptr);
+        std::vector<int> row_idxs(rows.size());
+        std::iota(row_idxs.begin(), row_idxs.end(), 0);
+        ASSERT_TRUE(delta_writer->write(&block, row_idxs).ok());
+        ASSERT_TRUE(delta_writer->close().ok());
+        ASSERT_TRUE(delta_writer->close_wait().ok());
+        delete delta_writer;
+
+        Version version(tablet->max_version().second + 1, tablet->max_version().second + 1);
+        std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+        k_engine->txn_manager()->get_txn_related_tablets(txn_id, kPartitionId,
+                                                           &tablet_related_rs);
+        ASSERT_EQ(1, tablet_related_rs.size());
+        for (auto& [tablet_info, rowset] : tablet_related_rs) {
+            ASSERT_TRUE(k_engine->txn_manager()
+                                ->publish_txn(tablet->data_dir()->get_meta(), kPartitionId,
+                                              txn_id, tablet_id, kSchemaHash,
+                                              tablet_info.tablet_uid, version)
+                                .ok());
+            ASSERT_TRUE(tablet->add_inc_rowset(rowset).ok());
+        }
+    }
+
+    // Inits a reader merging all the rowsets of the tablet as a cumulative compaction would.
+    static void _init_reader(int64_t tablet_id, BlockReader* reader) {
+        TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(tablet_id);
+        ASSERT_NE(tablet, nullptr);
+        TabletReader::ReaderParams reader_params;
+        reader_params.tablet = tablet;
+        reader_params.reader_type = READER_CUMULATIVE_COMPACTION;
+        reader_params.version = Version(0, tablet->max_version().second);
+        ASSERT_TRUE(tablet->capture_rs_readers(reader_params.version, &reader_params.rs_readers)
+                            .ok());
+        reader_params.tablet_schema = &tablet->tablet_schema();
+        reader_params.return_columns.resize(tablet->tablet_schema().num_columns());
+        std::iota(reader_params.return_columns.begin(), reader_params.return_columns.end(), 0);
+        reader_params.origin_return_columns = &reader_params.return_columns;
+        reader->set_batch_size(kBatchSize);
+        Status st = reader->init(reader_params);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+    }
+
+    // Reads all the merged rows of the tablet.
+    static void _read(int64_t tablet_id, std::vector<std::vector<int32_t>>* rows) {
+        BlockReader reader;
+        _init_reader(tablet_id, &reader);
+        TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(tablet_id);
+        std::vector<uint32_t> return_columns(tablet->tablet_schema().num_columns());
+        std::iota(return_columns.begin(), return_columns.end(), 0);
+        Block block = tablet->tablet_schema().create_block(return_columns);
+        bool eof = false;
+        while (!eof) {
+            Status st = reader.next_block_with_aggregation(&block, nullptr, nullptr, &eof);
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            ASSERT_LE(block.rows(), static_cast<size_t>(kBatchSize));
+            for (size_t row = 0; row < block.rows(); ++row) {
+                rows->emplace_back();
+                for (size_t cid = 0; cid < block.columns(); ++cid) {
+                    rows->back().push_back(block.get_by_position(cid).column->get_int(row));
+                }
+            }
+            block.clear_column_data();
+        }
+    }
+};
+
+TEST_F(BlockReaderTest, unique_keys_with_sequence_column) {
+    // (begin, end, value, sequence) of the versions 2 to 5
+    std::vector<std::tuple<int32_t, int32_t, int32_t, int32_t>> loads = {
+            {0, 3000, 0, 10},
+            // replaces the keys of the base rowset in the middle of its blocks
+            {1000, 1100, 100000, 20},
+            // loses to the version 3 and, with a lower sequence, to the version 2 as well
+            {1050, 1150, 200000, 5},
+            // replaces the last key of the base rowset with an equal sequence, then new keys
+            {2999, 3100, 300000, 10}};
+    // key -> (sequence, version, value)
+    std::map<int32_t, std::tuple<int32_t, int64_t, int32_t>> expected;
+    int64_t version = 2;
+    for (const auto& [begin, end, value, sequence] : loads) {
+        std::vector<std::vector<int32_t>> rows;
+        for (int32_t key = begin; key < end; ++key) {
+            rows.push_back({key, key + value, sequence});
+            auto it = expected.find(key);
+            if (it == expected.end() ||
+                std::make_tuple(sequence, version) >
+                        std::make_tuple(std::get<0>(it->second), std::get<1>(it->second))) {
+                expected[key] = {sequence, version, key + value};
+            }
+        }
+        _load(kUniqueTabletId, rows);
+        ++version;
+    }
+
+    std::vector<std::vector<int32_t>> rows;
+    _read(kUniqueTabletId, &rows);
+    ASSERT_EQ(expected.size(), rows.size());
+    auto it = expected.begin();
+    for (const auto& row : rows) {
+        ASSERT_EQ(3, row.size());
+        EXPECT_EQ(it->first, row[0]);
+        EXPECT_EQ(std::get<2>(it->second), row[1]) << row[0];
+        EXPECT_EQ(std::get<0>(it->second), row[2]) << row[0];
+        ++it;
+    }
+}
+
+TEST_F(BlockReaderTest, agg_keys) {
+    // (begin, end, value) of the versions 2 to 5, the last one after all the others
+    std::vector<std::tuple<int32_t, int32_t, int32_t>> loads = {
+            {0, 3000, 1}, {550, 650, 3}, {500, 600, 2}, {3000, 3100, 4}};
+    std::map<int32_t, int64_t> expected;
+    for (const auto& [begin, end, value] : loads) {
+        std::vector<std::vector<int32_t>> rows;
+        for (int32_t key = begin; key < end; ++key) {
+            rows.push_back({key, value});
+            expected[key] += value;
+        }
+        _load(kAggTabletId, rows);
+    }
+
+    std::vector<std::vector<int32_t>> rows;
+    _read(kAggTabletId, &rows);
+    ASSERT_EQ(expected.size(), rows.size());
+    auto it = expected.begin();
+    for (const auto& row : rows) {
+        ASSERT_EQ(2, row.size());
+        EXPECT_EQ(it->first, row[0]);
+        EXPECT_EQ(it->second, row[1]) << row[0];
+        ++it;
+    }
+
+    // the runs of the rows before the rows of the other rowsets
+    BlockReader reader;
+    _init_reader(kAggTabletId, &reader);
+    std::map<int32_t, int> key_counts;
+    for (const auto& [begin, end, value] : loads) {
+        for (int32_t key = begin; key < end; ++key) {
+            ++key_counts[key];
+        }
+    }
+    std::vector<int32_t> keys;
+    int run_keys = 0;
+    IteratorRowRef& ref = reader._next_row;
+    while (true) {
+        keys.push_back(ref.block->get_by_position(0).column->get_int(ref.row_pos));
+        int run_rows = reader._vcollect_iter.next_run_rows(kBatchSize);
+        ASSERT_LE(run_rows, kBatchSize);
+        ASSERT_LT(static_cast<size_t>(ref.row_pos + run_rows), ref.block->rows());
+        for (int i = 1; i <= run_rows; ++i) {
+            int32_t key = ref.block->get_by_position(0).column->get_int(ref.row_pos + i);
+            // a key of another rowset is left to the heap
+            EXPECT_EQ(1, key_counts[key]) << key;
+            keys.push_back(key);
+        }
+        run_keys += run_rows;
+        Status st = reader._vcollect_iter.next(&ref, run_rows);
+        if (st.precise_code() == OLAP_ERR_DATA_EOF) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+    }
+    // all the rows in key order, most of them in runs
+    std::vector<int32_t> expected_keys;
+    for (const auto& [key, count] : key_counts) {
+        expected_keys.insert(expected_keys.end(), count, key);
+    }
+    EXPECT_EQ(expected_keys, keys);
+    EXPECT_GT(run_keys, 2000);
+}
+
+} // namespace doris::vectorized
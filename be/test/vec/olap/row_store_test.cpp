@@ -0,0 +1,137 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/row_store.h"
+
+#include <gtest/gtest.h>
+
+namespace doris::vectorized {
+
+static void add_column(TabletSchemaPB* schema_pb, const std::string& name, const std::string& type,
+                       bool is_key, bool is_nullable) {
+    ColumnPB* column = schema_pb->add_column();
+    column->set_unique_id(schema_pb->column_size());
+    column->set_name(name);
+    column->set_type(type);
+    column->set_is_key(is_key);
+    column->set_is_nullable(is_nullable);
+    column->set_length(type == "INT" ? 4 : 64);
+    column->set_aggregation(is_key ? "NONE" : "REPLACE");
+}
+
+TEST(RowStoreTest, EncodeAndDecode) {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(UNIQUE_KEYS);
+    add_column(&schema_pb, "k1", "INT", true, false);
+    add_column(&schema_pb, "__row_store__", "STRING", false, false);
+    add_column(&schema_pb, "v1", "VARCHAR", false, true);
+    schema_pb.set_row_store_col_idx(1);
+    TabletSchema schema;
+    schema.init_from_pb(schema_pb);
+    EXPECT_TRUE(schema.has_row_store_column());
+    EXPECT_TRUE(RowStore::check_schema(schema).ok());
+
+    Block block = schema.create_block();
+    auto columns = block.mutate_columns();
+    for (int32_t i = 0; i < 10; ++i) {
+        columns[0]->insert_data(reinterpret_cast<const char*>(&i), sizeof(i));
+        columns[1]->insert_default();
+        std::string value = std::string(i, 'a');
+        columns[2]->insert_data(i % 3 == 0 ? nullptr : value.data(), value.size());
+    }
+    block.set_columns(std::move(columns));
+
+    auto rows = ColumnString::create();
+    RowStore::encode_rows(schema, block, 2, 6, rows.get());
+    EXPECT_EQ(6, rows->size());
+
+    Block decoded_block = schema.create_block({0, 2});
+    auto decoded_columns = decoded_block.mutate_columns();
+    for (size_t i = 0; i < rows->size(); ++i) {
+        EXPECT_TRUE(RowStore::decode_row(rows->get_data_at(i), decoded_columns).ok());
+    }
+    for (size_t i = 0; i < rows->size(); ++i) {
+        size_t row = i + 2;
+        EXPECT_EQ(block.get_by_position(0).column->get_data_at(row),
+                  decoded_columns[0]->get_data_at(i));
+        EXPECT_EQ(block.get_by_position(2).column->is_null_at(row),
+                  decoded_columns[1]->is_null_at(i));
+        EXPECT_EQ(block.get_by_position(2).column->get_data_at(row),
+                  decoded_columns[1]->get_data_at(i));
+    }
+}
+
+TEST(RowStoreTest, Encoding) {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(UNIQUE_KEYS);
+    add_column(&schema_pb, "k1", "INT", true, false);
+    add_column(&schema_pb, "v1", "VARCHAR", false, true);
+    add_column(&schema_pb, "__row_store__", "STRING", false, false);
+    schema_pb.set_row_store_col_idx(2);
+    TabletSchema schema;
+    schema.init_from_pb(schema_pb);
+
+    Block block = schema.create_block();
+    auto columns = block.mutate_columns();
+    int32_t k1 = 0x01020304;
+    columns[0]->insert_data(reinterpret_cast<const char*>(&k1), sizeof(k1));
+    columns[0]->insert_data(reinterpret_cast<const char*>(&k1), sizeof(k1));
+    columns[1]->insert_data("abc", 3);
+    columns[1]->insert_data(nullptr, 0);
+    columns[2]->insert_default();
+    columns[2]->insert_default();
+    block.set_columns(std::move(columns));
+
+    // the encoding is stored in the segments, it must not change
+    auto rows = ColumnString::create();
+    RowStore::encode_rows(schema, block, 0, 2, rows.get());
+    EXPECT_EQ(std::string("\x01\x02\x04\x03\x02\x01\x00\x03"
+                          "abc",
+                          11),
+              rows->get_data_at(0).to_string());
+    EXPECT_EQ(std::string("\x01\x02\x04\x03\x02\x01\x01", 7), rows->get_data_at(1).to_string());
+
+    Block decoded_block = schema.create_block({0, 1});
+    auto decoded_columns = decoded_block.mutate_columns();
+    for (auto row : {std::string("\x02\x02\x04\x03\x02\x01\x01", 7),
+                     std::string("\x01\x03\x04\x03\x02\x01\x01", 7),
+                     std::string("\x01\x02\x04\x03\x02\x01\x00\x04"
+                                 "abc",
+                                 11),
+                     std::string("\x01\x02\x04\x03\x02\x01\x01\x00", 8),
+                     std::string("\x01\x02\x04\x03", 4), std::string()}) {
+        EXPECT_EQ(TStatusCode::CORRUPTION,
+                  RowStore::decode_row(StringRef(row), decoded_columns).code());
+        for (auto& column : decoded_columns) {
+            column->clear();
+        }
+    }
+}
+
+TEST(RowStoreTest, CheckSchema) {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(AGG_KEYS);
+    add_column(&schema_pb, "k1", "INT", true, false);
+    add_column(&schema_pb, "__row_store__", "STRING", false, false);
+    add_column(&schema_pb, "v1", "HLL", false, false);
+    schema_pb.set_row_store_col_idx(1);
+    TabletSchema schema;
+    schema.init_from_pb(schema_pb);
+    EXPECT_FALSE(RowStore::check_schema(schema).ok());
+}
+
+} // namespace doris::vectorized
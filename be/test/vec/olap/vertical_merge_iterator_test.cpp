@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/vertical_merge_iterator.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace doris::vectorized {
+
+static void check_row_sources(const RowSourcesBuffer& buffer, size_t num_sources) {
+    std::unique_ptr<RowSourcesBuffer::Reader> reader;
+    EXPECT_TRUE(buffer.create_reader(&reader).ok());
+    std::vector<RowSource> sources;
+    size_t num_read = 0;
+    while (true) {
+        EXPECT_TRUE(reader->next_batch(&sources).ok());
+        if (sources.empty()) {
+            break;
+        }
+        for (auto& source : sources) {
+            EXPECT_EQ(num_read % 100, source.source());
+            EXPECT_EQ(num_read % 3 == 0, source.is_same());
+            ++num_read;
+        }
+    }
+    EXPECT_EQ(num_sources, num_read);
+}
+
+TEST(VerticalMergeIteratorTest, RowSource) {
+    RowSource source(RowSource::MAX_SOURCE, true);
+    EXPECT_EQ(RowSource::MAX_SOURCE, source.source());
+    EXPECT_TRUE(source.is_same());
+
+    RowSource other(5, false);
+    EXPECT_EQ(5, other.source());
+    EXPECT_FALSE(other.is_same());
+}
+
+TEST(VerticalMergeIteratorTest, RowSourcesInMemory) {
+    std::string tmp_path = "./ut_dir/vertical_merge_iterator_test_memory.tmp";
+    size_t num_sources = 10000;
+    {
+        RowSourcesBuffer buffer(tmp_path, 1024 * 1024);
+        for (size_t i = 0; i < num_sources; ++i) {
+            EXPECT_TRUE(buffer.append(RowSource(i % 100, i % 3 == 0)).ok());
+        }
+        EXPECT_TRUE(buffer.flush().ok());
+        EXPECT_EQ(num_sources, buffer.total_size());
+        EXPECT_FALSE(std::filesystem::exists(tmp_path));
+        check_row_sources(buffer, num_sources);
+    }
+}
+
+TEST(VerticalMergeIteratorTest, RowSourcesSpilled) {
+    std::filesystem::create_directories("./ut_dir");
+    std::string tmp_path = "./ut_dir/vertical_merge_iterator_test_spill.tmp";
+    size_t num_sources = 10000;
+    {
+        // 1000 sources in memory at most
+        RowSourcesBuffer buffer(tmp_path, 1000 * sizeof(RowSource));
+        for (size_t i = 0; i < num_sources; ++i) {
+            EXPECT_TRUE(buffer.append(RowSource(i % 100, i % 3 == 0)).ok());
+        }
+        EXPECT_TRUE(buffer.flush().ok());
+        EXPECT_EQ(num_sources, buffer.total_size());
+        EXPECT_TRUE(std::filesystem::exists(tmp_path));
+        // several readers may read the buffer at the same time
+        check_row_sources(buffer, num_sources);
+        check_row_sources(buffer, num_sources);
+    }
+    // the spilled file is removed with the buffer
+    EXPECT_FALSE(std::filesystem::exists(tmp_path));
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/zorder_comparator.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include "olap/tablet_schema.h"
+
+namespace doris::vectorized {
+
+static TabletSchema create_zorder_schema() {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(DUP_KEYS);
+    schema_pb.set_sort_type(SortType::ZORDER);
+    schema_pb.set_sort_col_num(2);
+    for (int i = 0; i < 2; ++i) {
+        ColumnPB* column = schema_pb.add_column();
+        column->set_unique_id(i);
+        column->set_name("k" + std::to_string(i));
+        column->set_type("INT");
+        column->set_is_key(true);
+        column->set_is_nullable(false);
+        column->set_length(4);
+        column->set_aggregation("NONE");
+    }
+    TabletSchema schema;
+    schema.init_from_pb(schema_pb);
+    return schema;
+}
+
+static Block create_block(const TabletSchema& schema,
+                          const std::vector<std::pair<int32_t, int32_t>>& rows) {
+    Block block = schema.create_block();
+    auto columns = block.mutate_columns();
+    for (auto& row : rows) {
+        columns[0]->insert_data(reinterpret_cast<const char*>(&row.first), sizeof(int32_t));
+        columns[1]->insert_data(reinterpret_cast<const char*>(&row.second), sizeof(int32_t));
+    }
+    block.set_columns(std::move(columns));
+    return block;
+}
+
+TEST(ZOrderComparatorTest, InterleavedOrder) {
+    TabletSchema schema = create_zorder_schema();
+    std::vector<std::pair<int32_t, int32_t>> rows;
+    for (int32_t x = 0; x < 4; ++x) {
+        for (int32_t y = 0; y < 4; ++y) {
+            rows.emplace_back(x, y);
+        }
+    }
+    Block block = create_block(schema, rows);
+    ZOrderComparator comparator(schema, 2);
+
+    std::vector<size_t> perm(rows.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::sort(perm.begin(), perm.end(), [&](size_t lhs, size_t rhs) {
+        return comparator.compare_at(lhs, rhs, block, block) < 0;
+    });
+    // the bits of x and y interleaved, the bit of x first
+    auto z_value = [](int32_t x, int32_t y) {
+        return ((x & 2) << 2) | ((y & 2) << 1) | ((x & 1) << 1) | (y & 1);
+    };
+    for (size_t i = 0; i < perm.size(); ++i) {
+        EXPECT_EQ(static_cast<int32_t>(i), z_value(rows[perm[i]].first, rows[perm[i]].second));
+    }
+    EXPECT_EQ(0, comparator.compare_at(5, 5, block, block));
+}
+
+TEST(ZOrderComparatorTest, SignedValues) {
+    TabletSchema schema = create_zorder_schema();
+    Block block = create_block(schema, {{-1, 0}, {0, 0}, {0, -1}, {-100, 100}});
+    ZOrderComparator comparator(schema, 2);
+    EXPECT_LT(comparator.compare_at(0, 1, block, block), 0);
+    EXPECT_LT(comparator.compare_at(2, 1, block, block), 0);
+    EXPECT_GT(comparator.compare_at(1, 3, block, block), 0);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,169 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/shared_hash_table_controller.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "exprs/runtime_filter_slots.h"
+#include "runtime/runtime_filter_mgr.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+TEST(SharedHashTableControllerTest, only_first_instance_builds) {
+    SharedHashTableController controller;
+    TUniqueId builder_id;
+    builder_id.__set_hi(1);
+    builder_id.__set_lo(1);
+    TUniqueId other_id;
+    other_id.__set_hi(1);
+    other_id.__set_lo(2);
+
+    EXPECT_TRUE(controller.should_build_hash_table(builder_id, 1));
+    EXPECT_FALSE(controller.should_build_hash_table(other_id, 1));
+    // asking again must not change the builder
+    EXPECT_TRUE(controller.should_build_hash_table(builder_id, 1));
+    // each join node has its own builder
+    EXPECT_TRUE(controller.should_build_hash_table(other_id, 2));
+    EXPECT_NE(controller.get_context(1), controller.get_context(2));
+}
+
+TEST(SharedHashTableControllerTest, wait_for_signal) {
+    SharedHashTableController controller;
+    TUniqueId builder_id;
+    builder_id.__set_hi(1);
+    builder_id.__set_lo(1);
+    EXPECT_TRUE(controller.should_build_hash_table(builder_id, 1));
+
+    RuntimeState state;
+    auto context = controller.get_context(1);
+    std::thread builder([&] {
+        context->blocks = std::make_shared<std::vector<Block>>();
+        controller.signal(1, Status::OK());
+    });
+    EXPECT_TRUE(controller.wait_for_signal(&state, context).ok());
+    builder.join();
+    EXPECT_NE(context->blocks, nullptr);
+
+    // the waiting instances get the status of a failed build
+    EXPECT_TRUE(controller.should_build_hash_table(builder_id, 2));
+    controller.signal(2, Status::InternalError("build failed"));
+    EXPECT_FALSE(controller.wait_for_signal(&state, controller.get_context(2)).ok());
+}
+
+static TRuntimeFilterDesc create_filter_desc(int filter_id, TRuntimeFilterType::type type) {
+    TExprNode expr_node;
+    expr_node.__set_node_type(TExprNodeType::SLOT_REF);
+    expr_node.__set_type(create_type_desc(TYPE_INT));
+    expr_node.__set_num_children(0);
+    TSlotRef slot_ref;
+    slot_ref.__set_slot_id(0);
+    slot_ref.__set_tuple_id(0);
+    expr_node.__set_slot_ref(slot_ref);
+    TExpr expr;
+    expr.nodes.push_back(expr_node);
+
+    TRuntimeFilterDesc desc;
+    desc.__set_filter_id(filter_id);
+    desc.__set_expr_order(0);
+    desc.__set_has_local_targets(false);
+    desc.__set_has_remote_targets(true);
+    desc.__set_is_broadcast_join(true);
+    desc.__set_type(type);
+    desc.__set_bloom_filter_size_bytes(4096);
+    desc.__set_src_expr(expr);
+    desc.__set_planId_to_target_expr({{0, expr}});
+    return desc;
+}
+
+// An instance of the fragment, with the producers of the runtime filters of the join.
+struct JoinInstance {
+    JoinInstance(const std::vector<TRuntimeFilterDesc>& descs, const TQueryOptions& options)
+            : state(TUniqueId(), options, TQueryGlobals(), nullptr),
+              expr_ctxs(1, nullptr),
+              slots(expr_ctxs, expr_ctxs, descs) {
+        EXPECT_TRUE(state.init_instance_mem_tracker().ok());
+        EXPECT_TRUE(state.runtime_filter_mgr()->init(state.instance_mem_tracker()).ok());
+        for (auto& desc : descs) {
+            EXPECT_TRUE(state.runtime_filter_mgr()
+                                ->regist_filter(RuntimeFilterRole::PRODUCER, desc, options)
+                                .ok());
+        }
+    }
+
+    IRuntimeFilter* filter(int filter_id) {
+        IRuntimeFilter* filter = nullptr;
+        EXPECT_TRUE(state.runtime_filter_mgr()->get_producer_filter(filter_id, &filter).ok());
+        return filter;
+    }
+
+    RuntimeState state;
+    std::vector<VExprContext*> expr_ctxs;
+    VRuntimeFilterSlots slots;
+};
+
+TEST(SharedHashTableControllerTest, copy_runtime_filters) {
+    TQueryOptions options;
+    options.__set_runtime_filter_max_in_num(1024);
+    std::vector<TRuntimeFilterDesc> descs {create_filter_desc(0, TRuntimeFilterType::IN),
+                                           create_filter_desc(1, TRuntimeFilterType::BLOOM)};
+    JoinInstance builder(descs, options);
+    JoinInstance waiter(descs, options);
+    SharedHashTableContext context;
+
+    EXPECT_TRUE(builder.slots.init(&builder.state, 3).ok());
+    for (int value : {3, 5, 7}) {
+        builder.filter(0)->insert(&value);
+        builder.filter(1)->insert(&value);
+    }
+    EXPECT_TRUE(builder.slots.copy_to_shared_context(&context).ok());
+    EXPECT_EQ(2, context.runtime_filters.size());
+
+    // the waiter never sees the build rows, its filters come from the builder
+    EXPECT_TRUE(waiter.slots.init(&waiter.state, 3).ok());
+    EXPECT_TRUE(waiter.slots.copy_from_shared_context(context, waiter.state.obj_pool()).ok());
+
+    PMergeFilterRequest in_filter;
+    EXPECT_TRUE(waiter.filter(0)->serialize(&in_filter, nullptr, nullptr).ok());
+    EXPECT_EQ(3, in_filter.in_filter().values_size());
+
+    PMergeFilterRequest builder_bloom;
+    PMergeFilterRequest waiter_bloom;
+    void* builder_data = nullptr;
+    void* waiter_data = nullptr;
+    int builder_len = 0;
+    int waiter_len = 0;
+    EXPECT_TRUE(builder.filter(1)->serialize(&builder_bloom, &builder_data, &builder_len).ok());
+    EXPECT_TRUE(waiter.filter(1)->serialize(&waiter_bloom, &waiter_data, &waiter_len).ok());
+    EXPECT_EQ(builder_len, waiter_len);
+    EXPECT_EQ(0, memcmp(builder_data, waiter_data, builder_len));
+
+    // a filter the builder did not save is an error, not an empty filter
+    context.runtime_filters.erase(1);
+    JoinInstance late_waiter(descs, options);
+    EXPECT_TRUE(late_waiter.slots.init(&late_waiter.state, 3).ok());
+    EXPECT_FALSE(
+            late_waiter.slots.copy_from_shared_context(context, late_waiter.state.obj_pool())
+                    .ok());
+}
+
+} // namespace doris::vectorized
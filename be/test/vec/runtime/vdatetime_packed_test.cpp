@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vdatetime_packed.h"
+
+#include <gtest/gtest.h>
+
+#include "util/binary_cast.hpp"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris::vectorized {
+
+TEST(VDateTimePackedTest, date_time_fields_test) {
+    VecDateTimeValue value;
+    value.set_time(2022, 5, 24, 13, 45, 59);
+    Int64 packed = binary_cast<VecDateTimeValue, Int64>(value);
+
+    EXPECT_EQ(packed_date::year(packed), 2022);
+    EXPECT_EQ(packed_date::month(packed), 5);
+    EXPECT_EQ(packed_date::day(packed), 24);
+    EXPECT_EQ(packed_date::hour(packed), 13);
+    EXPECT_EQ(packed_date::minute(packed), 45);
+    EXPECT_EQ(packed_date::second(packed), 59);
+    EXPECT_EQ(packed_date::type(packed), TIME_DATETIME);
+
+    VecDateTimeValue date = value;
+    date.cast_to_date();
+    EXPECT_EQ(packed_date::to_date(packed), binary_cast<VecDateTimeValue, Int64>(date));
+}
+
+TEST(VDateTimePackedTest, same_as_values_test) {
+    // all the days of a few years around a leap year, and the invalid days of their months
+    for (uint32_t year : {1000, 1900, 1999, 2000, 2001, 2004, 9999}) {
+        for (uint32_t month = 0; month <= 15; ++month) {
+            for (uint32_t day = 0; day <= 31; ++day) {
+                UInt32 date_v2 = (year << 9) | (month << 5) | day;
+                const auto& value_v2 = reinterpret_cast<const DateV2Value&>(date_v2);
+                EXPECT_EQ(packed_date::is_valid_date(date_v2), value_v2.is_valid_date())
+                        << year << "-" << month << "-" << day;
+
+                VecDateTimeValue value;
+                value.set_time(year, month, day, 23, 59, 59);
+                Int64 date_time = binary_cast<VecDateTimeValue, Int64>(value);
+                EXPECT_EQ(packed_date::is_valid_date(date_time), value.is_valid_date())
+                        << year << "-" << month << "-" << day;
+
+                if (value.is_valid_date()) {
+                    EXPECT_EQ(packed_date::daynr(date_v2), value_v2.daynr());
+                    EXPECT_EQ(packed_date::daynr(date_time), value.daynr());
+                }
+            }
+        }
+    }
+
+    VecDateTimeValue value;
+    value.set_time(2022, 5, 24, 24, 0, 0);
+    EXPECT_FALSE(packed_date::is_valid_date(binary_cast<VecDateTimeValue, Int64>(value)));
+    value.set_time(2022, 5, 24, 23, 60, 0);
+    EXPECT_FALSE(packed_date::is_valid_date(binary_cast<VecDateTimeValue, Int64>(value)));
+}
+
+TEST(VDateTimePackedTest, floor_to_unit_test) {
+    VecDateTimeValue value;
+    value.set_time(2022, 5, 24, 13, 45, 59);
+    Int64 packed = binary_cast<VecDateTimeValue, Int64>(value);
+
+    auto expect_floor = [](uint32_t year, uint32_t month, uint32_t day, uint32_t hour,
+                           uint32_t minute, uint32_t second) {
+        VecDateTimeValue expected;
+        expected.set_time(year, month, day, hour, minute, second);
+        return binary_cast<VecDateTimeValue, Int64>(expected);
+    };
+    EXPECT_EQ(packed_date::floor_to_unit<YEAR>(packed), expect_floor(2022, 1, 1, 0, 0, 0));
+    EXPECT_EQ(packed_date::floor_to_unit<MONTH>(packed), expect_floor(2022, 5, 1, 0, 0, 0));
+    EXPECT_EQ(packed_date::floor_to_unit<DAY>(packed), expect_floor(2022, 5, 24, 0, 0, 0));
+    EXPECT_EQ(packed_date::floor_to_unit<HOUR>(packed), expect_floor(2022, 5, 24, 13, 0, 0));
+    EXPECT_EQ(packed_date::floor_to_unit<MINUTE>(packed), expect_floor(2022, 5, 24, 13, 45, 0));
+    EXPECT_EQ(packed_date::floor_to_unit<SECOND>(packed), packed);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,124 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vparquet_writer.h"
+
+#include <gtest/gtest.h>
+#include <parquet/api/reader.h>
+
+#include <filesystem>
+
+#include "common/object_pool.h"
+#include "io/local_file_writer.h"
+#include "util/file_utils.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/exprs/vexpr.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+// an expr of the type of an output column, the writer only reads the type of the exprs
+class TypedExpr final : public VExpr {
+public:
+    explicit TypedExpr(PrimitiveType type) : VExpr(TypeDescriptor(type), true, true) {}
+
+    Status execute(VExprContext* context, Block* block, int* result_column_id) override {
+        return Status::NotSupported("not executed");
+    }
+    VExpr* clone(ObjectPool* pool) const override { return pool->add(new TypedExpr(*this)); }
+    const std::string& expr_name() const override { return _expr_name; }
+
+private:
+    const std::string _expr_name = "typed";
+};
+
+} // namespace
+
+TEST(VParquetWriterTest, write_columns) {
+    const std::string dir = "./ut_dir/vparquet_writer_test";
+    FileUtils::remove_all(dir);
+    ASSERT_TRUE(FileUtils::create_dir(dir).ok());
+    const std::string path = dir + "/0.parquet";
+
+    ObjectPool pool;
+    std::vector<VExprContext*> ctxs = {
+            pool.add(new VExprContext(pool.add(new TypedExpr(TYPE_INT)))),
+            pool.add(new VExprContext(pool.add(new TypedExpr(TYPE_VARCHAR))))};
+    std::vector<std::vector<std::string>> schema = {{"optional", "int32", "k1"},
+                                                    {"required", "byte_array", "k2"}};
+
+    auto ints = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    auto strings = ColumnString::create();
+    for (int i = 0; i < 5; ++i) {
+        ints->insert_value(i);
+        null_map->insert_value(i % 2);
+        std::string value = "v" + std::to_string(i);
+        strings->insert_data(value.data(), value.size());
+    }
+    Block block({{ColumnNullable::create(std::move(ints), std::move(null_map)),
+                  make_nullable(std::make_shared<DataTypeInt32>()), "k1"},
+                 {std::move(strings), std::make_shared<DataTypeString>(), "k2"}});
+
+    LocalFileWriter file_writer(path, 0);
+    ASSERT_TRUE(file_writer.open().ok());
+    VParquetWriterWrapper writer(&file_writer, ctxs, {{"compression", "snappy"}}, schema, false);
+    ASSERT_TRUE(writer.init().ok());
+    ASSERT_TRUE(writer.write(block).ok());
+    ASSERT_TRUE(writer.write(block).ok());
+    ASSERT_TRUE(writer.close().ok());
+    EXPECT_EQ(writer.written_len(), static_cast<int64_t>(std::filesystem::file_size(path)));
+
+    auto reader = parquet::ParquetFileReader::OpenFile(path);
+    ASSERT_EQ(10, reader->metadata()->num_rows());
+    auto row_group = reader->RowGroup(0);
+    auto k1 = std::static_pointer_cast<parquet::Int32Reader>(row_group->Column(0));
+    int16_t def_levels[10];
+    int32_t int_values[10];
+    int64_t num_values = 0;
+    ASSERT_EQ(10, k1->ReadBatch(10, def_levels, nullptr, int_values, &num_values));
+    ASSERT_EQ(6, num_values);
+    EXPECT_EQ(0, def_levels[1]);
+    EXPECT_EQ(1, def_levels[2]);
+    EXPECT_EQ(2, int_values[1]);
+    EXPECT_EQ(4, int_values[2]);
+
+    auto k2 = std::static_pointer_cast<parquet::ByteArrayReader>(row_group->Column(1));
+    parquet::ByteArray byte_values[10];
+    ASSERT_EQ(10, k2->ReadBatch(10, nullptr, nullptr, byte_values, &num_values));
+    EXPECT_EQ("v3", std::string(reinterpret_cast<const char*>(byte_values[8].ptr),
+                                byte_values[8].len));
+
+    // a column of a type other than the one of the schema is rejected
+    std::vector<std::vector<std::string>> wrong_schema = {{"optional", "int64", "k1"},
+                                                          {"required", "byte_array", "k2"}};
+    LocalFileWriter wrong_file_writer(dir + "/1.parquet", 0);
+    ASSERT_TRUE(wrong_file_writer.open().ok());
+    VParquetWriterWrapper wrong_writer(&wrong_file_writer, ctxs, {}, wrong_schema, false);
+    ASSERT_TRUE(wrong_writer.init().ok());
+    EXPECT_FALSE(wrong_writer.write(block).ok());
+
+    FileUtils::remove_all(dir);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/utils/block_to_arrow_batch.h"
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+#include <gtest/gtest.h>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+TEST(BlockToArrowBatchTest, convert) {
+    auto int_column = ColumnInt32::create();
+    auto null_map = ColumnUInt8::create();
+    auto string_column = ColumnString::create();
+    auto double_column = ColumnFloat64::create();
+    for (int i = 0; i < 3; ++i) {
+        int_column->insert_value(i);
+        null_map->insert_value(i == 1);
+        std::string value = "str" + std::to_string(i);
+        string_column->insert_data(value.data(), value.size());
+        double_column->insert_value(i + 0.5);
+    }
+    Block block;
+    block.insert({ColumnNullable::create(std::move(int_column), std::move(null_map)),
+                  make_nullable(std::make_shared<DataTypeInt32>()), "c1"});
+    block.insert({std::move(string_column), std::make_shared<DataTypeString>(), "c2"});
+    block.insert({std::move(double_column), std::make_shared<DataTypeFloat64>(), "c3"});
+
+    auto schema = arrow::schema({arrow::field("c1", arrow::int32(), true),
+                                 arrow::field("c2", arrow::utf8(), false),
+                                 arrow::field("c3", arrow::float64(), false)});
+    std::shared_ptr<arrow::RecordBatch> batch;
+    auto st = convert_to_arrow_batch(block, schema, arrow::default_memory_pool(), &batch);
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    ASSERT_EQ(3, batch->num_rows());
+
+    auto c1 = std::static_pointer_cast<arrow::Int32Array>(batch->column(0));
+    EXPECT_EQ(0, c1->Value(0));
+    EXPECT_TRUE(c1->IsNull(1));
+    EXPECT_EQ(2, c1->Value(2));
+    auto c2 = std::static_pointer_cast<arrow::StringArray>(batch->column(1));
+    EXPECT_EQ("str1", c2->GetString(1));
+    auto c3 = std::static_pointer_cast<arrow::DoubleArray>(batch->column(2));
+    EXPECT_DOUBLE_EQ(2.5, c3->Value(2));
+
+    // the type of a column does not match its field
+    auto bad_schema = arrow::schema({arrow::field("c1", arrow::int64(), true),
+                                     arrow::field("c2", arrow::utf8(), false),
+                                     arrow::field("c3", arrow::float64(), false)});
+    st = convert_to_arrow_batch(block, bad_schema, arrow::default_memory_pool(), &batch);
+    EXPECT_FALSE(st.ok());
+}
+
+} // namespace doris::vectorized
@@ -42,7 +42,7 @@ Usage: $0 <options>
      [no option]        build all components
      --fe               build Frontend and Spark DPP application
      --be               build Backend
-     --meta-tool        build Backend meta tool
+     --meta-tool        build Backend meta tool and scan tool
      --broker           build Broker
      --spark-dpp        build Spark DPP application
      --hive-udf         build Hive UDF library for Spark Load
@@ -201,6 +201,9 @@ fi
 if [[ -z ${WITH_LZO} ]]; then
     WITH_LZO=OFF
 fi
+if [[ -z ${WITH_HYPERSCAN} ]]; then
+    WITH_HYPERSCAN=OFF
+fi
 if [[ -z ${USE_LIBCPP} ]]; then
     USE_LIBCPP=OFF
 fi
@@ -233,6 +236,7 @@ echo "Get params:
     CLEAN               -- $CLEAN
     WITH_MYSQL          -- $WITH_MYSQL
     WITH_LZO            -- $WITH_LZO
+    WITH_HYPERSCAN      -- $WITH_HYPERSCAN
     GLIBC_COMPATIBILITY -- $GLIBC_COMPATIBILITY
     USE_AVX2            -- $USE_AVX2
     USE_LIBCPP          -- $USE_LIBCPP
@@ -295,6 +299,7 @@ if [ ${BUILD_BE} -eq 1 ] ; then
             ${CMAKE_USE_CCACHE} \
             -DWITH_MYSQL=${WITH_MYSQL} \
             -DWITH_LZO=${WITH_LZO} \
+            -DWITH_HYPERSCAN=${WITH_HYPERSCAN} \
             -DUSE_LIBCPP=${USE_LIBCPP} \
             -DBUILD_META_TOOL=${BUILD_META_TOOL} \
             -DBUILD_JAVA_UDF=${BUILD_JAVA_UDF} \
@@ -406,6 +411,7 @@ if [ ${BUILD_BE} -eq 1 ]; then
 
     if [ "${BUILD_META_TOOL}" = "ON" ]; then
         cp -r -p ${DORIS_HOME}/be/output/lib/meta_tool ${DORIS_OUTPUT}/be/lib/
+        cp -r -p ${DORIS_HOME}/be/output/lib/scan_tool ${DORIS_OUTPUT}/be/lib/
     fi
 
     cp -r -p ${DORIS_HOME}/be/output/udf/*.a ${DORIS_OUTPUT}/udf/lib/
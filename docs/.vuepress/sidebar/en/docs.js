@@ -488,7 +488,7 @@ module.exports = [
             title: "Hash Functions",
             directoryPath: "hash-functions/",
             initialOpenGroupIndex: -1,
-            children: ["murmur_hash3_32"],
+            children: ["murmur_hash3_32", "murmur_hash3_64", "xxhash_64"],
           },
           {
             title: "Math Functions",
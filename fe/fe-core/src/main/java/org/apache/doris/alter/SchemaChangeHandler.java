@@ -78,6 +78,7 @@ import org.apache.doris.task.AgentTaskExecutor;
 import org.apache.doris.task.AgentTaskQueue;
 import org.apache.doris.task.ClearAlterTask;
 import org.apache.doris.task.UpdateTabletMetaInfoTask;
+import org.apache.doris.thrift.TColumn;
 import org.apache.doris.thrift.TStorageFormat;
 import org.apache.doris.thrift.TStorageMedium;
 import org.apache.doris.thrift.TTaskType;
@@ -2229,6 +2230,11 @@ public class SchemaChangeHandler extends AlterHandler {
                     indexSchemaMap, indexes, jobId);
             LOG.debug("logModifyTableAddOrDropColumns info:{}", info);
             Catalog.getCurrentCatalog().getEditLog().logModifyTableAddOrDropColumns(info);
+
+            AgentBatchTask batchTask = createUpdateTabletSchemaTasks(olapTable, indexSchemaMap.keySet());
+            if (!FeConstants.runningUnitTest) {
+                AgentTaskExecutor.submit(batchTask);
+            }
         }
 
         //for compatibility, we need create a finished state schema change job v2
@@ -2243,6 +2249,41 @@ public class SchemaChangeHandler extends AlterHandler {
                 isReplay);
     }
 
+    // The tasks updating the schema of the replicas of the changed indexes, so that the BEs use the new
+    // columns before a load writes them. A BE missing its task still reads and loads the new columns through
+    // the schemas of the query and load plans, and a retried task of a stale schema version is ignored.
+    AgentBatchTask createUpdateTabletSchemaTasks(OlapTable olapTable, Set<Long> indexIds) {
+        AgentBatchTask batchTask = new AgentBatchTask();
+        for (long indexId : indexIds) {
+            MaterializedIndexMeta indexMeta = olapTable.getIndexMetaByIndexId(indexId);
+            List<TColumn> columnsDesc = Lists.newArrayList();
+            for (Column column : indexMeta.getSchema()) {
+                TColumn tColumn = column.toThrift();
+                column.setIndexFlag(tColumn, olapTable.getIndexes());
+                columnsDesc.add(tColumn);
+            }
+            // be id -> <tablet id, schema hash>
+            Map<Long, Set<Pair<Long, Integer>>> beIdToTabletIdWithHash = Maps.newHashMap();
+            for (Partition partition : olapTable.getPartitions()) {
+                MaterializedIndex index = partition.getIndex(indexId);
+                if (index == null) {
+                    continue;
+                }
+                for (Tablet tablet : index.getTablets()) {
+                    for (Replica replica : tablet.getReplicas()) {
+                        beIdToTabletIdWithHash.computeIfAbsent(replica.getBackendId(), k -> Sets.newHashSet())
+                                .add(new Pair<>(tablet.getId(), indexMeta.getSchemaHash()));
+                    }
+                }
+            }
+            for (Map.Entry<Long, Set<Pair<Long, Integer>>> kv : beIdToTabletIdWithHash.entrySet()) {
+                batchTask.addTask(new UpdateTabletMetaInfoTask(kv.getKey(), kv.getValue(), columnsDesc,
+                        indexMeta.getSchemaVersion()));
+            }
+        }
+        return batchTask;
+    }
+
     public void replayModifyTableAddOrDropColumns(TableAddOrDropColumnsInfo info) throws MetaNotFoundException {
         LOG.debug("info:{}", info);
         long dbId = info.getDbId();
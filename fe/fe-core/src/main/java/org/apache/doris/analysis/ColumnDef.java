@@ -152,6 +152,12 @@ public class ColumnDef {
                 "sequence column hidden column", false);
     }
 
+    // The BE fills the row store column with the encoded rows, whatever is loaded into it.
+    public static ColumnDef newRowStoreColumnDef(AggregateType aggregateType) {
+        return new ColumnDef(Column.ROW_STORE_COL, TypeDef.create(PrimitiveType.STRING), false, aggregateType, false,
+                new ColumnDef.DefaultValue(true, ""), "doris row store hidden column", false);
+    }
+
     public boolean isAllowNull() {
         return isAllowNull;
     }
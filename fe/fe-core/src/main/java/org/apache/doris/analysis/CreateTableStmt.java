@@ -32,6 +32,7 @@ import org.apache.doris.common.FeConstants;
 import org.apache.doris.common.FeNameFormat;
 import org.apache.doris.common.UserException;
 import org.apache.doris.common.util.PrintableMap;
+import org.apache.doris.common.util.PropertyAnalyzer;
 import org.apache.doris.common.util.Util;
 import org.apache.doris.external.elasticsearch.EsUtil;
 import org.apache.doris.mysql.privilege.PrivPredicate;
@@ -365,6 +366,13 @@ public class CreateTableStmt extends DdlStmt {
                 && keysDesc.getKeysType() == KeysType.UNIQUE_KEYS) {
             columnDefs.add(ColumnDef.newDeleteSignColumnDef(AggregateType.REPLACE));
         }
+        // add a hidden column storing the whole rows
+        boolean storeRowColumn = keysDesc != null
+                && PropertyAnalyzer.analyzeStoreRowColumn(properties, keysDesc.getKeysType());
+        if (storeRowColumn) {
+            columnDefs.add(ColumnDef.newRowStoreColumnDef(
+                    keysDesc.getKeysType() == KeysType.UNIQUE_KEYS ? AggregateType.REPLACE : AggregateType.NONE));
+        }
         boolean hasObjectStored = false;
         String objectStoredColumn = "";
         Set<String> columnSet = Sets.newTreeSet(String.CASE_INSENSITIVE_ORDER);
@@ -380,6 +388,9 @@ public class CreateTableStmt extends DdlStmt {
                     throw new AnalysisException("Array can only be used in the non-key column of"
                             + " the duplicate table at present.");
                 }
+                if (storeRowColumn) {
+                    throw new AnalysisException("Array column can't be stored in the row store column");
+                }
             }
 
             if (columnDef.getType().isObjectStored()) {
@@ -470,7 +481,7 @@ public class CreateTableStmt extends DdlStmt {
                     }
                 }
                 indexes.add(new Index(indexDef.getIndexName(), indexDef.getColumns(), indexDef.getIndexType(),
-                        indexDef.getComment()));
+                        indexDef.getComment(), indexDef.getProperties()));
                 distinct.add(indexDef.getIndexName());
                 distinctCol.add(indexDef.getColumns().stream().map(String::toUpperCase).collect(Collectors.toList()));
             }
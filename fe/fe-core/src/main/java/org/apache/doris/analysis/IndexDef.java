@@ -18,13 +18,17 @@
 package org.apache.doris.analysis;
 
 import org.apache.doris.catalog.Column;
+import org.apache.doris.catalog.Index;
 import org.apache.doris.catalog.KeysType;
 import org.apache.doris.catalog.PrimitiveType;
 import org.apache.doris.common.AnalysisException;
 
 import com.google.common.base.Strings;
+import com.google.common.collect.ImmutableSet;
+import com.google.common.collect.Maps;
 
 import java.util.List;
+import java.util.Map;
 import java.util.TreeSet;
 
 public class IndexDef {
@@ -33,8 +37,32 @@ public class IndexDef {
     private List<String> columns;
     private IndexType indexType;
     private String comment;
+    private Map<String, String> properties;
+
+    public static final String INVERTED_INDEX_PARSER_KEY = "parser";
+    public static final String INVERTED_INDEX_GRAM_SIZE_KEY = "gram_size";
+    public static final String DEFAULT_INVERTED_INDEX_PARSER = "unicode";
+    public static final int DEFAULT_INVERTED_INDEX_GRAM_SIZE = 3;
+    // the BE indexes the terms of at most 256 bytes
+    private static final int MAX_INVERTED_INDEX_GRAM_SIZE = 64;
+    private static final ImmutableSet<String> INVERTED_INDEX_PARSERS =
+            ImmutableSet.of("whitespace", "unicode", "ngram");
+    public static final String BITMAP_INDEX_ENCODING_KEY = "encoding";
+    public static final String BITMAP_INDEX_BIT_SLICED_ENCODING = "bit_sliced";
+    private static final ImmutableSet<String> BITMAP_INDEX_ENCODINGS =
+            ImmutableSet.of("dictionary", BITMAP_INDEX_BIT_SLICED_ENCODING);
+    // the types stored as integers of at most 8 bytes, whose order is the one of the integers
+    private static final ImmutableSet<PrimitiveType> BIT_SLICED_BITMAP_INDEX_TYPES = ImmutableSet.of(
+            PrimitiveType.TINYINT, PrimitiveType.SMALLINT, PrimitiveType.INT, PrimitiveType.BIGINT,
+            PrimitiveType.DATE, PrimitiveType.DATETIME, PrimitiveType.DATEV2, PrimitiveType.DATETIMEV2,
+            PrimitiveType.DECIMAL32, PrimitiveType.DECIMAL64);
 
     public IndexDef(String indexName, boolean ifNotExists, List<String> columns, IndexType indexType, String comment) {
+        this(indexName, ifNotExists, columns, indexType, comment, null);
+    }
+
+    public IndexDef(String indexName, boolean ifNotExists, List<String> columns, IndexType indexType, String comment,
+                    Map<String, String> properties) {
         this.indexName = indexName;
         this.ifNotExists = ifNotExists;
         this.columns = columns;
@@ -48,12 +76,15 @@ public class IndexDef {
         } else {
             this.comment = comment;
         }
+        this.properties = properties == null ? Maps.newHashMap() : properties;
     }
 
     public void analyze() throws AnalysisException {
-        if (indexType == IndexDef.IndexType.BITMAP) {
+        if (indexType == IndexDef.IndexType.BITMAP || indexType == IndexDef.IndexType.INVERTED
+                || indexType == IndexDef.IndexType.NGRAM_BF) {
             if (columns == null || columns.size() != 1) {
-                throw new AnalysisException("bitmap index can only apply to a single column.");
+                throw new AnalysisException(indexType.name().toLowerCase()
+                        + " index can only apply to a single column.");
             }
             if (Strings.isNullOrEmpty(indexName)) {
                 throw new AnalysisException("index name cannot be blank.");
@@ -67,6 +98,91 @@ public class IndexDef {
                 throw new AnalysisException("columns of index has duplicated.");
             }
         }
+        if (indexType == IndexType.INVERTED) {
+            analyzeInvertedIndexProperties();
+        } else if (indexType == IndexType.NGRAM_BF) {
+            analyzeNgramBloomFilterProperties();
+        } else if (indexType == IndexType.BITMAP) {
+            analyzeBitmapIndexProperties();
+        } else if (!properties.isEmpty()) {
+            throw new AnalysisException(indexType + " index does not support properties.");
+        }
+    }
+
+    private void analyzeInvertedIndexProperties() throws AnalysisException {
+        for (String key : properties.keySet()) {
+            if (!key.equalsIgnoreCase(INVERTED_INDEX_PARSER_KEY)
+                    && !key.equalsIgnoreCase(INVERTED_INDEX_GRAM_SIZE_KEY)) {
+                throw new AnalysisException("Unknown inverted index property: " + key);
+            }
+        }
+        Map<String, String> analyzed = Maps.newHashMap();
+        String parser = DEFAULT_INVERTED_INDEX_PARSER;
+        int gramSize = DEFAULT_INVERTED_INDEX_GRAM_SIZE;
+        for (Map.Entry<String, String> entry : properties.entrySet()) {
+            if (entry.getKey().equalsIgnoreCase(INVERTED_INDEX_PARSER_KEY)) {
+                parser = entry.getValue().toLowerCase();
+                if (!INVERTED_INDEX_PARSERS.contains(parser)) {
+                    throw new AnalysisException("Invalid inverted index parser: " + entry.getValue()
+                            + ", it should be one of " + INVERTED_INDEX_PARSERS);
+                }
+            } else {
+                gramSize = parseGramSize(entry.getValue());
+            }
+        }
+        analyzed.put(INVERTED_INDEX_PARSER_KEY, parser);
+        analyzed.put(INVERTED_INDEX_GRAM_SIZE_KEY, String.valueOf(gramSize));
+        properties = analyzed;
+    }
+
+    private void analyzeNgramBloomFilterProperties() throws AnalysisException {
+        int gramSize = DEFAULT_INVERTED_INDEX_GRAM_SIZE;
+        for (Map.Entry<String, String> entry : properties.entrySet()) {
+            if (!entry.getKey().equalsIgnoreCase(INVERTED_INDEX_GRAM_SIZE_KEY)) {
+                throw new AnalysisException("Unknown ngram bloom filter index property: " + entry.getKey());
+            }
+            gramSize = parseGramSize(entry.getValue());
+        }
+        Map<String, String> analyzed = Maps.newHashMap();
+        analyzed.put(INVERTED_INDEX_GRAM_SIZE_KEY, String.valueOf(gramSize));
+        properties = analyzed;
+    }
+
+    private void analyzeBitmapIndexProperties() throws AnalysisException {
+        Map<String, String> analyzed = Maps.newHashMap();
+        for (Map.Entry<String, String> entry : properties.entrySet()) {
+            if (!entry.getKey().equalsIgnoreCase(BITMAP_INDEX_ENCODING_KEY)) {
+                throw new AnalysisException("Unknown bitmap index property: " + entry.getKey());
+            }
+            String encoding = entry.getValue().toLowerCase();
+            if (!BITMAP_INDEX_ENCODINGS.contains(encoding)) {
+                throw new AnalysisException("Invalid bitmap index encoding: " + entry.getValue()
+                        + ", it should be one of " + BITMAP_INDEX_ENCODINGS);
+            }
+            // the default dictionary encoding is not kept, so the existing indexes are unchanged
+            if (encoding.equals(BITMAP_INDEX_BIT_SLICED_ENCODING)) {
+                analyzed.put(BITMAP_INDEX_ENCODING_KEY, encoding);
+            }
+        }
+        properties = analyzed;
+    }
+
+    private boolean isBitSliced() {
+        return BITMAP_INDEX_BIT_SLICED_ENCODING.equals(properties.get(BITMAP_INDEX_ENCODING_KEY));
+    }
+
+    private static int parseGramSize(String value) throws AnalysisException {
+        int gramSize;
+        try {
+            gramSize = Integer.parseInt(value);
+        } catch (NumberFormatException e) {
+            gramSize = -1;
+        }
+        if (gramSize <= 0 || gramSize > MAX_INVERTED_INDEX_GRAM_SIZE) {
+            throw new AnalysisException("Invalid gram_size: " + value
+                    + ", it should be in [1, " + MAX_INVERTED_INDEX_GRAM_SIZE + "]");
+        }
+        return gramSize;
     }
 
     public String toSql() {
@@ -93,6 +209,9 @@ public class IndexDef {
         if (indexType != null) {
             sb.append(" USING ").append(indexType.toString());
         }
+        if (!properties.isEmpty()) {
+            sb.append(" PROPERTIES (").append(Index.propertiesToSql(properties)).append(")");
+        }
         if (comment != null) {
             sb.append(" COMMENT '" + comment + "'");
         }
@@ -120,13 +239,18 @@ public class IndexDef {
         return comment;
     }
 
+    public Map<String, String> getProperties() {
+        return properties;
+    }
+
     public boolean isSetIfNotExists() {
         return ifNotExists;
     }
 
     public enum IndexType {
         BITMAP,
-
+        INVERTED,
+        NGRAM_BF,
     }
 
     public void checkColumn(Column column, KeysType keysType) throws AnalysisException {
@@ -137,18 +261,33 @@ public class IndexDef {
                     || colType.isFixedPointType() || colType.isStringType() || colType == PrimitiveType.BOOLEAN)) {
                 throw new AnalysisException(colType + " is not supported in bitmap index. "
                         + "invalid column: " + indexColName);
+            } else if (isBitSliced() && !BIT_SLICED_BITMAP_INDEX_TYPES.contains(colType)) {
+                throw new AnalysisException(colType + " is not supported in bit-sliced bitmap index. "
+                        + "invalid column: " + indexColName);
             } else if ((keysType == KeysType.AGG_KEYS && !column.isKey())) {
                 throw new AnalysisException(
                         "BITMAP index only used in columns of DUP_KEYS/UNIQUE_KEYS table or key columns of"
                                 + " AGG_KEYS table. invalid column: " + indexColName);
             }
+        } else if (indexType == IndexType.INVERTED || indexType == IndexType.NGRAM_BF) {
+            String indexColName = column.getName();
+            PrimitiveType colType = column.getDataType();
+            if (!colType.isStringType()) {
+                throw new AnalysisException(colType + " is not supported in " + indexType + " index. "
+                        + "invalid column: " + indexColName);
+            } else if ((keysType == KeysType.AGG_KEYS && !column.isKey())) {
+                throw new AnalysisException(
+                        indexType + " index only used in columns of DUP_KEYS/UNIQUE_KEYS table or key columns of"
+                                + " AGG_KEYS table. invalid column: " + indexColName);
+            }
         } else {
             throw new AnalysisException("Unsupported index type: " + indexType);
         }
     }
 
     public void checkColumns(List<Column> columns, KeysType keysType) throws AnalysisException {
-        if (indexType == IndexType.BITMAP) {
+        if (indexType == IndexType.BITMAP || indexType == IndexType.INVERTED
+                || indexType == IndexType.NGRAM_BF) {
             for (Column col : columns) {
                 checkColumn(col, keysType);
             }
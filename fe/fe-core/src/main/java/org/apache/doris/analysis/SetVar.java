@@ -137,6 +137,25 @@ public class SetVar {
             }
         }
 
+        if (getVariable().equalsIgnoreCase(SessionVariable.FRAGMENT_TRANSMISSION_COMPRESSION_CODEC)) {
+            String value = getValue().getStringValue();
+            if (!SessionVariable.isValidFragmentTransmissionCompressionCodec(value)) {
+                ErrorReport.reportAnalysisException(ErrorCode.ERR_WRONG_VALUE_FOR_VAR,
+                        SessionVariable.FRAGMENT_TRANSMISSION_COMPRESSION_CODEC, value);
+            }
+        }
+
+        // the BE chooses the sketch by its lower case name
+        if (getVariable().equalsIgnoreCase(SessionVariable.PERCENTILE_APPROX_SKETCH)) {
+            String value = getValue().getStringValue();
+            if (!SessionVariable.isValidPercentileApproxSketch(value)) {
+                ErrorReport.reportAnalysisException(ErrorCode.ERR_WRONG_VALUE_FOR_VAR,
+                        SessionVariable.PERCENTILE_APPROX_SKETCH, value);
+            }
+            this.value = new StringLiteral(value.toLowerCase());
+            this.result = (LiteralExpr) this.value;
+        }
+
         // Check variable time_zone value is valid
         if (getVariable().equalsIgnoreCase(SessionVariable.TIME_ZONE)) {
             this.value = new StringLiteral(TimeUtils.checkTimeZoneValidAndStandardize(getValue().getStringValue()));
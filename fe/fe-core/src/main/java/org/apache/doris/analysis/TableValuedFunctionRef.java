@@ -22,6 +22,7 @@ import org.apache.doris.common.UserException;
 import org.apache.doris.tablefunction.TableValuedFunctionInf;
 
 import java.util.List;
+import java.util.Map;
 
 public class TableValuedFunctionRef extends TableRef {
 
@@ -29,8 +30,17 @@ public class TableValuedFunctionRef extends TableRef {
     private TableValuedFunctionInf tableFunction;
 
     public TableValuedFunctionRef(String funcName, String alias, List<String> params) throws UserException {
+        this(funcName, alias, TableValuedFunctionInf.getTableFunction(funcName, params));
+    }
+
+    public TableValuedFunctionRef(String funcName, String alias, Map<String, String> properties)
+            throws UserException {
+        this(funcName, alias, TableValuedFunctionInf.getTableFunction(funcName, properties));
+    }
+
+    private TableValuedFunctionRef(String funcName, String alias, TableValuedFunctionInf tableFunction) {
         super(new TableName(null, null, "_table_valued_function_" + funcName), alias);
-        this.tableFunction = TableValuedFunctionInf.getTableFunction(funcName, params);
+        this.tableFunction = tableFunction;
         if (hasExplicitAlias()) {
             return;
         }
@@ -2893,6 +2893,11 @@ public class Catalog {
                 sb.append(olapTable.getSequenceType().toString()).append("\"");
             }
 
+            // row store column
+            if (olapTable.hasRowStoreColumn()) {
+                sb.append(",\n\"").append(PropertyAnalyzer.PROPERTIES_STORE_ROW_COLUMN).append("\" = \"true\"");
+            }
+
             sb.append("\n)");
         } else if (table.getType() == TableType.MYSQL) {
             MysqlTable mysqlTable = (MysqlTable) table;
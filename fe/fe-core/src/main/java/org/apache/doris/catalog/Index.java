@@ -30,7 +30,10 @@ import java.io.DataInput;
 import java.io.DataOutput;
 import java.io.IOException;
 import java.util.ArrayList;
+import java.util.HashMap;
 import java.util.List;
+import java.util.Map;
+import java.util.TreeMap;
 
 /**
  * Internal representation of index, including index type, name, columns and comments.
@@ -45,12 +48,21 @@ public class Index implements Writable {
     private IndexDef.IndexType indexType;
     @SerializedName(value = "comment")
     private String comment;
+    // the parser and gram_size of an inverted index
+    @SerializedName(value = "properties")
+    private Map<String, String> properties;
 
     public Index(String indexName, List<String> columns, IndexDef.IndexType indexType, String comment) {
+        this(indexName, columns, indexType, comment, null);
+    }
+
+    public Index(String indexName, List<String> columns, IndexDef.IndexType indexType, String comment,
+                 Map<String, String> properties) {
         this.indexName = indexName;
         this.columns = columns;
         this.indexType = indexType;
         this.comment = comment;
+        this.properties = properties;
     }
 
     public Index() {
@@ -58,6 +70,7 @@ public class Index implements Writable {
         this.columns = null;
         this.indexType = null;
         this.comment = null;
+        this.properties = null;
     }
 
     public String getIndexName() {
@@ -92,6 +105,24 @@ public class Index implements Writable {
         this.comment = comment;
     }
 
+    public Map<String, String> getProperties() {
+        return properties == null ? new HashMap<>() : properties;
+    }
+
+    public static String propertiesToSql(Map<String, String> properties) {
+        StringBuilder sb = new StringBuilder();
+        boolean first = true;
+        for (Map.Entry<String, String> entry : new TreeMap<>(properties).entrySet()) {
+            if (first) {
+                first = false;
+            } else {
+                sb.append(", ");
+            }
+            sb.append("\"").append(entry.getKey()).append("\" = \"").append(entry.getValue()).append("\"");
+        }
+        return sb.toString();
+    }
+
     @Override
     public void write(DataOutput out) throws IOException {
         Text.writeString(out, GsonUtils.GSON.toJson(this));
@@ -108,7 +139,8 @@ public class Index implements Writable {
     }
 
     public Index clone() {
-        return new Index(indexName, new ArrayList<>(columns), indexType, comment);
+        return new Index(indexName, new ArrayList<>(columns), indexType, comment,
+                properties == null ? null : new HashMap<>(properties));
     }
 
     @Override
@@ -133,6 +165,9 @@ public class Index implements Writable {
         if (indexType != null) {
             sb.append(" USING ").append(indexType.toString());
         }
+        if (properties != null && !properties.isEmpty()) {
+            sb.append(" PROPERTIES (").append(propertiesToSql(properties)).append(")");
+        }
         if (comment != null) {
             sb.append(" COMMENT '" + comment + "'");
         }
@@ -147,6 +182,9 @@ public class Index implements Writable {
         if (columns != null) {
             tIndex.setComment(comment);
         }
+        if (properties != null && !properties.isEmpty()) {
+            tIndex.setProperties(properties);
+        }
         return tIndex;
     }
 }
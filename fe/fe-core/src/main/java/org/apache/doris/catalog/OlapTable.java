@@ -925,6 +925,10 @@ public class OlapTable extends Table {
         return getSequenceCol() != null;
     }
 
+    public boolean hasRowStoreColumn() {
+        return getBaseSchema(true).stream().anyMatch(Column::isRowStoreColumn);
+    }
+
     public boolean hasHiddenColumn() {
         return getBaseSchema().stream().anyMatch(column -> !column.isVisible());
     }
@@ -1693,4 +1693,17 @@ public class Config extends ConfigBase {
 
     @ConfField(mutable = false, masterOnly = true)
     public static boolean enable_multi_tags = false;
+
+    /**
+     * If set to TRUE, the fragments of the queries are sent with the digests of their plan fragments, and only the
+     * digest is sent to the BEs which acknowledged caching the plan fragment under it.
+     */
+    @ConfField(mutable = true, masterOnly = false)
+    public static boolean enable_plan_fragment_template_cache = true;
+
+    /**
+     * The number of plan fragment digests remembered for each BE as cached there.
+     */
+    @ConfField(mutable = false, masterOnly = false)
+    public static int plan_fragment_template_num_per_backend = 1024;
 }
@@ -112,6 +112,10 @@ public class PropertyAnalyzer {
 
     public static final String PROPERTIES_STORAGE_POLICY = "storage_policy";
 
+    // Whether the rows of a table are also stored whole in a hidden column, so that a point query
+    // or a lazily materialized read gets all the columns of a row at once.
+    public static final String PROPERTIES_STORE_ROW_COLUMN = "store_row_column";
+
     private static final Logger LOG = LogManager.getLogger(PropertyAnalyzer.class);
     private static final String COMMA_SEPARATOR = ",";
     private static final double MAX_FPP = 0.05;
@@ -736,4 +740,22 @@ public class PropertyAnalyzer {
         throw new AnalysisException(PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE
                                     + " must be `true` or `false`");
     }
+
+    public static boolean analyzeStoreRowColumn(Map<String, String> properties, KeysType keysType)
+            throws AnalysisException {
+        if (properties == null || !properties.containsKey(PROPERTIES_STORE_ROW_COLUMN)) {
+            return false;
+        }
+        String value = properties.remove(PROPERTIES_STORE_ROW_COLUMN);
+        if (value.equalsIgnoreCase("false")) {
+            return false;
+        } else if (!value.equalsIgnoreCase("true")) {
+            throw new AnalysisException(PROPERTIES_STORE_ROW_COLUMN + " must be `true` or `false`");
+        }
+        // the stored rows would not follow the aggregation of the value columns
+        if (keysType == KeysType.AGG_KEYS) {
+            throw new AnalysisException(PROPERTIES_STORE_ROW_COLUMN + " is not supported by AGG_KEYS tables");
+        }
+        return true;
+    }
 }
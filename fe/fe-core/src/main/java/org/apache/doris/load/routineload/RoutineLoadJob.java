@@ -564,6 +564,11 @@ public abstract class RoutineLoadJob extends AbstractTxnStateChangeCallback impl
         return loadToSingleTablet;
     }
 
+    @Override
+    public boolean isPartialUpdate() {
+        return false;
+    }
+
     @Override
     public boolean isReadJsonByLine() {
         return false;
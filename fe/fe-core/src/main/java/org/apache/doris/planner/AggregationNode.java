@@ -25,6 +25,7 @@ import org.apache.doris.analysis.Analyzer;
 import org.apache.doris.analysis.Expr;
 import org.apache.doris.analysis.FunctionCallExpr;
 import org.apache.doris.analysis.SlotId;
+import org.apache.doris.analysis.SortInfo;
 import org.apache.doris.analysis.TupleDescriptor;
 import org.apache.doris.common.NotImplementedException;
 import org.apache.doris.common.UserException;
@@ -262,12 +263,44 @@ public class AggregationNode extends PlanNode {
         if (groupingExprs != null) {
             msg.agg_node.setGroupingExprs(Expr.treesToThrift(groupingExprs));
         }
+        if (isInputSortedByGroupKeys()) {
+            msg.agg_node.setIsInputSortedByGroupKeys(true);
+        }
+    }
+
+    /**
+     * Returns true if the rows of each group come one after another from the child, which is
+     * a sort or a merging exchange whose first ordering exprs are the grouping exprs in any
+     * order. The BE then aggregates the groups in turn without a hash table. Only a one-phase
+     * aggregation of the raw rows does so.
+     */
+    public boolean isInputSortedByGroupKeys() {
+        List<Expr> groupingExprs = aggInfo.getGroupingExprs();
+        if (!needsFinalize || useStreamingPreagg || aggInfo.isMerge() || groupingExprs == null
+                || groupingExprs.isEmpty()) {
+            return false;
+        }
+        SortInfo sortInfo = null;
+        PlanNode child = getChild(0);
+        if (child instanceof SortNode) {
+            sortInfo = ((SortNode) child).getSortInfo();
+        } else if (child instanceof ExchangeNode) {
+            sortInfo = ((ExchangeNode) child).getMergeInfo();
+        }
+        if (sortInfo == null || sortInfo.getOrderingExprs().size() < groupingExprs.size()) {
+            return false;
+        }
+        List<Expr> orderingExprs = sortInfo.getOrderingExprs().subList(0, groupingExprs.size());
+        return Sets.newHashSet(orderingExprs).equals(Sets.newHashSet(groupingExprs));
     }
 
     protected String getDisplayLabelDetail() {
         if (useStreamingPreagg) {
             return "STREAMING";
         }
+        if (isInputSortedByGroupKeys()) {
+            return "SORTED INPUT";
+        }
         return null;
     }
 
@@ -22,9 +22,13 @@ package org.apache.doris.planner;
 
 import org.apache.doris.analysis.AnalyticWindow;
 import org.apache.doris.analysis.Analyzer;
+import org.apache.doris.analysis.BinaryPredicate;
 import org.apache.doris.analysis.Expr;
 import org.apache.doris.analysis.ExprSubstitutionMap;
+import org.apache.doris.analysis.FunctionCallExpr;
+import org.apache.doris.analysis.IntLiteral;
 import org.apache.doris.analysis.OrderByElement;
+import org.apache.doris.analysis.SlotRef;
 import org.apache.doris.analysis.TupleDescriptor;
 import org.apache.doris.common.UserException;
 import org.apache.doris.statistics.StatisticalType;
@@ -108,6 +112,68 @@ public class AnalyticEvalNode extends PlanNode {
         return orderByElements;
     }
 
+    /**
+     * If all the analytic functions are row_number() or rank() and one of the conjuncts bounds
+     * their result by a constant, lets the sort feeding this node drop the rows that can't be among
+     * the first rows of their partition.
+     */
+    public void pushDownPartitionTopN(List<Expr> conjuncts) {
+        if (!(getChild(0) instanceof SortNode) || !((SortNode) getChild(0)).isAnalyticSort()) {
+            return;
+        }
+        for (Expr fnCall : analyticFnCalls) {
+            if (!(fnCall instanceof FunctionCallExpr)) {
+                return;
+            }
+            String fnName = ((FunctionCallExpr) fnCall).getFnName().getFunction();
+            if (!fnName.equalsIgnoreCase("row_number") && !fnName.equalsIgnoreCase("rank")) {
+                return;
+            }
+        }
+        long limit = -1;
+        for (Expr conjunct : conjuncts) {
+            long bound = getOutputUpperBound(conjunct);
+            if (bound > 0 && (limit < 0 || bound < limit)) {
+                limit = bound;
+            }
+        }
+        if (limit > 0) {
+            ((SortNode) getChild(0)).setPartitionTopN(limit, partitionExprs.size());
+        }
+    }
+
+    // Returns n if the conjunct is "slot <= n", "slot < n + 1" or "slot = n" for an output slot
+    // of this node, or -1.
+    private long getOutputUpperBound(Expr conjunct) {
+        if (!(conjunct instanceof BinaryPredicate)) {
+            return -1;
+        }
+        BinaryPredicate predicate = (BinaryPredicate) conjunct;
+        BinaryPredicate.Operator op = predicate.getOp();
+        Expr slot = predicate.getChild(0);
+        Expr bound = predicate.getChild(1);
+        if (slot instanceof IntLiteral) {
+            slot = predicate.getChild(1);
+            bound = predicate.getChild(0);
+            op = op.converse();
+        }
+        if (!(slot instanceof SlotRef) || !(bound instanceof IntLiteral)
+                || ((SlotRef) slot).getDesc() == null
+                || ((SlotRef) slot).getDesc().getParent() != outputTupleDesc) {
+            return -1;
+        }
+        long value = ((IntLiteral) bound).getValue();
+        switch (op) {
+            case LE:
+            case EQ:
+                return value;
+            case LT:
+                return value - 1;
+            default:
+                return -1;
+        }
+    }
+
     @Override
     public void init(Analyzer analyzer) throws UserException {
         analyzer.getDescTbl().computeStatAndMemLayout();
@@ -131,6 +131,10 @@ public class ExchangeNode extends PlanNode {
                 : MERGING_EXCHANGE_NODE;
     }
 
+    public SortInfo getMergeInfo() {
+        return mergeInfo;
+    }
+
     @Override
     protected void toThrift(TPlanNode msg) {
         msg.node_type = TPlanNodeType.EXCHANGE_NODE;
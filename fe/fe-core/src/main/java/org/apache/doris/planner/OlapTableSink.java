@@ -84,6 +84,9 @@ public class OlapTableSink extends DataSink {
     private TupleDescriptor tupleDescriptor;
     // specified partition ids.
     private List<Long> partitionIds;
+    // the columns loaded by a partial update, the BE fills the other columns from the existing rows
+    private boolean isPartialUpdate = false;
+    private List<String> partialUpdateInputColumns = Lists.newArrayList();
 
     // set after init called
     private TDataSink tDataSink;
@@ -124,6 +127,11 @@ public class OlapTableSink extends DataSink {
         }
     }
 
+    public void setPartialUpdateInputColumns(List<String> columns) {
+        this.isPartialUpdate = true;
+        this.partialUpdateInputColumns = columns;
+    }
+
     public void updateLoadId(TUniqueId newLoadId) {
         tDataSink.getOlapTableSink().setLoadId(newLoadId);
     }
@@ -199,6 +207,10 @@ public class OlapTableSink extends DataSink {
                     indexMeta.getSchemaHash(), columnsDesc);
             schemaParam.addToIndexes(indexSchema);
         }
+        if (isPartialUpdate) {
+            schemaParam.setIsPartialUpdate(true);
+            schemaParam.setPartialUpdateInputColumns(partialUpdateInputColumns);
+        }
         return schemaParam;
     }
 
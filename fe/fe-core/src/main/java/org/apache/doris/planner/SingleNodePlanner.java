@@ -55,6 +55,7 @@ import org.apache.doris.catalog.AggregateFunction;
 import org.apache.doris.catalog.AggregateType;
 import org.apache.doris.catalog.Column;
 import org.apache.doris.catalog.FunctionSet;
+import org.apache.doris.catalog.KeysType;
 import org.apache.doris.catalog.MysqlTable;
 import org.apache.doris.catalog.OdbcTable;
 import org.apache.doris.catalog.Table;
@@ -65,6 +66,9 @@ import org.apache.doris.common.Reference;
 import org.apache.doris.common.UserException;
 import org.apache.doris.common.util.VectorizedUtil;
 import org.apache.doris.planner.external.ExternalFileScanNode;
+import org.apache.doris.tablefunction.ExternalFileTableValuedFunction;
+import org.apache.doris.tablefunction.TableValuedFunctionInf;
+import org.apache.doris.thrift.TPushAggOp;
 
 import com.google.common.base.Preconditions;
 import com.google.common.base.Predicate;
@@ -1144,6 +1148,7 @@ public class SingleNodePlanner {
         Preconditions.checkState(selectStmt.getAggInfo() != null);
         // add aggregation, if required
         AggregateInfo aggInfo = selectStmt.getAggInfo();
+        pushDownAggNoGrouping(aggInfo, root);
         // aggInfo.substitueGroupingExpr(analyzer);
         PlanNode newRoot = new AggregationNode(ctx.getNextNodeId(), root, aggInfo);
         newRoot.init(analyzer);
@@ -1164,6 +1169,47 @@ public class SingleNodePlanner {
         return newRoot;
     }
 
+    /**
+     * Lets the segments of an olap scan answer the aggregate above it from their metadata. That
+     * needs a scan of a duplicate key table without predicates, whose rows are the rows of its
+     * segments, and an aggregate without grouping of only min and max, or only count, of the
+     * columns of the scan. The BE still reads the rows of the segments lacking the metadata.
+     */
+    private void pushDownAggNoGrouping(AggregateInfo aggInfo, PlanNode root) {
+        if (!(root instanceof OlapScanNode) || !root.getConjuncts().isEmpty()) {
+            return;
+        }
+        OlapScanNode scanNode = (OlapScanNode) root;
+        if (scanNode.getOlapTable().getKeysType() != KeysType.DUP_KEYS
+                || !aggInfo.getGroupingExprs().isEmpty() || aggInfo.isDistinctAgg()) {
+            return;
+        }
+        TPushAggOp aggOp = null;
+        for (FunctionCallExpr aggExpr : aggInfo.getAggregateExprs()) {
+            String functionName = aggExpr.getFnName().getFunction();
+            TPushAggOp op;
+            if (functionName.equalsIgnoreCase("min") || functionName.equalsIgnoreCase("max")) {
+                op = TPushAggOp.MINMAX;
+            } else if (functionName.equalsIgnoreCase(FunctionSet.COUNT)) {
+                op = TPushAggOp.COUNT;
+            } else {
+                return;
+            }
+            if (aggExpr.isDistinct() || (aggOp != null && aggOp != op)) {
+                return;
+            }
+            for (Expr child : aggExpr.getChildren()) {
+                if (!(child instanceof SlotRef)) {
+                    return;
+                }
+            }
+            aggOp = op;
+        }
+        if (aggOp != null) {
+            scanNode.setPushDownAggNoGrouping(aggOp);
+        }
+    }
+
     /**
      * Returns a MergeNode that materializes the exprs of the constant selectStmt. Replaces the resultExprs of the
      * selectStmt with SlotRefs into the materialized tuple.
@@ -1430,6 +1476,10 @@ public class SingleNodePlanner {
         if (!canMigrateConjuncts(inlineViewRef)) {
             rootNode = addUnassignedConjuncts(
                     analyzer, inlineViewRef.getDesc().getId().asList(), rootNode);
+            // e.g. "rn <= 3" on the row_number() of the view keeps the first rows of each partition
+            if (rootNode instanceof SelectNode && rootNode.getChild(0) instanceof AnalyticEvalNode) {
+                ((AnalyticEvalNode) rootNode.getChild(0)).pushDownPartitionTopN(rootNode.getConjuncts());
+            }
         }
         return rootNode;
     }
@@ -1721,8 +1771,14 @@ public class SingleNodePlanner {
                         null, -1);
                 break;
             case TABLE_VALUED_FUNCTION:
-                scanNode = new TableValuedFunctionScanNode(ctx.getNextNodeId(), tblRef.getDesc(),
-                        "TableValuedFunctionScanNode", ((TableValuedFunctionRef) tblRef).getTableFunction());
+                TableValuedFunctionInf tableFunction = ((TableValuedFunctionRef) tblRef).getTableFunction();
+                if (tableFunction instanceof ExternalFileTableValuedFunction) {
+                    scanNode = new ExternalFileScanNode(ctx.getNextNodeId(), tblRef.getDesc(), "TVF_FILE_SCAN_NODE",
+                            (ExternalFileTableValuedFunction) tableFunction);
+                } else {
+                    scanNode = new TableValuedFunctionScanNode(ctx.getNextNodeId(), tblRef.getDesc(),
+                            "TableValuedFunctionScanNode", tableFunction);
+                }
                 break;
             case HMS_EXTERNAL_TABLE:
                 scanNode = new ExternalFileScanNode(ctx.getNextNodeId(), tblRef.getDesc(), "HMS_FILE_SCAN_NODE");
@@ -64,6 +64,10 @@ public class SortNode extends PlanNode {
     // if true, the output of this node feeds an AnalyticNode
     private boolean isAnalyticSort;
     private DataPartition inputPartition;
+    // if set, only the rows that can be among the first partitionTopNLimit rows of their partition
+    // are kept, the partition exprs are the first partitionExprsNum ordering exprs
+    private long partitionTopNLimit = -1;
+    private int partitionExprsNum = 0;
 
     /**
      * Constructor.
@@ -102,6 +106,11 @@ public class SortNode extends PlanNode {
         return isAnalyticSort;
     }
 
+    public void setPartitionTopN(long limit, int partitionExprsNum) {
+        this.partitionTopNLimit = limit;
+        this.partitionExprsNum = partitionExprsNum;
+    }
+
     public DataPartition getInputPartition() {
         return inputPartition;
     }
@@ -149,6 +158,9 @@ public class SortNode extends PlanNode {
         }
         output.append("\n");
         output.append(detailPrefix + "offset: " + offset + "\n");
+        if (partitionTopNLimit >= 0) {
+            output.append(detailPrefix + "partition topn: " + partitionTopNLimit + "\n");
+        }
         return output.toString();
     }
 
@@ -241,6 +253,10 @@ public class SortNode extends PlanNode {
 
         msg.sort_node = sortNode;
         msg.sort_node.setOffset(offset);
+        if (partitionTopNLimit >= 0) {
+            msg.sort_node.setPartitionTopnLimit(partitionTopNLimit);
+            msg.sort_node.setPartitionExprsNum(partitionExprsNum);
+        }
     }
 
     @Override
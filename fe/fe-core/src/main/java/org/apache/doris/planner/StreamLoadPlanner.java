@@ -20,6 +20,7 @@ package org.apache.doris.planner;
 import org.apache.doris.analysis.Analyzer;
 import org.apache.doris.analysis.DescriptorTable;
 import org.apache.doris.analysis.Expr;
+import org.apache.doris.analysis.ImportColumnDesc;
 import org.apache.doris.analysis.PartitionNames;
 import org.apache.doris.analysis.SlotDescriptor;
 import org.apache.doris.analysis.TupleDescriptor;
@@ -56,6 +57,7 @@ import org.apache.doris.thrift.TUniqueId;
 
 import com.google.common.collect.Lists;
 import com.google.common.collect.Maps;
+import com.google.common.collect.Sets;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
 
@@ -64,6 +66,7 @@ import java.text.SimpleDateFormat;
 import java.util.Date;
 import java.util.List;
 import java.util.Map;
+import java.util.Set;
 
 // Used to generate a plan fragment for a streaming load.
 // we only support OlapTable now.
@@ -121,6 +124,10 @@ public class StreamLoadPlanner {
         if (!destTable.hasSequenceCol() && taskInfo.hasSequenceCol()) {
             throw new UserException("There is no sequence column in the table " + destTable.getName());
         }
+        if (taskInfo.isPartialUpdate() && (destTable.getKeysType() != KeysType.UNIQUE_KEYS
+                || !destTable.getEnableUniqueKeyMergeOnWrite())) {
+            throw new AnalysisException("partial update is only supported in unique tables with merge-on-write.");
+        }
         resetAnalyzer();
         // construct tuple descriptor, used for scanNode and dataSink
         tupleDesc = descTable.createTupleDescriptor("DstTableTuple");
@@ -157,6 +164,9 @@ public class StreamLoadPlanner {
         OlapTableSink olapTableSink = new OlapTableSink(destTable, tupleDesc, partitionIds);
         olapTableSink.init(loadId, taskInfo.getTxnId(), db.getId(), taskInfo.getTimeout(),
                 taskInfo.getSendBatchParallelism(), taskInfo.isLoadToSingleTablet());
+        if (taskInfo.isPartialUpdate()) {
+            olapTableSink.setPartialUpdateInputColumns(getPartialUpdateInputColumns());
+        }
         olapTableSink.complete();
 
         // for stream load, we only need one fragment, ScanNode -> DataSink.
@@ -219,6 +229,33 @@ public class StreamLoadPlanner {
         return params;
     }
 
+    // The columns loaded by a partial update: the columns of the column list, which also holds the
+    // delete sign and the sequence column after the scan node is initialized, and their shadow
+    // columns. All the columns are loaded if the load doesn't give a column list.
+    private List<String> getPartialUpdateInputColumns() throws UserException {
+        List<ImportColumnDesc> descs = taskInfo.getColumnExprDescs().descs;
+        boolean specifyColumns = descs.stream().anyMatch(ImportColumnDesc::isColumn);
+        Set<String> inputColumns = Sets.newTreeSet(String.CASE_INSENSITIVE_ORDER);
+        for (ImportColumnDesc desc : descs) {
+            Column column = destTable.getColumn(desc.getColumnName());
+            if (column != null) {
+                inputColumns.add(column.getName());
+            }
+        }
+        List<String> columns = Lists.newArrayList();
+        for (Column column : destTable.getFullSchema()) {
+            String name = Column.removeNamePrefix(column.getName());
+            if (specifyColumns && !inputColumns.contains(name)) {
+                if (column.isKey()) {
+                    throw new UserException("partial update needs to load the key column " + name);
+                }
+                continue;
+            }
+            columns.add(column.getName());
+        }
+        return columns;
+    }
+
     // get all specified partition ids.
     // if no partition specified, return null
     private List<Long> getAllPartitionIds() throws DdlException, AnalysisException {
@@ -39,7 +39,6 @@ import org.apache.doris.system.Backend;
 import org.apache.doris.system.BeSelectionPolicy;
 import org.apache.doris.thrift.TExplainLevel;
 import org.apache.doris.thrift.TExternalScanRange;
-import org.apache.doris.thrift.TFileFormatType;
 import org.apache.doris.thrift.TFileRangeDesc;
 import org.apache.doris.thrift.TFileScanNode;
 import org.apache.doris.thrift.TFileScanRange;
@@ -56,7 +55,6 @@ import org.apache.doris.thrift.TScanRangeLocation;
 import org.apache.doris.thrift.TScanRangeLocations;
 
 import com.google.common.base.Joiner;
-import com.google.common.base.Strings;
 import com.google.common.collect.Lists;
 import com.google.common.collect.Maps;
 import com.google.common.collect.Sets;
@@ -75,15 +73,11 @@ import java.util.Set;
 
 /**
  * ExternalFileScanNode for the file access type of datasource, now only support
- * hive,hudi and iceberg.
+ * hive,hudi,iceberg and the file table valued functions.
  */
 public class ExternalFileScanNode extends ExternalScanNode {
     private static final Logger LOG = LogManager.getLogger(ExternalFileScanNode.class);
 
-    private static final String HIVE_DEFAULT_COLUMN_SEPARATOR = "\001";
-
-    private static final String HIVE_DEFAULT_LINE_DELIMITER = "\n";
-
     // Just for explain
     private int inputSplitsNum = 0;
     private long totalFileSize = 0;
@@ -98,7 +92,7 @@ public class ExternalFileScanNode extends ExternalScanNode {
 
         private int nextBe = 0;
 
-        public void init() throws UserException {
+        public void init(long backendId) throws UserException {
             Set<Tag> tags = Sets.newHashSet();
             if (ConnectContext.get().getCurrentUserIdentity() != null) {
                 String qualifiedUser = ConnectContext.get().getCurrentUserIdentity().getQualifiedUser();
@@ -117,12 +111,16 @@ public class ExternalFileScanNode extends ExternalScanNode {
                     .addTags(tags)
                     .build();
             for (Backend be : Catalog.getCurrentSystemInfo().getIdToBackend().values()) {
+                if (backendId >= 0 && be.getId() != backendId) {
+                    continue;
+                }
                 if (policy.isMatch(be)) {
                     backends.add(be);
                 }
             }
             if (backends.isEmpty()) {
-                throw new UserException("No available backends");
+                throw new UserException(backendId >= 0 ? "Backend " + backendId + " is not available"
+                        : "No available backends");
             }
             Random random = new Random(System.currentTimeMillis());
             Collections.shuffle(backends, random);
@@ -171,6 +169,7 @@ public class ExternalFileScanNode extends ExternalScanNode {
 
     private List<TScanRangeLocations> scanRangeLocations;
 
+    // null when scanning the files of a table valued function
     private final HMSExternalTable hmsTable;
 
     private ExternalFileScanProvider scanProvider;
@@ -202,14 +201,29 @@ public class ExternalFileScanNode extends ExternalScanNode {
         }
     }
 
+    /**
+     * External file scan node for the files of a table valued function, like s3().
+     */
+    public ExternalFileScanNode(
+            PlanNodeId id,
+            TupleDescriptor desc,
+            String planNodeName,
+            ExternalFileScanProvider scanProvider) {
+
+        super(id, desc, planNodeName, StatisticalType.FILE_SCAN_NODE);
+
+        this.hmsTable = null;
+        this.scanProvider = scanProvider;
+    }
+
     @Override
     public void init(Analyzer analyzer) throws UserException {
         super.init(analyzer);
-        if (hmsTable.isView()) {
+        if (hmsTable != null && hmsTable.isView()) {
             throw new AnalysisException(String.format("Querying external view '[%s].%s.%s' is not supported",
                     hmsTable.getDlaType(), hmsTable.getDbName(), hmsTable.getName()));
         }
-        backendPolicy.init();
+        backendPolicy.init(scanProvider.getBackendId());
         numNodes = backendPolicy.numBackends();
         initContext();
     }
@@ -217,19 +231,8 @@ public class ExternalFileScanNode extends ExternalScanNode {
     private void initContext() throws DdlException, MetaNotFoundException {
         context.srcTupleDescriptor = analyzer.getDescTbl().createTupleDescriptor();
         context.params = new TFileScanRangeParams();
-        if (scanProvider.getTableFormatType().equals(TFileFormatType.FORMAT_CSV_PLAIN)) {
-            Map<String, String> serDeInfoParams = hmsTable.getRemoteTable().getSd().getSerdeInfo().getParameters();
-            String columnSeparator = Strings.isNullOrEmpty(serDeInfoParams.get("field.delim"))
-                    ? HIVE_DEFAULT_COLUMN_SEPARATOR
-                    : serDeInfoParams.get("field.delim");
-            String lineDelimiter = Strings.isNullOrEmpty(serDeInfoParams.get("line.delim"))
-                    ? HIVE_DEFAULT_LINE_DELIMITER
-                    : serDeInfoParams.get("line.delim");
-
-            TFileTextScanRangeParams textParams = new TFileTextScanRangeParams();
-            textParams.setLineDelimiterStr(lineDelimiter);
-            textParams.setColumnSeparatorStr(columnSeparator);
-
+        TFileTextScanRangeParams textParams = scanProvider.getTextParams();
+        if (textParams != null) {
             context.params.setTextParams(textParams);
         }
 
@@ -239,7 +242,7 @@ public class ExternalFileScanNode extends ExternalScanNode {
 
         Map<String, SlotDescriptor> slotDescByName = Maps.newTreeMap(String.CASE_INSENSITIVE_ORDER);
 
-        List<Column> columns = hmsTable.getBaseSchema(false);
+        List<Column> columns = scanProvider.getTableColumns();
         for (Column column : columns) {
             SlotDescriptor slotDesc = analyzer.getDescTbl().addSlotDescriptor(context.srcTupleDescriptor);
             slotDesc.setType(column.getType());
@@ -297,7 +300,7 @@ public class ExternalFileScanNode extends ExternalScanNode {
             tHdfsParams.setFsName(fsName);
             context.params.setHdfsParams(tHdfsParams);
         } else if (scanProvider.getTableFileType() == TFileType.FILE_S3) {
-            context.params.setProperties(hmsTable.getS3Properties());
+            context.params.setProperties(scanProvider.getS3Properties());
         }
 
         TScanRangeLocations curLocations = newLocations(context.params);
@@ -364,7 +367,8 @@ public class ExternalFileScanNode extends ExternalScanNode {
         rangeDesc.setSize(fileSplit.getLength());
         rangeDesc.setColumnsFromPath(columnsFromPath);
 
-        if (scanProvider.getTableFileType() == TFileType.FILE_HDFS) {
+        if (scanProvider.getTableFileType() == TFileType.FILE_HDFS
+                || scanProvider.getTableFileType() == TFileType.FILE_LOCAL) {
             rangeDesc.setPath(fileSplit.getPath().toUri().getPath());
         } else if (scanProvider.getTableFileType() == TFileType.FILE_S3) {
             rangeDesc.setPath(fileSplit.getPath().toString());
@@ -403,8 +407,13 @@ public class ExternalFileScanNode extends ExternalScanNode {
     @Override
     public String getNodeExplainString(String prefix, TExplainLevel detailLevel) {
         StringBuilder output = new StringBuilder();
-        output.append(prefix).append("table: ").append(hmsTable.getDbName()).append(".").append(hmsTable.getName())
-                .append("\n").append(prefix).append("hms url: ").append(scanProvider.getMetaStoreUrl()).append("\n");
+        if (hmsTable != null) {
+            output.append(prefix).append("table: ").append(hmsTable.getDbName()).append(".")
+                    .append(hmsTable.getName()).append("\n").append(prefix).append("hms url: ")
+                    .append(scanProvider.getMetaStoreUrl()).append("\n");
+        } else {
+            output.append(prefix).append("table: ").append(desc.getTable().getName()).append("\n");
+        }
 
         if (!conjuncts.isEmpty()) {
             output.append(prefix).append("predicates: ").append(getExplainString(conjuncts)).append("\n");
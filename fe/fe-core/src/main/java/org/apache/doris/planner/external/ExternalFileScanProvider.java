@@ -18,10 +18,12 @@
 package org.apache.doris.planner.external;
 
 import org.apache.doris.analysis.Expr;
+import org.apache.doris.catalog.Column;
 import org.apache.doris.common.DdlException;
 import org.apache.doris.common.MetaNotFoundException;
 import org.apache.doris.common.UserException;
 import org.apache.doris.thrift.TFileFormatType;
+import org.apache.doris.thrift.TFileTextScanRangeParams;
 import org.apache.doris.thrift.TFileType;
 
 import org.apache.hadoop.hive.metastore.api.Table;
@@ -48,4 +50,18 @@ public interface ExternalFileScanProvider {
     Map<String, String> getTableProperties() throws MetaNotFoundException;
 
     List<String> getPathPartitionKeys() throws DdlException, MetaNotFoundException;
+
+    // The columns of the files, followed by the partition columns parsed from their paths.
+    List<Column> getTableColumns() throws DdlException, MetaNotFoundException;
+
+    // The separators of the text files, or null for the other formats.
+    TFileTextScanRangeParams getTextParams() throws DdlException, MetaNotFoundException;
+
+    // The properties to access the files on S3.
+    Map<String, String> getS3Properties();
+
+    // The id of the only backend able to read the files, or -1 if any backend can.
+    default long getBackendId() {
+        return -1;
+    }
 }
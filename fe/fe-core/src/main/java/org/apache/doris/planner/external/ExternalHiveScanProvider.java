@@ -18,6 +18,7 @@
 package org.apache.doris.planner.external;
 
 import org.apache.doris.analysis.Expr;
+import org.apache.doris.catalog.Column;
 import org.apache.doris.catalog.HiveMetaStoreClientHelper;
 import org.apache.doris.catalog.external.HMSExternalTable;
 import org.apache.doris.common.DdlException;
@@ -25,8 +26,10 @@ import org.apache.doris.common.MetaNotFoundException;
 import org.apache.doris.common.UserException;
 import org.apache.doris.external.hive.util.HiveUtil;
 import org.apache.doris.thrift.TFileFormatType;
+import org.apache.doris.thrift.TFileTextScanRangeParams;
 import org.apache.doris.thrift.TFileType;
 
+import com.google.common.base.Strings;
 import com.google.common.collect.Lists;
 import com.google.common.collect.Maps;
 import org.apache.hadoop.conf.Configuration;
@@ -49,6 +52,10 @@ import java.util.stream.Collectors;
  * A HiveScanProvider to get information for scan node.
  */
 public class ExternalHiveScanProvider implements ExternalFileScanProvider {
+    private static final String HIVE_DEFAULT_COLUMN_SEPARATOR = "\001";
+
+    private static final String HIVE_DEFAULT_LINE_DELIMITER = "\n";
+
     protected HMSExternalTable hmsTable;
 
     public ExternalHiveScanProvider(HMSExternalTable hmsTable) {
@@ -162,4 +169,33 @@ public class ExternalHiveScanProvider implements ExternalFileScanProvider {
     public List<String> getPathPartitionKeys() throws DdlException, MetaNotFoundException {
         return getRemoteHiveTable().getPartitionKeys().stream().map(FieldSchema::getName).collect(Collectors.toList());
     }
+
+    @Override
+    public List<Column> getTableColumns() {
+        return hmsTable.getBaseSchema(false);
+    }
+
+    @Override
+    public TFileTextScanRangeParams getTextParams() throws DdlException, MetaNotFoundException {
+        if (!getTableFormatType().equals(TFileFormatType.FORMAT_CSV_PLAIN)) {
+            return null;
+        }
+        Map<String, String> serDeInfoParams = getRemoteHiveTable().getSd().getSerdeInfo().getParameters();
+        String columnSeparator = Strings.isNullOrEmpty(serDeInfoParams.get("field.delim"))
+                ? HIVE_DEFAULT_COLUMN_SEPARATOR
+                : serDeInfoParams.get("field.delim");
+        String lineDelimiter = Strings.isNullOrEmpty(serDeInfoParams.get("line.delim"))
+                ? HIVE_DEFAULT_LINE_DELIMITER
+                : serDeInfoParams.get("line.delim");
+
+        TFileTextScanRangeParams textParams = new TFileTextScanRangeParams();
+        textParams.setLineDelimiterStr(lineDelimiter);
+        textParams.setColumnSeparatorStr(columnSeparator);
+        return textParams;
+    }
+
+    @Override
+    public Map<String, String> getS3Properties() {
+        return hmsTable.getS3Properties();
+    }
 }
@@ -79,6 +79,7 @@ import org.apache.doris.thrift.TExecPlanFragmentParamsList;
 import org.apache.doris.thrift.TLoadErrorHubInfo;
 import org.apache.doris.thrift.TNetworkAddress;
 import org.apache.doris.thrift.TPaloScanRange;
+import org.apache.doris.thrift.TPlanFragment;
 import org.apache.doris.thrift.TPlanFragmentDestination;
 import org.apache.doris.thrift.TPlanFragmentExecParams;
 import org.apache.doris.thrift.TQueryGlobals;
@@ -235,6 +236,8 @@ public class Coordinator {
     public List<RuntimeFilter> assignedRuntimeFilters = new ArrayList<>();
     // Runtime filter ID to the builder instance number
     public Map<RuntimeFilterId, Integer> ridToBuilderNum = Maps.newHashMap();
+    // Runtime filter ID to the builder instance number on each BE
+    public Map<RuntimeFilterId, Map<TNetworkAddress, Integer>> ridToHostBuilderNum = Maps.newHashMap();
 
 
     // Used for query/insert
@@ -662,8 +665,9 @@ public class Coordinator {
                 }
                 states.scopedSpan = new ScopedSpan(span);
                 states.unsetFields();
-                futures.add(Pair.create(states, states.execRemoteFragmentsAsync()));
+                futures.add(Pair.create(states, states.execRemoteFragmentsAsync(true)));
             }
+            updateFragmentTemplates(futures, this.timeoutDeadline - System.currentTimeMillis());
             waitRpc(futures, this.timeoutDeadline - System.currentTimeMillis(), "send fragments");
 
             if (twoPhaseExecution) {
@@ -687,6 +691,36 @@ public class Coordinator {
         }
     }
 
+    // Records the plan fragments the backends cached, and sends the fragments again with the whole plan fragments to
+    // the backends which no longer cached some of the plan fragments omitted from the requests. The backends fail
+    // such requests before executing any of their fragments.
+    private void updateFragmentTemplates(List<Pair<BackendExecStates, Future<PExecPlanFragmentResult>>> futures,
+            long timeoutMs) throws TException {
+        for (Pair<BackendExecStates, Future<PExecPlanFragmentResult>> pair : futures) {
+            if (timeoutMs <= 0) {
+                // waitRpc reports the timeout
+                return;
+            }
+            PExecPlanFragmentResult result;
+            try {
+                result = pair.second.get(timeoutMs, TimeUnit.MILLISECONDS);
+            } catch (ExecutionException | TimeoutException e) {
+                // waitRpc reports the failure
+                continue;
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                return;
+            }
+            FragmentTemplateTracker.addCached(pair.first.beId, result.getCachedFragmentDigestsList());
+            if (result.getMissingFragmentDigestsCount() > 0) {
+                LOG.info("backend {} no longer caches {} plan fragments, send them again. query id: {}",
+                        pair.first.beId, result.getMissingFragmentDigestsCount(), DebugUtil.printId(queryId));
+                FragmentTemplateTracker.removeCached(pair.first.beId, result.getMissingFragmentDigestsList());
+                pair.second = pair.first.execRemoteFragmentsAsync(false);
+            }
+        }
+    }
+
     private void waitRpc(List<Pair<BackendExecStates, Future<PExecPlanFragmentResult>>> futures, long timeoutMs,
             String operation) throws RpcException, UserException {
         if (timeoutMs <= 0) {
@@ -736,6 +770,10 @@ public class Coordinator {
                         case THRIFT_RPC_ERROR:
                             SimpleScheduler.addToBlacklist(pair.first.beId, errMsg);
                             throw new RpcException(pair.first.brpcAddr.hostname, errMsg, exception);
+                        case TOO_MANY_TASKS:
+                            // the BE is busy and rejected the fragment before running it, so the
+                            // query can be retried like after an RPC failure
+                            throw new RpcException(pair.first.brpcAddr.hostname, errMsg, exception);
                         default:
                             throw new UserException(errMsg, exception);
                     }
@@ -1355,6 +1393,11 @@ public class Coordinator {
 
             for (RuntimeFilterId rid : fragment.getBuilderRuntimeFilterIds()) {
                 ridToBuilderNum.merge(rid, params.instanceExecParams.size(), Integer::sum);
+                Map<TNetworkAddress, Integer> hostBuilderNum =
+                        ridToHostBuilderNum.computeIfAbsent(rid, k -> Maps.newHashMap());
+                for (final FInstanceExecParam instance : params.instanceExecParams) {
+                    hostBuilderNum.merge(instance.host, 1, Integer::sum);
+                }
             }
         }
         // Use the uppermost fragment as a merged node, the uppermost fragment has one and only one instance
@@ -2218,18 +2261,41 @@ public class Coordinator {
             }
         }
 
-        public Future<InternalService.PExecPlanFragmentResult> execRemoteFragmentsAsync() throws TException {
-            try {
-                TExecPlanFragmentParamsList paramsList = new TExecPlanFragmentParamsList();
-                for (BackendExecState state : states) {
-                    paramsList.addToParamsList(state.rpcParams);
+        /**
+         * Sends the fragment instances to the backend. When omitCachedFragments is true, the plan fragments cached on
+         * the backend, or sent earlier in the same request, are omitted and only their digests are sent.
+         */
+        public Future<InternalService.PExecPlanFragmentResult> execRemoteFragmentsAsync(boolean omitCachedFragments)
+                throws TException {
+            TExecPlanFragmentParamsList paramsList = new TExecPlanFragmentParamsList();
+            // the params whose plan fragments are omitted, restored once the request is serialized
+            List<Pair<TExecPlanFragmentParams, TPlanFragment>> omitted = Lists.newArrayList();
+            boolean cachedOnBackend = omitCachedFragments && FragmentTemplateTracker.isCachedOn(beId);
+            Set<String> sentDigests = Sets.newHashSet();
+            for (BackendExecState state : states) {
+                TExecPlanFragmentParams params = state.rpcParams;
+                if (cachedOnBackend && params.isSetFragmentDigest() && params.isSetFragment()) {
+                    String digest = params.getFragmentDigest();
+                    if (sentDigests.contains(digest) || FragmentTemplateTracker.isCachedOn(beId, digest)) {
+                        omitted.add(Pair.create(params, params.getFragment()));
+                        params.unsetFragment();
+                    } else {
+                        sentDigests.add(digest);
+                    }
                 }
+                paramsList.addToParamsList(params);
+            }
+            try {
                 return BackendServiceProxy.getInstance()
                         .execPlanFragmentsAsync(brpcAddr, paramsList, twoPhaseExecution);
             } catch (RpcException e) {
                 // DO NOT throw exception here, return a complete future with error code,
                 // so that the following logic will cancel the fragment.
                 return futureWithException(e);
+            } finally {
+                for (Pair<TExecPlanFragmentParams, TPlanFragment> pair : omitted) {
+                    pair.first.setFragment(pair.second);
+                }
             }
         }
 
@@ -2296,14 +2362,23 @@ public class Coordinator {
             this.fragment = fragment;
         }
 
-        List<TExecPlanFragmentParams> toThrift(int backendNum) {
+        List<TExecPlanFragmentParams> toThrift(int backendNum) throws TException {
             List<TExecPlanFragmentParams> paramsList = Lists.newArrayList();
+            // the plan fragments of the loads carry the ids of their transactions, only those of the queries are
+            // the same for each execution
+            String fragmentDigest = null;
+            if (Config.enable_plan_fragment_template_cache && queryOptions.getQueryType() == TQueryType.SELECT) {
+                fragmentDigest = FragmentTemplateTracker.digest(fragment.toThrift());
+            }
 
             for (int i = 0; i < instanceExecParams.size(); ++i) {
                 final FInstanceExecParam instanceExecParam = instanceExecParams.get(i);
                 TExecPlanFragmentParams params = new TExecPlanFragmentParams();
                 params.setProtocolVersion(PaloInternalServiceVersion.V1);
                 params.setFragment(fragment.toThrift());
+                if (fragmentDigest != null) {
+                    params.setFragmentDigest(fragmentDigest);
+                }
                 params.setDescTbl(descTable);
                 params.setParams(new TPlanFragmentExecParams());
                 params.setResourceInfo(tResourceInfo);
@@ -2328,6 +2403,15 @@ public class Coordinator {
                         fragment.isTransferQueryStatisticsWithEveryBatch());
                 params.params.setRuntimeFilterParams(new TRuntimeFilterParams());
                 params.params.runtime_filter_params.setRuntimeFilterMergeAddr(runtimeFilterMergeAddr);
+                // The builders on the same BE merge their filters before sending them to the merge instance
+                for (RuntimeFilterId rid : fragment.getBuilderRuntimeFilterIds()) {
+                    Integer localBuilderNum = ridToHostBuilderNum.getOrDefault(rid, Maps.newHashMap())
+                            .get(instanceExecParam.host);
+                    if (localBuilderNum != null && localBuilderNum > 1) {
+                        params.params.runtime_filter_params.putToRuntimeFilterLocalBuilderNum(
+                                rid.asInt(), localBuilderNum);
+                    }
+                }
                 if (instanceExecParam.instanceId.equals(runtimeFilterMergeInstanceId)) {
                     for (Map.Entry<RuntimeFilterId, List<FRuntimeFilterTargetParam>> entry
                             : ridToTargetParam.entrySet()) {
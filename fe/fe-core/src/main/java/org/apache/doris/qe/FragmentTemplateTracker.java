@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package org.apache.doris.qe;
+
+import org.apache.doris.common.Config;
+import org.apache.doris.thrift.TPlanFragment;
+
+import com.google.common.collect.Maps;
+import org.apache.commons.codec.digest.DigestUtils;
+import org.apache.thrift.TException;
+import org.apache.thrift.TSerializer;
+import org.apache.thrift.protocol.TBinaryProtocol;
+
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * Tracks the plan fragments cached on each backend by their digests, so that a fragment sent to a backend which
+ * already has its plan fragment carries only the digest. A backend only appears here after it acknowledged caching a
+ * fragment, so the backends without the cache always get the whole plan fragments.
+ */
+public class FragmentTemplateTracker {
+    // backend id -> digests of the plan fragments it cached, the least recently cached first
+    private static Map<Long, Set<String>> backendDigests = Maps.newConcurrentMap();
+
+    public static String digest(TPlanFragment fragment) throws TException {
+        return DigestUtils.sha256Hex(new TSerializer(new TBinaryProtocol.Factory()).serialize(fragment));
+    }
+
+    // Whether the backend caches the plan fragments, and the fragments sent to it can omit them.
+    public static boolean isCachedOn(long backendId) {
+        return backendDigests.containsKey(backendId);
+    }
+
+    public static boolean isCachedOn(long backendId, String digest) {
+        Set<String> digests = backendDigests.get(backendId);
+        return digests != null && digests.contains(digest);
+    }
+
+    public static void addCached(long backendId, List<String> digests) {
+        if (digests.isEmpty()) {
+            return;
+        }
+        backendDigests.computeIfAbsent(backendId, id -> Collections.synchronizedSet(Collections.newSetFromMap(
+                new LinkedHashMap<String, Boolean>(16, 0.75f, true) {
+                    @Override
+                    protected boolean removeEldestEntry(Map.Entry<String, Boolean> eldest) {
+                        return size() > Config.plan_fragment_template_num_per_backend;
+                    }
+                }))).addAll(digests);
+    }
+
+    // The backend evicted the plan fragments or restarted.
+    public static void removeCached(long backendId, List<String> digests) {
+        Set<String> cached = backendDigests.get(backendId);
+        if (cached != null) {
+            cached.removeAll(digests);
+        }
+    }
+}
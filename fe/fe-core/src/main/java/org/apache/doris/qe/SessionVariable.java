@@ -24,6 +24,7 @@ import org.apache.doris.qe.VariableMgr.VarAttr;
 import org.apache.doris.thrift.TQueryOptions;
 import org.apache.doris.thrift.TResourceLimit;
 
+import com.google.common.collect.ImmutableSet;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
 import org.json.simple.JSONObject;
@@ -188,6 +189,22 @@ public class SessionVariable implements Serializable, Writable {
     public static final String TRIM_TAILING_SPACES_FOR_EXTERNAL_TABLE_QUERY
             = "trim_tailing_spaces_for_external_table_query";
 
+    public static final String FRAGMENT_TRANSMISSION_COMPRESSION_CODEC =
+            "fragment_transmission_compression_codec";
+    // the codecs the BE can compress the blocks sent between fragments with
+    public static final ImmutableSet<String> FRAGMENT_TRANSMISSION_COMPRESSION_CODECS =
+            ImmutableSet.of("none", "snappy", "lz4", "lz4f", "zlib", "zstd");
+
+    public static final String PERCENTILE_APPROX_SKETCH = "percentile_approx_sketch";
+    // the sketches percentile_approx can keep its values in
+    public static final ImmutableSet<String> PERCENTILE_APPROX_SKETCHES = ImmutableSet.of("tdigest", "ddsketch");
+
+    public static final String SCAN_THREAD_SHARES = "scan_thread_shares";
+
+    public static final String WORKLOAD_GROUP = "workload_group";
+
+    public static final String ENABLE_PERF_COUNTERS = "enable_perf_counters";
+
     static final String ENABLE_ARRAY_TYPE = "enable_array_type";
 
     public static final String ENABLE_NEREIDS_PLANNER = "enable_nereids_planner";
@@ -421,6 +438,27 @@ public class SessionVariable implements Serializable, Writable {
     @VariableMgr.VarAttr(name = TRIM_TAILING_SPACES_FOR_EXTERNAL_TABLE_QUERY, needForward = true)
     public boolean trimTailingSpacesForExternalTableQuery = false;
 
+    // the codec compressing the blocks sent between fragments: none, snappy, lz4 or zstd
+    @VariableMgr.VarAttr(name = FRAGMENT_TRANSMISSION_COMPRESSION_CODEC, needForward = true)
+    public String fragmentTransmissionCompressionCodec = "snappy";
+
+    // the sketch percentile_approx keeps its values in: tdigest or ddsketch
+    @VariableMgr.VarAttr(name = PERCENTILE_APPROX_SKETCH, needForward = true)
+    public String percentileApproxSketch = "tdigest";
+
+    // the share of the scanner threads of a BE given to the query, relative to 1024
+    @VariableMgr.VarAttr(name = SCAN_THREAD_SHARES, needForward = true)
+    public int scanThreadShares = 1024;
+
+    // the workload group of the queries, one of the workload_groups of the BE config
+    @VariableMgr.VarAttr(name = WORKLOAD_GROUP, needForward = true)
+    public String workloadGroup = "";
+
+    // whether the query profile has the CPU time, off CPU time, instructions and cache misses of
+    // the operators
+    @VariableMgr.VarAttr(name = ENABLE_PERF_COUNTERS, needForward = true)
+    public boolean enablePerfCounters = false;
+
 
     // the maximum size in bytes for a table that will be broadcast to all be nodes
     // when performing a join, By setting this value to -1 broadcasting can be disabled.
@@ -975,6 +1013,62 @@ public class SessionVariable implements Serializable, Writable {
         this.trimTailingSpacesForExternalTableQuery = trimTailingSpacesForExternalTableQuery;
     }
 
+    public String getFragmentTransmissionCompressionCodec() {
+        return fragmentTransmissionCompressionCodec;
+    }
+
+    public static boolean isValidFragmentTransmissionCompressionCodec(String codec) {
+        return codec != null && FRAGMENT_TRANSMISSION_COMPRESSION_CODECS.contains(codec.toLowerCase());
+    }
+
+    public void setFragmentTransmissionCompressionCodec(String codec) {
+        if (!isValidFragmentTransmissionCompressionCodec(codec)) {
+            throw new IllegalArgumentException("Invalid fragment transmission compression codec: " + codec
+                    + ", now we support " + FRAGMENT_TRANSMISSION_COMPRESSION_CODECS);
+        }
+        this.fragmentTransmissionCompressionCodec = codec;
+    }
+
+    public String getPercentileApproxSketch() {
+        return percentileApproxSketch;
+    }
+
+    public static boolean isValidPercentileApproxSketch(String sketch) {
+        return sketch != null && PERCENTILE_APPROX_SKETCHES.contains(sketch.toLowerCase());
+    }
+
+    public void setPercentileApproxSketch(String percentileApproxSketch) {
+        if (!isValidPercentileApproxSketch(percentileApproxSketch)) {
+            throw new IllegalArgumentException("Invalid percentile approx sketch: " + percentileApproxSketch
+                    + ", now we support " + PERCENTILE_APPROX_SKETCHES);
+        }
+        this.percentileApproxSketch = percentileApproxSketch.toLowerCase();
+    }
+
+    public int getScanThreadShares() {
+        return scanThreadShares;
+    }
+
+    public void setScanThreadShares(int scanThreadShares) {
+        this.scanThreadShares = scanThreadShares;
+    }
+
+    public String getWorkloadGroup() {
+        return workloadGroup;
+    }
+
+    public void setWorkloadGroup(String workloadGroup) {
+        this.workloadGroup = workloadGroup;
+    }
+
+    public boolean isEnablePerfCounters() {
+        return enablePerfCounters;
+    }
+
+    public void setEnablePerfCounters(boolean enablePerfCounters) {
+        this.enablePerfCounters = enablePerfCounters;
+    }
+
     public void setEnableJoinReorderBasedCost(boolean enableJoinReorderBasedCost) {
         this.enableJoinReorderBasedCost = enableJoinReorderBasedCost;
     }
@@ -1042,6 +1136,11 @@ public class SessionVariable implements Serializable, Writable {
         tResult.setEnableVectorizedEngine(enableVectorizedEngine);
         tResult.setReturnObjectDataAsBinary(returnObjectDataAsBinary);
         tResult.setTrimTailingSpacesForExternalTableQuery(trimTailingSpacesForExternalTableQuery);
+        tResult.setFragmentTransmissionCompressionCodec(fragmentTransmissionCompressionCodec);
+        tResult.setPercentileApproxSketch(percentileApproxSketch);
+        tResult.setScanThreadShares(scanThreadShares);
+        tResult.setWorkloadGroup(workloadGroup);
+        tResult.setEnablePerfCounters(enablePerfCounters);
 
         tResult.setBatchSize(batchSize);
         tResult.setDisableStreamPreaggregations(disableStreamPreaggregations);
@@ -118,6 +118,11 @@ public class BackendServiceClient {
         return stub.foldConstantExpr(request);
     }
 
+    public Future<InternalService.PFetchTableSchemaResult> fetchTableSchema(
+            InternalService.PFetchTableSchemaRequest request) {
+        return stub.fetchTableSchema(request);
+    }
+
     public void shutdown() {
         if (!channel.isShutdown()) {
             channel.shutdown();
@@ -22,6 +22,7 @@ import org.apache.doris.proto.InternalService;
 import org.apache.doris.proto.InternalService.PExecPlanFragmentStartRequest;
 import org.apache.doris.proto.Types;
 import org.apache.doris.thrift.TExecPlanFragmentParamsList;
+import org.apache.doris.thrift.TFileScanRange;
 import org.apache.doris.thrift.TFoldConstantParams;
 import org.apache.doris.thrift.TNetworkAddress;
 import org.apache.doris.thrift.TUniqueId;
@@ -275,4 +276,18 @@ public class BackendServiceProxy {
             throw new RpcException(address.hostname, e.getMessage());
         }
     }
+
+    public Future<InternalService.PFetchTableSchemaResult> fetchTableSchema(
+            TNetworkAddress address, TFileScanRange fileScanRange) throws RpcException, TException {
+        final InternalService.PFetchTableSchemaRequest pRequest = InternalService.PFetchTableSchemaRequest.newBuilder()
+                .setFileScanRange(ByteString.copyFrom(new TSerializer().serialize(fileScanRange))).build();
+
+        try {
+            final BackendServiceClient client = getProxy(address);
+            return client.fetchTableSchema(pRequest);
+        } catch (Throwable e) {
+            LOG.warn("failed to fetch table schema, address={}:{}", address.getHostname(), address.getPort(), e);
+            throw new RpcException(address.hostname, e.getMessage());
+        }
+    }
 }
@@ -0,0 +1,261 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package org.apache.doris.tablefunction;
+
+import org.apache.doris.analysis.Expr;
+import org.apache.doris.catalog.Catalog;
+import org.apache.doris.catalog.Column;
+import org.apache.doris.catalog.PrimitiveType;
+import org.apache.doris.catalog.ScalarType;
+import org.apache.doris.common.AnalysisException;
+import org.apache.doris.common.UserException;
+import org.apache.doris.common.util.BrokerUtil;
+import org.apache.doris.planner.external.ExternalFileScanProvider;
+import org.apache.doris.proto.InternalService;
+import org.apache.doris.proto.Types;
+import org.apache.doris.rpc.BackendServiceProxy;
+import org.apache.doris.system.Backend;
+import org.apache.doris.thrift.TFileFormatType;
+import org.apache.doris.thrift.TFileRangeDesc;
+import org.apache.doris.thrift.TFileScanRange;
+import org.apache.doris.thrift.TFileScanRangeParams;
+import org.apache.doris.thrift.TFileTextScanRangeParams;
+import org.apache.doris.thrift.TFileType;
+import org.apache.doris.thrift.THdfsParams;
+import org.apache.doris.thrift.TNetworkAddress;
+import org.apache.doris.thrift.TPrimitiveType;
+import org.apache.doris.thrift.TTypeNodeType;
+
+import com.google.common.collect.Lists;
+import com.google.common.collect.Maps;
+import org.apache.hadoop.conf.Configuration;
+import org.apache.hadoop.fs.FileStatus;
+import org.apache.hadoop.fs.FileSystem;
+import org.apache.hadoop.fs.Path;
+import org.apache.hadoop.hive.metastore.api.Table;
+import org.apache.hadoop.mapred.FileSplit;
+import org.apache.hadoop.mapred.InputSplit;
+import org.apache.logging.log4j.LogManager;
+import org.apache.logging.log4j.Logger;
+
+import java.io.IOException;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * The base of the table valued functions reading files, like s3("uri" = "...", "format" = "parquet").
+ * The files are scanned by ExternalFileScanNode, and their schema is read from the footer of the first
+ * file by a backend.
+ */
+public abstract class ExternalFileTableValuedFunction extends TableValuedFunctionInf
+        implements ExternalFileScanProvider {
+    private static final Logger LOG = LogManager.getLogger(ExternalFileTableValuedFunction.class);
+
+    public static final String FORMAT = "format";
+
+    private static final int FETCH_TABLE_SCHEMA_TIMEOUT_SEC = 30;
+
+    // The properties given by the user, with case insensitive keys.
+    protected final Map<String, String> properties = Maps.newTreeMap(String.CASE_INSENSITIVE_ORDER);
+
+    private final TFileFormatType formatType;
+
+    private List<InputSplit> fileSplits;
+
+    private List<Column> columns;
+
+    protected ExternalFileTableValuedFunction(Map<String, String> params) throws UserException {
+        properties.putAll(params);
+        String format = properties.getOrDefault(FORMAT, "").toLowerCase();
+        switch (format) {
+            case "parquet":
+                formatType = TFileFormatType.FORMAT_PARQUET;
+                break;
+            case "orc":
+                formatType = TFileFormatType.FORMAT_ORC;
+                break;
+            default:
+                throw new AnalysisException(getTableName() + " only supports the format parquet or orc, but got: "
+                        + format);
+        }
+    }
+
+    // The path or the glob pattern of the files.
+    protected abstract String getFilePattern();
+
+    // Lists the files and reads their schema, called at the end of the constructors of the subclasses.
+    protected void init() throws UserException {
+        fileSplits = listFiles();
+        if (fileSplits.isEmpty()) {
+            throw new AnalysisException("No file matches " + getFilePattern());
+        }
+        columns = fetchTableColumns((FileSplit) fileSplits.get(0));
+    }
+
+    protected List<InputSplit> listFiles() throws UserException {
+        Configuration conf = new Configuration();
+        for (Map.Entry<String, String> entry : getTableProperties().entrySet()) {
+            conf.set(entry.getKey(), entry.getValue());
+        }
+        for (Map.Entry<String, String> entry : getS3Properties().entrySet()) {
+            conf.set(entry.getKey(), entry.getValue());
+        }
+        List<InputSplit> splits = Lists.newArrayList();
+        try {
+            Path pattern = new Path(getFilePattern());
+            FileStatus[] statuses = pattern.getFileSystem(conf).globStatus(pattern);
+            if (statuses == null) {
+                return splits;
+            }
+            for (FileStatus status : statuses) {
+                if (!status.isDirectory()) {
+                    splits.add(new FileSplit(status.getPath(), 0, status.getLen(), new String[0]));
+                }
+            }
+        } catch (IOException e) {
+            throw new AnalysisException("Failed to list the files of " + getFilePattern() + ": " + e.getMessage());
+        }
+        return splits;
+    }
+
+    private List<Column> fetchTableColumns(FileSplit split) throws UserException {
+        long backendId = getBackendId();
+        if (backendId < 0) {
+            List<Long> backendIds = Catalog.getCurrentSystemInfo().getBackendIds(true);
+            if (backendIds.isEmpty()) {
+                throw new AnalysisException("No alive backends");
+            }
+            Collections.shuffle(backendIds, new Random(System.currentTimeMillis()));
+            backendId = backendIds.get(0);
+        }
+        Backend be = Catalog.getCurrentSystemInfo().getBackend(backendId);
+        if (be == null || !be.isAlive()) {
+            throw new AnalysisException("Backend " + backendId + " is not available");
+        }
+        TNetworkAddress address = new TNetworkAddress(be.getHost(), be.getBrpcPort());
+
+        InternalService.PFetchTableSchemaResult result;
+        try {
+            Future<InternalService.PFetchTableSchemaResult> future = BackendServiceProxy.getInstance()
+                    .fetchTableSchema(address, createFileScanRange(split));
+            result = future.get(FETCH_TABLE_SCHEMA_TIMEOUT_SEC, TimeUnit.SECONDS);
+        } catch (Exception e) {
+            LOG.warn("failed to fetch the schema of {} from backend {}", split.getPath(), backendId, e);
+            throw new AnalysisException("Failed to fetch the schema of " + split.getPath() + ": " + e.getMessage());
+        }
+        if (result.getStatus().getStatusCode() != 0) {
+            throw new AnalysisException("Failed to fetch the schema of " + split.getPath() + ": "
+                    + result.getStatus().getErrorMsgsList());
+        }
+
+        List<Column> fileColumns = Lists.newArrayList();
+        for (int i = 0; i < result.getColumnNamesCount(); ++i) {
+            fileColumns.add(new Column(result.getColumnNames(i), toScalarType(result.getColumnTypes(i)), true,
+                    null, true, null, ""));
+        }
+        return fileColumns;
+    }
+
+    private static ScalarType toScalarType(Types.PTypeDesc typeDesc) throws AnalysisException {
+        Types.PTypeNode node = typeDesc.getTypes(0);
+        if (node.getType() != TTypeNodeType.SCALAR.getValue()) {
+            throw new AnalysisException("Only the scalar types are supported in the files");
+        }
+        Types.PScalarType scalarType = node.getScalarType();
+        PrimitiveType type = PrimitiveType.fromThrift(TPrimitiveType.findByValue(scalarType.getType()));
+        return ScalarType.createType(type, scalarType.getLen(), scalarType.getPrecision(), scalarType.getScale());
+    }
+
+    private TFileScanRange createFileScanRange(FileSplit split) throws UserException {
+        TFileScanRangeParams params = new TFileScanRangeParams();
+        params.setFileType(getTableFileType());
+        params.setFormatType(formatType);
+        String filePath = split.getPath().toUri().getPath();
+        if (getTableFileType() == TFileType.FILE_HDFS) {
+            THdfsParams hdfsParams = BrokerUtil.generateHdfsParam(getTableProperties());
+            hdfsParams.setFsName(split.getPath().toUri().toString().replace(filePath, ""));
+            params.setHdfsParams(hdfsParams);
+        } else if (getTableFileType() == TFileType.FILE_S3) {
+            params.setProperties(getS3Properties());
+        }
+
+        TFileRangeDesc rangeDesc = new TFileRangeDesc();
+        rangeDesc.setPath(getTableFileType() == TFileType.FILE_S3 ? split.getPath().toString() : filePath);
+        rangeDesc.setStartOffset(0);
+        rangeDesc.setSize(split.getLength());
+
+        TFileScanRange fileScanRange = new TFileScanRange();
+        fileScanRange.setParams(params);
+        fileScanRange.addToRanges(rangeDesc);
+        return fileScanRange;
+    }
+
+    @Override
+    public List<Column> getTableColumns() {
+        return columns;
+    }
+
+    @Override
+    public List<TableValuedFunctionTask> getTasks() throws AnalysisException {
+        throw new AnalysisException(getTableName() + " is scanned by the file scan node");
+    }
+
+    @Override
+    public TFileFormatType getTableFormatType() {
+        return formatType;
+    }
+
+    @Override
+    public String getMetaStoreUrl() {
+        return null;
+    }
+
+    @Override
+    public List<InputSplit> getSplits(List<Expr> exprs) {
+        return fileSplits;
+    }
+
+    @Override
+    public Table getRemoteHiveTable() {
+        return null;
+    }
+
+    @Override
+    public Map<String, String> getTableProperties() {
+        return Maps.newHashMap();
+    }
+
+    @Override
+    public List<String> getPathPartitionKeys() {
+        return Lists.newArrayList();
+    }
+
+    @Override
+    public TFileTextScanRangeParams getTextParams() {
+        return null;
+    }
+
+    @Override
+    public Map<String, String> getS3Properties() {
+        return Maps.newHashMap();
+    }
+}
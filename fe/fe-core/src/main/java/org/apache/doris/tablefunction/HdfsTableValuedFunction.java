@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package org.apache.doris.tablefunction;
+
+import org.apache.doris.catalog.HiveTable;
+import org.apache.doris.common.AnalysisException;
+import org.apache.doris.common.UserException;
+import org.apache.doris.thrift.TFileType;
+import org.apache.doris.thrift.TTVFunctionName;
+
+import com.google.common.base.Strings;
+import com.google.common.collect.Maps;
+
+import java.util.Map;
+
+/**
+ * The Implement of table valued function——hdfs("uri" = "hdfs://host:port/path/*.orc", "format" = "orc",
+ * "hadoop.username" = "...", "dfs.nameservices" = "...").
+ */
+public class HdfsTableValuedFunction extends ExternalFileTableValuedFunction {
+    public static final String NAME = "hdfs";
+    public static final String URI = "uri";
+
+    private final String uri;
+
+    // The hadoop and dfs properties to access the files.
+    private final Map<String, String> hdfsProperties = Maps.newHashMap();
+
+    public HdfsTableValuedFunction(Map<String, String> params) throws UserException {
+        super(params);
+        uri = properties.get(URI);
+        if (Strings.isNullOrEmpty(uri)) {
+            throw new AnalysisException("hdfs table function requires the property " + URI);
+        }
+        for (Map.Entry<String, String> entry : properties.entrySet()) {
+            if (entry.getKey().startsWith(HiveTable.HIVE_HDFS_PREFIX) || entry.getKey().startsWith("hadoop.")) {
+                hdfsProperties.put(entry.getKey(), entry.getValue());
+            }
+        }
+        init();
+    }
+
+    @Override
+    public TTVFunctionName getFuncName() {
+        return TTVFunctionName.HDFS;
+    }
+
+    @Override
+    public String getTableName() {
+        return "HdfsTableValuedFunction";
+    }
+
+    @Override
+    protected String getFilePattern() {
+        return uri;
+    }
+
+    @Override
+    public TFileType getTableFileType() {
+        return TFileType.FILE_HDFS;
+    }
+
+    @Override
+    public Map<String, String> getTableProperties() {
+        return hdfsProperties;
+    }
+}
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package org.apache.doris.tablefunction;
+
+import org.apache.doris.catalog.Catalog;
+import org.apache.doris.common.AnalysisException;
+import org.apache.doris.common.ErrorCode;
+import org.apache.doris.common.ErrorReport;
+import org.apache.doris.common.UserException;
+import org.apache.doris.mysql.privilege.PrivPredicate;
+import org.apache.doris.qe.ConnectContext;
+import org.apache.doris.thrift.TFileType;
+import org.apache.doris.thrift.TTVFunctionName;
+
+import com.google.common.base.Strings;
+import com.google.common.collect.Lists;
+import org.apache.hadoop.fs.Path;
+import org.apache.hadoop.mapred.FileSplit;
+import org.apache.hadoop.mapred.InputSplit;
+
+import java.util.List;
+import java.util.Map;
+
+/**
+ * The Implement of table valued function——local("file_path" = "/path/to/file.parquet", "backend_id" = "10001",
+ * "format" = "parquet"). The file is on the disk of the backend and under its user_files_secure_path.
+ * Since it reads the disks of the backends, it requires the ADMIN privilege.
+ */
+public class LocalTableValuedFunction extends ExternalFileTableValuedFunction {
+    public static final String NAME = "local";
+    public static final String FILE_PATH = "file_path";
+    public static final String BACKEND_ID = "backend_id";
+
+    private final String filePath;
+
+    private final long backendId;
+
+    public LocalTableValuedFunction(Map<String, String> params) throws UserException {
+        super(params);
+        if (!Catalog.getCurrentCatalog().getAuth().checkGlobalPriv(ConnectContext.get(), PrivPredicate.ADMIN)) {
+            ErrorReport.reportAnalysisException(ErrorCode.ERR_SPECIFIC_ACCESS_DENIED_ERROR, "ADMIN");
+        }
+        filePath = properties.get(FILE_PATH);
+        if (Strings.isNullOrEmpty(filePath)) {
+            throw new AnalysisException("local table function requires the property " + FILE_PATH);
+        }
+        try {
+            backendId = Long.parseLong(properties.getOrDefault(BACKEND_ID, ""));
+        } catch (NumberFormatException e) {
+            throw new AnalysisException("local table function requires the id of a backend in " + BACKEND_ID);
+        }
+        init();
+    }
+
+    // The file is only visible to its backend, so it is read as a single range of an unknown size.
+    @Override
+    protected List<InputSplit> listFiles() {
+        return Lists.newArrayList(new FileSplit(new Path(filePath), 0, -1, new String[0]));
+    }
+
+    @Override
+    public TTVFunctionName getFuncName() {
+        return TTVFunctionName.LOCAL;
+    }
+
+    @Override
+    public String getTableName() {
+        return "LocalTableValuedFunction";
+    }
+
+    @Override
+    protected String getFilePattern() {
+        return filePath;
+    }
+
+    @Override
+    public TFileType getTableFileType() {
+        return TFileType.FILE_LOCAL;
+    }
+
+    @Override
+    public long getBackendId() {
+        return backendId;
+    }
+}
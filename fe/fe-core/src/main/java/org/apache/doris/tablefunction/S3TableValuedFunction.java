@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package org.apache.doris.tablefunction;
+
+import org.apache.doris.common.AnalysisException;
+import org.apache.doris.common.UserException;
+import org.apache.doris.datasource.DataSourceProperty;
+import org.apache.doris.thrift.TFileType;
+import org.apache.doris.thrift.TTVFunctionName;
+
+import com.google.common.base.Strings;
+
+import java.util.Map;
+
+/**
+ * The Implement of table valued function——s3("uri" = "s3://bucket/path/*.parquet", "format" = "parquet",
+ * "AWS_ACCESS_KEY" = "...", "AWS_SECRET_KEY" = "...", "AWS_ENDPOINT" = "...", "AWS_REGION" = "...").
+ */
+public class S3TableValuedFunction extends ExternalFileTableValuedFunction {
+    public static final String NAME = "s3";
+    public static final String URI = "uri";
+
+    private final String uri;
+
+    private final Map<String, String> s3Properties;
+
+    public S3TableValuedFunction(Map<String, String> params) throws UserException {
+        super(params);
+        uri = properties.get(URI);
+        if (Strings.isNullOrEmpty(uri)) {
+            throw new AnalysisException("s3 table function requires the property " + URI);
+        }
+        DataSourceProperty dataSourceProperty = new DataSourceProperty();
+        dataSourceProperty.setProperties(properties);
+        s3Properties = dataSourceProperty.getS3Properties();
+        init();
+    }
+
+    @Override
+    public TTVFunctionName getFuncName() {
+        return TTVFunctionName.S3;
+    }
+
+    @Override
+    public String getTableName() {
+        return "S3TableValuedFunction";
+    }
+
+    @Override
+    protected String getFilePattern() {
+        return uri;
+    }
+
+    @Override
+    public TFileType getTableFileType() {
+        return TFileType.FILE_S3;
+    }
+
+    @Override
+    public Map<String, String> getS3Properties() {
+        return s3Properties;
+    }
+}
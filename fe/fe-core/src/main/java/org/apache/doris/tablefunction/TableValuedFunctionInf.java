@@ -25,6 +25,7 @@ import org.apache.doris.common.UserException;
 import org.apache.doris.thrift.TTVFunctionName;
 
 import java.util.List;
+import java.util.Map;
 
 public abstract class TableValuedFunctionInf {
 
@@ -43,6 +44,19 @@ public abstract class TableValuedFunctionInf {
         throw new UserException("Could not find table function " + funcName);
     }
 
+    // The table functions on files take their parameters as properties
+    public static TableValuedFunctionInf getTableFunction(String funcName, Map<String, String> properties)
+            throws UserException {
+        if (funcName.equalsIgnoreCase(S3TableValuedFunction.NAME)) {
+            return new S3TableValuedFunction(properties);
+        } else if (funcName.equalsIgnoreCase(HdfsTableValuedFunction.NAME)) {
+            return new HdfsTableValuedFunction(properties);
+        } else if (funcName.equalsIgnoreCase(LocalTableValuedFunction.NAME)) {
+            return new LocalTableValuedFunction(properties);
+        }
+        throw new UserException("Could not find table function " + funcName);
+    }
+
     public abstract String getTableName();
 
     public abstract List<Column> getTableColumns();
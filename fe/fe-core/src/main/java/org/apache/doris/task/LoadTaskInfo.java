@@ -86,6 +86,8 @@ public interface LoadTaskInfo {
 
     boolean isLoadToSingleTablet();
 
+    boolean isPartialUpdate();
+
     String getHeaderType();
 
     class ImportColumnDescs {
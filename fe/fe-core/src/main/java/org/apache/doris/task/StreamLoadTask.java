@@ -75,6 +75,7 @@ public class StreamLoadTask implements LoadTaskInfo {
     private int sendBatchParallelism = 1;
     private double maxFilterRatio = 0.0;
     private boolean loadToSingleTablet = false;
+    private boolean isPartialUpdate = false;
     private String headerType = "";
 
     public StreamLoadTask(TUniqueId id, long txnId, TFileType fileType, TFileFormatType formatType) {
@@ -140,6 +141,11 @@ public class StreamLoadTask implements LoadTaskInfo {
         return loadToSingleTablet;
     }
 
+    @Override
+    public boolean isPartialUpdate() {
+        return isPartialUpdate;
+    }
+
     public PartitionNames getPartitions() {
         return partitions;
     }
@@ -320,6 +326,9 @@ public class StreamLoadTask implements LoadTaskInfo {
         if (request.isSetLoadToSingleTablet()) {
             loadToSingleTablet = request.isLoadToSingleTablet();
         }
+        if (request.isSetPartialUpdate()) {
+            isPartialUpdate = request.isPartialUpdate();
+        }
     }
 
     // used for stream load
@@ -22,6 +22,7 @@ import org.apache.doris.catalog.TabletMeta;
 import org.apache.doris.common.MarkedCountDownLatch;
 import org.apache.doris.common.Pair;
 import org.apache.doris.common.Status;
+import org.apache.doris.thrift.TColumn;
 import org.apache.doris.thrift.TStatusCode;
 import org.apache.doris.thrift.TTabletMetaInfo;
 import org.apache.doris.thrift.TTabletMetaType;
@@ -47,6 +48,9 @@ public class UpdateTabletMetaInfoTask extends AgentTask {
     private boolean isInMemory;
     private TTabletMetaType metaType;
     private String storagePolicy;
+    // the columns and the schema version of the tablets after a light schema change
+    private List<TColumn> columnsDesc;
+    private int schemaVersion;
 
     // <tablet id, tablet schema hash, tablet in memory>
     private List<Triple<Long, Integer, Boolean>> tabletToInMemory;
@@ -77,6 +81,13 @@ public class UpdateTabletMetaInfoTask extends AgentTask {
         this.tabletToInMemory = tabletToInMemory;
     }
 
+    public UpdateTabletMetaInfoTask(long backendId, Set<Pair<Long, Integer>> tableIdWithSchemaHash,
+                                    List<TColumn> columnsDesc, int schemaVersion) {
+        this(backendId, tableIdWithSchemaHash, TTabletMetaType.SCHEMA);
+        this.columnsDesc = columnsDesc;
+        this.schemaVersion = schemaVersion;
+    }
+
     public void countDownLatch(long backendId, Set<Pair<Long, Integer>> tablets) {
         if (this.latch != null) {
             if (latch.markedCountDown(backendId, tablets)) {
@@ -150,6 +161,18 @@ public class UpdateTabletMetaInfoTask extends AgentTask {
                 }
                 break;
             }
+            case SCHEMA: {
+                for (Pair<Long, Integer> pair : tableIdWithSchemaHash) {
+                    TTabletMetaInfo metaInfo = new TTabletMetaInfo();
+                    metaInfo.setTabletId(pair.first);
+                    metaInfo.setSchemaHash(pair.second);
+                    metaInfo.setColumnsDesc(columnsDesc);
+                    metaInfo.setSchemaVersion(schemaVersion);
+                    metaInfo.setMetaType(metaType);
+                    metaInfos.add(metaInfo);
+                }
+                break;
+            }
             default:
                 break;
         }
@@ -28,6 +28,10 @@ import org.apache.doris.catalog.OlapTable;
 import org.apache.doris.catalog.Table;
 import org.apache.doris.common.FeConstants;
 import org.apache.doris.common.jmockit.Deencapsulation;
+import org.apache.doris.task.AgentBatchTask;
+import org.apache.doris.task.UpdateTabletMetaInfoTask;
+import org.apache.doris.thrift.TTabletMetaInfo;
+import org.apache.doris.thrift.TTabletMetaType;
 import org.apache.doris.utframe.TestWithFeService;
 
 import com.google.common.collect.Maps;
@@ -323,6 +327,18 @@ public class SchemaChangeHandlerTest extends TestWithFeService {
             Assertions.assertEquals(baseIndexName, tbl.getName());
             MaterializedIndexMeta indexMeta = tbl.getIndexMetaByIndexId(tbl.getBaseIndexId());
             Assertions.assertNotNull(indexMeta);
+
+            // the replicas get the new schema of the tablet
+            AgentBatchTask batchTask = Catalog.getCurrentCatalog().getSchemaChangeHandler()
+                    .createUpdateTabletSchemaTasks(tbl, Sets.newHashSet(tbl.getBaseIndexId()));
+            Assertions.assertEquals(1, batchTask.getTaskNum());
+            TTabletMetaInfo metaInfo = ((UpdateTabletMetaInfoTask) batchTask.getAllTasks().get(0)).toThrift()
+                    .getTabletMetaInfos().get(0);
+            Assertions.assertEquals(TTabletMetaType.SCHEMA, metaInfo.getMetaType());
+            Assertions.assertEquals(indexMeta.getSchemaVersion(), metaInfo.getSchemaVersion());
+            Assertions.assertEquals(7, metaInfo.getColumnsDescSize());
+            Assertions.assertEquals("new_v1", metaInfo.getColumnsDesc().get(6).getColumnName());
+            Assertions.assertTrue(metaInfo.getColumnsDesc().get(6).getColUniqueId() > 0);
         } finally {
             tbl.readUnlock();
         }
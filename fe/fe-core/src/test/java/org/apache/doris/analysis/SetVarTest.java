@@ -22,6 +22,7 @@ import org.apache.doris.common.UserException;
 import org.apache.doris.mysql.privilege.MockedAuth;
 import org.apache.doris.mysql.privilege.PaloAuth;
 import org.apache.doris.qe.ConnectContext;
+import org.apache.doris.qe.SessionVariable;
 
 import mockit.Mocked;
 import org.junit.Assert;
@@ -61,6 +62,40 @@ public class SetVarTest {
         Assert.assertEquals("DEFAULT times = 100", var.toString());
     }
 
+    @Test
+    public void testFragmentTransmissionCompressionCodec() throws UserException, AnalysisException {
+        SetVar var = new SetVar(SetType.DEFAULT, SessionVariable.FRAGMENT_TRANSMISSION_COMPRESSION_CODEC,
+                new StringLiteral("ZSTD"));
+        var.analyze(analyzer);
+        Assert.assertEquals("ZSTD", var.getValue().getStringValue());
+
+        var = new SetVar(SetType.DEFAULT, SessionVariable.FRAGMENT_TRANSMISSION_COMPRESSION_CODEC,
+                new StringLiteral("gzip"));
+        try {
+            var.analyze(analyzer);
+            Assert.fail("No exception throws.");
+        } catch (AnalysisException e) {
+            Assert.assertTrue(e.getMessage().contains("gzip"));
+        }
+    }
+
+    @Test
+    public void testPercentileApproxSketch() throws UserException, AnalysisException {
+        SetVar var = new SetVar(SetType.DEFAULT, SessionVariable.PERCENTILE_APPROX_SKETCH,
+                new StringLiteral("DDSketch"));
+        var.analyze(analyzer);
+        Assert.assertEquals("ddsketch", var.getValue().getStringValue());
+
+        var = new SetVar(SetType.DEFAULT, SessionVariable.PERCENTILE_APPROX_SKETCH,
+                new StringLiteral("kll"));
+        try {
+            var.analyze(analyzer);
+            Assert.fail("No exception throws.");
+        } catch (AnalysisException e) {
+            Assert.assertTrue(e.getMessage().contains("kll"));
+        }
+    }
+
     @Test(expected = AnalysisException.class)
     public void testNoVariable() throws UserException, AnalysisException {
         SetVar var = new SetVar(SetType.DEFAULT, "", new StringLiteral("utf-8"));
@@ -575,4 +575,30 @@ public class CreateTableTest {
                     + "distributed by hash(k1) buckets 1 properties('replication_num' = '1');");
         });
     }
+
+    @Test
+    public void testCreateTableWithRowStoreColumn() throws Exception {
+        createTable("create table test.tbl_row_store(k1 int, v1 varchar(20)) unique key(k1)\n"
+                + "distributed by hash(k1) buckets 1\n"
+                + "properties('replication_num' = '1', 'store_row_column' = 'true');");
+        Database db = Catalog.getCurrentInternalCatalog().getDbOrMetaException("default_cluster:test");
+        OlapTable table = (OlapTable) db.getTableOrMetaException("tbl_row_store");
+        Assert.assertTrue(table.hasRowStoreColumn());
+        Column column = table.getBaseSchema(true).stream().filter(Column::isRowStoreColumn).findFirst().get();
+        Assert.assertEquals(PrimitiveType.STRING, column.getDataType());
+        Assert.assertEquals(AggregateType.REPLACE, column.getAggregationType());
+        Assert.assertTrue(column.getUniqueId() >= 0);
+        Assert.assertFalse(table.getBaseSchema().contains(column));
+
+        ExceptionChecker.expectThrowsWithMsg(AnalysisException.class,
+                "store_row_column is not supported by AGG_KEYS tables",
+                () -> createTable("create table test.tbl_agg_row_store(k1 int, v1 int sum) aggregate key(k1)\n"
+                        + "distributed by hash(k1) buckets 1\n"
+                        + "properties('replication_num' = '1', 'store_row_column' = 'true');"));
+        ExceptionChecker.expectThrowsWithMsg(AnalysisException.class,
+                "store_row_column must be `true` or `false`",
+                () -> createTable("create table test.tbl_bad_row_store(k1 int, v1 int) duplicate key(k1)\n"
+                        + "distributed by hash(k1) buckets 1\n"
+                        + "properties('replication_num' = '1', 'store_row_column' = 'yes');"));
+    }
 }
@@ -34,6 +34,7 @@ import org.apache.doris.catalog.ScalarType;
 import org.apache.doris.catalog.SinglePartitionInfo;
 import org.apache.doris.common.UserException;
 import org.apache.doris.thrift.TExplainLevel;
+import org.apache.doris.thrift.TOlapTableSchemaParam;
 import org.apache.doris.thrift.TUniqueId;
 
 import com.google.common.collect.Lists;
@@ -41,6 +42,7 @@ import mockit.Expectations;
 import mockit.Injectable;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
+import org.junit.Assert;
 import org.junit.Before;
 import org.junit.Test;
 
@@ -107,6 +109,41 @@ public class OlapTableSinkTest {
         sink.complete();
         LOG.info("sink is {}", sink.toThrift());
         LOG.info("{}", sink.getExplainString("", TExplainLevel.NORMAL));
+        Assert.assertFalse(sink.toThrift().getOlapTableSink().getSchema().isIsPartialUpdate());
+    }
+
+    @Test
+    public void testPartialUpdate() throws UserException {
+        TupleDescriptor tuple = getTuple();
+        SinglePartitionInfo partInfo = new SinglePartitionInfo();
+        partInfo.setReplicaAllocation(2, new ReplicaAllocation((short) 3));
+        MaterializedIndex index = new MaterializedIndex(2, MaterializedIndex.IndexState.NORMAL);
+        HashDistributionInfo distInfo = new HashDistributionInfo(
+                2, Lists.newArrayList(new Column("k1", PrimitiveType.BIGINT)));
+        Partition partition = new Partition(2, "p1", index, distInfo);
+
+        new Expectations() {
+            {
+                dstTable.getId();
+                result = 1;
+                dstTable.getPartitionInfo();
+                result = partInfo;
+                dstTable.getPartitions();
+                result = Lists.newArrayList(partition);
+                dstTable.getPartition(2L);
+                result = partition;
+            }
+        };
+
+        OlapTableSink sink = new OlapTableSink(dstTable, tuple, Lists.newArrayList(2L));
+        sink.init(new TUniqueId(1, 2), 3, 4, 1000, 1, false);
+        sink.setPartialUpdateInputColumns(Lists.newArrayList("k1", "k2", "v2"));
+        sink.complete();
+        TOlapTableSchemaParam schema = sink.toThrift().getOlapTableSink().getSchema();
+        Assert.assertTrue(schema.isIsPartialUpdate());
+        Assert.assertEquals(Lists.newArrayList("k1", "k2", "v2"), schema.getPartialUpdateInputColumns());
+        // all the columns still travel to the BEs, the missing ones are filled there
+        Assert.assertEquals(4, schema.getSlotDescsSize());
     }
 
     @Test
@@ -2190,4 +2190,51 @@ public class QueryPlanTest extends TestWithFeService {
         // errCode = 2, detailMessage = Unknown column 'col2' in 't_2'
         Assert.assertFalse(explainString.contains("errCode"));
     }
+
+    @Test
+    public void testAggregationOfSortedInput() throws Exception {
+        connectContext.setDatabase("default_cluster:test");
+        // the groups of k1 and of (k2, k1) are runs of the rows ordered by k1, k2
+        String sql = "explain select k1, count(*) from "
+                + "(select k1, k2 from test.baseall order by k1, k2 limit 10) t group by k1";
+        Assert.assertTrue(getSQLPlanOrErrorMsg(sql).contains("SORTED INPUT"));
+        sql = "explain select k2, k1, count(*) from "
+                + "(select k1, k2 from test.baseall order by k1, k2 limit 10) t group by k2, k1";
+        Assert.assertTrue(getSQLPlanOrErrorMsg(sql).contains("SORTED INPUT"));
+        // the groups of k2 are spread over the rows
+        sql = "explain select k2, count(*) from "
+                + "(select k1, k2 from test.baseall order by k1, k2 limit 10) t group by k2";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("SORTED INPUT"));
+        sql = "explain select k1, k3, count(*) from "
+                + "(select k1, k2, k3 from test.baseall order by k1, k2 limit 10) t group by k1, k3";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("SORTED INPUT"));
+        // the rows of a scan come in no order
+        sql = "explain select k1, count(*) from test.baseall group by k1";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("SORTED INPUT"));
+    }
+
+    @Test
+    public void testPushDownAggNoGrouping() throws Exception {
+        connectContext.setDatabase("default_cluster:test");
+        String sql = "explain select min(dt), max(id) from test.join1";
+        Assert.assertTrue(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP: MINMAX"));
+        sql = "explain select count(*), count(id) from test.join1";
+        Assert.assertTrue(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP: COUNT"));
+        // the metadata of the segments gives either the min and max or the count
+        sql = "explain select min(dt), count(id) from test.join1";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP"));
+        sql = "explain select sum(id) from test.join1";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP"));
+        sql = "explain select count(distinct id) from test.join1";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP"));
+        sql = "explain select max(id + 1) from test.join1";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP"));
+        sql = "explain select dt, count(*) from test.join1 group by dt";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP"));
+        sql = "explain select count(*) from test.join1 where id > 1";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP"));
+        // the rows of the segments of an aggregate key table are merged by the scan
+        sql = "explain select count(*) from test.baseall";
+        Assert.assertFalse(getSQLPlanOrErrorMsg(sql).contains("PUSHAGGOP"));
+    }
 }
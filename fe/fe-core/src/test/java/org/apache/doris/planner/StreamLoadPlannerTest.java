@@ -23,11 +23,15 @@ import org.apache.doris.analysis.ImportColumnsStmt;
 import org.apache.doris.analysis.ImportWhereStmt;
 import org.apache.doris.analysis.SqlParser;
 import org.apache.doris.analysis.SqlScanner;
+import org.apache.doris.catalog.AggregateType;
 import org.apache.doris.catalog.Column;
 import org.apache.doris.catalog.Database;
+import org.apache.doris.catalog.KeysType;
 import org.apache.doris.catalog.OlapTable;
 import org.apache.doris.catalog.Partition;
 import org.apache.doris.catalog.PrimitiveType;
+import org.apache.doris.catalog.Type;
+import org.apache.doris.common.AnalysisException;
 import org.apache.doris.common.UserException;
 import org.apache.doris.common.util.SqlParserUtils;
 import org.apache.doris.task.StreamLoadTask;
@@ -40,6 +44,7 @@ import com.google.common.collect.Lists;
 import mockit.Expectations;
 import mockit.Injectable;
 import mockit.Mocked;
+import mockit.Verifications;
 import org.junit.Assert;
 import org.junit.Test;
 
@@ -101,6 +106,91 @@ public class StreamLoadPlannerTest {
         planner.plan(streamLoadTask.getId());
     }
 
+    @Test
+    public void testPartialUpdatePlan() throws UserException {
+        Column k1 = new Column("k1", Type.BIGINT, true, null, false, null, "");
+        Column v1 = new Column("v1", Type.BIGINT, false, AggregateType.REPLACE, true, null, "");
+        Column v2 = new Column("v2", Type.BIGINT, false, AggregateType.REPLACE, true, null, "");
+        List<Column> columns = Lists.newArrayList(k1, v1, v2);
+        new Expectations() {
+            {
+                destTable.getKeysType();
+                minTimes = 0;
+                result = KeysType.UNIQUE_KEYS;
+                destTable.getEnableUniqueKeyMergeOnWrite();
+                minTimes = 0;
+                result = true;
+                destTable.getBaseSchema();
+                minTimes = 0;
+                result = columns;
+                destTable.getFullSchema();
+                minTimes = 0;
+                result = columns;
+                destTable.getColumn("k1");
+                minTimes = 0;
+                result = k1;
+                destTable.getColumn("v2");
+                minTimes = 0;
+                result = v2;
+                destTable.getPartitions();
+                minTimes = 0;
+                result = Arrays.asList(partition);
+                scanNode.getId();
+                minTimes = 0;
+                result = new PlanNodeId(5);
+            }
+        };
+        TStreamLoadPutRequest request = new TStreamLoadPutRequest();
+        request.setTxnId(1);
+        request.setLoadId(new TUniqueId(2, 3));
+        request.setFileType(TFileType.FILE_STREAM);
+        request.setFormatType(TFileFormatType.FORMAT_CSV_PLAIN);
+        request.setColumns("k1, v2");
+        request.setPartialUpdate(true);
+        StreamLoadTask streamLoadTask = StreamLoadTask.fromTStreamLoadPutRequest(request);
+        StreamLoadPlanner planner = new StreamLoadPlanner(db, destTable, streamLoadTask);
+        planner.plan(streamLoadTask.getId());
+        new Verifications() {
+            {
+                List<String> inputColumns;
+                sink.setPartialUpdateInputColumns(inputColumns = withCapture());
+                Assert.assertEquals(Lists.newArrayList("k1", "v2"), inputColumns);
+            }
+        };
+
+        // the key columns must be loaded
+        request.setColumns("v1, v2");
+        StreamLoadTask missingKeyTask = StreamLoadTask.fromTStreamLoadPutRequest(request);
+        try {
+            new StreamLoadPlanner(db, destTable, missingKeyTask).plan(missingKeyTask.getId());
+            Assert.fail("no key column");
+        } catch (UserException e) {
+            Assert.assertTrue(e.getMessage().contains("key column k1"));
+        }
+    }
+
+    @Test(expected = AnalysisException.class)
+    public void testPartialUpdateOfNonMergeOnWriteTable() throws UserException {
+        new Expectations() {
+            {
+                destTable.getKeysType();
+                minTimes = 0;
+                result = KeysType.UNIQUE_KEYS;
+                destTable.getEnableUniqueKeyMergeOnWrite();
+                minTimes = 0;
+                result = false;
+            }
+        };
+        TStreamLoadPutRequest request = new TStreamLoadPutRequest();
+        request.setTxnId(1);
+        request.setLoadId(new TUniqueId(2, 3));
+        request.setFileType(TFileType.FILE_STREAM);
+        request.setFormatType(TFileFormatType.FORMAT_CSV_PLAIN);
+        request.setPartialUpdate(true);
+        StreamLoadTask streamLoadTask = StreamLoadTask.fromTStreamLoadPutRequest(request);
+        new StreamLoadPlanner(db, destTable, streamLoadTask).plan(streamLoadTask.getId());
+    }
+
     @Test
     public void testParseStmt() throws Exception {
         String sql = new String("COLUMNS (k1, k2, k3=abc(), k4=default_value())");
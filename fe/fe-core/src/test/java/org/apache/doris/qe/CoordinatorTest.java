@@ -27,6 +27,7 @@ import org.apache.doris.analysis.TupleId;
 import org.apache.doris.catalog.Catalog;
 import org.apache.doris.catalog.HashDistributionInfo;
 import org.apache.doris.catalog.OlapTable;
+import org.apache.doris.common.Pair;
 import org.apache.doris.common.jmockit.Deencapsulation;
 import org.apache.doris.persist.EditLog;
 import org.apache.doris.planner.DataPartition;
@@ -38,6 +39,9 @@ import org.apache.doris.planner.PlanFragment;
 import org.apache.doris.planner.PlanFragmentId;
 import org.apache.doris.planner.PlanNodeId;
 import org.apache.doris.planner.ScanNode;
+import org.apache.doris.proto.InternalService.PExecPlanFragmentResult;
+import org.apache.doris.proto.Types;
+import org.apache.doris.rpc.RpcException;
 import org.apache.doris.service.FrontendOptions;
 import org.apache.doris.system.Backend;
 import org.apache.doris.thrift.TNetworkAddress;
@@ -45,11 +49,13 @@ import org.apache.doris.thrift.TPartitionType;
 import org.apache.doris.thrift.TScanRangeLocation;
 import org.apache.doris.thrift.TScanRangeLocations;
 import org.apache.doris.thrift.TScanRangeParams;
+import org.apache.doris.thrift.TStatusCode;
 import org.apache.doris.thrift.TUniqueId;
 
 import com.google.common.collect.ArrayListMultimap;
 import com.google.common.collect.ImmutableMap;
 import com.google.common.collect.Maps;
+import com.google.common.util.concurrent.Futures;
 import mockit.Mocked;
 import org.apache.commons.collections.map.HashedMap;
 import org.junit.Assert;
@@ -61,6 +67,7 @@ import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.concurrent.Future;
 
 public class CoordinatorTest extends Coordinator {
 
@@ -845,4 +852,26 @@ public class CoordinatorTest extends Coordinator {
             Assert.assertTrue(host.hostname.equals("0.0.0.2"));
         }
     }
+
+    @Test
+    public void testRetryFragmentRejectedByBusyBackend() {
+        Coordinator coordinator = new Coordinator(context, analyzer, originalPlanner);
+        PExecPlanFragmentResult result = PExecPlanFragmentResult.newBuilder()
+                .setStatus(Types.PStatus.newBuilder().setStatusCode(TStatusCode.TOO_MANY_TASKS.getValue())
+                        .addErrorMsgs("workload group batch already runs 2 queries, retry later"))
+                .build();
+        Coordinator.BackendExecStates states = coordinator.new BackendExecStates(1L,
+                new TNetworkAddress("0.0.0.1", 8060), false);
+        List<Pair<Coordinator.BackendExecStates, Future<PExecPlanFragmentResult>>> futures = new ArrayList<>();
+        Future<PExecPlanFragmentResult> future = Futures.immediateFuture(result);
+        futures.add(Pair.create(states, future));
+        try {
+            Deencapsulation.invoke(coordinator, "waitRpc", futures, 1000L, "send fragments");
+            Assert.fail("the busy backend must fail the rpc");
+        } catch (Exception e) {
+            // retried by the StmtExecutor like an rpc failure
+            Assert.assertTrue(e instanceof RpcException);
+            Assert.assertTrue(e.getMessage().contains("retry later"));
+        }
+    }
 }
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package org.apache.doris.qe;
+
+import org.apache.doris.thrift.TDataPartition;
+import org.apache.doris.thrift.TPartitionType;
+import org.apache.doris.thrift.TPlanFragment;
+
+import com.google.common.collect.Lists;
+import org.apache.thrift.TException;
+import org.junit.Assert;
+import org.junit.Test;
+
+public class FragmentTemplateTrackerTest {
+
+    @Test
+    public void testDigest() throws TException {
+        TPlanFragment fragment = new TPlanFragment(new TDataPartition(TPartitionType.UNPARTITIONED));
+        String digest = FragmentTemplateTracker.digest(fragment);
+        Assert.assertEquals(digest, FragmentTemplateTracker.digest(fragment.deepCopy()));
+        fragment.getPartition().setType(TPartitionType.RANDOM);
+        Assert.assertNotEquals(digest, FragmentTemplateTracker.digest(fragment));
+    }
+
+    @Test
+    public void testCachedOnBackend() {
+        long backendId = 10001;
+        Assert.assertFalse(FragmentTemplateTracker.isCachedOn(backendId));
+
+        FragmentTemplateTracker.addCached(backendId, Lists.newArrayList());
+        Assert.assertFalse(FragmentTemplateTracker.isCachedOn(backendId));
+
+        FragmentTemplateTracker.addCached(backendId, Lists.newArrayList("a", "b"));
+        Assert.assertTrue(FragmentTemplateTracker.isCachedOn(backendId));
+        Assert.assertTrue(FragmentTemplateTracker.isCachedOn(backendId, "a"));
+        Assert.assertFalse(FragmentTemplateTracker.isCachedOn(backendId + 1, "a"));
+
+        // the backend evicted "a", but still caches the plan fragments
+        FragmentTemplateTracker.removeCached(backendId, Lists.newArrayList("a"));
+        Assert.assertFalse(FragmentTemplateTracker.isCachedOn(backendId, "a"));
+        Assert.assertTrue(FragmentTemplateTracker.isCachedOn(backendId, "b"));
+        Assert.assertTrue(FragmentTemplateTracker.isCachedOn(backendId));
+    }
+}
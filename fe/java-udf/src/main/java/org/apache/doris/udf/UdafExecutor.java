@@ -229,6 +229,23 @@ public class UdafExecutor {
         }
     }
 
+    /**
+     * invoke getValue for the places at inputPlacesPtr and store the results in the rows
+     * [rowStart, rowStart + numRows), for the return types of fixed length.
+     */
+    public void getValues(long rowStart, long numRows) throws UdfRuntimeException {
+        try {
+            long placesAddress = UdfUtils.UNSAFE.getLong(null, inputPlacesPtr);
+            Method resultMethod = allMethods.get(UDAF_RESULT_FUNCTION);
+            for (long i = 0; i < numRows; ++i) {
+                Long curPlace = UdfUtils.UNSAFE.getLong(null, placesAddress + 8L * i);
+                storeUdfResult(resultMethod.invoke(udaf, stateObjMap.get(curPlace)), rowStart + i);
+            }
+        } catch (Exception e) {
+            throw new UdfRuntimeException("UDAF failed to result", e);
+        }
+    }
+
     private boolean storeUdfResult(Object obj, long row) throws UdfRuntimeException {
         if (obj == null) {
             //if result is null, because we have insert default before, so return true directly when row == 0
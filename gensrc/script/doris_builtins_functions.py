@@ -1268,6 +1268,15 @@ visible_functions = [
         '_ZN5doris13JsonFunctions15json_path_closeEPN9doris_udf15FunctionContextENS2_18FunctionStateScopeE',
         'vec', 'ALWAYS_NULLABLE'],
 
+    [['jsonb_parse'], 'STRING', ['VARCHAR'], '', '', '', 'vec', 'ALWAYS_NULLABLE'],
+    [['jsonb_parse'], 'STRING', ['STRING'], '', '', '', 'vec', 'ALWAYS_NULLABLE'],
+    [['jsonb_extract_int'], 'INT', ['STRING', 'VARCHAR'], '', '', '', 'vec', 'ALWAYS_NULLABLE'],
+    [['jsonb_extract_int'], 'INT', ['STRING', 'STRING'], '', '', '', 'vec', 'ALWAYS_NULLABLE'],
+    [['jsonb_extract_double'], 'DOUBLE', ['STRING', 'VARCHAR'], '', '', '', 'vec', 'ALWAYS_NULLABLE'],
+    [['jsonb_extract_double'], 'DOUBLE', ['STRING', 'STRING'], '', '', '', 'vec', 'ALWAYS_NULLABLE'],
+    [['jsonb_extract_string'], 'STRING', ['STRING', 'VARCHAR'], '', '', '', 'vec', 'ALWAYS_NULLABLE'],
+    [['jsonb_extract_string'], 'STRING', ['STRING', 'STRING'], '', '', '', 'vec', 'ALWAYS_NULLABLE'],
+
     [['json_array'], 'VARCHAR', ['VARCHAR', '...'],
             '_ZN5doris13JsonFunctions10json_arrayEPN9doris_udf15FunctionContextEiPKNS1_9StringValE',
             '', '', 'vec', ''],
@@ -1407,6 +1416,10 @@ visible_functions = [
     [['murmur_hash3_32'], 'INT', ['STRING', '...'],
         '_ZN5doris13HashFunctions15murmur_hash3_32EPN9doris_udf15FunctionContextEiPKNS1_9StringValE',
         '', '', 'vec', ''],
+    [['murmur_hash3_64'], 'BIGINT', ['VARCHAR', '...'], '', '', '', 'vec', ''],
+    [['murmur_hash3_64'], 'BIGINT', ['STRING', '...'], '', '', '', 'vec', ''],
+    [['xxhash_64'], 'BIGINT', ['VARCHAR', '...'], '', '', '', 'vec', ''],
+    [['xxhash_64'], 'BIGINT', ['STRING', '...'], '', '', '', 'vec', ''],
 
     # aes and base64 function
     [['aes_encrypt'], 'VARCHAR', ['VARCHAR', 'VARCHAR'],
@@ -38,6 +38,7 @@ struct TTabletSchema {
     10: optional i32 sequence_col_idx = -1
     11: optional Types.TSortType sort_type
     12: optional i32 sort_col_num
+    13: optional i32 row_store_col_idx = -1
 }
 
 // this enum stands for different storage format in src_backends
@@ -324,7 +325,8 @@ struct TRecoverTabletReq {
 
 enum TTabletMetaType {
     PARTITIONID,
-    INMEMORY
+    INMEMORY,
+    SCHEMA
 }
 
 struct TTabletMetaInfo {
@@ -334,6 +336,9 @@ struct TTabletMetaInfo {
     4: optional TTabletMetaType meta_type
     5: optional bool is_in_memory
     6: optional string storage_policy;
+    // the columns of the tablet after a light schema change, with their unique ids
+    7: optional list<Descriptors.TColumn> columns_desc
+    8: optional i32 schema_version
 }
 
 struct TUpdateTabletMetaInfoReq {
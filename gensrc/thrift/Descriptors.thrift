@@ -116,7 +116,9 @@ enum THdfsCompression {
 }
 
 enum TIndexType {
-  BITMAP
+  BITMAP,
+  INVERTED,
+  NGRAM_BF
 }
 
 // Mapping from names defined by Avro to the enum.
@@ -186,6 +188,11 @@ struct TOlapTableSchemaParam {
     4: required list<TSlotDescriptor> slot_descs
     5: required TTupleDescriptor tuple_desc
     6: required list<TOlapTableIndexSchema> indexes
+    // A partial update of a unique key merge-on-write table: the load carries the keys and
+    // the columns in partial_update_input_columns, and the other columns of a row keep the
+    // values of the existing row with the same key.
+    7: optional bool is_partial_update
+    8: optional list<string> partial_update_input_columns
 }
 
 struct TOlapTableIndex {
@@ -193,6 +200,9 @@ struct TOlapTableIndex {
   2: optional list<string> columns
   3: optional TIndexType index_type
   4: optional string comment
+  // the parser and gram_size of an inverted index, the gram_size of an ngram bloom filter, or
+  // the encoding of a bitmap index
+  5: optional map<string, string> properties
 }
 
 struct TTabletLocation {
@@ -539,6 +539,9 @@ struct TStreamLoadPutRequest {
     36: optional double max_filter_ratio
     37: optional bool load_to_single_tablet
     38: optional string header_type
+    // a partial update of a unique key merge-on-write table, which loads the key columns and
+    // the columns in `columns` only
+    39: optional bool partial_update
 }
 
 struct TStreamLoadPutResult {
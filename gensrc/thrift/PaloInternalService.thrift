@@ -163,6 +163,21 @@ struct TQueryOptions {
 
   // trim tailing spaces while querying external table and stream load
   44: optional bool trim_tailing_spaces_for_external_table_query = false
+
+  // the codec compressing the blocks sent between fragments: none, snappy, lz4 or zstd
+  45: optional string fragment_transmission_compression_codec
+
+  // the sketch of percentile_approx: tdigest or ddsketch
+  46: optional string percentile_approx_sketch
+
+  // the share of the scanner threads of the query, relative to 1024, 0 for the default one
+  47: optional i32 scan_thread_shares = 0
+
+  // the workload group of the query, defined by the config workload_groups of the BE
+  48: optional string workload_group
+
+  // whether the operators add the perf counters of their threads to the profile
+  49: optional bool enable_perf_counters = false
 }
     
 
@@ -201,6 +216,10 @@ struct TRuntimeFilterParams {
 
   // Number of Runtime filter producers
   4: optional map<i32, i32> runtime_filter_builder_num
+
+  // Number of the producers of each runtime filter on the BE of this instance, they merge
+  // their filters before sending them to the merge instance. Only set if more than one.
+  5: optional map<i32, i32> runtime_filter_local_builder_num
 }
 
 // Parameters for a single execution instance of a particular TPlanFragment
@@ -349,6 +368,10 @@ struct TExecPlanFragmentParams {
   // it will wait for the FE to send the "start execution" command before it is actually executed.
   // Otherwise, the fragment will start executing directly on the BE side.
   20: optional bool need_wait_execution_trigger = false;
+
+  // The digest of the plan fragment. The BE caches the fragment under it, and the FE omits the
+  // fragment of the requests to the BEs which acknowledged caching it.
+  21: optional string fragment_digest
 }
 
 struct TExecPlanFragmentParamsList {
@@ -266,6 +266,9 @@ struct TExternalScanRange {
 
 enum TTVFunctionName {
     NUMBERS = 0,
+    S3 = 1,
+    HDFS = 2,
+    LOCAL = 3,
 }
 
 // Every table valued function should have a scan range definition to save its
@@ -412,6 +415,17 @@ struct TMetaScanNode {
   5: optional string user
 }
 
+// The aggregates above an olap scan that its segments can answer from their metadata instead of
+// their rows. MINMAX returns the min and the max of every column of a segment from its zone map,
+// COUNT returns as many default rows of a segment as it has, the same number of nulls included.
+// The scan must have no conjuncts and no runtime filters left, the BE falls back to reading the
+// rows of a segment having deletes or key ranges to filter by.
+enum TPushAggOp {
+  NONE = 0,
+  MINMAX = 1,
+  COUNT = 2
+}
+
 struct TOlapScanNode {
   1: required Types.TTupleId tuple_id
   2: required list<string> key_column_name
@@ -421,6 +435,7 @@ struct TOlapScanNode {
   6: optional Types.TKeysType keyType
   7: optional string table_name
   8: required list<Descriptors.TColumn> columns_desc
+  9: optional TPushAggOp push_down_agg_type_opt
 }
 
 struct TEqJoinCondition {
@@ -478,6 +493,9 @@ struct THashJoinNode {
   8: optional Types.TTupleId voutput_tuple_id
 
   9: optional list<Types.TTupleId> vintermediate_tuple_id_list
+
+  // the build side is broadcast to every instance of the fragment
+  10: optional bool is_broadcast_join
 }
 
 struct TMergeJoinNode {
@@ -543,6 +561,10 @@ struct TAggregationNode {
   // rows have been aggregated, and this node is not an intermediate node.
   5: required bool need_finalize
   6: optional bool use_streaming_preaggregation
+  // Set when the input of a one-phase aggregation comes in order of its grouping exprs, from a
+  // sort or a merging exchange whose first ordering exprs are the grouping exprs. The groups are then
+  // aggregated one after another as the input streams in, without a hash table.
+  7: optional bool is_input_sorted_by_group_keys
 }
 
 struct TRepeatNode {
@@ -583,6 +605,12 @@ struct TSortNode {
 
   // Indicates whether the imposed limit comes DEFAULT_ORDER_BY_LIMIT.           
   6: optional bool is_default_limit                                              
+
+  // Set for the sort of an analytic node whose output is filtered by row_number() or rank()
+  // at most this value: the rows that can't be among the first ones of their partition are
+  // dropped before sorting. The first partition_exprs_num ordering exprs are the partition exprs.
+  7: optional i64 partition_topn_limit
+  8: optional i32 partition_exprs_num
 }
 
 enum TAnalyticWindowType {
@@ -0,0 +1,165 @@
+#!/usr/bin/env bash
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+#####################################################################
+# This script is used to run the micro benchmarks of Doris Backend
+# Usage: $0 <options>
+#  Optional options:
+#     --clean                clean and build the benchmarks
+#     --run                  build and run all the benchmarks
+#     --run --filter=xx      build and run the benchmarks matching the regex
+#     --save-baseline=NAME   save the result as the baseline NAME
+#     --compare=NAME         compare the result with the baseline NAME
+#     --threshold=N          the percentage of slowdown reported as regression, 10 by default
+#     -j                     build parallel
+#     -h                     print this help message
+#
+# The benchmarks are in be/benchmark/ and use google benchmark. The
+# baselines are saved in be/benchmark/baselines/, they are only
+# comparable with the results of the same machine.
+#####################################################################
+
+ROOT=`dirname "$0"`
+ROOT=`cd "$ROOT"; pwd`
+
+export DORIS_HOME=${ROOT}
+
+# Check args
+usage() {
+  echo "
+Usage: $0 <options>
+  Optional options:
+     --clean                clean and build the benchmarks
+     --run                  build and run all the benchmarks
+     --run --filter=xx      build and run the benchmarks matching the regex
+     --save-baseline=NAME   save the result as the baseline NAME
+     --compare=NAME         compare the result with the baseline NAME
+     --threshold=N          the percentage of slowdown reported as regression, 10 by default
+     -j                     build parallel
+     -h                     print this help message
+
+  Eg.
+    $0                                          build the benchmarks
+    $0 --run                                    build and run all the benchmarks
+    $0 --run --filter=BM_HashMap.*              run the hash map benchmarks
+    $0 --run --save-baseline=master             run and save the result as the baseline master
+    $0 --run --compare=master                   run and compare the result with the baseline master
+  "
+  exit 1
+}
+
+OPTS=$(getopt  -n $0 -o hj:f: -l run,clean,filter:,save-baseline:,compare:,threshold: -- "$@")
+if [ "$?" != "0" ]; then
+  usage
+fi
+
+set -eo pipefail
+
+eval set -- "$OPTS"
+
+PARALLEL=$[$(nproc)/5+1]
+
+CLEAN=0
+RUN=0
+FILTER=""
+SAVE_BASELINE=""
+COMPARE=""
+THRESHOLD=10
+if [ $# != 1 ] ; then
+    while true; do
+        case "$1" in
+            --clean) CLEAN=1 ; shift ;;
+            --run) RUN=1 ; shift ;;
+            -f | --filter) FILTER="--benchmark_filter=$2"; shift 2;;
+            --save-baseline) SAVE_BASELINE=$2; shift 2;;
+            --compare) COMPARE=$2; shift 2;;
+            --threshold) THRESHOLD=$2; shift 2;;
+            -j) PARALLEL=$2; shift 2 ;;
+            --) shift ;  break ;;
+            *) usage ; exit 0 ;;
+        esac
+    done
+fi
+
+CMAKE_BUILD_TYPE=${BUILD_TYPE:-RELEASE}
+CMAKE_BUILD_TYPE="${CMAKE_BUILD_TYPE^^}"
+
+echo "Get params:
+    PARALLEL            -- $PARALLEL
+    CLEAN               -- $CLEAN
+"
+echo "Build Backend Benchmark"
+
+. ${DORIS_HOME}/env.sh
+
+CMAKE_BUILD_DIR=${DORIS_HOME}/be/benchmark_build_${CMAKE_BUILD_TYPE}
+if [ ${CLEAN} -eq 1 ]; then
+    rm ${CMAKE_BUILD_DIR} -rf
+fi
+
+if [ ! -d ${CMAKE_BUILD_DIR} ]; then
+    mkdir -p ${CMAKE_BUILD_DIR}
+fi
+
+if [[ -z ${GLIBC_COMPATIBILITY} ]]; then
+    GLIBC_COMPATIBILITY=ON
+fi
+
+MAKE_PROGRAM="$(which "${BUILD_SYSTEM}")"
+echo "-- Make program: ${MAKE_PROGRAM}"
+
+cd ${CMAKE_BUILD_DIR}
+${CMAKE_CMD} -G "${GENERATOR}" \
+    -DCMAKE_MAKE_PROGRAM="${MAKE_PROGRAM}" \
+    -DCMAKE_BUILD_TYPE="${CMAKE_BUILD_TYPE}" \
+    -DMAKE_TEST=OFF \
+    -DBUILD_BENCHMARK=ON \
+    -DGLIBC_COMPATIBILITY="${GLIBC_COMPATIBILITY}" \
+    -DBUILD_META_TOOL=OFF \
+    -DWITH_MYSQL=OFF \
+    -DUSE_MEM_TRACKER=ON \
+    ${CMAKE_USE_CCACHE} ${DORIS_HOME}/be/
+${BUILD_SYSTEM} -j ${PARALLEL} doris_be_benchmark
+
+if [ ${RUN} -ne 1 ]; then
+    echo "Finished"
+    exit 0
+fi
+
+echo "******************************"
+echo "   Running Backend Benchmark  "
+echo "******************************"
+
+cd ${DORIS_HOME}
+BASELINE_DIR=${DORIS_HOME}/be/benchmark/baselines
+RESULT=${CMAKE_BUILD_DIR}/benchmark_result.json
+
+${CMAKE_BUILD_DIR}/benchmark/doris_be_benchmark --benchmark_out=${RESULT} \
+    --benchmark_out_format=json ${FILTER}
+echo "=== Finished. Benchmark result: ${RESULT}"
+
+if [ -n "${SAVE_BASELINE}" ]; then
+    mkdir -p ${BASELINE_DIR}
+    cp ${RESULT} ${BASELINE_DIR}/${SAVE_BASELINE}.json
+    echo "=== Saved the baseline ${BASELINE_DIR}/${SAVE_BASELINE}.json"
+fi
+
+if [ -n "${COMPARE}" ]; then
+    python3 ${DORIS_HOME}/be/benchmark/compare_baseline.py \
+        ${BASELINE_DIR}/${COMPARE}.json ${RESULT} --threshold=${THRESHOLD}
+fi